@@ -20,15 +20,100 @@ import socket
 import json
 import time
 import base64
+import mmap
+import select
+import struct
 from typing import Optional, List, Dict, Any, Union
+from collections import deque
 from contextlib import contextmanager
 
 
+def lz4_block_decompress(src: bytes, size: int) -> bytes:
+    """Decompress an LZ4 block (AI_BIN_FLAG_LZ4 payloads) of size bytes"""
+    try:
+        import lz4.block
+        return lz4.block.decompress(src, uncompressed_size=size)
+    except ImportError:
+        pass
+    dst = bytearray()
+    ip = 0
+    while ip < len(src):
+        token = src[ip]
+        ip += 1
+        length = token >> 4
+        if length == 15:
+            while True:
+                length += src[ip]
+                ip += 1
+                if src[ip - 1] != 255:
+                    break
+        dst += src[ip:ip + length]
+        ip += length
+        if ip >= len(src):
+            break
+        offset = src[ip] | (src[ip + 1] << 8)
+        ip += 2
+        length = token & 15
+        if length == 15:
+            while True:
+                length += src[ip]
+                ip += 1
+                if src[ip - 1] != 255:
+                    break
+        length += 4
+        start = len(dst) - offset
+        if offset >= length:
+            dst += dst[start:start + length]
+        else:
+            for i in range(length):  # overlapping: repeats the last offset bytes
+                dst.append(dst[start + i])
+    if len(dst) != size:
+        raise ConnectionError("Corrupt LZ4 payload")
+    return bytes(dst)
+
+
 class Atari800AI:
     """Client for Atari800 AI interface"""
 
     DEFAULT_SOCKET = "/tmp/atari800_ai.sock"
 
+    # Binary framed protocol (see AI_BIN_* in src/ai_interface.h)
+    BIN_MAGIC = 0xA8
+    BIN_HEADER = struct.Struct("<BBBBII")
+    BIN_PING = 0x00
+    BIN_JSON = 0x01
+    BIN_RUN = 0x02
+    BIN_PEEK = 0x03
+    BIN_POKE = 0x04
+    BIN_SCREEN_RAW = 0x05
+    BIN_CPU = 0x06
+    BIN_JOYSTICK = 0x07
+    BIN_KEY = 0x08
+    BIN_CONSOL = 0x09
+    BIN_ACK = 0x0A
+    BIN_SCREEN_DELTA = 0x0B
+    BIN_OBSERVATION = 0x0C
+    BIN_PEEK_MULTI = 0x0D
+    BIN_PEEK_BANK = 0x0E
+    BIN_SCREENSHOT = 0x0F
+    BIN_COVERAGE = 0x10
+    BIN_HISTORY = 0x11
+    BIN_STATE_SAVE = 0x12
+    BIN_STATE_LOAD = 0x13
+    BIN_HASH = 0x14
+    BIN_STATE_GET = 0x15
+    BIN_STATE_PUT = 0x16
+    BIN_HEATMAP = 0x17
+    BIN_EVENT_FRAME = 0x40
+    BIN_EVENT_JSON = 0x41
+    BIN_PROTOCOL_JSON = 0x7F
+    BIN_FLAG_LZ4 = 0x01
+
+    STICK_VALUES = {
+        "center": 15, "up": 14, "down": 13, "left": 11, "right": 7,
+        "ul": 10, "ur": 6, "ll": 9, "lr": 5,
+    }
+
     # Atari key codes (common ones)
     AKEY_NONE = -1
     AKEY_A = 63
@@ -73,18 +158,50 @@ class Atari800AI:
     AKEY_TAB = 44
     AKEY_BACKSPACE = 52
 
-    def __init__(self, socket_path: str = None):
+    def __init__(self, socket_path: str = None, binary: bool = False,
+                 address: str = None, compress: bool = False):
+        """address is "[host]:port" or "vsock:[cid:]port" of an emulator
+        started with -ai-listen; compress asks a binary connection for
+        LZ4-compressed payloads"""
         self.socket_path = socket_path or self.DEFAULT_SOCKET
+        self.address = address
         self.sock = None
+        self.use_binary = binary or compress
+        self.compress = compress
+        self.binary = False
+        self._tag = 0
+        self._rbuf = bytearray()  # received, not yet parsed
+        self._next_id = 0
+        self._pending = {}  # id of a submit()ted command -> its reply, None until it comes
+        self.events = deque()  # pushed events received while awaiting replies
+        self._delta_screen = None  # screen rebuilt by screen_delta()
+        self._delta_frame = -1
+        self._state_image = None  # state file kept by state_get()/state_put()
+        self._state_id = 0
 
     def connect(self):
         """Connect to the emulator"""
-        self.sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
-        self.sock.connect(self.socket_path)
+        if self.address is None:
+            self.sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+            self.sock.connect(self.socket_path)
+        elif self.address.startswith("vsock:"):
+            parts = self.address.split(":")
+            cid = int(parts[1]) if len(parts) > 2 else socket.VMADDR_CID_HOST
+            self.sock = socket.socket(socket.AF_VSOCK, socket.SOCK_STREAM)
+            self.sock.connect((cid, int(parts[-1])))
+        else:
+            host, port = self.address.rsplit(":", 1)
+            self.sock = socket.create_connection((host.strip("[]") or "localhost", int(port)))
+            self.sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        self.binary = False
+        self._rbuf.clear()
+        self._pending.clear()
         # Verify connection
         response = self._send({"cmd": "ping"})
         if response.get("status") != "ok":
             raise ConnectionError("Failed to connect to emulator")
+        if self.use_binary:
+            self.set_binary(True)
         return self
 
     def disconnect(self):
@@ -92,6 +209,20 @@ class Atari800AI:
         if self.sock:
             self.sock.close()
             self.sock = None
+        self.binary = False
+
+    def set_binary(self, enabled: bool = True) -> bool:
+        """Switch this connection to (or from) the binary framed protocol"""
+        if enabled and not self.binary:
+            response = self._send({"cmd": "protocol", "mode": "binary",
+                                   "compress": "lz4" if self.compress else "none"})
+            if response.get("status") != "ok":
+                return False
+            self.binary = True
+        elif not enabled and self.binary:
+            self._send_binary(self.BIN_PROTOCOL_JSON)
+            self.binary = False
+        return True
 
     def __enter__(self):
         return self.connect()
@@ -99,47 +230,308 @@ class Atari800AI:
     def __exit__(self, exc_type, exc_val, exc_tb):
         self.disconnect()
 
+    RECV_SIZE = 1 << 16
+
+    def _fill(self) -> None:
+        """Receive what the socket has, waiting for at least a byte"""
+        chunk = self.sock.recv(self.RECV_SIZE)
+        if not chunk:
+            raise ConnectionError("Connection closed")
+        self._rbuf += chunk
+
+    def _readable(self, timeout: Optional[float]) -> bool:
+        """Is there something to read, buffered or on the socket?"""
+        return bool(self._rbuf) or bool(select.select([self.sock], [], [], timeout)[0])
+
+    def _recv_exact(self, length: int) -> bytes:
+        while len(self._rbuf) < length:
+            self._fill()
+        data = bytes(self._rbuf[:length])
+        del self._rbuf[:length]
+        return data
+
+    @staticmethod
+    def _debug_records(data: bytes) -> list:
+        """[frame, bytes] of each debug port record in data"""
+        records = []
+        pos = 0
+        while pos + 6 <= len(data):
+            frame, length = struct.unpack_from("<IH", data, pos)
+            records.append([frame, data[pos + 6:pos + 6 + length]])
+            pos += 6 + length
+        return records
+
+    def _decode_event(self, opcode: int, body: bytes) -> dict:
+        if opcode == self.BIN_EVENT_FRAME:
+            frame, dropped, pc, a, x, y, sp, p = struct.unpack("<IIHBBBBB", body[:15])
+            event = {"event": "frame", "frame": frame, "dropped": dropped,
+                     "pc": pc, "a": a, "x": x, "y": y, "sp": sp, "p": p}
+            naddrs = body[15]
+            if naddrs:
+                event["mem"] = list(body[16:16 + naddrs])
+            pos = 16 + naddrs
+            kind, length = struct.unpack("<BI", body[pos:pos + 5])
+            if kind == 1:
+                event["screen"] = body[pos + 5:pos + 5 + length]
+            elif kind == 2:
+                event["screen_delta"] = body[pos + 5:pos + 5 + length]
+            pos += 5 + length
+            if pos < len(body):
+                audio = body[pos]
+                pos += 1
+                if audio & 2:
+                    channels = body[pos]
+                    event["env"] = [list(struct.unpack_from("<HBB", body, pos + 1 + 4 * i))
+                                    for i in range(channels)]
+                    pos += 1 + 4 * channels
+                if audio & 1:
+                    rate, channels, sample_bytes, length = struct.unpack_from("<HBBI", body, pos)
+                    event["pcm"] = {"rate": rate, "channels": channels, "bits": sample_bytes * 8,
+                                    "data": body[pos + 8:pos + 8 + length]}
+                    pos += 8 + length
+            if pos < len(body):
+                event["debug_dropped"], length = struct.unpack_from("<II", body, pos)
+                event["debug"] = self._debug_records(body[pos + 8:pos + 8 + length])
+            return event
+        if opcode == self.BIN_EVENT_JSON:
+            return json.loads(body.decode("utf-8"))
+        return {"event": "unknown", "opcode": opcode, "data": body}
+
+    def _recv_binary(self):
+        """Read one binary frame: (opcode, status, tag, body)"""
+        magic, opcode, status, flags, tag, length = self.BIN_HEADER.unpack(
+            self._recv_exact(self.BIN_HEADER.size))
+        if magic != self.BIN_MAGIC:
+            raise ConnectionError("Binary protocol framing error")
+        body = self._recv_exact(length)
+        if flags & self.BIN_FLAG_LZ4:
+            body = lz4_block_decompress(body[4:], struct.unpack_from("<I", body)[0])
+        return opcode, status, tag, body
+
+    def _recv_json(self) -> dict:
+        """Read one length-prefixed JSON message"""
+        while True:
+            end = self._rbuf.find(b"\n")
+            if end >= 0:
+                break
+            self._fill()
+        length = int(self._rbuf[:end].decode('utf-8').strip())
+        del self._rbuf[:end + 1]
+        return json.loads(self._recv_exact(length).decode('utf-8'))
+
+    def _recv_message(self):
+        """Read one message; pushed events are returned as dicts,
+        binary responses as (opcode, status, tag, body)"""
+        if not self.binary:
+            return self._recv_json()
+        opcode, status, tag, body = self._recv_binary()
+        if tag == 0 and 0x40 <= opcode < self.BIN_PROTOCOL_JSON:
+            return self._decode_event(opcode, body)
+        return opcode, status, tag, body
+
+    def _send_binary(self, opcode: int, payload: bytes = b"") -> bytes:
+        """Send a binary frame and return the response payload"""
+        if not self.sock:
+            raise ConnectionError("Not connected to emulator")
+
+        self._tag = (self._tag % 0xFFFFFFFF) + 1  # tag 0 marks pushed events
+        header = self.BIN_HEADER.pack(self.BIN_MAGIC, opcode, 0, 0, self._tag, len(payload))
+        self.sock.sendall(header + payload)
+
+        while True:
+            msg = self._recv_message()
+            if self._stash(msg):
+                continue
+            r_opcode, status, tag, body = msg
+            if r_opcode != opcode or tag != self._tag:
+                raise ConnectionError("Binary protocol framing error")
+            if status != 0:
+                raise RuntimeError(body.decode("utf-8", "replace"))
+            return body
+
     def _send(self, cmd: dict) -> dict:
         """Send a command and receive response"""
         if not self.sock:
             raise ConnectionError("Not connected to emulator")
 
+        if self.binary:
+            body = self._send_binary(self.BIN_JSON, json.dumps(cmd).encode("utf-8"))
+            return json.loads(body.decode("utf-8"))
+
         # Send command with length prefix
         data = json.dumps(cmd).encode('utf-8')
         header = f"{len(data)}\n".encode('utf-8')
         self.sock.sendall(header + data)
 
-        # Receive response
-        # Read length prefix
-        header = b""
-        while not header.endswith(b"\n"):
-            c = self.sock.recv(1)
-            if not c:
-                raise ConnectionError("Connection closed")
-            header += c
-
-        length = int(header.decode('utf-8').strip())
+        # Pushed events may arrive ahead of the response
+        while True:
+            response = self._recv_json()
+            if not self._stash(response):
+                return response
+
+    def _stash(self, msg) -> bool:
+        """Keep a message that is not the reply being waited for: a pushed
+        event, or the reply to a submit()ted command"""
+        if isinstance(msg, tuple):
+            opcode, status, tag, body = msg
+            if not self._pending or opcode != self.BIN_JSON or status != 0:
+                return False
+            msg = json.loads(body.decode("utf-8"))
+            if msg.get("id") not in self._pending:
+                return False
+        if "event" in msg:
+            self.events.append(msg)
+            return True
+        if msg.get("id") in self._pending:
+            self._pending[msg["id"]] = msg
+            return True
+        return False
 
-        # Read response body
-        response = b""
-        while len(response) < length:
-            chunk = self.sock.recv(length - len(response))
-            if not chunk:
-                raise ConnectionError("Connection closed")
-            response += chunk
+    # === Pipelining ===
 
-        return json.loads(response.decode('utf-8'))
+    def submit(self, cmd: dict) -> int:
+        """Send a command without waiting for the reply; returns its id,
+        to get the reply with result(). Any number may be in flight."""
+        if not self.sock:
+            raise ConnectionError("Not connected to emulator")
+        self._next_id += 1
+        cmd = dict(cmd, id=self._next_id)
+        data = json.dumps(cmd).encode("utf-8")
+        if self.binary:
+            self._tag = (self._tag % 0xFFFFFFFF) + 1
+            self.sock.sendall(self.BIN_HEADER.pack(self.BIN_MAGIC, self.BIN_JSON, 0, 0,
+                                                   self._tag, len(data)) + data)
+        else:
+            self.sock.sendall(f"{len(data)}\n".encode("utf-8") + data)
+        self._pending[self._next_id] = None
+        return self._next_id
+
+    def result(self, req_id: int) -> dict:
+        """The reply to a submit()ted command, waiting for it"""
+        while self._pending.get(req_id) is None:
+            if req_id not in self._pending:
+                raise KeyError(req_id)
+            msg = self._recv_message()
+            if not self._stash(msg):
+                raise ConnectionError("Reply to no command in flight")
+        return self._pending.pop(req_id)
+
+    def done(self, req_id: int) -> bool:
+        """Has the reply to a submit()ted command come? Reads what has
+        arrived without waiting."""
+        while self._pending.get(req_id) is None and self._readable(0):
+            msg = self._recv_message()
+            if not self._stash(msg):
+                raise ConnectionError("Reply to no command in flight")
+        return self._pending.get(req_id) is not None
+
+    def pipeline(self, cmds: List[dict]) -> List[dict]:
+        """Send all the commands at once and return their replies in
+        order, for one round trip instead of one per command"""
+        ids = [self.submit(cmd) for cmd in cmds]
+        return [self.result(i) for i in ids]
 
     # === Control ===
 
-    def load(self, path: str) -> bool:
-        """Load a program (XEX, COM, BAS, etc.)"""
-        response = self._send({"cmd": "load", "path": path})
+    def load(self, path: str, boot_frames: int = 0,
+             direct: bool = False) -> bool:
+        """Load a program (XEX, COM, BAS, etc.)
+
+        With boot_frames, also run that many frames; the boot is kept in
+        the boot cache, so loading the same again restores it at once.
+        With direct, load an XEX into the running machine without
+        rebooting (the OS must be up, e.g. after reset(boot_frames=...))."""
+        cmd = {"cmd": "load", "path": path}
+        if boot_frames > 0:
+            cmd["boot_frames"] = boot_frames
+        if direct:
+            cmd["direct"] = True
+        response = self._send(cmd)
         return response.get("status") == "ok"
 
-    def run(self, frames: int = 1) -> dict:
-        """Run emulator for N frames"""
-        return self._send({"cmd": "run", "frames": frames})
+    RUN_STAGES = ("input", "antic", "pokey", "sound", "sync", "cpu", "ai", "record", "host")
+
+    def run(self, frames: int = 1, unthrottled: bool = False,
+            inputs: Optional[list] = None, timeline: Optional[list] = None) -> dict:
+        """Run emulator for N frames.
+
+        With unthrottled the run skips host speed and sound sync. The reply
+        has frames_run, cycles, wall_ms and per-stage host time in time_ms.
+        inputs is a list of per-frame dicts as input() takes them, the last
+        one holding for the rest of the run. timeline is a list of such
+        dicts with a "frame" of the run and a scan "line" each, in order,
+        applied at the start of that line."""
+        if inputs is not None or timeline is not None:
+            cmd = {"cmd": "run", "frames": frames, "unthrottled": unthrottled}
+            if inputs is not None:
+                cmd["inputs"] = inputs
+            if timeline is not None:
+                cmd["timeline"] = timeline
+            return self._send(cmd)
+        if self.binary:
+            body = self._send_binary(self.BIN_RUN, struct.pack("<IB", frames, int(unthrottled)))
+            size = 4 * (3 + len(self.RUN_STAGES))
+            fields = struct.unpack_from("<%dI" % (3 + len(self.RUN_STAGES)), body)
+            reply = {"status": "ok", "frames_run": fields[0], "cycles": fields[1],
+                     "wall_ms": fields[2] / 1000.0, "unthrottled": unthrottled,
+                     "time_ms": {name: us / 1000.0
+                                 for name, us in zip(self.RUN_STAGES, fields[3:])}}
+            if len(body) > size:
+                reply["features"] = list(struct.unpack_from("<%df" % ((len(body) - size) // 4), body, size))
+            return reply
+        return self._send({"cmd": "run", "frames": frames, "unthrottled": unthrottled})
+
+    def run_until(self, until: str, max_frames: int = 3600) -> dict:
+        """Run until a condition holds, e.g. "mem[$D4] != start || pc == $E459".
+
+        Returns fired, clause, frame and frames_run, plus pc_hit when a
+        pc clause fired."""
+        return self._send({"cmd": "run_until", "until": until, "max_frames": max_frames})
+
+    def render(self, mode: str = "always", every: int = 1) -> dict:
+        """Choose which frames are drawn: "always", "observed" or "every"
+        (every Nth frame). Skipped frames still run ANTIC and the CPU."""
+        return self._send({"cmd": "render", "mode": mode, "every": every})
+
+    def rewind_config(self, depth: Optional[int] = None,
+                      stride: Optional[int] = None) -> dict:
+        """Keep depth keyframes, one every stride frames, for rewind
+        (depth 0 turns it off). Without arguments, report the settings,
+        the oldest frame that can be rewound to and the memory used."""
+        cmd = {"cmd": "rewind_config"}
+        if depth is not None:
+            cmd["depth"] = depth
+        if stride is not None:
+            cmd["stride"] = stride
+        return self._send(cmd)
+
+    def rewind(self, frames: int = 1) -> dict:
+        """Go back N frames: restore the nearest keyframe and re-simulate
+        the rest with the recorded input. Returns frame, keyframe and
+        replayed."""
+        return self._send({"cmd": "rewind", "frames": frames})
+
+    def reverse_step(self, frames: int = 1) -> dict:
+        """Go back N frames, as rewind does"""
+        return self._send({"cmd": "reverse_step", "frames": frames})
+
+    def reverse_continue(self) -> dict:
+        """Go back to the end of the latest earlier frame in which a
+        breakpoint fired, within the rewind history. Returns found, frame
+        and the hit under "breakpoint"."""
+        response = self._send({"cmd": "reverse_continue"})
+        if response.get("status") != "ok":
+            raise RuntimeError(response.get("msg", "reverse_continue failed"))
+        return response
+
+    def last_write(self, addr: int) -> dict:
+        """The last change of the byte at addr within the rewind history:
+        found, and under "write" the storing pc, old and value, frame,
+        scanline and xpos. The machine ends up where it was."""
+        response = self._send({"cmd": "last_write", "addr": addr})
+        if response.get("status") != "ok":
+            raise RuntimeError(response.get("msg", "last_write failed"))
+        return response
 
     def step(self, instructions: int = 1) -> dict:
         """Single-step N CPU instructions"""
@@ -150,15 +542,213 @@ class Atari800AI:
         response = self._send({"cmd": "pause"})
         return response.get("status") == "ok"
 
-    def reset(self) -> bool:
-        """Cold reset the machine"""
-        response = self._send({"cmd": "reset"})
+    def reset(self, boot_frames: int = 0) -> bool:
+        """Cold reset the machine
+
+        With boot_frames, also run that many frames; the boot is kept in
+        the boot cache, so the same reset again restores it at once."""
+        cmd = {"cmd": "reset"}
+        if boot_frames > 0:
+            cmd["boot_frames"] = boot_frames
+        response = self._send(cmd)
         return response.get("status") == "ok"
 
+    def boot_cache(self, entries: Optional[int] = None,
+                   clear: bool = False) -> dict:
+        """Keep at most entries cached boots (0 turns the cache off) and
+        report the entries, bytes, hits and misses"""
+        cmd = {"cmd": "boot_cache", "clear": clear}
+        if entries is not None:
+            cmd["entries"] = entries
+        return self._send(cmd)
+
+    def quick_boot(self, enable: Optional[bool] = None,
+                   clear: bool = False) -> dict:
+        """Turn quick boot on or off: cold starts of a setup seen before
+        skip the OS's memory test and clearing. Reports the setups kept."""
+        cmd = {"cmd": "quick_boot", "clear": clear}
+        if enable is not None:
+            cmd["enable"] = enable
+        return self._send(cmd)
+
+    def batch(self, commands: List[dict], stop_on_error: bool = False) -> dict:
+        """Run several commands in one round-trip
+
+        Each entry is a command dict such as {"cmd": "peek", "addr": 0x80}.
+        A "run" entry is executed in place, so a whole agent step
+        (input, run, observe) fits in a single batch. Returns the batch
+        reply; its "results" list holds one reply per executed command.
+        """
+        return self._send({"cmd": "batch", "stop_on_error": stop_on_error,
+                           "commands": commands})
+
+    # === Clients ===
+
+    def role(self, role: str = None, exclusive: bool = False) -> dict:
+        """Declare this connection "controller" or "observer" (None just reports)"""
+        cmd = {"cmd": "role"}
+        if role:
+            cmd["role"] = role
+            cmd["exclusive"] = exclusive
+        return self._send(cmd)
+
+    def subscribe(self, every: int = 1, mode: str = "observe", screen: str = "none",
+                  addrs: List[int] = None, window: int = None, audio: str = "none",
+                  rate: int = None, quality: int = None, debug: bool = False) -> dict:
+        """Have a frame record pushed every N frames.
+
+        mode: "observe", "free" (free-run the machine) or "lockstep"
+        screen: "none", "full" or "delta"
+        addrs: memory addresses whose values each record carries
+        window: unacknowledged records allowed (see ack())
+        audio: "none", "pcm" (the frame's samples, base64 in JSON mode),
+               "env" ([hz, volume, AUDC >> 4] per POKEY channel) or "both"
+        rate: PCM sample rate in Hz (default: the output rate); records then
+              carry all samples converted since the previous one
+        quality: resampling filter, 0 (linear) to 3 (sharpest, default 2)
+        debug: records carry the debug port output since the last one, as
+               "debug": [[frame, bytes], ...] (base64 in JSON mode) and
+               "debug_dropped", the bytes the full ring turned away
+        """
+        cmd = {"cmd": "subscribe", "every": every, "mode": mode, "screen": screen,
+               "addrs": list(addrs or []), "audio": audio, "debug": debug}
+        if window is not None:
+            cmd["window"] = window
+        if rate is not None:
+            cmd["rate"] = rate
+        if quality is not None:
+            cmd["quality"] = quality
+        return self._send(cmd)
+
+    def unsubscribe(self) -> dict:
+        return self._send({"cmd": "unsubscribe"})
+
+    def ack(self, frame: int = None) -> bool:
+        """Acknowledge frame records up to frame (default: all received)"""
+        if self.binary:
+            self._send_binary(self.BIN_ACK, b"" if frame is None else struct.pack("<I", frame))
+            return True
+        cmd = {"cmd": "ack"}
+        if frame is not None:
+            cmd["frame"] = frame
+        return self._send(cmd).get("status") == "ok"
+
+    @staticmethod
+    def apply_screen_delta(screen: bytearray, delta: bytes, width: int = 384):
+        """Update a screen buffer in place from a frame record's screen_delta"""
+        if isinstance(delta, str):
+            delta = base64.b64decode(delta)
+        pos = 0
+        while pos < len(delta):
+            row, x, length = struct.unpack_from("<HHH", delta, pos)
+            pos += 6
+            start = row * width + x
+            screen[start:start + length] = delta[pos:pos + length]
+            pos += length
+
+    @staticmethod
+    def apply_state_delta(base: bytes, delta: bytes) -> bytes:
+        """The state file a state_get delta makes of base"""
+        size = struct.unpack_from("<I", delta, 8)[0]
+        image = bytearray(base[:size]) + bytes(max(0, size - len(base)))
+        pos = 12
+        while pos < len(delta):
+            page, count = struct.unpack_from("<IH", delta, pos)
+            pos += 6
+            start = page * 256
+            length = min(count * 256, size - start)
+            image[start:start + length] = delta[pos:pos + length]
+            pos += length
+        return bytes(image)
+
+    @staticmethod
+    def make_state_delta(base: bytes, base_id: int, image: bytes) -> bytes:
+        """A delta for state_put: the 256-byte pages of image that differ
+        from base, the state with id base_id"""
+        base = base[:len(image)] + bytes(max(0, len(image) - len(base)))
+        out = bytearray(b"A8SD" + struct.pack("<II", base_id, len(image)))
+        pages = (len(image) + 255) // 256
+        page = 0
+        while page < pages:
+            if image[page * 256:page * 256 + 256] == base[page * 256:page * 256 + 256]:
+                page += 1
+                continue
+            first = page
+            while (page < pages and page - first < 0xffff
+                   and image[page * 256:page * 256 + 256] != base[page * 256:page * 256 + 256]):
+                page += 1
+            out += struct.pack("<IH", first, page - first) + image[first * 256:page * 256]
+        return bytes(out)
+
+    def next_event(self, timeout: Optional[float] = None) -> Optional[dict]:
+        """Return the next pushed event, waiting up to timeout seconds"""
+        if self.events:
+            return self.events.popleft()
+        # Wait for the start of a message, then read all of it
+        if not self._readable(timeout):
+            return None
+        msg = self._recv_message()
+        return msg if isinstance(msg, dict) else None
+
+    # === Lockstep ===
+
+    def lockstep_join(self, port: int, players: int = 2, timeout_ms: int = 0,
+                      default: str = "centre", frames: int = 1,
+                      addrs: List[int] = None) -> dict:
+        """Play joystick port in a lockstep episode. The first player sets
+        it up: how many players, how long a step waits for their actions
+        (0 = for ever), what a late player does ("centre" or "repeat" its
+        last action), frames per step and the addresses each step event
+        carries. Once all have joined, every step is pushed to all of them
+        as a {"event": "step", ...} (see next_step)."""
+        cmd = {"cmd": "lockstep_join", "port": port, "players": players,
+               "timeout_ms": timeout_ms, "default": default, "frames": frames,
+               "addrs": list(addrs or [])}
+        response = self._send(cmd)
+        if response.get("status") != "ok":
+            raise RuntimeError(response.get("msg", "lockstep_join failed"))
+        return response
+
+    def act(self, direction: str = "center", fire: bool = False, step: int = None) -> bool:
+        """This player's action for the next step; with step (from the
+        last step event) an action that comes too late is refused rather
+        than applied to the step after"""
+        cmd = {"cmd": "act", "direction": direction, "fire": fire}
+        if step is not None:
+            cmd["step"] = step
+        return self._send(cmd).get("status") == "ok"
+
+    def next_step(self, timeout: Optional[float] = None) -> Optional[dict]:
+        """Wait for the next step (or lockstep_end) event, keeping other
+        events queued"""
+        deadline = None if timeout is None else time.time() + timeout
+        for i, event in enumerate(self.events):
+            if event.get("event") in ("step", "lockstep_end"):
+                del self.events[i]
+                return event
+        while True:
+            left = None if deadline is None else max(0.0, deadline - time.time())
+            if not self._readable(left):
+                return None
+            msg = self._recv_message()
+            if not isinstance(msg, dict):
+                continue
+            if msg.get("event") in ("step", "lockstep_end"):
+                return msg
+            self.events.append(msg)
+
+    def lockstep_leave(self) -> dict:
+        """Leave the episode, which ends it for every player"""
+        return self._send({"cmd": "lockstep_leave"})
+
     # === Input ===
 
+
     def key(self, code: int, shift: bool = False) -> bool:
         """Press a key"""
+        if self.binary:
+            self._send_binary(self.BIN_KEY, struct.pack("<hB", code, 1 if shift else 0))
+            return True
         response = self._send({"cmd": "key", "code": code, "shift": shift})
         return response.get("status") == "ok"
 
@@ -189,17 +779,25 @@ class Atari800AI:
         return False
 
     def type_string(self, text: str, frame_delay: int = 5) -> bool:
-        """Type a string of characters"""
-        for char in text:
-            if not self.type_char(char):
-                continue
-            self.run(frames=frame_delay)
-            self.key_release()
-            self.run(frames=2)
-        return True
+        """Type a string of characters. The emulator presses the keys as
+        fast as the OS takes them; frame_delay is no longer used."""
+        return self.type(text).get("status") == "ok"
+
+    def type(self, text: str, max_frames: Optional[int] = None,
+             unthrottled: bool = False) -> dict:
+        """Type text and run until the program has taken the last key, or
+        max_frames. Returns typed, keys and frames_run."""
+        cmd = {"cmd": "type", "text": text, "unthrottled": unthrottled}
+        if max_frames is not None:
+            cmd["max_frames"] = max_frames
+        return self._send(cmd)
 
     def joystick(self, port: int = 0, direction: str = "center", fire: bool = False) -> bool:
         """Set joystick state"""
+        if self.binary:
+            stick = self.STICK_VALUES.get(direction, 15)
+            self._send_binary(self.BIN_JOYSTICK, bytes([port, stick, 1 if fire else 0]))
+            return True
         response = self._send({
             "cmd": "joystick",
             "port": port,
@@ -209,10 +807,31 @@ class Atari800AI:
         return response.get("status") == "ok"
 
     def paddle(self, port: int = 0, value: int = 128) -> bool:
-        """Set paddle position (0-228)"""
+        """Set pot 0-7 to 0-228 until set again, -1 to release it. On the
+        5200 pots 2i and 2i+1 are controller i's stick x and y."""
         response = self._send({"cmd": "paddle", "port": port, "value": value})
         return response.get("status") == "ok"
 
+    def input(self, joy: Optional[List[int]] = None, fire: Optional[List[bool]] = None,
+              pots: Optional[List[int]] = None, key: Optional[int] = None,
+              fire2: Optional[bool] = None) -> bool:
+        """Set all controllers at once, e.g. the 5200's: joy is 4 stick
+        values (15 centre), fire 4 triggers, pots 8 values 0-228 (-1 for
+        none), key an AKEY code (-1 for none) and fire2 the 5200's second
+        button. Groups left as None keep their state."""
+        cmd = {"cmd": "input"}
+        if joy is not None:
+            cmd["joy"] = list(joy)
+        if fire is not None:
+            cmd["fire"] = [int(bool(f)) for f in fire]
+        if pots is not None:
+            cmd["pots"] = list(pots)
+        if key is not None:
+            cmd["key"] = key
+        if fire2 is not None:
+            cmd["fire2"] = fire2
+        return self._send(cmd).get("status") == "ok"
+
     def consol(self, start: bool = False, select: bool = False, option: bool = False) -> bool:
         """Press console keys"""
         response = self._send({
@@ -225,45 +844,263 @@ class Atari800AI:
 
     # === Screen ===
 
-    def screenshot(self, path: str = None) -> str:
-        """Save screenshot to file, returns path"""
+    def screenshot(self, path: str = None, level: int = None) -> str:
+        """Save screenshot to file, returns path. level is the zlib
+        compression level (0-9), the emulator's -compression-level if None"""
         cmd = {"cmd": "screenshot"}
         if path:
             cmd["path"] = path
+        if level is not None:
+            cmd["level"] = level
         response = self._send(cmd)
         return response.get("path", "")
 
-    def screen_ascii(self) -> List[str]:
-        """Get screen as ASCII art (40x24 lines)"""
-        response = self._send({"cmd": "screen_ascii"})
+    def screenshot_data(self, format: str = "png", level: int = None) -> bytes:
+        """Get a screenshot's file contents, "png" (the emulator needs
+        libpng) or "pcx", without writing a file. Pixels are palette
+        indices holding the Atari colour numbers."""
+        if self.binary:
+            payload = bytes([255 if level is None else level, 1 if format == "pcx" else 0])
+            return self._send_binary(self.BIN_SCREENSHOT, payload)
+        cmd = {"cmd": "screenshot", "inline": True, "format": format}
+        if level is not None:
+            cmd["level"] = level
+        response = self._send(cmd)
+        if response.get("status") != "ok":
+            raise RuntimeError(response.get("msg", "screenshot failed"))
+        return base64.b64decode(response.get("data", ""))
+
+    def screen_ascii(self, pixels: bool = False, text80: bool = True) -> List[str]:
+        """Get the text of an enabled 80 column card (unless text80 is
+        False) or of the screen's character mode lines, or a 40x24 ASCII
+        sketch of it for graphics screens or with pixels"""
+        cmd = {"cmd": "screen_ascii"}
+        if pixels:
+            cmd["pixels"] = True
+        if not text80:
+            cmd["text80"] = False
+        response = self._send(cmd)
         return response.get("data", [])
 
     def screen_raw(self) -> bytes:
         """Get raw screen buffer (384x240 bytes, Atari color codes)"""
+        if self.binary:
+            body = self._send_binary(self.BIN_SCREEN_RAW)
+            return body[4:]
         response = self._send({"cmd": "screen_raw"})
         data = response.get("data", "")
         return base64.b64decode(data) if data else b""
 
+    def screen_delta(self) -> bytes:
+        """Get the raw screen, transferring only what changed since the
+        last call on this connection"""
+        base = self._delta_frame if self._delta_screen is not None else -1
+        if self.binary:
+            body = self._send_binary(self.BIN_SCREEN_DELTA, struct.pack("<i", base))
+            frame, kind = struct.unpack("<IB", body[:5])
+            data = body[5:]
+            full = kind == 1
+        else:
+            resp = self._send({"cmd": "screen_delta", "base": base})
+            frame, full = resp["frame"], resp["full"]
+            data = base64.b64decode(resp["data"])
+        if full:
+            self._delta_screen = bytearray(data)
+        else:
+            self.apply_screen_delta(self._delta_screen, data)
+        self._delta_frame = frame
+        return bytes(self._delta_screen)
+
+    def observation(self, width: int = 84, height: int = 84, format: str = "gray",
+                    crop: tuple = None) -> bytes:
+        """Get the screen cropped (default: visible area) and resized to
+        width x height; format "gray" (luma) or "index" (Atari colours)"""
+        if self.binary:
+            payload = struct.pack("<HHB", width, height, 1 if format == "index" else 0)
+            if crop:
+                payload += struct.pack("<HHHH", *crop)
+            return self._send_binary(self.BIN_OBSERVATION, payload)[5:]
+        cmd = {"cmd": "observation", "width": width, "height": height, "format": format}
+        if crop:
+            cmd["crop"] = list(crop)
+        resp = self._send(cmd)
+        if resp.get("status") != "ok":
+            raise RuntimeError(resp.get("msg"))
+        return base64.b64decode(resp["data"])
+
+    def hashes(self) -> tuple:
+        """64-bit hashes (screen, state) of the visible screen and of the
+        machine state, for telling whether either was seen before"""
+        if self.binary:
+            return struct.unpack("<QQ", self._send_binary(self.BIN_HASH))
+        resp = self._send({"cmd": "hash"})
+        if resp.get("status") != "ok":
+            raise RuntimeError(resp.get("msg"))
+        return int(resp["screen"], 16), int(resp["state"], 16)
+
     def print_screen(self):
         """Print screen to console"""
         lines = self.screen_ascii()
-        print("+" + "-" * 40 + "+")
+        width = max((len(line) for line in lines), default=40)
+        print("+" + "-" * width + "+")
         for line in lines:
-            print("|" + line + "|")
-        print("+" + "-" * 40 + "+")
+            print("|" + line.ljust(width) + "|")
+        print("+" + "-" * width + "+")
 
     # === Memory ===
 
     def peek(self, addr: int, length: int = 1) -> List[int]:
         """Read memory"""
+        if self.binary:
+            return list(self.peek_bytes(addr, length))
         response = self._send({"cmd": "peek", "addr": addr, "len": length})
         return response.get("data", [])
 
-    def poke(self, addr: int, data: Union[int, List[int]]) -> bool:
+    def peek_bytes(self, addr: int, length: int = 1) -> bytes:
+        """Read memory as raw bytes (binary protocol, no 256-byte limit)"""
+        if not self.binary:
+            return bytes(self.peek(addr, length))
+        return self._send_binary(self.BIN_PEEK, struct.pack("<HI", addr & 0xFFFF, length))
+
+    def peek_multi(self, ranges: List[tuple]) -> List[bytes]:
+        """Read several (addr, length) ranges in one request, returns the
+        bytes of each range"""
+        if self.binary:
+            data = self._send_binary(self.BIN_PEEK_MULTI, b"".join(
+                struct.pack("<HI", addr & 0xFFFF, length) for addr, length in ranges))
+        else:
+            response = self._send({"cmd": "peek_multi",
+                                   "ranges": [[addr, length] for addr, length in ranges]})
+            if response.get("status") != "ok":
+                raise RuntimeError(response.get("msg", "peek_multi failed"))
+            data = base64.b64decode(response.get("data", ""))
+        out, pos = [], 0
+        for _, length in ranges:
+            out.append(data[pos:pos + length])
+            pos += length
+        return out
+
+    BANK_KINDS = {"xe": 0, "axlon": 1, "mosaic": 2}
+
+    def peek_bank(self, bank: int, offset: int = 0, length: int = 1, kind: str = "xe") -> bytes:
+        """Read from an extended memory bank ("xe", "axlon" or "mosaic")
+        without switching it in; XE bank 0 is the base RAM at $4000"""
+        if self.binary:
+            return self._send_binary(self.BIN_PEEK_BANK, struct.pack(
+                "<BHHI", self.BANK_KINDS[kind], bank, offset, length))
+        response = self._send({"cmd": "peek_bank", "kind": kind, "bank": bank,
+                               "addr": offset, "len": length})
+        if response.get("status") != "ok":
+            raise RuntimeError(response.get("msg", "peek_bank failed"))
+        return base64.b64decode(response.get("data", ""))
+
+    def disasm(self, addr: Optional[int] = None, count: Optional[int] = None,
+               end: Optional[int] = None) -> List[tuple]:
+        """Disassemble count instructions (24 if neither count nor end is
+        given) from addr (default the PC), or every one starting up to end,
+        as (addr, bytes, mnemonic, operand, target, label) with target and
+        label None where there are none"""
+        if count is None and end is None:
+            count = 24
+        out: List[tuple] = []
+        while True:
+            cmd: Dict[str, Any] = {"cmd": "disasm"}
+            if addr is not None:
+                cmd["addr"] = addr
+            if count is not None:
+                cmd["count"] = count - len(out)
+            if end is not None:
+                cmd["end"] = end
+            response = self._send(cmd)
+            if response.get("status") != "ok":
+                raise RuntimeError(response.get("msg", "disasm failed"))
+            out.extend((a, bytes.fromhex(b), m, o, t, l) for a, b, m, o, t, l in response["insns"])
+            addr = response["next"]
+            # A reply holds as many as fit: go on from where it stopped
+            if (response["count"] == 0 or addr > 0xFFFF or (count is not None and len(out) >= count)
+                    or (end is not None and addr > end)):
+                return out
+
+    def monitor(self, commands: List[str]) -> Dict[str, Any]:
+        """Run monitor command lines (as typed at its prompt: "DLIST",
+        "STACK", "D 2000", "A 600" followed by its instructions and an
+        empty line) on the paused machine. Returns the reply: "results",
+        a {"line", "command", "output"} for each command run, and "ended",
+        "done", or "resumed" or "quit" if CONT, COLDSTART, WARMSTART or
+        QUIT stopped the list."""
+        response = self._send({"cmd": "monitor", "commands": list(commands)})
+        if response.get("status") != "ok":
+            raise RuntimeError(response.get("msg", "monitor failed"))
+        return response
+
+    def search_start(self, space: str = "cpu", value: Optional[int] = None) -> int:
+        """Start a memory search over "cpu" (the 64 KB the CPU sees) or the
+        "xe", "axlon" or "mosaic" banks; every byte is a candidate, or
+        with value each equal to it. Returns the number of candidates."""
+        cmd = {"cmd": "search_start", "space": space}
+        if value is not None:
+            cmd["value"] = value
+        response = self._send(cmd)
+        if response.get("status") != "ok":
+            raise RuntimeError(response.get("msg", "search_start failed"))
+        return response["count"]
+
+    def search(self, op: str, value: Optional[int] = None) -> int:
+        """Keep the candidates whose byte is "equal", "not_equal", "less"
+        or "greater" than value, or has "changed", stayed "unchanged",
+        "increased" or "decreased" since the previous step. Returns the
+        number left."""
+        cmd = {"cmd": "search", "op": op}
+        if value is not None:
+            cmd["value"] = value
+        response = self._send(cmd)
+        if response.get("status") != "ok":
+            raise RuntimeError(response.get("msg", "search failed"))
+        return response["count"]
+
+    def search_list(self, first: int = 0, limit: int = 256) -> list:
+        """The candidates' addresses, or (bank, offset) in a banked space"""
+        response = self._send({"cmd": "search_list", "first": first, "limit": limit})
+        if response.get("status") != "ok":
+            raise RuntimeError(response.get("msg", "search_list failed"))
+        return [tuple(m) if isinstance(m, list) else m for m in response["matches"]]
+
+    def discover_start(self, frames: int = 600) -> int:
+        """Record RAM at the end of each of the last frames frames, for
+        discover(). Returns the bytes set aside."""
+        response = self._send({"cmd": "discover_start", "frames": frames})
+        if response.get("status") != "ok":
+            raise RuntimeError(response.get("msg", "discover_start failed"))
+        return response["bytes"]
+
+    def discover(self, events: Union[List[int], Dict[str, List[int]]],
+                 window: int = 0, top: int = 16) -> Union[list, Dict[str, list]]:
+        """Rank RAM addresses by how the recorded frames in which they
+        changed match the frames at which events happened. Given a dict of
+        label -> frames, ranks for each label."""
+        if isinstance(events, dict):
+            return {label: self.discover(frames, window, top)
+                    for label, frames in events.items()}
+        response = self._send({"cmd": "discover", "events": list(events),
+                               "window": window, "top": top})
+        if response.get("status") != "ok":
+            raise RuntimeError(response.get("msg", "discover failed"))
+        return response["results"]
+
+    def discover_stop(self) -> None:
+        self._send({"cmd": "discover_stop"})
+
+    def poke(self, addr: int, data: Union[int, List[int], bytes]) -> bool:
         """Write memory"""
         if isinstance(data, int):
             data = [data]
-        response = self._send({"cmd": "poke", "addr": addr, "data": data})
+        if self.binary:
+            self._send_binary(self.BIN_POKE, struct.pack("<H", addr & 0xFFFF) + bytes(data))
+            return True
+        # Longer writes go as base64, which the server decodes in bulk
+        data = bytes(data)
+        payload = base64.b64encode(data).decode("ascii") if len(data) > 16 else list(data)
+        response = self._send({"cmd": "poke", "addr": addr, "data": payload})
         return response.get("status") == "ok"
 
     def dump(self, start: int, end: int, path: str) -> int:
@@ -271,10 +1108,34 @@ class Atari800AI:
         response = self._send({"cmd": "dump", "start": start, "end": end, "path": path})
         return response.get("bytes", 0)
 
+    def watch(self, addr: int, length: int = 1, enabled: bool = True) -> int:
+        """Watch (or stop watching) length bytes from addr for changes made
+        by CPU stores. Returns the number of addresses watched; a run_until
+        condition of "changed" stops when one of them changes."""
+        response = self._send({"cmd": "watch", "addr": addr, "len": length, "enabled": enabled})
+        if response.get("status") != "ok":
+            raise RuntimeError(response.get("msg", "watch failed"))
+        return response.get("count", 0)
+
+    def clear_watches(self) -> None:
+        """Stop watching every address and drop the recorded changes"""
+        self._send({"cmd": "watch", "clear": True})
+
+    def watch_read(self) -> tuple:
+        """Fetch and clear the recorded changes, returns (changes, dropped)
+        where each change is (addr, old, new, frame, scanline, xpos)"""
+        response = self._send({"cmd": "watch_read"})
+        return ([tuple(c) for c in response.get("changes", [])], response.get("dropped", 0))
+
     # === CPU ===
 
     def cpu(self) -> dict:
         """Get CPU state"""
+        if self.binary:
+            pc, a, x, y, sp, p = struct.unpack("<HBBBBB", self._send_binary(self.BIN_CPU))
+            flags = {name: (p >> bit) & 1 for name, bit in
+                     (("n", 7), ("v", 6), ("b", 4), ("d", 3), ("i", 2), ("z", 1), ("c", 0))}
+            return dict(status="ok", pc=pc, a=a, x=x, y=y, sp=sp, p=p, **flags)
         return self._send({"cmd": "cpu"})
 
     def cpu_set(self, **kwargs) -> bool:
@@ -290,6 +1151,20 @@ class Atari800AI:
         """Get ANTIC chip state"""
         return self._send({"cmd": "antic"})
 
+    def cycles(self, clear: bool = False) -> dict:
+        """Machine cycles of the last frame ("last") and their mean per
+        frame since the last clear ("mean"): total, cpu (idle of it),
+        dma, wsync, and the dlis, vbis and irqs taken"""
+        return self._send({"cmd": "cycles", "clear": clear})
+
+    def display_list(self, since: Optional[int] = None) -> dict:
+        """Display list of the last frame as [addr, ir, ypos, lines, operand]
+        entries; with since, entries are left out if the generation is the same"""
+        cmd = {"cmd": "display_list"}
+        if since is not None:
+            cmd["since"] = since
+        return self._send(cmd)
+
     def gtia(self) -> dict:
         """Get GTIA chip state"""
         return self._send({"cmd": "gtia"})
@@ -302,11 +1177,252 @@ class Atari800AI:
         """Get PIA chip state"""
         return self._send({"cmd": "pia"})
 
+    def netsio_stats(self, clear: bool = False) -> dict:
+        """Report the NetSIO sync round trips: counts, timeouts, mean and
+        max latency and a log2 histogram in microseconds"""
+        return self._send({"cmd": "netsio", "clear": clear})
+
     # === Debug ===
 
-    def debug_enable(self, addr: int = 0xD7FF) -> bool:
-        """Enable debug output port at address"""
-        response = self._send({"cmd": "debug_enable", "addr": addr})
+    def breakpoint(self, addr: int, enabled: bool = True,
+                   condition: Optional[str] = None) -> int:
+        """Set or clear a breakpoint on the instruction at addr. A run that
+        hits one stops at the end of that frame and a {"event":
+        "breakpoint", "addr", "frame", "scanline", "xpos"} event arrives
+        ahead of its reply. condition, in the syntax of the monitor's B
+        command (such as "A=0 SETC" or "X>10 OR MEM:00D4=FF"), must hold
+        too. Returns the number of breakpoints set."""
+        cmd = {"cmd": "breakpoint", "addr": addr, "enabled": enabled}
+        if condition is not None:
+            cmd["condition"] = condition
+        response = self._send(cmd)
+        if response.get("status") != "ok":
+            raise RuntimeError(response.get("msg", "breakpoint failed"))
+        return response.get("count", 0)
+
+    def clear_breakpoints(self) -> None:
+        """Remove every breakpoint"""
+        self._send({"cmd": "breakpoint", "clear": True})
+
+    def logpoint(self, addr: int, write: bool = False, log: bool = True,
+                 peek: Optional[int] = None, condition: Optional[str] = None,
+                 enabled: bool = True) -> int:
+        """Count each run of the instruction at addr, or with write=True
+        each store to addr, without stopping; with log=True record each
+        hit with the registers and the byte stored, or the byte at peek.
+        condition is as for breakpoint. Returns the number of logpoints."""
+        cmd = {"cmd": "logpoint", "addr": addr, "write": write, "log": log, "enabled": enabled}
+        if peek is not None:
+            cmd["peek"] = peek
+        if condition is not None:
+            cmd["condition"] = condition
+        response = self._send(cmd)
+        if response.get("status") != "ok":
+            raise RuntimeError(response.get("msg", "logpoint failed"))
+        return response.get("count", 0)
+
+    def clear_logpoints(self) -> None:
+        """Remove every logpoint and the hits recorded"""
+        self._send({"cmd": "logpoint", "clear": True})
+
+    def set_features(self, features: list) -> int:
+        """Compute values from memory at the end of every run(), returned
+        in its reply as "features". Each is a dict with kind ("byte",
+        "sbyte", "word", "word_be", "bcd", "bcd_le" or "bit"), addr and
+        optionally len (BCD bytes), mask, delta (the change since the
+        previous evaluation) and scale, e.g.
+        {"kind": "bcd", "addr": 0x2000, "len": 3, "delta": True}.
+        An empty list removes them. Returns how many are set."""
+        response = self._send({"cmd": "features", "set": features})
+        if response.get("status") != "ok":
+            raise RuntimeError(response.get("msg", "features failed"))
+        return response.get("count", 0)
+
+    def features(self) -> list:
+        """Evaluate the features now"""
+        return self._send({"cmd": "features"}).get("features", [])
+
+    def logpoint_read(self, reset: bool = False) -> tuple:
+        """Returns ({(addr, write): count}, hits, dropped), fetching and
+        clearing the hits recorded, each (addr, pc, frame, scanline, xpos,
+        a, x, y, s, p, value); reset zeroes the counts"""
+        response = self._send({"cmd": "logpoint_read", "reset": reset})
+        counts = {(a, w): n for a, w, n in response.get("counters", [])}
+        return counts, [tuple(r) for r in response.get("log", [])], response.get("dropped", 0)
+
+    def profile_start(self, reset: bool = True, host_time: bool = False) -> None:
+        """Start counting instructions and cycles by PC and opcode; with
+        reset=False the new counts add to the previous ones. The CPU runs
+        its slower tracing loop until profile_stop(). host_time also times
+        each instruction on the host, for what is expensive to emulate."""
+        self._send({"cmd": "profile_start", "reset": reset, "host_time": host_time})
+
+    def profile_stop(self) -> None:
+        """Stop profiling, keeping the counts for profile_dump()"""
+        self._send({"cmd": "profile_stop"})
+
+    def coverage_start(self, clear: bool = True) -> None:
+        """Mark the address of every instruction run until coverage_stop();
+        clear=False keeps those marked before"""
+        self._send({"cmd": "coverage_start", "clear": clear})
+
+    def coverage_stop(self) -> None:
+        self._send({"cmd": "coverage_stop"})
+
+    def coverage(self, clear: bool = False) -> tuple:
+        """(count, bitmap): the number of addresses run and an 8192-byte
+        bitmap of them, address a in bit a & 7 of byte a >> 3; clear=True
+        starts again from none"""
+        if self.binary:
+            body = self._send_binary(self.BIN_COVERAGE, bytes([1 if clear else 0]))
+            return struct.unpack("<I", body[:4])[0], body[4:]
+        response = self._send({"cmd": "coverage", "clear": clear})
+        if response.get("status") != "ok":
+            raise RuntimeError(response.get("msg", "coverage failed"))
+        return response["count"], base64.b64decode(response["bitmap"])
+
+    def heatmap_start(self, clear: bool = True) -> None:
+        """Count the executions, reads and writes of every address, and of
+        every extended RAM byte, until heatmap_stop(); clear=False counts on
+        from the last counts"""
+        self._send({"cmd": "heatmap_start", "clear": clear})
+
+    def heatmap_stop(self) -> None:
+        self._send({"cmd": "heatmap_stop"})
+
+    @staticmethod
+    def _varints(data: bytes) -> List[int]:
+        values, v, shift = [], 0, 0
+        for b in data:
+            v |= (b & 0x7F) << shift
+            shift += 7
+            if not b & 0x80:
+                values.append(v)
+                v, shift = 0, 0
+        return values
+
+    def heatmap(self, kind: str = "read", bank: Optional[str] = None) -> List[int]:
+        """The counters of kind ("read", "write" or "exec") for the 64 KB,
+        or with bank ("xe", "axlon", "mosaic") for every bank of that
+        memory one after the other"""
+        maps = {None: 0, "xe": 1, "axlon": 2, "mosaic": 3}
+        if self.binary:
+            body = self._send_binary(self.BIN_HEATMAP,
+                                     bytes([["read", "write", "exec"].index(kind), maps[bank]]))
+            return self._varints(body[12:])
+        counts, start = [], 0
+        while True:
+            response = self._send({"cmd": "heatmap", "kind": kind, "bank": bank or "",
+                                   "start": start})
+            if response.get("status") != "ok":
+                raise RuntimeError(response.get("msg", "heatmap failed"))
+            counts += self._varints(base64.b64decode(response["counts"]))
+            if not response["more"]:
+                return counts
+            start += response["length"]
+
+    def history_start(self, entries: int = 1 << 20, branches: bool = False) -> int:
+        """Keep the last entries instructions (a power of two, up to 2**26),
+        or with branches=True only those that do not follow on from the
+        one before. Returns the entries the ring holds."""
+        response = self._send({"cmd": "history_start", "entries": entries, "branches": branches})
+        if response.get("status") != "ok":
+            raise RuntimeError(response.get("msg", "history_start failed"))
+        return response["entries"]
+
+    def history_stop(self) -> None:
+        self._send({"cmd": "history_stop"})
+
+    def history(self, last: Optional[int] = None) -> List[tuple]:
+        """The newest last instructions recorded (all of them on a binary
+        connection, else at most 65536), oldest first, as (pc, from_pc,
+        opcode bytes, xpos, ypos)"""
+        if self.binary:
+            body = self._send_binary(self.BIN_HISTORY,
+                                     struct.pack("<I", last) if last is not None else b"")
+            data = body[8:]
+        else:
+            cmd = {"cmd": "history"}
+            if last is not None:
+                cmd["last"] = last
+            response = self._send(cmd)
+            if response.get("status") != "ok":
+                raise RuntimeError(response.get("msg", "history failed"))
+            data = base64.b64decode(response.get("records", ""))
+        return list(struct.iter_unpack("<HH3sBH", data))
+
+    def profile_dump(self, top: int = 20, csv: bool = False, routines: int = 0,
+                     labels: Optional[str] = None) -> dict:
+        """Return the profile: frames, insns, cycles, the top PCs by cycles
+        as [pc, count, cycles] (or a "csv" table), per-opcode counts in
+        "opcodes" and cycles per 4 KB page in "pages". A host_time profile
+        adds host_ns to each PC and sorts by it. routines > 0 adds the
+        hottest routines by the monitor's labels, loaded from the labels
+        file if given, as [name, addr, count, cycles, host_ns]."""
+        cmd = {"cmd": "profile_dump", "top": top, "format": "csv" if csv else "json"}
+        if routines:
+            cmd["routines"] = routines
+        if labels:
+            cmd["labels"] = labels
+        return self._send(cmd)
+
+    def trace_start(self, path: str) -> None:
+        """Write a binary record of every instruction to path until
+        trace_stop(); tools/trace_decode prints it as text"""
+        response = self._send({"cmd": "trace_start", "path": path})
+        if response.get("status") != "ok":
+            raise RuntimeError(response.get("msg", "trace_start failed"))
+
+    def trace_stop(self) -> dict:
+        """Finish the trace file; returns records, stalls (waits for the
+        writer) and error"""
+        return self._send({"cmd": "trace_stop"})
+
+    def trace_status(self) -> dict:
+        """Whether a trace is being written, and its records so far"""
+        return self._send({"cmd": "trace_status"})
+
+    def timeline_start(self, path: str, events: int = 0) -> None:
+        """Record a timeline of each thread's work (frames, stages, CPU
+        runs, commands, sound callbacks, recording jobs, NetSIO packets),
+        keeping the last events spans per thread (0 = the default), until
+        timeline_stop() writes it to path as Chrome trace JSON"""
+        response = self._send({"cmd": "timeline_start", "path": path, "events": events})
+        if response.get("status") != "ok":
+            raise RuntimeError(response.get("msg", "timeline_start failed"))
+
+    def timeline_stop(self) -> dict:
+        """Write the timeline file; returns spans, dropped (overwritten
+        in the rings) and error"""
+        return self._send({"cmd": "timeline_stop"})
+
+    def timeline_status(self) -> dict:
+        """Whether a timeline is being recorded, and its spans so far"""
+        return self._send({"cmd": "timeline_status"})
+
+    def stats(self, enable: Optional[bool] = None, clear: bool = False,
+              counters: Optional[bool] = None) -> dict:
+        """Performance counters: frame timing by stage (mean_us, max_us
+        and a log2 histogram for the whole frame and each stage), the
+        frame rate and CPU ms per frame since the last call, frames
+        skipped, socket bytes, command times, sound buffer fill and the
+        recording queue. enable turns frame timing on or off; counters the
+        hardware counters per stage ("hw_counters"); clear zeroes the
+        counts after the reply."""
+        cmd = {"cmd": "stats", "clear": clear}
+        if enable is not None:
+            cmd["enable"] = enable
+        if counters is not None:
+            cmd["counters"] = counters
+        return self._send(cmd)
+
+    def debug_enable(self, addr: int = 0xD7FF, size: int = None) -> bool:
+        """Enable debug output port at address, kept in a ring of size
+        bytes (default 65536; a new size empties it)"""
+        cmd = {"cmd": "debug_enable", "addr": addr}
+        if size is not None:
+            cmd["size"] = size
+        response = self._send(cmd)
         return response.get("status") == "ok"
 
     def debug_read(self) -> tuple:
@@ -314,18 +1430,289 @@ class Atari800AI:
         response = self._send({"cmd": "debug_read"})
         return (response.get("data", []), response.get("ascii", ""))
 
+    def debug_records(self) -> dict:
+        """Take the debug port records out of the ring: "records" is
+        [[frame, bytes], ...]; "dropped" and "written" count bytes since
+        the ring was sized, and "more" tells that records are left"""
+        response = self._send({"cmd": "debug_read"})
+        data = bytes(response.get("data", []))
+        records = []
+        pos = 0
+        for frame, length in response.get("records", []):
+            records.append([frame, data[pos:pos + length]])
+            pos += length
+        return {"records": records, "dropped": response.get("dropped", 0),
+                "written": response.get("written", 0), "more": response.get("more", False)}
+
     # === State ===
 
-    def save_state(self, path: str) -> bool:
-        """Save emulator state"""
-        response = self._send({"cmd": "save_state", "path": path})
+    def save_state(self, path: str, codec: str = "gzip") -> bool:
+        """Save emulator state. codec is "gzip", "fast" (LZ4, several
+        times faster to write) or "raw"; load_state reads all three."""
+        response = self._send({"cmd": "save_state", "path": path, "codec": codec})
         return response.get("status") == "ok"
 
+    def save_state_async(self, path: str, codec: str = "gzip") -> int:
+        """Capture the state now and write it in the background. Returns
+        the job id; a {"event": "save_state", "job": id, "ok": ...} event
+        follows when the file is complete (see wait_save)."""
+        response = self._send({"cmd": "save_state", "path": path, "codec": codec,
+                               "async": True})
+        if response.get("status") != "ok":
+            raise RuntimeError(response.get("msg", "save_state failed"))
+        return response["job"]
+
+    def save_status(self, job: int) -> str:
+        """State of an async save: pending, done, failed or unknown"""
+        return self._send({"cmd": "save_status", "job": job}).get("state", "unknown")
+
+    def wait_save(self, job: int, timeout: Optional[float] = None) -> bool:
+        """Wait for an async save to finish; True if it was written"""
+        deadline = None if timeout is None else time.time() + timeout
+        while True:
+            for i, event in enumerate(self.events):
+                if event.get("event") == "save_state" and event.get("job") == job:
+                    del self.events[i]
+                    return bool(event.get("ok"))
+            remaining = None if deadline is None else deadline - time.time()
+            if remaining is not None and remaining <= 0:
+                return self.save_status(job) == "done"
+            if self._readable(remaining):
+                msg = self._recv_message()
+                if isinstance(msg, dict):
+                    self.events.append(msg)
+
     def load_state(self, path: str) -> bool:
         """Load emulator state"""
         response = self._send({"cmd": "load_state", "path": path})
         return response.get("status") == "ok"
 
+    def get_state(self) -> bytes:
+        """The state as the bytes of a "fast" state file, to carry the
+        episode over to another instance with set_state (on this host or
+        another); needs the binary protocol"""
+        was_binary = self.binary
+        self.set_binary(True)
+        try:
+            return self._send_binary(self.BIN_STATE_SAVE)
+        finally:
+            self.set_binary(was_binary)
+
+    def set_state(self, state: bytes) -> None:
+        """Continue from a state from get_state (or a fast or raw state
+        file's bytes)"""
+        was_binary = self.binary
+        self.set_binary(True)
+        try:
+            self._send_binary(self.BIN_STATE_LOAD, state)
+        finally:
+            self.set_binary(was_binary)
+
+    def state_get(self) -> bytes:
+        """The state as an uncompressed state file, transferring only the
+        pages that changed since the last state_get or state_put on this
+        connection"""
+        has_base = self._state_image is not None
+        if self.binary:
+            body = self._send_binary(self.BIN_STATE_GET,
+                                     struct.pack("<I", self._state_id) if has_base else b"")
+            state_id, kind = struct.unpack("<IB", body[:5])
+            data, full = body[5:], kind == 1
+        else:
+            cmd = {"cmd": "state_get"}
+            if has_base:
+                cmd["base"] = "%08x" % self._state_id
+            resp = self._send(cmd)
+            if resp.get("status") != "ok":
+                raise RuntimeError(resp.get("msg"))
+            state_id, full = int(resp["id"], 16), resp["full"]
+            data = base64.b64decode(resp["data"])
+        if full:
+            image = lz4_block_decompress(data[8:], struct.unpack_from("<I", data, 4)[0])
+        else:
+            image = self.apply_state_delta(self._state_image, data)
+        self._state_image, self._state_id = image, state_id
+        return image
+
+    def state_put(self, image: bytes) -> None:
+        """Continue from an uncompressed state file (e.g. from state_get),
+        sending only the pages that differ from the last state this
+        connection got or put"""
+        if self._state_image is not None:
+            data = self.make_state_delta(self._state_image, self._state_id, image)
+        else:
+            try:
+                import lz4.block
+                data = (b"A8LZ" + struct.pack("<I", len(image))
+                        + lz4.block.compress(image, store_size=False))
+            except ImportError:
+                data = image  # as a raw state file, which may exceed 64 KB
+        if self.binary:
+            state_id = struct.unpack("<I", self._send_binary(self.BIN_STATE_PUT, data))[0]
+        else:
+            resp = self._send({"cmd": "state_put", "data": base64.b64encode(data).decode()})
+            if resp.get("status") != "ok":
+                raise RuntimeError(resp.get("msg"))
+            state_id = int(resp["id"], 16)
+        self._state_image, self._state_id = bytes(image), state_id
+
+
+class Atari800ForkServer(Atari800AI):
+    """Client for a fork server started with -ai-forkserver <path>
+
+    Each spawn() forks the booted emulator into a new instance with an AI
+    socket of its own (see src/ai_forkserver.h).
+    """
+
+    def spawn(self, socket_path: str = None, shm: str = None,
+              connect: bool = True) -> Union[Atari800AI, dict]:
+        """Fork an instance; returns a client connected to it, or with
+        connect=False the reply ({"pid", "socket", "spawn_us"})"""
+        cmd = {"cmd": "spawn"}
+        if socket_path:
+            cmd["socket"] = socket_path
+        if shm:
+            cmd["shm"] = shm
+        response = self._send(cmd)
+        if response.get("status") != "ok":
+            raise RuntimeError(response.get("msg", "spawn failed"))
+        if not connect:
+            return response
+        return Atari800AI(response["socket"]).connect()
+
+    def status(self) -> dict:
+        """Children alive and spawned so far, and the forked frame"""
+        return self._send({"cmd": "status"})
+
+    def acquire(self, connect: bool = True) -> Union[Atari800AI, dict]:
+        """Lease an idle instance of the -ai-pool; returns a client
+        connected to it, or with connect=False the reply ({"pid" and
+        "socket", or "address" and "port" with -ai-listen}). The instance
+        exits when its last client disconnects."""
+        response = self._send({"cmd": "acquire"})
+        if response.get("status") != "ok":
+            raise RuntimeError(response.get("msg", "acquire failed"))
+        if not connect:
+            return response
+        if "port" in response:
+            host = self.address.rsplit(":", 1)[0]
+            return Atari800AI(address="%s:%d" % (host, response["port"])).connect()
+        return Atari800AI(response["socket"]).connect()
+
+    def release(self, pid: int) -> bool:
+        """Give back an instance acquired with connect=False and not used"""
+        return self._send({"cmd": "release", "pid": pid}).get("status") == "ok"
+
+    def stats(self) -> dict:
+        """Instances idle and busy, and the frames all of them have run
+        and per second since the last stats()"""
+        return self._send({"cmd": "stats"})
+
+    def shutdown(self) -> bool:
+        """End the fork server; the instances keep running"""
+        return self._send({"cmd": "shutdown"}).get("status") == "ok"
+
+
+class Atari800Shm:
+    """Reader for the observation segment published with -ai-shm <name>
+
+    Each read() is lock-free: it retries until it gets a copy that no
+    frame publish overlapped (see AI_SHM_Header in src/ai_shm.h).
+    """
+
+    MAGIC = 0x4D485341
+    HEADER = struct.Struct("=7I2HH6B32s16s4s16s32s16s16s")
+    AUDIO = struct.Struct("=4B32s5I")  # version 2, right after HEADER
+    SEQ_OFFSET = 12
+
+    def __init__(self, name: str):
+        path = "/dev/shm/" + name.lstrip("/")
+        with open(path, "rb") as f:
+            self.map = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+        if struct.unpack_from("=I", self.map, 0)[0] != self.MAGIC:
+            self.close()
+            raise ValueError(f"{path} is not an atari800 observation segment")
+        self.version = struct.unpack_from("=I", self.map, 4)[0]
+
+    def close(self):
+        if self.map is not None:
+            self.map.close()
+            self.map = None
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, exc_type, exc_val, exc_tb):
+        self.close()
+
+    def _seq(self) -> int:
+        return struct.unpack_from("=I", self.map, self.SEQ_OFFSET)[0]
+
+    def frame(self) -> int:
+        """Frame number of the latest published observation"""
+        return struct.unpack_from("=I", self.map, 16)[0]
+
+    def read(self, screen: bool = True, memory: bool = True) -> dict:
+        """Return a consistent snapshot of the latest published frame"""
+        while True:
+            seq = self._seq()
+            if seq & 1:
+                continue
+            (_magic, _version, _size, _seq, frame, screen_off, memory_off,
+             width, height, pc, a, x, y, sp, p, _reserved,
+             gtia, pokey, pia, antic,
+             gtia_write, pokey_write, antic_write) = self.HEADER.unpack_from(self.map, 0)
+            obs = {
+                "frame": frame,
+                "width": width, "height": height,
+                "cpu": {"pc": pc, "a": a, "x": x, "y": y, "sp": sp, "p": p},
+                "gtia": gtia, "pokey": pokey, "pia": pia, "antic": antic,
+                "gtia_write": gtia_write, "pokey_write": pokey_write,
+                "antic_write": antic_write,
+            }
+            if self.version >= 2:
+                (env_channels, _channels, _sample_bytes, _reserved2, env,
+                 _rate, _offset, _size, _written, _frame_bytes) = self.AUDIO.unpack_from(
+                    self.map, self.HEADER.size)
+                obs["env"] = [list(struct.unpack_from("<HBB", env, 4 * i))
+                              for i in range(env_channels)]
+            if screen:
+                obs["screen"] = self.map[screen_off:screen_off + width * height]
+            if memory:
+                obs["memory"] = self.map[memory_off:memory_off + 65536]
+            if self._seq() == seq:
+                return obs
+
+    def read_audio(self, position: int = None):
+        """Return (samples, format, position) for the audio appended since
+        position, a count of bytes from a previous call (None: start from
+        the latest frame). Needs -ai-shm-audio; samples older than the ring
+        are skipped. format is {"rate", "channels", "bits"}.
+        """
+        if self.version < 2:
+            raise ValueError("segment has no audio")
+        while True:
+            seq = self._seq()
+            if seq & 1:
+                continue
+            (_env_channels, channels, sample_bytes, _reserved2, _env,
+             rate, offset, size, written, frame_bytes) = self.AUDIO.unpack_from(
+                self.map, self.HEADER.size)
+            if size == 0:
+                raise ValueError("segment has no audio ring (run with -ai-shm-audio)")
+            if position is None:
+                position = (written - frame_bytes) & 0xFFFFFFFF
+            count = (written - position) & 0xFFFFFFFF
+            if count > size:
+                count = size
+            start = (written - count) % size
+            data = self.map[offset + start:offset + min(start + count, size)]
+            if start + count > size:
+                data += self.map[offset:offset + start + count - size]
+            if self._seq() == seq:
+                fmt = {"rate": rate, "channels": channels, "bits": sample_bytes * 8}
+                return data, fmt, written
+
 
 # === Helper functions for common tasks ===
 
@@ -22,58 +22,183 @@ const __filename = fileURLToPath(import.meta.url);
 const __dirname = path.dirname(__filename);
 
 const SOCKET_PATH = '/tmp/atari800_ai.sock';
+// Set ATARI800_AI_BINARY=1 to use the binary framed protocol for bulk data
+const USE_BINARY = process.env.ATARI800_AI_BINARY === '1';
+
+// Binary framed protocol (see AI_BIN_* in src/ai_interface.h)
+const BIN_MAGIC = 0xa8;
+const BIN_HEADER_SIZE = 12;
+const BIN_PEEK = 0x03;
 // Default to emulator built in ../src/atari800 relative to mcp-server directory
 // Can be overridden with ATARI800_PATH environment variable
 const EMULATOR_PATH = process.env.ATARI800_PATH || path.join(__dirname, '..', 'src', 'atari800');
 
 let emulatorProcess = null;
 
-// Send command to emulator and get response
-async function sendCommand(cmd) {
-  return new Promise((resolve, reject) => {
-    const client = net.createConnection(SOCKET_PATH, () => {
-      const json = JSON.stringify(cmd);
-      const header = `${json.length}\n`;
-      client.write(header + json);
+const REQUEST_TIMEOUT = 10000;
+
+// One connection to the emulator, kept open across tool calls. Requests
+// are pipelined: each goes out at once with an id of its own (the tag of a
+// binary frame, the "id" the emulator echoes in a JSON reply), and its
+// reply is matched by that id, however many are in flight.
+class EmulatorConnection {
+  constructor(binary) {
+    this.binary = binary;
+    this.socket = null;
+    this.data = Buffer.alloc(0);
+    this.switched = !binary;   // binary framing acknowledged
+    this.nextId = 0;
+    this.pending = new Map();  // id -> { resolve, reject, timer, events }
+  }
+
+  open() {
+    if (this.socket) return;
+    this.socket = net.createConnection(SOCKET_PATH);
+    this.data = Buffer.alloc(0);
+    this.switched = !this.binary;
+    if (this.binary) {
+      // Frames may follow the switch at once; they are read after it
+      const json = JSON.stringify({ cmd: 'protocol', mode: 'binary' });
+      this.socket.write(`${Buffer.byteLength(json)}\n${json}`);
+    }
+    const socket = this.socket;
+    socket.on('data', (chunk) => this.receive(chunk));
+    socket.on('error', (err) => this.close(err));
+    socket.on('close', () => {
+      if (this.socket === socket) this.close(new Error('Connection closed'));
     });
+  }
 
-    let data = '';
-    let expectedLength = null;
+  // Drop the connection, failing what is in flight; the next request
+  // connects again (e.g. to a restarted emulator)
+  close(err = new Error('Connection closed')) {
+    if (this.socket) {
+      this.socket.destroy();
+      this.socket = null;
+    }
+    for (const req of this.pending.values()) {
+      clearTimeout(req.timer);
+      req.reject(err);
+    }
+    this.pending.clear();
+  }
 
-    client.on('data', (chunk) => {
-      data += chunk.toString();
+  send(message) {
+    this.open();
+    const id = this.nextId = (this.nextId % 0xffffffff) + 1;
+    return new Promise((resolve, reject) => {
+      const timer = setTimeout(() => this.close(new Error('Connection timeout')), REQUEST_TIMEOUT);
+      this.pending.set(id, { resolve, reject, timer, events: [] });
+      this.socket.write(message(id));
+    });
+  }
 
-      if (expectedLength === null) {
-        const newlineIdx = data.indexOf('\n');
-        if (newlineIdx !== -1) {
-          expectedLength = parseInt(data.substring(0, newlineIdx));
-          data = data.substring(newlineIdx + 1);
-        }
-      }
+  settle(id, fn) {
+    // Replies without an id (older emulators) answer the oldest request
+    if (id === undefined || !this.pending.has(id)) id = this.pending.keys().next().value;
+    const req = this.pending.get(id);
+    if (req === undefined) return;
+    this.pending.delete(id);
+    clearTimeout(req.timer);
+    fn(req);
+  }
 
-      if (expectedLength !== null && data.length >= expectedLength) {
-        client.end();
+  receive(chunk) {
+    this.data = this.data.length ? Buffer.concat([this.data, chunk]) : chunk;
+    for (;;) {
+      if (!this.switched || !this.binary) {
+        const newlineIdx = this.data.indexOf('\n');
+        if (newlineIdx === -1) return;
+        const length = parseInt(this.data.subarray(0, newlineIdx).toString());
+        if (this.data.length < newlineIdx + 1 + length) return;
+        const text = this.data.subarray(newlineIdx + 1, newlineIdx + 1 + length).toString();
+        this.data = this.data.subarray(newlineIdx + 1 + length);
+        let msg;
         try {
-          resolve(JSON.parse(data.substring(0, expectedLength)));
+          msg = JSON.parse(text);
         } catch (e) {
-          reject(new Error(`Failed to parse response: ${data}`));
+          this.close(new Error(`Failed to parse response: ${text}`));
+          return;
+        }
+        if (!this.switched) {
+          if (msg.status !== 'ok') {
+            this.close(new Error(msg.msg || 'Binary protocol not supported'));
+            return;
+          }
+          this.switched = true;
+        } else if (msg.event !== undefined) {
+          // Events (such as a breakpoint stopping a run) come with the next reply
+          const first = this.pending.values().next().value;
+          if (first) first.events.push(msg);
+        } else {
+          this.settle(msg.id, (req) => {
+            delete msg.id;
+            if (req.events.length) msg.events = req.events;
+            req.resolve(msg);
+          });
         }
+        continue;
       }
-    });
+      if (this.data.length < BIN_HEADER_SIZE) return;
+      const length = this.data.readUInt32LE(8);
+      if (this.data.length < BIN_HEADER_SIZE + length) return;
+      const header = this.data.subarray(0, BIN_HEADER_SIZE);
+      const body = Buffer.from(this.data.subarray(BIN_HEADER_SIZE, BIN_HEADER_SIZE + length));
+      this.data = this.data.subarray(BIN_HEADER_SIZE + length);
+      if (header.readUInt8(0) !== BIN_MAGIC) {
+        this.close(new Error('Binary protocol framing error'));
+        return;
+      }
+      const tag = header.readUInt32LE(4);
+      if (tag === 0) continue;  // pushed events are not asked for here
+      this.settle(tag, (req) => {
+        if (header.readUInt8(2) !== 0) req.reject(new Error(body.toString()));
+        else req.resolve(body);
+      });
+    }
+  }
+}
 
-    client.on('error', (err) => {
-      reject(err);
-    });
+const jsonConnection = new EmulatorConnection(false);
+const binaryConnection = new EmulatorConnection(true);
 
-    client.on('timeout', () => {
-      client.end();
-      reject(new Error('Connection timeout'));
-    });
+function closeConnections() {
+  jsonConnection.close();
+  binaryConnection.close();
+}
 
-    client.setTimeout(10000);
+// Send command to emulator and get response
+function sendCommand(cmd) {
+  return jsonConnection.send((id) => {
+    const json = JSON.stringify({ ...cmd, id });
+    return `${Buffer.byteLength(json)}\n${json}`;
   });
 }
 
+// Send one binary frame and get the response payload
+function sendBinary(opcode, payload = Buffer.alloc(0)) {
+  return binaryConnection.send((id) => {
+    const header = Buffer.alloc(BIN_HEADER_SIZE);
+    header.writeUInt8(BIN_MAGIC, 0);
+    header.writeUInt8(opcode, 1);
+    header.writeUInt32LE(id, 4);
+    header.writeUInt32LE(payload.length, 8);
+    return Buffer.concat([header, payload]);
+  });
+}
+
+// Read memory, as raw bytes over the binary protocol when enabled
+async function peekMemory(addr, len) {
+  if (USE_BINARY) {
+    const payload = Buffer.alloc(6);
+    payload.writeUInt16LE(addr & 0xffff, 0);
+    payload.writeUInt32LE(len, 2);
+    return Array.from(await sendBinary(BIN_PEEK, payload));
+  }
+  const resp = await sendCommand({ cmd: 'peek', addr, len });
+  return resp.data;
+}
+
 // Check if emulator is running
 function isEmulatorRunning() {
   return fs.existsSync(SOCKET_PATH);
@@ -82,9 +207,10 @@ function isEmulatorRunning() {
 // Format screen ASCII for display
 function formatScreen(data) {
   if (!data || !Array.isArray(data)) return 'No screen data';
-  return '┌' + '─'.repeat(40) + '┐\n' +
-         data.map(line => '│' + line + '│').join('\n') + '\n' +
-         '└' + '─'.repeat(40) + '┘';
+  const width = Math.max(40, ...data.map(line => [...line].length));
+  return '┌' + '─'.repeat(width) + '┐\n' +
+         data.map(line => '│' + line + ' '.repeat(width - [...line].length) + '│').join('\n') + '\n' +
+         '└' + '─'.repeat(width) + '┘';
 }
 
 // Create the MCP server
@@ -137,6 +263,152 @@ server.setRequestHandler(ListToolsRequestSchema, async () => {
               description: 'Number of frames to run (default: 60)',
               default: 60,
             },
+            unthrottled: {
+              type: 'boolean',
+              description: 'Run as fast as the host can instead of at real-time speed',
+              default: false,
+            },
+          },
+        },
+      },
+      {
+        name: 'atari_run_until',
+        description: 'Run the emulator until a condition holds or max_frames pass. ' +
+          'Conditions: mem[ADDR] OP VALUE|start, pc == ADDR, frames OP N, changed (a watched byte changed), joined with && and ||',
+        inputSchema: {
+          type: 'object',
+          properties: {
+            until: {
+              type: 'string',
+              description: 'Condition, e.g. "mem[$D4] != start || pc == $E459"',
+            },
+            max_frames: {
+              type: 'number',
+              description: 'Give up after this many frames (default: 3600)',
+              default: 3600,
+            },
+          },
+          required: ['until'],
+        },
+      },
+      {
+        name: 'atari_breakpoint',
+        description: 'Set or clear a breakpoint on the instruction at an address. ' +
+          'A run that hits one stops at the end of that frame.',
+        inputSchema: {
+          type: 'object',
+          properties: {
+            address: {
+              type: 'number',
+              description: 'Instruction address (0-65535)',
+            },
+            enabled: {
+              type: 'boolean',
+              description: 'Set (true) or clear (false) the breakpoint (default: true)',
+              default: true,
+            },
+          },
+          required: ['address'],
+        },
+      },
+      {
+        name: 'atari_watch',
+        description: 'Watch a memory range for changes made by the CPU. ' +
+          'Use atari_watch_read to see what changed and where in the frame, ' +
+          'or atari_run_until with "changed" to stop at the first change.',
+        inputSchema: {
+          type: 'object',
+          properties: {
+            address: {
+              type: 'number',
+              description: 'First address (0-65535)',
+            },
+            length: {
+              type: 'number',
+              description: 'Number of bytes (default: 1)',
+              default: 1,
+            },
+            enabled: {
+              type: 'boolean',
+              description: 'Watch (true) or stop watching (false) the range (default: true)',
+              default: true,
+            },
+            clear: {
+              type: 'boolean',
+              description: 'Stop watching everything instead',
+            },
+          },
+        },
+      },
+      {
+        name: 'atari_watch_read',
+        description: 'Fetch and clear the changes recorded in watched memory',
+        inputSchema: {
+          type: 'object',
+          properties: {},
+        },
+      },
+      {
+        name: 'atari_profile',
+        description: 'Profile the 6502: "start" counting cycles by PC (runs slower while on), ' +
+          '"stop", or "dump" the hottest PCs, e.g. to find loops waiting on VCOUNT or WSYNC.',
+        inputSchema: {
+          type: 'object',
+          properties: {
+            action: {
+              type: 'string',
+              enum: ['start', 'stop', 'dump'],
+              description: 'What to do',
+            },
+            top: {
+              type: 'number',
+              description: 'PCs to list for dump (default: 20)',
+              default: 20,
+            },
+          },
+          required: ['action'],
+        },
+      },
+      {
+        name: 'atari_trace',
+        description: 'Write a binary trace of every instruction to a file ("start", runs slower while on), ' +
+          '"stop" it, or get its "status". tools/trace_decode prints the file as monitor TRACE text.',
+        inputSchema: {
+          type: 'object',
+          properties: {
+            action: {
+              type: 'string',
+              enum: ['start', 'stop', 'status'],
+              description: 'What to do',
+            },
+            path: {
+              type: 'string',
+              description: 'Trace file to write for start',
+            },
+          },
+          required: ['action'],
+        },
+      },
+      {
+        name: 'atari_rewind',
+        description: 'Go back a number of frames, restoring the nearest keyframe and replaying ' +
+          'the recorded input. Rewind must be enabled first with depth (and stride).',
+        inputSchema: {
+          type: 'object',
+          properties: {
+            frames: {
+              type: 'number',
+              description: 'Frames to go back (default: 1)',
+              default: 1,
+            },
+            depth: {
+              type: 'number',
+              description: 'Enable rewind keeping this many keyframes (0 turns it off) instead of rewinding',
+            },
+            stride: {
+              type: 'number',
+              description: 'Frames between keyframes when enabling (default: 1)',
+            },
           },
         },
       },
@@ -218,6 +490,37 @@ server.setRequestHandler(ListToolsRequestSchema, async () => {
           required: ['address'],
         },
       },
+      {
+        name: 'atari_peek_bank',
+        description: 'Read from an extended memory bank without switching it in. ' +
+          'XE bank 0 is the base RAM at $4000, banks 1.. are the extended RAM.',
+        inputSchema: {
+          type: 'object',
+          properties: {
+            kind: {
+              type: 'string',
+              enum: ['xe', 'axlon', 'mosaic'],
+              description: 'Memory expansion (default: xe)',
+              default: 'xe',
+            },
+            bank: {
+              type: 'number',
+              description: 'Bank number',
+            },
+            offset: {
+              type: 'number',
+              description: 'Offset in the bank (default: 0)',
+              default: 0,
+            },
+            length: {
+              type: 'number',
+              description: 'Number of bytes to read (default: 16)',
+              default: 16,
+            },
+          },
+          required: ['bank'],
+        },
+      },
       {
         name: 'atari_poke',
         description: 'Write to Atari memory',
@@ -295,6 +598,15 @@ server.setRequestHandler(ListToolsRequestSchema, async () => {
               type: 'string',
               description: 'Path to save state file',
             },
+            codec: {
+              type: 'string',
+              enum: ['gzip', 'fast', 'raw'],
+              description: 'gzip (default), fast (LZ4, quicker to write) or raw (uncompressed)',
+            },
+            async: {
+              type: 'boolean',
+              description: 'Write the file in the background and return at once (default: false)',
+            },
           },
           required: ['path'],
         },
@@ -336,6 +648,7 @@ server.setRequestHandler(CallToolRequestSchema, async (request) => {
   try {
     switch (name) {
       case 'atari_start': {
+        closeConnections();
         if (emulatorProcess) {
           emulatorProcess.kill();
           emulatorProcess = null;
@@ -378,6 +691,7 @@ server.setRequestHandler(CallToolRequestSchema, async (request) => {
       }
 
       case 'atari_stop': {
+        closeConnections();
         if (emulatorProcess) {
           emulatorProcess.kill();
           emulatorProcess = null;
@@ -393,9 +707,145 @@ server.setRequestHandler(CallToolRequestSchema, async (request) => {
 
       case 'atari_run': {
         const frames = args.frames || 60;
-        const resp = await sendCommand({ cmd: 'run', frames });
+        const resp = await sendCommand({
+          cmd: 'run',
+          frames,
+          unthrottled: args.unthrottled || false,
+        });
+        let text = `Ran ${resp.frames_run} frames (${resp.cycles} cycles) in ${resp.wall_ms} ms, ` +
+          `${resp.speed}x real time.`;
+        for (const ev of resp.events || []) {
+          if (ev.event === 'breakpoint') {
+            text += ` Stopped at breakpoint $${ev.addr.toString(16).toUpperCase()} ` +
+              `(frame ${ev.frame}, scanline ${ev.scanline}).`;
+          }
+        }
         return {
-          content: [{ type: 'text', text: `Ran ${frames} frames.` }],
+          content: [{ type: 'text', text }],
+        };
+      }
+
+      case 'atari_breakpoint': {
+        const enabled = args.enabled !== false;
+        const resp = await sendCommand({ cmd: 'breakpoint', addr: args.address, enabled });
+        if (resp.status !== 'ok') {
+          return {
+            content: [{ type: 'text', text: `Error: ${resp.msg}` }],
+            isError: true,
+          };
+        }
+        return {
+          content: [{
+            type: 'text',
+            text: `Breakpoint at $${args.address.toString(16).toUpperCase()} ${enabled ? 'set' : 'cleared'}, ` +
+              `${resp.count} set.`,
+          }],
+        };
+      }
+
+      case 'atari_watch': {
+        const resp = args.clear
+          ? await sendCommand({ cmd: 'watch', clear: true })
+          : await sendCommand({
+            cmd: 'watch', addr: args.address, len: args.length || 1, enabled: args.enabled !== false,
+          });
+        if (resp.status !== 'ok') {
+          return {
+            content: [{ type: 'text', text: `Error: ${resp.msg}` }],
+            isError: true,
+          };
+        }
+        return {
+          content: [{ type: 'text', text: `${resp.count} addresses watched.` }],
+        };
+      }
+
+      case 'atari_watch_read': {
+        const resp = await sendCommand({ cmd: 'watch_read' });
+        const hex = (n, w) => '$' + n.toString(16).toUpperCase().padStart(w, '0');
+        const lines = resp.changes.map(([addr, old, value, frame, y, x]) =>
+          `${hex(addr, 4)}: ${hex(old, 2)} -> ${hex(value, 2)} (frame ${frame}, scanline ${y}, x ${x})`);
+        if (resp.dropped > 0) lines.unshift(`${resp.dropped} older changes dropped`);
+        return {
+          content: [{ type: 'text', text: lines.length > 0 ? lines.join('\n') : 'No changes.' }],
+        };
+      }
+
+      case 'atari_profile': {
+        if (args.action !== 'dump') {
+          await sendCommand({ cmd: `profile_${args.action}` });
+          return {
+            content: [{ type: 'text', text: `Profiling ${args.action === 'start' ? 'started' : 'stopped'}.` }],
+          };
+        }
+        const resp = await sendCommand({ cmd: 'profile_dump', top: args.top || 20 });
+        const pct = (n) => resp.cycles > 0 ? (100 * n / resp.cycles).toFixed(1) : '0.0';
+        const lines = [`${resp.frames} frames, ${resp.insns} instructions, ${resp.cycles} cycles`];
+        for (const [pc, count, cycles] of resp.top) {
+          lines.push(`$${pc.toString(16).toUpperCase().padStart(4, '0')}: ${count} x, ${cycles} cycles (${pct(cycles)}%)`);
+        }
+        return {
+          content: [{ type: 'text', text: lines.join('\n') }],
+        };
+      }
+
+      case 'atari_trace': {
+        const resp = args.action === 'start'
+          ? await sendCommand({ cmd: 'trace_start', path: args.path })
+          : await sendCommand({ cmd: `trace_${args.action}` });
+        if (resp.status !== 'ok') {
+          return {
+            content: [{ type: 'text', text: `Error: ${resp.msg}` }],
+            isError: true,
+          };
+        }
+        const text = args.action === 'start'
+          ? `Tracing to ${args.path}.`
+          : `${resp.active ? 'Tracing' : 'Trace finished'}: ${resp.records} instructions, ` +
+            `${resp.stalls} writer stalls${resp.error ? ', write error' : ''}.`;
+        return {
+          content: [{ type: 'text', text }],
+        };
+      }
+
+      case 'atari_rewind': {
+        const resp = args.depth !== undefined
+          ? await sendCommand({ cmd: 'rewind_config', depth: args.depth, stride: args.stride || 1 })
+          : await sendCommand({ cmd: 'rewind', frames: args.frames || 1 });
+        if (resp.status !== 'ok') {
+          return {
+            content: [{ type: 'text', text: `Error: ${resp.msg}` }],
+            isError: true,
+          };
+        }
+        const text = args.depth !== undefined
+          ? `Rewind keeps ${resp.depth} keyframes, one every ${resp.stride} frames.`
+          : `Rewound to frame ${resp.frame} (keyframe ${resp.keyframe}, ${resp.replayed} frames replayed).`;
+        return {
+          content: [{ type: 'text', text }],
+        };
+      }
+
+      case 'atari_run_until': {
+        const resp = await sendCommand({
+          cmd: 'run_until',
+          until: args.until,
+          max_frames: args.max_frames || 3600,
+        });
+        if (resp.status !== 'ok') {
+          return {
+            content: [{ type: 'text', text: `Error: ${resp.msg}` }],
+            isError: true,
+          };
+        }
+        let text = resp.fired
+          ? `Condition ${resp.clause} fired at frame ${resp.frame} after ${resp.frames_run} frames.`
+          : `Condition did not fire within ${resp.frames_run} frames.`;
+        if (resp.pc_hit) {
+          text += ` PC $${resp.pc_hit.pc.toString(16).toUpperCase()} reached on scanline ${resp.pc_hit.scanline}.`;
+        }
+        return {
+          content: [{ type: 'text', text }],
         };
       }
 
@@ -446,14 +896,29 @@ server.setRequestHandler(CallToolRequestSchema, async (request) => {
       }
 
       case 'atari_peek': {
+        const data = await peekMemory(args.address, args.length || 1);
+        const hex = data.map(b => b.toString(16).padStart(2, '0')).join(' ');
+        return {
+          content: [{ type: 'text', text: `$${args.address.toString(16).padStart(4, '0')}: ${hex} (${data.join(', ')})` }],
+        };
+      }
+
+      case 'atari_peek_bank': {
+        const kind = args.kind || 'xe';
+        const offset = args.offset || 0;
         const resp = await sendCommand({
-          cmd: 'peek',
-          addr: args.address,
-          len: args.length || 1,
+          cmd: 'peek_bank', kind, bank: args.bank, addr: offset, len: args.length || 16,
         });
-        const hex = resp.data.map(b => b.toString(16).padStart(2, '0')).join(' ');
+        if (resp.status !== 'ok') {
+          return {
+            content: [{ type: 'text', text: `Error: ${resp.msg}` }],
+            isError: true,
+          };
+        }
+        const data = [...Buffer.from(resp.data, 'base64')];
+        const hex = data.map(b => b.toString(16).padStart(2, '0')).join(' ');
         return {
-          content: [{ type: 'text', text: `$${args.address.toString(16).padStart(4, '0')}: ${hex} (${resp.data.join(', ')})` }],
+          content: [{ type: 'text', text: `${kind} bank ${args.bank} +$${offset.toString(16).padStart(4, '0')}: ${hex}` }],
         };
       }
 
@@ -546,9 +1011,14 @@ server.setRequestHandler(CallToolRequestSchema, async (request) => {
       }
 
       case 'atari_save_state': {
-        const resp = await sendCommand({ cmd: 'save_state', path: args.path });
+        const resp = await sendCommand({
+          cmd: 'save_state', path: args.path, codec: args.codec || 'gzip', async: !!args.async,
+        });
+        let text = `State saved to ${args.path}`;
+        if (resp.status !== 'ok') text = `Failed: ${resp.msg}`;
+        else if (resp.pending) text = `Saving to ${args.path} in the background (job ${resp.job})`;
         return {
-          content: [{ type: 'text', text: resp.status === 'ok' ? `State saved to ${args.path}` : `Failed: ${resp.msg}` }],
+          content: [{ type: 'text', text }],
         };
       }
 
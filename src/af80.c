@@ -370,6 +370,35 @@ UBYTE AF80_GetPixels(int scanline, int column, int *colour, int blink)
 	return font_data;
 }
 
+int AF80_GetText(TEXT80_Screen *screen)
+{
+	int row, column;
+	int table_start = crtreg[0x0c] + ((crtreg[0x0d]&0x3f)<<8);
+
+	screen->card = "af80";
+	screen->rows = AF80_ROWS;
+	if (crtreg[0x18] < AF80_ROWS && crtreg[0x19] < 80) {
+		screen->cursor_x = crtreg[0x19];
+		screen->cursor_y = crtreg[0x18];
+	}
+	else
+		screen->cursor_x = screen->cursor_y = -1;
+	for (row = 0; row < AF80_ROWS; row++) {
+		for (column = 0; column < 80; column++) {
+			/* as AF80_GetPixels finds it */
+			int screen_pos;
+			if (row >= crtreg[0x10])
+				screen_pos = (row-crtreg[0x10])*80 + column + crtreg[0x0e] + ((crtreg[0x0f]&0x3f)<<8);
+			else
+				screen_pos = row*80+column + table_start;
+			screen_pos &= 0x7ff;
+			screen->chars[row][column] = af80_screen[screen_pos] & 0x7f;
+			screen->inverse[row][column] = af80_attrib[screen_pos] & 0x01;
+		}
+	}
+	return TRUE;
+}
+
 void AF80_Reset(void)
 {
 	memset(af80_screen, 0, 0x800);
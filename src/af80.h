@@ -2,6 +2,7 @@
 #define AF80_H_
 
 #include "atari.h"
+#include "text80.h"
 #include <stdio.h>
 
 extern int AF80_palette[16];
@@ -15,6 +16,7 @@ void AF80_D5PutByte(UWORD addr, UBYTE byte);
 int AF80_D6GetByte(UWORD addr, int no_side_effects);
 void AF80_D6PutByte(UWORD addr, UBYTE byte);
 UBYTE AF80_GetPixels(int scanline, int column, int *colour, int blink);
+int AF80_GetText(TEXT80_Screen *screen);
 extern int AF80_enabled;
 void AF80_Reset(void);
 
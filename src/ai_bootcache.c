@@ -0,0 +1,193 @@
+/*
+ * ai_bootcache.c - Boot snapshot cache for the AI interface
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+#include "config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ai_bootcache.h"
+#include "ai_interface.h"
+#include "binload.h"
+#include "cartridge.h"
+#include "crc32.h"
+#include "esc.h"
+#include "input.h"
+#include "memory.h"
+#include "statesav.h"
+#include "util.h"
+
+#define MAX_ENTRIES 1024
+#define DEFAULT_ENTRIES 16
+
+typedef struct {
+    AI_BOOTCACHE_Key key;
+    UBYTE *state;
+    ULONG len;
+    unsigned int used;  /* when last stored or restored, for eviction */
+} Entry;
+
+static Entry *entries = NULL;
+static int max_entries = DEFAULT_ENTRIES;  /* entries is allocated when needed */
+static int entry_count = 0;
+static unsigned int use_clock = 0;
+static size_t entry_bytes = 0;
+static int hits = 0;
+static int misses = 0;
+
+static ULONG crc_of(const UBYTE *data, ULONG len) {
+    return CRC32_Update(0xffffffff, data, (unsigned int)len);
+}
+
+static void cart_key(const CARTRIDGE_image_t *cart, int *type, ULONG *crc) {
+    *type = cart->type;
+    *crc = cart->type != CARTRIDGE_NONE && cart->image != NULL
+        ? crc_of(cart->image, (ULONG)cart->size << 10) : 0;
+}
+
+static Entry *find(const AI_BOOTCACHE_Key *key) {
+    int i;
+
+    for (i = 0; i < entry_count; i++) {
+        if (memcmp(&entries[i].key, key, sizeof(*key)) == 0)
+            return &entries[i];
+    }
+    return NULL;
+}
+
+int AI_BOOTCACHE_Configure(int n) {
+    if (n < 0 || n > MAX_ENTRIES)
+        return FALSE;
+    AI_BOOTCACHE_Clear();
+    free(entries);
+    entries = NULL;
+    max_entries = n;
+    hits = misses = 0;
+    return TRUE;
+}
+
+int AI_BOOTCACHE_MaxEntries(void) {
+    return max_entries;
+}
+
+int AI_BOOTCACHE_MakeKey(AI_BOOTCACHE_Key *key, const char *path, int frames) {
+    int i;
+
+    /* Zeroed padding included, as keys are compared with memcmp */
+    memset(key, 0, sizeof(*key));
+    key->machine_type = Atari800_machine_type;
+    key->ram_size = MEMORY_ram_size;
+    key->tv_mode = Atari800_tv_mode;
+    key->builtin_basic = Atari800_builtin_basic;
+    key->builtin_game = Atari800_builtin_game;
+    key->disable_basic = Atari800_disable_basic;
+    key->sio_patch = ESC_enable_sio_patch;
+    key->sio_accel = SIO_accel;
+    key->slow_xex = BINLOAD_slow_xex_loading;
+    key->os_crc = crc_of(MEMORY_os, sizeof(MEMORY_os_buffer));
+    key->basic_crc = crc_of(MEMORY_basic, sizeof(MEMORY_basic_buffer));
+    cart_key(&CARTRIDGE_main, &key->cart_type[0], &key->cart_crc[0]);
+    cart_key(&CARTRIDGE_piggyback, &key->cart_type[1], &key->cart_crc[1]);
+    for (i = 0; i < SIO_MAX_DRIVES; i++) {
+        key->disk_status[i] = SIO_drive_status[i];
+        if (!SIO_ImageHash(i + 1, &key->disk_size[i], &key->disk_crc[i]))
+            return FALSE;
+    }
+    if (path != NULL) {
+        FILE *f = fopen(path, "rb");
+        int ok;
+        if (f == NULL)
+            return FALSE;
+        ok = CRC32_FromFile(f, &key->program_crc);
+        key->program_size = (ULONG)Util_flen(f);
+        fclose(f);
+        if (!ok)
+            return FALSE;
+    }
+    memcpy(key->joy, AI_joy_override, sizeof(key->joy));
+    memcpy(key->trig, AI_trig_override, sizeof(key->trig));
+    memcpy(key->pot, INPUT_pot_override, sizeof(key->pot));
+    key->key_code = INPUT_key_code;
+    key->key_shift = INPUT_key_shift;
+    key->consol = INPUT_key_consol;
+    key->frames = frames;
+    return TRUE;
+}
+
+int AI_BOOTCACHE_Restore(const AI_BOOTCACHE_Key *key) {
+    Entry *e = find(key);
+
+    if (e == NULL || !StateSav_ReadSnapshot(e->state, e->len)) {
+        misses++;
+        return FALSE;
+    }
+    e->used = ++use_clock;
+    hits++;
+    return TRUE;
+}
+
+int AI_BOOTCACHE_Store(const AI_BOOTCACHE_Key *key) {
+    ULONG len = StateSav_SaveSnapshot(NULL, 0);
+    UBYTE *state;
+    Entry *e;
+
+    if (max_entries == 0 || len == 0)
+        return FALSE;
+    state = (UBYTE *)Util_malloc(len);
+    len = StateSav_SaveSnapshot(state, len);
+    if (len == 0) {
+        free(state);
+        return FALSE;
+    }
+    if (entries == NULL)
+        entries = (Entry *)Util_malloc(max_entries * sizeof(Entry));
+    e = find(key);
+    if (e == NULL && entry_count < max_entries) {
+        e = &entries[entry_count++];
+        e->state = NULL;
+    }
+    else if (e == NULL) {
+        int i;
+        e = &entries[0];
+        for (i = 1; i < entry_count; i++) {
+            if (entries[i].used < e->used)
+                e = &entries[i];
+        }
+    }
+    if (e->state != NULL) {
+        entry_bytes -= e->len;
+        free(e->state);
+    }
+    e->key = *key;
+    e->state = state;
+    e->len = len;
+    e->used = ++use_clock;
+    entry_bytes += len;
+    return TRUE;
+}
+
+void AI_BOOTCACHE_Clear(void) {
+    while (entry_count > 0)
+        free(entries[--entry_count].state);
+    entry_bytes = 0;
+}
+
+int AI_BOOTCACHE_Entries(void) {
+    return entry_count;
+}
+
+size_t AI_BOOTCACHE_Bytes(void) {
+    return entry_bytes;
+}
+
+int AI_BOOTCACHE_Hits(void) {
+    return hits;
+}
+
+int AI_BOOTCACHE_Misses(void) {
+    return misses;
+}
@@ -0,0 +1,77 @@
+/*
+ * ai_bootcache.h - Boot snapshot cache for the AI interface
+ *
+ * Remembers the machine state a number of frames after a cold boot, so the
+ * same boot done again restores that state instead of emulating the frames.
+ * A boot is identified by everything it depends on: the machine and its
+ * settings, the OS, BASIC and cartridge images, the disks, the program
+ * being loaded, the input held and the frame count. Entries are in-process
+ * snapshots (see StateSav_SaveSnapshot); the least recently used one goes
+ * when the cache is full.
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+#ifndef AI_BOOTCACHE_H_
+#define AI_BOOTCACHE_H_
+
+#include <stddef.h>
+#include "atari.h"
+#include "sio.h"
+
+typedef struct {
+    int machine_type;
+    int ram_size;
+    int tv_mode;
+    int builtin_basic;
+    int builtin_game;
+    int disable_basic;
+    int sio_patch;
+    int sio_accel;
+    int slow_xex;
+    ULONG os_crc;
+    ULONG basic_crc;
+    int cart_type[2];
+    ULONG cart_crc[2];
+    int disk_status[SIO_MAX_DRIVES];
+    ULONG disk_size[SIO_MAX_DRIVES];
+    ULONG disk_crc[SIO_MAX_DRIVES];
+    ULONG program_size;
+    ULONG program_crc;
+    int joy[4];
+    int trig[4];
+    int pot[8];
+    int key_code;
+    int key_shift;
+    int consol;
+    int frames;
+} AI_BOOTCACHE_Key;
+
+/* Keep at most entries boots, 16 by default (0 turns the cache off), and
+   empty the cache. Returns FALSE if entries is out of range. */
+int AI_BOOTCACHE_Configure(int entries);
+int AI_BOOTCACHE_MaxEntries(void);
+
+/* Key of a cold boot run for frames frames in the present setup, loading
+   the program at path unless it is NULL. Returns FALSE if such a boot
+   cannot be cached: the program cannot be read, or a disk was written to. */
+int AI_BOOTCACHE_MakeKey(AI_BOOTCACHE_Key *key, const char *path, int frames);
+
+/* Put the machine in the state stored for key. Returns FALSE, touching
+   nothing, if there is none. */
+int AI_BOOTCACHE_Restore(const AI_BOOTCACHE_Key *key);
+
+/* Store the present state for key, replacing any stored before */
+int AI_BOOTCACHE_Store(const AI_BOOTCACHE_Key *key);
+
+void AI_BOOTCACHE_Clear(void);
+
+/* Boots stored, the memory they take in bytes, and the restores that
+   found and did not find their boot since the cache was configured */
+int AI_BOOTCACHE_Entries(void);
+size_t AI_BOOTCACHE_Bytes(void);
+int AI_BOOTCACHE_Hits(void);
+int AI_BOOTCACHE_Misses(void);
+
+#endif /* AI_BOOTCACHE_H_ */
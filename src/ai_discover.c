@@ -0,0 +1,176 @@
+/*
+ * ai_discover.c - Finding the RAM variables behind game events
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+#include "config.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "ai_discover.h"
+#include "memory.h"
+#include "util.h"
+
+static UBYTE *snapshots = NULL;   /* ring of capacity 64 KB snapshots */
+static int *frame_of = NULL;      /* the frame each one is the end of */
+static int capacity = 0;
+static int head = 0;              /* slot of the oldest */
+static int recorded = 0;
+
+/* Per-address counts for AI_DISCOVER_Rank() */
+static UWORD at_event[0x10000], elsewhere[0x10000], up[0x10000], down[0x10000];
+
+#define SLOT(i) ((head + (i)) % capacity)
+#define SNAPSHOT(i) (snapshots + ((size_t)SLOT(i) << 16))
+
+int AI_DISCOVER_Start(int frames) {
+    if (frames < 2 || frames > AI_DISCOVER_MAX_FRAMES)
+        return FALSE;
+    AI_DISCOVER_Stop();
+    snapshots = (UBYTE *)Util_malloc((size_t)frames << 16);
+    frame_of = (int *)Util_malloc(frames * sizeof(int));
+    capacity = frames;
+    return TRUE;
+}
+
+void AI_DISCOVER_Stop(void) {
+    free(snapshots);
+    free(frame_of);
+    snapshots = NULL;
+    frame_of = NULL;
+    capacity = head = recorded = 0;
+}
+
+void AI_DISCOVER_Frame(void) {
+    int slot;
+
+    if (capacity == 0)
+        return;
+    /* A rewind went back before them */
+    while (recorded > 0 && frame_of[SLOT(recorded - 1)] > Atari800_nframes)
+        recorded--;
+    if (recorded > 0 && frame_of[SLOT(recorded - 1)] == Atari800_nframes)
+        return;
+    if (recorded == capacity) {
+        head = SLOT(1);
+        recorded--;
+    }
+    slot = SLOT(recorded);
+    memcpy(snapshots + ((size_t)slot << 16), MEMORY_mem, 0x10000);
+    frame_of[slot] = Atari800_nframes;
+    recorded++;
+}
+
+int AI_DISCOVER_Recorded(int *first, int *last) {
+    if (recorded > 0) {
+        *first = frame_of[SLOT(0)];
+        *last = frame_of[SLOT(recorded - 1)];
+    }
+    else
+        *first = *last = -1;
+    return recorded;
+}
+
+/* Each frame is compared with the one before over all 64 K addresses at
+   once, 16 bytes at a time with SSE2 where available. Most bytes do not
+   change from one frame to the next, so unchanged runs are skipped. */
+#ifdef __SSE2__
+/* Adds 1 to the counts of the bytes set in mask */
+static void add_mask(UWORD *counts, __m128i mask) {
+    __m128i *c = (__m128i *)counts;
+    _mm_storeu_si128(c, _mm_sub_epi16(_mm_loadu_si128(c), _mm_unpacklo_epi8(mask, mask)));
+    _mm_storeu_si128(c + 1, _mm_sub_epi16(_mm_loadu_si128(c + 1), _mm_unpackhi_epi8(mask, mask)));
+}
+#endif
+
+static void count_changes(const UBYTE *old, const UBYTE *now, int event) {
+    int i;
+#ifdef __SSE2__
+    __m128i ones = _mm_set1_epi8(-1);
+
+    for (i = 0; i < 0x10000; i += 16) {
+        __m128i n = _mm_loadu_si128((const __m128i *)(now + i));
+        __m128i o = _mm_loadu_si128((const __m128i *)(old + i));
+        __m128i eq = _mm_cmpeq_epi8(n, o);
+        __m128i le;
+        if (_mm_movemask_epi8(eq) == 0xffff)
+            continue;
+        if (!event) {
+            add_mask(elsewhere + i, _mm_xor_si128(eq, ones));
+            continue;
+        }
+        le = _mm_cmpeq_epi8(_mm_min_epu8(n, o), n);
+        add_mask(at_event + i, _mm_xor_si128(eq, ones));
+        add_mask(up + i, _mm_xor_si128(le, ones));
+        add_mask(down + i, _mm_andnot_si128(eq, le));
+    }
+#else
+    for (i = 0; i < 0x10000; i++) {
+        if (now[i] == old[i])
+            continue;
+        if (!event)
+            elsewhere[i]++;
+        else {
+            at_event[i]++;
+            if (now[i] > old[i])
+                up[i]++;
+            else
+                down[i]++;
+        }
+    }
+#endif
+}
+
+int AI_DISCOVER_Rank(const int *events, int nevents, int window,
+                     AI_DISCOVER_Result *results, int max, int *frames, int *event_frames) {
+    int t, i, n = 0, e = 0, nresults = 0;
+
+    if (recorded < 2)
+        return -1;
+    if (max <= 0)
+        max = 0;
+    memset(at_event, 0, sizeof(at_event));
+    memset(elsewhere, 0, sizeof(elsewhere));
+    memset(up, 0, sizeof(up));
+    memset(down, 0, sizeof(down));
+    /* Frame t is the change from the snapshot before it */
+    for (t = 1; t < recorded; t++) {
+        int frame = frame_of[SLOT(t)], event = FALSE;
+        for (i = 0; i < nevents && !event; i++)
+            event = abs(events[i] - frame) <= window;
+        count_changes(SNAPSHOT(t - 1), SNAPSHOT(t), event);
+        e += event;
+        n++;
+    }
+    *frames = n;
+    *event_frames = e;
+
+    for (i = 0; i < 0x10000; i++) {
+        double n11 = at_event[i], n10 = elsewhere[i];
+        double n01 = e - n11, n00 = (n - e) - n10;
+        double den = (n11 + n10) * (n01 + n00) * e * (n - e);
+        double score;
+        int j;
+        if (den == 0.0)
+            continue;   /* never or always changes, or no events */
+        score = (n11 * n00 - n10 * n01) / sqrt(den);
+        if (score <= 0.0 || max == 0 || (nresults == max && score <= results[max - 1].score))
+            continue;
+        /* Insert it among the best, ties in address order */
+        for (j = nresults < max ? nresults++ : max - 1; j > 0 && results[j - 1].score < score; j--)
+            results[j] = results[j - 1];
+        results[j].addr = (UWORD)i;
+        results[j].score = score;
+        results[j].at_events = at_event[i];
+        results[j].elsewhere = elsewhere[i];
+        results[j].up = up[i];
+        results[j].down = down[i];
+    }
+    return nresults;
+}
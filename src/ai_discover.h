@@ -0,0 +1,59 @@
+/*
+ * ai_discover.h - Finding the RAM variables behind game events
+ *
+ * While recording, the 64 KB of RAM the CPU sees is kept at the end of
+ * every frame, in a ring of the last so many frames. Given the frames at
+ * which something happened, such as the score going up or a life being
+ * lost, every address is tested at once for how well the frames at which
+ * it changed match those: the phi coefficient of "changed in this frame"
+ * and "an event in this frame" over the recorded frames. The counts are
+ * gathered a frame at a time over all 64 K addresses, with SSE2 where
+ * available.
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+#ifndef AI_DISCOVER_H_
+#define AI_DISCOVER_H_
+
+#include "atari.h"
+
+#define AI_DISCOVER_DEFAULT_FRAMES 600
+#define AI_DISCOVER_MAX_FRAMES 4096
+#define AI_DISCOVER_MAX_RESULTS 256
+
+typedef struct {
+    UWORD addr;
+    double score;       /* phi of its changes and the events, -1..1 */
+    int at_events;      /* frames with an event in which it changed */
+    int elsewhere;      /* other frames in which it changed */
+    int up, down;       /* of the first, those it went up and down in */
+} AI_DISCOVER_Result;
+
+/* Start recording the RAM of up to frames frames, dropping any recorded
+   so far. Returns FALSE if frames is out of range. */
+int AI_DISCOVER_Start(int frames);
+
+/* Stop recording and free the snapshots */
+void AI_DISCOVER_Stop(void);
+
+/* Record the RAM at the end of frame Atari800_nframes: call between
+   frames. Calling it again for the same frame does nothing; after a
+   rewind the frames from the one rewound to on are recorded anew. */
+void AI_DISCOVER_Frame(void);
+
+/* Number of frames recorded (0 when not recording), and the first and
+   last of them */
+int AI_DISCOVER_Recorded(int *first, int *last);
+
+/* Ranks the addresses by how the frames in which they changed match the
+   events, frame numbers at which something happened; a frame within
+   window frames of an event counts as one with an event. Stores up to max
+   results, best first, the number of frames compared and how many of them
+   had an event; returns how many results it stored, or -1 if fewer than
+   two frames are recorded. */
+int AI_DISCOVER_Rank(const int *events, int nevents, int window,
+                     AI_DISCOVER_Result *results, int max, int *frames, int *event_frames);
+
+#endif /* AI_DISCOVER_H_ */
@@ -0,0 +1,78 @@
+/*
+ * ai_features.c - Memory-derived features evaluated natively
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+#include "config.h"
+#include <string.h>
+
+#include "ai_features.h"
+#include "memory.h"
+
+const char * const AI_FEATURE_kind_names[AI_FEATURE_KINDS] = {
+    "byte", "sbyte", "word", "word_be", "bcd", "bcd_le", "bit"
+};
+
+const char *AI_FEATURE_Set(AI_FEATURE_Table *t, const AI_FEATURE_Def *defs, int n) {
+    int i;
+
+    if (n < 0 || n > AI_FEATURE_MAX)
+        return "too many features";
+    for (i = 0; i < n; i++) {
+        if (defs[i].kind < 0 || defs[i].kind >= AI_FEATURE_KINDS)
+            return "unknown feature kind";
+        if ((defs[i].kind == AI_FEATURE_BCD || defs[i].kind == AI_FEATURE_BCD_LE)
+            && (defs[i].len < 1 || defs[i].len > AI_FEATURE_MAX_BCD))
+            return "BCD length must be 1 to 4 bytes";
+    }
+    memcpy(t->def, defs, n * sizeof(AI_FEATURE_Def));
+    t->n = n;
+    t->primed = FALSE;
+    return NULL;
+}
+
+/* Reads as the monitor does: hardware registers without side effects */
+#define PEEK(addr) ((UBYTE)MEMORY_SafeGetByte((UWORD)(addr)))
+
+static long feature_value(const AI_FEATURE_Def *d) {
+    long v = 0;
+    int i;
+
+    switch (d->kind) {
+    case AI_FEATURE_BYTE:
+        return PEEK(d->addr) & d->mask;
+    case AI_FEATURE_SBYTE:
+        return (SBYTE)(PEEK(d->addr) & d->mask);
+    case AI_FEATURE_WORD:
+        return PEEK(d->addr) | PEEK(d->addr + 1) << 8;
+    case AI_FEATURE_WORD_BE:
+        return PEEK(d->addr) << 8 | PEEK(d->addr + 1);
+    case AI_FEATURE_BCD:
+    case AI_FEATURE_BCD_LE:
+        for (i = 0; i < d->len; i++) {
+            UBYTE b = PEEK(d->addr + (d->kind == AI_FEATURE_BCD ? i : d->len - 1 - i));
+            /* Games often blank leading digits with a nibble above 9 */
+            v = v * 100 + ((b >> 4) > 9 ? 0 : (b >> 4)) * 10 + ((b & 15) > 9 ? 0 : (b & 15));
+        }
+        return v;
+    case AI_FEATURE_BIT:
+        return (PEEK(d->addr) & d->mask) != 0;
+    default:
+        return 0;
+    }
+}
+
+void AI_FEATURE_Eval(AI_FEATURE_Table *t, float *out) {
+    int i;
+
+    for (i = 0; i < t->n; i++) {
+        const AI_FEATURE_Def *d = &t->def[i];
+        long v = feature_value(d);
+        long prev = t->primed ? t->prev[i] : v;
+        t->prev[i] = v;
+        out[i] = d->scale * (float)(d->delta ? v - prev : v);
+    }
+    t->primed = TRUE;
+}
@@ -0,0 +1,61 @@
+/*
+ * ai_features.h - Memory-derived features evaluated natively
+ *
+ * A feature table lists values to read out of the 64 KB the CPU sees, such
+ * as a score kept in BCD, a lives counter or a flag bit, each optionally
+ * as its change since the previous evaluation and scaled. Evaluating the
+ * table writes one float per feature, so rewards and game state reach a
+ * client as a small array instead of it reading and decoding memory after
+ * every step.
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+#ifndef AI_FEATURES_H_
+#define AI_FEATURES_H_
+
+#include "atari.h"
+
+/* Kinds of feature (also used by libatari800.h) */
+#define AI_FEATURE_BYTE    0  /* the byte at addr, and mask */
+#define AI_FEATURE_SBYTE   1  /* the byte at addr, and mask, signed */
+#define AI_FEATURE_WORD    2  /* the word at addr, low byte first */
+#define AI_FEATURE_WORD_BE 3  /* the word at addr, high byte first */
+#define AI_FEATURE_BCD     4  /* len bytes of packed BCD, most significant first */
+#define AI_FEATURE_BCD_LE  5  /* len bytes of packed BCD, least significant first */
+#define AI_FEATURE_BIT     6  /* 1 if the byte at addr and mask is not 0, else 0 */
+#define AI_FEATURE_KINDS   7
+
+#define AI_FEATURE_MAX 64
+#define AI_FEATURE_MAX_BCD 4  /* bytes, 8 digits */
+
+typedef struct {
+    int kind;
+    UWORD addr;
+    int len;        /* bytes of a BCD number, 1..AI_FEATURE_MAX_BCD */
+    UBYTE mask;     /* for AI_FEATURE_BYTE, _SBYTE and _BIT */
+    int delta;      /* the change since the previous evaluation */
+    float scale;    /* the value is multiplied by it */
+} AI_FEATURE_Def;
+
+typedef struct {
+    int n;
+    AI_FEATURE_Def def[AI_FEATURE_MAX];
+    long prev[AI_FEATURE_MAX];  /* values at the previous evaluation */
+    int primed;                 /* prev holds them */
+} AI_FEATURE_Table;
+
+/* Kind names as the AI interface spells them: "byte", "sbyte", "word",
+   "word_be", "bcd", "bcd_le", "bit" */
+extern const char * const AI_FEATURE_kind_names[AI_FEATURE_KINDS];
+
+/* Replace the features of t with the n of defs, checking them first.
+   Returns NULL, or what is wrong with them, leaving t unchanged. Deltas
+   start from the first evaluation, at which they are 0. */
+const char *AI_FEATURE_Set(AI_FEATURE_Table *t, const AI_FEATURE_Def *defs, int n);
+
+/* Evaluate t into out, t->n floats */
+void AI_FEATURE_Eval(AI_FEATURE_Table *t, float *out);
+
+#endif /* AI_FEATURES_H_ */
@@ -0,0 +1,591 @@
+/*
+ * ai_forkserver.c - Spawn AI instances by forking a booted emulator
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+#define _GNU_SOURCE /* sched_setaffinity */
+#include "config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <sys/mman.h>
+#include <signal.h>
+#ifdef HAVE_SCHED_SETAFFINITY
+#include <sched.h>
+#endif
+
+#include "ai_forkserver.h"
+#include "ai_interface.h"
+#include "log.h"
+#include "util.h"
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+#define REQUEST_SIZE 1024
+
+typedef struct {
+    int fd;                     /* -1 = free */
+    int len;                    /* bytes in buf */
+    char buf[REQUEST_SIZE];
+} conn_t;
+
+/* What the fork server knows of a child. The table is shared with the
+   children, which keep their own clients and frames up to date. */
+typedef struct {
+    int pid;                    /* 0 = free */
+    int pooled;                 /* one of the -ai-pool instances */
+    int leased;                 /* handed out by "acquire" ... */
+    double lease_time;          /* ... at this time */
+    volatile int clients;       /* connected, by the child */
+    volatile int served;        /* has had a client, by the child */
+    volatile int frames;        /* run since the fork, by the child */
+} slot_t;
+
+static int listen_fd = -1;
+static int net_fd = -1;        /* -ai-listen as well, or -1 */
+static conn_t conns[AI_FORKSERVER_MAX_CLIENTS];
+static char server_path[256];
+static char server_listen[256];  /* the -ai-listen address, or empty */
+static int ready_fd = -1;      /* in a child, the pipe to the fork server */
+static int children = 0;       /* alive */
+static int spawned = 0;
+static int pool_size = 0;      /* -ai-pool */
+static int pool_pin = FALSE;
+static slot_t *slots = NULL;   /* AI_FORKSERVER_MAX_SLOTS, the first pool_size for the pool */
+static slot_t *own_slot = NULL;  /* in a child */
+static int fork_frame;         /* Atari800_nframes the children started from */
+static double done_frames = 0; /* run by the children that exited */
+static double stats_time;      /* and the total at the last "stats" */
+static double stats_frames = 0;
+
+static const char *get_string(const char *json, const char *key, char *buf, int bufsize) {
+    char search[64];
+    const char *p;
+    int i = 0;
+
+    snprintf(search, sizeof(search), "\"%s\":", key);
+    p = strstr(json, search);
+    if (p == NULL) return NULL;
+    p += strlen(search);
+    while (*p == ' ' || *p == '\t') p++;
+    if (*p != '"') return NULL;
+    p++;
+    while (*p && *p != '"' && i < bufsize - 1) {
+        if (*p == '\\' && *(p + 1)) p++;
+        buf[i++] = *p++;
+    }
+    buf[i] = '\0';
+    return buf;
+}
+
+static int open_socket(const char *path) {
+    struct sockaddr_un addr;
+    int i, tcp;
+
+    unlink(path);
+    listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd < 0) {
+        Log_print("AI: Failed to create the fork server socket: %s", strerror(errno));
+        return FALSE;
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+    if (bind(listen_fd, (struct sockaddr *)&addr, sizeof(addr)) < 0
+        || listen(listen_fd, AI_FORKSERVER_MAX_CLIENTS) < 0) {
+        Log_print("AI: Failed to listen on %s: %s", path, strerror(errno));
+        close(listen_fd);
+        listen_fd = -1;
+        return FALSE;
+    }
+    if (server_listen[0]) {
+        net_fd = AI_ListenSocket(server_listen, &tcp);
+        if (net_fd < 0 || listen(net_fd, AI_FORKSERVER_MAX_CLIENTS) < 0) {
+            if (net_fd >= 0) close(net_fd);
+            net_fd = -1;
+            close(listen_fd);
+            listen_fd = -1;
+            return FALSE;
+        }
+    }
+    for (i = 0; i < AI_FORKSERVER_MAX_CLIENTS; i++)
+        conns[i].fd = -1;
+    Log_print("AI: Fork server listening on %s%s%s", path,
+              server_listen[0] ? " and " : "", server_listen);
+    return TRUE;
+}
+
+/* The table of children, in memory the children share */
+static int open_slots(void) {
+    slots = (slot_t *)mmap(NULL, AI_FORKSERVER_MAX_SLOTS * sizeof(slot_t),
+                           PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (slots == MAP_FAILED) {
+        Log_print("AI: Cannot map the fork server's table: %s", strerror(errno));
+        slots = NULL;
+        return FALSE;
+    }
+    memset(slots, 0, AI_FORKSERVER_MAX_SLOTS * sizeof(slot_t));
+    return TRUE;
+}
+
+static slot_t *find_slot(int pid) {
+    int i;
+    for (i = 0; i < AI_FORKSERVER_MAX_SLOTS; i++)
+        if (slots[i].pid == pid) return &slots[i];
+    return NULL;
+}
+
+/* Network children listen on the fork server's port + 1 + their slot */
+static void child_address(int slot, char *buf, int size) {
+    const char *port = strrchr(server_listen, ':');
+    snprintf(buf, size, "%.*s:%ld", (int)(port - server_listen), server_listen,
+             strtol(port + 1, NULL, 0) + 1 + slot);
+}
+
+/* A pool instance runs on one core of those the fork server may use */
+static void pin_child(int slot) {
+#ifdef HAVE_SCHED_SETAFFINITY
+    cpu_set_t allowed, one;
+    int i, n;
+
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) < 0)
+        return;
+    n = slot % CPU_COUNT(&allowed);
+    for (i = 0; i < CPU_SETSIZE; i++) {
+        if (CPU_ISSET(i, &allowed) && n-- == 0) {
+            CPU_ZERO(&one);
+            CPU_SET(i, &one);
+            if (sched_setaffinity(0, sizeof(one), &one) < 0)
+                Log_print("AI: Cannot pin to CPU %d: %s", i, strerror(errno));
+            return;
+        }
+    }
+#endif
+}
+
+static void close_conn(conn_t *c) {
+    close(c->fd);
+    c->fd = -1;
+    c->len = 0;
+}
+
+/* Replies are short; a client that cannot take one is dropped */
+static void reply(conn_t *c, const char *json) {
+    char msg[REQUEST_SIZE];
+    int len = snprintf(msg, sizeof(msg), "%d\n%s", (int)strlen(json), json);
+    int off = 0;
+
+    while (off < len) {
+        int w = send(c->fd, msg + off, len - off, MSG_NOSIGNAL);
+        if (w < 0 && errno == EINTR) continue;
+        if (w <= 0) {
+            close_conn(c);
+            return;
+        }
+        off += w;
+    }
+}
+
+static void reap(void) {
+    int status;
+    pid_t pid;
+    while ((pid = waitpid(-1, &status, WNOHANG)) > 0) {
+        slot_t *slot = find_slot((int)pid);
+        children--;
+        if (slot != NULL) {
+            done_frames += slot->frames;
+            memset(slot, 0, sizeof(*slot));
+        }
+    }
+}
+
+/* A child no one has connected to, or been handed, yet */
+static int idle(const slot_t *slot) {
+    return slot->pid != 0 && !slot->served && slot->clients == 0
+           && (!slot->leased || Util_time() - slot->lease_time > AI_FORKSERVER_TIMEOUT / 1000.0);
+}
+
+/* Fork a child into slot, listening on socket (NULL for the default);
+   returns TRUE in the child. In the fork server *pid is the child, or -1
+   if it could not be forked, and *ok whether it opened its socket. */
+static int fork_child(int slot, const char *socket, const char *shm,
+                      char *socket_path, int socket_size, char *listen_addr, int listen_size,
+                      char *shm_name, int shm_size, pid_t *pid, int *ok) {
+    struct pollfd pfd;
+    int pipefd[2];
+    char c = 0;
+    int i;
+
+    *ok = FALSE;
+    *pid = -1;
+    if (pipe(pipefd) < 0)
+        return FALSE;
+    /* Or what is buffered would be written by the child as well */
+    fflush(stdout);
+    fflush(stderr);
+    *pid = fork();
+    if (*pid < 0) {
+        close(pipefd[0]);
+        close(pipefd[1]);
+        return FALSE;
+    }
+    if (*pid == 0) {
+        /* The child: the fork server's sockets are not its own */
+        close(pipefd[0]);
+        ready_fd = pipefd[1];
+        close(listen_fd);
+        listen_fd = -1;
+        if (net_fd >= 0) {
+            close(net_fd);
+            net_fd = -1;
+        }
+        for (i = 0; i < AI_FORKSERVER_MAX_CLIENTS; i++)
+            if (conns[i].fd >= 0) close_conn(&conns[i]);
+        if (socket != NULL)
+            Util_strlcpy(socket_path, socket, socket_size);
+        else
+            snprintf(socket_path, socket_size, "%s.%d", server_path, (int)getpid());
+        if (socket == NULL && server_listen[0])
+            child_address(slot, listen_addr, listen_size);
+        else
+            listen_addr[0] = '\0';
+        Util_strlcpy(shm_name, shm, shm_size);
+        own_slot = &slots[slot];
+        own_slot->pid = (int)getpid();
+        if (own_slot->pooled && pool_pin)
+            pin_child(slot);
+        return TRUE;
+    }
+
+    close(pipefd[1]);
+    slots[slot].pid = (int)*pid;
+    children++;
+    spawned++;
+    /* Answer once the child listens, so the client can connect at once */
+    pfd.fd = pipefd[0];
+    pfd.events = POLLIN;
+    if (poll(&pfd, 1, AI_FORKSERVER_TIMEOUT) > 0 && read(pipefd[0], &c, 1) == 1)
+        *ok = c != 0;
+    close(pipefd[0]);
+    return FALSE;
+}
+
+/* Where a client reaches the child in slot, as JSON members */
+static void child_json(int slot, const char *socket, char *buf, int size) {
+    if (socket == NULL && server_listen[0]) {
+        char addr[sizeof(server_listen) + 16];
+        child_address(slot, addr, sizeof(addr));
+        snprintf(buf, size, "\"pid\":%d,\"address\":\"%s\",\"port\":%ld", slots[slot].pid, addr,
+                 strtol(strrchr(addr, ':') + 1, NULL, 0));
+    }
+    else if (socket == NULL)
+        snprintf(buf, size, "\"pid\":%d,\"socket\":\"%s.%d\"", slots[slot].pid, server_path, slots[slot].pid);
+    else
+        snprintf(buf, size, "\"pid\":%d,\"socket\":\"%s\"", slots[slot].pid, socket);
+}
+
+/* Fork a child for a spawn request; returns TRUE in the child */
+static int spawn(conn_t *c, const char *request, char *socket_path, int socket_size,
+                 char *listen_addr, int listen_size, char *shm_name, int shm_size) {
+    char socket[sizeof(server_path) + 16], shm[256], where[512], json[768];
+    const char *path = get_string(request, "socket", socket, sizeof(socket));
+    double start = Util_time();
+    pid_t pid;
+    int slot, ok;
+
+    if (!get_string(request, "shm", shm, sizeof(shm)))
+        shm[0] = '\0';
+    for (slot = pool_size; slot < AI_FORKSERVER_MAX_SLOTS && slots[slot].pid != 0; slot++)
+        ;
+    if (slot == AI_FORKSERVER_MAX_SLOTS) {
+        reply(c, "{\"status\":\"error\",\"msg\":\"Too many children\"}");
+        return FALSE;
+    }
+    if (fork_child(slot, path, shm, socket_path, socket_size, listen_addr, listen_size,
+                   shm_name, shm_size, &pid, &ok))
+        return TRUE;
+    if (pid < 0) {
+        snprintf(json, sizeof(json), "{\"status\":\"error\",\"msg\":\"Cannot fork: %s\"}", strerror(errno));
+        reply(c, json);
+        return FALSE;
+    }
+    child_json(slot, path, where, sizeof(where));
+    if (ok)
+        snprintf(json, sizeof(json), "{\"status\":\"ok\",%s,\"spawn_us\":%.0f}",
+                 where, (Util_time() - start) * 1e6);
+    else
+        snprintf(json, sizeof(json), "{\"status\":\"error\",\"msg\":\"The child could not open its socket\",%s}",
+                 where);
+    reply(c, json);
+    return FALSE;
+}
+
+/* Keep the pool full; returns TRUE in a new instance */
+static int fill_pool(char *socket_path, int socket_size, char *listen_addr, int listen_size,
+                     char *shm_name, int shm_size) {
+    int i;
+
+    for (i = 0; i < pool_size; i++) {
+        pid_t pid;
+        int ok;
+        if (slots[i].pid != 0) continue;
+        slots[i].pooled = TRUE;
+        if (fork_child(i, NULL, "", socket_path, socket_size, listen_addr, listen_size,
+                       shm_name, shm_size, &pid, &ok))
+            return TRUE;
+        if (pid < 0) {
+            /* Tried again on the next wake */
+            Log_print("AI: Cannot fork a pool instance: %s", strerror(errno));
+            slots[i].pooled = FALSE;
+            break;
+        }
+        if (!ok)
+            Log_print("AI: Pool instance %d could not open its socket", (int)pid);
+    }
+    return FALSE;
+}
+
+/* Lease an idle pool instance to a client */
+static void acquire(conn_t *c) {
+    char where[512], json[640];
+    int i;
+
+    for (i = 0; i < pool_size && !idle(&slots[i]); i++)
+        ;
+    if (i == pool_size) {
+        reply(c, pool_size > 0 ? "{\"status\":\"error\",\"msg\":\"No idle instance\"}"
+                               : "{\"status\":\"error\",\"msg\":\"No pool (-ai-pool)\"}");
+        return;
+    }
+    slots[i].leased = TRUE;
+    slots[i].lease_time = Util_time();
+    child_json(i, NULL, where, sizeof(where));
+    snprintf(json, sizeof(json), "{\"status\":\"ok\",%s}", where);
+    reply(c, json);
+}
+
+/* The frames run by every child so far */
+static double total_frames(void) {
+    double total = done_frames;
+    int i;
+    for (i = 0; i < AI_FORKSERVER_MAX_SLOTS; i++)
+        if (slots[i].pid != 0) total += slots[i].frames;
+    return total;
+}
+
+static void stats(conn_t *c) {
+    char json[512];
+    double now = Util_time(), total = total_frames();
+    int i, idle_n = 0, busy = 0;
+
+    for (i = 0; i < AI_FORKSERVER_MAX_SLOTS; i++) {
+        if (slots[i].pid == 0) continue;
+        if (slots[i].clients > 0) busy++;
+        else if (i < pool_size && idle(&slots[i])) idle_n++;
+    }
+    snprintf(json, sizeof(json),
+             "{\"status\":\"ok\",\"children\":%d,\"pool\":%d,\"idle\":%d,\"busy\":%d,"
+             "\"frames\":%.0f,\"fps\":%.1f}",
+             children, pool_size, idle_n, busy, total,
+             now > stats_time ? (total - stats_frames) / (now - stats_time) : 0.0);
+    stats_time = now;
+    stats_frames = total;
+    reply(c, json);
+}
+
+/* Serve one request; returns 1 in a spawned child, -1 on shutdown */
+static int handle_request(conn_t *c, const char *request, char *socket_path, int socket_size,
+                          char *listen_addr, int listen_size, char *shm_name, int shm_size) {
+    char cmd[32] = "";
+    char json[256];
+
+    get_string(request, "cmd", cmd, sizeof(cmd));
+    if (strcmp(cmd, "spawn") == 0)
+        return spawn(c, request, socket_path, socket_size, listen_addr, listen_size,
+                     shm_name, shm_size) ? 1 : 0;
+    reap();
+    if (strcmp(cmd, "status") == 0) {
+        snprintf(json, sizeof(json), "{\"status\":\"ok\",\"children\":%d,\"spawned\":%d,\"frame\":%d}",
+                 children, spawned, Atari800_nframes);
+        reply(c, json);
+    }
+    else if (strcmp(cmd, "acquire") == 0)
+        acquire(c);
+    else if (strcmp(cmd, "release") == 0) {
+        char *p = strstr(request, "\"pid\":");
+        slot_t *slot = p != NULL ? find_slot(atoi(p + 6)) : NULL;
+        if (slot == NULL)
+            reply(c, "{\"status\":\"error\",\"msg\":\"No such instance\"}");
+        else {
+            slot->leased = FALSE;
+            reply(c, "{\"status\":\"ok\"}");
+        }
+    }
+    else if (strcmp(cmd, "stats") == 0)
+        stats(c);
+    else if (strcmp(cmd, "ping") == 0)
+        reply(c, "{\"status\":\"ok\",\"msg\":\"pong\"}");
+    else if (strcmp(cmd, "shutdown") == 0) {
+        reply(c, "{\"status\":\"ok\"}");
+        return -1;
+    }
+    else {
+        snprintf(json, sizeof(json), "{\"status\":\"error\",\"msg\":\"Unknown fork server command: %s\"}", cmd);
+        reply(c, json);
+    }
+    return 0;
+}
+
+/* Read what the client sent and serve the complete requests in it */
+static int serve_conn(conn_t *c, char *socket_path, int socket_size, char *listen_addr, int listen_size,
+                      char *shm_name, int shm_size) {
+    int r = read(c->fd, c->buf + c->len, sizeof(c->buf) - 1 - c->len);
+
+    if (r <= 0) {
+        if (r < 0 && (errno == EINTR || errno == EAGAIN)) return 0;
+        close_conn(c);
+        return 0;
+    }
+    c->len += r;
+    while (c->fd >= 0) {
+        char request[REQUEST_SIZE];
+        char *nl = memchr(c->buf, '\n', c->len);
+        int hlen, len, result;
+        if (nl == NULL) {
+            if (c->len == sizeof(c->buf) - 1) close_conn(c);
+            break;
+        }
+        hlen = nl - c->buf + 1;
+        len = atoi(c->buf);
+        if (len <= 0 || hlen + len > (int)sizeof(c->buf) - 1) {
+            Log_print("AI: Bad fork server request");
+            close_conn(c);
+            break;
+        }
+        if (c->len < hlen + len) break;
+        memcpy(request, c->buf + hlen, len);
+        request[len] = '\0';
+        c->len -= hlen + len;
+        memmove(c->buf, c->buf + hlen + len, c->len);
+        result = handle_request(c, request, socket_path, socket_size, listen_addr, listen_size,
+                                shm_name, shm_size);
+        if (result != 0) return result;
+    }
+    return 0;
+}
+
+void AI_FORKSERVER_SetPool(int size, int pin) {
+    pool_size = size < 0 ? 0 : size > AI_FORKSERVER_MAX_SLOTS ? AI_FORKSERVER_MAX_SLOTS : size;
+    pool_pin = pin;
+}
+
+int AI_FORKSERVER_Serve(const char *path, char *socket_path, int socket_size,
+                        char *listen_addr, int listen_size, char *shm_name, int shm_size) {
+    int i;
+
+    Util_strlcpy(server_path, path, sizeof(server_path));
+    Util_strlcpy(server_listen, listen_addr, sizeof(server_listen));
+    if (!open_slots() || !open_socket(path))
+        return -1;
+    fork_frame = Atari800_nframes;
+    stats_time = Util_time();
+    for (;;) {
+        struct pollfd fds[AI_FORKSERVER_MAX_CLIENTS + 2];
+        conn_t *owner[AI_FORKSERVER_MAX_CLIENTS + 2];
+        int n = 0;
+
+        reap();
+        if (fill_pool(socket_path, socket_size, listen_addr, listen_size, shm_name, shm_size))
+            return 1;
+        for (i = 0; i < AI_FORKSERVER_MAX_CLIENTS; i++) {
+            if (conns[i].fd < 0) continue;
+            fds[n].fd = conns[i].fd;
+            fds[n].events = POLLIN;
+            owner[n++] = &conns[i];
+        }
+        fds[n].fd = listen_fd;
+        fds[n].events = POLLIN;
+        owner[n++] = NULL;
+        if (net_fd >= 0) {
+            fds[n].fd = net_fd;
+            fds[n].events = POLLIN;
+            owner[n++] = NULL;
+        }
+        /* Wake now and then to reap the children that exited */
+        if (poll(fds, n, 1000) < 0 && errno != EINTR)
+            break;
+        reap();
+        for (i = 0; i < n; i++) {
+            int result;
+            if (!(fds[i].revents & (POLLIN | POLLHUP | POLLERR)))
+                continue;
+            if (owner[i] == NULL) {
+                int fd = accept(fds[i].fd, NULL, NULL), j;
+                if (fd < 0) continue;
+                for (j = 0; j < AI_FORKSERVER_MAX_CLIENTS && conns[j].fd >= 0; j++)
+                    ;
+                if (j == AI_FORKSERVER_MAX_CLIENTS) {
+                    Log_print("AI: Too many fork server clients, refusing connection");
+                    close(fd);
+                    continue;
+                }
+                conns[j].fd = fd;
+                conns[j].len = 0;
+                continue;
+            }
+            if (owner[i]->fd < 0)
+                continue;
+            result = serve_conn(owner[i], socket_path, socket_size, listen_addr, listen_size,
+                                shm_name, shm_size);
+            if (result > 0)
+                return 1;
+            if (result < 0)
+                goto shutdown;
+        }
+    }
+shutdown:
+    for (i = 0; i < AI_FORKSERVER_MAX_CLIENTS; i++)
+        if (conns[i].fd >= 0) close_conn(&conns[i]);
+    close(listen_fd);
+    listen_fd = -1;
+    if (net_fd >= 0) {
+        close(net_fd);
+        net_fd = -1;
+    }
+    unlink(path);
+    /* Pool instances nobody has taken would wait for a client forever */
+    for (i = 0; i < pool_size; i++)
+        if (slots[i].pid != 0 && !slots[i].leased && !slots[i].served)
+            kill(slots[i].pid, SIGTERM);
+    return 0;
+}
+
+void AI_FORKSERVER_Ready(int ok) {
+    char c = ok ? 1 : 0;
+
+    if (ready_fd < 0) return;
+    if (write(ready_fd, &c, 1) < 0)
+        Log_print("AI: Cannot reach the fork server");
+    close(ready_fd);
+    ready_fd = -1;
+}
+
+int AI_FORKSERVER_Update(int clients) {
+    if (own_slot == NULL) return TRUE;
+    own_slot->clients = clients;
+    if (clients > 0)
+        own_slot->served = TRUE;
+    own_slot->frames = Atari800_nframes - fork_frame;
+    return !own_slot->pooled || clients > 0 || !own_slot->served;
+}
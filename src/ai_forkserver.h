@@ -0,0 +1,101 @@
+/*
+ * ai_forkserver.h - Spawn AI instances by forking a booted emulator
+ *
+ * With -ai-forkserver the emulator starts up once, ROMs, configuration,
+ * machine and any program given to boot, and then, instead of opening
+ * its AI socket, listens on the fork server socket. Each "spawn" request
+ * forks a child that carries on from there with an AI socket of its own.
+ * A child is a copy-on-write image of the booted emulator, so it shares
+ * the ROMs and tables with the others and is ready in well under a
+ * millisecond, where a new process would start up from scratch.
+ *
+ * The fork server speaks the AI socket's length-prefixed JSON:
+ *
+ * {"cmd": "spawn", "socket": "/tmp/env7.sock", "shm": "env7"}
+ *   Fork a child listening on socket (default: the fork server's path
+ *   with ".<pid>" appended), publishing observations to the shared
+ *   memory segment shm if given (as -ai-shm). The reply comes once the
+ *   child's socket accepts connections.
+ *   -> {"status": "ok", "pid": 1234, "socket": "/tmp/env7.sock",
+ *       "spawn_us": 180}
+ *
+ * {"cmd": "status"}
+ *   -> {"status": "ok", "children": 3, "spawned": 10, "frame": 120}
+ *
+ * {"cmd": "acquire"}
+ *   Hand out an idle instance of the -ai-pool, one no client has been
+ *   given or connected to. The lease lapses if no client connects within
+ *   AI_FORKSERVER_TIMEOUT ms.
+ *   -> {"status": "ok", "pid": 1234, "socket": "/tmp/farm.sock.1234"}
+ *      or, with -ai-listen, {"status": "ok", "pid": 1234,
+ *      "address": "*:5003", "port": 5003}
+ *
+ * {"cmd": "release", "pid": 1234}
+ *   Give back an acquired instance that will not be used after all.
+ *   -> {"status": "ok"}
+ *
+ * {"cmd": "stats"}
+ *   Throughput of all the children together: frames run so far, and
+ *   frames per second since the previous stats request.
+ *   -> {"status": "ok", "children": 8, "pool": 8, "idle": 2, "busy": 6,
+ *       "frames": 1523400, "fps": 41250.5}
+ *
+ * {"cmd": "ping"}
+ *   -> {"status": "ok", "msg": "pong"}
+ *
+ * {"cmd": "shutdown"}
+ *   Stop serving and exit; the children keep running.
+ *   -> {"status": "ok"}
+ *
+ * With -ai-pool N[,pin] the fork server keeps N instances ready, for
+ * "acquire" to hand out, each on a core of its own with ",pin". A pool
+ * instance serves one lease: when its last client goes it exits and the
+ * fork server forks a fresh one in its place. To carry an episode over to
+ * another instance, on this host or another, a client takes the state
+ * from one with the binary AI_BIN_STATE_SAVE and gives it to the other
+ * with AI_BIN_STATE_LOAD (see ai_interface.h).
+ *
+ * With -ai-listen [host]:port the fork server takes requests on that
+ * port too, and the instances it forks without a "socket" listen on
+ * port + 1 + n, n below AI_FORKSERVER_MAX_SLOTS, so that learners on
+ * other hosts can use them.
+ *
+ * Only the emulation thread is forked: the children start the sound
+ * worker of -sound-thread afresh, but a sound device, NetSIO and other
+ * threads of the fork server are not theirs. It is meant for headless
+ * use, such as with libatari800 or -nosound.
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+#ifndef AI_FORKSERVER_H_
+#define AI_FORKSERVER_H_
+
+#include "atari.h"
+
+#define AI_FORKSERVER_MAX_CLIENTS 8  /* connections served at once */
+#define AI_FORKSERVER_TIMEOUT 5000   /* ms a child has to open its socket,
+                                        and an acquired one to be connected to */
+#define AI_FORKSERVER_MAX_SLOTS 256  /* children at once */
+
+/* Keep size instances ready for "acquire", pinned to cores if pin */
+void AI_FORKSERVER_SetPool(int size, int pin);
+
+/* Serve spawn requests on the socket path, and on the network address
+   listen_addr unless it is empty. Returns 1 in each child, with the AI
+   socket path, network address (empty for none) and shared memory name
+   (empty for none) it is to use; in the fork server 0 when it is told to
+   shut down, -1 if it cannot listen. */
+int AI_FORKSERVER_Serve(const char *path, char *socket_path, int socket_size,
+                        char *listen_addr, int listen_size, char *shm_name, int shm_size);
+
+/* In a child: tell the fork server whether its AI socket is open */
+void AI_FORKSERVER_Ready(int ok);
+
+/* In a child: report the clients connected now and the frames run, for
+   the fork server's stats. Returns FALSE when a pool instance has lost
+   its last client and is to exit. */
+int AI_FORKSERVER_Update(int clients);
+
+#endif /* AI_FORKSERVER_H_ */
@@ -0,0 +1,221 @@
+/*
+ * ai_hash.c - Hashes of the screen and of the machine state
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+#include "config.h"
+#include <string.h>
+
+#include "ai_hash.h"
+#include "antic.h"
+#include "cpu.h"
+#include "gtia.h"
+#include "memory.h"
+#include "pia.h"
+#include "pokey.h"
+#include "screen.h"
+#include "util.h"
+
+#define PAGE_SIZE 256
+
+static uint64_t rotl(uint64_t x, int n) {
+    return (x << n) | (x >> (64 - n));
+}
+
+/* The MurmurHash3 finaliser: every input bit flips half the output bits */
+static uint64_t mix(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+/* MurmurHash3's 64-bit mixing of len bytes, 8 at a time */
+static uint64_t hash_bytes(const UBYTE *p, size_t len, uint64_t seed) {
+    uint64_t h = seed ^ (len * 0x9e3779b97f4a7c15ULL);
+    uint64_t w;
+
+    for (; len >= 8; p += 8, len -= 8) {
+        memcpy(&w, p, 8);
+        w *= 0x87c37b91114253d5ULL;
+        w = rotl(w, 31);
+        w *= 0x4cf5ad432745937fULL;
+        h ^= w;
+        h = rotl(h, 27) * 5 + 0x52dce729;
+    }
+    if (len > 0) {
+        w = 0;
+        memcpy(&w, p, len);
+        h ^= mix(w);
+    }
+    return mix(h);
+}
+
+uint64_t AI_HASH_Screen(void) {
+    static uint64_t lines[Screen_HEIGHT];
+    const UBYTE *screen = (const UBYTE *)Screen_atari;
+    int x1 = Screen_visible_x1, x2 = Screen_visible_x2;
+    int y1 = Screen_visible_y1, y2 = Screen_visible_y2;
+    int y;
+
+    if (x1 < 0) x1 = 0;
+    if (y1 < 0) y1 = 0;
+    if (x2 > Screen_WIDTH) x2 = Screen_WIDTH;
+    if (y2 > Screen_HEIGHT) y2 = Screen_HEIGHT;
+    if (x2 <= x1 || y2 <= y1) return mix(0);
+    for (y = y1; y < y2; y++)
+        lines[y - y1] = hash_bytes(screen + y * Screen_WIDTH + x1, x2 - x1, 0);
+    return hash_bytes((const UBYTE *)lines, (y2 - y1) * sizeof(uint64_t), 1);
+}
+
+/* The pages of the state as last hashed: the CPU's 256, then the banks */
+static struct {
+    UBYTE *copy;
+    uint64_t *hashes;  /* of each page, seeded with its number */
+    int pages;
+    uint64_t sum;      /* of hashes */
+} state = { NULL, NULL, 0, 0 };
+
+/* Hardware registers, whose bytes in MEMORY_mem are not the machine's */
+static int hardware_page(int page) {
+#ifndef PAGED_ATTRIB
+    return memchr(MEMORY_attrib + (page << 8), MEMORY_HARDWARE, PAGE_SIZE) != NULL;
+#else
+    return MEMORY_readmap[page] != NULL;
+#endif
+}
+
+/* Brings the pages from first on up to date with data, n pages long */
+static void update_pages(int first, const UBYTE *data, int n) {
+    int i;
+    for (i = 0; i < n; i++) {
+        UBYTE *copy = state.copy + (size_t)(first + i) * PAGE_SIZE;
+        const UBYTE *page = data + (size_t)i * PAGE_SIZE;
+        uint64_t h;
+        if (memcmp(copy, page, PAGE_SIZE) == 0)
+            continue;
+        memcpy(copy, page, PAGE_SIZE);
+        h = hash_bytes(page, PAGE_SIZE, first + i);
+        state.sum += h - state.hashes[first + i];
+        state.hashes[first + i] = h;
+    }
+}
+
+static const int bank_kinds[] = { MEMORY_BANK_XE, MEMORY_BANK_AXLON, MEMORY_BANK_MOSAIC };
+static const int bank_sizes[] = { 0x4000, 0x4000, 0x1000 };
+
+/* Brings the pages of every bank, from page 256 of the state on, up to
+   date where they are kept, or counts them if update is FALSE */
+static int bank_pages(int update) {
+    int k, bank, page, n = 0;
+
+    for (k = 0; k < 3; k++) {
+        for (bank = 0; MEMORY_BankPage(bank_kinds[k], bank, 0) != NULL; bank++) {
+            for (page = 0; page < bank_sizes[k] / PAGE_SIZE; page++, n++) {
+                if (update)
+                    update_pages(256 + n, MEMORY_BankPage(bank_kinds[k], bank, page), 1);
+            }
+        }
+    }
+    return n;
+}
+
+uint64_t AI_HASH_State(void) {
+    UBYTE regs[128];
+    UBYTE mem[PAGE_SIZE];
+    int n = 0, i, page, banked;
+
+    banked = bank_pages(FALSE);
+    if (state.pages != 256 + banked) {
+        /* First call, or the machine changed: hash everything again */
+        state.pages = 256 + banked;
+        state.copy = (UBYTE *)Util_realloc(state.copy, (size_t)state.pages * PAGE_SIZE);
+        state.hashes = (uint64_t *)Util_realloc(state.hashes, state.pages * sizeof(uint64_t));
+        state.sum = 0;
+        for (i = 0; i < state.pages; i++) {
+            /* blank pages, which update_pages() replaces where they differ */
+            memset(state.copy + (size_t)i * PAGE_SIZE, 0, PAGE_SIZE);
+            state.hashes[i] = hash_bytes(state.copy + (size_t)i * PAGE_SIZE, PAGE_SIZE, i);
+            state.sum += state.hashes[i];
+        }
+    }
+    memset(mem, 0, sizeof(mem));
+    for (page = 0; page < 256; page++)
+        update_pages(page, hardware_page(page) ? mem : MEMORY_mem + (page << 8), 1);
+    bank_pages(TRUE);
+
+    CPU_GetStatus();
+    regs[n++] = CPU_regA;
+    regs[n++] = CPU_regX;
+    regs[n++] = CPU_regY;
+    regs[n++] = CPU_regS;
+    regs[n++] = CPU_regP;
+    regs[n++] = (UBYTE)CPU_regPC;
+    regs[n++] = (UBYTE)(CPU_regPC >> 8);
+    regs[n++] = ANTIC_DMACTL;
+    regs[n++] = ANTIC_CHACTL;
+    regs[n++] = (UBYTE)ANTIC_dlist;
+    regs[n++] = (UBYTE)(ANTIC_dlist >> 8);
+    regs[n++] = ANTIC_HSCROL;
+    regs[n++] = ANTIC_VSCROL;
+    regs[n++] = ANTIC_PMBASE;
+    regs[n++] = ANTIC_CHBASE;
+    regs[n++] = ANTIC_NMIEN;
+    regs[n++] = ANTIC_NMIST;
+    regs[n++] = (UBYTE)ANTIC_ypos;
+    regs[n++] = (UBYTE)(ANTIC_ypos >> 8);
+    regs[n++] = (UBYTE)ANTIC_xpos;
+    /* The read registers: collisions, triggers, console keys */
+    for (i = 0; i < 0x20; i++)
+        regs[n++] = GTIA_GetByte((UWORD)i, TRUE);
+    regs[n++] = GTIA_HPOSP0;
+    regs[n++] = GTIA_HPOSP1;
+    regs[n++] = GTIA_HPOSP2;
+    regs[n++] = GTIA_HPOSP3;
+    regs[n++] = GTIA_HPOSM0;
+    regs[n++] = GTIA_HPOSM1;
+    regs[n++] = GTIA_HPOSM2;
+    regs[n++] = GTIA_HPOSM3;
+    regs[n++] = GTIA_SIZEP0;
+    regs[n++] = GTIA_SIZEP1;
+    regs[n++] = GTIA_SIZEP2;
+    regs[n++] = GTIA_SIZEP3;
+    regs[n++] = GTIA_SIZEM;
+    regs[n++] = GTIA_GRAFP0;
+    regs[n++] = GTIA_GRAFP1;
+    regs[n++] = GTIA_GRAFP2;
+    regs[n++] = GTIA_GRAFP3;
+    regs[n++] = GTIA_GRAFM;
+    regs[n++] = GTIA_COLPM0;
+    regs[n++] = GTIA_COLPM1;
+    regs[n++] = GTIA_COLPM2;
+    regs[n++] = GTIA_COLPM3;
+    regs[n++] = GTIA_COLPF0;
+    regs[n++] = GTIA_COLPF1;
+    regs[n++] = GTIA_COLPF2;
+    regs[n++] = GTIA_COLPF3;
+    regs[n++] = GTIA_COLBK;
+    regs[n++] = GTIA_PRIOR;
+    regs[n++] = GTIA_VDELAY;
+    regs[n++] = GTIA_GRACTL;
+    /* Pots, KBCODE, RANDOM, SERIN, IRQST, SKSTAT */
+    for (i = 0; i < 0x10; i++)
+        regs[n++] = POKEY_GetByte((UWORD)i, TRUE);
+    for (i = 0; i < 4; i++) {
+        regs[n++] = POKEY_AUDF[i];
+        regs[n++] = POKEY_AUDC[i];
+    }
+    regs[n++] = POKEY_AUDCTL[0];
+    regs[n++] = POKEY_IRQEN;
+    regs[n++] = POKEY_SKCTL;
+    regs[n++] = PIA_PORTA;
+    regs[n++] = PIA_PORTB;
+    regs[n++] = PIA_PACTL;
+    regs[n++] = PIA_PBCTL;
+
+    return mix(state.sum ^ hash_bytes(regs, n, 2));
+}
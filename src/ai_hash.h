@@ -0,0 +1,31 @@
+/*
+ * ai_hash.h - Hashes of the screen and of the machine state
+ *
+ * 64-bit hashes for agents that need to know whether they have seen a
+ * screen or a state before (search, exploration, novelty bonuses) without
+ * fetching and hashing 92 KB screens and 64 KB of RAM every step. They are
+ * not cryptographic, and they are the same across runs and hosts of the
+ * same byte order.
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+#ifndef AI_HASH_H_
+#define AI_HASH_H_
+
+#include <stdint.h>
+
+/* Hash of the visible area of Screen_atari, Screen_visible_x1..x2 /
+   y1..y2: each line is hashed on its own and the line hashes are hashed
+   in order, so equal screens hash equal whatever was drawn before. */
+uint64_t AI_HASH_Screen(void);
+
+/* Hash of the machine state: the CPU's 64 KB but the hardware pages, every
+   XE, Axlon and Mosaic bank, and the registers of the CPU and the chips.
+   Each 256-byte page keeps its hash until it changes; a copy of the pages
+   as last hashed tells which did, so a step that wrote to a few pages
+   costs a compare of the memory and the hashing of those pages. */
+uint64_t AI_HASH_State(void);
+
+#endif /* AI_HASH_H_ */
@@ -0,0 +1,182 @@
+/*
+ * ai_heatmap.c - Memory access heatmap for the AI interface
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+#include "config.h"
+#include <stdlib.h>
+#include <string.h>
+
+#include "ai_heatmap.h"
+#include "memory.h"
+#include "util.h"
+
+ULONG *AI_HEATMAP_counts = NULL;
+
+/* The counters, kept while not counting */
+static ULONG *cpu_counts = NULL;  /* [AI_HEATMAP_KINDS][65536] */
+static struct {
+    ULONG *counts;                /* [AI_HEATMAP_KINDS][entries] */
+    ULONG entries;
+} banks[3] = { { NULL, 0 }, { NULL, 0 }, { NULL, 0 } };
+
+/* By MEMORY_BANK_* */
+static const int bank_sizes[] = { 0x4000, 0x4000, 0x1000 };
+static const UWORD bank_windows[] = { 0x4000, 0x4000, 0xc000 };
+
+/* Accesses of each opcode, including the undocumented ones: bits 7-4 the
+   addressing mode as in MONITOR_optype6502 (1 abs, 2 zp, 3 abs,X, 4 abs,Y,
+   5 (zp,X), 6 (zp),Y, 7 zp,X, 8 zp,Y, D JMP (abs)), bit 0 a read and bit 1
+   a write of the effective address. The stack is dealt with apart. */
+#define ACCESS_READ  1
+#define ACCESS_WRITE 2
+static const UBYTE accesses[256] = {
+    0x00, 0x51, 0x00, 0x53, 0x00, 0x21, 0x23, 0x23, 0x00, 0x00, 0x00, 0x00, 0x00, 0x11, 0x13, 0x13,  /* 0x */
+    0x00, 0x61, 0x00, 0x63, 0x00, 0x71, 0x73, 0x73, 0x00, 0x41, 0x00, 0x43, 0x00, 0x31, 0x33, 0x33,  /* 1x */
+    0x00, 0x51, 0x00, 0x53, 0x21, 0x21, 0x23, 0x23, 0x00, 0x00, 0x00, 0x00, 0x11, 0x11, 0x13, 0x13,  /* 2x */
+    0x00, 0x61, 0x00, 0x63, 0x00, 0x71, 0x73, 0x73, 0x00, 0x41, 0x00, 0x43, 0x00, 0x31, 0x33, 0x33,  /* 3x */
+    0x00, 0x51, 0x00, 0x53, 0x00, 0x21, 0x23, 0x23, 0x00, 0x00, 0x00, 0x00, 0x00, 0x11, 0x13, 0x13,  /* 4x */
+    0x00, 0x61, 0x00, 0x63, 0x00, 0x71, 0x73, 0x73, 0x00, 0x41, 0x00, 0x43, 0x00, 0x31, 0x33, 0x33,  /* 5x */
+    0x00, 0x51, 0x00, 0x53, 0x00, 0x21, 0x23, 0x23, 0x00, 0x00, 0x00, 0x00, 0xd0, 0x11, 0x13, 0x13,  /* 6x */
+    0x00, 0x61, 0x00, 0x63, 0x00, 0x71, 0x73, 0x73, 0x00, 0x41, 0x00, 0x43, 0x00, 0x31, 0x33, 0x33,  /* 7x */
+    0x00, 0x52, 0x00, 0x52, 0x22, 0x22, 0x22, 0x22, 0x00, 0x00, 0x00, 0x00, 0x12, 0x12, 0x12, 0x12,  /* 8x */
+    0x00, 0x62, 0x00, 0x62, 0x72, 0x72, 0x82, 0x82, 0x00, 0x42, 0x00, 0x42, 0x32, 0x32, 0x42, 0x42,  /* 9x */
+    0x00, 0x51, 0x00, 0x51, 0x21, 0x21, 0x21, 0x21, 0x00, 0x00, 0x00, 0x00, 0x11, 0x11, 0x11, 0x11,  /* Ax */
+    0x00, 0x61, 0x00, 0x61, 0x71, 0x71, 0x81, 0x81, 0x00, 0x41, 0x00, 0x41, 0x31, 0x31, 0x41, 0x41,  /* Bx */
+    0x00, 0x51, 0x00, 0x53, 0x21, 0x21, 0x23, 0x23, 0x00, 0x00, 0x00, 0x00, 0x11, 0x11, 0x13, 0x13,  /* Cx */
+    0x00, 0x61, 0x00, 0x63, 0x00, 0x71, 0x73, 0x73, 0x00, 0x41, 0x00, 0x43, 0x00, 0x31, 0x33, 0x33,  /* Dx */
+    0x00, 0x51, 0x00, 0x53, 0x21, 0x21, 0x23, 0x23, 0x00, 0x00, 0x00, 0x00, 0x11, 0x11, 0x13, 0x13,  /* Ex */
+    0x00, 0x61, 0x00, 0x63, 0x00, 0x71, 0x73, 0x73, 0x00, 0x41, 0x00, 0x43, 0x00, 0x31, 0x33, 0x33  /* Fx */
+};
+
+static void count_bank(int kind, UWORD addr) {
+    int k, live, n;
+
+    for (k = 0; k < 3; k++) {
+        ULONG offset = (UWORD)(addr - bank_windows[k]);
+        if (banks[k].entries == 0 || offset >= (ULONG)bank_sizes[k])
+            continue;
+        /* the Self Test ROM covers the middle of the XE window */
+        if (k == MEMORY_BANK_XE && MEMORY_selftest_enabled && addr >= 0x5000 && addr < 0x5800)
+            continue;
+        live = MEMORY_BankLive(k, &n);
+        if (live < 0)
+            continue;
+        offset += (ULONG)live * bank_sizes[k];
+        if (offset < banks[k].entries)
+            banks[k].counts[kind * banks[k].entries + offset]++;
+    }
+}
+
+static void count(int kind, UWORD addr) {
+    AI_HEATMAP_counts[((ULONG)kind << 16) + addr]++;
+    if ((addr & 0xc000) == 0x4000 || (addr & 0xf000) == 0xc000)
+        count_bank(kind, addr);
+}
+
+/* The word at a zero page pointer, which wraps within the page */
+static UWORD pointer(UBYTE zp) {
+    count(AI_HEATMAP_READ, zp);
+    count(AI_HEATMAP_READ, (UBYTE)(zp + 1));
+    return MEMORY_dGetByte(zp) | (MEMORY_dGetByte((UBYTE)(zp + 1)) << 8);
+}
+
+static void push(UBYTE s, int n) {
+    int i;
+    for (i = 0; i < n; i++)
+        count(AI_HEATMAP_WRITE, 0x100 + (UBYTE)(s - i));
+}
+
+static void pull(UBYTE s, int n) {
+    int i;
+    for (i = 1; i <= n; i++)
+        count(AI_HEATMAP_READ, 0x100 + (UBYTE)(s + i));
+}
+
+void AI_HEATMAP_Instruction(UWORD pc, UBYTE x, UBYTE y, UBYTE s) {
+    UBYTE insn = MEMORY_dGetByte(pc);
+    UBYTE type = accesses[insn];
+    UWORD op = MEMORY_dGetByte((UWORD)(pc + 1)) | (MEMORY_dGetByte((UWORD)(pc + 2)) << 8);
+    UWORD addr = 0;
+
+    count(AI_HEATMAP_EXEC, pc);
+    switch (type >> 4) {
+    case 1: addr = op; break;
+    case 2: addr = (UBYTE)op; break;
+    case 3: addr = (UWORD)(op + x); break;
+    case 4: addr = (UWORD)(op + y); break;
+    case 5: addr = pointer((UBYTE)(op + x)); break;
+    case 6: addr = (UWORD)(pointer((UBYTE)op) + y); break;
+    case 7: addr = (UBYTE)(op + x); break;
+    case 8: addr = (UBYTE)(op + y); break;
+    case 0xd:
+        /* the 6502 takes the high byte from the same page */
+        count(AI_HEATMAP_READ, op);
+        count(AI_HEATMAP_READ, (UWORD)((op & 0xff00) | ((op + 1) & 0xff)));
+        break;
+    default:
+        break;
+    }
+    if (type & ACCESS_READ)
+        count(AI_HEATMAP_READ, addr);
+    if (type & ACCESS_WRITE)
+        count(AI_HEATMAP_WRITE, addr);
+
+    switch (insn) {
+    case 0x00: push(s, 3); break;              /* BRK */
+    case 0x20: push(s, 2); break;              /* JSR */
+    case 0x08: case 0x48: push(s, 1); break;   /* PHP, PHA */
+    case 0x28: case 0x68: pull(s, 1); break;   /* PLP, PLA */
+    case 0x60: pull(s, 2); break;              /* RTS */
+    case 0x40: pull(s, 3); break;              /* RTI */
+    default: break;
+    }
+}
+
+void AI_HEATMAP_Start(int clear) {
+    int k, n;
+
+    if (cpu_counts == NULL) {
+        cpu_counts = (ULONG *)Util_malloc(AI_HEATMAP_KINDS * 65536 * sizeof(ULONG));
+        clear = TRUE;
+    }
+    if (clear)
+        memset(cpu_counts, 0, AI_HEATMAP_KINDS * 65536 * sizeof(ULONG));
+    for (k = 0; k < 3; k++) {
+        ULONG entries;
+        MEMORY_BankLive(k, &n);
+        entries = (ULONG)n * bank_sizes[k];
+        if (entries != banks[k].entries) {
+            free(banks[k].counts);
+            banks[k].counts = entries > 0
+                ? (ULONG *)Util_malloc(AI_HEATMAP_KINDS * entries * sizeof(ULONG)) : NULL;
+            banks[k].entries = entries;
+        }
+        else if (!clear)
+            continue;
+        if (entries > 0)
+            memset(banks[k].counts, 0, AI_HEATMAP_KINDS * entries * sizeof(ULONG));
+    }
+    AI_HEATMAP_counts = cpu_counts;
+}
+
+void AI_HEATMAP_Stop(void) {
+    AI_HEATMAP_counts = NULL;
+}
+
+const ULONG *AI_HEATMAP_Counts(int map, int kind, ULONG *entries) {
+    if (kind < 0 || kind >= AI_HEATMAP_KINDS)
+        map = -2;
+    if (map == AI_HEATMAP_CPU && cpu_counts != NULL) {
+        *entries = 65536;
+        return cpu_counts + ((ULONG)kind << 16);
+    }
+    if (map >= 0 && map < 3 && banks[map].entries > 0) {
+        *entries = banks[map].entries;
+        return banks[map].counts + kind * banks[map].entries;
+    }
+    *entries = 0;
+    return NULL;
+}
@@ -0,0 +1,57 @@
+/*
+ * ai_heatmap.h - Memory access heatmap for the AI interface
+ *
+ * Counts, for every address of the CPU's 64 KB, the instructions run from
+ * it and the reads and writes made to it, so that an agent can see which
+ * bytes a title works on (scores, timers, object tables) and pick its
+ * watch addresses. Accesses through the extended memory window are also
+ * counted against the byte of the XE, Axlon or Mosaic bank switched in.
+ * The code coverage (AI_coverage) only tells which instructions ran.
+ *
+ * The counting is done by the CPU's tracing loop, which decodes each
+ * instruction's effective address before running it: the operand, the
+ * zero page pointer of an indirect mode (which counts as two reads), the
+ * stack bytes of pushes, pulls, calls and returns. The accesses of
+ * interrupts and the dummy accesses of the real 6502 are not counted.
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+#ifndef AI_HEATMAP_H_
+#define AI_HEATMAP_H_
+
+#include "atari.h"
+
+#define AI_HEATMAP_READ  0
+#define AI_HEATMAP_WRITE 1
+#define AI_HEATMAP_EXEC  2
+#define AI_HEATMAP_KINDS 3
+
+/* The map -1 of AI_HEATMAP_Counts(): the CPU's address space */
+#define AI_HEATMAP_CPU   (-1)
+
+/* Read by the CPU loop: while non-NULL, the tracing loop calls
+   AI_HEATMAP_Instruction() before each instruction */
+extern ULONG *AI_HEATMAP_counts;
+
+/* Counts the accesses of the instruction at pc, with the registers it
+   starts with */
+void AI_HEATMAP_Instruction(UWORD pc, UBYTE x, UBYTE y, UBYTE s);
+
+/* Starts counting, from zero if clear, else on from where Stop left off.
+   The bank counters are sized for the machine now running, and start
+   from zero when it has a different number of banks. Call CPU_UpdateGo()
+   after. */
+void AI_HEATMAP_Start(int clear);
+
+/* Stops counting, keeping the counts. Call CPU_UpdateGo() after. */
+void AI_HEATMAP_Stop(void);
+
+/* The counters of kind (AI_HEATMAP_READ..EXEC) for map, AI_HEATMAP_CPU or
+   a MEMORY_BANK_*, as many as *entries is set to: 65536, or the number of
+   banks times the bank size, bank after bank. NULL with *entries 0 if
+   there are none. */
+const ULONG *AI_HEATMAP_Counts(int map, int kind, ULONG *entries);
+
+#endif /* AI_HEATMAP_H_ */
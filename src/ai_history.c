@@ -0,0 +1,91 @@
+/*
+ * ai_history.c - Long execution history for the AI interface
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+#include "config.h"
+#include <stdlib.h>
+
+#include "ai_history.h"
+#include "util.h"
+
+AI_HISTORY_Rec *AI_HISTORY_ring = NULL;
+ULONG AI_HISTORY_mask = 0;
+uint64_t AI_HISTORY_pos = 0;
+int AI_HISTORY_branches = FALSE;
+UWORD AI_HISTORY_last = 0;
+UWORD AI_HISTORY_next = 0;
+
+/* Including the undocumented opcodes; the JAMs count as 1 */
+const UBYTE AI_HISTORY_length[256] = {
+    1, 2, 1, 2, 2, 2, 2, 2, 1, 2, 1, 2, 3, 3, 3, 3,  /* 0x */
+    2, 2, 1, 2, 2, 2, 2, 2, 1, 3, 1, 3, 3, 3, 3, 3,  /* 1x */
+    3, 2, 1, 2, 2, 2, 2, 2, 1, 2, 1, 2, 3, 3, 3, 3,  /* 2x */
+    2, 2, 1, 2, 2, 2, 2, 2, 1, 3, 1, 3, 3, 3, 3, 3,  /* 3x */
+    1, 2, 1, 2, 2, 2, 2, 2, 1, 2, 1, 2, 3, 3, 3, 3,  /* 4x */
+    2, 2, 1, 2, 2, 2, 2, 2, 1, 3, 1, 3, 3, 3, 3, 3,  /* 5x */
+    1, 2, 1, 2, 2, 2, 2, 2, 1, 2, 1, 2, 3, 3, 3, 3,  /* 6x */
+    2, 2, 1, 2, 2, 2, 2, 2, 1, 3, 1, 3, 3, 3, 3, 3,  /* 7x */
+    2, 2, 2, 2, 2, 2, 2, 2, 1, 2, 1, 2, 3, 3, 3, 3,  /* 8x */
+    2, 2, 1, 2, 2, 2, 2, 2, 1, 3, 1, 3, 3, 3, 3, 3,  /* 9x */
+    2, 2, 2, 2, 2, 2, 2, 2, 1, 2, 1, 2, 3, 3, 3, 3,  /* Ax */
+    2, 2, 1, 2, 2, 2, 2, 2, 1, 3, 1, 3, 3, 3, 3, 3,  /* Bx */
+    2, 2, 2, 2, 2, 2, 2, 2, 1, 2, 1, 2, 3, 3, 3, 3,  /* Cx */
+    2, 2, 1, 2, 2, 2, 2, 2, 1, 3, 1, 3, 3, 3, 3, 3,  /* Dx */
+    2, 2, 2, 2, 2, 2, 2, 2, 1, 2, 1, 2, 3, 3, 3, 3,  /* Ex */
+    2, 2, 1, 2, 2, 2, 2, 2, 1, 3, 1, 3, 3, 3, 3, 3   /* Fx */
+};
+
+ULONG AI_HISTORY_Start(ULONG entries, int branches) {
+    ULONG size = 1;
+
+    if (entries > AI_HISTORY_MAX_ENTRIES)
+        return 0;
+    while (size < entries)
+        size <<= 1;
+    AI_HISTORY_Stop();
+    AI_HISTORY_ring = (AI_HISTORY_Rec *)Util_malloc(size * sizeof(AI_HISTORY_Rec));
+    AI_HISTORY_mask = size - 1;
+    AI_HISTORY_branches = branches;
+    /* so that the first instruction is always recorded */
+    AI_HISTORY_next = AI_HISTORY_last = 0;
+    return size;
+}
+
+void AI_HISTORY_Stop(void) {
+    free(AI_HISTORY_ring);
+    AI_HISTORY_ring = NULL;
+    AI_HISTORY_mask = 0;
+    AI_HISTORY_pos = 0;
+}
+
+ULONG AI_HISTORY_Held(void) {
+    if (AI_HISTORY_ring == NULL)
+        return 0;
+    return AI_HISTORY_pos > AI_HISTORY_mask ? AI_HISTORY_mask + 1 : (ULONG)AI_HISTORY_pos;
+}
+
+ULONG AI_HISTORY_Newest(ULONG n, const AI_HISTORY_Rec *parts[2], ULONG lens[2]) {
+    ULONG held = AI_HISTORY_Held();
+    ULONG first, end;
+
+    if (n > held)
+        n = held;
+    lens[0] = lens[1] = 0;
+    parts[0] = parts[1] = AI_HISTORY_ring;
+    if (n == 0)
+        return 0;
+    end = (ULONG)AI_HISTORY_pos & AI_HISTORY_mask;
+    first = (ULONG)(AI_HISTORY_pos - n) & AI_HISTORY_mask;
+    parts[0] = AI_HISTORY_ring + first;
+    if (first < end)
+        lens[0] = n;
+    else {
+        /* wraps, or the whole ring */
+        lens[0] = AI_HISTORY_mask + 1 - first;
+        lens[1] = end;
+    }
+    return n;
+}
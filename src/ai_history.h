@@ -0,0 +1,65 @@
+/*
+ * ai_history.h - Long execution history for the AI interface
+ *
+ * The monitor's history (CPU_remember_PC) holds the last 64 instructions,
+ * too few to see how a crash after a long run came about. This ring holds
+ * a power of two of them, up to AI_HISTORY_MAX_ENTRIES, as 10-byte
+ * records filled in by the CPU's checking loop while it is on. In branch
+ * mode it keeps only the instructions that do not follow on from the one
+ * before: the targets of taken branches, jumps, calls and returns and the
+ * first instructions of interrupt handlers, each with the PC it came
+ * from. The straight runs between them follow from the code, so the same
+ * ring reaches back several times as far.
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+#ifndef AI_HISTORY_H_
+#define AI_HISTORY_H_
+
+#include <stdint.h>
+#include "atari.h"
+
+#define AI_HISTORY_MAX_ENTRIES (1UL << 26)
+
+/* One instruction; sent over the socket as it is, in the host's byte
+   order (little-endian on x86 and ARM) */
+typedef struct {
+    UWORD pc;
+    UWORD from;      /* PC of the instruction run before it */
+    UBYTE op[3];     /* opcode and operand bytes */
+    UBYTE xpos;      /* cycle in the scanline, as the monitor's history */
+    UWORD ypos;      /* scanline */
+} AI_HISTORY_Rec;
+
+#define AI_HISTORY_REC_SIZE 10
+
+/* Read by the CPU loop: while AI_HISTORY_ring is non-NULL, record number
+   n goes to AI_HISTORY_ring[n & AI_HISTORY_mask]. AI_HISTORY_next is the
+   PC that follows on from the last instruction. */
+extern AI_HISTORY_Rec *AI_HISTORY_ring;
+extern ULONG AI_HISTORY_mask;
+extern uint64_t AI_HISTORY_pos;      /* records written since the start */
+extern int AI_HISTORY_branches;
+extern UWORD AI_HISTORY_last;
+extern UWORD AI_HISTORY_next;
+extern const UBYTE AI_HISTORY_length[256];  /* instruction length by opcode */
+
+/* Starts recording into a new ring of entries rounded up to a power of
+   two, only the jumps if branches. Returns the number of entries, or 0 if
+   there are too many. Call CPU_UpdateGo() after. */
+ULONG AI_HISTORY_Start(ULONG entries, int branches);
+
+/* Stops and frees the ring. Call CPU_UpdateGo() after. */
+void AI_HISTORY_Stop(void);
+
+/* Number of records held */
+ULONG AI_HISTORY_Held(void);
+
+/* Points parts[0] and parts[1] at the newest n records held, oldest first,
+   split where the ring wraps, with their counts in lens; returns how many
+   there are in all */
+ULONG AI_HISTORY_Newest(ULONG n, const AI_HISTORY_Rec *parts[2], ULONG lens[2]);
+
+#endif /* AI_HISTORY_H_ */
@@ -5,19 +5,52 @@
  * Licensed under GPL-2.0-or-later
  */
 
+#define _GNU_SOURCE /* syscall, getaddrinfo, fmemopen */
 #include "config.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <ctype.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>
 #include <sys/socket.h>
 #include <sys/un.h>
-#include <sys/select.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <netdb.h>
+#include <poll.h>
 #include <time.h>
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+#ifdef HAVE_LINUX_VM_SOCKETS_H
+#include <linux/vm_sockets.h>
+#endif
+#ifdef HAVE_LINUX_PERF_EVENT_H
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
 
 #include "ai_interface.h"
+#include "ai_bootcache.h"
+#include "ai_discover.h"
+#include "ai_features.h"
+#include "ai_hash.h"
+#include "ai_heatmap.h"
+#include "ai_history.h"
+#include "ai_forkserver.h"
+#include "ai_observe.h"
+#include "ai_rewind.h"
+#include "ai_saver.h"
+#include "ai_search.h"
+#include "ai_timeline.h"
+#include "ai_trace.h"
+#include "ai_shm.h"
 #include "atari.h"
 #include "cpu.h"
 #include "memory.h"
@@ -29,9 +62,22 @@
 #include "screen.h"
 #include "akey.h"
 #include "binload.h"
+#include "crc32.h"
 #include "sio.h"
 #include "statesav.h"
+#include "text80.h"
 #include "log.h"
+#include "util.h"
+#include "pokeysnd.h"
+#include "file_export.h"
+#ifdef NETSIO
+#include "netsio.h"
+#endif
+#ifdef SOUND
+#include "sound.h"
+#include "resample.h"
+#endif
+#include "monitor.h"
 
 /* Configuration */
 int AI_enabled = 0;
@@ -42,188 +88,3897 @@ char AI_socket_path[256] = AI_SOCKET_PATH;
 int AI_joy_override[4] = {-1, -1, -1, -1};
 int AI_trig_override[4] = {-1, -1, -1, -1};
 
+/* -ai-listen: a network address to listen on instead of AI_socket_path,
+   "[host]:port" for TCP or "vsock:[cid:]port" */
+static char ai_listen[256] = "";
+static int ai_listen_tcp = FALSE;
+
 /* State */
 static int ai_server_fd = -1;
-static int ai_client_fd = -1;
 static int ai_paused = 1;  /* Start paused, waiting for AI */
 static int ai_frames_to_run = 0;
 static int ai_steps_to_run = 0;
 
-/* Debug output buffer */
-#define AI_DEBUG_BUFFER_SIZE 4096
-static UBYTE ai_debug_buffer[AI_DEBUG_BUFFER_SIZE];
-static int ai_debug_buffer_pos = 0;
+/* Wire protocol of a connection */
+#define AI_PROTOCOL_JSON   0
+#define AI_PROTOCOL_BINARY 1
+
+/* Frames run by the pending "run" */
+static int ai_run_frames = 0;
+
+/* Input of one frame, as the "input" command and the "inputs" of a "run"
+   give it; only the groups in set are applied */
+#define AI_INPUT_JOY  1
+#define AI_INPUT_FIRE 2
+#define AI_INPUT_POTS 4
+#define AI_INPUT_KEY  8
+#define AI_INPUT_FIRE2 16
+typedef struct {
+    int joy[4];    /* INPUT_STICK_*, or -1 for no override */
+    int trig[4];   /* 0 pressed, or -1 for no override */
+    int pot[8];    /* 0-228, or -1 for no override */
+    int key_code;  /* AKEY_*, AKEY_NONE for none */
+    int key_shift;
+    int set;       /* AI_INPUT_* */
+} AI_FrameInput;
+
+/* The per-frame input of the pending "run": frame i of it gets
+   ai_run_inputs[i], and the last one holds for the frames beyond */
+static AI_FrameInput *ai_run_inputs = NULL;
+static int ai_run_ninputs = 0;
+static int ai_run_inputs_alloc = 0;
+
+/* The input changes of the pending "run" at given scan lines, in order of
+   frame and line; frame is counted from the start of the run */
+typedef struct {
+    int frame;
+    int line;
+    AI_FrameInput in;
+} AI_TimelineEvent;
+static struct {
+    AI_TimelineEvent *events;
+    int n, alloc;
+    int next;   /* first event not applied */
+    int frame;  /* of the run, running now */
+} ai_timeline = { NULL, 0, 0, 0, 0 };
+
+/* Scan line of the next timeline event in the frame running, or -1 */
+int AI_input_line = -1;
+
+/* Instrumentation of the pending "run" */
+int AI_timing = FALSE;
+int AI_unthrottled = FALSE;
+static double ai_stage_time[AI_TIME_STAGES];  /* seconds */
+static double ai_stage_mark;                  /* in ticks, see AI_Ticks() */
+const char * const AI_time_stage_names[AI_TIME_STAGES] = {
+    "input", "antic", "pokey", "sound", "sync", "cpu", "ai", "record", "host"};
+
+/* Frame timing: the stages of the frame in progress, where it started
+   (in ticks), and the counts since they were last cleared */
+int AI_frame_timing = FALSE;
+static double ai_frame_stage[AI_TIME_STAGES];
+static double ai_frame_start;
+static AI_FrameStats ai_frame_stats;
+static double ai_run_start_time;
+static unsigned int ai_run_start_clock;
+
+/* Counters for "stats": socket traffic, the time taken to serve each
+   command, and the frame, time and CPU time of the previous "stats"
+   reply, for the frame rate and CPU use since */
+static double ai_bytes_in = 0.0;
+static double ai_bytes_out = 0.0;
+static ULONG ai_cmd_count = 0;
+static double ai_cmd_total = 0.0;
+static double ai_cmd_max = 0.0;
+static ULONG ai_cmd_hist[AI_TIME_BUCKETS];
+static int ai_stats_frame = 0;
+static double ai_stats_time = 0.0;
+static clock_t ai_stats_clock = 0;
+
+/* Rewind: keyframe the pending "run" replays from, -1 = a plain run */
+static int ai_rewind_keyframe = -1;
+
+/* Time travel: last_write and reverse_continue replay the rewind history
+   a keyframe interval at a time, newest first, noting the latest write
+   to addr or breakpoint hit in each, until one has some; then the machine
+   is re-simulated to the frame it is to end up at */
+#define AI_TRAVEL_NONE             0
+#define AI_TRAVEL_LAST_WRITE       1
+#define AI_TRAVEL_REVERSE_CONTINUE 2
+
+typedef struct {
+    int kind;
+    int addr;               /* the address last_write asks about */
+    int now;                /* the frame the query was made at */
+    int seg_start, seg_end; /* the interval being replayed */
+    int returning;          /* replaying on to where it ends up */
+    int found;
+    int frame, ypos, xpos;  /* the latest hit found */
+    int pc, old, value;
+    int replayed;           /* frames re-simulated in all */
+    double start_time;
+} AI_Travel;
+
+static AI_Travel ai_travel = {AI_TRAVEL_NONE};
+
+/* The pending "run" boots for a "reset" or "load" with boot_frames, to be
+   stored in the boot cache under ai_boot_key if ai_boot_cacheable */
+static int ai_boot_run = FALSE;
+static int ai_boot_cacheable = FALSE;
+static AI_BOOTCACHE_Key ai_boot_key;
+
+/* The keys of a "type", pressed one a frame as the OS takes them */
+static struct {
+    SWORD *keys;  /* AKEY_* */
+    int n;
+    int alloc;
+    int pos;      /* next key to press */
+    int held;     /* key pressed for the frame about to run, or AKEY_NONE */
+    int last;     /* key pressed last */
+    int run;      /* the pending "run" is a "type" */
+} ai_type = {NULL, 0, 0, 0, AKEY_NONE, AKEY_NONE, FALSE};
+
+#define AI_TYPE_CH     0x02fc  /* OS key code waiting for a program, $FF once taken */
+#define AI_TYPE_KEYDEL 0x02f1  /* OS debounce: a repeat of its last key waits for 0 */
+
+/* Input the socket applies to a frame, as recorded for rewind */
+typedef struct {
+    int joy[4];
+    int trig[4];
+    int pot[8];
+    int key_code;
+    int key_shift;
+    int consol;
+} AI_RewindInput;
+
+/* Render policy */
+int AI_render_policy = AI_RENDER_ALWAYS;
+int AI_render_every = 1;
+
+/* run_until: a condition in disjunctive normal form, checked each frame */
+#define AI_UNTIL_MAX_TERMS 16
+#define AI_UNTIL_MEM    0
+#define AI_UNTIL_PC     1
+#define AI_UNTIL_FRAMES 2
+#define AI_UNTIL_CHANGED 3
+#define AI_UNTIL_EQ 0
+#define AI_UNTIL_NE 1
+#define AI_UNTIL_LT 2
+#define AI_UNTIL_LE 3
+#define AI_UNTIL_GT 4
+#define AI_UNTIL_GE 5
+
+typedef struct {
+    int kind;                 /* AI_UNTIL_MEM, _PC, _FRAMES or _CHANGED */
+    int new_clause;           /* first term after an "||" */
+    int op;                   /* AI_UNTIL_EQ .. AI_UNTIL_GE */
+    int addr;
+    int value;                /* mem: start value replaces it if use_start */
+    int use_start;
+    int hit;                  /* pc: reached during the current frame */
+    int hit_frame, hit_ypos, hit_xpos;
+} AI_UntilTerm;
+
+static int ai_until_active = 0;
+static int ai_until_nterms = 0;
+static AI_UntilTerm ai_until_terms[AI_UNTIL_MAX_TERMS];
+static int ai_until_frames = 0;       /* frames run so far */
+static int ai_until_max_frames = 0;
+
+UBYTE *AI_pc_watch = NULL;
+static UBYTE ai_pc_watch_map[65536];
+#define AI_WATCH_UNTIL 1  /* a run_until "pc" term */
+#define AI_WATCH_BREAK 2  /* a "breakpoint" */
+
+static int ai_breakpoints = 0;     /* addresses with AI_WATCH_BREAK */
+
+/* Breakpoints with a condition, in the monitor's B syntax, that must hold
+   as well; the monitor evaluates it when the CPU reaches addr */
+#define AI_BREAK_CONDS 16
+
+typedef struct {
+    int addr;
+    int size;
+    MONITOR_breakpoint_cond table[MONITOR_BREAKPOINT_TABLE_MAX];
+} AI_BreakCond;
+
+static AI_BreakCond ai_break_conds[AI_BREAK_CONDS];
+static int ai_nbreak_conds = 0;
+
+/* search_start/search/search_list */
+static AI_SEARCH_t ai_search = AI_SEARCH_INIT;
+static const char * const ai_search_spaces[] = {"cpu", "xe", "axlon", "mosaic", NULL};
+static const char * const ai_search_ops[] = {"equal", "not_equal", "less", "greater",
+    "changed", "unchanged", "increased", "decreased", NULL};
+#define AI_SEARCH_LIST_MAX 4096
+#define AI_MONITOR_MAX_COMMANDS 512  /* of a monitor command, with output */
+static int ai_break_addr = -1;     /* first breakpoint hit this frame */
+static int ai_break_frame, ai_break_ypos, ai_break_xpos;
+
+/* Write watch and the ring of changes it recorded; a last_write query
+   watches its address with AI_WATCH_TRAVEL */
+#define AI_WATCH_RING 4096
+#define AI_WATCH_CHANGES 1
+#define AI_WATCH_TRAVEL 2
+
+typedef struct {
+    UWORD addr;
+    UBYTE old;
+    UBYTE value;
+    int frame;
+    int ypos, xpos;
+} AI_WriteChange;
+
+UBYTE *AI_write_watch = NULL;
+UWORD AI_write_pc = 0;
+static UBYTE ai_write_watch_map[65536];
+static int ai_write_watches = 0;        /* addresses watched */
+static AI_WriteChange ai_changes[AI_WATCH_RING];
+static int ai_changes_start = 0;        /* oldest change kept */
+static int ai_changes_count = 0;
+static unsigned long ai_changes_dropped = 0;
+static int ai_changes_frame = 0;        /* changes in the current frame */
+
+/* Logpoints: running an address, or a store to one, counts a hit and
+   optionally records the registers in a ring, without stopping. Both
+   watch maps flag their addresses with AI_WATCH_LOG. */
+#define AI_WATCH_LOG 4
+#define AI_LOGPOINTS 64
+#define AI_LOG_RING 4096
+
+typedef struct {
+    int addr;
+    int write;          /* on stores to addr, else on running it */
+    int log;            /* record each hit, not only count it */
+    int peek;           /* address whose byte a hit records, -1 = none */
+    unsigned long count;
+    int size;           /* of the condition, 0 = none */
+    MONITOR_breakpoint_cond table[MONITOR_BREAKPOINT_TABLE_MAX];
+} AI_Logpoint;
+
+typedef struct {
+    UWORD addr;         /* the logpoint's */
+    UWORD pc;
+    int frame;
+    int ypos, xpos;
+    UBYTE a, x, y, s, p;
+    int value;          /* the byte stored or peeked, -1 = none */
+} AI_LogRec;
+
+static AI_Logpoint ai_logpoints[AI_LOGPOINTS];
+static int ai_nlogpoints = 0;
+static int ai_pc_logpoints = 0, ai_write_logpoints = 0;
+static AI_LogRec ai_log[AI_LOG_RING];
+static int ai_log_start = 0;
+static int ai_log_count = 0;
+static unsigned long ai_log_dropped = 0;
+
+/* Features evaluated for "features" and at the end of each "run" */
+static AI_FEATURE_Table ai_features;
+static float ai_feature_values[AI_FEATURE_MAX];
+
+/* Profiler tallies, kept after profile_stop until the next start */
+AI_ProfileRec *AI_profile = NULL;
+ULONG AI_profile_opcodes[256];
+static AI_ProfileRec ai_profile_map[65536];
+int AI_profile_host = FALSE;
+static int ai_profile_host_used = FALSE;  /* the tallies have host times */
+static double ai_profile_overhead = 0.0;  /* ticks the timing adds to an instruction */
+
+/* Code coverage: the PCs run since coverage_start or the last clear,
+   kept after coverage_stop */
+UBYTE *AI_coverage = NULL;
+static UBYTE ai_coverage_map[65536];
+static int ai_profile_start_frame = -1;  /* -1 = never started */
+static int ai_profile_frames = 0;        /* frames covered by stopped runs */
+
+/* Machine cycles by use (see ANTIC_cycles_t) summed over frames: since
+   the last "cycles" clear, and over the frames profiled */
+#define AI_CYCLE_KINDS 8
+typedef struct {
+    ULONG frames;
+    double sum[AI_CYCLE_KINDS];
+} AI_CycleSum;
+static const char * const ai_cycle_names[AI_CYCLE_KINDS] = {
+    "total", "cpu", "idle", "dma", "wsync", "dlis", "vbis", "irqs"};
+static AI_CycleSum ai_cycle_sum;
+static AI_CycleSum ai_profile_cycle_sum;
+static int ai_cycle_frame = -1;          /* frame last added to them */
+static UWORD ai_profile_order[65536];
+static const AI_ProfileRec *ai_profile_sorted;  /* the tallies profile_compare() sorts */
+#ifdef MONITOR_HINTS
+static AI_ProfileRec ai_routine_map[65536];    /* by the address of their label */
+#endif
+
+/* Hardware counters, with -perf-counters or "stats" "counters": a
+   perf_event_open() group read at every stage mark, its deltas charged
+   to the stage like the host time */
+#define AI_HW_COUNTERS 3
+static const char * const ai_hw_names[AI_HW_COUNTERS] = {
+    "cycles", "instructions", "cache_misses"};
+static int ai_hw_fds[AI_HW_COUNTERS] = {-1, -1, -1};  /* [0] leads, -1 = off */
+static double ai_hw_mark[AI_HW_COUNTERS];
+static double ai_hw_stage[AI_TIME_STAGES][AI_HW_COUNTERS];
+static ULONG ai_hw_frames = 0;
+
+/* Buffered input from a client: bytes [in_start, in_end) are unconsumed.
+   Large enough for one maximum-size frame plus its header. */
+#define AI_IN_BUFFER_SIZE (AI_BUFFER_SIZE + 64)
+
+/* Output a client has not read yet is queued, never waited for; a client
+   that lets this much pile up is disconnected */
+#define AI_OUT_LIMIT (16 * 1024 * 1024)
+
+/* Pushed events are skipped while this much output is still queued */
+#define AI_PUSH_BACKLOG 65536
+
+/* Subscription modes: observe frames the controller runs anyway, make the
+   machine free-run, or run in lockstep with acknowledgements */
+#define AI_SUB_OBSERVE  0
+#define AI_SUB_FREE     1
+#define AI_SUB_LOCKSTEP 2
+
+#define AI_SUB_MAX_ADDRS 64
+
+#define AI_SCREEN_SIZE (Screen_WIDTH * Screen_HEIGHT)
+/* Worst case of encode_screen_delta(): every row changed end to end */
+#define AI_SCREEN_DELTA_MAX (Screen_HEIGHT * (6 + Screen_WIDTH))
+
+/* peek_multi: ranges per request and bytes per reply */
+#define AI_PEEK_MAX_RANGES 256
+#define AI_PEEK_MAX_BYTES  0x40000
+static UBYTE ai_peek_buf[AI_PEEK_MAX_BYTES];
+
+typedef struct AI_Client {
+    int fd;                   /* -1 once closed, freed by reap_clients() */
+    int protocol;             /* AI_PROTOCOL_* */
+    int observer;             /* declared observer: never given control */
+    int bin_opcode;           /* binary frame being served (echoed in replies) */
+    ULONG bin_tag;
+    char req_id[AI_REQ_ID_SIZE];  /* "id" of the JSON command being served, as
+                                     sent (echoed in replies), or empty */
+    int sub_every;            /* push a frame event every N frames, 0 = off */
+    int sub_mode;             /* AI_SUB_* */
+    int sub_screen;           /* AI_SUB_SCREEN_* */
+    int sub_window;           /* unacknowledged records allowed, 0 = no limit */
+    int sub_unacked;
+    int sub_last_frame;       /* frame of the last record pushed */
+    int sub_naddrs;
+    UWORD sub_addrs[AI_SUB_MAX_ADDRS];
+    UBYTE *sub_prev_screen;   /* screen of the last record, for deltas */
+    int sub_audio;            /* AI_SUB_AUDIO_* bits */
+    int sub_debug;            /* records carry the debug port output */
+#ifdef SOUND
+    RESAMPLE_t *sub_resampler; /* PCM at the subscription's own rate */
+    int sub_resample_from;    /* output rate the converter was made for */
+    int sub_resample_quality;
+    UBYTE *sub_pcm;           /* converted samples since the last record */
+    int sub_pcm_len, sub_pcm_alloc;
+#endif
+    int compress;             /* LZ4 binary payloads (AI_BIN_FLAG_LZ4) */
+    ULONG events_dropped;     /* records skipped: output backed up or window full */
+    UBYTE *delta_ref[2];      /* screen_delta: [0] acknowledged, [1] last sent */
+    int delta_frame[2];       /* their frame numbers */
+    UBYTE *state_ref[2];      /* state_get/put images: [0] acknowledged, [1] last */
+    ULONG state_ref_len[2];
+    ULONG state_ref_id[2];    /* their CRC32s */
+    UBYTE in_buf[AI_IN_BUFFER_SIZE];
+    int in_start, in_end;
+    char *out_buf;            /* queued output: bytes [out_start, out_end) */
+    int out_start, out_end, out_size;
+} AI_Client;
+
+static AI_Client *ai_clients[AI_MAX_CLIENTS];
+static AI_Client *ai_cur = NULL;         /* client whose command is being served */
+static AI_Client *ai_controller = NULL;  /* client driving the machine */
+static int ai_controller_exclusive = 0;  /* others may not take control */
+static AI_Client *ai_run_client = NULL;  /* owed the reply of a pending run */
+static char ai_run_req_id[AI_REQ_ID_SIZE];  /* the "id", or binary opcode and tag, */
+static int ai_run_bin_opcode;               /* of the command that started it */
+static ULONG ai_run_bin_tag;
+static AI_Client *ai_stream_client = NULL;  /* subscriber in free or lockstep mode */
+
+/* Lockstep episode: players joined for joystick ports each send an "act"
+   for the next step; once all have (or the timeout passes and defaults
+   stand in) the machine runs the step's frames, then every player is
+   pushed a "step" event at once and the machine waits again */
+#define AI_LOCKSTEP_PORTS 4
+#define AI_LOCKSTEP_MAX_ADDRS 64
+static struct {
+    int expected;             /* players the episode needs; 0 = none */
+    AI_Client *player[AI_LOCKSTEP_PORTS];  /* by port */
+    int acted[AI_LOCKSTEP_PORTS];
+    int stick[AI_LOCKSTEP_PORTS], fire[AI_LOCKSTEP_PORTS];
+    int timeout_ms;           /* for the actions of a step; 0 = wait */
+    int repeat;               /* a late player repeats its last action,
+                                 rather than centring the stick */
+    int frames;               /* per step */
+    int naddrs;
+    UWORD addrs[AI_LOCKSTEP_MAX_ADDRS];  /* whose values each step event carries */
+    int waiting;              /* for actions, since wait_start */
+    double wait_start;
+    int frames_left;          /* of the step running */
+    int step;                 /* steps completed */
+    int defaulted;            /* ports that timed out in the last step */
+} ai_lockstep;
+static AI_Client *ai_save_clients[AI_SAVER_MAX_JOBS];  /* told when async save job id,
+                                                          at id % AI_SAVER_MAX_JOBS, is done */
+static char ai_save_req_ids[AI_SAVER_MAX_JOBS][AI_REQ_ID_SIZE];  /* and the "id" of the
+                                                                   save_state that queued it */
+
+/* Shared-memory observation segment name (empty = disabled) */
+static char ai_shm_name[256] = "";
+static int ai_shm_audio = FALSE;  /* -ai-shm-audio: PCM ring in the segment */
+static int ai_audio_observers = 0;  /* our share of Sound_observers */
+
+/* -ai-forkserver: after ai_fork_frames frames, serve spawn requests on
+   ai_fork_path (empty = not a fork server) instead of the AI socket */
+static char ai_fork_path[256] = "";
+static int ai_fork_frames = 1;
+static int ai_fork_sound_thread = FALSE;  /* -sound-thread, for the children */
+#ifdef ANTIC_RENDER_THREAD
+static int ai_fork_render_thread = FALSE; /* -render-thread, for the children */
+#endif
+
+/* Batch state: the sub-commands of a "batch" run one after another and
+   their replies are collected in ai_batch_out instead of being sent.
+   A "run" inside the batch suspends it until the frames are done. */
+static int ai_batch_active = 0;
+static AI_Client *ai_batch_client = NULL;
+static char ai_batch_cmds[AI_BUFFER_SIZE];  /* text of the "commands" array */
+static int ai_batch_pos = 0;                /* parse position in ai_batch_cmds */
+static int ai_batch_count = 0;              /* replies collected so far */
+static int ai_batch_errors = 0;
+static int ai_batch_failed = -1;            /* index of the first failed sub-command */
+static int ai_batch_stop_on_error = 0;
+static char ai_batch_out[AI_MAX_RESPONSE - 256];
+static int ai_batch_out_len = 0;
+
+/* Debug port output: a ring of records, each the bytes written in one
+   frame after a header of the frame number (32 bits) and their count (16
+   bits), little-endian. debug_read, or frame records of subscribers that
+   asked for it, take whole records out. New bytes that do not fit are
+   dropped and counted, so what is read has no gaps but at its end. */
+#define AI_DEBUG_DEFAULT_SIZE 65536
+#define AI_DEBUG_MIN_SIZE 256
+#define AI_DEBUG_MAX_SIZE (16 << 20)
+#define AI_DEBUG_HEADER 6
+#define AI_DEBUG_PUSH_MAX 262144  /* taken into one frame record */
+static struct {
+    UBYTE *buf;
+    ULONG size;
+    ULONG head;            /* where the next byte goes */
+    ULONG used;
+    ULONG last;            /* header of the newest record... */
+    int last_open;         /* ...if bytes of its frame may still join it */
+    int last_frame;
+    int last_len;
+    unsigned long written; /* bytes, since the ring was sized */
+    unsigned long dropped;
+} ai_debug = { NULL, AI_DEBUG_DEFAULT_SIZE };
+static UBYTE *ai_debug_out = NULL;  /* records taken out, in order */
+
+/* Response buffer */
+static char ai_response[AI_MAX_RESPONSE];
+#define AI_HISTORY_JSON_MAX 65536  /* history records base64 fits in ai_response */
+#define AI_HEATMAP_JSON_MAX 65536  /* heatmap counters base64 fits in ai_response */
+
+/* JSON commands are read through a key index: one pass over the command
+   finds where each top-level key's value starts, skipping nested objects,
+   arrays and strings, so looking a key up neither rescans the text nor
+   finds the same name inside a nested value. process_command() indexes
+   the command it serves; other text is indexed on each lookup. */
+
+#define AI_JSON_MAX_KEYS 64
+
+typedef struct {
+    const char *json;           /* the indexed text */
+    int n;
+    struct {
+        const char *key;        /* after the opening quote */
+        int len;
+        const char *val;        /* first character of the value */
+    } keys[AI_JSON_MAX_KEYS];
+} JSON_Index;
+
+static JSON_Index *json_cur = NULL;   /* of the command being served */
+
+#define JSON_SPACE(c) ((c) == ' ' || (c) == '\t' || (c) == '\r' || (c) == '\n')
+
+/* The end of the string whose opening quote is at p */
+static const char *json_skip_string(const char *p) {
+    for (p++; *p && *p != '"'; p++)
+        if (*p == '\\' && p[1]) p++;
+    return *p ? p + 1 : p;
+}
+
+/* The end of the value starting at p */
+static const char *json_skip_value(const char *p) {
+    int depth = 0;
+
+    if (*p == '"') return json_skip_string(p);
+    if (*p != '{' && *p != '[') {
+        while (*p && *p != ',' && *p != '}' && *p != ']' && !JSON_SPACE(*p)) p++;
+        return p;
+    }
+    while (*p) {
+        if (*p == '"') {
+            p = json_skip_string(p);
+            continue;
+        }
+        if (*p == '{' || *p == '[') depth++;
+        else if ((*p == '}' || *p == ']') && --depth == 0) return p + 1;
+        p++;
+    }
+    return p;
+}
+
+static void json_index(JSON_Index *ix, const char *json) {
+    const char *p = json;
+
+    ix->json = json;
+    ix->n = 0;
+    while (JSON_SPACE(*p)) p++;
+    if (*p++ != '{') return;
+    for (;;) {
+        const char *key;
+        while (JSON_SPACE(*p) || *p == ',') p++;
+        if (*p != '"') return;
+        key = p + 1;
+        p = json_skip_string(p);
+        if (p[-1] != '"') return;
+        if (ix->n < AI_JSON_MAX_KEYS) {
+            ix->keys[ix->n].key = key;
+            ix->keys[ix->n].len = (int)(p - 1 - key);
+        }
+        while (JSON_SPACE(*p)) p++;
+        if (*p++ != ':') return;
+        while (JSON_SPACE(*p)) p++;
+        if (ix->n < AI_JSON_MAX_KEYS)
+            ix->keys[ix->n++].val = p;
+        p = json_skip_value(p);
+    }
+}
+
+/* The value of a top-level key, or NULL if the object has none */
+static const char *json_find(const char *json, const char *key) {
+    JSON_Index local, *ix = json_cur;
+    int len = (int)strlen(key), i;
+
+    if (ix == NULL || ix->json != json) {
+        json_index(&local, json);
+        ix = &local;
+    }
+    for (i = 0; i < ix->n; i++)
+        if (ix->keys[i].len == len && memcmp(ix->keys[i].key, key, len) == 0)
+            return ix->keys[i].val;
+    return NULL;
+}
+
+static const char* json_get_string(const char *json, const char *key, char *buf, int bufsize) {
+    const char *p = json_find(json, key);
+    int i = 0;
+    if (!p) return NULL;
+    if (*p != '"') return NULL;
+    p++;
+    while (*p && *p != '"' && i < bufsize - 1) {
+        if (*p == '\\' && *(p+1)) { p++; }
+        buf[i++] = *p++;
+    }
+    buf[i] = '\0';
+    return buf;
+}
+
+/* Decodes the string whose opening quote is at *pp (\\uXXXX as the byte
+   XX) into buf, moving *pp past it; its length, or -1 if it is malformed
+   or does not fit */
+static int json_decode_string(const char **pp, char *buf, int bufsize) {
+    const char *p = *pp;
+    int n = 0;
+
+    if (*p++ != '"') return -1;
+    for (; *p != '"'; p++) {
+        int c = (unsigned char)*p;
+        if (c == '\0' || n == bufsize - 1) return -1;
+        if (c == '\\') {
+            switch (*++p) {
+            case 'n': c = '\n'; break;
+            case 't': c = '\t'; break;
+            case 'r': c = '\r'; break;
+            case 'b': c = '\b'; break;
+            case 'f': c = '\f'; break;
+            case 'u': {
+                int i;
+                for (c = 0, i = 1; i <= 4; i++) {
+                    int d = tolower((unsigned char)p[i]);
+                    if (!isxdigit(d)) return -1;
+                    c = c * 16 + (isdigit(d) ? d - '0' : d - 'a' + 10);
+                }
+                c &= 0xff;
+                p += 4;
+                break;
+            }
+            case '\0': return -1;
+            default: c = (unsigned char)*p; break;
+            }
+        }
+        buf[n++] = (char)c;
+    }
+    buf[n] = '\0';
+    *pp = p + 1;
+    return n;
+}
+
+/* A string value with its escapes decoded into buf; its length, or -1 if
+   there is none or it does not fit */
+static int json_get_text(const char *json, const char *key, char *buf, int bufsize) {
+    const char *p = json_find(json, key);
+
+    if (p == NULL) return -1;
+    return json_decode_string(&p, buf, bufsize);
+}
+
+/* An array of strings without newlines, decoded into buf a line each; how
+   many there are, or -1 if it is not such an array or does not fit */
+static int json_get_lines(const char *json, const char *key, char *buf, int bufsize) {
+    const char *p = json_find(json, key);
+    int n = 0, len = 0;
+
+    if (p == NULL || *p++ != '[') return -1;
+    for (;;) {
+        int l;
+        while (JSON_SPACE(*p) || *p == ',') p++;
+        if (*p == ']') break;
+        if (bufsize - len < 2) return -1;
+        l = json_decode_string(&p, buf + len, bufsize - len - 1);
+        if (l < 0 || memchr(buf + len, '\n', l) != NULL) return -1;
+        len += l;
+        buf[len++] = '\n';
+        n++;
+    }
+    buf[len] = '\0';
+    return n;
+}
+
+/* The "id" of a command as its JSON text, a number or a string, into buf;
+   empty if there is none or it does not fit */
+static void json_get_id(const char *json, char *buf, int bufsize) {
+    const char *p = json_find(json, "id");
+    int i = 0;
+
+    buf[0] = '\0';
+    if (p == NULL) return;
+    if (*p == '"') {
+        buf[i++] = *p++;
+        while (*p && *p != '"' && i < bufsize - 3) {
+            if (*p == '\\' && p[1]) buf[i++] = *p++;
+            buf[i++] = *p++;
+        }
+        if (*p != '"') i = 0;
+        else buf[i++] = '"';
+    }
+    else {
+        while ((isalnum((unsigned char)*p) || *p == '-' || *p == '+' || *p == '.') && i < bufsize - 1)
+            buf[i++] = *p++;
+        if (isalnum((unsigned char)*p)) i = 0;
+    }
+    buf[i] = '\0';
+}
+
+static int json_get_int(const char *json, const char *key, int def) {
+    const char *p = json_find(json, key);
+    if (!p) return def;
+    if (*p == '"') return def;  /* It's a string, not int */
+    return atoi(p);
+}
+
+static double json_get_double(const char *json, const char *key, double def) {
+    const char *p = json_find(json, key);
+    if (!p) return def;
+    if (*p == '"') return def;
+    return atof(p);
+}
+
+static int json_get_bool(const char *json, const char *key, int def) {
+    const char *p = json_find(json, key);
+    if (!p) return def;
+    if (strncmp(p, "true", 4) == 0) return 1;
+    if (strncmp(p, "false", 5) == 0) return 0;
+    return def;
+}
+
+/* Read an array of non-negative integers; returns how many were stored */
+static int json_get_int_array(const char *json, const char *key, int *out, int max) {
+    int n = 0;
+    const char *p = json_find(json, key);
+    if (!p) return 0;
+    if (*p++ != '[') return 0;
+    while (*p && *p != ']' && n < max) {
+        while (*p == ' ' || *p == ',') p++;
+        if (*p < '0' || *p > '9') break;
+        out[n++] = atoi(p);
+        while (*p >= '0' && *p <= '9') p++;
+    }
+    return n;
+}
+
+/* Read an array of integers, negative ones too; returns how many were
+   stored, or -1 if the array is malformed or longer than max */
+static int json_get_signed_array(const char *json, const char *key, int *out, int max) {
+    int n = 0;
+    char *end;
+    const char *p = json_find(json, key);
+    if (!p) return 0;
+    if (*p++ != '[') return -1;
+    for (;;) {
+        while (JSON_SPACE(*p) || *p == ',') p++;
+        if (*p == ']') return n;
+        if (n == max) return -1;
+        out[n++] = (int)strtol(p, &end, 10);
+        if (end == p) return -1;
+        p = end;
+    }
+}
+
+/* Read an array of [a, b] pairs into out as a, b, a, b, ...; returns how
+   many pairs were stored, or -1 if the array is malformed */
+static int json_get_int_pairs(const char *json, const char *key, int *out, int max) {
+    int n = 0;
+    char *end;
+    const char *p = json_find(json, key);
+    if (!p) return 0;
+    if (*p++ != '[') return -1;
+    for (;;) {
+        while (*p == ' ' || *p == ',') p++;
+        if (*p == ']') return n;
+        if (*p++ != '[' || n == max) return -1;
+        out[2 * n] = (int)strtol(p, &end, 10);
+        p = end;
+        while (*p == ' ' || *p == ',') p++;
+        out[2 * n + 1] = (int)strtol(p, &end, 10);
+        if (end == p) return -1;
+        p = end;
+        while (*p == ' ') p++;
+        if (*p++ != ']') return -1;
+        n++;
+    }
+}
+
+/* Copy the next {...} element of a JSON array starting at *pos into out,
+   skipping separators; returns 0 at the end of the array */
+static int json_next_object(const char *json, int *pos, char *out, int outsize) {
+    const char *p = json + *pos;
+    const char *start;
+    int depth = 0, in_string = 0, len;
+
+    while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n' || *p == ',') p++;
+    if (*p != '{') return 0;
+    start = p;
+    for (; *p; p++) {
+        if (in_string) {
+            if (*p == '\\' && p[1]) p++;
+            else if (*p == '"') in_string = 0;
+        }
+        else if (*p == '"') in_string = 1;
+        else if (*p == '{' || *p == '[') depth++;
+        else if ((*p == '}' || *p == ']') && --depth == 0) {
+            p++;
+            break;
+        }
+    }
+    len = p - start;
+    if (depth != 0 || len >= outsize) return 0;
+    memcpy(out, start, len);
+    out[len] = '\0';
+    *pos = p - json;
+    return 1;
+}
+
+/* Append-only writer for JSON replies: text, numbers and keys go straight
+   into the buffer, which is always kept terminated. What does not fit is
+   cut off, as with snprintf. */
+typedef struct {
+    char *buf;
+    int pos;
+    int size;
+} JSON_Writer;
+
+static const char json_hex_digits[] = "0123456789ABCDEF";
+
+static void jw_start(JSON_Writer *w, char *buf, int size) {
+    w->buf = buf;
+    w->pos = 0;
+    w->size = size;
+    buf[0] = '\0';
+}
+
+static void jw_mem(JSON_Writer *w, const char *s, int len) {
+    if (len > w->size - 1 - w->pos) len = w->size - 1 - w->pos;
+    memcpy(w->buf + w->pos, s, len);
+    w->pos += len;
+    w->buf[w->pos] = '\0';
+}
+
+static void jw_raw(JSON_Writer *w, const char *s) {
+    jw_mem(w, s, (int)strlen(s));
+}
+
+static void jw_char(JSON_Writer *w, char c) {
+    if (w->pos < w->size - 1) {
+        w->buf[w->pos++] = c;
+        w->buf[w->pos] = '\0';
+    }
+}
+
+static void jw_int(JSON_Writer *w, long v) {
+    char tmp[24];
+    int i = sizeof(tmp);
+    unsigned long u = v < 0 ? 0UL - (unsigned long)v : (unsigned long)v;
+
+    do {
+        tmp[--i] = (char)('0' + u % 10);
+        u /= 10;
+    } while (u != 0);
+    if (v < 0) tmp[--i] = '-';
+    jw_mem(w, tmp + i, sizeof(tmp) - i);
+}
+
+/* v as the given number of upper case hex digits, for inside a string */
+static void jw_hex(JSON_Writer *w, unsigned long v, int digits) {
+    char tmp[16];
+    int i;
+
+    if (digits > 16) digits = 16;
+    for (i = digits - 1; i >= 0; i--, v >>= 4)
+        tmp[i] = json_hex_digits[v & 15];
+    jw_mem(w, tmp, digits);
+}
+
+/* s as a quoted string; control characters are left out */
+static void jw_string(JSON_Writer *w, const char *s) {
+    jw_char(w, '"');
+    for (; *s != '\0'; s++) {
+        if ((UBYTE)*s < 0x20) continue;
+        if (*s == '"' || *s == '\\') jw_char(w, '\\');
+        jw_char(w, *s);
+    }
+    jw_char(w, '"');
+}
+
+/* len bytes of text as a quoted string, with its line breaks, tabs and
+   other control characters escaped */
+static void jw_text(JSON_Writer *w, const char *s, int len) {
+    int i;
+
+    jw_char(w, '"');
+    for (i = 0; i < len; i++) {
+        UBYTE c = (UBYTE)s[i];
+        if (c == '"' || c == '\\') {
+            jw_char(w, '\\');
+            jw_char(w, (char)c);
+        }
+        else if (c == '\n')
+            jw_mem(w, "\\n", 2);
+        else if (c == '\t')
+            jw_mem(w, "\\t", 2);
+        else if (c < 0x20 || c == 0x7f) {
+            jw_mem(w, "\\u00", 4);
+            jw_hex(w, c, 2);
+        }
+        else
+            jw_char(w, (char)c);
+    }
+    jw_char(w, '"');
+}
+
+/* "key": preceded by a comma unless it opens an object */
+static void jw_key(JSON_Writer *w, const char *key) {
+    if (w->pos > 0 && w->buf[w->pos - 1] != '{')
+        jw_char(w, ',');
+    jw_char(w, '"');
+    jw_raw(w, key);
+    jw_mem(w, "\":", 2);
+}
+
+static void jw_field(JSON_Writer *w, const char *key, long v) {
+    jw_key(w, key);
+    jw_int(w, v);
+}
+
+/* A [...] of byte values */
+static void jw_bytes(JSON_Writer *w, const UBYTE *data, int n) {
+    int i;
+
+    jw_char(w, '[');
+    for (i = 0; i < n; i++) {
+        if (i) jw_char(w, ',');
+        jw_int(w, data[i]);
+    }
+    jw_char(w, ']');
+}
+
+/* Base64 encoding for binary data. Whole blocks go through SSSE3 or
+   NEON when the compiler targets them (16 characters from 12 bytes with
+   SSSE3, 64 from 48 with NEON); the rest is done a group at a time. */
+static const char b64_table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+#ifdef __SSSE3__
+/* The 16 6-bit values of the 12 bytes at the start of in, one a byte */
+static __m128i b64_split(__m128i in) {
+    __m128i t0, t1;
+
+    in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+    t0 = _mm_mulhi_epu16(_mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+    t1 = _mm_mullo_epi16(_mm_and_si128(in, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+    return _mm_or_si128(t0, t1);
+}
+
+/* 6-bit values to their characters, by adding the offset of their range */
+static __m128i b64_chars(__m128i in) {
+    const __m128i offsets = _mm_setr_epi8(65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0);
+    __m128i range = _mm_subs_epu8(in, _mm_set1_epi8(51));
+
+    range = _mm_sub_epi8(range, _mm_cmpgt_epi8(in, _mm_set1_epi8(25)));
+    return _mm_add_epi8(in, _mm_shuffle_epi8(offsets, range));
+}
+#endif
+
+int AI_Base64Encode(const UBYTE *data, int len, char *out, int outsize) {
+    int i = 0, j = 0;
+#ifdef __SSSE3__
+    /* Loads 16 bytes for 12 */
+    for (; i + 16 <= len && j + 16 < outsize - 4; i += 12, j += 16)
+        _mm_storeu_si128((__m128i *)(out + j),
+            b64_chars(b64_split(_mm_loadu_si128((const __m128i *)(data + i)))));
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    uint8x16x4_t table;
+
+    table.val[0] = vld1q_u8((const UBYTE *)b64_table);
+    table.val[1] = vld1q_u8((const UBYTE *)b64_table + 16);
+    table.val[2] = vld1q_u8((const UBYTE *)b64_table + 32);
+    table.val[3] = vld1q_u8((const UBYTE *)b64_table + 48);
+    for (; i + 48 <= len && j + 64 < outsize - 4; i += 48, j += 64) {
+        uint8x16x3_t in = vld3q_u8(data + i);
+        uint8x16x4_t res;
+        res.val[0] = vshrq_n_u8(in.val[0], 2);
+        res.val[1] = vandq_u8(vorrq_u8(vshlq_n_u8(in.val[0], 4), vshrq_n_u8(in.val[1], 4)), vdupq_n_u8(63));
+        res.val[2] = vandq_u8(vorrq_u8(vshlq_n_u8(in.val[1], 2), vshrq_n_u8(in.val[2], 6)), vdupq_n_u8(63));
+        res.val[3] = vandq_u8(in.val[2], vdupq_n_u8(63));
+        res.val[0] = vqtbl4q_u8(table, res.val[0]);
+        res.val[1] = vqtbl4q_u8(table, res.val[1]);
+        res.val[2] = vqtbl4q_u8(table, res.val[2]);
+        res.val[3] = vqtbl4q_u8(table, res.val[3]);
+        vst4q_u8((UBYTE *)out + j, res);
+    }
+#endif
+    for (; i + 3 <= len && j < outsize - 4; i += 3) {
+        ULONG n = (ULONG)data[i] << 16 | data[i + 1] << 8 | data[i + 2];
+        out[j++] = b64_table[n >> 18];
+        out[j++] = b64_table[(n >> 12) & 63];
+        out[j++] = b64_table[(n >> 6) & 63];
+        out[j++] = b64_table[n & 63];
+    }
+    if (i < len && j < outsize - 4) {
+        ULONG n = (ULONG)data[i] << 16;
+        if (i + 1 < len) n |= data[i + 1] << 8;
+        out[j++] = b64_table[n >> 18];
+        out[j++] = b64_table[(n >> 12) & 63];
+        out[j++] = (i + 1 < len) ? b64_table[(n >> 6) & 63] : '=';
+        out[j++] = '=';
+    }
+    out[j] = '\0';
+    return j;
+}
+
+/* The 6-bit value of each base64 character, -1 for the rest */
+static const signed char b64_values_of[256] = {
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 62, -1, -1, -1, 63,
+    52, 53, 54, 55, 56, 57, 58, 59, 60, 61, -1, -1, -1, -1, -1, -1,
+    -1, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14,
+    15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, -1, -1, -1, -1, -1,
+    -1, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
+    41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1
+};
+
+#ifdef __SSSE3__
+/* The 6-bit values of 16 characters, or FALSE if one is not base64 */
+static int b64_values(__m128i *in) {
+    const __m128i lut_lo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                         0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a);
+    const __m128i lut_hi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                         0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m128i lut_roll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i mask_2f = _mm_set1_epi8(0x2f);
+    __m128i hi_nibbles = _mm_and_si128(_mm_srli_epi32(*in, 4), mask_2f);
+    __m128i lo_nibbles = _mm_and_si128(*in, mask_2f);
+    __m128i hi = _mm_shuffle_epi8(lut_hi, hi_nibbles);
+    __m128i lo = _mm_shuffle_epi8(lut_lo, lo_nibbles);
+    __m128i roll = _mm_shuffle_epi8(lut_roll, _mm_add_epi8(_mm_cmpeq_epi8(*in, mask_2f), hi_nibbles));
+
+    if (_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128())) != 0)
+        return FALSE;
+    *in = _mm_add_epi8(*in, roll);
+    return TRUE;
+}
+
+/* 16 6-bit values to the 12 bytes they encode, at the start of the result */
+static __m128i b64_join(__m128i in) {
+    in = _mm_maddubs_epi16(in, _mm_set1_epi32(0x01400140));
+    in = _mm_madd_epi16(in, _mm_set1_epi32(0x00011000));
+    return _mm_shuffle_epi8(in, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+}
+#endif
+
+int AI_Base64Decode(const char *in, int len, UBYTE *out, int outsize) {
+    int i = 0, j = 0;
+#ifdef __SSSE3__
+    /* Stores 16 bytes for 12; a block with padding or anything else is
+       left to the loop below */
+    for (; i + 16 <= len && j + 16 <= outsize; i += 16, j += 12) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(in + i));
+        if (!b64_values(&v)) break;
+        _mm_storeu_si128((__m128i *)(out + j), b64_join(v));
+    }
+#endif
+    if ((len - i) % 4 != 0) return -1;
+    for (; i < len; i += 4) {
+        int a = b64_values_of[(UBYTE)in[i]], b = b64_values_of[(UBYTE)in[i + 1]];
+        int c = b64_values_of[(UBYTE)in[i + 2]], d = b64_values_of[(UBYTE)in[i + 3]];
+        int n = i + 4 == len ? (in[i + 2] == '=' ? 1 : in[i + 3] == '=' ? 2 : 3) : 3;
+
+        if (a < 0 || b < 0 || (n > 1 && c < 0) || (n > 2 && d < 0)
+            || (n == 1 && in[i + 3] != '=') || j + n > outsize)
+            return -1;
+        out[j++] = (UBYTE)(a << 2 | b >> 4);
+        if (n > 1) out[j++] = (UBYTE)(b << 4 | c >> 2);
+        if (n > 2) out[j++] = (UBYTE)(c << 6 | d);
+    }
+    return j;
+}
+
+/* Encode what changed from prev to cur as spans of UWORD row, UWORD x,
+   UWORD len and len pixels, one span per changed row; returns the number
+   of bytes written (at most AI_SCREEN_DELTA_MAX, 0 if nothing changed) */
+static int encode_screen_delta(const UBYTE *prev, const UBYTE *cur, UBYTE *out) {
+    int y, n = 0;
+
+    for (y = 0; y < Screen_HEIGHT; y++) {
+        const UBYTE *a = prev + y * Screen_WIDTH;
+        const UBYTE *b = cur + y * Screen_WIDTH;
+        int x1 = 0, x2 = Screen_WIDTH;
+
+        if (memcmp(a, b, Screen_WIDTH) == 0) continue;
+        while (a[x1] == b[x1]) x1++;
+        while (a[x2 - 1] == b[x2 - 1]) x2--;
+        out[n++] = (UBYTE)y;
+        out[n++] = (UBYTE)(y >> 8);
+        out[n++] = (UBYTE)x1;
+        out[n++] = (UBYTE)(x1 >> 8);
+        out[n++] = (UBYTE)(x2 - x1);
+        out[n++] = (UBYTE)((x2 - x1) >> 8);
+        memcpy(out + n, b + x1, x2 - x1);
+        n += x2 - x1;
+    }
+    return n;
+}
+
+/* Prepare a screen_delta reply for frame base, which the client names as
+   the last screen it has; *pixels is set to the delta, or to the whole
+   screen (*kind AI_SUB_SCREEN_FULL) when the server no longer has base.
+   Returns the number of bytes at *pixels. */
+static int screen_delta_for(AI_Client *c, int base, const UBYTE **pixels, int *kind) {
+    static UBYTE delta[AI_SCREEN_DELTA_MAX];
+    const UBYTE *screen = (const UBYTE *)Screen_atari;
+    int len;
+
+    if (c->delta_ref[1] != NULL && base == c->delta_frame[1]) {
+        /* The last reply arrived: it becomes the acknowledged screen */
+        UBYTE *t = c->delta_ref[0];
+        c->delta_ref[0] = c->delta_ref[1];
+        c->delta_ref[1] = t;
+        c->delta_frame[0] = c->delta_frame[1];
+    }
+    if (c->delta_ref[0] != NULL && base == c->delta_frame[0]) {
+        len = encode_screen_delta(c->delta_ref[0], screen, delta);
+        *pixels = delta;
+        *kind = AI_SUB_SCREEN_DELTA;
+    } else {
+        len = AI_SCREEN_SIZE;
+        *pixels = screen;
+        *kind = AI_SUB_SCREEN_FULL;
+    }
+    if (c->delta_ref[1] == NULL) c->delta_ref[1] = (UBYTE *)Util_malloc(AI_SCREEN_SIZE);
+    memcpy(c->delta_ref[1], screen, AI_SCREEN_SIZE);
+    c->delta_frame[1] = Atari800_nframes;
+    return len;
+}
+
+/* Kernel buffers of network connections: room for several full frame
+   records in flight, so that a client across the network is not held to
+   one round trip per record */
+#define AI_NET_BUFFER_SIZE (4 * 1024 * 1024)
+
+int AI_ListenSocket(const char *address, int *tcp) {
+    char host[256];
+    const char *port = strrchr(address, ':');
+    int fd = -1, err = 0;
+    int size = AI_NET_BUFFER_SIZE;
+
+    *tcp = FALSE;
+    if (port == NULL) {
+        Log_print("AI: -ai-listen needs [host]:port or vsock:[cid:]port, not %s", address);
+        return -1;
+    }
+    Util_strlcpy(host, address, sizeof(host));
+    host[port - address] = '\0';
+    port++;
+
+    if (strncmp(host, "vsock", 5) == 0 && (host[5] == '\0' || host[5] == ':')) {
+#ifdef HAVE_LINUX_VM_SOCKETS_H
+        struct sockaddr_vm addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.svm_family = AF_VSOCK;
+        addr.svm_cid = host[5] ? (unsigned int)strtoul(host + 6, NULL, 0) : VMADDR_CID_ANY;
+        addr.svm_port = (unsigned int)strtoul(port, NULL, 0);
+        fd = socket(AF_VSOCK, SOCK_STREAM, 0);
+        if (fd >= 0 && bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+            err = errno;
+            close(fd);
+            fd = -1;
+        }
+        else if (fd < 0)
+            err = errno;
+#else
+        Log_print("AI: vsock is not supported by this build");
+        return -1;
+#endif
+    }
+    else {
+        struct addrinfo hints, *res, *ai;
+        char *name = host;
+        int one = 1, r;
+        size_t n = strlen(name);
+
+        /* [IPv6 address]:port */
+        if (n >= 2 && name[0] == '[' && name[n - 1] == ']') {
+            name[n - 1] = '\0';
+            name++;
+        }
+        memset(&hints, 0, sizeof(hints));
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        hints.ai_flags = AI_PASSIVE;
+        r = getaddrinfo(name[0] && strcmp(name, "*") != 0 ? name : NULL, port, &hints, &res);
+        if (r != 0) {
+            Log_print("AI: Cannot resolve %s: %s", address, gai_strerror(r));
+            return -1;
+        }
+        for (ai = res; ai != NULL && fd < 0; ai = ai->ai_next) {
+            fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+            if (fd < 0) {
+                err = errno;
+                continue;
+            }
+            setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+            if (bind(fd, ai->ai_addr, ai->ai_addrlen) < 0) {
+                err = errno;
+                close(fd);
+                fd = -1;
+            }
+        }
+        freeaddrinfo(res);
+        *tcp = TRUE;
+    }
+    if (fd < 0) {
+        Log_print("AI: Failed to bind %s: %s", address, strerror(err));
+        return -1;
+    }
+    /* Accepted connections inherit these */
+    setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &size, sizeof(size));
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+    return fd;
+}
+
+/* Socket setup */
+static int setup_server_socket(void) {
+    int flags;
+
+    if (ai_listen[0]) {
+        ai_server_fd = AI_ListenSocket(ai_listen, &ai_listen_tcp);
+        if (ai_server_fd < 0)
+            return 0;
+    }
+    else {
+        struct sockaddr_un addr;
+
+        if (strlen(AI_socket_path) >= sizeof(addr.sun_path)) {
+            Log_print("AI: Socket path too long: %s", AI_socket_path);
+            return 0;
+        }
+        unlink(AI_socket_path);  /* Remove existing socket */
+
+        ai_server_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (ai_server_fd < 0) {
+            Log_print("AI: Failed to create socket: %s", strerror(errno));
+            return 0;
+        }
+
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        Util_strlcpy(addr.sun_path, AI_socket_path, sizeof(addr.sun_path));
+
+        if (bind(ai_server_fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+            Log_print("AI: Failed to bind socket: %s", strerror(errno));
+            close(ai_server_fd);
+            ai_server_fd = -1;
+            return 0;
+        }
+    }
+
+    /* Set non-blocking */
+    flags = fcntl(ai_server_fd, F_GETFL, 0);
+    fcntl(ai_server_fd, F_SETFL, flags | O_NONBLOCK);
+
+    if (listen(ai_server_fd, AI_MAX_CLIENTS) < 0) {
+        Log_print("AI: Failed to listen: %s", strerror(errno));
+        close(ai_server_fd);
+        ai_server_fd = -1;
+        return 0;
+    }
+
+    Log_print("AI: Listening on %s", ai_listen[0] ? ai_listen : AI_socket_path);
+    return 1;
+}
+
+/* Keep Sound_observers counting the subscriptions and the shared-memory
+   ring that take each frame's samples */
+static void update_audio_observers(void) {
+    int i, n = ai_shm_audio && ai_shm_name[0] ? 1 : 0;
+    for (i = 0; i < AI_MAX_CLIENTS; i++) {
+        AI_Client *c = ai_clients[i];
+        if (c != NULL && c->fd >= 0 && c->sub_every > 0 && (c->sub_audio & AI_SUB_AUDIO_PCM)) n++;
+    }
+#ifdef SOUND
+    Sound_observers += n - ai_audio_observers;
+#endif
+    ai_audio_observers = n;
+}
+
+#ifdef SOUND
+/* Give a subscription its own sample rate, or the output rate when RATE
+   is 0 or already the output rate */
+static void set_sub_rate(AI_Client *c, int rate, int quality) {
+    RESAMPLE_Free(c->sub_resampler);
+    c->sub_resampler = NULL;
+    c->sub_pcm_len = 0;
+    if (rate > 0 && rate != Sound_out.freq) {
+        c->sub_resampler = RESAMPLE_New(Sound_out.freq, rate, Sound_out.channels,
+                                        Sound_out.sample_size, quality);
+        c->sub_resample_from = Sound_out.freq;
+        c->sub_resample_quality = quality;
+    }
+}
+
+/* Convert the frame's samples for every subscription with its own rate.
+   They collect until the subscription's next record, at most a second's
+   worth; older samples are dropped. */
+static void feed_resamplers(void) {
+    unsigned int size;
+    const UBYTE *samples = NULL;
+    int i;
+
+    for (i = 0; i < AI_MAX_CLIENTS; i++) {
+        AI_Client *c = ai_clients[i];
+        int bytes_per_frame, limit, need, count;
+        if (c == NULL || c->fd < 0 || c->sub_every <= 0 || c->sub_resampler == NULL) continue;
+        if (c->sub_resample_from != Sound_out.freq)
+            set_sub_rate(c, RESAMPLE_OutRate(c->sub_resampler), c->sub_resample_quality);
+        if (c->sub_resampler == NULL) continue;
+        if (samples == NULL) samples = Sound_FrameSamples(&size);
+        count = (int)size / Sound_out.sample_size;
+        need = RESAMPLE_MaxOutput(c->sub_resampler, count) * Sound_out.sample_size;
+        bytes_per_frame = Sound_out.channels * Sound_out.sample_size;
+        limit = RESAMPLE_OutRate(c->sub_resampler) * bytes_per_frame;
+        if (c->sub_pcm_len + need > limit && c->sub_pcm_len > 0) {
+            int drop = c->sub_pcm_len + need - limit;
+            drop = (drop + bytes_per_frame - 1) / bytes_per_frame * bytes_per_frame;
+            if (drop > c->sub_pcm_len) drop = c->sub_pcm_len;
+            memmove(c->sub_pcm, c->sub_pcm + drop, c->sub_pcm_len - drop);
+            c->sub_pcm_len -= drop;
+        }
+        if (c->sub_pcm_len + need > c->sub_pcm_alloc) {
+            c->sub_pcm_alloc = c->sub_pcm_len + need;
+            c->sub_pcm = (UBYTE *)Util_realloc(c->sub_pcm, c->sub_pcm_alloc);
+        }
+        c->sub_pcm_len += RESAMPLE_Process(c->sub_resampler, samples, count,
+                                           c->sub_pcm + c->sub_pcm_len) * Sound_out.sample_size;
+    }
+}
+#endif
+
+static int count_clients(void) {
+    int i, n = 0;
+    for (i = 0; i < AI_MAX_CLIENTS; i++) {
+        if (ai_clients[i] != NULL && ai_clients[i]->fd >= 0) n++;
+    }
+    return n;
+}
+
+static void lockstep_leave(AI_Client *c);
+
+static void close_client(AI_Client *c) {
+    int i;
+    if (c->fd < 0) return;
+    close(c->fd);
+    c->fd = -1;
+    if (ai_controller == c) {
+        ai_controller = NULL;
+        ai_controller_exclusive = 0;
+    }
+    if (ai_run_client == c) ai_run_client = NULL;
+    if (ai_stream_client == c) {
+        ai_stream_client = NULL;
+        ai_paused = 1;
+    }
+    if (ai_batch_client == c) {
+        ai_batch_active = 0;
+        ai_batch_client = NULL;
+    }
+    lockstep_leave(c);
+    if (ai_cur == c) ai_cur = NULL;
+    for (i = 0; i < AI_SAVER_MAX_JOBS; i++) {
+        if (ai_save_clients[i] == c) ai_save_clients[i] = NULL;
+    }
+    update_audio_observers();
+    AI_FORKSERVER_Update(count_clients());
+    Log_print("AI: Client disconnected");
+}
+
+/* Free clients closed since the last call; pointers to them may still be
+   in use while a command is being served, so close_client() only marks */
+static void reap_clients(void) {
+    int i;
+    for (i = 0; i < AI_MAX_CLIENTS; i++) {
+        AI_Client *c = ai_clients[i];
+        if (c != NULL && c->fd < 0) {
+            free(c->out_buf);
+            free(c->sub_prev_screen);
+#ifdef SOUND
+            RESAMPLE_Free(c->sub_resampler);
+            free(c->sub_pcm);
+#endif
+            free(c->delta_ref[0]);
+            free(c->delta_ref[1]);
+            free(c->state_ref[0]);
+            free(c->state_ref[1]);
+            free(c);
+            ai_clients[i] = NULL;
+        }
+    }
+}
+
+/* True if some connected client may drive the machine; with observers
+   only, emulation is never held paused */
+static int have_driver(void) {
+    int i;
+    for (i = 0; i < AI_MAX_CLIENTS; i++) {
+        AI_Client *c = ai_clients[i];
+        if (c != NULL && c->fd >= 0 && !c->observer) return TRUE;
+    }
+    return FALSE;
+}
+
+/* Write as much queued output as the socket takes without blocking */
+static void flush_output(AI_Client *c) {
+    while (c->fd >= 0 && c->out_start < c->out_end) {
+        int w = write(c->fd, c->out_buf + c->out_start, c->out_end - c->out_start);
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) close_client(c);
+            return;
+        }
+        c->out_start += w;
+        ai_bytes_out += w;
+    }
+    c->out_start = c->out_end = 0;
+}
+
+/* Queue bytes for the client and try to send them right away */
+static int client_write(AI_Client *c, const void *buf, int len) {
+    if (c == NULL || c->fd < 0) return FALSE;
+    if (c->out_start > 0 && c->out_start == c->out_end)
+        c->out_start = c->out_end = 0;
+    if (c->out_end + len > c->out_size) {
+        int pending = c->out_end - c->out_start;
+        if (pending + len > AI_OUT_LIMIT) {
+            Log_print("AI: Client is not reading its replies, dropping it");
+            close_client(c);
+            return FALSE;
+        }
+        if (c->out_start > 0) {
+            memmove(c->out_buf, c->out_buf + c->out_start, pending);
+            c->out_start = 0;
+            c->out_end = pending;
+        }
+        if (c->out_end + len > c->out_size) {
+            int size = c->out_size ? c->out_size : 4096;
+            while (size < c->out_end + len) size *= 2;
+            c->out_buf = (char *)Util_realloc(c->out_buf, size);
+            c->out_size = size;
+        }
+    }
+    memcpy(c->out_buf + c->out_end, buf, len);
+    c->out_end += len;
+    flush_output(c);
+    return c->fd >= 0;
+}
+
+/* Pull whatever the client has sent into its input buffer with a single
+   read(). Several pipelined commands may arrive at once; they are parsed
+   out of the buffer one by one without further syscalls. */
+static void fill_input(AI_Client *c) {
+    int r;
+
+    if (c->fd < 0) return;
+    if (c->in_start > 0) {
+        memmove(c->in_buf, c->in_buf + c->in_start, c->in_end - c->in_start);
+        c->in_end -= c->in_start;
+        c->in_start = 0;
+    }
+    if (c->in_end == AI_IN_BUFFER_SIZE) return;  /* a full frame is waiting */
+
+    r = read(c->fd, c->in_buf + c->in_end, AI_IN_BUFFER_SIZE - c->in_end);
+    if (r > 0) {
+        c->in_end += r;
+        ai_bytes_in += r;
+    } else if (r == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+        /* Client disconnected */
+        close_client(c);
+    }
+}
+
+/* Little-endian helpers for the binary protocol */
+static void put_le16(UBYTE *p, UWORD v) {
+    p[0] = (UBYTE)v;
+    p[1] = (UBYTE)(v >> 8);
+}
+
+static void put_le32(UBYTE *p, ULONG v) {
+    p[0] = (UBYTE)v;
+    p[1] = (UBYTE)(v >> 8);
+    p[2] = (UBYTE)(v >> 16);
+    p[3] = (UBYTE)(v >> 24);
+}
+
+int AI_AudioEnvelopes(UBYTE *out) {
+    int chans = 4, i;
+#if defined(SOUND) && defined(STEREO_SOUND)
+    if (POKEYSND_stereo_enabled) chans = 8;
+#endif
+    for (i = 0; i < chans; i++) {
+        UBYTE audc = POKEY_AUDC[i];
+        int period = POKEY_ChannelPeriod(i / 4, i % 4);
+        ULONG hz = 0;
+        if (period > 0 && !(audc & POKEY_VOL_ONLY)) {
+            hz = (ULONG)POKEYSND_FREQ_17_EXACT / (2 * (ULONG)period);
+            if (hz > 0xffff) hz = 0xffff;
+        }
+        put_le16(out, (UWORD)hz);
+        out[2] = audc & POKEY_VOLUME_MASK;
+        out[3] = audc >> 4;
+        out += AI_AUDIO_ENV_SIZE;
+    }
+    return chans;
+}
+
+static UWORD get_le16(const UBYTE *p) {
+    return (UWORD)(p[0] | (p[1] << 8));
+}
+
+static ULONG get_le32(const UBYTE *p) {
+    return (ULONG)p[0] | ((ULONG)p[1] << 8) | ((ULONG)p[2] << 16) | ((ULONG)p[3] << 24);
+}
+
+/* state_get / state_put: a delta is AI_STATE_DELTA_MAGIC, ULONG id of the
+   base image, ULONG length of the new image, then runs of ULONG first
+   page, UWORD count and the count AI_STATE_PAGE-byte pages that differ
+   from the base, the last page of the image cut short. A base shorter
+   than the image counts as zeros past its end. */
+#define AI_STATE_DELTA_MAGIC "A8SD"
+#define AI_STATE_DELTA_HEADER 12
+#define AI_STATE_PAGE 256
+/* Largest image taken from a client: 4 MB of banks and then some */
+#define AI_STATE_MAX_SIZE 0x800000
+
+static UBYTE *ai_state_delta = NULL;
+static ULONG ai_state_delta_size = 0;
+
+static int state_page_differs(const UBYTE *base, ULONG base_len, const UBYTE *image, ULONG len, ULONG page) {
+    ULONG off = page * AI_STATE_PAGE;
+    ULONG n = len - off < AI_STATE_PAGE ? len - off : AI_STATE_PAGE;
+    ULONG same = off >= base_len ? 0 : base_len - off < n ? base_len - off : n;
+    ULONG i;
+
+    if (same > 0 && memcmp(base + off, image + off, same) != 0) return TRUE;
+    for (i = same; i < n; i++) {
+        if (image[off + i] != 0) return TRUE;
+    }
+    return FALSE;
+}
+
+/* Encode image as a delta from base into ai_state_delta; returns its size */
+static ULONG encode_state_delta(const UBYTE *base, ULONG base_len, ULONG base_id,
+                                const UBYTE *image, ULONG len) {
+    ULONG pages = (len + AI_STATE_PAGE - 1) / AI_STATE_PAGE;
+    ULONG bound = AI_STATE_DELTA_HEADER + len + 6 * pages;
+    ULONG page = 0, n = AI_STATE_DELTA_HEADER;
+
+    if (bound > ai_state_delta_size) {
+        ai_state_delta_size = bound;
+        ai_state_delta = (UBYTE *)Util_realloc(ai_state_delta, bound);
+    }
+    memcpy(ai_state_delta, AI_STATE_DELTA_MAGIC, 4);
+    put_le32(ai_state_delta + 4, base_id);
+    put_le32(ai_state_delta + 8, len);
+    while (page < pages) {
+        ULONG first = page, bytes;
+        if (!state_page_differs(base, base_len, image, len, page)) {
+            page++;
+            continue;
+        }
+        while (page < pages && page - first < 0xffff
+               && state_page_differs(base, base_len, image, len, page))
+            page++;
+        bytes = (page == pages ? len : page * AI_STATE_PAGE) - first * AI_STATE_PAGE;
+        put_le32(ai_state_delta + n, first);
+        put_le16(ai_state_delta + n + 4, (UWORD)(page - first));
+        memcpy(ai_state_delta + n + 6, image + first * AI_STATE_PAGE, bytes);
+        n += 6 + bytes;
+    }
+    return n;
+}
+
+/* The image a delta of len bytes makes of base, in a new buffer, or NULL
+   if the delta is malformed */
+static UBYTE *decode_state_delta(const UBYTE *delta, ULONG len, const UBYTE *base,
+                                 ULONG base_len, ULONG *image_len) {
+    ULONG size = get_le32(delta + 8);
+    ULONG n = AI_STATE_DELTA_HEADER;
+    UBYTE *image;
+
+    if (size > AI_STATE_MAX_SIZE) return NULL;
+    image = (UBYTE *)Util_malloc(size > 0 ? size : 1);
+    memcpy(image, base, base_len < size ? base_len : size);
+    if (base_len < size) memset(image + base_len, 0, size - base_len);
+    while (n < len) {
+        ULONG first, off, bytes;
+        if (len - n < 6) break;
+        first = get_le32(delta + n);
+        off = first * AI_STATE_PAGE;
+        if (first >= (size + AI_STATE_PAGE - 1) / AI_STATE_PAGE) break;
+        bytes = (ULONG)get_le16(delta + n + 4) * AI_STATE_PAGE;
+        if (bytes > size - off) bytes = size - off;
+        if (bytes > len - n - 6) break;
+        memcpy(image + off, delta + n + 6, bytes);
+        n += 6 + bytes;
+    }
+    if (n != len) {
+        free(image);
+        return NULL;
+    }
+    *image_len = size;
+    return image;
+}
+
+/* The client names id as the state it has: if it is the last one it was
+   given, that becomes the acknowledged one. Returns the slot of id in
+   c->state_ref, or -1 if the server does not have it (any more). */
+static int state_ref_acknowledge(AI_Client *c, ULONG id) {
+    if (c->state_ref[1] != NULL && id == c->state_ref_id[1]) {
+        UBYTE *t = c->state_ref[0];
+        c->state_ref[0] = c->state_ref[1];
+        c->state_ref[1] = t;
+        c->state_ref_len[0] = c->state_ref_len[1];
+        c->state_ref_id[0] = c->state_ref_id[1];
+    }
+    if (c->state_ref[0] != NULL && id == c->state_ref_id[0]) return 0;
+    return -1;
+}
+
+/* Keep image, a buffer of ours now the client's, as the last state it has
+   been given; returns its id */
+static ULONG state_ref_keep(AI_Client *c, UBYTE *image, ULONG len) {
+    free(c->state_ref[1]);
+    c->state_ref[1] = image;
+    c->state_ref_len[1] = len;
+    c->state_ref_id[1] = ~CRC32_Update(0xffffffff, image, (unsigned int)len);
+    return c->state_ref_id[1];
+}
+
+/* The state as an uncompressed state file, in a new buffer */
+static UBYTE *capture_state(ULONG *len) {
+    UBYTE *image = StateSav_CaptureAtariState(TRUE, len);
+    UBYTE *packed;
+    ULONG size;
+
+    if (image != NULL) return image;
+    /* Builds that save to memory only (libatari800) give it packed */
+    packed = StateSav_PackAtariState(&size);
+    if (packed == NULL) return NULL;
+    *len = get_le32(packed + 4);
+    image = (UBYTE *)Util_malloc(*len > 0 ? *len : 1);
+    if (!StateSav_LZDecompress(packed + 8, size - 8, image, *len)) {
+        free(image);
+        image = NULL;
+    }
+    free(packed);
+    return image;
+}
+
+/* Prepare a state_get reply for a client that has the state base (if
+   has_base): *data is set to a delta from it, or to the state as a file of
+   the fast codec (*kind AI_SUB_SCREEN_FULL) when the server no longer has
+   base. Returns FALSE if the state cannot be captured. */
+static int state_get_for(AI_Client *c, int has_base, ULONG base, const UBYTE **data,
+                         ULONG *len, int *kind, ULONG *id) {
+    static UBYTE *packed = NULL;
+    ULONG image_len;
+    UBYTE *image = capture_state(&image_len);
+    int slot;
+
+    if (image == NULL) return FALSE;
+    slot = has_base ? state_ref_acknowledge(c, base) : -1;
+    if (slot >= 0) {
+        *len = encode_state_delta(c->state_ref[slot], c->state_ref_len[slot], base,
+                                  image, image_len);
+        *data = ai_state_delta;
+        *kind = AI_SUB_SCREEN_DELTA;
+    } else {
+        free(packed);
+        packed = StateSav_PackImage(image, image_len, len);
+        *data = packed;
+        *kind = AI_SUB_SCREEN_FULL;
+    }
+    *id = state_ref_keep(c, image, image_len);
+    return TRUE;
+}
+
+/* Load a state_put state: a delta from a state the client has, or a state
+   file of the fast or raw codec. Returns NULL and sets *id, or the reason
+   it failed. */
+static const char *state_put_for(AI_Client *c, const UBYTE *data, ULONG len, ULONG *id) {
+    UBYTE *image;
+    ULONG image_len;
+
+    if (len >= AI_STATE_DELTA_HEADER && memcmp(data, AI_STATE_DELTA_MAGIC, 4) == 0) {
+        int slot = state_ref_acknowledge(c, get_le32(data + 4));
+        if (slot < 0) return "Unknown base state";
+        image = decode_state_delta(data, len, c->state_ref[slot], c->state_ref_len[slot],
+                                   &image_len);
+        if (image == NULL) return "Malformed state delta";
+    } else if (len >= 8 && memcmp(data, "A8LZ", 4) == 0) {
+        image_len = get_le32(data + 4);
+        if (image_len > AI_STATE_MAX_SIZE) return "Failed to load state";
+        image = (UBYTE *)Util_malloc(image_len > 0 ? image_len : 1);
+        if (!StateSav_LZDecompress(data + 8, len - 8, image, image_len)) {
+            free(image);
+            return "Failed to load state";
+        }
+    } else {
+        image_len = len;
+        image = (UBYTE *)Util_malloc(len > 0 ? len : 1);
+        memcpy(image, data, len);
+    }
+    if (!StateSav_UnpackAtariState(image, image_len)) {
+        free(image);
+        return "Failed to load state";
+    }
+    AI_REWIND_Clear();
+    *id = state_ref_keep(c, image, image_len);
+    return NULL;
+}
+
+/* Pack the PCs run into a bitmap, bit addr & 7 of byte addr >> 3, and
+   return how many there are; with clear, start collecting afresh */
+static int coverage_bitmap(UBYTE *bitmap, int clear) {
+    int i, bit, count = 0;
+    for (i = 0; i < AI_COVERAGE_BYTES; i++) {
+        const UBYTE *pcs = ai_coverage_map + 8 * i;
+        UBYTE bits = 0;
+        for (bit = 0; bit < 8; bit++)
+            bits |= (pcs[bit] != 0) << bit;
+        bitmap[i] = bits;
+        count += pcs[0] + pcs[1] + pcs[2] + pcs[3] + pcs[4] + pcs[5] + pcs[6] + pcs[7];
+    }
+    if (clear)
+        memset(ai_coverage_map, 0, sizeof(ai_coverage_map));
+    return count;
+}
+
+/* The n counters as LEB128 varints, 7 bits a byte from the lowest, the
+   top bit set on all but the last byte of each, in a buffer kept until the
+   next call; *len is set to their bytes */
+static const UBYTE *heatmap_varints(const ULONG *counts, ULONG n, ULONG *len) {
+    static UBYTE *buf = NULL;
+    static ULONG size = 0;
+    ULONG i, v, pos = 0;
+
+    if (n * 5 > size) {
+        size = n * 5;
+        buf = (UBYTE *)Util_realloc(buf, size);
+    }
+    for (i = 0; i < n; i++) {
+        for (v = counts[i]; v >= 0x80; v >>= 7)
+            buf[pos++] = (UBYTE)(v | 0x80);
+        buf[pos++] = (UBYTE)v;
+    }
+    *len = pos;
+    return buf;
+}
+
+/* The counters of kind and map for start and length, clipped to those
+   there are; NULL if there are none */
+static const ULONG *heatmap_range(int map, int kind, ULONG *entries, ULONG *start, ULONG *length) {
+    const ULONG *counts = AI_HEATMAP_Counts(map, kind, entries);
+    if (*start > *entries) *start = *entries;
+    if (*length > *entries - *start) *length = *entries - *start;
+    return counts;
+}
+
+/* Read the (addr, len) ranges back to back into ai_peek_buf, wrapping at
+   0xFFFF like peek; returns the bytes read or an error message */
+static const char *peek_ranges(const int *ranges, int n, int *bytes) {
+    int r, total = 0;
+
+    for (r = 0; r < n; r++) {
+        int addr = ranges[2 * r], len = ranges[2 * r + 1];
+        if (addr < 0 || addr > 0xffff || len < 0 || len > 0x10000)
+            return "Ranges need addr 0-65535 and len 0-65536";
+        if (len > AI_PEEK_MAX_BYTES - total)
+            return "Ranges add up to more than 262144 bytes";
+        total += len;
+    }
+    total = 0;
+    for (r = 0; r < n; r++) {
+        int addr = ranges[2 * r], len = ranges[2 * r + 1], i;
+        for (i = 0; i < len; i++)
+            ai_peek_buf[total++] = MEMORY_SafeGetByte((UWORD)(addr + i));
+    }
+    *bytes = total;
+    return NULL;
+}
+
+/* Disassembles from addr as [addr,"bytes","mnemonic","operand",target,label]
+   records, target and label null where there are none, up to count
+   instructions starting at or before end and as many as fit; returns the
+   length written and stores how many and the address after the last one */
+static int disasm_json(char *out, size_t size, int addr, int end, int count, int *n, int *next) {
+    int len = 0;
+
+    for (*n = 0; *n < count && addr <= end && addr <= 0xffff; (*n)++) {
+        MONITOR_instruction insn;
+        char rec[640];
+        JSON_Writer w;
+        int r, i;
+
+        MONITOR_DecodeInstruction((UWORD)addr, &insn);
+        jw_start(&w, rec, sizeof(rec));
+        if (*n) jw_char(&w, ',');
+        jw_char(&w, '[');
+        jw_int(&w, addr);
+        jw_mem(&w, ",\"", 2);
+        for (i = 0; i < insn.size; i++)
+            jw_hex(&w, insn.bytes[i], 2);
+        jw_mem(&w, "\",", 2);
+        jw_string(&w, insn.mnemonic);
+        jw_char(&w, ',');
+        jw_string(&w, insn.operand);
+        jw_char(&w, ',');
+        if (insn.target >= 0) jw_int(&w, insn.target);
+        else jw_raw(&w, "null");
+        jw_char(&w, ',');
+        /* Labels come from files and may have anything in them */
+        if (insn.label != NULL) jw_string(&w, insn.label);
+        else jw_raw(&w, "null");
+        jw_char(&w, ']');
+        r = w.pos;
+        if ((size_t)(len + r) >= size)
+            break;
+        memcpy(out + len, rec, r + 1);
+        len += r;
+        addr += insn.size;
+    }
+    *next = addr;
+    return len;
+}
+
+/* Payloads of LZ4 connections below this are sent as they are */
+#define AI_LZ4_MIN_PAYLOAD 256
+
+/* Send the payload pieces of a binary frame LZ4-compressed (ULONG size,
+   then the block) if that makes it smaller. Returns FALSE to send them as
+   they are. */
+static int send_frame_packed(AI_Client *c, UBYTE *header, ULONG total,
+                             const void * const *parts, const int *lens, int nparts) {
+    static UBYTE *plain = NULL, *packed = NULL;
+    static ULONG plain_size = 0;
+    ULONG pos = 0, len;
+    int i;
+
+    if (total > plain_size) {
+        plain_size = total;
+        plain = (UBYTE *)Util_realloc(plain, plain_size);
+        packed = (UBYTE *)Util_realloc(packed, 4 + StateSav_LZ_BOUND(plain_size));
+    }
+    for (i = 0; i < nparts; i++) {
+        if (lens[i] > 0) memcpy(plain + pos, parts[i], lens[i]);
+        pos += lens[i];
+    }
+    len = StateSav_LZCompress(plain, total, packed + 4);
+    if (4 + len >= total) return FALSE;
+    put_le32(packed, total);
+    header[3] = AI_BIN_FLAG_LZ4;
+    put_le32(header + 8, 4 + len);
+    if (client_write(c, header, AI_BIN_HEADER_SIZE))
+        client_write(c, packed, 4 + len);
+    return TRUE;
+}
+
+/* Send a binary frame whose payload is the NPARTS pieces back to back, so
+   that large buffers (screen, memory) go out without an intermediate copy */
+static void send_frame_parts(AI_Client *c, int opcode, ULONG tag, int status,
+                             const void * const *parts, const int *lens, int nparts) {
+    UBYTE header[AI_BIN_HEADER_SIZE];
+    ULONG total = 0;
+    int i;
+    if (c == NULL || c->fd < 0) return;
+
+    for (i = 0; i < nparts; i++) total += lens[i];
+    header[0] = AI_BIN_MAGIC;
+    header[1] = (UBYTE)opcode;
+    header[2] = (UBYTE)status;
+    header[3] = 0;
+    put_le32(header + 4, tag);
+    if (c->compress && total >= AI_LZ4_MIN_PAYLOAD
+        && send_frame_packed(c, header, total, parts, lens, nparts))
+        return;
+    put_le32(header + 8, total);
+    if (!client_write(c, header, sizeof(header))) return;
+    for (i = 0; i < nparts; i++) {
+        if (lens[i] > 0 && !client_write(c, parts[i], lens[i])) return;
+    }
+}
+
+static void send_frame(AI_Client *c, int opcode, ULONG tag, int status,
+                       const void *p1, int len1, const void *p2, int len2) {
+    const void *parts[2];
+    int lens[2];
+    parts[0] = p1;
+    parts[1] = p2;
+    lens[0] = len1;
+    lens[1] = len2;
+    send_frame_parts(c, opcode, tag, status, parts, lens, 2);
+}
+
+/* Reply to the binary frame being served */
+static void send_reply(int status, const void *p1, int len1, const void *p2, int len2) {
+    if (ai_cur == NULL) return;
+    send_frame(ai_cur, ai_cur->bin_opcode, ai_cur->bin_tag, status, p1, len1, p2, len2);
+}
+
+static void send_binary_error(const char *msg) {
+    send_reply(AI_BIN_STATUS_ERROR, msg, strlen(msg), NULL, 0);
+}
+
+/* Send a JSON message to one client in its current framing */
+static void send_json(AI_Client *c, int opcode, ULONG tag, const char *json) {
+    int len = strlen(json);
+    char header[32];
+
+    if (c == NULL || c->fd < 0) return;
+    if (c->protocol == AI_PROTOCOL_BINARY) {
+        send_frame(c, opcode, tag, AI_BIN_STATUS_OK, json, len, NULL, 0);
+        return;
+    }
+    snprintf(header, sizeof(header), "%d\n", len);
+    if (client_write(c, header, strlen(header)))
+        client_write(c, json, len);
+}
+
+/* A reply to the command being served, with its "id" put first when it
+   had one, so that a client with several commands in flight can tell
+   which reply is whose */
+static void send_reply_json(AI_Client *c, const char *json) {
+    char id[AI_REQ_ID_SIZE + 16], header[32];
+    int len, idlen;
+
+    if (!c->req_id[0] || json[0] != '{') {
+        send_json(c, c->bin_opcode, c->bin_tag, json);
+        return;
+    }
+    if (c->fd < 0) return;
+    json++;
+    len = strlen(json);
+    idlen = snprintf(id, sizeof(id), "{\"id\":%s%s", c->req_id, json[0] == '}' ? "" : ",");
+    if (c->protocol == AI_PROTOCOL_BINARY) {
+        send_frame(c, c->bin_opcode, c->bin_tag, AI_BIN_STATUS_OK, id, idlen, json, len);
+        return;
+    }
+    snprintf(header, sizeof(header), "%d\n", idlen + len);
+    if (client_write(c, header, strlen(header)) && client_write(c, id, idlen))
+        client_write(c, json, len);
+}
+
+/* Collect a sub-command reply while a batch is running */
+static void batch_capture(const char *json) {
+    static const char overflow[] = "{\"status\":\"error\",\"msg\":\"Batch response too large\"}";
+    int len = strlen(json);
+
+    if (ai_batch_out_len + len + 1 >= (int)sizeof(ai_batch_out) - (int)sizeof(overflow)) {
+        json = overflow;
+        len = sizeof(overflow) - 1;
+    }
+    if (strncmp(json, "{\"status\":\"error\"", 17) == 0) {
+        ai_batch_errors++;
+        if (ai_batch_failed < 0) ai_batch_failed = ai_batch_count;
+    }
+    if (ai_batch_out_len + len + 1 < (int)sizeof(ai_batch_out)) {
+        if (ai_batch_count > 0) ai_batch_out[ai_batch_out_len++] = ',';
+        memcpy(ai_batch_out + ai_batch_out_len, json, len);
+        ai_batch_out_len += len;
+    }
+    ai_batch_count++;
+}
+
+/* Send response to the client whose command is being served */
+void AI_SendResponse(const char *json) {
+    if (ai_batch_active && ai_cur == ai_batch_client) {
+        batch_capture(json);
+        return;
+    }
+    if (ai_cur == NULL) return;
+    /* JSON commands on a binary connection arrived through AI_BIN_JSON */
+    send_reply_json(ai_cur, json);
+}
+
+static void debug_put(ULONG pos, UBYTE byte) {
+    ai_debug.buf[pos % ai_debug.size] = byte;
+}
+
+/* Empty the ring and make it size bytes */
+static void debug_resize(ULONG size) {
+    free(ai_debug.buf);
+    free(ai_debug_out);
+    ai_debug.buf = (UBYTE *)Util_malloc(size);
+    ai_debug_out = (UBYTE *)Util_malloc(size);
+    ai_debug.size = size;
+    ai_debug.head = ai_debug.used = 0;
+    ai_debug.last_open = FALSE;
+    ai_debug.written = ai_debug.dropped = 0;
+}
+
+/* Debug write hook - called when program writes to debug port */
+void AI_DebugWrite(UBYTE byte) {
+    if (ai_debug.buf == NULL)
+        debug_resize(ai_debug.size);
+    if (ai_debug.last_open && ai_debug.last_frame == Atari800_nframes
+        && ai_debug.last_len < 0xffff) {
+        if (ai_debug.used + 1 > ai_debug.size) {
+            ai_debug.dropped++;
+            ai_debug.last_open = FALSE;
+            return;
+        }
+        ai_debug.last_len++;
+        debug_put(ai_debug.last + 4, (UBYTE)ai_debug.last_len);
+        debug_put(ai_debug.last + 5, (UBYTE)(ai_debug.last_len >> 8));
+    }
+    else {
+        int i;
+        if (ai_debug.used + AI_DEBUG_HEADER + 1 > ai_debug.size) {
+            ai_debug.dropped++;
+            ai_debug.last_open = FALSE;
+            return;
+        }
+        ai_debug.last = ai_debug.head;
+        ai_debug.last_open = TRUE;
+        ai_debug.last_frame = Atari800_nframes;
+        ai_debug.last_len = 1;
+        for (i = 0; i < 4; i++)
+            debug_put(ai_debug.head + i, (UBYTE)((ULONG)Atari800_nframes >> (8 * i)));
+        debug_put(ai_debug.head + 4, 1);
+        debug_put(ai_debug.head + 5, 0);
+        ai_debug.head = (ai_debug.head + AI_DEBUG_HEADER) % ai_debug.size;
+        ai_debug.used += AI_DEBUG_HEADER;
+    }
+    debug_put(ai_debug.head, byte);
+    ai_debug.head = (ai_debug.head + 1) % ai_debug.size;
+    ai_debug.used++;
+    ai_debug.written++;
+}
+
+/* Copy the oldest whole records, up to max bytes, to ai_debug_out,
+   leaving them in the ring. Returns the bytes copied. */
+static ULONG debug_peek(ULONG max) {
+    ULONG tail, n = 0;
+
+    if (ai_debug.used == 0) return 0;
+    tail = (ai_debug.head + ai_debug.size - ai_debug.used) % ai_debug.size;
+    while (n < ai_debug.used) {
+        ULONG len, i;
+        for (i = 0; i < AI_DEBUG_HEADER; i++)
+            ai_debug_out[n + i] = ai_debug.buf[(tail + n + i) % ai_debug.size];
+        len = AI_DEBUG_HEADER + get_le16(ai_debug_out + n + 4);
+        if (n + len > max) break;
+        for (; i < len; i++)
+            ai_debug_out[n + i] = ai_debug.buf[(tail + n + i) % ai_debug.size];
+        n += len;
+    }
+    return n;
+}
+
+/* Take out the n oldest bytes, as copied by debug_peek() */
+static void debug_consume(ULONG n) {
+    ai_debug.used -= n;
+    /* The newest record went too: bytes of its frame start another */
+    if (ai_debug.used == 0)
+        ai_debug.last_open = FALSE;
+}
+
+#ifdef SCREENSHOTS
+/* Screenshots sent inline are PNG where libpng is compiled in */
+#ifdef HAVE_LIBPNG
+#define AI_SCREENSHOT_FORMAT "png"
+#else
+#define AI_SCREENSHOT_FORMAT "pcx"
+#endif
+
+/* Save a screenshot to PATH, or when PATH is NULL to memory as an image of
+   type FORMAT ("png" or "pcx"; *data is set to the image and its size
+   returned), at zlib compression LEVEL, or at -compression-level when
+   LEVEL is out of 0-9. Returns 0 on failure. */
+static int save_screenshot(const char *path, const char *format, int level, const UBYTE **data) {
+    int result;
+#if defined(HAVE_LIBPNG) || defined(HAVE_LIBZ)
+    int saved_level = FILE_EXPORT_compression_level;
+    if (level >= 0 && level <= 9)
+        FILE_EXPORT_compression_level = level;
+#endif
+    if (path != NULL)
+        result = Screen_SaveScreenshot(path, 0);
+    else
+        result = File_Export_SaveScreenToMemory(format, (UBYTE *)Screen_atari, NULL, data);
+#if defined(HAVE_LIBPNG) || defined(HAVE_LIBZ)
+    FILE_EXPORT_compression_level = saved_level;
+#endif
+    return result;
+}
+#endif /* SCREENSHOTS */
+
+/* Screen to ASCII conversion */
+static void screen_to_ascii(char *out, int outsize) {
+    /* Map Atari screen (384x240) to 40x24 ASCII */
+    const char *chars = " .:-=+*#%@";
+    int char_count = strlen(chars);
+
+    int lines = 0;
+    int pos = 0;
+    int row, col;
+    out[pos++] = '[';
+
+    for (row = 0; row < 24 && pos < outsize - 100; row++) {
+        out[pos++] = '"';
+        for (col = 0; col < 40 && pos < outsize - 50; col++) {
+            /* Sample screen at this character position */
+            int sx = (col * 336 / 40) + 24;  /* 24 pixel left margin */
+            int sy = (row * 192 / 24) + 24;  /* 24 pixel top margin */
+            UBYTE pixel;
+            int brightness, char_idx;
+
+            if (sx < 0) sx = 0;
+            if (sx >= Screen_WIDTH) sx = Screen_WIDTH - 1;
+            if (sy < 0) sy = 0;
+            if (sy >= Screen_HEIGHT) sy = Screen_HEIGHT - 1;
+
+            /* Get pixel value and map to ASCII */
+            pixel = ((UBYTE *)Screen_atari)[sy * Screen_WIDTH + sx];
+            brightness = (pixel & 0x0F);  /* Luminance is low nibble */
+            char_idx = brightness * (char_count - 1) / 15;
+            out[pos++] = chars[char_idx];
+        }
+        out[pos++] = '"';
+        if (row < 23) out[pos++] = ',';
+        lines++;
+    }
+    out[pos++] = ']';
+    out[pos] = '\0';
+}
+
+/* Unicode for the ATASCII graphics characters: 0x00-0x1f, then 0x60,
+   0x7b, 0x7d, 0x7e and 0x7f */
+static const unsigned short atascii_graphics[37] = {
+    0x2665, 0x251c, 0x2595, 0x2518, 0x2524, 0x2510, 0x2571, 0x2572,
+    0x25e2, 0x2597, 0x25e3, 0x259d, 0x2598, 0x2594, 0x2581, 0x2596,
+    0x2663, 0x250c, 0x2500, 0x253c, 0x25cf, 0x2584, 0x258e, 0x252c,
+    0x2534, 0x258c, 0x2514, 0x241b, 0x2191, 0x2193, 0x2190, 0x2192,
+    0x25c6, 0x2660, 0x21b0, 0x25c0, 0x25b6
+};
+
+/* Append an ATASCII character (without the inverse bit) to out as
+   UTF-8, escaped for a JSON string; returns the bytes written */
+static int put_atascii(char *out, int c) {
+    int u;
+    if (c == '"' || c == '\\') {
+        out[0] = '\\';
+        out[1] = (char)c;
+        return 2;
+    }
+    if (c >= 0x20 && c < 0x7f && c != 0x60 && c != 0x7b && c != 0x7d && c != 0x7e) {
+        out[0] = (char)c;
+        return 1;
+    }
+    u = c < 0x20 ? atascii_graphics[c]
+        : atascii_graphics[c == 0x60 ? 32 : c == 0x7b ? 33 : c - 0x7d + 34];
+    /* All of them are three bytes in UTF-8 */
+    out[0] = (char)(0xe0 | (u >> 12));
+    out[1] = (char)(0x80 | ((u >> 6) & 0x3f));
+    out[2] = (char)(0x80 | (u & 0x3f));
+    return 3;
+}
+
+/* Screen memory as ANTIC sees it */
+static UBYTE antic_view_byte(UWORD addr) {
+    if (ANTIC_xe_ptr != NULL && addr >= 0x4000 && addr < 0x8000)
+        return ANTIC_xe_ptr[addr - 0x4000];
+    return MEMORY_SafeGetByte(addr);
+}
+
+/* Reply to "screen_ascii" with the text of the character mode lines
+   (ANTIC 2-7) in the display list the last frame ran, read from screen
+   memory. Returns FALSE, sending nothing, if there are none. */
+static int screen_text_reply(int inverse) {
+    /* [mode,ypos,lines,addr] of each row */
+    static char rows[ANTIC_DL_MAX * 24];
+    static char masks[ANTIC_DL_MAX * 52];
+    const ANTIC_DLEntry *dl;
+    ULONG generation;
+    int n = ANTIC_GetDisplayList(&dl, &generation);
+    int pos, rpos = 0, mpos = 0, nrows = 0, width = 0;
+    int i, k;
+
+    pos = snprintf(ai_response, sizeof(ai_response),
+        "{\"status\":\"ok\",\"source\":\"text\",\"data\":[");
+    for (i = 0; i < n; i++) {
+        int mode = dl[i].ir & 0x0f;
+        int chars;
+        if (mode < 2 || mode > 7) continue;
+        /* The bytes ANTIC fetched: the playfield width, or the next
+           wider one on a horizontally scrolled line */
+        chars = (ANTIC_DMACTL & 3) == 0 ? 0 : 24 + 8 * (ANTIC_DMACTL & 3);
+        if ((dl[i].ir & 0x10) && chars < 48) chars += 8;
+        if (mode >= 6) chars /= 2;
+        if (chars > width) width = chars;
+
+        if (pos + chars * 3 + 64 > (int)sizeof(ai_response)) break;
+        pos += snprintf(ai_response + pos, sizeof(ai_response) - pos,
+            "%s\"", nrows ? "," : "");
+        for (k = 0; k < chars; k++) {
+            /* Screen memory wraps at 4K boundaries */
+            UBYTE code = antic_view_byte((dl[i].operand & 0xf000) | ((dl[i].operand + k) & 0x0fff));
+            /* Modes 6 and 7 use the top bits for the colour */
+            int c = mode >= 6 ? code & 0x3f : code & 0x7f;
+            /* Internal screen code to ATASCII */
+            c = c < 0x40 ? c + 0x20 : c < 0x60 ? c - 0x40 : c;
+            pos += put_atascii(ai_response + pos, c);
+        }
+        ai_response[pos++] = '"';
+        if (inverse) {
+            /* ^ under the inverse characters; in modes 4 and 5 bit 7
+               picks the colour instead */
+            mpos += snprintf(masks + mpos, sizeof(masks) - mpos, "%s\"", nrows ? "," : "");
+            for (k = 0; k < chars; k++) {
+                UBYTE code = antic_view_byte((dl[i].operand & 0xf000) | ((dl[i].operand + k) & 0x0fff));
+                masks[mpos++] = mode <= 3 && (code & 0x80) ? '^' : ' ';
+            }
+            masks[mpos++] = '"';
+            masks[mpos] = '\0';
+        }
+        rpos += snprintf(rows + rpos, sizeof(rows) - rpos, "%s[%d,%d,%d,%d]",
+            nrows ? "," : "", mode, dl[i].ypos, dl[i].lines, dl[i].operand);
+        nrows++;
+    }
+    if (nrows == 0) return FALSE;
+    rows[rpos] = masks[mpos] = '\0';
+    pos += snprintf(ai_response + pos, sizeof(ai_response) - pos,
+        "],\"width\":%d,\"height\":%d,\"rows\":[%s]", width, nrows, rows);
+    if (inverse)
+        pos += snprintf(ai_response + pos, sizeof(ai_response) - pos, ",\"inverse\":[%s]", masks);
+    snprintf(ai_response + pos, sizeof(ai_response) - pos, "}");
+    AI_SendResponse(ai_response);
+    return TRUE;
+}
+
+/* Reply to "screen_ascii" with the text of the enabled 80 column card,
+   read from its character RAM. Returns FALSE, sending nothing, if there is
+   none or it shows graphics. */
+static int screen_text80_reply(int inverse) {
+    static TEXT80_Screen screen;
+    int pos, row, col;
+
+    if (!TEXT80_GetScreen(&screen)) return FALSE;
+    pos = snprintf(ai_response, sizeof(ai_response),
+        "{\"status\":\"ok\",\"source\":\"text80\",\"card\":\"%s\",\"data\":[", screen.card);
+    for (row = 0; row < screen.rows; row++) {
+        ai_response[pos++] = row ? ',' : ' ';
+        ai_response[pos++] = '"';
+        for (col = 0; col < TEXT80_COLUMNS; col++)
+            pos += put_atascii(ai_response + pos, screen.chars[row][col]);
+        ai_response[pos++] = '"';
+    }
+    pos += snprintf(ai_response + pos, sizeof(ai_response) - pos,
+        "],\"width\":%d,\"height\":%d,\"cursor\":[%d,%d]",
+        TEXT80_COLUMNS, screen.rows, screen.cursor_x, screen.cursor_y);
+    if (inverse) {
+        pos += snprintf(ai_response + pos, sizeof(ai_response) - pos, ",\"inverse\":[");
+        for (row = 0; row < screen.rows; row++) {
+            ai_response[pos++] = row ? ',' : ' ';
+            ai_response[pos++] = '"';
+            for (col = 0; col < TEXT80_COLUMNS; col++)
+                ai_response[pos++] = screen.inverse[row][col] ? '^' : ' ';
+            ai_response[pos++] = '"';
+        }
+        ai_response[pos++] = ']';
+    }
+    snprintf(ai_response + pos, sizeof(ai_response) - pos, "}");
+    AI_SendResponse(ai_response);
+    return TRUE;
+}
+
+static void process_command(const char *cmd);
+static void dispatch_command(const char *cmd);
+
+/* Send the aggregated reply of a finished batch */
+static void batch_finish(void) {
+    int stopped = ai_batch_stop_on_error && ai_batch_failed >= 0;
+    int pos;
+
+    ai_batch_active = 0;
+    pos = snprintf(ai_response, sizeof(ai_response),
+        "{\"status\":\"%s\",\"count\":%d,\"errors\":%d,",
+        stopped ? "error" : "ok", ai_batch_count, ai_batch_errors);
+    if (stopped) {
+        pos += snprintf(ai_response + pos, sizeof(ai_response) - pos,
+            "\"msg\":\"Batch stopped at command %d\",\"failed_index\":%d,",
+            ai_batch_failed, ai_batch_failed);
+    }
+    pos += snprintf(ai_response + pos, sizeof(ai_response) - pos, "\"results\":[");
+    memcpy(ai_response + pos, ai_batch_out, ai_batch_out_len);
+    pos += ai_batch_out_len;
+    snprintf(ai_response + pos, sizeof(ai_response) - pos, "]}");
+    AI_SendResponse(ai_response);
+}
+
+/* Run batch sub-commands until the batch ends or one of them resumes
+   emulation; in the latter case AI_Frame() calls back here once the
+   machine is paused again */
+static void batch_continue(void) {
+    static char sub[AI_BUFFER_SIZE];
+
+    while (ai_batch_active && ai_paused) {
+        if (ai_batch_stop_on_error && ai_batch_failed >= 0) break;
+        if (!json_next_object(ai_batch_cmds, &ai_batch_pos, sub, sizeof(sub))) break;
+        process_command(sub);
+    }
+    if (ai_batch_active && ai_paused) batch_finish();
+}
+
+/* Set joystick override - will be applied after INPUT_Frame */
+static void set_joystick(int port, int stick, int fire) {
+    if (port >= 0 && port < 4) {
+        /* Use -1 (no override) for center to allow keyboard input */
+        AI_joy_override[port] = (stick == INPUT_STICK_CENTRE) ? -1 : stick;
+        /* Set fire button override: 0 = pressed, -1 = no override (allows keyboard) */
+        AI_trig_override[port] = fire ? 0 : -1;
+    }
+}
+
+/* Parse the input of a frame from obj: "joy" (4 INPUT_STICK_* values),
+   "fire" (4 0/1), "pots" (8 values 0-228), "key" (AKEY_*) and "fire2";
+   NULL if it is valid, else what is wrong */
+static const char *frame_input_parse(const char *obj, AI_FrameInput *in) {
+    int v[8], n, i;
+
+    in->set = 0;
+    if ((n = json_get_signed_array(obj, "joy", v, 4)) < 0) return "joy must be up to 4 stick values";
+    for (i = 0; i < 4; i++)
+        in->joy[i] = i < n && v[i] >= 0 && v[i] < INPUT_STICK_CENTRE ? v[i] : -1;
+    if (n > 0) in->set |= AI_INPUT_JOY;
+    if ((n = json_get_signed_array(obj, "fire", v, 4)) < 0) return "fire must be up to 4 values";
+    for (i = 0; i < 4; i++)
+        in->trig[i] = i < n && v[i] > 0 ? 0 : -1;
+    if (n > 0) in->set |= AI_INPUT_FIRE;
+    if ((n = json_get_signed_array(obj, "pots", v, 8)) < 0) return "pots must be up to 8 values";
+    for (i = 0; i < 8; i++) {
+        if (i < n && v[i] > 228) return "pots must be 0-228, or -1";
+        in->pot[i] = i < n && v[i] >= 0 ? v[i] : -1;
+    }
+    if (n > 0) in->set |= AI_INPUT_POTS;
+    if (json_find(obj, "key") != NULL) {
+        in->key_code = json_get_int(obj, "key", AKEY_NONE);
+        if (in->key_code < 0) in->key_code = AKEY_NONE;
+        in->set |= AI_INPUT_KEY;
+    }
+    if (json_find(obj, "fire2") != NULL) {
+        in->key_shift = json_get_bool(obj, "fire2", FALSE);
+        in->set |= AI_INPUT_FIRE2;
+    }
+    return NULL;
+}
+
+static void frame_input_apply(const AI_FrameInput *in) {
+    if (in->set & AI_INPUT_JOY) memcpy(AI_joy_override, in->joy, sizeof(in->joy));
+    if (in->set & AI_INPUT_FIRE) memcpy(AI_trig_override, in->trig, sizeof(in->trig));
+    if (in->set & AI_INPUT_POTS) memcpy(INPUT_pot_override, in->pot, sizeof(in->pot));
+    if (in->set & AI_INPUT_KEY) INPUT_key_code = in->key_code;
+    if (in->set & AI_INPUT_FIRE2) INPUT_key_shift = in->key_shift;
+}
+
+/* Parse the "timeline" of a "run" from list, events like frame inputs
+   with a "frame" (of the run) and a "line"; NULL if it is valid */
+static const char *timeline_parse(const char *list, int frames) {
+    char item[512];
+    int pos = 0, n = 0;
+    const char *err = NULL;
+
+    ai_timeline.n = ai_timeline.next = 0;
+    if (*list != '[') return "timeline must be an array of events";
+    while (json_next_object(list + 1, &pos, item, sizeof(item))) {
+        AI_TimelineEvent *ev;
+        if (n == ai_timeline.alloc) {
+            ai_timeline.alloc = ai_timeline.alloc ? 2 * ai_timeline.alloc : 64;
+            ai_timeline.events = (AI_TimelineEvent *)Util_realloc(ai_timeline.events,
+                ai_timeline.alloc * sizeof(AI_TimelineEvent));
+        }
+        ev = &ai_timeline.events[n];
+        ev->frame = json_get_int(item, "frame", -1);
+        ev->line = json_get_int(item, "line", 0);
+        if (ev->frame < 0 || ev->frame >= frames) return "timeline frame must be within the run";
+        if (ev->line < 0 || ev->line >= Atari800_tv_mode) return "timeline line must be within the frame";
+        if (n > 0 && (ev->frame < ev[-1].frame
+                      || (ev->frame == ev[-1].frame && ev->line < ev[-1].line)))
+            return "timeline must be in order of frame and line";
+        if ((err = frame_input_parse(item, &ev->in)) != NULL) return err;
+        n++;
+    }
+    ai_timeline.n = n;
+    return NULL;
+}
+
+/* Line of the next timeline event if it falls in the frame running */
+static int timeline_line(void) {
+    const AI_TimelineEvent *ev;
+    if (ai_timeline.next >= ai_timeline.n) return -1;
+    ev = &ai_timeline.events[ai_timeline.next];
+    return ev->frame == ai_timeline.frame ? ev->line : -1;
+}
+
+/* Points AI_input_line at the first event of the frame about to run */
+static void timeline_arm(void) {
+    AI_input_line = -1;
+    if (ai_frames_to_run <= 0) return;
+    ai_timeline.frame = ai_run_frames - ai_frames_to_run;
+    AI_input_line = timeline_line();
+}
+
+void AI_InputLine(void) {
+    while (timeline_line() >= 0 && timeline_line() <= ANTIC_ypos)
+        frame_input_apply(&ai_timeline.events[ai_timeline.next++].in);
+    INPUT_Refresh();
+    AI_input_line = timeline_line();
+}
+
+/* The INPUT_STICK_* of a "direction"; centred if it is none of them */
+static int stick_direction(const char *dir) {
+    if (strcmp(dir, "up") == 0) return INPUT_STICK_FORWARD;
+    if (strcmp(dir, "down") == 0) return INPUT_STICK_BACK;
+    if (strcmp(dir, "left") == 0) return INPUT_STICK_LEFT;
+    if (strcmp(dir, "right") == 0) return INPUT_STICK_RIGHT;
+    if (strcmp(dir, "ul") == 0) return INPUT_STICK_UL;
+    if (strcmp(dir, "ur") == 0) return INPUT_STICK_UR;
+    if (strcmp(dir, "ll") == 0) return INPUT_STICK_LL;
+    if (strcmp(dir, "lr") == 0) return INPUT_STICK_LR;
+    return INPUT_STICK_CENTRE;
+}
+
+static int lockstep_joined(void) {
+    int port, n = 0;
+    for (port = 0; port < AI_LOCKSTEP_PORTS; port++)
+        if (ai_lockstep.player[port] != NULL) n++;
+    return n;
+}
+
+static int lockstep_port(const AI_Client *c) {
+    int port;
+    for (port = 0; port < AI_LOCKSTEP_PORTS; port++)
+        if (ai_lockstep.player[port] == c) return port;
+    return -1;
+}
+
+/* Push the state after a step to every player at once, and start waiting
+   for the actions of the next one */
+static void lockstep_push(void) {
+    JSON_Writer w;
+    int port, i;
+
+    jw_start(&w, ai_response, sizeof(ai_response));
+    jw_raw(&w, "{\"event\":\"step\"");
+    jw_field(&w, "step", ai_lockstep.step);
+    jw_field(&w, "frame", Atari800_nframes);
+    jw_key(&w, "defaulted");
+    jw_char(&w, '[');
+    for (port = 0, i = 0; port < AI_LOCKSTEP_PORTS; port++) {
+        if (ai_lockstep.defaulted & (1 << port)) {
+            if (i++) jw_char(&w, ',');
+            jw_int(&w, port);
+        }
+    }
+    jw_char(&w, ']');
+    if (ai_lockstep.naddrs > 0) {
+        jw_key(&w, "mem");
+        jw_char(&w, '[');
+        for (i = 0; i < ai_lockstep.naddrs; i++) {
+            if (i) jw_char(&w, ',');
+            jw_int(&w, MEMORY_SafeGetByte(ai_lockstep.addrs[i]));
+        }
+        jw_char(&w, ']');
+    }
+    jw_char(&w, '}');
+    for (port = 0; port < AI_LOCKSTEP_PORTS; port++) {
+        AI_Client *c = ai_lockstep.player[port];
+        if (c != NULL && c->fd >= 0) send_json(c, AI_BIN_EVENT_JSON, 0, ai_response);
+        ai_lockstep.acted[port] = FALSE;
+    }
+    ai_lockstep.waiting = TRUE;
+    ai_lockstep.wait_start = Util_time();
+}
+
+/* Run the step if every player has acted or the time is up */
+static void lockstep_check(void) {
+    int port, late = 0;
+
+    if (!ai_lockstep.waiting) return;
+    for (port = 0; port < AI_LOCKSTEP_PORTS; port++)
+        if (ai_lockstep.player[port] != NULL && !ai_lockstep.acted[port]) late |= 1 << port;
+    if (late != 0 && (ai_lockstep.timeout_ms <= 0
+        || (Util_time() - ai_lockstep.wait_start) * 1e3 < ai_lockstep.timeout_ms))
+        return;
+    for (port = 0; port < AI_LOCKSTEP_PORTS; port++) {
+        if (ai_lockstep.player[port] == NULL) continue;
+        if ((late & (1 << port)) && !ai_lockstep.repeat) {
+            ai_lockstep.stick[port] = INPUT_STICK_CENTRE;
+            ai_lockstep.fire[port] = 0;
+        }
+        set_joystick(port, ai_lockstep.stick[port], ai_lockstep.fire[port]);
+    }
+    ai_lockstep.defaulted = late;
+    ai_lockstep.waiting = FALSE;
+    ai_lockstep.frames_left = ai_lockstep.frames;
+    ai_paused = 0;
+}
+
+/* Milliseconds until a waiting step times out, for poll(); -1 if none */
+static int lockstep_wait_ms(void) {
+    double left;
+
+    if (!ai_lockstep.waiting || ai_lockstep.timeout_ms <= 0) return -1;
+    left = ai_lockstep.timeout_ms - (Util_time() - ai_lockstep.wait_start) * 1e3;
+    return left > 0 ? (int)left + 1 : 0;
+}
+
+/* End the episode: the players are told why and the machine pauses */
+static void lockstep_end(const char *reason) {
+    char event[128];
+    int port;
+
+    if (ai_lockstep.expected == 0) return;
+    snprintf(event, sizeof(event),
+        "{\"event\":\"lockstep_end\",\"step\":%d,\"frame\":%d,\"reason\":\"%s\"}",
+        ai_lockstep.step, Atari800_nframes, reason);
+    for (port = 0; port < AI_LOCKSTEP_PORTS; port++) {
+        AI_Client *c = ai_lockstep.player[port];
+        if (c != NULL && c->fd >= 0) send_json(c, AI_BIN_EVENT_JSON, 0, event);
+    }
+    if (ai_lockstep.frames_left > 0) ai_paused = 1;
+    memset(&ai_lockstep, 0, sizeof(ai_lockstep));
+}
+
+/* A player leaving ends the episode for all of them */
+static void lockstep_leave(AI_Client *c) {
+    if (c != NULL && lockstep_port(c) >= 0) lockstep_end("player left");
+}
+
+/* End free-running or lockstep; the subscription itself stays */
+static void stop_streaming(void) {
+    if (ai_stream_client != NULL) {
+        ai_stream_client->sub_mode = AI_SUB_OBSERVE;
+        ai_stream_client = NULL;
+    }
+}
+
+/* Acknowledge the records up to and including frame (-1 = all of them);
+   a lockstep subscriber's ack lets the machine run on */
+static void ack_records(AI_Client *c, int frame) {
+    if (frame < 0 || c->sub_every <= 0) {
+        c->sub_unacked = 0;
+    } else {
+        int behind = (c->sub_last_frame - frame) / c->sub_every;
+        if (behind < 0) behind = 0;
+        if (behind < c->sub_unacked) c->sub_unacked = behind;
+    }
+    if (c == ai_stream_client && c->sub_mode == AI_SUB_LOCKSTEP
+        && c->sub_unacked < c->sub_window)
+        ai_paused = 0;
+}
+
+/* The stage clock. With frame timing a mark is taken on each side of
+   every CPU_GO(), hundreds per frame, so on x86 it is the time stamp
+   counter (AI_Ticks() is a macro then); elsewhere the monotonic clock. */
+#ifndef AI_TICKS_TSC
+double AI_Ticks(void) {
+    return (double)Util_time_ns();
+}
+#endif
+static double ai_tick_seconds = 0.0;  /* 0 until calibrated */
+
+static void calibrate_ticks(void) {
+#ifdef AI_TICKS_TSC
+    int64_t ns0, ns1;
+    double t0, t1;
+    ns0 = Util_time_ns();
+    t0 = AI_Ticks();
+    do {
+        ns1 = Util_time_ns();
+        t1 = AI_Ticks();
+    } while (ns1 - ns0 < 5000000);
+    ai_tick_seconds = (ns1 - ns0) * 1e-9 / (t1 - t0);
+#else
+    ai_tick_seconds = 1e-9;
+#endif
+}
+
+double AI_TickSeconds(void) {
+    if (ai_tick_seconds == 0.0)
+        calibrate_ticks();
+    return ai_tick_seconds;
+}
+
+/* Reads the hardware counters into v; FALSE if they are off */
+static int hw_read(double *v) {
+#ifdef HAVE_LINUX_PERF_EVENT_H
+    __u64 values[1 + AI_HW_COUNTERS];  /* PERF_FORMAT_GROUP: nr, then the values */
+    int i;
+    if (ai_hw_fds[0] < 0 || read(ai_hw_fds[0], values, sizeof(values)) != sizeof(values))
+        return FALSE;
+    for (i = 0; i < AI_HW_COUNTERS; i++)
+        v[i] = (double)values[1 + i];
+    return TRUE;
+#else
+    return FALSE;
+#endif
+}
+
+static void hw_close(void) {
+    int i;
+    for (i = AI_HW_COUNTERS - 1; i >= 0; i--) {
+        if (ai_hw_fds[i] >= 0) close(ai_hw_fds[i]);
+        ai_hw_fds[i] = -1;
+    }
+}
+
+/* Counts this thread's user-mode cycles, instructions and cache misses
+   from now on; FALSE if the host cannot (no perf events, or
+   perf_event_paranoid forbids them) */
+static int hw_open(void) {
+#ifdef HAVE_LINUX_PERF_EVENT_H
+    static const __u64 events[AI_HW_COUNTERS] = {
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES};
+    int i;
+    if (ai_hw_fds[0] >= 0) return TRUE;
+    for (i = 0; i < AI_HW_COUNTERS; i++) {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = events[i];
+        attr.read_format = PERF_FORMAT_GROUP;
+        attr.disabled = i == 0;  /* the group starts with its leader */
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        ai_hw_fds[i] = (int)syscall(__NR_perf_event_open, &attr, 0, -1,
+                                    i ? ai_hw_fds[0] : -1, 0);
+        if (ai_hw_fds[i] < 0) {
+            hw_close();
+            return FALSE;
+        }
+    }
+    ioctl(ai_hw_fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    if (!hw_read(ai_hw_mark)) {
+        hw_close();
+        return FALSE;
+    }
+    return TRUE;
+#else
+    return FALSE;
+#endif
+}
+
+/* Turns the hardware counters on or off, and frame timing on with them,
+   for their stage marks; FALSE if they cannot be turned on */
+static int hw_set(int on) {
+    if (!on) {
+        hw_close();
+        return TRUE;
+    }
+    if (!hw_open()) return FALSE;
+    if (!AI_frame_timing) AI_SetFrameTiming(TRUE);
+    return TRUE;
+}
+
+/* Charge the host time since the last mark to a stage of the frame */
+void AI_TimeStage(int stage) {
+    double now = AI_Ticks();
+    double t = (now - ai_stage_mark) * ai_tick_seconds;
+    ai_stage_time[stage] += t;
+    ai_frame_stage[stage] += t;
+    if (AI_TIMELINE_enabled)
+        AI_TIMELINE_Span(AI_TIMELINE_EMULATOR, AI_time_stage_names[stage], ai_stage_mark, now);
+    ai_stage_mark = now;
+    if (ai_hw_fds[0] >= 0) {
+        double v[AI_HW_COUNTERS];
+        int i;
+        if (hw_read(v)) {
+            for (i = 0; i < AI_HW_COUNTERS; i++) {
+                ai_hw_stage[stage][i] += v[i] - ai_hw_mark[i];
+                ai_hw_mark[i] = v[i];
+            }
+        }
+    }
+}
+
+void AI_TimeReset(void) {
+    if (ai_tick_seconds == 0.0)
+        calibrate_ticks();
+    memset(ai_stage_time, 0, sizeof(ai_stage_time));
+    ai_stage_mark = AI_Ticks();
+    hw_read(ai_hw_mark);
+}
+
+/* Histogram bucket of a time in seconds: 0 under 1 us, then one per
+   power of two of us */
+static int time_bucket(double t) {
+    double us = t * 1e6;
+    int b = 0;
+    while (b < AI_TIME_BUCKETS - 1 && us >= (double)(1 << b))
+        b++;
+    return b;
+}
+
+static void frame_stats_add(int i, double t) {
+    ai_frame_stats.total[i] += t;
+    if (t > ai_frame_stats.max[i])
+        ai_frame_stats.max[i] = t;
+    ai_frame_stats.hist[i][time_bucket(t)]++;
+}
+
+/* Called at the end of each frame with frame timing on */
+void AI_TimeFrame(void) {
+    int i;
+    for (i = 0; i < AI_TIME_STAGES; i++) {
+        frame_stats_add(i, ai_frame_stage[i]);
+        ai_frame_stage[i] = 0.0;
+    }
+    frame_stats_add(AI_TIME_STAGES, (ai_stage_mark - ai_frame_start) * ai_tick_seconds);
+    if (AI_TIMELINE_enabled)
+        AI_TIMELINE_Span(AI_TIMELINE_EMULATOR, "frame", ai_frame_start, ai_stage_mark);
+    ai_frame_start = ai_stage_mark;
+    ai_frame_stats.frames++;
+    if (ai_hw_fds[0] >= 0) ai_hw_frames++;
+}
+
+void AI_SetFrameTiming(int on) {
+    if (on && !AI_frame_timing) {
+        if (ai_tick_seconds == 0.0)
+            calibrate_ticks();
+        memset(ai_frame_stage, 0, sizeof(ai_frame_stage));
+        ai_frame_start = ai_stage_mark = AI_Ticks();
+        AI_timing = TRUE;
+    }
+    else if (!on && ai_frames_to_run == 0)
+        AI_timing = FALSE;
+    if (!on)
+        hw_close();
+    AI_frame_timing = on;
+    CPU_UpdateGo();
+}
+
+void AI_GetFrameStats(AI_FrameStats *stats, int clear) {
+    *stats = ai_frame_stats;
+    if (clear)
+        memset(&ai_frame_stats, 0, sizeof(ai_frame_stats));
+}
+
+double AI_TimeCharged(int stage) {
+    return ai_stage_time[stage];
+}
+
+static int break_cond_find(int addr) {
+    int i;
+    for (i = 0; i < ai_nbreak_conds; i++)
+        if (ai_break_conds[i].addr == addr) return i;
+    return -1;
+}
+
+static void break_cond_remove(int addr) {
+    int i = break_cond_find(addr);
+    if (i >= 0)
+        ai_break_conds[i] = ai_break_conds[--ai_nbreak_conds];
+}
+
+/* Parses space-separated B command tokens into bc; returns NULL or the error */
+static const char *break_cond_parse(const char *text, AI_BreakCond *bc) {
+    static char error[96];
+    char token[64];
+
+    bc->size = 0;
+    while (*text) {
+        int len = 0;
+        const char *msg;
+        while (*text == ' ') text++;
+        if (*text == '\0') break;
+        while (*text && *text != ' ') {
+            /* the token may go back in the error message */
+            if (len < (int)sizeof(token) - 1)
+                token[len++] = *text == '"' || *text == '\\' ? '?' : toupper((unsigned char)*text);
+            text++;
+        }
+        token[len] = '\0';
+        if (bc->size == MONITOR_BREAKPOINT_TABLE_MAX)
+            return "Too many conditions";
+        msg = MONITOR_ParseBreakpointCond(token, &bc->table[bc->size]);
+        if (msg != NULL) {
+            snprintf(error, sizeof(error), "%s: %s", msg, token);
+            return error;
+        }
+        bc->size++;
+    }
+    return bc->size > 0 ? NULL : "Empty condition";
+}
+
+static int logpoint_find(int addr, int write) {
+    int i;
+    for (i = 0; i < ai_nlogpoints; i++)
+        if (ai_logpoints[i].addr == addr && ai_logpoints[i].write == write) return i;
+    return -1;
+}
+
+/* Count a hit of the logpoint at addr and record it, with the registers
+   in CPU_regA etc. and the instruction at pc */
+static void logpoint_hit(UWORD addr, int write, UWORD pc, int value) {
+    AI_Logpoint *lp;
+    AI_LogRec *rec;
+    int i = logpoint_find(addr, write);
+
+    /* A rewind re-simulates frames that were already logged */
+    if (i < 0 || ai_rewind_keyframe >= 0) return;
+    lp = &ai_logpoints[i];
+    if (lp->size > 0 && !MONITOR_BreakpointFires(lp->table, lp->size)) return;
+    lp->count++;
+    if (!lp->log) return;
+    if (ai_log_count == AI_LOG_RING) {
+        ai_log_start = (ai_log_start + 1) % AI_LOG_RING;
+        ai_log_count--;
+        ai_log_dropped++;
+    }
+    rec = &ai_log[(ai_log_start + ai_log_count++) % AI_LOG_RING];
+    CPU_GetStatus();
+    rec->addr = addr;
+    rec->pc = pc;
+    rec->frame = Atari800_nframes + 1;
+    rec->ypos = ANTIC_ypos;
+    rec->xpos = ANTIC_xpos;
+    rec->a = CPU_regA;
+    rec->x = CPU_regX;
+    rec->y = CPU_regY;
+    rec->s = CPU_regS;
+    rec->p = CPU_regP;
+    rec->value = lp->peek >= 0 ? MEMORY_SafeGetByte((UWORD)lp->peek) : value;
+}
+
+/* Called by the CPU before an instruction at a watched address, with the
+   registers in CPU_regPC etc. */
+void AI_WatchHit(UWORD pc) {
+    int i;
+    /* reverse_continue looks for the latest before the frame it started at */
+    if ((AI_pc_watch[pc] & AI_WATCH_BREAK) && ai_travel.kind == AI_TRAVEL_REVERSE_CONTINUE
+        && !ai_travel.returning && Atari800_nframes + 1 < ai_travel.now
+        && ((i = break_cond_find(pc)) < 0
+            || MONITOR_BreakpointFires(ai_break_conds[i].table, ai_break_conds[i].size))) {
+        ai_travel.found = TRUE;
+        ai_travel.pc = pc;
+        ai_travel.frame = Atari800_nframes + 1;
+        ai_travel.ypos = ANTIC_ypos;
+        ai_travel.xpos = ANTIC_xpos;
+    }
+    /* A rewind re-simulates frames that were already stopped in */
+    if ((AI_pc_watch[pc] & AI_WATCH_BREAK) && ai_break_addr < 0 && ai_rewind_keyframe < 0
+        && ((i = break_cond_find(pc)) < 0
+            || MONITOR_BreakpointFires(ai_break_conds[i].table, ai_break_conds[i].size))) {
+        ai_break_addr = pc;
+        ai_break_frame = Atari800_nframes + 1;
+        ai_break_ypos = ANTIC_ypos;
+        ai_break_xpos = ANTIC_xpos;
+    }
+    if (AI_pc_watch[pc] & AI_WATCH_LOG)
+        logpoint_hit(pc, FALSE, pc, -1);
+    if (!(AI_pc_watch[pc] & AI_WATCH_UNTIL)) return;
+    for (i = 0; i < ai_until_nterms; i++) {
+        AI_UntilTerm *t = &ai_until_terms[i];
+        if (t->kind == AI_UNTIL_PC && t->addr == pc && !t->hit) {
+            t->hit = TRUE;
+            t->hit_frame = Atari800_nframes + 1;  /* numbered like the reply's "frame" */
+            t->hit_ypos = ANTIC_ypos;
+            t->hit_xpos = ANTIC_xpos;
+        }
+    }
+}
+
+/* Called by the CPU after a store to a watched address */
+void AI_WriteHit(UWORD addr, UBYTE old) {
+    AI_WriteChange *ch;
+    UBYTE value = MEMORY_mem[addr];
+
+    if (value != old && (AI_write_watch[addr] & AI_WATCH_TRAVEL) && !ai_travel.returning) {
+        ai_travel.found = TRUE;
+        ai_travel.pc = AI_write_pc;
+        ai_travel.old = old;
+        ai_travel.value = value;
+        ai_travel.frame = Atari800_nframes + 1;
+        ai_travel.ypos = ANTIC_ypos;
+        ai_travel.xpos = ANTIC_xpos;
+    }
+    if (AI_write_watch[addr] & AI_WATCH_LOG) {
+        /* Conditions are those of the storing instruction */
+        UWORD pc = CPU_regPC;
+        CPU_regPC = AI_write_pc;
+        logpoint_hit(addr, TRUE, AI_write_pc, value);
+        CPU_regPC = pc;
+    }
+    /* No change, or a rewind re-simulating frames already reported */
+    if (value == old || ai_rewind_keyframe >= 0 || !(AI_write_watch[addr] & AI_WATCH_CHANGES)) return;
+    if (ai_changes_count == AI_WATCH_RING) {
+        ai_changes_start = (ai_changes_start + 1) % AI_WATCH_RING;
+        ai_changes_count--;
+        ai_changes_dropped++;
+    }
+    ch = &ai_changes[(ai_changes_start + ai_changes_count++) % AI_WATCH_RING];
+    ch->addr = addr;
+    ch->old = old;
+    ch->value = value;
+    ch->frame = Atari800_nframes + 1;
+    ch->ypos = ANTIC_ypos;
+    ch->xpos = ANTIC_xpos;
+    ai_changes_frame++;
+}
+
+/* Hottest first: by host time if it was taken, else by cycles */
+static int profile_compare(const void *a, const void *b) {
+    const AI_ProfileRec *x = &ai_profile_sorted[*(const UWORD *)a];
+    const AI_ProfileRec *y = &ai_profile_sorted[*(const UWORD *)b];
+    if (ai_profile_host_used && x->host != y->host) return x->host < y->host ? 1 : -1;
+    if (x->cycles != y->cycles) return x->cycles < y->cycles ? 1 : -1;
+    return (int)*(const UWORD *)a - (int)*(const UWORD *)b;
+}
+
+/* The ticks an instruction gains from being timed: the least a pair of
+   AI_Ticks() reads can differ by */
+static double profile_overhead(void) {
+    double best = 0.0;
+    int i;
+    for (i = 0; i < 1000; i++) {
+        double t0 = AI_Ticks();
+        double t = AI_Ticks() - t0;
+        if (i == 0 || t < best) best = t;
+    }
+    return best;
+}
+
+/* The host time of r in ns, less the timing's own */
+static double profile_host_ns(const AI_ProfileRec *r) {
+    double ns = (r->host - r->count * ai_profile_overhead) * ai_tick_seconds * 1e9;
+    return ns > 0.0 ? ns : 0.0;
+}
+
+static void cycle_values(const ANTIC_cycles_t *c, double *v) {
+    v[0] = c->total;
+    v[1] = c->cpu;
+    v[2] = c->idle;
+    v[3] = c->dma;
+    v[4] = c->wsync;
+    v[5] = c->dlis;
+    v[6] = c->vbis;
+    v[7] = c->irqs;
+}
+
+static void cycle_sum_add(AI_CycleSum *s, const ANTIC_cycles_t *c) {
+    double v[AI_CYCLE_KINDS];
+    int i;
+    cycle_values(c, v);
+    for (i = 0; i < AI_CYCLE_KINDS; i++)
+        s->sum[i] += v[i];
+    s->frames++;
+}
+
+/* {"total":...,...,"irqs":...}, each divided by div */
+static size_t cycles_json(char *out, size_t size, const double *v, double div) {
+    size_t len = snprintf(out, size, "{");
+    int i;
+    for (i = 0; i < AI_CYCLE_KINDS; i++)
+        len += snprintf(out + len, size - len, div == 1.0 ? "%s\"%s\":%.0f" : "%s\"%s\":%.1f",
+                        i ? "," : "", ai_cycle_names[i], div > 0 ? v[i] / div : 0.0);
+    return len + snprintf(out + len, size - len, "}");
+}
+
+/* [name,label address,count,cycles,host ns] of the routines, the PCs
+   grouped by the user label at or below them, hottest first */
+static int profile_routines_json(char *out, size_t size, int routines) {
+#ifdef MONITOR_HINTS
+    int n = 0, i, len;
+
+    memset(ai_routine_map, 0, sizeof(ai_routine_map));
+    for (i = 0; i < 65536; i++) {
+        const AI_ProfileRec *r = &ai_profile_map[i];
+        AI_ProfileRec *routine;
+        UWORD addr;
+        if (r->count == 0 || MONITOR_RoutineLabel((UWORD)i, &addr) == NULL) continue;
+        routine = &ai_routine_map[addr];
+        if (routine->count == 0) ai_profile_order[n++] = addr;
+        routine->count += r->count;
+        routine->cycles += r->cycles;
+        routine->host += profile_host_ns(r);
+    }
+    ai_profile_sorted = ai_routine_map;
+    qsort(ai_profile_order, n, sizeof(UWORD), profile_compare);
+    if (routines > n) routines = n;
+    len = snprintf(out, size, "[");
+    for (i = 0; i < routines; i++) {
+        const AI_ProfileRec *r = &ai_routine_map[ai_profile_order[i]];
+        UWORD addr;
+        const char *name = MONITOR_RoutineLabel(ai_profile_order[i], &addr);
+        len += snprintf(out + len, size - len, "%s[\"%s\",%d,%lu,%lu,", i ? "," : "",
+                        name, ai_profile_order[i], (unsigned long)r->count, (unsigned long)r->cycles);
+        len += snprintf(out + len, size - len, ai_profile_host_used ? "%.0f]" : "null]", r->host);
+    }
+    return len + snprintf(out + len, size - len, "]");
+#else
+    return snprintf(out, size, "null");
+#endif
+}
+
+static void profile_dump(int top, int csv, int routines) {
+    unsigned long insns = 0, cycles = 0, pages[16];
+    double host_ns = 0.0;
+    int n = 0, i, pos;
+
+    memset(pages, 0, sizeof(pages));
+    for (i = 0; i < 65536; i++) {
+        if (ai_profile_map[i].count == 0) continue;
+        insns += ai_profile_map[i].count;
+        cycles += ai_profile_map[i].cycles;
+        pages[i >> 12] += ai_profile_map[i].cycles;
+        host_ns += profile_host_ns(&ai_profile_map[i]);
+        ai_profile_order[n++] = (UWORD)i;
+    }
+    ai_profile_sorted = ai_profile_map;
+    qsort(ai_profile_order, n, sizeof(UWORD), profile_compare);
+    if (top > n) top = n;
+
+    pos = snprintf(ai_response, sizeof(ai_response),
+        "{\"status\":\"ok\",\"active\":%s,\"frames\":%d,\"insns\":%lu,\"cycles\":%lu,\"pcs\":%d,",
+        AI_profile != NULL ? "true" : "false",
+        ai_profile_frames + (AI_profile != NULL ? Atari800_nframes - ai_profile_start_frame : 0),
+        insns, cycles, n);
+    if (ai_profile_host_used)
+        pos += snprintf(ai_response + pos, sizeof(ai_response) - pos, "\"host_ns\":%.0f,", host_ns);
+    else
+        pos += snprintf(ai_response + pos, sizeof(ai_response) - pos, "\"host_ns\":null,");
+    if (csv) {
+        pos += snprintf(ai_response + pos, sizeof(ai_response) - pos, "\"csv\":\"pc,count,cycles%s\\n",
+                        ai_profile_host_used ? ",host_ns" : "");
+        for (i = 0; i < top; i++) {
+            const AI_ProfileRec *r = &ai_profile_map[ai_profile_order[i]];
+            pos += snprintf(ai_response + pos, sizeof(ai_response) - pos,
+                "%d,%lu,%lu", ai_profile_order[i], (unsigned long)r->count, (unsigned long)r->cycles);
+            if (ai_profile_host_used)
+                pos += snprintf(ai_response + pos, sizeof(ai_response) - pos, ",%.0f", profile_host_ns(r));
+            pos += snprintf(ai_response + pos, sizeof(ai_response) - pos, "\\n");
+        }
+        pos += snprintf(ai_response + pos, sizeof(ai_response) - pos, "\",");
+    }
+    else {
+        pos += snprintf(ai_response + pos, sizeof(ai_response) - pos, "\"top\":[");
+        for (i = 0; i < top; i++) {
+            const AI_ProfileRec *r = &ai_profile_map[ai_profile_order[i]];
+            pos += snprintf(ai_response + pos, sizeof(ai_response) - pos, "%s[%d,%lu,%lu",
+                i ? "," : "", ai_profile_order[i], (unsigned long)r->count, (unsigned long)r->cycles);
+            if (ai_profile_host_used)
+                pos += snprintf(ai_response + pos, sizeof(ai_response) - pos, ",%.0f", profile_host_ns(r));
+            pos += snprintf(ai_response + pos, sizeof(ai_response) - pos, "]");
+        }
+        pos += snprintf(ai_response + pos, sizeof(ai_response) - pos, "],");
+    }
+    if (routines > 0) {
+        pos += snprintf(ai_response + pos, sizeof(ai_response) - pos, "\"routines\":");
+        pos += profile_routines_json(ai_response + pos, sizeof(ai_response) - pos, routines);
+        pos += snprintf(ai_response + pos, sizeof(ai_response) - pos, ",");
+    }
+    pos += snprintf(ai_response + pos, sizeof(ai_response) - pos, "\"opcodes\":[");
+    for (i = 0; i < 256; i++)
+        pos += snprintf(ai_response + pos, sizeof(ai_response) - pos, "%s%lu",
+            i ? "," : "", (unsigned long)AI_profile_opcodes[i]);
+    pos += snprintf(ai_response + pos, sizeof(ai_response) - pos, "],\"pages\":[");
+    for (i = 0; i < 16; i++)
+        pos += snprintf(ai_response + pos, sizeof(ai_response) - pos, "%s%lu", i ? "," : "", pages[i]);
+    pos += snprintf(ai_response + pos, sizeof(ai_response) - pos, "],\"frame_cycles\":");
+    pos += cycles_json(ai_response + pos, sizeof(ai_response) - pos,
+                       ai_profile_cycle_sum.sum, ai_profile_cycle_sum.frames);
+    snprintf(ai_response + pos, sizeof(ai_response) - pos, "}");
+    AI_SendResponse(ai_response);
+}
+
+static const char *until_number(const char *p, int *out) {
+    char *end;
+    while (*p == ' ') p++;
+    if (*p == '$') *out = (int)strtol(p + 1, &end, 16);
+    else *out = (int)strtol(p, &end, 0);
+    return end == p || (*p == '$' && end == p + 1) ? NULL : end;
+}
+
+static const char *until_op(const char *p, int *op) {
+    static const char * const ops[] = {"==", "!=", "<=", ">=", "<", ">"};
+    static const int codes[] = {AI_UNTIL_EQ, AI_UNTIL_NE, AI_UNTIL_LE, AI_UNTIL_GE,
+                                AI_UNTIL_LT, AI_UNTIL_GT};
+    int i;
+    while (*p == ' ') p++;
+    for (i = 0; i < 6; i++) {
+        int len = strlen(ops[i]);
+        if (strncmp(p, ops[i], len) == 0) {
+            *op = codes[i];
+            return p + len;
+        }
+    }
+    return NULL;
+}
+
+/* Parse a run_until condition into ai_until_terms; returns NULL on
+   success or what is wrong with it */
+static const char *until_parse(const char *p) {
+    int n = 0, new_clause = TRUE;
+
+    for (;;) {
+        AI_UntilTerm *t;
+        if (n == AI_UNTIL_MAX_TERMS) return "Too many terms in condition";
+        t = &ai_until_terms[n];
+        memset(t, 0, sizeof(*t));
+        t->new_clause = new_clause;
+
+        while (*p == ' ') p++;
+        if (strncmp(p, "mem[", 4) == 0) {
+            t->kind = AI_UNTIL_MEM;
+            if ((p = until_number(p + 4, &t->addr)) == NULL || *p++ != ']')
+                return "Expected mem[ADDR]";
+            if ((p = until_op(p, &t->op)) == NULL) return "Expected a comparison";
+            while (*p == ' ') p++;
+            if (strncmp(p, "start", 5) == 0) {
+                t->use_start = TRUE;
+                t->value = MEMORY_SafeGetByte((UWORD)t->addr);
+                p += 5;
+            } else if ((p = until_number(p, &t->value)) == NULL) {
+                return "Expected a value or start";
+            }
+        } else if (strncmp(p, "pc", 2) == 0) {
+            t->kind = AI_UNTIL_PC;
+            if ((p = until_op(p + 2, &t->op)) == NULL || t->op != AI_UNTIL_EQ)
+                return "pc only supports ==";
+            if ((p = until_number(p, &t->addr)) == NULL) return "Expected an address";
+        } else if (strncmp(p, "changed", 7) == 0) {
+            t->kind = AI_UNTIL_CHANGED;
+            p += 7;
+        } else if (strncmp(p, "frames", 6) == 0) {
+            t->kind = AI_UNTIL_FRAMES;
+            if ((p = until_op(p + 6, &t->op)) == NULL) return "Expected a comparison";
+            if ((p = until_number(p, &t->value)) == NULL) return "Expected a frame count";
+        } else {
+            return "Expected mem[ADDR], pc, changed or frames";
+        }
+        t->addr &= 0xffff;
+        n++;
+
+        while (*p == ' ') p++;
+        if (*p == '\0') break;
+        if (strncmp(p, "&&", 2) == 0) new_clause = FALSE;
+        else if (strncmp(p, "||", 2) == 0) new_clause = TRUE;
+        else return "Expected && or ||";
+        p += 2;
+    }
+    ai_until_nterms = n;
+    return NULL;
+}
+
+static int until_compare(int a, int op, int b) {
+    switch (op) {
+    case AI_UNTIL_EQ: return a == b;
+    case AI_UNTIL_NE: return a != b;
+    case AI_UNTIL_LT: return a < b;
+    case AI_UNTIL_LE: return a <= b;
+    case AI_UNTIL_GT: return a > b;
+    default: return a >= b;
+    }
+}
+
+/* Evaluate the condition at the end of a frame; returns the index of the
+   first clause that holds, or -1 */
+static int until_check(void) {
+    int i, clause = -1, holds = FALSE;
+
+    for (i = 0; i < ai_until_nterms; i++) {
+        const AI_UntilTerm *t = &ai_until_terms[i];
+        int v;
+        if (t->new_clause) {
+            if (holds) return clause;
+            clause++;
+            holds = TRUE;
+        }
+        if (!holds) continue;
+        switch (t->kind) {
+        case AI_UNTIL_MEM:
+            v = until_compare(MEMORY_SafeGetByte((UWORD)t->addr), t->op, t->value);
+            break;
+        case AI_UNTIL_PC:
+            v = t->hit;
+            break;
+        case AI_UNTIL_CHANGED:
+            v = ai_changes_frame > 0;
+            break;
+        default:
+            v = until_compare(ai_until_frames, t->op, t->value);
+            break;
+        }
+        if (!v) holds = FALSE;
+    }
+    return holds ? clause : -1;
+}
+
+/* PC hits only count for the frame they happened in */
+static void until_clear_hits(void) {
+    int i;
+    for (i = 0; i < ai_until_nterms; i++) ai_until_terms[i].hit = FALSE;
+}
+
+/* Point the CPU at the watch map while anything in it is set */
+static void watch_update(void) {
+    int i, watching = ai_breakpoints > 0 || ai_pc_logpoints > 0;
+    for (i = 0; i < ai_until_nterms && ai_until_active && !watching; i++) {
+        if (ai_until_terms[i].kind == AI_UNTIL_PC) watching = TRUE;
+    }
+    AI_pc_watch = watching ? ai_pc_watch_map : NULL;
+    AI_write_watch = ai_write_watches > 0 || ai_write_logpoints > 0
+        || ai_travel.kind == AI_TRAVEL_LAST_WRITE ? ai_write_watch_map : NULL;
+    CPU_UpdateGo();
+}
+
+static void until_stop(void) {
+    int i;
+    ai_until_active = 0;
+    for (i = 0; i < ai_until_nterms; i++) {
+        if (ai_until_terms[i].kind == AI_UNTIL_PC)
+            ai_pc_watch_map[ai_until_terms[i].addr] &= ~AI_WATCH_UNTIL;
+    }
+    watch_update();
+}
+
+/* Send the reply for a finished run_until */
+static void until_reply(int clause) {
+    const AI_UntilTerm *hit = NULL;
+    int i, pos;
+
+    if (clause >= 0) {
+        int c = -1;
+        for (i = 0; i < ai_until_nterms; i++) {
+            if (ai_until_terms[i].new_clause) c++;
+            if (c == clause && ai_until_terms[i].kind == AI_UNTIL_PC) {
+                hit = &ai_until_terms[i];
+                break;
+            }
+        }
+    }
+    pos = snprintf(ai_response, sizeof(ai_response),
+        "{\"status\":\"ok\",\"fired\":%s,\"clause\":%d,\"frame\":%d,\"frames_run\":%d",
+        clause >= 0 ? "true" : "false", clause, Atari800_nframes, ai_until_frames);
+    if (hit != NULL) {
+        pos += snprintf(ai_response + pos, sizeof(ai_response) - pos,
+            ",\"pc_hit\":{\"pc\":%d,\"frame\":%d,\"scanline\":%d,\"xpos\":%d}",
+            hit->addr, hit->hit_frame, hit->hit_ypos, hit->hit_xpos);
+    }
+    snprintf(ai_response + pos, sizeof(ai_response) - pos, "}");
+    AI_SendResponse(ai_response);
+}
+
+/* The current client is owed the reply of a run. The client may have
+   queries answered while it runs, so the run keeps the id (or binary
+   opcode and tag) of the command that started it for the reply. */
+static void set_run_client(void) {
+    ai_run_client = ai_cur;
+    Util_strlcpy(ai_run_req_id, ai_cur->req_id, sizeof(ai_run_req_id));
+    ai_run_bin_opcode = ai_cur->bin_opcode;
+    ai_run_bin_tag = ai_cur->bin_tag;
+}
 
-/* Response buffer */
-static char ai_response[AI_MAX_RESPONSE];
+/* Make the client owed the reply of the run that ended current, to send
+   it; NULL if it has gone */
+static AI_Client *take_run_client(void) {
+    AI_Client *c = ai_run_client;
+    ai_run_client = NULL;
+    if (c != NULL) {
+        Util_strlcpy(c->req_id, ai_run_req_id, sizeof(c->req_id));
+        c->bin_opcode = ai_run_bin_opcode;
+        c->bin_tag = ai_run_bin_tag;
+    }
+    return c;
+}
 
-/* Simple JSON helpers - minimal implementation */
+/* The AKEY_* that types ASCII character c, or AKEY_NONE */
+static int ascii_key(int c) {
+    static const SWORD letters[26] = {
+        AKEY_a, AKEY_b, AKEY_c, AKEY_d, AKEY_e, AKEY_f, AKEY_g, AKEY_h, AKEY_i,
+        AKEY_j, AKEY_k, AKEY_l, AKEY_m, AKEY_n, AKEY_o, AKEY_p, AKEY_q, AKEY_r,
+        AKEY_s, AKEY_t, AKEY_u, AKEY_v, AKEY_w, AKEY_x, AKEY_y, AKEY_z};
+    static const SWORD digits[10] = {
+        AKEY_0, AKEY_1, AKEY_2, AKEY_3, AKEY_4, AKEY_5, AKEY_6, AKEY_7, AKEY_8, AKEY_9};
+    static const char punct[] = " !\"#$%&'()*+,-./:;<=>?@[\\]^_|";
+    static const SWORD punct_keys[] = {
+        AKEY_SPACE, AKEY_EXCLAMATION, AKEY_DBLQUOTE, AKEY_HASH, AKEY_DOLLAR,
+        AKEY_PERCENT, AKEY_AMPERSAND, AKEY_QUOTE, AKEY_PARENLEFT, AKEY_PARENRIGHT,
+        AKEY_ASTERISK, AKEY_PLUS, AKEY_COMMA, AKEY_MINUS, AKEY_FULLSTOP, AKEY_SLASH,
+        AKEY_COLON, AKEY_SEMICOLON, AKEY_LESS, AKEY_EQUAL, AKEY_GREATER,
+        AKEY_QUESTION, AKEY_AT, AKEY_BRACKETLEFT, AKEY_BACKSLASH, AKEY_BRACKETRIGHT,
+        AKEY_CIRCUMFLEX, AKEY_UNDERSCORE, AKEY_BAR};
+    const char *p;
 
-static const char* json_get_string(const char *json, const char *key, char *buf, int bufsize) {
-    char search[64];
-    snprintf(search, sizeof(search), "\"%s\":", key);
-    const char *p = strstr(json, search);
-    if (!p) return NULL;
-    p += strlen(search);
-    while (*p == ' ' || *p == '\t') p++;
-    if (*p != '"') return NULL;
-    p++;
-    int i = 0;
-    while (*p && *p != '"' && i < bufsize - 1) {
-        if (*p == '\\' && *(p+1)) { p++; }
-        buf[i++] = *p++;
+    if (c >= 'a' && c <= 'z') return letters[c - 'a'];
+    if (c >= 'A' && c <= 'Z') return letters[c - 'A'] | AKEY_SHFT;
+    if (c >= '0' && c <= '9') return digits[c - '0'];
+    switch (c) {
+    case '\n':
+    case 0x9b:  /* ATASCII EOL */
+        return AKEY_RETURN;
+    case '\t': return AKEY_TAB;
+    case '\b': return AKEY_BACKSPACE;
+    case 0x1b: return AKEY_ESCAPE;
     }
-    buf[i] = '\0';
-    return buf;
+    if (c != '\0' && (p = strchr(punct, c)) != NULL) return punct_keys[p - punct];
+    return AKEY_NONE;
 }
 
-static int json_get_int(const char *json, const char *key, int def) {
-    char search[64];
-    snprintf(search, sizeof(search), "\"%s\":", key);
-    const char *p = strstr(json, search);
-    if (!p) return def;
-    p += strlen(search);
-    while (*p == ' ' || *p == '\t') p++;
-    if (*p == '"') return def;  /* It's a string, not int */
-    return atoi(p);
+/* Choose the key of the frame about to run: the next one once the
+   program has taken the last out of CH, else none */
+static void type_next(void) {
+    int key = ai_type.pos < ai_type.n ? ai_type.keys[ai_type.pos] : AKEY_NONE;
+
+    if (key == AKEY_NONE || MEMORY_dGetByte(AI_TYPE_CH) != 0xff
+        /* INPUT_Frame() sees no new key where only shift or control changed */
+        || (ai_type.held != AKEY_NONE && ((key ^ ai_type.held) & ~AKEY_SHFTCTRL) == 0)
+        || (key == ai_type.last && MEMORY_dGetByte(AI_TYPE_KEYDEL) != 0))
+        key = AKEY_NONE;
+    else {
+        ai_type.pos++;
+        ai_type.last = key;
+    }
+    ai_type.held = key;
+    INPUT_key_code = key;
+    INPUT_key_shift = key != AKEY_NONE && (key & AKEY_SHFT) != 0;
 }
 
-static int json_get_bool(const char *json, const char *key, int def) {
-    char search[64];
-    snprintf(search, sizeof(search), "\"%s\":", key);
-    const char *p = strstr(json, search);
-    if (!p) return def;
-    p += strlen(search);
-    while (*p == ' ' || *p == '\t') p++;
-    if (strncmp(p, "true", 4) == 0) return 1;
-    if (strncmp(p, "false", 5) == 0) return 0;
-    return def;
+static void type_stop(void) {
+    ai_type.run = FALSE;
+    if (ai_type.held != AKEY_NONE) {
+        INPUT_key_code = AKEY_NONE;
+        INPUT_key_shift = 0;
+        ai_type.held = AKEY_NONE;
+    }
 }
 
-/* Base64 encoding for binary data */
-static const char b64_table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+/* Reply to a "type" once its keys are taken or its frames are up */
+static void type_reply(void) {
+    snprintf(ai_response, sizeof(ai_response),
+        "{\"status\":\"ok\",\"typed\":%d,\"keys\":%d,\"frames_run\":%d}",
+        ai_type.pos, ai_type.n, ai_run_frames);
+    AI_SendResponse(ai_response);
+    type_stop();
+}
 
-static int base64_encode(const UBYTE *data, int len, char *out, int outsize) {
-    int i, j = 0;
-    for (i = 0; i < len && j < outsize - 4; i += 3) {
-        int n = (data[i] << 16);
-        if (i + 1 < len) n |= (data[i + 1] << 8);
-        if (i + 2 < len) n |= data[i + 2];
-        out[j++] = b64_table[(n >> 18) & 63];
-        out[j++] = b64_table[(n >> 12) & 63];
-        out[j++] = (i + 1 < len) ? b64_table[(n >> 6) & 63] : '=';
-        out[j++] = (i + 2 < len) ? b64_table[n & 63] : '=';
+/* Start a "run" of frames for the current client; the reply goes out
+   from AI_Frame() once they are done */
+static void run_start(int frames, int unthrottled) {
+    stop_streaming();
+    if (ai_until_active) until_stop();
+    ai_run_frames = ai_frames_to_run = frames;
+    set_run_client();
+    ai_paused = 0;
+    AI_unthrottled = unthrottled;
+    AI_timing = TRUE;
+    AI_TimeReset();
+    ai_run_start_clock = ANTIC_CPU_CLOCK;
+    ai_run_start_time = Util_time();
+    ai_rewind_keyframe = -1;
+    ai_boot_run = FALSE;
+    ai_run_ninputs = 0;
+    ai_timeline.n = ai_timeline.next = 0;
+    if (ai_type.run) type_stop();
+}
+
+/* {"mean_us":...,"max_us":...,"hist":[...]} of stage i of the frame stats */
+static size_t frame_stats_json(char *out, size_t size, const AI_FrameStats *s, int i) {
+    size_t len = snprintf(out, size, "{\"mean_us\":%.1f,\"max_us\":%.1f,\"hist\":[",
+        s->frames ? s->total[i] * 1e6 / s->frames : 0.0, s->max[i] * 1e6);
+    int b;
+    for (b = 0; b < AI_TIME_BUCKETS; b++)
+        len += snprintf(out + len, size - len, b ? ",%lu" : "%lu", (unsigned long)s->hist[i][b]);
+    return len + snprintf(out + len, size - len, "]}");
+}
+
+#ifdef STAT_UNALIGNED_WORDS
+/* "name":[...8...] of accesses by the low 3 bits of their address */
+static size_t unaligned_json(char *out, size_t size, const char *name, const unsigned int *stat) {
+    size_t len = snprintf(out, size, "\"%s\":[", name);
+    int i;
+    for (i = 0; i < 8; i++)
+        len += snprintf(out + len, size - len, i ? ",%u" : "%u", stat[i]);
+    return len + snprintf(out + len, size - len, "]");
+}
+#endif
+
+/* "hw_counters" for "stats": the mean hardware counts per frame of each
+   stage, and its instructions per cycle; null while they are off */
+static size_t hw_counters_json(char *out, size_t size, int clear) {
+    size_t len;
+    int i, c;
+
+    if (ai_hw_fds[0] < 0)
+        return snprintf(out, size, "\"hw_counters\":null");
+    len = snprintf(out, size, "\"hw_counters\":{\"frames\":%lu,\"stages\":{",
+                   (unsigned long)ai_hw_frames);
+    for (i = 0; i < AI_TIME_STAGES; i++) {
+        const double *v = ai_hw_stage[i];
+        len += snprintf(out + len, size - len, "%s\"%s\":{", i ? "," : "", AI_time_stage_names[i]);
+        for (c = 0; c < AI_HW_COUNTERS; c++)
+            len += snprintf(out + len, size - len, "\"%s\":%.0f,", ai_hw_names[c],
+                            ai_hw_frames ? v[c] / ai_hw_frames : 0.0);
+        len += snprintf(out + len, size - len, "\"ipc\":%.2f}", v[0] > 0 ? v[1] / v[0] : 0.0);
     }
-    out[j] = '\0';
-    return j;
+    if (clear) {
+        memset(ai_hw_stage, 0, sizeof(ai_hw_stage));
+        ai_hw_frames = 0;
+    }
+    return len + snprintf(out + len, size - len, "}}");
 }
 
-/* Socket setup */
-static int setup_server_socket(void) {
-    struct sockaddr_un addr;
+/* The emulator's performance counters for "stats", from "fps" on; the
+   rate and CPU time are since the previous call */
+static size_t perf_stats_json(char *out, size_t size, int clear) {
+    double now = Util_time();
+    clock_t cpu = clock();
+    int frames = Atari800_nframes - ai_stats_frame;
+    double interval = now - ai_stats_time;
+    double target = Atari800_tv_mode == Atari800_TV_PAL ? Atari800_FPS_PAL : Atari800_FPS_NTSC;
+    size_t len;
+    int b;
+
+    if (AI_unthrottled || (Atari800_turbo && Atari800_turbo_speed == 0))
+        target = 0.0;
+    else if (Atari800_turbo)
+        target *= Atari800_turbo_speed / 100.0;
+    len = snprintf(out, size,
+        "\"fps\":%.2f,\"target_fps\":%.2f,\"cpu_ms_per_frame\":%.3f,\"interval_s\":%.3f,"
+        "\"frames_skipped\":%d,\"refresh_rate\":%d,\"auto_frameskip\":%s,"
+        "\"socket\":{\"bytes_in\":%.0f,\"bytes_out\":%.0f},"
+        "\"commands\":{\"count\":%lu,\"mean_us\":%.1f,\"max_us\":%.1f,\"hist\":[",
+        interval > 0 ? frames / interval : 0.0, target,
+        frames > 0 ? (double)(cpu - ai_stats_clock) * 1e3 / CLOCKS_PER_SEC / frames : 0.0,
+        interval, Atari800_frames_skipped, Atari800_refresh_rate,
+        Atari800_auto_frameskip ? "true" : "false", ai_bytes_in, ai_bytes_out,
+        (unsigned long)ai_cmd_count, ai_cmd_count ? ai_cmd_total * 1e6 / ai_cmd_count : 0.0,
+        ai_cmd_max * 1e6);
+    for (b = 0; b < AI_TIME_BUCKETS; b++)
+        len += snprintf(out + len, size - len, b ? ",%lu" : "%lu", (unsigned long)ai_cmd_hist[b]);
+    len += snprintf(out + len, size - len, "]},\"unaligned\":");
+#ifdef STAT_UNALIGNED_WORDS
+    len += snprintf(out + len, size - len, "{");
+    len += unaligned_json(out + len, size - len, "screen_write_long", Screen_atari_write_long_stat);
+    len += snprintf(out + len, size - len, ",");
+    len += unaligned_json(out + len, size - len, "pm_read_long", pm_scanline_read_long_stat);
+    len += snprintf(out + len, size - len, ",");
+    len += unaligned_json(out + len, size - len, "memory_read_word", memory_read_word_stat);
+    len += snprintf(out + len, size - len, ",");
+    len += unaligned_json(out + len, size - len, "memory_write_word", memory_write_word_stat);
+    len += snprintf(out + len, size - len, ",");
+    len += unaligned_json(out + len, size - len, "memory_read_aligned_word", memory_read_aligned_word_stat);
+    len += snprintf(out + len, size - len, ",");
+    len += unaligned_json(out + len, size - len, "memory_write_aligned_word", memory_write_aligned_word_stat);
+    len += snprintf(out + len, size - len, "}");
+#else
+    len += snprintf(out + len, size - len, "null");
+#endif
+    len += snprintf(out + len, size - len, ",\"sound\":");
+#ifdef SOUND
+    if (Sound_enabled) {
+        Sound_stats_t s;
+        Sound_GetStats(&s);
+        len += snprintf(out + len, size - len,
+            "{\"fill\":%u,\"size\":%u,\"min_fill\":%u,\"max_fill\":%u,"
+            "\"underruns\":%u,\"overruns\":%u,\"dropped\":%u}",
+            s.fill, s.size, s.min_fill, s.max_fill, s.underruns, s.overruns, s.dropped);
+    }
+    else
+#endif
+        len += snprintf(out + len, size - len, "null");
+    len += snprintf(out + len, size - len, ",\"record\":");
+#if defined(AUDIO_RECORDING) || defined(VIDEO_RECORDING)
+    {
+        int queued;
+        ULONG dropped;
+        if (File_Export_GetQueueStats(&queued, &dropped))
+            len += snprintf(out + len, size - len, "{\"queued\":%d,\"dropped\":%lu}",
+                            queued, (unsigned long)dropped);
+        else
+            len += snprintf(out + len, size - len, "null");
+    }
+#else
+    len += snprintf(out + len, size - len, "null");
+#endif
+
+    ai_stats_frame = Atari800_nframes;
+    ai_stats_time = now;
+    ai_stats_clock = cpu;
+    if (clear) {
+        ai_bytes_in = ai_bytes_out = 0.0;
+        ai_cmd_count = 0;
+        ai_cmd_total = ai_cmd_max = 0.0;
+        memset(ai_cmd_hist, 0, sizeof(ai_cmd_hist));
+        Atari800_frames_skipped = 0;
+    }
+    return len;
+}
 
-    unlink(AI_socket_path);  /* Remove existing socket */
+/* ,"features":[...] evaluated now, or nothing without features */
+static size_t features_json(char *out, size_t size) {
+    size_t len;
+    int i;
 
-    ai_server_fd = socket(AF_UNIX, SOCK_STREAM, 0);
-    if (ai_server_fd < 0) {
-        Log_print("AI: Failed to create socket: %s", strerror(errno));
+    if (ai_features.n == 0)
         return 0;
+    AI_FEATURE_Eval(&ai_features, ai_feature_values);
+    len = snprintf(out, size, ",\"features\":[");
+    for (i = 0; i < ai_features.n; i++)
+        len += snprintf(out + len, size - len, i ? ",%.9g" : "%.9g", ai_feature_values[i]);
+    return len + snprintf(out + len, size - len, "]");
+}
+
+/* Reply to a finished "run" with its frame, cycle and timing counts, and
+   the features at its end */
+static void run_reply(void) {
+    double wall = Util_time() - ai_run_start_time;
+    double emulated = ai_run_frames / (Atari800_tv_mode == Atari800_TV_PAL
+                                       ? Atari800_FPS_PAL : Atari800_FPS_NTSC);
+    ULONG cycles = (ULONG)(ANTIC_CPU_CLOCK - ai_run_start_clock);
+    int i, pos;
+
+    if (ai_cur != NULL && ai_cur->protocol == AI_PROTOCOL_BINARY
+        && ai_cur->bin_opcode == AI_BIN_RUN) {
+        UBYTE out[12 + 4 * AI_TIME_STAGES + 4 * AI_FEATURE_MAX];
+        UBYTE *p = out + 12 + 4 * AI_TIME_STAGES;
+        put_le32(out, (ULONG)ai_run_frames);
+        put_le32(out + 4, cycles);
+        put_le32(out + 8, (ULONG)(wall * 1e6));
+        for (i = 0; i < AI_TIME_STAGES; i++)
+            put_le32(out + 12 + 4 * i, (ULONG)(ai_stage_time[i] * 1e6));
+        /* The features follow as float32 */
+        AI_FEATURE_Eval(&ai_features, ai_feature_values);
+        for (i = 0; i < ai_features.n; i++, p += 4) {
+            ULONG bits;
+            memcpy(&bits, &ai_feature_values[i], 4);
+            put_le32(p, bits);
+        }
+        send_reply(AI_BIN_STATUS_OK, out, p - out, NULL, 0);
+        return;
+    }
+    pos = snprintf(ai_response, sizeof(ai_response),
+        "{\"status\":\"ok\",\"frames_run\":%d,\"cycles\":%lu,"
+        "\"wall_ms\":%.3f,\"emulated_ms\":%.3f,\"speed\":%.3f,"
+        "\"unthrottled\":%s,\"time_ms\":{",
+        ai_run_frames, (unsigned long)cycles, wall * 1e3, emulated * 1e3,
+        wall > 0 ? emulated / wall : 0.0, AI_unthrottled ? "true" : "false");
+    for (i = 0; i < AI_TIME_STAGES; i++) {
+        pos += snprintf(ai_response + pos, sizeof(ai_response) - pos,
+            "%s\"%s\":%.3f", i ? "," : "", AI_time_stage_names[i], ai_stage_time[i] * 1e3);
     }
+    pos += snprintf(ai_response + pos, sizeof(ai_response) - pos, "}");
+    pos += features_json(ai_response + pos, sizeof(ai_response) - pos);
+    snprintf(ai_response + pos, sizeof(ai_response) - pos, "}");
+    AI_SendResponse(ai_response);
+}
 
-    /* Set non-blocking */
-    int flags = fcntl(ai_server_fd, F_GETFL, 0);
-    fcntl(ai_server_fd, F_SETFL, flags | O_NONBLOCK);
+/* Reply to a finished "rewind" once its frames are re-simulated */
+static void rewind_reply(void) {
+    snprintf(ai_response, sizeof(ai_response),
+        "{\"status\":\"ok\",\"frame\":%d,\"keyframe\":%d,\"replayed\":%d}",
+        Atari800_nframes, ai_rewind_keyframe, Atari800_nframes - ai_rewind_keyframe);
+    AI_SendResponse(ai_response);
+    ai_rewind_keyframe = -1;
+}
 
-    memset(&addr, 0, sizeof(addr));
-    addr.sun_family = AF_UNIX;
-    strncpy(addr.sun_path, AI_socket_path, sizeof(addr.sun_path) - 1);
+/* Replay the keyframe interval before seg_end; FALSE if it is not in
+   the rewind history */
+static int travel_segment(void) {
+    int keyframe;
 
-    if (bind(ai_server_fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
-        Log_print("AI: Failed to bind socket: %s", strerror(errno));
-        close(ai_server_fd);
-        ai_server_fd = -1;
-        return 0;
+    if (ai_travel.seg_end - 1 < AI_REWIND_Oldest()) return FALSE;
+    keyframe = AI_REWIND_Restore(ai_travel.seg_end - 1);
+    if (keyframe < 0) return FALSE;
+    ai_travel.seg_start = keyframe;
+    ai_travel.replayed += ai_travel.seg_end - keyframe;
+    run_start(ai_travel.seg_end - keyframe, TRUE);
+    ai_rewind_keyframe = keyframe;
+    return TRUE;
+}
+
+static void travel_reply(void) {
+    int pos = snprintf(ai_response, sizeof(ai_response),
+        "{\"status\":\"ok\",\"found\":%s,\"frame\":%d,\"searched_from\":%d,\"replayed\":%d,\"us\":%.0f",
+        ai_travel.found ? "true" : "false", Atari800_nframes, ai_travel.seg_start,
+        ai_travel.replayed, (Util_time() - ai_travel.start_time) * 1e6);
+    if (ai_travel.found && ai_travel.kind == AI_TRAVEL_LAST_WRITE)
+        pos += snprintf(ai_response + pos, sizeof(ai_response) - pos,
+            ",\"write\":{\"addr\":%d,\"old\":%d,\"value\":%d,\"pc\":%d,\"frame\":%d,\"scanline\":%d,\"xpos\":%d}",
+            ai_travel.addr, ai_travel.old, ai_travel.value, ai_travel.pc,
+            ai_travel.frame, ai_travel.ypos, ai_travel.xpos);
+    else if (ai_travel.found)
+        pos += snprintf(ai_response + pos, sizeof(ai_response) - pos,
+            ",\"breakpoint\":{\"addr\":%d,\"frame\":%d,\"scanline\":%d,\"xpos\":%d}",
+            ai_travel.pc, ai_travel.frame, ai_travel.ypos, ai_travel.xpos);
+    snprintf(ai_response + pos, sizeof(ai_response) - pos, "}");
+    AI_SendResponse(ai_response);
+}
+
+/* Called when a replayed stretch is done: start the next one, or reply */
+static void travel_next(void) {
+    int target;
+
+    ai_rewind_keyframe = -1;
+    if (!ai_travel.returning) {
+        if (!ai_travel.found) {
+            ai_travel.seg_end = ai_travel.seg_start;
+            if (travel_segment()) return;
+        }
+        /* last_write goes back to where it was asked, reverse_continue
+           to the end of the frame of the hit */
+        ai_travel.returning = TRUE;
+        target = ai_travel.kind == AI_TRAVEL_REVERSE_CONTINUE && ai_travel.found
+            ? ai_travel.frame : ai_travel.now;
+        if (target < Atari800_nframes) {
+            /* Only the frames up to the hit were replayed: nothing is newer */
+            int keyframe = AI_REWIND_Restore(target);
+            if (keyframe >= 0 && keyframe < target) {
+                ai_travel.replayed += target - keyframe;
+                run_start(target - keyframe, TRUE);
+                ai_rewind_keyframe = keyframe;
+                return;
+            }
+        }
+        else if (target > Atari800_nframes) {
+            ai_travel.replayed += target - Atari800_nframes;
+            run_start(target - Atari800_nframes, TRUE);
+            ai_rewind_keyframe = Atari800_nframes;
+            return;
+        }
     }
+    travel_reply();
+    if (ai_travel.kind == AI_TRAVEL_LAST_WRITE)
+        ai_write_watch_map[ai_travel.addr] &= ~AI_WATCH_TRAVEL;
+    ai_travel.kind = AI_TRAVEL_NONE;
+    watch_update();
+}
 
-    if (listen(ai_server_fd, 1) < 0) {
-        Log_print("AI: Failed to listen: %s", strerror(errno));
-        close(ai_server_fd);
-        ai_server_fd = -1;
-        return 0;
+/* Start a last_write or reverse_continue from the current frame */
+static void travel_start(int kind, int addr) {
+    memset(&ai_travel, 0, sizeof(ai_travel));
+    ai_travel.kind = kind;
+    ai_travel.addr = addr;
+    ai_travel.now = ai_travel.seg_end = ai_travel.seg_start = Atari800_nframes;
+    ai_travel.start_time = Util_time();
+    if (kind == AI_TRAVEL_LAST_WRITE)
+        ai_write_watch_map[addr] |= AI_WATCH_TRAVEL;
+    watch_update();
+    if (!travel_segment()) {
+        travel_reply();
+        if (kind == AI_TRAVEL_LAST_WRITE)
+            ai_write_watch_map[addr] &= ~AI_WATCH_TRAVEL;
+        ai_travel.kind = AI_TRAVEL_NONE;
+        watch_update();
     }
+}
 
-    Log_print("AI: Listening on %s", AI_socket_path);
-    return 1;
+/* Drop what is left of a program being loaded by BINLOAD_Loader() */
+static void binload_stop(void) {
+    if (BINLOAD_bin_file != NULL) {
+        fclose(BINLOAD_bin_file);
+        BINLOAD_bin_file = NULL;
+    }
+    BINLOAD_start_binloading = FALSE;
+    BINLOAD_loading_basic = 0;
 }
 
-/* Send response to client */
-void AI_SendResponse(const char *json) {
-    if (ai_client_fd < 0) return;
+/* Cold boot, loading the program at path unless it is NULL, and run
+   frames frames; or, if the boot cache has that boot, restore it */
+static void boot_start(const char *path, int frames) {
+    int cacheable = AI_BOOTCACHE_MaxEntries() > 0
+        && AI_BOOTCACHE_MakeKey(&ai_boot_key, path, frames);
 
-    int len = strlen(json);
-    char header[32];
-    snprintf(header, sizeof(header), "%d\n", len);
-    write(ai_client_fd, header, strlen(header));
-    write(ai_client_fd, json, len);
+    if (cacheable) {
+        Atari800_Coldstart();
+        binload_stop();
+        if (AI_BOOTCACHE_Restore(&ai_boot_key)) {
+            stop_streaming();
+            if (ai_until_active) until_stop();
+            Atari800_nframes += frames;
+            AI_REWIND_Clear();
+            snprintf(ai_response, sizeof(ai_response),
+                "{\"status\":\"ok\",\"frames\":%d,\"cached\":true}", frames);
+            AI_SendResponse(ai_response);
+            return;
+        }
+    }
+    if (path == NULL)
+        Atari800_Coldstart();
+    else if (!BINLOAD_Loader(path)) {
+        snprintf(ai_response, sizeof(ai_response),
+            "{\"status\":\"error\",\"msg\":\"Failed to load %s\"}", path);
+        AI_SendResponse(ai_response);
+        return;
+    }
+    run_start(frames, TRUE);
+    ai_boot_run = TRUE;
+    ai_boot_cacheable = cacheable;
 }
 
-/* Debug write hook - called when program writes to debug port */
-void AI_DebugWrite(UBYTE byte) {
-    if (ai_debug_buffer_pos < AI_DEBUG_BUFFER_SIZE) {
-        ai_debug_buffer[ai_debug_buffer_pos++] = byte;
+/* Reply to a finished boot, storing it in the boot cache if it ran all
+   its frames and the program is loaded by then */
+static void boot_reply(void) {
+    int stored = ai_boot_cacheable && ai_run_frames == ai_boot_key.frames
+        && BINLOAD_bin_file == NULL && !BINLOAD_start_binloading
+        && AI_BOOTCACHE_Store(&ai_boot_key);
+
+    snprintf(ai_response, sizeof(ai_response),
+        "{\"status\":\"ok\",\"frames\":%d,\"cached\":false,\"stored\":%s}",
+        ai_run_frames, stored ? "true" : "false");
+    AI_SendResponse(ai_response);
+    ai_boot_run = FALSE;
+}
+
+/* Record the input for the frame about to run or, while a rewind
+   re-simulates, put back the input recorded for it */
+static void rewind_input(void) {
+    AI_RewindInput rec;
+    int frame = Atari800_nframes + 1;
+
+    if (AI_REWIND_Depth() == 0) return;
+    if (ai_rewind_keyframe >= 0) {
+        const void *p = AI_REWIND_GetInput(AI_REWIND_AI, frame);
+        if (p == NULL) return;
+        memcpy(&rec, p, sizeof(rec));
+        memcpy(AI_joy_override, rec.joy, sizeof(rec.joy));
+        memcpy(AI_trig_override, rec.trig, sizeof(rec.trig));
+        memcpy(INPUT_pot_override, rec.pot, sizeof(rec.pot));
+        INPUT_key_code = rec.key_code;
+        INPUT_key_shift = rec.key_shift;
+        INPUT_key_consol = rec.consol;
+        return;
     }
+    memcpy(rec.joy, AI_joy_override, sizeof(rec.joy));
+    memcpy(rec.trig, AI_trig_override, sizeof(rec.trig));
+    memcpy(rec.pot, INPUT_pot_override, sizeof(rec.pot));
+    rec.key_code = INPUT_key_code;
+    rec.key_shift = INPUT_key_shift;
+    rec.consol = INPUT_key_consol;
+    AI_REWIND_RecordInput(AI_REWIND_AI, frame, &rec, sizeof(rec));
 }
 
-/* Screen to ASCII conversion */
-static void screen_to_ascii(char *out, int outsize) {
-    /* Map Atari screen (384x240) to 40x24 ASCII */
-    const char *chars = " .:-=+*#%@";
-    int char_count = strlen(chars);
+/* Tell clients about async saves that have finished */
+static void report_saves(void) {
+    char event[96 + AI_REQ_ID_SIZE];
+    int id, state;
 
-    int lines = 0;
-    int pos = 0;
-    out[pos++] = '[';
+    while ((id = AI_SAVER_NextDone(&state)) > 0) {
+        AI_Client *c = ai_save_clients[id % AI_SAVER_MAX_JOBS];
+        ai_save_clients[id % AI_SAVER_MAX_JOBS] = NULL;
+        if (c == NULL || c->fd < 0) continue;
+        if (ai_save_req_ids[id % AI_SAVER_MAX_JOBS][0])
+            snprintf(event, sizeof(event), "{\"event\":\"save_state\",\"id\":%s,\"job\":%d,\"ok\":%s}",
+                ai_save_req_ids[id % AI_SAVER_MAX_JOBS], id, state == AI_SAVER_DONE ? "true" : "false");
+        else
+            snprintf(event, sizeof(event), "{\"event\":\"save_state\",\"job\":%d,\"ok\":%s}",
+                id, state == AI_SAVER_DONE ? "true" : "false");
+        send_json(c, AI_BIN_EVENT_JSON, 0, event);
+    }
+}
 
-    for (int row = 0; row < 24 && pos < outsize - 100; row++) {
-        out[pos++] = '"';
-        for (int col = 0; col < 40 && pos < outsize - 50; col++) {
-            /* Sample screen at this character position */
-            int sx = (col * 336 / 40) + 24;  /* 24 pixel left margin */
-            int sy = (row * 192 / 24) + 24;  /* 24 pixel top margin */
+/* "save_state" with async: capture now, write on the saver thread */
+static void save_state_async(const char *path, int codec) {
+    ULONG len;
+    UBYTE *image = StateSav_CaptureAtariState(TRUE, &len);
+    int id;
 
-            if (sx < 0) sx = 0;
-            if (sx >= Screen_WIDTH) sx = Screen_WIDTH - 1;
-            if (sy < 0) sy = 0;
-            if (sy >= Screen_HEIGHT) sy = Screen_HEIGHT - 1;
+    if (image == NULL) {
+        AI_SendResponse("{\"status\":\"error\",\"msg\":\"Failed to save state\"}");
+        return;
+    }
+    id = AI_SAVER_Queue(path, image, len, codec);
+    if (id == 0) {
+        free(image);
+        AI_SendResponse("{\"status\":\"error\",\"msg\":\"Too many saves pending\"}");
+        return;
+    }
+    ai_save_clients[id % AI_SAVER_MAX_JOBS] = ai_cur;
+    Util_strlcpy(ai_save_req_ids[id % AI_SAVER_MAX_JOBS], ai_cur->req_id, AI_REQ_ID_SIZE);
+    snprintf(ai_response, sizeof(ai_response),
+        "{\"status\":\"ok\",\"job\":%d,\"pending\":true}", id);
+    AI_SendResponse(ai_response);
+    /* Sent after the reply if it is done already (no writer thread) */
+    report_saves();
+}
 
-            /* Get pixel value and map to ASCII */
-            UBYTE pixel = ((UBYTE *)Screen_atari)[sy * Screen_WIDTH + sx];
-            int brightness = (pixel & 0x0F);  /* Luminance is low nibble */
-            int char_idx = brightness * (char_count - 1) / 15;
-            out[pos++] = chars[char_idx];
-        }
-        out[pos++] = '"';
-        if (row < 23) out[pos++] = ',';
-        lines++;
+/* Commands that only read the machine or only affect the asking
+   connection; any client may send them, everything else needs control */
+static const char * const ai_query_commands[] = {
+    "ping", "protocol", "role", "subscribe", "unsubscribe", "ack", "batch",
+    "screenshot", "screen_ascii", "screen_raw", "screen_delta", "observation", "hash", "peek", "peek_multi", "peek_bank", "dump", "cpu",
+    "antic", "cycles", "display_list", "gtia", "pokey", "pia", "disk_status", "netsio", "save_state", "state_get", "save_status", "profile_dump", "trace_status", "timeline_status",
+    "search_list", "discover", "discover_status", "history", "disasm", "stats", NULL
+};
+
+static int is_query_command(const char *cmd_type) {
+    int i;
+    for (i = 0; ai_query_commands[i] != NULL; i++) {
+        if (strcmp(cmd_type, ai_query_commands[i]) == 0) return TRUE;
     }
-    out[pos++] = ']';
-    out[pos] = '\0';
+    return FALSE;
+}
+
+/* Commands a client may have answered between frames while a run it
+   started goes on: the queries, but for those whose order with the run's
+   reply matters, as they change how the client is served */
+static int may_overlap_run(const char *cmd_type) {
+    static const char * const ordered[] = {
+        "protocol", "role", "subscribe", "unsubscribe", "ack", "batch", NULL
+    };
+    int i;
+    if (!is_query_command(cmd_type)) return FALSE;
+    for (i = 0; ordered[i] != NULL; i++) {
+        if (strcmp(cmd_type, ordered[i]) == 0) return FALSE;
+    }
+    return TRUE;
+}
+
+/* Give the current client control if it may have it; returns NULL on
+   success or the reason it was refused */
+static const char *take_control(void) {
+    if (ai_lockstep.expected > 0) return "A lockstep episode is in progress";
+    if (ai_controller == ai_cur) return NULL;
+    if (ai_cur->observer) return "Observers cannot control the emulator";
+    if (ai_controller != NULL && ai_controller_exclusive)
+        return "Another client has exclusive control";
+    if (ai_controller != NULL) Log_print("AI: Control passed to another client");
+    ai_controller = ai_cur;
+    ai_controller_exclusive = 0;
+    return NULL;
+}
+
+/* Binary counterpart of the control check in process_command() */
+static int may_serve_binary(int opcode) {
+    const char *denied;
+    switch (opcode) {
+    case AI_BIN_PING:
+    case AI_BIN_JSON:
+    case AI_BIN_PEEK:
+    case AI_BIN_PEEK_MULTI:
+    case AI_BIN_PEEK_BANK:
+    case AI_BIN_SCREEN_RAW:
+    case AI_BIN_SCREEN_DELTA:
+    case AI_BIN_OBSERVATION:
+    case AI_BIN_SCREENSHOT:
+    case AI_BIN_HASH:
+    case AI_BIN_CPU:
+    case AI_BIN_HISTORY:
+    case AI_BIN_STATE_SAVE:
+    case AI_BIN_STATE_GET:
+    case AI_BIN_ACK:
+    case AI_BIN_PROTOCOL_JSON:
+        return TRUE;
+    default:
+        break;
+    }
+    denied = take_control();
+    if (denied == NULL) return TRUE;
+    send_binary_error(denied);
+    return FALSE;
+}
+
+static const char *client_role(const AI_Client *c) {
+    if (c == ai_controller) return "controller";
+    return c->observer ? "observer" : "none";
 }
 
 /* Process a command */
+/* Serve a JSON command through its key index */
 static void process_command(const char *cmd) {
+    JSON_Index ix, *outer = json_cur;
+
+    json_index(&ix, cmd);
+    json_cur = &ix;
+    dispatch_command(cmd);
+    json_cur = outer;
+}
+
+static void dispatch_command(const char *cmd) {
     char cmd_type[32] = "";
     char path[512] = "";
 
     json_get_string(cmd, "cmd", cmd_type, sizeof(cmd_type));
 
+    /* Lockstep players act side by side, without taking control */
+    if (!is_query_command(cmd_type) && strcmp(cmd_type, "act") != 0
+        && strncmp(cmd_type, "lockstep_", 9) != 0) {
+        const char *denied = take_control();
+        if (denied != NULL) {
+            snprintf(ai_response, sizeof(ai_response),
+                "{\"status\":\"error\",\"msg\":\"%s\"}", denied);
+            AI_SendResponse(ai_response);
+            return;
+        }
+    }
+
     /* === CONTROL === */
     if (strcmp(cmd_type, "ping") == 0) {
         AI_SendResponse("{\"status\":\"ok\",\"msg\":\"pong\"}");
     }
     else if (strcmp(cmd_type, "load") == 0) {
+        int boot_frames = json_get_int(cmd, "boot_frames", 0);
+        int direct = json_get_bool(cmd, "direct", FALSE);
         json_get_string(cmd, "path", path, sizeof(path));
-        if (path[0] && BINLOAD_Loader(path)) {
+        if (direct && boot_frames > 0) {
+            AI_SendResponse("{\"status\":\"error\",\"msg\":\"A direct load does not boot\"}");
+        } else if (path[0] && boot_frames > 0) {
+            boot_start(path, boot_frames);
+            /* Response sent after the boot, unless it was cached */
+        } else if (path[0] && (direct ? BINLOAD_LoaderDirect(path) : BINLOAD_Loader(path))) {
             AI_SendResponse("{\"status\":\"ok\"}");
         } else {
             snprintf(ai_response, sizeof(ai_response),
@@ -232,22 +3987,486 @@ static void process_command(const char *cmd) {
         }
     }
     else if (strcmp(cmd_type, "run") == 0) {
-        ai_frames_to_run = json_get_int(cmd, "frames", 1);
-        ai_paused = 0;
+        const char *list = json_find(cmd, "inputs");
+        const char *timeline = json_find(cmd, "timeline");
+        int frames = json_get_int(cmd, "frames", 1);
+        const char *err = NULL;
+        int pos = 0, n = 0, nevents = 0;
+
+        if (list != NULL) {
+            char item[512];
+            if (*list != '[')
+                err = "inputs must be an array of frame inputs";
+            while (err == NULL && json_next_object(list + 1, &pos, item, sizeof(item))) {
+                if (n == frames) {
+                    err = "more inputs than frames";
+                    break;
+                }
+                if (n == ai_run_inputs_alloc) {
+                    ai_run_inputs_alloc = ai_run_inputs_alloc ? 2 * ai_run_inputs_alloc : 64;
+                    ai_run_inputs = (AI_FrameInput *)Util_realloc(ai_run_inputs,
+                        ai_run_inputs_alloc * sizeof(AI_FrameInput));
+                }
+                err = frame_input_parse(item, &ai_run_inputs[n++]);
+            }
+        }
+        if (err == NULL && timeline != NULL) {
+            err = timeline_parse(timeline, frames);
+            nevents = ai_timeline.n;
+        }
+        if (err != NULL) {
+            snprintf(ai_response, sizeof(ai_response),
+                "{\"status\":\"error\",\"msg\":\"%s\"}", err);
+            AI_SendResponse(ai_response);
+            return;
+        }
+        run_start(frames, json_get_bool(cmd, "unthrottled", FALSE));
+        ai_run_ninputs = n;
+        ai_timeline.n = nevents;
         /* Response sent after frames complete */
     }
+    else if (strcmp(cmd_type, "run_until") == 0) {
+        char until[512] = "";
+        const char *err;
+        int i;
+
+        json_get_string(cmd, "until", until, sizeof(until));
+        if ((err = until_parse(until)) != NULL) {
+            snprintf(ai_response, sizeof(ai_response),
+                "{\"status\":\"error\",\"msg\":\"%s\"}", err);
+            AI_SendResponse(ai_response);
+            return;
+        }
+        stop_streaming();
+        for (i = 0; i < ai_until_nterms; i++) {
+            if (ai_until_terms[i].kind == AI_UNTIL_PC)
+                ai_pc_watch_map[ai_until_terms[i].addr] |= AI_WATCH_UNTIL;
+        }
+        ai_until_max_frames = json_get_int(cmd, "max_frames", 3600);
+        ai_until_frames = 0;
+        ai_until_active = 1;
+        watch_update();
+        ai_frames_to_run = 0;
+        AI_timing = AI_frame_timing;
+        AI_unthrottled = FALSE;
+        set_run_client();
+        ai_paused = 0;
+        /* Response sent when the condition fires */
+    }
+    else if (strcmp(cmd_type, "render") == 0) {
+        static const char * const modes[] = {"always", "observed", "every"};
+        char mode[16] = "always";
+        int policy;
+
+        json_get_string(cmd, "mode", mode, sizeof(mode));
+        for (policy = 0; policy < 3 && strcmp(mode, modes[policy]) != 0; policy++)
+            ;
+        if (policy == 3) {
+            AI_SendResponse("{\"status\":\"error\",\"msg\":\"mode must be always, observed or every\"}");
+            return;
+        }
+        AI_render_policy = policy;
+        AI_render_every = json_get_int(cmd, "every", 1);
+        if (AI_render_every < 1) AI_render_every = 1;
+        snprintf(ai_response, sizeof(ai_response),
+            "{\"status\":\"ok\",\"mode\":\"%s\",\"every\":%d}", modes[policy], AI_render_every);
+        AI_SendResponse(ai_response);
+    }
+    else if (strcmp(cmd_type, "rewind_config") == 0) {
+        int depth = json_get_int(cmd, "depth", AI_REWIND_Depth());
+        int stride = json_get_int(cmd, "stride", AI_REWIND_Stride());
+
+        if ((depth != AI_REWIND_Depth() || stride != AI_REWIND_Stride())
+            && !AI_REWIND_Configure(depth, stride)) {
+            AI_SendResponse("{\"status\":\"error\",\"msg\":\"Invalid depth or stride\"}");
+            return;
+        }
+        snprintf(ai_response, sizeof(ai_response),
+            "{\"status\":\"ok\",\"depth\":%d,\"stride\":%d,\"oldest\":%d,\"bytes\":%lu}",
+            AI_REWIND_Depth(), AI_REWIND_Stride(), AI_REWIND_Oldest(),
+            (unsigned long)AI_REWIND_Bytes());
+        AI_SendResponse(ai_response);
+    }
+    else if (strcmp(cmd_type, "last_write") == 0 || strcmp(cmd_type, "reverse_continue") == 0) {
+        int last_write = cmd_type[0] == 'l';
+        int addr = json_get_int(cmd, "addr", -1);
+
+        if (AI_REWIND_Depth() == 0) {
+            AI_SendResponse("{\"status\":\"error\",\"msg\":\"Rewind is off, see rewind_config\"}");
+            return;
+        }
+        if (last_write && (addr < 0 || addr > 0xffff)) {
+            AI_SendResponse("{\"status\":\"error\",\"msg\":\"addr must be 0-65535\"}");
+            return;
+        }
+        if (!last_write && ai_breakpoints == 0) {
+            AI_SendResponse("{\"status\":\"error\",\"msg\":\"No breakpoints set\"}");
+            return;
+        }
+        if (ai_until_active) until_stop();
+        travel_start(last_write ? AI_TRAVEL_LAST_WRITE : AI_TRAVEL_REVERSE_CONTINUE, addr);
+        /* Response sent once the history is searched */
+    }
+    else if (strcmp(cmd_type, "rewind") == 0 || strcmp(cmd_type, "reverse_step") == 0) {
+        int target = Atari800_nframes - json_get_int(cmd, "frames", 1);
+        int keyframe;
+
+        if (AI_REWIND_Depth() == 0) {
+            AI_SendResponse("{\"status\":\"error\",\"msg\":\"Rewind is off, see rewind_config\"}");
+            return;
+        }
+        if (ai_until_active) until_stop();
+        keyframe = AI_REWIND_Restore(target);
+        if (keyframe < 0) {
+            snprintf(ai_response, sizeof(ai_response),
+                "{\"status\":\"error\",\"msg\":\"Frame %d is not in the rewind history\","
+                "\"oldest\":%d}", target, AI_REWIND_Oldest());
+            AI_SendResponse(ai_response);
+            return;
+        }
+        if (target == keyframe) {
+            stop_streaming();
+            ai_rewind_keyframe = keyframe;
+            rewind_reply();
+            return;
+        }
+        /* Re-simulate from the keyframe with the recorded input */
+        run_start(target - keyframe, TRUE);
+        ai_rewind_keyframe = keyframe;
+        /* Response sent after the frames are replayed */
+    }
     else if (strcmp(cmd_type, "step") == 0) {
         ai_steps_to_run = json_get_int(cmd, "instructions", 1);
         ai_paused = 0;
         /* Response sent after steps complete */
     }
     else if (strcmp(cmd_type, "pause") == 0) {
+        stop_streaming();
+        if (ai_until_active) until_stop();
         ai_paused = 1;
         AI_SendResponse("{\"status\":\"ok\"}");
     }
-    else if (strcmp(cmd_type, "reset") == 0) {
-        Atari800_Coldstart();
-        AI_SendResponse("{\"status\":\"ok\"}");
+    else if (strcmp(cmd_type, "reset") == 0) {
+        int boot_frames = json_get_int(cmd, "boot_frames", 0);
+        if (boot_frames > 0) {
+            boot_start(NULL, boot_frames);
+            /* Response sent after the boot, unless it was cached */
+        } else {
+            Atari800_Coldstart();
+            AI_SendResponse("{\"status\":\"ok\"}");
+        }
+    }
+    else if (strcmp(cmd_type, "boot_cache") == 0) {
+        int entries = json_get_int(cmd, "entries", AI_BOOTCACHE_MaxEntries());
+
+        if (entries != AI_BOOTCACHE_MaxEntries() && !AI_BOOTCACHE_Configure(entries)) {
+            AI_SendResponse("{\"status\":\"error\",\"msg\":\"entries must be 0 to 1024\"}");
+            return;
+        }
+        if (json_get_bool(cmd, "clear", FALSE))
+            AI_BOOTCACHE_Clear();
+        snprintf(ai_response, sizeof(ai_response),
+            "{\"status\":\"ok\",\"entries\":%d,\"max\":%d,\"bytes\":%lu,"
+            "\"hits\":%d,\"misses\":%d}",
+            AI_BOOTCACHE_Entries(), AI_BOOTCACHE_MaxEntries(),
+            (unsigned long)AI_BOOTCACHE_Bytes(), AI_BOOTCACHE_Hits(), AI_BOOTCACHE_Misses());
+        AI_SendResponse(ai_response);
+    }
+    else if (strcmp(cmd_type, "quick_boot") == 0) {
+        Atari800_quick_boot = json_get_bool(cmd, "enable", Atari800_quick_boot);
+        if (json_get_bool(cmd, "clear", FALSE))
+            Atari800_QuickBootClear();
+        snprintf(ai_response, sizeof(ai_response),
+            "{\"status\":\"ok\",\"enabled\":%s,\"entries\":%d}",
+            Atari800_quick_boot ? "true" : "false", Atari800_QuickBootEntries());
+        AI_SendResponse(ai_response);
+    }
+    else if (strcmp(cmd_type, "batch") == 0) {
+        const char *list = json_find(cmd, "commands");
+        if (ai_batch_active && ai_batch_client == ai_cur) {
+            AI_SendResponse("{\"status\":\"error\",\"msg\":\"Nested batch not supported\"}");
+        } else if (ai_batch_active) {
+            AI_SendResponse("{\"status\":\"error\",\"msg\":\"Another client's batch is in progress\"}");
+        } else if (!list || *list != '[') {
+            AI_SendResponse("{\"status\":\"error\",\"msg\":\"batch needs a commands array\"}");
+        } else {
+            /* Keep a copy: cmd is reused for later commands if the batch suspends */
+            snprintf(ai_batch_cmds, sizeof(ai_batch_cmds), "%s", list + 1);
+            ai_batch_pos = 0;
+            ai_batch_count = 0;
+            ai_batch_errors = 0;
+            ai_batch_failed = -1;
+            ai_batch_out_len = 0;
+            ai_batch_stop_on_error = json_get_bool(cmd, "stop_on_error", 0);
+            ai_batch_active = 1;
+            ai_batch_client = ai_cur;
+            batch_continue();
+        }
+    }
+    else if (strcmp(cmd_type, "protocol") == 0) {
+        char mode[16] = "";
+        json_get_string(cmd, "mode", mode, sizeof(mode));
+        if (ai_batch_active && ai_batch_client == ai_cur) {
+            AI_SendResponse("{\"status\":\"error\",\"msg\":\"protocol cannot be changed inside a batch\"}");
+        } else if (strcmp(mode, "binary") == 0) {
+            char compress[16] = "none";
+            json_get_string(cmd, "compress", compress, sizeof(compress));
+            if (strcmp(compress, "lz4") != 0 && strcmp(compress, "none") != 0) {
+                AI_SendResponse("{\"status\":\"error\",\"msg\":\"Unknown compression\"}");
+                return;
+            }
+            /* Acknowledge in JSON, then switch framing */
+            snprintf(ai_response, sizeof(ai_response),
+                     "{\"status\":\"ok\",\"mode\":\"binary\",\"version\":1,\"compress\":\"%s\"}", compress);
+            AI_SendResponse(ai_response);
+            ai_cur->protocol = AI_PROTOCOL_BINARY;
+            ai_cur->compress = compress[0] == 'l';
+        } else if (strcmp(mode, "json") == 0) {
+            AI_SendResponse("{\"status\":\"ok\",\"mode\":\"json\",\"version\":1}");
+        } else {
+            AI_SendResponse("{\"status\":\"error\",\"msg\":\"Unknown protocol mode\"}");
+        }
+    }
+    else if (strcmp(cmd_type, "role") == 0) {
+        char role[16] = "";
+        json_get_string(cmd, "role", role, sizeof(role));
+        if (strcmp(role, "observer") == 0) {
+            ai_cur->observer = TRUE;
+            if (ai_controller == ai_cur) {
+                ai_controller = NULL;
+                ai_controller_exclusive = 0;
+            }
+        } else if (strcmp(role, "controller") == 0) {
+            if (ai_controller != NULL && ai_controller != ai_cur && ai_controller_exclusive) {
+                AI_SendResponse("{\"status\":\"error\",\"msg\":\"Another client has exclusive control\"}");
+                return;
+            }
+            ai_cur->observer = FALSE;
+            ai_controller = ai_cur;
+            ai_controller_exclusive = json_get_bool(cmd, "exclusive", 0);
+        } else if (role[0]) {
+            AI_SendResponse("{\"status\":\"error\",\"msg\":\"Unknown role\"}");
+            return;
+        }
+        snprintf(ai_response, sizeof(ai_response),
+            "{\"status\":\"ok\",\"role\":\"%s\",\"exclusive\":%s,\"clients\":%d}",
+            client_role(ai_cur),
+            ai_controller == ai_cur && ai_controller_exclusive ? "true" : "false",
+            count_clients());
+        AI_SendResponse(ai_response);
+    }
+    else if (strcmp(cmd_type, "subscribe") == 0) {
+        char mode[16] = "observe";
+        char screen[16] = "none";
+        char audio[16] = "none";
+        int addrs[AI_SUB_MAX_ADDRS];
+        int every = json_get_int(cmd, "every", 1);
+        int rate = json_get_int(cmd, "rate", 0);
+#ifdef SOUND
+        int quality = json_get_int(cmd, "quality", -1);
+#endif
+        int sub_mode, sub_screen, sub_audio, i, n;
+
+        json_get_string(cmd, "mode", mode, sizeof(mode));
+        json_get_string(cmd, "screen", screen, sizeof(screen));
+        json_get_string(cmd, "audio", audio, sizeof(audio));
+        if (strcmp(mode, "observe") == 0) sub_mode = AI_SUB_OBSERVE;
+        else if (strcmp(mode, "free") == 0) sub_mode = AI_SUB_FREE;
+        else if (strcmp(mode, "lockstep") == 0) sub_mode = AI_SUB_LOCKSTEP;
+        else sub_mode = -1;
+        if (strcmp(screen, "none") == 0) sub_screen = AI_SUB_SCREEN_NONE;
+        else if (strcmp(screen, "full") == 0) sub_screen = AI_SUB_SCREEN_FULL;
+        else if (strcmp(screen, "delta") == 0) sub_screen = AI_SUB_SCREEN_DELTA;
+        else sub_screen = -1;
+        if (strcmp(audio, "none") == 0) sub_audio = 0;
+        else if (strcmp(audio, "pcm") == 0) sub_audio = AI_SUB_AUDIO_PCM;
+        else if (strcmp(audio, "env") == 0) sub_audio = AI_SUB_AUDIO_ENV;
+        else if (strcmp(audio, "both") == 0) sub_audio = AI_SUB_AUDIO_PCM | AI_SUB_AUDIO_ENV;
+        else sub_audio = -1;
+
+        if (sub_mode < 0 || sub_screen < 0 || sub_audio < 0) {
+            AI_SendResponse("{\"status\":\"error\",\"msg\":\"Unknown subscribe mode, screen or audio\"}");
+            return;
+        }
+#ifdef SOUND
+        if ((sub_audio & AI_SUB_AUDIO_PCM) && !Sound_enabled) {
+#else
+        if (sub_audio & AI_SUB_AUDIO_PCM) {
+#endif
+            AI_SendResponse("{\"status\":\"error\",\"msg\":\"PCM audio needs sound output enabled\"}");
+            return;
+        }
+        if (rate != 0 && (rate < 1000 || rate > 65535)) {
+            AI_SendResponse("{\"status\":\"error\",\"msg\":\"Audio rate must be 1000 to 65535 Hz\"}");
+            return;
+        }
+#ifdef SOUND
+        if (quality < 0 || quality > RESAMPLE_QUALITY_MAX) quality = RESAMPLE_QUALITY_DEFAULT;
+#endif
+        if (sub_mode != AI_SUB_OBSERVE) {
+            /* Free-running and lockstep drive the machine */
+            const char *denied = ai_batch_active && ai_batch_client == ai_cur
+                ? "Streaming cannot start inside a batch" : take_control();
+            if (denied != NULL) {
+                snprintf(ai_response, sizeof(ai_response),
+                    "{\"status\":\"error\",\"msg\":\"%s\"}", denied);
+                AI_SendResponse(ai_response);
+                return;
+            }
+        }
+        if (every < 1) every = 1;
+        n = json_get_int_array(cmd, "addrs", addrs, AI_SUB_MAX_ADDRS);
+        for (i = 0; i < n; i++) ai_cur->sub_addrs[i] = (UWORD)addrs[i];
+        ai_cur->sub_naddrs = n;
+        ai_cur->sub_every = every;
+        ai_cur->sub_mode = sub_mode;
+        ai_cur->sub_screen = sub_screen;
+        ai_cur->sub_audio = sub_audio;
+        ai_cur->sub_debug = json_get_bool(cmd, "debug", FALSE);
+#ifdef SOUND
+        set_sub_rate(ai_cur, sub_audio & AI_SUB_AUDIO_PCM ? rate : 0, quality);
+        if (ai_cur->sub_resampler != NULL) rate = RESAMPLE_OutRate(ai_cur->sub_resampler);
+        else if (sub_audio & AI_SUB_AUDIO_PCM) rate = Sound_out.freq;
+        else rate = 0;
+#else
+        rate = 0;
+#endif
+        update_audio_observers();
+        ai_cur->sub_window = json_get_int(cmd, "window", sub_mode == AI_SUB_LOCKSTEP ? 1 : 0);
+        if (sub_mode == AI_SUB_LOCKSTEP && ai_cur->sub_window < 1) ai_cur->sub_window = 1;
+        ai_cur->sub_unacked = 0;
+        ai_cur->events_dropped = 0;
+        free(ai_cur->sub_prev_screen);
+        ai_cur->sub_prev_screen = NULL;  /* first record carries the full screen */
+
+        if (ai_stream_client == ai_cur || sub_mode != AI_SUB_OBSERVE) stop_streaming();
+        if (sub_mode != AI_SUB_OBSERVE) {
+            ai_stream_client = ai_cur;
+            ai_cur->sub_mode = sub_mode;
+            ai_frames_to_run = 0;
+            AI_timing = AI_frame_timing;
+            AI_unthrottled = FALSE;
+            if (ai_until_active) until_stop();
+            ai_run_client = NULL;
+            ai_paused = 0;
+        }
+        snprintf(ai_response, sizeof(ai_response),
+            "{\"status\":\"ok\",\"every\":%d,\"mode\":\"%s\",\"screen\":\"%s\","
+            "\"addrs\":%d,\"window\":%d,\"audio\":\"%s\",\"rate\":%d,\"debug\":%s}",
+            every, mode, screen, n, ai_cur->sub_window, audio, rate,
+            ai_cur->sub_debug ? "true" : "false");
+        AI_SendResponse(ai_response);
+    }
+    else if (strcmp(cmd_type, "unsubscribe") == 0) {
+        snprintf(ai_response, sizeof(ai_response),
+            "{\"status\":\"ok\",\"dropped\":%lu}", (unsigned long)ai_cur->events_dropped);
+        if (ai_stream_client == ai_cur) {
+            stop_streaming();
+            ai_paused = 1;
+        }
+        ai_cur->sub_every = 0;
+#ifdef SOUND
+        set_sub_rate(ai_cur, 0, 0);
+#endif
+        update_audio_observers();
+        AI_SendResponse(ai_response);
+    }
+    else if (strcmp(cmd_type, "ack") == 0) {
+        ack_records(ai_cur, json_get_int(cmd, "frame", -1));
+        snprintf(ai_response, sizeof(ai_response),
+            "{\"status\":\"ok\",\"unacked\":%d}", ai_cur->sub_unacked);
+        AI_SendResponse(ai_response);
+    }
+
+    /* === LOCKSTEP === */
+    else if (strcmp(cmd_type, "lockstep_join") == 0) {
+        int port = json_get_int(cmd, "port", -1);
+        const char *err = NULL;
+
+        if (port < 0 || port >= AI_LOCKSTEP_PORTS)
+            err = "port must be 0-3";
+        else if (ai_cur->observer)
+            err = "Observers cannot play";
+        else if (ai_controller != NULL && ai_controller != ai_cur && ai_controller_exclusive)
+            err = "Another client has exclusive control";
+        else if (ai_lockstep.player[port] != NULL && ai_lockstep.player[port] != ai_cur)
+            err = "Port already has a player";
+        else if (lockstep_port(ai_cur) >= 0 && lockstep_port(ai_cur) != port)
+            err = "Already playing on another port";
+        else if (ai_lockstep.expected == 0 && (!ai_paused || ai_frames_to_run > 0
+                 || ai_until_active || ai_stream_client != NULL))
+            err = "The machine is running";
+        else if (ai_lockstep.expected > 0 && lockstep_joined() == ai_lockstep.expected)
+            err = "The episode has started";
+        if (err != NULL) {
+            snprintf(ai_response, sizeof(ai_response),
+                "{\"status\":\"error\",\"msg\":\"%s\"}", err);
+            AI_SendResponse(ai_response);
+            return;
+        }
+        if (ai_lockstep.expected == 0) {
+            /* The first player sets the episode up */
+            char def[16] = "centre";
+            int addrs[AI_LOCKSTEP_MAX_ADDRS], i;
+            ai_lockstep.expected = json_get_int(cmd, "players", 2);
+            if (ai_lockstep.expected < 1) ai_lockstep.expected = 1;
+            if (ai_lockstep.expected > AI_LOCKSTEP_PORTS) ai_lockstep.expected = AI_LOCKSTEP_PORTS;
+            ai_lockstep.timeout_ms = json_get_int(cmd, "timeout_ms", 0);
+            json_get_string(cmd, "default", def, sizeof(def));
+            ai_lockstep.repeat = strcmp(def, "repeat") == 0;
+            ai_lockstep.frames = json_get_int(cmd, "frames", 1);
+            if (ai_lockstep.frames < 1) ai_lockstep.frames = 1;
+            ai_lockstep.naddrs = json_get_int_array(cmd, "addrs", addrs, AI_LOCKSTEP_MAX_ADDRS);
+            for (i = 0; i < ai_lockstep.naddrs; i++) ai_lockstep.addrs[i] = (UWORD)addrs[i];
+        }
+        ai_lockstep.player[port] = ai_cur;
+        ai_lockstep.stick[port] = INPUT_STICK_CENTRE;
+        ai_lockstep.fire[port] = 0;
+        snprintf(ai_response, sizeof(ai_response),
+            "{\"status\":\"ok\",\"port\":%d,\"joined\":%d,\"players\":%d,"
+            "\"timeout_ms\":%d,\"default\":\"%s\",\"frames\":%d}",
+            port, lockstep_joined(), ai_lockstep.expected, ai_lockstep.timeout_ms,
+            ai_lockstep.repeat ? "repeat" : "centre", ai_lockstep.frames);
+        AI_SendResponse(ai_response);
+        /* Everyone is here: the first step event shows where play starts */
+        if (lockstep_joined() == ai_lockstep.expected) lockstep_push();
+    }
+    else if (strcmp(cmd_type, "act") == 0) {
+        int port = lockstep_port(ai_cur);
+        int step = json_get_int(cmd, "step", -1);
+        char dir[16] = "";
+
+        if (port < 0) {
+            AI_SendResponse("{\"status\":\"error\",\"msg\":\"Not a lockstep player\"}");
+            return;
+        }
+        if (!ai_lockstep.waiting) {
+            AI_SendResponse("{\"status\":\"error\",\"msg\":\"The episode has not started\"}");
+            return;
+        }
+        if (step >= 0 && step != ai_lockstep.step) {
+            snprintf(ai_response, sizeof(ai_response),
+                "{\"status\":\"error\",\"msg\":\"Action for step %d, now at %d\"}",
+                step, ai_lockstep.step);
+            AI_SendResponse(ai_response);
+            return;
+        }
+        json_get_string(cmd, "direction", dir, sizeof(dir));
+        ai_lockstep.stick[port] = stick_direction(dir);
+        ai_lockstep.fire[port] = json_get_bool(cmd, "fire", 0);
+        ai_lockstep.acted[port] = TRUE;
+        snprintf(ai_response, sizeof(ai_response),
+            "{\"status\":\"ok\",\"step\":%d}", ai_lockstep.step);
+        AI_SendResponse(ai_response);
+        lockstep_check();
+    }
+    else if (strcmp(cmd_type, "lockstep_leave") == 0) {
+        int port = lockstep_port(ai_cur);
+        snprintf(ai_response, sizeof(ai_response),
+            "{\"status\":\"ok\",\"steps\":%d}", ai_lockstep.step);
+        AI_SendResponse(port >= 0 ? ai_response
+                        : "{\"status\":\"error\",\"msg\":\"Not a lockstep player\"}");
+        lockstep_leave(ai_cur);
     }
 
     /* === INPUT === */
@@ -256,6 +4475,43 @@ static void process_command(const char *cmd) {
         INPUT_key_shift = json_get_bool(cmd, "shift", 0);
         AI_SendResponse("{\"status\":\"ok\"}");
     }
+    else if (strcmp(cmd_type, "type") == 0) {
+        static char text[AI_BUFFER_SIZE];
+        int len = json_get_text(cmd, "text", text, sizeof(text));
+        int i, n = 0;
+
+        if (len < 0) {
+            AI_SendResponse("{\"status\":\"error\",\"msg\":\"text must be a string\"}");
+            return;
+        }
+        if (Atari800_machine_type == Atari800_MACHINE_5200) {
+            AI_SendResponse("{\"status\":\"error\",\"msg\":\"The 5200 has no keyboard\"}");
+            return;
+        }
+        if (len > ai_type.alloc) {
+            ai_type.alloc = len;
+            ai_type.keys = (SWORD *)Util_realloc(ai_type.keys, len * sizeof(SWORD));
+        }
+        for (i = 0; i < len; i++) {
+            int key = ascii_key((unsigned char)text[i]);
+            if (text[i] == '\r') continue;
+            if (key == AKEY_NONE) {
+                snprintf(ai_response, sizeof(ai_response),
+                    "{\"status\":\"error\",\"msg\":\"No key types character %d at %d\"}",
+                    (unsigned char)text[i], i);
+                AI_SendResponse(ai_response);
+                return;
+            }
+            ai_type.keys[n++] = (SWORD)key;
+        }
+        run_start(json_get_int(cmd, "max_frames", 600 + 8 * n),
+                  json_get_bool(cmd, "unthrottled", FALSE));
+        ai_type.n = n;
+        ai_type.pos = 0;
+        ai_type.held = ai_type.last = AKEY_NONE;
+        ai_type.run = TRUE;
+        /* Response sent once the keys are taken */
+    }
     else if (strcmp(cmd_type, "key_release") == 0) {
         INPUT_key_code = AKEY_NONE;
         INPUT_key_shift = 0;
@@ -264,36 +4520,32 @@ static void process_command(const char *cmd) {
     else if (strcmp(cmd_type, "joystick") == 0) {
         int port = json_get_int(cmd, "port", 0);
         char dir[16] = "";
-        json_get_string(cmd, "direction", dir, sizeof(dir));
         int fire = json_get_bool(cmd, "fire", 0);
+        json_get_string(cmd, "direction", dir, sizeof(dir));
 
-        int stick = INPUT_STICK_CENTRE;
-        if (strcmp(dir, "up") == 0) stick = INPUT_STICK_FORWARD;
-        else if (strcmp(dir, "down") == 0) stick = INPUT_STICK_BACK;
-        else if (strcmp(dir, "left") == 0) stick = INPUT_STICK_LEFT;
-        else if (strcmp(dir, "right") == 0) stick = INPUT_STICK_RIGHT;
-        else if (strcmp(dir, "ul") == 0) stick = INPUT_STICK_UL;
-        else if (strcmp(dir, "ur") == 0) stick = INPUT_STICK_UR;
-        else if (strcmp(dir, "ll") == 0) stick = INPUT_STICK_LL;
-        else if (strcmp(dir, "lr") == 0) stick = INPUT_STICK_LR;
-
-        if (port >= 0 && port < 4) {
-            /* Set joystick override - will be applied after INPUT_Frame */
-            /* Use -1 (no override) for center to allow keyboard input */
-            AI_joy_override[port] = (stick == INPUT_STICK_CENTRE) ? -1 : stick;
-            /* Set fire button override: 0 = pressed, -1 = no override (allows keyboard) */
-            AI_trig_override[port] = fire ? 0 : -1;
-        }
+        set_joystick(port, stick_direction(dir), fire);
         AI_SendResponse("{\"status\":\"ok\"}");
     }
     else if (strcmp(cmd_type, "paddle") == 0) {
         int port = json_get_int(cmd, "port", 0);
         int value = json_get_int(cmd, "value", 128);
-        if (port >= 0 && port < 8) {
-            POKEY_POT_input[port] = value;
+        if (port >= 0 && port < 8 && value <= 228) {
+            INPUT_pot_override[port] = value < 0 ? -1 : value;
         }
         AI_SendResponse("{\"status\":\"ok\"}");
     }
+    else if (strcmp(cmd_type, "input") == 0) {
+        AI_FrameInput in;
+        const char *err = frame_input_parse(cmd, &in);
+        if (err != NULL) {
+            snprintf(ai_response, sizeof(ai_response),
+                "{\"status\":\"error\",\"msg\":\"%s\"}", err);
+            AI_SendResponse(ai_response);
+            return;
+        }
+        frame_input_apply(&in);
+        AI_SendResponse("{\"status\":\"ok\"}");
+    }
     else if (strcmp(cmd_type, "consol") == 0) {
         INPUT_key_consol = INPUT_CONSOL_NONE;
         if (!json_get_bool(cmd, "start", 1)) INPUT_key_consol &= ~INPUT_CONSOL_START;
@@ -304,14 +4556,34 @@ static void process_command(const char *cmd) {
 
     /* === SCREEN === */
     else if (strcmp(cmd_type, "screenshot") == 0) {
+#ifdef SCREENSHOTS
+        int level = json_get_int(cmd, "level", -1);
+        if (json_get_bool(cmd, "inline", FALSE)) {
+            char format[8] = "";
+            const UBYTE *image;
+            int size, pos;
+            json_get_string(cmd, "format", format, sizeof(format));
+            if (strcmp(format, "png") != 0 && strcmp(format, "pcx") != 0)
+                strcpy(format, AI_SCREENSHOT_FORMAT);
+            size = save_screenshot(NULL, format, level, &image);
+            if (size == 0) {
+                snprintf(ai_response, sizeof(ai_response),
+                    "{\"status\":\"error\",\"msg\":\"Cannot encode %s screenshots\"}", format);
+                AI_SendResponse(ai_response);
+                return;
+            }
+            pos = snprintf(ai_response, sizeof(ai_response),
+                "{\"status\":\"ok\",\"format\":\"%s\",\"bytes\":%d,\"data\":\"", format, size);
+            pos += AI_Base64Encode(image, size, ai_response + pos, sizeof(ai_response) - pos);
+            snprintf(ai_response + pos, sizeof(ai_response) - pos, "\"}");
+            AI_SendResponse(ai_response);
+            return;
+        }
         json_get_string(cmd, "path", path, sizeof(path));
         if (!path[0]) {
             snprintf(path, sizeof(path), "/tmp/atari800_ai_%ld.png", (long)time(NULL));
         }
-        /* Debug: log screen dimensions */
-        Log_print("AI screenshot: path=%s vis=%d,%d-%d,%d", path,
-            Screen_visible_x1, Screen_visible_y1, Screen_visible_x2, Screen_visible_y2);
-        if (Screen_SaveScreenshot(path, 0)) {
+        if (save_screenshot(path, NULL, level, NULL)) {
             snprintf(ai_response, sizeof(ai_response),
                 "{\"status\":\"ok\",\"path\":\"%s\"}", path);
         } else {
@@ -320,18 +4592,81 @@ static void process_command(const char *cmd) {
                 Screen_visible_x1, Screen_visible_y1, Screen_visible_x2, Screen_visible_y2);
         }
         AI_SendResponse(ai_response);
+#else
+        AI_SendResponse("{\"status\":\"error\",\"msg\":\"Screenshots not compiled in\"}");
+#endif
     }
     else if (strcmp(cmd_type, "screen_ascii") == 0) {
         char ascii_data[2048];
-        screen_to_ascii(ascii_data, sizeof(ascii_data));
+        int pixels = json_get_bool(cmd, "pixels", FALSE);
+        int inverse = json_get_bool(cmd, "inverse", FALSE);
+        int text80 = !pixels && json_get_bool(cmd, "text80", TRUE);
+        /* An 80 column card's text first, unless text80 is false; graphics
+           screens get the luminance sketch instead */
+        if (!(text80 && screen_text80_reply(inverse))
+            && (pixels || !screen_text_reply(inverse))) {
+            screen_to_ascii(ascii_data, sizeof(ascii_data));
+            snprintf(ai_response, sizeof(ai_response),
+                "{\"status\":\"ok\",\"source\":\"pixels\",\"width\":40,\"height\":24,\"data\":%s}", ascii_data);
+            AI_SendResponse(ai_response);
+        }
+    }
+    else if (strcmp(cmd_type, "screen_delta") == 0) {
+        static char b64_buf[AI_SCREEN_DELTA_MAX * 4 / 3 + 8];
+        int base = json_get_int(cmd, "base", -1);
+        const UBYTE *pixels;
+        int kind;
+        int len = screen_delta_for(ai_cur, base, &pixels, &kind);
+        AI_Base64Encode(pixels, len, b64_buf, sizeof(b64_buf));
+        snprintf(ai_response, sizeof(ai_response),
+            "{\"status\":\"ok\",\"frame\":%d,\"base\":%d,\"full\":%s,"
+            "\"width\":%d,\"height\":%d,\"bytes\":%d,\"data\":\"%s\"}",
+            Atari800_nframes, kind == AI_SUB_SCREEN_FULL ? -1 : base,
+            kind == AI_SUB_SCREEN_FULL ? "true" : "false",
+            Screen_WIDTH, Screen_HEIGHT, len, b64_buf);
+        AI_SendResponse(ai_response);
+    }
+    else if (strcmp(cmd_type, "observation") == 0) {
+        static UBYTE obs[Screen_WIDTH * Screen_HEIGHT];
+        static char b64_buf[Screen_WIDTH * Screen_HEIGHT * 4 / 3 + 8];
+        char format[16] = "gray";
+        int crop[4] = {0, 0, 0, 0};
+        int width = json_get_int(cmd, "width", 84);
+        int height = json_get_int(cmd, "height", 84);
+        int len;
+
+        json_get_string(cmd, "format", format, sizeof(format));
+        json_get_int_array(cmd, "crop", crop, 4);
+        len = AI_OBS_Render(obs, width, height,
+                            strcmp(format, "index") == 0 ? AI_OBS_INDEX
+                            : strcmp(format, "gray") == 0 ? AI_OBS_GRAY : -1,
+                            crop[0], crop[1], crop[2], crop[3]);
+        if (len == 0) {
+            AI_SendResponse("{\"status\":\"error\",\"msg\":\"Invalid observation shape, format or crop\"}");
+        } else {
+            AI_Base64Encode(obs, len, b64_buf, sizeof(b64_buf));
+            snprintf(ai_response, sizeof(ai_response),
+                "{\"status\":\"ok\",\"frame\":%d,\"width\":%d,\"height\":%d,"
+                "\"format\":\"%s\",\"data\":\"%s\"}",
+                Atari800_nframes, width, height, format, b64_buf);
+            AI_SendResponse(ai_response);
+        }
+    }
+    else if (strcmp(cmd_type, "hash") == 0) {
+        /* Hex strings: JSON numbers lose the low bits of 64-bit values */
+        uint64_t screen = AI_HASH_Screen();
+        uint64_t state = AI_HASH_State();
         snprintf(ai_response, sizeof(ai_response),
-            "{\"status\":\"ok\",\"width\":40,\"height\":24,\"data\":%s}", ascii_data);
+            "{\"status\":\"ok\",\"frame\":%d,\"screen\":\"%08lx%08lx\",\"state\":\"%08lx%08lx\"}",
+            Atari800_nframes,
+            (unsigned long)(screen >> 32), (unsigned long)(screen & 0xffffffff),
+            (unsigned long)(state >> 32), (unsigned long)(state & 0xffffffff));
         AI_SendResponse(ai_response);
     }
     else if (strcmp(cmd_type, "screen_raw") == 0) {
         /* Base64 encode screen buffer */
         static char b64_buf[Screen_WIDTH * Screen_HEIGHT * 2];
-        base64_encode((UBYTE*)Screen_atari, Screen_WIDTH * Screen_HEIGHT,
+        AI_Base64Encode((UBYTE*)Screen_atari, Screen_WIDTH * Screen_HEIGHT,
                       b64_buf, sizeof(b64_buf));
         snprintf(ai_response, sizeof(ai_response),
             "{\"status\":\"ok\",\"width\":%d,\"height\":%d,\"data\":\"%s\"}",
@@ -343,39 +4678,300 @@ static void process_command(const char *cmd) {
     else if (strcmp(cmd_type, "peek") == 0) {
         int addr = json_get_int(cmd, "addr", 0);
         int len = json_get_int(cmd, "len", 1);
+        JSON_Writer w;
+        int i;
         if (len > 256) len = 256;  /* Limit */
+        if (len < 0) len = 0;
 
-        int pos = snprintf(ai_response, sizeof(ai_response),
-            "{\"status\":\"ok\",\"addr\":%d,\"data\":[", addr);
-        for (int i = 0; i < len && pos < sizeof(ai_response) - 20; i++) {
-            pos += snprintf(ai_response + pos, sizeof(ai_response) - pos,
-                "%s%d", i ? "," : "", MEMORY_SafeGetByte((UWORD)(addr + i)));
-        }
-        snprintf(ai_response + pos, sizeof(ai_response) - pos, "]}");
+        for (i = 0; i < len; i++)
+            ai_peek_buf[i] = MEMORY_SafeGetByte((UWORD)(addr + i));
+        jw_start(&w, ai_response, sizeof(ai_response));
+        jw_raw(&w, "{\"status\":\"ok\"");
+        jw_field(&w, "addr", addr);
+        jw_key(&w, "data");
+        jw_bytes(&w, ai_peek_buf, len);
+        jw_char(&w, '}');
         AI_SendResponse(ai_response);
     }
     else if (strcmp(cmd_type, "poke") == 0) {
         int addr = json_get_int(cmd, "addr", 0);
-        /* Parse data array - simple extraction */
-        const char *data = strstr(cmd, "\"data\":");
-        if (data) {
-            data = strchr(data, '[');
-            if (data) {
-                data++;
-                while (*data && *data != ']') {
-                    while (*data == ' ' || *data == ',') data++;
-                    if (*data >= '0' && *data <= '9') {
-                        int val = atoi(data);
-                        MEMORY_mem[(UWORD)addr++] = (UBYTE)val;  /* Direct write - bypasses attribute check */
-                        while (*data >= '0' && *data <= '9') data++;
-                    } else {
-                        break;
-                    }
+        const char *data = json_find(cmd, "data");
+        int i;
+        if (data && *data == '"') {
+            /* A base64 string, for bulk writes */
+            const char *end = strchr(++data, '"');
+            int n = end ? AI_Base64Decode(data, (int)(end - data), ai_peek_buf, sizeof(ai_peek_buf)) : -1;
+            if (n < 0) {
+                AI_SendResponse("{\"status\":\"error\",\"msg\":\"data must be an array or base64\"}");
+                return;
+            }
+            for (i = 0; i < n; i++)
+                MEMORY_mem[(UWORD)addr++] = ai_peek_buf[i];
+        }
+        else if (data && *data++ == '[') {
+            while (*data && *data != ']') {
+                while (JSON_SPACE(*data) || *data == ',') data++;
+                if (*data >= '0' && *data <= '9') {
+                    int val = atoi(data);
+                    MEMORY_mem[(UWORD)addr++] = (UBYTE)val;  /* Direct write - bypasses attribute check */
+                    while (*data >= '0' && *data <= '9') data++;
+                } else {
+                    break;
                 }
             }
         }
         AI_SendResponse("{\"status\":\"ok\"}");
     }
+    else if (strcmp(cmd_type, "peek_multi") == 0) {
+        static int ranges[2 * AI_PEEK_MAX_RANGES];
+        int n = json_get_int_pairs(cmd, "ranges", ranges, AI_PEEK_MAX_RANGES);
+        const char *err;
+        int bytes, pos;
+
+        if (n < 0) {
+            AI_SendResponse("{\"status\":\"error\",\"msg\":\"ranges must be up to 256 [addr, len] pairs\"}");
+            return;
+        }
+        if ((err = peek_ranges(ranges, n, &bytes)) != NULL) {
+            snprintf(ai_response, sizeof(ai_response), "{\"status\":\"error\",\"msg\":\"%s\"}", err);
+            AI_SendResponse(ai_response);
+            return;
+        }
+        pos = snprintf(ai_response, sizeof(ai_response),
+            "{\"status\":\"ok\",\"bytes\":%d,\"data\":\"", bytes);
+        pos += AI_Base64Encode(ai_peek_buf, bytes, ai_response + pos, sizeof(ai_response) - pos);
+        snprintf(ai_response + pos, sizeof(ai_response) - pos, "\"}");
+        AI_SendResponse(ai_response);
+    }
+    else if (strcmp(cmd_type, "peek_bank") == 0) {
+        static const char * const kinds[] = {"xe", "axlon", "mosaic"};
+        char kind_name[16] = "xe";
+        int bank = json_get_int(cmd, "bank", 0);
+        int addr = json_get_int(cmd, "addr", 0);
+        int len = json_get_int(cmd, "len", 1);
+        int kind, pos;
+
+        json_get_string(cmd, "kind", kind_name, sizeof(kind_name));
+        for (kind = 0; kind < 3 && strcmp(kind_name, kinds[kind]) != 0; kind++)
+            ;
+        if (kind == 3 || !MEMORY_ReadBank(kind, bank, addr, ai_peek_buf, len)) {
+            AI_SendResponse("{\"status\":\"error\",\"msg\":\"No such bank, or the range does not fit in it\"}");
+            return;
+        }
+        pos = snprintf(ai_response, sizeof(ai_response),
+            "{\"status\":\"ok\",\"kind\":\"%s\",\"bank\":%d,\"addr\":%d,\"bytes\":%d,\"data\":\"",
+            kinds[kind], bank, addr, len);
+        pos += AI_Base64Encode(ai_peek_buf, len, ai_response + pos, sizeof(ai_response) - pos);
+        snprintf(ai_response + pos, sizeof(ai_response) - pos, "\"}");
+        AI_SendResponse(ai_response);
+    }
+    else if (strcmp(cmd_type, "disasm") == 0) {
+        int addr = json_get_int(cmd, "addr", CPU_regPC);
+        int end = json_get_int(cmd, "end", -1);
+        int count = json_get_int(cmd, "count", end < 0 ? 24 : 0x10000);
+        int n, next, pos;
+
+        if (addr < 0 || addr > 0xffff) {
+            AI_SendResponse("{\"status\":\"error\",\"msg\":\"addr must be 0-65535\"}");
+            return;
+        }
+        pos = snprintf(ai_response, sizeof(ai_response), "{\"status\":\"ok\",\"insns\":[");
+        pos += disasm_json(ai_response + pos, sizeof(ai_response) - pos - 64,
+                           addr, end < 0 ? 0xffff : end, count, &n, &next);
+        snprintf(ai_response + pos, sizeof(ai_response) - pos, "],\"count\":%d,\"next\":%d}", n, next);
+        AI_SendResponse(ai_response);
+    }
+    else if (strcmp(cmd_type, "monitor") == 0) {
+        static char script[16384];
+        static char output[AI_MAX_RESPONSE / 4];
+        static MONITOR_batch_command commands[AI_MONITOR_MAX_COMMANDS];
+        static const char * const endings[] = { "done", "resumed", "quit" };
+        JSON_Writer w;
+        FILE *out;
+        const char *line = script;
+        int n, i, l = 0, result;
+        long start = 0, len;
+
+        if (json_get_lines(cmd, "commands", script, sizeof(script)) < 0) {
+            AI_SendResponse("{\"status\":\"error\",\"msg\":\"commands must be a list of monitor command lines\"}");
+            return;
+        }
+#ifdef HAVE_FMEMOPEN
+        out = fmemopen(output, sizeof(output), "w");
+#else
+        out = tmpfile();
+#endif
+        if (out == NULL) {
+            AI_SendResponse("{\"status\":\"error\",\"msg\":\"Cannot capture the monitor's output\"}");
+            return;
+        }
+        n = MONITOR_Batch(script, out, commands, AI_MONITOR_MAX_COMMANDS, &result);
+        fflush(out);
+        len = ftell(out);
+        if (len > (long)sizeof(output)) len = sizeof(output);
+#ifndef HAVE_FMEMOPEN
+        rewind(out);
+        len = (long)fread(output, 1, len, out);
+#endif
+        fclose(out);
+        if (n > AI_MONITOR_MAX_COMMANDS) n = AI_MONITOR_MAX_COMMANDS;
+
+        jw_start(&w, ai_response, sizeof(ai_response) - 128);
+        jw_raw(&w, "{\"status\":\"ok\",\"results\":[");
+        for (i = 0; i < n; i++) {
+            long end = commands[i].end < len ? commands[i].end : len;
+            /* The command's text: line commands[i].line of the script */
+            for (; l < commands[i].line; l++)
+                line = strchr(line, '\n') + 1;
+            if (i) jw_char(&w, ',');
+            jw_raw(&w, "{\"line\":");
+            jw_int(&w, commands[i].line);
+            jw_raw(&w, ",\"command\":");
+            jw_text(&w, line, (int)strcspn(line, "\n"));
+            jw_raw(&w, ",\"output\":");
+            jw_text(&w, output + start, (int)(end - start));
+            jw_char(&w, '}');
+            start = end;
+        }
+        jw_char(&w, ']');
+        jw_field(&w, "count", n);
+        jw_raw(&w, ",\"ended\":\"");
+        jw_raw(&w, endings[result]);
+        jw_raw(&w, "\"");
+        if (w.pos >= w.size - 1) {
+            AI_SendResponse("{\"status\":\"error\",\"msg\":\"The output does not fit in a reply\"}");
+            return;
+        }
+        jw_char(&w, '}');
+        AI_SendResponse(ai_response);
+    }
+    else if (strcmp(cmd_type, "search_start") == 0 || strcmp(cmd_type, "search") == 0) {
+        char name[16] = "";
+        int value = json_get_int(cmd, "value", -1);
+        /* search_start with a value keeps the bytes equal to it */
+        int narrow = strcmp(cmd_type, "search") == 0 || value >= 0;
+        int op = AI_SEARCH_EQUAL;
+        double start = Util_time();
+        long count = 0;
+
+        if (strcmp(cmd_type, "search_start") == 0) {
+            int space;
+            strcpy(name, "cpu");
+            json_get_string(cmd, "space", name, sizeof(name));
+            for (space = 0; ai_search_spaces[space] != NULL && strcmp(name, ai_search_spaces[space]) != 0; space++)
+                ;
+            if (ai_search_spaces[space] == NULL || !AI_SEARCH_Start(&ai_search, space)) {
+                AI_SendResponse("{\"status\":\"error\",\"msg\":\"space must be cpu, or xe, axlon or mosaic RAM the machine has\"}");
+                return;
+            }
+            count = ai_search.count;
+        }
+        else {
+            json_get_string(cmd, "op", name, sizeof(name));
+            for (op = 0; ai_search_ops[op] != NULL && strcmp(name, ai_search_ops[op]) != 0; op++)
+                ;
+            if (ai_search_ops[op] == NULL) {
+                AI_SendResponse("{\"status\":\"error\",\"msg\":\"Unknown search op\"}");
+                return;
+            }
+        }
+        if (narrow && op <= AI_SEARCH_GREATER && (value < 0 || value > 255)) {
+            AI_SendResponse("{\"status\":\"error\",\"msg\":\"value must be 0-255\"}");
+            return;
+        }
+        if (narrow) {
+            count = AI_SEARCH_Narrow(&ai_search, op, value);
+            if (count < 0) {
+                AI_SendResponse("{\"status\":\"error\",\"msg\":\"No search started, or its memory is gone\"}");
+                return;
+            }
+        }
+        snprintf(ai_response, sizeof(ai_response),
+            "{\"status\":\"ok\",\"space\":\"%s\",\"count\":%ld,\"us\":%.1f}",
+            ai_search_spaces[ai_search.space], count, (Util_time() - start) * 1e6);
+        AI_SendResponse(ai_response);
+    }
+    else if (strcmp(cmd_type, "search_list") == 0) {
+        static ULONG offsets[AI_SEARCH_LIST_MAX];
+        int first = json_get_int(cmd, "first", 0);
+        int limit = json_get_int(cmd, "limit", 256);
+        ULONG i, n;
+        int pos;
+
+        if (ai_search.space < 0) {
+            AI_SendResponse("{\"status\":\"error\",\"msg\":\"No search started\"}");
+            return;
+        }
+        if (first < 0) first = 0;
+        if (limit < 0) limit = 0;
+        if (limit > AI_SEARCH_LIST_MAX) limit = AI_SEARCH_LIST_MAX;
+        n = AI_SEARCH_List(&ai_search, first, offsets, limit);
+        pos = snprintf(ai_response, sizeof(ai_response),
+            "{\"status\":\"ok\",\"space\":\"%s\",\"count\":%u,\"first\":%d,\"matches\":[",
+            ai_search_spaces[ai_search.space], ai_search.count, first);
+        /* Banked spaces give each match as [bank, offset in the bank] */
+        for (i = 0; i < n; i++) {
+            if (ai_search.bank_size == 0)
+                pos += snprintf(ai_response + pos, sizeof(ai_response) - pos, "%s%u",
+                    i ? "," : "", offsets[i]);
+            else
+                pos += snprintf(ai_response + pos, sizeof(ai_response) - pos, "%s[%u,%u]",
+                    i ? "," : "", offsets[i] / ai_search.bank_size, offsets[i] % ai_search.bank_size);
+        }
+        snprintf(ai_response + pos, sizeof(ai_response) - pos, "]}");
+        AI_SendResponse(ai_response);
+    }
+    else if (strcmp(cmd_type, "discover_start") == 0) {
+        int frames = json_get_int(cmd, "frames", AI_DISCOVER_DEFAULT_FRAMES);
+        if (!AI_DISCOVER_Start(frames)) {
+            AI_SendResponse("{\"status\":\"error\",\"msg\":\"frames must be 2-4096\"}");
+            return;
+        }
+        /* The frame so far is the first to compare with */
+        AI_DISCOVER_Frame();
+        snprintf(ai_response, sizeof(ai_response),
+            "{\"status\":\"ok\",\"frames\":%d,\"bytes\":%ld}", frames, (long)frames << 16);
+        AI_SendResponse(ai_response);
+    }
+    else if (strcmp(cmd_type, "discover_stop") == 0) {
+        AI_DISCOVER_Stop();
+        AI_SendResponse("{\"status\":\"ok\"}");
+    }
+    else if (strcmp(cmd_type, "discover_status") == 0) {
+        int first, last;
+        int recorded = AI_DISCOVER_Recorded(&first, &last);
+        snprintf(ai_response, sizeof(ai_response),
+            "{\"status\":\"ok\",\"frames\":%d,\"first\":%d,\"last\":%d}", recorded, first, last);
+        AI_SendResponse(ai_response);
+    }
+    else if (strcmp(cmd_type, "discover") == 0) {
+        static int events[AI_DISCOVER_MAX_FRAMES];
+        static AI_DISCOVER_Result results[AI_DISCOVER_MAX_RESULTS];
+        int nevents = json_get_int_array(cmd, "events", events, AI_DISCOVER_MAX_FRAMES);
+        int window = json_get_int(cmd, "window", 0);
+        int top = json_get_int(cmd, "top", 16);
+        double start = Util_time();
+        int frames, event_frames, n, pos, i;
+
+        if (top < 1) top = 1;
+        if (top > AI_DISCOVER_MAX_RESULTS) top = AI_DISCOVER_MAX_RESULTS;
+        if (window < 0) window = 0;
+        n = AI_DISCOVER_Rank(events, nevents, window, results, top, &frames, &event_frames);
+        if (n < 0) {
+            AI_SendResponse("{\"status\":\"error\",\"msg\":\"Fewer than two frames recorded since discover_start\"}");
+            return;
+        }
+        pos = snprintf(ai_response, sizeof(ai_response),
+            "{\"status\":\"ok\",\"frames\":%d,\"event_frames\":%d,\"us\":%.0f,\"results\":[",
+            frames, event_frames, (Util_time() - start) * 1e6);
+        for (i = 0; i < n; i++)
+            pos += snprintf(ai_response + pos, sizeof(ai_response) - pos,
+                "%s{\"addr\":%d,\"score\":%.4f,\"at_events\":%d,\"elsewhere\":%d,\"up\":%d,\"down\":%d}",
+                i ? "," : "", results[i].addr, results[i].score, results[i].at_events,
+                results[i].elsewhere, results[i].up, results[i].down);
+        snprintf(ai_response + pos, sizeof(ai_response) - pos, "]}");
+        AI_SendResponse(ai_response);
+    }
     else if (strcmp(cmd_type, "dump") == 0) {
         int start = json_get_int(cmd, "start", 0);
         int end = json_get_int(cmd, "end", 0xFFFF);
@@ -383,7 +4979,8 @@ static void process_command(const char *cmd) {
         if (path[0]) {
             FILE *f = fopen(path, "wb");
             if (f) {
-                for (int i = start; i <= end; i++) {
+                int i;
+                for (i = start; i <= end; i++) {
                     UBYTE b = MEMORY_SafeGetByte((UWORD)i);
                     fwrite(&b, 1, 1, f);
                 }
@@ -400,35 +4997,562 @@ static void process_command(const char *cmd) {
         }
         AI_SendResponse(ai_response);
     }
+    else if (strcmp(cmd_type, "watch") == 0) {
+        int addr = json_get_int(cmd, "addr", -1);
+        int len = json_get_int(cmd, "len", 1);
+        int enabled = json_get_bool(cmd, "enabled", TRUE);
+        int a;
+
+        if (json_get_bool(cmd, "clear", FALSE)) {
+            int a;
+            for (a = 0; a < 65536; a++) ai_write_watch_map[a] &= ~AI_WATCH_CHANGES;
+            ai_write_watches = 0;
+            ai_changes_start = ai_changes_count = 0;
+            ai_changes_dropped = 0;
+        }
+        else if (addr < 0 || len < 1 || addr + len > 0x10000) {
+            AI_SendResponse("{\"status\":\"error\",\"msg\":\"addr and len must lie within 0-65535\"}");
+            return;
+        }
+        else {
+            for (a = addr; a < addr + len; a++) {
+                if (enabled && !(ai_write_watch_map[a] & AI_WATCH_CHANGES)) {
+                    ai_write_watch_map[a] |= AI_WATCH_CHANGES;
+                    ai_write_watches++;
+                }
+                else if (!enabled && (ai_write_watch_map[a] & AI_WATCH_CHANGES)) {
+                    ai_write_watch_map[a] &= ~AI_WATCH_CHANGES;
+                    ai_write_watches--;
+                }
+            }
+        }
+        watch_update();
+        snprintf(ai_response, sizeof(ai_response),
+            "{\"status\":\"ok\",\"count\":%d}", ai_write_watches);
+        AI_SendResponse(ai_response);
+    }
+    else if (strcmp(cmd_type, "logpoint") == 0) {
+        int addr = json_get_int(cmd, "addr", -1);
+        int write = json_get_bool(cmd, "write", FALSE);
+        int enabled = json_get_bool(cmd, "enabled", TRUE);
+        int i = logpoint_find(addr, write);
+        char condition[256];
+
+        if (json_get_bool(cmd, "clear", FALSE)) {
+            int a;
+            for (a = 0; a < 65536; a++) {
+                ai_pc_watch_map[a] &= ~AI_WATCH_LOG;
+                ai_write_watch_map[a] &= ~AI_WATCH_LOG;
+            }
+            ai_nlogpoints = ai_pc_logpoints = ai_write_logpoints = 0;
+            ai_log_start = ai_log_count = 0;
+            ai_log_dropped = 0;
+        }
+        else if (addr < 0 || addr > 0xffff) {
+            AI_SendResponse("{\"status\":\"error\",\"msg\":\"addr must be 0-65535\"}");
+            return;
+        }
+        else if (enabled) {
+            AI_Logpoint lp;
+            AI_BreakCond bc;
+            const char *error = NULL;
+
+            lp.addr = addr;
+            lp.write = write;
+            lp.log = json_get_bool(cmd, "log", TRUE);
+            lp.peek = json_get_int(cmd, "peek", -1);
+            lp.count = i >= 0 ? ai_logpoints[i].count : 0;
+            lp.size = 0;
+            if (json_get_string(cmd, "condition", condition, sizeof(condition))) {
+                error = break_cond_parse(condition, &bc);
+                lp.size = bc.size;
+                memcpy(lp.table, bc.table, sizeof(lp.table));
+            }
+            if (error == NULL && (lp.peek < -1 || lp.peek > 0xffff))
+                error = "peek must be 0-65535";
+            if (error == NULL && i < 0 && ai_nlogpoints == AI_LOGPOINTS)
+                error = "Too many logpoints";
+            if (error != NULL) {
+                snprintf(ai_response, sizeof(ai_response),
+                    "{\"status\":\"error\",\"msg\":\"%s\"}", error);
+                AI_SendResponse(ai_response);
+                return;
+            }
+            if (i < 0) {
+                i = ai_nlogpoints++;
+                if (write) {
+                    ai_write_watch_map[addr] |= AI_WATCH_LOG;
+                    ai_write_logpoints++;
+                }
+                else {
+                    ai_pc_watch_map[addr] |= AI_WATCH_LOG;
+                    ai_pc_logpoints++;
+                }
+            }
+            ai_logpoints[i] = lp;
+        }
+        else if (i >= 0) {
+            if (write) {
+                ai_write_watch_map[addr] &= ~AI_WATCH_LOG;
+                ai_write_logpoints--;
+            }
+            else {
+                ai_pc_watch_map[addr] &= ~AI_WATCH_LOG;
+                ai_pc_logpoints--;
+            }
+            ai_logpoints[i] = ai_logpoints[--ai_nlogpoints];
+        }
+        /* The CPU only runs the checking loop while something is watched */
+        watch_update();
+        snprintf(ai_response, sizeof(ai_response),
+            "{\"status\":\"ok\",\"count\":%d}", ai_nlogpoints);
+        AI_SendResponse(ai_response);
+    }
+    else if (strcmp(cmd_type, "logpoint_read") == 0) {
+        int reset = json_get_bool(cmd, "reset", FALSE);
+        int pos = snprintf(ai_response, sizeof(ai_response),
+            "{\"status\":\"ok\",\"dropped\":%lu,\"counters\":[", ai_log_dropped);
+        int i;
+
+        for (i = 0; i < ai_nlogpoints; i++) {
+            AI_Logpoint *lp = &ai_logpoints[i];
+            pos += snprintf(ai_response + pos, sizeof(ai_response) - pos,
+                "%s[%d,%s,%lu]", i ? "," : "", lp->addr, lp->write ? "true" : "false", lp->count);
+            if (reset) lp->count = 0;
+        }
+        pos += snprintf(ai_response + pos, sizeof(ai_response) - pos, "],\"log\":[");
+        for (i = 0; i < ai_log_count; i++) {
+            const AI_LogRec *r = &ai_log[(ai_log_start + i) % AI_LOG_RING];
+            pos += snprintf(ai_response + pos, sizeof(ai_response) - pos,
+                "%s[%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d]", i ? "," : "",
+                r->addr, r->pc, r->frame, r->ypos, r->xpos, r->a, r->x, r->y, r->s, r->p, r->value);
+        }
+        snprintf(ai_response + pos, sizeof(ai_response) - pos, "]}");
+        ai_log_start = ai_log_count = 0;
+        ai_log_dropped = 0;
+        AI_SendResponse(ai_response);
+    }
+    else if (strcmp(cmd_type, "watch_read") == 0) {
+        int pos = snprintf(ai_response, sizeof(ai_response),
+            "{\"status\":\"ok\",\"dropped\":%lu,\"changes\":[", ai_changes_dropped);
+        int i;
+
+        for (i = 0; i < ai_changes_count; i++) {
+            const AI_WriteChange *ch = &ai_changes[(ai_changes_start + i) % AI_WATCH_RING];
+            pos += snprintf(ai_response + pos, sizeof(ai_response) - pos,
+                "%s[%d,%d,%d,%d,%d,%d]", i ? "," : "",
+                ch->addr, ch->old, ch->value, ch->frame, ch->ypos, ch->xpos);
+        }
+        snprintf(ai_response + pos, sizeof(ai_response) - pos, "]}");
+        ai_changes_start = ai_changes_count = 0;
+        ai_changes_dropped = 0;
+        AI_SendResponse(ai_response);
+    }
+
+    /* === Features === */
+    else if (strcmp(cmd_type, "features") == 0) {
+        const char *list = json_find(cmd, "set");
+
+        if (json_get_bool(cmd, "clear", FALSE))
+            AI_FEATURE_Set(&ai_features, NULL, 0);
+        else if (list != NULL) {
+            static AI_FEATURE_Def defs[AI_FEATURE_MAX + 1];
+            char item[256], kind[16];
+            const char *err = NULL;
+            int pos = 0, n = 0;
+
+            if (*list != '[')
+                err = "set must be an array of features";
+            while (err == NULL && n <= AI_FEATURE_MAX
+                   && json_next_object(list + 1, &pos, item, sizeof(item))) {
+                AI_FEATURE_Def *d = &defs[n++];
+                int addr = json_get_int(item, "addr", -1);
+                strcpy(kind, "byte");
+                json_get_string(item, "kind", kind, sizeof(kind));
+                for (d->kind = 0; d->kind < AI_FEATURE_KINDS
+                     && strcmp(kind, AI_FEATURE_kind_names[d->kind]) != 0; d->kind++)
+                    ;
+                if (addr < 0 || addr > 0xffff)
+                    err = "addr must be 0-65535";
+                d->addr = (UWORD)addr;
+                d->len = json_get_int(item, "len", 1);
+                d->mask = (UBYTE)json_get_int(item, "mask", 0xff);
+                d->delta = json_get_bool(item, "delta", FALSE);
+                d->scale = (float)json_get_double(item, "scale", 1.0);
+            }
+            if (err == NULL)
+                err = AI_FEATURE_Set(&ai_features, defs, n);
+            if (err != NULL) {
+                snprintf(ai_response, sizeof(ai_response),
+                    "{\"status\":\"error\",\"msg\":\"%s\"}", err);
+                AI_SendResponse(ai_response);
+                return;
+            }
+        }
+        else {
+            int pos = snprintf(ai_response, sizeof(ai_response),
+                "{\"status\":\"ok\",\"frame\":%d", Atari800_nframes);
+            pos += features_json(ai_response + pos, sizeof(ai_response) - pos);
+            snprintf(ai_response + pos, sizeof(ai_response) - pos, "}");
+            AI_SendResponse(ai_response);
+            return;
+        }
+        snprintf(ai_response, sizeof(ai_response),
+            "{\"status\":\"ok\",\"count\":%d}", ai_features.n);
+        AI_SendResponse(ai_response);
+    }
 
     /* === CPU === */
     else if (strcmp(cmd_type, "cpu") == 0) {
+        static const char flag_names[] = "nvbdizc";
+        static const UBYTE flag_bits[] = {CPU_N_FLAG, CPU_V_FLAG, CPU_B_FLAG,
+            CPU_D_FLAG, CPU_I_FLAG, CPU_Z_FLAG, CPU_C_FLAG};
+        JSON_Writer w;
+        char name[2] = "";
+        int i;
+
         CPU_GetStatus();
-        snprintf(ai_response, sizeof(ai_response),
-            "{\"status\":\"ok\",\"pc\":%d,\"a\":%d,\"x\":%d,\"y\":%d,"
-            "\"sp\":%d,\"p\":%d,"
-            "\"n\":%d,\"v\":%d,\"b\":%d,\"d\":%d,\"i\":%d,\"z\":%d,\"c\":%d}",
-            CPU_regPC, CPU_regA, CPU_regX, CPU_regY, CPU_regS, CPU_regP,
-            (CPU_regP & CPU_N_FLAG) ? 1 : 0,
-            (CPU_regP & CPU_V_FLAG) ? 1 : 0,
-            (CPU_regP & CPU_B_FLAG) ? 1 : 0,
-            (CPU_regP & CPU_D_FLAG) ? 1 : 0,
-            (CPU_regP & CPU_I_FLAG) ? 1 : 0,
-            (CPU_regP & CPU_Z_FLAG) ? 1 : 0,
-            (CPU_regP & CPU_C_FLAG) ? 1 : 0);
+        jw_start(&w, ai_response, sizeof(ai_response));
+        jw_raw(&w, "{\"status\":\"ok\"");
+        jw_field(&w, "pc", CPU_regPC);
+        jw_field(&w, "a", CPU_regA);
+        jw_field(&w, "x", CPU_regX);
+        jw_field(&w, "y", CPU_regY);
+        jw_field(&w, "sp", CPU_regS);
+        jw_field(&w, "p", CPU_regP);
+        for (i = 0; i < 7; i++) {
+            name[0] = flag_names[i];
+            jw_field(&w, name, (CPU_regP & flag_bits[i]) ? 1 : 0);
+        }
+        jw_char(&w, '}');
         AI_SendResponse(ai_response);
     }
     else if (strcmp(cmd_type, "cpu_set") == 0) {
         /* Only set values that are specified */
         const char *p;
-        if ((p = strstr(cmd, "\"pc\":"))) CPU_regPC = atoi(p + 5);
-        if ((p = strstr(cmd, "\"a\":"))) CPU_regA = atoi(p + 4);
-        if ((p = strstr(cmd, "\"x\":"))) CPU_regX = atoi(p + 4);
-        if ((p = strstr(cmd, "\"y\":"))) CPU_regY = atoi(p + 4);
-        if ((p = strstr(cmd, "\"sp\":"))) CPU_regS = atoi(p + 5);
+        if ((p = json_find(cmd, "pc"))) CPU_regPC = atoi(p);
+        if ((p = json_find(cmd, "a"))) CPU_regA = atoi(p);
+        if ((p = json_find(cmd, "x"))) CPU_regX = atoi(p);
+        if ((p = json_find(cmd, "y"))) CPU_regY = atoi(p);
+        if ((p = json_find(cmd, "sp"))) CPU_regS = atoi(p);
         CPU_PutStatus();
         AI_SendResponse("{\"status\":\"ok\"}");
     }
+    else if (strcmp(cmd_type, "breakpoint") == 0) {
+        int addr = json_get_int(cmd, "addr", -1);
+        int enabled = json_get_bool(cmd, "enabled", TRUE);
+        char condition[256];
+
+        if (json_get_bool(cmd, "clear", FALSE)) {
+            int a;
+            for (a = 0; a < 65536; a++) ai_pc_watch_map[a] &= ~AI_WATCH_BREAK;
+            ai_breakpoints = 0;
+            ai_nbreak_conds = 0;
+            enabled = FALSE;
+        }
+        else if (addr < 0 || addr > 0xffff) {
+            AI_SendResponse("{\"status\":\"error\",\"msg\":\"addr must be 0-65535\"}");
+            return;
+        }
+        else if (enabled) {
+            if (json_get_string(cmd, "condition", condition, sizeof(condition))) {
+                AI_BreakCond bc;
+                const char *error = break_cond_parse(condition, &bc);
+                int i = break_cond_find(addr);
+                if (error == NULL && i < 0 && ai_nbreak_conds == AI_BREAK_CONDS)
+                    error = "Too many breakpoints with a condition";
+                if (error != NULL) {
+                    snprintf(ai_response, sizeof(ai_response),
+                        "{\"status\":\"error\",\"msg\":\"%s\"}", error);
+                    AI_SendResponse(ai_response);
+                    return;
+                }
+                bc.addr = addr;
+                ai_break_conds[i >= 0 ? i : ai_nbreak_conds++] = bc;
+            }
+            else
+                break_cond_remove(addr);
+            if (!(ai_pc_watch_map[addr] & AI_WATCH_BREAK)) {
+                ai_pc_watch_map[addr] |= AI_WATCH_BREAK;
+                ai_breakpoints++;
+            }
+        }
+        else if (ai_pc_watch_map[addr] & AI_WATCH_BREAK) {
+            ai_pc_watch_map[addr] &= ~AI_WATCH_BREAK;
+            ai_breakpoints--;
+            break_cond_remove(addr);
+        }
+        /* The CPU only runs the checking loop while something is watched */
+        watch_update();
+        snprintf(ai_response, sizeof(ai_response),
+            "{\"status\":\"ok\",\"addr\":%d,\"enabled\":%s,\"count\":%d}",
+            addr, enabled ? "true" : "false", ai_breakpoints);
+        AI_SendResponse(ai_response);
+    }
+    else if (strcmp(cmd_type, "profile_start") == 0) {
+        int host = json_get_bool(cmd, "host_time", FALSE);
+        if (json_get_bool(cmd, "reset", TRUE) || ai_profile_start_frame < 0) {
+            memset(ai_profile_map, 0, sizeof(ai_profile_map));
+            memset(AI_profile_opcodes, 0, sizeof(AI_profile_opcodes));
+            memset(&ai_profile_cycle_sum, 0, sizeof(ai_profile_cycle_sum));
+            ai_profile_frames = 0;
+            ai_profile_host_used = FALSE;
+        }
+        if (host) {
+            if (ai_tick_seconds == 0.0)
+                calibrate_ticks();
+            if (ai_profile_overhead == 0.0)
+                ai_profile_overhead = profile_overhead();
+            ai_profile_host_used = TRUE;
+        }
+        AI_profile_host = host;
+        if (AI_profile == NULL) {
+            ai_profile_start_frame = Atari800_nframes;
+            /* The CPU switches to its tracing loop while profiling */
+            AI_profile = ai_profile_map;
+            CPU_UpdateGo();
+        }
+        AI_SendResponse("{\"status\":\"ok\"}");
+    }
+    else if (strcmp(cmd_type, "profile_stop") == 0) {
+        if (AI_profile != NULL) {
+            ai_profile_frames += Atari800_nframes - ai_profile_start_frame;
+            AI_profile = NULL;
+            AI_profile_host = FALSE;
+            CPU_UpdateGo();
+        }
+        AI_SendResponse("{\"status\":\"ok\"}");
+    }
+    else if (strcmp(cmd_type, "coverage_start") == 0) {
+        if (json_get_bool(cmd, "clear", TRUE))
+            memset(ai_coverage_map, 0, sizeof(ai_coverage_map));
+        if (AI_coverage == NULL) {
+            AI_coverage = ai_coverage_map;
+            CPU_UpdateGo();
+        }
+        AI_SendResponse("{\"status\":\"ok\"}");
+    }
+    else if (strcmp(cmd_type, "coverage_stop") == 0) {
+        if (AI_coverage != NULL) {
+            AI_coverage = NULL;
+            CPU_UpdateGo();
+        }
+        AI_SendResponse("{\"status\":\"ok\"}");
+    }
+    else if (strcmp(cmd_type, "coverage") == 0) {
+        UBYTE bitmap[AI_COVERAGE_BYTES];
+        int count = coverage_bitmap(bitmap, json_get_bool(cmd, "clear", FALSE));
+        int pos = snprintf(ai_response, sizeof(ai_response),
+            "{\"status\":\"ok\",\"active\":%s,\"count\":%d,\"bitmap\":\"",
+            AI_coverage != NULL ? "true" : "false", count);
+        pos += AI_Base64Encode(bitmap, sizeof(bitmap), ai_response + pos, sizeof(ai_response) - pos);
+        snprintf(ai_response + pos, sizeof(ai_response) - pos, "\"}");
+        AI_SendResponse(ai_response);
+    }
+    else if (strcmp(cmd_type, "heatmap_start") == 0) {
+        AI_HEATMAP_Start(json_get_bool(cmd, "clear", TRUE));
+        CPU_UpdateGo();
+        AI_SendResponse("{\"status\":\"ok\"}");
+    }
+    else if (strcmp(cmd_type, "heatmap_stop") == 0) {
+        if (AI_HEATMAP_counts != NULL) {
+            AI_HEATMAP_Stop();
+            CPU_UpdateGo();
+        }
+        AI_SendResponse("{\"status\":\"ok\"}");
+    }
+    else if (strcmp(cmd_type, "heatmap") == 0) {
+        static const char *const kinds[AI_HEATMAP_KINDS] = { "read", "write", "exec" };
+        static const char *const maps[3] = { "xe", "axlon", "mosaic" };
+        char kind_name[16] = "read", map_name[16] = "";
+        int kind, map = AI_HEATMAP_CPU, pos;
+        ULONG entries, start, length, i, len = 0, nonzero = 0;
+        double total = 0;
+        const ULONG *counts;
+        const UBYTE *varints = NULL;
+
+        json_get_string(cmd, "kind", kind_name, sizeof(kind_name));
+        json_get_string(cmd, "bank", map_name, sizeof(map_name));
+        for (kind = 0; kind < AI_HEATMAP_KINDS && strcmp(kind_name, kinds[kind]) != 0; kind++);
+        if (kind == AI_HEATMAP_KINDS) {
+            AI_SendResponse("{\"status\":\"error\",\"msg\":\"kind must be read, write or exec\"}");
+            return;
+        }
+        if (map_name[0]) {
+            for (map = 0; map < 3 && strcmp(map_name, maps[map]) != 0; map++);
+            if (map == 3) {
+                AI_SendResponse("{\"status\":\"error\",\"msg\":\"bank must be xe, axlon or mosaic\"}");
+                return;
+            }
+        }
+        start = (ULONG)json_get_int(cmd, "start", 0);
+        length = (ULONG)json_get_int(cmd, "length", AI_HEATMAP_JSON_MAX);
+        if (length > AI_HEATMAP_JSON_MAX) length = AI_HEATMAP_JSON_MAX;
+        counts = heatmap_range(map, kind, &entries, &start, &length);
+        for (i = 0; i < length; i++) {
+            total += counts[start + i];
+            if (counts[start + i] != 0) nonzero++;
+        }
+        if (length > 0) varints = heatmap_varints(counts + start, length, &len);
+        pos = snprintf(ai_response, sizeof(ai_response),
+            "{\"status\":\"ok\",\"active\":%s,\"kind\":\"%s\",\"bank\":\"%s\",\"entries\":%lu,"
+            "\"start\":%lu,\"length\":%lu,\"more\":%s,\"total\":%.0f,\"nonzero\":%lu,\"counts\":\"",
+            AI_HEATMAP_counts != NULL ? "true" : "false", kinds[kind], map_name,
+            (unsigned long)entries, (unsigned long)start, (unsigned long)length,
+            start + length < entries ? "true" : "false", total, (unsigned long)nonzero);
+        if (len > 0) pos += AI_Base64Encode(varints, (int)len, ai_response + pos, sizeof(ai_response) - pos);
+        snprintf(ai_response + pos, sizeof(ai_response) - pos, "\"}");
+        AI_SendResponse(ai_response);
+    }
+    else if (strcmp(cmd_type, "history_start") == 0) {
+        int entries = json_get_int(cmd, "entries", 1 << 20);
+        ULONG size = entries > 0 ? AI_HISTORY_Start((ULONG)entries, json_get_bool(cmd, "branches", FALSE)) : 0;
+        if (size == 0) {
+            AI_SendResponse("{\"status\":\"error\",\"msg\":\"entries must be 1-67108864\"}");
+            return;
+        }
+        CPU_UpdateGo();
+        snprintf(ai_response, sizeof(ai_response),
+            "{\"status\":\"ok\",\"entries\":%lu,\"bytes\":%lu}",
+            (unsigned long)size, (unsigned long)size * sizeof(AI_HISTORY_Rec));
+        AI_SendResponse(ai_response);
+    }
+    else if (strcmp(cmd_type, "history_stop") == 0) {
+        if (AI_HISTORY_ring != NULL) {
+            AI_HISTORY_Stop();
+            CPU_UpdateGo();
+        }
+        AI_SendResponse("{\"status\":\"ok\"}");
+    }
+    else if (strcmp(cmd_type, "history") == 0) {
+        /* As much as base64 fits in the response, or all of it to a file */
+        const AI_HISTORY_Rec *parts[2];
+        ULONG lens[2], n;
+        int last, pos, p;
+
+        json_get_string(cmd, "path", path, sizeof(path));
+        last = json_get_int(cmd, "last", path[0] ? (int)AI_HISTORY_MAX_ENTRIES : AI_HISTORY_JSON_MAX);
+        if (last < 0) last = 0;
+        if (!path[0] && last > AI_HISTORY_JSON_MAX) last = AI_HISTORY_JSON_MAX;
+        n = AI_HISTORY_Newest((ULONG)last, parts, lens);
+        if (path[0]) {
+            FILE *fp = fopen(path, "wb");
+            int ok = fp != NULL;
+            for (p = 0; ok && p < 2; p++)
+                ok = fwrite(parts[p], sizeof(AI_HISTORY_Rec), lens[p], fp) == lens[p];
+            if (fp != NULL && fclose(fp) != 0)
+                ok = FALSE;
+            if (!ok) {
+                AI_SendResponse("{\"status\":\"error\",\"msg\":\"Cannot write the history file\"}");
+                return;
+            }
+        }
+        pos = snprintf(ai_response, sizeof(ai_response),
+            "{\"status\":\"ok\",\"active\":%s,\"branches\":%s,\"entries\":%lu,\"held\":%lu,"
+            "\"recorded\":%.0f,\"count\":%lu",
+            AI_HISTORY_ring != NULL ? "true" : "false", AI_HISTORY_branches ? "true" : "false",
+            AI_HISTORY_ring != NULL ? (unsigned long)AI_HISTORY_mask + 1 : 0UL,
+            (unsigned long)AI_HISTORY_Held(), (double)AI_HISTORY_pos, (unsigned long)n);
+        if (!path[0]) {
+            static UBYTE records[AI_HISTORY_JSON_MAX * sizeof(AI_HISTORY_Rec)];
+            memcpy(records, parts[0], lens[0] * sizeof(AI_HISTORY_Rec));
+            memcpy(records + lens[0] * sizeof(AI_HISTORY_Rec), parts[1], lens[1] * sizeof(AI_HISTORY_Rec));
+            pos += snprintf(ai_response + pos, sizeof(ai_response) - pos, ",\"records\":\"");
+            pos += AI_Base64Encode(records, n * sizeof(AI_HISTORY_Rec), ai_response + pos, sizeof(ai_response) - pos);
+            pos += snprintf(ai_response + pos, sizeof(ai_response) - pos, "\"");
+        }
+        snprintf(ai_response + pos, sizeof(ai_response) - pos, "}");
+        AI_SendResponse(ai_response);
+    }
+    else if (strcmp(cmd_type, "trace_start") == 0) {
+        json_get_string(cmd, "path", path, sizeof(path));
+        if (path[0] && AI_TRACE_Start(path))
+            AI_SendResponse("{\"status\":\"ok\"}");
+        else
+            AI_SendResponse("{\"status\":\"error\",\"msg\":\"Cannot create the trace file\"}");
+    }
+    else if (strcmp(cmd_type, "timeline_start") == 0) {
+        json_get_string(cmd, "path", path, sizeof(path));
+        if (path[0] && AI_TIMELINE_Start(path, json_get_int(cmd, "events", 0)))
+            AI_SendResponse("{\"status\":\"ok\"}");
+        else
+            AI_SendResponse("{\"status\":\"error\",\"msg\":\"Cannot create the timeline file\"}");
+    }
+    else if (strcmp(cmd_type, "timeline_stop") == 0 || strcmp(cmd_type, "timeline_status") == 0) {
+        AI_TIMELINE_Stats stats = {0, 0, FALSE};
+        int active = FALSE;
+        if (strcmp(cmd_type, "timeline_stop") == 0)
+            AI_TIMELINE_Stop(&stats);
+        else
+            active = AI_TIMELINE_Status(&stats);
+        snprintf(ai_response, sizeof(ai_response),
+            "{\"status\":\"ok\",\"active\":%s,\"spans\":%.0f,\"dropped\":%.0f,\"error\":%s}",
+            active ? "true" : "false", stats.spans, stats.dropped, stats.error ? "true" : "false");
+        AI_SendResponse(ai_response);
+    }
+    else if (strcmp(cmd_type, "trace_stop") == 0 || strcmp(cmd_type, "trace_status") == 0) {
+        AI_TRACE_Stats stats = {0, 0, FALSE};
+        int active = FALSE;
+        if (strcmp(cmd_type, "trace_stop") == 0)
+            AI_TRACE_Stop(&stats);
+        else
+            active = AI_TRACE_Status(&stats);
+        snprintf(ai_response, sizeof(ai_response),
+            "{\"status\":\"ok\",\"active\":%s,\"records\":%.0f,\"stalls\":%u,\"error\":%s}",
+            active ? "true" : "false", stats.records, (unsigned) stats.stalls,
+            stats.error ? "true" : "false");
+        AI_SendResponse(ai_response);
+    }
+    else if (strcmp(cmd_type, "stats") == 0) {
+        AI_FrameStats s;
+        int enable = json_get_bool(cmd, "enable", -1);
+        int counters = json_get_bool(cmd, "counters", -1);
+        size_t len;
+        int i;
+
+        if (enable >= 0 && enable != AI_frame_timing)
+            AI_SetFrameTiming(enable);
+        if (counters >= 0 && !hw_set(counters)) {
+            AI_SendResponse("{\"status\":\"error\",\"msg\":\"Hardware counters are not available\"}");
+            return;
+        }
+        AI_GetFrameStats(&s, json_get_bool(cmd, "clear", FALSE));
+        len = snprintf(ai_response, sizeof(ai_response),
+            "{\"status\":\"ok\",\"enabled\":%s,\"frames\":%lu,\"frame\":",
+            AI_frame_timing ? "true" : "false", (unsigned long)s.frames);
+        len += frame_stats_json(ai_response + len, sizeof(ai_response) - len, &s, AI_TIME_STAGES);
+        len += snprintf(ai_response + len, sizeof(ai_response) - len, ",\"stages\":{");
+        for (i = 0; i < AI_TIME_STAGES; i++) {
+            len += snprintf(ai_response + len, sizeof(ai_response) - len,
+                "%s\"%s\":", i ? "," : "", AI_time_stage_names[i]);
+            len += frame_stats_json(ai_response + len, sizeof(ai_response) - len, &s, i);
+        }
+        len += snprintf(ai_response + len, sizeof(ai_response) - len, "},");
+        len += perf_stats_json(ai_response + len, sizeof(ai_response) - len,
+                               json_get_bool(cmd, "clear", FALSE));
+        len += snprintf(ai_response + len, sizeof(ai_response) - len, ",");
+        len += hw_counters_json(ai_response + len, sizeof(ai_response) - len,
+                                json_get_bool(cmd, "clear", FALSE));
+        snprintf(ai_response + len, sizeof(ai_response) - len, "}");
+        AI_SendResponse(ai_response);
+    }
+    else if (strcmp(cmd_type, "profile_dump") == 0) {
+        char format[16] = "json";
+        int top = json_get_int(cmd, "top", 20);
+        int routines = json_get_int(cmd, "routines", 0);
+        json_get_string(cmd, "format", format, sizeof(format));
+#ifdef MONITOR_HINTS
+        json_get_string(cmd, "labels", path, sizeof(path));
+        if (path[0])
+            MONITOR_PreloadLabelFile(path);
+#endif
+        /* CSV lines take up to 36 bytes, routines 80; keep the reply
+           within bounds */
+        if (top < 0) top = 0;
+        if (top > 15000) top = 15000;
+        if (routines > 4000) routines = 4000;
+        profile_dump(top, strcmp(format, "csv") == 0, routines);
+    }
 
     /* === CHIPS === */
     else if (strcmp(cmd_type, "antic") == 0) {
@@ -441,6 +5565,46 @@ static void process_command(const char *cmd) {
             ANTIC_NMIEN, ANTIC_NMIST, ANTIC_ypos, ANTIC_xpos);
         AI_SendResponse(ai_response);
     }
+    else if (strcmp(cmd_type, "cycles") == 0) {
+        double v[AI_CYCLE_KINDS];
+        size_t len;
+
+        cycle_values(&ANTIC_frame_cycles, v);
+        len = snprintf(ai_response, sizeof(ai_response), "{\"status\":\"ok\",\"last\":");
+        len += cycles_json(ai_response + len, sizeof(ai_response) - len, v, 1.0);
+        len += snprintf(ai_response + len, sizeof(ai_response) - len,
+                        ",\"frames\":%lu,\"mean\":", (unsigned long)ai_cycle_sum.frames);
+        len += cycles_json(ai_response + len, sizeof(ai_response) - len,
+                           ai_cycle_sum.sum, ai_cycle_sum.frames);
+        snprintf(ai_response + len, sizeof(ai_response) - len, "}");
+        if (json_get_bool(cmd, "clear", FALSE))
+            memset(&ai_cycle_sum, 0, sizeof(ai_cycle_sum));
+        AI_SendResponse(ai_response);
+    }
+    else if (strcmp(cmd_type, "display_list") == 0) {
+        const ANTIC_DLEntry *dl;
+        ULONG generation;
+        int n = ANTIC_GetDisplayList(&dl, &generation);
+        int since = json_get_int(cmd, "since", -1);
+        int pos, i;
+
+        /* A client that has this generation already gets no entries */
+        if (since >= 0 && (ULONG)since == generation) n = -1;
+        pos = snprintf(ai_response, sizeof(ai_response),
+            "{\"status\":\"ok\",\"generation\":%lu,\"changed\":%s",
+            (unsigned long)generation, n < 0 ? "false" : "true");
+        if (n >= 0) {
+            pos += snprintf(ai_response + pos, sizeof(ai_response) - pos, ",\"entries\":[");
+            for (i = 0; i < n; i++) {
+                pos += snprintf(ai_response + pos, sizeof(ai_response) - pos,
+                    "%s[%d,%d,%d,%d,%d]", i ? "," : "",
+                    dl[i].addr, dl[i].ir, dl[i].ypos, dl[i].lines, dl[i].operand);
+            }
+            pos += snprintf(ai_response + pos, sizeof(ai_response) - pos, "]");
+        }
+        snprintf(ai_response + pos, sizeof(ai_response) - pos, "}");
+        AI_SendResponse(ai_response);
+    }
     else if (strcmp(cmd_type, "gtia") == 0) {
         snprintf(ai_response, sizeof(ai_response),
             "{\"status\":\"ok\","
@@ -488,51 +5652,185 @@ static void process_command(const char *cmd) {
             PIA_PORT_input[0], PIA_PORT_input[1]);
         AI_SendResponse(ai_response);
     }
+#ifdef NETSIO
+    else if (strcmp(cmd_type, "netsio") == 0) {
+        NetSIOSyncStats s;
+        size_t len;
+        int i;
+
+        netsio_get_sync_stats(&s, json_get_bool(cmd, "clear", FALSE));
+        len = snprintf(ai_response, sizeof(ai_response),
+            "{\"status\":\"ok\",\"enabled\":%s,\"syncs\":%lu,\"timeouts\":%lu,"
+            "\"mean_us\":%.1f,\"max_us\":%ld,\"latency_us\":[",
+            netsio_enabled ? "true" : "false", s.syncs, s.timeouts,
+            s.syncs ? s.total_us / s.syncs : 0.0, s.max_us);
+        for (i = 0; i < NETSIO_LATENCY_BUCKETS; i++)
+            len += snprintf(ai_response + len, sizeof(ai_response) - len,
+                            i ? ",%lu" : "%lu", s.latency[i]);
+        snprintf(ai_response + len, sizeof(ai_response) - len, "]}");
+        AI_SendResponse(ai_response);
+    }
+#endif
 
     /* === DEBUG === */
     else if (strcmp(cmd_type, "debug_enable") == 0) {
+        int size = json_get_int(cmd, "size", (int)ai_debug.size);
+
+        if (size < AI_DEBUG_MIN_SIZE || size > AI_DEBUG_MAX_SIZE) {
+            AI_SendResponse("{\"status\":\"error\",\"msg\":\"size must be 256 bytes to 16 MB\"}");
+            return;
+        }
+        if (ai_debug.buf == NULL || (ULONG)size != ai_debug.size)
+            debug_resize((ULONG)size);
         AI_debug_port = json_get_int(cmd, "addr", 0xD7FF);
-        AI_SendResponse("{\"status\":\"ok\"}");
+        snprintf(ai_response, sizeof(ai_response),
+            "{\"status\":\"ok\",\"size\":%lu}", (unsigned long)ai_debug.size);
+        AI_SendResponse(ai_response);
     }
     else if (strcmp(cmd_type, "debug_read") == 0) {
-        int pos = snprintf(ai_response, sizeof(ai_response),
-            "{\"status\":\"ok\",\"data\":[");
-        for (int i = 0; i < ai_debug_buffer_pos && pos < sizeof(ai_response) - 100; i++) {
-            pos += snprintf(ai_response + pos, sizeof(ai_response) - pos,
-                "%s%d", i ? "," : "", ai_debug_buffer[i]);
+        JSON_Writer w;
+        ULONG n = debug_peek((sizeof(ai_response) - 1024) / 8);
+        ULONG i;
+        int pos;
+
+        /* The bytes of the records taken, without their headers */
+        jw_start(&w, ai_response, sizeof(ai_response) - 100);
+        jw_raw(&w, "{\"status\":\"ok\",\"data\":[");
+        for (i = 0; i < n; i += AI_DEBUG_HEADER + get_le16(ai_debug_out + i + 4)) {
+            int k, len = get_le16(ai_debug_out + i + 4);
+            for (k = 0; k < len; k++) {
+                if (i || k) jw_char(&w, ',');
+                jw_int(&w, ai_debug_out[i + AI_DEBUG_HEADER + k]);
+            }
         }
-        pos += snprintf(ai_response + pos, sizeof(ai_response) - pos, "],\"ascii\":\"");
-        for (int i = 0; i < ai_debug_buffer_pos && pos < sizeof(ai_response) - 10; i++) {
-            UBYTE c = ai_debug_buffer[i];
-            if (c >= 32 && c < 127 && c != '"' && c != '\\') {
-                ai_response[pos++] = c;
-            } else {
-                ai_response[pos++] = '.';
+        jw_raw(&w, "],\"records\":[");
+        for (i = 0; i < n; i += AI_DEBUG_HEADER + get_le16(ai_debug_out + i + 4)) {
+            if (i) jw_char(&w, ',');
+            jw_char(&w, '[');
+            jw_int(&w, (long)get_le32(ai_debug_out + i));
+            jw_char(&w, ',');
+            jw_int(&w, get_le16(ai_debug_out + i + 4));
+            jw_char(&w, ']');
+        }
+        jw_char(&w, ']');
+        jw_field(&w, "dropped", (long)ai_debug.dropped);
+        jw_field(&w, "written", (long)ai_debug.written);
+        jw_key(&w, "more");
+        jw_raw(&w, ai_debug.used > n ? "true" : "false");
+        jw_raw(&w, ",\"ascii\":\"");
+        pos = w.pos;
+        for (i = 0; i < n; i += AI_DEBUG_HEADER + get_le16(ai_debug_out + i + 4)) {
+            int k, len = get_le16(ai_debug_out + i + 4);
+            for (k = 0; k < len && pos < (int)sizeof(ai_response) - 10; k++) {
+                UBYTE c = ai_debug_out[i + AI_DEBUG_HEADER + k];
+                ai_response[pos++] = c >= 32 && c < 127 && c != '"' && c != '\\' ? c : '.';
             }
         }
         snprintf(ai_response + pos, sizeof(ai_response) - pos, "\"}");
-        ai_debug_buffer_pos = 0;  /* Clear buffer */
+        debug_consume(n);
         AI_SendResponse(ai_response);
     }
 
     /* === STATE === */
     else if (strcmp(cmd_type, "save_state") == 0) {
+        static const char * const codecs[] = {"gzip", "fast", "raw"};
+        char name[16] = "gzip";
+        int codec;
+
         json_get_string(cmd, "path", path, sizeof(path));
-        if (path[0] && StateSav_SaveAtariState(path, "wb", TRUE)) {
+        json_get_string(cmd, "codec", name, sizeof(name));
+        for (codec = 0; codec < 3 && strcmp(name, codecs[codec]) != 0; codec++)
+            ;
+        if (codec == 3) {
+            AI_SendResponse("{\"status\":\"error\",\"msg\":\"codec must be gzip, fast or raw\"}");
+        } else if (!path[0]) {
+            /* The state in the reply, as AI_BIN_STATE_SAVE gives it */
+            ULONG size;
+            UBYTE *state = StateSav_PackAtariState(&size);
+            if (state == NULL || size > (sizeof(ai_response) - 64) / 4 * 3) {
+                AI_SendResponse("{\"status\":\"error\",\"msg\":\"Failed to save state\"}");
+            } else {
+                int pos = snprintf(ai_response, sizeof(ai_response),
+                    "{\"status\":\"ok\",\"bytes\":%lu,\"data\":\"", (unsigned long)size);
+                pos += AI_Base64Encode(state, (int)size, ai_response + pos, sizeof(ai_response) - pos);
+                snprintf(ai_response + pos, sizeof(ai_response) - pos, "\"}");
+                AI_SendResponse(ai_response);
+            }
+            free(state);
+        } else if (path[0] && json_get_bool(cmd, "async", FALSE)) {
+            save_state_async(path, codec);
+        } else if (path[0] && StateSav_SaveAtariStateCodec(path, TRUE, codec)) {
             AI_SendResponse("{\"status\":\"ok\"}");
         } else {
             AI_SendResponse("{\"status\":\"error\",\"msg\":\"Failed to save state\"}");
         }
     }
+    else if (strcmp(cmd_type, "save_status") == 0) {
+        static const char * const states[] = {"pending", "done", "failed"};
+        int job = json_get_int(cmd, "job", 0);
+        int state = AI_SAVER_Status(job);
+        snprintf(ai_response, sizeof(ai_response),
+            "{\"status\":\"ok\",\"job\":%d,\"state\":\"%s\"}",
+            job, state == AI_SAVER_UNKNOWN ? "unknown" : states[state]);
+        AI_SendResponse(ai_response);
+    }
     else if (strcmp(cmd_type, "load_state") == 0) {
+        static UBYTE state[AI_BUFFER_SIZE];
+        const char *data = json_find(cmd, "data");
+        const char *end = data && *data == '"' ? strchr(data + 1, '"') : NULL;
+        int n = end ? AI_Base64Decode(data + 1, (int)(end - data - 1), state, sizeof(state)) : -1;
+
         json_get_string(cmd, "path", path, sizeof(path));
-        if (path[0] && StateSav_ReadAtariState(path, "rb")) {
+        if (n > 0 && StateSav_UnpackAtariState(state, (ULONG)n)) {
+            AI_REWIND_Clear();
+            AI_SendResponse("{\"status\":\"ok\"}");
+        } else if (!data && path[0] && StateSav_ReadAtariState(path, "rb")) {
+            AI_REWIND_Clear();
             AI_SendResponse("{\"status\":\"ok\"}");
         } else {
             AI_SendResponse("{\"status\":\"error\",\"msg\":\"Failed to load state\"}");
         }
     }
 
+    else if (strcmp(cmd_type, "state_get") == 0) {
+        char base[16] = "";
+        const UBYTE *data;
+        ULONG len, id;
+        int kind;
+
+        json_get_string(cmd, "base", base, sizeof(base));
+        if (!state_get_for(ai_cur, base[0] != '\0', strtoul(base, NULL, 16), &data, &len, &kind, &id)
+            || len > (sizeof(ai_response) - 128) / 4 * 3) {
+            AI_SendResponse("{\"status\":\"error\",\"msg\":\"Failed to save state\"}");
+        } else {
+            int pos = snprintf(ai_response, sizeof(ai_response),
+                "{\"status\":\"ok\",\"frame\":%d,\"id\":\"%08lx\",\"full\":%s,"
+                "\"bytes\":%lu,\"data\":\"", Atari800_nframes, (unsigned long)id,
+                kind == AI_SUB_SCREEN_FULL ? "true" : "false", (unsigned long)len);
+            pos += AI_Base64Encode(data, (int)len, ai_response + pos, sizeof(ai_response) - pos);
+            snprintf(ai_response + pos, sizeof(ai_response) - pos, "\"}");
+            AI_SendResponse(ai_response);
+        }
+    }
+    else if (strcmp(cmd_type, "state_put") == 0) {
+        static UBYTE state[AI_BUFFER_SIZE];
+        const char *data = json_find(cmd, "data");
+        const char *end = data && *data == '"' ? strchr(data + 1, '"') : NULL;
+        int n = end ? AI_Base64Decode(data + 1, (int)(end - data - 1), state, sizeof(state)) : -1;
+        const char *err = n > 0 ? NULL : "state_put needs base64 data";
+        ULONG id;
+
+        if (err == NULL) err = state_put_for(ai_cur, state, (ULONG)n, &id);
+        if (err != NULL) {
+            snprintf(ai_response, sizeof(ai_response),
+                "{\"status\":\"error\",\"msg\":\"%s\"}", err);
+        } else {
+            snprintf(ai_response, sizeof(ai_response),
+                "{\"status\":\"ok\",\"id\":\"%08lx\"}", (unsigned long)id);
+        }
+        AI_SendResponse(ai_response);
+    }
+
     /* Unknown command */
     else {
         snprintf(ai_response, sizeof(ai_response),
@@ -541,68 +5839,754 @@ static void process_command(const char *cmd) {
     }
 }
 
-/* Read command from client */
-static int read_command(char *buf, int bufsize) {
-    if (ai_client_fd < 0) return 0;
+/* Process a binary frame (payload is NUL-terminated for AI_BIN_JSON) */
+static void process_binary_command(int opcode, ULONG tag, UBYTE *payload, int len) {
+    UBYTE out[16];
 
-    /* Read length prefix */
-    char header[32];
-    int hpos = 0;
-    while (hpos < sizeof(header) - 1) {
-        int r = read(ai_client_fd, header + hpos, 1);
-        if (r <= 0) {
-            if (r == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
-                /* Client disconnected */
-                close(ai_client_fd);
-                ai_client_fd = -1;
-                Log_print("AI: Client disconnected");
-            }
-            return 0;
+    ai_cur->bin_opcode = opcode;
+    ai_cur->bin_tag = tag;
+    if (!may_serve_binary(opcode)) return;
+
+    switch (opcode) {
+    case AI_BIN_PING:
+        send_reply(AI_BIN_STATUS_OK, NULL, 0, NULL, 0);
+        break;
+    case AI_BIN_JSON:
+        process_command((const char *)payload);
+        break;
+    case AI_BIN_RUN:
+        if (len < 4) {
+            send_binary_error("RUN needs a frame count");
+            break;
+        }
+        run_start((int)get_le32(payload), len >= 5 && payload[4] != 0);
+        /* Response sent after frames complete */
+        break;
+    case AI_BIN_PEEK: {
+        int addr, count, i;
+        ULONG n;
+        UBYTE *buf = (UBYTE *)ai_response;
+        if (len < 6) {
+            send_binary_error("PEEK needs addr and len");
+            break;
+        }
+        addr = get_le16(payload);
+        n = get_le32(payload + 2);
+        count = n > 65536 ? 65536 : (int)n;
+        for (i = 0; i < count; i++) {
+            buf[i] = MEMORY_SafeGetByte((UWORD)(addr + i));
+        }
+        send_reply(AI_BIN_STATUS_OK, buf, count, NULL, 0);
+        break;
+    }
+    case AI_BIN_PEEK_MULTI: {
+        static int ranges[2 * AI_PEEK_MAX_RANGES];
+        const char *err;
+        int n = len / 6, i, count;
+        if (n > AI_PEEK_MAX_RANGES) {
+            send_binary_error("PEEK_MULTI takes up to 256 ranges");
+            break;
+        }
+        for (i = 0; i < n; i++) {
+            ranges[2 * i] = get_le16(payload + 6 * i);
+            ranges[2 * i + 1] = (int)get_le32(payload + 6 * i + 2);
+        }
+        if ((err = peek_ranges(ranges, n, &count)) != NULL) {
+            send_binary_error(err);
+            break;
+        }
+        send_reply(AI_BIN_STATUS_OK, ai_peek_buf, count, NULL, 0);
+        break;
+    }
+    case AI_BIN_PEEK_BANK: {
+        int count;
+        if (len < 9) {
+            send_binary_error("PEEK_BANK needs kind, bank, offset and len");
+            break;
+        }
+        count = (int)get_le32(payload + 5);
+        if (!MEMORY_ReadBank(payload[0], get_le16(payload + 1), get_le16(payload + 3), ai_peek_buf, count)) {
+            send_binary_error("No such bank, or the range does not fit in it");
+            break;
+        }
+        send_reply(AI_BIN_STATUS_OK, ai_peek_buf, count, NULL, 0);
+        break;
+    }
+    case AI_BIN_POKE: {
+        int addr, i;
+        if (len < 2) {
+            send_binary_error("POKE needs an address");
+            break;
+        }
+        addr = get_le16(payload);
+        for (i = 2; i < len; i++) {
+            MEMORY_mem[(UWORD)addr++] = payload[i];  /* Direct write, same as JSON poke */
+        }
+        send_reply(AI_BIN_STATUS_OK, NULL, 0, NULL, 0);
+        break;
+    }
+    case AI_BIN_SCREEN_RAW:
+        put_le16(out, Screen_WIDTH);
+        put_le16(out + 2, Screen_HEIGHT);
+        send_reply(AI_BIN_STATUS_OK, out, 4,
+                   Screen_atari, Screen_WIDTH * Screen_HEIGHT);
+        break;
+    case AI_BIN_SCREEN_DELTA: {
+        const UBYTE *pixels;
+        int kind, count;
+        count = screen_delta_for(ai_cur, len >= 4 ? (int)get_le32(payload) : -1, &pixels, &kind);
+        put_le32(out, (ULONG)Atari800_nframes);
+        out[4] = (UBYTE)kind;
+        send_reply(AI_BIN_STATUS_OK, out, 5, pixels, count);
+        break;
+    }
+    case AI_BIN_OBSERVATION: {
+        static UBYTE obs[Screen_WIDTH * Screen_HEIGHT];
+        int width, height, count;
+        if (len < 5) {
+            send_binary_error("OBSERVATION needs width, height and format");
+            break;
+        }
+        width = get_le16(payload);
+        height = get_le16(payload + 2);
+        count = AI_OBS_Render(obs, width, height, payload[4],
+                              len >= 13 ? get_le16(payload + 5) : 0,
+                              len >= 13 ? get_le16(payload + 7) : 0,
+                              len >= 13 ? get_le16(payload + 9) : 0,
+                              len >= 13 ? get_le16(payload + 11) : 0);
+        if (count == 0) {
+            send_binary_error("Invalid observation shape, format or crop");
+            break;
         }
-        if (header[hpos] == '\n') {
-            header[hpos] = '\0';
+        put_le16(out, (UWORD)width);
+        put_le16(out + 2, (UWORD)height);
+        out[4] = payload[4];
+        send_reply(AI_BIN_STATUS_OK, out, 5, obs, count);
+        break;
+    }
+#ifdef SCREENSHOTS
+    case AI_BIN_SCREENSHOT: {
+        const char *format = len >= 2 ? (payload[1] == 1 ? "pcx" : "png") : AI_SCREENSHOT_FORMAT;
+        const UBYTE *image;
+        int size = save_screenshot(NULL, format, len >= 1 ? payload[0] : -1, &image);
+        if (size == 0) {
+            send_binary_error(strcmp(format, "png") == 0 ? "Cannot encode png screenshots"
+                                                         : "Cannot encode pcx screenshots");
+            break;
+        }
+        send_reply(AI_BIN_STATUS_OK, image, size, NULL, 0);
+        break;
+    }
+#else
+    case AI_BIN_SCREENSHOT:
+        send_binary_error("Screenshots not compiled in");
+        break;
+#endif
+    case AI_BIN_COVERAGE: {
+        UBYTE bitmap[AI_COVERAGE_BYTES];
+        put_le32(out, (ULONG)coverage_bitmap(bitmap, len >= 1 && payload[0] != 0));
+        send_reply(AI_BIN_STATUS_OK, out, 4, bitmap, sizeof(bitmap));
+        break;
+    }
+    case AI_BIN_HEATMAP: {
+        ULONG entries, start = len >= 6 ? get_le32(payload + 2) : 0;
+        ULONG length = len >= 10 ? get_le32(payload + 6) : 0xffffffffUL;
+        ULONG n = 0;
+        const UBYTE *varints = NULL;
+        const ULONG *counts;
+        if (len < 2 || payload[0] >= AI_HEATMAP_KINDS || payload[1] > 3) {
+            send_binary_error("Bad heatmap request");
+            break;
+        }
+        counts = heatmap_range(payload[1] - 1, payload[0], &entries, &start, &length);
+        if (length > 0) varints = heatmap_varints(counts + start, length, &n);
+        put_le32(out, entries);
+        put_le32(out + 4, start);
+        put_le32(out + 8, length);
+        send_reply(AI_BIN_STATUS_OK, out, 12, varints, (int)n);
+        break;
+    }
+    case AI_BIN_HISTORY: {
+        const AI_HISTORY_Rec *parts[2];
+        const void *frame_parts[3];
+        ULONG lens[2];
+        int frame_lens[3];
+        ULONG n = AI_HISTORY_Newest(len >= 4 ? get_le32(payload) : AI_HISTORY_MAX_ENTRIES, parts, lens);
+        put_le32(out, n);
+        put_le32(out + 4, AI_HISTORY_branches ? 1 : 0);
+        frame_parts[0] = out;
+        frame_lens[0] = 8;
+        frame_parts[1] = parts[0];
+        frame_lens[1] = (int)(lens[0] * sizeof(AI_HISTORY_Rec));
+        frame_parts[2] = parts[1];
+        frame_lens[2] = (int)(lens[1] * sizeof(AI_HISTORY_Rec));
+        send_frame_parts(ai_cur, opcode, tag, AI_BIN_STATUS_OK, frame_parts, frame_lens, 3);
+        break;
+    }
+    case AI_BIN_STATE_SAVE: {
+        ULONG size;
+        UBYTE *state = StateSav_PackAtariState(&size);
+        if (state == NULL) {
+            send_binary_error("Failed to save state");
+            break;
+        }
+        send_reply(AI_BIN_STATUS_OK, state, (int)size, NULL, 0);
+        free(state);
+        break;
+    }
+    case AI_BIN_STATE_LOAD:
+        if (!StateSav_UnpackAtariState(payload, (ULONG)len)) {
+            send_binary_error("Failed to load state");
+            break;
+        }
+        AI_REWIND_Clear();
+        send_reply(AI_BIN_STATUS_OK, NULL, 0, NULL, 0);
+        break;
+    case AI_BIN_STATE_GET: {
+        const UBYTE *data;
+        ULONG count, id;
+        int kind;
+        if (!state_get_for(ai_cur, len >= 4, len >= 4 ? get_le32(payload) : 0,
+                           &data, &count, &kind, &id)) {
+            send_binary_error("Failed to save state");
+            break;
+        }
+        put_le32(out, id);
+        out[4] = (UBYTE)kind;
+        send_reply(AI_BIN_STATUS_OK, out, 5, data, (int)count);
+        break;
+    }
+    case AI_BIN_STATE_PUT: {
+        ULONG id;
+        const char *err = state_put_for(ai_cur, payload, (ULONG)len, &id);
+        if (err != NULL) {
+            send_binary_error(err);
+            break;
+        }
+        put_le32(out, id);
+        send_reply(AI_BIN_STATUS_OK, out, 4, NULL, 0);
+        break;
+    }
+    case AI_BIN_HASH: {
+        uint64_t screen = AI_HASH_Screen();
+        uint64_t state = AI_HASH_State();
+        put_le32(out, (ULONG)screen);
+        put_le32(out + 4, (ULONG)(screen >> 32));
+        put_le32(out + 8, (ULONG)state);
+        put_le32(out + 12, (ULONG)(state >> 32));
+        send_reply(AI_BIN_STATUS_OK, out, 16, NULL, 0);
+        break;
+    }
+    case AI_BIN_CPU:
+        CPU_GetStatus();
+        put_le16(out, CPU_regPC);
+        out[2] = CPU_regA;
+        out[3] = CPU_regX;
+        out[4] = CPU_regY;
+        out[5] = CPU_regS;
+        out[6] = CPU_regP;
+        send_reply(AI_BIN_STATUS_OK, out, 7, NULL, 0);
+        break;
+    case AI_BIN_JOYSTICK:
+        if (len < 3) {
+            send_binary_error("JOYSTICK needs port, stick and fire");
+            break;
+        }
+        set_joystick(payload[0], payload[1] & 0x0f, payload[2]);
+        send_reply(AI_BIN_STATUS_OK, NULL, 0, NULL, 0);
+        break;
+    case AI_BIN_KEY:
+        if (len < 3) {
+            send_binary_error("KEY needs code and shift");
             break;
         }
-        hpos++;
+        INPUT_key_code = (SWORD)get_le16(payload);
+        INPUT_key_shift = payload[2] ? 1 : 0;
+        send_reply(AI_BIN_STATUS_OK, NULL, 0, NULL, 0);
+        break;
+    case AI_BIN_CONSOL:
+        if (len < 1) {
+            send_binary_error("CONSOL needs a key mask");
+            break;
+        }
+        INPUT_key_consol = INPUT_CONSOL_NONE & ~(payload[0] & INPUT_CONSOL_NONE);
+        send_reply(AI_BIN_STATUS_OK, NULL, 0, NULL, 0);
+        break;
+    case AI_BIN_ACK:
+        ack_records(ai_cur, len >= 4 ? (int)get_le32(payload) : -1);
+        send_reply(AI_BIN_STATUS_OK, NULL, 0, NULL, 0);
+        break;
+    case AI_BIN_PROTOCOL_JSON:
+        send_reply(AI_BIN_STATUS_OK, NULL, 0, NULL, 0);
+        ai_cur->protocol = AI_PROTOCOL_JSON;
+        ai_cur->compress = FALSE;
+        break;
+    default:
+        snprintf(ai_response, sizeof(ai_response), "Unknown opcode: %d", opcode);
+        send_binary_error(ai_response);
+        break;
     }
+}
 
-    int len = atoi(header);
-    if (len <= 0 || len >= bufsize) return 0;
+/* Parse a binary frame out of the client's input buffer; returns payload
+   length, or -1 if no complete frame has arrived yet */
+static int read_binary_command(AI_Client *c, int *opcode, ULONG *tag, UBYTE *buf, int bufsize) {
+    const UBYTE *header = c->in_buf + c->in_start;
+    int avail = c->in_end - c->in_start;
+    ULONG len;
 
-    /* Read JSON body */
-    int total = 0;
-    while (total < len) {
-        int r = read(ai_client_fd, buf + total, len - total);
-        if (r <= 0) return 0;
-        total += r;
+    if (avail < AI_BIN_HEADER_SIZE) return -1;
+    if (header[0] != AI_BIN_MAGIC) {
+        /* Framing lost - there is no way to resynchronise */
+        Log_print("AI: Bad binary frame magic 0x%02X", header[0]);
+        close_client(c);
+        return -1;
+    }
+    len = get_le32(header + 8);
+    if (len >= (ULONG)bufsize) {
+        Log_print("AI: Binary frame too large (%u bytes)", (unsigned int)len);
+        close_client(c);
+        return -1;
     }
+    if ((ULONG)avail < AI_BIN_HEADER_SIZE + len) return -1;
+
+    *opcode = header[1];
+    *tag = get_le32(header + 4);
+    memcpy(buf, header + AI_BIN_HEADER_SIZE, len);
     buf[len] = '\0';
-    return len;
+    c->in_start += AI_BIN_HEADER_SIZE + (int)len;
+    return (int)len;
+}
+
+/* Parse a "<length>\n<json>" command out of the client's input buffer;
+   returns its length, or 0 if no complete command has arrived yet */
+static int read_command(AI_Client *c, char *buf, int bufsize) {
+    for (;;) {
+        const UBYTE *p = c->in_buf + c->in_start;
+        int avail = c->in_end - c->in_start;
+        int hpos, len;
+
+        for (hpos = 0; hpos < avail && p[hpos] != '\n'; hpos++) {
+            if (hpos >= 31) {
+                Log_print("AI: Bad command length header");
+                close_client(c);
+                return 0;
+            }
+        }
+        if (hpos == avail) return 0;
+
+        len = atoi((const char *)p);
+        if (len <= 0 || len >= bufsize) {
+            /* Skip the unusable header and carry on with the next one */
+            c->in_start += hpos + 1;
+            continue;
+        }
+        if (avail < hpos + 1 + len) return 0;
+
+        memcpy(buf, p + hpos + 1, len);
+        buf[len] = '\0';
+        c->in_start += hpos + 1 + len;
+        return len;
+    }
+}
+
+/* Is the next command buffered for the client, complete, one it may
+   have answered while the run it is owed the reply of goes on? */
+static int next_overlaps_run(const AI_Client *c) {
+    static char cmd_buf[AI_BUFFER_SIZE];
+    const UBYTE *p = c->in_buf + c->in_start;
+    int avail = c->in_end - c->in_start;
+    char cmd_type[32] = "";
+    int off, len;
+
+    if (c->fd < 0) return FALSE;
+    if (c->protocol == AI_PROTOCOL_BINARY) {
+        if (avail < AI_BIN_HEADER_SIZE || p[0] != AI_BIN_MAGIC) return FALSE;
+        switch (p[1]) {
+        case AI_BIN_PING:
+        case AI_BIN_PEEK:
+        case AI_BIN_PEEK_MULTI:
+        case AI_BIN_PEEK_BANK:
+        case AI_BIN_SCREEN_RAW:
+        case AI_BIN_SCREEN_DELTA:
+        case AI_BIN_OBSERVATION:
+        case AI_BIN_SCREENSHOT:
+        case AI_BIN_HASH:
+        case AI_BIN_CPU:
+        case AI_BIN_HISTORY:
+        case AI_BIN_STATE_SAVE:
+        case AI_BIN_STATE_GET:
+            return TRUE;
+        case AI_BIN_JSON:
+            break;
+        default:
+            return FALSE;
+        }
+        off = AI_BIN_HEADER_SIZE;
+        len = (int)get_le32(p + 8);
+    }
+    else {
+        for (off = 0; off < avail && off < 32 && p[off] != '\n'; off++)
+            ;
+        if (off == avail || p[off] != '\n') return FALSE;
+        len = atoi((const char *)p);
+        off++;
+    }
+    if (len <= 0 || len >= (int)sizeof(cmd_buf) || avail < off + len) return FALSE;
+    memcpy(cmd_buf, p + off, len);
+    cmd_buf[len] = '\0';
+    json_get_string(cmd_buf, "cmd", cmd_type, sizeof(cmd_type));
+    return may_overlap_run(cmd_type);
+}
+
+/* Serve one buffered command from the client; returns FALSE if no
+   complete command is waiting */
+static int serve_client(AI_Client *c) {
+    static char cmd_buf[AI_BUFFER_SIZE];
+    char name[AI_TIMELINE_NAME] = "";  /* of the command, for the timeline */
+    int served = FALSE;
+    double start = Util_time();
+    double ticks = AI_TIMELINE_enabled ? AI_Ticks() : 0.0;
+
+    if (c->fd < 0) return FALSE;
+    ai_cur = c;
+    if (c->protocol == AI_PROTOCOL_BINARY) {
+        int opcode, len;
+        ULONG tag;
+        if ((len = read_binary_command(c, &opcode, &tag, (UBYTE *)cmd_buf, sizeof(cmd_buf))) >= 0) {
+            snprintf(name, sizeof(name), "binary %d", opcode);
+            if (opcode == AI_BIN_JSON)
+                json_get_id(cmd_buf, c->req_id, sizeof(c->req_id));
+            else
+                c->req_id[0] = '\0';
+            process_binary_command(opcode, tag, (UBYTE *)cmd_buf, len);
+            served = TRUE;
+        }
+    } else if (read_command(c, cmd_buf, sizeof(cmd_buf)) > 0) {
+        JSON_Index ix, *outer = json_cur;
+        json_index(&ix, cmd_buf);
+        json_cur = &ix;
+        if (ticks != 0.0)
+            json_get_string(cmd_buf, "cmd", name, sizeof(name));
+        json_get_id(cmd_buf, c->req_id, sizeof(c->req_id));
+        dispatch_command(cmd_buf);
+        json_cur = outer;
+        served = TRUE;
+    }
+    ai_cur = NULL;
+    if (served) {
+        double t = Util_time() - start;
+        ai_cmd_count++;
+        ai_cmd_total += t;
+        if (t > ai_cmd_max) ai_cmd_max = t;
+        ai_cmd_hist[time_bucket(t)]++;
+        /* Not for the command that started the timeline */
+        if (AI_TIMELINE_enabled && ticks != 0.0)
+            AI_TIMELINE_Span(AI_TIMELINE_EMULATOR, name, ticks, AI_Ticks());
+    }
+    return served;
+}
+
+/* Queue one frame record for a subscriber; the CPU registers were
+   fetched by the caller, and the debug port records taken out of the
+   ring, ndebug bytes in ai_debug_out */
+static void push_frame_record(AI_Client *c, ULONG ndebug) {
+    static UBYTE rec[15 + 1 + AI_SUB_MAX_ADDRS + 5 + AI_SCREEN_DELTA_MAX];
+    UBYTE audio[1 + 1 + AI_AUDIO_ENV_SIZE * AI_AUDIO_ENV_MAX + 8];
+    UBYTE debug[8];
+    const UBYTE *screen = (const UBYTE *)Screen_atari;
+    const UBYTE *pixels = NULL;
+    const UBYTE *samples = NULL;
+    unsigned int nsamples = 0;
+    int rate = 0, channels = 0, sample_bytes = 0;
+    int kind = c->sub_screen;
+    int i, n, naudio = 0, nenv = 0, npixels = 0;
+
+    if (kind == AI_SUB_SCREEN_DELTA && c->sub_prev_screen == NULL) {
+        /* Nothing to diff against yet */
+        c->sub_prev_screen = (UBYTE *)Util_malloc(AI_SCREEN_SIZE);
+        kind = AI_SUB_SCREEN_FULL;
+    }
+    if (kind == AI_SUB_SCREEN_FULL) {
+        pixels = screen;
+        npixels = AI_SCREEN_SIZE;
+    }
+
+    /* Binary layout: the fixed part, then the memory values, then the
+       screen; JSON records carry the same fields */
+    put_le32(rec, (ULONG)Atari800_nframes);
+    put_le32(rec + 4, c->events_dropped);
+    put_le16(rec + 8, CPU_regPC);
+    rec[10] = CPU_regA;
+    rec[11] = CPU_regX;
+    rec[12] = CPU_regY;
+    rec[13] = CPU_regS;
+    rec[14] = CPU_regP;
+    n = 15;
+    rec[n++] = (UBYTE)c->sub_naddrs;
+    for (i = 0; i < c->sub_naddrs; i++)
+        rec[n++] = MEMORY_SafeGetByte(c->sub_addrs[i]);
+    if (kind == AI_SUB_SCREEN_DELTA) {
+        npixels = encode_screen_delta(c->sub_prev_screen, screen, rec + n + 5);
+        pixels = rec + n + 5;
+    }
+    rec[n++] = (UBYTE)kind;
+    put_le32(rec + n, (ULONG)npixels);
+    n += 4;
+    if (c->sub_prev_screen != NULL)
+        memcpy(c->sub_prev_screen, screen, AI_SCREEN_SIZE);
+
+    /* The audio section: envelopes, then the samples left in
+       POKEYSND_process_buffer by the frame's Sound_Update() */
+    if (c->sub_audio != 0) {
+        audio[naudio++] = (UBYTE)c->sub_audio;
+        if (c->sub_audio & AI_SUB_AUDIO_ENV) {
+            nenv = AI_AudioEnvelopes(audio + naudio + 1);
+            audio[naudio++] = (UBYTE)nenv;
+            naudio += nenv * AI_AUDIO_ENV_SIZE;
+        }
+#ifdef SOUND
+        if (c->sub_audio & AI_SUB_AUDIO_PCM) {
+            if (c->sub_resampler != NULL) {
+                samples = c->sub_pcm;
+                nsamples = (unsigned int)c->sub_pcm_len;
+                c->sub_pcm_len = 0;
+                rate = RESAMPLE_OutRate(c->sub_resampler);
+            }
+            else {
+                samples = Sound_FrameSamples(&nsamples);
+                rate = Sound_out.freq;
+            }
+            channels = Sound_out.channels;
+            sample_bytes = Sound_out.sample_size;
+            put_le16(audio + naudio, (UWORD)rate);
+            audio[naudio + 2] = (UBYTE)channels;
+            audio[naudio + 3] = (UBYTE)sample_bytes;
+            put_le32(audio + naudio + 4, (ULONG)nsamples);
+            naudio += 8;
+        }
+#endif
+    }
+    else if (c->sub_debug)
+        audio[naudio++] = 0;  /* no audio, for the debug section to follow */
+    if (!c->sub_debug)
+        ndebug = 0;
+    put_le32(debug, (ULONG)ai_debug.dropped);
+    put_le32(debug + 4, ndebug);
+
+    if (c->protocol == AI_PROTOCOL_BINARY) {
+        const void *parts[6];
+        int lens[6];
+        parts[0] = rec;
+        lens[0] = n;
+        parts[1] = pixels;
+        lens[1] = npixels;
+        if (kind == AI_SUB_SCREEN_DELTA) {
+            lens[0] = n + npixels;
+            lens[1] = 0;
+        }
+        parts[2] = audio;
+        lens[2] = naudio;
+        parts[3] = samples;
+        lens[3] = (int)nsamples;
+        parts[4] = debug;
+        lens[4] = c->sub_debug ? 8 : 0;
+        parts[5] = ai_debug_out;
+        lens[5] = (int)ndebug;
+        send_frame_parts(c, AI_BIN_EVENT_FRAME, 0, AI_BIN_STATUS_OK, parts, lens, 6);
+    } else {
+        JSON_Writer w;
+        int pos;
+
+        jw_start(&w, ai_response, sizeof(ai_response));
+        jw_raw(&w, "{\"event\":\"frame\"");
+        jw_field(&w, "frame", Atari800_nframes);
+        jw_key(&w, "paused");
+        jw_raw(&w, ai_paused && have_driver() ? "true" : "false");
+        jw_field(&w, "pc", CPU_regPC);
+        jw_field(&w, "a", CPU_regA);
+        jw_field(&w, "x", CPU_regX);
+        jw_field(&w, "y", CPU_regY);
+        jw_field(&w, "sp", CPU_regS);
+        jw_field(&w, "p", CPU_regP);
+        jw_field(&w, "dropped", (long)c->events_dropped);
+        if (c->sub_naddrs > 0) {
+            jw_key(&w, "mem");
+            jw_bytes(&w, rec + 16, c->sub_naddrs);
+        }
+        pos = w.pos;
+        if (kind != AI_SUB_SCREEN_NONE) {
+            pos += snprintf(ai_response + pos, sizeof(ai_response) - pos, ",\"%s\":\"",
+                kind == AI_SUB_SCREEN_DELTA ? "screen_delta" : "screen");
+            pos += AI_Base64Encode(pixels, npixels, ai_response + pos, sizeof(ai_response) - pos);
+            ai_response[pos++] = '"';
+        }
+        if (c->sub_audio & AI_SUB_AUDIO_ENV) {
+            const UBYTE *env = audio + 2;
+            pos += snprintf(ai_response + pos, sizeof(ai_response) - pos, ",\"env\":[");
+            for (i = 0; i < nenv; i++, env += AI_AUDIO_ENV_SIZE) {
+                pos += snprintf(ai_response + pos, sizeof(ai_response) - pos,
+                    "%s[%d,%d,%d]", i ? "," : "", get_le16(env), env[2], env[3]);
+            }
+            ai_response[pos++] = ']';
+        }
+        if (c->sub_audio & AI_SUB_AUDIO_PCM) {
+            pos += snprintf(ai_response + pos, sizeof(ai_response) - pos,
+                ",\"pcm\":{\"rate\":%d,\"channels\":%d,\"bits\":%d,\"data\":\"",
+                rate, channels, sample_bytes * 8);
+            pos += AI_Base64Encode(samples, (int)nsamples, ai_response + pos, sizeof(ai_response) - pos);
+            pos += snprintf(ai_response + pos, sizeof(ai_response) - pos, "\"}");
+        }
+        if (c->sub_debug) {
+            ULONG k;
+            pos += snprintf(ai_response + pos, sizeof(ai_response) - pos,
+                ",\"debug_dropped\":%lu,\"debug\":[", (unsigned long)ai_debug.dropped);
+            for (k = 0; k < ndebug; k += AI_DEBUG_HEADER + get_le16(ai_debug_out + k + 4)) {
+                pos += snprintf(ai_response + pos, sizeof(ai_response) - pos,
+                    "%s[%lu,\"", k ? "," : "", (unsigned long)get_le32(ai_debug_out + k));
+                pos += AI_Base64Encode(ai_debug_out + k + AI_DEBUG_HEADER, get_le16(ai_debug_out + k + 4),
+                    ai_response + pos, sizeof(ai_response) - pos);
+                pos += snprintf(ai_response + pos, sizeof(ai_response) - pos, "\"]");
+            }
+            ai_response[pos++] = ']';
+        }
+        snprintf(ai_response + pos, sizeof(ai_response) - pos, "}");
+        send_json(c, AI_BIN_JSON, 0, ai_response);
+    }
+    c->sub_last_frame = Atari800_nframes;
+    if (c->sub_window > 0) c->sub_unacked++;
+}
+
+/* Push frame records to the subscribers due one. A subscriber that has
+   its window full or output still queued misses the record rather than
+   stalling the frame; only a lockstep subscriber is always served. */
+static void push_frame_events(void) {
+    int i, fetched = FALSE;
+    long ndebug = -1;  /* debug port bytes taken out, once needed */
+    int debug_sent = FALSE;
+
+#ifdef SOUND
+    feed_resamplers();
+#endif
+    for (i = 0; i < AI_MAX_CLIENTS; i++) {
+        AI_Client *c = ai_clients[i];
+        if (c == NULL || c->fd < 0 || c->sub_every <= 0) continue;
+        if (Atari800_nframes % c->sub_every != 0) continue;
+        if (c != ai_stream_client || c->sub_mode != AI_SUB_LOCKSTEP) {
+            if ((c->sub_window > 0 && c->sub_unacked >= c->sub_window)
+                || c->out_end - c->out_start > AI_PUSH_BACKLOG) {
+                c->events_dropped++;
+                continue;
+            }
+        }
+        if (!fetched) {
+            CPU_GetStatus();
+            fetched = TRUE;
+        }
+        if (c->sub_debug) {
+            if (ndebug < 0)
+                ndebug = (long)debug_peek(AI_DEBUG_PUSH_MAX);
+            debug_sent = TRUE;
+        }
+        push_frame_record(c, ndebug > 0 ? (ULONG)ndebug : 0);
+    }
+    /* Records that no subscriber got stay for the next */
+    if (debug_sent)
+        debug_consume((ULONG)ndebug);
+
+    /* Lockstep: hold the machine until the subscriber catches up */
+    if (ai_stream_client != NULL && ai_stream_client->sub_mode == AI_SUB_LOCKSTEP
+        && ai_stream_client->sub_unacked >= ai_stream_client->sub_window)
+        ai_paused = 1;
 }
 
-/* Check for and accept new connections */
-static void check_connections(void) {
-    if (ai_server_fd < 0) return;
+/* Accept a pending connection on the listening socket */
+static void accept_client(void) {
+    AI_Client *c;
+    int i, flags;
+    int fd = accept(ai_server_fd, NULL, NULL);
+
+    if (fd < 0) return;
+    for (i = 0; i < AI_MAX_CLIENTS && ai_clients[i] != NULL; i++)
+        ;
+    if (i == AI_MAX_CLIENTS) {
+        Log_print("AI: Too many clients, refusing connection");
+        close(fd);
+        return;
+    }
+    /* Set non-blocking */
+    flags = fcntl(fd, F_GETFL, 0);
+    fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+    if (ai_listen_tcp) {
+        /* Replies and frame records are written whole: send them at once */
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    }
+
+    c = (AI_Client *)Util_malloc(sizeof(AI_Client));
+    memset(c, 0, sizeof(AI_Client));
+    c->fd = fd;
+    c->protocol = AI_PROTOCOL_JSON;
+    c->bin_opcode = AI_BIN_JSON;
+    c->delta_frame[0] = c->delta_frame[1] = -1;
+    ai_clients[i] = c;
+    AI_FORKSERVER_Update(count_clients());
+    Log_print("AI: Client connected (%d connected)", count_clients());
+
+    if (ai_controller == NULL) {
+        /* Nobody is in control: this client is, pause and wait for commands */
+        ai_controller = c;
+        ai_controller_exclusive = 0;
+        ai_paused = 1;
+    }
+}
 
-    fd_set fds;
-    struct timeval tv = {0, 0};
+/* Wait up to timeout_ms (-1 = forever, 0 = just check) for a new
+   connection, client input or room for queued output, and handle
+   whatever arrived */
+static void poll_events(int timeout_ms) {
+    struct pollfd fds[AI_MAX_CLIENTS + 2];
+    AI_Client *owner[AI_MAX_CLIENTS + 2];
+    int i, n = 0, wake = AI_SAVER_WakeFd();
 
-    FD_ZERO(&fds);
-    FD_SET(ai_server_fd, &fds);
+    reap_clients();
+    for (i = 0; i < AI_MAX_CLIENTS; i++) {
+        AI_Client *c = ai_clients[i];
+        if (c == NULL) continue;
+        fds[n].fd = c->fd;
+        fds[n].events = POLLIN;
+        if (c->out_start < c->out_end) fds[n].events |= POLLOUT;
+        fds[n].revents = 0;
+        owner[n++] = c;
+    }
+    /* The listening socket goes last so that a client's hangup is seen
+       before a connection that replaces it */
+    if (ai_server_fd >= 0) {
+        fds[n].fd = ai_server_fd;
+        fds[n].events = POLLIN;
+        fds[n].revents = 0;
+        owner[n++] = NULL;
+    }
+    /* Finished async saves, behind the listening socket */
+    if (wake >= 0) {
+        fds[n].fd = wake;
+        fds[n].events = POLLIN;
+        fds[n].revents = 0;
+        owner[n++] = NULL;
+    }
+    if (n == 0 || poll(fds, n, timeout_ms) <= 0) return;
 
-    if (select(ai_server_fd + 1, &fds, NULL, NULL, &tv) > 0) {
-        int client = accept(ai_server_fd, NULL, NULL);
-        if (client >= 0) {
-            if (ai_client_fd >= 0) {
-                close(ai_client_fd);  /* Only one client at a time */
+    for (i = 0; i < n; i++) {
+        AI_Client *c = owner[i];
+        if (c == NULL) {
+            if (fds[i].fd == wake) {
+                if (fds[i].revents & POLLIN) report_saves();
             }
-            ai_client_fd = client;
-            /* Set non-blocking */
-            int flags = fcntl(ai_client_fd, F_GETFL, 0);
-            fcntl(ai_client_fd, F_SETFL, flags | O_NONBLOCK);
-            Log_print("AI: Client connected");
-            ai_paused = 1;  /* Pause and wait for commands */
+            else if (fds[i].revents & POLLIN) accept_client();
+            continue;
         }
+        if (fds[i].revents & POLLOUT) flush_output(c);
+        if (fds[i].revents & (POLLIN | POLLHUP | POLLERR)) fill_input(c);
     }
 }
 
@@ -610,6 +6594,9 @@ static void check_connections(void) {
 int AI_Initialise(int *argc, char *argv[]) {
     int i, j;
 
+    ai_stats_time = Util_time();
+    ai_stats_clock = clock();
+
     for (i = j = 1; i < *argc; i++) {
         int match = FALSE;
 
@@ -621,15 +6608,105 @@ int AI_Initialise(int *argc, char *argv[]) {
             strncpy(AI_socket_path, argv[++i], sizeof(AI_socket_path) - 1);
             match = TRUE;
         }
+        else if (strcmp(argv[i], "-ai-listen") == 0 && i + 1 < *argc) {
+            Util_strlcpy(ai_listen, argv[++i], sizeof(ai_listen));
+            match = TRUE;
+        }
         else if (strcmp(argv[i], "-ai-debug-port") == 0 && i + 1 < *argc) {
             AI_debug_port = strtol(argv[++i], NULL, 0);
             match = TRUE;
         }
+        else if (strcmp(argv[i], "-ai-debug-buffer") == 0 && i + 1 < *argc) {
+            long size = strtol(argv[++i], NULL, 0);
+            if (size < AI_DEBUG_MIN_SIZE || size > AI_DEBUG_MAX_SIZE)
+                Log_print("AI: Invalid -ai-debug-buffer %s", argv[i]);
+            else
+                ai_debug.size = (ULONG)size;
+            match = TRUE;
+        }
+        else if (strcmp(argv[i], "-ai-shm") == 0 && i + 1 < *argc) {
+            strncpy(ai_shm_name, argv[++i], sizeof(ai_shm_name) - 1);
+            AI_enabled = TRUE;
+            match = TRUE;
+        }
+        else if (strcmp(argv[i], "-ai-shm-audio") == 0) {
+            ai_shm_audio = TRUE;
+            match = TRUE;
+        }
+        else if (strcmp(argv[i], "-ai-rewind") == 0 && i + 1 < *argc) {
+            char *end;
+            int depth = strtol(argv[++i], &end, 0);
+            int stride = *end == ',' ? strtol(end + 1, NULL, 0) : 1;
+            if (!AI_REWIND_Configure(depth, stride))
+                Log_print("AI: Invalid -ai-rewind %s", argv[i]);
+            match = TRUE;
+        }
+        else if (strcmp(argv[i], "-ai-boot-cache") == 0 && i + 1 < *argc) {
+            if (!AI_BOOTCACHE_Configure(strtol(argv[++i], NULL, 0)))
+                Log_print("AI: Invalid -ai-boot-cache %s", argv[i]);
+            match = TRUE;
+        }
+        else if (strcmp(argv[i], "-ai-trace") == 0 && i + 1 < *argc) {
+            if (!AI_TRACE_Start(argv[++i]))
+                Log_print("AI: Cannot create the trace file %s", argv[i]);
+            match = TRUE;
+        }
+        else if (strcmp(argv[i], "-ai-timeline") == 0 && i + 1 < *argc) {
+            if (!AI_TIMELINE_Start(argv[++i], 0))
+                Log_print("AI: Cannot create the timeline file %s", argv[i]);
+            match = TRUE;
+        }
+        else if (strcmp(argv[i], "-ai-forkserver") == 0 && i + 1 < *argc) {
+            char *comma;
+            Util_strlcpy(ai_fork_path, argv[++i], sizeof(ai_fork_path));
+            comma = strchr(ai_fork_path, ',');
+            if (comma != NULL) {
+                *comma = '\0';
+                ai_fork_frames = strtol(comma + 1, NULL, 0);
+                if (ai_fork_frames < 1)
+                    ai_fork_frames = 1;
+            }
+            AI_enabled = TRUE;
+            match = TRUE;
+        }
+        else if (strcmp(argv[i], "-ai-pool") == 0 && i + 1 < *argc) {
+            char *end;
+            int size = strtol(argv[++i], &end, 0);
+            if (size < 1 || size > AI_FORKSERVER_MAX_SLOTS || (*end && strcmp(end, ",pin") != 0))
+                Log_print("AI: Invalid -ai-pool %s", argv[i]);
+            else
+                AI_FORKSERVER_SetPool(size, *end != '\0');
+            match = TRUE;
+        }
         else if (strcmp(argv[i], "-ai-run") == 0) {
             AI_enabled = TRUE;
             ai_paused = 0;  /* Don't start paused */
             match = TRUE;
         }
+        else if (strcmp(argv[i], "-frame-timing") == 0) {
+            AI_SetFrameTiming(TRUE);
+            match = TRUE;
+        }
+        else if (strcmp(argv[i], "-perf-counters") == 0) {
+            if (!hw_set(TRUE))
+                Log_print("AI: Hardware counters are not available");
+            match = TRUE;
+        }
+        else if (strcmp(argv[i], "-help") == 0) {
+            Log_print("\t-frame-timing    Time every frame by stage (CPU, ANTIC, sound, display...)");
+            Log_print("\t                 for the speed display, the AI stats command and -benchmark");
+            Log_print("\t-perf-counters   Also count host cycles, instructions and cache misses by stage");
+            Log_print("\t-ai-listen [host]:port  Serve AI clients over TCP instead of the Unix");
+            Log_print("\t                 socket; vsock:[cid:]port for clients outside a VM");
+            Log_print("\t-ai-debug-buffer <bytes>  Size of the ring the debug port output is kept");
+            Log_print("\t                 in until read (default 65536)");
+            Log_print("\t-ai-timeline <file>  Record a timeline of every thread's work, written as");
+            Log_print("\t                 Chrome trace JSON at exit");
+            Log_print("\t-ai-forkserver <path>[,frames]  Run the frames (default 1), then fork an");
+            Log_print("\t                 AI instance for each spawn request on path");
+            Log_print("\t-ai-pool <n>[,pin]  Keep n instances forked for acquire requests to the");
+            Log_print("\t                 fork server, each on a core of its own with ,pin");
+        }
 
         if (!match) {
             argv[j++] = argv[i];
@@ -637,11 +6714,18 @@ int AI_Initialise(int *argc, char *argv[]) {
     }
     *argc = j;
 
-    if (AI_enabled) {
+    /* A fork server's children open the socket and segment */
+    if (AI_enabled && !ai_fork_path[0]) {
         if (!setup_server_socket()) {
             AI_enabled = FALSE;
             return FALSE;
         }
+        if (ai_shm_name[0] && !AI_SHM_Open(ai_shm_name, ai_shm_audio)) {
+            AI_Exit();
+            AI_enabled = FALSE;
+            return FALSE;
+        }
+        update_audio_observers();
         Log_print("AI: Interface enabled");
     }
 
@@ -650,45 +6734,275 @@ int AI_Initialise(int *argc, char *argv[]) {
 
 /* Cleanup */
 void AI_Exit(void) {
-    if (ai_client_fd >= 0) {
-        close(ai_client_fd);
-        ai_client_fd = -1;
+    int i;
+    for (i = 0; i < AI_MAX_CLIENTS; i++) {
+        if (ai_clients[i] != NULL) close_client(ai_clients[i]);
     }
+    reap_clients();
     if (ai_server_fd >= 0) {
         close(ai_server_fd);
         ai_server_fd = -1;
+        if (!ai_listen[0])
+            unlink(AI_socket_path);
+    }
+    AI_SHM_Close();
+    AI_TRACE_Stop(NULL);
+    AI_TIMELINE_Stop(NULL);
+    AI_SAVER_Exit();
+    hw_close();
+}
+
+/* -ai-forkserver: serve spawn requests until one forks this process, then
+   carry on in the child as an AI instance of its own. Only this thread
+   is forked, so the sound worker and the renderer are stopped first and
+   started again in each child. */
+static void fork_server(void) {
+    int result;
+
+#ifdef NETSIO
+    if (netsio_enabled) {
+        Log_print("AI: NetSIO cannot be shared with the fork server's children");
+        Atari800_ErrExit();
+        exit(1);
+    }
+#endif
+    if (POKEYSND_threaded) {
+        /* The worker stops with the next frame's sound */
+        ai_fork_sound_thread = TRUE;
+        POKEYSND_threaded = FALSE;
+        return;
     }
-    unlink(AI_socket_path);
+#ifdef ANTIC_RENDER_THREAD
+    if (ANTIC_render_thread) {
+        /* The renderer stops with the next frame */
+        ai_fork_render_thread = TRUE;
+        ANTIC_render_thread = FALSE;
+        return;
+    }
+#endif
+    result = AI_FORKSERVER_Serve(ai_fork_path, AI_socket_path, sizeof(AI_socket_path),
+                                 ai_listen, sizeof(ai_listen), ai_shm_name, sizeof(ai_shm_name));
+    if (result <= 0) {
+        if (result < 0)
+            Atari800_ErrExit();
+        else
+            Atari800_Exit(FALSE);
+        exit(result < 0 ? 1 : 0);
+    }
+    /* Each child listens where the fork server said */
+    ai_fork_path[0] = '\0';
+    POKEYSND_threaded = ai_fork_sound_thread;
+#ifdef ANTIC_RENDER_THREAD
+    ANTIC_render_thread = ai_fork_render_thread;
+#endif
+    if (!setup_server_socket()
+        || (ai_shm_name[0] && !AI_SHM_Open(ai_shm_name, ai_shm_audio))) {
+        AI_FORKSERVER_Ready(FALSE);
+        _exit(1);
+    }
+    update_audio_observers();
+    AI_FORKSERVER_Ready(TRUE);
+    ai_stats_time = Util_time();
+    ai_stats_clock = clock();
+    Log_print("AI: Spawned with pid %d", (int)getpid());
+    /* Hold the forked frame for the client the child was spawned for */
+    while (count_clients() == 0)
+        poll_events(-1);
 }
 
 /* Process AI commands each frame */
 void AI_Frame(void) {
-    static char cmd_buf[AI_BUFFER_SIZE];
+    int i, broke = FALSE;
 
     if (!AI_enabled) return;
 
-    check_connections();
+    if (ai_fork_path[0]) {
+        if (Atari800_nframes < ai_fork_frames) return;
+        fork_server();
+        if (ai_fork_path[0]) return;
+    }
+    if (!AI_FORKSERVER_Update(count_clients())) {
+        /* A pool instance whose lease is over: the fork server has a
+           fresh one to hand out instead */
+        Log_print("AI: Lease over, exiting");
+        Atari800_Exit(FALSE);
+        exit(0);
+    }
+
+    if (Atari800_nframes != ai_cycle_frame) {
+        ai_cycle_frame = Atari800_nframes;
+        cycle_sum_add(&ai_cycle_sum, &ANTIC_frame_cycles);
+        if (AI_profile != NULL)
+            cycle_sum_add(&ai_profile_cycle_sum, &ANTIC_frame_cycles);
+    }
+
+    AI_REWIND_Frame();
+    AI_DISCOVER_Frame();
+
+    /* Non-blocking check for new connections and client input */
+    poll_events(0);
+
+    /* Publish the frame just completed before any "run" reply goes out,
+       so a client woken by the reply sees the matching observation */
+    AI_SHM_Publish();
+    push_frame_events();
+
+    /* A breakpoint ends the run that hit it at the end of the frame */
+    if (ai_break_addr >= 0) {
+        AI_Client *c = ai_run_client != NULL ? ai_run_client : ai_controller;
+        char event[128];
+        snprintf(event, sizeof(event),
+            "{\"event\":\"breakpoint\",\"addr\":%d,\"frame\":%d,\"scanline\":%d,\"xpos\":%d}",
+            ai_break_addr, ai_break_frame, ai_break_ypos, ai_break_xpos);
+        if (c != NULL && c->fd >= 0) send_json(c, AI_BIN_EVENT_JSON, 0, event);
+        ai_break_addr = -1;
+        broke = TRUE;
+        if (ai_frames_to_run > 1) {
+            ai_run_frames -= ai_frames_to_run - 1;
+            ai_frames_to_run = 1;
+        }
+        else if (ai_frames_to_run == 0 && !ai_until_active && have_driver()) {
+            stop_streaming();
+            ai_paused = 1;
+        }
+    }
+
+    /* A run_until ends at the end of the frame its condition fired in */
+    if (ai_until_active) {
+        int clause;
+        ai_until_frames++;
+        clause = until_check();
+        until_clear_hits();
+        if (clause >= 0 || broke || ai_until_frames >= ai_until_max_frames) {
+            until_stop();
+            ai_paused = 1;
+            ai_cur = take_run_client();
+            until_reply(clause);
+            if (ai_batch_active) {
+                ai_cur = ai_batch_client;
+                batch_continue();
+            }
+            ai_cur = NULL;
+        }
+    }
+    ai_changes_frame = 0;
+
+    /* A "type" ends once the program has taken its last key */
+    if (ai_type.run && ai_frames_to_run > 1 && ai_type.pos == ai_type.n
+        && MEMORY_dGetByte(AI_TYPE_CH) == 0xff) {
+        ai_run_frames -= ai_frames_to_run - 1;
+        ai_frames_to_run = 1;
+    }
 
     /* If we were running frames, decrement and check */
     if (ai_frames_to_run > 0) {
         ai_frames_to_run--;
         if (ai_frames_to_run == 0) {
             ai_paused = 1;
-            snprintf(ai_response, sizeof(ai_response),
-                "{\"status\":\"ok\",\"frames_run\":1}");
-            AI_SendResponse(ai_response);
+            ai_cur = take_run_client();
+            if (ai_travel.kind != AI_TRAVEL_NONE)
+                travel_next();  /* which may start another stretch */
+            else if (ai_rewind_keyframe >= 0)
+                rewind_reply();
+            else if (ai_boot_run)
+                boot_reply();
+            else if (ai_type.run)
+                type_reply();
+            else
+                run_reply();
+            if (ai_paused) {
+                AI_timing = AI_frame_timing;
+                AI_unthrottled = FALSE;
+                if (ai_batch_active) {
+                    ai_cur = ai_batch_client;
+                    batch_continue();
+                }
+            }
+            ai_cur = NULL;
         }
     }
 
-    /* Process commands while paused */
-    while (ai_paused && ai_client_fd >= 0) {
-        if (read_command(cmd_buf, sizeof(cmd_buf)) > 0) {
-            process_command(cmd_buf);
-        } else {
-            /* No command available, wait a bit */
-            usleep(1000);  /* 1ms */
+    /* The end of a lockstep step: all players see it at once */
+    if (ai_lockstep.frames_left > 0 && --ai_lockstep.frames_left == 0) {
+        ai_paused = 1;
+        ai_lockstep.step++;
+        lockstep_push();
+    }
+
+    /* Observers only query, so they are served while the machine runs
+       (which it also does, paused or not, when nobody can drive it).
+       While free-running every client is, so input can be streamed in. */
+    if (!ai_paused || !have_driver()) {
+        int all = ai_stream_client != NULL && ai_stream_client->sub_mode == AI_SUB_FREE;
+        for (i = 0; i < AI_MAX_CLIENTS; i++) {
+            AI_Client *c = ai_clients[i];
+            if (c != NULL && (c->observer || all)) {
+                while (serve_client(c))
+                    ;
+            }
+            /* The client a run is for has its queries sent after the run
+               answered now; anything else waits for the run's reply */
+            else if (c != NULL && c == ai_run_client && !ai_paused
+                     && !(ai_batch_active && c == ai_batch_client)) {
+                while (next_overlaps_run(c) && serve_client(c))
+                    ;
+            }
+        }
+    }
+
+    /* Process commands while paused, sleeping in poll() between them */
+    while (ai_paused && have_driver()) {
+        int served = FALSE;
+        for (i = 0; i < AI_MAX_CLIENTS && ai_paused; i++) {
+            if (ai_clients[i] != NULL && serve_client(ai_clients[i])) served = TRUE;
         }
-        check_connections();
+        lockstep_check();
+        if (!served && ai_paused) {
+            /* No complete command buffered - block until more arrives,
+               or a lockstep step times out */
+            poll_events(lockstep_wait_ms());
+        }
+    }
+
+    /* The input a "run" gave the frame about to run */
+    if (ai_frames_to_run > 0 && ai_run_ninputs > 0) {
+        int k = ai_run_frames - ai_frames_to_run;
+        if (k < ai_run_ninputs) frame_input_apply(&ai_run_inputs[k]);
+    }
+    timeline_arm();
+    if (ai_type.run) {
+        if (ai_frames_to_run > 0) type_next();
+        else type_stop();
+    }
+    rewind_input();
+}
+
+/* Will anyone look at the frame about to run? Called before ANTIC_Frame() */
+static int frame_observed(void) {
+    int i, frame = Atari800_nframes + 1;  /* its number once complete */
+
+    if (!AI_enabled || ai_shm_name[0] || ai_until_active || ai_steps_to_run > 0)
+        return TRUE;
+    /* Running on its own, not in a counted run: queries may come any time */
+    if (ai_frames_to_run == 0 && ai_stream_client == NULL) return TRUE;
+    if (ai_frames_to_run == 1) return TRUE;  /* last frame of a run */
+    for (i = 0; i < AI_MAX_CLIENTS; i++) {
+        AI_Client *c = ai_clients[i];
+        if (c != NULL && c->fd >= 0 && c->sub_every > 0
+            && c->sub_screen != AI_SUB_SCREEN_NONE && frame % c->sub_every == 0)
+            return TRUE;
+    }
+    return FALSE;
+}
+
+int AI_RenderFrame(void) {
+    switch (AI_render_policy) {
+    case AI_RENDER_OBSERVED:
+        return frame_observed();
+    case AI_RENDER_EVERY:
+        return (Atari800_nframes + 1) % AI_render_every == 0;
+    default:
+        return TRUE;
     }
 }
 
@@ -715,5 +7029,10 @@ void AI_ApplyInput(void) {
         if (AI_trig_override[i] >= 0) {
             GTIA_TRIG[i] = AI_trig_override[i];
         }
+
+        /* The 5200 reads its sticks through the pots, unless set there */
+        if (Atari800_machine_type == Atari800_MACHINE_5200 && AI_joy_override[i] >= 0
+            && INPUT_pot_override[2 * i] < 0 && INPUT_pot_override[2 * i + 1] < 0)
+            INPUT_Stick5200(i, AI_joy_override[i]);
     }
 }
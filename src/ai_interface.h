@@ -23,6 +23,107 @@
 #define AI_SOCKET_PATH "/tmp/atari800_ai.sock"
 #define AI_BUFFER_SIZE 65536
 #define AI_MAX_RESPONSE 1048576  /* 1MB max response */
+#define AI_REQ_ID_SIZE 64         /* longest "id" echoed, as JSON text */
+#define AI_MAX_CLIENTS 8         /* concurrent connections */
+
+/* Binary framed protocol (negotiated per connection, see "protocol" below).
+ *
+ * Every frame in either direction starts with a 12-byte header, all
+ * multi-byte fields little-endian:
+ *   offset 0  UBYTE  magic   (AI_BIN_MAGIC)
+ *   offset 1  UBYTE  opcode  (AI_BIN_*; responses echo the request opcode)
+ *   offset 2  UBYTE  status  (requests: 0; responses: AI_BIN_STATUS_*)
+ *   offset 3  UBYTE  flags   (AI_BIN_FLAG_*; requests: 0)
+ *   offset 4  ULONG  tag     (chosen by the client, echoed in the response)
+ *   offset 8  ULONG  length  (payload bytes following the header)
+ * Error responses carry the message text as payload.
+ *
+ * Opcodes 0x40-0x7E with tag 0 are events pushed by the server; they may
+ * arrive between any two responses, so clients should not use tag 0.
+ */
+#define AI_BIN_MAGIC       0xA8
+#define AI_BIN_HEADER_SIZE 12
+
+#define AI_BIN_STATUS_OK    0
+#define AI_BIN_STATUS_ERROR 1
+
+/* The payload is ULONG size, then an LZ4 block that decompresses to size
+   bytes of the real payload. Sent only on connections that asked for it
+   (see "protocol"), for payloads it makes smaller. */
+#define AI_BIN_FLAG_LZ4 0x01
+
+#define AI_BIN_PING       0x00  /* -> empty payload */
+#define AI_BIN_JSON       0x01  /* JSON command text -> JSON response text */
+#define AI_BIN_RUN        0x02  /* ULONG frames, [UBYTE unthrottled] -> ULONG frames_run,
+                                   ULONG cycles, ULONG wall_us, AI_TIME_STAGES x ULONG stage_us,
+                                   a float32 per feature (see "features") */
+#define AI_BIN_PEEK       0x03  /* UWORD addr, ULONG len -> len raw bytes */
+#define AI_BIN_POKE       0x04  /* UWORD addr, raw bytes -> empty payload */
+#define AI_BIN_SCREEN_RAW 0x05  /* -> UWORD width, UWORD height, width*height bytes */
+#define AI_BIN_CPU        0x06  /* -> UWORD pc, UBYTE a, x, y, sp, p */
+#define AI_BIN_JOYSTICK   0x07  /* UBYTE port, UBYTE stick (INPUT_STICK_*), UBYTE fire -> empty */
+#define AI_BIN_KEY        0x08  /* SWORD code (AKEY_*), UBYTE shift -> empty */
+#define AI_BIN_CONSOL     0x09  /* UBYTE INPUT_CONSOL_* bits to press -> empty */
+#define AI_BIN_ACK        0x0A  /* [ULONG frame] acknowledge frame records -> empty */
+#define AI_BIN_SCREEN_DELTA 0x0B  /* ULONG base frame -> ULONG frame, UBYTE kind (AI_SUB_SCREEN_*), data */
+#define AI_BIN_OBSERVATION 0x0C  /* UWORD width, height, UBYTE format (AI_OBS_*), [UWORD x1, y1, x2, y2]
+                                    -> UWORD width, height, UBYTE format, width*height bytes */
+#define AI_BIN_PEEK_MULTI  0x0D  /* up to 256 x (UWORD addr, ULONG len) -> the ranges' bytes back to back */
+#define AI_BIN_PEEK_BANK   0x0E  /* UBYTE kind (MEMORY_BANK_*), UWORD bank, UWORD offset, ULONG len
+                                    -> len raw bytes */
+#define AI_BIN_SCREENSHOT  0x0F  /* [UBYTE zlib level 0-9, [UBYTE format 0 PNG, 1 PCX]]
+                                    -> the image file's bytes, as the screenshot command */
+#define AI_BIN_COVERAGE    0x10  /* [UBYTE clear] -> ULONG count, the AI_COVERAGE_BYTES bitmap */
+#define AI_BIN_HISTORY     0x11  /* [ULONG max] -> ULONG count, ULONG branches, the newest count
+                                    AI_HISTORY_Rec records, oldest first */
+#define AI_BIN_STATE_SAVE  0x12  /* -> the state file, of the fast codec */
+#define AI_BIN_STATE_LOAD  0x13  /* a state file of the fast or raw codec -> empty */
+#define AI_BIN_HASH        0x14  /* -> 64-bit screen hash, 64-bit state hash, see "hash" */
+#define AI_BIN_STATE_GET   0x15  /* [ULONG base id] -> ULONG id, UBYTE kind (AI_SUB_SCREEN_FULL:
+                                    fast state file, _DELTA: delta), data; see "state_get" */
+#define AI_BIN_STATE_PUT   0x16  /* a state file or a delta -> ULONG id, see "state_put" */
+#define AI_BIN_HEATMAP     0x17  /* UBYTE kind (AI_HEATMAP_*), UBYTE map (0 the CPU's, 1 + MEMORY_BANK_*),
+                                    [ULONG start, [ULONG length]] -> ULONG entries, start, length,
+                                    the counters as varints; see "heatmap" */
+#define AI_BIN_EVENT_FRAME 0x40  /* pushed frame record, see below */
+#define AI_BIN_EVENT_JSON  0x41  /* pushed JSON event text, e.g. save_state done */
+#define AI_BIN_PROTOCOL_JSON 0x7F  /* switch the connection back to JSON -> empty */
+
+/* Frame record (AI_BIN_EVENT_FRAME payload):
+ *   ULONG frame, ULONG dropped, UWORD pc, UBYTE a, x, y, sp, p,
+ *   UBYTE naddrs, naddrs memory values (subscribed "addrs", in order),
+ *   UBYTE screen kind (AI_SUB_SCREEN_*), ULONG screen bytes, screen data.
+ * A full screen is Screen_WIDTH * Screen_HEIGHT pixels. A delta is a list
+ * of spans, each UWORD row, UWORD x, UWORD len and len pixels, relative to
+ * the screen of the previous record received; it is empty if nothing
+ * changed. The first record of a delta subscription is a full screen.
+ * Subscriptions with audio append UBYTE audio (AI_SUB_AUDIO_* bits), then
+ *   with AI_SUB_AUDIO_ENV: UBYTE channels, channels x AI_AUDIO_ENV_SIZE
+ *     bytes (see AI_AudioEnvelopes());
+ *   with AI_SUB_AUDIO_PCM: UWORD rate, UBYTE channels, UBYTE sample bytes,
+ *     ULONG length, the frame's samples (unsigned 8-bit or signed 16-bit
+ *     little-endian, channels interleaved). At a subscribed "rate" they
+ *     are all the samples converted since the previous record.
+ * Subscriptions with debug append the audio byte (0 without audio), then
+ *   ULONG bytes the debug port ring dropped, ULONG length and the debug
+ *   port records taken since the previous record: each ULONG frame,
+ *   UWORD count and count bytes written to the port in that frame.
+ */
+#define AI_SUB_SCREEN_NONE  0
+#define AI_SUB_SCREEN_FULL  1
+#define AI_SUB_SCREEN_DELTA 2
+
+#define AI_SUB_AUDIO_PCM 0x01
+#define AI_SUB_AUDIO_ENV 0x02
+
+/* Tone of each POKEY channel at the end of the frame, AI_AUDIO_ENV_SIZE
+   bytes per channel: UWORD frequency in Hz (0 for volume-only output and
+   the low half of a 16-bit pair, capped at 65535), UBYTE volume (0-15),
+   UBYTE AUDC >> 4 (distortion and volume-only bits). Fills 4 channels, or
+   8 with stereo POKEYs, and returns how many. */
+#define AI_AUDIO_ENV_SIZE 4
+#define AI_AUDIO_ENV_MAX  8
+int AI_AudioEnvelopes(UBYTE *out);
 
 /* Initialize AI interface - call from main() */
 int AI_Initialise(int *argc, char *argv[]);
@@ -41,16 +142,132 @@ int AI_IsPaused(void);
  * All commands are JSON objects with a "cmd" field.
  * Responses are JSON objects with "status" ("ok" or "error") and data.
  *
+ * A client need not wait for a reply before sending the next command;
+ * each connection's commands are served in order. A command with an "id"
+ * (a number or a string, up to AI_REQ_ID_SIZE characters) gets it back
+ * as the first member of its reply, e.g. {"id": 7, "status": "ok", ...},
+ * so a client with several in flight can match them up.
+ *
+ * Replies can then come out of order: while a "run" or "run_until" of a
+ * client goes on, the queries it sends after it (peek, cpu, stats,
+ * screen and the like, and the binary reads) are answered between
+ * frames, ahead of the run's reply. Any other command waits for the run,
+ * and so does everything sent after it. An async "save_state" done event
+ * carries the id of the save_state too.
+ *
  * === CONTROL ===
  * {"cmd": "ping"}
  *   -> {"status": "ok", "msg": "pong"}
  *
  * {"cmd": "load", "path": "/path/to/program.xex"}
  *   -> {"status": "ok"} or {"status": "error", "msg": "..."}
+ *   With "boot_frames": N the machine also runs N frames unthrottled, as
+ *   "reset" does with it, and the boot is cached the same way.
+ *   With "direct": true a DOS binary (XEX) is loaded into the running
+ *   machine instead, without rebooting: its segments are copied at once
+ *   and the CPU goes on at its INIT or RUN address, as after the boot
+ *   sector of the normal load. The OS must be up, e.g. after a "reset"
+ *   with boot_frames; that reset and a direct load are then equivalent
+ *   to a normal load, minus the boot time.
  *
- * {"cmd": "run", "frames": 60}
- *   Run for N frames (default 1), then pause and respond
- *   -> {"status": "ok", "frames_run": 60}
+ * {"cmd": "run", "frames": 60, "unthrottled": false}
+ *   Run for N frames (default 1), then pause and respond. With unthrottled
+ *   the run skips Atari800_Sync() and sound sync, going as fast as the host
+ *   can; otherwise it is paced like normal emulation.
+ *   "cycles" is CPU clock cycles elapsed, "wall_ms" host time for the run
+ *   and "speed" emulated time over wall time. "time_ms" splits the host
+ *   time by stage; "antic" includes the CPU, which ANTIC drives, unless
+ *   frame timing is on (see "stats"), when "cpu" has it. "ai" is command
+ *   handling, "record" video recording and "host" the time between
+ *   frames, spent by the platform drawing the screen.
+ *   -> {"status": "ok", "frames_run": 60, "cycles": 1788480,
+ *       "wall_ms": 1002.4, "emulated_ms": 1001.3, "speed": 0.999,
+ *       "unthrottled": false, "time_ms": {"input": 0.2, "antic": 41.8,
+ *       "pokey": 0.1, "sound": 0.9, "sync": 958.7, "cpu": 0.0,
+ *       "ai": 0.3, "record": 0.0, "host": 0.4}}
+ *   With features set (see "features") the reply ends with their values,
+ *   "features": [...].
+ *
+ * {"cmd": "run", "frames": 3, "inputs": [{"joy": [11]}, {"fire": [1]}, {}]}
+ *   Run with input given per frame, as for "input": frame i of the run
+ *   gets inputs[i] and the last one holds for frames beyond the list,
+ *   so a whole action sequence goes in one command. More inputs than
+ *   frames is an error.
+ *
+ * {"cmd": "run", "frames": 3, "timeline": [{"frame": 0, "line": 120,
+ *  "joy": [7]}, {"frame": 1, "line": 8, "fire": [1]}, {"frame": 2,
+ *  "line": 200, "fire": [0]}]}
+ *   Run with input that changes at given scan lines: each event holds
+ *   the fields of an "input" and the frame of the run (from 0) and the
+ *   line (0-261, 0-311 on PAL) at whose start it takes effect. Events
+ *   must be in order of frame and line. They apply after the "inputs"
+ *   of their frame and hold until changed, like them. While input is
+ *   recorded or played back they wait for the next frame; rewinding
+ *   replays the input as it was at the start of each frame only.
+ *
+ * {"cmd": "run_until", "until": "mem[$D4] < start || pc == $E459",
+ *  "max_frames": 3600}
+ *   Run until the condition holds, checked at the end of every frame, or
+ *   until max_frames (default 3600) frames have run. The condition is one
+ *   or more clauses joined by "||", each made of terms joined by "&&":
+ *     mem[ADDR] OP VALUE   memory byte compare; VALUE may be "start",
+ *                          the byte's value when run_until began
+ *     pc == ADDR           the CPU reached ADDR during the frame (watched
+ *                          at instruction granularity)
+ *     frames OP N          frames run so far
+ *     changed              a watched byte changed during the frame
+ *   OP is ==, !=, <, <=, > or >=; numbers are decimal, 0x.. or $...
+ *   Up to 16 terms. The machine pauses at the end of the frame in which
+ *   the condition fired; "pc_hit" tells where within it a PC term fired.
+ *   -> {"status": "ok", "fired": true, "clause": 0, "frame": 5012,
+ *       "frames_run": 187, "pc_hit": {"pc": 0xE459, "frame": 5012,
+ *       "scanline": 112, "xpos": 40}}
+ *      ("fired": false when max_frames ran out)
+ *
+ * {"cmd": "render", "mode": "observed", "every": 4}
+ *   Choose which frames are drawn: "always" (default), "observed" (only
+ *   frames a reply, subscription or shared memory will show) or "every"
+ *   (frames whose number is a multiple of every). A "screen" query taken
+ *   mid-run under the other modes may show an older frame.
+ *   -> {"status": "ok", "mode": "observed", "every": 4}
+ *
+ * {"cmd": "rewind_config", "depth": 60, "stride": 30}
+ *   Keep depth keyframes (0, the default, turns rewind off), one every
+ *   stride frames (default 1), plus the input of every frame since the
+ *   oldest. Older keyframes are kept as run-length packed differences from
+ *   the next, so the history costs little more than one state. Omitted
+ *   values stay the same; changing either discards the history, as does
+ *   load_state. "-ai-rewind depth[,stride]" enables it from the start.
+ *   -> {"status": "ok", "depth": 60, "stride": 30, "oldest": 1200,
+ *       "bytes": 734512}
+ *
+ * {"cmd": "rewind", "frames": 45}
+ *   Go back N frames (default 1): restore the newest keyframe at or before
+ *   the target, drop the keyframes after it, and re-simulate the frames in
+ *   between with the recorded joystick, key and console input.
+ *   -> {"status": "ok", "frame": 3015, "keyframe": 3000, "replayed": 15}
+ *      or {"status": "error", "msg": "...", "oldest": 1200}
+ *
+ * {"cmd": "reverse_step", "frames": 1}
+ *   The same as rewind
+ *
+ * {"cmd": "last_write", "addr": 0x0080}
+ *   Find the last change of the byte at addr within the rewind history:
+ *   the keyframe intervals are replayed newest first, watching it, until
+ *   one has a change, then the machine is re-simulated back to this frame.
+ *   searched_from is the oldest frame replayed.
+ *   -> {"status": "ok", "found": true, "frame": 3015, "searched_from": 2970,
+ *       "replayed": 90, "us": 2100, "write": {"addr": 128, "old": 3, "value": 2,
+ *       "pc": 8244, "frame": 2991, "scanline": 248, "xpos": 30}}
+ *
+ * {"cmd": "reverse_continue"}
+ *   Go back to the end of the latest frame before this one in which a
+ *   breakpoint (with its condition) fired, searching the rewind history
+ *   as last_write does; found is false, and the frame this one, if none
+ *   did
+ *   -> {"status": "ok", "found": true, "frame": 2991, "searched_from": 2970,
+ *       "replayed": 66, "us": 1500, "breakpoint": {"addr": 8244, "frame": 2991,
+ *       "scanline": 248, "xpos": 30}}
  *
  * {"cmd": "step", "instructions": 1}
  *   Single-step N CPU instructions (default 1)
@@ -63,6 +280,100 @@ int AI_IsPaused(void);
  *   Cold reset the machine
  *   -> {"status": "ok"}
  *
+ * {"cmd": "reset", "boot_frames": 600}
+ *   Cold reset, then run N frames unthrottled. The state reached is kept
+ *   in the boot cache, keyed by the machine type and settings, OS, BASIC
+ *   and cartridge images, the contents of the disks (and of the program,
+ *   for "load"), the input held and N; the next such boot restores it
+ *   without emulating the frames. A disk written to since it was mounted,
+ *   or a program still loading after N frames, keeps the boot uncached.
+ *   -> {"status": "ok", "frames": 600, "cached": false, "stored": true}
+ *      or {"status": "ok", "frames": 600, "cached": true}
+ *
+ * {"cmd": "boot_cache", "entries": 16, "clear": false}
+ *   Keep at most entries boots (default 16, 0 turns the cache off; a
+ *   change empties it, as does clear). "-ai-boot-cache entries" sets it
+ *   from the start.
+ *   -> {"status": "ok", "entries": 3, "max": 16, "bytes": 467670,
+ *       "hits": 41, "misses": 3}
+ *
+ * {"cmd": "quick_boot", "enable": true, "clear": false}
+ *   Turn quick boot (-quick-boot) on or off: a cold start of a setup
+ *   seen before skips the OS's memory test and clearing, reading back the
+ *   state the OS had when it first called SIOV, whatever disk or program
+ *   is booted. entries is the setups kept.
+ *   -> {"status": "ok", "enabled": true, "entries": 1}
+ *
+ * {"cmd": "batch", "stop_on_error": false,
+ *  "commands": [{"cmd": "joystick", ...}, {"cmd": "run", "frames": 4}, ...]}
+ *   Run the sub-commands in order and answer once with all their replies.
+ *   A "run" inside the batch suspends it until the frames are done.
+ *   With stop_on_error the batch ends at the first failing sub-command.
+ *   -> {"status": "ok", "count": 6, "errors": 0, "results": [{...}, ...]}
+ *      or {"status": "error", ..., "failed_index": 2, "results": [...]}
+ *
+ * {"cmd": "protocol", "mode": "binary", "compress": "none"}
+ *   Switch this connection to the binary framed protocol (AI_BIN_*).
+ *   The reply is still JSON; every later frame uses the binary header.
+ *   With compress "lz4" the server's larger payloads (frame records,
+ *   screens, memory) come compressed, see AI_BIN_FLAG_LZ4; worth it when
+ *   the client is across a network (-ai-listen).
+ *   -> {"status": "ok", "mode": "binary", "version": 1, "compress": "none"}
+ *
+ * === CLIENTS ===
+ * Up to AI_MAX_CLIENTS connections are served at once. One of them is the
+ * controller; only it may send commands that change the machine (run,
+ * input, poke, load, ...). Queries (ping, screen_*, peek, cpu, chip
+ * registers, ...) are open to every client. The first client to connect
+ * while nobody is in control becomes the controller and pauses emulation.
+ * Any other client takes control by sending a control command, unless it
+ * declared itself an observer or the controller holds exclusive control.
+ * Observers are also served while the machine runs.
+ *
+ * {"cmd": "role", "role": "observer"}
+ * {"cmd": "role", "role": "controller", "exclusive": true}
+ *   Declare this connection's role; without "role" just report it.
+ *   -> {"status": "ok", "role": "controller", "exclusive": true, "clients": 2}
+ *
+ * {"cmd": "subscribe", "every": 1, "mode": "observe", "screen": "none",
+ *  "addrs": [53279, 1536], "window": 0, "audio": "none", "rate": 0,
+ *  "quality": 2, "debug": false}
+ *   Push a frame record every N frames (default 1) without being asked.
+ *   mode "observe" reports frames run anyway; "free" (needs control) lets
+ *   the machine free-run while every client's commands, input included,
+ *   are served between frames; "lockstep" (needs control) runs until
+ *   "window" records are unacknowledged, then holds the machine until an
+ *   "ack". screen is "none", "full" or "delta" (see the frame record);
+ *   addrs lists up to 64 memory bytes to include. Outside lockstep a
+ *   record is skipped, and counted in "dropped", while "window" records
+ *   (if nonzero) are unacknowledged or the client is behind on reading.
+ *   "run" and "pause" end free-running and lockstep. audio is "none",
+ *   "pcm" (the samples the frame produced; needs sound output enabled),
+ *   "env" (per-channel POKEY tone, see AI_AudioEnvelopes()) or "both".
+ *   PCM comes at the output rate unless "rate" (1000-65535 Hz) asks for
+ *   another; the samples are then converted with a band-limited filter
+ *   of "quality" 0 (linear) to 3 (sharpest, default 2), and a record
+ *   carries everything since the previous one, up to a second's worth.
+ *   With debug, records take the debug port output out of its ring (see
+ *   debug_enable), up to 256 KB each; what no record was sent with stays.
+ *   -> {"status": "ok", "every": 1, "mode": "observe", "screen": "none",
+ *       "addrs": 2, "window": 0, "audio": "none", "rate": 0, "debug": false}
+ *   then  {"event": "frame", "frame": 1234, "paused": false, "pc": 0xE459,
+ *          "a": 0, "x": 0, "y": 0, "sp": 0xFF, "p": 0x30, "dropped": 0,
+ *          "mem": [0, 12], "screen_delta": "base64...",
+ *          "env": [[440, 8, 10], ...],
+ *          "pcm": {"rate": 44100, "channels": 1, "bits": 16,
+ *                  "data": "base64..."},
+ *          "debug_dropped": 0, "debug": [[1230, "base64..."], ...]} ...
+ *
+ * {"cmd": "ack", "frame": 1234}
+ *   Acknowledge the frame records up to this frame (default: all)
+ *   -> {"status": "ok", "unacked": 0}
+ *
+ * {"cmd": "unsubscribe"}
+ *   Stop the records; a free-running or lockstep machine pauses
+ *   -> {"status": "ok", "dropped": 0}
+ *
  * === INPUT ===
  * {"cmd": "key", "code": 33, "shift": false}
  *   Press a key (AKEY_* code)
@@ -72,13 +383,36 @@ int AI_IsPaused(void);
  *   Release all keys
  *   -> {"status": "ok"}
  *
+ * {"cmd": "type", "text": "10 PRINT \"HI\"\nRUN\n", "max_frames": 1000,
+ *  "unthrottled": true}
+ *   Type text, running until the program has taken the last key (or
+ *   max_frames, 600 + 8 per key by default). Each key is pressed for a
+ *   frame once the OS key code in CH ($02FC) is taken; a key repeated
+ *   waits for a release and the OS debounce (KEYDEL, $02F1), so a program
+ *   reading the keyboard gets about a key a frame. Letters in upper case
+ *   are typed with shift, newlines as RETURN; \r is skipped. Not on the
+ *   5200.
+ *   -> {"status": "ok", "typed": 15, "keys": 15, "frames_run": 19}
+ *
  * {"cmd": "joystick", "port": 0, "direction": "up", "fire": true}
  *   Set joystick state. direction: "up","down","left","right","center",
  *   "ul","ur","ll","lr"
  *   -> {"status": "ok"}
  *
  * {"cmd": "paddle", "port": 0, "value": 128}
- *   Set paddle position (0-228)
+ *   Set pot port (0-7) to value (0-228) until set again; -1 gives it
+ *   back to the machine's own input. On the 5200 pots 2i and 2i + 1 are
+ *   the x and y of controller i's analog stick.
+ *   -> {"status": "ok"}
+ *
+ * {"cmd": "input", "joy": [15, 11, 15, 15], "fire": [1, 0, 0, 0],
+ *  "pots": [114, 60, -1, -1, -1, -1, -1, -1], "key": 63, "fire2": false}
+ *   Set all controllers at once, e.g. the 5200's four sticks, triggers and
+ *   keypad. Groups left out keep their state. joy holds INPUT_STICK_*
+ *   values (15 centre, -1 no override), which the 5200 turns into full
+ *   stick deflections; pots, as in "paddle", take precedence there. key is
+ *   an AKEY_* code (AKEY_5200_* on the 5200), -1 for none; fire2 is the
+ *   5200's second button, the shift key on the others.
  *   -> {"status": "ok"}
  *
  * {"cmd": "consol", "start": false, "select": false, "option": false}
@@ -86,14 +420,49 @@ int AI_IsPaused(void);
  *   -> {"status": "ok"}
  *
  * === SCREEN ===
- * {"cmd": "screenshot", "format": "png", "path": "/tmp/screen.png"}
- *   Save screenshot to file
+ * {"cmd": "screenshot", "format": "png", "path": "/tmp/screen.png", "level": 1}
+ *   Save screenshot to file. level (0-9) is the zlib compression level,
+ *   -compression-level if omitted; 1 is several times faster than the
+ *   default 6 and little larger.
  *   -> {"status": "ok", "path": "/tmp/screen.png"}
  *
+ * {"cmd": "screenshot", "inline": true, "format": "png", "level": 1}
+ *   Return the screenshot's file contents instead of writing a file, with
+ *   nothing touching the disk. format is "png" (the default, needs libpng)
+ *   or "pcx" (the default without libpng). The image keeps the Atari
+ *   colour numbers as palette indices.
+ *   -> {"status": "ok", "format": "png", "bytes": 1862, "data": "<base64>"}
+ *
  * {"cmd": "screen_ascii"}
  *   Get screen as ASCII art (40x24 chars approximation)
  *   -> {"status": "ok", "width": 40, "height": 24, "data": ["line1", ...]}
  *
+ * {"cmd": "screen_delta", "base": 1234}
+ *   Screen changes since frame "base", the frame of the newest screen this
+ *   client has (from an earlier screen_delta). The server keeps the last
+ *   two screens it sent each client; if base is neither (or omitted) the
+ *   full screen is sent. data is base64 of a delta as in the frame record,
+ *   or of the whole screen when "full" is true.
+ *   -> {"status": "ok", "frame": 1240, "base": 1234, "full": false,
+ *       "width": 384, "height": 240, "bytes": 812, "data": "base64..."}
+ *
+ * {"cmd": "observation", "width": 84, "height": 84, "format": "gray",
+ *  "crop": [24, 0, 360, 240]}
+ *   Render the screen cropped (default: the visible area) and resized to
+ *   width x height (up to 384x240). format "gray" box-averages the luma of
+ *   the current palette; "index" samples Atari colour indices.
+ *   -> {"status": "ok", "frame": 1234, "width": 84, "height": 84,
+ *       "format": "gray", "data": "base64..."}
+ *
+ * {"cmd": "hash"}
+ *   64-bit hashes, as hex, of the visible area of the screen and of the
+ *   machine state (the CPU's memory but the hardware pages, the extended
+ *   RAM banks and the chip registers), for telling whether a screen or a
+ *   state was seen before. Pages of memory keep their hashes until they
+ *   change, so asking every frame is cheap.
+ *   -> {"status": "ok", "frame": 1234, "screen": "9ae16a3b2f90404f",
+ *       "state": "0b4a5c2e61d7f380"}
+ *
  * {"cmd": "screen_raw"}
  *   Get raw screen buffer (base64 encoded, 384x240 bytes)
  *   -> {"status": "ok", "width": 384, "height": 240, "data": "base64..."}
@@ -111,6 +480,77 @@ int AI_IsPaused(void);
  *   Dump memory range to binary file
  *   -> {"status": "ok", "bytes": 65536}
  *
+ * {"cmd": "peek_multi", "ranges": [[0x0080, 16], [0x0600, 512]]}
+ *   Read up to 256 ranges (no per-range cap, 262144 bytes in all) in one
+ *   request; the bytes come back to back, base64 encoded
+ *   -> {"status": "ok", "bytes": 528, "data": "<base64>"}
+ *
+ * {"cmd": "peek_bank", "kind": "xe", "bank": 1, "addr": 0x0000, "len": 256}
+ *   Read from an extended memory bank without switching it in: kind is
+ *   "xe" (16 KB banks; 0 is the base RAM at $4000, 1.. as in PORTB),
+ *   "axlon" (16 KB) or "mosaic" (4 KB); addr is the offset in the bank
+ *   -> {"status": "ok", "kind": "xe", "bank": 1, "addr": 0, "bytes": 256, "data": "<base64>"}
+ *
+ * {"cmd": "disasm", "addr": 0x2000, "count": 24, "end": 0x3FFF}
+ *   Disassemble, as the monitor does, count instructions (default 24, or
+ *   all up to end) from addr (default the PC), those starting at or
+ *   before end; one reply holds as many as fit in 1 MB, about 30000, and
+ *   next is where to go on from. Each is [addr, bytes, mnemonic, operand,
+ *   the address the operand refers to or null, its label or null].
+ *   -> {"status": "ok", "insns": [[8192, "AD3412", "LDA", "$1234", 4660, null], ...],
+ *       "count": 24, "next": 8252}
+ *
+ * {"cmd": "search_start", "space": "cpu", "value": 3}
+ *   Start a memory search (see ai_search.h) over "cpu", the 64 KB the
+ *   CPU sees, or all the banks of "xe", "axlon" or "mosaic" RAM, with
+ *   every byte a candidate, or with value those equal to it
+ *   -> {"status": "ok", "space": "cpu", "count": 65536, "us": 12.5}
+ *
+ * {"cmd": "search", "op": "decreased"}
+ *   Keep the candidates whose byte is now "equal", "not_equal", "less"
+ *   or "greater" than value, or "changed", "unchanged", "increased" or
+ *   "decreased" since the previous step
+ *   -> {"status": "ok", "space": "cpu", "count": 12, "us": 1.2}
+ *
+ * {"cmd": "search_list", "first": 0, "limit": 256}
+ *   The candidates' addresses (at most 4096), as [bank, offset] pairs in
+ *   a banked space
+ *   -> {"status": "ok", "space": "cpu", "count": 12, "first": 0, "matches": [20, 503]}
+ *
+ * {"cmd": "discover_start", "frames": 600}
+ *   Record the 64 KB the CPU sees at the end of each of the last frames
+ *   frames (2-4096, 64 KB each; see ai_discover.h), from this one on
+ *   -> {"status": "ok", "frames": 600, "bytes": 39321600}
+ *
+ * {"cmd": "discover", "events": [120, 187, 300], "window": 0, "top": 16}
+ *   Rank the addresses by how the frames in which they changed match the
+ *   frames at which events happened (within window frames) among those
+ *   recorded; score is their phi coefficient, and up and down count the
+ *   events at which the byte went up and down
+ *   -> {"status": "ok", "frames": 599, "event_frames": 3, "us": 21000,
+ *       "results": [{"addr": 200, "score": 1.0, "at_events": 3, "elsewhere": 0, "up": 3, "down": 0}]}
+ *
+ * {"cmd": "discover_status"}
+ *   -> {"status": "ok", "frames": 600, "first": 1000, "last": 1599}
+ *
+ * {"cmd": "discover_stop"}
+ *   Stop recording and free the frames
+ *   -> {"status": "ok"}
+ *
+ * {"cmd": "watch", "addr": 0x0080, "len": 4, "enabled": true}
+ *   Watch (or stop watching) len bytes (default 1) from addr for
+ *   changes; "clear": true drops every watch. While anything is watched,
+ *   each instruction store that changes a watched byte is recorded with
+ *   where in the frame it happened. The last 4096 changes are kept, and
+ *   older ones are counted as dropped. Stack pushes and writes from
+ *   outside the CPU (SIO, poke) are not recorded.
+ *   -> {"status": "ok", "count": 4}   (addresses watched)
+ *
+ * {"cmd": "watch_read"}
+ *   Fetch and clear the recorded changes, oldest first, each as
+ *   [addr, old, new, frame, scanline, xpos]
+ *   -> {"status": "ok", "dropped": 0, "changes": [[128, 3, 4, 5012, 248, 12], ...]}
+ *
  * === CPU ===
  * {"cmd": "cpu"}
  *   Get CPU state
@@ -122,9 +562,220 @@ int AI_IsPaused(void);
  *   -> {"status": "ok"}
  *
  * {"cmd": "breakpoint", "addr": 0x1234, "enabled": true}
- *   Set/clear breakpoint at address
+ *   Set/clear a breakpoint on the instruction at addr; "clear": true
+ *   removes them all. With "condition": "A=0 SETC" it only counts when
+ *   the condition, in the syntax of the monitor's B command (conditions
+ *   that must all hold, in groups separated by OR), holds as well; up to
+ *   16 breakpoints have one. A run (or free-running machine) that
+ *   reaches one stops at the end of that frame, after an event to its
+ *   client:
+ *   {"event": "breakpoint", "addr": 0x1234, "frame": 100, "scanline": 8, "xpos": 20}
+ *   The CPU runs its checking loop only while breakpoints are set.
+ *   -> {"status": "ok", "addr": 0x1234, "enabled": true, "count": 1}
+ *
+ * {"cmd": "logpoint", "addr": 0x1234, "write": false, "log": true,
+ *  "peek": 0x0080, "condition": "A=0"}
+ *   Set (again, keeping its count) or with "enabled": false clear a
+ *   logpoint, which counts the runs of the instruction at addr, or with
+ *   "write" the stores to addr, and goes on; "clear": true removes them
+ *   all. With "log" each hit is also recorded in a ring of 4096, with the
+ *   registers and the byte stored, or that at peek. condition is as for
+ *   breakpoints, evaluated at the instruction. Up to 64 logpoints.
+ *   -> {"status": "ok", "count": 1}   (logpoints set)
+ *
+ * {"cmd": "logpoint_read", "reset": false}
+ *   The logpoints' counts ("reset" zeroes them), and the hits recorded,
+ *   oldest first, which are cleared: [addr, pc, frame, scanline, xpos,
+ *   a, x, y, s, p, value or -1]
+ *   -> {"status": "ok", "dropped": 0, "counters": [[4660, false, 17]],
+ *       "log": [[4660, 4660, 5012, 40, 12, 0, 3, 255, 250, 50, 7], ...]}
+ *
+ * {"cmd": "features", "set": [{"kind": "bcd", "addr": 0x2000, "len": 3,
+ *                              "delta": true, "scale": 1.0}, ...]}
+ *   Set the features evaluated at the end of every "run" and for
+ *   "features" without "set": values read from memory, each "byte" (the
+ *   byte at addr, and "mask", default 255), "sbyte" (signed), "word" or
+ *   "word_be" (low or high byte first), "bcd" or "bcd_le" ("len" bytes of
+ *   packed BCD, 1-4, most or least significant first, digits above 9
+ *   counting as 0) or "bit" (1 if the byte and "mask" is not 0). With
+ *   "delta" the feature is the change since the previous evaluation, 0 at
+ *   the first; it is multiplied by "scale". Up to 64; "clear": true or an
+ *   empty set removes them.
+ *   -> {"status": "ok", "count": 2}
+ *
+ * {"cmd": "features"}
+ *   Evaluate the features now.
+ *   -> {"status": "ok", "frame": 5012, "features": [1250, 0]}
+ *
+ * {"cmd": "profile_start", "reset": true, "host_time": false}
+ *   Count every instruction and its cycles by PC and by opcode until
+ *   profile_stop; "reset": false adds to the previous counts. The CPU
+ *   runs its slower tracing loop while profiling, and only then.
+ *   "host_time": true also times each instruction on the host, which
+ *   slows it down further: the work an instruction sets off (a register
+ *   write, an OS patch) is charged to its PC, so it shows which code is
+ *   expensive to emulate rather than just long-running.
+ *   -> {"status": "ok"}
+ *
+ * {"cmd": "profile_stop"}
+ *   -> {"status": "ok"}
+ *
+ * {"cmd": "profile_dump", "top": 20, "format": "json", "routines": 0, "labels": ""}
+ *   The hottest PCs by cycles as [pc, count, cycles] ("format": "csv"
+ *   gives them as "csv": "pc,count,cycles\n..." instead), instructions
+ *   by opcode and cycles by 4 KB page ($0xxx .. $Fxxx). A STA WSYNC is
+ *   charged the wait it causes on its scanline, so wait loops show up.
+ *   "frame_cycles" is the mean per profiled frame of the "cycles" counts.
+ *   If the profile has host times ("host_time"), the PCs are by host time
+ *   instead and gain a host_ns column, less the timing's own cost, and
+ *   "host_ns" is their total; else it is null. "routines": N adds the N
+ *   hottest routines, the PCs grouped by the monitor's user label at or
+ *   below them, as [name, addr, count, cycles, host_ns]; "labels" loads
+ *   a label file first, as the monitor's LOADLABS. Needs MONITOR_HINTS
+ *   (else "routines" is null).
+ *   -> {"status": "ok", "active": false, "frames": 600, "insns": 5600000,
+ *       "cycles": 17800000, "pcs": 278, "host_ns": null,
+ *       "top": [[20743, 3520428, 10561284], ...],
+ *       "opcodes": [...256 counts...], "pages": [...16 cycle totals...],
+ *       "frame_cycles": {"total": 35568.0, "cpu": 28561.7, ...}}
+ *
+ * {"cmd": "coverage_start", "clear": true}
+ *   Mark the address of every instruction run until coverage_stop;
+ *   "clear": false keeps the addresses marked before. The CPU runs a
+ *   loop that does little else, unless breakpoints, watches or the
+ *   profiler need their own.
  *   -> {"status": "ok"}
  *
+ * {"cmd": "coverage_stop"}
+ *   -> {"status": "ok"}
+ *
+ * {"cmd": "coverage", "clear": false}
+ *   The addresses marked, as a bitmap of 8192 bytes in which address a
+ *   is bit a & 7 (LSB first) of byte a >> 3, and how many there are;
+ *   "clear": true starts again from none (as does binary opcode
+ *   AI_BIN_COVERAGE, which returns the bitmap unencoded)
+ *   -> {"status": "ok", "active": true, "count": 812, "bitmap": "<base64>"}
+ *
+ * {"cmd": "heatmap_start", "clear": true}
+ *   Count, until heatmap_stop, the instructions run from each address
+ *   and the reads and writes made to it, and those through the extended
+ *   memory window against the XE, Axlon or Mosaic bank switched in (see
+ *   ai_heatmap.h). The CPU runs its tracing loop meanwhile, a few times
+ *   slower. "clear": false counts on from the last counts.
+ *   -> {"status": "ok"}
+ *
+ * {"cmd": "heatmap_stop"}
+ *   -> {"status": "ok"}
+ *
+ * {"cmd": "heatmap", "kind": "write", "bank": "", "start": 0,
+ *  "length": 65536}
+ *   The counters of one kind, "read", "write" or "exec", of the CPU's
+ *   64 KB or, with "bank" "xe", "axlon" or "mosaic", of every bank of
+ *   that memory one after the other (XE bank 0 is the base RAM at
+ *   0x4000). Up to 65536 counters a reply, from start; "more" tells if
+ *   there are others past them. "counts" holds them as LEB128 varints
+ *   (7 bits a byte, lowest first, the top bit set on all but the last
+ *   byte of each), one byte for each address never touched; "total" is
+ *   their sum and "nonzero" the addresses touched. Binary opcode
+ *   AI_BIN_HEATMAP returns the varints unencoded, a whole map at once.
+ *   -> {"status": "ok", "active": true, "kind": "write", "bank": "",
+ *       "entries": 65536, "start": 0, "length": 65536, "more": false,
+ *       "total": 1830221, "nonzero": 1372, "counts": "<base64>"}
+ *
+ * {"cmd": "history_start", "entries": 1048576, "branches": false}
+ *   Keep the last entries instructions (rounded up to a power of two, at
+ *   most 2^26) in a ring of 10-byte records, see ai_history.h: PC, PC of
+ *   the instruction before, opcode and operand bytes, cycle and scanline.
+ *   "branches": true keeps only the instructions that do not follow on
+ *   from the one before, the targets of jumps and interrupts. The CPU
+ *   runs its checking loop while this is on.
+ *   -> {"status": "ok", "entries": 1048576, "bytes": 10485760}
+ *
+ * {"cmd": "history_stop"}
+ *   -> {"status": "ok"}
+ *
+ * {"cmd": "history", "last": 1000, "path": ""}
+ *   The newest last records, oldest first, base64 encoded (at most 65536;
+ *   binary opcode AI_BIN_HISTORY sends any number raw), or with "path"
+ *   all of them (or the last) written to that file instead
+ *   -> {"status": "ok", "active": true, "branches": false, "entries": 1048576,
+ *       "held": 1048576, "recorded": 52000000, "count": 1000, "records": "<base64>"}
+ *
+ * {"cmd": "trace_start", "path": "/tmp/run.a8t"}
+ *   Write a binary record of every instruction (PC, opcode and operand
+ *   bytes, registers, scanline, position and cycle; see ai_trace.h) to
+ *   path until trace_stop, replacing a trace being written. A writer
+ *   thread does the file output; the CPU runs its tracing loop meanwhile.
+ *   tools/trace_decode prints a trace as the monitor's TRACE text.
+ *   -ai-trace <path> starts one at boot.
+ *   -> {"status": "ok"}
+ *
+ * {"cmd": "trace_stop"}
+ *   Finish the file. "stalls" counts the times the emulator waited for
+ *   the writer; "error" is true if a write failed.
+ *   -> {"status": "ok", "active": false, "records": 1234567, "stalls": 0, "error": false}
+ *
+ * {"cmd": "trace_status"}
+ *   -> {"status": "ok", "active": true, "records": 1234567, "stalls": 0, "error": false}
+ *
+ * {"cmd": "timeline_start", "path": "/tmp/run.json", "events": 262144}
+ *   Record a timeline (see ai_timeline.h) of the spans of work on each
+ *   thread, keeping the last "events" per thread: frames, their stages,
+ *   every CPU_GO() run and the ANTIC work between, and AI commands on the
+ *   emulation thread; sound callbacks, recording jobs and NetSIO packets
+ *   on theirs. Turns frame timing on until timeline_stop. -ai-timeline
+ *   <path> records one from boot, written at exit.
+ *   -> {"status": "ok"}
+ *
+ * {"cmd": "timeline_stop"}
+ *   Write the timeline to its file as Chrome trace JSON. "dropped" counts
+ *   the spans the rings had overwritten; "error" is true if the write
+ *   failed.
+ *   -> {"status": "ok", "active": false, "spans": 23673, "dropped": 0, "error": false}
+ *
+ * {"cmd": "timeline_status"}
+ *   -> {"status": "ok", "active": true, "spans": 23671, "dropped": 0, "error": false}
+ *
+ * {"cmd": "stats", "enable": true, "clear": false, "counters": true}
+ *   Frame timing: with it on (-frame-timing, or "enable": true) every frame
+ *   is timed by stage, as in the "run" reply, with the CPU apart from
+ *   ANTIC, at some cost in speed. Gives each stage's mean and longest time
+ *   per frame and a histogram of frames by its time: bucket 0 under 1 us,
+ *   bucket i from 2^(i-1) to 2^i us, the last from 16 ms up. "frame" is
+ *   the whole frame, start to start. "enable": false stops it.
+ *   The other counters are always kept. "fps" and "cpu_ms_per_frame"
+ *   (process CPU time, all threads) cover the "interval_s" since the
+ *   previous "stats"; "target_fps" is 0 when running unthrottled.
+ *   "frames_skipped" counts frames not drawn for the refresh rate (-refresh,
+ *   or set by the automatic frame skip where a port turns it on). "socket" is the bytes read from and written
+ *   to all clients; "commands" the time taken to serve each command, in
+ *   the same buckets (for "run" just starting it). "unaligned" needs a
+ *   STAT_UNALIGNED_WORDS build: word accesses by the low 3 bits of their
+ *   address. "sound" is the output buffer in bytes, "record" the frames
+ *   waiting for the encoder thread; each null when not in use.
+ *   "counters": true (or -perf-counters) also reads the host's hardware
+ *   counters through perf_event_open() at every stage mark, and turns
+ *   frame timing on for them; "hw_counters" gives each stage's mean
+ *   cycles, instructions and cache misses per frame, and its instructions
+ *   per cycle, or is null while they are off. They need Linux and a
+ *   perf_event_paranoid setting that allows them; an error reply says
+ *   when they cannot be had. Stopping frame timing stops them. "clear"
+ *   zeroes the counts after the reply.
+ *   -> {"status": "ok", "enabled": true, "frames": 3000,
+ *       "frame": {"mean_us": 20012.4, "max_us": 21480.2, "hist": [...16...]},
+ *       "stages": {"input": {"mean_us": 1.2, "max_us": 9.1, "hist": [...]},
+ *       ..., "host": {...}},
+ *       "fps": 49.86, "target_fps": 49.86, "cpu_ms_per_frame": 2.1,
+ *       "interval_s": 10.0, "frames_skipped": 0, "refresh_rate": 1,
+ *       "auto_frameskip": false, "socket": {"bytes_in": 1234, "bytes_out": 56789},
+ *       "commands": {"count": 52, "mean_us": 30.5, "max_us": 410.0, "hist": [...]},
+ *       "unaligned": null,
+ *       "sound": {"fill": 1762, "size": 10614, "min_fill": 1764, "max_fill": 3534,
+ *                 "underruns": 0, "overruns": 0, "dropped": 0},
+ *       "record": {"queued": 2, "dropped": 0},
+ *       "hw_counters": {"frames": 3000, "stages": {"input": {"cycles": 1830,
+ *       "instructions": 2400, "cache_misses": 12, "ipc": 1.31}, ...}}}
+ *
  * === CHIPS ===
  * {"cmd": "antic"}
  *   Get ANTIC state
@@ -132,6 +783,17 @@ int AI_IsPaused(void);
  *       "hscrol": 0x00, "vscrol": 0x00, "pmbase": 0x00, "chbase": 0x00,
  *       "nmien": 0x00, "nmist": 0x00, "vcount": 0x00, "ypos": 0, "xpos": 0}
  *
+ * {"cmd": "cycles", "clear": false}
+ *   Where the machine cycles of the last frame went ("last") and their
+ *   mean per frame since the last "clear": run by the CPU ("cpu",
+ *   interrupt entry included; "idle" of those in idle loops the emulation
+ *   skipped), taken by ANTIC DMA ("dma"), and the CPU halted by WSYNC
+ *   ("wsync", not counting DMA meanwhile). cpu + dma + wsync = total.
+ *   "dlis", "vbis" and "irqs" count the interrupts taken.
+ *   -> {"status": "ok", "last": {"total": 35568, "cpu": 28548, "idle": 15084,
+ *       "dma": 6670, "wsync": 350, "dlis": 14, "vbis": 1, "irqs": 0},
+ *       "frames": 600, "mean": {"total": 35568.0, "cpu": 28561.7, ...}}
+ *
  * {"cmd": "gtia"}
  *   Get GTIA state
  *   -> {"status": "ok", "hposp0": 0x00, ..., "colbk": 0x00, "prior": 0x00, ...}
@@ -145,6 +807,14 @@ int AI_IsPaused(void);
  *   -> {"status": "ok", "porta": 0x00, "portb": 0x00, "pactl": 0x00, "pbctl": 0x00}
  *
  * === DEVICES ===
+ * {"cmd": "netsio", "clear": false}
+ *   NetSIO (FujiNet) round trips, in builds with NetSIO: the packets that
+ *   stop emulation until FujiNet answers, the answers received and those
+ *   given up on after 45 ms. latency_us[i] counts answers taking 2^i to
+ *   2^(i+1) microseconds. clear zeroes the counts after replying.
+ *   -> {"status": "ok", "enabled": true, "syncs": 120, "timeouts": 0,
+ *       "mean_us": 412.5, "max_us": 1870, "latency_us": [0, 0, ..., 0]}
+ *
  * {"cmd": "disk_insert", "drive": 1, "path": "/path/to/disk.atr"}
  *   Insert disk image
  *   -> {"status": "ok"}
@@ -158,22 +828,68 @@ int AI_IsPaused(void);
  *   -> {"status": "ok", "drives": [{"drive": 1, "path": "...", "sectors": 720}, ...]}
  *
  * === STATE ===
- * {"cmd": "save_state", "path": "/tmp/state.sav"}
- *   Save emulator state
+ * {"cmd": "save_state", "path": "/tmp/state.sav", "codec": "gzip",
+ *  "async": false}
+ *   Save emulator state. codec is "gzip" (default, readable by any
+ *   atari800), "fast" (LZ4 block format, several times faster to write,
+ *   slightly larger) or "raw" (uncompressed)
  *   -> {"status": "ok"}
+ *   With async the state is captured at once but compressed and written
+ *   by a background thread; the reply carries a job id, and when the file
+ *   is complete the client is sent
+ *     {"event": "save_state", "job": 3, "ok": true}
+ *   (binary connections: opcode AI_BIN_EVENT_JSON). Up to 16 writes may
+ *   be pending.
+ *   -> {"status": "ok", "job": 3, "pending": true}
+ *
+ * {"cmd": "save_status", "job": 3}
+ *   State of an async save: "pending", "done", "failed" or "unknown"
+ *   (never queued, or one of the 16 most recent no longer)
+ *   -> {"status": "ok", "job": 3, "state": "done"}
  *
  * {"cmd": "load_state", "path": "/tmp/state.sav"}
- *   Load emulator state
+ *   Load emulator state, saved with any codec
  *   -> {"status": "ok"}
  *
+ * {"cmd": "state_get", "base": "1c291ca3"}
+ *   The state inline, for a client that keeps a copy: the first time (or
+ *   without base, or when the server no longer has it) as a state file of
+ *   the fast codec, afterwards as a delta from base, the id of the last
+ *   state the client got or put on this connection. Like screen_delta, the
+ *   server keeps the last state it gave and the one before. id is the
+ *   CRC32 of the uncompressed state file.
+ *   -> {"status": "ok", "frame": 1234, "id": "5e0f21b7", "full": false,
+ *       "bytes": 1840, "data": "<base64>"}
+ *   A delta is "A8SD", ULONG base id, ULONG length of the new file, then
+ *   runs of ULONG first page, UWORD count and the count 256-byte pages of
+ *   the file that changed, the last page of the file cut short; past the
+ *   end of a shorter base, pages count as zeros. Memory a frame did not
+ *   touch and devices that did not change stay out of it.
+ *
+ * {"cmd": "state_put", "data": "<base64>"}
+ *   Load a state file of the fast or raw codec, or a delta (as above) from
+ *   a state this connection got or put last or the one before, and keep it
+ *   as the base of later deltas either way. Commands and binary frames
+ *   are up to 64 KB, so large changes need a state file of the fast codec.
+ *   -> {"status": "ok", "id": "5e0f21b7"}
+ *
  * === DEBUG OUTPUT ===
- * {"cmd": "debug_enable", "addr": 0xD7FF}
- *   Enable debug port - writes to this address will be captured
- *   -> {"status": "ok"}
+ * {"cmd": "debug_enable", "addr": 0xD7FF, "size": 65536}
+ *   Enable debug port - writes to this address will be captured. They are
+ *   kept in a ring of size bytes (256 to 16 MB, default 65536 or
+ *   -ai-debug-buffer; a new size empties it) as records of the bytes of
+ *   one frame, 6 bytes of frame number and count before them. Bytes that
+ *   do not fit are dropped and counted.
+ *   -> {"status": "ok", "size": 65536}
  *
  * {"cmd": "debug_read"}
- *   Read and clear debug output buffer
- *   -> {"status": "ok", "data": [0x41, 0x42, ...], "ascii": "AB..."}
+ *   Take the oldest records out of the ring, as many as fit the reply:
+ *   their bytes in data and ascii, and [frame, count] of each in records.
+ *   dropped and written count bytes since the ring was sized; more tells
+ *   that records are left.
+ *   -> {"status": "ok", "data": [0x41, 0x42, ...],
+ *       "records": [[1230, 1], [1231, 1]], "dropped": 0, "written": 2,
+ *       "more": false, "ascii": "AB..."}
  *
  */
 
@@ -181,6 +897,124 @@ int AI_IsPaused(void);
 void AI_SendResponse(const char *json);
 void AI_DebugWrite(UBYTE byte);
 void AI_ApplyInput(void);  /* Apply AI input overrides after INPUT_Frame */
+/* Scan line of the frame running at which INPUT_Scanline() calls
+   AI_InputLine() to apply the next "timeline" input change, or -1 */
+extern int AI_input_line;
+void AI_InputLine(void);
+/* Base64 of len bytes at data into out, NUL-terminated; returns the number
+   of characters written, stopping short if outsize is too small */
+int AI_Base64Encode(const UBYTE *data, int len, char *out, int outsize);
+/* The bytes of len base64 characters (padded, no line breaks) into out;
+   returns how many, or -1 if the text is not base64 or out is too small */
+int AI_Base64Decode(const char *in, int len, UBYTE *out, int outsize);
+/* A socket bound to the -ai-listen style address "[host]:port" or
+   "vsock:[cid:]port", not yet listening; *tcp is set for TCP. Returns -1
+   after logging why if it cannot be bound. */
+int AI_ListenSocket(const char *address, int *tcp);
+
+/* PC watch for run_until and breakpoints: when non-NULL, the CPU calls
+   AI_WatchHit() before executing an instruction at any address flagged
+   in the map. Call CPU_UpdateGo() after changing it. */
+extern UBYTE *AI_pc_watch;         /* 64 KB map, NULL = no PC watched */
+void AI_WatchHit(UWORD pc);
+
+/* Write watch: when non-NULL, the CPU's checking loop calls AI_WriteHit()
+   after an instruction stores to an address flagged in the map, with the
+   byte that was there before, and with the PC of the storing instruction
+   in AI_write_pc. Stack pushes are not watched. Call CPU_UpdateGo() after
+   changing it. */
+extern UBYTE *AI_write_watch;      /* 64 KB map, NULL = nothing watched */
+extern UWORD AI_write_pc;
+void AI_WriteHit(UWORD addr, UBYTE old);
+
+/* Profiler: while AI_profile is non-NULL, the CPU's tracing loop counts
+   each instruction and its cycles against its PC, and its opcode in
+   AI_profile_opcodes. Call CPU_UpdateGo() after changing it. With
+   AI_profile_host set it also adds the AI_Ticks() each instruction took
+   to emulate. */
+typedef struct {
+    ULONG count;
+    ULONG cycles;
+    double host;  /* AI_Ticks() */
+} AI_ProfileRec;
+extern AI_ProfileRec *AI_profile;  /* 64K entries, NULL = not profiling */
+extern ULONG AI_profile_opcodes[256];
+extern int AI_profile_host;
+
+/* Code coverage: while AI_coverage is non-NULL, every CPU loop but the
+   fast one sets the byte of each instruction's PC, and CPU_UpdateGo()
+   picks a loop that does just that when no other check is needed. Call
+   CPU_UpdateGo() after changing it. */
+extern UBYTE *AI_coverage;         /* 64 KB map, NULL = not collecting */
+#define AI_COVERAGE_BYTES 8192     /* the map as a bitmap */
+
+/* The host clock of the stage timing and the profiler: on x86 the time
+   stamp counter, a few ns to read, elsewhere the monotonic clock in ns */
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define AI_TICKS_TSC
+#define AI_Ticks() ((double)__rdtsc())
+#else
+double AI_Ticks(void);
+#endif
+/* Seconds per AI_Ticks() tick, calibrated on the first call */
+double AI_TickSeconds(void);
+
+/* Run instrumentation: while AI_timing is set, Atari800_Frame() charges
+   the host time since the previous mark to a stage with AI_TIME_STAGE() */
+#define AI_TIME_INPUT  0  /* devices, input and GTIA frame setup */
+#define AI_TIME_ANTIC  1  /* ANTIC_Frame(), with the CPU unless AI_TIME_CPU */
+#define AI_TIME_POKEY  2
+#define AI_TIME_SOUND  3
+#define AI_TIME_SYNC   4  /* waiting in Atari800_Sync() */
+#define AI_TIME_CPU    5  /* CPU_GO(), split from ANTIC with AI_frame_timing */
+#define AI_TIME_AI     6  /* AI_Frame(): commands and observations */
+#define AI_TIME_RECORD 7  /* video recording */
+#define AI_TIME_HOST   8  /* between frames: the platform's display and events */
+#define AI_TIME_STAGES 9
+extern int AI_timing;
+void AI_TimeStage(int stage);
+/* Zero the stage times and charge them from now on; the host seconds
+   charged to a stage since then */
+void AI_TimeReset(void);
+double AI_TimeCharged(int stage);
+extern const char * const AI_time_stage_names[AI_TIME_STAGES];
+#define AI_TIME_STAGE(stage) do { if (AI_timing) AI_TimeStage(stage); } while (0)
+
+/* Frame timing (-frame-timing, the "stats" command): every frame is timed,
+   the CPU apart from ANTIC (CPU_UpdateGo() puts a timing wrapper around
+   CPU_GO()), and the time of each stage per frame is gathered in
+   histograms. Call AI_SetFrameTiming() to change it. */
+#define AI_TIME_BUCKETS 16
+typedef struct {
+    ULONG frames;
+    /* Seconds in total and in the longest frame, by stage; the last entry
+       is the whole frame, from the start of one to the start of the next */
+    double total[AI_TIME_STAGES + 1];
+    double max[AI_TIME_STAGES + 1];
+    /* Frames by time taken: bucket 0 under 1 us, bucket i from 2^(i-1)
+       to 2^i us, the last from 16 ms up */
+    ULONG hist[AI_TIME_STAGES + 1][AI_TIME_BUCKETS];
+} AI_FrameStats;
+extern int AI_frame_timing;
+void AI_SetFrameTiming(int on);
+void AI_GetFrameStats(AI_FrameStats *stats, int clear);
+void AI_TimeFrame(void);
+#define AI_TIME_FRAME() do { if (AI_frame_timing) AI_TimeFrame(); } while (0)
+
+/* Set during an unthrottled "run": skip Atari800_Sync() and sound sync */
+extern int AI_unthrottled;
+
+/* Render policy: which frames are drawn in full. Frames that are not run
+   ANTIC_Frame(Atari800_collisions_in_skipped_frames) and skip the overlays
+   and the platform blit. */
+#define AI_RENDER_ALWAYS   0  /* every frame (default) */
+#define AI_RENDER_OBSERVED 1  /* frames a client will look at: the last frame
+                                 of a run, subscribed screens, shared memory */
+#define AI_RENDER_EVERY    2  /* every Nth frame */
+extern int AI_render_policy;
+extern int AI_render_every;
+int AI_RenderFrame(void);    /* should the frame about to run be drawn? */
 
 /* AI input overrides - set by joystick command, applied after INPUT_Frame */
 extern int AI_joy_override[4];     /* -1 = no override, 0-15 = stick value */
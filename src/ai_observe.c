@@ -0,0 +1,115 @@
+/*
+ * ai_observe.c - Downsampled observations of the emulated screen
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+#include "config.h"
+#include <string.h>
+
+#include "ai_observe.h"
+#include "colours.h"
+#include "screen.h"
+
+/* Source span [start, end) of each destination column or row */
+static void box_edges(int *start, int *end, int n, int lo, int hi) {
+    int i, len = hi - lo;
+    for (i = 0; i < n; i++) {
+        start[i] = lo + i * len / n;
+        end[i] = lo + (i + 1) * len / n;
+        /* Enlarging: every output pixel still covers one source pixel */
+        if (end[i] <= start[i]) end[i] = start[i] + 1;
+    }
+}
+
+/* Luma per palette entry (ITU-R BT.601 weights) from the current palette,
+   so colour adjustments and external palettes apply */
+static void palette_luma(UBYTE *luma) {
+    int i;
+    for (i = 0; i < 256; i++) {
+        luma[i] = (UBYTE)((Colours_GetR(i) * 299 + Colours_GetG(i) * 587
+                           + Colours_GetB(i) * 114 + 500) / 1000);
+    }
+}
+
+int AI_OBS_Render(UBYTE *dest, int width, int height, int format,
+                  int x1, int y1, int x2, int y2) {
+    static int xs[Screen_WIDTH], xe[Screen_WIDTH];
+    static int ys[Screen_HEIGHT], ye[Screen_HEIGHT];
+    const UBYTE *screen = (const UBYTE *)Screen_atari;
+    int i, j;
+
+    if (width < 1 || width > Screen_WIDTH || height < 1 || height > Screen_HEIGHT)
+        return 0;
+    if (format != AI_OBS_GRAY && format != AI_OBS_INDEX)
+        return 0;
+
+    if (x2 <= x1 || y2 <= y1) {
+        x1 = Screen_visible_x1;
+        y1 = Screen_visible_y1;
+        x2 = Screen_visible_x2;
+        y2 = Screen_visible_y2;
+    }
+    if (x1 < 0) x1 = 0;
+    if (y1 < 0) y1 = 0;
+    if (x2 > Screen_WIDTH) x2 = Screen_WIDTH;
+    if (y2 > Screen_HEIGHT) y2 = Screen_HEIGHT;
+    if (x2 <= x1 || y2 <= y1) return 0;
+
+    box_edges(xs, xe, width, x1, x2);
+    box_edges(ys, ye, height, y1, y2);
+
+    if (format == AI_OBS_INDEX) {
+        /* Colour indices cannot be averaged: take the centre of each box */
+        for (j = 0; j < height; j++) {
+            const UBYTE *row = screen + ((ys[j] + ye[j] - 1) / 2) * Screen_WIDTH;
+            for (i = 0; i < width; i++)
+                *dest++ = row[(xs[i] + xe[i] - 1) / 2];
+        }
+    } else {
+        UBYTE luma[256];
+        ULONG acc[Screen_WIDTH];
+        int cw = x2 - x1;
+
+        palette_luma(luma);
+        for (j = 0; j < height; j++) {
+            int y;
+            /* Sum the box's rows column by column - a stride-1 loop the
+               compiler can vectorise - then reduce each column run */
+            memset(acc, 0, cw * sizeof(ULONG));
+            for (y = ys[j]; y < ye[j]; y++) {
+                const UBYTE *row = screen + y * Screen_WIDTH + x1;
+                int x;
+                for (x = 0; x < cw; x++)
+                    acc[x] += luma[row[x]];
+            }
+            for (i = 0; i < width; i++) {
+                ULONG sum = 0;
+                ULONG area = (ULONG)(xe[i] - xs[i]) * (ye[j] - ys[j]);
+                int x;
+                for (x = xs[i] - x1; x < xe[i] - x1; x++)
+                    sum += acc[x];
+                *dest++ = (UBYTE)((sum + area / 2) / area);
+            }
+        }
+    }
+    return width * height;
+}
+
+void AI_OBS_MaxPool(const UBYTE *prev) {
+    UBYTE *screen = (UBYTE *)Screen_atari;
+    UBYTE luma[256];
+    int i, j;
+
+    palette_luma(luma);
+    /* Most of the screen is the same in both: skip it a word at a time */
+    for (i = 0; i < Screen_WIDTH * Screen_HEIGHT; i += sizeof(ULONG)) {
+        if (*(const ULONG *)(prev + i) == *(const ULONG *)(screen + i))
+            continue;
+        for (j = i; j < i + (int)sizeof(ULONG); j++) {
+            if (luma[prev[j]] > luma[screen[j]])
+                screen[j] = prev[j];
+        }
+    }
+}
@@ -0,0 +1,35 @@
+/*
+ * ai_observe.h - Downsampled observations of the emulated screen
+ *
+ * Renders Screen_atari, cropped and resized, into a caller-supplied buffer
+ * in the shapes agents train on (e.g. 84x84 grayscale), so clients do not
+ * have to fetch the full 384x240 frame and resize it themselves.
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+#ifndef AI_OBSERVE_H_
+#define AI_OBSERVE_H_
+
+#include "atari.h"
+
+/* Pixel formats (also used on the wire, see ai_interface.h) */
+#define AI_OBS_GRAY  0  /* 8-bit luma of the current palette, box-averaged */
+#define AI_OBS_INDEX 1  /* Atari colour index, sampled at each box centre */
+
+/* Render a width x height observation of the crop rectangle
+   x1 <= x < x2, y1 <= y < y2 into dest (width * height bytes, row-major).
+   An empty rectangle (x2 <= x1 or y2 <= y1) selects the visible area,
+   Screen_visible_x1..x2 / y1..y2. Returns the number of bytes written,
+   or 0 if the shape or format is invalid. */
+int AI_OBS_Render(UBYTE *dest, int width, int height, int format,
+                  int x1, int y1, int x2, int y2);
+
+/* Max-pool Screen_atari with prev, an earlier Screen_atari: each pixel
+   keeps whichever of the two colours has the greater luma in the current
+   palette, as Atari RL environments pool the last two frames of a skip to
+   remove sprite flicker. */
+void AI_OBS_MaxPool(const UBYTE *prev);
+
+#endif /* AI_OBSERVE_H_ */
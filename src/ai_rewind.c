@@ -0,0 +1,253 @@
+/*
+ * ai_rewind.c - Rewind buffer for the AI interface
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+#include "config.h"
+#include <stdlib.h>
+#include <string.h>
+
+#include "ai_rewind.h"
+#include "statesav.h"
+#include "util.h"
+
+/* A delta is a sequence of (skip, count, count bytes) records, the counts
+   as native ULONGs: skip equal bytes, then XOR count bytes in. Runs of
+   equal bytes shorter than a record header stay inside a literal, so a
+   delta is never more than one header longer than the state. */
+#define DELTA_HEADER   ((int)(2 * sizeof(ULONG)))
+#define DELTA_MIN_SKIP DELTA_HEADER
+
+typedef struct {
+    int frame;
+    UBYTE *delta;   /* turns the next newer keyframe into this one */
+    int len;
+} Keyframe;
+
+static int rewind_depth = 0;
+static int rewind_stride = 1;
+
+static Keyframe *keys = NULL;     /* the depth - 1 older keyframes, a ring */
+static int key_first = 0;
+static int key_count = 0;
+
+static UBYTE *newest = NULL;      /* full state of the newest keyframe */
+static UBYTE *work = NULL;        /* state being taken */
+static UBYTE *packed = NULL;      /* delta being built */
+static int newest_frame = -1;
+static int state_len = 0;
+static int buffer_size = 0;
+
+/* Input of the last input_span frames, indexed by frame % input_span */
+static UBYTE *inputs = NULL;
+static int *input_frames = NULL;  /* frame each slot holds, -1 = none */
+static int input_span = 0;
+
+static size_t key_bytes = 0;
+
+static void put_ulong(UBYTE *p, ULONG v) { memcpy(p, &v, sizeof(v)); }
+static ULONG get_ulong(const UBYTE *p) { ULONG v; memcpy(&v, p, sizeof(v)); return v; }
+
+/* Encode the difference of a from b (both len bytes) into out */
+static int delta_encode(UBYTE *out, const UBYTE *a, const UBYTE *b, int len) {
+    int i = 0, o = 0;
+
+    while (i < len) {
+        int skip_start = i, lit_start, lit_end, same, k;
+        while (i < len && a[i] == b[i]) i++;
+        if (i == len) break;
+        lit_start = i;
+        /* The literal ends before the first long enough equal run */
+        for (same = 0; i < len && same < DELTA_MIN_SKIP; i++)
+            same = a[i] == b[i] ? same + 1 : 0;
+        lit_end = i - same;
+        put_ulong(out + o, (ULONG)(lit_start - skip_start));
+        put_ulong(out + o + sizeof(ULONG), (ULONG)(lit_end - lit_start));
+        o += DELTA_HEADER;
+        for (k = lit_start; k < lit_end; k++)
+            out[o++] = a[k] ^ b[k];
+        i = lit_end;
+    }
+    return o;
+}
+
+/* Apply a delta to state in place */
+static void delta_apply(UBYTE *state, const UBYTE *delta, int len) {
+    int o = 0, pos = 0;
+
+    while (o < len) {
+        ULONG skip = get_ulong(delta + o);
+        ULONG count = get_ulong(delta + o + sizeof(ULONG));
+        ULONG k;
+        o += DELTA_HEADER;
+        pos += skip;
+        for (k = 0; k < count; k++)
+            state[pos++] ^= delta[o++];
+    }
+}
+
+static void drop_keys(void) {
+    while (key_count > 0) {
+        key_count--;
+        free(keys[(key_first + key_count) % (rewind_depth - 1)].delta);
+    }
+    key_first = 0;
+    key_bytes = 0;
+    newest_frame = -1;
+}
+
+int AI_REWIND_Configure(int depth, int stride) {
+    int i;
+
+    if (depth < 0 || stride < 1 || (depth > 0 && (long)(depth + 1) * stride > 0x7fffff))
+        return FALSE;
+    if (rewind_depth > 0)
+        drop_keys();
+    free(keys);
+    free(newest);
+    free(work);
+    free(packed);
+    free(inputs);
+    free(input_frames);
+    keys = NULL;
+    newest = work = packed = inputs = NULL;
+    input_frames = NULL;
+    state_len = buffer_size = input_span = 0;
+
+    rewind_depth = depth;
+    rewind_stride = stride;
+    if (depth == 0)
+        return TRUE;
+    if (depth > 1)
+        keys = (Keyframe *)Util_malloc((depth - 1) * sizeof(Keyframe));
+    /* Enough to re-simulate from the oldest keyframe to the present */
+    input_span = (depth + 1) * stride;
+    inputs = (UBYTE *)Util_malloc((size_t)input_span * AI_REWIND_CHANNELS * AI_REWIND_INPUT_SIZE);
+    input_frames = (int *)Util_malloc((size_t)input_span * AI_REWIND_CHANNELS * sizeof(int));
+    for (i = 0; i < input_span * AI_REWIND_CHANNELS; i++)
+        input_frames[i] = -1;
+    return TRUE;
+}
+
+int AI_REWIND_Depth(void) {
+    return rewind_depth;
+}
+
+int AI_REWIND_Stride(void) {
+    return rewind_stride;
+}
+
+void AI_REWIND_Clear(void) {
+    if (rewind_depth > 0)
+        drop_keys();
+}
+
+void AI_REWIND_Frame(void) {
+    int len;
+    UBYTE *swap;
+
+    if (rewind_depth == 0 || Atari800_nframes % rewind_stride != 0
+        || Atari800_nframes == newest_frame)
+        return;
+    if (Atari800_nframes < newest_frame)
+        drop_keys();  /* a state was loaded: the history is not ours */
+
+    len = work != NULL ? (int)StateSav_SaveSnapshot(work, buffer_size) : 0;
+    if (len == 0) {
+        /* First keyframe, or the machine got more RAM */
+        drop_keys();
+        buffer_size = (int)StateSav_SaveSnapshot(NULL, 0);
+        newest = (UBYTE *)Util_realloc(newest, buffer_size);
+        work = (UBYTE *)Util_realloc(work, buffer_size);
+        packed = (UBYTE *)Util_realloc(packed, buffer_size + DELTA_HEADER);
+        len = (int)StateSav_SaveSnapshot(work, buffer_size);
+        if (len == 0)
+            return;
+    }
+
+    if (newest_frame >= 0 && len == state_len && rewind_depth > 1) {
+        /* The old newest keyframe becomes a delta from the new one */
+        Keyframe *k;
+        int n = delta_encode(packed, newest, work, len);
+        if (key_count == rewind_depth - 1) {
+            k = &keys[key_first];
+            free(k->delta);
+            key_bytes -= k->len;
+            key_first = (key_first + 1) % (rewind_depth - 1);
+            key_count--;
+        }
+        k = &keys[(key_first + key_count) % (rewind_depth - 1)];
+        k->frame = newest_frame;
+        k->len = n;
+        k->delta = (UBYTE *)Util_malloc(n > 0 ? n : 1);
+        memcpy(k->delta, packed, n);
+        key_bytes += n;
+        key_count++;
+    }
+    else if (len != state_len) {
+        drop_keys();
+    }
+
+    swap = newest;
+    newest = work;
+    work = swap;
+    newest_frame = Atari800_nframes;
+    state_len = len;
+}
+
+void AI_REWIND_RecordInput(int channel, int frame, const void *data, int len) {
+    int slot;
+
+    if (rewind_depth == 0 || frame < 0 || len > AI_REWIND_INPUT_SIZE)
+        return;
+    slot = (frame % input_span) * AI_REWIND_CHANNELS + channel;
+    memcpy(inputs + (size_t)slot * AI_REWIND_INPUT_SIZE, data, len);
+    input_frames[slot] = frame;
+}
+
+const void *AI_REWIND_GetInput(int channel, int frame) {
+    int slot;
+
+    if (rewind_depth == 0 || frame < 0)
+        return NULL;
+    slot = (frame % input_span) * AI_REWIND_CHANNELS + channel;
+    if (input_frames[slot] != frame)
+        return NULL;
+    return inputs + (size_t)slot * AI_REWIND_INPUT_SIZE;
+}
+
+int AI_REWIND_Oldest(void) {
+    if (rewind_depth == 0 || newest_frame < 0)
+        return -1;
+    return key_count > 0 ? keys[key_first].frame : newest_frame;
+}
+
+int AI_REWIND_Restore(int target) {
+    int oldest = AI_REWIND_Oldest();
+
+    if (oldest < 0 || target < oldest || target > Atari800_nframes)
+        return -1;
+    /* Walk back from the newest keyframe, each delta leaving the state of
+       the keyframe before */
+    while (newest_frame > target) {
+        Keyframe *k = &keys[(key_first + key_count - 1) % (rewind_depth - 1)];
+        delta_apply(newest, k->delta, k->len);
+        newest_frame = k->frame;
+        free(k->delta);
+        key_bytes -= k->len;
+        key_count--;
+    }
+    if (!StateSav_ReadSnapshot(newest, state_len))
+        return -1;
+    Atari800_nframes = newest_frame;
+    return newest_frame;
+}
+
+size_t AI_REWIND_Bytes(void) {
+    if (rewind_depth == 0)
+        return 0;
+    return key_bytes + 3 * (size_t)buffer_size
+        + (size_t)input_span * AI_REWIND_CHANNELS * (AI_REWIND_INPUT_SIZE + sizeof(int));
+}
@@ -0,0 +1,62 @@
+/*
+ * ai_rewind.h - Rewind buffer for the AI interface
+ *
+ * Keeps a ring of keyframes, the machine state every stride frames, plus
+ * the input of every frame since the oldest one. Only the newest keyframe
+ * is held whole; each older one is stored as the XOR difference from the
+ * keyframe after it, run-length packed, so a ring of seconds of play costs
+ * little more than one state. Rewinding restores the nearest keyframe at or
+ * before the target; the caller re-simulates the remaining frames with the
+ * recorded input.
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+#ifndef AI_REWIND_H_
+#define AI_REWIND_H_
+
+#include <stddef.h>
+#include "atari.h"
+
+/* Input channels: each input layer records its own per-frame data */
+#define AI_REWIND_AI          0  /* socket overrides and keys, see AI_Frame */
+#define AI_REWIND_LIBATARI800 1  /* input_template_t of libatari800_next_frame */
+#define AI_REWIND_CHANNELS    2
+
+#define AI_REWIND_INPUT_SIZE  64 /* maximum bytes recorded per channel and frame */
+
+/* Keep depth keyframes taken every stride frames. depth 0 turns rewind off
+   and frees the buffer. Any history recorded so far is discarded. Returns
+   FALSE if the arguments are out of range. */
+int AI_REWIND_Configure(int depth, int stride);
+int AI_REWIND_Depth(void);
+int AI_REWIND_Stride(void);
+
+/* Forget the history, e.g. after a state was loaded from elsewhere */
+void AI_REWIND_Clear(void);
+
+/* Take a keyframe if one is due: call between frames, when the state is
+   that at the end of frame Atari800_nframes. Calling it again for the same
+   frame does nothing. */
+void AI_REWIND_Frame(void);
+
+/* Record the input of a channel for the frame about to run, whose number
+   will be frame once complete */
+void AI_REWIND_RecordInput(int channel, int frame, const void *data, int len);
+
+/* Recorded input of a channel for a frame, or NULL if there is none */
+const void *AI_REWIND_GetInput(int channel, int frame);
+
+/* Oldest frame that can be rewound to, or -1 if there is no history */
+int AI_REWIND_Oldest(void);
+
+/* Restore the newest keyframe at or before frame target, dropping the
+   keyframes after it, and set Atari800_nframes to its frame. Returns the
+   keyframe's frame number, or -1 if target is outside the history. */
+int AI_REWIND_Restore(int target);
+
+/* Memory held by keyframes and input records, in bytes */
+size_t AI_REWIND_Bytes(void);
+
+#endif /* AI_REWIND_H_ */
@@ -0,0 +1,205 @@
+/*
+ * ai_saver.c - Background state file writer for the AI interface
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+#include "config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef HAVE_PTHREAD_CREATE
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "ai_saver.h"
+#include "statesav.h"
+#include "log.h"
+#include "util.h"
+
+typedef struct {
+    int id;          /* 0 = slot never used */
+    int state;       /* AI_SAVER_PENDING, _DONE or _FAILED */
+    int reported;    /* returned by AI_SAVER_NextDone() */
+    int codec;
+    UBYTE *image;
+    ULONG len;
+    char path[FILENAME_MAX];
+} AI_SaveJob;
+
+/* Job id lives in slot id % AI_SAVER_MAX_JOBS. A pending job is only
+   touched by the writer, which takes them oldest first. */
+static AI_SaveJob jobs[AI_SAVER_MAX_JOBS];
+static int next_id = 1;
+
+#ifdef HAVE_PTHREAD_CREATE
+static pthread_mutex_t jobs_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t jobs_queued = PTHREAD_COND_INITIALIZER;
+static pthread_t writer;
+static int writer_running = FALSE;
+static int writer_failed = FALSE;
+static int writer_stop = FALSE;
+static int wake_pipe[2] = {-1, -1};
+#define LOCK()   pthread_mutex_lock(&jobs_lock)
+#define UNLOCK() pthread_mutex_unlock(&jobs_lock)
+#else
+#define LOCK()   do { } while (0)
+#define UNLOCK() do { } while (0)
+#endif
+
+static void run_job(AI_SaveJob *job) {
+    int ok = StateSav_WriteAtariState(job->path, job->image, job->len, job->codec);
+
+    LOCK();
+    free(job->image);
+    job->image = NULL;
+    job->state = ok ? AI_SAVER_DONE : AI_SAVER_FAILED;
+    UNLOCK();
+}
+
+#ifdef HAVE_PTHREAD_CREATE
+static void *writer_main(void *arg) {
+    (void)arg;
+    for (;;) {
+        AI_SaveJob *job = NULL;
+        int i;
+
+        LOCK();
+        for (;;) {
+            for (i = 0; i < AI_SAVER_MAX_JOBS; i++) {
+                if (jobs[i].id != 0 && jobs[i].state == AI_SAVER_PENDING
+                    && (job == NULL || jobs[i].id < job->id))
+                    job = &jobs[i];
+            }
+            if (job != NULL || writer_stop) break;
+            pthread_cond_wait(&jobs_queued, &jobs_lock);
+        }
+        UNLOCK();
+        if (job == NULL) return NULL;
+
+        run_job(job);
+        /* A full pipe already wakes the reader */
+        if (write(wake_pipe[1], "", 1) < 0) { }
+    }
+}
+
+/* Start the writer if it is not running; called with the lock held */
+static int start_writer(void) {
+    if (writer_running) return TRUE;
+    if (writer_failed) return FALSE;
+    if (pipe(wake_pipe) < 0) {
+        wake_pipe[0] = wake_pipe[1] = -1;
+    }
+    else {
+        fcntl(wake_pipe[0], F_SETFL, fcntl(wake_pipe[0], F_GETFL) | O_NONBLOCK);
+        fcntl(wake_pipe[1], F_SETFL, fcntl(wake_pipe[1], F_GETFL) | O_NONBLOCK);
+        writer_stop = FALSE;
+        if (pthread_create(&writer, NULL, writer_main, NULL) == 0) {
+            writer_running = TRUE;
+            return TRUE;
+        }
+        close(wake_pipe[0]);
+        close(wake_pipe[1]);
+        wake_pipe[0] = wake_pipe[1] = -1;
+    }
+    Log_print("AI: Cannot start the state writer thread, saving in the foreground");
+    writer_failed = TRUE;
+    return FALSE;
+}
+#endif /* HAVE_PTHREAD_CREATE */
+
+int AI_SAVER_Queue(const char *path, UBYTE *image, ULONG len, int codec) {
+    AI_SaveJob *job = &jobs[next_id % AI_SAVER_MAX_JOBS];
+
+    LOCK();
+    /* Jobs finish in order, so if this one is pending, all are */
+    if (job->id != 0 && job->state == AI_SAVER_PENDING) {
+        UNLOCK();
+        return 0;
+    }
+    job->id = next_id++;
+    job->state = AI_SAVER_PENDING;
+    job->reported = FALSE;
+    job->codec = codec;
+    job->image = image;
+    job->len = len;
+    Util_strlcpy(job->path, path, sizeof(job->path));
+#ifdef HAVE_PTHREAD_CREATE
+    if (start_writer()) {
+        pthread_cond_signal(&jobs_queued);
+        UNLOCK();
+        return job->id;
+    }
+#endif
+    UNLOCK();
+    run_job(job);
+    return job->id;
+}
+
+int AI_SAVER_Status(int id) {
+    AI_SaveJob *job;
+    int state = AI_SAVER_UNKNOWN;
+
+    if (id <= 0) return AI_SAVER_UNKNOWN;
+    job = &jobs[id % AI_SAVER_MAX_JOBS];
+    LOCK();
+    if (job->id == id) state = job->state;
+    UNLOCK();
+    return state;
+}
+
+int AI_SAVER_NextDone(int *status) {
+    AI_SaveJob *job = NULL;
+    int i;
+
+#ifdef HAVE_PTHREAD_CREATE
+    if (wake_pipe[0] >= 0) {
+        char buf[64];
+        while (read(wake_pipe[0], buf, sizeof(buf)) > 0)
+            ;
+    }
+#endif
+    LOCK();
+    for (i = 0; i < AI_SAVER_MAX_JOBS; i++) {
+        if (jobs[i].id != 0 && jobs[i].state != AI_SAVER_PENDING && !jobs[i].reported
+            && (job == NULL || jobs[i].id < job->id))
+            job = &jobs[i];
+    }
+    if (job != NULL) {
+        job->reported = TRUE;
+        *status = job->state;
+    }
+    UNLOCK();
+    return job != NULL ? job->id : 0;
+}
+
+int AI_SAVER_WakeFd(void) {
+#ifdef HAVE_PTHREAD_CREATE
+    return wake_pipe[0];
+#else
+    return -1;
+#endif
+}
+
+void AI_SAVER_Exit(void) {
+#ifdef HAVE_PTHREAD_CREATE
+    LOCK();
+    if (!writer_running) {
+        UNLOCK();
+        return;
+    }
+    writer_stop = TRUE;
+    pthread_cond_signal(&jobs_queued);
+    UNLOCK();
+    /* The writer finishes the queue before it stops */
+    pthread_join(writer, NULL);
+    writer_running = FALSE;
+    close(wake_pipe[0]);
+    close(wake_pipe[1]);
+    wake_pipe[0] = wake_pipe[1] = -1;
+#endif
+}
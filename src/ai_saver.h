@@ -0,0 +1,47 @@
+/*
+ * ai_saver.h - Background state file writer for the AI interface
+ *
+ * "save_state" with "async" captures the state file into memory on the
+ * emulation thread, which is cheap, and queues it here; a writer thread
+ * then compresses it and writes it out, so periodic checkpoints do not
+ * stall the frame. Jobs complete in the order they were queued. Without
+ * thread support the write happens at once, inside AI_SAVER_Queue().
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+#ifndef AI_SAVER_H_
+#define AI_SAVER_H_
+
+#include "atari.h"
+
+#define AI_SAVER_MAX_JOBS 16  /* jobs queued or remembered at once */
+
+/* Job states */
+#define AI_SAVER_UNKNOWN -1  /* no such job, or too old to remember */
+#define AI_SAVER_PENDING  0
+#define AI_SAVER_DONE     1
+#define AI_SAVER_FAILED   2
+
+/* Queue a state captured with StateSav_CaptureAtariState() to be written
+   to path with a StateSav_CODEC_ codec; the queue takes over the image.
+   Returns the job id (ids count up from 1), or 0 if AI_SAVER_MAX_JOBS
+   jobs are still pending, in which case the image stays the caller's. */
+int AI_SAVER_Queue(const char *path, UBYTE *image, ULONG len, int codec);
+
+/* State of a job */
+int AI_SAVER_Status(int id);
+
+/* Id of a job that finished since it was last asked, with its state in
+   *status, or 0 if there is none */
+int AI_SAVER_NextDone(int *status);
+
+/* Descriptor that polls readable while finished jobs wait for
+   AI_SAVER_NextDone(), or -1 */
+int AI_SAVER_WakeFd(void);
+
+/* Finish the queued writes and stop the writer thread */
+void AI_SAVER_Exit(void);
+
+#endif /* AI_SAVER_H_ */
@@ -0,0 +1,234 @@
+/*
+ * ai_search.c - Narrowing memory searches for locating game variables
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+#include "config.h"
+#include <stdlib.h>
+#include <string.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "ai_search.h"
+#include "memory.h"
+#include "util.h"
+
+/* Copies start..end-1 of the CPU's view to the same place in dest */
+static void read_cpu(UBYTE *dest, int start, int end) {
+    int page, addr;
+
+    memcpy(dest + start, MEMORY_mem + start, end - start);
+    /* Only the pages with hardware registers need reading byte by byte */
+    for (page = start >> 8; page <= (end - 1) >> 8; page++) {
+        int from = page << 8 > start ? page << 8 : start;
+        int to = (page + 1) << 8 < end ? (page + 1) << 8 : end;
+#ifndef PAGED_ATTRIB
+        if (memchr(MEMORY_attrib + from, MEMORY_HARDWARE, to - from) == NULL)
+            continue;
+#else
+        if (MEMORY_readmap[page] == NULL)
+            continue;
+#endif
+        for (addr = from; addr < to; addr++)
+            dest[addr] = MEMORY_SafeGetByte(addr);
+    }
+}
+
+void AI_SEARCH_ReadCPU(UBYTE *dest) {
+    read_cpu(dest, 0, 0x10000);
+}
+
+/* Returns the bank size of a banked space and stores how many banks the
+   machine has now */
+static int bank_geometry(int space, int *banks) {
+    int kind = space - AI_SEARCH_XE + MEMORY_BANK_XE;
+    UBYTE probe;
+
+    *banks = 0;
+    while (MEMORY_ReadBank(kind, *banks, 0, &probe, 1))
+        (*banks)++;
+    return kind == MEMORY_BANK_MOSAIC ? 0x1000 : 0x4000;
+}
+
+/* Reads the memory searched, or with live_only just the blocks with
+   candidates left, to the same offsets in dest. FALSE if the machine no
+   longer has the memory the search started with. */
+static int read_space(const AI_SEARCH_t *s, UBYTE *dest, int live_only) {
+    int kind = s->space - AI_SEARCH_XE + MEMORY_BANK_XE;
+    int bank, banks;
+    ULONG i;
+
+    if (s->space != AI_SEARCH_CPU && (ULONG)bank_geometry(s->space, &banks) * banks != s->size)
+        return FALSE;
+    if (!live_only) {
+        if (s->space == AI_SEARCH_CPU)
+            AI_SEARCH_ReadCPU(dest);
+        else
+            for (bank = 0; bank < banks; bank++)
+                MEMORY_ReadBank(kind, bank, 0, dest + bank * s->bank_size, s->bank_size);
+        return TRUE;
+    }
+    for (i = 0; i < s->nlive; i++) {
+        ULONG offset = s->live_block[i] * AI_SEARCH_BLOCK;
+        if (s->space == AI_SEARCH_CPU)
+            read_cpu(dest, offset, offset + AI_SEARCH_BLOCK);
+        else
+            MEMORY_ReadBank(kind, offset / s->bank_size, offset % s->bank_size,
+                            dest + offset, AI_SEARCH_BLOCK);
+    }
+    return TRUE;
+}
+
+static int count_bits(ULONG bits) {
+#ifdef __GNUC__
+    return __builtin_popcount(bits);
+#else
+    int n = 0;
+    for (; bits != 0; bits &= bits - 1)
+        n++;
+    return n;
+#endif
+}
+
+/* The bytes of a block that satisfy op, from the masks of those equal to
+   and at most the value or old byte they are compared with */
+static ULONG block_matches(int op, const UBYTE *old, const UBYTE *now, UBYTE value) {
+    ULONG eq = 0, le = 0;
+#ifdef __SSE2__
+    __m128i v = _mm_set1_epi8((char)value);
+    int half;
+
+    for (half = 0; half < AI_SEARCH_BLOCK / 16; half++) {
+        __m128i n = _mm_loadu_si128((const __m128i *)(now + 16 * half));
+        __m128i o = op >= AI_SEARCH_CHANGED ? _mm_loadu_si128((const __m128i *)(old + 16 * half)) : v;
+        eq |= (ULONG)_mm_movemask_epi8(_mm_cmpeq_epi8(n, o)) << (16 * half);
+        /* unsigned n <= o where min(n, o) == n */
+        le |= (ULONG)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(n, o), n)) << (16 * half);
+    }
+#else
+    int i;
+
+    for (i = AI_SEARCH_BLOCK - 1; i >= 0; i--) {
+        UBYTE other = op >= AI_SEARCH_CHANGED ? old[i] : value;
+        eq = eq << 1 | (now[i] == other);
+        le = le << 1 | (now[i] <= other);
+    }
+#endif
+    switch (op) {
+    case AI_SEARCH_EQUAL:
+    case AI_SEARCH_UNCHANGED:
+        return eq;
+    case AI_SEARCH_NOT_EQUAL:
+    case AI_SEARCH_CHANGED:
+        return ~eq;
+    case AI_SEARCH_LESS:
+    case AI_SEARCH_DECREASED:
+        return le & ~eq;
+    case AI_SEARCH_GREATER:
+    case AI_SEARCH_INCREASED:
+        return ~le;
+    default:
+        return 0;
+    }
+}
+
+int AI_SEARCH_Start(AI_SEARCH_t *s, int space) {
+    ULONG size, blocks, i;
+    int banks, bank_size = 0;
+
+    if (space == AI_SEARCH_CPU)
+        size = 0x10000;
+    else if (space >= AI_SEARCH_XE && space <= AI_SEARCH_MOSAIC) {
+        bank_size = bank_geometry(space, &banks);
+        if (banks == 0)
+            return FALSE;
+        size = (ULONG)bank_size * banks;
+    }
+    else
+        return FALSE;
+
+    blocks = size / AI_SEARCH_BLOCK;
+    if (size != s->size) {
+        AI_SEARCH_Free(s);
+        s->snapshot = (UBYTE *)Util_malloc(size);
+        s->current = (UBYTE *)Util_malloc(size);
+        s->live_block = (ULONG *)Util_malloc(blocks * sizeof(ULONG));
+        s->live_bits = (ULONG *)Util_malloc(blocks * sizeof(ULONG));
+    }
+    s->space = space;
+    s->size = size;
+    s->bank_size = bank_size;
+    read_space(s, s->snapshot, FALSE);
+    for (i = 0; i < blocks; i++) {
+        s->live_block[i] = i;
+        s->live_bits[i] = 0xffffffff;
+    }
+    s->nlive = blocks;
+    s->count = size;
+    return TRUE;
+}
+
+long AI_SEARCH_Narrow(AI_SEARCH_t *s, int op, int value) {
+    ULONG i, n = 0, count = 0;
+    UBYTE *swap;
+
+    /* Once few blocks are left, reading just those is quicker, above all
+       those with hardware registers */
+    if (s->space < 0 || !read_space(s, s->current, s->nlive < s->size / AI_SEARCH_BLOCK / 8))
+        return -1;
+    for (i = 0; i < s->nlive; i++) {
+        ULONG offset = s->live_block[i] * AI_SEARCH_BLOCK;
+        ULONG bits = s->live_bits[i]
+            & block_matches(op, s->snapshot + offset, s->current + offset, (UBYTE)value);
+        if (bits == 0)
+            continue;
+        s->live_block[n] = s->live_block[i];
+        s->live_bits[n++] = bits;
+        count += count_bits(bits);
+    }
+    s->nlive = n;
+    s->count = count;
+    /* What was read is compared with at the next step */
+    swap = s->snapshot;
+    s->snapshot = s->current;
+    s->current = swap;
+    return (long)count;
+}
+
+ULONG AI_SEARCH_List(const AI_SEARCH_t *s, ULONG first, ULONG *offsets, ULONG max) {
+    ULONG i, n = 0;
+
+    for (i = 0; i < s->nlive && n < max; i++) {
+        ULONG bits = s->live_bits[i];
+        ULONG in_block = count_bits(bits);
+        int b;
+        if (first >= in_block) {
+            first -= in_block;
+            continue;
+        }
+        for (b = 0; bits != 0 && n < max; b++, bits >>= 1) {
+            if (!(bits & 1))
+                continue;
+            if (first > 0)
+                first--;
+            else
+                offsets[n++] = s->live_block[i] * AI_SEARCH_BLOCK + b;
+        }
+    }
+    return n;
+}
+
+void AI_SEARCH_Free(AI_SEARCH_t *s) {
+    free(s->snapshot);
+    free(s->current);
+    free(s->live_block);
+    free(s->live_bits);
+    s->snapshot = s->current = NULL;
+    s->live_block = s->live_bits = NULL;
+    s->space = -1;
+    s->size = 0;
+    s->nlive = s->count = 0;
+}
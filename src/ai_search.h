@@ -0,0 +1,77 @@
+/*
+ * ai_search.h - Narrowing memory searches for locating game variables
+ *
+ * A search starts from a snapshot of the memory in which every byte is a
+ * candidate, and each step keeps the candidates whose byte compares as
+ * asked, with a value or with the byte at the previous step, taking a new
+ * snapshot. Memory is read with memcpy and compared 16 bytes at a time
+ * where SSE2 is available, and the candidates are kept as a bitmap of
+ * which only the 32-byte blocks with some left are stored, so a step
+ * costs a few microseconds once the first ones have thinned them.
+ *
+ * Searches run over the 64 KB the CPU sees, hardware registers read
+ * without side effects, or over all the banks of the XE, Axlon or Mosaic
+ * RAM extension, switched in or not (see MEMORY_ReadBank()).
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+#ifndef AI_SEARCH_H_
+#define AI_SEARCH_H_
+
+#include "atari.h"
+
+/* What is searched */
+#define AI_SEARCH_CPU     0
+#define AI_SEARCH_XE      1
+#define AI_SEARCH_AXLON   2
+#define AI_SEARCH_MOSAIC  3
+
+/* What the candidates must satisfy: the first four compare the byte with
+   a value, the others with the byte at the previous step */
+#define AI_SEARCH_EQUAL      0
+#define AI_SEARCH_NOT_EQUAL  1
+#define AI_SEARCH_LESS       2
+#define AI_SEARCH_GREATER    3
+#define AI_SEARCH_CHANGED    4
+#define AI_SEARCH_UNCHANGED  5
+#define AI_SEARCH_INCREASED  6
+#define AI_SEARCH_DECREASED  7
+
+#define AI_SEARCH_BLOCK 32   /* bytes per bitmap word */
+
+typedef struct {
+    int space;           /* AI_SEARCH_CPU etc., -1 before the first start */
+    ULONG size;          /* bytes searched */
+    int bank_size;       /* bytes per bank, 0 for AI_SEARCH_CPU */
+    UBYTE *snapshot;     /* the memory at the last step */
+    UBYTE *current;      /* read into at each step */
+    ULONG *live_block;   /* blocks with candidates left, in order */
+    ULONG *live_bits;    /* their candidates, bit n for byte n */
+    ULONG nlive;
+    ULONG count;         /* candidates */
+} AI_SEARCH_t;
+
+#define AI_SEARCH_INIT {-1, 0, 0, NULL, NULL, NULL, NULL, 0, 0}
+
+/* Copies the 64 KB the CPU sees to dest, hardware registers as
+   MEMORY_SafeGetByte() reads them */
+void AI_SEARCH_ReadCPU(UBYTE *dest);
+
+/* Starts a search of space with every byte a candidate. Returns FALSE if
+   the machine has no such memory. */
+int AI_SEARCH_Start(AI_SEARCH_t *s, int space);
+
+/* Keeps the candidates that satisfy op and returns how many are left,
+   or -1 if no search was started or its memory is gone */
+long AI_SEARCH_Narrow(AI_SEARCH_t *s, int op, int value);
+
+/* Stores the offsets of up to max candidates, skipping the first ones;
+   returns how many it stored. In a banked space an offset is
+   bank * bank_size + the offset in the bank. */
+ULONG AI_SEARCH_List(const AI_SEARCH_t *s, ULONG first, ULONG *offsets, ULONG max);
+
+void AI_SEARCH_Free(AI_SEARCH_t *s);
+
+#endif /* AI_SEARCH_H_ */
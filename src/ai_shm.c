@@ -0,0 +1,237 @@
+/*
+ * ai_shm.c - Shared-memory observation export for the AI interface
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+#define _POSIX_C_SOURCE 200112L /* for shm_open and ftruncate */
+
+#include "config.h"
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+
+#ifdef HAVE_SHM_OPEN
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "ai_shm.h"
+#include "ai_interface.h"
+#include "atari.h"
+#include "cpu.h"
+#include "memory.h"
+#include "antic.h"
+#include "gtia.h"
+#include "pokey.h"
+#include "pia.h"
+#include "screen.h"
+#include "log.h"
+#ifdef SOUND
+#include "sound.h"
+#endif
+
+/* Full barrier so readers never see seq change before the data does */
+#if defined(__GNUC__)
+#define AI_SHM_BARRIER() __sync_synchronize()
+#else
+#define AI_SHM_BARRIER() do { } while (0)
+#endif
+
+#define AI_SHM_SCREEN_SIZE (Screen_WIDTH * Screen_HEIGHT)
+#define AI_SHM_MEMORY_SIZE 65536
+
+static AI_SHM_Header *shm_header = NULL;
+static size_t shm_size = 0;
+static char shm_name[256];
+
+int AI_SHM_Open(const char *name, int audio) {
+#ifdef HAVE_SHM_OPEN
+    int fd;
+    void *p;
+
+#ifndef SOUND
+    if (audio) {
+        Log_print("AI: Shared-memory audio needs sound support");
+        return FALSE;
+    }
+#endif
+
+    if (name[0] == '/')
+        snprintf(shm_name, sizeof(shm_name), "%s", name);
+    else
+        snprintf(shm_name, sizeof(shm_name), "/%s", name);
+
+    shm_size = sizeof(AI_SHM_Header) + AI_SHM_SCREEN_SIZE + AI_SHM_MEMORY_SIZE;
+    if (audio) shm_size += AI_SHM_AUDIO_SIZE;
+
+    fd = shm_open(shm_name, O_CREAT | O_RDWR, 0600);
+    if (fd < 0) {
+        Log_print("AI: shm_open(%s) failed: %s", shm_name, strerror(errno));
+        return FALSE;
+    }
+    if (ftruncate(fd, (off_t)shm_size) < 0) {
+        Log_print("AI: Failed to size shared memory %s: %s", shm_name, strerror(errno));
+        close(fd);
+        shm_unlink(shm_name);
+        return FALSE;
+    }
+    p = mmap(NULL, shm_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) {
+        Log_print("AI: Failed to map shared memory %s: %s", shm_name, strerror(errno));
+        shm_unlink(shm_name);
+        return FALSE;
+    }
+
+    shm_header = (AI_SHM_Header *)p;
+    memset(shm_header, 0, sizeof(AI_SHM_Header));
+    shm_header->version = AI_SHM_VERSION;
+    shm_header->size = (ULONG)shm_size;
+    shm_header->screen_offset = sizeof(AI_SHM_Header);
+    shm_header->memory_offset = sizeof(AI_SHM_Header) + AI_SHM_SCREEN_SIZE;
+    shm_header->screen_width = Screen_WIDTH;
+    shm_header->screen_height = Screen_HEIGHT;
+    if (audio) {
+        shm_header->audio_offset = shm_header->memory_offset + AI_SHM_MEMORY_SIZE;
+        shm_header->audio_size = AI_SHM_AUDIO_SIZE;
+    }
+    AI_SHM_BARRIER();
+    /* Magic goes in last so a reader never trusts a half-built header */
+    shm_header->magic = AI_SHM_MAGIC;
+
+    Log_print("AI: Publishing frames to shared memory %s (%lu bytes)",
+              shm_name, (unsigned long)shm_size);
+    return TRUE;
+#else
+    Log_print("AI: Shared memory export is not supported on this platform");
+    return FALSE;
+#endif
+}
+
+void AI_SHM_Publish(void) {
+    AI_SHM_Header *h = shm_header;
+    UBYTE *base;
+    int i;
+
+    if (h == NULL) return;
+    base = (UBYTE *)h;
+
+    h->seq++;  /* odd: write in progress */
+    AI_SHM_BARRIER();
+
+    h->frame = (ULONG)Atari800_nframes;
+    memcpy(base + h->screen_offset, Screen_atari, AI_SHM_SCREEN_SIZE);
+    memcpy(base + h->memory_offset, MEMORY_mem, AI_SHM_MEMORY_SIZE);
+
+    CPU_GetStatus();
+    h->cpu_pc = CPU_regPC;
+    h->cpu_a = CPU_regA;
+    h->cpu_x = CPU_regX;
+    h->cpu_y = CPU_regY;
+    h->cpu_sp = CPU_regS;
+    h->cpu_p = CPU_regP;
+
+    for (i = 0; i < 32; i++)
+        h->gtia[i] = GTIA_GetByte((UWORD)(0xd000 + i), TRUE);
+    for (i = 0; i < 16; i++) {
+        h->pokey[i] = POKEY_GetByte((UWORD)(0xd200 + i), TRUE);
+        h->antic[i] = ANTIC_GetByte((UWORD)(0xd400 + i), TRUE);
+    }
+    for (i = 0; i < 4; i++)
+        h->pia[i] = PIA_GetByte((UWORD)(0xd300 + i), TRUE);
+
+    h->gtia_write[0x00] = GTIA_HPOSP0;
+    h->gtia_write[0x01] = GTIA_HPOSP1;
+    h->gtia_write[0x02] = GTIA_HPOSP2;
+    h->gtia_write[0x03] = GTIA_HPOSP3;
+    h->gtia_write[0x04] = GTIA_HPOSM0;
+    h->gtia_write[0x05] = GTIA_HPOSM1;
+    h->gtia_write[0x06] = GTIA_HPOSM2;
+    h->gtia_write[0x07] = GTIA_HPOSM3;
+    h->gtia_write[0x08] = GTIA_SIZEP0;
+    h->gtia_write[0x09] = GTIA_SIZEP1;
+    h->gtia_write[0x0a] = GTIA_SIZEP2;
+    h->gtia_write[0x0b] = GTIA_SIZEP3;
+    h->gtia_write[0x0c] = GTIA_SIZEM;
+    h->gtia_write[0x0d] = GTIA_GRAFP0;
+    h->gtia_write[0x0e] = GTIA_GRAFP1;
+    h->gtia_write[0x0f] = GTIA_GRAFP2;
+    h->gtia_write[0x10] = GTIA_GRAFP3;
+    h->gtia_write[0x11] = GTIA_GRAFM;
+    h->gtia_write[0x12] = GTIA_COLPM0;
+    h->gtia_write[0x13] = GTIA_COLPM1;
+    h->gtia_write[0x14] = GTIA_COLPM2;
+    h->gtia_write[0x15] = GTIA_COLPM3;
+    h->gtia_write[0x16] = GTIA_COLPF0;
+    h->gtia_write[0x17] = GTIA_COLPF1;
+    h->gtia_write[0x18] = GTIA_COLPF2;
+    h->gtia_write[0x19] = GTIA_COLPF3;
+    h->gtia_write[0x1a] = GTIA_COLBK;
+    h->gtia_write[0x1b] = GTIA_PRIOR;
+    h->gtia_write[0x1c] = GTIA_VDELAY;
+    h->gtia_write[0x1d] = GTIA_GRACTL;
+
+    for (i = 0; i < 4; i++) {
+        h->pokey_write[i * 2] = POKEY_AUDF[i];
+        h->pokey_write[i * 2 + 1] = POKEY_AUDC[i];
+    }
+    h->pokey_write[0x08] = POKEY_AUDCTL[0];
+    h->pokey_write[0x0e] = POKEY_IRQEN;
+    h->pokey_write[0x0f] = POKEY_SKCTL;
+
+    h->antic_write[0x00] = ANTIC_DMACTL;
+    h->antic_write[0x01] = ANTIC_CHACTL;
+    h->antic_write[0x02] = (UBYTE)(ANTIC_dlist & 0xff);
+    h->antic_write[0x03] = (UBYTE)(ANTIC_dlist >> 8);
+    h->antic_write[0x04] = ANTIC_HSCROL;
+    h->antic_write[0x05] = ANTIC_VSCROL;
+    h->antic_write[0x07] = ANTIC_PMBASE;
+    h->antic_write[0x09] = ANTIC_CHBASE;
+    h->antic_write[0x0e] = ANTIC_NMIEN;
+
+    h->env_channels = (UBYTE)AI_AudioEnvelopes(h->env[0]);
+    h->audio_frame_bytes = 0;
+#ifdef SOUND
+    if (h->audio_size != 0) {
+        unsigned int len;
+        UBYTE const *samples = Sound_FrameSamples(&len);
+        UBYTE *ring = base + h->audio_offset;
+        /* The output format can change whenever sound is set up again */
+        h->audio_channels = Sound_enabled ? (UBYTE)Sound_out.channels : 0;
+        h->audio_sample_bytes = Sound_enabled ? (UBYTE)Sound_out.sample_size : 0;
+        h->audio_rate = Sound_enabled ? Sound_out.freq : 0;
+        h->audio_frame_bytes = len;
+        if (len > AI_SHM_AUDIO_SIZE) {
+            /* Only the newest ring-full survives anyway */
+            samples += len - AI_SHM_AUDIO_SIZE;
+            h->audio_written += len - AI_SHM_AUDIO_SIZE;
+            len = AI_SHM_AUDIO_SIZE;
+        }
+        while (len > 0) {
+            ULONG pos = h->audio_written % AI_SHM_AUDIO_SIZE;
+            unsigned int n = AI_SHM_AUDIO_SIZE - pos;
+            if (n > len) n = len;
+            memcpy(ring + pos, samples, n);
+            samples += n;
+            len -= n;
+            h->audio_written += n;
+        }
+    }
+#endif
+
+    AI_SHM_BARRIER();
+    h->seq++;  /* even: consistent */
+}
+
+void AI_SHM_Close(void) {
+#ifdef HAVE_SHM_OPEN
+    if (shm_header == NULL) return;
+    munmap(shm_header, shm_size);
+    shm_header = NULL;
+    shm_unlink(shm_name);
+#endif
+}
@@ -0,0 +1,87 @@
+/*
+ * ai_shm.h - Shared-memory observation export for the AI interface
+ *
+ * With "-ai-shm <name>" the emulator maps a POSIX shared-memory segment and
+ * publishes the current frame, the 64 KB memory image and chip register
+ * snapshots into it once per frame, so agents can observe the machine
+ * without any socket round-trip. With "-ai-shm-audio" as well, the samples
+ * each frame produces are appended to a ring after the memory image.
+ *
+ * Readers use the seqlock in AI_SHM_Header.seq:
+ *   1. s1 = seq; if s1 is odd, a frame is being written - retry
+ *   2. copy whatever fields are needed
+ *   3. s2 = seq; if s2 != s1 the copy is torn - retry
+ *
+ * The audio ring holds the last audio_size bytes of samples: byte number
+ * N of the stream (counted from the start, modulo 2^32 like audio_written)
+ * is at audio_offset + N % audio_size. A reader keeps its own position,
+ * copies the bytes from there up to audio_written, and has lost whatever
+ * fell more than audio_size bytes behind.
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+#ifndef AI_SHM_H_
+#define AI_SHM_H_
+
+#include "atari.h"
+
+#define AI_SHM_MAGIC   0x4D485341  /* "ASHM" little-endian */
+#define AI_SHM_VERSION 2
+
+#define AI_SHM_AUDIO_SIZE 262144  /* bytes in the PCM ring, a power of 2 */
+
+/* Segment layout: this header, then the screen, then the memory image,
+   then the audio ring if there is one. All fields are in host byte order. */
+typedef struct AI_SHM_Header {
+    ULONG magic;             /* AI_SHM_MAGIC */
+    ULONG version;           /* AI_SHM_VERSION */
+    ULONG size;              /* total size of the segment in bytes */
+    volatile ULONG seq;      /* seqlock counter, odd while publishing */
+    ULONG frame;             /* Atari800_nframes at publish time */
+    ULONG screen_offset;     /* offset of screen_width * screen_height pixels */
+    ULONG memory_offset;     /* offset of the 64 KB MEMORY_mem image */
+    UWORD screen_width;
+    UWORD screen_height;
+
+    /* CPU registers */
+    UWORD cpu_pc;
+    UBYTE cpu_a, cpu_x, cpu_y, cpu_sp, cpu_p;
+    UBYTE reserved;
+
+    /* Chip registers as the CPU would read them (no side effects) */
+    UBYTE gtia[32];          /* $D000-$D01F */
+    UBYTE pokey[16];         /* $D200-$D20F */
+    UBYTE pia[4];            /* $D300-$D303 */
+    UBYTE antic[16];         /* $D400-$D40F */
+
+    /* Write-only registers, indexed by register offset */
+    UBYTE gtia_write[32];    /* HPOSPx, SIZEx, GRAFx, COLxx, PRIOR, VDELAY, GRACTL */
+    UBYTE pokey_write[16];   /* AUDFx/AUDCx, AUDCTL, IRQEN, SKCTL */
+    UBYTE antic_write[16];   /* DMACTL, CHACTL, DLISTL/H, HSCROL, VSCROL, PMBASE, CHBASE, NMIEN */
+
+    /* Version 2: audio */
+    UBYTE env_channels;      /* POKEY channels in env, 4 or 8 */
+    UBYTE audio_channels;    /* 1 = mono, 2 = stereo; 0 without sound output */
+    UBYTE audio_sample_bytes; /* 1 = unsigned 8-bit, 2 = signed 16-bit */
+    UBYTE reserved2;
+    UBYTE env[8][4];         /* tone of each channel, see AI_AudioEnvelopes() */
+    ULONG audio_rate;        /* sample rate in Hz */
+    ULONG audio_offset;      /* offset of the ring, 0 without one */
+    ULONG audio_size;        /* ring length in bytes, 0 without one */
+    ULONG audio_written;     /* bytes of samples appended so far, modulo 2^32 */
+    ULONG audio_frame_bytes; /* bytes the published frame appended */
+} AI_SHM_Header;
+
+/* Create and map the segment; name gets a leading '/' if it lacks one.
+   AUDIO adds the PCM ring, which stays empty while sound output is off. */
+int AI_SHM_Open(const char *name, int audio);
+
+/* Publish the current machine state (call once per frame) */
+void AI_SHM_Publish(void);
+
+/* Unmap and unlink the segment */
+void AI_SHM_Close(void);
+
+#endif /* AI_SHM_H_ */
@@ -0,0 +1,187 @@
+/*
+ * ai_timeline.c - Timeline of where the emulator's threads spend their time
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+#include "config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ai_timeline.h"
+#include "ai_interface.h"
+#include "log.h"
+#include "util.h"
+
+/* Each thread's spans are stored before its head is moved past them, so
+   the writer sees only whole spans */
+#if defined(__GNUC__)
+#define TIMELINE_BARRIER() __sync_synchronize()
+#else
+#define TIMELINE_BARRIER() do { } while (0)
+#endif
+
+typedef struct {
+    double start;
+    double end;
+    char name[AI_TIMELINE_NAME];
+} span_t;
+
+typedef struct {
+    span_t *spans;               /* ring of ring_size, allocated on first use */
+    volatile ULONG head;         /* spans recorded, the next goes at head % ring_size */
+    double open[AI_TIMELINE_DEPTH];
+    const char *open_name[AI_TIMELINE_DEPTH];
+    int depth;                   /* AI_TIMELINE_Begin()s not yet ended */
+} thread_t;
+
+static const char * const thread_names[AI_TIMELINE_THREADS] = {
+    "emulator", "audio", "encoder", "netsio rx"};
+
+volatile int AI_TIMELINE_enabled = FALSE;
+
+static thread_t threads[AI_TIMELINE_THREADS];
+static ULONG ring_size;
+static FILE *timeline_fp = NULL;
+static double origin;            /* AI_Ticks() at the start */
+static int started_timing;       /* frame timing was turned on for us */
+
+/* Rings are freed only when the next timeline starts, in case a thread
+   was still recording a span as the last one stopped */
+static void reset_threads(void) {
+    int i;
+    for (i = 0; i < AI_TIMELINE_THREADS; i++) {
+        free(threads[i].spans);
+        memset(&threads[i], 0, sizeof(thread_t));
+    }
+}
+
+int AI_TIMELINE_Start(const char *path, int events) {
+    FILE *fp = fopen(path, "w");
+
+    if (fp == NULL)
+        return FALSE;
+    if (timeline_fp != NULL) {
+        AI_TIMELINE_enabled = FALSE;
+        fclose(timeline_fp);
+    }
+    else
+        started_timing = !AI_frame_timing;
+    timeline_fp = fp;
+    reset_threads();
+    ring_size = events > 0 ? (ULONG)events : AI_TIMELINE_EVENTS;
+    if (!AI_frame_timing)
+        AI_SetFrameTiming(TRUE);
+    origin = AI_Ticks();
+    TIMELINE_BARRIER();
+    AI_TIMELINE_enabled = TRUE;
+    return TRUE;
+}
+
+void AI_TIMELINE_Span(int thread, const char *name, double start, double end) {
+    thread_t *t = &threads[thread];
+    span_t *s;
+    size_t len;
+
+    if (t->spans == NULL)
+        t->spans = (span_t *)Util_malloc(ring_size * sizeof(span_t));
+    s = &t->spans[t->head % ring_size];
+    s->start = start;
+    s->end = end;
+    len = strlen(name);
+    if (len >= AI_TIMELINE_NAME)
+        len = AI_TIMELINE_NAME - 1;
+    memcpy(s->name, name, len);
+    s->name[len] = '\0';
+    TIMELINE_BARRIER();
+    t->head++;
+}
+
+void AI_TIMELINE_Begin(int thread, const char *name) {
+    thread_t *t = &threads[thread];
+    if (t->depth < AI_TIMELINE_DEPTH) {
+        t->open[t->depth] = AI_Ticks();
+        t->open_name[t->depth] = name;
+    }
+    t->depth++;
+}
+
+void AI_TIMELINE_End(int thread) {
+    thread_t *t = &threads[thread];
+    /* An End for a Begin from before the start is dropped */
+    if (t->depth == 0)
+        return;
+    if (--t->depth < AI_TIMELINE_DEPTH)
+        AI_TIMELINE_Span(thread, t->open_name[t->depth], t->open[t->depth], AI_Ticks());
+}
+
+static void get_stats(AI_TIMELINE_Stats *stats) {
+    int i;
+    stats->spans = stats->dropped = 0.0;
+    stats->error = FALSE;
+    for (i = 0; i < AI_TIMELINE_THREADS; i++) {
+        stats->spans += threads[i].head;
+        if (threads[i].head > ring_size)
+            stats->dropped += threads[i].head - ring_size;
+    }
+}
+
+int AI_TIMELINE_Status(AI_TIMELINE_Stats *stats) {
+    if (timeline_fp == NULL)
+        return FALSE;
+    get_stats(stats);
+    return TRUE;
+}
+
+/* Writes a span name as a JSON string, without what would need escaping */
+static void write_name(FILE *fp, const char *name) {
+    fputc('"', fp);
+    for (; *name; name++)
+        fputc(*name == '"' || *name == '\\' || (UBYTE)*name < 0x20 ? '?' : *name, fp);
+    fputc('"', fp);
+}
+
+int AI_TIMELINE_Stop(AI_TIMELINE_Stats *stats) {
+    double us = AI_TickSeconds() * 1e6;
+    int first = TRUE;
+    int i, error;
+    AI_TIMELINE_Stats s;
+
+    if (timeline_fp == NULL)
+        return FALSE;
+    AI_TIMELINE_enabled = FALSE;
+    TIMELINE_BARRIER();
+    get_stats(&s);
+
+    fprintf(timeline_fp, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    for (i = 0; i < AI_TIMELINE_THREADS; i++) {
+        thread_t *t = &threads[i];
+        ULONG n;
+        if (t->spans == NULL)
+            continue;
+        fprintf(timeline_fp, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+                "\"args\":{\"name\":\"%s\"}}", first ? "" : ",\n", i + 1, thread_names[i]);
+        first = FALSE;
+        /* A full ring: its oldest span may have been being overwritten */
+        for (n = t->head > ring_size ? t->head - ring_size + 1 : 0; n < t->head; n++) {
+            const span_t *span = &t->spans[n % ring_size];
+            fprintf(timeline_fp, ",\n{\"name\":");
+            write_name(timeline_fp, span->name);
+            fprintf(timeline_fp, ",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                    i + 1, (span->start - origin) * us, (span->end - span->start) * us);
+        }
+    }
+    fprintf(timeline_fp, "\n]}\n");
+    error = ferror(timeline_fp) | fclose(timeline_fp);
+    timeline_fp = NULL;
+    if (error)
+        Log_print("AI: Cannot write the timeline file");
+    s.error = error != 0;
+    if (started_timing)
+        AI_SetFrameTiming(FALSE);
+    if (stats != NULL)
+        *stats = s;
+    return TRUE;
+}
@@ -0,0 +1,72 @@
+/*
+ * ai_timeline.h - Timeline of where the emulator's threads spend their time
+ *
+ * While a timeline is being recorded, each instrumented thread appends a
+ * span, a name with its start and end time, to a ring of its own for
+ * every stretch of work: on the emulation thread each frame and its
+ * stages down to every CPU_GO() run and the ANTIC work between them (the
+ * stages of frame timing, which the timeline turns on) and each AI
+ * command; the sound callback on the audio thread; each recording job on
+ * the encoder thread; each batch of packets on the NetSIO receive
+ * thread. A thread only ever writes its own ring, without locks; a full
+ * ring overwrites its oldest spans, so the file holds the last stretch
+ * of the run.
+ *
+ * When it stops the timeline is written as Chrome trace event JSON, which
+ * chrome://tracing and Perfetto load, and Tracy's import-chrome converts.
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+#ifndef AI_TIMELINE_H_
+#define AI_TIMELINE_H_
+
+#include "atari.h"
+
+#define AI_TIMELINE_EVENTS 262144  /* default spans kept per thread */
+#define AI_TIMELINE_NAME 24        /* span names are cut to 23 chars */
+#define AI_TIMELINE_DEPTH 8        /* open AI_TIMELINE_BEGIN()s per thread */
+
+/* The threads the timeline knows; each has one ring */
+#define AI_TIMELINE_EMULATOR 0
+#define AI_TIMELINE_AUDIO    1
+#define AI_TIMELINE_ENCODER  2
+#define AI_TIMELINE_NETSIO   3
+#define AI_TIMELINE_THREADS  4
+
+/* TRUE while a timeline is being recorded */
+extern volatile int AI_TIMELINE_enabled;
+
+typedef struct {
+    double spans;    /* spans recorded */
+    double dropped;  /* of those, overwritten by later ones */
+    int error;       /* the file could not be written */
+} AI_TIMELINE_Stats;
+
+/* Start recording a timeline for path, keeping up to events spans per
+   thread (0 for AI_TIMELINE_EVENTS), and turn frame timing on for its
+   stages. Replaces a timeline being recorded, which is discarded.
+   Returns FALSE if path cannot be created. */
+int AI_TIMELINE_Start(const char *path, int events);
+
+/* Stop recording and write the file; fills *stats if not NULL. Returns
+   FALSE if no timeline was being recorded. */
+int AI_TIMELINE_Stop(AI_TIMELINE_Stats *stats);
+
+/* Spans so far, for a status reply. Returns FALSE if none is recording. */
+int AI_TIMELINE_Status(AI_TIMELINE_Stats *stats);
+
+/* Record a span of thread from start to end, in AI_Ticks() */
+void AI_TIMELINE_Span(int thread, const char *name, double start, double end);
+
+/* Open and close a span on the calling thread; they nest */
+void AI_TIMELINE_Begin(int thread, const char *name);
+void AI_TIMELINE_End(int thread);
+
+#define AI_TIMELINE_BEGIN(thread, name) \
+    do { if (AI_TIMELINE_enabled) AI_TIMELINE_Begin(thread, name); } while (0)
+#define AI_TIMELINE_END(thread) \
+    do { if (AI_TIMELINE_enabled) AI_TIMELINE_End(thread); } while (0)
+
+#endif /* AI_TIMELINE_H_ */
@@ -0,0 +1,191 @@
+/*
+ * ai_trace.c - Binary execution trace for the AI interface
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+#include "config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef HAVE_PTHREAD_CREATE
+#include <pthread.h>
+#endif
+
+#include "ai_trace.h"
+#include "cpu.h"
+#include "log.h"
+
+#define CHUNK_BYTES (AI_TRACE_CHUNK_RECORDS * AI_TRACE_RECORD)
+
+UBYTE *AI_trace_pos = NULL;
+UBYTE *AI_trace_end = NULL;
+
+static FILE *trace_fp = NULL;
+static UBYTE *buffer = NULL;
+static UBYTE *chunks[AI_TRACE_CHUNKS];
+/* Bytes of chunk i waiting for the writer, 0 = free. The emulator fills
+   chunk fill; the writer takes them from head, in order. */
+static ULONG queued[AI_TRACE_CHUNKS];
+static int fill;
+static int head;
+static double records_done;  /* records in chunks handed over */
+static ULONG stalls;
+static int write_error;
+
+#ifdef HAVE_PTHREAD_CREATE
+static pthread_mutex_t trace_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t chunk_queued = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t chunk_freed = PTHREAD_COND_INITIALIZER;
+static pthread_t writer;
+static int writer_running = FALSE;
+static int writer_stop = FALSE;
+#define LOCK()   pthread_mutex_lock(&trace_lock)
+#define UNLOCK() pthread_mutex_unlock(&trace_lock)
+#else
+#define LOCK()   do { } while (0)
+#define UNLOCK() do { } while (0)
+#endif
+
+static void write_chunk(int i, ULONG len) {
+    int failed = fwrite(chunks[i], 1, len, trace_fp) != len;
+
+    if (failed) {
+        LOCK();
+        if (!write_error) Log_print("AI: Cannot write the trace file, the rest of the trace is lost");
+        write_error = TRUE;
+        UNLOCK();
+    }
+}
+
+#ifdef HAVE_PTHREAD_CREATE
+static void *writer_main(void *arg) {
+    (void)arg;
+    for (;;) {
+        ULONG len;
+
+        LOCK();
+        while (queued[head] == 0 && !writer_stop)
+            pthread_cond_wait(&chunk_queued, &trace_lock);
+        len = queued[head];
+        UNLOCK();
+        /* The queue is written out before the writer stops */
+        if (len == 0) return NULL;
+
+        write_chunk(head, len);
+        LOCK();
+        queued[head] = 0;
+        head = (head + 1) % AI_TRACE_CHUNKS;
+        pthread_cond_signal(&chunk_freed);
+        UNLOCK();
+    }
+}
+#endif
+
+/* Pass len bytes of the chunk being filled to the writer and move on to
+   a free chunk */
+static void hand_over(ULONG len) {
+    records_done += len / AI_TRACE_RECORD;
+    if (len == 0) return;
+#ifdef HAVE_PTHREAD_CREATE
+    if (writer_running) {
+        int next = (fill + 1) % AI_TRACE_CHUNKS;
+        LOCK();
+        queued[fill] = len;
+        pthread_cond_signal(&chunk_queued);
+        while (queued[next] != 0) {
+            stalls++;
+            pthread_cond_wait(&chunk_freed, &trace_lock);
+        }
+        fill = next;
+        UNLOCK();
+        return;
+    }
+#endif
+    write_chunk(fill, len);
+}
+
+void AI_TRACE_Flush(void) {
+    hand_over((ULONG) (AI_trace_pos - chunks[fill]));
+    AI_trace_pos = chunks[fill];
+    AI_trace_end = chunks[fill] + CHUNK_BYTES;
+}
+
+int AI_TRACE_Start(const char *path) {
+    UBYTE header[AI_TRACE_HEADER];
+    int i;
+
+    if (AI_trace_pos != NULL) AI_TRACE_Stop(NULL);
+    buffer = (UBYTE *)malloc((size_t)CHUNK_BYTES * AI_TRACE_CHUNKS);
+    if (buffer == NULL) return FALSE;
+    trace_fp = fopen(path, "wb");
+    if (trace_fp == NULL) {
+        free(buffer);
+        buffer = NULL;
+        return FALSE;
+    }
+    memset(header, 0, sizeof(header));
+    memcpy(header, "A8TRACE", 7);
+    header[8] = AI_TRACE_VERSION & 0xff;
+    header[9] = AI_TRACE_VERSION >> 8;
+    header[10] = AI_TRACE_RECORD & 0xff;
+    header[11] = AI_TRACE_RECORD >> 8;
+    write_error = fwrite(header, 1, sizeof(header), trace_fp) != sizeof(header);
+
+    for (i = 0; i < AI_TRACE_CHUNKS; i++) {
+        chunks[i] = buffer + (size_t)CHUNK_BYTES * i;
+        queued[i] = 0;
+    }
+    fill = head = 0;
+    records_done = 0;
+    stalls = 0;
+#ifdef HAVE_PTHREAD_CREATE
+    writer_stop = FALSE;
+    writer_running = pthread_create(&writer, NULL, writer_main, NULL) == 0;
+    if (!writer_running)
+        Log_print("AI: Cannot start the trace writer thread, writing in the foreground");
+#endif
+    AI_trace_pos = chunks[0];
+    AI_trace_end = chunks[0] + CHUNK_BYTES;
+    CPU_UpdateGo();
+    return TRUE;
+}
+
+int AI_TRACE_Status(AI_TRACE_Stats *stats) {
+    if (AI_trace_pos == NULL) return FALSE;
+    stats->records = records_done + (AI_trace_pos - chunks[fill]) / AI_TRACE_RECORD;
+    LOCK();
+    stats->stalls = stalls;
+    stats->error = write_error;
+    UNLOCK();
+    return TRUE;
+}
+
+int AI_TRACE_Stop(AI_TRACE_Stats *stats) {
+    if (AI_trace_pos == NULL) return FALSE;
+    hand_over((ULONG) (AI_trace_pos - chunks[fill]));
+    AI_trace_pos = AI_trace_end = NULL;
+    CPU_UpdateGo();
+#ifdef HAVE_PTHREAD_CREATE
+    if (writer_running) {
+        LOCK();
+        writer_stop = TRUE;
+        pthread_cond_signal(&chunk_queued);
+        UNLOCK();
+        pthread_join(writer, NULL);
+        writer_running = FALSE;
+    }
+#endif
+    if (fclose(trace_fp) != 0) write_error = TRUE;
+    trace_fp = NULL;
+    free(buffer);
+    buffer = NULL;
+    if (stats != NULL) {
+        stats->records = records_done;
+        stats->stalls = stalls;
+        stats->error = write_error;
+    }
+    return TRUE;
+}
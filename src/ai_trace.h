@@ -0,0 +1,64 @@
+/*
+ * ai_trace.h - Binary execution trace for the AI interface
+ *
+ * The tracing CPU loop appends one fixed-size record per instruction to
+ * a chunk in memory; full chunks are handed to a writer thread, which
+ * writes them out while the emulator fills the next one. Nothing is
+ * dropped: if the writer falls behind by AI_TRACE_CHUNKS chunks the
+ * emulator waits for it. tools/trace_decode turns a trace into the text
+ * the monitor's TRACE command writes.
+ *
+ * The file is a 16-byte header, "A8TRACE" and a 0, then the version and
+ * the record size as little-endian 16-bit words and 4 zero bytes,
+ * followed by 16-byte records:
+ *
+ *   0-1   PC, little-endian
+ *   2-4   opcode and the two bytes after it
+ *   5-9   A, X, Y, P, S
+ *   10    ANTIC horizontal position, as the monitor shows it
+ *   11    scanline, bits 7-0
+ *   12-15 CPU cycle, 31 bits, little-endian; bit 31 is bit 8 of the
+ *         scanline. The cycle wraps about every 20 minutes of machine time.
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+#ifndef AI_TRACE_H_
+#define AI_TRACE_H_
+
+#include "atari.h"
+
+#define AI_TRACE_VERSION 1
+#define AI_TRACE_HEADER 16
+#define AI_TRACE_RECORD 16
+#define AI_TRACE_CHUNK_RECORDS 65536  /* records handed over at a time */
+#define AI_TRACE_CHUNKS 8             /* chunks in flight */
+
+/* Next record and the end of the chunk being filled; NULL when no trace
+   is being written */
+extern UBYTE *AI_trace_pos;
+extern UBYTE *AI_trace_end;
+
+typedef struct {
+    double records;  /* records written or queued */
+    ULONG stalls;    /* times the emulator waited for the writer */
+    int error;       /* a write failed; the rest of the trace is lost */
+} AI_TRACE_Stats;
+
+/* Start writing a trace to path, replacing one already being written.
+   Returns FALSE if the file cannot be created. */
+int AI_TRACE_Start(const char *path);
+
+/* Finish the trace; fills *stats if not NULL. Returns FALSE if no trace
+   was being written. */
+int AI_TRACE_Stop(AI_TRACE_Stats *stats);
+
+/* Statistics of the trace being written. Returns FALSE if none is. */
+int AI_TRACE_Status(AI_TRACE_Stats *stats);
+
+/* Hand over the full chunk and start the next; called by the CPU when
+   AI_trace_pos reaches AI_trace_end */
+void AI_TRACE_Flush(void);
+
+#endif /* AI_TRACE_H_ */
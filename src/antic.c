@@ -47,6 +47,18 @@
 #ifdef NEW_CYCLE_EXACT
 #include "cycle_map.h"
 #endif
+#if defined(__SSE2__) && !defined(USE_COLOUR_TRANSLATION_TABLE) && !defined(DIRTYRECT)
+/* GTIA modes 9, 10 and 11 draw 16 characters at a time where no player or
+   missile covers them, see gtia_simd_chars() */
+#define GTIA_SIMD
+#include <emmintrin.h>
+#endif
+#if defined(ANTIC_RENDER_THREAD) && !defined(ANTIC_RENDER_INSTANCE)
+/* this instance logs the lines the renderer thread draws, see antic_render.h */
+#define DEFER_DRAWING
+#include <pthread.h>
+#include <stdlib.h>
+#endif
 
 #define LCHOP 3			/* do not build leftmost 0..3 characters in wide mode */
 #define RCHOP 3			/* do not build rightmost 0..3 characters in wide mode */
@@ -72,6 +84,11 @@ static int dmactl_bug_chdata;
 #ifndef NO_SIMPLE_PAL_BLENDING
 int ANTIC_pal_blending = 0;
 #endif /* NO_SIMPLE_PAL_BLENDING */
+int ANTIC_scanline_cache = FALSE;
+static ULONG scanline_cache_generation = 0;
+#ifdef ANTIC_RENDER_THREAD
+int ANTIC_render_thread = FALSE;
+#endif
 
 /* Video memory access is hidden behind these macros. It allows to track dirty video memory
    to improve video system performance */
@@ -441,6 +458,11 @@ unsigned int ANTIC_screenline_cpu_clock = 0;
 int ANTIC_xpos = 0;
 int ANTIC_xpos_limit;
 int ANTIC_wsync_halt = FALSE;
+int ANTIC_batch_lines = 0;
+
+ANTIC_cycles_t ANTIC_cycles;
+ANTIC_cycles_t ANTIC_frame_cycles;
+static unsigned int frame_start_clock = 0;
 
 int ANTIC_ypos;						/* Line number - lines 8..247 are on screen */
 
@@ -965,9 +987,19 @@ int ANTIC_Initialise(int *argc, char *argv[])
 			}
 			else a_m = TRUE;
 		}
+		else if (strcmp(argv[i], "-scanline-cache") == 0)
+			ANTIC_scanline_cache = TRUE;
+#ifdef ANTIC_RENDER_THREAD
+		else if (strcmp(argv[i], "-render-thread") == 0)
+			ANTIC_render_thread = TRUE;
+#endif
 		else {
 			if (strcmp(argv[i], "-help") == 0) {
 				Log_print("\t-artif <num>     Set artifacting mode 0-4 (0 = disable)");
+				Log_print("\t-scanline-cache  Reuse scanlines drawn from unchanged data");
+#ifdef ANTIC_RENDER_THREAD
+				Log_print("\t-render-thread   Draw the scanlines on a thread of their own");
+#endif
 			}
 			argv[j++] = argv[i];
 		}
@@ -1004,7 +1036,6 @@ int ANTIC_Initialise(int *argc, char *argv[])
 	mode_e_an_lookup[2] = mode_e_an_lookup[8] = mode_e_an_lookup[0x20] = mode_e_an_lookup[0x80] = 1;
 	mode_e_an_lookup[3] = mode_e_an_lookup[12] = mode_e_an_lookup[0x30] = mode_e_an_lookup[0xc0] = 2;
 #ifdef NEW_CYCLE_EXACT
-	CYCLE_MAP_Create();
 	ANTIC_cpu2antic_ptr = &CYCLE_MAP_cpu2antic[0];
 	ANTIC_antic2cpu_ptr = &CYCLE_MAP_antic2cpu[0];
 #endif /* NEW_CYCLE_EXACT */
@@ -1014,6 +1045,11 @@ int ANTIC_Initialise(int *argc, char *argv[])
 	return TRUE;
 }
 
+void ANTIC_InvalidateScanlineCache(void)
+{
+	scanline_cache_generation++;
+}
+
 void ANTIC_Reset(void)
 {
 	ANTIC_NMIEN = 0x00;
@@ -1170,6 +1206,96 @@ static const UBYTE gtia_10_lookup[] =
 static const UBYTE gtia_10_pm[] =
 {1, 2, 4, 8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
 
+#ifdef GTIA_SIMD
+#define GTIA_SIMD_CHARS 16
+
+enum { GTIA_SIMD_9, GTIA_SIMD_10, GTIA_SIMD_11, GTIA_SIMD_E9 };
+
+/* The colour bytes of 16 GTIA pixels n (0..15), computed rather than looked
+   up: mode 9 ORs the luminance into COLBK, mode 11 the hue, with hue 0
+   taking COLBK's hue and no luminance; mode 10 picks PM0..3 for 0..3, COLBK
+   for 8..11 and PF0..3 otherwise. Mode E in GTIA 9 turns each pair of
+   ANTIC pixels 0, 1, 2, 3 into luminances 0, 0, 1, 2. c holds the colours
+   of the mode, each in every byte, in the order gtia_simd_chars() sets. */
+static __m128i gtia_simd_colours(int mode, __m128i n, const __m128i *c)
+{
+	const __m128i three = _mm_set1_epi8(3);
+	switch (mode) {
+	case GTIA_SIMD_9:
+		return _mm_or_si128(c[0], n);
+	case GTIA_SIMD_11: {
+		__m128i none = _mm_cmpeq_epi8(n, _mm_setzero_si128());
+		__m128i hue = _mm_or_si128(c[0], _mm_slli_epi16(n, 4));
+		return _mm_or_si128(_mm_and_si128(none, c[1]), _mm_andnot_si128(none, hue));
+	}
+	case GTIA_SIMD_E9: {
+		const __m128i one = _mm_set1_epi8(1);
+		__m128i hi = _mm_and_si128(_mm_srli_epi16(n, 2), three);
+		__m128i lo = _mm_and_si128(n, three);
+		hi = _mm_sub_epi8(hi, _mm_min_epu8(hi, one));
+		lo = _mm_sub_epi8(lo, _mm_min_epu8(lo, one));
+		return _mm_or_si128(c[0], _mm_or_si128(_mm_slli_epi16(hi, 2), lo));
+	}
+	default: { /* GTIA_SIMD_10 */
+		__m128i reg = _mm_and_si128(n, three);
+		__m128i pm = _mm_setzero_si128();
+		__m128i pf = _mm_setzero_si128();
+		__m128i is_pm = _mm_cmplt_epi8(n, _mm_set1_epi8(4));
+		__m128i is_bak = _mm_cmpeq_epi8(_mm_and_si128(n, _mm_set1_epi8(0x0c)), _mm_set1_epi8(8));
+		int k;
+		for (k = 0; k < 4; k++) {
+			__m128i is_reg = _mm_cmpeq_epi8(reg, _mm_set1_epi8((char) k));
+			pm = _mm_or_si128(pm, _mm_and_si128(is_reg, c[1 + k]));
+			pf = _mm_or_si128(pf, _mm_and_si128(is_reg, c[5 + k]));
+		}
+		pf = _mm_or_si128(_mm_and_si128(is_bak, c[0]), _mm_andnot_si128(is_bak, pf));
+		return _mm_or_si128(_mm_and_si128(is_pm, pm), _mm_andnot_si128(is_pm, pf));
+	}
+	}
+}
+
+/* Draws GTIA_SIMD_CHARS characters of mode F (or E for GTIA_SIMD_E9), two
+   GTIA pixels of four screen bytes each, if none of their player/missile
+   bytes is set. Returns FALSE, having drawn nothing, if one is. */
+static int gtia_simd_chars(int mode, const UBYTE *antic_memptr, UWORD *ptr, const ULONG *t_pm_scanline_ptr, const __m128i *c)
+{
+	const __m128i *pm = (const __m128i *) t_pm_scanline_ptr;
+	__m128i any = _mm_or_si128(_mm_or_si128(_mm_loadu_si128(pm), _mm_loadu_si128(pm + 1)),
+	                           _mm_or_si128(_mm_loadu_si128(pm + 2), _mm_loadu_si128(pm + 3)));
+	__m128i data, hi, lo;
+	__m128i *out = (__m128i *) ptr;
+	int half;
+	if (_mm_movemask_epi8(_mm_cmpeq_epi8(any, _mm_setzero_si128())) != 0xffff)
+		return FALSE;
+	data = _mm_loadu_si128((const __m128i *) antic_memptr);
+	hi = _mm_and_si128(_mm_srli_epi16(data, 4), _mm_set1_epi8(0x0f));
+	lo = _mm_and_si128(data, _mm_set1_epi8(0x0f));
+	for (half = 0; half < 2; half++) {
+		/* the pixels of 8 characters, left to right */
+		__m128i pixels = half ? _mm_unpackhi_epi8(hi, lo) : _mm_unpacklo_epi8(hi, lo);
+		__m128i col = gtia_simd_colours(mode, pixels, c);
+		__m128i col2 = _mm_unpacklo_epi8(col, col);
+		_mm_storeu_si128(out++, _mm_unpacklo_epi16(col2, col2));
+		_mm_storeu_si128(out++, _mm_unpackhi_epi16(col2, col2));
+		col2 = _mm_unpackhi_epi8(col, col);
+		_mm_storeu_si128(out++, _mm_unpacklo_epi16(col2, col2));
+		_mm_storeu_si128(out++, _mm_unpackhi_epi16(col2, col2));
+	}
+	return TRUE;
+}
+
+/* In the character loops: draws the next GTIA_SIMD_CHARS characters if it
+   can, and goes on after them */
+#define GTIA_SIMD_LOOP(mode, c) \
+	if (nchars >= GTIA_SIMD_CHARS && gtia_simd_chars(mode, antic_memptr, ptr, t_pm_scanline_ptr, c)) { \
+		antic_memptr += GTIA_SIMD_CHARS; \
+		ptr += 4 * GTIA_SIMD_CHARS; \
+		t_pm_scanline_ptr += GTIA_SIMD_CHARS; \
+		nchars -= GTIA_SIMD_CHARS - 1; \
+		continue; \
+	}
+#endif /* GTIA_SIMD */
+
 static void draw_an_gtia9(const ULONG *t_pm_scanline_ptr)
 {
 	int i = ((const UBYTE *) t_pm_scanline_ptr - GTIA_pm_scanline) & ~1;
@@ -1448,12 +1574,14 @@ static void draw_an_gtia_bug(const ULONG *t_pm_scanline_ptr)
 #define ADD_FONT_CYCLES ANTIC_xpos += font_cycles[md]
 #endif
 
+#define INIT_BLANK_LOOKUP	blank_lookup[0x60] = (anticmode == 2 || dctr & 0xe) ? 0xff : 0;\
+	blank_lookup[0x00] = blank_lookup[0x20] = blank_lookup[0x40] = (dctr & 0xe) == 8 ? 0 : 0xff;
+
 #ifdef PAGED_MEM
 
 #define INIT_ANTIC_2	int t_chbase = (dctr ^ chbase_20) & 0xfc07;\
 	ADD_FONT_CYCLES;\
-	blank_lookup[0x60] = (anticmode == 2 || dctr & 0xe) ? 0xff : 0;\
-	blank_lookup[0x00] = blank_lookup[0x20] = blank_lookup[0x40] = (dctr & 0xe) == 8 ? 0 : 0xff;
+	INIT_BLANK_LOOKUP
 
 #define GET_CHDATA_ANTIC_2	chdata = (screendata & invert_mask) ? 0xff : 0;\
 	if (blank_lookup[screendata & blank_mask])\
@@ -1467,8 +1595,7 @@ static void draw_an_gtia_bug(const ULONG *t_pm_scanline_ptr)
 	else\
 		chptr = MEMORY_mem + ((dctr ^ chbase_20) & 0xfc07);\
 	ADD_FONT_CYCLES;\
-	blank_lookup[0x60] = (anticmode == 2 || dctr & 0xe) ? 0xff : 0;\
-	blank_lookup[0x00] = blank_lookup[0x20] = blank_lookup[0x40] = (dctr & 0xe) == 8 ? 0 : 0xff;
+	INIT_BLANK_LOOKUP
 
 #define GET_CHDATA_ANTIC_2	chdata = (screendata & invert_mask) ? 0xff : 0;\
 	if (blank_lookup[screendata & blank_mask])\
@@ -2260,6 +2387,9 @@ static void prepare_an_antic_e(int nchars, const UBYTE *antic_memptr, const ULON
 static void draw_antic_e_gtia9(int nchars, const UBYTE *antic_memptr, UWORD *ptr, const ULONG *t_pm_scanline_ptr)
 {
 	ULONG lookup[16];
+#ifdef GTIA_SIMD
+	__m128i colours[1];
+#endif
 	if ((uintptr_t) ptr & 2) { /* HSCROL & 1 */
 		prepare_an_antic_e(nchars, antic_memptr, t_pm_scanline_ptr);
 		draw_an_gtia9(t_pm_scanline_ptr);
@@ -2274,8 +2404,15 @@ static void draw_antic_e_gtia9(int nchars, const UBYTE *antic_memptr, UWORD *ptr
 	lookup[12] = lookup[13] = ANTIC_lookup_gtia9[8];
 	lookup[14] = ANTIC_lookup_gtia9[9];
 	lookup[15] = ANTIC_lookup_gtia9[10];
+#ifdef GTIA_SIMD
+	colours[0] = _mm_set1_epi8((char) ANTIC_lookup_gtia9[0]);
+#endif
 	CHAR_LOOP_BEGIN
-		UBYTE screendata = *antic_memptr++;
+		UBYTE screendata;
+#ifdef GTIA_SIMD
+		GTIA_SIMD_LOOP(GTIA_SIMD_E9, colours)
+#endif
+		screendata = *antic_memptr++;
 		WRITE_VIDEO_LONG((ULONG *) ptr, lookup[screendata >> 4]);
 		WRITE_VIDEO_LONG((ULONG *) ptr + 1, lookup[screendata & 0xf]);
 		if (IS_ZERO_ULONG(t_pm_scanline_ptr))
@@ -2394,6 +2531,28 @@ static void draw_antic_f_artif_new(int nchars, const UBYTE *antic_memptr, UWORD
 static void prepare_an_antic_f(int nchars, const UBYTE *antic_memptr, const ULONG *t_pm_scanline_ptr)
 {
 	UBYTE *an_ptr = (UBYTE *) t_pm_scanline_ptr + (an_scanline - GTIA_pm_scanline);
+#ifdef GTIA_SIMD
+	/* the four pixels of 16 bytes at a time, left to right */
+	const __m128i three = _mm_set1_epi8(3);
+	while (nchars > GTIA_SIMD_CHARS) {
+		__m128i data = _mm_loadu_si128((const __m128i *) antic_memptr);
+		__m128i p0 = _mm_and_si128(_mm_srli_epi16(data, 6), three);
+		__m128i p1 = _mm_and_si128(_mm_srli_epi16(data, 4), three);
+		__m128i p2 = _mm_and_si128(_mm_srli_epi16(data, 2), three);
+		__m128i p3 = _mm_and_si128(data, three);
+		__m128i p01 = _mm_unpacklo_epi8(p0, p1);
+		__m128i p23 = _mm_unpacklo_epi8(p2, p3);
+		_mm_storeu_si128((__m128i *) an_ptr, _mm_unpacklo_epi16(p01, p23));
+		_mm_storeu_si128((__m128i *) an_ptr + 1, _mm_unpackhi_epi16(p01, p23));
+		p01 = _mm_unpackhi_epi8(p0, p1);
+		p23 = _mm_unpackhi_epi8(p2, p3);
+		_mm_storeu_si128((__m128i *) an_ptr + 2, _mm_unpacklo_epi16(p01, p23));
+		_mm_storeu_si128((__m128i *) an_ptr + 3, _mm_unpackhi_epi16(p01, p23));
+		antic_memptr += GTIA_SIMD_CHARS;
+		an_ptr += 4 * GTIA_SIMD_CHARS;
+		nchars -= GTIA_SIMD_CHARS;
+	}
+#endif
 	CHAR_LOOP_BEGIN
 		UBYTE screendata = *antic_memptr++;
 		*an_ptr++ = screendata >> 6;
@@ -2405,13 +2564,23 @@ static void prepare_an_antic_f(int nchars, const UBYTE *antic_memptr, const ULON
 
 static void draw_antic_f_gtia9(int nchars, const UBYTE *antic_memptr, UWORD *ptr, const ULONG *t_pm_scanline_ptr)
 {
+#ifdef GTIA_SIMD
+	__m128i colours[1];
+#endif
 	if ((uintptr_t) ptr & 2) { /* HSCROL & 1 */
 		prepare_an_antic_f(nchars, antic_memptr, t_pm_scanline_ptr);
 		draw_an_gtia9(t_pm_scanline_ptr);
 		return;
 	}
+#ifdef GTIA_SIMD
+	colours[0] = _mm_set1_epi8((char) ANTIC_lookup_gtia9[0]);
+#endif
 	CHAR_LOOP_BEGIN
-		UBYTE screendata = *antic_memptr++;
+		UBYTE screendata;
+#ifdef GTIA_SIMD
+		GTIA_SIMD_LOOP(GTIA_SIMD_9, colours)
+#endif
+		screendata = *antic_memptr++;
 		WRITE_VIDEO_LONG((ULONG *) ptr, ANTIC_lookup_gtia9[screendata >> 4]);
 		WRITE_VIDEO_LONG((ULONG *) ptr + 1, ANTIC_lookup_gtia9[screendata & 0xf]);
 		if (IS_ZERO_ULONG(t_pm_scanline_ptr))
@@ -2449,6 +2618,10 @@ static void draw_antic_f_gtia10(int nchars, const UBYTE *antic_memptr, UWORD *pt
 	ULONG lookup_gtia10[16];
 #else
 	UWORD lookup_gtia10[16];
+#endif
+#ifdef GTIA_SIMD
+	__m128i colours[9];
+	int k;
 #endif
 	if ((uintptr_t) ptr & 2) { /* HSCROL & 1 */
 		prepare_an_antic_f(nchars, antic_memptr, t_pm_scanline_ptr);
@@ -2475,11 +2648,22 @@ static void draw_antic_f_gtia10(int nchars, const UBYTE *antic_memptr, UWORD *pt
 	lookup_gtia10[14] = lookup_gtia10[6] = ANTIC_cl[C_PF2];
 	lookup_gtia10[15] = lookup_gtia10[7] = ANTIC_cl[C_PF3];
 	lookup_gtia10[8] = lookup_gtia10[9] = lookup_gtia10[10] = lookup_gtia10[11] = ANTIC_cl[C_BAK];
+#endif
+#ifdef GTIA_SIMD
+	colours[0] = _mm_set1_epi8((char) lookup_gtia10[8]);
+	for (k = 0; k < 4; k++) {
+		colours[1 + k] = _mm_set1_epi8((char) lookup_gtia10[k]);
+		colours[5 + k] = _mm_set1_epi8((char) lookup_gtia10[4 + k]);
+	}
 #endif
 	ptr++;
 	t_pm_scanline_ptr = (const ULONG *) (((const UBYTE *) t_pm_scanline_ptr) + 1);
 	CHAR_LOOP_BEGIN
-		UBYTE screendata = *antic_memptr++;
+		UBYTE screendata;
+#ifdef GTIA_SIMD
+		GTIA_SIMD_LOOP(GTIA_SIMD_10, colours)
+#endif
+		screendata = *antic_memptr++;
 		if (IS_ZERO_ULONG(t_pm_scanline_ptr)) {
 			DO_GTIA_BYTE(ptr, lookup_gtia10, screendata)
 			ptr += 4;
@@ -2506,13 +2690,24 @@ static void draw_antic_f_gtia10(int nchars, const UBYTE *antic_memptr, UWORD *pt
 
 static void draw_antic_f_gtia11(int nchars, const UBYTE *antic_memptr, UWORD *ptr, const ULONG *t_pm_scanline_ptr)
 {
+#ifdef GTIA_SIMD
+	__m128i colours[2];
+#endif
 	if ((uintptr_t) ptr & 2) { /* HSCROL & 1 */
 		prepare_an_antic_f(nchars, antic_memptr, t_pm_scanline_ptr);
 		draw_an_gtia11(t_pm_scanline_ptr);
 		return;
 	}
+#ifdef GTIA_SIMD
+	colours[0] = _mm_set1_epi8((char) ANTIC_lookup_gtia9[0]);
+	colours[1] = _mm_set1_epi8((char) ANTIC_lookup_gtia11[0]);
+#endif
 	CHAR_LOOP_BEGIN
-		UBYTE screendata = *antic_memptr++;
+		UBYTE screendata;
+#ifdef GTIA_SIMD
+		GTIA_SIMD_LOOP(GTIA_SIMD_11, colours)
+#endif
+		screendata = *antic_memptr++;
 		WRITE_VIDEO_LONG((ULONG *) ptr, ANTIC_lookup_gtia11[screendata >> 4]);
 		WRITE_VIDEO_LONG((ULONG *) ptr + 1, ANTIC_lookup_gtia11[screendata & 0xf]);
 		if (IS_ZERO_ULONG(t_pm_scanline_ptr))
@@ -2631,6 +2826,425 @@ static draw_antic_function saved_draw_antic_ptr;
 /* pointer to current GTIA mode blank drawing routine */
 static void (*draw_antic_0_ptr)(void) = draw_antic_0;
 
+/* Scanline cache ---------------------------------------------------------- */
+/* With ANTIC_scanline_cache set, everything a line of playfield is drawn from
+   is kept in a scanline_key. When a line of the next frame has the same key,
+   Screen_atari already holds it and it is not drawn again. Only lines with
+   no players or missiles on them are kept, so that skipping one never skips
+   a collision, and a line drawn in several parts (a register written while
+   it is drawn, see ANTIC_UpdateScanline) is never kept. */
+
+typedef struct {
+	const ULONG *screen;		/* Screen_atari the line was drawn to, NULL = none */
+	ULONG generation;
+	draw_antic_function draw;
+	int md;
+	int chars;
+	int x_min;
+	int ch_offset;
+	int left_border_chars;
+	int right_border_start;
+	UWORD chbase_20;
+	UBYTE anticmode;
+	UBYTE dctr;
+	UBYTE invert_mask;
+	UBYTE blank_mask;
+	UBYTE dmactl;
+	UBYTE hscrol;
+	UBYTE prior;
+	UBYTE artif_mode;
+	UBYTE artif_new;
+	UBYTE colours[9];
+	UBYTE screendata[sizeof(antic_memory)];
+	UBYTE chdata[48];			/* font data of every character shown */
+} scanline_key;
+
+static scanline_key scanline_cache[Screen_HEIGHT];
+
+#define SCANLINE_CACHE_LINE (scanline_cache + (scrn_ptr - (UWORD *) Screen_atari) / (Screen_WIDTH / 2))
+
+/* Forget the line at scrn_ptr, it is drawn in some other way */
+static void scanline_cache_drop(void)
+{
+	SCANLINE_CACHE_LINE->screen = NULL;
+}
+
+/* Do what the line's drawing routine does besides drawing, for a line that
+   is not drawn: the font modes add the font cycles, and modes 2 and 3 set
+   up blank_lookup, which draw_antic_2_gtia_bug uses as it finds it. */
+static void skip_draw_antic(void)
+{
+	if (anticmode >= 8 || draw_antic_ptr == draw_antic_2_gtia_bug)
+		return;
+	ADD_FONT_CYCLES;
+	if (anticmode <= 3) {
+		INIT_BLANK_LOOKUP
+	}
+}
+
+/* Return TRUE if the line at scrn_ptr is in Screen_atari as draw_antic_ptr
+   would draw it now. Otherwise remember the line if it is drawn whole and
+   can be kept, and return FALSE. */
+static int scanline_cache_hit(int whole_line)
+{
+	static scanline_key key;
+	scanline_key *line = SCANLINE_CACHE_LINE;
+	const UBYTE *screendata = antic_memory + ANTIC_margin + ch_offset[md];
+	int i;
+
+	if (!whole_line || GTIA_pm_dirty
+#ifdef NEW_CYCLE_EXACT
+		|| draw_antic_ptr_changed
+#endif
+#ifndef NO_SIMPLE_PAL_BLENDING
+		|| ANTIC_pal_blending
+#endif
+		) {
+		line->screen = NULL;
+		return FALSE;
+	}
+	memset(&key, 0, sizeof(key));
+	key.screen = Screen_atari;
+	key.generation = scanline_cache_generation;
+	key.draw = draw_antic_ptr;
+	key.md = md;
+	key.chars = chars_displayed[md];
+	key.x_min = x_min[md];
+	key.ch_offset = ch_offset[md];
+	key.left_border_chars = left_border_chars;
+	key.right_border_start = right_border_start;
+	key.chbase_20 = chbase_20;
+	key.anticmode = anticmode;
+	key.dctr = dctr;
+	key.invert_mask = invert_mask;
+	key.blank_mask = (UBYTE) blank_mask;
+	key.dmactl = ANTIC_DMACTL;
+	key.hscrol = ANTIC_HSCROL;
+	key.prior = GTIA_PRIOR;
+	key.artif_mode = (UBYTE) ANTIC_artif_mode;
+	key.artif_new = (UBYTE) ANTIC_artif_new;
+	key.colours[0] = GTIA_COLPM0;
+	key.colours[1] = GTIA_COLPM1;
+	key.colours[2] = GTIA_COLPM2;
+	key.colours[3] = GTIA_COLPM3;
+	key.colours[4] = GTIA_COLPF0;
+	key.colours[5] = GTIA_COLPF1;
+	key.colours[6] = GTIA_COLPF2;
+	key.colours[7] = GTIA_COLPF3;
+	key.colours[8] = GTIA_COLBK;
+	memcpy(key.screendata, antic_memory, sizeof(antic_memory));
+	if (anticmode <= 7) {
+		/* the font line as draw_antic_2, 4 and 6 find it */
+		int chline = anticmode <= 4 ? dctr : anticmode == 6 ? dctr & 7 : dctr >> 1;
+		int chmask = anticmode <= 5 ? 0x7f : 0x3f;
+#ifdef PAGED_MEM
+		UWORD t_chbase = anticmode <= 5 ? (chline ^ chbase_20) & 0xfc07 : chline ^ chbase_20;
+		for (i = 0; i < key.chars; i++)
+			key.chdata[i] = MEMORY_dGetByte(t_chbase + ((UWORD) (screendata[i] & chmask) << 3));
+#else
+		const UBYTE *chptr;
+		if (ANTIC_xe_ptr != NULL && chbase_20 < 0x8000 && chbase_20 >= 0x4000)
+			chptr = ANTIC_xe_ptr + (anticmode <= 5 ? (chline ^ chbase_20) & 0x3c07 : (chline ^ chbase_20) - 0x4000);
+		else
+			chptr = MEMORY_mem + (anticmode <= 5 ? (chline ^ chbase_20) & 0xfc07 : chline ^ chbase_20);
+		for (i = 0; i < key.chars; i++)
+			key.chdata[i] = chptr[(screendata[i] & chmask) << 3];
+#endif
+	}
+	if (memcmp(&key, line, sizeof(key)) == 0)
+		return TRUE;
+	*line = key;
+	return FALSE;
+}
+
+#ifndef NEW_CYCLE_EXACT
+
+/* Collisions without drawing ---------------------------------------------- */
+/* ANTIC_Frame(ANTIC_DRAW_COLLISIONS) runs a frame as ANTIC_Frame(TRUE) does,
+   but leaves Screen_atari alone: collide_antic_line only looks up the
+   playfield colour under each colour clock of the line and adds the players
+   and missiles there to PF0PM-PF3PM, as draw_antic_ptr would. The routines
+   of the GTIA modes fill an_scanline, and draw_an_gtia10 reads it one colour
+   clock left of what the line filled, so such lines still fill it. */
+
+#define COLLIDE(colreg)	PF_COLLS(colreg) |= *pm_ptr++
+
+#define COLLIDE_HIRES(data) {\
+	int k = 4;\
+	do {\
+		if (data & 0xc0)\
+			PF2PM |= *pm_ptr;\
+		pm_ptr++;\
+		data <<= 2;\
+	} while (--k);\
+}
+
+#define COLLIDE_GTIA10(data) {\
+	int colreg = gtia_10_lookup[(data) >> 4];\
+	COLLIDE(colreg);\
+	COLLIDE(colreg);\
+	colreg = gtia_10_lookup[(data) & 0x0f];\
+	COLLIDE(colreg);\
+	COLLIDE(colreg);\
+}
+
+/* the collisions of draw_an_gtia10 */
+static void collide_an_gtia10(const UBYTE *pm_ptr)
+{
+	int i = (pm_ptr - GTIA_pm_scanline) | 1;
+	while (i < right_border_start) {
+		int colreg = gtia_10_lookup[(an_scanline[i - 1] << 2) + an_scanline[i]];
+		PF_COLLS(colreg) |= GTIA_pm_scanline[i];
+		PF_COLLS(colreg) |= GTIA_pm_scanline[i + 1];
+		i += 2;
+	}
+}
+
+static void collide_antic_line(int nchars, const UBYTE *antic_memptr, const UBYTE *pm_ptr)
+{
+	static const UBYTE gtia_bug_colreg[] = {L_PF0, L_PF1, L_PF2, L_PF3};
+	int gtia = GTIA_PRIOR >> 6;
+	/* the routines drawing with prepare_an_antic_* rather than directly */
+	int an = gtia != 0 && (x_min[md] & 1); /* HSCROL & 1 */
+	int hires_colls = TRUE;
+#ifndef USE_COLOUR_TRANSLATION_TABLE
+	/* the new artifacting doesn't set PF2PM */
+	hires_colls = draw_antic_ptr != draw_antic_2_artif_new && draw_antic_ptr != draw_antic_f_artif_new;
+#endif
+
+	if (draw_antic_ptr == draw_antic_2_gtia_bug) {
+		prepare_an_antic_2(nchars, antic_memptr, (const ULONG *) pm_ptr);
+		if (GTIA_pm_dirty) {
+			int i;
+			for (i = pm_ptr - GTIA_pm_scanline; i < right_border_start; i++)
+				PF_COLLS(gtia_bug_colreg[an_scanline[i]]) |= GTIA_pm_scanline[i];
+		}
+		return;
+	}
+	if (draw_antic_ptr == draw_antic_f_gtia_bug) {
+		if (GTIA_pm_dirty)
+			CHAR_LOOP_BEGIN
+				UBYTE screendata = *antic_memptr++;
+				int k = 4;
+				do {
+					COLLIDE((playfield_lookup + 0x40)[screendata & 0xc0]);
+					screendata <<= 2;
+				} while (--k);
+			CHAR_LOOP_END
+		return;
+	}
+
+	switch (anticmode) {
+	case 2:
+	case 3:
+		{
+			INIT_ANTIC_2
+			if (an) {
+				prepare_an_antic_2(nchars, antic_memptr, (const ULONG *) pm_ptr);
+				if (gtia == 2 && GTIA_pm_dirty)
+					collide_an_gtia10(pm_ptr);
+			}
+			else if (GTIA_pm_dirty && (gtia == 2 || (gtia == 0 && hires_colls))) {
+				if (gtia == 2)
+					pm_ptr++;
+				CHAR_LOOP_BEGIN
+					UBYTE screendata = *antic_memptr++;
+					int chdata;
+					GET_CHDATA_ANTIC_2
+					if (gtia == 2)
+						COLLIDE_GTIA10(chdata)
+					else
+						COLLIDE_HIRES(chdata)
+				CHAR_LOOP_END
+			}
+		}
+		break;
+	case 4:
+	case 5:
+		if (gtia != 0) {
+			prepare_an_antic_4(nchars, antic_memptr, (const ULONG *) pm_ptr);
+			if (gtia == 2 && GTIA_pm_dirty)
+				collide_an_gtia10(pm_ptr);
+		}
+		else {
+#ifdef PAGED_MEM
+			UWORD t_chbase = ((anticmode == 4 ? dctr : dctr >> 1) ^ chbase_20) & 0xfc07;
+#else
+			const UBYTE *chptr;
+			if (ANTIC_xe_ptr != NULL && chbase_20 < 0x8000 && chbase_20 >= 0x4000)
+				chptr = ANTIC_xe_ptr + (((anticmode == 4 ? dctr : dctr >> 1) ^ chbase_20) & 0x3c07);
+			else
+				chptr = MEMORY_mem + (((anticmode == 4 ? dctr : dctr >> 1) ^ chbase_20) & 0xfc07);
+#endif
+			ADD_FONT_CYCLES;
+			if (GTIA_pm_dirty)
+				CHAR_LOOP_BEGIN
+					UBYTE screendata = *antic_memptr++;
+					UBYTE colreg3 = screendata & 0x80 ? L_PF3 : L_PF2;
+					UBYTE chdata;
+					int k = 4;
+#ifdef PAGED_MEM
+					chdata = MEMORY_dGetByte(t_chbase + ((UWORD) (screendata & 0x7f) << 3));
+#else
+					chdata = chptr[(screendata & 0x7f) << 3];
+#endif
+					do {
+						COLLIDE((chdata & 0xc0) == 0xc0 ? colreg3 : playfield_lookup[chdata & 0xc0]);
+						chdata <<= 2;
+					} while (--k);
+				CHAR_LOOP_END
+		}
+		break;
+	case 6:
+	case 7:
+		if (gtia != 0) {
+			prepare_an_antic_6(nchars, antic_memptr, (const ULONG *) pm_ptr);
+			if (gtia == 2 && GTIA_pm_dirty)
+				collide_an_gtia10(pm_ptr);
+		}
+		else {
+#ifdef PAGED_MEM
+			UWORD t_chbase = (anticmode == 6 ? dctr & 7 : dctr >> 1) ^ chbase_20;
+#else
+			const UBYTE *chptr;
+			if (ANTIC_xe_ptr != NULL && chbase_20 < 0x8000 && chbase_20 >= 0x4000)
+				chptr = ANTIC_xe_ptr + (((anticmode == 6 ? dctr & 7 : dctr >> 1) ^ chbase_20) - 0x4000);
+			else
+				chptr = MEMORY_mem + ((anticmode == 6 ? dctr & 7 : dctr >> 1) ^ chbase_20);
+#endif
+			ADD_FONT_CYCLES;
+			if (GTIA_pm_dirty)
+				CHAR_LOOP_BEGIN
+					UBYTE screendata = *antic_memptr++;
+					UBYTE colreg = (playfield_lookup + 0x40)[screendata & 0xc0];
+					UBYTE chdata;
+					int k = 8;
+#ifdef PAGED_MEM
+					chdata = MEMORY_dGetByte(t_chbase + ((UWORD) (screendata & 0x3f) << 3));
+#else
+					chdata = chptr[(screendata & 0x3f) << 3];
+#endif
+					do {
+						COLLIDE(chdata & 0x80 ? colreg : L_BAK);
+						chdata <<= 1;
+					} while (--k);
+				CHAR_LOOP_END
+		}
+		break;
+	case 8:
+		if (gtia != 0) {
+			prepare_an_antic_8(nchars, antic_memptr, (const ULONG *) pm_ptr);
+			if (gtia == 2 && GTIA_pm_dirty)
+				collide_an_gtia10(pm_ptr);
+		}
+		else if (GTIA_pm_dirty)
+			CHAR_LOOP_BEGIN
+				UBYTE screendata = *antic_memptr++;
+				int kk = 4;
+				do {
+					int colreg = playfield_lookup[screendata & 0xc0];
+					/* draw_antic_8 stops at the right edge */
+					if (pm_ptr >= GTIA_pm_scanline + 4 * (48 - RCHOP))
+						return;
+					COLLIDE(colreg);
+					COLLIDE(colreg);
+					COLLIDE(colreg);
+					COLLIDE(colreg);
+					screendata <<= 2;
+				} while (--kk);
+			CHAR_LOOP_END
+		break;
+	case 9:
+		/* modes 9, b and c draw nothing in the GTIA modes */
+		if (gtia == 0 && GTIA_pm_dirty)
+			CHAR_LOOP_BEGIN
+				UBYTE screendata = *antic_memptr++;
+				int kk = 4;
+				do {
+					if (pm_ptr >= GTIA_pm_scanline + 4 * (48 - RCHOP))
+						return;
+					COLLIDE(screendata & 0x80 ? L_PF0 : L_BAK);
+					COLLIDE(screendata & 0x80 ? L_PF0 : L_BAK);
+					COLLIDE(screendata & 0x40 ? L_PF0 : L_BAK);
+					COLLIDE(screendata & 0x40 ? L_PF0 : L_BAK);
+					screendata <<= 2;
+				} while (--kk);
+			CHAR_LOOP_END
+		break;
+	case 0xa:
+		if (gtia != 0) {
+			prepare_an_antic_a(nchars, antic_memptr, (const ULONG *) pm_ptr);
+			if (gtia == 2 && GTIA_pm_dirty)
+				collide_an_gtia10(pm_ptr);
+		}
+		else if (GTIA_pm_dirty)
+			CHAR_LOOP_BEGIN
+				UBYTE screendata = *antic_memptr++;
+				int kk = 4;
+				do {
+					int colreg = playfield_lookup[screendata & 0xc0];
+					COLLIDE(colreg);
+					COLLIDE(colreg);
+					screendata <<= 2;
+				} while (--kk);
+			CHAR_LOOP_END
+		break;
+	case 0xb:
+	case 0xc:
+		if (gtia == 0 && GTIA_pm_dirty)
+			CHAR_LOOP_BEGIN
+				UBYTE screendata = *antic_memptr++;
+				int k = 8;
+				do {
+					COLLIDE(screendata & 0x80 ? L_PF0 : L_BAK);
+					screendata <<= 1;
+				} while (--k);
+			CHAR_LOOP_END
+		break;
+	case 0xd:
+	case 0xe:
+		if (gtia != 0) {
+			if (an || gtia != 1) {
+				prepare_an_antic_e(nchars, antic_memptr, (const ULONG *) pm_ptr);
+				if (gtia == 2 && GTIA_pm_dirty)
+					collide_an_gtia10(pm_ptr);
+			}
+		}
+		else if (GTIA_pm_dirty)
+			CHAR_LOOP_BEGIN
+				UBYTE screendata = *antic_memptr++;
+				int k = 4;
+				do {
+					COLLIDE(playfield_lookup[screendata & 0xc0]);
+					screendata <<= 2;
+				} while (--k);
+			CHAR_LOOP_END
+		break;
+	case 0xf:
+		if (an) {
+			prepare_an_antic_f(nchars, antic_memptr, (const ULONG *) pm_ptr);
+			if (gtia == 2 && GTIA_pm_dirty)
+				collide_an_gtia10(pm_ptr);
+		}
+		else if (GTIA_pm_dirty && (gtia == 2 || (gtia == 0 && hires_colls))) {
+			if (gtia == 2)
+				pm_ptr++;
+			CHAR_LOOP_BEGIN
+				int screendata = *antic_memptr++;
+				if (gtia == 2)
+					COLLIDE_GTIA10(screendata)
+				else
+					COLLIDE_HIRES(screendata)
+			CHAR_LOOP_END
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+#endif /* NEW_CYCLE_EXACT */
+
 #ifdef NEW_CYCLE_EXACT
 /* wrapper for antic_0, for dmactl bugs */
 static void draw_antic_0_dmactl_bug(int nchars, const UBYTE *antic_memptr, UWORD *ptr, const ULONG *t_pm_scanline_ptr)
@@ -2787,6 +3401,19 @@ UWORD ANTIC_GetDLWord(UWORD *paddr)
 	return (ANTIC_GetDLByte(paddr) << 8) + lsb;
 }
 
+/* ANTIC_Frame fills one list while the other holds the last frame */
+static ANTIC_DLEntry dl_entries[2][ANTIC_DL_MAX];
+static int dl_count[2];
+static int dl_done = 0;
+static ULONG dl_generation = 0;
+
+int ANTIC_GetDisplayList(const ANTIC_DLEntry **entries, ULONG *generation)
+{
+	*entries = dl_entries[dl_done];
+	*generation = dl_generation;
+	return dl_count[dl_done];
+}
+
 #if !defined(BASIC) && !defined(CURSES_BASIC)
 
 /* Real ANTIC doesn't fetch beginning bytes in HSC
@@ -2838,6 +3465,635 @@ static void antic_load(void)
 #endif
 }
 
+/* Draws lines like ANTIC_Frame does for an unscrolled mode line, with the
+   line drawing routine of draw_antic_table but none of the DMA */
+void ANTIC_DrawModeLines(int mode, int gtia, const UBYTE *data, int lines)
+{
+	static const UBYTE mode_md[16] = {
+		NORMAL0, NORMAL0, NORMAL0, NORMAL0, NORMAL0, NORMAL0, NORMAL1, NORMAL1,
+		NORMAL2, NORMAL2, NORMAL1, NORMAL1, NORMAL1, NORMAL0, NORMAL0, NORMAL0
+	};
+	draw_antic_function draw = draw_antic_table[gtia & 3][mode & 0xf];
+	UWORD *ptr = (UWORD *) Screen_atari;
+	int y = 0;
+
+	if (draw == NULL)
+		return;
+	anticmode = (UBYTE) (mode & 0xf);
+	md = mode_md[anticmode];
+	memcpy(antic_memory + ANTIC_margin, data, chars_read[md]);
+	dctr = 0;
+	while (lines-- > 0) {
+		draw(chars_displayed[md], antic_memory + ANTIC_margin + ch_offset[md],
+		     ptr + x_min[md], (ULONG *) &GTIA_pm_scanline[x_min[md]]);
+		if (++y == Screen_HEIGHT) {
+			y = 0;
+			ptr = (UWORD *) Screen_atari;
+		}
+		else
+			ptr += Screen_WIDTH / 2;
+		dctr++;
+		dctr &= 0xf;
+	}
+	ANTIC_InvalidateScanlineCache();
+}
+
+/* Note the instruction just fetched from addr; called once any jump
+   or LMS address has been read */
+static void dl_record(UWORD addr)
+{
+	int n = dl_count[dl_done ^ 1];
+	ANTIC_DLEntry *e;
+	if (n == ANTIC_DL_MAX)
+		return;
+	e = &dl_entries[dl_done ^ 1][n];
+	if (n > 0)
+		e[-1].lines = ANTIC_ypos - e[-1].ypos;
+	e->addr = addr;
+	e->ypos = ANTIC_ypos;
+	e->lines = 0;
+	e->operand = anticmode == 1 ? ANTIC_dlist : anticmode == 0 ? 0 : screenaddr;
+	e->ir = IR;
+	dl_count[dl_done ^ 1] = n + 1;
+}
+
+/* Close the list filled this frame and make it the last frame's */
+static void dl_finish(void)
+{
+	int n = dl_count[dl_done ^ 1];
+	const ANTIC_DLEntry *e = dl_entries[dl_done ^ 1];
+	const ANTIC_DLEntry *old = dl_entries[dl_done];
+	int i;
+	if (n > 0)
+		dl_entries[dl_done ^ 1][n - 1].lines = ANTIC_ypos - e[n - 1].ypos;
+	if (n != dl_count[dl_done])
+		dl_generation++;
+	else
+		for (i = 0; i < n; i++)
+			if (e[i].addr != old[i].addr || e[i].ypos != old[i].ypos
+			 || e[i].lines != old[i].lines || e[i].operand != old[i].operand
+			 || e[i].ir != old[i].ir) {
+				dl_generation++;
+				break;
+			}
+	dl_done ^= 1;
+	dl_count[dl_done ^ 1] = 0;
+}
+
+#ifdef ANTIC_RENDER_THREAD
+
+/* Renderer thread --------------------------------------------------------- */
+/* With ANTIC_render_thread, ANTIC_Frame runs the display list, the DMA and
+   the CPU as ever, but where draw_partial_scanline would draw it only logs
+   a render_record: the part of the line, the drawing state, and whatever
+   else the drawing reads that has changed since the record before - the
+   line's screen data, GTIA_pm_scanline, the colour tables, the font. The
+   renderer thread draws the records in order with the drawing code of
+   antic_render.c, a batch of lines behind. The playfield collisions come
+   out of the drawing, so reading them (ANTIC_SyncCollisions) waits for the
+   lines so far, as does the end of the visible lines, before PAL blending
+   and the vertical blank. */
+
+enum {
+	RENDER_FRAME,		/* the frame's screen and collisions */
+	RENDER_COLLISIONS,	/* PF0PM-PF3PM, set by GTIA */
+	RENDER_SEGMENT		/* draw_partial_scanline(l, r) on line y */
+};
+
+/* Parts of a RENDER_SEGMENT only there when changed */
+#define RENDER_MEMORY	0x01
+#define RENDER_PM		0x02
+#define RENDER_TABLES	0x04
+#define RENDER_FONT		0x08
+
+typedef struct {
+	UBYTE kind;
+	UBYTE parts;
+	/* RENDER_FRAME */
+	UBYTE scanline_cache;
+	ULONG generation;
+	ULONG *screen;
+	/* RENDER_FRAME, RENDER_COLLISIONS */
+	UBYTE colls[4];
+	/* RENDER_SEGMENT */
+	int y;
+	int l;
+	int r;
+	UBYTE draw;			/* draw_antic_ptr, as its index in draw_functions */
+	UBYTE draw_0;		/* draw_antic_0_ptr, in draw_0_functions */
+	UBYTE pm_lookup;	/* pm_lookup_ptr, as a row of pm_lookup_table */
+	UBYTE draw_changed;
+	UBYTE anticmode;
+	UBYTE dctr;
+	UBYTE invert_mask;
+	UBYTE dmactl;
+	UBYTE hscrol;
+	UBYTE prior;
+	UBYTE pm_dirty;
+	UBYTE artif_mode;
+	UBYTE artif_new;
+	UBYTE pal_blending;
+	UBYTE colours[9];
+	UWORD chbase_20;
+	int md;
+	int blank_mask;
+	int dmactl_bug_chdata;
+	int left_border_chars;
+	int right_border_start;
+	int chars_displayed[6];
+	int x_min[6];
+	int ch_offset[6];
+	UBYTE antic_memory[sizeof(antic_memory)];	/* RENDER_MEMORY */
+	UBYTE pm_scanline[Screen_WIDTH / 2 + 8];	/* RENDER_PM */
+	UWORD cl[128];								/* RENDER_TABLES */
+	ULONG lookup_gtia9[16];
+	ULONG lookup_gtia11[16];
+	UWORD hires_lookup_l[128];
+	UWORD font_addr;							/* RENDER_FONT */
+	UWORD font_size;
+	UBYTE font[1024];
+} render_record;
+
+/* Every routine draw_antic_ptr may point to */
+static draw_antic_function const draw_functions[] = {
+	draw_antic_2, draw_antic_2_gtia9, draw_antic_2_gtia10, draw_antic_2_gtia11,
+	draw_antic_2_artif,
+#ifndef USE_COLOUR_TRANSLATION_TABLE
+	draw_antic_2_artif_new,
+#endif
+	draw_antic_2_gtia_bug, draw_antic_2_dmactl_bug, draw_antic_0_dmactl_bug,
+	draw_antic_4, draw_antic_4_gtia9, draw_antic_4_gtia10, draw_antic_4_gtia11,
+	draw_antic_6, draw_antic_6_gtia9, draw_antic_6_gtia10, draw_antic_6_gtia11,
+	draw_antic_8, draw_antic_8_gtia9, draw_antic_8_gtia10, draw_antic_8_gtia11,
+	draw_antic_9, draw_antic_9_gtia9, draw_antic_9_gtia10, draw_antic_9_gtia11,
+	draw_antic_a, draw_antic_a_gtia9, draw_antic_a_gtia10, draw_antic_a_gtia11,
+	draw_antic_c,
+	draw_antic_e, draw_antic_e_gtia9, draw_antic_e_gtia10, draw_antic_e_gtia11,
+	draw_antic_f, draw_antic_f_gtia9, draw_antic_f_gtia10, draw_antic_f_gtia11,
+	draw_antic_f_artif,
+#ifndef USE_COLOUR_TRANSLATION_TABLE
+	draw_antic_f_artif_new,
+#endif
+	draw_antic_f_gtia_bug
+};
+#define DRAW_FUNCTIONS ((int) (sizeof(draw_functions) / sizeof(draw_functions[0])))
+
+static void (* const draw_0_functions[3])(void) = {
+	draw_antic_0, draw_antic_0_gtia10, draw_antic_0_gtia11
+};
+
+#ifdef DEFER_DRAWING
+
+#define RENDER_QUEUE 256	/* records, a power of two */
+#define RENDER_BATCH 16		/* records handed to the renderer at once */
+
+/* The queue is a ring of RENDER_QUEUE records: the emulation fills the ones
+   from tail up to head and hands them over by moving published up to head,
+   the renderer draws the ones up to published and moves tail past them.
+   published and tail are shared under lock, head and tail_seen are the
+   emulation's own. */
+static struct {
+	pthread_mutex_t lock;
+	pthread_cond_t logged;	/* the renderer waits for records */
+	pthread_cond_t drawn;	/* the emulation waits for the renderer */
+	pthread_t thread;
+	int running;
+	int quit;
+	int deferring;			/* ANTIC_Frame is logging the lines */
+	int send_all;			/* the next segment sends all its parts */
+	render_record *queue;
+	unsigned int head;
+	unsigned int published;
+	unsigned int tail;
+	unsigned int tail_seen;
+	render_record sent;		/* the parts as the renderer has them */
+} renderer = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, PTHREAD_COND_INITIALIZER };
+
+void Renderer_Initialise(void);
+void Renderer_Replay(const render_record *rec);
+void Renderer_GetCollisions(UBYTE *colls);
+
+static void *render_main(void *arg)
+{
+	pthread_mutex_lock(&renderer.lock);
+	for (;;) {
+		unsigned int tail = renderer.tail;
+		unsigned int end;
+		while (renderer.published == tail && !renderer.quit)
+			pthread_cond_wait(&renderer.logged, &renderer.lock);
+		if (renderer.quit)
+			break;
+		end = renderer.published;
+		pthread_mutex_unlock(&renderer.lock);
+
+		for (; tail != end; tail++)
+			Renderer_Replay(&renderer.queue[tail & (RENDER_QUEUE - 1)]);
+
+		pthread_mutex_lock(&renderer.lock);
+		renderer.tail = tail;
+		pthread_cond_signal(&renderer.drawn);
+	}
+	pthread_mutex_unlock(&renderer.lock);
+	return arg;
+}
+
+static void render_start(void)
+{
+	Renderer_Initialise();
+	renderer.queue = (render_record *) Util_malloc(RENDER_QUEUE * sizeof(render_record));
+	renderer.head = renderer.published = renderer.tail = renderer.tail_seen = 0;
+	renderer.quit = FALSE;
+	if (pthread_create(&renderer.thread, NULL, render_main, NULL) != 0) {
+		Log_print("Cannot start the renderer thread");
+		free(renderer.queue);
+		renderer.queue = NULL;
+		ANTIC_render_thread = FALSE;
+		return;
+	}
+	renderer.running = TRUE;
+	/* Screen_atari holds lines the scanline cache of the renderer knows nothing of */
+	scanline_cache_generation++;
+}
+
+/* Ends the thread, which is idle between frames. */
+static void render_stop(void)
+{
+	pthread_mutex_lock(&renderer.lock);
+	renderer.quit = TRUE;
+	pthread_cond_signal(&renderer.logged);
+	pthread_mutex_unlock(&renderer.lock);
+	pthread_join(renderer.thread, NULL);
+	renderer.running = FALSE;
+	free(renderer.queue);
+	renderer.queue = NULL;
+	scanline_cache_generation++;
+}
+
+/* The record to fill next, once the renderer has drawn it if the queue is full */
+static render_record *render_next(void)
+{
+	if (renderer.head - renderer.tail_seen == RENDER_QUEUE) {
+		pthread_mutex_lock(&renderer.lock);
+		renderer.published = renderer.head;
+		pthread_cond_signal(&renderer.logged);
+		while (renderer.head - renderer.tail == RENDER_QUEUE)
+			pthread_cond_wait(&renderer.drawn, &renderer.lock);
+		renderer.tail_seen = renderer.tail;
+		pthread_mutex_unlock(&renderer.lock);
+	}
+	return &renderer.queue[renderer.head & (RENDER_QUEUE - 1)];
+}
+
+/* Logs the record render_next() gave, handing a batch over to the renderer */
+static void render_log(void)
+{
+	if ((++renderer.head & (RENDER_BATCH - 1)) == 0) {
+		pthread_mutex_lock(&renderer.lock);
+		renderer.published = renderer.head;
+		renderer.tail_seen = renderer.tail;
+		pthread_cond_signal(&renderer.logged);
+		pthread_mutex_unlock(&renderer.lock);
+	}
+}
+
+/* Waits until the renderer has drawn all records logged */
+static void render_flush(void)
+{
+	pthread_mutex_lock(&renderer.lock);
+	renderer.published = renderer.head;
+	pthread_cond_signal(&renderer.logged);
+	while (renderer.tail != renderer.head)
+		pthread_cond_wait(&renderer.drawn, &renderer.lock);
+	renderer.tail_seen = renderer.tail;
+	pthread_mutex_unlock(&renderer.lock);
+}
+
+/* Before the visible lines of a frame; the thread starts or stops here,
+   whether the frame is drawn or not */
+static void render_begin_frame(int draw_display)
+{
+	render_record *rec;
+
+	if (ANTIC_render_thread != renderer.running) {
+		if (renderer.running)
+			render_stop();
+		else
+			render_start();
+	}
+	if (!renderer.running || !draw_display)
+		return;
+	rec = render_next();
+	rec->kind = RENDER_FRAME;
+	rec->screen = Screen_atari;
+	rec->generation = scanline_cache_generation;
+	rec->scanline_cache = (UBYTE) ANTIC_scanline_cache;
+	rec->colls[0] = PF0PM;
+	rec->colls[1] = PF1PM;
+	rec->colls[2] = PF2PM;
+	rec->colls[3] = PF3PM;
+	render_log();
+	renderer.send_all = TRUE;
+	renderer.deferring = TRUE;
+}
+
+/* After the visible lines: Screen_atari and the collisions are complete */
+static void render_end_frame(void)
+{
+	ANTIC_SyncCollisions();
+	renderer.deferring = FALSE;
+}
+
+/* Before the emulation draws on the lines itself */
+static void render_wait(void)
+{
+	if (renderer.deferring) {
+		render_flush();
+		/* what the renderer's cache keeps of this frame is drawn over */
+		scanline_cache_generation++;
+	}
+}
+
+static int draw_function_index(draw_antic_function draw)
+{
+	static int last = 0;
+	int i;
+	if (draw_functions[last] == draw)
+		return last;
+	for (i = 0; i < DRAW_FUNCTIONS; i++)
+		if (draw_functions[i] == draw)
+			return last = i;
+	return 0;
+}
+
+/* Logs draw_partial_scanline(l, r), fetching the line's screen data when
+   the drawing would */
+static void render_partial_scanline(int l, int r)
+{
+	int lborder_start = LCHOP * 4;
+	int lborder_end = LCHOP * 4 + left_border_chars * 4;
+	int rborder_end = (48 - RCHOP) * 4;
+	int playfield = anticmode >= 2 && (ANTIC_DMACTL & 3) != 0;
+	render_record *rec;
+	render_record *sent = &renderer.sent;
+
+	/* clipped as draw_partial_scanline clips it */
+	if (!playfield)
+		lborder_end = rborder_end;
+	if (l > rborder_end)
+		l = rborder_end;
+	if (r > rborder_end)
+		r = rborder_end;
+	if (l < lborder_start)
+		l = lborder_start;
+	if (r < lborder_start)
+		r = lborder_start;
+	if (l >= r)
+		return;
+	if (r > lborder_end && need_load) {
+		antic_load();
+		need_load = FALSE;
+	}
+
+	rec = render_next();
+	rec->kind = RENDER_SEGMENT;
+	rec->parts = 0;
+	rec->y = (scrn_ptr - (UWORD *) Screen_atari) / (Screen_WIDTH / 2);
+	rec->l = l;
+	rec->r = r;
+	rec->draw = (UBYTE) draw_function_index(draw_antic_ptr);
+	rec->draw_0 = draw_antic_0_ptr == draw_0_functions[0] ? 0 : draw_antic_0_ptr == draw_0_functions[1] ? 1 : 2;
+	rec->pm_lookup = (UBYTE) ((pm_lookup_ptr - pm_lookup_table[0]) / 256);
+	rec->draw_changed = (UBYTE) draw_antic_ptr_changed;
+	rec->anticmode = anticmode;
+	rec->dctr = dctr;
+	rec->invert_mask = invert_mask;
+	rec->dmactl = ANTIC_DMACTL;
+	rec->hscrol = ANTIC_HSCROL;
+	rec->prior = GTIA_PRIOR;
+	rec->pm_dirty = (UBYTE) GTIA_pm_dirty;
+	rec->artif_mode = (UBYTE) ANTIC_artif_mode;
+	rec->artif_new = (UBYTE) ANTIC_artif_new;
+#ifndef NO_SIMPLE_PAL_BLENDING
+	rec->pal_blending = (UBYTE) ANTIC_pal_blending;
+#endif
+	rec->colours[0] = GTIA_COLPM0;
+	rec->colours[1] = GTIA_COLPM1;
+	rec->colours[2] = GTIA_COLPM2;
+	rec->colours[3] = GTIA_COLPM3;
+	rec->colours[4] = GTIA_COLPF0;
+	rec->colours[5] = GTIA_COLPF1;
+	rec->colours[6] = GTIA_COLPF2;
+	rec->colours[7] = GTIA_COLPF3;
+	rec->colours[8] = GTIA_COLBK;
+	rec->chbase_20 = chbase_20;
+	rec->md = md;
+	rec->blank_mask = blank_mask;
+	rec->dmactl_bug_chdata = dmactl_bug_chdata;
+	rec->left_border_chars = left_border_chars;
+	rec->right_border_start = right_border_start;
+	memcpy(rec->chars_displayed, chars_displayed, sizeof(chars_displayed));
+	memcpy(rec->x_min, x_min, sizeof(x_min));
+	memcpy(rec->ch_offset, ch_offset, sizeof(ch_offset));
+
+	if (renderer.send_all || memcmp(sent->antic_memory, antic_memory, sizeof(antic_memory)) != 0) {
+		memcpy(sent->antic_memory, antic_memory, sizeof(antic_memory));
+		memcpy(rec->antic_memory, antic_memory, sizeof(antic_memory));
+		rec->parts |= RENDER_MEMORY;
+	}
+	if (renderer.send_all || memcmp(sent->pm_scanline, GTIA_pm_scanline, sizeof(sent->pm_scanline)) != 0) {
+		memcpy(sent->pm_scanline, GTIA_pm_scanline, sizeof(sent->pm_scanline));
+		memcpy(rec->pm_scanline, GTIA_pm_scanline, sizeof(rec->pm_scanline));
+		rec->parts |= RENDER_PM;
+	}
+	if (renderer.send_all || memcmp(sent->cl, ANTIC_cl, sizeof(ANTIC_cl)) != 0
+		|| memcmp(sent->lookup_gtia9, ANTIC_lookup_gtia9, sizeof(ANTIC_lookup_gtia9)) != 0
+		|| memcmp(sent->lookup_gtia11, ANTIC_lookup_gtia11, sizeof(ANTIC_lookup_gtia11)) != 0
+		|| memcmp(sent->hires_lookup_l, ANTIC_hires_lookup_l, sizeof(ANTIC_hires_lookup_l)) != 0) {
+		/* the collisions in ANTIC_cl are the renderer's, it keeps its own */
+		memcpy(sent->cl, ANTIC_cl, sizeof(ANTIC_cl));
+		memcpy(sent->lookup_gtia9, ANTIC_lookup_gtia9, sizeof(ANTIC_lookup_gtia9));
+		memcpy(sent->lookup_gtia11, ANTIC_lookup_gtia11, sizeof(ANTIC_lookup_gtia11));
+		memcpy(sent->hires_lookup_l, ANTIC_hires_lookup_l, sizeof(ANTIC_hires_lookup_l));
+		memcpy(rec->cl, ANTIC_cl, sizeof(ANTIC_cl));
+		memcpy(rec->lookup_gtia9, ANTIC_lookup_gtia9, sizeof(ANTIC_lookup_gtia9));
+		memcpy(rec->lookup_gtia11, ANTIC_lookup_gtia11, sizeof(ANTIC_lookup_gtia11));
+		memcpy(rec->hires_lookup_l, ANTIC_hires_lookup_l, sizeof(ANTIC_hires_lookup_l));
+		rec->parts |= RENDER_TABLES;
+	}
+	if (playfield && anticmode <= 7) {
+		/* the font the drawing routines of modes 2-7 read */
+		UWORD font_addr = anticmode <= 5 ? chbase_20 & 0xfc00 : chbase_20;
+		UWORD font_size = anticmode <= 5 ? 1024 : 512;
+		const UBYTE *font;
+		if (ANTIC_xe_ptr != NULL && chbase_20 < 0x8000 && chbase_20 >= 0x4000)
+			font = ANTIC_xe_ptr + (font_addr - 0x4000);
+		else
+			font = MEMORY_mem + font_addr;
+		if (renderer.send_all || font_addr != sent->font_addr || font_size != sent->font_size
+			|| memcmp(sent->font, font, font_size) != 0) {
+			sent->font_addr = font_addr;
+			sent->font_size = font_size;
+			memcpy(sent->font, font, font_size);
+			rec->font_addr = font_addr;
+			rec->font_size = font_size;
+			memcpy(rec->font, font, font_size);
+			rec->parts |= RENDER_FONT;
+		}
+	}
+	renderer.send_all = FALSE;
+	render_log();
+}
+
+void ANTIC_SyncCollisions(void)
+{
+	UBYTE colls[4];
+	if (!renderer.deferring)
+		return;
+	render_flush();
+	Renderer_GetCollisions(colls);
+	PF0PM = colls[0];
+	PF1PM = colls[1];
+	PF2PM = colls[2];
+	PF3PM = colls[3];
+}
+
+void ANTIC_SetCollisions(void)
+{
+	render_record *rec;
+	if (!renderer.deferring)
+		return;
+	rec = render_next();
+	rec->kind = RENDER_COLLISIONS;
+	rec->colls[0] = PF0PM;
+	rec->colls[1] = PF1PM;
+	rec->colls[2] = PF2PM;
+	rec->colls[3] = PF3PM;
+	render_log();
+}
+
+#define RENDER_WAIT render_wait()
+
+#else /* ANTIC_RENDER_INSTANCE */
+
+/* What the drawing reads of GTIA, the memory and the screen, as the
+   records bring it */
+UBYTE GTIA_COLPM0;
+UBYTE GTIA_COLPM1;
+UBYTE GTIA_COLPM2;
+UBYTE GTIA_COLPM3;
+UBYTE GTIA_COLPF0;
+UBYTE GTIA_COLPF1;
+UBYTE GTIA_COLPF2;
+UBYTE GTIA_COLPF3;
+UBYTE GTIA_COLBK;
+UBYTE GTIA_PRIOR;
+UBYTE GTIA_pm_scanline[Screen_WIDTH / 2 + 8];
+int GTIA_pm_dirty;
+UBYTE MEMORY_mem[65536 + 2];
+ULONG *Screen_atari;
+
+void Renderer_Initialise(void)
+{
+	static char name[] = "atari800";
+	char *argv[1];
+	int argc = 1;
+	argv[0] = name;
+	ANTIC_Initialise(&argc, argv);
+}
+
+void Renderer_GetCollisions(UBYTE *colls)
+{
+	colls[0] = PF0PM;
+	colls[1] = PF1PM;
+	colls[2] = PF2PM;
+	colls[3] = PF3PM;
+}
+
+void Renderer_Replay(const render_record *rec)
+{
+	if (rec->kind == RENDER_FRAME) {
+		Screen_atari = rec->screen;
+		scanline_cache_generation = rec->generation;
+		ANTIC_scanline_cache = rec->scanline_cache;
+	}
+	if (rec->kind != RENDER_SEGMENT) {
+		PF0PM = rec->colls[0];
+		PF1PM = rec->colls[1];
+		PF2PM = rec->colls[2];
+		PF3PM = rec->colls[3];
+		return;
+	}
+
+	if (rec->parts & RENDER_MEMORY)
+		memcpy(antic_memory, rec->antic_memory, sizeof(antic_memory));
+	if (rec->parts & RENDER_PM)
+		memcpy(GTIA_pm_scanline, rec->pm_scanline, sizeof(GTIA_pm_scanline));
+	if (rec->parts & RENDER_TABLES) {
+		UBYTE colls[4];
+		Renderer_GetCollisions(colls);
+		memcpy(ANTIC_cl, rec->cl, sizeof(ANTIC_cl));
+		memcpy(ANTIC_lookup_gtia9, rec->lookup_gtia9, sizeof(ANTIC_lookup_gtia9));
+		memcpy(ANTIC_lookup_gtia11, rec->lookup_gtia11, sizeof(ANTIC_lookup_gtia11));
+		memcpy(ANTIC_hires_lookup_l, rec->hires_lookup_l, sizeof(ANTIC_hires_lookup_l));
+		PF0PM = colls[0];
+		PF1PM = colls[1];
+		PF2PM = colls[2];
+		PF3PM = colls[3];
+	}
+	if (rec->parts & RENDER_FONT)
+		memcpy(MEMORY_mem + rec->font_addr, rec->font, rec->font_size);
+	if (rec->artif_mode != ANTIC_artif_mode || rec->artif_new != ANTIC_artif_new) {
+		ANTIC_artif_mode = rec->artif_mode;
+		ANTIC_artif_new = rec->artif_new;
+		ANTIC_UpdateArtifacting();
+	}
+
+	draw_antic_ptr = draw_functions[rec->draw];
+	draw_antic_0_ptr = draw_0_functions[rec->draw_0];
+	pm_lookup_ptr = pm_lookup_table[rec->pm_lookup];
+	draw_antic_ptr_changed = rec->draw_changed;
+	anticmode = rec->anticmode;
+	dctr = rec->dctr;
+	invert_mask = rec->invert_mask;
+	ANTIC_DMACTL = rec->dmactl;
+	ANTIC_HSCROL = rec->hscrol;
+	GTIA_PRIOR = rec->prior;
+	GTIA_pm_dirty = rec->pm_dirty;
+#ifndef NO_SIMPLE_PAL_BLENDING
+	ANTIC_pal_blending = rec->pal_blending;
+#endif
+	GTIA_COLPM0 = rec->colours[0];
+	GTIA_COLPM1 = rec->colours[1];
+	GTIA_COLPM2 = rec->colours[2];
+	GTIA_COLPM3 = rec->colours[3];
+	GTIA_COLPF0 = rec->colours[4];
+	GTIA_COLPF1 = rec->colours[5];
+	GTIA_COLPF2 = rec->colours[6];
+	GTIA_COLPF3 = rec->colours[7];
+	GTIA_COLBK = rec->colours[8];
+	chbase_20 = rec->chbase_20;
+	md = rec->md;
+	blank_mask = rec->blank_mask;
+	dmactl_bug_chdata = rec->dmactl_bug_chdata;
+	left_border_chars = rec->left_border_chars;
+	right_border_start = rec->right_border_start;
+	memcpy(chars_displayed, rec->chars_displayed, sizeof(chars_displayed));
+	memcpy(x_min, rec->x_min, sizeof(x_min));
+	memcpy(ch_offset, rec->ch_offset, sizeof(ch_offset));
+	need_load = FALSE;
+
+	scrn_ptr = (UWORD *) Screen_atari + rec->y * (Screen_WIDTH / 2);
+	draw_partial_scanline(rec->l, rec->r);
+}
+
+#endif /* DEFER_DRAWING */
+
+#endif /* ANTIC_RENDER_THREAD */
+
+#ifndef RENDER_WAIT
+#define RENDER_WAIT
+#endif
+
 #ifdef NEW_CYCLE_EXACT
 int ANTIC_cur_screen_pos = ANTIC_NOT_DRAWING;
 #endif
@@ -2846,6 +4102,32 @@ int ANTIC_cur_screen_pos = ANTIC_NOT_DRAWING;
 static int scanlines_to_curses_display = 0;
 #endif
 
+void ANTIC_NextOverscreenLine(void)
+{
+	ANTIC_xpos -= ANTIC_LINE_C;
+	ANTIC_screenline_cpu_clock += ANTIC_LINE_C;
+	UPDATE_DMACTL;
+	ANTIC_ypos++;
+	UPDATE_GTIA_BUG;
+	ANTIC_batch_lines--;
+	POKEY_Scanline();		/* check and generate IRQ */
+	ANTIC_xpos += ANTIC_DMAR;
+}
+
+/* Runs the overscreen lines up to end. The fast CPU loops take them in one
+   CPU_GO() call, going through ANTIC_NextOverscreenLine() at each line end;
+   the others, or a CPU stopped on the way, return at the first, and the
+   rest are run from here. */
+static void overscreen_lines(int end)
+{
+	do {
+		ANTIC_batch_lines = end - ANTIC_ypos - 1;
+		POKEY_Scanline();		/* check and generate IRQ */
+		OVERSCREEN_LINE;
+	} while (ANTIC_ypos < end);
+	ANTIC_batch_lines = 0;
+}
+
 /* This function emulates one frame drawing screen at Screen_atari */
 void ANTIC_Frame(int draw_display)
 {
@@ -2859,6 +4141,8 @@ void ANTIC_Frame(int draw_display)
 		{ 0, 0, 7, 9, 7, 15, 7, 15, 7, 3, 3, 1, 0, 1, 0, 0 };
 	UBYTE vscrol_flag = FALSE;
 	UBYTE no_jvb = TRUE;
+	UBYTE dl_fetched;
+	UWORD dl_addr = 0;
 #ifndef NEW_CYCLE_EXACT
 	UBYTE need_load;
 #endif
@@ -2867,15 +4151,21 @@ void ANTIC_Frame(int draw_display)
 	int cpu2antic_index;
 #endif /* NEW_CYCLE_EXACT */
 
+#ifdef NEW_CYCLE_EXACT
+	/* draw_partial_scanline draws the collisions */
+	if (draw_display == ANTIC_DRAW_COLLISIONS)
+		draw_display = TRUE;
+#endif
+
 	ANTIC_ypos = 0;
-	do {
-		POKEY_Scanline();		/* check and generate IRQ */
-		OVERSCREEN_LINE;
-	} while (ANTIC_ypos < 8);
+	overscreen_lines(8);
 
 	scrn_ptr = (UWORD *) Screen_atari;
 #ifdef NEW_CYCLE_EXACT
 	ANTIC_cur_screen_pos = ANTIC_NOT_DRAWING;
+#endif
+#ifdef DEFER_DRAWING
+	render_begin_frame(draw_display);
 #endif
 	need_dl = TRUE;
 	do {
@@ -2895,8 +4185,11 @@ void ANTIC_Frame(int draw_display)
 #endif
 
 		need_load = FALSE;
+		dl_fetched = FALSE;
 		if (need_dl) {
 			if (ANTIC_DMACTL & 0x20) {
+				dl_addr = ANTIC_dlist;
+				dl_fetched = TRUE;
 				IR = ANTIC_GetDLByte(&ANTIC_dlist);
 				anticmode = IR & 0xf;
 				ANTIC_xpos++;
@@ -3007,6 +4300,8 @@ void ANTIC_Frame(int draw_display)
 			ANTIC_dlist = ANTIC_GetDLWord(&ANTIC_dlist);
 			ANTIC_xpos += 2;
 		}
+		if (dl_fetched)
+			dl_record(dl_addr);
 
 #ifdef NEW_CYCLE_EXACT
 		/* begin drawing here */
@@ -3066,7 +4361,10 @@ void ANTIC_Frame(int draw_display)
 #define YPOS_BREAK_FLICKER do{if (ANTIC_ypos == ANTIC_break_ypos - 1000) {\
 				static int toggle;\
 				if (toggle == 1) {\
+					RENDER_WAIT;\
 					FILL_VIDEO(scrn_ptr + LBORDER_START, 0x0f0f, (RBORDER_END - LBORDER_START) * 2);\
+					if (ANTIC_scanline_cache)\
+						scanline_cache_drop();\
 				}\
 				toggle = !toggle;\
 			}}while(0)
@@ -3107,9 +4405,14 @@ void ANTIC_Frame(int draw_display)
 		ANTIC_xpos += ANTIC_DMAR;
 
 		if (anticmode < 2 || (ANTIC_DMACTL & 3) == 0) {
-			draw_antic_0_ptr();
+			if (draw_display != ANTIC_DRAW_COLLISIONS) {
+				draw_antic_0_ptr();
+				if (ANTIC_scanline_cache)
+					scanline_cache_drop();
+			}
 			GOEOL;
-			YPOS_BREAK_FLICKER;
+			if (draw_display != ANTIC_DRAW_COLLISIONS)
+				YPOS_BREAK_FLICKER;
 			scrn_ptr += Screen_WIDTH / 2;
 			if (no_jvb) {
 				dctr++;
@@ -3134,22 +4437,34 @@ void ANTIC_Frame(int draw_display)
 				ANTIC_xpos -= extra_cycles[md];
 		}
 
-		draw_antic_ptr(chars_displayed[md],
-			antic_memory + ANTIC_margin + ch_offset[md],
-			scrn_ptr + x_min[md],
-			(ULONG *) &GTIA_pm_scanline[x_min[md]]);
+		if (draw_display == ANTIC_DRAW_COLLISIONS)
+			collide_antic_line(chars_displayed[md],
+				antic_memory + ANTIC_margin + ch_offset[md],
+				&GTIA_pm_scanline[x_min[md]]);
+		else if (ANTIC_scanline_cache && scanline_cache_hit(TRUE))
+			skip_draw_antic();
+		else
+			draw_antic_ptr(chars_displayed[md],
+				antic_memory + ANTIC_margin + ch_offset[md],
+				scrn_ptr + x_min[md],
+				(ULONG *) &GTIA_pm_scanline[x_min[md]]);
 
 		GOEOL;
 #endif /* NEW_CYCLE_EXACT */
-		YPOS_BREAK_FLICKER;
+		if (draw_display != ANTIC_DRAW_COLLISIONS)
+			YPOS_BREAK_FLICKER;
 		scrn_ptr += Screen_WIDTH / 2;
 		dctr++;
 		dctr &= 0xf;
 	} while (ANTIC_ypos < (Screen_HEIGHT + 8));
+	dl_finish();
+#ifdef DEFER_DRAWING
+	render_end_frame();
+#endif
 
 #ifndef NO_SIMPLE_PAL_BLENDING
 	/* Simple PAL blending, using only the base 256 color palette. */
-	if (ANTIC_pal_blending)
+	if (ANTIC_pal_blending && draw_display != ANTIC_DRAW_COLLISIONS)
 	{
 		int ypos = ANTIC_ypos - 1;
 		/* Start at the last screen line (248). */
@@ -3189,11 +4504,17 @@ void ANTIC_Frame(int draw_display)
 	ANTIC_xpos += ANTIC_DMAR;
 	GOEOL;
 
-	do {
-		POKEY_Scanline();		/* check and generate IRQ */
-		OVERSCREEN_LINE;
-	} while (ANTIC_ypos < Atari800_tv_mode);
+	overscreen_lines(Atari800_tv_mode);
 	ANTIC_ypos = 0; /* just for monitor.c */
+
+	/* What is neither run by the CPU nor halted by WSYNC was taken by DMA */
+	ANTIC_cycles.total = ANTIC_CPU_CLOCK - frame_start_clock;
+	ANTIC_cycles.dma = ANTIC_cycles.total - ANTIC_cycles.cpu - ANTIC_cycles.wsync;
+	if (ANTIC_cycles.dma < 0)
+		ANTIC_cycles.dma = 0;
+	ANTIC_frame_cycles = ANTIC_cycles;
+	memset(&ANTIC_cycles, 0, sizeof(ANTIC_cycles));
+	frame_start_clock = ANTIC_CPU_CLOCK;
 }
 
 #ifdef NEW_CYCLE_EXACT
@@ -3351,6 +4672,13 @@ void draw_partial_scanline(int l, int r)
 	/* use this variable to alter the number of chars saved */
 	/* int l_borderpfchar=0; */
 
+#ifdef DEFER_DRAWING
+	if (renderer.deferring) {
+		render_partial_scanline(l, r);
+		return;
+	}
+#endif
+
 	r_pfchar = chars_displayed[md];
 	if (md == NORMAL1 || md == SCROLL1) { /* modes 6,7,a,b,c */
 		r_pfchar *= 2;
@@ -3480,7 +4808,11 @@ void draw_partial_scanline(int l, int r)
 			left_border_start = right_border_start;
 		}
 		draw_antic_0_ptr();
+		if (ANTIC_scanline_cache)
+			scanline_cache_drop();
 	}
+	else if (ANTIC_scanline_cache && scanline_cache_hit(l == lborder_start && r == rborder_end))
+		skip_draw_antic();
 	else {
 		draw_antic_ptr(nchars, /* chars_displayed[md], */
 			antic_memory + ANTIC_margin + ch_offset[md] + ch_adj,
@@ -3732,6 +5064,8 @@ glitch */
 					/*don't steal cycles after DMACTL off*/
 					ANTIC_cpu2antic_ptr = &CYCLE_MAP_cpu2antic[0];
 					ANTIC_antic2cpu_ptr = &CYCLE_MAP_antic2cpu[0];
+					/* same moment on the new map, not cycles run */
+					ANTIC_cycles.cpu += ANTIC_xpos - ANTIC_antic2cpu_ptr[actual_xpos];
 					ANTIC_xpos = ANTIC_antic2cpu_ptr[actual_xpos];
 					ANTIC_xpos_limit = ANTIC_antic2cpu_ptr[antic_limit];
 				}
@@ -4031,6 +5365,9 @@ glitch */
 		break;
 #endif /* defined(BASIC) || defined(CURSES_BASIC) */
 	case ANTIC_OFFSET_WSYNC:
+		/* The cycles skipped are taken back from the CPU_GO() running */
+		ANTIC_cycles.cpu += ANTIC_xpos;
+		ANTIC_cycles.wsync -= ANTIC_xpos;
 #ifdef NEW_CYCLE_EXACT
 		if (ANTIC_DRAWING_SCREEN) {
 			if (ANTIC_xpos <= ANTIC_antic2cpu_ptr[ANTIC_WSYNC_C] && ANTIC_xpos_limit >= ANTIC_antic2cpu_ptr[ANTIC_WSYNC_C])
@@ -4072,6 +5409,8 @@ case we have ANTIC_cpu2antic_ptr[ANTIC_WSYNC_C+1]-1 = 8 and in the 2nd =12  */
 #ifdef NEW_CYCLE_EXACT
 		}
 #endif /* NEW_CYCLE_EXACT */
+		ANTIC_cycles.cpu -= ANTIC_xpos;
+		ANTIC_cycles.wsync += ANTIC_xpos;
 		break;
 	case ANTIC_OFFSET_NMIEN:
 		ANTIC_NMIEN = byte;
@@ -1,6 +1,7 @@
 #ifndef ANTIC_H_
 #define ANTIC_H_
 
+#include "antic_render.h"
 #include "atari.h"
 
 /*
@@ -48,6 +49,33 @@ extern int ANTIC_xpos_limit;
 /* Main clock value at the beginning of the current scanline. */
 extern unsigned int ANTIC_screenline_cpu_clock;
 
+/* Overscreen lines after the current one that the CPU_GO() call running
+   it may run on into, 0 outside ANTIC_Frame()'s blank lines at the top and
+   bottom of the frame. At the end of each, CPU_GO() calls
+   ANTIC_NextOverscreenLine() instead of returning. */
+extern int ANTIC_batch_lines;
+
+/* Ends the current overscreen line and starts the next, as ANTIC_Frame()
+   would between two CPU_GO() calls. */
+void ANTIC_NextOverscreenLine(void);
+
+/* Where the cycles of a frame went. CPU_GO() and ANTIC count them in
+   ANTIC_cycles as the frame runs, a few additions per CPU_GO() call, and
+   ANTIC_Frame() works out total and dma and copies them to
+   ANTIC_frame_cycles when it ends. */
+typedef struct {
+	int total;	/* machine cycles in the frame */
+	int cpu;	/* run by the CPU, interrupt entry included */
+	int idle;	/* of cpu, in idle loops the emulation skipped over */
+	int dma;	/* taken by ANTIC: display list, screen, P/MG, refresh */
+	int wsync;	/* the CPU halted by WSYNC, DMA meanwhile not counted */
+	int dlis;	/* NMIs taken */
+	int vbis;
+	int irqs;	/* IRQs taken */
+} ANTIC_cycles_t;
+extern ANTIC_cycles_t ANTIC_cycles;
+extern ANTIC_cycles_t ANTIC_frame_cycles;
+
 /* Current main clock value. */
 #define ANTIC_CPU_CLOCK (ANTIC_screenline_cpu_clock + ANTIC_XPOS)
 
@@ -65,6 +93,9 @@ extern unsigned int ANTIC_screenline_cpu_clock;
    memory refresh cycles. */
 #define ANTIC_DMAR     9
 
+/* ANTIC_Frame() argument: collisions only */
+#define ANTIC_DRAW_COLLISIONS 2
+
 extern int ANTIC_artif_mode;
 extern int ANTIC_artif_new;
 
@@ -73,6 +104,9 @@ extern UBYTE ANTIC_PENV_input;
 
 int ANTIC_Initialise(int *argc, char *argv[]);
 void ANTIC_Reset(void);
+/* draw_display is TRUE to draw the frame, FALSE to only run it, or
+   ANTIC_DRAW_COLLISIONS to run it and set the collision registers as
+   drawing would, leaving Screen_atari alone. */
 void ANTIC_Frame(int draw_display);
 UBYTE ANTIC_GetByte(UWORD addr, int no_side_effects);
 void ANTIC_PutByte(UWORD addr, UBYTE byte);
@@ -134,4 +168,55 @@ void ANTIC_UpdateScanlinePrior(UBYTE byte);
 extern int ANTIC_pal_blending;
 #endif /* NO_SIMPLE_PAL_BLENDING */
 
+/* Set to 1 to leave scanlines that would be drawn as they were in the
+   previous frame in Screen_atari (-scanline-cache). Call
+   ANTIC_InvalidateScanlineCache() when setting it at run time. */
+extern int ANTIC_scanline_cache;
+
+/* Forget the scanlines kept by the cache, after something other than
+   ANTIC_Frame has drawn on Screen_atari. */
+void ANTIC_InvalidateScanlineCache(void);
+
+#ifdef ANTIC_RENDER_THREAD
+/* Set to 1 to have a thread draw the scanlines of the frames, a few lines
+   behind the emulation (-render-thread). The thread starts or stops with
+   the next frame drawn. */
+extern int ANTIC_render_thread;
+
+/* Bring PF0PM-PF3PM in ANTIC_cl up to the lines run so far, waiting for
+   the renderer thread to draw them. GTIA calls it before it reads or saves
+   the collisions. */
+void ANTIC_SyncCollisions(void);
+
+/* Have the renderer thread go on from PF0PM-PF3PM as they are in ANTIC_cl
+   now, after GTIA has cleared or loaded them. */
+void ANTIC_SetCollisions(void);
+#endif /* ANTIC_RENDER_THREAD */
+
+/* Draw lines scanlines of ANTIC mode mode (2..15) in GTIA mode gtia
+   (0..3, as in PRIOR bits 6-7) from the top of Screen_atari down,
+   wrapping at the bottom, with the routine ANTIC_Frame would use for an
+   unscrolled line of the playfield width DMACTL sets. data holds the
+   line's 48 bytes of screen memory; the players and missiles come from
+   GTIA_pm_scanline as it stands. For timing the drawing routines on their
+   own (-benchmark-kernels): it must not be called from ANTIC_Frame. */
+void ANTIC_DrawModeLines(int mode, int gtia, const UBYTE *data, int lines);
+
+/* One display list instruction as ANTIC ran it */
+typedef struct {
+	UWORD addr;			/* where it was fetched from */
+	UWORD ypos;			/* first scanline */
+	UWORD lines;		/* scanlines up to the next instruction fetched */
+	UWORD operand;		/* screen address for modes 2-F, jump target for 1 */
+	UBYTE ir;
+} ANTIC_DLEntry;
+
+/* Most instructions a frame can fetch: one per displayed scanline */
+#define ANTIC_DL_MAX 240
+
+/* The display list of the last frame, as ANTIC_Frame walked it. Returns
+   the number of entries; *generation changes when they differ from the
+   frame before. */
+int ANTIC_GetDisplayList(const ANTIC_DLEntry **entries, ULONG *generation);
+
 #endif /* ANTIC_H_ */
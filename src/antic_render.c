@@ -0,0 +1,20 @@
+/*
+ * antic_render.c - the ANTIC drawing code built a second time, for the
+ *                  renderer thread
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+/* antic.c under the names of antic_render.h: its drawing routines, their
+   state and the copy of what they read are the renderer thread's own, and
+   Renderer_Replay() draws the records antic.c logs. The rest of antic.c
+   comes along unused. */
+
+#include "config.h"
+#include "antic_render.h"
+
+#ifdef ANTIC_RENDER_THREAD
+#define ANTIC_RENDER_INSTANCE
+#include "antic.c"
+#endif
@@ -0,0 +1,108 @@
+/*
+ * antic_render.h - the ANTIC drawing code built a second time, for the
+ *                  renderer thread
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+#ifndef ANTIC_RENDER_H_
+#define ANTIC_RENDER_H_
+
+/* With ANTIC_render_thread set, the emulation only logs each part of a
+   scanline it would draw, with everything the drawing reads, and a thread
+   draws the lines from the log a few lines behind. The thread runs the
+   drawing code of antic.c built a second time by antic_render.c, under the
+   names below, so that it has the state of the drawing routines - lookup
+   tables, the scanline cache, the playfield collisions - to itself. */
+#if defined(NEW_CYCLE_EXACT) && defined(HAVE_PTHREAD_CREATE) && !defined(BASIC) \
+	&& !defined(CURSES_BASIC) && !defined(USE_CURSES) && !defined(PAGED_MEM) && !defined(DIRTYRECT)
+#define ANTIC_RENDER_THREAD
+#endif
+
+#endif /* ANTIC_RENDER_H_ */
+
+/* antic_render.c defines ANTIC_RENDER_INSTANCE before including antic.c,
+   which gets here before any declaration these rename */
+#if defined(ANTIC_RENDER_INSTANCE) && !defined(ANTIC_RENDER_NAMES_)
+#define ANTIC_RENDER_NAMES_
+
+#define ANTIC_CHACTL Renderer_ANTIC_CHACTL
+#define ANTIC_CHBASE Renderer_ANTIC_CHBASE
+#define ANTIC_DMACTL Renderer_ANTIC_DMACTL
+#define ANTIC_DrawModeLines Renderer_ANTIC_DrawModeLines
+#define ANTIC_Frame Renderer_ANTIC_Frame
+#define ANTIC_GetByte Renderer_ANTIC_GetByte
+#define ANTIC_GetDLByte Renderer_ANTIC_GetDLByte
+#define ANTIC_GetDLWord Renderer_ANTIC_GetDLWord
+#define ANTIC_GetDisplayList Renderer_ANTIC_GetDisplayList
+#define ANTIC_HSCROL Renderer_ANTIC_HSCROL
+#define ANTIC_Initialise Renderer_ANTIC_Initialise
+#define ANTIC_InvalidateScanlineCache Renderer_ANTIC_InvalidateScanlineCache
+#define ANTIC_NMIEN Renderer_ANTIC_NMIEN
+#define ANTIC_NMIST Renderer_ANTIC_NMIST
+#define ANTIC_NextOverscreenLine Renderer_ANTIC_NextOverscreenLine
+#define ANTIC_PENH_input Renderer_ANTIC_PENH_input
+#define ANTIC_PENV_input Renderer_ANTIC_PENV_input
+#define ANTIC_PMBASE Renderer_ANTIC_PMBASE
+#define ANTIC_PutByte Renderer_ANTIC_PutByte
+#define ANTIC_Reset Renderer_ANTIC_Reset
+#define ANTIC_SetPrior Renderer_ANTIC_SetPrior
+#define ANTIC_StateRead Renderer_ANTIC_StateRead
+#define ANTIC_StateSave Renderer_ANTIC_StateSave
+#define ANTIC_SetCollisions Renderer_ANTIC_SetCollisions
+#define ANTIC_SyncCollisions Renderer_ANTIC_SyncCollisions
+#define ANTIC_UpdateArtifacting Renderer_ANTIC_UpdateArtifacting
+#define ANTIC_UpdateScanline Renderer_ANTIC_UpdateScanline
+#define ANTIC_UpdateScanlinePrior Renderer_ANTIC_UpdateScanlinePrior
+#define ANTIC_VSCROL Renderer_ANTIC_VSCROL
+#define ANTIC_VideoMemset Renderer_ANTIC_VideoMemset
+#define ANTIC_VideoPutByte Renderer_ANTIC_VideoPutByte
+#define ANTIC_antic2cpu_ptr Renderer_ANTIC_antic2cpu_ptr
+#define ANTIC_artif_mode Renderer_ANTIC_artif_mode
+#define ANTIC_artif_new Renderer_ANTIC_artif_new
+#define ANTIC_batch_lines Renderer_ANTIC_batch_lines
+#define ANTIC_break_ypos Renderer_ANTIC_break_ypos
+#define ANTIC_cl Renderer_ANTIC_cl
+#define ANTIC_cpu2antic_ptr Renderer_ANTIC_cpu2antic_ptr
+#define ANTIC_cur_screen_pos Renderer_ANTIC_cur_screen_pos
+#define ANTIC_cycles Renderer_ANTIC_cycles
+#define ANTIC_delayed_wsync Renderer_ANTIC_delayed_wsync
+#define ANTIC_dlist Renderer_ANTIC_dlist
+#define ANTIC_frame_cycles Renderer_ANTIC_frame_cycles
+#define ANTIC_hires_lookup_l Renderer_ANTIC_hires_lookup_l
+#define ANTIC_lookup_gtia11 Renderer_ANTIC_lookup_gtia11
+#define ANTIC_lookup_gtia9 Renderer_ANTIC_lookup_gtia9
+#define ANTIC_missile_dma_enabled Renderer_ANTIC_missile_dma_enabled
+#define ANTIC_missile_flickering Renderer_ANTIC_missile_flickering
+#define ANTIC_missile_gra_enabled Renderer_ANTIC_missile_gra_enabled
+#define ANTIC_pal_blending Renderer_ANTIC_pal_blending
+#define ANTIC_player_dma_enabled Renderer_ANTIC_player_dma_enabled
+#define ANTIC_player_flickering Renderer_ANTIC_player_flickering
+#define ANTIC_player_gra_enabled Renderer_ANTIC_player_gra_enabled
+#define ANTIC_render_thread Renderer_ANTIC_render_thread
+#define ANTIC_scanline_cache Renderer_ANTIC_scanline_cache
+#define ANTIC_screenline_cpu_clock Renderer_ANTIC_screenline_cpu_clock
+#define ANTIC_wsync_halt Renderer_ANTIC_wsync_halt
+#define ANTIC_xe_ptr Renderer_ANTIC_xe_ptr
+#define ANTIC_xpos Renderer_ANTIC_xpos
+#define ANTIC_xpos_limit Renderer_ANTIC_xpos_limit
+#define ANTIC_ypos Renderer_ANTIC_ypos
+
+/* What the drawing reads of GTIA, the memory and the screen */
+#define GTIA_COLBK Renderer_GTIA_COLBK
+#define GTIA_COLPF0 Renderer_GTIA_COLPF0
+#define GTIA_COLPF1 Renderer_GTIA_COLPF1
+#define GTIA_COLPF2 Renderer_GTIA_COLPF2
+#define GTIA_COLPF3 Renderer_GTIA_COLPF3
+#define GTIA_COLPM0 Renderer_GTIA_COLPM0
+#define GTIA_COLPM1 Renderer_GTIA_COLPM1
+#define GTIA_COLPM2 Renderer_GTIA_COLPM2
+#define GTIA_COLPM3 Renderer_GTIA_COLPM3
+#define GTIA_PRIOR Renderer_GTIA_PRIOR
+#define GTIA_pm_dirty Renderer_GTIA_pm_dirty
+#define GTIA_pm_scanline Renderer_GTIA_pm_scanline
+#define MEMORY_mem Renderer_MEMORY_mem
+#define Screen_atari Renderer_Screen_atari
+
+#endif /* ANTIC_RENDER_INSTANCE */
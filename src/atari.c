@@ -65,6 +65,7 @@
 #include "cassette.h"
 #include "cfg.h"
 #include "cpu.h"
+#include "crc32.h"
 #include "devices.h"
 #include "esc.h"
 #include "gtia.h"
@@ -82,7 +83,9 @@
 #include "platform.h"
 #include "pokey.h"
 #include "rtime.h"
+#include "ai_heatmap.h"
 #include "ai_interface.h"
+#include "benchmark.h"
 #include "pbi.h"
 #include "sio.h"
 #include "sysrom.h"
@@ -124,6 +127,12 @@
 #ifdef PBI_BB
 #include "pbi_bb.h"
 #endif
+#ifdef PBI_MIO
+#include "pbi_mio.h"
+#endif
+#ifdef PBI_XLD
+#include "pbi_xld.h"
+#endif
 #if defined(PBI_XLD) || defined (VOICEBOX)
 #include "votraxsnd.h"
 #endif
@@ -151,6 +160,12 @@
 #ifdef NETSIO
 #include "netsio.h"
 #endif /* NETSIO */
+#ifdef NETPLAY
+#include "netplay.h"
+#endif
+#ifdef STREAM_OUTPUT
+#include "stream.h"
+#endif
 
 int Atari800_machine_type = Atari800_MACHINE_XLXE;
 
@@ -168,18 +183,55 @@ int Atari800_os_version = -1;
 
 int verbose = FALSE;
 
+/* -startup-timing: the time each step of Atari800_Initialise() took */
+#define STARTUP_STEPS 64
+static struct {
+	const char *name;
+	double time;
+} startup_steps[STARTUP_STEPS];
+static int startup_count = 0;
+static double startup_start;
+static double startup_mark;
+static int startup_timing = FALSE;
+
+/* Charges the time since the previous step to name and returns ok, so
+   it can wrap an initialiser in a condition: the initialiser runs first,
+   as the argument */
+static int Startup(const char *name, int ok)
+{
+	double now = Util_time();
+	if (startup_count < STARTUP_STEPS) {
+		startup_steps[startup_count].name = name;
+		startup_steps[startup_count].time = now - startup_mark;
+		startup_count++;
+	}
+	startup_mark = now;
+	return ok;
+}
+
+static void PrintStartup(void)
+{
+	int i;
+	if (!startup_timing)
+		return;
+	Log_print("Startup: %.2f ms", (startup_mark - startup_start) * 1e3);
+	for (i = 0; i < startup_count; i++)
+		if (startup_steps[i].time >= 5e-6)
+			Log_print("\t%-16s %8.3f ms", startup_steps[i].name, startup_steps[i].time * 1e3);
+}
+
 int Atari800_display_screen = FALSE;
 int Atari800_nframes = 0;
 int Atari800_refresh_rate = 1;
+int Atari800_frames_skipped = 0;
 int Atari800_collisions_in_skipped_frames = FALSE;
 int Atari800_turbo = FALSE;
 int Atari800_turbo_speed = 0; /* percentage speed or 0 for max turbo */
+int Atari800_run_ahead = 0;
+int Atari800_quick_boot = FALSE;
 int Atari800_start_in_monitor = FALSE;
 int Atari800_auto_frameskip = FALSE;
-
-#ifdef BENCHMARK
-static double benchmark_start_time;
-#endif
+int Atari800_sync_spin = TRUE;
 
 #ifdef CTRL_C_HANDLER
 volatile sig_atomic_t sigint_flag = FALSE;
@@ -249,6 +301,211 @@ void Atari800_Warmstart(void)
 #endif /* NETSIO */
 }
 
+#ifndef BASIC
+/* Quick boot. After a cold start the OS tests and clears the memory and
+   sets itself up the same way every time, until it first calls SIOV, to
+   boot from a disk or to load a program. Watching a cold start, the state
+   at the start of the frame of that call is kept for the setup: the
+   machine, its memory, the ROMs and the cartridges. A later cold start of
+   the same setup reads it back at once. Disks and the program being loaded
+   are read only from SIOV on, so every boot of the setup gets it. */
+#define QUICK_BOOT_ENTRIES 8
+/* A cold start that has not called SIOV by then never will: a cartridge
+   that does not boot, or the SIO patch not used */
+#define QUICK_BOOT_MAX_FRAMES 300
+
+typedef struct {
+	int machine_type;
+	int ram_size;
+	int axlon_banks;
+	int mosaic_banks;
+	int mapram;
+	int tv_mode;
+	int builtin_basic;
+	int builtin_game;
+	int disable_basic;
+	int loading_basic;
+	int device_patches;  /* the OS in RAM carries them */
+	int consol;
+	int cart_type[2];
+	ULONG cart_crc[2];
+	ULONG os_crc;
+	ULONG basic_crc;
+} quick_boot_key_t;
+
+static struct {
+	quick_boot_key_t key;
+	UBYTE *state;
+	ULONG len;
+	int consol_override;
+} quick_boot_entries[QUICK_BOOT_ENTRIES];
+static int quick_boot_count = 0;
+static int quick_boot_next = 0;  /* entry to replace when all are taken */
+
+/* The cold start being watched */
+static struct {
+	int active;
+	int frames;        /* run since the cold start */
+	quick_boot_key_t key;
+	UBYTE *state;      /* at the start of the present frame */
+	ULONG size;
+	ULONG len;
+	int consol_override;
+} quick_boot_capture = { FALSE, 0 };
+
+static void QuickBootCart(const CARTRIDGE_image_t *cart, int *type, ULONG *crc)
+{
+	*type = cart->type;
+	*crc = cart->type != CARTRIDGE_NONE && cart->image != NULL
+		? CRC32_Update(0xffffffff, cart->image, (unsigned int)cart->size << 10) : 0;
+}
+
+/* Returns FALSE if cold starts of the present setup cannot be quick */
+static int QuickBootKey(quick_boot_key_t *key)
+{
+	/* Holding Start boots from the cassette, with side effects left out
+	   of snapshots; PBI devices and network SIO have their own state */
+	if (Atari800_machine_type == Atari800_MACHINE_5200 || !ESC_enable_sio_patch
+		|| CASSETTE_hold_start)
+		return FALSE;
+#ifdef PBI_MIO
+	if (PBI_MIO_enabled)
+		return FALSE;
+#endif
+#ifdef PBI_BB
+	if (PBI_BB_enabled)
+		return FALSE;
+#endif
+#ifdef PBI_XLD
+	if (PBI_XLD_enabled)
+		return FALSE;
+#endif
+#ifdef AF80
+	if (AF80_enabled)
+		return FALSE;
+#endif
+#ifdef BIT3
+	if (BIT3_enabled)
+		return FALSE;
+#endif
+#ifdef NETSIO
+	if (netsio_enabled)
+		return FALSE;
+#endif
+	/* Padding zeroed too, as keys are compared with memcmp */
+	memset(key, 0, sizeof(*key));
+	key->machine_type = Atari800_machine_type;
+	key->ram_size = MEMORY_ram_size;
+	key->axlon_banks = MEMORY_axlon_num_banks;
+	key->mosaic_banks = MEMORY_mosaic_num_banks;
+	key->mapram = MEMORY_enable_mapram;
+	key->tv_mode = Atari800_tv_mode;
+	key->builtin_basic = Atari800_builtin_basic;
+	key->builtin_game = Atari800_builtin_game;
+	key->disable_basic = Atari800_disable_basic;
+	key->loading_basic = BINLOAD_loading_basic;
+	key->device_patches = Devices_enable_h_patch | Devices_enable_p_patch << 1
+		| Devices_enable_r_patch << 2 | Devices_enable_b_patch << 3;
+	key->consol = INPUT_key_consol;
+	QuickBootCart(&CARTRIDGE_main, &key->cart_type[0], &key->cart_crc[0]);
+	QuickBootCart(&CARTRIDGE_piggyback, &key->cart_type[1], &key->cart_crc[1]);
+	key->os_crc = CRC32_Update(0xffffffff, MEMORY_os, sizeof(MEMORY_os_buffer));
+	key->basic_crc = CRC32_Update(0xffffffff, MEMORY_basic, sizeof(MEMORY_basic_buffer));
+	return TRUE;
+}
+
+/* Called at the end of a cold start: reads back the state kept for the
+   setup, or watches the boot for it */
+static void QuickBootColdstart(void)
+{
+	quick_boot_key_t key;
+	int i;
+
+	quick_boot_capture.active = FALSE;
+	if (!Atari800_quick_boot || !QuickBootKey(&key))
+		return;
+	for (i = 0; i < quick_boot_count; i++) {
+		if (memcmp(&quick_boot_entries[i].key, &key, sizeof(key)) == 0) {
+			if (StateSav_ReadSnapshot(quick_boot_entries[i].state, quick_boot_entries[i].len)) {
+				GTIA_consol_override = quick_boot_entries[i].consol_override;
+				return;
+			}
+			/* The snapshot no longer fits the machine: take it again */
+			break;
+		}
+	}
+	quick_boot_capture.key = key;
+	quick_boot_capture.frames = 0;
+	quick_boot_capture.len = 0;
+	quick_boot_capture.active = TRUE;
+}
+
+void Atari800_QuickBootFrame(void)
+{
+	if (!quick_boot_capture.active)
+		return;
+	if (quick_boot_capture.frames >= QUICK_BOOT_MAX_FRAMES) {
+		quick_boot_capture.active = FALSE;
+		return;
+	}
+	quick_boot_capture.len = quick_boot_capture.state != NULL
+		? StateSav_SaveSnapshot(quick_boot_capture.state, quick_boot_capture.size) : 0;
+	if (quick_boot_capture.len == 0) {
+		/* First boot watched, or the machine got more RAM */
+		quick_boot_capture.size = StateSav_SaveSnapshot(NULL, 0);
+		quick_boot_capture.state = (UBYTE *)Util_realloc(quick_boot_capture.state, quick_boot_capture.size);
+		quick_boot_capture.len = StateSav_SaveSnapshot(quick_boot_capture.state, quick_boot_capture.size);
+	}
+	quick_boot_capture.consol_override = GTIA_consol_override;
+	quick_boot_capture.frames++;
+}
+
+void Atari800_QuickBootSIO(void)
+{
+	int i;
+
+	if (!quick_boot_capture.active)
+		return;
+	quick_boot_capture.active = FALSE;
+	/* Nothing to gain if SIOV is called in the frame of the cold start */
+	if (quick_boot_capture.frames < 2 || quick_boot_capture.len == 0)
+		return;
+	for (i = 0; i < quick_boot_count; i++) {
+		if (memcmp(&quick_boot_entries[i].key, &quick_boot_capture.key, sizeof(quick_boot_capture.key)) == 0)
+			break;
+	}
+	if (i == quick_boot_count) {
+		if (quick_boot_count < QUICK_BOOT_ENTRIES)
+			quick_boot_count++;
+		else {
+			i = quick_boot_next;
+			quick_boot_next = (quick_boot_next + 1) % QUICK_BOOT_ENTRIES;
+		}
+	}
+	quick_boot_entries[i].key = quick_boot_capture.key;
+	quick_boot_entries[i].state = (UBYTE *)Util_realloc(quick_boot_entries[i].state, quick_boot_capture.len);
+	memcpy(quick_boot_entries[i].state, quick_boot_capture.state, quick_boot_capture.len);
+	quick_boot_entries[i].len = quick_boot_capture.len;
+	quick_boot_entries[i].consol_override = quick_boot_capture.consol_override;
+}
+
+void Atari800_QuickBootClear(void)
+{
+	while (quick_boot_count > 0) {
+		quick_boot_count--;
+		free(quick_boot_entries[quick_boot_count].state);
+		quick_boot_entries[quick_boot_count].state = NULL;
+	}
+	quick_boot_next = 0;
+	quick_boot_capture.active = FALSE;
+}
+
+int Atari800_QuickBootEntries(void)
+{
+	return quick_boot_count;
+}
+#endif /* BASIC */
+
 void Atari800_Coldstart(void)
 {
 	PBI_Reset();
@@ -283,6 +540,9 @@ void Atari800_Coldstart(void)
 	if(netsio_enabled)
 		netsio_cold_reset();
 #endif /* NETSIO */
+#ifndef BASIC
+	QuickBootColdstart();
+#endif
 }
 
 int Atari800_LoadImage(const char *filename, UBYTE *buffer, int nbytes)
@@ -309,17 +569,18 @@ static int load_roms(void)
 	int basic_ver, xegame_ver;
 	SYSROM_ChooseROMs(Atari800_machine_type, MEMORY_ram_size, Atari800_tv_mode, &Atari800_os_version, &basic_ver, &xegame_ver);
 	if (Atari800_os_version == -1
-		|| !SYSROM_LoadImage(Atari800_os_version, MEMORY_os)) {
+		|| !SYSROM_LoadImage(Atari800_os_version, MEMORY_os_buffer, sizeof(MEMORY_os_buffer), &MEMORY_os)) {
 		/* Missing OS ROM. */
 		Atari800_os_version = -1;
 		/* Avoid MEMORY_os containing old OS when the user explicitly removed
 		   all system ROMs from settings. */
-		memset(MEMORY_os, 0, sizeof(MEMORY_os));
+		memset(MEMORY_os_buffer, 0, sizeof(MEMORY_os_buffer));
+		MEMORY_os = MEMORY_os_buffer;
 		return FALSE;
 	}
 	else if (Atari800_machine_type != Atari800_MACHINE_5200) {
 		/* OS ROM found, try loading BASIC. */
-		MEMORY_have_basic = basic_ver != -1 && SYSROM_LoadImage(basic_ver, MEMORY_basic);
+		MEMORY_have_basic = basic_ver != -1 && SYSROM_LoadImage(basic_ver, MEMORY_basic_buffer, sizeof(MEMORY_basic_buffer), &MEMORY_basic);
 		if (!MEMORY_have_basic)
 			/* Missing BASIC ROM. Don't fail when it happens. */
 			Atari800_builtin_basic = FALSE;
@@ -327,7 +588,7 @@ static int load_roms(void)
 		if (Atari800_builtin_game) {
 			/* Try loading built-in XEGS game. */
 			if (xegame_ver == -1
-				|| !SYSROM_LoadImage(xegame_ver, MEMORY_xegame))
+				|| !SYSROM_LoadImage(xegame_ver, MEMORY_xegame_buffer, sizeof(MEMORY_xegame_buffer), &MEMORY_xegame))
 				/* Missing XEGS game ROM. */
 				Atari800_builtin_game = FALSE;
 		}
@@ -389,13 +650,19 @@ int Atari800_Initialise(int *argc, char *argv[])
 
 	g_ulAtariState = ATARI_UNINITIALIZED;
 #endif /* _WX_ */
+	startup_start = startup_mark = Util_time();
 	PreInitialise();
+	Startup("preinitialise", TRUE);
 #else /* __PLUS */
 	const char *rtconfig_filename = NULL;
+	const char *config_snapshot = NULL;
 	int got_config;
 	int help_only = FALSE;
 
+	startup_start = startup_mark = Util_time();
+	startup_count = 0;
 	PreInitialise();
+	Startup("preinitialise", TRUE);
 
 	if (*argc > 1) {
 		for (i = j = 1; i < *argc; i++) {
@@ -420,6 +687,28 @@ int Atari800_Initialise(int *argc, char *argv[])
 			else if (strcmp(argv[i], "-verbose") == 0) {
 				verbose = TRUE;
 			}
+			else if (strcmp(argv[i], "-startup-timing") == 0) {
+				startup_timing = TRUE;
+			}
+			else if (strcmp(argv[i], "-rom-cache") == 0) {
+				if (i + 1 < *argc)
+					SYSROM_SetCacheFile(argv[++i]);
+				else {
+					Log_print("Missing argument for '%s'", argv[i]);
+					return FALSE;
+				}
+			}
+			else if (strcmp(argv[i], "-no-rom-cache") == 0) {
+				SYSROM_SetCacheFile(NULL);
+			}
+			else if (strcmp(argv[i], "-config-snapshot") == 0) {
+				if (i + 1 < *argc)
+					config_snapshot = argv[++i];
+				else {
+					Log_print("Missing argument for '%s'", argv[i]);
+					return FALSE;
+				}
+			}
 			else {
 				argv[j++] = argv[i];
 			}
@@ -428,9 +717,12 @@ int Atari800_Initialise(int *argc, char *argv[])
 	}
 #ifndef ANDROID
 	got_config = CFG_LoadConfig(rtconfig_filename);
+	if (config_snapshot != NULL)
+		CFG_WriteSnapshot(config_snapshot);
 #else
 	got_config = TRUE; /* pretend we got a config file -- not needed in Android */
 #endif
+	Startup("config", TRUE);
 
 	/* try to find ROM images if the configuration file is not found
 	   or it does not specify some ROM paths (blank paths count as specified) */
@@ -462,6 +754,7 @@ int Atari800_Initialise(int *argc, char *argv[])
 	/* finally if nothing is found, set some defaults to make
 	   the configuration file easier to edit */
 	SYSROM_SetDefaults();
+	Startup("rom_search", TRUE);
 
 	/* if no configuration file read, try to save one with the defaults (except when
 	   using libatari800) */
@@ -606,6 +899,12 @@ int Atari800_Initialise(int *argc, char *argv[])
 		else if (strcmp(argv[i], "-turbo") == 0) {
 			Atari800_turbo = TRUE;
 		}
+		else if (strcmp(argv[i], "-no-idle-skip") == 0)
+			CPU_idle_skip = FALSE;
+		else if (strcmp(argv[i], "-sync-spin") == 0)
+			Atari800_sync_spin = TRUE;
+		else if (strcmp(argv[i], "-no-sync-spin") == 0)
+			Atari800_sync_spin = FALSE;
 #ifdef NETSIO
 		else if (strcmp(argv[i], "-netsio") == 0) {
 			/* Optional UDP port argument (default 9997). */
@@ -701,6 +1000,21 @@ int Atari800_Initialise(int *argc, char *argv[])
 				else
 					a_m = TRUE;
 			}
+			else if (strcmp(argv[i], "-run-ahead") == 0) {
+				if (i_a) {
+					Atari800_run_ahead = Util_sscandec(argv[++i]);
+					if (Atari800_run_ahead < 0 || Atari800_run_ahead > Atari800_RUN_AHEAD_MAX) {
+						Log_print("Invalid run-ahead frames, using 0");
+						Atari800_run_ahead = 0;
+					}
+				}
+				else
+					a_m = TRUE;
+			}
+			else if (strcmp(argv[i], "-quick-boot") == 0)
+				Atari800_quick_boot = TRUE;
+			else if (strcmp(argv[i], "-no-quick-boot") == 0)
+				Atari800_quick_boot = FALSE;
 			else if (strcmp(argv[i], "-autosave-config") == 0)
 				CFG_save_on_exit = TRUE;
 			else if (strcmp(argv[i], "-no-autosave-config") == 0)
@@ -725,6 +1039,11 @@ int Atari800_Initialise(int *argc, char *argv[])
 #ifndef __PLUS
 					help_only = TRUE;
 					Log_print("\t-config <file>   Specify alternate configuration file");
+					Log_print("\t-config-snapshot <file>");
+					Log_print("\t                 Write the configuration read to <file> in binary form");
+					Log_print("\t-rom-cache <file>");
+					Log_print("\t                 Keep the checksums of ROM images found in <file>");
+					Log_print("\t-no-rom-cache    Read every ROM image found at each start");
 #endif
 					Log_print("\t-autosave-config Automatically save configuration on emulator exit");
 					Log_print("\t-no-autosave-config");
@@ -747,6 +1066,9 @@ int Atari800_Initialise(int *argc, char *argv[])
 #ifndef BASIC
 					Log_print("\t-state <file>    Load saved-state file");
 					Log_print("\t-refresh <rate>  Specify screen refresh rate");
+					Log_print("\t-run-ahead <n>   Show the frame n frames ahead of the input (0-%d)", Atari800_RUN_AHEAD_MAX);
+					Log_print("\t-quick-boot      Skip the OS start-up on cold starts seen before");
+					Log_print("\t-no-quick-boot   Run the OS start-up on every cold start");
 #endif
 					Log_print("\t-nopatch         Don't patch SIO routine in OS");
 					Log_print("\t-nopatchall      Don't patch OS at all, H: device won't work");
@@ -767,6 +1089,9 @@ int Atari800_Initialise(int *argc, char *argv[])
 					Log_print("\t-nostereo        Turn off emulation of two POKEYs");
 #endif
 					Log_print("\t-turbo           Run emulated Atari as fast as possible");
+					Log_print("\t-no-idle-skip    Run every pass of loops waiting for an interrupt");
+					Log_print("\t-sync-spin       Wait out the last moment of each frame busily (default)");
+					Log_print("\t-no-sync-spin    Only sleep between frames");
 					Log_print("\t-monitor         Start emulated Atari in the monitor");
 #ifdef MONITOR_BREAK
 					Log_print("\t-bbrk            Break on BRK instruction");
@@ -775,6 +1100,7 @@ int Atari800_Initialise(int *argc, char *argv[])
 #ifdef MONITOR_HINTS
 					Log_print("\t-label-file <f>  Load monitor labels from file <f>");
 #endif
+					Log_print("\t-startup-timing  Print the time each step of the startup took");
 					Log_print("\t-v               Show version/release number");
 				}
 
@@ -799,69 +1125,79 @@ int Atari800_Initialise(int *argc, char *argv[])
 	/* Update machine feature variables. after reading from config file and/or
 	   command-line options. */
 	Atari800_SetMachineType(Atari800_machine_type);
+	Startup("options", TRUE);
 
 #ifdef SDL
 	if (!help_only) {
-		if (!SDL_INIT_Initialise())
+		if (!Startup("sdl", SDL_INIT_Initialise()))
 			return FALSE;
 	}
 #endif /* SDL */
 
-	if (!SYSROM_Initialise(argc, argv)
+	if (!Startup("sysrom", SYSROM_Initialise(argc, argv))
 #if !defined(BASIC) && !defined(CURSES_BASIC)
-		|| !Colours_Initialise(argc, argv)
-		|| !ARTIFACT_Initialise(argc, argv)
+		|| !Startup("colours", Colours_Initialise(argc, argv))
+		|| !Startup("artifact", ARTIFACT_Initialise(argc, argv))
 #endif
-		|| !Devices_Initialise(argc, argv)
-		|| !RTIME_Initialise(argc, argv)
+		|| !Startup("devices", Devices_Initialise(argc, argv))
+		|| !Startup("rtime", RTIME_Initialise(argc, argv))
 #ifdef IDE
-		|| !IDE_Initialise(argc, argv)
+		|| !Startup("ide", IDE_Initialise(argc, argv))
 #endif
 #ifdef POKEYREC
-		|| !POKEYREC_Initialise(argc, argv)
+		|| !Startup("pokeyrec", POKEYREC_Initialise(argc, argv))
 #endif
-		|| !SIO_Initialise (argc, argv)
-		|| !CARTRIDGE_Initialise(argc, argv)
-		|| !CASSETTE_Initialise(argc, argv)
-		|| !PBI_Initialise(argc,argv)
+		|| !Startup("sio", SIO_Initialise(argc, argv))
+		|| !Startup("cartridge", CARTRIDGE_Initialise(argc, argv))
+		|| !Startup("cassette", CASSETTE_Initialise(argc, argv))
+		|| !Startup("pbi", PBI_Initialise(argc, argv))
 #ifdef VOICEBOX
-		|| !VOICEBOX_Initialise(argc, argv)
+		|| !Startup("voicebox", VOICEBOX_Initialise(argc, argv))
 #endif
 #ifndef BASIC
-		|| !INPUT_Initialise(argc, argv)
+		|| !Startup("input", INPUT_Initialise(argc, argv))
 #endif
 #ifdef XEP80_EMULATION
-		|| !XEP80_Initialise(argc, argv)
+		|| !Startup("xep80", XEP80_Initialise(argc, argv))
 #endif
 #ifdef AF80
-		|| !AF80_Initialise(argc, argv)
+		|| !Startup("af80", AF80_Initialise(argc, argv))
 #endif
 #ifdef BIT3
-		|| !BIT3_Initialise(argc, argv) 
+		|| !Startup("bit3", BIT3_Initialise(argc, argv)) 
 #endif
 #ifdef NTSC_FILTER
-		|| !FILTER_NTSC_Initialise(argc, argv)
+		|| !Startup("filter_ntsc", FILTER_NTSC_Initialise(argc, argv))
 #endif
 #if SUPPORTS_CHANGE_VIDEOMODE
-		|| !VIDEOMODE_Initialise(argc, argv)
+		|| !Startup("videomode", VIDEOMODE_Initialise(argc, argv))
 #endif
 #ifndef DONT_DISPLAY
 		/* Platform Specific Initialisation */
-		|| !PLATFORM_Initialise(argc, argv)
+		|| !Startup("platform", PLATFORM_Initialise(argc, argv))
 #endif
 #if !defined(BASIC) && !defined(CURSES_BASIC)
-		|| !Screen_Initialise(argc, argv)
-		|| !UI_Initialise(argc, argv)
+		|| !Startup("screen", Screen_Initialise(argc, argv))
+		|| !Startup("ui", UI_Initialise(argc, argv))
 #if defined(AUDIO_RECORDING) || defined(VIDEO_RECORDING)
-		|| !File_Export_Initialise(argc, argv)
+		|| !Startup("file_export", File_Export_Initialise(argc, argv))
 #endif
 #endif
 		/* Initialise Custom Chips */
-		|| !ANTIC_Initialise(argc, argv)
-		|| !GTIA_Initialise(argc, argv)
-		|| !PIA_Initialise(argc, argv)
-		|| !POKEY_Initialise(argc, argv)
-		|| !AI_Initialise(argc, argv)
+		|| !Startup("antic", ANTIC_Initialise(argc, argv))
+		|| !Startup("gtia", GTIA_Initialise(argc, argv))
+		|| !Startup("pia", PIA_Initialise(argc, argv))
+		|| !Startup("pokey", POKEY_Initialise(argc, argv))
+		|| !Startup("ai", AI_Initialise(argc, argv))
+#ifdef NETPLAY
+		|| !Startup("netplay", NETPLAY_Initialise(argc, argv))
+#endif
+#ifdef STREAM_OUTPUT
+		|| !Startup("stream", STREAM_Initialise(argc, argv))
+#endif
+#ifndef LIBATARI800
+		|| !Startup("benchmark", BENCHMARK_Initialise(argc, argv))
+#endif
 	) {
 		Atari800_ErrExit();
 		return FALSE;
@@ -876,14 +1212,14 @@ int Atari800_Initialise(int *argc, char *argv[])
 
 #if SUPPORTS_CHANGE_VIDEOMODE
 #ifndef DONT_DISPLAY
-	if (!VIDEOMODE_InitialiseDisplay()) {
+	if (!Startup("display", VIDEOMODE_InitialiseDisplay())) {
 		Atari800_ErrExit();
 		return FALSE;
 	}
 #endif
 #endif
 	/* Configure Atari System */
-	Atari800_InitialiseMachine();
+	Startup("machine", Atari800_InitialiseMachine());
 #else /* __PLUS */
 
 	if (!InitialiseMachine()) {
@@ -950,14 +1286,16 @@ int Atari800_Initialise(int *argc, char *argv[])
 	}
 #endif
 	
+	Startup("media", TRUE);
+
 	/* Load Atari executable, if any */
 	if (run_direct != NULL)
-		BINLOAD_Loader(run_direct);
+		Startup("run", BINLOAD_Loader(run_direct));
 
 #ifndef BASIC
 	/* Load state file */
 	if (state_file != NULL) {
-		if (StateSav_ReadAtariState(state_file, "rb"))
+		if (Startup("state", StateSav_ReadAtariState(state_file, "rb")))
 			/* Don't press Start nor Option */
 			GTIA_consol_override = 0;
 	}
@@ -978,9 +1316,16 @@ int Atari800_Initialise(int *argc, char *argv[])
 	g_ulAtariState &= ~ATARI_UNINITIALIZED;
 #endif /* __PLUS */
 
-#ifdef BENCHMARK
-	benchmark_start_time = Util_time();
-#endif
+#ifndef LIBATARI800
+	if (BENCHMARK_enabled) {
+		/* Run the workloads in place of the emulator */
+		int ok;
+		PrintStartup();
+		ok = BENCHMARK_Run();
+		Atari800_ErrExit();
+		exit(ok ? 0 : 1);
+	}
+#endif /* LIBATARI800 */
 
 #ifdef SOUND
 	if (Sound_enabled) {
@@ -995,9 +1340,11 @@ int Atari800_Initialise(int *argc, char *argv[])
 		if (Sound_Setup())
 			/* Start sound if opening audio output was successful. */
 				Sound_Continue();
+		Startup("sound", TRUE);
 	}
 #endif /* SOUND */
 
+	PrintStartup();
 	return TRUE;
 }
 
@@ -1062,6 +1409,9 @@ int Atari800_Exit(int run_monitor)
 #if SUPPORTS_CHANGE_VIDEOMODE
 		VIDEOMODE_Exit();
 #endif
+#ifdef NTSC_FILTER
+		FILTER_NTSC_Exit();
+#endif
 #ifdef AF80
 		AF80_Exit();
 #endif
@@ -1072,6 +1422,12 @@ int Atari800_Exit(int run_monitor)
 		INPUT_Exit();	/* finish event recording */
 #endif
 		AI_Exit();  /* Clean up AI interface */
+#ifdef NETPLAY
+		NETPLAY_Exit();
+#endif
+#ifdef STREAM_OUTPUT
+		STREAM_Exit();
+#endif
 		PBI_Exit();
 		CASSETTE_Exit(); /* Finish writing to the cassette file */
 		CARTRIDGE_Exit();
@@ -1106,45 +1462,73 @@ void Atari800_ErrExit(void)
 
 #ifndef __PLUS
 #ifndef LIBATARI800
-static void autoframeskip(double curtime, double lasttime)
+/* Auto frameskip looks at the time each frame took from waking up after
+   the previous sync to this one, its work, as a histogram of the last
+   AFS_FRAMES frames in AFS_BINS bins up to twice the frame time. Frames
+   displayed and skipped are also summed apart, to predict the work at a
+   lower refresh rate: the work of a skipped frame plus the display cost
+   shared among fewer frames. */
+#define AFS_FRAMES 32
+#define AFS_BINS 32
+
+static void autoframeskip(double work, double deltatime)
 {
-	static int afs_lastframe = 0, afs_discard = 0;
-	static double afs_lasttime = 0.0, afs_sleeptime = 0.0;
-	double afs_speedpct, afs_sleeppct, afs_ataritime, afs_realtime;
-
-	if (lasttime - curtime > 0)
-		afs_sleeptime += lasttime - curtime;
-	if (curtime - afs_lasttime > 0.5) {
-		afs_ataritime = ((double) (Atari800_nframes - afs_lastframe)) /
-						((double) (Atari800_tv_mode == Atari800_TV_PAL ? Atari800_FPS_PAL : Atari800_FPS_NTSC));
-		afs_realtime = curtime - afs_lasttime;
-		afs_speedpct = 100.0 * afs_ataritime / afs_realtime;
-		afs_sleeppct = 100.0 * afs_sleeptime / afs_realtime;
-
-		if (afs_discard < 3 && (afs_realtime > 2.0 * afs_ataritime)) {
-			afs_discard++;
-		} else {
-			afs_discard = 0;
-			if (afs_speedpct < 90.0) {
-				if (Atari800_refresh_rate < 4)
-					Atari800_refresh_rate++;
-			} else {
-				if (afs_sleeppct > 20.0 && Atari800_refresh_rate > 1)
-					Atari800_refresh_rate--;
-			}
+	static int histogram[AFS_BINS];
+	static int frames = 0;
+	static int shown_frames = 0;
+	static double shown_work = 0.0, skipped_work = 0.0;
+	double mean, predicted;
+	int bin, count;
+
+	/* A stall, such as loading a file or an open menu, says nothing of
+	   the emulation speed */
+	if (work > 4.0 * deltatime)
+		return;
+	bin = (int) (work / deltatime * (AFS_BINS / 2));
+	histogram[bin < AFS_BINS ? bin : AFS_BINS - 1]++;
+	if (Atari800_display_screen) {
+		shown_frames++;
+		shown_work += work;
+	}
+	else
+		skipped_work += work;
+	if (++frames < AFS_FRAMES)
+		return;
+
+	/* 90th percentile, in bins */
+	for (bin = 0, count = 0; bin < AFS_BINS - 1; bin++) {
+		count += histogram[bin];
+		if (count * 10 >= frames * 9)
+			break;
+	}
+	mean = (shown_work + skipped_work) / frames;
+	if (mean > 0.95 * deltatime || (bin >= AFS_BINS / 2 && mean > 0.8 * deltatime)) {
+		/* Frames are late, or too many of them nearly */
+		if (Atari800_refresh_rate < 4)
+			Atari800_refresh_rate++;
+	}
+	else if (Atari800_refresh_rate > 1) {
+		if (shown_frames > 0 && shown_frames < frames) {
+			double skipped = skipped_work / (frames - shown_frames);
+			predicted = skipped + (shown_work / shown_frames - skipped) / (Atari800_refresh_rate - 1);
 		}
-
-		afs_sleeptime = 0.0;
-		afs_lastframe = Atari800_nframes;
-		afs_lasttime = Util_time();
+		else
+			predicted = mean;
+		if (predicted < 0.8 * deltatime)
+			Atari800_refresh_rate--;
 	}
+
+	memset(histogram, 0, sizeof(histogram));
+	frames = shown_frames = 0;
+	shown_work = skipped_work = 0.0;
 }
 
 void Atari800_Sync(void)
 {
-	static double lasttime = 0;
+	static int64_t lasttime = 0;
+	static int64_t woke = 0;
 	double deltatime = 1.0 / ((Atari800_tv_mode == Atari800_TV_PAL) ? Atari800_FPS_PAL : Atari800_FPS_NTSC);
-	double curtime;
+	int64_t curtime;
 
 #if defined(SOUND) && !defined(__PLUS)
 	deltatime *= Sound_AdjustSpeed();
@@ -1156,14 +1540,17 @@ void Atari800_Sync(void)
 	if (Atari800_turbo && Atari800_turbo_speed > 0) {
 		deltatime /= Atari800_turbo_speed / 100.0;
 	}
-	lasttime += deltatime;
-	curtime = Util_time();
+	/* in nanoseconds on the monotonic clock, so that the deadlines do not
+	   drift as they add up */
+	lasttime += (int64_t)(deltatime * 1e9);
+	curtime = Util_time_ns();
 	if (Atari800_auto_frameskip)
-		autoframeskip(curtime, lasttime);
-	Util_sleep(lasttime - curtime);
-	curtime = Util_time();
+		autoframeskip((curtime - woke) * 1e-9, deltatime);
+	if (lasttime > curtime)
+		Util_sleep_until(lasttime, Atari800_sync_spin);
+	curtime = woke = Util_time_ns();
 
-	if ((lasttime + deltatime) < curtime)
+	if (lasttime + (int64_t)(deltatime * 1e9) < curtime)
 		lasttime = curtime;
 }
 
@@ -1319,13 +1706,88 @@ static void basic_frame(void)
 #endif /* defined(BASIC) || defined(VERY_SLOW) || defined(CURSES_BASIC) */
 #endif /* LIBATARI800 */
 
+#if !defined(BASIC) && !defined(CURSES_BASIC)
+/* What is drawn over the Atari screen of a displayed frame */
+static void DrawOverlays(void)
+{
+	INPUT_DrawMousePointer();
+	Screen_DrawAtariSpeed(Util_time());
+	Screen_DrawDiskLED();
+	Screen_Draw1200LED();
+	Screen_DrawStatusText();
+}
+
+int Atari800_RunAheadWanted(void)
+{
+	if (Atari800_run_ahead == 0 || Atari800_turbo || AI_unthrottled)
+		return FALSE;
+#if defined(AUDIO_RECORDING) || defined(VIDEO_RECORDING)
+	/* A recording gets the frames as emulated */
+	if (File_Export_IsRecording())
+		return FALSE;
+#endif
+	/* Frames ahead would read on in the file, past what the
+	   snapshot brings back */
+	if (BINLOAD_bin_file != NULL)
+		return FALSE;
+	return TRUE;
+}
+
+void Atari800_RunAhead(void)
+{
+	static UBYTE *snapshot = NULL;
+	static ULONG snapshot_size = 0;
+	ULONG len = snapshot != NULL ? StateSav_SaveSnapshot(snapshot, snapshot_size) : 0;
+	/* The frames ahead are not seen by the AI interface's watches */
+	UBYTE *pc_watch = AI_pc_watch;
+	UBYTE *write_watch = AI_write_watch;
+	AI_ProfileRec *profile = AI_profile;
+	UBYTE *coverage = AI_coverage;
+	ULONG *heatmap = AI_HEATMAP_counts;
+	int i;
+
+	if (len == 0) {
+		/* First run, or the machine got more RAM */
+		snapshot_size = StateSav_SaveSnapshot(NULL, 0);
+		snapshot = (UBYTE *)Util_realloc(snapshot, snapshot_size);
+		len = StateSav_SaveSnapshot(snapshot, snapshot_size);
+	}
+	AI_pc_watch = AI_write_watch = AI_coverage = NULL;
+	AI_profile = NULL;
+	AI_HEATMAP_counts = NULL;
+#ifdef SOUND
+	POKEYSND_SetSpeculative(TRUE);
+#endif
+	for (i = 1; i <= Atari800_run_ahead; i++) {
+		GTIA_Frame();
+		ANTIC_Frame(i == Atari800_run_ahead ? TRUE : ANTIC_DRAW_COLLISIONS);
+		POKEY_Frame();
+	}
+#ifdef SOUND
+	POKEYSND_SetSpeculative(FALSE);
+#endif
+	AI_pc_watch = pc_watch;
+	AI_write_watch = write_watch;
+	AI_profile = profile;
+	AI_coverage = coverage;
+	AI_HEATMAP_counts = heatmap;
+	if (len == 0 || !StateSav_ReadSnapshot(snapshot, len))
+		Log_print("Run-ahead snapshot failed");
+}
+#endif /* !defined(BASIC) && !defined(CURSES_BASIC) */
+
 void Atari800_Frame(void)
 {
 #ifndef BASIC
 	static int refresh_counter = 0;
+#ifndef CURSES_BASIC
+	int run_ahead = FALSE;
+#endif
 
 	/* Process AI interface commands */
+	AI_TIME_STAGE(AI_TIME_HOST);
 	AI_Frame();
+	AI_TIME_STAGE(AI_TIME_AI);
 
 #ifdef CTRL_C_HANDLER
 	if (sigint_flag) {
@@ -1383,15 +1845,23 @@ void Atari800_Frame(void)
 #endif
 	Devices_Frame();
 #ifndef BASIC
+	Atari800_QuickBootFrame();
+#ifdef NETPLAY
+	NETPLAY_Frame();  /* exchange input, roll back wrongly guessed frames */
+#endif
 	INPUT_Frame();
 	AI_ApplyInput();  /* Apply AI joystick/trigger overrides */
+#ifdef NETPLAY
+	NETPLAY_ApplyInput();
+#endif
 #endif
 	GTIA_Frame();
+	AI_TIME_STAGE(AI_TIME_INPUT);
 
 #ifdef BASIC
 	basic_frame();
 #else /* BASIC */
-	if (++refresh_counter >= Atari800_refresh_rate) {
+	if (++refresh_counter >= Atari800_refresh_rate && AI_RenderFrame()) {
 		refresh_counter = 0;
 #ifdef USE_CURSES
 		curses_clear_screen();
@@ -1399,12 +1869,14 @@ void Atari800_Frame(void)
 #ifdef CURSES_BASIC
 		basic_frame();
 #else
-		ANTIC_Frame(TRUE);
-		INPUT_DrawMousePointer();
-		Screen_DrawAtariSpeed(Util_time());
-		Screen_DrawDiskLED();
-		Screen_Draw1200LED();
-		Screen_DrawStatusText();
+		run_ahead = Atari800_RunAheadWanted();
+		if (run_ahead)
+			/* Atari800_RunAhead() draws a later frame */
+			ANTIC_Frame(ANTIC_DRAW_COLLISIONS);
+		else {
+			ANTIC_Frame(TRUE);
+			DrawOverlays();
+		}
 #endif /* CURSES_BASIC */
 #ifdef DONT_DISPLAY
 		Atari800_display_screen = FALSE;
@@ -1413,40 +1885,51 @@ void Atari800_Frame(void)
 #endif /* DONT_DISPLAY */
 	}
 	else {
+		if (refresh_counter < Atari800_refresh_rate)
+			Atari800_frames_skipped++;
 #if defined(VERY_SLOW) || defined(CURSES_BASIC)
 		basic_frame();
 #else
-		ANTIC_Frame(Atari800_collisions_in_skipped_frames);
+		ANTIC_Frame(Atari800_collisions_in_skipped_frames ? ANTIC_DRAW_COLLISIONS : FALSE);
 #endif
 		Atari800_display_screen = FALSE;
 	}
 #endif /* BASIC */
+	AI_TIME_STAGE(AI_TIME_ANTIC);
 	POKEY_Frame();
+#ifdef NETSIO
+	if (netsio_enabled)
+		netsio_flush();
+#endif /* NETSIO */
+	AI_TIME_STAGE(AI_TIME_POKEY);
 #ifdef VIDEO_RECORDING
 	File_Export_WriteVideo();
+	AI_TIME_STAGE(AI_TIME_RECORD);
 #endif
 #ifdef SOUND
 	Sound_Update();
+#endif
+	AI_TIME_STAGE(AI_TIME_SOUND);
+#ifdef STREAM_OUTPUT
+	STREAM_Frame();
+#endif
+#if !defined(BASIC) && !defined(CURSES_BASIC)
+	if (run_ahead) {
+		Atari800_RunAhead();
+		DrawOverlays();
+	}
 #endif
 #if defined(AUDIO_RECORDING) || defined(VIDEO_RECORDING)
 	/* multimedia stats are drawn here so they don't get recorded in the video */
 	Screen_DrawMultimediaStats();
+	AI_TIME_STAGE(AI_TIME_RECORD);
 #endif
 	Atari800_nframes++;
 #ifndef LIBATARI800
-#ifdef BENCHMARK
-	if (Atari800_nframes >= BENCHMARK) {
-		double benchmark_time = Util_time() - benchmark_start_time;
-		Atari800_ErrExit();
-		printf("%d frames emulated in %.2f seconds\n", BENCHMARK, benchmark_time);
-		exit(0);
-	}
-#else
-
 #ifdef ALTERNATE_SYNC_WITH_HOST
 	if (refresh_counter == 0)
 #endif
-		if (Atari800_turbo && Atari800_turbo_speed == 0) {
+		if ((Atari800_turbo && Atari800_turbo_speed == 0) || AI_unthrottled) {
 			/* No need to draw Atari frames with frequency higher than display
 			   refresh rate. */
 			static double last_display_screen_time = 0.0;
@@ -1460,8 +1943,9 @@ void Atari800_Frame(void)
 		}
 		else
 			Atari800_Sync();
-#endif /* BENCHMARK */
 #endif /* LIBATARI800 */
+	AI_TIME_STAGE(AI_TIME_SYNC);
+	AI_TIME_FRAME();
 }
 
 #endif /* __PLUS */
@@ -108,9 +108,18 @@ extern int Atari800_nframes;
 /* How often the screen is updated (1 = every Atari frame). */
 extern int Atari800_refresh_rate;
 
+/* Frames not drawn because of Atari800_refresh_rate, counted by
+   Atari800_Frame(). */
+extern int Atari800_frames_skipped;
+
 /* If TRUE, will try to maintain the emulation speed to 100% */
 extern int Atari800_auto_frameskip;
 
+/* If TRUE, Atari800_Sync() sleeps until shortly before the end of the
+   frame and spins for the rest, for the oversleep of the host's sleep
+   calls, up to 4 ms; if FALSE it only sleeps. */
+extern int Atari800_sync_spin;
+
 /* Set to TRUE for faster emulation with Atari800_refresh_rate > 1.
    Set to FALSE for accurate emulation with Atari800_refresh_rate > 1. */
 extern int Atari800_collisions_in_skipped_frames;
@@ -120,6 +129,37 @@ extern int Atari800_turbo;
 /* Percentage speed or 0 for max turbo */
 extern int Atari800_turbo_speed;
 
+/* Frames to run ahead of the input: each displayed frame is emulated
+   without drawing, saved to a snapshot, followed by Atari800_run_ahead
+   frames with the same input, the last of them drawn, and read back. What
+   is shown then answers input that many frames sooner. The frames run
+   ahead are not heard and are left out of video recordings, which stop
+   it. 0 turns it off. */
+#define Atari800_RUN_AHEAD_MAX 4
+extern int Atari800_run_ahead;
+/* TRUE if the frame about to be displayed is to be run ahead. The frame
+   is then emulated with ANTIC_DRAW_COLLISIONS, and Atari800_RunAhead()
+   called after its sound: it runs the frames ahead with the input held,
+   draws the last one and reads the state after the first back. */
+int Atari800_RunAheadWanted(void);
+void Atari800_RunAhead(void);
+
+/* Quick boot: with Atari800_quick_boot on, a cold start watched until the
+   OS first calls SIOV leaves the state at the start of that frame kept for
+   the setup (machine, memory, ROMs, cartridges, OS patches), and a later
+   cold start of the same setup reads it back, skipping the OS's memory
+   test and clearing. Disks and the program loaded do not matter, as the OS
+   reads them from SIOV on. Needs the SIO patch; not for the 5200, a
+   cassette boot or PBI devices. Atari800_QuickBootFrame() is called at the
+   start of each frame, before the input is read, and
+   Atari800_QuickBootSIO() by the SIO patch. */
+extern int Atari800_quick_boot;
+void Atari800_QuickBootFrame(void);
+void Atari800_QuickBootSIO(void);
+/* Forget the states kept, e.g. after changing a ROM in place */
+void Atari800_QuickBootClear(void);
+int Atari800_QuickBootEntries(void);
+
 /* Set to TRUE to start in the monitor. It's up to each port's
 	main.c to implement this (initially only SDL supports it). */
 extern int Atari800_start_in_monitor;
@@ -54,6 +54,9 @@
 static int curses_mode = CURSES_LEFT;
 
 static int curses_screen[24][40];
+/* What stdscr holds, so that only changed cells are written to it;
+   -1 is never a character */
+static int shown_screen[24][40];
 
 int PLATFORM_Initialise(int *argc, char *argv[])
 {
@@ -92,6 +95,7 @@ int PLATFORM_Initialise(int *argc, char *argv[])
 	keypad(stdscr, TRUE);
 	curs_set(0);				/* Disable Cursor */
 	nodelay(stdscr, 1);			/* Don't block for keypress */
+	memset(shown_screen, 0xff, sizeof(shown_screen));
 
 #ifdef SOUND
 	if (!Sound_Initialise(argc, argv))
@@ -109,6 +113,9 @@ int PLATFORM_Exit(int run_monitor)
 
 	if (run_monitor && MONITOR_Run()) {
 		curs_set(0);
+		/* Put back what the monitor scrolled away, as
+		   PLATFORM_DisplayScreen() refreshes only on changes */
+		refresh();
 		return TRUE;
 	}
 	return FALSE;
@@ -252,9 +259,14 @@ void PLATFORM_DisplayScreen(void)
 {
 	int x;
 	int y;
+	int changed = FALSE;
 	for (y = 0; y < 24; y++) {
 		for (x = 0; x < 40; x++) {
 			int ch = curses_screen[y][x];
+			if (ch == shown_screen[y][x])
+				continue;
+			shown_screen[y][x] = ch;
+			changed = TRUE;
 			switch (curses_mode) {
 			default:
 			case CURSES_LEFT:
@@ -278,7 +290,10 @@ void PLATFORM_DisplayScreen(void)
 			addch(ch);
 		}
 	}
-	refresh();
+	/* Curses sends only what differs from the terminal anyway, but
+	   not touching stdscr saves it comparing the whole screen */
+	if (changed)
+		refresh();
 }
 
 int PLATFORM_Keyboard(void)
@@ -103,12 +103,20 @@ static int motif_disk_sel = 1;
 #include <X11/extensions/XShm.h>
 
 static XShmSegmentInfo shminfo;
-static XImage *image = NULL;
+static int use_shm = FALSE;
 #ifdef USE_COLOUR_TRANSLATION_TABLE
 extern int colour_translation_table[256];
 #endif
 #endif /* SHM */
 
+/* The window's pixels, converted from the palette on this side and sent
+   with XShmPutImage(), or XPutImage() where the server cannot share memory
+   with us, such as a remote one. NULL when the visual's pixels are not 8, 16
+   or 32 bits: then points and rectangles are drawn into a pixmap instead. */
+static XImage *image = NULL;
+/* Rows of the window changed by this frame, sent without shared memory */
+static UBYTE changed_rows[Screen_HEIGHT];
+
 static int invisible = 0;
 
 #ifdef LINUX_JOYSTICK
@@ -154,9 +162,7 @@ static int clipping_height = Screen_HEIGHT;
 static Display *display = NULL;
 static Screen *screen = NULL;
 static Window window;
-#ifndef SHM
 static Pixmap pixmap;
-#endif
 static Visual *visual = NULL;
 static Colormap cmap;
 
@@ -205,14 +211,11 @@ static int mouse_stick;			/* Mouse Joystick Position */
 static int js0_mode = -1;
 static int js1_mode = -1;
 
-#ifndef SHM
-
 #define	NPOINTS	(4096 / 4)
 #define	NRECTS	(4096 / 4)
 
 static XPoint points[NPOINTS];
 static XRectangle rectangles[NRECTS];
-#endif
 
 static int keyboard_consol = INPUT_CONSOL_NONE;
 static int menu_consol = INPUT_CONSOL_NONE;
@@ -261,14 +264,13 @@ static int GetKeyCode(XEvent *event)
 
 	switch (event->type) {
 	case Expose:
-#ifndef SHM
-		XCopyArea(display, pixmap, window, gc,
-				  0, 0,
-				  window_width, window_height,
-				  0, 0);
-#else
-		modified = TRUE;
-#endif
+		if (image == NULL)
+			XCopyArea(display, pixmap, window, gc,
+					  0, 0,
+					  window_width, window_height,
+					  0, 0);
+		else
+			modified = TRUE;
 		break;
 	case FocusIn:
 		autorepeat_off();
@@ -1383,6 +1385,63 @@ static void motif_exposure(Widget w, XtPointer client_data, XEvent *event,
 
 #endif /* MOTIF */
 
+#ifdef SHM
+static int shm_attach_failed;
+
+static int ShmErrorHandler(Display *d, XErrorEvent *error)
+{
+	shm_attach_failed = TRUE;
+	return 0;
+}
+
+/* Sets image up in memory shared with the X server. Fails on a server that
+   has the extension but runs on another machine. */
+static int CreateShmImage(int depth)
+{
+	int (*old_handler)(Display *, XErrorEvent *);
+
+	if (!XShmQueryExtension(display))
+		return FALSE;
+	image = XShmCreateImage(display, visual, depth, ZPixmap,
+							NULL, &shminfo, window_width, window_height);
+	if (image == NULL)
+		return FALSE;
+	if (image->bits_per_pixel != 8 && image->bits_per_pixel != 16 && image->bits_per_pixel != 32) {
+		XDestroyImage(image);
+		image = NULL;
+		return FALSE;
+	}
+	shminfo.shmid = shmget(IPC_PRIVATE, image->bytes_per_line * window_height, IPC_CREAT | 0777);
+	if (shminfo.shmid < 0) {
+		XDestroyImage(image);
+		image = NULL;
+		return FALSE;
+	}
+	shminfo.shmaddr = image->data = shmat(shminfo.shmid, 0, 0);
+	shminfo.readOnly = False;
+
+	XSync(display, False);
+	shm_attach_failed = image->data == (char *) -1;
+	if (!shm_attach_failed) {
+		old_handler = XSetErrorHandler(ShmErrorHandler);
+		XShmAttach(display, &shminfo);
+		XSync(display, False);
+		XSetErrorHandler(old_handler);
+	}
+	/* Goes when both sides have detached */
+	shmctl(shminfo.shmid, IPC_RMID, 0);
+	if (shm_attach_failed) {
+		if (image->data != (char *) -1)
+			shmdt(shminfo.shmaddr);
+		image->data = NULL;
+		XDestroyImage(image);
+		image = NULL;
+		return FALSE;
+	}
+	return TRUE;
+}
+#endif /* SHM */
+
 int PLATFORM_Initialise(int *argc, char *argv[])
 {
 #if !defined(XVIEW) && !defined(MOTIF)
@@ -2177,49 +2236,38 @@ int PLATFORM_Initialise(int *argc, char *argv[])
 #endif /* !defined(XVIEW) && !defined(MOTIF) */
 
 #ifdef SHM
+	use_shm = CreateShmImage(depth);
+	if (use_shm)
+		printf("Using X11 Shared Memory Extensions\n");
+	else
+		printf("X Shared Memory extensions not available, sending the screen over the connection\n");
+	if (!use_shm)
+#endif /* SHM */
 	{
-		int major;
-		int minor;
-		Bool pixmaps;
-		Status status;
-		int shmsize;
-
-		status = XShmQueryVersion(display, &major, &minor, &pixmaps);
-		if (!status) {
-			printf("X Shared Memory extensions not available\n");
-			exit(1);
+		image = XCreateImage(display, visual, depth, ZPixmap, 0, NULL,
+							 window_width, window_height, 32, 0);
+		if (image != NULL && image->bits_per_pixel != 8 && image->bits_per_pixel != 16
+			&& image->bits_per_pixel != 32) {
+			XDestroyImage(image);
+			image = NULL;
+		}
+		if (image != NULL) {
+			image->data = (char *) Util_malloc(image->bytes_per_line * window_height);
+			memset(image->data, 0, image->bytes_per_line * window_height);
 		}
-		printf("Using X11 Shared Memory Extensions\n");
-
-		image = XShmCreateImage(display, visual, depth, ZPixmap,
-						NULL, &shminfo, window_width, window_height);
-		shmsize = (window_width * window_height *
-					image->bits_per_pixel) / 8;
-
-		shminfo.shmid = shmget(IPC_PRIVATE, shmsize, IPC_CREAT | 0777);
-		shminfo.shmaddr = image->data = shmat(shminfo.shmid, 0, 0);
-		shminfo.readOnly = False;
-
-		XShmAttach(display, &shminfo);
-
-		XSync(display, False);
-
-		shmctl(shminfo.shmid, IPC_RMID, 0);
-
 	}
-#else
-	pixmap = XCreatePixmap(display, window,
-						   window_width, window_height, depth);
-#endif /* SHM */
+	if (image == NULL)
+		pixmap = XCreatePixmap(display, window,
+							   window_width, window_height, depth);
 
 	PLATFORM_PaletteUpdate();
 
-#ifndef SHM
-	XFillRectangle(display, pixmap, gc, 0, 0,
-				   window_width, window_height);
-	for (i = 0; i < NRECTS; i++)
-		rectangles[i].height = (windowsize == Huge) ? 3 : 2;
-#endif
+	if (image == NULL) {
+		XFillRectangle(display, pixmap, gc, 0, 0,
+					   window_width, window_height);
+		for (i = 0; i < NRECTS; i++)
+			rectangles[i].height = (windowsize == Huge) ? 3 : 2;
+	}
 
 	XMapWindow(display, window);
 
@@ -2281,11 +2329,22 @@ int PLATFORM_Exit(int run_monitor)
 				XFreeColormap(display, cmap);
 
 #ifdef SHM
-			if (image != NULL)
-				XDestroyImage(image);
-#else
-			XFreePixmap(display, pixmap);
+			if (use_shm) {
+				XShmDetach(display, &shminfo);
+				XSync(display, False);
+			}
 #endif
+			if (image != NULL) {
+#ifdef SHM
+				if (use_shm) {
+					shmdt(shminfo.shmaddr);
+					image->data = NULL;
+				}
+#endif
+				XDestroyImage(image);
+			}
+			else
+				XFreePixmap(display, pixmap);
 			XUnmapWindow(display, window);
 			XDestroyWindow(display, window);
 			autorepeat_restore();
@@ -2304,274 +2363,309 @@ int PLATFORM_Exit(int run_monitor)
 	return restart;
 }
 
-void PLATFORM_DisplayScreen(void)
+static void PutImage(int x, int y, int width, int height)
 {
-	static char status_line[64];
-	int update_status_line = FALSE;
-
-	if (!invisible) {
-		const UBYTE *ptr2 = (const UBYTE *) Screen_atari + clipping_y * Screen_WIDTH + clipping_x;
-
 #ifdef SHM
+	if (use_shm)
+		XShmPutImage(display, window, gc, image, x, y, x, y, width, height, 0);
+	else
+#endif
+		XPutImage(display, window, gc, image, x, y, x, y, width, height);
+}
 
-		int first_x = Screen_WIDTH;
-		int last_x = -1000;
-		int first_y = Screen_HEIGHT;
-		int last_y = -1000;
-		int x;
-		int y;
-
-#define SHM_SET_LAST \
-		last_y = y; \
-		if (x > last_x) \
-			last_x = x; \
-		if (x < first_x) \
-			first_x = x;
-
-#define SHM_DISPLAY_SCREEN(pixel_type) \
-			pixel_type *ptr = (pixel_type *) image->data; \
-			pixel_type help_color; \
-			if (windowsize == Small) { \
-				for (y = clipping_y; y < (clipping_y + clipping_height); y++) { \
-					for (x = clipping_x; x < (clipping_x + clipping_width); x++) { \
-						help_color = colours[*ptr2++]; \
-						if (help_color != *ptr || force_redraw) { \
-							SHM_SET_LAST \
-							*ptr = help_color; \
-						} \
-						ptr++; \
+/* Converts the changes into image and sends what changed */
+static void DisplayImage(const UBYTE *ptr2)
+{
+	int first_x = Screen_WIDTH;
+	int last_x = -1000;
+	int first_y = Screen_HEIGHT;
+	int last_y = -1000;
+	int x;
+	int y;
+
+#define IMAGE_SET_LAST \
+	last_y = y; \
+	changed_rows[y] = TRUE; \
+	if (x > last_x) \
+		last_x = x; \
+	if (x < first_x) \
+		first_x = x;
+
+#define IMAGE_DISPLAY_SCREEN(pixel_type) \
+		pixel_type *ptr = (pixel_type *) image->data; \
+		int line = image->bytes_per_line / sizeof(pixel_type); \
+		pixel_type help_color; \
+		if (windowsize == Small) { \
+			for (y = clipping_y; y < (clipping_y + clipping_height); y++) { \
+				for (x = clipping_x; x < (clipping_x + clipping_width); x++) { \
+					help_color = colours[*ptr2++]; \
+					if (help_color != *ptr || force_redraw) { \
+						IMAGE_SET_LAST \
+						*ptr = help_color; \
 					} \
-					if (first_y > last_y && last_y >= 0) \
-						first_y = last_y; \
-					ptr2 += Screen_WIDTH - clipping_width; \
+					ptr++; \
 				} \
+				if (first_y > last_y && last_y >= 0) \
+					first_y = last_y; \
+				ptr2 += Screen_WIDTH - clipping_width; \
+				ptr += line - window_width; \
 			} \
-			else if (windowsize == Large) { \
-				for (y = clipping_y; y < (clipping_y + clipping_height); y++) { \
-					pixel_type *ptr_second_line = ptr + window_width; \
-					for (x = clipping_x; x < (clipping_x + clipping_width); x++) { \
-						help_color = colours[*ptr2++]; \
-						if (help_color != *ptr || force_redraw) { \
-							SHM_SET_LAST \
-							ptr[0] = help_color; \
-							ptr[1] = help_color; \
-							ptr_second_line[0] = help_color; \
-							ptr_second_line[1] = help_color; \
-						} \
-						ptr += 2; \
-						ptr_second_line += 2; \
+		} \
+		else if (windowsize == Large) { \
+			for (y = clipping_y; y < (clipping_y + clipping_height); y++) { \
+				pixel_type *ptr_second_line = ptr + line; \
+				for (x = clipping_x; x < (clipping_x + clipping_width); x++) { \
+					help_color = colours[*ptr2++]; \
+					if (help_color != *ptr || force_redraw) { \
+						IMAGE_SET_LAST \
+						ptr[0] = help_color; \
+						ptr[1] = help_color; \
+						ptr_second_line[0] = help_color; \
+						ptr_second_line[1] = help_color; \
 					} \
-					if (first_y > last_y && last_y >= 0) \
-						first_y = last_y; \
-					ptr2 += Screen_WIDTH - clipping_width; \
-					ptr += window_width; \
+					ptr += 2; \
+					ptr_second_line += 2; \
 				} \
+				if (first_y > last_y && last_y >= 0) \
+					first_y = last_y; \
+				ptr2 += Screen_WIDTH - clipping_width; \
+				ptr += line + line - window_width; \
 			} \
-			else { \
-				for (y = clipping_y; y < (clipping_y + clipping_height); y++) { \
-					pixel_type *ptr_second_line = ptr + window_width; \
-					pixel_type *ptr_third_line = ptr + window_width + window_width; \
-					for (x = clipping_x; x < (clipping_x + clipping_width); x++) { \
-						help_color = colours[*ptr2++]; \
-						if (help_color != *ptr || force_redraw) { \
-							SHM_SET_LAST \
-							ptr[0] = help_color; \
-							ptr[1] = help_color; \
-							ptr[2] = help_color; \
-							ptr_second_line[0] = help_color; \
-							ptr_second_line[1] = help_color; \
-							ptr_second_line[2] = help_color; \
-							ptr_third_line[0] = help_color; \
-							ptr_third_line[1] = help_color; \
-							ptr_third_line[2] = help_color; \
-						} \
-						ptr += 3; \
-						ptr_second_line += 3; \
-						ptr_third_line += 3; \
+		} \
+		else { \
+			for (y = clipping_y; y < (clipping_y + clipping_height); y++) { \
+				pixel_type *ptr_second_line = ptr + line; \
+				pixel_type *ptr_third_line = ptr + line + line; \
+				for (x = clipping_x; x < (clipping_x + clipping_width); x++) { \
+					help_color = colours[*ptr2++]; \
+					if (help_color != *ptr || force_redraw) { \
+						IMAGE_SET_LAST \
+						ptr[0] = help_color; \
+						ptr[1] = help_color; \
+						ptr[2] = help_color; \
+						ptr_second_line[0] = help_color; \
+						ptr_second_line[1] = help_color; \
+						ptr_second_line[2] = help_color; \
+						ptr_third_line[0] = help_color; \
+						ptr_third_line[1] = help_color; \
+						ptr_third_line[2] = help_color; \
 					} \
-					if (first_y > last_y && last_y >= 0) \
-						first_y = last_y; \
-					ptr2 += Screen_WIDTH - clipping_width; \
-					ptr += window_width + window_width; \
+					ptr += 3; \
+					ptr_second_line += 3; \
+					ptr_third_line += 3; \
 				} \
-			}
-
-		if (image->bits_per_pixel == 32) {
-			SHM_DISPLAY_SCREEN(ULONG)
-		}
-		else if (image->bits_per_pixel == 16) {
-			SHM_DISPLAY_SCREEN(UWORD)
-		}
-		else if (image->bits_per_pixel == 8) {
-			SHM_DISPLAY_SCREEN(UBYTE)
+				if (first_y > last_y && last_y >= 0) \
+					first_y = last_y; \
+				ptr2 += Screen_WIDTH - clipping_width; \
+				ptr += 3 * line - window_width; \
+			} \
 		}
 
-		if (modified) {
-			XShmPutImage(display, window, gc, image, 0, 0, 0, 0,
-					 window_width, window_height, 0);
-			modified = FALSE;
-		}
-		else if (last_y >= 0) {
-			last_x++;
-			last_y++;
-			if (first_x < clipping_x)
-				first_x = clipping_x;
-			if (last_x > clipping_x + clipping_width)
-				last_x = clipping_x + clipping_width;
-			else if (last_x <= first_x)
-				last_x = first_x + 1;
-			if (first_y < clipping_y)
-				first_y = clipping_y;
-			if (last_y > clipping_y + clipping_height)
-				last_y = clipping_y + clipping_height;
-			else if (last_y <= first_y)
-				last_y = first_y + 1;
-
-			first_x *= clipping_factor;
-			last_x *= clipping_factor;
-			first_y *= clipping_factor;
-			last_y *= clipping_factor;
-
-			XShmPutImage(display, window, gc, image,
-					 first_x - (clipping_x * clipping_factor),
-					 first_y - (clipping_y * clipping_factor),
-					 first_x - (clipping_x * clipping_factor),
-					 first_y - (clipping_y * clipping_factor),
-					 last_x - first_x, last_y - first_y, 0);
+	if (image->bits_per_pixel == 32) {
+		IMAGE_DISPLAY_SCREEN(ULONG)
+	}
+	else if (image->bits_per_pixel == 16) {
+		IMAGE_DISPLAY_SCREEN(UWORD)
+	}
+	else if (image->bits_per_pixel == 8) {
+		IMAGE_DISPLAY_SCREEN(UBYTE)
+	}
+
+	if (modified) {
+		PutImage(0, 0, window_width, window_height);
+		modified = FALSE;
+	}
+	else if (last_y >= 0) {
+		last_x++;
+		last_y++;
+		if (first_x < clipping_x)
+			first_x = clipping_x;
+		if (last_x > clipping_x + clipping_width)
+			last_x = clipping_x + clipping_width;
+		else if (last_x <= first_x)
+			last_x = first_x + 1;
+		if (first_y < clipping_y)
+			first_y = clipping_y;
+		if (last_y > clipping_y + clipping_height)
+			last_y = clipping_y + clipping_height;
+		else if (last_y <= first_y)
+			last_y = first_y + 1;
+
+		first_x = (first_x - clipping_x) * clipping_factor;
+		last_x = (last_x - clipping_x) * clipping_factor;
+#ifdef SHM
+		if (use_shm)
+			PutImage(first_x, (first_y - clipping_y) * clipping_factor,
+					 last_x - first_x, (last_y - first_y) * clipping_factor);
+		else
+#endif
+		{
+			/* Each run of changed rows, as every byte goes over the wire */
+			for (y = first_y; y < last_y; y++) {
+				int rows = 0;
+				while (y + rows < last_y && changed_rows[y + rows])
+					rows++;
+				if (rows > 0) {
+					PutImage(first_x, (y - clipping_y) * clipping_factor,
+							 last_x - first_x, rows * clipping_factor);
+					y += rows;
+				}
+			}
 		}
+	}
+	memset(changed_rows, 0, sizeof(changed_rows));
 
+#ifdef SHM
+	/* The server must be done with image before it changes */
+	if (use_shm)
 		XSync(display, FALSE);
+	else
+#endif
+		XFlush(display);
+}
 
-#else /* SHM */
-
-		UBYTE *ptr = image_data + clipping_y * Screen_WIDTH + clipping_x;
-		int n = 0;
-		int last_colour = -1;
-		int x;
-		int y;
-
-		switch (windowsize) {
-		case Small:
-			for (y = 0; y < clipping_height; y++) {
-				for (x = 0; x < clipping_width; x++) {
-					UBYTE colour = *ptr2++;
-					if (colour != *ptr || force_redraw) {
-						*ptr = colour;
-						if (colour != last_colour || n >= NPOINTS) {
-							if (n > 0) {
-								XDrawPoints(display, pixmap, gc_colour[last_colour],
-											points, n, CoordModeOrigin);
-								n = 0;
-								modified = TRUE;
-							}
-							last_colour = colour;
+/* Draws the changes into pixmap as points and rectangles */
+static void DisplayPixmap(const UBYTE *ptr2)
+{
+	UBYTE *ptr = image_data + clipping_y * Screen_WIDTH + clipping_x;
+	int n = 0;
+	int last_colour = -1;
+	int x;
+	int y;
+
+	switch (windowsize) {
+	case Small:
+		for (y = 0; y < clipping_height; y++) {
+			for (x = 0; x < clipping_width; x++) {
+				UBYTE colour = *ptr2++;
+				if (colour != *ptr || force_redraw) {
+					*ptr = colour;
+					if (colour != last_colour || n >= NPOINTS) {
+						if (n > 0) {
+							XDrawPoints(display, pixmap, gc_colour[last_colour],
+										points, n, CoordModeOrigin);
+							n = 0;
+							modified = TRUE;
 						}
-						points[n].x = x;
-						points[n].y = y;
-						n++;
+						last_colour = colour;
 					}
-					ptr++;
+					points[n].x = x;
+					points[n].y = y;
+					n++;
 				}
-				ptr += Screen_WIDTH - clipping_width;
-				ptr2 += Screen_WIDTH - clipping_width;
-			}
-			if (n > 0) {
-				XDrawPoints(display, pixmap, gc_colour[last_colour],
-							points, n, CoordModeOrigin);
-				modified = TRUE;
+				ptr++;
 			}
-			break;
-		case Large:
-			for (y = 0; y < window_height; y += 2) {
-				for (x = 0; x < window_width; ) {
-					UBYTE colour = *ptr2++;
-					if (colour != *ptr || force_redraw) {
-						int width = 2;
-						*ptr++ = colour;
-						if (colour != last_colour || n >= NRECTS) {
-							if (n > 0) {
-								XFillRectangles(display, pixmap, gc_colour[last_colour],
-												rectangles, n);
-								n = 0;
-								modified = TRUE;
-							}
-							last_colour = colour;
-						}
-						rectangles[n].x = x;
-						rectangles[n].y = y;
-						while ((x += 2) < window_width && colour == *ptr2 && colour != *ptr) {
-							width += 2;
-							ptr2++;
-							*ptr++ = colour;
+			ptr += Screen_WIDTH - clipping_width;
+			ptr2 += Screen_WIDTH - clipping_width;
+		}
+		if (n > 0) {
+			XDrawPoints(display, pixmap, gc_colour[last_colour],
+						points, n, CoordModeOrigin);
+			modified = TRUE;
+		}
+		break;
+	case Large:
+		for (y = 0; y < window_height; y += 2) {
+			for (x = 0; x < window_width; ) {
+				UBYTE colour = *ptr2++;
+				if (colour != *ptr || force_redraw) {
+					int width = 2;
+					*ptr++ = colour;
+					if (colour != last_colour || n >= NRECTS) {
+						if (n > 0) {
+							XFillRectangles(display, pixmap, gc_colour[last_colour],
+											rectangles, n);
+							n = 0;
+							modified = TRUE;
 						}
-						rectangles[n].width = width;
-						/* rectangles[n].height = 2; */
-						n++;
-						continue;
+						last_colour = colour;
+					}
+					rectangles[n].x = x;
+					rectangles[n].y = y;
+					while ((x += 2) < window_width && colour == *ptr2 && colour != *ptr) {
+						width += 2;
+						ptr2++;
+						*ptr++ = colour;
 					}
-					ptr++;
-					x += 2;
+					rectangles[n].width = width;
+					/* rectangles[n].height = 2; */
+					n++;
+					continue;
 				}
-				ptr += Screen_WIDTH - clipping_width;
-				ptr2 += Screen_WIDTH - clipping_width;
+				ptr++;
+				x += 2;
 			}
-			if (n > 0) {
-				XFillRectangles(display, pixmap, gc_colour[last_colour],
-								rectangles, n);
-				modified = TRUE;
-			}
-			break;
-		case Huge:
-			for (y = 0; y < window_height; y += 3) {
-				for (x = 0; x < window_width; ) {
-					UBYTE colour = *ptr2++;
-					if (colour != *ptr || force_redraw) {
-						int width = 3;
-						*ptr++ = colour;
-						if (colour != last_colour || n >= NRECTS) {
-							if (n > 0) {
-								XFillRectangles(display, pixmap, gc_colour[last_colour],
-												rectangles, n);
-								n = 0;
-								modified = TRUE;
-							}
-							last_colour = colour;
-						}
-						rectangles[n].x = x;
-						rectangles[n].y = y;
-						while ((x += 3) < window_width && colour == *ptr2 && colour != *ptr) {
-							width += 3;
-							ptr2++;
-							*ptr++ = colour;
+			ptr += Screen_WIDTH - clipping_width;
+			ptr2 += Screen_WIDTH - clipping_width;
+		}
+		if (n > 0) {
+			XFillRectangles(display, pixmap, gc_colour[last_colour],
+							rectangles, n);
+			modified = TRUE;
+		}
+		break;
+	case Huge:
+		for (y = 0; y < window_height; y += 3) {
+			for (x = 0; x < window_width; ) {
+				UBYTE colour = *ptr2++;
+				if (colour != *ptr || force_redraw) {
+					int width = 3;
+					*ptr++ = colour;
+					if (colour != last_colour || n >= NRECTS) {
+						if (n > 0) {
+							XFillRectangles(display, pixmap, gc_colour[last_colour],
+											rectangles, n);
+							n = 0;
+							modified = TRUE;
 						}
-						rectangles[n].width = width;
-						/* rectangles[n].height = 3; */
-						n++;
-						continue;
+						last_colour = colour;
 					}
-					ptr++;
-					x += 3;
+					rectangles[n].x = x;
+					rectangles[n].y = y;
+					while ((x += 3) < window_width && colour == *ptr2 && colour != *ptr) {
+						width += 3;
+						ptr2++;
+						*ptr++ = colour;
+					}
+					rectangles[n].width = width;
+					/* rectangles[n].height = 3; */
+					n++;
+					continue;
 				}
-				ptr2 += Screen_WIDTH - clipping_width;
-				ptr += Screen_WIDTH - clipping_width;
+				ptr++;
+				x += 3;
 			}
-			if (n > 0) {
-				XFillRectangles(display, pixmap, gc_colour[last_colour],
-								rectangles, n);
-				modified = TRUE;
-			}
-			break;
+			ptr2 += Screen_WIDTH - clipping_width;
+			ptr += Screen_WIDTH - clipping_width;
 		}
-
-		if (modified) {
-			XCopyArea(display, pixmap, window, gc, 0, 0,
-					  window_width, window_height, 0, 0);
-			XSync(display, FALSE);
-			modified = FALSE;
+		if (n > 0) {
+			XFillRectangles(display, pixmap, gc_colour[last_colour],
+							rectangles, n);
+			modified = TRUE;
 		}
+		break;
+	}
 
-#endif /* SHM */
+	if (modified) {
+		XCopyArea(display, pixmap, window, gc, 0, 0,
+				  window_width, window_height, 0, 0);
+		XSync(display, FALSE);
+		modified = FALSE;
+	}
+}
+
+void PLATFORM_DisplayScreen(void)
+{
+	static char status_line[64];
+	int update_status_line = FALSE;
 
+	if (!invisible) {
+		const UBYTE *ptr2 = (const UBYTE *) Screen_atari + clipping_y * Screen_WIDTH + clipping_x;
+
+		if (image != NULL)
+			DisplayImage(ptr2);
+		else
+			DisplayPixmap(ptr2);
 	}
 
 	switch (x11_monitor) {
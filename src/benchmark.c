@@ -0,0 +1,1132 @@
+/*
+ * benchmark.c - Built-in emulation benchmark
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+/* Each workload but "boot" starts from a cold boot, lets the OS come up
+   and then takes the machine over with a program put in RAM: interrupts
+   off, a display list of its own and a loop that keeps the part of the
+   machine the workload is about busy. The frames are run unthrottled and
+   drawn in full, as with a display, but nothing is shown; the POKEY sound
+   is synthesised into a buffer that is thrown away.
+
+   The kernels of -benchmark-kernels are timed further down. */
+
+#include "config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "antic.h"
+#include "atari.h"
+#include "ai_interface.h"
+#include "benchmark.h"
+#include "binload.h"
+#include "cartridge.h"
+#include "cassette.h"
+#include "cpu.h"
+#include "esc.h"
+#include "gtia.h"
+#include "log.h"
+#include "memory.h"
+#include "pokey.h"
+#include "screen.h"
+#include "sio.h"
+#include "statesav.h"
+#include "util.h"
+#ifdef SOUND
+#include "pokeysnd.h"
+#include "sound.h"
+#endif
+#ifdef NTSC_FILTER
+#include "filter_ntsc.h"
+#endif
+#ifdef PAL_BLENDING
+#include "pal_blending.h"
+#endif
+#ifdef VIDEO_CODEC_ZMBV
+#include "codecs/video_zmbv.h"
+#endif
+
+#define DEFAULT_FRAMES 1000
+#define BOOT_FRAMES    60   /* for the OS to come up before a take-over */
+#define WARMUP_FRAMES  10
+
+/* Where the take-over programs live */
+#define DLIST_ADDR  0x2000
+#define DLI_ADDR    0x2100
+#define CODE_ADDR   0x2200
+#define PMG_PAGE    0x30    /* PMBASE: single line players at $3400 */
+#define TEXT_ADDR   0x4000
+#define BITMAP_ADDR 0x6000  /* two 4K halves, as ANTIC cannot cross 4K */
+
+#define ANTIC_REG(r) (0xd400 + ANTIC_OFFSET_##r)
+#define GTIA_REG(r)  (0xd000 + GTIA_OFFSET_##r)
+#define POKEY_REG(r) (0xd200 + POKEY_OFFSET_##r)
+#define POKEY2_REG(r) (0xd210 + POKEY_OFFSET_##r)
+#define VDSLST 0x0200
+
+int BENCHMARK_enabled = FALSE;
+
+static int frames = DEFAULT_FRAMES;
+static int time_kernels = FALSE;
+static char only[256] = "";  /* comma-separated names to run, "" = all */
+static char output_file[FILENAME_MAX] = "";
+
+typedef struct {
+	const char *name;
+	int (*setup)(void);  /* FALSE skips the workload */
+	int warmup;          /* frames run after setup and before timing */
+} Workload;
+
+static int setup_boot(void);
+static int setup_text(void);
+static int setup_gtia9(void);
+static int setup_gtia10(void);
+static int setup_gtia11(void);
+static int setup_pmg(void);
+static int setup_dli(void);
+static int setup_cart(void);
+static int setup_sound(void);
+static int setup_sio(void);
+
+static const Workload workloads[] = {
+	{ "boot", setup_boot, 0 },
+	{ "text", setup_text, WARMUP_FRAMES },
+	{ "gtia9", setup_gtia9, WARMUP_FRAMES },
+	{ "gtia10", setup_gtia10, WARMUP_FRAMES },
+	{ "gtia11", setup_gtia11, WARMUP_FRAMES },
+	{ "pmg", setup_pmg, WARMUP_FRAMES },
+	{ "dli", setup_dli, WARMUP_FRAMES },
+	{ "cart", setup_cart, WARMUP_FRAMES },
+	{ "sound", setup_sound, WARMUP_FRAMES },
+	{ "sio", setup_sio, 0 }
+};
+#define N_WORKLOADS ((int) (sizeof(workloads) / sizeof(workloads[0])))
+
+static int kernel_named(const char *name, size_t len);
+
+/* Temporary cartridge or disk image of the running workload */
+static char temp_file[FILENAME_MAX] = "";
+
+#ifdef SOUND
+static SWORD *sound_buffer = NULL;
+static int sound_samples;
+#endif
+
+/* Do the len characters at item name name: all of it, or its start up to
+   an underscore, as "antic" names all the antic_* kernels? */
+static int names(const char *item, size_t len, const char *name)
+{
+	return strncmp(item, name, len) == 0 && (name[len] == '\0' || name[len] == '_');
+}
+
+static int selected(const char *name)
+{
+	const char *p = only;
+
+	if (only[0] == '\0')
+		return TRUE;
+	while (*p != '\0') {
+		const char *end = strchr(p, ',');
+		if (end == NULL)
+			end = p + strlen(p);
+		if (end > p && names(p, end - p, name))
+			return TRUE;
+		p = *end == ',' ? end + 1 : end;
+	}
+	return FALSE;
+}
+
+/* Checks that every name in list is a workload or names kernels */
+static int valid_list(const char *list)
+{
+	const char *p = list;
+
+	while (*p != '\0') {
+		const char *end = strchr(p, ',');
+		int i;
+		if (end == NULL)
+			end = p + strlen(p);
+		for (i = 0; i < N_WORKLOADS; i++) {
+			if (strlen(workloads[i].name) == (size_t) (end - p)
+			    && strncmp(p, workloads[i].name, end - p) == 0)
+				break;
+		}
+		if (i == N_WORKLOADS && (end == p || !kernel_named(p, end - p)))
+			return FALSE;
+		p = *end == ',' ? end + 1 : end;
+	}
+	return list[0] != '\0';
+}
+
+int BENCHMARK_Initialise(int *argc, char *argv[])
+{
+	int i;
+	int j;
+
+	for (i = j = 1; i < *argc; i++) {
+		int i_a = (i + 1 < *argc);		/* is argument available? */
+		int a_m = FALSE;			/* error, argument missing! */
+		int a_i = FALSE;			/* error, argument invalid! */
+
+		if (strcmp(argv[i], "-benchmark") == 0)
+			BENCHMARK_enabled = TRUE;
+		else if (strcmp(argv[i], "-benchmark-kernels") == 0)
+			BENCHMARK_enabled = time_kernels = TRUE;
+		else if (strcmp(argv[i], "-benchmark-frames") == 0) {
+			if (i_a) {
+				frames = Util_sscandec(argv[++i]);
+				if (frames < 1)
+					a_i = TRUE;
+			}
+			else a_m = TRUE;
+		}
+		else if (strcmp(argv[i], "-benchmark-only") == 0) {
+			if (i_a) {
+				Util_strlcpy(only, argv[++i], sizeof(only));
+				if (!valid_list(only))
+					a_i = TRUE;
+			}
+			else a_m = TRUE;
+		}
+		else if (strcmp(argv[i], "-benchmark-output") == 0) {
+			if (i_a)
+				Util_strlcpy(output_file, argv[++i], sizeof(output_file));
+			else a_m = TRUE;
+		}
+		else {
+			if (strcmp(argv[i], "-help") == 0) {
+				Log_print("\t-benchmark       Run the built-in benchmark workloads, print a JSON");
+				Log_print("\t                 report and exit");
+				Log_print("\t-benchmark-kernels  Time the drawing, filter, codec, sound and state");
+				Log_print("\t                 saving routines on their own instead of workloads");
+				Log_print("\t-benchmark-frames <n>  Frames timed per workload (default %d)", DEFAULT_FRAMES);
+				Log_print("\t-benchmark-only <list> Run only the comma-separated workloads: boot,");
+				Log_print("\t                 text, gtia9, gtia10, gtia11, pmg, dli, cart, sound, sio");
+				Log_print("\t                 or kernels, such as antic, zmbv or antic_f_pmg");
+				Log_print("\t-benchmark-output <file>  Write the report to file, not standard output");
+			}
+			argv[j++] = argv[i];
+		}
+
+		if (a_m) {
+			Log_print("Missing argument for '%s'", argv[i]);
+			return FALSE;
+		}
+		else if (a_i) {
+			Log_print("Invalid argument for '%s'", argv[--i]);
+			return FALSE;
+		}
+	}
+	*argc = j;
+
+	return TRUE;
+}
+
+/* Runs one frame, synthesising its sound as a sound card would pull it */
+static void run_frame(void)
+{
+	Atari800_Frame();
+#ifdef SOUND
+	POKEYSND_Process(sound_buffer, sound_samples);
+	AI_TIME_STAGE(AI_TIME_SOUND);
+#endif
+}
+
+static void run_frames(int n)
+{
+	while (n-- > 0)
+		run_frame();
+}
+
+/* 6502 code of the take-over program being built, which goes at CODE_ADDR */
+static UBYTE code[256];
+static int code_len;
+
+static void op(int byte)
+{
+	code[code_len++] = (UBYTE) byte;
+}
+
+static void op_abs(int opcode, int addr)
+{
+	op(opcode);
+	op(addr & 0xff);
+	op(addr >> 8);
+}
+
+/* LDA #value; STA addr */
+static void store(int addr, int value)
+{
+	op(0xa9);
+	op(value);
+	op_abs(0x8d, addr);
+}
+
+static UWORD here(void)
+{
+	return (UWORD) (CODE_ADDR + code_len);
+}
+
+/* A display list of 24 lines of ANTIC mode 2 from TEXT_ADDR or 192 lines
+   of mode F from BITMAP_ADDR, with a DLI on every line if dli is set */
+static void put_display_list(int mode, int dli)
+{
+	UBYTE dl[256];
+	int len = 0;
+	int lines = mode == 2 ? 24 : 192;
+	int i;
+
+	dl[len++] = 0x70;
+	dl[len++] = 0x70;
+	dl[len++] = 0x70;
+	for (i = 0; i < lines; i++) {
+		int instr = mode | (dli ? 0x80 : 0);
+		if (i == 0 || i == 96) {
+			int addr = mode == 2 ? TEXT_ADDR : BITMAP_ADDR + (i == 0 ? 0 : 0x1000);
+			dl[len++] = (UBYTE) (instr | 0x40);
+			dl[len++] = (UBYTE) (addr & 0xff);
+			dl[len++] = (UBYTE) (addr >> 8);
+		}
+		else
+			dl[len++] = (UBYTE) instr;
+	}
+	dl[len++] = 0x41;
+	dl[len++] = DLIST_ADDR & 0xff;
+	dl[len++] = DLIST_ADDR >> 8;
+	MEMORY_CopyToMem(dl, DLIST_ADDR, len);
+}
+
+/* Cold boots, then writes the screens, the display list and the start of a
+   program that takes over the hardware. The caller adds the loop and calls
+   start_program(). */
+static void begin_program(int mode, int dli, int dmactl, int prior)
+{
+	int i;
+
+	Atari800_Coldstart();
+	run_frames(BOOT_FRAMES);
+
+	for (i = 0; i < 0x400; i++)
+		MEMORY_dPutByte(TEXT_ADDR + i, (UBYTE) (i % 96 + 0x21));
+	for (i = 0; i < 0x2000; i++)
+		MEMORY_dPutByte(BITMAP_ADDR + i, (UBYTE) ((i * 7) ^ (i >> 7)));
+	put_display_list(mode, dli);
+
+	code_len = 0;
+	op(0x78);                               /* SEI */
+	op(0xd8);                               /* CLD */
+	store(ANTIC_REG(NMIEN), 0x00);
+	store(ANTIC_REG(DLISTL), DLIST_ADDR & 0xff);
+	store(ANTIC_REG(DLISTH), DLIST_ADDR >> 8);
+	store(ANTIC_REG(DMACTL), dmactl);
+	store(ANTIC_REG(CHBASE), 0xe0);
+	store(ANTIC_REG(CHACTL), 0x02);
+	store(GTIA_REG(PRIOR), prior);
+	store(GTIA_REG(GRACTL), 0x00);
+	store(GTIA_REG(COLPF0), 0x46);
+	store(GTIA_REG(COLPF1), 0x0c);
+	store(GTIA_REG(COLPF2), 0x94);
+	store(GTIA_REG(COLPF3), 0xd8);
+	store(GTIA_REG(COLBK), 0x00);
+	store(ANTIC_REG(NMIEN), dli ? 0x80 : 0x00);
+}
+
+static int start_program(void)
+{
+	MEMORY_CopyToMem(code, CODE_ADDR, code_len);
+	CPU_regPC = CODE_ADDR;
+	return TRUE;
+}
+
+/* Loop inverting the screen bytes in pages first_page to end_page - 1 */
+static void emit_screen_loop(int first_page, int end_page)
+{
+	UWORD loop = here();
+
+	op_abs(0xbd, first_page << 8);          /* loop: LDA page,X */
+	op(0x49);                               /*       EOR #$FF */
+	op(0xff);
+	op_abs(0x9d, first_page << 8);          /*       STA page,X */
+	op(0xe8);                               /*       INX */
+	op(0xd0);                               /*       BNE loop */
+	op(0xf5);
+	op_abs(0xee, loop + 2);                 /*       INC loop+2 */
+	op_abs(0xee, loop + 7);                 /*       INC loop+7 */
+	op_abs(0xad, loop + 2);                 /*       LDA loop+2 */
+	op(0xc9);                               /*       CMP #end_page */
+	op(end_page);
+	op(0xd0);                               /*       BNE next */
+	op(0x08);
+	op(0xa9);                               /*       LDA #first_page */
+	op(first_page);
+	op_abs(0x8d, loop + 2);                 /*       STA loop+2 */
+	op_abs(0x8d, loop + 7);                 /*       STA loop+7 */
+	op_abs(0x4c, loop);                     /* next: JMP loop */
+}
+
+static int setup_boot(void)
+{
+	/* The machine as the command line left it */
+	return TRUE;
+}
+
+static int setup_text(void)
+{
+	begin_program(0x02, FALSE, 0x22, 0x00);
+	emit_screen_loop(TEXT_ADDR >> 8, (TEXT_ADDR >> 8) + 4);
+	return start_program();
+}
+
+static int setup_gtia(int prior)
+{
+	begin_program(0x0f, FALSE, 0x22, prior);
+	emit_screen_loop(BITMAP_ADDR >> 8, (BITMAP_ADDR >> 8) + 0x20);
+	return start_program();
+}
+
+static int setup_gtia9(void)
+{
+	return setup_gtia(0x40);
+}
+
+static int setup_gtia10(void)
+{
+	return setup_gtia(0x80);
+}
+
+static int setup_gtia11(void)
+{
+	return setup_gtia(0xc0);
+}
+
+/* Four players and four missiles, all in colour, moved on every scanline
+   over a mode F screen */
+static int setup_pmg(void)
+{
+	UWORD loop;
+	int i;
+
+	begin_program(0x0f, FALSE, 0x3e, 0x01);
+	for (i = 0; i < 0x500; i++)
+		MEMORY_dPutByte((PMG_PAGE << 8) + 0x300 + i, (UBYTE) (0x81 | (i * 0x1d)));
+	store(ANTIC_REG(PMBASE), PMG_PAGE);
+	store(GTIA_REG(GRACTL), 0x03);
+	store(GTIA_REG(SIZEP0), 0x01);
+	store(GTIA_REG(SIZEP1), 0x03);
+	store(GTIA_REG(SIZEM), 0x55);
+	store(GTIA_REG(COLPM0), 0x28);
+	store(GTIA_REG(COLPM1), 0x58);
+	store(GTIA_REG(COLPM2), 0x88);
+	store(GTIA_REG(COLPM3), 0xb8);
+	loop = here();
+	op_abs(0xad, ANTIC_REG(VCOUNT));        /* loop: LDA VCOUNT */
+	op_abs(0x8d, ANTIC_REG(WSYNC));         /*       STA WSYNC */
+	op_abs(0x8d, GTIA_REG(HPOSP0));         /*       STA HPOSP0 */
+	op_abs(0x8d, GTIA_REG(HITCLR));         /*       STA HITCLR */
+	op(0x49);                               /*       EOR #$FF */
+	op(0xff);
+	op_abs(0x8d, GTIA_REG(HPOSP1));         /*       STA HPOSP1 */
+	op_abs(0x8d, GTIA_REG(HPOSM2));         /*       STA HPOSM2 */
+	op(0x0a);                               /*       ASL A */
+	op_abs(0x8d, GTIA_REG(HPOSP2));         /*       STA HPOSP2 */
+	op_abs(0x8d, GTIA_REG(HPOSM1));         /*       STA HPOSM1 */
+	op(0x4a);                               /*       LSR A */
+	op(0x4a);                               /*       LSR A */
+	op_abs(0x8d, GTIA_REG(HPOSP3));         /*       STA HPOSP3 */
+	op_abs(0x8d, GTIA_REG(HPOSM0));         /*       STA HPOSM0 */
+	op_abs(0x8d, GTIA_REG(HPOSM3));         /*       STA HPOSM3 */
+	op_abs(0x4c, loop);                     /*       JMP loop */
+	return start_program();
+}
+
+/* A DLI on each of 192 mode F lines that changes three colours */
+static int setup_dli(void)
+{
+	static const UBYTE dli[] = {
+		0x48,                   /* PHA */
+		0xad, 0x0b, 0xd4,       /* LDA VCOUNT */
+		0x8d, 0x0a, 0xd4,       /* STA WSYNC */
+		0x8d, 0x1a, 0xd0,       /* STA COLBK */
+		0x8d, 0x18, 0xd0,       /* STA COLPF2 */
+		0x0a,                   /* ASL A */
+		0x8d, 0x16, 0xd0,       /* STA COLPF0 */
+		0x68,                   /* PLA */
+		0x40                    /* RTI */
+	};
+
+	begin_program(0x0f, TRUE, 0x22, 0x00);
+	MEMORY_CopyToMem(dli, DLI_ADDR, sizeof(dli));
+	MEMORY_dPutByte(VDSLST, DLI_ADDR & 0xff);
+	MEMORY_dPutByte(VDSLST + 1, DLI_ADDR >> 8);
+	emit_screen_loop(BITMAP_ADDR >> 8, (BITMAP_ADDR >> 8) + 0x20);
+	return start_program();
+}
+
+/* A 32K XEGS cartridge whose bank at $8000 is switched for every byte
+   copied from it to the screen */
+static int setup_cart(void)
+{
+	UBYTE bank[0x2000];
+	FILE *f;
+	UWORD loop;
+	int b;
+	int i;
+
+	f = Util_uniqopen(temp_file, "wb");
+	if (f == NULL)
+		return FALSE;
+	for (b = 0; b < 4; b++) {
+		/* The last bank is fixed at $A000, where $FF at $BFFC tells the
+		   OS there is no cartridge to start */
+		for (i = 0; i < 0x2000; i++)
+			bank[i] = b == 3 ? 0xff : (UBYTE) ((i + b * 32) % 96 + 0x21);
+		fwrite(bank, 1, sizeof(bank), f);
+	}
+	fclose(f);
+	CARTRIDGE_Insert(temp_file);
+	CARTRIDGE_SetType(&CARTRIDGE_main, CARTRIDGE_XEGS_32);
+	if (CARTRIDGE_main.type != CARTRIDGE_XEGS_32)
+		return FALSE;
+
+	begin_program(0x02, FALSE, 0x22, 0x00);
+	loop = here();
+	op_abs(0x8e, 0xd500);                   /* loop: STX $D500 */
+	op_abs(0xbd, 0x8000);                   /*       LDA $8000,X */
+	op_abs(0x9d, TEXT_ADDR);                /*       STA TEXT_ADDR,X */
+	op(0xe8);                               /*       INX */
+	op_abs(0x4c, loop);                     /*       JMP loop */
+	return start_program();
+}
+
+/* Both POKEYs playing pure and distorted tones that sweep on every
+   scanline */
+static int setup_sound(void)
+{
+	static const UBYTE audc[8] = {
+		0xaa, 0xa6, 0xc8, 0x24, 0xa8, 0xac, 0x86, 0xc4
+	};
+#ifdef SOUND
+	UWORD loop;
+	int i;
+
+	begin_program(0x02, FALSE, 0x22, 0x00);
+	store(POKEY_REG(SKCTL), 0x03);
+	store(POKEY2_REG(SKCTL), 0x03);
+	store(POKEY_REG(AUDCTL), 0x00);
+	store(POKEY2_REG(AUDCTL), 0x01);
+	for (i = 0; i < 4; i++) {
+		store(POKEY_REG(AUDC1) + 2 * i, audc[i]);
+		store(POKEY2_REG(AUDC1) + 2 * i, audc[4 + i]);
+	}
+	loop = here();
+	op(0xe8);                               /* loop: INX */
+	op_abs(0x8e, POKEY_REG(AUDF1));         /*       STX AUDF1 */
+	op_abs(0x8e, POKEY2_REG(AUDF3));        /*       STX AUDF3+$10 */
+	op(0x8a);                               /*       TXA */
+	op(0x4a);                               /*       LSR A */
+	op_abs(0x8d, POKEY_REG(AUDF2));         /*       STA AUDF2 */
+	op_abs(0x8d, POKEY2_REG(AUDF1));        /*       STA AUDF1+$10 */
+	op(0x4a);                               /*       LSR A */
+	op_abs(0x8d, POKEY_REG(AUDF3));         /*       STA AUDF3 */
+	op_abs(0x8d, POKEY_REG(AUDF4));         /*       STA AUDF4 */
+	op_abs(0x8d, POKEY2_REG(AUDF2));        /*       STA AUDF2+$10 */
+	op_abs(0x8d, POKEY2_REG(AUDF4));        /*       STA AUDF4+$10 */
+	op_abs(0x8d, ANTIC_REG(WSYNC));         /*       STA WSYNC */
+	op_abs(0x4c, loop);                     /*       JMP loop */
+	return start_program();
+#else
+	/* Nothing synthesises the sound */
+	return FALSE;
+#endif
+}
+
+/* A disk whose boot sector asks the OS to load 255 sectors, read without
+   the SIO patch, timed from the cold boot */
+static int setup_sio(void)
+{
+	UBYTE header[16];
+	UBYTE sector[128];
+	FILE *f;
+	int s;
+	int i;
+
+	f = Util_uniqopen(temp_file, "wb");
+	if (f == NULL)
+		return FALSE;
+	memset(header, 0, sizeof(header));
+	header[0] = 0x96;
+	header[1] = 0x02;
+	header[2] = (720 * 128 / 16) & 0xff;
+	header[3] = (720 * 128 / 16) >> 8;
+	header[4] = 128;
+	fwrite(header, 1, sizeof(header), f);
+	for (s = 1; s <= 720; s++) {
+		for (i = 0; i < 128; i++)
+			sector[i] = (UBYTE) (s + i);
+		if (s == 1) {
+			static const UBYTE boot[] = {
+				0x00, 0xff,             /* 255 sectors */
+				0x00, 0x20,             /* to $2000 */
+				0x08, 0x20,             /* DOSINI: the RTS at $2008 */
+				0x18, 0x60,             /* CLC; RTS */
+				0x60                    /* RTS */
+			};
+			memcpy(sector, boot, sizeof(boot));
+		}
+		fwrite(sector, 1, sizeof(sector), f);
+	}
+	fclose(f);
+	if (!SIO_Mount(1, temp_file, TRUE))
+		return FALSE;
+	ESC_enable_sio_patch = FALSE;
+	ESC_UpdatePatches();
+	Atari800_Coldstart();
+	return TRUE;
+}
+
+/* Takes out what the command line put in the machine, so the built-in
+   workloads run the same whatever was given */
+static void clear_media(void)
+{
+	int i;
+
+	if (BINLOAD_bin_file != NULL) {
+		fclose(BINLOAD_bin_file);
+		BINLOAD_bin_file = NULL;
+	}
+	BINLOAD_start_binloading = FALSE;
+	for (i = 1; i <= SIO_MAX_DRIVES; i++)
+		SIO_Dismount(i);
+	CARTRIDGE_Remove();
+	CASSETTE_Remove();
+}
+
+static void remove_temp_file(void)
+{
+	if (temp_file[0] == '\0')
+		return;
+	SIO_Dismount(1);
+	CARTRIDGE_Remove();
+#ifdef HAVE_UTIL_UNLINK
+	Util_unlink(temp_file);
+#endif
+	temp_file[0] = '\0';
+}
+
+static int compare_times(const void *a, const void *b)
+{
+	double x = *(const double *) a;
+	double y = *(const double *) b;
+	return x < y ? -1 : x > y;
+}
+
+/* Nanoseconds of the frame at fraction p of the sorted times */
+static double percentile(const double *sorted, int n, double p)
+{
+	return sorted[(int) ((n - 1) * p + 0.5)] * 1e9;
+}
+
+static void report(FILE *out, const char *name, double *times, double total,
+                   const double *stages)
+{
+	double fps = total > 0 ? frames / total : 0.0;
+	double real_fps = Atari800_tv_mode == Atari800_TV_PAL ? Atari800_FPS_PAL : Atari800_FPS_NTSC;
+	int i;
+
+	qsort(times, frames, sizeof(double), compare_times);
+	fprintf(out, "    {\"name\": \"%s\", \"frames\": %d, \"seconds\": %.6f, \"fps\": %.1f, \"speed\": %.2f,\n",
+	        name, frames, total, fps, fps / real_fps);
+	fprintf(out, "     \"ns_per_frame\": {\"mean\": %.0f, \"p50\": %.0f, \"p90\": %.0f, \"p99\": %.0f, \"max\": %.0f},\n",
+	        total * 1e9 / frames, percentile(times, frames, 0.5), percentile(times, frames, 0.9),
+	        percentile(times, frames, 0.99), times[frames - 1] * 1e9);
+	fprintf(out, "     \"stage_ns_per_frame\": {");
+	for (i = 0; i < AI_TIME_STAGES; i++)
+		fprintf(out, "%s\"%s\": %.0f", i ? ", " : "", AI_time_stage_names[i], stages[i] * 1e9 / frames);
+	fprintf(out, "}}");
+}
+
+static void run_workloads(FILE *out)
+{
+	double *times = (double *) Util_malloc(frames * sizeof(double));
+	int first = TRUE;
+	int cleared = FALSE;
+	int w;
+
+	fprintf(out, "{\"tv\": \"%s\", \"frames\": %d, \"frame_timing\": %s, \"workloads\": [\n",
+	        Atari800_tv_mode == Atari800_TV_PAL ? "PAL" : "NTSC", frames,
+	        AI_frame_timing ? "true" : "false");
+	for (w = 0; w < N_WORKLOADS; w++) {
+		const Workload *wl = &workloads[w];
+		double start;
+		double stage_time[AI_TIME_STAGES];
+		int i;
+
+		if (!selected(wl->name))
+			continue;
+		if (w > 0) {
+			/* The take-over programs need the computer's OS */
+			if (Atari800_machine_type == Atari800_MACHINE_5200)
+				break;
+			if (!cleared)
+				clear_media();
+			cleared = TRUE;
+		}
+		if (!wl->setup()) {
+			remove_temp_file();
+			continue;
+		}
+		run_frames(wl->warmup);
+
+		AI_TimeReset();
+		AI_timing = TRUE;
+		start = Util_time();
+		for (i = 0; i < frames; i++) {
+			double t = Util_time();
+			run_frame();
+			times[i] = Util_time() - t;
+		}
+		start = Util_time() - start;
+		AI_timing = AI_frame_timing;
+		for (i = 0; i < AI_TIME_STAGES; i++)
+			stage_time[i] = AI_TimeCharged(i);
+		remove_temp_file();
+
+		if (!first)
+			fprintf(out, ",\n");
+		first = FALSE;
+		report(out, wl->name, times, start, stage_time);
+	}
+	fprintf(out, "\n]}\n");
+	free(times);
+}
+
+/* Kernels ----------------------------------------------------------------- */
+
+/* With -benchmark-kernels the routines the frames spend their time in are
+   timed one by one, outside the emulation, on the screen, registers and
+   buffers a kernel's setup leaves. Each runs once to warm the caches, then
+   in KERNEL_BATCHES batches of as many calls as take KERNEL_BATCH_TIME. */
+
+#define KERNEL_BATCHES    7
+#define KERNEL_BATCH_TIME 0.02
+
+typedef struct {
+	const char *name;
+	const char *unit;    /* what the times are per */
+	int units;           /* of them in one call of run */
+	int (*setup)(int arg);  /* FALSE skips the kernel */
+	void (*run)(int arg);
+	void (*end)(void);   /* NULL if nothing to undo */
+	int arg;
+} Kernel;
+
+/* Screen memory of a mode line, and two frames in a row of the text
+   workload for the kernels that work on whole screens */
+static UBYTE line_data[48];
+static UBYTE *frames_run[2];
+/* Where the kernels write what they make */
+static UBYTE *kernel_buffer = NULL;
+static int kernel_buffer_size;
+
+#define KERNEL_PMG  0x100  /* antic_* arg: with players and missiles */
+
+static void put_players(int on)
+{
+	int i;
+
+	GTIA_PutByte(GTIA_OFFSET_GRACTL, 0x00);
+	for (i = 0; i < 4; i++) {
+		GTIA_PutByte(GTIA_OFFSET_HPOSP0 + i, on ? 0x40 + 0x18 * i : 0);
+		GTIA_PutByte(GTIA_OFFSET_HPOSM0 + i, on ? 0x38 + 0x20 * i : 0);
+		GTIA_PutByte(GTIA_OFFSET_GRAFP0 + i, on ? 0x81 | (0x3c >> i) : 0);
+		GTIA_PutByte(GTIA_OFFSET_COLPM0 + i, 0x28 + 0x30 * i);
+	}
+	GTIA_PutByte(GTIA_OFFSET_SIZEP0, 0x01);
+	GTIA_PutByte(GTIA_OFFSET_SIZEP1, 0x03);
+	GTIA_PutByte(GTIA_OFFSET_SIZEM, 0x55);
+	GTIA_PutByte(GTIA_OFFSET_GRAFM, on ? 0xe4 : 0);
+	GTIA_NewPmScanline();
+}
+
+#if !defined(BASIC) && !defined(CURSES_BASIC)
+
+static int setup_antic(int arg)
+{
+	int i;
+
+	for (i = 0; i < (int) sizeof(line_data); i++)
+		line_data[i] = (UBYTE) ((i * 0x35) ^ 0x5a);
+	GTIA_PutByte(GTIA_OFFSET_PRIOR, (UBYTE) (((arg >> 4) & 3) << 6 | 0x01));
+	put_players(arg & KERNEL_PMG);
+	return TRUE;
+}
+
+static void run_antic(int arg)
+{
+	ANTIC_DrawModeLines(arg & 0xf, (arg >> 4) & 3, line_data, Screen_HEIGHT);
+}
+
+static void end_antic(void)
+{
+	put_players(FALSE);
+	GTIA_PutByte(GTIA_OFFSET_PRIOR, 0x00);
+}
+
+#endif /* !defined(BASIC) && !defined(CURSES_BASIC) */
+
+static int setup_pm(int arg)
+{
+	put_players(TRUE);
+	return TRUE;
+}
+
+static void run_pm(int arg)
+{
+	int i;
+
+	for (i = 0; i < Screen_HEIGHT; i++)
+		GTIA_NewPmScanline();
+}
+
+static void end_pm(void)
+{
+	put_players(FALSE);
+}
+
+#define VISIBLE_WIDTH  (Screen_visible_x2 - Screen_visible_x1)
+#define VISIBLE_HEIGHT (Screen_visible_y2 - Screen_visible_y1)
+#define VISIBLE_SCREEN ((UBYTE *) Screen_atari + Screen_visible_y1 * Screen_WIDTH + Screen_visible_x1)
+
+static int setup_screen(int arg)
+{
+	memcpy(Screen_atari, frames_run[1], Screen_WIDTH * Screen_HEIGHT);
+	ANTIC_InvalidateScanlineCache();
+	return TRUE;
+}
+
+#ifdef NTSC_FILTER
+
+static atari_ntsc_t *ntsc = NULL;
+
+static int setup_ntsc(int arg)
+{
+	setup_screen(arg);
+	if (ntsc == NULL) {
+		ntsc = FILTER_NTSC_New();
+		FILTER_NTSC_Update(ntsc);
+	}
+	return TRUE;
+}
+
+/* The blitters a single thread of FILTER_NTSC_Blit runs */
+static void run_ntsc(int arg)
+{
+	long pitch = ATARI_NTSC_OUT_WIDTH(VISIBLE_WIDTH) * (arg == 32 ? 4 : 2);
+
+	if (arg == 32)
+		atari_ntsc_blit_argb32(ntsc, VISIBLE_SCREEN, Screen_WIDTH, VISIBLE_WIDTH, VISIBLE_HEIGHT, kernel_buffer, pitch);
+	else
+		atari_ntsc_blit_rgb16(ntsc, VISIBLE_SCREEN, Screen_WIDTH, VISIBLE_WIDTH, VISIBLE_HEIGHT, kernel_buffer, pitch);
+}
+
+#endif /* NTSC_FILTER */
+
+#ifdef PAL_BLENDING
+
+static int setup_pal_blending(int arg)
+{
+	PAL_BLENDING_UpdateLookup();
+	return setup_screen(arg);
+}
+
+static void run_pal_blending(int arg)
+{
+	if (arg == 32)
+		PAL_BLENDING_Blit32((ULONG *) kernel_buffer, VISIBLE_SCREEN, VISIBLE_WIDTH, VISIBLE_WIDTH, VISIBLE_HEIGHT, 0);
+	else
+		PAL_BLENDING_Blit16((ULONG *) kernel_buffer, VISIBLE_SCREEN, VISIBLE_WIDTH / 2, VISIBLE_WIDTH, VISIBLE_HEIGHT, 0);
+}
+
+#endif /* PAL_BLENDING */
+
+#ifdef VIDEO_CODEC_ZMBV
+
+static int zmbv_threads;
+static int zmbv_frame;
+
+/* ZMBV_CreateFrame, through the codec, on one thread */
+static int setup_zmbv(int arg)
+{
+	int size;
+
+	zmbv_threads = ZMBV_threads;
+	ZMBV_threads = 1;
+	size = Video_Codec_ZMBV.init(VISIBLE_WIDTH, VISIBLE_HEIGHT, Screen_visible_x1, Screen_visible_y1);
+	if (size < 0 || size > kernel_buffer_size) {
+		ZMBV_threads = zmbv_threads;
+		return FALSE;
+	}
+	zmbv_frame = 0;
+	return TRUE;
+}
+
+/* Interframes go back and forth between the two frames */
+static void run_zmbv(int arg)
+{
+	UBYTE *source = frames_run[zmbv_frame & 1];
+
+	Video_Codec_ZMBV.frame(source, arg || zmbv_frame == 0, kernel_buffer, kernel_buffer_size);
+	zmbv_frame++;
+}
+
+static void end_zmbv(void)
+{
+	Video_Codec_ZMBV.end();
+	ZMBV_threads = zmbv_threads;
+}
+
+#endif /* VIDEO_CODEC_ZMBV */
+
+static void run_base64(int arg)
+{
+	AI_Base64Encode((UBYTE *) Screen_atari, Screen_WIDTH * Screen_HEIGHT, (char *) kernel_buffer, kernel_buffer_size);
+}
+
+#ifdef SOUND
+
+static int sound_engine;
+static int frame_samples;
+
+/* The sound of a frame from a POKEY playing four tones, with the MZ
+   engine (arg = playback rate) or the original one (-arg) */
+static int setup_pokeysnd(int arg)
+{
+	static const UBYTE regs[][2] = {
+		{ POKEY_OFFSET_AUDCTL, 0x00 },
+		{ POKEY_OFFSET_AUDF1, 0x51 }, { POKEY_OFFSET_AUDC1, 0xa8 },
+		{ POKEY_OFFSET_AUDF2, 0x66 }, { POKEY_OFFSET_AUDC2, 0xa6 },
+		{ POKEY_OFFSET_AUDF3, 0x79 }, { POKEY_OFFSET_AUDC3, 0x24 },
+		{ POKEY_OFFSET_AUDF4, 0x0f }, { POKEY_OFFSET_AUDC4, 0x86 }
+	};
+	int rate = arg < 0 ? -arg : arg;
+	int i;
+
+	sound_engine = POKEYSND_enable_new_pokey;
+	POKEYSND_enable_new_pokey = arg > 0;
+	POKEYSND_Init(POKEYSND_FREQ_17_EXACT, rate, 1, POKEYSND_BIT16);
+	for (i = 0; i < (int) (sizeof(regs) / sizeof(regs[0])); i++)
+		POKEYSND_Update(regs[i][0], regs[i][1], 0, 4);
+	frame_samples = (int) (rate / (Atari800_tv_mode == Atari800_TV_PAL ? Atari800_FPS_PAL : Atari800_FPS_NTSC));
+	return frame_samples * (int) sizeof(SWORD) <= kernel_buffer_size;
+}
+
+static void run_pokeysnd(int arg)
+{
+	POKEYSND_Process(kernel_buffer, frame_samples);
+}
+
+static void end_pokeysnd(void)
+{
+	POKEYSND_enable_new_pokey = sound_engine;
+}
+
+#endif /* SOUND */
+
+static void end_statesav(void);
+
+static int setup_statesav(int arg)
+{
+	FILE *f = Util_uniqopen(temp_file, "wb");
+
+	if (f == NULL)
+		return FALSE;
+	fclose(f);
+	if (!StateSav_SaveAtariState(temp_file, "wb", TRUE)) {
+		end_statesav();
+		return FALSE;
+	}
+	return TRUE;
+}
+
+static void run_statesav(int arg)
+{
+	StateSav_SaveAtariState(temp_file, "wb", TRUE);
+}
+
+static void end_statesav(void)
+{
+#ifdef HAVE_UTIL_UNLINK
+	Util_unlink(temp_file);
+#endif
+	temp_file[0] = '\0';
+}
+
+#define ANTIC_KERNEL(name, mode) \
+	{ name, "line", Screen_HEIGHT, setup_antic, run_antic, end_antic, mode }
+
+static const Kernel kernels[] = {
+#if !defined(BASIC) && !defined(CURSES_BASIC)
+	ANTIC_KERNEL("antic_2", 0x02),
+	ANTIC_KERNEL("antic_4", 0x04),
+	ANTIC_KERNEL("antic_6", 0x06),
+	ANTIC_KERNEL("antic_8", 0x08),
+	ANTIC_KERNEL("antic_9", 0x09),
+	ANTIC_KERNEL("antic_a", 0x0a),
+	ANTIC_KERNEL("antic_c", 0x0c),
+	ANTIC_KERNEL("antic_e", 0x0e),
+	ANTIC_KERNEL("antic_f", 0x0f),
+	ANTIC_KERNEL("antic_e_gtia9", 0x1e),
+	ANTIC_KERNEL("antic_f_gtia9", 0x1f),
+	ANTIC_KERNEL("antic_f_gtia10", 0x2f),
+	ANTIC_KERNEL("antic_f_gtia11", 0x3f),
+	ANTIC_KERNEL("antic_2_pmg", KERNEL_PMG | 0x02),
+	ANTIC_KERNEL("antic_f_pmg", KERNEL_PMG | 0x0f),
+#endif
+	{ "gtia_pm_scanline", "line", Screen_HEIGHT, setup_pm, run_pm, end_pm, 0 },
+#ifdef NTSC_FILTER
+	{ "ntsc_rgb16", "frame", 1, setup_ntsc, run_ntsc, NULL, 16 },
+	{ "ntsc_argb32", "frame", 1, setup_ntsc, run_ntsc, NULL, 32 },
+#endif
+#ifdef PAL_BLENDING
+	{ "pal_blending_16", "frame", 1, setup_pal_blending, run_pal_blending, NULL, 16 },
+	{ "pal_blending_32", "frame", 1, setup_pal_blending, run_pal_blending, NULL, 32 },
+#endif
+#ifdef VIDEO_CODEC_ZMBV
+	{ "zmbv_keyframe", "frame", 1, setup_zmbv, run_zmbv, end_zmbv, TRUE },
+	{ "zmbv_interframe", "frame", 1, setup_zmbv, run_zmbv, end_zmbv, FALSE },
+#endif
+	{ "ai_base64", "frame", 1, setup_screen, run_base64, NULL, 0 },
+#ifdef SOUND
+	{ "pokeysnd_mz_44100", "frame", 1, setup_pokeysnd, run_pokeysnd, end_pokeysnd, 44100 },
+	{ "pokeysnd_mz_48000", "frame", 1, setup_pokeysnd, run_pokeysnd, end_pokeysnd, 48000 },
+	{ "pokeysnd_44100", "frame", 1, setup_pokeysnd, run_pokeysnd, end_pokeysnd, -44100 },
+#endif
+	{ "statesav", "save", 1, setup_statesav, run_statesav, end_statesav, 0 }
+};
+#define N_KERNELS ((int) (sizeof(kernels) / sizeof(kernels[0])))
+
+static void time_kernel(FILE *out, const Kernel *k)
+{
+	double times[KERNEL_BATCHES];
+	double t;
+	int calls = 1;
+	int b;
+	int i;
+
+	k->run(k->arg);
+	for (;;) {
+		t = Util_time();
+		for (i = 0; i < calls; i++)
+			k->run(k->arg);
+		t = Util_time() - t;
+		if (t >= KERNEL_BATCH_TIME || calls >= 0x1000000)
+			break;
+		calls *= t > KERNEL_BATCH_TIME / 16 ? 2 : 16;
+	}
+	for (b = 0; b < KERNEL_BATCHES; b++) {
+		t = Util_time();
+		for (i = 0; i < calls; i++)
+			k->run(k->arg);
+		times[b] = (Util_time() - t) / ((double) calls * k->units);
+	}
+	qsort(times, KERNEL_BATCHES, sizeof(double), compare_times);
+	fprintf(out, "    {\"name\": \"%s\", \"unit\": \"%s\", \"calls\": %d, \"units_per_call\": %d,\n",
+	        k->name, k->unit, calls * KERNEL_BATCHES, k->units);
+	fprintf(out, "     \"ns_per_unit\": {\"min\": %.1f, \"median\": %.1f, \"max\": %.1f}}",
+	        times[0] * 1e9, times[KERNEL_BATCHES / 2] * 1e9, times[KERNEL_BATCHES - 1] * 1e9);
+}
+
+static void run_kernels(FILE *out)
+{
+	int first = TRUE;
+	int k;
+
+	/* The text workload leaves a normal width playfield with the OS font
+	   and colours, and gives two frames that differ as frames do */
+	if (Atari800_machine_type != Atari800_MACHINE_5200) {
+		clear_media();
+		setup_text();
+		run_frames(WARMUP_FRAMES);
+	}
+	else {
+		Atari800_Coldstart();
+		run_frames(BOOT_FRAMES);
+	}
+	for (k = 0; k < 2; k++) {
+		frames_run[k] = (UBYTE *) Util_malloc(Screen_WIDTH * Screen_HEIGHT);
+		run_frame();
+		memcpy(frames_run[k], Screen_atari, Screen_WIDTH * Screen_HEIGHT);
+	}
+	kernel_buffer_size = Screen_WIDTH * Screen_HEIGHT * 8;
+	kernel_buffer = (UBYTE *) Util_malloc(kernel_buffer_size);
+
+	fprintf(out, "{\"tv\": \"%s\", \"kernels\": [\n",
+	        Atari800_tv_mode == Atari800_TV_PAL ? "PAL" : "NTSC");
+	for (k = 0; k < N_KERNELS; k++) {
+		if (!selected(kernels[k].name))
+			continue;
+		if (!kernels[k].setup(kernels[k].arg))
+			continue;
+		if (!first)
+			fprintf(out, ",\n");
+		first = FALSE;
+		time_kernel(out, &kernels[k]);
+		if (kernels[k].end != NULL)
+			kernels[k].end();
+	}
+	fprintf(out, "\n]}\n");
+
+	free(kernel_buffer);
+	free(frames_run[0]);
+	free(frames_run[1]);
+}
+
+static int kernel_named(const char *name, size_t len)
+{
+	int k;
+
+	for (k = 0; k < N_KERNELS; k++) {
+		if (names(name, len, kernels[k].name))
+			return TRUE;
+	}
+	return FALSE;
+}
+
+int BENCHMARK_Run(void)
+{
+	FILE *out = stdout;
+
+	if (output_file[0] != '\0') {
+		out = fopen(output_file, "w");
+		if (out == NULL) {
+			Log_print("Cannot write benchmark report to %s", output_file);
+			return FALSE;
+		}
+	}
+	AI_unthrottled = TRUE;
+	Atari800_refresh_rate = 1;
+#ifdef SOUND
+	/* Synthesise into a buffer of our own, with no audio output */
+	Sound_enabled = FALSE;
+	POKEYSND_stereo_enabled = TRUE;
+	POKEYSND_Init(POKEYSND_FREQ_17_EXACT, 44100, 2, POKEYSND_BIT16);
+	sound_samples = 2 * (int) (44100 / (Atari800_tv_mode == Atari800_TV_PAL ? Atari800_FPS_PAL : Atari800_FPS_NTSC));
+	sound_buffer = (SWORD *) Util_malloc(sound_samples * sizeof(SWORD));
+#endif
+
+	if (time_kernels)
+		run_kernels(out);
+	else
+		run_workloads(out);
+
+#ifdef SOUND
+	free(sound_buffer);
+#endif
+	if (out != stdout)
+		return fclose(out) == 0;
+	return fflush(out) == 0;
+}
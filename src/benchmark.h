@@ -0,0 +1,32 @@
+/*
+ * benchmark.h - Built-in emulation benchmark
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+#ifndef BENCHMARK_H_
+#define BENCHMARK_H_
+
+/* With -benchmark the emulator runs a fixed set of headless workloads
+   instead of starting up: the machine as the command line set it up, then
+   small programs put in RAM that each keep one part of the emulation busy
+   (text, GTIA modes, player/missile graphics, display list interrupts,
+   bank switching, stereo sound, disk loading). Every frame is timed, and
+   a JSON report with the frame rate, the spread of frame times and the
+   time taken by each stage of the frame is written out.
+
+   With -benchmark-kernels the routines the frames spend most of their time
+   in are timed on their own instead, and the report gives the time per
+   line or frame of each. */
+
+extern int BENCHMARK_enabled;
+
+int BENCHMARK_Initialise(int *argc, char *argv[]);
+
+/* Run the selected workloads on the initialised machine and write the
+   report. Returns FALSE if the report could not be written. The machine
+   is left in no particular state: the caller is expected to exit. */
+int BENCHMARK_Run(void);
+
+#endif /* BENCHMARK_H_ */
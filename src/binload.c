@@ -51,6 +51,8 @@ static UWORD to = 0;
 static int init2e3 = FALSE;
 /* Indicates that we are currently not during loading of a segment. */
 static int segfinished = TRUE;
+/* Loading with BINLOAD_LoaderDirect(), which ignores slow XEX loading. */
+static int direct = FALSE;
 int BINLOAD_pause_loading;
 
 /* Read a word from file */
@@ -110,7 +112,7 @@ static void loader_cont(void)
 		}
 		do {
 			int byte;
-			if (BINLOAD_slow_xex_loading) {
+			if (BINLOAD_slow_xex_loading && !direct) {
 				instr_elapsed++;
 				if ((instr_elapsed < 300) || BINLOAD_pause_loading) {
 					CPU_regS--;
@@ -171,13 +173,13 @@ int BINLOAD_LoaderStart(UBYTE *buffer)
 	BINLOAD_wait_active = FALSE;
 	init2e3 = TRUE;
 	segfinished = TRUE;
+	direct = FALSE;
 	return 'C';
 }
 
-/* Load BIN file, returns TRUE if ok */
-int BINLOAD_Loader(const char *filename)
+/* Open BIN file as BINLOAD_bin_file, returns TRUE if ok */
+static int open_bin_file(const char *filename)
 {
-	UBYTE buf[2];
 	if (BINLOAD_bin_file != NULL) {		/* close previously open file */
 		fclose(BINLOAD_bin_file);
 		BINLOAD_bin_file = NULL;
@@ -195,6 +197,50 @@ int BINLOAD_Loader(const char *filename)
 		Log_print("binload: can't open \"%s\"", filename);
 		return FALSE;
 	}
+	return TRUE;
+}
+
+/* Load BIN file into the running machine without rebooting, returns TRUE
+   if ok. The segments are copied at once and the CPU goes on at INITAD or
+   RUNAD, set up as after the boot sector of BINLOAD_LoaderStart(). */
+int BINLOAD_LoaderDirect(const char *filename)
+{
+	UBYTE buf[6];
+	if (!open_bin_file(filename))
+		return FALSE;
+	/* The header and the addresses of one segment at least */
+	if (fread(buf, 1, 6, BINLOAD_bin_file) != 6 || buf[0] != 0xff || buf[1] != 0xff) {
+		fclose(BINLOAD_bin_file);
+		BINLOAD_bin_file = NULL;
+		Log_print("binload: \"%s\" not recognized as a DOS program", filename);
+		return FALSE;
+	}
+	fseek(BINLOAD_bin_file, 2, SEEK_SET);
+	/* Reset reboots, as does a return from RUNAD (to 0xe477 = Atari OS
+	   Coldstart), and the program gets the whole stack */
+	MEMORY_dPutWordAligned(0x0c, 0xe477);
+	MEMORY_dPutByte(0x01ff, 0xe4);
+	MEMORY_dPutByte(0x01fe, 0x76);
+	CPU_regS = 0xfd;
+	CPU_GetStatus();
+	CPU_ClrD;
+	CPU_ClrI;
+	BINLOAD_start_binloading = TRUE;
+	BINLOAD_wait_active = FALSE;
+	init2e3 = TRUE;
+	segfinished = TRUE;
+	direct = TRUE;
+	loader_cont();
+	CPU_PutStatus();
+	return TRUE;
+}
+
+/* Load BIN file, returns TRUE if ok */
+int BINLOAD_Loader(const char *filename)
+{
+	UBYTE buf[2];
+	if (!open_bin_file(filename))
+		return FALSE;
 	/* Avoid "BOOT ERROR" when loading a BASIC program */
 	if (SIO_drive_status[0] == SIO_NO_DISK)
 		SIO_DisableDrive(1);
@@ -7,6 +7,9 @@
 extern FILE *BINLOAD_bin_file;
 
 int BINLOAD_Loader(const char *filename);
+/* Load a DOS binary into the running machine at once, without the reboot
+   and boot sector BINLOAD_Loader() goes through: the OS must be up. */
+int BINLOAD_LoaderDirect(const char *filename);
 extern int BINLOAD_start_binloading;
 extern int BINLOAD_loading_basic;
 
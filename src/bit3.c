@@ -246,6 +246,32 @@ UBYTE BIT3_GetPixels(int scanline, int column, int *colour, int blink)
 	return font_data;
 }
 
+int BIT3_GetText(TEXT80_Screen *screen)
+{
+	int row, column;
+	int table_start = crtreg[0x0d] + ((crtreg[0x0c]&0x3f)<<8);
+	int cursor_pos = ((crtreg[0x0e]&0x3f)<<8)|crtreg[0x0f];
+
+	screen->card = "bit3";
+	screen->rows = BIT3_ROWS;
+	screen->cursor_x = screen->cursor_y = -1;
+	for (row = 0; row < BIT3_ROWS; row++) {
+		for (column = 0; column < 80; column++) {
+			/* as BIT3_GetPixels finds it */
+			int screen_pos = ((row*80+column + table_start)&0x3fff);
+			UBYTE character = bit3_screen[screen_pos&0x7ff];
+			/* ASCII, the same as ATASCII where it matters */
+			screen->chars[row][column] = character & 0x7f;
+			screen->inverse[row][column] = (character & 0x80) != 0;
+			if (screen_pos == cursor_pos && (crtreg[0x0a]&0x60) != 0x20) {
+				screen->cursor_x = column;
+				screen->cursor_y = row;
+			}
+		}
+	}
+	return TRUE;
+}
+
 void BIT3_Reset(void)
 {
 	memset(bit3_screen, 0, 0x800);
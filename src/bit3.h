@@ -2,6 +2,7 @@
 #define BIT3_H_
 
 #include "atari.h"
+#include "text80.h"
 #include <stdio.h>
 
 extern int BIT3_palette[2];
@@ -15,6 +16,7 @@ void BIT3_D5PutByte(UWORD addr, UBYTE byte);
 int BIT3_D6GetByte(UWORD addr, int no_side_effects);
 void BIT3_D6PutByte(UWORD addr, UBYTE byte);
 UBYTE BIT3_GetPixels(int scanline, int column, int *colour, int blink);
+int BIT3_GetText(TEXT80_Screen *screen);
 extern int BIT3_enabled;
 void BIT3_Reset(void);
 
@@ -26,10 +26,15 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
+#ifdef HAVE_PTHREAD_CREATE
+#include <pthread.h>
+#endif
 
 #include "atari.h"
 #include "binload.h" /* BINLOAD_loading_basic */
 #include "cartridge.h"
+#include "crc32.h"
 #include "memory.h"
 #ifdef IDE
 #  include "ide.h"
@@ -79,8 +84,8 @@ static int CartIsPassthrough(int type)
 	       type == CARTRIDGE_ATRAX_SDX_64 || type == CARTRIDGE_ATRAX_SDX_128;
 }
 
-CARTRIDGE_image_t CARTRIDGE_main = { CARTRIDGE_NONE, 0, 0, NULL, "", TRUE }; /* Left/Right cartridge */
-CARTRIDGE_image_t CARTRIDGE_piggyback = { CARTRIDGE_NONE, 0, 0, NULL, "", TRUE }; /* Pass through cartridge for SpartaDOSX */
+CARTRIDGE_image_t CARTRIDGE_main = { CARTRIDGE_NONE, 0, 0, NULL, "", TRUE, 0 }; /* Left/Right cartridge */
+CARTRIDGE_image_t CARTRIDGE_piggyback = { CARTRIDGE_NONE, 0, 0, NULL, "", TRUE, 0 }; /* Pass through cartridge for SpartaDOSX */
 
 /* The currently active cartridge in the left slot - normally points to
    CARTRIDGE_main but can be switched to CARTRIDGE_piggyback if the main
@@ -234,6 +239,188 @@ static void set_bank_MEGA_4096(void)
 	}
 }
 
+/* Write-back of writeable cartridges (Ram-Cart, SiDiCar). The 8 KB blocks
+   of the image that a bank copied back changes are marked dirty, and only
+   those are written into the cartridge's file, in place, together with
+   the checksum of a CART file's header. A worker thread writes them a
+   while after the first one, so that a program switching banks all the
+   time causes one write of each block; the rest are written when the
+   cartridge is removed. An image that was not changed is never written. */
+#define WRITEBACK_BLOCK 0x2000
+#define WRITEBACK_DELAY 1 /* seconds */
+
+typedef struct {
+	CARTRIDGE_image_t *cart;
+	char filename[FILENAME_MAX]; /* the worker's copy of cart->filename */
+	int header; /* offset of the image in the file */
+	int len; /* of the image */
+	int checksum; /* of the whole image, kept up to date */
+	UBYTE *dirty; /* a flag per block, NULL until the image is first changed */
+	int dirty_blocks;
+#ifdef HAVE_PTHREAD_CREATE
+	pthread_t thread;
+	int running;
+	int stop;
+#endif
+} writeback_t;
+
+/* For CARTRIDGE_main and CARTRIDGE_piggyback */
+static writeback_t writeback[2];
+
+#ifdef HAVE_PTHREAD_CREATE
+static pthread_mutex_t writeback_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t writeback_cond = PTHREAD_COND_INITIALIZER;
+static int writeback_failed = FALSE;
+#define WRITEBACK_LOCK() pthread_mutex_lock(&writeback_lock)
+#define WRITEBACK_UNLOCK() pthread_mutex_unlock(&writeback_lock)
+#else
+#define WRITEBACK_LOCK() do { } while (0)
+#define WRITEBACK_UNLOCK() do { } while (0)
+#endif
+
+/* Writes the dirty blocks of WB into its file. Called with the lock held,
+   which is released while writing; the image's blocks are copied first,
+   so the emulator can go on changing them meanwhile. */
+static void WritebackFlush(writeback_t *wb)
+{
+	static UBYTE buffer[WRITEBACK_BLOCK];
+	FILE *fp = fopen(wb->filename, "r+b");
+	int block;
+	int error = FALSE;
+
+	if (fp == NULL || Util_flen(fp) != wb->header + wb->len) {
+		/* The file is gone or no longer the one read: write it all. */
+		if (fp != NULL)
+			fclose(fp);
+		CARTRIDGE_WriteImage(wb->filename, wb->cart->type, wb->cart->image, wb->len, wb->header == 0, -1);
+		memset(wb->dirty, 0, (wb->len + WRITEBACK_BLOCK - 1) / WRITEBACK_BLOCK);
+		wb->dirty_blocks = 0;
+		return;
+	}
+	for (block = 0; wb->dirty_blocks > 0; block++) {
+		int offset = block * WRITEBACK_BLOCK;
+		int len = wb->len - offset < WRITEBACK_BLOCK ? wb->len - offset : WRITEBACK_BLOCK;
+		int checksum;
+		if (!wb->dirty[block])
+			continue;
+		memcpy(buffer, wb->cart->image + offset, len);
+		wb->dirty[block] = FALSE;
+		wb->dirty_blocks--;
+		checksum = wb->checksum;
+		WRITEBACK_UNLOCK();
+		if (fseek(fp, wb->header + offset, SEEK_SET) != 0 || fwrite(buffer, 1, len, fp) < len)
+			error = TRUE;
+		if (wb->header != 0) {
+			UBYTE sum[4];
+			sum[0] = checksum >> 24;
+			sum[1] = checksum >> 16;
+			sum[2] = checksum >> 8;
+			sum[3] = checksum;
+			if (fseek(fp, 8, SEEK_SET) != 0 || fwrite(sum, 1, 4, fp) < 4)
+				error = TRUE;
+		}
+		WRITEBACK_LOCK();
+	}
+	if (fclose(fp) != 0 || error)
+		Log_print("Error writing cartridge \"%s\".\n", wb->filename);
+}
+
+#ifdef HAVE_PTHREAD_CREATE
+static void *WritebackThread(void *arg)
+{
+	writeback_t *wb = (writeback_t *) arg;
+	WRITEBACK_LOCK();
+	for (;;) {
+		while (wb->dirty_blocks == 0 && !wb->stop)
+			pthread_cond_wait(&writeback_cond, &writeback_lock);
+		if (wb->dirty_blocks == 0)
+			break;
+		if (!wb->stop) {
+			/* Let the changes of the next while join these. */
+			struct timespec until;
+			until.tv_sec = time(NULL) + WRITEBACK_DELAY;
+			until.tv_nsec = 0;
+			while (!wb->stop && pthread_cond_timedwait(&writeback_cond, &writeback_lock, &until) == 0)
+				;
+		}
+		WritebackFlush(wb);
+	}
+	WRITEBACK_UNLOCK();
+	return NULL;
+}
+#endif /* HAVE_PTHREAD_CREATE */
+
+/* Copies the cartridge RAM at ADDR1..ADDR2 to the image of the active
+   cartridge at OFFSET, marking the blocks it changes for write-back. */
+static void CopyToCart(UWORD addr1, UWORD addr2, ULONG offset)
+{
+	writeback_t *wb = &writeback[active_cart == &CARTRIDGE_piggyback];
+	UBYTE const *src = MEMORY_mem + addr1;
+	UBYTE *dst = active_cart->image + offset;
+	int len = addr2 - addr1 + 1;
+	int block;
+
+	if (memcmp(dst, src, len) == 0)
+		return;
+	WRITEBACK_LOCK();
+	if (wb->dirty == NULL) {
+		wb->cart = active_cart;
+		Util_strlcpy(wb->filename, active_cart->filename, sizeof(wb->filename));
+		wb->header = active_cart->raw ? 0 : 16;
+		wb->len = active_cart->size << 10;
+		wb->checksum = CARTRIDGE_Checksum(active_cart->image, wb->len);
+		wb->dirty = (UBYTE *) Util_malloc((wb->len + WRITEBACK_BLOCK - 1) / WRITEBACK_BLOCK);
+		memset(wb->dirty, 0, (wb->len + WRITEBACK_BLOCK - 1) / WRITEBACK_BLOCK);
+		wb->dirty_blocks = 0;
+	}
+	wb->checksum += CARTRIDGE_Checksum(src, len) - CARTRIDGE_Checksum(dst, len);
+	memcpy(dst, src, len);
+	for (block = offset / WRITEBACK_BLOCK; block <= (offset + len - 1) / WRITEBACK_BLOCK; block++) {
+		if (!wb->dirty[block]) {
+			wb->dirty[block] = TRUE;
+			wb->dirty_blocks++;
+		}
+	}
+#ifdef HAVE_PTHREAD_CREATE
+	if (!wb->running && !writeback_failed) {
+		wb->stop = FALSE;
+		wb->running = pthread_create(&wb->thread, NULL, WritebackThread, wb) == 0;
+		if (!wb->running) {
+			Log_print("Cannot start the cartridge writer thread, writing on removal");
+			writeback_failed = TRUE;
+		}
+	}
+	pthread_cond_broadcast(&writeback_cond);
+#endif
+	WRITEBACK_UNLOCK();
+}
+
+/* Writes what is left of CART's changes and ends its write-back. */
+static void WritebackStop(CARTRIDGE_image_t *cart)
+{
+	writeback_t *wb = &writeback[cart == &CARTRIDGE_piggyback];
+
+	if (wb->dirty == NULL)
+		return;
+#ifdef HAVE_PTHREAD_CREATE
+	if (wb->running) {
+		WRITEBACK_LOCK();
+		wb->stop = TRUE;
+		pthread_cond_broadcast(&writeback_cond);
+		WRITEBACK_UNLOCK();
+		/* The worker writes the remaining blocks before it stops */
+		pthread_join(wb->thread, NULL);
+		wb->running = FALSE;
+	}
+#endif
+	WRITEBACK_LOCK();
+	if (wb->dirty_blocks > 0)
+		WritebackFlush(wb);
+	WRITEBACK_UNLOCK();
+	free(wb->dirty);
+	wb->dirty = NULL;
+}
+
 /* Ram-Cart */
 static void set_bank_RAMCART(int mask, int old_state)
 {
@@ -242,11 +429,11 @@ static void set_bank_RAMCART(int mask, int old_state)
 	if (old_state & 0x1000) {
 		if (old_state & 0x0002) {
 			offset = Calculate_RamCart_Address(active_cart->type, old_state & mask);
-			MEMORY_CopyToCart(0x8000, 0x9fff, active_cart->image + offset);
+			CopyToCart(0x8000, 0x9fff, offset);
 		}
 		if (old_state & 0x0001) {
 			offset = Calculate_RamCart_Address(active_cart->type, old_state & mask);
-			MEMORY_CopyToCart(0xa000, 0xbfff, active_cart->image + offset + 0x2000);
+			CopyToCart(0xa000, 0xbfff, offset + 0x2000);
 		}
 	}
 
@@ -278,7 +465,7 @@ static void set_bank_SIDICAR(int mask, int old_state)
 
 	if (old_state & 0x10) {
 		offset = Calculate_SiDiCar_Address(active_cart->type, old_state & mask);
-		MEMORY_CopyToCart(0x8000, 0x9fff, active_cart->image + offset);
+		CopyToCart(0x8000, 0x9fff, offset);
 	}
 
 	if (active_cart->state & 0x10) {
@@ -1455,6 +1642,18 @@ static void ResetCartState(CARTRIDGE_image_t *cart)
 	}
 }
 
+/* Frees CART->IMAGE, or unmaps the file it was mapped from. */
+static void FreeImage(CARTRIDGE_image_t *cart)
+{
+	if (cart->mapped != 0)
+		/* the mapping starts with the file, a CART file's header included */
+		Util_UnmapFile(cart->image + (cart->size << 10) - cart->mapped, cart->mapped);
+	else
+		free(cart->image);
+	cart->image = NULL;
+	cart->mapped = 0;
+}
+
 /* Before first use of the cartridge, preprocess its contents if needed. */
 static void PreprocessCart(CARTRIDGE_image_t *cart)
 {
@@ -1577,7 +1776,7 @@ static void PreprocessCart(CARTRIDGE_image_t *cart)
 				(byte & 0x40 ? map->data[6] : 0) |
 				(byte & 0x80 ? map->data[7] : 0);
 		}
-		free(cart->image);
+		FreeImage(cart);
 		cart->image = new_image;
 	}
 }
@@ -1655,22 +1854,8 @@ int CARTRIDGE_WriteImage(char *filename, int type, UBYTE *image, int size, int r
 static void RemoveCart(CARTRIDGE_image_t *cart)
 {
 	if (cart->image != NULL) {
-		switch (cart->type) {
-		case CARTRIDGE_RAMCART_64:
-		case CARTRIDGE_RAMCART_128:
-		case CARTRIDGE_DOUBLE_RAMCART_256:
-		case CARTRIDGE_RAMCART_1M:
-		case CARTRIDGE_RAMCART_2M:
-		case CARTRIDGE_RAMCART_4M:
-		case CARTRIDGE_RAMCART_8M:
-		case CARTRIDGE_RAMCART_16M:
-		case CARTRIDGE_RAMCART_32M:
-		case CARTRIDGE_SIDICAR_32:
-			CARTRIDGE_WriteImage(cart->filename, cart->type, cart->image, cart->size << 10, cart->raw, -1);
-		}
-
-		free(cart->image);
-		cart->image = NULL;
+		WritebackStop(cart);
+		FreeImage(cart);
 	}
 	if (cart->type != CARTRIDGE_NONE) {
 		cart->type = CARTRIDGE_NONE;
@@ -1712,7 +1897,137 @@ void CARTRIDGE_ColdStart(void) {
 	MapActiveCart();
 }
 
-int CARTRIDGE_ReadImage(const char *filename, CARTRIDGE_image_t *cart)
+/* Dumps whose size alone does not tell their type. Entries are added here
+   as dumps are confirmed; the file of known dumps can add to or correct
+   any of them. */
+static CARTRIDGE_known_t const builtin_known[] = {
+	/* crc, kb, type, machine, tv */
+	{ 0, 0, CARTRIDGE_NONE, -1, -1 }
+};
+
+#define DEFAULT_KNOWN_NAME ".atari800.carts"
+
+static CARTRIDGE_known_t *known = NULL;
+static int known_size = 0;
+static int known_loaded = FALSE;
+static int known_enabled = TRUE;
+static char known_filename[FILENAME_MAX] = "";
+
+void CARTRIDGE_SetKnownFile(char const *filename)
+{
+	if (filename == NULL)
+		known_enabled = FALSE;
+	else {
+		Util_strlcpy(known_filename, filename, FILENAME_MAX);
+		known_enabled = TRUE;
+	}
+	free(known);
+	known = NULL;
+	known_size = 0;
+	known_loaded = FALSE;
+}
+
+static int ParseMachine(char const *s, int *machine)
+{
+	if (strcmp(s, "-") == 0)
+		*machine = -1;
+	else if (strcmp(s, "800") == 0)
+		*machine = Atari800_MACHINE_800;
+	else if (Util_stricmp(s, "XL") == 0 || Util_stricmp(s, "XE") == 0)
+		*machine = Atari800_MACHINE_XLXE;
+	else if (strcmp(s, "5200") == 0)
+		*machine = Atari800_MACHINE_5200;
+	else
+		return FALSE;
+	return TRUE;
+}
+
+static int ParseTV(char const *s, int *tv)
+{
+	if (strcmp(s, "-") == 0)
+		*tv = -1;
+	else if (Util_stricmp(s, "PAL") == 0)
+		*tv = Atari800_TV_PAL;
+	else if (Util_stricmp(s, "NTSC") == 0)
+		*tv = Atari800_TV_NTSC;
+	else
+		return FALSE;
+	return TRUE;
+}
+
+static void LoadKnown(void)
+{
+	FILE *fp;
+	char line[256];
+	int alloc = 0;
+	int lineno = 0;
+
+	known_loaded = TRUE;
+	if (known_filename[0] == '\0') {
+		char *home = getenv("HOME");
+		if (home == NULL)
+			return;
+		Util_catpath(known_filename, home, DEFAULT_KNOWN_NAME);
+	}
+	if ((fp = fopen(known_filename, "r")) == NULL)
+		return;
+	while (fgets(line, sizeof(line), fp) != NULL) {
+		unsigned long crc;
+		int kb;
+		int type;
+		char machine[8] = "-";
+		char tv[8] = "-";
+		CARTRIDGE_known_t e;
+		char *comment = strchr(line, '#');
+		++lineno;
+		if (comment != NULL)
+			*comment = '\0';
+		Util_trim(line);
+		if (line[0] == '\0')
+			continue;
+		if (sscanf(line, "%lx %d %d %7s %7s", &crc, &kb, &type, machine, tv) < 3
+		    || type <= CARTRIDGE_NONE || type >= CARTRIDGE_TYPE_COUNT || CARTRIDGES[type].kb != kb
+		    || !ParseMachine(machine, &e.machine) || !ParseTV(tv, &e.tv)) {
+			Log_print("%s:%d: invalid cartridge entry", known_filename, lineno);
+			continue;
+		}
+		e.crc = (ULONG)crc;
+		e.kb = kb;
+		e.type = type;
+		if (known_size == alloc) {
+			alloc = alloc == 0 ? 64 : alloc * 2;
+			known = (CARTRIDGE_known_t *)Util_realloc(known, alloc * sizeof(CARTRIDGE_known_t));
+		}
+		known[known_size++] = e;
+	}
+	fclose(fp);
+}
+
+CARTRIDGE_known_t const *CARTRIDGE_Identify(UBYTE const *image, int kb)
+{
+	ULONG crc = ~CRC32_Update(0xffffffff, image, (unsigned int)kb << 10);
+	CARTRIDGE_known_t const *e;
+	int i;
+
+	if (known_enabled && !known_loaded)
+		LoadKnown();
+	/* Entries from the file come first, so that they can correct ours */
+	for (i = 0; i < known_size; ++i) {
+		if (known[i].crc == crc && known[i].kb == kb)
+			return &known[i];
+	}
+	for (e = builtin_known; e->type != CARTRIDGE_NONE; ++e) {
+		if (e->crc == crc && e->kb == kb)
+			return e;
+	}
+	return NULL;
+}
+
+/* Reads a cartridge image as described for CARTRIDGE_ReadImage. If MAP,
+   the image is mapped from the file instead where possible: the pages of
+   one file are then shared by every emulator that has it inserted, and
+   the writes of writeable cartridges go to private copies of their pages. */
+static int ReadImage(const char *filename, CARTRIDGE_image_t *cart, int map)
 {
 	FILE *fp;
 	int len;
@@ -1733,17 +2048,23 @@ int CARTRIDGE_ReadImage(const char *filename, CARTRIDGE_image_t *cart)
 		strcpy(cart->filename, filename);
 
 	cart->raw = TRUE;
+	cart->mapped = 0;
 
 	/* if full kilobytes, assume it is raw image */
 	if ((len & 0x3ff) == 0) {
-		/* alloc memory and read data */
-		cart->image = (UBYTE *) Util_malloc(len);
-		if (fread(cart->image, 1, len, fp) < len) {
-			Log_print("Error reading cartridge.\n");
-			fclose(fp);
-			free(cart->image);
-			cart->image = NULL;
-			return CARTRIDGE_TOO_FEW_DATA;
+		cart->image = map ? (UBYTE *) Util_MapFile(fp, len, TRUE) : NULL;
+		if (cart->image != NULL)
+			cart->mapped = len;
+		else {
+			/* alloc memory and read data */
+			cart->image = (UBYTE *) Util_malloc(len);
+			if (fread(cart->image, 1, len, fp) < len) {
+				Log_print("Error reading cartridge.\n");
+				fclose(fp);
+				free(cart->image);
+				cart->image = NULL;
+				return CARTRIDGE_TOO_FEW_DATA;
+			}
 		}
 		fclose(fp);
 		/* find cart type */
@@ -1755,7 +2076,13 @@ int CARTRIDGE_ReadImage(const char *filename, CARTRIDGE_image_t *cart)
 				if (cart->type == CARTRIDGE_NONE) {
 					cart->type = type;
 				} else {
-					/* more than one cartridge type of such length - user must select */
+					/* more than one cartridge type of such length - a known
+					   dump tells which, else user must select */
+					CARTRIDGE_known_t const *known = CARTRIDGE_Identify(cart->image, len);
+					if (known != NULL) {
+						cart->type = known->type;
+						return 0;
+					}
 					cart->type = CARTRIDGE_UNKNOWN;
 					return len;
 				}
@@ -1764,8 +2091,7 @@ int CARTRIDGE_ReadImage(const char *filename, CARTRIDGE_image_t *cart)
 			/*InitCartridge(cart);*/
 			return 0;	/* ok */
 		}
-		free(cart->image);
-		cart->image = NULL;
+		FreeImage(cart);
 		return CARTRIDGE_BAD_FORMAT;
 	}
 
@@ -1789,14 +2115,22 @@ int CARTRIDGE_ReadImage(const char *filename, CARTRIDGE_image_t *cart)
 			len = CARTRIDGES[type].kb << 10;
 			cart->raw = FALSE;
 			cart->size = CARTRIDGES[type].kb;
-			/* alloc memory and read data */
-			cart->image = (UBYTE *) Util_malloc(len);
-			if (fread(cart->image, 1, len, fp) < len) {
-				Log_print("Error reading cartridge.\n");
-				fclose(fp);
-				free(cart->image);
-				cart->image = NULL;
-				return CARTRIDGE_TOO_FEW_DATA;
+			/* the header is mapped too, the file's offset being a page's */
+			cart->image = map ? (UBYTE *) Util_MapFile(fp, 16 + len, TRUE) : NULL;
+			if (cart->image != NULL) {
+				cart->image += 16;
+				cart->mapped = 16 + len;
+			}
+			else {
+				/* alloc memory and read data */
+				cart->image = (UBYTE *) Util_malloc(len);
+				if (fread(cart->image, 1, len, fp) < len) {
+					Log_print("Error reading cartridge.\n");
+					fclose(fp);
+					free(cart->image);
+					cart->image = NULL;
+					return CARTRIDGE_TOO_FEW_DATA;
+				}
 			}
 			fclose(fp);
 			checksum = (header[8] << 24) |
@@ -1813,13 +2147,18 @@ int CARTRIDGE_ReadImage(const char *filename, CARTRIDGE_image_t *cart)
 	return CARTRIDGE_BAD_FORMAT;
 }
 
+int CARTRIDGE_ReadImage(const char *filename, CARTRIDGE_image_t *cart)
+{
+	return ReadImage(filename, cart, FALSE);
+}
+
 /* Loads a cartridge from FILENAME. Copies FILENAME to CART->FILENAME.
    If loading failed, sets CART->TYPE to CARTRIDGE_NONE and returns one of:
    * CARTRIDGE_CANT_OPEN if there was an error when opening file,
    * CARTRIDGE_BAD_FORMAT if the file is not a proper cartridge image.
 
-   If loading succeeded, allocates a buffer with cartridge image data and puts
-   it in CART->IMAGE. Then sets CART->TYPE if possible, and returns one of:
+   If loading succeeded, maps or allocates a buffer with cartridge image data
+   and puts it in CART->IMAGE. Then sets CART->TYPE if possible, and returns one of:
    * 0 if cartridge type was recognized; CART->TYPE is then set correctly;
    * CARTRIDGE_BAD_CHECKSUM if cartridge is a CART file but with invalid
      checksum; CART->TYPE is then set correctly;
@@ -1829,7 +2168,7 @@ int CARTRIDGE_ReadImage(const char *filename, CARTRIDGE_image_t *cart)
      CARTRIDGE_SetType() or CARTRIDGE_SetTypeAutoReboot(). */
 static int InsertCartridge(const char *filename, CARTRIDGE_image_t *cart)
 {
-	int kb = CARTRIDGE_ReadImage(filename, cart);
+	int kb = ReadImage(filename, cart, TRUE);
 	if ((kb == CARTRIDGE_BAD_CHECKSUM) || (kb == 0)) {
 		InitCartridge(cart);
 	}
@@ -1988,6 +2327,13 @@ int CARTRIDGE_Initialise(int *argc, char *argv[])
 			}
 			else a_m = TRUE;
 		}
+		else if (strcmp(argv[i], "-cart-db") == 0) {
+			if (i_a)
+				CARTRIDGE_SetKnownFile(argv[++i]);
+			else a_m = TRUE;
+		}
+		else if (strcmp(argv[i], "-no-cart-db") == 0)
+			CARTRIDGE_SetKnownFile(NULL);
 		else if (strcmp(argv[i], "-cart-autoreboot") == 0)
 			CARTRIDGE_autoreboot = TRUE;
 		else if (strcmp(argv[i], "-no-cart-autoreboot") == 0)
@@ -1999,6 +2345,8 @@ int CARTRIDGE_Initialise(int *argc, char *argv[])
 				Log_print("\t-cart-type <num>     Set cartridge type (0..%i)", CARTRIDGE_TYPE_COUNT-1);
 				Log_print("\t-cart2 <file>        Install piggyback cartridge");
 				Log_print("\t-cart2-type <num>    Set piggyback cartridge type (0..%i)", CARTRIDGE_TYPE_COUNT-1);
+				Log_print("\t-cart-db <file>      Read known raw cartridge dumps from <file>");
+				Log_print("\t-no-cart-db          Know only the built-in raw cartridge dumps");
 				Log_print("\t-cart-autoreboot     Reboot when cartridge is inserted/removed");
 				Log_print("\t-no-cart-autoreboot  Don't reboot after changing cartridge");
 			}
@@ -2137,6 +2485,24 @@ void CARTRIDGE_StateSave(void)
 	}
 }
 
+/* Bank state only, for snapshots that keep the inserted cartridges */
+void CARTRIDGE_BankStateSave(void)
+{
+	StateSav_SaveINT(&CARTRIDGE_main.state, 1);
+	StateSav_SaveINT(&CARTRIDGE_piggyback.state, 1);
+}
+
+void CARTRIDGE_BankStateRead(void)
+{
+	StateSav_ReadINT(&CARTRIDGE_main.state, 1);
+	StateSav_ReadINT(&CARTRIDGE_piggyback.state, 1);
+	if (CartIsPassthrough(CARTRIDGE_main.type) && (CARTRIDGE_main.state & 0x0c) == 0x08)
+		active_cart = &CARTRIDGE_piggyback;
+	else
+		active_cart = &CARTRIDGE_main;
+	MapActiveCart();
+}
+
 #endif
 
 /*
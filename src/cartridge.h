@@ -52,6 +52,7 @@ typedef struct CARTRIDGE_image_t {
 	UBYTE *image;
 	char filename[FILENAME_MAX];
 	int raw; /* File contains RAW data (important for writeable cartridges). */
+	int mapped; /* Length of the file mapping IMAGE points into, or 0 if IMAGE was allocated. */
 } CARTRIDGE_image_t;
 
 extern CARTRIDGE_image_t CARTRIDGE_main;
@@ -113,6 +114,8 @@ UBYTE CARTRIDGE_GetByte(UWORD addr, int no_side_effects);
 void CARTRIDGE_PutByte(UWORD addr, UBYTE byte);
 void CARTRIDGE_StateSave(void);
 void CARTRIDGE_StateRead(UBYTE version);
+void CARTRIDGE_BankStateSave(void);
+void CARTRIDGE_BankStateRead(void);
 
 /* addr must be $4fxx in 5200 mode or $8fxx in 800 mode. */
 UBYTE CARTRIDGE_BountyBob1GetByte(UWORD addr, int no_side_effects);
@@ -132,6 +135,24 @@ void CARTRIDGE_BountyBob2PutByte(UWORD addr, UBYTE value);
 /* addr must be $bfxx in 5200 mode only. */
 void CARTRIDGE_5200SuperCartPutByte(UWORD addr, UBYTE value);
 
+/* A known dump of a cartridge, identified by the CRC32 of its raw data */
+typedef struct {
+	ULONG crc;
+	int kb;
+	int type;
+	int machine; /* Atari800_MACHINE_* the dump is for, or -1 if any */
+	int tv;      /* Atari800_TV_PAL or Atari800_TV_NTSC, or -1 if either */
+} CARTRIDGE_known_t;
+
+/* Sets the file of known dumps read on top of the built-in ones, NULL to
+   use the built-in ones only. By default it is ~/.atari800.carts, whose
+   lines are "<crc32> <kb> <type> [800|XL|XE|5200|-] [PAL|NTSC|-]". */
+void CARTRIDGE_SetKnownFile(char const *filename);
+
+/* Looks up the raw cartridge image of KB kilobytes. Returns NULL if it is not
+   a known dump. */
+CARTRIDGE_known_t const *CARTRIDGE_Identify(UBYTE const *image, int kb);
+
 int CARTRIDGE_ReadImage(const char *filename, CARTRIDGE_image_t *cart);
 int CARTRIDGE_WriteImage(char *filename, int type, UBYTE *image, int size, int raw, UBYTE value);
 
@@ -70,6 +70,10 @@ char CASSETTE_description[CASSETTE_DESCRIPTION_MAX];
 static int cassette_gapdelay = 0;	/* in ms, includes leader and all gaps */
 static int cassette_motor = 0;
 
+/* The bytes of tape records loaded without the SIO patch come
+   CASSETTE_accel times faster (see IMG_TAPE_Read()). */
+int CASSETTE_accel = 1;
+
 int CASSETTE_hold_start_on_reboot = 0;
 int CASSETTE_hold_start = 0;
 int CASSETTE_press_space = 0;
@@ -126,6 +130,7 @@ int CASSETTE_Initialise(int *argc, char *argv[])
 	for (i = j = 1; i < *argc; i++) {
 		int i_a = (i + 1 < *argc);		/* is argument available? */
 		int a_m = FALSE;			/* error, argument missing! */
+		int a_i = FALSE;			/* error, argument invalid! */
 
 		if (strcmp(argv[i], "-tape") == 0) {
 			if (i_a) {
@@ -148,11 +153,21 @@ int CASSETTE_Initialise(int *argc, char *argv[])
 		}
 		else if (strcmp(argv[i], "-tape-readonly") == 0)
 			protect = TRUE;
+		else if (strcmp(argv[i], "-tape-accel") == 0) {
+			if (i_a) {
+				CASSETTE_accel = Util_sscandec(argv[++i]);
+				if (CASSETTE_accel < 1 || CASSETTE_accel > 4)
+					a_i = TRUE;
+			}
+			else a_m = TRUE;
+		}
 		else {
 			if (strcmp(argv[i], "-help") == 0) {
 				Log_print("\t-tape <file>      Insert cassette image");
 				Log_print("\t-boottape <file>  Insert cassette image and boot it");
 				Log_print("\t-tape-readonly    Mark the attached cassette image as read-only");
+				Log_print("\t-tape-accel <n>   Read tape records n times faster when loading");
+				Log_print("\t                 without the SIO patch (1-4)");
 			}
 			argv[j++] = argv[i];
 		}
@@ -161,6 +176,10 @@ int CASSETTE_Initialise(int *argc, char *argv[])
 			Log_print("Missing argument for '%s'", argv[i]);
 			return FALSE;
 		}
+		else if (a_i) {
+			Log_print("Invalid argument for '%s'", argv[--i]);
+			return FALSE;
+		}
 	}
 
 	*argc = j;
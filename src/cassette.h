@@ -31,6 +31,10 @@ void CASSETTE_Remove(void);
    Returns TRUE on success, FALSE otherwise. */
 int CASSETTE_CreateCAS(char const *filename, char const *description);
 
+/* Speed-up of the bytes of tape records loaded without the SIO patch
+   (-tape-accel); 1 keeps the real speed. */
+extern int CASSETTE_accel;
+
 extern int CASSETTE_hold_start;
 extern int CASSETTE_hold_start_on_reboot; /* preserve hold_start after reboot */
 extern int CASSETTE_press_space;
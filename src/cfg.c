@@ -25,6 +25,10 @@
 #include "artifact.h"
 #include "atari.h"
 #include <stdlib.h>
+#include <string.h>
+#if defined(HAVE_STAT) && defined(HAVE_SYS_STAT_H)
+#include <sys/stat.h>
+#endif
 #include "cartridge.h"
 #include "cassette.h"
 #include "binload.h"
@@ -80,281 +84,472 @@ int CFG_save_on_exit = FALSE;
 
 static char rtconfig_filename[FILENAME_MAX];
 
-int CFG_LoadConfig(const char *alternate_config_filename)
-{
-	FILE *fp;
-	const char *fname = rtconfig_filename;
-	char string[256];
-#ifndef BASIC
-	int was_obsolete_dir = FALSE;
+/* The configuration last loaded, in a compact binary form that is applied
+   again without parsing text: SNAPSHOT_MAGIC, the number of handlers in
+   read_config[] and the Atari800_TITLE of the build, then for each option
+   taken the index of the handler that took it, followed by the option's
+   name and value, both NUL-terminated. The indices hold for the build that
+   made the snapshot only, which the count and title stand for. */
+#define SNAPSHOT_MAGIC "\033A800CFG"
+#define SNAPSHOT_MAGIC_SIZE 8
+#define SNAPSHOT_HEADER_SIZE (SNAPSHOT_MAGIC_SIZE + 1 + (int)sizeof(Atari800_TITLE))
+
+static UBYTE *snapshot = NULL;
+static int snapshot_size = 0;
+static int snapshot_alloc = 0;
+
+#if defined(HAVE_STAT) && defined(HAVE_SYS_STAT_H)
+#define CFG_CACHE
+/* The file the snapshot was made from, as it was then. While it keeps its
+   size and modification time, loading it again applies the snapshot. */
+static char snapshot_filename[FILENAME_MAX] = "";
+static long snapshot_file_size;
+static long snapshot_file_mtime;
 #endif
 
-#ifdef SUPPORTS_PLATFORM_CONFIGINIT
-	PLATFORM_ConfigInit();
+#ifndef BASIC
+static int was_obsolete_dir;
 #endif
 
-	/* if alternate config filename is passed then use it */
-	if (alternate_config_filename != NULL && *alternate_config_filename > 0) {
-		Util_strlcpy(rtconfig_filename, alternate_config_filename, FILENAME_MAX);
-	}
-	/* else use the default config name under the HOME folder */
-	else {
-		char *home = getenv("HOME");
-		if (home != NULL)
-			Util_catpath(rtconfig_filename, home, DEFAULT_CFG_NAME);
-		else
-			strcpy(rtconfig_filename, DEFAULT_CFG_NAME);
+static int ReadCoreConfig(char *string, char *ptr)
+{
+	if (strcmp(string, "H1_DIR") == 0)
+		Util_strlcpy(Devices_atari_h_dir[0], ptr, FILENAME_MAX);
+	else if (strcmp(string, "H2_DIR") == 0)
+		Util_strlcpy(Devices_atari_h_dir[1], ptr, FILENAME_MAX);
+	else if (strcmp(string, "H3_DIR") == 0)
+		Util_strlcpy(Devices_atari_h_dir[2], ptr, FILENAME_MAX);
+	else if (strcmp(string, "H4_DIR") == 0)
+		Util_strlcpy(Devices_atari_h_dir[3], ptr, FILENAME_MAX);
+	else if (strcmp(string, "HD_READ_ONLY") == 0)
+		Devices_h_read_only = Util_sscandec(ptr);
+	else if (strcmp(string, "HD_DEVICE_NAME") == 0)
+		Devices_h_device_name = *ptr;
+
+	else if (strcmp(string, "PRINT_COMMAND") == 0) {
+		if (!Devices_SetPrintCommand(ptr))
+			Log_print("Unsafe PRINT_COMMAND ignored");
 	}
 
-	fp = fopen(fname, "r");
-	if (fp == NULL) {
-		Log_print("User config file '%s' not found.", rtconfig_filename);
+	else if (strcmp(string, "ACCURATE_SKIPPED_FRAMES") == 0)
+		Atari800_collisions_in_skipped_frames = Util_sscanbool(ptr);
+	else if (strcmp(string, "SCREEN_REFRESH_RATIO") == 0)
+		Atari800_refresh_rate = Util_sscandec(ptr);
+	else if (strcmp(string, "DISABLE_BASIC") == 0)
+		Atari800_disable_basic = Util_sscanbool(ptr);
+	else if (strcmp(string, "TURBO_SPEED") == 0) {
+		Atari800_turbo_speed = Util_sscandec(ptr);
+	}
+	else if (strcmp(string, "RUN_AHEAD") == 0) {
+		Atari800_run_ahead = Util_sscandec(ptr);
+		if (Atari800_run_ahead < 0 || Atari800_run_ahead > Atari800_RUN_AHEAD_MAX)
+			Atari800_run_ahead = 0;
+	}
+	else if (strcmp(string, "QUICK_BOOT") == 0)
+		Atari800_quick_boot = Util_sscanbool(ptr);
+	else if (strcmp(string, "SYNC_SPIN") == 0)
+		Atari800_sync_spin = Util_sscanbool(ptr);
+	else if (strcmp(string, "ENABLE_SIO_PATCH") == 0) {
+		ESC_enable_sio_patch = Util_sscanbool(ptr);
+	}
+	else if (strcmp(string, "ENABLE_SLOW_XEX_LOADING") == 0) {
+		BINLOAD_slow_xex_loading = Util_sscanbool(ptr);
+	}
+	else if (strcmp(string, "ENABLE_H_PATCH") == 0) {
+		Devices_enable_h_patch = Util_sscanbool(ptr);
+	}
+	else if (strcmp(string, "ENABLE_P_PATCH") == 0) {
+		Devices_enable_p_patch = Util_sscanbool(ptr);
+	}
+	else if (strcmp(string, "ENABLE_R_PATCH") == 0) {
+		Devices_enable_r_patch = Util_sscanbool(ptr);
+	}
 
-#ifdef SYSTEM_WIDE_CFG_FILE
-		/* try system wide config file */
-		fname = SYSTEM_WIDE_CFG_FILE;
-		Log_print("Trying system wide config file: %s", fname);
-		fp = fopen(fname, "r");
+	else if (strcmp(string, "ENABLE_NEW_POKEY") == 0) {
+#ifdef SOUND
+		POKEYSND_enable_new_pokey = Util_sscanbool(ptr);
+#endif /* SOUND */
+	}
+	else if (strcmp(string, "STEREO_POKEY") == 0) {
+#ifdef STEREO_SOUND
+		POKEYSND_stereo_enabled = Util_sscanbool(ptr);
+		Sound_desired.channels = POKEYSND_stereo_enabled ? 2 : 1;
+#endif /* STEREO_SOUND */
+	}
+	else if (strcmp(string, "SPEAKER_SOUND") == 0) {
+#ifdef CONSOLE_SOUND
+		POKEYSND_console_sound_enabled = Util_sscanbool(ptr);
 #endif
-		if (fp == NULL) {
-			Log_print("No configuration file found, will create fresh one from scratch:");
-			return FALSE;
-		}
 	}
-
-	if (fgets(string, sizeof(string), fp) != NULL) {
-		Log_print("Using Atari800 config file: %s\nCreated by %s", fname, string);
+	else if (strcmp(string, "MACHINE_TYPE") == 0) {
+		if (strcmp(ptr, "Atari 400/800") == 0 ||
+		    /* Also recognise legacy values of this parameter */
+		    strcmp(ptr, "Atari OS/A") == 0 ||
+		    strcmp(ptr, "Atari OS/B") == 0)
+			Atari800_machine_type = Atari800_MACHINE_800;
+		else if (strcmp(ptr, "Atari XL/XE") == 0)
+			Atari800_machine_type = Atari800_MACHINE_XLXE;
+		else if (strcmp(ptr, "Atari 5200") == 0)
+			Atari800_machine_type = Atari800_MACHINE_5200;
+		else
+			Log_print("Invalid machine type: %s", ptr);
 	}
-
-	while (fgets(string, sizeof(string), fp)) {
-		char *ptr;
-		Util_chomp(string);
-		Util_trim(string);
-		/* Check for comments */
-		if (string[0] == '#') {
-			continue;
+	else if (strcmp(string, "RAM_SIZE") == 0) {
+		if (strcmp(ptr, "320 (RAMBO)") == 0)
+			MEMORY_ram_size = MEMORY_RAM_320_RAMBO;
+		else if (strcmp(ptr, "320 (COMPY SHOP)") == 0)
+			MEMORY_ram_size = MEMORY_RAM_320_COMPY_SHOP;
+		else {
+			int size = Util_sscandec(ptr);
+			if (MEMORY_SizeValid(size))
+				MEMORY_ram_size = size;
+			else
+				Log_print("Invalid RAM size: %s", ptr);
 		}
-		ptr = strchr(string, '=');
-		if (ptr != NULL) {
-			*ptr++ = '\0';
-			Util_trim(string);
-			Util_trim(ptr);
-
-			if (SYSROM_ReadConfig(string, ptr)) {
-			}
+	}
+	else if (strcmp(string, "DEFAULT_TV_MODE") == 0) {
+		if (strcmp(ptr, "PAL") == 0)
+			Atari800_tv_mode = Atari800_TV_PAL;
+		else if (strcmp(ptr, "NTSC") == 0)
+			Atari800_tv_mode = Atari800_TV_NTSC;
+		else
+			Log_print("Invalid TV Mode: %s", ptr);
+	}
+	else if (strcmp(string, "MOSAIC_RAM_NUM_BANKS") == 0) {
+		int num = Util_sscandec(ptr);
+		if (num >= 0 && num <= 64)
+			MEMORY_mosaic_num_banks = num;
+		else
+			Log_print("Invalid Mosaic RAM number of banks: %s", ptr);
+	}
+	else if (strcmp(string, "AXLON_RAM_NUM_BANKS") == 0) {
+		int num = Util_sscandec(ptr);
+		if (num == 0 || num == 8 || num == 16 || num == 32 || num == 64 || num == 128 || num == 256)
+			MEMORY_axlon_num_banks = num;
+		else
+			Log_print("Invalid Mosaic RAM number of banks: %s", ptr);
+	}
+	else if (strcmp(string, "ENABLE_MAPRAM") == 0)
+		MEMORY_enable_mapram = Util_sscanbool(ptr);
+	else if (strcmp(string, "BUILTIN_BASIC") == 0)
+		Atari800_builtin_basic = Util_sscanbool(ptr);
+	else if (strcmp(string, "KEYBOARD_LEDS") == 0)
+		Atari800_keyboard_leds = Util_sscanbool(ptr);
+	else if (strcmp(string, "F_KEYS") == 0)
+		Atari800_f_keys = Util_sscanbool(ptr);
+	else if (strcmp(string, "BUILTIN_GAME") == 0)
+		Atari800_builtin_game = Util_sscanbool(ptr);
+	else if (strcmp(string, "KEYBOARD_DETACHED") == 0)
+		Atari800_keyboard_detached = Util_sscanbool(ptr);
+	else if (strcmp(string, "1200XL_JUMPER") == 0)
+		Atari800_jumper = Util_sscanbool(ptr);
+	else if (strcmp(string, "CFG_SAVE_ON_EXIT") == 0) {
+		CFG_save_on_exit = Util_sscanbool(ptr);
+	}
 #ifdef BASIC
-			else if (strcmp(string, "ATARI_FILES_DIR") == 0
-				  || strcmp(string, "SAVED_FILES_DIR") == 0
-				  || strcmp(string, "DISK_DIR") == 0 || strcmp(string, "ROM_DIR") == 0
-				  || strcmp(string, "EXE_DIR") == 0 || strcmp(string, "STATE_DIR") == 0)
-				/* do nothing */;
+	else if (strcmp(string, "ATARI_FILES_DIR") == 0
+		  || strcmp(string, "SAVED_FILES_DIR") == 0
+		  || strcmp(string, "DISK_DIR") == 0 || strcmp(string, "ROM_DIR") == 0
+		  || strcmp(string, "EXE_DIR") == 0 || strcmp(string, "STATE_DIR") == 0)
+		/* do nothing */;
 #else
-			else if (strcmp(string, "ATARI_FILES_DIR") == 0) {
-				if (UI_n_atari_files_dir >= UI_MAX_DIRECTORIES)
-					Log_print("All ATARI_FILES_DIR slots used!");
-				else
-					Util_strlcpy(UI_atari_files_dir[UI_n_atari_files_dir++], ptr, FILENAME_MAX);
-			}
-			else if (strcmp(string, "SAVED_FILES_DIR") == 0) {
-				if (UI_n_saved_files_dir >= UI_MAX_DIRECTORIES)
-					Log_print("All SAVED_FILES_DIR slots used!");
-				else
-					Util_strlcpy(UI_saved_files_dir[UI_n_saved_files_dir++], ptr, FILENAME_MAX);
-			}
-			else if (strcmp(string, "SHOW_HIDDEN_FILES") == 0)
-				UI_show_hidden_files = Util_sscanbool(ptr);
-			else if (strcmp(string, "DISK_DIR") == 0 || strcmp(string, "ROM_DIR") == 0
-				  || strcmp(string, "EXE_DIR") == 0 || strcmp(string, "STATE_DIR") == 0) {
-				/* ignore blank and "." values */
-				if (ptr[0] != '\0' && (ptr[0] != '.' || ptr[1] != '\0'))
-					was_obsolete_dir = TRUE;
-			}
+	else if (strcmp(string, "ATARI_FILES_DIR") == 0) {
+		if (UI_n_atari_files_dir >= UI_MAX_DIRECTORIES)
+			Log_print("All ATARI_FILES_DIR slots used!");
+		else
+			Util_strlcpy(UI_atari_files_dir[UI_n_atari_files_dir++], ptr, FILENAME_MAX);
+	}
+	else if (strcmp(string, "SAVED_FILES_DIR") == 0) {
+		if (UI_n_saved_files_dir >= UI_MAX_DIRECTORIES)
+			Log_print("All SAVED_FILES_DIR slots used!");
+		else
+			Util_strlcpy(UI_saved_files_dir[UI_n_saved_files_dir++], ptr, FILENAME_MAX);
+	}
+	else if (strcmp(string, "SHOW_HIDDEN_FILES") == 0)
+		UI_show_hidden_files = Util_sscanbool(ptr);
+	else if (strcmp(string, "DISK_DIR") == 0 || strcmp(string, "ROM_DIR") == 0
+		  || strcmp(string, "EXE_DIR") == 0 || strcmp(string, "STATE_DIR") == 0) {
+		/* ignore blank and "." values */
+		if (ptr[0] != '\0' && (ptr[0] != '.' || ptr[1] != '\0'))
+			was_obsolete_dir = TRUE;
+	}
 #endif
-			else if (strcmp(string, "H1_DIR") == 0)
-				Util_strlcpy(Devices_atari_h_dir[0], ptr, FILENAME_MAX);
-			else if (strcmp(string, "H2_DIR") == 0)
-				Util_strlcpy(Devices_atari_h_dir[1], ptr, FILENAME_MAX);
-			else if (strcmp(string, "H3_DIR") == 0)
-				Util_strlcpy(Devices_atari_h_dir[2], ptr, FILENAME_MAX);
-			else if (strcmp(string, "H4_DIR") == 0)
-				Util_strlcpy(Devices_atari_h_dir[3], ptr, FILENAME_MAX);
-			else if (strcmp(string, "HD_READ_ONLY") == 0)
-				Devices_h_read_only = Util_sscandec(ptr);
-			else if (strcmp(string, "HD_DEVICE_NAME") == 0)
-				Devices_h_device_name = *ptr;
-
-			else if (strcmp(string, "PRINT_COMMAND") == 0) {
-				if (!Devices_SetPrintCommand(ptr))
-					Log_print("Unsafe PRINT_COMMAND ignored");
-			}
+	else
+		return FALSE;
+	return TRUE;
+}
 
-			else if (strcmp(string, "ACCURATE_SKIPPED_FRAMES") == 0)
-				Atari800_collisions_in_skipped_frames = Util_sscanbool(ptr);
-			else if (strcmp(string, "SCREEN_REFRESH_RATIO") == 0)
-				Atari800_refresh_rate = Util_sscandec(ptr);
-			else if (strcmp(string, "DISABLE_BASIC") == 0)
-				Atari800_disable_basic = Util_sscanbool(ptr);
-			else if (strcmp(string, "TURBO_SPEED") == 0) {
-				Atari800_turbo_speed = Util_sscandec(ptr);
-			}
-			else if (strcmp(string, "ENABLE_SIO_PATCH") == 0) {
-				ESC_enable_sio_patch = Util_sscanbool(ptr);
-			}
-			else if (strcmp(string, "ENABLE_SLOW_XEX_LOADING") == 0) {
-				BINLOAD_slow_xex_loading = Util_sscanbool(ptr);
-			}
-			else if (strcmp(string, "ENABLE_H_PATCH") == 0) {
-				Devices_enable_h_patch = Util_sscanbool(ptr);
-			}
-			else if (strcmp(string, "ENABLE_P_PATCH") == 0) {
-				Devices_enable_p_patch = Util_sscanbool(ptr);
-			}
-			else if (strcmp(string, "ENABLE_R_PATCH") == 0) {
-				Devices_enable_r_patch = Util_sscanbool(ptr);
-			}
+typedef int (*ReadConfigFunc)(char *option, char *ptr);
 
-			else if (strcmp(string, "ENABLE_NEW_POKEY") == 0) {
-#ifdef SOUND
-				POKEYSND_enable_new_pokey = Util_sscanbool(ptr);
-#endif /* SOUND */
-			}
-			else if (strcmp(string, "STEREO_POKEY") == 0) {
-#ifdef STEREO_SOUND
-				POKEYSND_stereo_enabled = Util_sscanbool(ptr);
-				Sound_desired.channels = POKEYSND_stereo_enabled ? 2 : 1;
-#endif /* STEREO_SOUND */
-			}
-			else if (strcmp(string, "SPEAKER_SOUND") == 0) {
-#ifdef CONSOLE_SOUND
-				POKEYSND_console_sound_enabled = Util_sscanbool(ptr);
-#endif
-			}
-			else if (strcmp(string, "MACHINE_TYPE") == 0) {
-				if (strcmp(ptr, "Atari 400/800") == 0 ||
-				    /* Also recognise legacy values of this parameter */
-				    strcmp(ptr, "Atari OS/A") == 0 ||
-				    strcmp(ptr, "Atari OS/B") == 0)
-					Atari800_machine_type = Atari800_MACHINE_800;
-				else if (strcmp(ptr, "Atari XL/XE") == 0)
-					Atari800_machine_type = Atari800_MACHINE_XLXE;
-				else if (strcmp(ptr, "Atari 5200") == 0)
-					Atari800_machine_type = Atari800_MACHINE_5200;
-				else
-					Log_print("Invalid machine type: %s", ptr);
-			}
-			else if (strcmp(string, "RAM_SIZE") == 0) {
-				if (strcmp(ptr, "320 (RAMBO)") == 0)
-					MEMORY_ram_size = MEMORY_RAM_320_RAMBO;
-				else if (strcmp(ptr, "320 (COMPY SHOP)") == 0)
-					MEMORY_ram_size = MEMORY_RAM_320_COMPY_SHOP;
-				else {
-					int size = Util_sscandec(ptr);
-					if (MEMORY_SizeValid(size))
-						MEMORY_ram_size = size;
-					else
-						Log_print("Invalid RAM size: %s", ptr);
-				}
-			}
-			else if (strcmp(string, "DEFAULT_TV_MODE") == 0) {
-				if (strcmp(ptr, "PAL") == 0)
-					Atari800_tv_mode = Atari800_TV_PAL;
-				else if (strcmp(ptr, "NTSC") == 0)
-					Atari800_tv_mode = Atari800_TV_NTSC;
-				else
-					Log_print("Invalid TV Mode: %s", ptr);
-			}
-			else if (strcmp(string, "MOSAIC_RAM_NUM_BANKS") == 0) {
-				int num = Util_sscandec(ptr);
-				if (num >= 0 && num <= 64)
-					MEMORY_mosaic_num_banks = num;
-				else
-					Log_print("Invalid Mosaic RAM number of banks: %s", ptr);
-			}
-			else if (strcmp(string, "AXLON_RAM_NUM_BANKS") == 0) {
-				int num = Util_sscandec(ptr);
-				if (num == 0 || num == 8 || num == 16 || num == 32 || num == 64 || num == 128 || num == 256)
-					MEMORY_axlon_num_banks = num;
-				else
-					Log_print("Invalid Mosaic RAM number of banks: %s", ptr);
-			}
-			else if (strcmp(string, "ENABLE_MAPRAM") == 0)
-				MEMORY_enable_mapram = Util_sscanbool(ptr);
-			else if (strcmp(string, "BUILTIN_BASIC") == 0)
-				Atari800_builtin_basic = Util_sscanbool(ptr);
-			else if (strcmp(string, "KEYBOARD_LEDS") == 0)
-				Atari800_keyboard_leds = Util_sscanbool(ptr);
-			else if (strcmp(string, "F_KEYS") == 0)
-				Atari800_f_keys = Util_sscanbool(ptr);
-			else if (strcmp(string, "BUILTIN_GAME") == 0)
-				Atari800_builtin_game = Util_sscanbool(ptr);
-			else if (strcmp(string, "KEYBOARD_DETACHED") == 0)
-				Atari800_keyboard_detached = Util_sscanbool(ptr);
-			else if (strcmp(string, "1200XL_JUMPER") == 0)
-				Atari800_jumper = Util_sscanbool(ptr);
-			else if (strcmp(string, "CFG_SAVE_ON_EXIT") == 0) {
-				CFG_save_on_exit = Util_sscanbool(ptr);
-			}
-			/* Add module-specific configurations here */
-			else if (PBI_ReadConfig(string,ptr)) {
-			}
-			else if (CARTRIDGE_ReadConfig(string, ptr)) {
-			}
-			else if (CASSETTE_ReadConfig(string, ptr)) {
-			}
-			else if (RTIME_ReadConfig(string, ptr)) {
-			}
+/* The handlers offered each option, in this order */
+static ReadConfigFunc const read_config[] = {
+	SYSROM_ReadConfig,
+	ReadCoreConfig,
+	/* Add module-specific configurations here */
+	PBI_ReadConfig,
+	CARTRIDGE_ReadConfig,
+	CASSETTE_ReadConfig,
+	RTIME_ReadConfig,
 #ifdef XEP80_EMULATION
-			else if (XEP80_ReadConfig(string, ptr)) {
-			}
+	XEP80_ReadConfig,
 #endif
 #ifdef AF80
-			else if (AF80_ReadConfig(string,ptr)) {
-			}
+	AF80_ReadConfig,
 #endif
 #ifdef BIT3
-			else if (BIT3_ReadConfig(string,ptr)) {
-			}
+	BIT3_ReadConfig,
 #endif
 #if !defined(BASIC) && !defined(CURSES_BASIC)
-			else if (Colours_ReadConfig(string, ptr)) {
-			}
-			else if (ARTIFACT_ReadConfig(string, ptr)) {
-			}
-			else if (Screen_ReadConfig(string, ptr)) {
-			}
+	Colours_ReadConfig,
+	ARTIFACT_ReadConfig,
+	Screen_ReadConfig,
 #endif
 #ifdef NTSC_FILTER
-			else if (FILTER_NTSC_ReadConfig(string, ptr)) {
-			}
+	FILTER_NTSC_ReadConfig,
 #endif
 #if SUPPORTS_CHANGE_VIDEOMODE
-			else if (VIDEOMODE_ReadConfig(string, ptr)) {
-			}
+	VIDEOMODE_ReadConfig,
 #endif
 #ifdef SOUND
-			else if (Sound_ReadConfig(string, ptr)) {
-			}
+	Sound_ReadConfig,
 #endif /* SOUND */
 #if defined(HAVE_LIBPNG) || defined(HAVE_LIBZ) || defined(AUDIO_RECORDING) || defined(VIDEO_RECORDING)
-			else if (File_Export_ReadConfig(string, ptr)) {
-			}
+	File_Export_ReadConfig,
 #endif
-			else {
 #ifdef SUPPORTS_PLATFORM_CONFIGURE
-				if (!PLATFORM_Configure(string, ptr)) {
-					Log_print("Unrecognized variable or bad parameters: '%s=%s'", string, ptr);
-				}
+	PLATFORM_Configure,
+#endif
+};
+#define READ_CONFIG_SIZE ((int)(sizeof(read_config) / sizeof(read_config[0])))
+
+static void UnrecognizedOption(char const *string, char const *ptr)
+{
+#ifdef SUPPORTS_PLATFORM_CONFIGURE
+	Log_print("Unrecognized variable or bad parameters: '%s=%s'", string, ptr);
 #else
-				Log_print("Unrecognized variable: %s", string);
+	Log_print("Unrecognized variable: %s", string);
 #endif
+}
+
+static void SnapshotPut(const void *data, int n)
+{
+	if (snapshot_size + n > snapshot_alloc) {
+		snapshot_alloc = 2 * (snapshot_size + n);
+		snapshot = (UBYTE *)Util_realloc(snapshot, snapshot_alloc);
+	}
+	memcpy(snapshot + snapshot_size, data, n);
+	snapshot_size += n;
+}
+
+/* Parses a text configuration file, applying each option and keeping it in
+   the snapshot along with the handler that took it. */
+static void ParseText(FILE *fp)
+{
+	char string[256];
+	UBYTE count = READ_CONFIG_SIZE;
+
+	snapshot_size = 0;
+	SnapshotPut(SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_SIZE);
+	SnapshotPut(&count, 1);
+	SnapshotPut(Atari800_TITLE, sizeof(Atari800_TITLE));
+
+	while (fgets(string, sizeof(string), fp)) {
+		char *ptr;
+		Util_chomp(string);
+		Util_trim(string);
+		/* Check for comments */
+		if (string[0] == '#') {
+			continue;
+		}
+		ptr = strchr(string, '=');
+		if (ptr != NULL) {
+			int start = snapshot_size;
+			int id;
+			*ptr++ = '\0';
+			Util_trim(string);
+			Util_trim(ptr);
+
+			/* Kept before the handlers see them, as they may change them */
+			SnapshotPut(&count, 1);
+			SnapshotPut(string, strlen(string) + 1);
+			SnapshotPut(ptr, strlen(ptr) + 1);
+			for (id = 0; id < READ_CONFIG_SIZE; id++) {
+				if (read_config[id](string, ptr))
+					break;
+			}
+			if (id < READ_CONFIG_SIZE)
+				snapshot[start] = (UBYTE)id;
+			else {
+				snapshot_size = start;
+				UnrecognizedOption(string, ptr);
 			}
 		}
 		else {
 			Log_print("Ignored config line: %s", string);
 		}
 	}
+}
 
+/* Checks that DATA is a snapshot this build can apply */
+static int SnapshotValid(const UBYTE *data, int size)
+{
+	const UBYTE *p = data + SNAPSHOT_HEADER_SIZE;
+	const UBYTE *end = data + size;
+
+	if (size < SNAPSHOT_HEADER_SIZE
+	    || memcmp(data, SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_SIZE) != 0
+	    || data[SNAPSHOT_MAGIC_SIZE] != READ_CONFIG_SIZE
+	    || memcmp(data + SNAPSHOT_MAGIC_SIZE + 1, Atari800_TITLE, sizeof(Atari800_TITLE)) != 0)
+		return FALSE;
+	while (p < end) {
+		int i;
+		if (*p++ >= READ_CONFIG_SIZE)
+			return FALSE;
+		/* name and value, each short enough for a config line */
+		for (i = 0; i < 2; i++) {
+			const UBYTE *z = (const UBYTE *)memchr(p, '\0', end - p);
+			if (z == NULL || z - p >= 256)
+				return FALSE;
+			p = z + 1;
+		}
+	}
+	return TRUE;
+}
+
+/* Applies the options of the snapshot, each straight to its handler */
+static void ApplySnapshot(void)
+{
+	const UBYTE *p = snapshot + SNAPSHOT_HEADER_SIZE;
+	const UBYTE *end = snapshot + snapshot_size;
+	char string[256];
+	char ptr[256];
+
+	while (p < end) {
+		int id = *p++;
+		Util_strlcpy(string, (const char *)p, sizeof(string));
+		p += strlen(string) + 1;
+		Util_strlcpy(ptr, (const char *)p, sizeof(ptr));
+		p += strlen(ptr) + 1;
+		if (!read_config[id](string, ptr))
+			UnrecognizedOption(string, ptr);
+	}
+}
+
+/* Reads a snapshot written by CFG_WriteSnapshot() */
+static int ReadSnapshot(const char *fname)
+{
+	FILE *fp = fopen(fname, "rb");
+	int size;
+
+	if (fp == NULL)
+		return FALSE;
+	size = Util_flen(fp);
+	if (size > snapshot_alloc) {
+		snapshot_alloc = size;
+		snapshot = (UBYTE *)Util_realloc(snapshot, snapshot_alloc);
+	}
+	rewind(fp);
+	snapshot_size = size > 0 && fread(snapshot, size, 1, fp) == 1 ? size : 0;
 	fclose(fp);
+	if (!SnapshotValid(snapshot, snapshot_size)) {
+		snapshot_size = 0;
+		return FALSE;
+	}
+	return TRUE;
+}
+
+/* Loads a text configuration file or a snapshot. A file loaded before and
+   unchanged since is not read again: its snapshot is applied. Returns FALSE
+   if the file cannot be opened. */
+static int LoadFile(const char *fname)
+{
+	FILE *fp;
+	char string[256];
+#ifdef CFG_CACHE
+	struct stat st;
+	int have_stat = stat(fname, &st) == 0;
+
+	if (have_stat && snapshot_size > 0 && strcmp(fname, snapshot_filename) == 0
+	    && (long)st.st_size == snapshot_file_size && (long)st.st_mtime == snapshot_file_mtime) {
+		Log_print("Using Atari800 config file: %s (unchanged)", fname);
+		ApplySnapshot();
+		return TRUE;
+	}
+	snapshot_filename[0] = '\0';
+#endif
+
+	fp = fopen(fname, "r");
+	if (fp == NULL)
+		return FALSE;
+
+	string[0] = '\0';
+	if (fgets(string, sizeof(string), fp) != NULL
+	    && strncmp(string, SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_SIZE) == 0) {
+		fclose(fp);
+		if (!ReadSnapshot(fname)) {
+			Log_print("Config snapshot %s is invalid or from another build", fname);
+			return TRUE;
+		}
+		Log_print("Using Atari800 config snapshot: %s", fname);
+		ApplySnapshot();
+	}
+	else {
+		if (string[0] != '\0')
+			Log_print("Using Atari800 config file: %s\nCreated by %s", fname, string);
+		ParseText(fp);
+		fclose(fp);
+	}
+
+#ifdef CFG_CACHE
+	if (have_stat) {
+		Util_strlcpy(snapshot_filename, fname, FILENAME_MAX);
+		snapshot_file_size = (long)st.st_size;
+		snapshot_file_mtime = (long)st.st_mtime;
+	}
+#endif
+	return TRUE;
+}
+
+int CFG_LoadConfig(const char *alternate_config_filename)
+{
+	const char *fname = rtconfig_filename;
+
+#ifdef SUPPORTS_PLATFORM_CONFIGINIT
+	PLATFORM_ConfigInit();
+#endif
+#ifndef BASIC
+	was_obsolete_dir = FALSE;
+#endif
+
+	/* if alternate config filename is passed then use it */
+	if (alternate_config_filename != NULL && *alternate_config_filename > 0) {
+		Util_strlcpy(rtconfig_filename, alternate_config_filename, FILENAME_MAX);
+	}
+	/* else use the default config name under the HOME folder */
+	else {
+		char *home = getenv("HOME");
+		if (home != NULL)
+			Util_catpath(rtconfig_filename, home, DEFAULT_CFG_NAME);
+		else
+			strcpy(rtconfig_filename, DEFAULT_CFG_NAME);
+	}
+
+	if (!LoadFile(fname)) {
+		Log_print("User config file '%s' not found.", rtconfig_filename);
+
+#ifdef SYSTEM_WIDE_CFG_FILE
+		/* try system wide config file */
+		fname = SYSTEM_WIDE_CFG_FILE;
+		Log_print("Trying system wide config file: %s", fname);
+		if (!LoadFile(fname))
+#endif
+		{
+			Log_print("No configuration file found, will create fresh one from scratch:");
+			snapshot_size = 0;
+			return FALSE;
+		}
+	}
+
 #ifndef BASIC
 	if (was_obsolete_dir) {
 		Log_print(
@@ -366,6 +561,54 @@ int CFG_LoadConfig(const char *alternate_config_filename)
 	return TRUE;
 }
 
+const unsigned char *CFG_GetSnapshot(int *size)
+{
+	*size = snapshot_size;
+	return snapshot_size > 0 ? snapshot : NULL;
+}
+
+int CFG_ApplySnapshot(const unsigned char *data, int size)
+{
+	if (!SnapshotValid(data, size))
+		return FALSE;
+	if (data != snapshot) {
+		if (size > snapshot_alloc) {
+			snapshot_alloc = size;
+			snapshot = (UBYTE *)Util_realloc(snapshot, snapshot_alloc);
+		}
+		memcpy(snapshot, data, size);
+		snapshot_size = size;
+#ifdef CFG_CACHE
+		snapshot_filename[0] = '\0';
+#endif
+	}
+#ifdef SUPPORTS_PLATFORM_CONFIGINIT
+	PLATFORM_ConfigInit();
+#endif
+	ApplySnapshot();
+	return TRUE;
+}
+
+int CFG_WriteSnapshot(const char *filename)
+{
+	FILE *fp;
+
+	if (snapshot_size == 0) {
+		Log_print("No configuration loaded to write to %s", filename);
+		return FALSE;
+	}
+	fp = fopen(filename, "wb");
+	if (fp == NULL || fwrite(snapshot, snapshot_size, 1, fp) != 1) {
+		Log_print("Cannot write config snapshot: %s", filename);
+		if (fp != NULL)
+			fclose(fp);
+		return FALSE;
+	}
+	fclose(fp);
+	Log_print("Writing config snapshot: %s", filename);
+	return TRUE;
+}
+
 int CFG_WriteConfig(void)
 {
 	FILE *fp;
@@ -427,6 +670,9 @@ int CFG_WriteConfig(void)
 
 	fprintf(fp, "DISABLE_BASIC=%d\n", Atari800_disable_basic);
 	fprintf(fp, "TURBO_SPEED=%d\n", Atari800_turbo_speed);
+	fprintf(fp, "SYNC_SPIN=%d\n", Atari800_sync_spin);
+	fprintf(fp, "RUN_AHEAD=%d\n", Atari800_run_ahead);
+	fprintf(fp, "QUICK_BOOT=%d\n", Atari800_quick_boot);
 	fprintf(fp, "ENABLE_SIO_PATCH=%d\n", ESC_enable_sio_patch);
 	fprintf(fp, "ENABLE_SLOW_XEX_LOADING=%d\n", BINLOAD_slow_xex_loading);
 	fprintf(fp, "ENABLE_H_PATCH=%d\n", Devices_enable_h_patch);
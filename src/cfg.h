@@ -1,9 +1,23 @@
 #ifndef CFG_H_
 #define CFG_H_
 
-/* Load Atari800 text configuration file. */
+/* Load Atari800 text configuration file, or a snapshot from
+   CFG_WriteSnapshot(). A file loaded before is not read again while its
+   size and modification time stay the same. */
 int CFG_LoadConfig(const char *alternate_config_filename);
 
+/* The configuration last loaded, in a compact binary form that
+   CFG_ApplySnapshot() and CFG_LoadConfig() apply without parsing text; it
+   holds for this build only. Returns NULL if no configuration was loaded. */
+const unsigned char *CFG_GetSnapshot(int *size);
+
+/* Applies a configuration got from CFG_GetSnapshot() as if its file was
+   loaded. Returns FALSE if DATA is not a snapshot of this build. */
+int CFG_ApplySnapshot(const unsigned char *data, int size);
+
+/* Writes CFG_GetSnapshot() to FILENAME, which -config then accepts. */
+int CFG_WriteSnapshot(const char *filename);
+
 /* Writes Atari800 text configuration file. */
 int CFG_WriteConfig(void);
 
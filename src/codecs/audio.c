@@ -33,6 +33,7 @@
 #include "sound.h"
 #include "pokeysnd.h"
 #include "file_export.h"
+#include "resample.h"
 
 #include "codecs/audio.h"
 #include "codecs/audio_pcm.h"
@@ -59,6 +60,12 @@ UBYTE *audio_buffer = NULL;
 
 static AUDIO_CODEC_t *requested_audio_codec = NULL;
 
+/* Converts the samples to -ar for the codecs that do not resample
+   themselves */
+static RESAMPLE_t *resampler = NULL;
+static UBYTE *resample_buffer = NULL;
+static int resample_buffer_size = 0;
+
 static AUDIO_CODEC_t *known_audio_codecs[] = {
 	&Audio_Codec_PCM,
 #ifdef AUDIO_CODEC_MP3
@@ -73,9 +80,9 @@ static AUDIO_CODEC_t *known_audio_codecs[] = {
 	NULL,
 };
 
+int audio_param_samplerate = -1;
 #ifdef AUDIO_CODEC_MP3
 int audio_param_bitrate = 128;
-int audio_param_samplerate = -1;
 int audio_param_quality = 4;
 #endif
 
@@ -139,22 +146,22 @@ int CODECS_AUDIO_Initialise(int *argc, char *argv[])
 			}
 			else a_m = TRUE;
 		}
-#ifdef AUDIO_CODEC_MP3
-		else if (strcmp(argv[i], "-ab") == 0) {
+		else if (strcmp(argv[i], "-ar") == 0) {
 			if (i_a) {
-				audio_param_bitrate = Util_sscandec(argv[++i]);
-				if (audio_param_bitrate < 8 || audio_param_bitrate > 320) {
-					Log_print("Invalid bitrate; must be between 8 and 320 kbps");
+				audio_param_samplerate = Util_sscandec(argv[++i]);
+				if (audio_param_samplerate < 8000 || audio_param_samplerate > 48000) {
+					Log_print("Invalid output samplerate; must be between 8000 and 48000 Hz");
 					return FALSE;
 				}
 			}
 			else a_m = TRUE;
 		}
-		else if (strcmp(argv[i], "-ar") == 0) {
+#ifdef AUDIO_CODEC_MP3
+		else if (strcmp(argv[i], "-ab") == 0) {
 			if (i_a) {
-				audio_param_samplerate = Util_sscandec(argv[++i]);
-				if (audio_param_samplerate < 8000 || audio_param_samplerate > 48000) {
-					Log_print("Invalid output samplerate; must be between 8000 and 48000 Hz");
+				audio_param_bitrate = Util_sscandec(argv[++i]);
+				if (audio_param_bitrate < 8 || audio_param_bitrate > 320) {
+					Log_print("Invalid bitrate; must be between 8 and 320 kbps");
 					return FALSE;
 				}
 			}
@@ -176,9 +183,9 @@ int CODECS_AUDIO_Initialise(int *argc, char *argv[])
 				char buf[256];
 				Log_print(audio_codec_args(buf));
 				Log_print("\t                 Select audio codec (default: auto)");
+				Log_print("\t-ar <num>        Set audio recording sample rate in Hz (8000..48000, default: same as -dsprate)");
 #ifdef AUDIO_CODEC_MP3
 				Log_print("\t-ab <num>        Set audio recording bitrate in kbps (8..320, default: 128)");
-				Log_print("\t-ar <num>        Set audio recording sample rate in Hz (8000..48000, default: same as -dsprate)");
 				Log_print("\t-aq <num>        Set audio recording quality (0..9, default 5)");
 #endif
 			}
@@ -241,6 +248,7 @@ int CODECS_AUDIO_CheckType(char *codec_id)
 int CODECS_AUDIO_Init(void)
 {
 	int sample_size;
+	int sample_rate;
 	float fps;
 
 	if (!audio_codec) {
@@ -259,11 +267,31 @@ int CODECS_AUDIO_Init(void)
 	}
 
 	fps = Atari800_tv_mode == Atari800_TV_PAL ? Atari800_FPS_PAL : Atari800_FPS_NTSC;
-	audio_buffer_size = audio_codec->init(POKEYSND_playback_freq, fps, sample_size, POKEYSND_num_pokeys);
+	sample_rate = POKEYSND_playback_freq;
+	if (audio_param_samplerate > 0 && audio_param_samplerate != POKEYSND_playback_freq
+#ifdef AUDIO_CODEC_MP3
+	    && audio_codec != &Audio_Codec_MP3 /* LAME resamples by itself */
+#endif
+	    ) {
+		resampler = RESAMPLE_New(POKEYSND_playback_freq, audio_param_samplerate, POKEYSND_num_pokeys,
+		                         sample_size, RESAMPLE_QUALITY_MAX);
+		sample_rate = audio_param_samplerate;
+	}
+	audio_buffer_size = audio_codec->init(sample_rate, fps, sample_size, POKEYSND_num_pokeys);
 	if (audio_buffer_size < 0) {
 		File_Export_SetErrorMessageArg("Failed init of %s codec", audio_codec->codec_id);
+		RESAMPLE_Free(resampler);
+		resampler = NULL;
 		return 0;
 	}
+	if (resampler) {
+		/* The frames may come out a sample or two longer than the codec
+		   expects */
+		int frame_samples = ((int)(POKEYSND_playback_freq / fps) + 2) * POKEYSND_num_pokeys;
+		int max_size = RESAMPLE_MaxOutput(resampler, frame_samples) * sample_size;
+		if (audio_buffer_size < max_size)
+			audio_buffer_size = max_size;
+	}
 	audio_buffer = (UBYTE *)Util_malloc(audio_buffer_size);
 	audio_out = audio_codec->audio_out();
 
@@ -279,5 +307,27 @@ void CODECS_AUDIO_End(void)
 		audio_buffer_size = 0;
 		audio_buffer = NULL;
 	}
+	if (resampler) {
+		RESAMPLE_Free(resampler);
+		resampler = NULL;
+		free(resample_buffer);
+		resample_buffer = NULL;
+		resample_buffer_size = 0;
+	}
 	audio_codec = NULL;
 }
+
+const UBYTE *CODECS_AUDIO_Resample(const UBYTE *buf, int *num_samples)
+{
+	int size;
+
+	if (!resampler || !buf)
+		return buf;
+	size = RESAMPLE_MaxOutput(resampler, *num_samples) * (POKEYSND_snd_flags & POKEYSND_BIT16 ? 2 : 1);
+	if (size > resample_buffer_size) {
+		resample_buffer_size = size;
+		resample_buffer = (UBYTE *)Util_realloc(resample_buffer, size);
+	}
+	*num_samples = RESAMPLE_Process(resampler, buf, *num_samples, resample_buffer);
+	return resample_buffer;
+}
@@ -76,9 +76,9 @@ extern AUDIO_OUT_t *audio_out;
 extern int audio_buffer_size;
 extern UBYTE *audio_buffer;
 
+extern int audio_param_samplerate;
 #ifdef AUDIO_CODEC_MP3
 extern int audio_param_bitrate;
-extern int audio_param_samplerate;
 extern int audio_param_quality;
 #endif
 
@@ -89,6 +89,11 @@ int CODECS_AUDIO_CheckType(char *codec_id);
 int CODECS_AUDIO_Init(void);
 void CODECS_AUDIO_End(void);
 
+/* Convert NUM_SAMPLES sample values in BUF to the -ar rate when the codec
+   needs it done. Returns the samples to encode, BUF itself if there is
+   nothing to convert, and updates NUM_SAMPLES. */
+const UBYTE *CODECS_AUDIO_Resample(const UBYTE *buf, int *num_samples);
+
 
 #endif /* CODECS_AUDIO_H_ */
 
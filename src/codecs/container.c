@@ -27,6 +27,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "screen.h"
 #include "util.h"
 #include "log.h"
@@ -43,8 +44,11 @@
 #ifdef VIDEO_RECORDING
 #include "codecs/video.h"
 #include "codecs/container_avi.h"
+#include "codecs/container_a8f.h"
 #endif
 
+#define CONTAINER_BUFFER_SIZE (1024 * 1024)
+
 /* Global pointer to current multimedia container, or NULL if one has not been
    initialized. This pointer should not be used after a call to
    container->close(). */
@@ -78,6 +82,7 @@ static CONTAINER_t *known_containers[] = {
 #endif
 #ifdef VIDEO_RECORDING
 	&Container_AVI,
+	&Container_A8F,
 #endif
 	NULL,
 };
@@ -88,6 +93,13 @@ static FILE *fp = NULL;
    (only the differences from the previous frame) */
 static int keyframe_count;
 
+/* The last screen encoded, to skip the ones that are the same */
+static UBYTE *last_screen = NULL;
+static int last_screen_valid;
+
+/* The machine state of a frame taken in CONTAINER_AddVideoFrame */
+static UBYTE *frame_data_buffer = NULL;
+
 /* audio statistics */
 static ULONG audio_frame_count;
 static ULONG total_audio_size;
@@ -134,6 +146,10 @@ static int close_codecs(void)
 		CODECS_VIDEO_End();
 		video_codec = NULL;
 	}
+	free(last_screen);
+	last_screen = NULL;
+	free(frame_data_buffer);
+	frame_data_buffer = NULL;
 #endif
 #ifdef AUDIO_RECORDING
 	if (audio_codec) {
@@ -162,6 +178,7 @@ int CONTAINER_Open(const char *filename)
 		byteswritten = 0;
 
 		keyframe_count = 0; /* force first frame to be keyframe */
+		last_screen_valid = FALSE;
 
 		/* video statistics */
 		video_frame_count = 0;
@@ -176,7 +193,7 @@ int CONTAINER_Open(const char *filename)
 		largest_audio_frame = 0;
 
 #ifdef AUDIO_RECORDING
-		if (Sound_enabled) {
+		if (Sound_enabled && container->audio_frame) {
 			if (!CODECS_AUDIO_Init()) {
 				/* error message set in codec */
 				Log_print(FILE_EXPORT_error_message);
@@ -189,6 +206,9 @@ int CONTAINER_Open(const char *filename)
 #endif
 #ifdef VIDEO_RECORDING
 		if (container->video_frame) {
+			/* A8F files hold the screens as they are */
+			if (container == &Container_A8F)
+				video_codec = &Video_Codec_RAW;
 			if (!CODECS_VIDEO_Init()) {
 				/* error message set in codec */
 				Log_print(FILE_EXPORT_error_message);
@@ -218,6 +238,9 @@ int CONTAINER_Open(const char *filename)
 #endif
 		fp = fopen(filename, "wb");
 		if (fp) {
+			/* Containers write a frame in many small pieces; they reach the
+			   file in blocks of this size */
+			setvbuf(fp, NULL, _IOFBF, CONTAINER_BUFFER_SIZE);
 			if (!container->prepare(fp)) {
 				/* error message set in container */
 				Log_print(FILE_EXPORT_error_message);
@@ -249,6 +272,7 @@ int CONTAINER_AddAudioSamples(const UBYTE *buf, int num_samples)
 
 	if (!fp || !audio_codec) return 0;
 
+	buf = CODECS_AUDIO_Resample(buf, &num_samples);
 	if (!buf) {
 		/* This happens at file close time, checking if audio codec has samples
 		   remaining */
@@ -312,37 +336,93 @@ int CONTAINER_AddAudioSamples(const UBYTE *buf, int num_samples)
 #endif
 
 #ifdef VIDEO_RECORDING
-int CONTAINER_AddVideoFrame(void)
+int CONTAINER_FrameDataSize(void)
+{
+	if (!fp || !container->frame_data_size) return 0;
+	return container->frame_data_size();
+}
+
+void CONTAINER_CaptureFrameData(UBYTE *buf)
+{
+	if (fp && container->capture_frame_data)
+		container->capture_frame_data(buf);
+}
+
+/* Writes the video frame in video_buffer and the machine state that goes
+   with it */
+static int save_video_frame(int size, int is_keyframe, const UBYTE *frame_data)
+{
+	int result = container->video_frame(fp, video_buffer, size, is_keyframe);
+	if (result && container->save_frame_data)
+		result = container->save_frame_data(fp, frame_data);
+	return result;
+}
+
+int CONTAINER_AddVideoFrame(const UBYTE *screen, const UBYTE *frame_data)
 {
 	int size;
 	int result;
 	int is_keyframe;
+	int keyframe_due;
 
 	if (!fp || !video_codec) return 0;
 
+	if (screen == NULL) {
+		/* A dropped frame: nothing changes, not even the distance to the
+		   next keyframe */
+		result = save_video_frame(0, FALSE, frame_data);
+		if (result) {
+			video_frame_count++;
+			smallest_video_frame = 0;
+		}
+		return result;
+	}
+
+	if (frame_data == NULL && container->capture_frame_data) {
+		if (frame_data_buffer == NULL)
+			frame_data_buffer = (UBYTE *)Util_malloc(container->frame_data_size());
+		container->capture_frame_data(frame_data_buffer);
+		frame_data = frame_data_buffer;
+	}
+
 	/* When a codec uses interframes (deltas from the previous frame), a
 	   keyframe is needed every keyframe interval. */
-	if (video_codec->uses_interframes) {
-		keyframe_count--;
-		if (keyframe_count <= 0) {
-			is_keyframe = TRUE;
-			keyframe_count = video_codec_keyframe_interval;
-		}
-		else {
-			is_keyframe = FALSE;
-		}
+	keyframe_count--;
+	keyframe_due = keyframe_count <= 0;
+	if (keyframe_due) {
+		keyframe_count = video_codec_keyframe_interval;
 	}
-	else {
-		is_keyframe = TRUE;
+	is_keyframe = video_codec->uses_interframes ? keyframe_due : TRUE;
+
+	/* A screen the same as the last is not encoded but written as an
+	   empty frame, except where a keyframe is due so the video can still
+	   be played from there. */
+	if (video_codec_skip_unchanged) {
+		if (!keyframe_due && last_screen_valid && memcmp(screen, last_screen, Screen_WIDTH * Screen_HEIGHT) == 0) {
+			result = save_video_frame(0, FALSE, frame_data);
+			if (result) {
+				video_frame_count++;
+				smallest_video_frame = 0;
+				result = container->size_check(ftell(fp));
+				if (!result) {
+					Log_print("%s maximum file size reached, closing file", container->container_id);
+				}
+			}
+			return result;
+		}
+		if (last_screen == NULL)
+			last_screen = (UBYTE *)Util_malloc(Screen_WIDTH * Screen_HEIGHT);
+		memcpy(last_screen, screen, Screen_WIDTH * Screen_HEIGHT);
+		last_screen_valid = TRUE;
 	}
 
-	size = video_codec->frame((UBYTE *)Screen_atari, is_keyframe, video_buffer, video_buffer_size);
+	size = video_codec->frame((UBYTE *)screen, is_keyframe, video_buffer, video_buffer_size);
 	if (size < 0) {
 		/* failed creating video frame; force close of file */
 		Log_print("video codec %s failed encoding frame", video_codec->codec_id);
 		return 0;
 	}
-	result = container->video_frame(fp, video_buffer, size, is_keyframe);
+	result = save_video_frame(size, is_keyframe, frame_data);
 	if (result) {
 		/* update statistics */
 		byteswritten += size;
@@ -18,6 +18,13 @@ typedef int (*CONTAINER_SizeCheck)(int current_size);
 /* Create a valid file by forcing any final data to be written to the file */
 typedef int (*CONTAINER_Finalize)(FILE *fp);
 
+/* Containers that record machine state with each video frame: the size of
+   that state, taking it at the end of the frame, and saving it after the
+   video frame it goes with */
+typedef int (*CONTAINER_GetFrameDataSize)(void);
+typedef void (*CONTAINER_TakeFrameData)(UBYTE *buf);
+typedef int (*CONTAINER_SaveFrameData)(FILE *fp, const UBYTE *buf);
+
 typedef struct {
     char *container_id;
     char *description;
@@ -26,6 +33,9 @@ typedef struct {
     CONTAINER_SaveVideoFrame video_frame;
     CONTAINER_SizeCheck size_check;
     CONTAINER_Finalize finalize;
+    CONTAINER_GetFrameDataSize frame_data_size;     /* optional */
+    CONTAINER_TakeFrameData capture_frame_data;
+    CONTAINER_SaveFrameData save_frame_data;
 } CONTAINER_t;
 
 /* RIFF files (WAV, AVI) are limited to 4GB in size, so define a reasonable max
@@ -49,7 +59,16 @@ int CONTAINER_Open(const char *filename);
 int CONTAINER_AddAudioSamples(const UBYTE *buf, int num_samples);
 #endif
 #ifdef VIDEO_RECORDING
-int CONTAINER_AddVideoFrame(void);
+/* Bytes of machine state the container records with each video frame, 0
+   for none, and taking them into BUF at the end of a frame */
+int CONTAINER_FrameDataSize(void);
+void CONTAINER_CaptureFrameData(UBYTE *buf);
+
+/* Encodes SCREEN, Screen_WIDTH * Screen_HEIGHT palette indices, or with
+   NULL writes an empty frame that players show as a repeat of the last.
+   FRAME_DATA is the frame's machine state from CONTAINER_CaptureFrameData;
+   with NULL it is taken now, or repeated for an empty frame. */
+int CONTAINER_AddVideoFrame(const UBYTE *screen, const UBYTE *frame_data);
 #endif
 int CONTAINER_Close(int file_ok);
 
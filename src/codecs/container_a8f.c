@@ -0,0 +1,320 @@
+/*
+ * container_a8f.c - raw frame dumps for machine learning datasets
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+/* This file is only compiled when VIDEO_RECORDING is defined.
+
+   An A8F file holds the screen of every frame as palette indices, with no
+   compression, so it can be mapped into memory and used as an array
+   without decoding anything. All numbers are little-endian. It starts with
+   a header of A8F_HEADER_SIZE bytes:
+
+     0    "A8F1"
+     4    u32 header size
+     8    u32 record size
+     12   u32 frames, updated as the file is written
+     16   u16 width, u16 height of the screen
+     20   u32 offset of the memory in a record, u32 its size (0: none)
+     28   u32 offset of the input in a record, u32 its size
+     36   u32 frames per second * 1000
+     40   u32 scan lines per frame (312 PAL, 262 NTSC)
+     64   256 x (u8 red, green, blue): the palette
+
+   followed by one record per frame, each record size bytes with no
+   padding: the screen, width * height bytes of palette indices row by row
+   (the area video recordings show); then the first A8F_ram_size bytes of
+   memory as the frame ends (-a8f-ram); then the input of the frame, four
+   bytes: PORTA (both joysticks), TRIG0, the key code (AKEY_NONE is 0xff)
+   and the console keys. In numpy:
+
+     h = np.fromfile(f, '<u4', 11)
+     width, height = int(h[4] & 0xffff), int(h[4] >> 16)
+     records = np.memmap(f, np.uint8, 'r', int(h[1]), (int(h[3]), int(h[2])))
+     screens = records[:, :width * height].reshape(-1, height, width)
+
+   Records are collected into batches of about A8F_BATCH_SIZE bytes, each
+   written with one call at its place in the file, which is allocated ahead
+   in steps of A8F_ALLOCATE_SIZE so it does not fragment; the frame count in
+   the header follows each batch, so a file whose recording did not finish
+   holds the frames up to the last batch. The allocated space past the last
+   frame is cut off when the file is closed. */
+
+#define _POSIX_C_SOURCE 200809L /* for fileno, pwrite, posix_fallocate and ftruncate */
+
+#include "config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+#include <fcntl.h>
+#include <sys/types.h>
+#include "atari.h"
+#include "colours.h"
+#include "gtia.h"
+#include "input.h"
+#include "memory.h"
+#include "pia.h"
+#include "util.h"
+#include "log.h"
+#include "file_export.h"
+#include "codecs/image.h"
+#include "codecs/video.h"
+#include "codecs/container.h"
+#include "codecs/container_a8f.h"
+
+#define A8F_HEADER_SIZE 832
+#define A8F_INPUT_SIZE 4
+#define A8F_BATCH_SIZE (4 * 1024 * 1024)
+#define A8F_ALLOCATE_SIZE ((off_t) 64 * 1024 * 1024)
+
+int A8F_ram_size = 0;
+
+static int ram_size;        /* of the file being written */
+static int screen_size;
+static int record_size;
+static UBYTE *batch = NULL;
+static int batch_records;   /* records a batch holds */
+static int num_records;     /* in the batch */
+static ULONG frames_written;
+static off_t allocated;
+static UBYTE *last_record = NULL;   /* for frames that repeat the one before */
+static int last_record_valid;
+
+/* The screens go into the file as they are: this codec only cuts out the
+   area that video recordings show. It is not offered by -vcodec. */
+static int raw_width;
+static int raw_height;
+static int raw_left;
+static int raw_top;
+
+static int RAW_Init(int width, int height, int left_margin, int top_margin)
+{
+	raw_width = width;
+	raw_height = height;
+	raw_left = left_margin;
+	raw_top = top_margin;
+	return width * height;
+}
+
+static int RAW_CreateFrame(UBYTE *source, int keyframe, UBYTE *buf, int bufsize)
+{
+	int y;
+
+	if (bufsize < raw_width * raw_height)
+		return -1;
+	source += raw_top * Screen_WIDTH + raw_left;
+	for (y = 0; y < raw_height; y++) {
+		memcpy(buf, source, raw_width);
+		buf += raw_width;
+		source += Screen_WIDTH;
+	}
+	return raw_width * raw_height;
+}
+
+static int RAW_End(void)
+{
+	return 1;
+}
+
+VIDEO_CODEC_t Video_Codec_RAW = {
+	"raw",
+	"Palette indices",
+	{'r', 'a', 'w', ' '},
+	{0, 0, 0, 0},
+	FALSE,
+	&RAW_Init,
+	&RAW_CreateFrame,
+	&RAW_End,
+};
+
+static void put_le(UBYTE *p, ULONG value, int bytes)
+{
+	while (bytes-- > 0) {
+		*p++ = (UBYTE) (value & 0xff);
+		value >>= 8;
+	}
+}
+
+/* Writes SIZE bytes at OFFSET in the file */
+static int write_at(FILE *fp, const UBYTE *buf, size_t size, off_t offset)
+{
+#ifdef HAVE_PWRITE
+	int fd = fileno(fp);
+	while (size > 0) {
+		ssize_t n = pwrite(fd, buf, size, offset);
+		if (n <= 0)
+			return FALSE;
+		buf += n;
+		size -= n;
+		offset += n;
+	}
+	return TRUE;
+#else
+	return fseek(fp, (long) offset, SEEK_SET) == 0 && fwrite(buf, 1, size, fp) == size;
+#endif
+}
+
+static int write_frame_count(FILE *fp)
+{
+	UBYTE count[4];
+	put_le(count, frames_written, 4);
+	return write_at(fp, count, 4, 12);
+}
+
+static int flush_batch(FILE *fp)
+{
+	off_t offset = A8F_HEADER_SIZE + (off_t) frames_written * record_size;
+	off_t end = offset + (off_t) num_records * record_size;
+
+	if (num_records == 0)
+		return TRUE;
+#ifdef HAVE_POSIX_FALLOCATE
+	if (end > allocated) {
+		allocated = end + A8F_ALLOCATE_SIZE;
+		/* Only a hint: where it fails, the writes still extend the file */
+		posix_fallocate(fileno(fp), 0, allocated);
+	}
+#endif
+	if (!write_at(fp, batch, (size_t) num_records * record_size, offset))
+		return FALSE;
+	frames_written += num_records;
+	num_records = 0;
+	return write_frame_count(fp);
+}
+
+static int A8F_Prepare(FILE *fp)
+{
+	UBYTE header[A8F_HEADER_SIZE];
+	int i;
+
+	ram_size = A8F_ram_size;
+	screen_size = image_codec_width * image_codec_height;
+	record_size = screen_size + ram_size + A8F_INPUT_SIZE;
+	batch_records = A8F_BATCH_SIZE / record_size;
+	if (batch_records < 1)
+		batch_records = 1;
+	num_records = 0;
+	frames_written = 0;
+	allocated = 0;
+	last_record_valid = FALSE;
+
+	memset(header, 0, sizeof(header));
+	memcpy(header, "A8F1", 4);
+	put_le(header + 4, A8F_HEADER_SIZE, 4);
+	put_le(header + 8, record_size, 4);
+	put_le(header + 16, image_codec_width, 2);
+	put_le(header + 18, image_codec_height, 2);
+	put_le(header + 20, screen_size, 4);
+	put_le(header + 24, ram_size, 4);
+	put_le(header + 28, screen_size + ram_size, 4);
+	put_le(header + 32, A8F_INPUT_SIZE, 4);
+	put_le(header + 36, (ULONG) (fps * 1000 + 0.5), 4);
+	put_le(header + 40, Atari800_tv_mode, 4);
+	for (i = 0; i < 256; i++) {
+		header[64 + 3 * i] = Colours_GetR(i);
+		header[64 + 3 * i + 1] = Colours_GetG(i);
+		header[64 + 3 * i + 2] = Colours_GetB(i);
+	}
+	if (!write_at(fp, header, sizeof(header), 0)) {
+		File_Export_SetErrorMessage("Failed writing A8F header");
+		return 0;
+	}
+	byteswritten = A8F_HEADER_SIZE;
+
+	batch = (UBYTE *)Util_malloc((size_t) batch_records * record_size);
+	last_record = (UBYTE *)Util_malloc(record_size);
+	return 1;
+}
+
+/* Puts the screen in the next record; A8F_SaveFrameData completes it */
+static int A8F_VideoFrame(FILE *fp, const UBYTE *buf, int bufsize, int is_keyframe)
+{
+	UBYTE *record = batch + (size_t) num_records * record_size;
+
+	if (bufsize == screen_size)
+		memcpy(record, buf, screen_size);
+	else {
+		/* An empty frame repeats the last */
+		if (last_record_valid)
+			memcpy(record, last_record, screen_size);
+		else
+			memset(record, 0, screen_size);
+		byteswritten += screen_size;
+	}
+	return TRUE;
+}
+
+static int A8F_FrameDataSize(void)
+{
+	return ram_size + A8F_INPUT_SIZE;
+}
+
+static void A8F_CaptureFrameData(UBYTE *buf)
+{
+	memcpy(buf, MEMORY_mem, ram_size);
+	buf += ram_size;
+	buf[0] = PIA_PORT_input[0];
+	buf[1] = GTIA_TRIG[0];
+	buf[2] = (UBYTE) INPUT_key_code;
+	buf[3] = (UBYTE) INPUT_key_consol;
+}
+
+static int A8F_SaveFrameData(FILE *fp, const UBYTE *buf)
+{
+	UBYTE *record = batch + (size_t) num_records * record_size;
+
+	if (buf != NULL)
+		memcpy(record + screen_size, buf, ram_size + A8F_INPUT_SIZE);
+	else if (last_record_valid)
+		memcpy(record + screen_size, last_record + screen_size, ram_size + A8F_INPUT_SIZE);
+	else
+		memset(record + screen_size, 0, ram_size + A8F_INPUT_SIZE);
+	memcpy(last_record, record, record_size);
+	last_record_valid = TRUE;
+	byteswritten += ram_size + A8F_INPUT_SIZE;
+	if (++num_records == batch_records)
+		return flush_batch(fp);
+	return TRUE;
+}
+
+static int A8F_SizeCheck(int size)
+{
+	/* The frame count is 32 bits, the file size is not limited */
+	return frames_written < 0xfff00000;
+}
+
+static int A8F_Finalize(FILE *fp)
+{
+	int result = flush_batch(fp);
+
+#ifdef HAVE_FTRUNCATE
+	/* Cut off the space allocated past the last frame */
+	if (result && allocated > 0)
+		result = ftruncate(fileno(fp), A8F_HEADER_SIZE + (off_t) frames_written * record_size) == 0;
+#endif
+	if (!result)
+		Log_print("Failed writing A8F frames");
+	free(batch);
+	batch = NULL;
+	free(last_record);
+	last_record = NULL;
+	return result;
+}
+
+CONTAINER_t Container_A8F = {
+	"a8f",
+	"Raw frames for datasets",
+	&A8F_Prepare,
+	NULL,
+	&A8F_VideoFrame,
+	&A8F_SizeCheck,
+	&A8F_Finalize,
+	&A8F_FrameDataSize,
+	&A8F_CaptureFrameData,
+	&A8F_SaveFrameData,
+};
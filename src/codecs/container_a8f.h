@@ -0,0 +1,16 @@
+#ifndef CODECS_CONTAINER_A8F_H_
+#define CODECS_CONTAINER_A8F_H_
+
+#include "atari.h"
+#include "codecs/container.h"
+#include "codecs/video.h"
+
+extern CONTAINER_t Container_A8F;
+
+/* Copies the screens into A8F files as they are */
+extern VIDEO_CODEC_t Video_Codec_RAW;
+
+/* Bytes of memory recorded with each frame, from address 0 */
+extern int A8F_ram_size;
+
+#endif /* CODECS_CONTAINER_A8F_H_ */
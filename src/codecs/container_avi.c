@@ -39,38 +39,38 @@
 #include "codecs/container_avi.h"
 
 
-/* AVI requires the header at the beginning of the file contains sizes of each
-   chunk, so the header will be rewritten upon the close of the file to update
-   the header values with the final totals. *;
-*/
-static ULONG size_riff;
-static ULONG size_movi;
-
-/* AVI files using the version 1.0 indexes ('idx1') have a 32 bit limit, which
-   limits file size to 4GB. Some media players may fail to play videos greater
-   than 2GB because of their incorrect use of signed rather than unsigned 32 bit
-   values.
-
-   The maximum recording duration depends mostly on the complexity of the video.
-   The audio is saved as raw PCM samples which doesn't vary per frame. On NTSC
-   at 60Hz using 16 bit samples, this will be just under 1500 bytes per frame.
-
-   The size of each encoded video frame depends on the complexity the screen
-   image. The RLE compression is based on scan lines, and performs best when
-   neighboring pixels on the scan line are the same color. Due to overhead in
-   the compression sceme itself, the best it can do is about 1500 bytes on a
-   completely black screen. Complex screens where many neighboring pixels have
-   different colors result in video frames of around 30k. This is still a
-   significant savings over an uncompressed frame which would be 80k.
-
-   For complex scenes, therefore, this results in about 8 minutes of video
-   recording per GB, or about 36 minutes when using the full 4GB file size. Less
-   complex video will provide more recording time. For example, recording the
-   unchanging BASIC prompt screen would result in about 6 hours of video.
-
-   The video will automatically be stopped should the recording length approach
-   the file size limit. */
-
+/* Files are written as OpenDML (AVI 2.0) AVIs, a series of RIFF chunks:
+   the first, 'AVI ', holds the header and the first stretch of audio and
+   video, and each after it, 'AVIX', up to another RIFF_SIZE_LIMIT bytes.
+   Every stream has a two-level index: standard index chunks ('ix00',
+   'ix01') written into the movi data as it goes, each listing the chunks
+   since the one before, and a super index ('indx') in the stream's header
+   that points to them, with room for SUPER_INDEX_ENTRIES. The first RIFF
+   also ends in an 'idx1' index for players that only know AVI 1.0.
+
+   Only the chunks since the last standard index are kept in memory. After
+   each one, every INDEX_INTERVAL video frames or about 20 seconds, the
+   header at the start of the file and that of the current RIFF are
+   rewritten with the sizes and lengths so far, and the file is flushed:
+   should the emulator crash, or the machine go down, the file plays up to
+   there. The data after it is past the end of the last RIFF, where
+   players do not look.
+
+   The maximum recording duration depends mostly on the complexity of the
+   video. The size of each encoded video frame depends on the complexity of
+   the screen image: complex screens compress with RLE to around 30k, so a
+   1GB RIFF holds about 8 minutes of them; simple ones much less. The file
+   size is limited only by the file system. The recording stops when the
+   super indexes are full, after SUPER_INDEX_ENTRIES * INDEX_INTERVAL video
+   frames, 11 hours at 50 frames per second. */
+
+#define RIFF_SIZE_LIMIT     0x40000000
+#define INDEX_INTERVAL      1000
+#define SUPER_INDEX_ENTRIES 2048
+#define IDX1_MAX_ENTRIES    (1 << 19)
+
+/* The first RIFF's 'idx1', two words per chunk: offset from 'movi', and
+   size and flags */
 #define FRAME_INDEX_ALLOC_SIZE 1000
 static int num_frames_allocated;
 static ULONG frames_written;
@@ -80,9 +80,67 @@ static ULONG *frame_indexes;
 #define AUDIO_FRAME_FLAG 0x40000000
 #define KEYFRAME_FLAG    0x80000000
 
-
+/* The two levels of one stream's OpenDML index */
+typedef struct {
+	const char *chunk_id;   /* '00dc' or '01wb' */
+	const char *index_id;   /* 'ix00' or 'ix01' */
+	ULONG length;           /* in stream units, so far */
+	ULONG indexed_length;   /* up to the last standard index */
+	/* Chunks since the last standard index, two words each: offset of
+	   the data from the start of the RIFF, and size, with the top bit set
+	   for chunks that are not keyframes */
+	ULONG *entries;
+	int num_entries;
+	int num_allocated;
+	/* Standard indexes written, four words each: 64 bit file offset, size
+	   and duration */
+	ULONG *super;
+	int num_super;
+} AVI_stream_index;
+
+static AVI_stream_index stream_index[2];
 static int num_streams;
 
+/* The current RIFF: where it starts in the file, as a 64 bit number in
+   two words, and its size so far */
+static ULONG riff_start_lo;
+static ULONG riff_start_hi;
+static ULONG riff_size;
+static int riff_count;
+
+/* The first RIFF: where its 'movi' is, and its sizes when it is done or
+   zero until then */
+static ULONG movi_start;
+static ULONG first_riff_size;
+static ULONG first_movi_size;
+static ULONG first_riff_frames;
+
+/* Written to the first header */
+static ULONG size_riff;
+static ULONG size_movi;
+
+
+/* AVI_WriteSuperIndex writes a stream's 'indx' chunk, always with room for
+   all entries so the header does not change size */
+static void AVI_WriteSuperIndex(FILE *fp, const AVI_stream_index *index)
+{
+	int i;
+
+	/* The format is documented in the OpenDML AVI File Format Extensions
+	   1.02, as AVISUPERINDEX */
+	fputs("indx", fp);
+	fputl(24 + 16 * SUPER_INDEX_ENTRIES, fp);
+	fputw(4, fp); /* words per entry */
+	fputc(0, fp); /* index subtype */
+	fputc(0, fp); /* index type: AVI_INDEX_OF_INDEXES */
+	fputl(index->num_super, fp); /* entries in use */
+	fputs(index->chunk_id, fp);
+	fputl(0, fp); /* reserved */
+	fputl(0, fp);
+	fputl(0, fp);
+	for (i = 0; i < 4 * SUPER_INDEX_ENTRIES; i++)
+		fputl(i < 4 * index->num_super ? index->super[i] : 0, fp);
+}
 
 /* AVI_WriteHeader creates and writes out the file header. Note that this
    function will have to be called again just prior to closing the file in order
@@ -99,19 +157,20 @@ static int AVI_WriteHeader(FILE *fp) {
 
 	/* RIFF AVI header */
 	fputs("RIFF", fp);
-	fputl(size_riff, fp); /* length of entire file minus 8 bytes */
+	fputl(size_riff, fp); /* length of the first RIFF minus 8 bytes */
 	fputs("AVI ", fp);
 
 	/* hdrl LIST. Payload size includes the 4 bytes of the 'hdrl' identifier. */
 	fputs("LIST", fp);
 
 	/* total header size includes hdrl identifier plus avih size PLUS the video stream
-	   header which is (strl header LIST + (strh + strf + strn)) */
-	list_size = 4 + 8 + 56 + (12 + (8 + 56 + 8 + 40 + 256*4 + 8 + 16));
+	   header which is (strl header LIST + (strh + strf + indx + strn)) PLUS the
+	   odml LIST */
+	list_size = 4 + 8 + 56 + (12 + (8 + 56 + 8 + 40 + 256*4 + 8 + 24 + 16 * SUPER_INDEX_ENTRIES + 8 + 16)) + 12 + 8 + 248;
 
 #ifdef AUDIO_RECORDING
-	/* if audio is included, add size of audio stream strl header LIST + (strh + strf + strn) */
-	if (num_streams == 2) list_size += 12 + (8 + 56 + 8 + 18 + audio_out->extra_data_size + 8 + 12);
+	/* if audio is included, add size of audio stream strl header LIST + (strh + strf + indx + strn) */
+	if (num_streams == 2) list_size += 12 + (8 + 56 + 8 + 18 + audio_out->extra_data_size + 8 + 24 + 16 * SUPER_INDEX_ENTRIES + 8 + 12);
 #endif
 
 	fputl(list_size, fp); /* length of header payload */
@@ -128,7 +187,7 @@ static int AVI_WriteHeader(FILE *fp) {
 	fputl(image_codec_width * image_codec_height * 3, fp); /* approximate bytes per second of video + audio FIXME: should likely be (width * height * 3 + audio) * fps */
 	fputl(0, fp); /* reserved */
 	fputl(0x10, fp); /* flags; 0x10 indicates the index at the end of the file */
-	fputl(video_frame_count, fp); /* number of frames in the video */
+	fputl(first_riff_frames, fp); /* number of frames in the first RIFF */
 	fputl(0, fp); /* initial frames, always zero for us */
 	fputl(num_streams, fp); /* 2 = video and audio, 1 = video only */
 	fputl(image_codec_width * image_codec_height * 3, fp); /* suggested buffer size */
@@ -142,9 +201,9 @@ static int AVI_WriteHeader(FILE *fp) {
 	/* video stream format */
 
 	/* 12 bytes for video stream strl LIST chuck header; LIST payload size includes the
-	   4 bytes of the 'strl' identifier plus the strh + strf + strn sizes */
+	   4 bytes of the 'strl' identifier plus the strh + strf + indx + strn sizes */
 	fputs("LIST", fp);
-	fputl(4 + 8 + 56 + 8 + 40 + 256*4 + 8 + 16, fp);
+	fputl(4 + 8 + 56 + 8 + 40 + 256*4 + 8 + 24 + 16 * SUPER_INDEX_ENTRIES + 8 + 16, fp);
 	fputs("strl", fp);
 
 	/* Stream header format is document at https://docs.microsoft.com/en-us/previous-versions/windows/desktop/api/avifmt/ns-avifmt-avistreamheader */
@@ -163,7 +222,7 @@ static int AVI_WriteHeader(FILE *fp) {
 	fputl(1000000, fp); /* scale */
 	fputl((ULONG)(fps * 1000000), fp); /* rate = frames per second / scale */
 	fputl(0, fp); /* start */
-	fputl(video_frame_count, fp); /* length (for video is number of frames) */
+	fputl(stream_index[0].length, fp); /* length (for video is number of frames) */
 	fputl(image_codec_width * image_codec_height * 3, fp); /* suggested buffer size */
 	fputl(0, fp); /* quality */
 	fputl(0, fp); /* sample size (0 = variable sample size) */
@@ -195,6 +254,9 @@ static int AVI_WriteHeader(FILE *fp) {
 		fputc(0, fp);
 	}
 
+	/* 8 + 24 + 16 * SUPER_INDEX_ENTRIES bytes for the super index */
+	AVI_WriteSuperIndex(fp, &stream_index[0]);
+
 	/* 8 bytes for stream name indicator */
 	fputs("strn", fp);
 	fputl(16, fp); /* length of name */
@@ -213,9 +275,9 @@ static int AVI_WriteHeader(FILE *fp) {
 		/* audio stream format */
 
 		/* 12 bytes for audio stream strl LIST chuck header; LIST payload size includes the
-		4 bytes of the 'strl' identifier plus the strh + strf + strn sizes */
+		4 bytes of the 'strl' identifier plus the strh + strf + indx + strn sizes */
 		fputs("LIST", fp);
-		fputl(4 + 8 + 56 + 8 + 18 + audio_out->extra_data_size + 8 + 12, fp);
+		fputl(4 + 8 + 56 + 8 + 18 + audio_out->extra_data_size + 8 + 24 + 16 * SUPER_INDEX_ENTRIES + 8 + 12, fp);
 		fputs("strl", fp);
 
 		/* stream header format is same as video above even when used for audio */
@@ -257,6 +319,9 @@ static int AVI_WriteHeader(FILE *fp) {
 			fwrite(audio_out->extra_data, audio_out->extra_data_size, 1, fp);
 		}
 
+		/* 8 + 24 + 16 * SUPER_INDEX_ENTRIES bytes for the super index */
+		AVI_WriteSuperIndex(fp, &stream_index[1]);
+
 		/* 8 bytes for stream name indicator */
 		fputs("strn", fp);
 		fputl(12, fp); /* length of name */
@@ -267,19 +332,70 @@ static int AVI_WriteHeader(FILE *fp) {
 	}
 #endif /* AUDIO_RECORDING */
 
+	/* 12 bytes for the OpenDML header LIST, and 8 + 248 for its extended
+	   AVI header, which holds the number of frames in the whole file */
+	fputs("LIST", fp);
+	fputl(4 + 8 + 248, fp);
+	fputs("odml", fp);
+	fputs("dmlh", fp);
+	fputl(248, fp);
+	fputl(stream_index[0].length, fp); /* total frames */
+	for (i = 0; i < 244; i++)
+		fputc(0, fp);
+
 	/* audia/video data */
 
 	/* 8 bytes for audio/video stream LIST chuck header; LIST payload is the
 	  'movi' chunk which in turn contains 00dc and 01wb chunks representing a
-	  frame of video and the corresponding audio. */
+	  frame of video and the corresponding audio, and the ix00 and ix01
+	  standard indexes. */
 	fputs("LIST", fp);
 	fputl(size_movi, fp); /* length of all video and audio chunks */
-	size_movi = ftell(fp); /* start of movi payload, will finalize after all chunks written */
+	movi_start = ftell(fp); /* start of movi payload */
 	fputs("movi", fp);
 
 	return (ftell(fp) == 12 + 8 + list_size + 12);
 }
 
+/* AVI_WriteRiffStart writes the start of a RIFF after the first: its
+   header and that of its movi LIST, with the sizes so far */
+static void AVI_WriteRiffStart(FILE *fp)
+{
+	fputs("RIFF", fp);
+	fputl(riff_size - 8, fp);
+	fputs("AVIX", fp);
+	fputs("LIST", fp);
+	fputl(riff_size - 20, fp);
+	fputs("movi", fp);
+}
+
+/* AVI_UpdateHeaders rewrites the file header and that of the current
+   RIFF with the sizes so far, and flushes the file, leaving it playable up
+   to here. RIFFs are smaller than 2GB, so even where long is 32 bits the
+   current one is reached from the end of the file. */
+static int AVI_UpdateHeaders(FILE *fp)
+{
+	if (first_riff_size == 0) {
+		size_riff = riff_size - 8;
+		size_movi = riff_size - movi_start;
+		first_riff_frames = stream_index[0].length;
+	}
+	else {
+		size_riff = first_riff_size - 8;
+		size_movi = first_movi_size;
+	}
+	if (!AVI_WriteHeader(fp))
+		return FALSE;
+	if (riff_count > 1) {
+		fseek(fp, 0, SEEK_END);
+		fseek(fp, -(long)riff_size, SEEK_CUR);
+		AVI_WriteRiffStart(fp);
+	}
+	fseek(fp, 0, SEEK_END);
+	fflush(fp);
+	return !ferror(fp);
+}
+
 /* AVI_Prepare will start a new video file and write out an initial copy of the
    header. Note that the file will not be valid until the it is closed with
    AVI_Finalize because the length information contained in the header must be
@@ -289,6 +405,8 @@ static int AVI_WriteHeader(FILE *fp) {
    */
 static int AVI_Prepare(FILE *fp)
 {
+	int i;
+
 #ifdef AUDIO_RECORDING
 	if (audio_codec) {
 		num_streams = 2;
@@ -300,67 +418,221 @@ static int AVI_Prepare(FILE *fp)
 	}
 
 	/* some variables must exist before the call to WriteHeader */
+	memset(stream_index, 0, sizeof(stream_index));
+	stream_index[0].chunk_id = "00dc";
+	stream_index[0].index_id = "ix00";
+	stream_index[1].chunk_id = "01wb";
+	stream_index[1].index_id = "ix01";
+	for (i = 0; i < num_streams; i++)
+		stream_index[i].super = (ULONG *)Util_malloc(4 * SUPER_INDEX_ENTRIES * sizeof(ULONG));
 	size_riff = 0;
 	size_movi = 0;
+	first_riff_size = 0;
+	first_movi_size = 0;
+	first_riff_frames = 0;
 	if (!AVI_WriteHeader(fp)) {
 		File_Export_SetErrorMessage("Failed writing AVI header");
+		for (i = 0; i < num_streams; i++)
+			free(stream_index[i].super);
 		return 0;
 	}
+	riff_start_lo = 0;
+	riff_start_hi = 0;
+	riff_size = movi_start + 4;
+	riff_count = 1;
 
 	/* set up video statistics */
 	frames_written = 0;
 
-	byteswritten = ftell(fp) + 8; /* current size + index header */
+	byteswritten = riff_size;
 
-	/* allocate space for index which is written at the end of the file */
+	/* allocate space for index which is written at the end of the first RIFF */
 	num_frames_allocated = FRAME_INDEX_ALLOC_SIZE;
-	frame_indexes = (ULONG *)Util_malloc(num_frames_allocated * sizeof(ULONG));
-	memset(frame_indexes, 0, num_frames_allocated * sizeof(ULONG));
+	frame_indexes = (ULONG *)Util_malloc(2 * num_frames_allocated * sizeof(ULONG));
 
 	return 1;
 }
 
+/* AVI_WriteStandardIndex writes the stream's chunks since its last
+   standard index as a new one, and adds that to its super index */
+static void AVI_WriteStandardIndex(FILE *fp, AVI_stream_index *index)
+{
+	ULONG size;
+	ULONG *super;
+	int i;
+
+	if (index->num_entries == 0)
+		return;
+	if (index->num_super == SUPER_INDEX_ENTRIES) {
+		/* AVI_SizeCheck stops the recording before this happens */
+		index->num_entries = 0;
+		return;
+	}
+	size = 24 + 8 * index->num_entries;
+	super = index->super + 4 * index->num_super++;
+	super[0] = riff_start_lo + riff_size; /* offset in the file */
+	super[1] = riff_start_hi + (super[0] < riff_start_lo);
+	super[2] = 8 + size;
+	super[3] = index->length - index->indexed_length; /* duration */
+
+	/* AVISTDINDEX in the OpenDML document; chunk offsets are to their
+	   data, from the start of the RIFF */
+	fputs(index->index_id, fp);
+	fputl(size, fp);
+	fputw(2, fp); /* words per entry */
+	fputc(0, fp); /* index subtype */
+	fputc(1, fp); /* index type: AVI_INDEX_OF_CHUNKS */
+	fputl(index->num_entries, fp); /* entries in use */
+	fputs(index->chunk_id, fp);
+	fputl(riff_start_lo, fp); /* base offset */
+	fputl(riff_start_hi, fp);
+	fputl(0, fp); /* reserved */
+	for (i = 0; i < 2 * index->num_entries; i++)
+		fputl(index->entries[i], fp);
+
+	riff_size += 8 + size;
+	byteswritten += 8 + size;
+	index->num_entries = 0;
+	index->indexed_length = index->length;
+}
+
+static int AVI_WriteIndex(FILE *fp) {
+	int i;
+	ULONG index;
+	int is_keyframe;
+
+	if (frames_written == 0) return 0;
+
+	/* The index format used here is tag 'idx1" (index version 1.0) & documented at
+	https://docs.microsoft.com/en-us/previous-versions/windows/desktop/api/Aviriff/ns-aviriff-avioldindex
+	*/
+
+	fputs("idx1", fp);
+	fputl(frames_written * 16, fp);
+
+	for (i = 0; i < frames_written; i++) {
+		index = frame_indexes[2 * i + 1];
+		is_keyframe = index & KEYFRAME_FLAG ? 0x10 : 0;
+		if (index & VIDEO_FRAME_FLAG)
+			fputs("00dc", fp); /* stream 0, a compressed video frame */
+		else
+			fputs("01wb", fp); /* stream 1, audio data */
+		fputl(is_keyframe, fp); /* flags: is a keyframe */
+		fputl(frame_indexes[2 * i], fp); /* offset in bytes from start of the 'movi' list */
+		fputl(index & FRAME_SIZE_MASK, fp); /* size of frame */
+	}
+
+	riff_size += 8 + frames_written * 16;
+	byteswritten += 8 + frames_written * 16;
+	return !ferror(fp);
+}
+
+/* AVI_EndRiff writes the standard indexes for what is left, and, if this
+   is the first RIFF, the idx1 index */
+static int AVI_EndRiff(FILE *fp)
+{
+	int i;
+
+	for (i = 0; i < num_streams; i++)
+		AVI_WriteStandardIndex(fp, &stream_index[i]);
+	if (riff_count > 1)
+		return TRUE;
+	first_movi_size = riff_size - movi_start;
+	first_riff_frames = stream_index[0].length;
+	if (!AVI_WriteIndex(fp))
+		return FALSE;
+	first_riff_size = riff_size;
+	free(frame_indexes);
+	frame_indexes = NULL;
+	num_frames_allocated = 0;
+	return TRUE;
+}
+
+/* AVI_NewRiff ends the current RIFF and starts an 'AVIX' one after it */
+static int AVI_NewRiff(FILE *fp)
+{
+	if (!AVI_EndRiff(fp) || !AVI_UpdateHeaders(fp))
+		return FALSE;
+	riff_start_lo += riff_size;
+	if (riff_start_lo < riff_size)
+		riff_start_hi++;
+	riff_count++;
+	riff_size = 24;
+	byteswritten += 24;
+	AVI_WriteRiffStart(fp);
+	return !ferror(fp);
+}
+
 /* AVI_WriteFrame writes out a single frame of video or audio, and saves the
-   index data for the end-of-file index chunk */
+   index data for the standard index and, in the first RIFF, the idx1
+   index */
 static int AVI_WriteFrame(FILE *fp, const UBYTE *buf, int size, int frame_type, int is_keyframe) {
 	int padding;
-	int frame_size;
-	int expected_frame_size;
-
-	frame_size = ftell(fp);
+	ULONG needed;
+	AVI_stream_index *index = &stream_index[frame_type == VIDEO_FRAME_FLAG ? 0 : 1];
+	int i;
 
 	/* AVI chunks must be word-aligned, i.e. lengths must be multiples of 2 bytes.
 	   If the size is an odd number, the data is padded with a zero but the length
 	   value still reports the actual length, not the padded length */
 	padding = size % 2;
-	if (frame_type == VIDEO_FRAME_FLAG) {
-		fputs("00dc", fp);
+
+	/* Start a new RIFF if this chunk and the indexes at the end of this one
+	   would not fit */
+	needed = 8 + size + padding;
+	for (i = 0; i < num_streams; i++)
+		needed += 32 + 8 * (stream_index[i].num_entries + 1);
+	if (frame_indexes != NULL)
+		needed += 8 + 16 * (frames_written + 1);
+	if ((riff_size + needed > RIFF_SIZE_LIMIT || frames_written == IDX1_MAX_ENTRIES)
+	    && riff_size > (riff_count == 1 ? movi_start + 4 : 24)) {
+		if (!AVI_NewRiff(fp))
+			return FALSE;
 	}
-	else {
-		fputs("01wb", fp);
+
+	if (frame_indexes != NULL) {
+		frame_indexes[2 * frames_written] = riff_size - movi_start;
+		frame_indexes[2 * frames_written + 1] = size | frame_type | (is_keyframe ? KEYFRAME_FLAG : 0);
+		frames_written++;
+		if (frames_written >= num_frames_allocated) {
+			num_frames_allocated += FRAME_INDEX_ALLOC_SIZE;
+			frame_indexes = (ULONG *)Util_realloc(frame_indexes, 2 * num_frames_allocated * sizeof(ULONG));
+		}
+	}
+	if (index->num_entries == index->num_allocated) {
+		index->num_allocated += FRAME_INDEX_ALLOC_SIZE;
+		index->entries = (ULONG *)Util_realloc(index->entries, 2 * index->num_allocated * sizeof(ULONG));
 	}
+	index->entries[2 * index->num_entries] = riff_size + 8;
+	index->entries[2 * index->num_entries + 1] = size | (is_keyframe ? 0 : 0x80000000);
+	index->num_entries++;
+
+	fputs(index->chunk_id, fp);
 	fputl(size, fp);
 	fwrite(buf, 1, size, fp);
 	if (padding) {
 		fputc(0, fp);
 	}
-	expected_frame_size = 8 + size + padding;
-
-	size |= frame_type;
-	if (is_keyframe) size |= KEYFRAME_FLAG;
-	frame_indexes[frames_written] = size;
-	frames_written++;
-	if (frames_written >= num_frames_allocated) {
-		num_frames_allocated += FRAME_INDEX_ALLOC_SIZE;
-		frame_indexes = (ULONG *)Util_realloc(frame_indexes, num_frames_allocated * sizeof(ULONG));
-	}
+	riff_size += 8 + size + padding;
+	byteswritten += 8 + padding;
 
-	/* update size limit calculation including the 16 bytes needed for each index entry */
-	frame_size = ftell(fp) - frame_size;
-	byteswritten += frame_size + 16;
+	if (frame_type == VIDEO_FRAME_FLAG) {
+		index->length++;
+		if (index->num_entries >= INDEX_INTERVAL) {
+			/* A checkpoint: the file is good up to here */
+			for (i = 0; i < num_streams; i++)
+				AVI_WriteStandardIndex(fp, &stream_index[i]);
+			if (!AVI_UpdateHeaders(fp))
+				return FALSE;
+		}
+	}
+#ifdef AUDIO_RECORDING
+	else {
+		index->length = audio_out->length;
+	}
+#endif
 
-	/* check expected file data written equals the calculated size */
-	return frame_size == expected_frame_size;
+	return !ferror(fp);
 }
 
 /* AVI_VideoFrame adds a video frame to the stream and updates the video
@@ -377,49 +649,16 @@ static int AVI_AudioFrame(FILE *fp, const UBYTE *buf, int bufsize) {
 }
 #endif
 
-static int AVI_WriteIndex(FILE *fp) {
+/* The file size does not matter (nor fit in SIZE, past 2GB); the super
+   indexes keep room for the standard indexes a few more frames and the
+   end of the file can write. */
+static int AVI_SizeCheck(int size) {
 	int i;
-	int offset;
-	int size;
-	int index_size;
-	int chunk_size;
-	ULONG index;
-	int is_keyframe;
-
-	if (frames_written == 0) return 0;
-
-	chunk_size = ftell(fp);
-	offset = 4;
-	index_size = frames_written * 16;
-
-	/* The index format used here is tag 'idx1" (index version 1.0) & documented at
-	https://docs.microsoft.com/en-us/previous-versions/windows/desktop/api/Aviriff/ns-aviriff-avioldindex
-	*/
-
-	fputs("idx1", fp);
-	fputl(index_size, fp);
-
-	for (i = 0; i < frames_written; i++) {
-		index = frame_indexes[i];
-		is_keyframe = index & KEYFRAME_FLAG ? 0x10 : 0;
-		size = index & FRAME_SIZE_MASK;
-		if (index & VIDEO_FRAME_FLAG)
-			fputs("00dc", fp); /* stream 0, a compressed video frame */
-		else
-			fputs("01wb", fp); /* stream 1, audio data */
-		fputl(is_keyframe, fp); /* flags: is a keyframe */
-		fputl(offset, fp); /* offset in bytes from start of the 'movi' list */
-		fputl(size, fp); /* size of frame */
-		offset += size + 8 + (size % 2); /* make sure to word-align next offset */
+	for (i = 0; i < num_streams; i++) {
+		if (stream_index[i].num_super > SUPER_INDEX_ENTRIES - 4)
+			return FALSE;
 	}
-
-	chunk_size = ftell(fp) - chunk_size;
-	byteswritten += chunk_size;
-	return (chunk_size == 8 + index_size);
-}
-
-static int AVI_SizeCheck(int size) {
-	return size < MAX_RIFF_FILE_SIZE;
+	return TRUE;
 }
 
 /* AVI_Finalize must be called to create a valid AVI file, because the header
@@ -430,13 +669,12 @@ static int AVI_SizeCheck(int size) {
    */
 static int AVI_Finalize(FILE *fp)
 {
-	int result = 1;
+	int result;
+	int i;
 
-	size_movi = ftell(fp) - size_movi; /* movi payload ends here */
-	result = AVI_WriteIndex(fp);
+	result = AVI_EndRiff(fp);
 	if (result > 0) {
-		size_riff = ftell(fp) - 8;
-		result = AVI_WriteHeader(fp);
+		result = AVI_UpdateHeaders(fp);
 
 		if (!result) {
 			Log_print("Failed writing AVI header; file will not be playable.");
@@ -446,6 +684,11 @@ static int AVI_Finalize(FILE *fp)
 		Log_print("Failed writing AVI index; file will not be playable.");
 	}
 
+	for (i = 0; i < num_streams; i++) {
+		free(stream_index[i].entries);
+		free(stream_index[i].super);
+	}
+	memset(stream_index, 0, sizeof(stream_index));
 	free(frame_indexes);
 	frame_indexes = NULL;
 	num_frames_allocated = 0;
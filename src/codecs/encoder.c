@@ -0,0 +1,402 @@
+/*
+ * encoder.c - run the recording codecs and container on a worker thread
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+#include "config.h"
+#include <stdlib.h>
+#include <string.h>
+#ifdef HAVE_PTHREAD_CREATE
+#include <pthread.h>
+#endif
+
+#include "screen.h"
+#include "screen_ring.h"
+#include "pokeysnd.h"
+#include "util.h"
+#include "log.h"
+#include "ai_timeline.h"
+#include "codecs/container.h"
+#include "codecs/encoder.h"
+#ifdef VIDEO_RECORDING
+#include "codecs/video.h"
+#endif
+
+#ifdef HAVE_PTHREAD_CREATE
+
+/* Without video, samples are collected into blocks of about this many bytes
+   before they are queued, so the worker wakes up for many calls at once */
+#define AUDIO_BLOCK_SIZE 65536
+
+enum {
+	ITEM_AUDIO,
+	ITEM_VIDEO,
+	ITEM_REPEAT   /* a dropped video frame */
+};
+static const char * const item_names[] = {"audio", "video", "repeat"};
+
+typedef struct {
+	int kind;
+	const UBYTE *screen;  /* held in the screen ring */
+	UBYTE *data;      /* the samples, or the screen's frame data slot */
+	int num_samples;
+	UBYTE *audio;     /* this item's sample buffer, kept between uses */
+	int audio_size;
+	int *calls;       /* samples of each ENCODER_AddAudioSamples() call */
+	int num_calls;
+	int calls_size;
+} ENCODER_item;
+
+static pthread_t thread;
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t queued = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t done = PTHREAD_COND_INITIALIZER;
+static int running = FALSE;
+static int stopping;
+static int failed;
+
+/* Items are taken off at head and added at tail */
+static ENCODER_item *items = NULL;
+static int num_items;
+static int head;
+static int count;
+
+/* Frame data slots not in the queue, one for each screen the queue may
+   yet hold (NULL without frame data) */
+static UBYTE **free_screens = NULL;
+static int num_free;
+static int drop;
+static int sample_size;
+static int block_audio;
+static ENCODER_item *pending_audio;   /* a block being filled, not queued yet */
+static int frame_data_size;   /* machine state after each screen */
+
+/* Copies of the container's statistics, updated by the worker */
+static ULONG frames_written;
+static ULONG bytes_written;
+static ULONG frames_dropped;
+
+static void *worker(void *arg)
+{
+	pthread_mutex_lock(&lock);
+	for (;;) {
+		ENCODER_item *item;
+		int ok = TRUE;
+		while (count == 0 && !stopping)
+			pthread_cond_wait(&queued, &lock);
+		if (count == 0)
+			break;
+		item = &items[head];
+		pthread_mutex_unlock(&lock);
+
+		/* After a failure the queue is only emptied; the emulation thread
+		   closes the file when it sees the flag. */
+		if (!failed) {
+			AI_TIMELINE_BEGIN(AI_TIMELINE_ENCODER, item_names[item->kind]);
+			switch (item->kind) {
+#ifdef AUDIO_RECORDING
+			case ITEM_AUDIO:
+				{
+					/* The codecs take a frame of samples at a time, and
+					   audio-only files count frames by the calls */
+					const UBYTE *samples = item->data;
+					int i;
+					for (i = 0; i < item->num_calls && ok; i++) {
+						ok = CONTAINER_AddAudioSamples(samples, item->calls[i]);
+						samples += item->calls[i] * sample_size;
+					}
+				}
+				break;
+#endif
+#ifdef VIDEO_RECORDING
+			case ITEM_VIDEO:
+				ok = CONTAINER_AddVideoFrame(item->screen, item->data);
+				break;
+			case ITEM_REPEAT:
+				ok = CONTAINER_AddVideoFrame(NULL, NULL);
+				break;
+#endif
+			default:
+				break;
+			}
+			AI_TIMELINE_END(AI_TIMELINE_ENCODER);
+		}
+
+		pthread_mutex_lock(&lock);
+		if (!ok)
+			failed = TRUE;
+		if (item->kind == ITEM_VIDEO) {
+			Screen_Ring_Release(item->screen);
+			free_screens[num_free++] = item->data;
+		}
+		frames_written = video_frame_count;
+		bytes_written = byteswritten;
+		head = (head + 1) % num_items;
+		count--;
+		pthread_cond_signal(&done);
+	}
+	pthread_mutex_unlock(&lock);
+	return NULL;
+}
+
+static void free_buffers(int slots)
+{
+	int i;
+	for (i = 0; i < num_items; i++) {
+		free(items[i].audio);
+		free(items[i].calls);
+	}
+	free(items);
+	items = NULL;
+	for (i = 0; i < slots; i++)
+		free(free_screens[i]);
+	free(free_screens);
+	free_screens = NULL;
+}
+
+int ENCODER_Start(int slots, int drop_frames)
+{
+	int i;
+
+	if (running || slots < 1)
+		return FALSE;
+	/* The screens are the ring's copies, shared with its other readers */
+	if (!Screen_Ring_Open(slots))
+		return FALSE;
+	/* Room for each queued screen's frame of audio, and then some */
+	num_items = 4 * slots + 8;
+	items = (ENCODER_item *) Util_malloc(num_items * sizeof(ENCODER_item));
+	memset(items, 0, num_items * sizeof(ENCODER_item));
+	free_screens = (UBYTE **) Util_malloc(slots * sizeof(UBYTE *));
+#ifdef VIDEO_RECORDING
+	frame_data_size = CONTAINER_FrameDataSize();
+#else
+	frame_data_size = 0;
+#endif
+	for (i = 0; i < slots; i++)
+		free_screens[i] = frame_data_size > 0 ? (UBYTE *) Util_malloc(frame_data_size) : NULL;
+	num_free = slots;
+	head = count = 0;
+	stopping = failed = FALSE;
+	drop = drop_frames;
+	sample_size = POKEYSND_snd_flags & POKEYSND_BIT16 ? 2 : 1;
+	/* With video, each frame's audio goes next to it in the file */
+#ifdef VIDEO_RECORDING
+	block_audio = video_codec == NULL;
+#else
+	block_audio = TRUE;
+#endif
+	pending_audio = NULL;
+	frames_written = video_frame_count;
+	bytes_written = byteswritten;
+	frames_dropped = 0;
+
+	if (pthread_create(&thread, NULL, worker, NULL) != 0) {
+		Log_print("Cannot start the recording thread; encoding in the emulation thread");
+		free_buffers(slots);
+		Screen_Ring_Close(slots);
+		return FALSE;
+	}
+	running = TRUE;
+	return TRUE;
+}
+
+int ENCODER_Stop(void)
+{
+	int slots;
+
+	if (!running)
+		return TRUE;
+	pthread_mutex_lock(&lock);
+	if (pending_audio != NULL) {
+		/* The last block, however full */
+		count++;
+		pending_audio = NULL;
+	}
+	stopping = TRUE;
+	pthread_cond_signal(&queued);
+	pthread_mutex_unlock(&lock);
+	pthread_join(thread, NULL);
+	running = FALSE;
+
+	/* Every screen is back in the pool now */
+	slots = num_free;
+	free_buffers(slots);
+	Screen_Ring_Close(slots);
+	if (frames_dropped > 0)
+		Log_print("Recording: %lu video frames dropped", (unsigned long) frames_dropped);
+	return !failed;
+}
+
+int ENCODER_IsRunning(void)
+{
+	return running;
+}
+
+/* Waits for a free item, with the lock held. Returns NULL after a failure. */
+static ENCODER_item *reserve(void)
+{
+	while (count == num_items && !failed)
+		pthread_cond_wait(&done, &lock);
+	if (failed)
+		return NULL;
+	return &items[(head + count) % num_items];
+}
+
+static void commit(void)
+{
+	count++;
+	pthread_cond_signal(&queued);
+}
+
+#ifdef AUDIO_RECORDING
+int ENCODER_AddAudioSamples(const UBYTE *buf, int num_samples)
+{
+	ENCODER_item *item;
+	int size = num_samples * sample_size;
+	int used;
+
+	pthread_mutex_lock(&lock);
+	if (failed)
+		item = NULL;
+	else if (pending_audio != NULL)
+		item = pending_audio;
+	else {
+		item = reserve();
+		if (item != NULL) {
+			item->num_samples = 0;
+			item->num_calls = 0;
+		}
+	}
+	pthread_mutex_unlock(&lock);
+	if (item == NULL)
+		return 0;
+
+	/* The worker does not touch the item until it is committed */
+	used = item->num_samples * sample_size;
+	if (used + size > item->audio_size) {
+		item->audio_size = used + size;
+		if (block_audio && item->audio_size < AUDIO_BLOCK_SIZE)
+			item->audio_size = AUDIO_BLOCK_SIZE;
+		item->audio = (UBYTE *) Util_realloc(item->audio, item->audio_size);
+	}
+	if (item->num_calls == item->calls_size) {
+		item->calls_size = item->calls_size * 2 + 16;
+		item->calls = (int *) Util_realloc(item->calls, item->calls_size * sizeof(int));
+	}
+	memcpy(item->audio + used, buf, size);
+	item->kind = ITEM_AUDIO;
+	item->data = item->audio;
+	item->num_samples += num_samples;
+	item->calls[item->num_calls++] = num_samples;
+	if (block_audio && used + size < AUDIO_BLOCK_SIZE) {
+		pending_audio = item;
+		return 1;
+	}
+	pending_audio = NULL;
+
+	pthread_mutex_lock(&lock);
+	commit();
+	pthread_mutex_unlock(&lock);
+	return 1;
+}
+#endif
+
+#ifdef VIDEO_RECORDING
+int ENCODER_AddVideoFrame(void)
+{
+	ENCODER_item *item;
+	const UBYTE *screen = NULL;
+	UBYTE *frame_data = NULL;
+
+	pthread_mutex_lock(&lock);
+	if (num_free > 0 || !drop) {
+		while (num_free == 0 && !failed)
+			pthread_cond_wait(&done, &lock);
+		/* Only other readers holding on to theirs leave no ring slot */
+		screen = Screen_Ring_AcquireCurrent();
+	}
+	if (screen == NULL) {
+		item = reserve();
+		if (item != NULL) {
+			item->kind = ITEM_REPEAT;
+			frames_dropped++;
+			commit();
+		}
+		pthread_mutex_unlock(&lock);
+		return item != NULL;
+	}
+	item = reserve();
+	if (item != NULL)
+		frame_data = free_screens[--num_free];
+	pthread_mutex_unlock(&lock);
+	if (item == NULL) {
+		Screen_Ring_Release(screen);
+		return 0;
+	}
+
+	if (frame_data_size > 0)
+		CONTAINER_CaptureFrameData(frame_data);
+	item->kind = ITEM_VIDEO;
+	item->screen = screen;
+	item->data = frame_data;
+
+	pthread_mutex_lock(&lock);
+	commit();
+	pthread_mutex_unlock(&lock);
+	return 1;
+}
+#endif
+
+void ENCODER_GetStats(ULONG *frames, ULONG *bytes, ULONG *dropped, int *queued)
+{
+	pthread_mutex_lock(&lock);
+	*frames = frames_written;
+	*bytes = bytes_written;
+	*dropped = frames_dropped;
+	*queued = count;
+	pthread_mutex_unlock(&lock);
+}
+
+#else /* HAVE_PTHREAD_CREATE */
+
+int ENCODER_Start(int slots, int drop_frames)
+{
+	return FALSE;
+}
+
+int ENCODER_Stop(void)
+{
+	return TRUE;
+}
+
+int ENCODER_IsRunning(void)
+{
+	return FALSE;
+}
+
+#ifdef AUDIO_RECORDING
+int ENCODER_AddAudioSamples(const UBYTE *buf, int num_samples)
+{
+	return CONTAINER_AddAudioSamples(buf, num_samples);
+}
+#endif
+
+#ifdef VIDEO_RECORDING
+int ENCODER_AddVideoFrame(void)
+{
+	return CONTAINER_AddVideoFrame((const UBYTE *) Screen_atari, NULL);
+}
+#endif
+
+void ENCODER_GetStats(ULONG *frames, ULONG *bytes, ULONG *dropped, int *queued)
+{
+	*frames = video_frame_count;
+	*bytes = byteswritten;
+	*dropped = 0;
+	*queued = 0;
+}
+
+#endif /* HAVE_PTHREAD_CREATE */
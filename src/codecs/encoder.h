@@ -0,0 +1,51 @@
+/*
+ * encoder.h - run the recording codecs and container on a worker thread
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+#ifndef CODECS_ENCODER_H_
+#define CODECS_ENCODER_H_
+
+#include "atari.h"
+
+/* The emulation thread copies each frame's screen and audio, and any
+   machine state the container records with the frame, into a queue and
+   goes on; a worker thread takes them off in the same order and runs
+   CONTAINER_AddVideoFrame() and CONTAINER_AddAudioSamples() on them, so
+   encoding and writing the file do not hold up the frame. Screens are held
+   in the screen ring (screen_ring.h), SLOTS at most, sharing the copy with
+   its other readers. When that many are waiting to be encoded, the next
+   video frame waits for one, or, with DROP_FRAMES, is recorded as a repeat
+   of the one before; audio is never dropped. Audio recorded without video
+   is queued in blocks of many calls: the emulation thread only copies the
+   samples, and the worker runs the audio codec, MP3 included, on a whole
+   block when it wakes up. */
+
+/* Starts the worker for the container just opened. Returns FALSE if it
+   could not be started; the caller then writes frames itself. */
+int ENCODER_Start(int slots, int drop_frames);
+
+/* Waits until everything queued is written and stops the worker. Returns
+   FALSE if a frame failed to encode or write, in which case the file
+   should be closed as failed. Does nothing if the worker is not running. */
+int ENCODER_Stop(void);
+
+int ENCODER_IsRunning(void);
+
+/* Queue a call to CONTAINER_AddAudioSamples() or CONTAINER_AddVideoFrame()
+   with Screen_atari. Return zero if an earlier frame failed. */
+#ifdef AUDIO_RECORDING
+int ENCODER_AddAudioSamples(const UBYTE *buf, int num_samples);
+#endif
+#ifdef VIDEO_RECORDING
+int ENCODER_AddVideoFrame(void);
+#endif
+
+/* The frame count and bytes written so far, as of the last frame the
+   worker finished, the video frames dropped since ENCODER_Start(), and
+   the frames and audio blocks queued and not yet taken by the worker. */
+void ENCODER_GetStats(ULONG *frames, ULONG *bytes, ULONG *dropped, int *queued);
+
+#endif /* CODECS_ENCODER_H_ */
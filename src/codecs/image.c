@@ -39,6 +39,12 @@
 
 IMAGE_CODEC_t *image_codec = NULL;
 
+/* Images saved to memory go here, allocated on first use. The largest is
+   an interlaced screen stored as RGB, which PCX's run-length encoding can
+   double at worst. */
+#define MEMORY_IMAGE_SIZE (2 * 3 * Screen_WIDTH * Screen_HEIGHT + 1024)
+static UBYTE *memory_image = NULL;
+
 /* image size will be determined in a call to CODECS_IMAGE_SetMargins() below */
 int image_codec_left_margin;
 int image_codec_top_margin;
@@ -89,8 +95,22 @@ int CODECS_IMAGE_Init(const char *filename)
 {
 	image_codec = match_image_codec(filename);
 	CODECS_IMAGE_SetMargins();
-	fprintf(stderr, "CODECS_IMAGE_Init: %s -> codec=%p margins=%d,%d size=%dx%d\n",
-		filename, (void*)image_codec, image_codec_left_margin, image_codec_top_margin,
-		image_codec_width, image_codec_height);
 	return (image_codec != NULL);
 }
+
+/* Saves the screen as an image of the type ID names (a file name or just
+   its extension, as for CODECS_IMAGE_Init) to memory: *data points to the
+   image until the next call. Leaves image_codec as it was. Returns the
+   size of the image, or 0 if the type is not known. */
+int CODECS_IMAGE_SaveToMemory(const char *id, UBYTE *ptr1, UBYTE *ptr2, const UBYTE **data)
+{
+	IMAGE_CODEC_t *codec = match_image_codec(id);
+
+	if (codec == NULL || codec->to_buffer == NULL)
+		return 0;
+	CODECS_IMAGE_SetMargins();
+	if (memory_image == NULL)
+		memory_image = (UBYTE *) Util_malloc(MEMORY_IMAGE_SIZE);
+	*data = memory_image;
+	return codec->to_buffer(memory_image, MEMORY_IMAGE_SIZE, ptr1, ptr2);
+}
@@ -24,6 +24,7 @@ extern int image_codec_height;
 
 void CODECS_IMAGE_SetMargins(void);
 int CODECS_IMAGE_Init(const char *filename);
+int CODECS_IMAGE_SaveToMemory(const char *id, UBYTE *ptr1, UBYTE *ptr2, const UBYTE **data);
 int CODECS_IMAGE_SaveScreen(FILE *fp, UBYTE *ptr1, UBYTE *ptr2);
 
 #endif /* CODECS_IMAGE_H_ */
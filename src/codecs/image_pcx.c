@@ -29,6 +29,29 @@
 #include "codecs/image.h"
 
 
+/* Where PCX_SaveScreen writes: the file, or out_buf when it has none.
+   out_size goes past out_max when the buffer is too small. */
+static FILE *out_fp = NULL;
+static UBYTE *out_buf = NULL;
+static int out_size;
+static int out_max = 0;
+
+static void put_byte(int value)
+{
+	if (out_fp != NULL)
+		fputc(value, out_fp);
+	else if (out_size < out_max)
+		out_buf[out_size++] = (UBYTE) value;
+	else
+		out_size = out_max + 1;
+}
+
+static void put_word(int value)
+{
+	put_byte(value & 0xff);
+	put_byte((value >> 8) & 0xff);
+}
+
 /* PCX_SaveScreen saves the screen data to the file in PCX format, optionally
    using interlace if ptr2 is not NULL.
 
@@ -42,7 +65,8 @@
    on the external libpng library. No external dependencies are needed for PCX
    format.
 
-   fp:          file pointer of file open for writing
+   fp:          file pointer of file open for writing, or NULL to write to
+                out_buf
    ptr1:        pointer to Screen_atari
    ptr2:        (optional) pointer to another array of size Screen_atari containing
                 the interlaced scan lines to blend with ptr1. Set to NULL if no
@@ -57,26 +81,28 @@ static int PCX_SaveScreen(FILE *fp, UBYTE *ptr1, UBYTE *ptr2)
 	UBYTE last;
 	UBYTE count;
 
-	fputc(0xa, fp);   /* pcx signature */
-	fputc(0x5, fp);   /* version 5 */
-	fputc(0x1, fp);   /* RLE encoding */
-	fputc(0x8, fp);   /* bits per pixel */
-	fputw(0, fp);     /* XMin */
-	fputw(0, fp);     /* YMin */
-	fputw(image_codec_width - 1, fp); /* XMax */
-	fputw(image_codec_height - 1, fp);        /* YMax */
-	fputw(0, fp);     /* HRes */
-	fputw(0, fp);     /* VRes */
+	out_fp = fp;
+	out_size = 0;
+	put_byte(0xa);   /* pcx signature */
+	put_byte(0x5);   /* version 5 */
+	put_byte(0x1);   /* RLE encoding */
+	put_byte(0x8);   /* bits per pixel */
+	put_word(0);     /* XMin */
+	put_word(0);     /* YMin */
+	put_word(image_codec_width - 1); /* XMax */
+	put_word(image_codec_height - 1);        /* YMax */
+	put_word(0);     /* HRes */
+	put_word(0);     /* VRes */
 	for (i = 0; i < 48; i++)
-		fputc(0, fp); /* EGA color palette */
-	fputc(0, fp);     /* reserved */
-	fputc(ptr2 != NULL ? 3 : 1, fp); /* number of bit planes */
-	fputw(image_codec_width, fp);  /* number of bytes per scan line per color plane */
-	fputw(1, fp);     /* palette info */
-	fputw(image_codec_width, fp); /* screen resolution */
-	fputw(image_codec_height, fp);
+		put_byte(0); /* EGA color palette */
+	put_byte(0);     /* reserved */
+	put_byte(ptr2 != NULL ? 3 : 1); /* number of bit planes */
+	put_word(image_codec_width);  /* number of bytes per scan line per color plane */
+	put_word(1);     /* palette info */
+	put_word(image_codec_width); /* screen resolution */
+	put_word(image_codec_height);
 	for (i = 0; i < 54; i++)
-		fputc(0, fp);  /* unused */
+		put_byte(0);  /* unused */
 
 	ptr1 += (Screen_WIDTH * image_codec_top_margin) + image_codec_left_margin;
 	if (ptr2 != NULL) {
@@ -96,8 +122,8 @@ static int PCX_SaveScreen(FILE *fp, UBYTE *ptr1, UBYTE *ptr2)
 			} while (last == (ptr2 != NULL ? (((Colours_table[*ptr1] >> plane) & 0xff) + ((Colours_table[*ptr2] >> plane) & 0xff)) >> 1 : *ptr1)
 						&& count < 0xff && x < image_codec_width);
 			if (count > 0xc1 || last >= 0xc0)
-				fputc(count, fp);
-			fputc(last, fp);
+				put_byte(count);
+			put_byte(last);
 		} while (x < image_codec_width);
 
 		if (ptr2 != NULL && plane) {
@@ -117,20 +143,36 @@ static int PCX_SaveScreen(FILE *fp, UBYTE *ptr1, UBYTE *ptr2)
 
 	if (ptr2 == NULL) {
 		/* write palette */
-		fputc(0xc, fp);
+		put_byte(0xc);
 		for (i = 0; i < 256; i++) {
-			fputc(Colours_GetR(i), fp);
-			fputc(Colours_GetG(i), fp);
-			fputc(Colours_GetB(i), fp);
+			put_byte(Colours_GetR(i));
+			put_byte(Colours_GetG(i));
+			put_byte(Colours_GetB(i));
 		}
 	}
 
+	if (fp == NULL)
+		return out_size <= out_max ? out_size : 0;
 	return 1;
 }
 
+/* Instead of saving PCX to a file, this function allows saving the screen to a buffer */
+static int PCX_SaveToBuffer(UBYTE *buf, int bufsize, UBYTE *ptr1, UBYTE *ptr2)
+{
+	int result;
+
+	out_buf = buf;
+	out_max = bufsize;
+	result = PCX_SaveScreen(NULL, ptr1, ptr2);
+	out_buf = NULL;
+	out_max = 0;
+
+	return result;
+}
+
 IMAGE_CODEC_t Image_Codec_PCX = {
 	"pcx",
 	"PC Paintbrush",
 	&PCX_SaveScreen,
-	NULL,
+	&PCX_SaveToBuffer,
 };
@@ -38,15 +38,17 @@
 
 #include <png.h>
 
-#ifdef VIDEO_CODEC_PNG
 static int current_png_size = -1;
 static int max_buffer_size = 0;
 static UBYTE *image_buffer = NULL;
 
+/* The blend of two interlaced frames, allocated on first use */
+static png_bytep rgb_buffer = NULL;
+
 static void png_write_fn_callback(png_structp png_ptr, png_bytep data, png_size_t length)
 {
 	if (current_png_size >= 0) {
-		if (current_png_size + length < max_buffer_size) {
+		if (current_png_size + length <= max_buffer_size) {
 			memcpy(image_buffer + current_png_size, data, length);
 			current_png_size += length;
 		}
@@ -56,7 +58,10 @@ static void png_write_fn_callback(png_structp png_ptr, png_bytep data, png_size_
 		}
 	}
 }
-#endif /* VIDEO_CODEC_PNG */
+
+static void png_flush_fn_callback(png_structp png_ptr)
+{
+}
 
 /* PNG_SaveScreen saves the screen data to the file in PNG format, optionally
    using interlace if ptr2 is not NULL.
@@ -65,7 +70,12 @@ static void png_write_fn_callback(png_structp png_ptr, png_bytep data, png_size_
    PCX. Because it depends on the external libpng library, it is only compiled
    in atari800 if requested and libpng is found on the system.
 
-   fp:          file pointer of file open for writing
+   Without interlace, the image is stored as the screen is, as indices into
+   the palette of the 256 Atari colours. Interlaced images blend two colours
+   per pixel and are stored as RGB.
+
+   fp:          file pointer of file open for writing, or NULL to write to
+                image_buffer
    ptr1:        pointer to Screen_atari
    ptr2:        (optional) pointer to another array of size Screen_atari containing
                 the interlaced scan lines to blend with ptr1. Set to NULL if no
@@ -88,15 +98,15 @@ static int PNG_SaveScreen(FILE *fp, UBYTE *ptr1, UBYTE *ptr2)
 		png_destroy_write_struct(&png_ptr, NULL);
 		return 0;
 	}
-#ifdef VIDEO_CODEC_PNG
-	if (fp == NULL) {
-		png_set_write_fn(png_ptr, NULL, png_write_fn_callback, NULL);
+	/* libpng errors end up here */
+	if (setjmp(png_jmpbuf(png_ptr))) {
+		png_destroy_write_struct(&png_ptr, &info_ptr);
+		return 0;
 	}
+	if (fp == NULL)
+		png_set_write_fn(png_ptr, NULL, png_write_fn_callback, png_flush_fn_callback);
 	else
-#endif
-	{
 		png_init_io(png_ptr, fp);
-	}
 
 	png_set_compression_level(png_ptr, FILE_EXPORT_compression_level);
 	png_set_IHDR(
@@ -127,7 +137,9 @@ static int PNG_SaveScreen(FILE *fp, UBYTE *ptr1, UBYTE *ptr2)
 		int y;
 		ptr1 += (Screen_WIDTH * image_codec_top_margin) + image_codec_left_margin;
 		ptr2 += (Screen_WIDTH * image_codec_top_margin) + image_codec_left_margin;
-		ptr3 = (png_bytep) Util_malloc(3 * image_codec_width * image_codec_height);
+		if (rgb_buffer == NULL)
+			rgb_buffer = (png_bytep) Util_malloc(3 * Screen_WIDTH * Screen_HEIGHT);
+		ptr3 = rgb_buffer;
 		for (y = 0; y < image_codec_height; y++) {
 			rows[y] = ptr3;
 			for (x = 0; x < image_codec_width; x++) {
@@ -144,18 +156,13 @@ static int PNG_SaveScreen(FILE *fp, UBYTE *ptr1, UBYTE *ptr2)
 	png_set_rows(png_ptr, info_ptr, rows);
 	png_write_png(png_ptr, info_ptr, PNG_TRANSFORM_IDENTITY, NULL);
 	png_destroy_write_struct(&png_ptr, &info_ptr);
-	if (ptr2 != NULL)
-		free(rows[0]);
-
-#ifdef VIDEO_CODEC_PNG
-	/* When writing to file (fp != NULL), current_png_size is -1, but write succeeded */
-	return (current_png_size >= 0) ? current_png_size : 1;
-#else
-	return 1;  /* Success when writing to file */
-#endif
+
+	/* The size written to image_buffer, or success when writing to file */
+	if (fp == NULL)
+		return (current_png_size > 0) ? current_png_size : 0;
+	return 1;
 }
 
-#ifdef VIDEO_CODEC_PNG
 /* Instead of saving PNG to a file, this function allows saving the screen to a buffer */
 static int PNG_SaveToBuffer(UBYTE *buf, int bufsize, UBYTE *ptr1, UBYTE *ptr2)
 {
@@ -173,15 +180,10 @@ static int PNG_SaveToBuffer(UBYTE *buf, int bufsize, UBYTE *ptr1, UBYTE *ptr2)
 
 	return result;
 }
-#endif
 
 IMAGE_CODEC_t Image_Codec_PNG = {
 	"png",
 	"Portable Network Graphics",
 	&PNG_SaveScreen,
-#ifdef VIDEO_CODEC_PNG
 	&PNG_SaveToBuffer,
-#else
-	NULL,
-#endif
 };
@@ -39,6 +39,9 @@
 #ifdef VIDEO_CODEC_ZMBV
 #include "codecs/video_zmbv.h"
 #endif
+#ifdef VIDEO_CODEC_H264
+#include "codecs/video_h264.h"
+#endif
 
 /* Global pointer to current video codec, or NULL if one has not been
    initialized. This pointer should not be used after a call to
@@ -57,6 +60,8 @@ static VIDEO_CODEC_t *requested_video_codec = NULL;
 #define MAX_KEYFRAME_INTERVAL 500
 int video_codec_keyframe_interval = 0;
 
+int video_codec_skip_unchanged = TRUE;
+
 
 static VIDEO_CODEC_t *known_video_codecs[] = {
 	&Video_Codec_MRLE,
@@ -66,6 +71,9 @@ static VIDEO_CODEC_t *known_video_codecs[] = {
 #endif
 #ifdef VIDEO_CODEC_ZMBV
 	&Video_Codec_ZMBV,
+#endif
+#ifdef VIDEO_CODEC_H264
+	&Video_Codec_H264,
 #endif
 	NULL,
 };
@@ -149,12 +157,44 @@ int CODECS_VIDEO_Initialise(int *argc, char *argv[])
 			}
 			else a_m = TRUE;
 		}
+		else if (strcmp(argv[i], "-skip-unchanged") == 0)
+			video_codec_skip_unchanged = TRUE;
+		else if (strcmp(argv[i], "-no-skip-unchanged") == 0)
+			video_codec_skip_unchanged = FALSE;
+#ifdef VIDEO_CODEC_ZMBV
+		else if (strcmp(argv[i], "-zmbv-threads") == 0) {
+			if (i_a) {
+				ZMBV_threads = Util_sscandec(argv[++i]);
+				if (ZMBV_threads < 0)
+					a_i = TRUE;
+			}
+			else a_m = TRUE;
+		}
+#endif
+#ifdef VIDEO_CODEC_H264
+		else if (strcmp(argv[i], "-h264-encoder") == 0) {
+			if (i_a)
+				Util_strlcpy(VIDEO_H264_encoder_library, argv[++i], FILENAME_MAX);
+			else a_m = TRUE;
+		}
+#endif
 		else {
 			if (strcmp(argv[i], "-help") == 0) {
 				char buf[256];
 				Log_print(video_codec_args(buf));
 				Log_print("\t                 Select video codec (default: auto)");
 				Log_print("\t-keyint <num>    Set video keyframe interval to one keyframe every num frames");
+				Log_print("\t-skip-unchanged Write unchanged screens as empty frames without encoding them (default)");
+				Log_print("\t-no-skip-unchanged");
+				Log_print("\t                 Encode every screen");
+#ifdef VIDEO_CODEC_ZMBV
+				Log_print("\t-zmbv-threads <n>");
+				Log_print("\t                 Split ZMBV motion estimation across n threads (0: one per core)");
+#endif
+#ifdef VIDEO_CODEC_H264
+				Log_print("\t-h264-encoder <library>");
+				Log_print("\t                 Load the hardware encoder for -vcodec h264 from library");
+#endif
 			}
 			argv[j++] = argv[i];
 		}
@@ -191,6 +231,19 @@ int CODECS_VIDEO_ReadConfig(char *string, char *ptr)
 			video_codec_keyframe_interval = num;
 		else return FALSE;
 	}
+	else if (strcmp(string, "VIDEO_CODEC_SKIP_UNCHANGED") == 0) {
+		return (video_codec_skip_unchanged = Util_sscanbool(ptr)) != -1;
+	}
+#ifdef VIDEO_CODEC_ZMBV
+	else if (strcmp(string, "ZMBV_THREADS") == 0) {
+		return (ZMBV_threads = Util_sscandec(ptr)) >= 0;
+	}
+#endif
+#ifdef VIDEO_CODEC_H264
+	else if (strcmp(string, "H264_ENCODER") == 0) {
+		Util_strlcpy(VIDEO_H264_encoder_library, ptr, FILENAME_MAX);
+	}
+#endif
 	else return FALSE;
 	return TRUE;
 }
@@ -204,6 +257,13 @@ void CODECS_VIDEO_WriteConfig(FILE *fp)
 		fprintf(fp, "VIDEO_CODEC=%s\n", requested_video_codec->codec_id);
 	}
 	fprintf(fp, "VIDEO_CODEC_KEYFRAME_INTERVAL=%d\n", video_codec_keyframe_interval);
+	fprintf(fp, "VIDEO_CODEC_SKIP_UNCHANGED=%d\n", video_codec_skip_unchanged);
+#ifdef VIDEO_CODEC_ZMBV
+	fprintf(fp, "ZMBV_THREADS=%d\n", ZMBV_threads);
+#endif
+#ifdef VIDEO_CODEC_H264
+	fprintf(fp, "H264_ENCODER=%s\n", VIDEO_H264_encoder_library);
+#endif
 }
 
 
@@ -224,6 +284,14 @@ int CODECS_VIDEO_Init(void)
 	}
 
 	video_buffer_size = video_codec->init(image_codec_width, image_codec_height, image_codec_left_margin, image_codec_top_margin);
+#ifdef VIDEO_CODEC_H264
+	if (video_buffer_size < 0 && video_codec == &Video_Codec_H264) {
+		/* Without a hardware encoder, record with the default codec */
+		video_codec = get_best_video_codec();
+		Log_print("Recording with %s instead", video_codec->codec_id);
+		video_buffer_size = video_codec->init(image_codec_width, image_codec_height, image_codec_left_margin, image_codec_top_margin);
+	}
+#endif
 	if (video_buffer_size < 0) {
 		Log_print("Failed to initialize %s video codec", video_codec->codec_id);
 		return 0;
@@ -33,6 +33,10 @@ extern int video_buffer_size;
 extern UBYTE *video_buffer;
 extern int video_codec_keyframe_interval;
 
+/* Write screens that are the same as the last one encoded as empty frames
+   instead of encoding them */
+extern int video_codec_skip_unchanged;
+
 int CODECS_VIDEO_Initialise(int *argc, char *argv[]);
 int CODECS_VIDEO_ReadConfig(char *string, char *ptr);
 void CODECS_VIDEO_WriteConfig(FILE *fp);
@@ -0,0 +1,197 @@
+/*
+ * video_h264.c - H.264 video through hardware encoders
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+/* This file is only compiled when VIDEO_CODEC_H264 is defined.
+
+   The emulator does not encode H.264 itself. Each screen is converted to
+   NV12 and handed to a backend that drives a platform encoder: one loaded
+   from the library named by -h264-encoder, or one the program embedding
+   the emulator registered. The first backend that opens is used; when none
+   does, the codec fails to start and CODECS_VIDEO_Init records with the
+   default codec instead. */
+
+#include "config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef HAVE_DLFCN_H
+#include <dlfcn.h>
+#endif
+#include "screen.h"
+#include "colours.h"
+#include "util.h"
+#include "log.h"
+#include "codecs/container.h"
+#include "codecs/video_h264.h"
+
+#define MAX_BACKENDS 8
+
+char VIDEO_H264_encoder_library[FILENAME_MAX] = "";
+
+static const VIDEO_H264_BACKEND_t *backends[MAX_BACKENDS];
+static int num_backends = 0;
+static const VIDEO_H264_BACKEND_t *library_backend = NULL;
+static char loaded_library[FILENAME_MAX] = "";
+static const VIDEO_H264_BACKEND_t *backend = NULL;   /* the open one */
+
+static int nv12_width;
+static int nv12_height;
+static int screen_left;
+static int screen_top;
+static UBYTE *nv12 = NULL;
+
+/* BT.601 video range values of each palette entry. The chroma of an entry
+   is packed as U + (V << 16), so the four pixels under a chroma sample are
+   averaged with one sum for both. */
+static UBYTE luma[256];
+static ULONG chroma[256];
+
+int VIDEO_H264_RegisterBackend(const VIDEO_H264_BACKEND_t *new_backend)
+{
+	if (num_backends == MAX_BACKENDS)
+		return FALSE;
+	backends[num_backends++] = new_backend;
+	return TRUE;
+}
+
+/* Loads the backend of VIDEO_H264_encoder_library, once for each name */
+static void load_library(void)
+{
+	if (strcmp(loaded_library, VIDEO_H264_encoder_library) == 0)
+		return;
+	strcpy(loaded_library, VIDEO_H264_encoder_library);
+	library_backend = NULL;
+	if (VIDEO_H264_encoder_library[0] == '\0')
+		return;
+#ifdef HAVE_DLOPEN
+	{
+		/* The library stays loaded: a backend may keep threads running */
+		void *handle = dlopen(VIDEO_H264_encoder_library, RTLD_NOW | RTLD_LOCAL);
+		const VIDEO_H264_BACKEND_t *(*get_backend)(void);
+		if (handle == NULL) {
+			Log_print("Cannot load H.264 encoder: %s", dlerror());
+			return;
+		}
+		*(void **) &get_backend = dlsym(handle, "atari800_h264_backend");
+		if (get_backend == NULL) {
+			Log_print("%s is not an H.264 encoder", VIDEO_H264_encoder_library);
+			return;
+		}
+		library_backend = get_backend();
+	}
+#else
+	Log_print("H.264 encoder libraries are not supported on this platform");
+#endif
+}
+
+static int try_open(const VIDEO_H264_BACKEND_t *candidate)
+{
+	if (candidate == NULL || !candidate->open(nv12_width, nv12_height, fps))
+		return FALSE;
+	backend = candidate;
+	return TRUE;
+}
+
+static void fill_tables(void)
+{
+	int i;
+
+	for (i = 0; i < 256; i++) {
+		int r = Colours_GetR(i);
+		int g = Colours_GetG(i);
+		int b = Colours_GetB(i);
+		int u = ((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128;
+		int v = ((112 * r - 94 * g - 18 * b + 128) >> 8) + 128;
+		luma[i] = (UBYTE) (((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+		chroma[i] = (ULONG) u | ((ULONG) v << 16);
+	}
+}
+
+static int H264_Init(int width, int height, int left_margin, int top_margin)
+{
+	int i;
+
+	/* NV12 needs even sizes; an odd row or column is left out */
+	nv12_width = width & ~1;
+	nv12_height = height & ~1;
+	screen_left = left_margin;
+	screen_top = top_margin;
+
+	load_library();
+	backend = NULL;
+	if (!try_open(library_backend)) {
+		for (i = 0; i < num_backends; i++) {
+			if (try_open(backends[i]))
+				break;
+		}
+	}
+	if (backend == NULL) {
+		Log_print("No H.264 encoder available");
+		return -1;
+	}
+	Log_print("Encoding H.264 with %s", backend->name);
+
+	fill_tables();
+	nv12 = (UBYTE *) Util_malloc(nv12_width * nv12_height * 3 / 2);
+	/* Far more than a hardware encoder makes of a frame this size */
+	return nv12_width * nv12_height * 3 + 65536;
+}
+
+/* Converts the recorded area of SOURCE to NV12, two rows at a time */
+static void convert_to_nv12(const UBYTE *source)
+{
+	UBYTE *y_row = nv12;
+	UBYTE *uv_row = nv12 + nv12_width * nv12_height;
+	int x, y;
+
+	source += screen_top * Screen_WIDTH + screen_left;
+	for (y = 0; y < nv12_height; y += 2) {
+		const UBYTE *top = source;
+		const UBYTE *bottom = source + Screen_WIDTH;
+		UBYTE *y_next = y_row + nv12_width;
+		for (x = 0; x < nv12_width; x += 2) {
+			ULONG sum = chroma[top[x]] + chroma[top[x + 1]] + chroma[bottom[x]] + chroma[bottom[x + 1]] + 0x20002;
+			y_row[x] = luma[top[x]];
+			y_row[x + 1] = luma[top[x + 1]];
+			y_next[x] = luma[bottom[x]];
+			y_next[x + 1] = luma[bottom[x + 1]];
+			uv_row[x] = (UBYTE) ((sum & 0xffff) >> 2);
+			uv_row[x + 1] = (UBYTE) (sum >> 18);
+		}
+		source += 2 * Screen_WIDTH;
+		y_row += 2 * nv12_width;
+		uv_row += nv12_width;
+	}
+}
+
+static int H264_CreateFrame(UBYTE *source, int keyframe, UBYTE *buf, int bufsize)
+{
+	convert_to_nv12(source);
+	return backend->encode(nv12, keyframe, buf, bufsize);
+}
+
+static int H264_End(void)
+{
+	if (backend != NULL) {
+		backend->close();
+		backend = NULL;
+	}
+	free(nv12);
+	nv12 = NULL;
+	return 1;
+}
+
+VIDEO_CODEC_t Video_Codec_H264 = {
+	"h264",
+	"H.264 (hardware encoder)",
+	{'H', '2', '6', '4'},
+	{'H', '2', '6', '4'},
+	TRUE,
+	&H264_Init,
+	&H264_CreateFrame,
+	&H264_End,
+};
@@ -0,0 +1,35 @@
+#ifndef CODECS_VIDEO_H264_H_
+#define CODECS_VIDEO_H264_H_
+
+#include "atari.h"
+#include "codecs/video.h"
+
+/* A hardware H.264 encoder (VAAPI, NVENC, VideoToolbox...) as the h264
+   codec uses it. */
+typedef struct {
+	const char *name;
+	/* Opens the encoder for WIDTH x HEIGHT frames, both even, at FPS frames
+	   per second. Returns FALSE if the hardware or its driver is not
+	   there. */
+	int (*open)(int width, int height, double fps);
+	/* Encodes one frame. NV12 is the Y plane, WIDTH bytes a row, followed by
+	   the interleaved U and V samples at half the resolution. With KEYFRAME
+	   the frame must be an IDR frame with the SPS and PPS in front. Stores
+	   the frame in Annex B form in BUF and returns its size, or -1 on error.
+	   Each call returns its own frame, so the encoder must run without
+	   B-frames or lookahead. */
+	int (*encode)(const UBYTE *nv12, int keyframe, UBYTE *buf, int bufsize);
+	void (*close)(void);
+} VIDEO_H264_BACKEND_t;
+
+extern VIDEO_CODEC_t Video_Codec_H264;
+
+/* Shared library with a backend, loaded when the codec is first used. It
+   exports const VIDEO_H264_BACKEND_t *atari800_h264_backend(void). */
+extern char VIDEO_H264_encoder_library[FILENAME_MAX];
+
+/* Adds a backend for the codec to try; the library's is tried first, then
+   these in the order they were added. Returns FALSE if there are too many. */
+int VIDEO_H264_RegisterBackend(const VIDEO_H264_BACKEND_t *backend);
+
+#endif /* CODECS_VIDEO_H264_H_ */
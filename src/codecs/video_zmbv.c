@@ -32,11 +32,20 @@
    - if compression level is zero, raw uncompressed data is stored rather than
      the zlib stream with compression level 0 data
    - motion estimation range is fixed to a value suited to Atari graphics
+   - motion vectors are searched for bands of block rows on several
+     threads; the output does not depend on the number of threads
 */  
 
 
+#include "config.h"
 #include <string.h>
 #include <stdlib.h>
+#ifdef HAVE_PTHREAD_CREATE
+#include <pthread.h>
+#endif
+#if defined(HAVE_SYSCONF) && defined(HAVE_UNISTD_H)
+#include <unistd.h>
+#endif
 #include "codecs/video_zmbv.h"
 #include "screen.h"
 #include "colours.h"
@@ -87,14 +96,35 @@ static z_stream zstream;
 #endif
 static int score_tab[ZMBV_BLOCK * ZMBV_BLOCK * 4 + 1];
 
+int ZMBV_threads = 0;
+
+/* Each block's motion vector search starts with the vector chosen for the
+   block before it. For an inter frame, bands of block rows are searched
+   on several threads, each starting as if the block before its first had
+   vector (0,0); where that was not so, the band's blocks are searched
+   again in order until the search picks the vector it picked before, from
+   where on the rest follows as before. */
+static SBYTE *block_mv;       /* mx, my and xored for each block */
 
 static int block_cmp(UBYTE *src, int stride, UBYTE *src2, int stride2, int bw, int bh, int *xored)
 {
 	int sum = 0;
 	int i, j;
-	UWORD histogram[256] = {0};
+	UWORD histogram[256];
+
+	/* Most blocks of a frame are equal to the previous frame's, which is
+	   found without the histogram */
+	for(j = 0; j < bh; j++){
+		if (memcmp(src + j * stride, src2 + j * stride2, bw) != 0)
+			break;
+	}
+	if (j == bh) {
+		*xored = 0;
+		return 0;
+	}
 
 	/* Build frequency histogram of byte values for src[] ^ src2[] */
+	memset(histogram, 0, sizeof(histogram));
 	for(j = 0; j < bh; j++){
 		for(i = 0; i < bw; i++){
 			int t = src[i] ^ src2[i];
@@ -104,11 +134,8 @@ static int block_cmp(UBYTE *src, int stride, UBYTE *src2, int stride2, int bw, i
 		src2 += stride2;
 	}
 
-	/* If not all the xored values were 0, then the blocks are different */
-	*xored = (histogram[0] < bw * bh);
-
-	/* Exit early if blocks are equal */
-	if (!*xored) return 0;
+	/* The blocks are different */
+	*xored = 1;
 
 	/* Sum the entropy of all values */
 	for(i = 0; i < 256; i++)
@@ -162,6 +189,183 @@ static int motion_estimation(UBYTE *src, int sstride, UBYTE *prev, int pstride,
 	return bv;
 }
 
+/* The frame being searched: block rows are split into bands, band 0 done
+   by the caller and band i by worker i */
+static struct {
+	UBYTE *src;
+	UBYTE *prev;
+	int rows;
+	int bands;
+} job;
+
+/* Searches blocks FIRST to LAST - 1 in order, the block before FIRST
+   having chosen (MX, MY). With CONVERGE, stops after the first block that
+   gets the vector it has already. */
+static void search_blocks(int first, int last, int mx, int my, int converge)
+{
+	int blocks_per_row = (video_width + ZMBV_BLOCK - 1) / ZMBV_BLOCK;
+	int block;
+
+	for(block = first; block < last; block++){
+		int x = (block % blocks_per_row) * ZMBV_BLOCK;
+		int y = (block / blocks_per_row) * ZMBV_BLOCK;
+		SBYTE *mv = block_mv + block * 3;
+		int xored;
+		motion_estimation(job.src + y * Screen_WIDTH + x, Screen_WIDTH,
+		                  job.prev + y * pstride + x, pstride, x, y, &mx, &my, &xored);
+		if (converge && mv[0] == mx && mv[1] == my) {
+			return;
+		}
+		mv[0] = mx;
+		mv[1] = my;
+		mv[2] = xored;
+	}
+}
+
+static int band_start(int band)
+{
+	int blocks_per_row = (video_width + ZMBV_BLOCK - 1) / ZMBV_BLOCK;
+	return job.rows * band / job.bands * blocks_per_row;
+}
+
+static void search_band(int band)
+{
+	search_blocks(band_start(band), band_start(band + 1), 0, 0, FALSE);
+}
+
+#ifdef HAVE_PTHREAD_CREATE
+/* Most threads a frame is split across, the caller included */
+#define MAX_THREADS 8
+/* Fewest block rows worth handing to a thread */
+#define MIN_BAND_ROWS 3
+
+static pthread_t workers[MAX_THREADS - 1];
+static int num_workers = 0;
+static int pool_failed = FALSE;
+static int pool_stop = FALSE;
+/* Goes up with every frame handed to the workers */
+static unsigned int job_generation = 0;
+/* job_generation when the running workers were started */
+static unsigned int start_generation = 0;
+static int bands_pending = 0;
+static pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t job_ready = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t job_done = PTHREAD_COND_INITIALIZER;
+
+static void *worker_main(void *arg)
+{
+	int band = (int) (long) arg;
+	unsigned int seen = start_generation;
+	for (;;) {
+		int run;
+		pthread_mutex_lock(&pool_lock);
+		while (job_generation == seen && !pool_stop)
+			pthread_cond_wait(&job_ready, &pool_lock);
+		if (pool_stop) {
+			pthread_mutex_unlock(&pool_lock);
+			return NULL;
+		}
+		seen = job_generation;
+		run = band < job.bands;
+		pthread_mutex_unlock(&pool_lock);
+
+		if (run) {
+			search_band(band);
+			pthread_mutex_lock(&pool_lock);
+			if (--bands_pending == 0)
+				pthread_cond_signal(&job_done);
+			pthread_mutex_unlock(&pool_lock);
+		}
+	}
+}
+
+/* Start the workers on the first inter frame; FALSE leaves it to the caller */
+static int start_pool(void)
+{
+	int n = ZMBV_threads;
+	if (num_workers > 0)
+		return TRUE;
+	if (pool_failed)
+		return FALSE;
+#if defined(HAVE_SYSCONF) && defined(_SC_NPROCESSORS_ONLN)
+	if (n <= 0)
+		n = (int) sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+	if (n > MAX_THREADS)
+		n = MAX_THREADS;
+	if (n <= 1)
+		return FALSE;
+	pool_stop = FALSE;
+	start_generation = job_generation;
+	while (num_workers < n - 1) {
+		if (pthread_create(&workers[num_workers], NULL, worker_main, (void *) (long) (num_workers + 1)) != 0)
+			break;
+		num_workers++;
+	}
+	if (num_workers == 0) {
+		Log_print("Cannot start the ZMBV threads, encoding on one thread");
+		pool_failed = TRUE;
+		return FALSE;
+	}
+	return TRUE;
+}
+
+static void stop_pool(void)
+{
+	int i;
+	pthread_mutex_lock(&pool_lock);
+	pool_stop = TRUE;
+	pthread_cond_broadcast(&job_ready);
+	pthread_mutex_unlock(&pool_lock);
+	for (i = 0; i < num_workers; i++)
+		pthread_join(workers[i], NULL);
+	num_workers = 0;
+}
+#endif /* HAVE_PTHREAD_CREATE */
+
+/* Chooses the vector of every block of the frame into block_mv */
+static void search_frame(UBYTE *src, UBYTE *prev)
+{
+	job.src = src;
+	job.prev = prev;
+	job.rows = (video_height + ZMBV_BLOCK - 1) / ZMBV_BLOCK;
+	job.bands = 1;
+#ifdef HAVE_PTHREAD_CREATE
+	if (ZMBV_threads != 1 && start_pool()) {
+		int bands = job.rows / MIN_BAND_ROWS;
+		if (bands > num_workers + 1)
+			bands = num_workers + 1;
+		if (bands > 1) {
+			int band;
+
+			pthread_mutex_lock(&pool_lock);
+			job.bands = bands;
+			bands_pending = bands - 1;
+			job_generation++;
+			pthread_cond_broadcast(&job_ready);
+			pthread_mutex_unlock(&pool_lock);
+
+			search_band(0);
+
+			pthread_mutex_lock(&pool_lock);
+			while (bands_pending > 0)
+				pthread_cond_wait(&job_done, &pool_lock);
+			pthread_mutex_unlock(&pool_lock);
+
+			/* Redo the start of each band that did not follow (0,0) */
+			for (band = 1; band < bands; band++) {
+				int first = band_start(band);
+				SBYTE *before = block_mv + (first - 1) * 3;
+				if (before[0] || before[1])
+					search_blocks(first, band_start(band + 1), before[0], before[1], TRUE);
+			}
+			return;
+		}
+	}
+#endif
+	search_band(0);
+}
+
 static int ZMBV_CreateFrame(UBYTE *source, int keyframe, UBYTE *buf, int bufsize)
 {
 	UBYTE *src;
@@ -214,8 +418,9 @@ static int ZMBV_CreateFrame(UBYTE *source, int keyframe, UBYTE *buf, int bufsize
 		UBYTE *tsrc;
 		UBYTE *tprev;
 		UBYTE *mv;
-		int mx = 0, my = 0;
+		SBYTE *block = block_mv;
 
+		search_frame(src, prev);
 		bw = (video_width + ZMBV_BLOCK - 1) / ZMBV_BLOCK;
 		bh = (video_height + ZMBV_BLOCK - 1) / ZMBV_BLOCK;
 		mv = work + work_size;
@@ -224,16 +429,16 @@ static int ZMBV_CreateFrame(UBYTE *source, int keyframe, UBYTE *buf, int bufsize
 		/* for now just XOR'ing */
 		for(y = 0; y < video_height; y += ZMBV_BLOCK) {
 			bh2 = FFMIN(video_height - y, ZMBV_BLOCK);
-			for(x = 0; x < video_width; x += ZMBV_BLOCK, mv += 2) {
+			for(x = 0; x < video_width; x += ZMBV_BLOCK, mv += 2, block += 3) {
 				bw2 = FFMIN(video_width - x, ZMBV_BLOCK);
 
 				tsrc = src + x;
 				tprev = prev + x;
 
-				motion_estimation(tsrc, Screen_WIDTH, tprev, pstride, x, y, &mx, &my, &xored);
-				mv[0] = (mx * 2) | !!xored;
-				mv[1] = my * 2;
-				tprev += mx + my * pstride;
+				xored = block[2];
+				mv[0] = (block[0] * 2) | !!xored;
+				mv[1] = block[1] * 2;
+				tprev += block[0] + block[1] * pstride;
 				if(xored){
 					for(j = 0; j < bh2; j++){
 						for(i = 0; i < bw2; i++)
@@ -285,7 +490,11 @@ static int ZMBV_CreateFrame(UBYTE *source, int keyframe, UBYTE *buf, int bufsize
 
 static int ZMBV_End(void)
 {
+#ifdef HAVE_PTHREAD_CREATE
+	stop_pool();
+#endif
 	free(prev_buf);
+	free(block_mv);
 #ifdef HAVE_LIBZ
 	if (zlib_init_ok) {
 		free(work_buf);
@@ -326,6 +535,7 @@ static int ZMBV_Init(int width, int height, int left_margin, int top_margin)
 
 	/* Motion estimation range: maximum distance is -64..63 */
 	lrange = urange = 2;
+	block_mv = (SBYTE *)Util_malloc(((video_width + ZMBV_BLOCK - 1) / ZMBV_BLOCK) * ((video_height + ZMBV_BLOCK - 1) / ZMBV_BLOCK) * 3);
 
 	work_size = video_width * video_height + 1024 +
 		((video_width + ZMBV_BLOCK - 1) / ZMBV_BLOCK) * ((video_height + ZMBV_BLOCK - 1) / ZMBV_BLOCK) * 2 + 4;
@@ -6,5 +6,8 @@
 
 extern VIDEO_CODEC_t Video_Codec_ZMBV;
 
+/* Threads motion estimation is split across, 0 for one per core */
+extern int ZMBV_threads;
+
 #endif /* CODECS_VIDEO_ZMBV_H_ */
 
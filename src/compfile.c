@@ -36,11 +36,66 @@
 #include "log.h"
 #include "util.h"
 
+/* Decompressed output -------------------------------------------------- */
+
+/* Output of the decompressors: a file, or a buffer that grows as needed */
+typedef struct {
+	FILE *fp;
+	UBYTE *data;
+	ULONG size;
+	ULONG alloc;
+	ULONG pos;
+} Output;
+
+static int output_save(Output *out, const void *buf, int size)
+{
+	if (out->fp != NULL)
+		return (int) fwrite(buf, 1, size, out->fp) == size;
+	if (out->pos + size > out->alloc) {
+		out->alloc = out->alloc == 0 ? 65536 : out->alloc * 2;
+		if (out->alloc < out->pos + size)
+			out->alloc = out->pos + size;
+		out->data = (UBYTE *) Util_realloc(out->data, out->alloc);
+	}
+	memcpy(out->data + out->pos, buf, size);
+	out->pos += size;
+	if (out->pos > out->size)
+		out->size = out->pos;
+	return TRUE;
+}
+
+static void output_rewind(Output *out)
+{
+	if (out->fp != NULL)
+		Util_rewind(out->fp);
+	else
+		out->pos = 0;
+}
+
+static void output_init(Output *out, FILE *fp)
+{
+	out->fp = fp;
+	out->data = NULL;
+	out->size = 0;
+	out->alloc = 0;
+	out->pos = 0;
+}
+
+/* Hands the buffer of OUT to the caller, or frees it if FALSE */
+static int output_finish(Output *out, int result, UBYTE **data, ULONG *size)
+{
+	if (!result) {
+		free(out->data);
+		return FALSE;
+	}
+	*data = out->data != NULL ? out->data : (UBYTE *) Util_malloc(1);
+	*size = out->size;
+	return TRUE;
+}
+
 /* GZ decompression ------------------------------------------------------ */
 
-/* Opens a GZIP compressed file and decompresses its contents to outfp.
-   Returns TRUE on success. */
-int CompFile_ExtractGZ(const char *infilename, FILE *outfp)
+static int extract_gz(const char *infilename, Output *out)
 {
 #ifndef HAVE_LIBZ
 	Log_print("This executable cannot decompress ZLIB files");
@@ -59,7 +114,7 @@ int CompFile_ExtractGZ(const char *infilename, FILE *outfp)
 	do {
 		result = gzread(gzf, buf, UNCOMPRESS_BUFFER_SIZE);
 		if (result > 0) {
-			if ((int) fwrite(buf, 1, result, outfp) != result)
+			if (!output_save(out, buf, result))
 				result = -1;
 		}
 	} while (result == UNCOMPRESS_BUFFER_SIZE);
@@ -69,6 +124,22 @@ int CompFile_ExtractGZ(const char *infilename, FILE *outfp)
 #endif	/* HAVE_LIBZ */
 }
 
+/* Opens a GZIP compressed file and decompresses its contents to outfp.
+   Returns TRUE on success. */
+int CompFile_ExtractGZ(const char *infilename, FILE *outfp)
+{
+	Output out;
+	output_init(&out, outfp);
+	return extract_gz(infilename, &out);
+}
+
+int CompFile_ExtractGZToBuffer(const char *infilename, UBYTE **data, ULONG *size)
+{
+	Output out;
+	output_init(&out, NULL);
+	return output_finish(&out, extract_gz(infilename, &out), data, size);
+}
+
 
 /* DCM decompression ----------------------------------------------------- */
 
@@ -90,13 +161,8 @@ static int fload(void *buf, int size, FILE *fp)
 	return (int) fread(buf, 1, size, fp) == size;
 }
 
-static int fsave(void *buf, int size, FILE *fp)
-{
-	return (int) fwrite(buf, 1, size, fp) == size;
-}
-
 typedef struct {
-	FILE *fp;
+	Output *out;
 	int sectorcount;
 	int sectorsize;
 	int current_sector;
@@ -122,12 +188,12 @@ static int write_atr_header(const ATR_Info *pai)
 	header.seccounthi = (UBYTE) (paras >> 8);
 	header.hiseccountlo = (UBYTE) (paras >> 16);
 	header.hiseccounthi = (UBYTE) (paras >> 24);
-	return fsave(&header, sizeof(header), pai->fp);
+	return output_save(pai->out, &header, sizeof(header));
 }
 
 static int write_atr_sector(ATR_Info *pai, UBYTE *buf)
 {
-	return fsave(buf, pai->current_sector++ <= 3 ? 128 : pai->sectorsize, pai->fp);
+	return output_save(pai->out, buf, pai->current_sector++ <= 3 ? 128 : pai->sectorsize);
 }
 
 static int pad_till_sector(ATR_Info *pai, int till_sector)
@@ -233,7 +299,7 @@ static int dcm_pass(FILE *infp, ATR_Info *pai)
 	}
 }
 
-int CompFile_DCMtoATR(FILE *infp, FILE *outfp)
+static int dcm_to_atr(FILE *infp, Output *out)
 {
 	int archive_type;
 	int archive_flags;
@@ -252,7 +318,7 @@ int CompFile_DCMtoATR(FILE *infp, FILE *outfp)
 			Log_print("It seems that DCMs of a multi-file archive have been combined in wrong order");
 		return FALSE;
 	}
-	ai.fp = outfp;
+	ai.out = out;
 	ai.current_sector = 1;
 	switch ((archive_flags >> 5) & 3) {
 	case 0:
@@ -306,6 +372,20 @@ int CompFile_DCMtoATR(FILE *infp, FILE *outfp)
 		return pad_till_sector(&ai, ai.sectorcount + 1);
 	/* more sectors written: update ATR header */
 	ai.sectorcount = last_sector;
-	Util_rewind(outfp);
+	output_rewind(out);
 	return write_atr_header(&ai);
 }
+
+int CompFile_DCMtoATR(FILE *infp, FILE *outfp)
+{
+	Output out;
+	output_init(&out, outfp);
+	return dcm_to_atr(infp, &out);
+}
+
+int CompFile_DCMtoATRBuffer(FILE *infp, UBYTE **data, ULONG *size)
+{
+	Output out;
+	output_init(&out, NULL);
+	return output_finish(&out, dcm_to_atr(infp, &out), data, size);
+}
@@ -3,7 +3,15 @@
 
 #include <stdio.h>  /* FILE */
 
+#include "atari.h"
+
 int CompFile_ExtractGZ(const char *infilename, FILE *outfp);
 int CompFile_DCMtoATR(FILE *infp, FILE *outfp);
 
+/* Like the above, but decompress to a buffer allocated with malloc, stored
+   in *DATA with its size in *SIZE. Return FALSE, with nothing allocated,
+   on error. */
+int CompFile_ExtractGZToBuffer(const char *infilename, UBYTE **data, ULONG *size);
+int CompFile_DCMtoATRBuffer(FILE *infp, UBYTE **data, ULONG *size);
+
 #endif /* COMPFILE_H_ */
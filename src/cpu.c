@@ -68,6 +68,10 @@
 #include "esc.h"
 #include "memory.h"
 #include "monitor.h"
+#include "ai_interface.h"
+#include "ai_heatmap.h"
+#include "ai_history.h"
+#include "ai_trace.h"
 #ifndef BASIC
 #include "statesav.h"
 #ifndef __PLUS
@@ -315,6 +319,7 @@ void CPU_PutStatus(void)
 		else \
 			CPU_delayed_nmi = 1; \
 		ANTIC_xpos++; \
+		IDLE_CHECK(addr); \
 		SET_PC(addr); \
 		DONE; \
 	} \
@@ -322,6 +327,355 @@ void CPU_PutStatus(void)
 	DONE;
 #endif
 
+/* Store that reports a change of a watched address, see AI_write_watch.
+   ADDR is passed on as it is, so the store itself is the same as without
+   the watch. */
+#ifndef ASAP
+#define WATCHED_PUT(put, addr, byte) do { \
+		if (AI_write_watch != NULL && AI_write_watch[(UWORD) (addr)]) { \
+			UBYTE watch_old = MEMORY_mem[(UWORD) (addr)]; \
+			put(addr, byte); \
+			UPDATE_GLOBAL_REGS; \
+			AI_WriteHit((UWORD) (addr), watch_old); \
+		} \
+		else \
+			put(addr, byte); \
+	} while (0)
+#endif
+
+/* Idle loop skipping. A loop that only reads plain memory and VCOUNT and
+   branches back does the same thing every time round until something
+   outside the CPU changes memory, which cannot happen inside one CPU_GO()
+   call: NMIs come between calls and IRQs are only taken on CLI, PLP and
+   RTI. So once one pass through the loop has left every register and
+   flag as it found them, the fast loop moves ANTIC_xpos on by whole
+   passes to just before the limit, and the last pass runs as usual. The
+   machine ends up as it would have without the skip, cycle for cycle. */
+int CPU_idle_skip = TRUE;
+
+#ifndef ASAP
+/* Longest loop body looked at, in bytes */
+#define IDLE_MAX_LOOP 32
+
+/* Addressing mode of the instructions an idle loop may contain:
+   1 implied/accumulator, 2 #imm, 3 zp, 4 zp,X, 5 zp,Y, 6 abs, 7 abs,X,
+   8 abs,Y, 9 (zp,X), 10 (zp),Y, 11 branch, 0 not allowed */
+static const UBYTE idle_mode[256] =
+{
+	0, 9, 0, 0, 0, 3, 0, 0, 0, 2, 1, 0, 0, 6, 0, 0,		/* 0x */
+	11, 10, 0, 0, 0, 4, 0, 0, 1, 8, 0, 0, 0, 7, 0, 0,	/* 1x */
+	0, 9, 0, 0, 3, 3, 0, 0, 0, 2, 1, 0, 6, 6, 0, 0,		/* 2x */
+	11, 10, 0, 0, 0, 4, 0, 0, 1, 8, 0, 0, 0, 7, 0, 0,	/* 3x */
+	0, 9, 0, 0, 0, 3, 0, 0, 0, 2, 1, 0, 0, 6, 0, 0,		/* 4x */
+	11, 10, 0, 0, 0, 4, 0, 0, 0, 8, 0, 0, 0, 7, 0, 0,	/* 5x */
+	0, 9, 0, 0, 0, 3, 0, 0, 0, 2, 1, 0, 0, 6, 0, 0,		/* 6x */
+	11, 10, 0, 0, 0, 4, 0, 0, 0, 8, 0, 0, 0, 7, 0, 0,	/* 7x */
+	0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 1, 0, 0, 0, 0, 0,		/* 8x */
+	11, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0,	/* 9x */
+	2, 9, 2, 0, 3, 3, 3, 0, 1, 2, 1, 0, 6, 6, 6, 0,		/* Ax */
+	11, 10, 0, 0, 4, 4, 5, 0, 1, 8, 0, 0, 7, 7, 8, 0,	/* Bx */
+	2, 9, 0, 0, 3, 3, 0, 0, 1, 2, 1, 0, 6, 6, 0, 0,		/* Cx */
+	11, 10, 0, 0, 0, 4, 0, 0, 0, 8, 0, 0, 0, 7, 0, 0,	/* Dx */
+	2, 9, 0, 0, 3, 3, 0, 0, 1, 2, 1, 0, 6, 6, 0, 0,		/* Ex */
+	11, 10, 0, 0, 0, 4, 0, 0, 0, 8, 0, 0, 0, 7, 0, 0	/* Fx */
+};
+
+#ifdef PAGED_ATTRIB
+#define IDLE_PLAIN(a)	(MEMORY_readmap[(a) >> 8] == NULL)
+#else
+#define IDLE_PLAIN(a)	(MEMORY_attrib[a] != MEMORY_HARDWARE)
+#endif
+/* VCOUNT only changes at the end of the scanline, past any limit */
+#define IDLE_READ_OK(a)	(IDLE_PLAIN(a) || ((a) & 0xff0f) == 0xd40b)
+
+/* Most waiting loops also test for a way out, a key or BREAK, with a
+   branch that leaves the loop, so idle_loop() follows the loop as the
+   CPU would: from the registers and flags it was entered with, reading
+   the memory it reads, taking each branch or not. A branch on a flag it
+   cannot work out (after ADC or SBC) ends the look unless it is the last
+   one, which has just been taken. */
+#define IDLE_MAX_STEPS 32
+#define IDLE_MAX_READS 16
+
+/* The last loop idle_loop() accepted, so that the next CPU_GO() call can
+   accept it again by checking that its code and the memory it read are
+   the same. Loops that read through zero page pointers are not kept. */
+static struct {
+	int len;						/* 0 = none */
+	UWORD start;
+	UBYTE a;
+	UBYTE x;
+	UBYTE y;
+	UBYTE p;
+	int reads;
+	UBYTE code[IDLE_MAX_LOOP];
+	UWORD read[IDLE_MAX_READS];
+	UBYTE value[IDLE_MAX_READS];
+} idle_last;
+
+/* N and Z of a result, -1 = not known */
+#define IDLE_NZ(r)		(n = (r) < 0 ? -1 : (r) >> 7, z = (r) < 0 ? -1 : (r) == 0)
+#define IDLE_CMP(r)		if ((r) < 0 || val < 0) n = z = c = -1; \
+						else { int t = (r) - val; c = t >= 0; n = (t >> 7) & 1; z = (t & 0xff) == 0; }
+#define IDLE_LOGIC(e)	a = a < 0 || val < 0 ? -1 : (e); IDLE_NZ(a)
+#define IDLE_STEP(r, d)	if ((r) >= 0) (r) = ((r) + (d)) & 0xff; IDLE_NZ(r)
+
+/* Whether the loop from start to the branch that ends just before end,
+   which has just branched back to start with these registers and flags,
+   only reads memory that cannot change in CPU_GO() and comes back to
+   that branch without leaving */
+static int idle_loop(UWORD start, UWORD end, UBYTE A, UBYTE X, UBYTE Y, UBYTE P)
+{
+	UWORD reads[IDLE_MAX_READS];
+	UBYTE values[IDLE_MAX_READS];
+	int len = (UWORD) (end - start);
+	int a = A, x = X, y = Y;
+	int n = P >> 7, v = (P >> 6) & 1, z = (P >> 1) & 1, c = P & 1;
+	UWORD pc = start;
+	int keep = TRUE;
+	int r = 0;
+	int i;
+
+	if (len > IDLE_MAX_LOOP || len < 2)
+		return FALSE;
+	if (len == idle_last.len && start == idle_last.start && A == idle_last.a && X == idle_last.x
+		&& Y == idle_last.y && P == idle_last.p && memcmp(MEMORY_mem + start, idle_last.code, len) == 0) {
+		for (i = 0; i < idle_last.reads; i++)
+			if (!IDLE_READ_OK(idle_last.read[i]) || MEMORY_SafeGetByte(idle_last.read[i]) != idle_last.value[i])
+				break;
+		if (i == idle_last.reads)
+			return TRUE;
+	}
+	for (i = 0; i < IDLE_MAX_STEPS; i++) {
+		UWORD off = (UWORD) (pc - start);
+		UBYTE op;
+		int addr = -1;
+		int val = -1;
+		if (off >= len)
+			return FALSE;
+		op = MEMORY_dGetByte(pc);
+		switch (idle_mode[op]) {
+		case 1:
+			break;
+		case 2:
+			val = MEMORY_dGetByte((UWORD) (pc + 1));
+			break;
+		case 3:
+			addr = MEMORY_dGetByte((UWORD) (pc + 1));
+			break;
+		case 4:
+			if (x < 0)
+				return FALSE;
+			addr = (UBYTE) (MEMORY_dGetByte((UWORD) (pc + 1)) + x);
+			break;
+		case 5:
+			if (y < 0)
+				return FALSE;
+			addr = (UBYTE) (MEMORY_dGetByte((UWORD) (pc + 1)) + y);
+			break;
+		case 6:
+			addr = MEMORY_dGetWord((UWORD) (pc + 1));
+			break;
+		case 7:
+			if (x < 0)
+				return FALSE;
+			addr = (UWORD) (MEMORY_dGetWord((UWORD) (pc + 1)) + x);
+			break;
+		case 8:
+			if (y < 0)
+				return FALSE;
+			addr = (UWORD) (MEMORY_dGetWord((UWORD) (pc + 1)) + y);
+			break;
+		case 9:
+			if (x < 0)
+				return FALSE;
+			addr = (UBYTE) (MEMORY_dGetByte((UWORD) (pc + 1)) + x);
+			if (!IDLE_PLAIN(addr) || !IDLE_PLAIN((UBYTE) (addr + 1)))
+				return FALSE;
+			addr = zGetWord(addr);
+			keep = FALSE;
+			break;
+		case 10:
+			if (y < 0)
+				return FALSE;
+			addr = MEMORY_dGetByte((UWORD) (pc + 1));
+			if (!IDLE_PLAIN(addr) || !IDLE_PLAIN((UBYTE) (addr + 1)))
+				return FALSE;
+			addr = (UWORD) (zGetWord(addr) + y);
+			keep = FALSE;
+			break;
+		case 11:
+			{
+				/* Bits 7-6 of a branch pick N, V, C or Z, bit 5 the value
+				   that takes it */
+				int flag = (op >> 6) == 0 ? n : (op >> 6) == 1 ? v : (op >> 6) == 2 ? c : z;
+				if (off == len - 2) {
+					if (flag >= 0 && flag != ((op >> 5) & 1))
+						return FALSE;
+					goto accepted;
+				}
+				if (flag < 0)
+					return FALSE;
+				if (flag == ((op >> 5) & 1))
+					pc = (UWORD) (pc + 2 + (SBYTE) MEMORY_dGetByte((UWORD) (pc + 1)));
+				else
+					pc += 2;
+			}
+			continue;
+		default:
+			return FALSE;
+		}
+		if (addr >= 0) {
+			if (!IDLE_READ_OK(addr) || r == IDLE_MAX_READS)
+				return FALSE;
+			val = MEMORY_SafeGetByte(addr);
+			reads[r] = (UWORD) addr;
+			values[r++] = (UBYTE) val;
+		}
+		switch (op) {
+		case 0x0a:	/* ASL A */
+			if (a < 0)
+				n = z = c = -1;
+			else {
+				c = a >> 7;
+				a = (a << 1) & 0xff;
+				IDLE_NZ(a);
+			}
+			break;
+		case 0x4a:	/* LSR A */
+			if (a < 0)
+				n = z = c = -1;
+			else {
+				c = a & 1;
+				a >>= 1;
+				IDLE_NZ(a);
+			}
+			break;
+		case 0x2a:	/* ROL A */
+			if (a < 0 || c < 0)
+				a = n = z = c = -1;
+			else {
+				int t = ((a << 1) | c) & 0xff;
+				c = a >> 7;
+				a = t;
+				IDLE_NZ(a);
+			}
+			break;
+		case 0x6a:	/* ROR A */
+			if (a < 0 || c < 0)
+				a = n = z = c = -1;
+			else {
+				int t = (a >> 1) | (c << 7);
+				c = a & 1;
+				a = t;
+				IDLE_NZ(a);
+			}
+			break;
+		case 0x18:
+			c = 0;
+			break;
+		case 0x38:
+			c = 1;
+			break;
+		case 0xb8:
+			v = 0;
+			break;
+		case 0xea:
+			break;
+		case 0x88:
+			IDLE_STEP(y, -1);
+			break;
+		case 0xc8:
+			IDLE_STEP(y, 1);
+			break;
+		case 0xca:
+			IDLE_STEP(x, -1);
+			break;
+		case 0xe8:
+			IDLE_STEP(x, 1);
+			break;
+		case 0x8a:
+			a = x;
+			IDLE_NZ(a);
+			break;
+		case 0x98:
+			a = y;
+			IDLE_NZ(a);
+			break;
+		case 0xa8:
+			y = a;
+			IDLE_NZ(y);
+			break;
+		case 0xaa:
+			x = a;
+			IDLE_NZ(x);
+			break;
+		case 0xa0: case 0xa4: case 0xac: case 0xb4: case 0xbc:
+			y = val;
+			IDLE_NZ(y);
+			break;
+		case 0xa2: case 0xa6: case 0xae: case 0xb6: case 0xbe:
+			x = val;
+			IDLE_NZ(x);
+			break;
+		case 0xc0: case 0xc4: case 0xcc:
+			IDLE_CMP(y);
+			break;
+		case 0xe0: case 0xe4: case 0xec:
+			IDLE_CMP(x);
+			break;
+		case 0x24: case 0x2c:	/* BIT */
+			n = val < 0 ? -1 : val >> 7;
+			v = val < 0 ? -1 : (val >> 6) & 1;
+			z = a < 0 || val < 0 ? -1 : (a & val) == 0;
+			break;
+		default:
+			/* The rest are ORA, AND, EOR, ADC, LDA, CMP and SBC */
+			switch (op >> 5) {
+			case 0:
+				IDLE_LOGIC(a | val);
+				break;
+			case 1:
+				IDLE_LOGIC(a & val);
+				break;
+			case 2:
+				IDLE_LOGIC(a ^ val);
+				break;
+			case 5:
+				a = val;
+				IDLE_NZ(a);
+				break;
+			case 6:
+				IDLE_CMP(a);
+				break;
+			default:
+				/* ADC and SBC, with decimal mode and all, are not followed */
+				a = n = z = c = v = -1;
+				break;
+			}
+			break;
+		}
+		pc += idle_mode[op] == 1 ? 1 : idle_mode[op] >= 6 && idle_mode[op] <= 8 ? 3 : 2;
+	}
+	return FALSE;
+
+accepted:
+	if (keep) {
+		idle_last.len = len;
+		idle_last.start = start;
+		idle_last.a = A;
+		idle_last.x = X;
+		idle_last.y = Y;
+		idle_last.p = P;
+		idle_last.reads = r;
+		memcpy(idle_last.code, MEMORY_mem + start, len);
+		memcpy(idle_last.read, reads, r * sizeof(UWORD));
+		memcpy(idle_last.value, values, r);
+	}
+	return TRUE;
+}
+#endif /* ASAP */
+
 /* 1 extra cycle for X (or Y) index overflow */
 #define NCYCLES_X   if ((UBYTE) addr < X) ANTIC_xpos++
 #define NCYCLES_Y   if ((UBYTE) addr < Y) ANTIC_xpos++
@@ -362,6 +716,11 @@ void CPU_PutStatus(void)
 
 #endif /* FALCON_CPUASM */
 
+#ifdef LIBATARI800
+int CPU_stopped = 0;
+static int stopped_nmi = FALSE;  /* an NMI came while stopped */
+#endif
+
 /* Triggers a Non-Maskable Interrupt */
 void CPU_NMI(void)
 {
@@ -372,6 +731,13 @@ void CPU_NMI(void)
 
 	if(CPU_delayed_nmi > 0)
 		CPU_GO(ANTIC_xpos_limit + CPU_delayed_nmi);
+#ifdef LIBATARI800
+	if (CPU_stopped) {
+		/* taken when the CPU runs again */
+		stopped_nmi = TRUE;
+		return;
+	}
+#endif
 
 	S = CPU_regS;
 	PHW(CPU_regPC);
@@ -380,6 +746,11 @@ void CPU_NMI(void)
 	CPU_regPC = MEMORY_dGetWordAligned(0xfffa);
 	CPU_regS = S;
 	ANTIC_xpos += 7; /* handling an interrupt by 6502 takes 7 cycles */
+	ANTIC_cycles.cpu += 7;
+	if (ANTIC_NMIST & 0x80)
+		ANTIC_cycles.dlis++;
+	else if (ANTIC_NMIST & 0x40)
+		ANTIC_cycles.vbis++;
 	INC_RET_NESTING;
 }
 
@@ -402,6 +773,7 @@ void CPU_NMI(void)
 		SET_PC(MEMORY_dGetWordAligned(0xfffe)); \
 		CPUCHECKIRQ_RESTORE_S; \
 		ANTIC_xpos += 7; \
+		ANTIC_cycles.irqs++; \
 		INC_RET_NESTING; \
 	}
 
@@ -445,2018 +817,176 @@ static const int cycles[256] =
 	2, 5, 2, 8, 4, 4, 6, 6, 2, 4, 2, 7, 4, 4, 7, 7		/* Fx */
 };
 
-/* 6502 emulation routine */
-#ifndef NO_GOTO
-__extension__ /* suppress -ansi -pedantic warnings */
-#endif
-void CPU_GO(int limit)
-{
-#ifdef NO_GOTO
-#define OPCODE_ALIAS(code)	case 0x##code:
-#define DONE				break
-#else
-#define OPCODE_ALIAS(code)	opcode_##code:
-#define DONE				goto next
-	static const void *opcode[256] =
-	{
-		&&opcode_00, &&opcode_01, &&opcode_02, &&opcode_03,
-		&&opcode_04, &&opcode_05, &&opcode_06, &&opcode_07,
-		&&opcode_08, &&opcode_09, &&opcode_0a, &&opcode_0b,
-		&&opcode_0c, &&opcode_0d, &&opcode_0e, &&opcode_0f,
-
-		&&opcode_10, &&opcode_11, &&opcode_12, &&opcode_13,
-		&&opcode_14, &&opcode_15, &&opcode_16, &&opcode_17,
-		&&opcode_18, &&opcode_19, &&opcode_1a, &&opcode_1b,
-		&&opcode_1c, &&opcode_1d, &&opcode_1e, &&opcode_1f,
-
-		&&opcode_20, &&opcode_21, &&opcode_22, &&opcode_23,
-		&&opcode_24, &&opcode_25, &&opcode_26, &&opcode_27,
-		&&opcode_28, &&opcode_29, &&opcode_2a, &&opcode_2b,
-		&&opcode_2c, &&opcode_2d, &&opcode_2e, &&opcode_2f,
-
-		&&opcode_30, &&opcode_31, &&opcode_32, &&opcode_33,
-		&&opcode_34, &&opcode_35, &&opcode_36, &&opcode_37,
-		&&opcode_38, &&opcode_39, &&opcode_3a, &&opcode_3b,
-		&&opcode_3c, &&opcode_3d, &&opcode_3e, &&opcode_3f,
-
-		&&opcode_40, &&opcode_41, &&opcode_42, &&opcode_43,
-		&&opcode_44, &&opcode_45, &&opcode_46, &&opcode_47,
-		&&opcode_48, &&opcode_49, &&opcode_4a, &&opcode_4b,
-		&&opcode_4c, &&opcode_4d, &&opcode_4e, &&opcode_4f,
-
-		&&opcode_50, &&opcode_51, &&opcode_52, &&opcode_53,
-		&&opcode_54, &&opcode_55, &&opcode_56, &&opcode_57,
-		&&opcode_58, &&opcode_59, &&opcode_5a, &&opcode_5b,
-		&&opcode_5c, &&opcode_5d, &&opcode_5e, &&opcode_5f,
-
-		&&opcode_60, &&opcode_61, &&opcode_62, &&opcode_63,
-		&&opcode_64, &&opcode_65, &&opcode_66, &&opcode_67,
-		&&opcode_68, &&opcode_69, &&opcode_6a, &&opcode_6b,
-		&&opcode_6c, &&opcode_6d, &&opcode_6e, &&opcode_6f,
-
-		&&opcode_70, &&opcode_71, &&opcode_72, &&opcode_73,
-		&&opcode_74, &&opcode_75, &&opcode_76, &&opcode_77,
-		&&opcode_78, &&opcode_79, &&opcode_7a, &&opcode_7b,
-		&&opcode_7c, &&opcode_7d, &&opcode_7e, &&opcode_7f,
-
-		&&opcode_80, &&opcode_81, &&opcode_82, &&opcode_83,
-		&&opcode_84, &&opcode_85, &&opcode_86, &&opcode_87,
-		&&opcode_88, &&opcode_89, &&opcode_8a, &&opcode_8b,
-		&&opcode_8c, &&opcode_8d, &&opcode_8e, &&opcode_8f,
-
-		&&opcode_90, &&opcode_91, &&opcode_92, &&opcode_93,
-		&&opcode_94, &&opcode_95, &&opcode_96, &&opcode_97,
-		&&opcode_98, &&opcode_99, &&opcode_9a, &&opcode_9b,
-		&&opcode_9c, &&opcode_9d, &&opcode_9e, &&opcode_9f,
-
-		&&opcode_a0, &&opcode_a1, &&opcode_a2, &&opcode_a3,
-		&&opcode_a4, &&opcode_a5, &&opcode_a6, &&opcode_a7,
-		&&opcode_a8, &&opcode_a9, &&opcode_aa, &&opcode_ab,
-		&&opcode_ac, &&opcode_ad, &&opcode_ae, &&opcode_af,
-
-		&&opcode_b0, &&opcode_b1, &&opcode_b2, &&opcode_b3,
-		&&opcode_b4, &&opcode_b5, &&opcode_b6, &&opcode_b7,
-		&&opcode_b8, &&opcode_b9, &&opcode_ba, &&opcode_bb,
-		&&opcode_bc, &&opcode_bd, &&opcode_be, &&opcode_bf,
-
-		&&opcode_c0, &&opcode_c1, &&opcode_c2, &&opcode_c3,
-		&&opcode_c4, &&opcode_c5, &&opcode_c6, &&opcode_c7,
-		&&opcode_c8, &&opcode_c9, &&opcode_ca, &&opcode_cb,
-		&&opcode_cc, &&opcode_cd, &&opcode_ce, &&opcode_cf,
-
-		&&opcode_d0, &&opcode_d1, &&opcode_d2, &&opcode_d3,
-		&&opcode_d4, &&opcode_d5, &&opcode_d6, &&opcode_d7,
-		&&opcode_d8, &&opcode_d9, &&opcode_da, &&opcode_db,
-		&&opcode_dc, &&opcode_dd, &&opcode_de, &&opcode_df,
-
-		&&opcode_e0, &&opcode_e1, &&opcode_e2, &&opcode_e3,
-		&&opcode_e4, &&opcode_e5, &&opcode_e6, &&opcode_e7,
-		&&opcode_e8, &&opcode_e9, &&opcode_ea, &&opcode_eb,
-		&&opcode_ec, &&opcode_ed, &&opcode_ee, &&opcode_ef,
-
-		&&opcode_f0, &&opcode_f1, &&opcode_f2, &&opcode_f3,
-		&&opcode_f4, &&opcode_f5, &&opcode_f6, &&opcode_f7,
-		&&opcode_f8, &&opcode_f9, &&opcode_fa, &&opcode_fb,
-		&&opcode_fc, &&opcode_fd, &&opcode_fe, &&opcode_ff,
-	};
-#endif	/* NO_GOTO */
-
-#ifdef CYCLES_PER_OPCODE
-#define OPCODE(code) OPCODE_ALIAS(code) ANTIC_xpos += cycles[0x##code];
-#else
-#define OPCODE(code) OPCODE_ALIAS(code)
-#endif
 
-#ifdef PC_PTR
-	const UBYTE *PC;
-#else
-	UWORD PC;
+/* CPU_GO() points at one of these, see CPU_UpdateGo() */
+static void CPU_GO_fast(int limit);
+#ifndef ASAP
+static void CPU_GO_coverage(int limit);
 #endif
-	UBYTE A;
-	UBYTE X;
-	UBYTE Y;
-	UBYTE S;
-
-	UWORD addr;
-	UBYTE data;
-#define insn data
-
-#else /* FALCON_CPUASM */
-
-void CPU_GO(int limit)
-{
-#endif /* FALCON_CPUASM */
-
-/*
-   This used to be in the main loop but has been removed to improve
-   execution speed. It does not seem to have any adverse effect on
-   the emulation for two reasons:
-
-   1. NMI's will can only be raised in antic.c - there is
-      no way an NMI can be generated whilst in this routine.
-
-   2. The timing of the IRQs are not that critical. */
-
-	if (ANTIC_wsync_halt) {
-
-#ifdef NEW_CYCLE_EXACT
-		if (ANTIC_DRAWING_SCREEN) {
-/* if ANTIC_WSYNC_C is a stolen cycle, ANTIC_antic2cpu_ptr will convert that to the nearest
-   cpu cycle before that cycle.  The CPU will see this cycle, if WSYNC is not
-   delayed. (Actually this cycle is the first cycle of the instruction after
-   STA WSYNC, which was really executed one cycle after STA WSYNC because
-   of an internal antic delay ).   ANTIC_delayed_wsync is added to this cycle to form
-   the limit in the case that WSYNC is not early (does not allow this extra cycle) */
-
-			if (limit < ANTIC_antic2cpu_ptr[ANTIC_WSYNC_C] + ANTIC_delayed_wsync)
-				return;
-			ANTIC_xpos = ANTIC_antic2cpu_ptr[ANTIC_WSYNC_C] + ANTIC_delayed_wsync;
-		}
-		else {
-			if (limit < (ANTIC_WSYNC_C + ANTIC_delayed_wsync))
-				return;
-			ANTIC_xpos = ANTIC_WSYNC_C;
-		}
-		ANTIC_delayed_wsync = 0;
-
-#else /* NEW_CYCLE_EXACT */
-
-		if (limit < ANTIC_WSYNC_C)
-			return;
-		ANTIC_xpos = ANTIC_WSYNC_C;
-
-#endif /* NEW_CYCLE_EXACT */
-
-		ANTIC_wsync_halt = 0;
-	}
-	ANTIC_xpos_limit = limit;			/* needed for WSYNC store inside ANTIC */
-
-	UPDATE_LOCAL_REGS;
-
-	CPUCHECKIRQ;
-
-#ifndef FALCON_CPUASM
-	while (ANTIC_xpos < ANTIC_xpos_limit) {
-		CPU_delayed_nmi = 0;
-#ifdef MONITOR_PROFILE
-		int old_xpos = ANTIC_xpos;
-		UWORD old_PC = GET_PC();
+static void CPU_GO_checks(int limit);
+#if defined(MONITOR_TRACE) || defined(MONITOR_PROFILE) || !defined(ASAP)
+static void CPU_GO_trace(int limit);
 #endif
 
-
-#ifdef MONITOR_BREAKPOINTS
-	breakpoint_return:
-#endif
-
-#ifdef PC_PTR
-		/* must handle 64k wrapping */
-		if (PC >= MEMORY_mem + 0xfffe) {
-			if (PC >= MEMORY_mem + 0x10000)
-				PC -= 0x10000;
-			else {
-				/* the opcode is before 0x10000, but the operand is past */
-#ifdef WORDS_UNALIGNED_OK
-				*(UWORD *) (MEMORY_mem + 0x10000) = *(UWORD *) MEMORY_mem;
-#else
-				MEMORY_mem[0x10000] = MEMORY_mem[0];
-				MEMORY_mem[0x10001] = MEMORY_mem[1];
-#endif /* WORDS_UNALIGNED_OK */
-			}
-		}
-#endif /* PC_PTR */
-
-#ifdef MONITOR_TRACE
-		if (MONITOR_trace_file != NULL) {
-			MONITOR_ShowState(MONITOR_trace_file, GET_PC(), A, X, Y, S,
-				(N & 0x80) ? 'N' : '-',
-#ifndef NO_V_FLAG_VARIABLE
-				V ? 'V' : '-',
-#else
-				(CPU_regP & CPU_V_FLAG) ? 'V' : '-',
-#endif
-				(Z == 0) ? 'Z' : '-',
-				(C != 0) ? 'C' : '-');
-		}
-#endif
-
-#ifdef MONITOR_BREAK
-		CPU_remember_PC[CPU_remember_PC_curpos] = GET_PC();
-		CPU_remember_op[CPU_remember_PC_curpos][0] = MEMORY_dGetByte(GET_PC());
-		CPU_remember_op[CPU_remember_PC_curpos][1] = MEMORY_dGetByte(GET_PC()+1);
-		CPU_remember_op[CPU_remember_PC_curpos][2] = MEMORY_dGetByte(GET_PC()+2);
-#ifdef NEW_CYCLE_EXACT
-		if (ANTIC_DRAWING_SCREEN)
-			CPU_remember_xpos[CPU_remember_PC_curpos] = ANTIC_cpu2antic_ptr[ANTIC_xpos] + (ANTIC_ypos << 8);
-		else
+#define CPU_GO_NAME CPU_GO_fast
+#define CPU_GO_CHECKS 0
+#define CPU_GO_TRACE 0
+#define CPU_GO_COVERAGE 0
+#include "cpu_go.h"
+#undef CPU_GO_NAME
+#undef CPU_GO_CHECKS
+#undef CPU_GO_TRACE
+#undef CPU_GO_COVERAGE
+
+#ifndef ASAP
+#define CPU_GO_NAME CPU_GO_coverage
+#define CPU_GO_CHECKS 0
+#define CPU_GO_TRACE 0
+#define CPU_GO_COVERAGE 1
+#include "cpu_go.h"
+#undef CPU_GO_NAME
+#undef CPU_GO_CHECKS
+#undef CPU_GO_TRACE
+#undef CPU_GO_COVERAGE
 #endif
-			CPU_remember_xpos[CPU_remember_PC_curpos] = ANTIC_xpos + (ANTIC_ypos << 8);
-		CPU_remember_PC_curpos = (CPU_remember_PC_curpos + 1) % CPU_REMEMBER_PC_STEPS;
-
-		if (MONITOR_break_addr == GET_PC() || ANTIC_break_ypos == ANTIC_ypos) {
-			DO_BREAK;
-		}
-#endif /* MONITOR_BREAK */
-
-#if defined(WRAP_64K) && !defined(PC_PTR)
-		MEMORY_mem[0x10000] = MEMORY_mem[0];
-#endif
-
-		insn = GET_CODE_BYTE();
-
-#ifdef MONITOR_BREAKPOINTS
-#ifdef MONITOR_BREAK
-		if (MONITOR_breakpoint_table_size > 0 && MONITOR_breakpoints_enabled && !MONITOR_break_step)
-#else
-		if (MONITOR_breakpoint_table_size > 0 && MONITOR_breakpoints_enabled)
-#endif
-		{
-			UBYTE optype = MONITOR_optype6502[insn];
-			int i;
-			switch (optype >> 4) {
-			case 1:
-				addr = PEEK_CODE_WORD();
-				break;
-			case 2:
-				addr = PEEK_CODE_BYTE();
-				break;
-			case 3:
-				addr = PEEK_CODE_WORD() + X;
-				break;
-			case 4:
-				addr = PEEK_CODE_WORD() + Y;
-				break;
-			case 5:
-				addr = (UBYTE) (PEEK_CODE_BYTE() + X);
-				addr = zGetWord(addr);
-				break;
-			case 6:
-				addr = PEEK_CODE_BYTE();
-				addr = zGetWord(addr) + Y;
-				break;
-			case 7:
-				addr = (UBYTE) (PEEK_CODE_BYTE() + X);
-				break;
-			case 8:
-				addr = (UBYTE) (PEEK_CODE_BYTE() + Y);
-				break;
-			/* XXX: case 13 */
-			default:
-				addr = 0;
-				break;
-			}
-			for (i = 0; i < MONITOR_breakpoint_table_size; i++) {
-				int cond;
-				int value, m_addr;
-				if (!MONITOR_breakpoint_table[i].enabled)
-					continue; /* skip */
-				cond = MONITOR_breakpoint_table[i].condition;
-				if (cond == MONITOR_BREAKPOINT_OR)
-					break; /* fire */
-				value = MONITOR_breakpoint_table[i].value;
-				m_addr = MONITOR_breakpoint_table[i].m_addr;
-				if (cond == MONITOR_BREAKPOINT_FLAG_CLEAR) {
-					switch (value) {
-					case CPU_N_FLAG:
-						if ((N & 0x80) == 0)
-							continue;
-						break;
-#ifndef NO_V_FLAG_VARIABLE
-					case CPU_V_FLAG:
-						if (V == 0)
-							continue;
-						break;
-#endif
-					case CPU_Z_FLAG:
-						if (Z != 0)
-							continue;
-						break;
-					case CPU_C_FLAG:
-						if (C == 0)
-							continue;
-						break;
-					default:
-						if ((CPU_regP & value) == 0)
-							continue;
-						break;
-					}
-				}
-				else if (cond == MONITOR_BREAKPOINT_FLAG_SET) {
-					switch (value) {
-					case CPU_N_FLAG:
-						if ((N & 0x80) != 0)
-							continue;
-						break;
-#ifndef NO_V_FLAG_VARIABLE
-					case CPU_V_FLAG:
-						if (V != 0)
-							continue;
-						break;
-#endif
-					case CPU_Z_FLAG:
-						if (Z == 0)
-							continue;
-						break;
-					case CPU_C_FLAG:
-						if (C != 0)
-							continue;
-						break;
-					default:
-						if ((CPU_regP & value) != 0)
-							continue;
-						break;
-					}
-				}
-				else {
-					int val;
-					switch (cond >> 3) {
-					case MONITOR_BREAKPOINT_PC >> 3:
-						val = GET_PC() - 1;
-						break;
-					case MONITOR_BREAKPOINT_A >> 3:
-						val = A;
-						break;
-					case MONITOR_BREAKPOINT_X >> 3:
-						val = X;
-						break;
-					case MONITOR_BREAKPOINT_Y >> 3:
-						val = Y;
-						break;
-					case MONITOR_BREAKPOINT_S >> 3:
-						val = S;
-						break;
-					case MONITOR_BREAKPOINT_READ >> 3:
-						if ((optype & 4) == 0)
-							goto cond_failed;
-						val = addr;
-						break;
-					case MONITOR_BREAKPOINT_WRITE >> 3:
-						if ((optype & 8) == 0)
-							goto cond_failed;
-						val = addr;
-						break;
-					case MONITOR_BREAKPOINT_ACCESS >> 3:
-						if ((optype & 12) == 0)
-							goto cond_failed;
-						val = addr;
-						break;
-					case MONITOR_BREAKPOINT_MEMORY >> 3:
-						val = MEMORY_SafeGetByte(m_addr);
-						break;
-					default:
-						/* shouldn't happen */
-						continue;
-					}
-					if ((cond & MONITOR_BREAKPOINT_LESS) != 0 && val < value)
-						continue;
-					if ((cond & MONITOR_BREAKPOINT_EQUAL) != 0 && val == value)
-						continue;
-					if ((cond & MONITOR_BREAKPOINT_GREATER) != 0 && val > value)
-						continue;
-				cond_failed:
-					;
-				}
-				/* a condition failed */
-				/* quickly skip AND-connected conditions */
-				do {
-					if (++i >= MONITOR_breakpoint_table_size)
-						goto no_breakpoint;
-				} while (MONITOR_breakpoint_table[i].condition != MONITOR_BREAKPOINT_OR || !MONITOR_breakpoint_table[i].enabled);
-			}
-			/* fire breakpoint */
-			PC--;
-			DO_BREAK;
-			goto breakpoint_return;
-		no_breakpoint:
-			;
-		}
-#endif /* MONITOR_BREAKPOINTS */
 
-#ifndef CYCLES_PER_OPCODE
-		ANTIC_xpos += cycles[insn];
+#define CPU_GO_NAME CPU_GO_checks
+#define CPU_GO_CHECKS 1
+#define CPU_GO_TRACE 0
+#define CPU_GO_COVERAGE 1
+#include "cpu_go.h"
+#undef CPU_GO_NAME
+#undef CPU_GO_CHECKS
+#undef CPU_GO_TRACE
+#undef CPU_GO_COVERAGE
+
+#if defined(MONITOR_TRACE) || defined(MONITOR_PROFILE) || !defined(ASAP)
+#define CPU_GO_NAME CPU_GO_trace
+#define CPU_GO_CHECKS 1
+#define CPU_GO_TRACE 1
+#define CPU_GO_COVERAGE 1
+#include "cpu_go.h"
+#undef CPU_GO_NAME
+#undef CPU_GO_CHECKS
+#undef CPU_GO_TRACE
+#undef CPU_GO_COVERAGE
 #endif
 
 #ifdef MONITOR_PROFILE
-		CPU_instruction_count[insn]++;
-		MONITOR_coverage[old_PC = PC - 1].count++;
-		MONITOR_coverage_insns++;
-#endif
-
-#ifdef PREFETCH_CODE
-		addr = PEEK_CODE_WORD();
-#endif
-
-#ifdef NO_GOTO
-		switch (insn) {
+void (*CPU_GO)(int limit) = CPU_GO_trace;
+static void (*go_untimed)(int limit) = CPU_GO_trace;
 #else
-		goto *opcode[insn];
+void (*CPU_GO)(int limit) = CPU_GO_fast;
+static void (*go_untimed)(int limit) = CPU_GO_fast;
 #endif
 
-	OPCODE(00)				/* BRK */
-#ifdef LIBATARI800
-#ifdef HAVE_SETJMP
-		if (!libatari800_continue_on_brk)
-			longjmp(libatari800_cpu_crash, LIBATARI800_BRK_INSTRUCTION);
-#endif /* HAVE_SETJMP */
-#else /* LIBATARI800 */
-#ifdef MONITOR_BREAK
-		if (MONITOR_break_brk) {
-			DO_BREAK;
-		}
-		else
-#endif /* MONITOR_BREAK */
-#endif /* LIBATARI800 */
-		{
-			PC++;
-			PHPC;
-			PHPB1;
-			CPU_SetI;
-			SET_PC(MEMORY_dGetWordAligned(0xfffe));
-			INC_RET_NESTING;
-		}
-		DONE;
-
-	OPCODE(01)				/* ORA (ab,x) */
-		INDIRECT_X;
-		ORA(MEMORY_GetByte(addr));
-		DONE;
-
-	OPCODE(03)				/* ASO (ab,x) [unofficial - ASL then ORA with Acc] */
-		INDIRECT_X;
-
-	aso:
-		RMW_GetByte(data, addr);
-		C = (data & 0x80) ? 1 : 0;
-		data <<= 1;
-		MEMORY_PutByte(addr, data);
-		Z = N = A |= data;
-		DONE;
-
-	OPCODE_ALIAS(04)		/* NOP ab [unofficial - skip byte] */
-	OPCODE_ALIAS(44)
-	OPCODE(64)
-		PC++;
-		DONE;
-
-	OPCODE_ALIAS(14)		/* NOP ab,x [unofficial - skip byte] */
-	OPCODE_ALIAS(34)
-	OPCODE_ALIAS(54)
-	OPCODE_ALIAS(74)
-	OPCODE_ALIAS(d4)
-	OPCODE(f4)
-		PC++;
-		DONE;
-
-	OPCODE_ALIAS(80)		/* NOP #ab [unofficial - skip byte] */
-	OPCODE_ALIAS(82)
-	OPCODE_ALIAS(89)
-	OPCODE_ALIAS(c2)
-	OPCODE(e2)
-		PC++;
-		DONE;
-
-	OPCODE(05)				/* ORA ab */
-		ZPAGE;
-		ORA(MEMORY_dGetByte(addr));
-		DONE;
-
-	OPCODE(06)				/* ASL ab */
-		ZPAGE;
-		data = MEMORY_dGetByte(addr);
-		C = (data & 0x80) ? 1 : 0;
-		Z = N = data << 1;
-		MEMORY_dPutByte(addr, Z);
-		DONE;
-
-	OPCODE(07)				/* ASO ab [unofficial - ASL then ORA with Acc] */
-		ZPAGE;
-
-	aso_zpage:
-		data = MEMORY_dGetByte(addr);
-		C = (data & 0x80) ? 1 : 0;
-		data <<= 1;
-		MEMORY_dPutByte(addr, data);
-		Z = N = A |= data;
-		DONE;
-
-	OPCODE(08)				/* PHP */
-		PHPB1;
-		DONE;
-
-	OPCODE(09)				/* ORA #ab */
-		ORA(IMMEDIATE);
-		DONE;
-
-	OPCODE(0a)				/* ASL */
-		C = (A & 0x80) ? 1 : 0;
-		Z = N = A <<= 1;
-		DONE;
-
-	OPCODE_ALIAS(0b)		/* ANC #ab [unofficial - AND then copy N to C (Fox) */
-	OPCODE(2b)
-		AND(IMMEDIATE);
-		C = N >= 0x80;
-		DONE;
-
-	OPCODE(0c)				/* NOP abcd [unofficial - skip word] */
-		PC += 2;
-		DONE;
-
-	OPCODE(0d)				/* ORA abcd */
-		ABSOLUTE;
-		ORA(MEMORY_GetByte(addr));
-		DONE;
-
-	OPCODE(0e)				/* ASL abcd */
-		ABSOLUTE;
-		RMW_GetByte(data, addr);
-		C = (data & 0x80) ? 1 : 0;
-		Z = N = data << 1;
-		MEMORY_PutByte(addr, Z);
-		DONE;
-
-	OPCODE(0f)				/* ASO abcd [unofficial - ASL then ORA with Acc] */
-		ABSOLUTE;
-		goto aso;
-
-	OPCODE(10)				/* BPL */
-		BRANCH(!(N & 0x80))
-
-	OPCODE(11)				/* ORA (ab),y */
-		INDIRECT_Y;
-		NCYCLES_Y;
-		ORA(MEMORY_GetByte(addr));
-		DONE;
-
-	OPCODE(13)				/* ASO (ab),y [unofficial - ASL then ORA with Acc] */
-		INDIRECT_Y;
-		goto aso;
-
-	OPCODE(15)				/* ORA ab,x */
-		ZPAGE_X;
-		ORA(MEMORY_dGetByte(addr));
-		DONE;
-
-	OPCODE(16)				/* ASL ab,x */
-		ZPAGE_X;
-		data = MEMORY_dGetByte(addr);
-		C = (data & 0x80) ? 1 : 0;
-		Z = N = data << 1;
-		MEMORY_dPutByte(addr, Z);
-		DONE;
-
-	OPCODE(17)				/* ASO ab,x [unofficial - ASL then ORA with Acc] */
-		ZPAGE_X;
-		goto aso_zpage;
-
-	OPCODE(18)				/* CLC */
-		C = 0;
-		DONE;
-
-	OPCODE(19)				/* ORA abcd,y */
-		ABSOLUTE_Y;
-		NCYCLES_Y;
-		ORA(MEMORY_GetByte(addr));
-		DONE;
-
-	OPCODE(1b)				/* ASO abcd,y [unofficial - ASL then ORA with Acc] */
-		ABSOLUTE_Y;
-		goto aso;
-
-	OPCODE_ALIAS(1c)		/* NOP abcd,x [unofficial - skip word] */
-	OPCODE_ALIAS(3c)
-	OPCODE_ALIAS(5c)
-	OPCODE_ALIAS(7c)
-	OPCODE_ALIAS(dc)
-	OPCODE(fc)
-		if (OP_BYTE + X >= 0x100)
-			ANTIC_xpos++;
-		PC += 2;
-		DONE;
-
-	OPCODE(1d)				/* ORA abcd,x */
-		ABSOLUTE_X;
-		NCYCLES_X;
-		ORA(MEMORY_GetByte(addr));
-		DONE;
-
-	OPCODE(1e)				/* ASL abcd,x */
-		ABSOLUTE_X;
-		RMW_GetByte(data, addr);
-		C = (data & 0x80) ? 1 : 0;
-		Z = N = data << 1;
-		MEMORY_PutByte(addr, Z);
-		DONE;
-
-	OPCODE(1f)				/* ASO abcd,x [unofficial - ASL then ORA with Acc] */
-		ABSOLUTE_X;
-		goto aso;
-
-	OPCODE(20)				/* JSR abcd */
-		{
-			UWORD retaddr = GET_PC() + 1;
-#ifdef MONITOR_BREAK
-			CPU_remember_JMP[CPU_remember_jmp_curpos] = GET_PC() - 1;
-			CPU_remember_jmp_curpos = (CPU_remember_jmp_curpos + 1) % CPU_REMEMBER_JMP_STEPS;
-			MONITOR_ret_nesting++;
+#ifndef ASAP
+/* With frame timing, CPU_GO() charges the time since the last mark to
+   ANTIC and its own run to the CPU */
+static void CPU_GO_timed(int limit)
+{
+	AI_TIME_STAGE(AI_TIME_ANTIC);
+	go_untimed(limit);
+	AI_TIME_STAGE(AI_TIME_CPU);
+}
 #endif
-			PHW(retaddr);
-		}
-		SET_PC(OP_WORD);
-		DONE;
-
-	OPCODE(21)				/* AND (ab,x) */
-		INDIRECT_X;
-		AND(MEMORY_GetByte(addr));
-		DONE;
-
-	OPCODE(23)				/* RLA (ab,x) [unofficial - ROL Mem, then AND with A] */
-		INDIRECT_X;
-
-	rla:
-		RMW_GetByte(data, addr);
-		if (C) {
-			C = (data & 0x80) ? 1 : 0;
-			data = (data << 1) + 1;
-		}
-		else {
-			C = (data & 0x80) ? 1 : 0;
-			data = (data << 1);
-		}
-		MEMORY_PutByte(addr, data);
-		Z = N = A &= data;
-		DONE;
 
-	OPCODE(24)				/* BIT ab */
-		ZPAGE;
-		N = MEMORY_dGetByte(addr);
-#ifndef NO_V_FLAG_VARIABLE
-		V = N & 0x40;
-#else
-		CPU_regP = (CPU_regP & 0xbf) + (N & 0x40);
-#endif
-		Z = (A & N);
-		DONE;
-
-	OPCODE(25)				/* AND ab */
-		ZPAGE;
-		AND(MEMORY_dGetByte(addr));
-		DONE;
-
-	OPCODE(26)				/* ROL ab */
-		ZPAGE;
-		data = MEMORY_dGetByte(addr);
-		Z = N = (data << 1) + C;
-		C = (data & 0x80) ? 1 : 0;
-		MEMORY_dPutByte(addr, Z);
-		DONE;
-
-	OPCODE(27)				/* RLA ab [unofficial - ROL Mem, then AND with A] */
-		ZPAGE;
-
-	rla_zpage:
-		data = MEMORY_dGetByte(addr);
-		if (C) {
-			C = (data & 0x80) ? 1 : 0;
-			data = (data << 1) + 1;
-		}
-		else {
-			C = (data & 0x80) ? 1 : 0;
-			data = (data << 1);
-		}
-		MEMORY_dPutByte(addr, data);
-		Z = N = A &= data;
-		DONE;
-
-	OPCODE(28)				/* PLP */
-		PLP;
-		CPUCHECKIRQ;
-		DONE;
-
-	OPCODE(29)				/* AND #ab */
-		AND(IMMEDIATE);
-		DONE;
-
-	OPCODE(2a)				/* ROL */
-		Z = N = (A << 1) + C;
-		C = (A & 0x80) ? 1 : 0;
-		A = Z;
-		DONE;
-
-	OPCODE(2c)				/* BIT abcd */
-		ABSOLUTE;
-		N = MEMORY_GetByte(addr);
-#ifndef NO_V_FLAG_VARIABLE
-		V = N & 0x40;
-#else
-		CPU_regP = (CPU_regP & 0xbf) + (N & 0x40);
-#endif
-		Z = (A & N);
-		DONE;
-
-	OPCODE(2d)				/* AND abcd */
-		ABSOLUTE;
-		AND(MEMORY_GetByte(addr));
-		DONE;
-
-	OPCODE(2e)				/* ROL abcd */
-		ABSOLUTE;
-		RMW_GetByte(data, addr);
-		Z = N = (data << 1) + C;
-		C = (data & 0x80) ? 1 : 0;
-		MEMORY_PutByte(addr, Z);
-		DONE;
-
-	OPCODE(2f)				/* RLA abcd [unofficial - ROL Mem, then AND with A] */
-		ABSOLUTE;
-		goto rla;
-
-	OPCODE(30)				/* BMI */
-		BRANCH(N & 0x80)
-
-	OPCODE(31)				/* AND (ab),y */
-		INDIRECT_Y;
-		NCYCLES_Y;
-		AND(MEMORY_GetByte(addr));
-		DONE;
-
-	OPCODE(33)				/* RLA (ab),y [unofficial - ROL Mem, then AND with A] */
-		INDIRECT_Y;
-		goto rla;
-
-	OPCODE(35)				/* AND ab,x */
-		ZPAGE_X;
-		AND(MEMORY_dGetByte(addr));
-		DONE;
-
-	OPCODE(36)				/* ROL ab,x */
-		ZPAGE_X;
-		data = MEMORY_dGetByte(addr);
-		Z = N = (data << 1) + C;
-		C = (data & 0x80) ? 1 : 0;
-		MEMORY_dPutByte(addr, Z);
-		DONE;
-
-	OPCODE(37)				/* RLA ab,x [unofficial - ROL Mem, then AND with A] */
-		ZPAGE_X;
-		goto rla_zpage;
-
-	OPCODE(38)				/* SEC */
-		C = 1;
-		DONE;
-
-	OPCODE(39)				/* AND abcd,y */
-		ABSOLUTE_Y;
-		NCYCLES_Y;
-		AND(MEMORY_GetByte(addr));
-		DONE;
-
-	OPCODE(3b)				/* RLA abcd,y [unofficial - ROL Mem, then AND with A] */
-		ABSOLUTE_Y;
-		goto rla;
-
-	OPCODE(3d)				/* AND abcd,x */
-		ABSOLUTE_X;
-		NCYCLES_X;
-		AND(MEMORY_GetByte(addr));
-		DONE;
-
-	OPCODE(3e)				/* ROL abcd,x */
-		ABSOLUTE_X;
-		RMW_GetByte(data, addr);
-		Z = N = (data << 1) + C;
-		C = (data & 0x80) ? 1 : 0;
-		MEMORY_PutByte(addr, Z);
-		DONE;
-
-	OPCODE(3f)				/* RLA abcd,x [unofficial - ROL Mem, then AND with A] */
-		ABSOLUTE_X;
-		goto rla;
-
-	OPCODE(40)				/* RTI */
-		PLP;
-		data = PL;
-		SET_PC((PL << 8) + data);
-		CPUCHECKIRQ;
-#ifdef MONITOR_BREAK
-		if (MONITOR_break_ret && --MONITOR_ret_nesting <= 0)
-			MONITOR_break_step = TRUE;
-#endif
-		DONE;
-
-	OPCODE(41)				/* EOR (ab,x) */
-		INDIRECT_X;
-		EOR(MEMORY_GetByte(addr));
-		DONE;
-
-	OPCODE(43)				/* LSE (ab,x) [unofficial - LSR then EOR result with A] */
-		INDIRECT_X;
-
-	lse:
-		RMW_GetByte(data, addr);
-		C = data & 1;
-		data >>= 1;
-		MEMORY_PutByte(addr, data);
-		Z = N = A ^= data;
-		DONE;
-
-	OPCODE(45)				/* EOR ab */
-		ZPAGE;
-		EOR(MEMORY_dGetByte(addr));
-		DONE;
-
-	OPCODE(46)				/* LSR ab */
-		ZPAGE;
-		data = MEMORY_dGetByte(addr);
-		C = data & 1;
-		Z = data >> 1;
-		N = 0;
-		MEMORY_dPutByte(addr, Z);
-		DONE;
-
-	OPCODE(47)				/* LSE ab [unofficial - LSR then EOR result with A] */
-		ZPAGE;
-
-	lse_zpage:
-		data = MEMORY_dGetByte(addr);
-		C = data & 1;
-		data >>= 1;
-		MEMORY_dPutByte(addr, data);
-		Z = N = A ^= data;
-		DONE;
-
-	OPCODE(48)				/* PHA */
-		PH(A);
-		DONE;
-
-	OPCODE(49)				/* EOR #ab */
-		EOR(IMMEDIATE);
-		DONE;
-
-	OPCODE(4a)				/* LSR */
-		C = A & 1;
-		Z = N = A >>= 1;
-		DONE;
-
-	OPCODE(4b)				/* ALR #ab [unofficial - Acc AND Data, LSR result] */
-		data = A & IMMEDIATE;
-		C = data & 1;
-		Z = N = A = (data >> 1);
-		DONE;
-
-	OPCODE(4c)				/* JMP abcd */
-#ifdef MONITOR_BREAK
-		CPU_remember_JMP[CPU_remember_jmp_curpos] = GET_PC() - 1;
-		CPU_remember_jmp_curpos = (CPU_remember_jmp_curpos + 1) % CPU_REMEMBER_JMP_STEPS;
-#endif
-		SET_PC(OP_WORD);
-		DONE;
-
-	OPCODE(4d)				/* EOR abcd */
-		ABSOLUTE;
-		EOR(MEMORY_GetByte(addr));
-		DONE;
-
-	OPCODE(4e)				/* LSR abcd */
-		ABSOLUTE;
-		RMW_GetByte(data, addr);
-		C = data & 1;
-		Z = data >> 1;
-		N = 0;
-		MEMORY_PutByte(addr, Z);
-		DONE;
-
-	OPCODE(4f)				/* LSE abcd [unofficial - LSR then EOR result with A] */
-		ABSOLUTE;
-		goto lse;
-
-	OPCODE(50)				/* BVC */
-#ifndef NO_V_FLAG_VARIABLE
-		BRANCH(!V)
-#else
-		BRANCH(!(CPU_regP & 0x40))
-#endif
+#ifdef LIBATARI800
+static void CPU_GO_stopped(int limit)
+{
+	if (ANTIC_xpos < limit)
+		ANTIC_xpos = limit;
+}
 
-	OPCODE(51)				/* EOR (ab),y */
-		INDIRECT_Y;
-		NCYCLES_Y;
-		EOR(MEMORY_GetByte(addr));
-		DONE;
-
-	OPCODE(53)				/* LSE (ab),y [unofficial - LSR then EOR result with A] */
-		INDIRECT_Y;
-		goto lse;
-
-	OPCODE(55)				/* EOR ab,x */
-		ZPAGE_X;
-		EOR(MEMORY_dGetByte(addr));
-		DONE;
-
-	OPCODE(56)				/* LSR ab,x */
-		ZPAGE_X;
-		data = MEMORY_dGetByte(addr);
-		C = data & 1;
-		Z = data >> 1;
-		N = 0;
-		MEMORY_dPutByte(addr, Z);
-		DONE;
-
-	OPCODE(57)				/* LSE ab,x [unofficial - LSR then EOR result with A] */
-		ZPAGE_X;
-		goto lse_zpage;
-
-	OPCODE(58)				/* CLI */
-		CPU_ClrI;
-		CPUCHECKIRQ;
-		DONE;
-
-	OPCODE(59)				/* EOR abcd,y */
-		ABSOLUTE_Y;
-		NCYCLES_Y;
-		EOR(MEMORY_GetByte(addr));
-		DONE;
-
-	OPCODE(5b)				/* LSE abcd,y [unofficial - LSR then EOR result with A] */
-		ABSOLUTE_Y;
-		goto lse;
-
-	OPCODE(5d)				/* EOR abcd,x */
-		ABSOLUTE_X;
-		NCYCLES_X;
-		EOR(MEMORY_GetByte(addr));
-		DONE;
-
-	OPCODE(5e)				/* LSR abcd,x */
-		ABSOLUTE_X;
-		RMW_GetByte(data, addr);
-		C = data & 1;
-		Z = data >> 1;
-		N = 0;
-		MEMORY_PutByte(addr, Z);
-		DONE;
-
-	OPCODE(5f)				/* LSE abcd,x [unofficial - LSR then EOR result with A] */
-		ABSOLUTE_X;
-		goto lse;
-
-	OPCODE(60)				/* RTS */
-		data = PL;
-		SET_PC((PL << 8) + data + 1);
-#ifdef MONITOR_BREAK
-		if (MONITOR_break_ret && --MONITOR_ret_nesting <= 0)
-			MONITOR_break_step = TRUE;
-#endif
-		if (CPU_rts_handler != NULL) {
-			CPU_rts_handler();
-			CPU_rts_handler = NULL;
-		}
-		DONE;
+void CPU_Stop(int code)
+{
+	CPU_stopped = code;
+	/* leaves the loop, as a WSYNC store does */
+	ANTIC_xpos = ANTIC_xpos_limit;
+	CPU_GO = CPU_GO_stopped;
+}
 
-	OPCODE(61)				/* ADC (ab,x) */
-		INDIRECT_X;
-		data = MEMORY_GetByte(addr);
-		goto adc;
+void CPU_Resume(void)
+{
+	CPU_stopped = 0;
+	CPU_UpdateGo();
+	if (stopped_nmi) {
+		stopped_nmi = FALSE;
+		CPU_NMI();
+	}
+}
+#endif /* LIBATARI800 */
 
-	OPCODE(63)				/* RRA (ab,x) [unofficial - ROR Mem, then ADC to Acc] */
-		INDIRECT_X;
+/* Sets go_untimed to the loop the debugging checks need */
+static void SelectGo(void)
+{
+#ifdef MONITOR_PROFILE
+	/* the profile covers the whole run */
+	go_untimed = CPU_GO_trace;
+#else /* MONITOR_PROFILE */
+	int checks = FALSE;
 
-	rra:
-		RMW_GetByte(data, addr);
-		if (C) {
-			C = data & 1;
-			data = (data >> 1) + 0x80;
-		}
-		else {
-			C = data & 1;
-			data >>= 1;
-		}
-		MEMORY_PutByte(addr, data);
-		goto adc;
-
-	OPCODE(65)				/* ADC ab */
-		ZPAGE;
-		data = MEMORY_dGetByte(addr);
-		goto adc;
-
-	OPCODE(66)				/* ROR ab */
-		ZPAGE;
-		data = MEMORY_dGetByte(addr);
-		Z = N = (C << 7) + (data >> 1);
-		C = data & 1;
-		MEMORY_dPutByte(addr, Z);
-		DONE;
-
-	OPCODE(67)				/* RRA ab [unofficial - ROR Mem, then ADC to Acc] */
-		ZPAGE;
-
-	rra_zpage:
-		data = MEMORY_dGetByte(addr);
-		if (C) {
-			C = data & 1;
-			data = (data >> 1) + 0x80;
-		}
-		else {
-			C = data & 1;
-			data >>= 1;
-		}
-		MEMORY_dPutByte(addr, data);
-		goto adc;
-
-	OPCODE(68)				/* PLA */
-		Z = N = A = PL;
-		DONE;
-
-	OPCODE(69)				/* ADC #ab */
-		data = IMMEDIATE;
-		goto adc;
-
-	OPCODE(6a)				/* ROR */
-		Z = N = (C << 7) + (A >> 1);
-		C = A & 1;
-		A = Z;
-		DONE;
-
-	OPCODE(6b)				/* ARR #ab [unofficial - Acc AND Data, ROR result] */
-		/* It does some 'BCD fixup' if D flag is set */
-		/* MPC 05/24/00 */
-		data = A & IMMEDIATE;
-		if (CPU_regP & CPU_D_FLAG) {
-			UBYTE temp = (data >> 1) + (C << 7);
-			Z = N = temp;
-#ifndef NO_V_FLAG_VARIABLE
-			V = ((temp ^ data) & 0x40);
-#else
-			CPU_regP = (CPU_regP & 0xbf) + ((temp ^ data) & 0x40);
+#ifdef MONITOR_TRACE
+	if (MONITOR_trace_file != NULL) {
+		go_untimed = CPU_GO_trace;
+		return;
+	}
 #endif
-			if ((data & 0x0F) + (data & 0x01) > 5)
-				temp = (temp & 0xF0) + ((temp + 0x6) & 0x0F);
-			if (data + (data & 0x10) >= 0x60) {
-				temp += 0x60;
-				C = 1;
-			}
-			else
-				C = 0;
-			A = (UBYTE) temp;
-		}
-		else {
-			Z = N = A = (data >> 1) + (C << 7);
-			C = data >> 7;
-#ifndef NO_V_FLAG_VARIABLE
-			V = C ^ ((A >> 5) & 1);
-#else
-			CPU_regP = (CPU_regP & 0xbf) + ((A ^ data) & 0x40);
+#ifndef ASAP
+	if (AI_profile != NULL || AI_trace_pos != NULL || AI_HEATMAP_counts != NULL) {
+		go_untimed = CPU_GO_trace;
+		return;
+	}
 #endif
-		}
-		DONE;
-
-	OPCODE(6c)				/* JMP (abcd) */
 #ifdef MONITOR_BREAK
-		CPU_remember_JMP[CPU_remember_jmp_curpos] = GET_PC() - 1;
-		CPU_remember_jmp_curpos = (CPU_remember_jmp_curpos + 1) % CPU_REMEMBER_JMP_STEPS;
+	if (MONITOR_break_addr != 0xd000 || (ANTIC_break_ypos >= 0 && ANTIC_break_ypos <= 311)
+		|| MONITOR_break_step || MONITOR_break_ret)
+		checks = TRUE;
 #endif
-		ABSOLUTE;
-#ifdef CPU65C02
-		/* XXX: if ((UBYTE) addr == 0xff) ANTIC_xpos++; */
-		SET_PC(MEMORY_dGetWord(addr));
-#else
-		/* original 6502 had a bug in JMP (addr) when addr crossed page boundary */
-		if ((UBYTE) addr == 0xff)
-			SET_PC((MEMORY_dGetByte(addr - 0xff) << 8) + MEMORY_dGetByte(addr));
-		else
-			SET_PC(MEMORY_dGetWord(addr));
-#endif
-		DONE;
-
-	OPCODE(6d)				/* ADC abcd */
-		ABSOLUTE;
-		data = MEMORY_GetByte(addr);
-		goto adc;
-
-	OPCODE(6e)				/* ROR abcd */
-		ABSOLUTE;
-		RMW_GetByte(data, addr);
-		Z = N = (C << 7) + (data >> 1);
-		C = data & 1;
-		MEMORY_PutByte(addr, Z);
-		DONE;
-
-	OPCODE(6f)				/* RRA abcd [unofficial - ROR Mem, then ADC to Acc] */
-		ABSOLUTE;
-		goto rra;
-
-	OPCODE(70)				/* BVS */
-#ifndef NO_V_FLAG_VARIABLE
-		BRANCH(V)
-#else
-		BRANCH(CPU_regP & 0x40)
-#endif
-
-	OPCODE(71)				/* ADC (ab),y */
-		INDIRECT_Y;
-		NCYCLES_Y;
-		data = MEMORY_GetByte(addr);
-		goto adc;
-
-	OPCODE(73)				/* RRA (ab),y [unofficial - ROR Mem, then ADC to Acc] */
-		INDIRECT_Y;
-		goto rra;
-
-	OPCODE(75)				/* ADC ab,x */
-		ZPAGE_X;
-		data = MEMORY_dGetByte(addr);
-		goto adc;
-
-	OPCODE(76)				/* ROR ab,x */
-		ZPAGE_X;
-		data = MEMORY_dGetByte(addr);
-		Z = N = (C << 7) + (data >> 1);
-		C = data & 1;
-		MEMORY_dPutByte(addr, Z);
-		DONE;
-
-	OPCODE(77)				/* RRA ab,x [unofficial - ROR Mem, then ADC to Acc] */
-		ZPAGE_X;
-		goto rra_zpage;
-
-	OPCODE(78)				/* SEI */
-		CPU_SetI;
-		DONE;
-
-	OPCODE(79)				/* ADC abcd,y */
-		ABSOLUTE_Y;
-		NCYCLES_Y;
-		data = MEMORY_GetByte(addr);
-		goto adc;
-
-	OPCODE(7b)				/* RRA abcd,y [unofficial - ROR Mem, then ADC to Acc] */
-		ABSOLUTE_Y;
-		goto rra;
-
-	OPCODE(7d)				/* ADC abcd,x */
-		ABSOLUTE_X;
-		NCYCLES_X;
-		data = MEMORY_GetByte(addr);
-		goto adc;
-
-	OPCODE(7e)				/* ROR abcd,x */
-		ABSOLUTE_X;
-		RMW_GetByte(data, addr);
-		Z = N = (C << 7) + (data >> 1);
-		C = data & 1;
-		MEMORY_PutByte(addr, Z);
-		DONE;
-
-	OPCODE(7f)				/* RRA abcd,x [unofficial - ROR Mem, then ADC to Acc] */
-		ABSOLUTE_X;
-		goto rra;
-
-	OPCODE(81)				/* STA (ab,x) */
-		INDIRECT_X;
-		MEMORY_PutByte(addr, A);
-		DONE;
-
-	/* AXS doesn't change flags and SAX is better name for it (Fox) */
-	OPCODE(83)				/* SAX (ab,x) [unofficial - Store result A AND X */
-		INDIRECT_X;
-		data = A & X;
-		MEMORY_PutByte(addr, data);
-		DONE;
-
-	OPCODE(84)				/* STY ab */
-		ZPAGE;
-		MEMORY_dPutByte(addr, Y);
-		DONE;
-
-	OPCODE(85)				/* STA ab */
-		ZPAGE;
-		MEMORY_dPutByte(addr, A);
-		DONE;
-
-	OPCODE(86)				/* STX ab */
-		ZPAGE;
-		MEMORY_dPutByte(addr, X);
-		DONE;
-
-	OPCODE(87)				/* SAX ab [unofficial - Store result A AND X] */
-		ZPAGE;
-		data = A & X;
-		MEMORY_dPutByte(addr, data);
-		DONE;
-
-	OPCODE(88)				/* DEY */
-		Z = N = --Y;
-		DONE;
-
-	OPCODE(8a)				/* TXA */
-		Z = N = A = X;
-		DONE;
-
-	OPCODE(8b)				/* ANE #ab [unofficial - A AND X AND (Mem OR $EF) to Acc] (Fox) */
-		data = IMMEDIATE;
-		Z = N = A & X & data;
-		A &= X & (data | 0xef);
-		DONE;
-
-	OPCODE(8c)				/* STY abcd */
-		ABSOLUTE;
-		MEMORY_PutByte(addr, Y);
-		DONE;
-
-	OPCODE(8d)				/* STA abcd */
-		ABSOLUTE;
-		MEMORY_PutByte(addr, A);
-		DONE;
-
-	OPCODE(8e)				/* STX abcd */
-		ABSOLUTE;
-		MEMORY_PutByte(addr, X);
-		DONE;
-
-	OPCODE(8f)				/* SAX abcd [unofficial - Store result A AND X] */
-		ABSOLUTE;
-		data = A & X;
-		MEMORY_PutByte(addr, data);
-		DONE;
-
-	OPCODE(90)				/* BCC */
-		BRANCH(!C)
-
-	OPCODE(91)				/* STA (ab),y */
-		INDIRECT_Y;
-		MEMORY_PutByte(addr, A);
-		DONE;
-
-	OPCODE(93)				/* SHA (ab),y [unofficial, UNSTABLE - Store A AND X AND (H+1) ?] (Fox) */
-		/* It seems previous memory value is important - also in 9f */
-		ZPAGE;
-		addr = zGetWord(addr);
-		data = A & X & ((addr >> 8) + 1);
-		if ((addr & 0xff) + Y > 0xff) { /* if it crosses a page */
-			MEMORY_PutByte(((addr + Y) & 0xff) | (data << 8), data);
-		}
-		else {
-			MEMORY_PutByte(addr + Y, data);
-		}
-		DONE;
-
-	OPCODE(94)				/* STY ab,x */
-		ZPAGE_X;
-		MEMORY_dPutByte(addr, Y);
-		DONE;
-
-	OPCODE(95)				/* STA ab,x */
-		ZPAGE_X;
-		MEMORY_dPutByte(addr, A);
-		DONE;
-
-	OPCODE(96)				/* STX ab,y */
-		ZPAGE_Y;
-		MEMORY_PutByte(addr, X);
-		DONE;
-
-	OPCODE(97)				/* SAX ab,y [unofficial - Store result A AND X] */
-		ZPAGE_Y;
-		data = A & X;
-		MEMORY_dPutByte(addr, data);
-		DONE;
-
-	OPCODE(98)				/* TYA */
-		Z = N = A = Y;
-		DONE;
-
-	OPCODE(99)				/* STA abcd,y */
-		ABSOLUTE_Y;
-		MEMORY_PutByte(addr, A);
-		DONE;
-
-	OPCODE(9a)				/* TXS */
-		S = X;
-		DONE;
-
-	OPCODE(9b)				/* SHS abcd,y [unofficial, UNSTABLE] (Fox) */
-		/* Transfer A AND X to S, then store S AND (H+1)] */
-		/* S seems to be stable, only memory values vary */
-		ABSOLUTE;
-		S = A & X;
-		data = S & ((addr >> 8) + 1);
-		if ((addr & 0xff) + Y > 0xff) { /* if it crosses a page */
-			MEMORY_PutByte(((addr + Y) & 0xff) | (data << 8), data);
-		}
-		else {
-			MEMORY_PutByte(addr + Y, data);
-		}
-		DONE;
-
-	OPCODE(9c)				/* SHY abcd,x [unofficial - Store Y and (H+1)] (Fox) */
-		/* Seems to be stable */
-		ABSOLUTE;
-		/* MPC 05/24/00 */
-		data = Y & ((UBYTE) ((addr >> 8) + 1));
-		if ((addr & 0xff) + X > 0xff) { /* if it crosses a page */
-			MEMORY_PutByte(((addr + X) & 0xff) | (data << 8), data);
-		}
-		else {
-			MEMORY_PutByte(addr + X, data);
-		}
-		DONE;
-
-	OPCODE(9d)				/* STA abcd,x */
-		ABSOLUTE_X;
-		MEMORY_PutByte(addr, A);
-		DONE;
-
-	OPCODE(9e)				/* SHX abcd,y [unofficial - Store X and (H+1)] (Fox) */
-		/* Seems to be stable */
-		ABSOLUTE;
-		/* MPC 05/24/00 */
-		data = X & ((UBYTE) ((addr >> 8) + 1));
-		if ((addr & 0xff) + Y > 0xff) { /* if it crosses a page */
-			MEMORY_PutByte(((addr + Y) & 0xff) | (data << 8), data);
-		}
-		else {
-			MEMORY_PutByte(addr + Y, data);
-		}
-		DONE;
-
-	OPCODE(9f)				/* SHA abcd,y [unofficial, UNSTABLE - Store A AND X AND (H+1) ?] (Fox) */
-		ABSOLUTE;
-		data = A & X & ((addr >> 8) + 1);
-		if ((addr & 0xff) + Y > 0xff) { /* if it crosses a page */
-			MEMORY_PutByte(((addr + Y) & 0xff) | (data << 8), data);
-		}
-		else {
-			MEMORY_PutByte(addr + Y, data);
-		}
-		DONE;
-
-	OPCODE(a0)				/* LDY #ab */
-		LDY(IMMEDIATE);
-		DONE;
-
-	OPCODE(a1)				/* LDA (ab,x) */
-		INDIRECT_X;
-		LDA(MEMORY_GetByte(addr));
-		DONE;
-
-	OPCODE(a2)				/* LDX #ab */
-		LDX(IMMEDIATE);
-		DONE;
-
-	OPCODE(a3)				/* LAX (ab,x) [unofficial] */
-		INDIRECT_X;
-		Z = N = X = A = MEMORY_GetByte(addr);
-		DONE;
-
-	OPCODE(a4)				/* LDY ab */
-		ZPAGE;
-		LDY(MEMORY_dGetByte(addr));
-		DONE;
-
-	OPCODE(a5)				/* LDA ab */
-		ZPAGE;
-		LDA(MEMORY_dGetByte(addr));
-		DONE;
-
-	OPCODE(a6)				/* LDX ab */
-		ZPAGE;
-		LDX(MEMORY_dGetByte(addr));
-		DONE;
-
-	OPCODE(a7)				/* LAX ab [unofficial] */
-		ZPAGE;
-		Z = N = X = A = MEMORY_GetByte(addr);
-		DONE;
-
-	OPCODE(a8)				/* TAY */
-		Z = N = Y = A;
-		DONE;
-
-	OPCODE(a9)				/* LDA #ab */
-		LDA(IMMEDIATE);
-		DONE;
-
-	OPCODE(aa)				/* TAX */
-		Z = N = X = A;
-		DONE;
-
-	OPCODE(ab)				/* ANX #ab [unofficial - AND #ab, then TAX] */
-		Z = N = X = A &= IMMEDIATE;
-		DONE;
-
-	OPCODE(ac)				/* LDY abcd */
-		ABSOLUTE;
-		LDY(MEMORY_GetByte(addr));
-		DONE;
-
-	OPCODE(ad)				/* LDA abcd */
-		ABSOLUTE;
-		LDA(MEMORY_GetByte(addr));
-		DONE;
-
-	OPCODE(ae)				/* LDX abcd */
-		ABSOLUTE;
-		LDX(MEMORY_GetByte(addr));
-		DONE;
-
-	OPCODE(af)				/* LAX abcd [unofficial] */
-		ABSOLUTE;
-		Z = N = X = A = MEMORY_GetByte(addr);
-		DONE;
-
-	OPCODE(b0)				/* BCS */
-		BRANCH(C)
-
-	OPCODE(b1)				/* LDA (ab),y */
-		INDIRECT_Y;
-		NCYCLES_Y;
-		LDA(MEMORY_GetByte(addr));
-		DONE;
-
-	OPCODE(b3)				/* LAX (ab),y [unofficial] */
-		INDIRECT_Y;
-		NCYCLES_Y;
-		Z = N = X = A = MEMORY_GetByte(addr);
-		DONE;
-
-	OPCODE(b4)				/* LDY ab,x */
-		ZPAGE_X;
-		LDY(MEMORY_dGetByte(addr));
-		DONE;
-
-	OPCODE(b5)				/* LDA ab,x */
-		ZPAGE_X;
-		LDA(MEMORY_dGetByte(addr));
-		DONE;
-
-	OPCODE(b6)				/* LDX ab,y */
-		ZPAGE_Y;
-		LDX(MEMORY_GetByte(addr));
-		DONE;
-
-	OPCODE(b7)				/* LAX ab,y [unofficial] */
-		ZPAGE_Y;
-		Z = N = X = A = MEMORY_GetByte(addr);
-		DONE;
-
-	OPCODE(b8)				/* CLV */
-#ifndef NO_V_FLAG_VARIABLE
-		V = 0;
-#else
-		CPU_ClrV;
+#ifdef MONITOR_BREAKPOINTS
+	if (MONITOR_breakpoint_filter != 0)
+		checks = TRUE;
 #endif
-		DONE;
-
-	OPCODE(b9)				/* LDA abcd,y */
-		ABSOLUTE_Y;
-		NCYCLES_Y;
-		LDA(MEMORY_GetByte(addr));
-		DONE;
-
-	OPCODE(ba)				/* TSX */
-		Z = N = X = S;
-		DONE;
-
-/* AXA [unofficial - original decode by R.Sterba and R.Petruzela 15.1.1998 :-)]
-   AXA - this is our new imaginative name for instruction with opcode hex BB.
-   AXA - Store Mem AND #$FD to Acc and X, then set stackpoint to value (Acc - 4)
-   It's cool! :-)
-   LAS - this is better name for this :) (Fox)
-   It simply ANDs stack pointer with Mem, then transfers result to A and X
- */
-
-	OPCODE(bb)				/* LAS abcd,y [unofficial - AND S with Mem, transfer to A and X (Fox) */
-		ABSOLUTE_Y;
-		NCYCLES_Y;
-		Z = N = A = X = S &= MEMORY_GetByte(addr);
-		DONE;
-
-	OPCODE(bc)				/* LDY abcd,x */
-		ABSOLUTE_X;
-		NCYCLES_X;
-		LDY(MEMORY_GetByte(addr));
-		DONE;
-
-	OPCODE(bd)				/* LDA abcd,x */
-		ABSOLUTE_X;
-		NCYCLES_X;
-		LDA(MEMORY_GetByte(addr));
-		DONE;
-
-	OPCODE(be)				/* LDX abcd,y */
-		ABSOLUTE_Y;
-		NCYCLES_Y;
-		LDX(MEMORY_GetByte(addr));
-		DONE;
-
-	OPCODE(bf)				/* LAX abcd,y [unofficial] */
-		ABSOLUTE_Y;
-		NCYCLES_Y;
-		Z = N = X = A = MEMORY_GetByte(addr);
-		DONE;
-
-	OPCODE(c0)				/* CPY #ab */
-		CPY(IMMEDIATE);
-		DONE;
-
-	OPCODE(c1)				/* CMP (ab,x) */
-		INDIRECT_X;
-		CMP(MEMORY_GetByte(addr));
-		DONE;
-
-	OPCODE(c3)				/* DCM (ab,x) [unofficial - DEC Mem then CMP with Acc] */
-		INDIRECT_X;
-
-	dcm:
-		RMW_GetByte(data, addr);
-		data--;
-		MEMORY_PutByte(addr, data);
-		CMP(data);
-		DONE;
-
-	OPCODE(c4)				/* CPY ab */
-		ZPAGE;
-		CPY(MEMORY_dGetByte(addr));
-		DONE;
-
-	OPCODE(c5)				/* CMP ab */
-		ZPAGE;
-		CMP(MEMORY_dGetByte(addr));
-		DONE;
-
-	OPCODE(c6)				/* DEC ab */
-		ZPAGE;
-		Z = N = MEMORY_dGetByte(addr) - 1;
-		MEMORY_dPutByte(addr, Z);
-		DONE;
-
-	OPCODE(c7)				/* DCM ab [unofficial - DEC Mem then CMP with Acc] */
-		ZPAGE;
-
-	dcm_zpage:
-		data = MEMORY_dGetByte(addr) - 1;
-		MEMORY_dPutByte(addr, data);
-		CMP(data);
-		DONE;
-
-	OPCODE(c8)				/* INY */
-		Z = N = ++Y;
-		DONE;
-
-	OPCODE(c9)				/* CMP #ab */
-		CMP(IMMEDIATE);
-		DONE;
-
-	OPCODE(ca)				/* DEX */
-		Z = N = --X;
-		DONE;
-
-	OPCODE(cb)				/* SBX #ab [unofficial - store ((A AND X) - Mem) in X] (Fox) */
-		X &= A;
-		data = IMMEDIATE;
-		C = X >= data;
-		/* MPC 05/24/00 */
-		Z = N = X -= data;
-		DONE;
-
-	OPCODE(cc)				/* CPY abcd */
-		ABSOLUTE;
-		CPY(MEMORY_GetByte(addr));
-		DONE;
-
-	OPCODE(cd)				/* CMP abcd */
-		ABSOLUTE;
-		CMP(MEMORY_GetByte(addr));
-		DONE;
-
-	OPCODE(ce)				/* DEC abcd */
-		ABSOLUTE;
-		RMW_GetByte(Z, addr);
-		N = --Z;
-		MEMORY_PutByte(addr, Z);
-		DONE;
-
-	OPCODE(cf)				/* DCM abcd [unofficial - DEC Mem then CMP with Acc] */
-		ABSOLUTE;
-		goto dcm;
-
-	OPCODE(d0)				/* BNE */
-		BRANCH(Z)
-
-	OPCODE(d1)				/* CMP (ab),y */
-		INDIRECT_Y;
-		NCYCLES_Y;
-		CMP(MEMORY_GetByte(addr));
-		DONE;
-
-	OPCODE(d3)				/* DCM (ab),y [unofficial - DEC Mem then CMP with Acc] */
-		INDIRECT_Y;
-		goto dcm;
-
-	OPCODE(d5)				/* CMP ab,x */
-		ZPAGE_X;
-		CMP(MEMORY_dGetByte(addr));
-		DONE;
-
-	OPCODE(d6)				/* DEC ab,x */
-		ZPAGE_X;
-		Z = N = MEMORY_dGetByte(addr) - 1;
-		MEMORY_dPutByte(addr, Z);
-		DONE;
-
-	OPCODE(d7)				/* DCM ab,x [unofficial - DEC Mem then CMP with Acc] */
-		ZPAGE_X;
-		goto dcm_zpage;
-
-	OPCODE(d8)				/* CLD */
-		CPU_ClrD;
-		DONE;
-
-	OPCODE(d9)				/* CMP abcd,y */
-		ABSOLUTE_Y;
-		NCYCLES_Y;
-		CMP(MEMORY_GetByte(addr));
-		DONE;
-
-	OPCODE(db)				/* DCM abcd,y [unofficial - DEC Mem then CMP with Acc] */
-		ABSOLUTE_Y;
-		goto dcm;
-
-	OPCODE(dd)				/* CMP abcd,x */
-		ABSOLUTE_X;
-		NCYCLES_X;
-		CMP(MEMORY_GetByte(addr));
-		DONE;
-
-	OPCODE(de)				/* DEC abcd,x */
-		ABSOLUTE_X;
-		RMW_GetByte(Z, addr);
-		N = --Z;
-		MEMORY_PutByte(addr, Z);
-		DONE;
-
-	OPCODE(df)				/* DCM abcd,x [unofficial - DEC Mem then CMP with Acc] */
-		ABSOLUTE_X;
-		goto dcm;
-
-	OPCODE(e0)				/* CPX #ab */
-		CPX(IMMEDIATE);
-		DONE;
-
-	OPCODE(e1)				/* SBC (ab,x) */
-		INDIRECT_X;
-		data = MEMORY_GetByte(addr);
-		goto sbc;
-
-	OPCODE(e3)				/* INS (ab,x) [unofficial - INC Mem then SBC with Acc] */
-		INDIRECT_X;
-
-	ins:
-		RMW_GetByte(data, addr);
-		++data;
-		MEMORY_PutByte(addr, data);
-		goto sbc;
-
-	OPCODE(e4)				/* CPX ab */
-		ZPAGE;
-		CPX(MEMORY_dGetByte(addr));
-		DONE;
-
-	OPCODE(e5)				/* SBC ab */
-		ZPAGE;
-		data = MEMORY_dGetByte(addr);
-		goto sbc;
-
-	OPCODE(e6)				/* INC ab */
-		ZPAGE;
-		Z = N = MEMORY_dGetByte(addr) + 1;
-		MEMORY_dPutByte(addr, Z);
-		DONE;
-
-	OPCODE(e7)				/* INS ab [unofficial - INC Mem then SBC with Acc] */
-		ZPAGE;
-
-	ins_zpage:
-		data = MEMORY_dGetByte(addr) + 1;
-		MEMORY_dPutByte(addr, data);
-		goto sbc;
-
-	OPCODE(e8)				/* INX */
-		Z = N = ++X;
-		DONE;
-
-	OPCODE_ALIAS(e9)		/* SBC #ab */
-	OPCODE(eb)				/* SBC #ab [unofficial] */
-		data = IMMEDIATE;
-		goto sbc;
-
-	OPCODE_ALIAS(ea)		/* NOP */
-	OPCODE_ALIAS(1a)		/* NOP [unofficial] */
-	OPCODE_ALIAS(3a)
-	OPCODE_ALIAS(5a)
-	OPCODE_ALIAS(7a)
-	OPCODE_ALIAS(da)
-	OPCODE(fa)
-		DONE;
-
-	OPCODE(ec)				/* CPX abcd */
-		ABSOLUTE;
-		CPX(MEMORY_GetByte(addr));
-		DONE;
-
-	OPCODE(ed)				/* SBC abcd */
-		ABSOLUTE;
-		data = MEMORY_GetByte(addr);
-		goto sbc;
-
-	OPCODE(ee)				/* INC abcd */
-		ABSOLUTE;
-		RMW_GetByte(Z, addr);
-		N = ++Z;
-		MEMORY_PutByte(addr, Z);
-		DONE;
-
-	OPCODE(ef)				/* INS abcd [unofficial - INC Mem then SBC with Acc] */
-		ABSOLUTE;
-		goto ins;
-
-	OPCODE(f0)				/* BEQ */
-		BRANCH(!Z)
-
-	OPCODE(f1)				/* SBC (ab),y */
-		INDIRECT_Y;
-		NCYCLES_Y;
-		data = MEMORY_GetByte(addr);
-		goto sbc;
-
-	OPCODE(f3)				/* INS (ab),y [unofficial - INC Mem then SBC with Acc] */
-		INDIRECT_Y;
-		goto ins;
-
-	OPCODE(f5)				/* SBC ab,x */
-		ZPAGE_X;
-		data = MEMORY_dGetByte(addr);
-		goto sbc;
-
-	OPCODE(f6)				/* INC ab,x */
-		ZPAGE_X;
-		Z = N = MEMORY_dGetByte(addr) + 1;
-		MEMORY_dPutByte(addr, Z);
-		DONE;
-
-	OPCODE(f7)				/* INS ab,x [unofficial - INC Mem then SBC with Acc] */
-		ZPAGE_X;
-		goto ins_zpage;
-
-	OPCODE(f8)				/* SED */
-		CPU_SetD;
-		DONE;
-
-	OPCODE(f9)				/* SBC abcd,y */
-		ABSOLUTE_Y;
-		NCYCLES_Y;
-		data = MEMORY_GetByte(addr);
-		goto sbc;
-
-	OPCODE(fb)				/* INS abcd,y [unofficial - INC Mem then SBC with Acc] */
-		ABSOLUTE_Y;
-		goto ins;
-
-	OPCODE(fd)				/* SBC abcd,x */
-		ABSOLUTE_X;
-		NCYCLES_X;
-		data = MEMORY_GetByte(addr);
-		goto sbc;
-
-	OPCODE(fe)				/* INC abcd,x */
-		ABSOLUTE_X;
-		RMW_GetByte(Z, addr);
-		N = ++Z;
-		MEMORY_PutByte(addr, Z);
-		DONE;
-
-	OPCODE(ff)				/* INS abcd,x [unofficial - INC Mem then SBC with Acc] */
-		ABSOLUTE_X;
-		goto ins;
-
-#ifdef ASAP
-
-	OPCODE_ALIAS(d2)
-	OPCODE_ALIAS(f2)
-
-#else
-
-	OPCODE(d2)				/* ESCRTS #ab (CIM) - on Atari is here instruction CIM [unofficial] !RS! */
-		data = IMMEDIATE;
-		UPDATE_GLOBAL_REGS;
-		CPU_GetStatus();
-		ESC_Run(data);
-		CPU_PutStatus();
-		UPDATE_LOCAL_REGS;
-		data = PL;
-		SET_PC((PL << 8) + data + 1);
-#ifdef MONITOR_BREAK
-		if (MONITOR_break_ret && --MONITOR_ret_nesting <= 0)
-			MONITOR_break_step = TRUE;
+#ifndef ASAP
+	if (AI_pc_watch != NULL || AI_write_watch != NULL || AI_HISTORY_ring != NULL)
+		checks = TRUE;
+	if (!checks && AI_coverage != NULL) {
+		go_untimed = CPU_GO_coverage;
+		return;
+	}
 #endif
-		DONE;
-
-	OPCODE(f2)				/* ESC #ab (CIM) - on Atari is here instruction CIM [unofficial] !RS! */
-		/* OPCODE(ff: ESC #ab - opcode FF is now used for INS [unofficial] instruction !RS! */
-		data = IMMEDIATE;
-		UPDATE_GLOBAL_REGS;
-		CPU_GetStatus();
-		ESC_Run(data);
-		CPU_PutStatus();
-		UPDATE_LOCAL_REGS;
-		DONE;
-
-#endif /* ASAP */
-
-	OPCODE_ALIAS(02)		/* CIM [unofficial - crash intermediate] */
-	OPCODE_ALIAS(12)
-	OPCODE_ALIAS(22)
-	OPCODE_ALIAS(32)
-	OPCODE_ALIAS(42)
-	OPCODE_ALIAS(52)
-	OPCODE_ALIAS(62)
-	OPCODE_ALIAS(72)
-	OPCODE_ALIAS(92)
-	OPCODE(b2)
-
-#ifdef ASAP
-
-		ASAP_CIM();
-		DONE;
-
-#else
+	go_untimed = checks ? CPU_GO_checks : CPU_GO_fast;
+#endif /* MONITOR_PROFILE */
+}
 
-	/* OPCODE(d2) Used for ESCRTS #ab (CIM) */
-	/* OPCODE(f2) Used for ESC #ab (CIM) */
-		PC--;
-		UPDATE_GLOBAL_REGS;
-		CPU_GetStatus();
-
-#ifdef CRASH_MENU
-		UI_crash_address = GET_PC();
-		UI_crash_afterCIM = GET_PC() + 1;
-		UI_crash_code = insn;
-		UI_Run();
-#else
-		CPU_cim_encountered = TRUE;
+void CPU_UpdateGo(void)
+{
+	SelectGo();
 #ifdef LIBATARI800
-#ifdef HAVE_SETJMP
-		longjmp(libatari800_cpu_crash, LIBATARI800_CPU_CRASH);
-#endif /* HAVE_SETJMP */
-#else
-		ENTER_MONITOR;
-#endif /* LIBATARI800 */
-#endif /* CRASH_MENU */
-
-		CPU_PutStatus();
-		UPDATE_LOCAL_REGS;
-		DONE;
-
-#endif /* ASAP */
-
-/* ---------------------------------------------- */
-/* ADC and SBC routines */
-
-	adc:
-		if (!(CPU_regP & CPU_D_FLAG)) {
-			/* Binary mode */
-			unsigned int tmp;
-			tmp = A + data + C;
-			C = tmp > 0xff;
-			/* C = tmp >> 8; */
-#ifndef NO_V_FLAG_VARIABLE
-			V = !((A ^ data) & 0x80) && ((data ^ tmp) & 0x80);
-#else
-			CPU_ClrV;
-			if (!((A ^ data) & 0x80) && ((data ^ tmp) & 0x80))
-				CPU_SetV;
+	if (CPU_stopped)
+		return;
 #endif
-			Z = N = A = (UBYTE) tmp;
-	    }
-		else {
-			/* Decimal mode */
-			unsigned int tmp;
-			tmp = (A & 0x0f) + (data & 0x0f) + C;
-			if (tmp >= 0x0a)
-				tmp = ((tmp + 0x06) & 0x0f) + 0x10;
-			tmp += (A & 0xf0) + (data & 0xf0);
-
-			Z = A + data + C;
-			N = (UBYTE) tmp;
-#ifndef NO_V_FLAG_VARIABLE
-			V = !((A ^ data) & 0x80) && ((data ^ tmp) & 0x80);
-#else
-			CPU_ClrV;
-			if (!((A ^ data) & 0x80) && ((data ^ tmp) & 0x80))
-				CPU_SetV;
-#endif
-
-			if (tmp >= 0xa0)
-				tmp += 0x60;
-			C = tmp > 0xff;
-			A = (UBYTE) tmp;
-		}
-		DONE;
-
-	sbc:
-		if (!(CPU_regP & CPU_D_FLAG)) {
-			/* Binary mode */
-			unsigned int tmp;
-			/* tmp = A - data - !C; */
-			tmp = A - data - 1 + C;
-			C = tmp < 0x100;
-#ifndef NO_V_FLAG_VARIABLE
-			V = ((A ^ data) & 0x80) && ((A ^ tmp) & 0x80);
-#else
-			CPU_ClrV;
-			if (((A ^ data) & 0x80) && ((A ^ tmp) & 0x80))
-				CPU_SetV;
-#endif
-			Z = N = A = (UBYTE) tmp;
-		}
-		else {
-			/* Decimal mode */
-			unsigned int tmp;
-			tmp = (A & 0x0f) - (data & 0x0f) - 1 + C;
-			if (tmp & 0x10)
-				tmp = ((tmp - 0x06) & 0x0f) - 0x10;
-			tmp += (A & 0xf0) - (data & 0xf0);
-			if (tmp & 0x100)
-				tmp -= 0x60;
-
-			Z = N = A - data - 1 + C;
-#ifndef NO_V_FLAG_VARIABLE
-			V = ((A ^ data) & 0x80) && ((A ^ Z) & 0x80);
-#else
-			CPU_ClrV;
-			if (((A ^ data) & 0x80) && ((A ^ Z) & 0x80))
-				CPU_SetV;
-#endif
-			C = ((unsigned int) (A - data - 1 + C)) <= 0xff;
-
-			A = tmp;
-		}
-		DONE;
-
-#ifdef NO_GOTO
-	}
+#ifndef ASAP
+	CPU_GO = AI_frame_timing ? CPU_GO_timed : go_untimed;
 #else
-	next:
+	CPU_GO = go_untimed;
 #endif
-
-#ifdef MONITOR_PROFILE
-		{
-			int cyc = ANTIC_xpos - old_xpos;
-			MONITOR_coverage[old_PC].cycles += cyc;
-			MONITOR_coverage_cycles += cyc;
-		}
-#endif
-
-#ifdef MONITOR_BREAK
-		if (MONITOR_break_step) {
-			DO_BREAK;
-		}
-#endif
-		/* This "continue" does nothing here.
-		   But it is necessary because, if we're not using NO_GOTO nor MONITOR_BREAK,
-		   gcc can complain: "error: label at end of compound statement". */
-		continue;
-	}
+}
 
 #else /* FALCON_CPUASM */
 
-	{
-		extern void CPU_GO_m68k(void);
-		CPU_GO_m68k();
-	}
+#define CPU_GO_NAME CPU_GO
+#define CPU_GO_CHECKS 1
+#define CPU_GO_TRACE 1
+#define CPU_GO_COVERAGE 1
+#include "cpu_go.h"
 
-#endif /* FALCON_CPUASM */
-	UPDATE_GLOBAL_REGS;
+void CPU_UpdateGo(void)
+{
 }
 
+#endif /* FALCON_CPUASM */
+
 void CPU_Reset(void)
 {
 #ifdef MONITOR_PROFILE
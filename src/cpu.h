@@ -46,7 +46,27 @@ void CPU_Reset(void);
 void CPU_StateSave(UBYTE SaveVerbose);
 void CPU_StateRead(UBYTE SaveVerbose, UBYTE StateVersion);
 void CPU_NMI(void);
+#ifdef FALCON_CPUASM
 void CPU_GO(int limit);
+#else
+/* Runs the CPU until ANTIC_xpos reaches limit. Points at a build of the
+   loop with or without the per-instruction debugging checks; call
+   CPU_UpdateGo() after turning any of them on or off. */
+extern void (*CPU_GO)(int limit);
+#endif
+void CPU_UpdateGo(void);
+#ifdef LIBATARI800
+/* Stops the CPU for the rest of the frame, with the libatari800 error code
+   of why: CPU_GO() returns after the current instruction and then only lets
+   ANTIC's cycles pass, so the registers stay as they were at the crash. An
+   NMI that comes meanwhile is held. */
+void CPU_Stop(int code);
+/* Runs the CPU again after CPU_Stop(), taking the NMI held if there is one */
+void CPU_Resume(void);
+extern int CPU_stopped;
+#endif
+/* Skip the repeats of loops that wait for an interrupt, see cpu.c */
+extern int CPU_idle_skip;
 #define CPU_GenerateIRQ() (CPU_IRQ = 1)
 
 extern UWORD CPU_regPC;
@@ -0,0 +1,2162 @@
+/*
+ * cpu_go.h - 6502 CPU emulation loop, included by cpu.c
+ *
+ * Copyright (C) 1995-1998 David Firth
+ * Copyright (C) 1998-2025 Atari800 development team (see DOC/CREDITS)
+ *
+ * This file is part of the Atari800 emulator project which emulates
+ * the Atari 400, 800, 800XL, 130XE, and 5200 8-bit computers.
+ *
+ * Atari800 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * Atari800 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Atari800; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+/*
+	cpu.c includes this file once for each variant of CPU_GO() it builds,
+	with these defined:
+
+	CPU_GO_NAME    name of the function
+	CPU_GO_CHECKS  1 to compile in the per-instruction checks: MONITOR_BREAK
+	               breakpoints, stepping and execution history,
+	               MONITOR_BREAKPOINTS, the AI interface's PC and write
+	               watches and its long history (ai_history.h)
+	CPU_GO_TRACE   1 to also compile in MONITOR_TRACE, MONITOR_PROFILE and
+	               the AI interface's profiler and heatmap
+	CPU_GO_COVERAGE 1 to mark each instruction's PC in AI_coverage; the
+	               loop with just this is only run while it is set, the
+	               others test it
+
+	There is no include guard.
+ */
+
+/* Stores by instructions (stack pushes excepted) */
+#if CPU_GO_CHECKS && !defined(ASAP)
+#define PUT_BYTE(addr, byte)	WATCHED_PUT(MEMORY_PutByte, addr, byte)
+#define dPUT_BYTE(addr, byte)	WATCHED_PUT(MEMORY_dPutByte, addr, byte)
+#else
+#define PUT_BYTE(addr, byte)	MEMORY_PutByte(addr, byte)
+#define dPUT_BYTE(addr, byte)	MEMORY_dPutByte(addr, byte)
+#endif
+
+#if CPU_GO_TRACE && (defined(MONITOR_PROFILE) || !defined(ASAP))
+#define CPU_GO_PROFILE 1
+#else
+#define CPU_GO_PROFILE 0
+#endif
+
+/* Taken backward branches in the fast loop look for idle loops to skip,
+   see idle_loop() in cpu.c. The registers and flags after the last pass
+   through the loop are compared with those after the one before. */
+#if !CPU_GO_CHECKS && !CPU_GO_TRACE && !defined(ASAP)
+#define IDLE_CHECK(target) \
+	if ((target) < GET_PC() && CPU_idle_skip) { \
+		if (GET_PC() == idle_pc && A == idle_a && X == idle_x && Y == idle_y \
+			&& N == idle_n && Z == idle_z && C == idle_c && IDLE_V_SAME && CPU_regP == idle_p) { \
+			int period = ANTIC_xpos - idle_xpos; \
+			if (ANTIC_xpos + period < ANTIC_xpos_limit) { \
+				if (idle_ok < 0) \
+					idle_ok = idle_loop(target, (UWORD) GET_PC(), A, X, Y, IDLE_P); \
+				if (idle_ok) { \
+					int skip = (ANTIC_xpos_limit - 1 - ANTIC_xpos) / period * period; \
+					ANTIC_xpos += skip; \
+					ANTIC_cycles.idle += skip; \
+				} \
+			} \
+		} \
+		else { \
+			idle_pc = GET_PC(); \
+			idle_ok = -1; \
+			idle_a = A; idle_x = X; idle_y = Y; \
+			idle_n = N; idle_z = Z; idle_c = C; IDLE_V_SAVE; idle_p = CPU_regP; \
+		} \
+		idle_xpos = ANTIC_xpos; \
+	}
+#ifndef NO_V_FLAG_VARIABLE
+#define IDLE_V_SAME	(V == idle_v)
+#define IDLE_V_SAVE	(idle_v = V)
+#define IDLE_P		((N & 0x80) + (V ? 0x40 : 0) + (CPU_regP & 0x0c) + ((Z == 0) ? 0x02 : 0) + C)
+#else
+#define IDLE_V_SAME	TRUE
+#define IDLE_V_SAVE
+#define IDLE_P		((N & 0x80) + (CPU_regP & 0x4c) + ((Z == 0) ? 0x02 : 0) + C)
+#endif
+#define CPU_GO_IDLE 1
+#else
+#define IDLE_CHECK(target)
+#define CPU_GO_IDLE 0
+#endif
+
+/* The fast loops run on through the overscreen lines ANTIC_Frame()
+   batches (see ANTIC_batch_lines) rather than return at each line end.
+   The debugging loops return, so that their checks see every line. */
+#if !CPU_GO_CHECKS && !defined(ASAP) && !defined(FALCON_CPUASM)
+#define CPU_GO_BATCH 1
+#else
+#define CPU_GO_BATCH 0
+#endif
+
+/* 6502 emulation routine */
+#ifndef FALCON_CPUASM
+#ifndef NO_GOTO
+__extension__ /* suppress -ansi -pedantic warnings */
+#endif
+void CPU_GO_NAME(int limit)
+{
+#ifdef NO_GOTO
+#define OPCODE_ALIAS(code)	case 0x##code:
+#define DONE				break
+#else
+#define OPCODE_ALIAS(code)	opcode_##code:
+#define DONE				goto next
+	static const void *opcode[256] =
+	{
+		&&opcode_00, &&opcode_01, &&opcode_02, &&opcode_03,
+		&&opcode_04, &&opcode_05, &&opcode_06, &&opcode_07,
+		&&opcode_08, &&opcode_09, &&opcode_0a, &&opcode_0b,
+		&&opcode_0c, &&opcode_0d, &&opcode_0e, &&opcode_0f,
+
+		&&opcode_10, &&opcode_11, &&opcode_12, &&opcode_13,
+		&&opcode_14, &&opcode_15, &&opcode_16, &&opcode_17,
+		&&opcode_18, &&opcode_19, &&opcode_1a, &&opcode_1b,
+		&&opcode_1c, &&opcode_1d, &&opcode_1e, &&opcode_1f,
+
+		&&opcode_20, &&opcode_21, &&opcode_22, &&opcode_23,
+		&&opcode_24, &&opcode_25, &&opcode_26, &&opcode_27,
+		&&opcode_28, &&opcode_29, &&opcode_2a, &&opcode_2b,
+		&&opcode_2c, &&opcode_2d, &&opcode_2e, &&opcode_2f,
+
+		&&opcode_30, &&opcode_31, &&opcode_32, &&opcode_33,
+		&&opcode_34, &&opcode_35, &&opcode_36, &&opcode_37,
+		&&opcode_38, &&opcode_39, &&opcode_3a, &&opcode_3b,
+		&&opcode_3c, &&opcode_3d, &&opcode_3e, &&opcode_3f,
+
+		&&opcode_40, &&opcode_41, &&opcode_42, &&opcode_43,
+		&&opcode_44, &&opcode_45, &&opcode_46, &&opcode_47,
+		&&opcode_48, &&opcode_49, &&opcode_4a, &&opcode_4b,
+		&&opcode_4c, &&opcode_4d, &&opcode_4e, &&opcode_4f,
+
+		&&opcode_50, &&opcode_51, &&opcode_52, &&opcode_53,
+		&&opcode_54, &&opcode_55, &&opcode_56, &&opcode_57,
+		&&opcode_58, &&opcode_59, &&opcode_5a, &&opcode_5b,
+		&&opcode_5c, &&opcode_5d, &&opcode_5e, &&opcode_5f,
+
+		&&opcode_60, &&opcode_61, &&opcode_62, &&opcode_63,
+		&&opcode_64, &&opcode_65, &&opcode_66, &&opcode_67,
+		&&opcode_68, &&opcode_69, &&opcode_6a, &&opcode_6b,
+		&&opcode_6c, &&opcode_6d, &&opcode_6e, &&opcode_6f,
+
+		&&opcode_70, &&opcode_71, &&opcode_72, &&opcode_73,
+		&&opcode_74, &&opcode_75, &&opcode_76, &&opcode_77,
+		&&opcode_78, &&opcode_79, &&opcode_7a, &&opcode_7b,
+		&&opcode_7c, &&opcode_7d, &&opcode_7e, &&opcode_7f,
+
+		&&opcode_80, &&opcode_81, &&opcode_82, &&opcode_83,
+		&&opcode_84, &&opcode_85, &&opcode_86, &&opcode_87,
+		&&opcode_88, &&opcode_89, &&opcode_8a, &&opcode_8b,
+		&&opcode_8c, &&opcode_8d, &&opcode_8e, &&opcode_8f,
+
+		&&opcode_90, &&opcode_91, &&opcode_92, &&opcode_93,
+		&&opcode_94, &&opcode_95, &&opcode_96, &&opcode_97,
+		&&opcode_98, &&opcode_99, &&opcode_9a, &&opcode_9b,
+		&&opcode_9c, &&opcode_9d, &&opcode_9e, &&opcode_9f,
+
+		&&opcode_a0, &&opcode_a1, &&opcode_a2, &&opcode_a3,
+		&&opcode_a4, &&opcode_a5, &&opcode_a6, &&opcode_a7,
+		&&opcode_a8, &&opcode_a9, &&opcode_aa, &&opcode_ab,
+		&&opcode_ac, &&opcode_ad, &&opcode_ae, &&opcode_af,
+
+		&&opcode_b0, &&opcode_b1, &&opcode_b2, &&opcode_b3,
+		&&opcode_b4, &&opcode_b5, &&opcode_b6, &&opcode_b7,
+		&&opcode_b8, &&opcode_b9, &&opcode_ba, &&opcode_bb,
+		&&opcode_bc, &&opcode_bd, &&opcode_be, &&opcode_bf,
+
+		&&opcode_c0, &&opcode_c1, &&opcode_c2, &&opcode_c3,
+		&&opcode_c4, &&opcode_c5, &&opcode_c6, &&opcode_c7,
+		&&opcode_c8, &&opcode_c9, &&opcode_ca, &&opcode_cb,
+		&&opcode_cc, &&opcode_cd, &&opcode_ce, &&opcode_cf,
+
+		&&opcode_d0, &&opcode_d1, &&opcode_d2, &&opcode_d3,
+		&&opcode_d4, &&opcode_d5, &&opcode_d6, &&opcode_d7,
+		&&opcode_d8, &&opcode_d9, &&opcode_da, &&opcode_db,
+		&&opcode_dc, &&opcode_dd, &&opcode_de, &&opcode_df,
+
+		&&opcode_e0, &&opcode_e1, &&opcode_e2, &&opcode_e3,
+		&&opcode_e4, &&opcode_e5, &&opcode_e6, &&opcode_e7,
+		&&opcode_e8, &&opcode_e9, &&opcode_ea, &&opcode_eb,
+		&&opcode_ec, &&opcode_ed, &&opcode_ee, &&opcode_ef,
+
+		&&opcode_f0, &&opcode_f1, &&opcode_f2, &&opcode_f3,
+		&&opcode_f4, &&opcode_f5, &&opcode_f6, &&opcode_f7,
+		&&opcode_f8, &&opcode_f9, &&opcode_fa, &&opcode_fb,
+		&&opcode_fc, &&opcode_fd, &&opcode_fe, &&opcode_ff,
+	};
+#endif	/* NO_GOTO */
+
+#ifdef CYCLES_PER_OPCODE
+#define OPCODE(code) OPCODE_ALIAS(code) ANTIC_xpos += cycles[0x##code];
+#else
+#define OPCODE(code) OPCODE_ALIAS(code)
+#endif
+
+#ifdef PC_PTR
+	const UBYTE *PC;
+#else
+	UWORD PC;
+#endif
+	UBYTE A;
+	UBYTE X;
+	UBYTE Y;
+	UBYTE S;
+
+	UWORD addr;
+	UBYTE data;
+#define insn data
+
+#if CPU_GO_IDLE
+	int idle_pc = -1;	/* branch after the last pass, -1 = none yet */
+	int idle_xpos = 0;
+	int idle_ok = -1;	/* idle_loop() of that loop, -1 = not asked yet */
+	UBYTE idle_a = 0, idle_x = 0, idle_y = 0, idle_n = 0, idle_z = 0, idle_c = 0, idle_p = 0;
+#ifndef NO_V_FLAG_VARIABLE
+	UBYTE idle_v = 0;
+#endif
+#endif
+
+#else /* FALCON_CPUASM */
+
+void CPU_GO_NAME(int limit)
+{
+#endif /* FALCON_CPUASM */
+
+/*
+   This used to be in the main loop but has been removed to improve
+   execution speed. It does not seem to have any adverse effect on
+   the emulation for two reasons:
+
+   1. NMI's will can only be raised in antic.c - there is
+      no way an NMI can be generated whilst in this routine.
+
+   2. The timing of the IRQs are not that critical. */
+
+#if CPU_GO_BATCH
+next_line:
+#endif
+	if (ANTIC_wsync_halt) {
+
+#ifdef NEW_CYCLE_EXACT
+		if (ANTIC_DRAWING_SCREEN) {
+/* if ANTIC_WSYNC_C is a stolen cycle, ANTIC_antic2cpu_ptr will convert that to the nearest
+   cpu cycle before that cycle.  The CPU will see this cycle, if WSYNC is not
+   delayed. (Actually this cycle is the first cycle of the instruction after
+   STA WSYNC, which was really executed one cycle after STA WSYNC because
+   of an internal antic delay ).   ANTIC_delayed_wsync is added to this cycle to form
+   the limit in the case that WSYNC is not early (does not allow this extra cycle) */
+
+			if (limit < ANTIC_antic2cpu_ptr[ANTIC_WSYNC_C] + ANTIC_delayed_wsync)
+				return;
+			ANTIC_cycles.wsync -= ANTIC_xpos;
+			ANTIC_xpos = ANTIC_antic2cpu_ptr[ANTIC_WSYNC_C] + ANTIC_delayed_wsync;
+		}
+		else {
+			if (limit < (ANTIC_WSYNC_C + ANTIC_delayed_wsync))
+				return;
+			ANTIC_cycles.wsync -= ANTIC_xpos;
+			ANTIC_xpos = ANTIC_WSYNC_C;
+		}
+		ANTIC_delayed_wsync = 0;
+
+#else /* NEW_CYCLE_EXACT */
+
+		if (limit < ANTIC_WSYNC_C)
+			return;
+		ANTIC_cycles.wsync -= ANTIC_xpos;
+		ANTIC_xpos = ANTIC_WSYNC_C;
+
+#endif /* NEW_CYCLE_EXACT */
+
+		ANTIC_cycles.wsync += ANTIC_xpos;
+		ANTIC_wsync_halt = 0;
+	}
+	ANTIC_xpos_limit = limit;			/* needed for WSYNC store inside ANTIC */
+	ANTIC_cycles.cpu -= ANTIC_xpos;		/* the cycles run are added on return */
+
+	UPDATE_LOCAL_REGS;
+
+	CPUCHECKIRQ;
+
+#ifndef FALCON_CPUASM
+	while (ANTIC_xpos < ANTIC_xpos_limit) {
+		CPU_delayed_nmi = 0;
+#if CPU_GO_PROFILE
+		int old_xpos = ANTIC_xpos;
+		UWORD old_PC = GET_PC();
+#endif
+#if CPU_GO_TRACE && !defined(ASAP)
+		double insn_ticks = AI_profile_host ? AI_Ticks() : 0.0;
+#endif
+
+
+#if CPU_GO_CHECKS && defined(MONITOR_BREAKPOINTS)
+	breakpoint_return:
+#endif
+
+#ifdef PC_PTR
+		/* must handle 64k wrapping */
+		if (PC >= MEMORY_mem + 0xfffe) {
+			if (PC >= MEMORY_mem + 0x10000)
+				PC -= 0x10000;
+			else {
+				/* the opcode is before 0x10000, but the operand is past */
+#ifdef WORDS_UNALIGNED_OK
+				*(UWORD *) (MEMORY_mem + 0x10000) = *(UWORD *) MEMORY_mem;
+#else
+				MEMORY_mem[0x10000] = MEMORY_mem[0];
+				MEMORY_mem[0x10001] = MEMORY_mem[1];
+#endif /* WORDS_UNALIGNED_OK */
+			}
+		}
+#endif /* PC_PTR */
+
+#if CPU_GO_TRACE && defined(MONITOR_TRACE)
+		if (MONITOR_trace_file != NULL) {
+			MONITOR_ShowState(MONITOR_trace_file, GET_PC(), A, X, Y, S,
+				(N & 0x80) ? 'N' : '-',
+#ifndef NO_V_FLAG_VARIABLE
+				V ? 'V' : '-',
+#else
+				(CPU_regP & CPU_V_FLAG) ? 'V' : '-',
+#endif
+				(Z == 0) ? 'Z' : '-',
+				(C != 0) ? 'C' : '-');
+		}
+#endif
+#if CPU_GO_TRACE && !defined(ASAP)
+		if (AI_trace_pos != NULL) {
+			/* record layout in ai_trace.h */
+			UBYTE *rec = AI_trace_pos;
+			UWORD pc = GET_PC();
+			ULONG clock = ANTIC_CPU_CLOCK & 0x7fffffff;
+			if (ANTIC_ypos & 0x100)
+				clock |= 0x80000000;
+			rec[0] = (UBYTE) pc;
+			rec[1] = (UBYTE) (pc >> 8);
+			rec[2] = MEMORY_dGetByte(pc);
+			rec[3] = MEMORY_dGetByte((UWORD) (pc + 1));
+			rec[4] = MEMORY_dGetByte((UWORD) (pc + 2));
+			rec[5] = A;
+			rec[6] = X;
+			rec[7] = Y;
+#ifndef NO_V_FLAG_VARIABLE
+			rec[8] = (N & 0x80) + (V ? 0x40 : 0) + (CPU_regP & 0x3c) + ((Z == 0) ? 0x02 : 0) + C;
+#else
+			rec[8] = (N & 0x80) + (CPU_regP & 0x7c) + ((Z == 0) ? 0x02 : 0) + C;
+#endif
+			rec[9] = S;
+			rec[10] = (UBYTE) ANTIC_XPOS;
+			rec[11] = (UBYTE) ANTIC_ypos;
+			rec[12] = (UBYTE) clock;
+			rec[13] = (UBYTE) (clock >> 8);
+			rec[14] = (UBYTE) (clock >> 16);
+			rec[15] = (UBYTE) (clock >> 24);
+			AI_trace_pos += AI_TRACE_RECORD;
+			if (AI_trace_pos >= AI_trace_end)
+				AI_TRACE_Flush();
+		}
+#endif
+
+#if CPU_GO_CHECKS && defined(MONITOR_BREAK)
+		CPU_remember_PC[CPU_remember_PC_curpos] = GET_PC();
+		CPU_remember_op[CPU_remember_PC_curpos][0] = MEMORY_dGetByte(GET_PC());
+		CPU_remember_op[CPU_remember_PC_curpos][1] = MEMORY_dGetByte(GET_PC()+1);
+		CPU_remember_op[CPU_remember_PC_curpos][2] = MEMORY_dGetByte(GET_PC()+2);
+#ifdef NEW_CYCLE_EXACT
+		if (ANTIC_DRAWING_SCREEN)
+			CPU_remember_xpos[CPU_remember_PC_curpos] = ANTIC_cpu2antic_ptr[ANTIC_xpos] + (ANTIC_ypos << 8);
+		else
+#endif
+			CPU_remember_xpos[CPU_remember_PC_curpos] = ANTIC_xpos + (ANTIC_ypos << 8);
+		CPU_remember_PC_curpos = (CPU_remember_PC_curpos + 1) % CPU_REMEMBER_PC_STEPS;
+
+		if (MONITOR_break_addr == GET_PC() || ANTIC_break_ypos == ANTIC_ypos) {
+			DO_BREAK;
+		}
+#endif /* MONITOR_BREAK */
+
+#if defined(WRAP_64K) && !defined(PC_PTR)
+		MEMORY_mem[0x10000] = MEMORY_mem[0];
+#endif
+
+#if CPU_GO_CHECKS && !defined(ASAP)
+		if (AI_pc_watch != NULL && AI_pc_watch[GET_PC()]) {
+			/* for the conditions of AI breakpoints */
+			UPDATE_GLOBAL_REGS;
+			AI_WatchHit(GET_PC());
+		}
+		if (AI_write_watch != NULL)
+			AI_write_pc = GET_PC();
+#endif
+
+#if CPU_GO_CHECKS && !defined(ASAP)
+		if (AI_HISTORY_ring != NULL) {
+			UWORD hpc = GET_PC();
+			if (hpc != AI_HISTORY_next || !AI_HISTORY_branches) {
+				AI_HISTORY_Rec *rec = AI_HISTORY_ring + ((ULONG) AI_HISTORY_pos++ & AI_HISTORY_mask);
+				rec->pc = hpc;
+				rec->from = AI_HISTORY_last;
+				rec->op[0] = MEMORY_dGetByte(hpc);
+				rec->op[1] = MEMORY_dGetByte((UWORD) (hpc + 1));
+				rec->op[2] = MEMORY_dGetByte((UWORD) (hpc + 2));
+#ifdef NEW_CYCLE_EXACT
+				if (ANTIC_DRAWING_SCREEN)
+					rec->xpos = (UBYTE) ANTIC_cpu2antic_ptr[ANTIC_xpos];
+				else
+#endif
+					rec->xpos = (UBYTE) ANTIC_xpos;
+				rec->ypos = (UWORD) ANTIC_ypos;
+			}
+			AI_HISTORY_last = hpc;
+			AI_HISTORY_next = (UWORD) (hpc + AI_HISTORY_length[MEMORY_dGetByte(hpc)]);
+		}
+#endif
+
+#if CPU_GO_COVERAGE && !defined(ASAP)
+#if CPU_GO_CHECKS
+		if (AI_coverage != NULL)
+#endif
+			AI_coverage[GET_PC()] = 1;
+#endif
+
+		insn = GET_CODE_BYTE();
+
+#if CPU_GO_CHECKS && defined(MONITOR_BREAKPOINTS)
+		/* Only where MONITOR_breakpoint_map says the table may fire is it
+		   evaluated */
+#if CPU_GO_CHECKS && defined(MONITOR_BREAK)
+		if (MONITOR_breakpoint_filter != 0 && !MONITOR_break_step)
+#else
+		if (MONITOR_breakpoint_filter != 0)
+#endif
+		{
+			UWORD bp_pc = (UWORD) (GET_PC() - 1);
+			int hit = (MONITOR_breakpoint_filter & MONITOR_BREAKPOINT_MAP_ALL)
+				|| (MONITOR_breakpoint_map[bp_pc] & MONITOR_BREAKPOINT_MAP_PC);
+			if (!hit && (MONITOR_breakpoint_filter & (MONITOR_BREAKPOINT_MAP_READ | MONITOR_BREAKPOINT_MAP_WRITE))) {
+				UBYTE optype = MONITOR_optype6502[insn];
+				if (optype & 12) {
+					switch (optype >> 4) {
+					case 1:
+						addr = PEEK_CODE_WORD();
+						break;
+					case 2:
+						addr = PEEK_CODE_BYTE();
+						break;
+					case 3:
+						addr = PEEK_CODE_WORD() + X;
+						break;
+					case 4:
+						addr = PEEK_CODE_WORD() + Y;
+						break;
+					case 5:
+						addr = (UBYTE) (PEEK_CODE_BYTE() + X);
+						addr = zGetWord(addr);
+						break;
+					case 6:
+						addr = PEEK_CODE_BYTE();
+						addr = zGetWord(addr) + Y;
+						break;
+					case 7:
+						addr = (UBYTE) (PEEK_CODE_BYTE() + X);
+						break;
+					case 8:
+						addr = (UBYTE) (PEEK_CODE_BYTE() + Y);
+						break;
+					/* XXX: case 13 */
+					default:
+						addr = 0;
+						break;
+					}
+					/* read (4) and write (8) as MAP_READ and MAP_WRITE */
+					hit = MONITOR_breakpoint_map[addr] & ((optype >> 1) & 6);
+				}
+			}
+			if (hit) {
+				UPDATE_GLOBAL_REGS;
+				CPU_regPC = bp_pc;
+				if (MONITOR_BreakpointFires(MONITOR_breakpoint_table, MONITOR_breakpoint_table_size)) {
+					PC--;
+					DO_BREAK;
+					goto breakpoint_return;
+				}
+			}
+		}
+#endif /* MONITOR_BREAKPOINTS */
+
+#ifndef CYCLES_PER_OPCODE
+		ANTIC_xpos += cycles[insn];
+#endif
+
+#if CPU_GO_TRACE && defined(MONITOR_PROFILE)
+		CPU_instruction_count[insn]++;
+		MONITOR_coverage[old_PC = PC - 1].count++;
+		MONITOR_coverage_insns++;
+#endif
+#if CPU_GO_TRACE && !defined(ASAP)
+		if (AI_profile != NULL) {
+			AI_profile[old_PC].count++;
+			AI_profile_opcodes[insn]++;
+		}
+		if (AI_HEATMAP_counts != NULL)
+			AI_HEATMAP_Instruction(old_PC, X, Y, S);
+#endif
+
+#ifdef PREFETCH_CODE
+		addr = PEEK_CODE_WORD();
+#endif
+
+#ifdef NO_GOTO
+		switch (insn) {
+#else
+		goto *opcode[insn];
+#endif
+
+	OPCODE(00)				/* BRK */
+#ifdef LIBATARI800
+		if (libatari800_stop_on_brk) {
+			PC--;
+			CPU_Stop(LIBATARI800_BRK_INSTRUCTION);
+		}
+		else
+#else /* LIBATARI800 */
+#ifdef MONITOR_BREAK
+		if (MONITOR_break_brk) {
+			DO_BREAK;
+		}
+		else
+#endif /* MONITOR_BREAK */
+#endif /* LIBATARI800 */
+		{
+#ifdef LIBATARI800
+			/* reported for the frame, which goes on */
+			if (!libatari800_continue_on_brk)
+				libatari800_error_code = LIBATARI800_BRK_INSTRUCTION;
+#endif
+			PC++;
+			PHPC;
+			PHPB1;
+			CPU_SetI;
+			SET_PC(MEMORY_dGetWordAligned(0xfffe));
+			INC_RET_NESTING;
+		}
+		DONE;
+
+	OPCODE(01)				/* ORA (ab,x) */
+		INDIRECT_X;
+		ORA(MEMORY_GetByte(addr));
+		DONE;
+
+	OPCODE(03)				/* ASO (ab,x) [unofficial - ASL then ORA with Acc] */
+		INDIRECT_X;
+
+	aso:
+		RMW_GetByte(data, addr);
+		C = (data & 0x80) ? 1 : 0;
+		data <<= 1;
+		PUT_BYTE(addr, data);
+		Z = N = A |= data;
+		DONE;
+
+	OPCODE_ALIAS(04)		/* NOP ab [unofficial - skip byte] */
+	OPCODE_ALIAS(44)
+	OPCODE(64)
+		PC++;
+		DONE;
+
+	OPCODE_ALIAS(14)		/* NOP ab,x [unofficial - skip byte] */
+	OPCODE_ALIAS(34)
+	OPCODE_ALIAS(54)
+	OPCODE_ALIAS(74)
+	OPCODE_ALIAS(d4)
+	OPCODE(f4)
+		PC++;
+		DONE;
+
+	OPCODE_ALIAS(80)		/* NOP #ab [unofficial - skip byte] */
+	OPCODE_ALIAS(82)
+	OPCODE_ALIAS(89)
+	OPCODE_ALIAS(c2)
+	OPCODE(e2)
+		PC++;
+		DONE;
+
+	OPCODE(05)				/* ORA ab */
+		ZPAGE;
+		ORA(MEMORY_dGetByte(addr));
+		DONE;
+
+	OPCODE(06)				/* ASL ab */
+		ZPAGE;
+		data = MEMORY_dGetByte(addr);
+		C = (data & 0x80) ? 1 : 0;
+		Z = N = data << 1;
+		dPUT_BYTE(addr, Z);
+		DONE;
+
+	OPCODE(07)				/* ASO ab [unofficial - ASL then ORA with Acc] */
+		ZPAGE;
+
+	aso_zpage:
+		data = MEMORY_dGetByte(addr);
+		C = (data & 0x80) ? 1 : 0;
+		data <<= 1;
+		dPUT_BYTE(addr, data);
+		Z = N = A |= data;
+		DONE;
+
+	OPCODE(08)				/* PHP */
+		PHPB1;
+		DONE;
+
+	OPCODE(09)				/* ORA #ab */
+		ORA(IMMEDIATE);
+		DONE;
+
+	OPCODE(0a)				/* ASL */
+		C = (A & 0x80) ? 1 : 0;
+		Z = N = A <<= 1;
+		DONE;
+
+	OPCODE_ALIAS(0b)		/* ANC #ab [unofficial - AND then copy N to C (Fox) */
+	OPCODE(2b)
+		AND(IMMEDIATE);
+		C = N >= 0x80;
+		DONE;
+
+	OPCODE(0c)				/* NOP abcd [unofficial - skip word] */
+		PC += 2;
+		DONE;
+
+	OPCODE(0d)				/* ORA abcd */
+		ABSOLUTE;
+		ORA(MEMORY_GetByte(addr));
+		DONE;
+
+	OPCODE(0e)				/* ASL abcd */
+		ABSOLUTE;
+		RMW_GetByte(data, addr);
+		C = (data & 0x80) ? 1 : 0;
+		Z = N = data << 1;
+		PUT_BYTE(addr, Z);
+		DONE;
+
+	OPCODE(0f)				/* ASO abcd [unofficial - ASL then ORA with Acc] */
+		ABSOLUTE;
+		goto aso;
+
+	OPCODE(10)				/* BPL */
+		BRANCH(!(N & 0x80))
+
+	OPCODE(11)				/* ORA (ab),y */
+		INDIRECT_Y;
+		NCYCLES_Y;
+		ORA(MEMORY_GetByte(addr));
+		DONE;
+
+	OPCODE(13)				/* ASO (ab),y [unofficial - ASL then ORA with Acc] */
+		INDIRECT_Y;
+		goto aso;
+
+	OPCODE(15)				/* ORA ab,x */
+		ZPAGE_X;
+		ORA(MEMORY_dGetByte(addr));
+		DONE;
+
+	OPCODE(16)				/* ASL ab,x */
+		ZPAGE_X;
+		data = MEMORY_dGetByte(addr);
+		C = (data & 0x80) ? 1 : 0;
+		Z = N = data << 1;
+		dPUT_BYTE(addr, Z);
+		DONE;
+
+	OPCODE(17)				/* ASO ab,x [unofficial - ASL then ORA with Acc] */
+		ZPAGE_X;
+		goto aso_zpage;
+
+	OPCODE(18)				/* CLC */
+		C = 0;
+		DONE;
+
+	OPCODE(19)				/* ORA abcd,y */
+		ABSOLUTE_Y;
+		NCYCLES_Y;
+		ORA(MEMORY_GetByte(addr));
+		DONE;
+
+	OPCODE(1b)				/* ASO abcd,y [unofficial - ASL then ORA with Acc] */
+		ABSOLUTE_Y;
+		goto aso;
+
+	OPCODE_ALIAS(1c)		/* NOP abcd,x [unofficial - skip word] */
+	OPCODE_ALIAS(3c)
+	OPCODE_ALIAS(5c)
+	OPCODE_ALIAS(7c)
+	OPCODE_ALIAS(dc)
+	OPCODE(fc)
+		if (OP_BYTE + X >= 0x100)
+			ANTIC_xpos++;
+		PC += 2;
+		DONE;
+
+	OPCODE(1d)				/* ORA abcd,x */
+		ABSOLUTE_X;
+		NCYCLES_X;
+		ORA(MEMORY_GetByte(addr));
+		DONE;
+
+	OPCODE(1e)				/* ASL abcd,x */
+		ABSOLUTE_X;
+		RMW_GetByte(data, addr);
+		C = (data & 0x80) ? 1 : 0;
+		Z = N = data << 1;
+		PUT_BYTE(addr, Z);
+		DONE;
+
+	OPCODE(1f)				/* ASO abcd,x [unofficial - ASL then ORA with Acc] */
+		ABSOLUTE_X;
+		goto aso;
+
+	OPCODE(20)				/* JSR abcd */
+		{
+			UWORD retaddr = GET_PC() + 1;
+#if CPU_GO_CHECKS && defined(MONITOR_BREAK)
+			CPU_remember_JMP[CPU_remember_jmp_curpos] = GET_PC() - 1;
+			CPU_remember_jmp_curpos = (CPU_remember_jmp_curpos + 1) % CPU_REMEMBER_JMP_STEPS;
+			MONITOR_ret_nesting++;
+#endif
+			PHW(retaddr);
+		}
+		SET_PC(OP_WORD);
+		DONE;
+
+	OPCODE(21)				/* AND (ab,x) */
+		INDIRECT_X;
+		AND(MEMORY_GetByte(addr));
+		DONE;
+
+	OPCODE(23)				/* RLA (ab,x) [unofficial - ROL Mem, then AND with A] */
+		INDIRECT_X;
+
+	rla:
+		RMW_GetByte(data, addr);
+		if (C) {
+			C = (data & 0x80) ? 1 : 0;
+			data = (data << 1) + 1;
+		}
+		else {
+			C = (data & 0x80) ? 1 : 0;
+			data = (data << 1);
+		}
+		PUT_BYTE(addr, data);
+		Z = N = A &= data;
+		DONE;
+
+	OPCODE(24)				/* BIT ab */
+		ZPAGE;
+		N = MEMORY_dGetByte(addr);
+#ifndef NO_V_FLAG_VARIABLE
+		V = N & 0x40;
+#else
+		CPU_regP = (CPU_regP & 0xbf) + (N & 0x40);
+#endif
+		Z = (A & N);
+		DONE;
+
+	OPCODE(25)				/* AND ab */
+		ZPAGE;
+		AND(MEMORY_dGetByte(addr));
+		DONE;
+
+	OPCODE(26)				/* ROL ab */
+		ZPAGE;
+		data = MEMORY_dGetByte(addr);
+		Z = N = (data << 1) + C;
+		C = (data & 0x80) ? 1 : 0;
+		dPUT_BYTE(addr, Z);
+		DONE;
+
+	OPCODE(27)				/* RLA ab [unofficial - ROL Mem, then AND with A] */
+		ZPAGE;
+
+	rla_zpage:
+		data = MEMORY_dGetByte(addr);
+		if (C) {
+			C = (data & 0x80) ? 1 : 0;
+			data = (data << 1) + 1;
+		}
+		else {
+			C = (data & 0x80) ? 1 : 0;
+			data = (data << 1);
+		}
+		dPUT_BYTE(addr, data);
+		Z = N = A &= data;
+		DONE;
+
+	OPCODE(28)				/* PLP */
+		PLP;
+		CPUCHECKIRQ;
+		DONE;
+
+	OPCODE(29)				/* AND #ab */
+		AND(IMMEDIATE);
+		DONE;
+
+	OPCODE(2a)				/* ROL */
+		Z = N = (A << 1) + C;
+		C = (A & 0x80) ? 1 : 0;
+		A = Z;
+		DONE;
+
+	OPCODE(2c)				/* BIT abcd */
+		ABSOLUTE;
+		N = MEMORY_GetByte(addr);
+#ifndef NO_V_FLAG_VARIABLE
+		V = N & 0x40;
+#else
+		CPU_regP = (CPU_regP & 0xbf) + (N & 0x40);
+#endif
+		Z = (A & N);
+		DONE;
+
+	OPCODE(2d)				/* AND abcd */
+		ABSOLUTE;
+		AND(MEMORY_GetByte(addr));
+		DONE;
+
+	OPCODE(2e)				/* ROL abcd */
+		ABSOLUTE;
+		RMW_GetByte(data, addr);
+		Z = N = (data << 1) + C;
+		C = (data & 0x80) ? 1 : 0;
+		PUT_BYTE(addr, Z);
+		DONE;
+
+	OPCODE(2f)				/* RLA abcd [unofficial - ROL Mem, then AND with A] */
+		ABSOLUTE;
+		goto rla;
+
+	OPCODE(30)				/* BMI */
+		BRANCH(N & 0x80)
+
+	OPCODE(31)				/* AND (ab),y */
+		INDIRECT_Y;
+		NCYCLES_Y;
+		AND(MEMORY_GetByte(addr));
+		DONE;
+
+	OPCODE(33)				/* RLA (ab),y [unofficial - ROL Mem, then AND with A] */
+		INDIRECT_Y;
+		goto rla;
+
+	OPCODE(35)				/* AND ab,x */
+		ZPAGE_X;
+		AND(MEMORY_dGetByte(addr));
+		DONE;
+
+	OPCODE(36)				/* ROL ab,x */
+		ZPAGE_X;
+		data = MEMORY_dGetByte(addr);
+		Z = N = (data << 1) + C;
+		C = (data & 0x80) ? 1 : 0;
+		dPUT_BYTE(addr, Z);
+		DONE;
+
+	OPCODE(37)				/* RLA ab,x [unofficial - ROL Mem, then AND with A] */
+		ZPAGE_X;
+		goto rla_zpage;
+
+	OPCODE(38)				/* SEC */
+		C = 1;
+		DONE;
+
+	OPCODE(39)				/* AND abcd,y */
+		ABSOLUTE_Y;
+		NCYCLES_Y;
+		AND(MEMORY_GetByte(addr));
+		DONE;
+
+	OPCODE(3b)				/* RLA abcd,y [unofficial - ROL Mem, then AND with A] */
+		ABSOLUTE_Y;
+		goto rla;
+
+	OPCODE(3d)				/* AND abcd,x */
+		ABSOLUTE_X;
+		NCYCLES_X;
+		AND(MEMORY_GetByte(addr));
+		DONE;
+
+	OPCODE(3e)				/* ROL abcd,x */
+		ABSOLUTE_X;
+		RMW_GetByte(data, addr);
+		Z = N = (data << 1) + C;
+		C = (data & 0x80) ? 1 : 0;
+		PUT_BYTE(addr, Z);
+		DONE;
+
+	OPCODE(3f)				/* RLA abcd,x [unofficial - ROL Mem, then AND with A] */
+		ABSOLUTE_X;
+		goto rla;
+
+	OPCODE(40)				/* RTI */
+		PLP;
+		data = PL;
+		SET_PC((PL << 8) + data);
+		CPUCHECKIRQ;
+#if CPU_GO_CHECKS && defined(MONITOR_BREAK)
+		if (MONITOR_break_ret && --MONITOR_ret_nesting <= 0)
+			MONITOR_break_step = TRUE;
+#endif
+		DONE;
+
+	OPCODE(41)				/* EOR (ab,x) */
+		INDIRECT_X;
+		EOR(MEMORY_GetByte(addr));
+		DONE;
+
+	OPCODE(43)				/* LSE (ab,x) [unofficial - LSR then EOR result with A] */
+		INDIRECT_X;
+
+	lse:
+		RMW_GetByte(data, addr);
+		C = data & 1;
+		data >>= 1;
+		PUT_BYTE(addr, data);
+		Z = N = A ^= data;
+		DONE;
+
+	OPCODE(45)				/* EOR ab */
+		ZPAGE;
+		EOR(MEMORY_dGetByte(addr));
+		DONE;
+
+	OPCODE(46)				/* LSR ab */
+		ZPAGE;
+		data = MEMORY_dGetByte(addr);
+		C = data & 1;
+		Z = data >> 1;
+		N = 0;
+		dPUT_BYTE(addr, Z);
+		DONE;
+
+	OPCODE(47)				/* LSE ab [unofficial - LSR then EOR result with A] */
+		ZPAGE;
+
+	lse_zpage:
+		data = MEMORY_dGetByte(addr);
+		C = data & 1;
+		data >>= 1;
+		dPUT_BYTE(addr, data);
+		Z = N = A ^= data;
+		DONE;
+
+	OPCODE(48)				/* PHA */
+		PH(A);
+		DONE;
+
+	OPCODE(49)				/* EOR #ab */
+		EOR(IMMEDIATE);
+		DONE;
+
+	OPCODE(4a)				/* LSR */
+		C = A & 1;
+		Z = N = A >>= 1;
+		DONE;
+
+	OPCODE(4b)				/* ALR #ab [unofficial - Acc AND Data, LSR result] */
+		data = A & IMMEDIATE;
+		C = data & 1;
+		Z = N = A = (data >> 1);
+		DONE;
+
+	OPCODE(4c)				/* JMP abcd */
+#if CPU_GO_CHECKS && defined(MONITOR_BREAK)
+		CPU_remember_JMP[CPU_remember_jmp_curpos] = GET_PC() - 1;
+		CPU_remember_jmp_curpos = (CPU_remember_jmp_curpos + 1) % CPU_REMEMBER_JMP_STEPS;
+#endif
+		SET_PC(OP_WORD);
+		DONE;
+
+	OPCODE(4d)				/* EOR abcd */
+		ABSOLUTE;
+		EOR(MEMORY_GetByte(addr));
+		DONE;
+
+	OPCODE(4e)				/* LSR abcd */
+		ABSOLUTE;
+		RMW_GetByte(data, addr);
+		C = data & 1;
+		Z = data >> 1;
+		N = 0;
+		PUT_BYTE(addr, Z);
+		DONE;
+
+	OPCODE(4f)				/* LSE abcd [unofficial - LSR then EOR result with A] */
+		ABSOLUTE;
+		goto lse;
+
+	OPCODE(50)				/* BVC */
+#ifndef NO_V_FLAG_VARIABLE
+		BRANCH(!V)
+#else
+		BRANCH(!(CPU_regP & 0x40))
+#endif
+
+	OPCODE(51)				/* EOR (ab),y */
+		INDIRECT_Y;
+		NCYCLES_Y;
+		EOR(MEMORY_GetByte(addr));
+		DONE;
+
+	OPCODE(53)				/* LSE (ab),y [unofficial - LSR then EOR result with A] */
+		INDIRECT_Y;
+		goto lse;
+
+	OPCODE(55)				/* EOR ab,x */
+		ZPAGE_X;
+		EOR(MEMORY_dGetByte(addr));
+		DONE;
+
+	OPCODE(56)				/* LSR ab,x */
+		ZPAGE_X;
+		data = MEMORY_dGetByte(addr);
+		C = data & 1;
+		Z = data >> 1;
+		N = 0;
+		dPUT_BYTE(addr, Z);
+		DONE;
+
+	OPCODE(57)				/* LSE ab,x [unofficial - LSR then EOR result with A] */
+		ZPAGE_X;
+		goto lse_zpage;
+
+	OPCODE(58)				/* CLI */
+		CPU_ClrI;
+		CPUCHECKIRQ;
+		DONE;
+
+	OPCODE(59)				/* EOR abcd,y */
+		ABSOLUTE_Y;
+		NCYCLES_Y;
+		EOR(MEMORY_GetByte(addr));
+		DONE;
+
+	OPCODE(5b)				/* LSE abcd,y [unofficial - LSR then EOR result with A] */
+		ABSOLUTE_Y;
+		goto lse;
+
+	OPCODE(5d)				/* EOR abcd,x */
+		ABSOLUTE_X;
+		NCYCLES_X;
+		EOR(MEMORY_GetByte(addr));
+		DONE;
+
+	OPCODE(5e)				/* LSR abcd,x */
+		ABSOLUTE_X;
+		RMW_GetByte(data, addr);
+		C = data & 1;
+		Z = data >> 1;
+		N = 0;
+		PUT_BYTE(addr, Z);
+		DONE;
+
+	OPCODE(5f)				/* LSE abcd,x [unofficial - LSR then EOR result with A] */
+		ABSOLUTE_X;
+		goto lse;
+
+	OPCODE(60)				/* RTS */
+		data = PL;
+		SET_PC((PL << 8) + data + 1);
+#if CPU_GO_CHECKS && defined(MONITOR_BREAK)
+		if (MONITOR_break_ret && --MONITOR_ret_nesting <= 0)
+			MONITOR_break_step = TRUE;
+#endif
+		if (CPU_rts_handler != NULL) {
+			CPU_rts_handler();
+			CPU_rts_handler = NULL;
+		}
+		DONE;
+
+	OPCODE(61)				/* ADC (ab,x) */
+		INDIRECT_X;
+		data = MEMORY_GetByte(addr);
+		goto adc;
+
+	OPCODE(63)				/* RRA (ab,x) [unofficial - ROR Mem, then ADC to Acc] */
+		INDIRECT_X;
+
+	rra:
+		RMW_GetByte(data, addr);
+		if (C) {
+			C = data & 1;
+			data = (data >> 1) + 0x80;
+		}
+		else {
+			C = data & 1;
+			data >>= 1;
+		}
+		PUT_BYTE(addr, data);
+		goto adc;
+
+	OPCODE(65)				/* ADC ab */
+		ZPAGE;
+		data = MEMORY_dGetByte(addr);
+		goto adc;
+
+	OPCODE(66)				/* ROR ab */
+		ZPAGE;
+		data = MEMORY_dGetByte(addr);
+		Z = N = (C << 7) + (data >> 1);
+		C = data & 1;
+		dPUT_BYTE(addr, Z);
+		DONE;
+
+	OPCODE(67)				/* RRA ab [unofficial - ROR Mem, then ADC to Acc] */
+		ZPAGE;
+
+	rra_zpage:
+		data = MEMORY_dGetByte(addr);
+		if (C) {
+			C = data & 1;
+			data = (data >> 1) + 0x80;
+		}
+		else {
+			C = data & 1;
+			data >>= 1;
+		}
+		dPUT_BYTE(addr, data);
+		goto adc;
+
+	OPCODE(68)				/* PLA */
+		Z = N = A = PL;
+		DONE;
+
+	OPCODE(69)				/* ADC #ab */
+		data = IMMEDIATE;
+		goto adc;
+
+	OPCODE(6a)				/* ROR */
+		Z = N = (C << 7) + (A >> 1);
+		C = A & 1;
+		A = Z;
+		DONE;
+
+	OPCODE(6b)				/* ARR #ab [unofficial - Acc AND Data, ROR result] */
+		/* It does some 'BCD fixup' if D flag is set */
+		/* MPC 05/24/00 */
+		data = A & IMMEDIATE;
+		if (CPU_regP & CPU_D_FLAG) {
+			UBYTE temp = (data >> 1) + (C << 7);
+			Z = N = temp;
+#ifndef NO_V_FLAG_VARIABLE
+			V = ((temp ^ data) & 0x40);
+#else
+			CPU_regP = (CPU_regP & 0xbf) + ((temp ^ data) & 0x40);
+#endif
+			if ((data & 0x0F) + (data & 0x01) > 5)
+				temp = (temp & 0xF0) + ((temp + 0x6) & 0x0F);
+			if (data + (data & 0x10) >= 0x60) {
+				temp += 0x60;
+				C = 1;
+			}
+			else
+				C = 0;
+			A = (UBYTE) temp;
+		}
+		else {
+			Z = N = A = (data >> 1) + (C << 7);
+			C = data >> 7;
+#ifndef NO_V_FLAG_VARIABLE
+			V = C ^ ((A >> 5) & 1);
+#else
+			CPU_regP = (CPU_regP & 0xbf) + ((A ^ data) & 0x40);
+#endif
+		}
+		DONE;
+
+	OPCODE(6c)				/* JMP (abcd) */
+#if CPU_GO_CHECKS && defined(MONITOR_BREAK)
+		CPU_remember_JMP[CPU_remember_jmp_curpos] = GET_PC() - 1;
+		CPU_remember_jmp_curpos = (CPU_remember_jmp_curpos + 1) % CPU_REMEMBER_JMP_STEPS;
+#endif
+		ABSOLUTE;
+#ifdef CPU65C02
+		/* XXX: if ((UBYTE) addr == 0xff) ANTIC_xpos++; */
+		SET_PC(MEMORY_dGetWord(addr));
+#else
+		/* original 6502 had a bug in JMP (addr) when addr crossed page boundary */
+		if ((UBYTE) addr == 0xff)
+			SET_PC((MEMORY_dGetByte(addr - 0xff) << 8) + MEMORY_dGetByte(addr));
+		else
+			SET_PC(MEMORY_dGetWord(addr));
+#endif
+		DONE;
+
+	OPCODE(6d)				/* ADC abcd */
+		ABSOLUTE;
+		data = MEMORY_GetByte(addr);
+		goto adc;
+
+	OPCODE(6e)				/* ROR abcd */
+		ABSOLUTE;
+		RMW_GetByte(data, addr);
+		Z = N = (C << 7) + (data >> 1);
+		C = data & 1;
+		PUT_BYTE(addr, Z);
+		DONE;
+
+	OPCODE(6f)				/* RRA abcd [unofficial - ROR Mem, then ADC to Acc] */
+		ABSOLUTE;
+		goto rra;
+
+	OPCODE(70)				/* BVS */
+#ifndef NO_V_FLAG_VARIABLE
+		BRANCH(V)
+#else
+		BRANCH(CPU_regP & 0x40)
+#endif
+
+	OPCODE(71)				/* ADC (ab),y */
+		INDIRECT_Y;
+		NCYCLES_Y;
+		data = MEMORY_GetByte(addr);
+		goto adc;
+
+	OPCODE(73)				/* RRA (ab),y [unofficial - ROR Mem, then ADC to Acc] */
+		INDIRECT_Y;
+		goto rra;
+
+	OPCODE(75)				/* ADC ab,x */
+		ZPAGE_X;
+		data = MEMORY_dGetByte(addr);
+		goto adc;
+
+	OPCODE(76)				/* ROR ab,x */
+		ZPAGE_X;
+		data = MEMORY_dGetByte(addr);
+		Z = N = (C << 7) + (data >> 1);
+		C = data & 1;
+		dPUT_BYTE(addr, Z);
+		DONE;
+
+	OPCODE(77)				/* RRA ab,x [unofficial - ROR Mem, then ADC to Acc] */
+		ZPAGE_X;
+		goto rra_zpage;
+
+	OPCODE(78)				/* SEI */
+		CPU_SetI;
+		DONE;
+
+	OPCODE(79)				/* ADC abcd,y */
+		ABSOLUTE_Y;
+		NCYCLES_Y;
+		data = MEMORY_GetByte(addr);
+		goto adc;
+
+	OPCODE(7b)				/* RRA abcd,y [unofficial - ROR Mem, then ADC to Acc] */
+		ABSOLUTE_Y;
+		goto rra;
+
+	OPCODE(7d)				/* ADC abcd,x */
+		ABSOLUTE_X;
+		NCYCLES_X;
+		data = MEMORY_GetByte(addr);
+		goto adc;
+
+	OPCODE(7e)				/* ROR abcd,x */
+		ABSOLUTE_X;
+		RMW_GetByte(data, addr);
+		Z = N = (C << 7) + (data >> 1);
+		C = data & 1;
+		PUT_BYTE(addr, Z);
+		DONE;
+
+	OPCODE(7f)				/* RRA abcd,x [unofficial - ROR Mem, then ADC to Acc] */
+		ABSOLUTE_X;
+		goto rra;
+
+	OPCODE(81)				/* STA (ab,x) */
+		INDIRECT_X;
+		PUT_BYTE(addr, A);
+		DONE;
+
+	/* AXS doesn't change flags and SAX is better name for it (Fox) */
+	OPCODE(83)				/* SAX (ab,x) [unofficial - Store result A AND X */
+		INDIRECT_X;
+		data = A & X;
+		PUT_BYTE(addr, data);
+		DONE;
+
+	OPCODE(84)				/* STY ab */
+		ZPAGE;
+		dPUT_BYTE(addr, Y);
+		DONE;
+
+	OPCODE(85)				/* STA ab */
+		ZPAGE;
+		dPUT_BYTE(addr, A);
+		DONE;
+
+	OPCODE(86)				/* STX ab */
+		ZPAGE;
+		dPUT_BYTE(addr, X);
+		DONE;
+
+	OPCODE(87)				/* SAX ab [unofficial - Store result A AND X] */
+		ZPAGE;
+		data = A & X;
+		dPUT_BYTE(addr, data);
+		DONE;
+
+	OPCODE(88)				/* DEY */
+		Z = N = --Y;
+		DONE;
+
+	OPCODE(8a)				/* TXA */
+		Z = N = A = X;
+		DONE;
+
+	OPCODE(8b)				/* ANE #ab [unofficial - A AND X AND (Mem OR $EF) to Acc] (Fox) */
+		data = IMMEDIATE;
+		Z = N = A & X & data;
+		A &= X & (data | 0xef);
+		DONE;
+
+	OPCODE(8c)				/* STY abcd */
+		ABSOLUTE;
+		PUT_BYTE(addr, Y);
+		DONE;
+
+	OPCODE(8d)				/* STA abcd */
+		ABSOLUTE;
+		PUT_BYTE(addr, A);
+		DONE;
+
+	OPCODE(8e)				/* STX abcd */
+		ABSOLUTE;
+		PUT_BYTE(addr, X);
+		DONE;
+
+	OPCODE(8f)				/* SAX abcd [unofficial - Store result A AND X] */
+		ABSOLUTE;
+		data = A & X;
+		PUT_BYTE(addr, data);
+		DONE;
+
+	OPCODE(90)				/* BCC */
+		BRANCH(!C)
+
+	OPCODE(91)				/* STA (ab),y */
+		INDIRECT_Y;
+		PUT_BYTE(addr, A);
+		DONE;
+
+	OPCODE(93)				/* SHA (ab),y [unofficial, UNSTABLE - Store A AND X AND (H+1) ?] (Fox) */
+		/* It seems previous memory value is important - also in 9f */
+		ZPAGE;
+		addr = zGetWord(addr);
+		data = A & X & ((addr >> 8) + 1);
+		if ((addr & 0xff) + Y > 0xff) { /* if it crosses a page */
+			PUT_BYTE(((addr + Y) & 0xff) | (data << 8), data);
+		}
+		else {
+			PUT_BYTE(addr + Y, data);
+		}
+		DONE;
+
+	OPCODE(94)				/* STY ab,x */
+		ZPAGE_X;
+		dPUT_BYTE(addr, Y);
+		DONE;
+
+	OPCODE(95)				/* STA ab,x */
+		ZPAGE_X;
+		dPUT_BYTE(addr, A);
+		DONE;
+
+	OPCODE(96)				/* STX ab,y */
+		ZPAGE_Y;
+		PUT_BYTE(addr, X);
+		DONE;
+
+	OPCODE(97)				/* SAX ab,y [unofficial - Store result A AND X] */
+		ZPAGE_Y;
+		data = A & X;
+		dPUT_BYTE(addr, data);
+		DONE;
+
+	OPCODE(98)				/* TYA */
+		Z = N = A = Y;
+		DONE;
+
+	OPCODE(99)				/* STA abcd,y */
+		ABSOLUTE_Y;
+		PUT_BYTE(addr, A);
+		DONE;
+
+	OPCODE(9a)				/* TXS */
+		S = X;
+		DONE;
+
+	OPCODE(9b)				/* SHS abcd,y [unofficial, UNSTABLE] (Fox) */
+		/* Transfer A AND X to S, then store S AND (H+1)] */
+		/* S seems to be stable, only memory values vary */
+		ABSOLUTE;
+		S = A & X;
+		data = S & ((addr >> 8) + 1);
+		if ((addr & 0xff) + Y > 0xff) { /* if it crosses a page */
+			PUT_BYTE(((addr + Y) & 0xff) | (data << 8), data);
+		}
+		else {
+			PUT_BYTE(addr + Y, data);
+		}
+		DONE;
+
+	OPCODE(9c)				/* SHY abcd,x [unofficial - Store Y and (H+1)] (Fox) */
+		/* Seems to be stable */
+		ABSOLUTE;
+		/* MPC 05/24/00 */
+		data = Y & ((UBYTE) ((addr >> 8) + 1));
+		if ((addr & 0xff) + X > 0xff) { /* if it crosses a page */
+			PUT_BYTE(((addr + X) & 0xff) | (data << 8), data);
+		}
+		else {
+			PUT_BYTE(addr + X, data);
+		}
+		DONE;
+
+	OPCODE(9d)				/* STA abcd,x */
+		ABSOLUTE_X;
+		PUT_BYTE(addr, A);
+		DONE;
+
+	OPCODE(9e)				/* SHX abcd,y [unofficial - Store X and (H+1)] (Fox) */
+		/* Seems to be stable */
+		ABSOLUTE;
+		/* MPC 05/24/00 */
+		data = X & ((UBYTE) ((addr >> 8) + 1));
+		if ((addr & 0xff) + Y > 0xff) { /* if it crosses a page */
+			PUT_BYTE(((addr + Y) & 0xff) | (data << 8), data);
+		}
+		else {
+			PUT_BYTE(addr + Y, data);
+		}
+		DONE;
+
+	OPCODE(9f)				/* SHA abcd,y [unofficial, UNSTABLE - Store A AND X AND (H+1) ?] (Fox) */
+		ABSOLUTE;
+		data = A & X & ((addr >> 8) + 1);
+		if ((addr & 0xff) + Y > 0xff) { /* if it crosses a page */
+			PUT_BYTE(((addr + Y) & 0xff) | (data << 8), data);
+		}
+		else {
+			PUT_BYTE(addr + Y, data);
+		}
+		DONE;
+
+	OPCODE(a0)				/* LDY #ab */
+		LDY(IMMEDIATE);
+		DONE;
+
+	OPCODE(a1)				/* LDA (ab,x) */
+		INDIRECT_X;
+		LDA(MEMORY_GetByte(addr));
+		DONE;
+
+	OPCODE(a2)				/* LDX #ab */
+		LDX(IMMEDIATE);
+		DONE;
+
+	OPCODE(a3)				/* LAX (ab,x) [unofficial] */
+		INDIRECT_X;
+		Z = N = X = A = MEMORY_GetByte(addr);
+		DONE;
+
+	OPCODE(a4)				/* LDY ab */
+		ZPAGE;
+		LDY(MEMORY_dGetByte(addr));
+		DONE;
+
+	OPCODE(a5)				/* LDA ab */
+		ZPAGE;
+		LDA(MEMORY_dGetByte(addr));
+		DONE;
+
+	OPCODE(a6)				/* LDX ab */
+		ZPAGE;
+		LDX(MEMORY_dGetByte(addr));
+		DONE;
+
+	OPCODE(a7)				/* LAX ab [unofficial] */
+		ZPAGE;
+		Z = N = X = A = MEMORY_GetByte(addr);
+		DONE;
+
+	OPCODE(a8)				/* TAY */
+		Z = N = Y = A;
+		DONE;
+
+	OPCODE(a9)				/* LDA #ab */
+		LDA(IMMEDIATE);
+		DONE;
+
+	OPCODE(aa)				/* TAX */
+		Z = N = X = A;
+		DONE;
+
+	OPCODE(ab)				/* ANX #ab [unofficial - AND #ab, then TAX] */
+		Z = N = X = A &= IMMEDIATE;
+		DONE;
+
+	OPCODE(ac)				/* LDY abcd */
+		ABSOLUTE;
+		LDY(MEMORY_GetByte(addr));
+		DONE;
+
+	OPCODE(ad)				/* LDA abcd */
+		ABSOLUTE;
+		LDA(MEMORY_GetByte(addr));
+		DONE;
+
+	OPCODE(ae)				/* LDX abcd */
+		ABSOLUTE;
+		LDX(MEMORY_GetByte(addr));
+		DONE;
+
+	OPCODE(af)				/* LAX abcd [unofficial] */
+		ABSOLUTE;
+		Z = N = X = A = MEMORY_GetByte(addr);
+		DONE;
+
+	OPCODE(b0)				/* BCS */
+		BRANCH(C)
+
+	OPCODE(b1)				/* LDA (ab),y */
+		INDIRECT_Y;
+		NCYCLES_Y;
+		LDA(MEMORY_GetByte(addr));
+		DONE;
+
+	OPCODE(b3)				/* LAX (ab),y [unofficial] */
+		INDIRECT_Y;
+		NCYCLES_Y;
+		Z = N = X = A = MEMORY_GetByte(addr);
+		DONE;
+
+	OPCODE(b4)				/* LDY ab,x */
+		ZPAGE_X;
+		LDY(MEMORY_dGetByte(addr));
+		DONE;
+
+	OPCODE(b5)				/* LDA ab,x */
+		ZPAGE_X;
+		LDA(MEMORY_dGetByte(addr));
+		DONE;
+
+	OPCODE(b6)				/* LDX ab,y */
+		ZPAGE_Y;
+		LDX(MEMORY_GetByte(addr));
+		DONE;
+
+	OPCODE(b7)				/* LAX ab,y [unofficial] */
+		ZPAGE_Y;
+		Z = N = X = A = MEMORY_GetByte(addr);
+		DONE;
+
+	OPCODE(b8)				/* CLV */
+#ifndef NO_V_FLAG_VARIABLE
+		V = 0;
+#else
+		CPU_ClrV;
+#endif
+		DONE;
+
+	OPCODE(b9)				/* LDA abcd,y */
+		ABSOLUTE_Y;
+		NCYCLES_Y;
+		LDA(MEMORY_GetByte(addr));
+		DONE;
+
+	OPCODE(ba)				/* TSX */
+		Z = N = X = S;
+		DONE;
+
+/* AXA [unofficial - original decode by R.Sterba and R.Petruzela 15.1.1998 :-)]
+   AXA - this is our new imaginative name for instruction with opcode hex BB.
+   AXA - Store Mem AND #$FD to Acc and X, then set stackpoint to value (Acc - 4)
+   It's cool! :-)
+   LAS - this is better name for this :) (Fox)
+   It simply ANDs stack pointer with Mem, then transfers result to A and X
+ */
+
+	OPCODE(bb)				/* LAS abcd,y [unofficial - AND S with Mem, transfer to A and X (Fox) */
+		ABSOLUTE_Y;
+		NCYCLES_Y;
+		Z = N = A = X = S &= MEMORY_GetByte(addr);
+		DONE;
+
+	OPCODE(bc)				/* LDY abcd,x */
+		ABSOLUTE_X;
+		NCYCLES_X;
+		LDY(MEMORY_GetByte(addr));
+		DONE;
+
+	OPCODE(bd)				/* LDA abcd,x */
+		ABSOLUTE_X;
+		NCYCLES_X;
+		LDA(MEMORY_GetByte(addr));
+		DONE;
+
+	OPCODE(be)				/* LDX abcd,y */
+		ABSOLUTE_Y;
+		NCYCLES_Y;
+		LDX(MEMORY_GetByte(addr));
+		DONE;
+
+	OPCODE(bf)				/* LAX abcd,y [unofficial] */
+		ABSOLUTE_Y;
+		NCYCLES_Y;
+		Z = N = X = A = MEMORY_GetByte(addr);
+		DONE;
+
+	OPCODE(c0)				/* CPY #ab */
+		CPY(IMMEDIATE);
+		DONE;
+
+	OPCODE(c1)				/* CMP (ab,x) */
+		INDIRECT_X;
+		CMP(MEMORY_GetByte(addr));
+		DONE;
+
+	OPCODE(c3)				/* DCM (ab,x) [unofficial - DEC Mem then CMP with Acc] */
+		INDIRECT_X;
+
+	dcm:
+		RMW_GetByte(data, addr);
+		data--;
+		PUT_BYTE(addr, data);
+		CMP(data);
+		DONE;
+
+	OPCODE(c4)				/* CPY ab */
+		ZPAGE;
+		CPY(MEMORY_dGetByte(addr));
+		DONE;
+
+	OPCODE(c5)				/* CMP ab */
+		ZPAGE;
+		CMP(MEMORY_dGetByte(addr));
+		DONE;
+
+	OPCODE(c6)				/* DEC ab */
+		ZPAGE;
+		Z = N = MEMORY_dGetByte(addr) - 1;
+		dPUT_BYTE(addr, Z);
+		DONE;
+
+	OPCODE(c7)				/* DCM ab [unofficial - DEC Mem then CMP with Acc] */
+		ZPAGE;
+
+	dcm_zpage:
+		data = MEMORY_dGetByte(addr) - 1;
+		dPUT_BYTE(addr, data);
+		CMP(data);
+		DONE;
+
+	OPCODE(c8)				/* INY */
+		Z = N = ++Y;
+		DONE;
+
+	OPCODE(c9)				/* CMP #ab */
+		CMP(IMMEDIATE);
+		DONE;
+
+	OPCODE(ca)				/* DEX */
+		Z = N = --X;
+		DONE;
+
+	OPCODE(cb)				/* SBX #ab [unofficial - store ((A AND X) - Mem) in X] (Fox) */
+		X &= A;
+		data = IMMEDIATE;
+		C = X >= data;
+		/* MPC 05/24/00 */
+		Z = N = X -= data;
+		DONE;
+
+	OPCODE(cc)				/* CPY abcd */
+		ABSOLUTE;
+		CPY(MEMORY_GetByte(addr));
+		DONE;
+
+	OPCODE(cd)				/* CMP abcd */
+		ABSOLUTE;
+		CMP(MEMORY_GetByte(addr));
+		DONE;
+
+	OPCODE(ce)				/* DEC abcd */
+		ABSOLUTE;
+		RMW_GetByte(Z, addr);
+		N = --Z;
+		PUT_BYTE(addr, Z);
+		DONE;
+
+	OPCODE(cf)				/* DCM abcd [unofficial - DEC Mem then CMP with Acc] */
+		ABSOLUTE;
+		goto dcm;
+
+	OPCODE(d0)				/* BNE */
+		BRANCH(Z)
+
+	OPCODE(d1)				/* CMP (ab),y */
+		INDIRECT_Y;
+		NCYCLES_Y;
+		CMP(MEMORY_GetByte(addr));
+		DONE;
+
+	OPCODE(d3)				/* DCM (ab),y [unofficial - DEC Mem then CMP with Acc] */
+		INDIRECT_Y;
+		goto dcm;
+
+	OPCODE(d5)				/* CMP ab,x */
+		ZPAGE_X;
+		CMP(MEMORY_dGetByte(addr));
+		DONE;
+
+	OPCODE(d6)				/* DEC ab,x */
+		ZPAGE_X;
+		Z = N = MEMORY_dGetByte(addr) - 1;
+		dPUT_BYTE(addr, Z);
+		DONE;
+
+	OPCODE(d7)				/* DCM ab,x [unofficial - DEC Mem then CMP with Acc] */
+		ZPAGE_X;
+		goto dcm_zpage;
+
+	OPCODE(d8)				/* CLD */
+		CPU_ClrD;
+		DONE;
+
+	OPCODE(d9)				/* CMP abcd,y */
+		ABSOLUTE_Y;
+		NCYCLES_Y;
+		CMP(MEMORY_GetByte(addr));
+		DONE;
+
+	OPCODE(db)				/* DCM abcd,y [unofficial - DEC Mem then CMP with Acc] */
+		ABSOLUTE_Y;
+		goto dcm;
+
+	OPCODE(dd)				/* CMP abcd,x */
+		ABSOLUTE_X;
+		NCYCLES_X;
+		CMP(MEMORY_GetByte(addr));
+		DONE;
+
+	OPCODE(de)				/* DEC abcd,x */
+		ABSOLUTE_X;
+		RMW_GetByte(Z, addr);
+		N = --Z;
+		PUT_BYTE(addr, Z);
+		DONE;
+
+	OPCODE(df)				/* DCM abcd,x [unofficial - DEC Mem then CMP with Acc] */
+		ABSOLUTE_X;
+		goto dcm;
+
+	OPCODE(e0)				/* CPX #ab */
+		CPX(IMMEDIATE);
+		DONE;
+
+	OPCODE(e1)				/* SBC (ab,x) */
+		INDIRECT_X;
+		data = MEMORY_GetByte(addr);
+		goto sbc;
+
+	OPCODE(e3)				/* INS (ab,x) [unofficial - INC Mem then SBC with Acc] */
+		INDIRECT_X;
+
+	ins:
+		RMW_GetByte(data, addr);
+		++data;
+		PUT_BYTE(addr, data);
+		goto sbc;
+
+	OPCODE(e4)				/* CPX ab */
+		ZPAGE;
+		CPX(MEMORY_dGetByte(addr));
+		DONE;
+
+	OPCODE(e5)				/* SBC ab */
+		ZPAGE;
+		data = MEMORY_dGetByte(addr);
+		goto sbc;
+
+	OPCODE(e6)				/* INC ab */
+		ZPAGE;
+		Z = N = MEMORY_dGetByte(addr) + 1;
+		dPUT_BYTE(addr, Z);
+		DONE;
+
+	OPCODE(e7)				/* INS ab [unofficial - INC Mem then SBC with Acc] */
+		ZPAGE;
+
+	ins_zpage:
+		data = MEMORY_dGetByte(addr) + 1;
+		dPUT_BYTE(addr, data);
+		goto sbc;
+
+	OPCODE(e8)				/* INX */
+		Z = N = ++X;
+		DONE;
+
+	OPCODE_ALIAS(e9)		/* SBC #ab */
+	OPCODE(eb)				/* SBC #ab [unofficial] */
+		data = IMMEDIATE;
+		goto sbc;
+
+	OPCODE_ALIAS(ea)		/* NOP */
+	OPCODE_ALIAS(1a)		/* NOP [unofficial] */
+	OPCODE_ALIAS(3a)
+	OPCODE_ALIAS(5a)
+	OPCODE_ALIAS(7a)
+	OPCODE_ALIAS(da)
+	OPCODE(fa)
+		DONE;
+
+	OPCODE(ec)				/* CPX abcd */
+		ABSOLUTE;
+		CPX(MEMORY_GetByte(addr));
+		DONE;
+
+	OPCODE(ed)				/* SBC abcd */
+		ABSOLUTE;
+		data = MEMORY_GetByte(addr);
+		goto sbc;
+
+	OPCODE(ee)				/* INC abcd */
+		ABSOLUTE;
+		RMW_GetByte(Z, addr);
+		N = ++Z;
+		PUT_BYTE(addr, Z);
+		DONE;
+
+	OPCODE(ef)				/* INS abcd [unofficial - INC Mem then SBC with Acc] */
+		ABSOLUTE;
+		goto ins;
+
+	OPCODE(f0)				/* BEQ */
+		BRANCH(!Z)
+
+	OPCODE(f1)				/* SBC (ab),y */
+		INDIRECT_Y;
+		NCYCLES_Y;
+		data = MEMORY_GetByte(addr);
+		goto sbc;
+
+	OPCODE(f3)				/* INS (ab),y [unofficial - INC Mem then SBC with Acc] */
+		INDIRECT_Y;
+		goto ins;
+
+	OPCODE(f5)				/* SBC ab,x */
+		ZPAGE_X;
+		data = MEMORY_dGetByte(addr);
+		goto sbc;
+
+	OPCODE(f6)				/* INC ab,x */
+		ZPAGE_X;
+		Z = N = MEMORY_dGetByte(addr) + 1;
+		dPUT_BYTE(addr, Z);
+		DONE;
+
+	OPCODE(f7)				/* INS ab,x [unofficial - INC Mem then SBC with Acc] */
+		ZPAGE_X;
+		goto ins_zpage;
+
+	OPCODE(f8)				/* SED */
+		CPU_SetD;
+		DONE;
+
+	OPCODE(f9)				/* SBC abcd,y */
+		ABSOLUTE_Y;
+		NCYCLES_Y;
+		data = MEMORY_GetByte(addr);
+		goto sbc;
+
+	OPCODE(fb)				/* INS abcd,y [unofficial - INC Mem then SBC with Acc] */
+		ABSOLUTE_Y;
+		goto ins;
+
+	OPCODE(fd)				/* SBC abcd,x */
+		ABSOLUTE_X;
+		NCYCLES_X;
+		data = MEMORY_GetByte(addr);
+		goto sbc;
+
+	OPCODE(fe)				/* INC abcd,x */
+		ABSOLUTE_X;
+		RMW_GetByte(Z, addr);
+		N = ++Z;
+		PUT_BYTE(addr, Z);
+		DONE;
+
+	OPCODE(ff)				/* INS abcd,x [unofficial - INC Mem then SBC with Acc] */
+		ABSOLUTE_X;
+		goto ins;
+
+#ifdef ASAP
+
+	OPCODE_ALIAS(d2)
+	OPCODE_ALIAS(f2)
+
+#else
+
+	OPCODE(d2)				/* ESCRTS #ab (CIM) - on Atari is here instruction CIM [unofficial] !RS! */
+		data = IMMEDIATE;
+		UPDATE_GLOBAL_REGS;
+		CPU_GetStatus();
+		ESC_Run(data);
+		CPU_PutStatus();
+		UPDATE_LOCAL_REGS;
+#ifdef LIBATARI800
+		if (CPU_stopped)
+			DONE;
+#endif
+		data = PL;
+		SET_PC((PL << 8) + data + 1);
+#if CPU_GO_CHECKS && defined(MONITOR_BREAK)
+		if (MONITOR_break_ret && --MONITOR_ret_nesting <= 0)
+			MONITOR_break_step = TRUE;
+#endif
+		DONE;
+
+	OPCODE(f2)				/* ESC #ab (CIM) - on Atari is here instruction CIM [unofficial] !RS! */
+		/* OPCODE(ff: ESC #ab - opcode FF is now used for INS [unofficial] instruction !RS! */
+		data = IMMEDIATE;
+		UPDATE_GLOBAL_REGS;
+		CPU_GetStatus();
+		ESC_Run(data);
+		CPU_PutStatus();
+		UPDATE_LOCAL_REGS;
+		DONE;
+
+#endif /* ASAP */
+
+	OPCODE_ALIAS(02)		/* CIM [unofficial - crash intermediate] */
+	OPCODE_ALIAS(12)
+	OPCODE_ALIAS(22)
+	OPCODE_ALIAS(32)
+	OPCODE_ALIAS(42)
+	OPCODE_ALIAS(52)
+	OPCODE_ALIAS(62)
+	OPCODE_ALIAS(72)
+	OPCODE_ALIAS(92)
+	OPCODE(b2)
+
+#ifdef ASAP
+
+		ASAP_CIM();
+		DONE;
+
+#else
+
+	/* OPCODE(d2) Used for ESCRTS #ab (CIM) */
+	/* OPCODE(f2) Used for ESC #ab (CIM) */
+		PC--;
+		UPDATE_GLOBAL_REGS;
+		CPU_GetStatus();
+
+#ifdef CRASH_MENU
+		UI_crash_address = GET_PC();
+		UI_crash_afterCIM = GET_PC() + 1;
+		UI_crash_code = insn;
+		UI_Run();
+#else
+		CPU_cim_encountered = TRUE;
+#ifdef LIBATARI800
+		CPU_Stop(LIBATARI800_CPU_CRASH);
+#else
+		ENTER_MONITOR;
+#endif /* LIBATARI800 */
+#endif /* CRASH_MENU */
+
+		CPU_PutStatus();
+		UPDATE_LOCAL_REGS;
+		DONE;
+
+#endif /* ASAP */
+
+/* ---------------------------------------------- */
+/* ADC and SBC routines */
+
+	adc:
+		if (!(CPU_regP & CPU_D_FLAG)) {
+			/* Binary mode */
+			unsigned int tmp;
+			tmp = A + data + C;
+			C = tmp > 0xff;
+			/* C = tmp >> 8; */
+#ifndef NO_V_FLAG_VARIABLE
+			V = !((A ^ data) & 0x80) && ((data ^ tmp) & 0x80);
+#else
+			CPU_ClrV;
+			if (!((A ^ data) & 0x80) && ((data ^ tmp) & 0x80))
+				CPU_SetV;
+#endif
+			Z = N = A = (UBYTE) tmp;
+	    }
+		else {
+			/* Decimal mode */
+			unsigned int tmp;
+			tmp = (A & 0x0f) + (data & 0x0f) + C;
+			if (tmp >= 0x0a)
+				tmp = ((tmp + 0x06) & 0x0f) + 0x10;
+			tmp += (A & 0xf0) + (data & 0xf0);
+
+			Z = A + data + C;
+			N = (UBYTE) tmp;
+#ifndef NO_V_FLAG_VARIABLE
+			V = !((A ^ data) & 0x80) && ((data ^ tmp) & 0x80);
+#else
+			CPU_ClrV;
+			if (!((A ^ data) & 0x80) && ((data ^ tmp) & 0x80))
+				CPU_SetV;
+#endif
+
+			if (tmp >= 0xa0)
+				tmp += 0x60;
+			C = tmp > 0xff;
+			A = (UBYTE) tmp;
+		}
+		DONE;
+
+	sbc:
+		if (!(CPU_regP & CPU_D_FLAG)) {
+			/* Binary mode */
+			unsigned int tmp;
+			/* tmp = A - data - !C; */
+			tmp = A - data - 1 + C;
+			C = tmp < 0x100;
+#ifndef NO_V_FLAG_VARIABLE
+			V = ((A ^ data) & 0x80) && ((A ^ tmp) & 0x80);
+#else
+			CPU_ClrV;
+			if (((A ^ data) & 0x80) && ((A ^ tmp) & 0x80))
+				CPU_SetV;
+#endif
+			Z = N = A = (UBYTE) tmp;
+		}
+		else {
+			/* Decimal mode */
+			unsigned int tmp;
+			tmp = (A & 0x0f) - (data & 0x0f) - 1 + C;
+			if (tmp & 0x10)
+				tmp = ((tmp - 0x06) & 0x0f) - 0x10;
+			tmp += (A & 0xf0) - (data & 0xf0);
+			if (tmp & 0x100)
+				tmp -= 0x60;
+
+			Z = N = A - data - 1 + C;
+#ifndef NO_V_FLAG_VARIABLE
+			V = ((A ^ data) & 0x80) && ((A ^ Z) & 0x80);
+#else
+			CPU_ClrV;
+			if (((A ^ data) & 0x80) && ((A ^ Z) & 0x80))
+				CPU_SetV;
+#endif
+			C = ((unsigned int) (A - data - 1 + C)) <= 0xff;
+
+			A = tmp;
+		}
+		DONE;
+
+#ifdef NO_GOTO
+	}
+#else
+	next:
+#endif
+
+#if CPU_GO_TRACE && defined(MONITOR_PROFILE)
+		{
+			int cyc = ANTIC_xpos - old_xpos;
+			MONITOR_coverage[old_PC].cycles += cyc;
+			MONITOR_coverage_cycles += cyc;
+		}
+#endif
+#if CPU_GO_TRACE && !defined(ASAP)
+		if (AI_profile != NULL) {
+			AI_profile[old_PC].cycles += ANTIC_xpos - old_xpos;
+			if (AI_profile_host)
+				AI_profile[old_PC].host += AI_Ticks() - insn_ticks;
+		}
+#endif
+
+#if CPU_GO_CHECKS && defined(MONITOR_BREAK)
+		if (MONITOR_break_step) {
+			DO_BREAK;
+		}
+#endif
+		/* This "continue" does nothing here.
+		   But it is necessary because, if we're not using NO_GOTO nor MONITOR_BREAK,
+		   gcc can complain: "error: label at end of compound statement". */
+		continue;
+	}
+
+#else /* FALCON_CPUASM */
+
+	{
+		extern void CPU_GO_m68k(void);
+		CPU_GO_m68k();
+	}
+
+#endif /* FALCON_CPUASM */
+	UPDATE_GLOBAL_REGS;
+	ANTIC_cycles.cpu += ANTIC_xpos;
+#if CPU_GO_BATCH
+	if (ANTIC_batch_lines > 0
+#ifdef LIBATARI800
+		&& !CPU_stopped
+#endif
+		) {
+		ANTIC_NextOverscreenLine();
+#if CPU_GO_IDLE
+		/* VCOUNT has moved on and a pass across the line end took
+		   the refresh cycles too: look for the loop again */
+		idle_pc = -1;
+#endif
+		goto next_line;
+	}
+#endif
+}
+
+#undef CPU_GO_PROFILE
+#undef CPU_GO_IDLE
+#undef CPU_GO_BATCH
+#undef IDLE_CHECK
+#undef IDLE_V_SAME
+#undef IDLE_V_SAVE
+#undef IDLE_P
+#undef PUT_BYTE
+#undef dPUT_BYTE
+#undef OPCODE_ALIAS
+#undef DONE
+#undef OPCODE
+#undef insn
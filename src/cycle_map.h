@@ -2,8 +2,9 @@
 #define CYCLE_MAP_H_
 
 #define CYCLE_MAP_SIZE (114 + 9)
-extern int CYCLE_MAP_cpu2antic[CYCLE_MAP_SIZE * (17 * 7 + 1)];
-extern int CYCLE_MAP_antic2cpu[CYCLE_MAP_SIZE * (17 * 7 + 1)];
-void CYCLE_MAP_Create(void);
+/* For each kind of display line, the ANTIC cycle of each CPU cycle and the
+   CPU cycle of each ANTIC cycle; constant, see tools/gen_cycle_map.c */
+extern int const CYCLE_MAP_cpu2antic[CYCLE_MAP_SIZE * (17 * 7 + 1)];
+extern int const CYCLE_MAP_antic2cpu[CYCLE_MAP_SIZE * (17 * 7 + 1)];
 
 #endif /* CYCLE_MAP_H_ */
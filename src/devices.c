@@ -234,49 +234,114 @@ static int match(const char *pattern, const char *filename)
 
 static char dir_path[FILENAME_MAX];
 static char filename_pattern[FILENAME_MAX];
-static DIR *dp = NULL;
+
+/* Names of the entries in the directories read last. A listing is read
+   again when the directory's mtime changes, that is when an entry is
+   added, removed or renamed. Since mtime counts whole seconds, a listing
+   read within a second of the last change is not trusted. */
+#define DIR_CACHE_SIZE 8
+static struct {
+	char path[FILENAME_MAX];
+	time_t mtime;
+	int trusted;
+	char *names; /* each ended by NUL */
+	size_t len;
+	size_t alloc;
+	unsigned int used;
+} dir_cache[DIR_CACHE_SIZE];
+static unsigned int dir_cache_clock = 0;
+
+/* the names of the directory being read, from dir_next */
+static const char *dir_next = NULL;
+static const char *dir_end = NULL;
 
 static int Devices_OpenDir(const char *filename)
 {
+	DIR *dp;
+	struct dirent *entry;
+	int i;
+	int slot = 0;
+	time_t mtime = 0;
+	int trusted = FALSE;
+#ifdef HAVE_STAT
+	struct stat status;
+#endif
+
 	Util_splitpath(filename, dir_path, filename_pattern);
-	if (dp != NULL)
-		closedir(dp);
+	for (i = 0; i < DIR_CACHE_SIZE; i++) {
+		if (strcmp(dir_cache[i].path, dir_path) == 0) {
+			slot = i;
+			break;
+		}
+		if (dir_cache[i].used < dir_cache[slot].used)
+			slot = i;
+	}
+#ifdef HAVE_STAT
+	if (stat(dir_path, &status) == 0) {
+		mtime = status.st_mtime;
+		trusted = time(NULL) > mtime + 1;
+		if (i < DIR_CACHE_SIZE && dir_cache[slot].trusted && dir_cache[slot].mtime == mtime) {
+			dir_cache[slot].used = ++dir_cache_clock;
+			dir_next = dir_cache[slot].names;
+			dir_end = dir_next + dir_cache[slot].len;
+			return TRUE;
+		}
+	}
+#endif
+	dir_next = dir_end = NULL;
 	dp = opendir(dir_path);
-	return dp != NULL;
+	if (dp == NULL)
+		return FALSE;
+	strcpy(dir_cache[slot].path, dir_path);
+	dir_cache[slot].mtime = mtime;
+	dir_cache[slot].trusted = trusted;
+	dir_cache[slot].len = 0;
+	dir_cache[slot].used = ++dir_cache_clock;
+	while ((entry = readdir(dp)) != NULL) {
+		size_t len = strlen(entry->d_name) + 1;
+		if (dir_cache[slot].len + len > dir_cache[slot].alloc) {
+			dir_cache[slot].alloc = (dir_cache[slot].len + len) * 2;
+			dir_cache[slot].names = (char *) Util_realloc(dir_cache[slot].names, dir_cache[slot].alloc);
+		}
+		memcpy(dir_cache[slot].names + dir_cache[slot].len, entry->d_name, len);
+		dir_cache[slot].len += len;
+	}
+	closedir(dp);
+	dir_next = dir_cache[slot].names;
+	dir_end = dir_next + dir_cache[slot].len;
+	return TRUE;
 }
 
 static int Devices_ReadDir(char *fullpath, char *filename, int *isdir,
                           int *readonly, int *size, char *timetext)
 {
-	struct dirent *entry;
+	const char *name;
 	char temppath[FILENAME_MAX];
 #ifdef HAVE_STAT
 	struct stat status;
 #endif
 	for (;;) {
-		entry = readdir(dp);
-		if (entry == NULL) {
-			closedir(dp);
-			dp = NULL;
+		if (dir_next == dir_end)
 			return FALSE;
-		}
-		if (entry->d_name[0] == '.') {
+		name = dir_next;
+		dir_next += strlen(name) + 1;
+		if (name[0] == '.') {
 			/* don't match Unix hidden files unless specifically requested */
 			if (filename_pattern[0] != '.')
 				continue;
 			/* never match "." */
-			if (entry->d_name[1] == '\0')
+			if (name[1] == '\0')
 				continue;
 			/* never match ".." */
-			if (entry->d_name[1] == '.' && entry->d_name[2] == '\0')
+			if (name[1] == '.' && name[2] == '\0')
 				continue;
 		}
-		if (match(filename_pattern, entry->d_name))
+		if (match(filename_pattern, name))
 			break;
 	}
 	if (filename != NULL)
-		strcpy(filename, entry->d_name);
-	Util_catpath(temppath, dir_path, entry->d_name);
+		strcpy(filename, name);
+	Util_catpath(temppath, dir_path, name);
 	if (fullpath != NULL)
 		strcpy(fullpath, temppath);
 #ifdef HAVE_STAT
@@ -149,9 +149,11 @@ void ESC_Run(UBYTE esc_code)
 #else /* CRASH_MENU */
 	CPU_cim_encountered = 1;
 	Log_print("Invalid ESC code %02x at address %04x", esc_code, CPU_regPC - 2);
-#if defined(LIBATARI800) && defined(HAVE_SETJMP)
-	longjmp(libatari800_cpu_crash, LIBATARI800_INVALID_ESCAPE_OPCODE);
-#endif /* LIBATARI800 && HAVE_SETJMP */
+#ifdef LIBATARI800
+	CPU_regPC -= 2;
+	CPU_Stop(LIBATARI800_INVALID_ESCAPE_OPCODE);
+	return;
+#endif /* LIBATARI800 */
 #ifndef __PLUS
 	if (!Atari800_Exit(TRUE))
 		exit(0);
@@ -30,6 +30,7 @@
 #include "cfg.h"
 #include "util.h"
 #include "log.h"
+#include "pokeysnd.h"
 
 #ifdef SCREENSHOTS
 #include "codecs/image.h"
@@ -37,6 +38,7 @@
 
 #if defined(AUDIO_RECORDING) || defined(VIDEO_RECORDING)
 #include "codecs/container.h"
+#include "codecs/encoder.h"
 
 #ifdef AUDIO_RECORDING
 #include "codecs/audio.h"
@@ -44,6 +46,7 @@
 
 #ifdef VIDEO_RECORDING
 #include "codecs/video.h"
+#include "codecs/container_a8f.h"
 #endif
 
 #endif /* defined(AUDIO_RECORDING) || defined(VIDEO_RECORDING) */
@@ -75,6 +78,13 @@ static int video_no_last = -1;
 static int video_no_max = 0;
 #endif /* VIDEO_RECORDING */
 
+/* Screens the encoder thread may fall behind by; 0 encodes in the
+   emulation thread */
+#define MAX_RECORD_QUEUE 64
+static int record_queue = 8;
+/* When it is that far behind, record repeats instead of waiting */
+static int record_drop_frames = FALSE;
+
 #endif /* defined(AUDIO_RECORDING) || defined(VIDEO_RECORDING) */
 
 
@@ -115,6 +125,28 @@ int File_Export_Initialise(int *argc, char *argv[])
 				video_no_max = Util_filenamepattern(argv[++i], video_filename_format, FILENAME_MAX, DEFAULT_VIDEO_FILENAME_FORMAT);
 			else a_m = TRUE;
 		}
+		else if (strcmp(argv[i], "-a8f-ram") == 0) {
+			if (i_a) {
+				A8F_ram_size = Util_sscandec(argv[++i]);
+				if (A8F_ram_size < 0 || A8F_ram_size > 65536)
+					a_i = TRUE;
+			}
+			else a_m = TRUE;
+		}
+#endif
+#if defined(AUDIO_RECORDING) || defined(VIDEO_RECORDING)
+		else if (strcmp(argv[i], "-record-queue") == 0) {
+			if (i_a) {
+				record_queue = Util_sscandec(argv[++i]);
+				if (record_queue < 0 || record_queue > MAX_RECORD_QUEUE)
+					a_i = TRUE;
+			}
+			else a_m = TRUE;
+		}
+		else if (strcmp(argv[i], "-record-drop-frames") == 0)
+			record_drop_frames = TRUE;
+		else if (strcmp(argv[i], "-no-record-drop-frames") == 0)
+			record_drop_frames = FALSE;
 #endif
 		else {
 			if (strcmp(argv[i], "-help") == 0) {
@@ -127,6 +159,18 @@ int File_Export_Initialise(int *argc, char *argv[])
 #endif
 #ifdef VIDEO_RECORDING
 				Log_print("\t-vname <p>       Set filename pattern for video recording");
+				Log_print("\t-a8f-ram <n>     Record the first n bytes of memory with each frame of");
+				Log_print("\t                 .a8f frame dumps (0-65536, default 0)");
+#endif
+#if defined(AUDIO_RECORDING) || defined(VIDEO_RECORDING)
+				Log_print("\t-record-queue <n>");
+				Log_print("\t                 Encode recordings on a separate thread, up to n frames behind");
+				Log_print("\t                 (0-%d, 0 encodes along with the emulation; default 8)", MAX_RECORD_QUEUE);
+				Log_print("\t-record-drop-frames");
+				Log_print("\t                 Record repeated frames instead of waiting when the encoder");
+				Log_print("\t                 is that far behind");
+				Log_print("\t-no-record-drop-frames");
+				Log_print("\t                 Wait for the encoder, recording every frame (default)");
 #endif
 			}
 			argv[j++] = argv[i];
@@ -164,7 +208,27 @@ int File_Export_ReadConfig(char *string, char *ptr)
 		else return FALSE;
 	}
 #endif
+#if defined(AUDIO_RECORDING) || defined(VIDEO_RECORDING)
+	else if (strcmp(string, "RECORD_QUEUE") == 0) {
+		int num = Util_sscandec(ptr);
+		if (num >= 0 && num <= MAX_RECORD_QUEUE)
+			record_queue = num;
+		else return FALSE;
+	}
+	else if (strcmp(string, "RECORD_DROP_FRAMES") == 0) {
+		int num = Util_sscandec(ptr);
+		if (num == 0 || num == 1)
+			record_drop_frames = num;
+		else return FALSE;
+	}
+#endif
 #ifdef VIDEO_RECORDING
+	else if (strcmp(string, "A8F_RAM") == 0) {
+		int num = Util_sscandec(ptr);
+		if (num >= 0 && num <= 65536)
+			A8F_ram_size = num;
+		else return FALSE;
+	}
 	else if (CODECS_VIDEO_ReadConfig(string, ptr)) {
 	}
 #endif
@@ -181,7 +245,12 @@ void File_Export_WriteConfig(FILE *fp)
 #if defined(HAVE_LIBPNG) || defined(HAVE_LIBZ)
 	fprintf(fp, "COMPRESSION_LEVEL=%d\n", FILE_EXPORT_compression_level);
 #endif
+#if defined(AUDIO_RECORDING) || defined(VIDEO_RECORDING)
+	fprintf(fp, "RECORD_QUEUE=%d\n", record_queue);
+	fprintf(fp, "RECORD_DROP_FRAMES=%d\n", record_drop_frames);
+#endif
 #ifdef VIDEO_RECORDING
+	fprintf(fp, "A8F_RAM=%d\n", A8F_ram_size);
 	CODECS_VIDEO_WriteConfig(fp);
 #endif
 #ifdef AUDIO_RECORDING
@@ -250,7 +319,8 @@ int File_Export_IsRecording(void)
    */
 int File_Export_StopRecording(void)
 {
-	return CONTAINER_Close(TRUE);
+	/* The encoder thread writes out what is queued first */
+	return CONTAINER_Close(ENCODER_Stop());
 }
 
 /* File_Export_StartRecording will open a new multimedia file, the type of which
@@ -263,7 +333,15 @@ int File_Export_StartRecording(const char *filename)
 {
 	File_Export_StopRecording();
 
-	return CONTAINER_Open(filename);
+#ifdef AUDIO_RECORDING
+	/* Sound synthesis may be idle; the recording needs this frame's samples. */
+	POKEYSND_quiet = FALSE;
+#endif
+	if (!CONTAINER_Open(filename))
+		return FALSE;
+	if (record_queue > 0)
+		ENCODER_Start(record_queue, record_drop_frames);
+	return TRUE;
 }
 
 #ifdef AUDIO_RECORDING
@@ -296,8 +374,12 @@ int File_Export_WriteAudio(const UBYTE *samples, int num_samples)
 
 	if (!container) return 0;
 	if (!audio_codec || (audio_codec && !container->audio_frame)) return 1;
-	result = CONTAINER_AddAudioSamples(samples, num_samples);
+	if (ENCODER_IsRunning())
+		result = ENCODER_AddAudioSamples(samples, num_samples);
+	else
+		result = CONTAINER_AddAudioSamples(samples, num_samples);
 	if (!result) {
+		ENCODER_Stop();
 		CONTAINER_Close(FALSE);
 	}
 
@@ -320,6 +402,9 @@ int File_Export_GetNextVideoFile(char *buffer, int bufsize) {
    calling File_Export_WriteVideo again, but the audio and video functions may
    be called in either order.
 
+   With -record-queue, the screen is copied and queued for the encoder thread,
+   and a failure to encode or write it is reported by a later call.
+
    RETURNS: non-zero if successfully added the video frame to the file
    (indicating the size of the video frame in bytes) or 0 if failed when
    creating the video frame or adding it to the file. */
@@ -329,8 +414,12 @@ int File_Export_WriteVideo(void)
 
 	if (!container) return 0;
 	if (!video_codec || (video_codec && !container->video_frame)) return 1;
-	result = CONTAINER_AddVideoFrame();
+	if (ENCODER_IsRunning())
+		result = ENCODER_AddVideoFrame();
+	else
+		result = CONTAINER_AddVideoFrame((const UBYTE *) Screen_atari, NULL);
 	if (!result) {
+		ENCODER_Stop();
 		CONTAINER_Close(FALSE);
 	}
 
@@ -347,14 +436,39 @@ int File_Export_WriteVideo(void)
 int File_Export_GetRecordingStats(int *seconds, int *size, char **media_type)
 {
 	if (container) {
-		*seconds = (int)(video_frame_count / fps);
-		*size = byteswritten / 1024;
+		ULONG frames = video_frame_count;
+		ULONG bytes = byteswritten;
+		ULONG dropped;
+		int queued;
+		if (ENCODER_IsRunning())
+			ENCODER_GetStats(&frames, &bytes, &dropped, &queued);
+		*seconds = (int)(frames / fps);
+		*size = bytes / 1024;
 		*media_type = description;
 		return 1;
 	}
 	return 0;
 }
 
+/* File_Export_GetQueueStats gets the frames and audio blocks waiting for the
+   encoder thread and the video frames it has dropped, both 0 when encoding
+   is done in the emulation thread.
+
+   RETURNS: TRUE if a file is currently being written, FALSE if not
+   */
+int File_Export_GetQueueStats(int *queued, ULONG *dropped)
+{
+	*queued = 0;
+	*dropped = 0;
+	if (container) {
+		ULONG frames, bytes;
+		if (ENCODER_IsRunning())
+			ENCODER_GetStats(&frames, &bytes, dropped, queued);
+		return 1;
+	}
+	return 0;
+}
+
 #endif /* defined(AUDIO_RECORDING) || defined(VIDEO_RECORDING) */
 
 #ifdef SCREENSHOTS
@@ -378,19 +492,23 @@ int File_Export_SaveScreen(const char *filename, UBYTE *ptr1, UBYTE *ptr2) {
 	FILE *fp;
 
 	CODECS_IMAGE_Init(filename);
-	fprintf(stderr, "File_Export_SaveScreen: codec=%p ptr1=%p\n", (void*)image_codec, (void*)ptr1);
 	if (image_codec) {
 		fp = fopen(filename, "wb");
-		fprintf(stderr, "File_Export_SaveScreen: fopen(%s) = %p\n", filename, (void*)fp);
 		if (fp == NULL)
 			return 0;
 		result = image_codec->to_file(fp, ptr1, ptr2);
-		fprintf(stderr, "File_Export_SaveScreen: to_file returned %d\n", result);
 		fclose(fp);
-	} else {
-		fprintf(stderr, "File_Export_SaveScreen: No codec found!\n");
 	}
 	return result;
 }
 
+/* Saves the current emulated screen to memory instead of a file, for
+   screenshots sent elsewhere: TYPE is an image file extension, such as
+   "png". *data points to the image until the next call.
+
+   Returns: the size of the image, or 0 if the type is not supported. */
+int File_Export_SaveScreenToMemory(const char *type, UBYTE *ptr1, UBYTE *ptr2, const UBYTE **data) {
+	return CODECS_IMAGE_SaveToMemory(type, ptr1, ptr2, data);
+}
+
 #endif /*def SCREENSHOTS */
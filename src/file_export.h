@@ -36,11 +36,13 @@ int File_Export_WriteVideo(void);
 #endif
 
 int File_Export_GetRecordingStats(int *seconds, int *size, char **media_type);
+int File_Export_GetQueueStats(int *queued, ULONG *dropped);
 #endif /* defined(AUDIO_RECORDING) || defined(VIDEO_RECORDING) */
 
 #ifdef SCREENSHOTS
 int File_Export_ImageTypeSupported(const char *id);
 int File_Export_SaveScreen(const char *filename, UBYTE *ptr1, UBYTE *ptr2);
+int File_Export_SaveScreenToMemory(const char *type, UBYTE *ptr1, UBYTE *ptr2, const UBYTE **data);
 #endif
 
 #endif /* FILE_EXPORT_H_ */
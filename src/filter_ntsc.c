@@ -20,8 +20,16 @@
  * along with Atari800; if not, write to the Free Software
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  */
+#include "config.h"
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
+#ifdef HAVE_PTHREAD_CREATE
+#include <pthread.h>
+#endif
+#if defined(HAVE_SYSCONF) && defined(HAVE_UNISTD_H)
+#include <unistd.h>
+#endif
 
 #include "filter_ntsc.h"
 
@@ -50,6 +58,183 @@ static char const * const preset_cfg_strings[FILTER_NTSC_PRESET_SIZE] = {
 
 atari_ntsc_t *FILTER_NTSC_emu = NULL;
 
+int FILTER_NTSC_threads = 0;
+
+#ifdef HAVE_PTHREAD_CREATE
+/* Most threads a blit is split across, the caller included */
+#define MAX_THREADS 8
+/* Fewest input rows worth handing to a thread */
+#define MIN_BAND_ROWS 16
+
+/* The blit being run. Band 0 is done by the caller, band i by worker i. */
+static struct {
+	FILTER_NTSC_BlitFunc func;
+	atari_ntsc_t const *filter;
+	ATARI_NTSC_IN_T const *input;
+	long in_row_width;
+	int in_width;
+	int in_height;
+	void *rgb_out;
+	long out_pitch;
+	int bands;
+} job;
+
+static pthread_t workers[MAX_THREADS - 1];
+static int num_workers = 0;
+static int pool_failed = FALSE;
+static int pool_stop = FALSE;
+/* Goes up with every blit handed to the workers */
+static unsigned int job_generation = 0;
+/* job_generation when the running workers were started */
+static unsigned int start_generation = 0;
+static int bands_pending = 0;
+static pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t job_ready = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t job_done = PTHREAD_COND_INITIALIZER;
+
+/* Rows are filtered independently of each other, so a band of rows
+   gives the same pixels as the whole frame would. */
+static void blit_band(int band)
+{
+	int first = job.in_height * band / job.bands;
+	int last = job.in_height * (band + 1) / job.bands;
+	if (last > first)
+		job.func(job.filter, job.input + job.in_row_width * first, job.in_row_width,
+		         job.in_width, last - first,
+		         (char *) job.rgb_out + job.out_pitch * first, job.out_pitch);
+}
+
+static void *worker_main(void *arg)
+{
+	int band = (int) (long) arg;
+	unsigned int seen = start_generation;
+	for (;;) {
+		int run;
+		pthread_mutex_lock(&pool_lock);
+		while (job_generation == seen && !pool_stop)
+			pthread_cond_wait(&job_ready, &pool_lock);
+		if (pool_stop) {
+			pthread_mutex_unlock(&pool_lock);
+			return NULL;
+		}
+		seen = job_generation;
+		run = band < job.bands;
+		pthread_mutex_unlock(&pool_lock);
+
+		if (run) {
+			blit_band(band);
+			pthread_mutex_lock(&pool_lock);
+			if (--bands_pending == 0)
+				pthread_cond_signal(&job_done);
+			pthread_mutex_unlock(&pool_lock);
+		}
+	}
+}
+
+/* Threads to split a blit across, the caller included */
+static int pool_size(void)
+{
+	int n = FILTER_NTSC_threads;
+#if defined(HAVE_SYSCONF) && defined(_SC_NPROCESSORS_ONLN)
+	if (n <= 0)
+		n = (int) sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+	if (n <= 0)
+		n = 1;
+	if (n > MAX_THREADS)
+		n = MAX_THREADS;
+	return n;
+}
+
+/* Start the workers on the first blit; FALSE leaves blits on the caller */
+static int start_pool(void)
+{
+	int n;
+	if (num_workers > 0)
+		return TRUE;
+	if (pool_failed)
+		return FALSE;
+	n = pool_size();
+	if (n == 1)
+		return FALSE;
+	pool_stop = FALSE;
+	start_generation = job_generation;
+	while (num_workers < n - 1) {
+		if (pthread_create(&workers[num_workers], NULL, worker_main, (void *) (long) (num_workers + 1)) != 0)
+			break;
+		num_workers++;
+	}
+	if (num_workers == 0) {
+		Log_print("Cannot start the NTSC filter threads, filtering on one thread");
+		pool_failed = TRUE;
+		return FALSE;
+	}
+	return TRUE;
+}
+
+static void stop_pool(void)
+{
+	int i;
+	pthread_mutex_lock(&pool_lock);
+	pool_stop = TRUE;
+	pthread_cond_broadcast(&job_ready);
+	pthread_mutex_unlock(&pool_lock);
+	for (i = 0; i < num_workers; i++)
+		pthread_join(workers[i], NULL);
+	num_workers = 0;
+}
+#endif /* HAVE_PTHREAD_CREATE */
+
+void FILTER_NTSC_Blit(FILTER_NTSC_BlitFunc func, atari_ntsc_t const *filter,
+                      ATARI_NTSC_IN_T const *input, long in_row_width,
+                      int in_width, int in_height, void *rgb_out, long out_pitch)
+{
+#ifdef HAVE_PTHREAD_CREATE
+	int bands;
+	if (FILTER_NTSC_threads != 1 && start_pool()) {
+		bands = in_height / MIN_BAND_ROWS;
+		if (bands > num_workers + 1)
+			bands = num_workers + 1;
+		if (bands > 1) {
+			pthread_mutex_lock(&pool_lock);
+			job.func = func;
+			job.filter = filter;
+			job.input = input;
+			job.in_row_width = in_row_width;
+			job.in_width = in_width;
+			job.in_height = in_height;
+			job.rgb_out = rgb_out;
+			job.out_pitch = out_pitch;
+			job.bands = bands;
+			bands_pending = bands - 1;
+			job_generation++;
+			pthread_cond_broadcast(&job_ready);
+			pthread_mutex_unlock(&pool_lock);
+
+			blit_band(0);
+
+			pthread_mutex_lock(&pool_lock);
+			while (bands_pending > 0)
+				pthread_cond_wait(&job_done, &pool_lock);
+			pthread_mutex_unlock(&pool_lock);
+			return;
+		}
+	}
+#endif
+	func(filter, input, in_row_width, in_width, in_height, rgb_out, out_pitch);
+}
+
+/* What a filter's kernels are computed from, with the kernels last
+   computed. Turning the filter on again, or a palette update that leaves
+   the NTSC settings as they were, copies them instead of computing them. */
+static struct {
+	atari_ntsc_setup_t setup; /* yiq_palette left NULL */
+	double yiq_table[768];
+} last_key;
+static atari_ntsc_t *last_kernels = NULL;
+/* The filter that holds last_kernels already, if any */
+static atari_ntsc_t const *last_filter = NULL;
+
 atari_ntsc_t *FILTER_NTSC_New(void)
 {
 	atari_ntsc_t *filter = (atari_ntsc_t*) Util_malloc(sizeof(atari_ntsc_t));
@@ -58,6 +243,8 @@ atari_ntsc_t *FILTER_NTSC_New(void)
 
 void FILTER_NTSC_Delete(atari_ntsc_t *filter)
 {
+	if (filter == last_filter)
+		last_filter = NULL;
 	free(filter);
 }
 
@@ -89,8 +276,26 @@ void FILTER_NTSC_Update(atari_ntsc_t *filter)
 		FILTER_NTSC_setup.gamma = COLOURS_NTSC_setup.gamma;
 	}
 
+	FILTER_NTSC_setup.yiq_palette = NULL;
+	/* A palette_out would be written by atari_ntsc_init() */
+	if (FILTER_NTSC_setup.palette_out == NULL && last_kernels != NULL
+	    && memcmp(&last_key.setup, &FILTER_NTSC_setup, sizeof(atari_ntsc_setup_t)) == 0
+	    && memcmp(last_key.yiq_table, yiq_table, sizeof(yiq_table)) == 0) {
+		FILTER_NTSC_setup.yiq_palette = yiq_table;
+		if (filter != last_filter)
+			memcpy(filter, last_kernels, sizeof(atari_ntsc_t));
+		last_filter = filter;
+		return;
+	}
+	memcpy(&last_key.setup, &FILTER_NTSC_setup, sizeof(atari_ntsc_setup_t));
+	memcpy(last_key.yiq_table, yiq_table, sizeof(yiq_table));
+
 	FILTER_NTSC_setup.yiq_palette = yiq_table;
 	atari_ntsc_init(filter, &FILTER_NTSC_setup);
+	if (last_kernels == NULL)
+		last_kernels = (atari_ntsc_t*) Util_malloc(sizeof(atari_ntsc_t));
+	memcpy(last_kernels, filter, sizeof(atari_ntsc_t));
+	last_filter = filter;
 }
 
 void FILTER_NTSC_RestoreDefaults(void)
@@ -164,6 +369,8 @@ int FILTER_NTSC_ReadConfig(char *option, char *ptr)
 		return Util_sscandouble(ptr, &FILTER_NTSC_setup.bleed);
 	else if (strcmp(option, "FILTER_NTSC_BURST_PHASE") == 0)
 		return Util_sscandouble(ptr, &FILTER_NTSC_setup.burst_phase);
+	else if (strcmp(option, "FILTER_NTSC_THREADS") == 0)
+		return (FILTER_NTSC_threads = Util_sscandec(ptr)) >= 0;
 	else
 		return FALSE;
 }
@@ -176,6 +383,7 @@ void FILTER_NTSC_WriteConfig(FILE *fp)
 	fprintf(fp, "FILTER_NTSC_FRINGING=%g\n", FILTER_NTSC_setup.fringing);
 	fprintf(fp, "FILTER_NTSC_BLEED=%g\n", FILTER_NTSC_setup.bleed);
 	fprintf(fp, "FILTER_NTSC_BURST_PHASE=%g\n", FILTER_NTSC_setup.burst_phase);
+	fprintf(fp, "FILTER_NTSC_THREADS=%d\n", FILTER_NTSC_threads);
 }
 
 int FILTER_NTSC_Initialise(int *argc, char *argv[])
@@ -217,6 +425,15 @@ int FILTER_NTSC_Initialise(int *argc, char *argv[])
 				FILTER_NTSC_setup.burst_phase = atof(argv[++i]);
 			else a_m = TRUE;
 		}
+		else if (strcmp(argv[i], "-ntsc-threads") == 0) {
+			if (i_a) {
+				FILTER_NTSC_threads = Util_sscandec(argv[++i]);
+				if (FILTER_NTSC_threads < 0) {
+					Log_print("Invalid value for -ntsc-threads");
+					return FALSE;
+				}
+			} else a_m = TRUE;
+		}
 		else if (strcmp(argv[i], "-ntsc-filter-preset") == 0) {
 			if (i_a) {
 				int idx = CFG_MatchTextParameter(argv[++i], preset_cfg_strings, FILTER_NTSC_PRESET_SIZE);
@@ -237,6 +454,7 @@ int FILTER_NTSC_Initialise(int *argc, char *argv[])
 				Log_print("\t-ntsc-burstphase <n>  Set burst phase (artifact colours) for NTSC filter (default %.2g)", FILTER_NTSC_setup.burst_phase);
 				Log_print("\t-ntsc-filter-preset composite|svideo|rgb|monochrome");
 				Log_print("\t                      Use one of predefined NTSC filter adjustments");
+				Log_print("\t-ntsc-threads <n>     Split NTSC filtering across n threads (0: one per core)");
 			}
 			argv[j++] = argv[i];
 		}
@@ -250,3 +468,13 @@ int FILTER_NTSC_Initialise(int *argc, char *argv[])
 
 	return TRUE;
 }
+
+void FILTER_NTSC_Exit(void)
+{
+#ifdef HAVE_PTHREAD_CREATE
+	stop_pool();
+#endif
+	free(last_kernels);
+	last_kernels = NULL;
+	last_filter = NULL;
+}
@@ -24,6 +24,21 @@ extern atari_ntsc_setup_t FILTER_NTSC_setup;
    returned by FILTER_NTSC_New(). */
 extern atari_ntsc_t *FILTER_NTSC_emu;
 
+/* Threads FILTER_NTSC_Blit splits a frame across, the calling thread
+   included; 0 means one per core. */
+extern int FILTER_NTSC_threads;
+
+/* One of the atari_ntsc_blit_* functions. */
+typedef void (*FILTER_NTSC_BlitFunc)(atari_ntsc_t const *ntsc, ATARI_NTSC_IN_T const *atari_in,
+                                     long in_row_width, int in_width, int in_height,
+                                     void *rgb_out, long out_pitch);
+/* Runs FUNC, an atari_ntsc_blit_* function taking the same arguments, in
+   horizontal bands on a pool of worker threads started on the first call.
+   Returns when the whole frame is written. */
+void FILTER_NTSC_Blit(FILTER_NTSC_BlitFunc func, atari_ntsc_t const *filter,
+                      ATARI_NTSC_IN_T const *input, long in_row_width,
+                      int in_width, int in_height, void *rgb_out, long out_pitch);
+
 /* Allocates memory for a new NTSC filter. */
 atari_ntsc_t *FILTER_NTSC_New(void);
 /* Frees memory used by an NTSC filter, FILTER. */
@@ -60,5 +75,7 @@ void FILTER_NTSC_WriteConfig(FILE *fp);
 
 /* NTSC filter initialisation and processing of command-line arguments. */
 int FILTER_NTSC_Initialise(int *argc, char *argv[]);
+/* Stops the FILTER_NTSC_Blit threads. */
+void FILTER_NTSC_Exit(void);
 
 #endif /* FILTER_NTSC_H_ */
@@ -0,0 +1,2406 @@
+/* Generated by tools/gen_cycle_map.c - do not edit. */
+
+int const CYCLE_MAP_cpu2antic[CYCLE_MAP_SIZE * (17 * 7 + 1)] = {
+	/* 0 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,29,30,31,33,
+	34,35,37,38,39,41,42,43,45,46,47,49,50,51,53,54,
+	55,57,58,59,61,62,63,64,65,66,67,68,69,70,71,72,
+	73,74,75,76,77,78,79,80,81,82,83,84,85,86,87,88,
+	89,90,91,92,93,94,95,96,97,98,99,100,101,102,103,104,
+	105,106,107,108,109,110,111,112,113,114,115,116,117,118,119,120,
+	121,122,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 1 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,30,95,96,97,
+	98,99,100,101,102,103,104,105,106,107,108,109,110,111,112,113,
+	114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 2 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,22,103,104,105,106,107,108,109,110,111,112,
+	113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 3 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,23,104,105,106,107,108,109,110,111,112,
+	113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 4 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,24,105,106,107,108,109,110,111,112,
+	113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 5 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,25,106,107,108,109,110,111,112,
+	113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 6 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,26,107,108,109,110,111,112,
+	113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 7 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,27,108,109,110,111,112,
+	113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 8 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,109,110,111,112,113,
+	114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 9 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,109,110,111,112,
+	113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 10 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,14,110,111,
+	112,113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 11 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,15,110,
+	111,112,113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 12 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,16,
+	110,111,112,113,114,115,116,117,118,119,120,121,122,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 13 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	17,110,111,112,113,114,115,116,117,118,119,120,121,122,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 14 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,18,110,111,112,113,114,115,116,117,118,119,120,121,122,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 15 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,19,110,111,112,113,114,115,116,117,118,119,120,121,122,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 16 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,20,110,111,112,113,114,115,116,117,118,119,120,121,
+	122,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 17 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,21,110,111,112,113,114,115,116,117,118,119,120,
+	121,122,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 18 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,29,30,31,35,
+	39,43,47,51,55,59,63,65,67,69,71,73,75,77,79,81,
+	83,85,87,89,91,93,95,96,97,98,99,100,101,102,103,104,
+	105,106,107,108,109,110,111,112,113,114,115,116,117,118,119,120,
+	121,122,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 19 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,25,27,31,35,39,43,47,51,
+	55,59,63,65,67,69,71,73,75,77,79,81,83,85,87,89,
+	91,93,95,97,99,101,103,104,105,106,107,108,109,110,111,112,
+	113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 20 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,26,30,34,38,42,46,50,
+	54,58,62,64,66,68,70,72,74,76,78,80,82,84,86,88,
+	90,92,94,96,98,100,102,104,105,106,107,108,109,110,111,112,
+	113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 21 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,27,31,35,39,43,47,
+	51,55,59,63,65,67,69,71,73,75,77,79,81,83,85,87,
+	89,91,93,95,97,99,101,103,105,106,107,108,109,110,111,112,
+	113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 22 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,30,34,38,42,46,
+	50,54,58,62,64,66,68,70,72,74,76,78,80,82,84,86,
+	88,90,92,94,96,98,100,102,104,106,107,108,109,110,111,112,
+	113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 23 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,31,35,39,43,
+	47,51,55,59,63,65,67,69,71,73,75,77,79,81,83,85,
+	87,89,91,93,95,97,99,101,103,105,107,108,109,110,111,112,
+	113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 24 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,30,34,38,42,
+	46,50,54,58,62,64,66,68,70,72,74,76,78,80,82,84,
+	86,88,90,92,94,96,98,100,102,104,106,108,109,110,111,112,
+	113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 25 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,29,31,35,39,
+	43,47,51,55,59,63,65,67,69,71,73,75,77,79,81,83,
+	85,87,89,91,93,95,97,99,101,103,105,107,109,110,111,112,
+	113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 26 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,29,30,34,38,
+	42,46,50,54,58,62,64,66,68,70,72,74,76,78,80,82,
+	84,86,88,90,92,94,96,98,100,102,104,106,108,109,110,111,
+	112,113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 27 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	17,19,21,23,25,27,31,35,39,43,47,51,55,59,63,65,
+	67,69,71,73,75,77,79,81,83,85,87,89,91,93,95,97,
+	99,101,103,105,107,109,110,111,112,113,114,115,116,117,118,119,
+	120,121,122,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 28 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,18,20,22,24,26,30,34,38,42,46,50,54,58,62,64,
+	66,68,70,72,74,76,78,80,82,84,86,88,90,92,94,96,
+	98,100,102,104,106,108,109,110,111,112,113,114,115,116,117,118,
+	119,120,121,122,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 29 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,19,21,23,25,27,31,35,39,43,47,51,55,59,63,
+	65,67,69,71,73,75,77,79,81,83,85,87,89,91,93,95,
+	97,99,101,103,105,107,109,110,111,112,113,114,115,116,117,118,
+	119,120,121,122,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 30 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,20,22,24,26,30,34,38,42,46,50,54,58,62,
+	64,66,68,70,72,74,76,78,80,82,84,86,88,90,92,94,
+	96,98,100,102,104,106,108,109,110,111,112,113,114,115,116,117,
+	118,119,120,121,122,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 31 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,21,23,25,27,31,35,39,43,47,51,55,59,
+	63,65,67,69,71,73,75,77,79,81,83,85,87,89,91,93,
+	95,97,99,101,103,105,107,109,110,111,112,113,114,115,116,117,
+	118,119,120,121,122,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 32 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,22,24,26,30,34,38,42,46,50,54,58,
+	62,64,66,68,70,72,74,76,78,80,82,84,86,88,90,92,
+	94,96,98,100,102,104,106,108,109,110,111,112,113,114,115,116,
+	117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 33 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,23,25,27,31,35,39,43,47,51,55,
+	59,63,65,67,69,71,73,75,77,79,81,83,85,87,89,91,
+	93,95,97,99,101,103,105,107,109,110,111,112,113,114,115,116,
+	117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 34 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,24,26,30,34,38,42,46,50,54,
+	58,62,64,66,68,70,72,74,76,78,80,82,84,86,88,90,
+	92,94,96,98,100,102,104,106,108,109,110,111,112,113,114,115,
+	116,117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 35 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,30,31,35,39,
+	43,47,51,55,59,63,66,67,70,71,74,75,78,79,82,83,
+	86,87,90,91,93,94,95,96,97,98,99,100,101,102,103,104,
+	105,106,107,108,109,110,111,112,113,114,115,116,117,118,119,120,
+	121,122,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 36 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,22,23,26,27,31,35,39,43,47,51,55,
+	59,63,66,67,70,71,74,75,78,79,82,83,86,87,90,91,
+	94,95,98,99,101,102,103,104,105,106,107,108,109,110,111,112,
+	113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 37 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,23,24,27,31,35,39,43,47,51,55,
+	59,63,64,67,68,71,72,75,76,79,80,83,84,87,88,91,
+	92,95,96,99,100,102,103,104,105,106,107,108,109,110,111,112,
+	113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 38 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,24,25,29,33,37,41,45,49,53,
+	57,61,64,65,68,69,72,73,76,77,80,81,84,85,88,89,
+	92,93,96,97,100,101,103,104,105,106,107,108,109,110,111,112,
+	113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 39 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,25,26,30,34,38,42,46,50,
+	54,58,62,65,66,69,70,73,74,77,78,81,82,85,86,89,
+	90,93,94,97,98,101,102,104,105,106,107,108,109,110,111,112,
+	113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 40 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,26,27,31,35,39,43,47,
+	51,55,59,63,66,67,70,71,74,75,78,79,82,83,86,87,
+	90,91,94,95,98,99,102,103,105,106,107,108,109,110,111,112,
+	113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 41 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,27,31,35,39,43,47,
+	51,55,59,63,64,67,68,71,72,75,76,79,80,83,84,87,
+	88,91,92,95,96,99,100,103,104,106,107,108,109,110,111,112,
+	113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 42 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,29,33,37,41,45,
+	49,53,57,61,64,65,68,69,72,73,76,77,80,81,84,85,
+	88,89,92,93,96,97,100,101,104,105,107,108,109,110,111,112,
+	113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 43 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,30,34,38,42,
+	46,50,54,58,62,65,66,69,70,73,74,77,78,81,82,85,
+	86,89,90,93,94,97,98,101,102,105,106,108,109,110,111,112,
+	113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 44 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,14,15,18,
+	19,22,23,26,27,31,35,39,43,47,51,55,59,63,66,67,
+	70,71,74,75,78,79,82,83,86,87,90,91,94,95,98,99,
+	102,103,106,107,109,110,111,112,113,114,115,116,117,118,119,120,
+	121,122,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 45 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,15,16,
+	19,20,23,24,27,31,35,39,43,47,51,55,59,63,64,67,
+	68,71,72,75,76,79,80,83,84,87,88,91,92,95,96,99,
+	100,103,104,107,108,109,110,111,112,113,114,115,116,117,118,119,
+	120,121,122,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 46 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,16,
+	17,20,21,24,25,29,33,37,41,45,49,53,57,61,64,65,
+	68,69,72,73,76,77,80,81,84,85,88,89,92,93,96,97,
+	100,101,104,105,108,109,110,111,112,113,114,115,116,117,118,119,
+	120,121,122,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 47 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	17,18,21,22,25,26,30,34,38,42,46,50,54,58,62,65,
+	66,69,70,73,74,77,78,81,82,85,86,89,90,93,94,97,
+	98,101,102,105,106,109,110,111,112,113,114,115,116,117,118,119,
+	120,121,122,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 48 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,18,19,22,23,26,27,31,35,39,43,47,51,55,59,63,
+	66,67,70,71,74,75,78,79,82,83,86,87,90,91,94,95,
+	98,99,102,103,106,107,109,110,111,112,113,114,115,116,117,118,
+	119,120,121,122,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 49 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,19,20,23,24,27,31,35,39,43,47,51,55,59,63,
+	64,67,68,71,72,75,76,79,80,83,84,87,88,91,92,95,
+	96,99,100,103,104,107,108,109,110,111,112,113,114,115,116,117,
+	118,119,120,121,122,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 50 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,20,21,24,25,29,33,37,41,45,49,53,57,61,
+	64,65,68,69,72,73,76,77,80,81,84,85,88,89,92,93,
+	96,97,100,101,104,105,108,109,110,111,112,113,114,115,116,117,
+	118,119,120,121,122,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 51 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,21,22,25,26,30,34,38,42,46,50,54,58,
+	62,65,66,69,70,73,74,77,78,81,82,85,86,89,90,93,
+	94,97,98,101,102,105,106,109,110,111,112,113,114,115,116,117,
+	118,119,120,121,122,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 52 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,29,30,31,34,
+	35,38,39,42,43,46,47,50,51,54,55,58,59,62,63,65,
+	66,67,69,70,71,73,74,75,77,78,79,81,82,83,85,86,
+	87,89,90,91,93,94,95,96,97,98,99,100,101,102,103,104,
+	105,106,107,108,109,110,111,112,113,114,115,116,117,118,119,120,
+	121,122,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 53 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,25,26,27,30,31,34,35,38,
+	39,42,43,46,47,50,51,54,55,58,59,62,63,65,66,67,
+	69,70,71,73,74,75,77,78,79,81,82,83,85,86,87,89,
+	90,91,93,94,95,97,98,99,101,102,103,104,105,106,107,108,
+	109,110,111,112,113,114,115,116,117,118,119,120,121,122,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 54 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,26,27,30,31,34,35,38,
+	39,42,43,46,47,50,51,54,55,58,59,62,63,64,66,67,
+	68,70,71,72,74,75,76,78,79,80,82,83,84,86,87,88,
+	90,91,92,94,95,96,98,99,100,102,103,104,105,106,107,108,
+	109,110,111,112,113,114,115,116,117,118,119,120,121,122,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 55 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,27,29,31,33,35,37,
+	39,41,43,45,47,49,51,53,55,57,59,61,63,64,65,67,
+	68,69,71,72,73,75,76,77,79,80,81,83,84,85,87,88,
+	89,91,92,93,95,96,97,99,100,101,103,104,105,106,107,108,
+	109,110,111,112,113,114,115,116,117,118,119,120,121,122,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 56 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,29,30,33,34,37,
+	38,41,42,45,46,49,50,53,54,57,58,61,62,64,65,66,
+	68,69,70,72,73,74,76,77,78,80,81,82,84,85,86,88,
+	89,90,92,93,94,96,97,98,100,101,102,104,105,106,107,108,
+	109,110,111,112,113,114,115,116,117,118,119,120,121,122,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 57 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,30,31,34,35,
+	38,39,42,43,46,47,50,51,54,55,58,59,62,63,65,66,
+	67,69,70,71,73,74,75,77,78,79,81,82,83,85,86,87,
+	89,90,91,93,94,95,97,98,99,101,102,103,105,106,107,108,
+	109,110,111,112,113,114,115,116,117,118,119,120,121,122,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 58 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,30,31,34,35,
+	38,39,42,43,46,47,50,51,54,55,58,59,62,63,64,66,
+	67,68,70,71,72,74,75,76,78,79,80,82,83,84,86,87,
+	88,90,91,92,94,95,96,98,99,100,102,103,104,106,107,108,
+	109,110,111,112,113,114,115,116,117,118,119,120,121,122,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 59 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,29,31,33,35,
+	37,39,41,43,45,47,49,51,53,55,57,59,61,63,64,65,
+	67,68,69,71,72,73,75,76,77,79,80,81,83,84,85,87,
+	88,89,91,92,93,95,96,97,99,100,101,103,104,105,107,108,
+	109,110,111,112,113,114,115,116,117,118,119,120,121,122,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 60 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,29,30,33,34,
+	37,38,41,42,45,46,49,50,53,54,57,58,61,62,64,65,
+	66,68,69,70,72,73,74,76,77,78,80,81,82,84,85,86,
+	88,89,90,92,93,94,96,97,98,100,101,102,104,105,106,108,
+	109,110,111,112,113,114,115,116,117,118,119,120,121,122,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 61 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	17,18,19,21,22,23,25,26,27,30,31,34,35,38,39,42,
+	43,46,47,50,51,54,55,58,59,62,63,65,66,67,69,70,
+	71,73,74,75,77,78,79,81,82,83,85,86,87,89,90,91,
+	93,94,95,97,98,99,101,102,103,105,106,107,109,110,111,112,
+	113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 62 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,18,19,20,22,23,24,26,27,30,31,34,35,38,39,42,
+	43,46,47,50,51,54,55,58,59,62,63,64,66,67,68,70,
+	71,72,74,75,76,78,79,80,82,83,84,86,87,88,90,91,
+	92,94,95,96,98,99,100,102,103,104,106,107,108,109,110,111,
+	112,113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 63 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,19,20,21,23,24,25,27,29,31,33,35,37,39,41,
+	43,45,47,49,51,53,55,57,59,61,63,64,65,67,68,69,
+	71,72,73,75,76,77,79,80,81,83,84,85,87,88,89,91,
+	92,93,95,96,97,99,100,101,103,104,105,107,108,109,110,111,
+	112,113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 64 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,20,21,22,24,25,26,29,30,33,34,37,38,41,
+	42,45,46,49,50,53,54,57,58,61,62,64,65,66,68,69,
+	70,72,73,74,76,77,78,80,81,82,84,85,86,88,89,90,
+	92,93,94,96,97,98,100,101,102,104,105,106,108,109,110,111,
+	112,113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 65 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,21,22,23,25,26,27,30,31,34,35,38,39,
+	42,43,46,47,50,51,54,55,58,59,62,63,65,66,67,69,
+	70,71,73,74,75,77,78,79,81,82,83,85,86,87,89,90,
+	91,93,94,95,97,98,99,101,102,103,105,106,107,109,110,111,
+	112,113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 66 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,22,23,24,26,27,30,31,34,35,38,39,
+	42,43,46,47,50,51,54,55,58,59,62,63,64,66,67,68,
+	70,71,72,74,75,76,78,79,80,82,83,84,86,87,88,90,
+	91,92,94,95,96,98,99,100,102,103,104,106,107,108,109,110,
+	111,112,113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 67 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,23,24,25,27,29,31,33,35,37,39,
+	41,43,45,47,49,51,53,55,57,59,61,63,64,65,67,68,
+	69,71,72,73,75,76,77,79,80,81,83,84,85,87,88,89,
+	91,92,93,95,96,97,99,100,101,103,104,105,107,108,109,110,
+	111,112,113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 68 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,24,25,26,29,30,33,34,37,38,
+	41,42,45,46,49,50,53,54,57,58,61,62,64,65,66,68,
+	69,70,72,73,74,76,77,78,80,81,82,84,85,86,88,89,
+	90,92,93,94,96,97,98,100,101,102,104,105,106,108,109,110,
+	111,112,113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 69 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,29,30,34,38,
+	42,46,50,54,58,62,64,66,68,70,72,74,76,78,80,82,
+	84,86,88,90,92,94,95,96,97,98,99,100,101,102,103,104,
+	105,106,107,108,109,110,111,112,113,114,115,116,117,118,119,120,
+	121,122,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 70 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,24,26,30,34,38,42,46,50,54,
+	58,62,64,66,68,70,72,74,76,78,80,82,84,86,88,90,
+	92,94,96,98,100,102,103,104,105,106,107,108,109,110,111,112,
+	113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 71 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,25,27,31,35,39,43,47,51,
+	55,59,63,65,67,69,71,73,75,77,79,81,83,85,87,89,
+	91,93,95,97,99,101,103,104,105,106,107,108,109,110,111,112,
+	113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 72 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,26,30,34,38,42,46,50,
+	54,58,62,64,66,68,70,72,74,76,78,80,82,84,86,88,
+	90,92,94,96,98,100,102,104,105,106,107,108,109,110,111,112,
+	113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 73 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,27,31,35,39,43,47,
+	51,55,59,63,65,67,69,71,73,75,77,79,81,83,85,87,
+	89,91,93,95,97,99,101,103,105,106,107,108,109,110,111,112,
+	113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 74 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,30,34,38,42,46,
+	50,54,58,62,64,66,68,70,72,74,76,78,80,82,84,86,
+	88,90,92,94,96,98,100,102,104,106,107,108,109,110,111,112,
+	113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 75 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,31,35,39,43,
+	47,51,55,59,63,65,67,69,71,73,75,77,79,81,83,85,
+	87,89,91,93,95,97,99,101,103,105,107,108,109,110,111,112,
+	113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 76 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,30,34,38,42,
+	46,50,54,58,62,64,66,68,70,72,74,76,78,80,82,84,
+	86,88,90,92,94,96,98,100,102,104,106,108,109,110,111,112,
+	113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 77 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,29,31,35,39,
+	43,47,51,55,59,63,65,67,69,71,73,75,77,79,81,83,
+	85,87,89,91,93,95,97,99,101,103,105,107,109,110,111,112,
+	113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 78 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,16,
+	18,20,22,24,26,30,34,38,42,46,50,54,58,62,64,66,
+	68,70,72,74,76,78,80,82,84,86,88,90,92,94,96,98,
+	100,102,104,106,108,109,110,111,112,113,114,115,116,117,118,119,
+	120,121,122,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 79 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	17,19,21,23,25,27,31,35,39,43,47,51,55,59,63,65,
+	67,69,71,73,75,77,79,81,83,85,87,89,91,93,95,97,
+	99,101,103,105,107,109,110,111,112,113,114,115,116,117,118,119,
+	120,121,122,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 80 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,18,20,22,24,26,30,34,38,42,46,50,54,58,62,64,
+	66,68,70,72,74,76,78,80,82,84,86,88,90,92,94,96,
+	98,100,102,104,106,108,109,110,111,112,113,114,115,116,117,118,
+	119,120,121,122,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 81 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,19,21,23,25,27,31,35,39,43,47,51,55,59,63,
+	65,67,69,71,73,75,77,79,81,83,85,87,89,91,93,95,
+	97,99,101,103,105,107,109,110,111,112,113,114,115,116,117,118,
+	119,120,121,122,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 82 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,20,22,24,26,30,34,38,42,46,50,54,58,62,
+	64,66,68,70,72,74,76,78,80,82,84,86,88,90,92,94,
+	96,98,100,102,104,106,108,109,110,111,112,113,114,115,116,117,
+	118,119,120,121,122,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 83 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,21,23,25,27,31,35,39,43,47,51,55,59,
+	63,65,67,69,71,73,75,77,79,81,83,85,87,89,91,93,
+	95,97,99,101,103,105,107,109,110,111,112,113,114,115,116,117,
+	118,119,120,121,122,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 84 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,22,24,26,30,34,38,42,46,50,54,58,
+	62,64,66,68,70,72,74,76,78,80,82,84,86,88,90,92,
+	94,96,98,100,102,104,106,108,109,110,111,112,113,114,115,116,
+	117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 85 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,23,25,27,31,35,39,43,47,51,55,
+	59,63,65,67,69,71,73,75,77,79,81,83,85,87,89,91,
+	93,95,97,99,101,103,105,107,109,110,111,112,113,114,115,116,
+	117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 86 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,29,30,33,34,
+	37,38,41,42,45,46,49,50,53,54,57,58,61,62,64,65,
+	66,68,69,70,72,73,74,76,77,78,80,81,82,84,85,86,
+	88,89,90,92,93,94,95,96,97,98,99,100,101,102,103,104,
+	105,106,107,108,109,110,111,112,113,114,115,116,117,118,119,120,
+	121,122,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 87 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,24,25,26,29,30,33,34,37,38,
+	41,42,45,46,49,50,53,54,57,58,61,62,64,65,66,68,
+	69,70,72,73,74,76,77,78,80,81,82,84,85,86,88,89,
+	90,92,93,94,96,97,98,100,101,102,103,104,105,106,107,108,
+	109,110,111,112,113,114,115,116,117,118,119,120,121,122,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 88 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,25,26,27,30,31,34,35,38,
+	39,42,43,46,47,50,51,54,55,58,59,62,63,65,66,67,
+	69,70,71,73,74,75,77,78,79,81,82,83,85,86,87,89,
+	90,91,93,94,95,97,98,99,101,102,103,104,105,106,107,108,
+	109,110,111,112,113,114,115,116,117,118,119,120,121,122,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 89 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,26,27,30,31,34,35,38,
+	39,42,43,46,47,50,51,54,55,58,59,62,63,64,66,67,
+	68,70,71,72,74,75,76,78,79,80,82,83,84,86,87,88,
+	90,91,92,94,95,96,98,99,100,102,103,104,105,106,107,108,
+	109,110,111,112,113,114,115,116,117,118,119,120,121,122,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 90 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,27,29,31,33,35,37,
+	39,41,43,45,47,49,51,53,55,57,59,61,63,64,65,67,
+	68,69,71,72,73,75,76,77,79,80,81,83,84,85,87,88,
+	89,91,92,93,95,96,97,99,100,101,103,104,105,106,107,108,
+	109,110,111,112,113,114,115,116,117,118,119,120,121,122,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 91 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,29,30,33,34,37,
+	38,41,42,45,46,49,50,53,54,57,58,61,62,64,65,66,
+	68,69,70,72,73,74,76,77,78,80,81,82,84,85,86,88,
+	89,90,92,93,94,96,97,98,100,101,102,104,105,106,107,108,
+	109,110,111,112,113,114,115,116,117,118,119,120,121,122,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 92 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,30,31,34,35,
+	38,39,42,43,46,47,50,51,54,55,58,59,62,63,65,66,
+	67,69,70,71,73,74,75,77,78,79,81,82,83,85,86,87,
+	89,90,91,93,94,95,97,98,99,101,102,103,105,106,107,108,
+	109,110,111,112,113,114,115,116,117,118,119,120,121,122,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 93 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,30,31,34,35,
+	38,39,42,43,46,47,50,51,54,55,58,59,62,63,64,66,
+	67,68,70,71,72,74,75,76,78,79,80,82,83,84,86,87,
+	88,90,91,92,94,95,96,98,99,100,102,103,104,106,107,108,
+	109,110,111,112,113,114,115,116,117,118,119,120,121,122,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 94 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,29,31,33,35,
+	37,39,41,43,45,47,49,51,53,55,57,59,61,63,64,65,
+	67,68,69,71,72,73,75,76,77,79,80,81,83,84,85,87,
+	88,89,91,92,93,95,96,97,99,100,101,103,104,105,107,108,
+	109,110,111,112,113,114,115,116,117,118,119,120,121,122,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 95 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,16,
+	17,18,20,21,22,24,25,26,29,30,33,34,37,38,41,42,
+	45,46,49,50,53,54,57,58,61,62,64,65,66,68,69,70,
+	72,73,74,76,77,78,80,81,82,84,85,86,88,89,90,92,
+	93,94,96,97,98,100,101,102,104,105,106,108,109,110,111,112,
+	113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 96 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	17,18,19,21,22,23,25,26,27,30,31,34,35,38,39,42,
+	43,46,47,50,51,54,55,58,59,62,63,65,66,67,69,70,
+	71,73,74,75,77,78,79,81,82,83,85,86,87,89,90,91,
+	93,94,95,97,98,99,101,102,103,105,106,107,109,110,111,112,
+	113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 97 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,18,19,20,22,23,24,26,27,30,31,34,35,38,39,42,
+	43,46,47,50,51,54,55,58,59,62,63,64,66,67,68,70,
+	71,72,74,75,76,78,79,80,82,83,84,86,87,88,90,91,
+	92,94,95,96,98,99,100,102,103,104,106,107,108,109,110,111,
+	112,113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 98 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,19,20,21,23,24,25,27,29,31,33,35,37,39,41,
+	43,45,47,49,51,53,55,57,59,61,63,64,65,67,68,69,
+	71,72,73,75,76,77,79,80,81,83,84,85,87,88,89,91,
+	92,93,95,96,97,99,100,101,103,104,105,107,108,109,110,111,
+	112,113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 99 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,20,21,22,24,25,26,29,30,33,34,37,38,41,
+	42,45,46,49,50,53,54,57,58,61,62,64,65,66,68,69,
+	70,72,73,74,76,77,78,80,81,82,84,85,86,88,89,90,
+	92,93,94,96,97,98,100,101,102,104,105,106,108,109,110,111,
+	112,113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 100 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,21,22,23,25,26,27,30,31,34,35,38,39,
+	42,43,46,47,50,51,54,55,58,59,62,63,65,66,67,69,
+	70,71,73,74,75,77,78,79,81,82,83,85,86,87,89,90,
+	91,93,94,95,97,98,99,101,102,103,105,106,107,109,110,111,
+	112,113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 101 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,22,23,24,26,27,30,31,34,35,38,39,
+	42,43,46,47,50,51,54,55,58,59,62,63,64,66,67,68,
+	70,71,72,74,75,76,78,79,80,82,83,84,86,87,88,90,
+	91,92,94,95,96,98,99,100,102,103,104,106,107,108,109,110,
+	111,112,113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 102 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,23,24,25,27,29,31,33,35,37,39,
+	41,43,45,47,49,51,53,55,57,59,61,63,64,65,67,68,
+	69,71,72,73,75,76,77,79,80,81,83,84,85,87,88,89,
+	91,92,93,95,96,97,99,100,101,103,104,105,107,108,109,110,
+	111,112,113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 103 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,29,30,33,34,
+	35,37,38,41,42,43,45,46,49,50,51,53,54,57,58,59,
+	61,62,64,65,66,67,68,69,70,72,73,74,75,76,77,78,
+	80,81,82,83,84,85,86,88,89,90,91,92,93,94,95,96,
+	97,98,99,100,101,102,103,104,105,106,107,108,109,110,111,112,
+	113,114,115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 104 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,24,25,26,27,29,30,33,34,35,
+	37,38,41,42,43,45,46,49,50,51,53,54,57,58,59,61,
+	62,64,65,66,67,68,69,70,72,73,74,75,76,77,78,80,
+	81,82,83,84,85,86,88,89,90,91,92,93,94,96,97,98,
+	99,100,101,102,103,104,105,106,107,108,109,110,111,112,113,114,
+	115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 105 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,25,26,27,29,30,31,34,35,
+	37,38,39,42,43,45,46,47,50,51,53,54,55,58,59,61,
+	62,63,65,66,67,68,69,70,71,73,74,75,76,77,78,79,
+	81,82,83,84,85,86,87,89,90,91,92,93,94,95,97,98,
+	99,100,101,102,103,104,105,106,107,108,109,110,111,112,113,114,
+	115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 106 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,26,27,29,30,31,34,35,
+	37,38,39,42,43,45,46,47,50,51,53,54,55,58,59,61,
+	62,63,64,66,67,68,69,70,71,72,74,75,76,77,78,79,
+	80,82,83,84,85,86,87,88,90,91,92,93,94,95,96,98,
+	99,100,101,102,103,104,105,106,107,108,109,110,111,112,113,114,
+	115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 107 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,27,29,30,31,33,35,
+	37,38,39,41,43,45,46,47,49,51,53,54,55,57,59,61,
+	62,63,64,65,67,68,69,70,71,72,73,75,76,77,78,79,
+	80,81,83,84,85,86,87,88,89,91,92,93,94,95,96,97,
+	99,100,101,102,103,104,105,106,107,108,109,110,111,112,113,114,
+	115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 108 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,29,30,31,33,34,
+	37,38,39,41,42,45,46,47,49,50,53,54,55,57,58,61,
+	62,63,64,65,66,68,69,70,71,72,73,74,76,77,78,79,
+	80,81,82,84,85,86,87,88,89,90,92,93,94,95,96,97,
+	98,100,101,102,103,104,105,106,107,108,109,110,111,112,113,114,
+	115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 109 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,30,31,33,34,
+	35,38,39,41,42,43,46,47,49,50,51,54,55,57,58,59,
+	62,63,64,65,66,67,69,70,71,72,73,74,75,77,78,79,
+	80,81,82,83,85,86,87,88,89,90,91,93,94,95,96,97,
+	98,99,101,102,103,104,105,106,107,108,109,110,111,112,113,114,
+	115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 110 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,30,31,33,34,
+	35,38,39,41,42,43,46,47,49,50,51,54,55,57,58,59,
+	62,63,64,65,66,67,68,70,71,72,73,74,75,76,78,79,
+	80,81,82,83,84,86,87,88,89,90,91,92,94,95,96,97,
+	98,99,100,102,103,104,105,106,107,108,109,110,111,112,113,114,
+	115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 111 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,29,31,33,34,
+	35,37,39,41,42,43,45,47,49,50,51,53,55,57,58,59,
+	61,63,64,65,66,67,68,69,71,72,73,74,75,76,77,79,
+	80,81,82,83,84,85,87,88,89,90,91,92,93,95,96,97,
+	98,99,100,101,103,104,105,106,107,108,109,110,111,112,113,114,
+	115,116,117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 112 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,16,
+	17,18,19,20,21,22,24,25,26,27,29,30,33,34,35,37,
+	38,41,42,43,45,46,49,50,51,53,54,57,58,59,61,62,
+	64,65,66,67,68,69,70,72,73,74,75,76,77,78,80,81,
+	82,83,84,85,86,88,89,90,91,92,93,94,96,97,98,99,
+	100,101,102,104,105,106,107,108,109,110,111,112,113,114,115,116,
+	117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 113 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	17,18,19,20,21,22,23,25,26,27,29,30,31,34,35,37,
+	38,39,42,43,45,46,47,50,51,53,54,55,58,59,61,62,
+	63,65,66,67,68,69,70,71,73,74,75,76,77,78,79,81,
+	82,83,84,85,86,87,89,90,91,92,93,94,95,97,98,99,
+	100,101,102,103,105,106,107,108,109,110,111,112,113,114,115,116,
+	117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 114 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,18,19,20,21,22,23,24,26,27,29,30,31,34,35,37,
+	38,39,42,43,45,46,47,50,51,53,54,55,58,59,61,62,
+	63,64,66,67,68,69,70,71,72,74,75,76,77,78,79,80,
+	82,83,84,85,86,87,88,90,91,92,93,94,95,96,98,99,
+	100,101,102,103,104,106,107,108,109,110,111,112,113,114,115,116,
+	117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 115 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,19,20,21,22,23,24,25,27,29,30,31,33,35,37,
+	38,39,41,43,45,46,47,49,51,53,54,55,57,59,61,62,
+	63,64,65,67,68,69,70,71,72,73,75,76,77,78,79,80,
+	81,83,84,85,86,87,88,89,91,92,93,94,95,96,97,99,
+	100,101,102,103,104,105,107,108,109,110,111,112,113,114,115,116,
+	117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 116 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,20,21,22,23,24,25,26,29,30,31,33,34,37,
+	38,39,41,42,45,46,47,49,50,53,54,55,57,58,61,62,
+	63,64,65,66,68,69,70,71,72,73,74,76,77,78,79,80,
+	81,82,84,85,86,87,88,89,90,92,93,94,95,96,97,98,
+	100,101,102,103,104,105,106,108,109,110,111,112,113,114,115,116,
+	117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 117 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,21,22,23,24,25,26,27,30,31,33,34,35,
+	38,39,41,42,43,46,47,49,50,51,54,55,57,58,59,62,
+	63,64,65,66,67,69,70,71,72,73,74,75,77,78,79,80,
+	81,82,83,85,86,87,88,89,90,91,93,94,95,96,97,98,
+	99,101,102,103,104,105,106,107,109,110,111,112,113,114,115,116,
+	117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 118 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,22,23,24,25,26,27,30,31,33,34,35,
+	38,39,41,42,43,46,47,49,50,51,54,55,57,58,59,62,
+	63,64,65,66,67,68,70,71,72,73,74,75,76,78,79,80,
+	81,82,83,84,86,87,88,89,90,91,92,94,95,96,97,98,
+	99,100,102,103,104,105,106,107,108,109,110,111,112,113,114,115,
+	116,117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+
+	/* 119 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,23,24,25,26,27,29,31,33,34,35,
+	37,39,41,42,43,45,47,49,50,51,53,55,57,58,59,61,
+	63,64,65,66,67,68,69,71,72,73,74,75,76,77,79,80,
+	81,82,83,84,85,87,88,89,90,91,92,93,95,96,97,98,
+	99,100,101,103,104,105,106,107,108,109,110,111,112,113,114,115,
+	116,117,118,119,120,121,122,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1
+};
+
+int const CYCLE_MAP_antic2cpu[CYCLE_MAP_SIZE * (17 * 7 + 1)] = {
+	/* 0 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,28,28,29,30,
+	31,31,32,33,34,34,35,36,37,37,38,39,40,40,41,42,
+	43,43,44,45,46,46,47,48,49,49,50,51,52,52,53,54,
+	55,56,57,58,59,60,61,62,63,64,65,66,67,68,69,70,
+	71,72,73,74,75,76,77,78,79,80,81,82,83,84,85,86,
+	87,88,89,90,91,92,93,94,95,96,97,98,99,100,101,102,
+	103,104,105,106,107,108,109,110,111,112,113,
+
+	/* 1 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,28,28,28,29,
+	29,29,29,29,29,29,29,29,29,29,29,29,29,29,29,29,
+	29,29,29,29,29,29,29,29,29,29,29,29,29,29,29,29,
+	29,29,29,29,29,29,29,29,29,29,29,29,29,29,29,29,
+	29,29,29,29,29,29,29,29,29,29,29,29,29,29,29,29,
+	30,31,32,33,34,35,36,37,38,39,40,41,42,43,44,45,
+	46,47,48,49,50,51,52,53,54,55,56,
+
+	/* 2 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,21,22,22,22,22,22,22,22,22,22,
+	22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,
+	22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,
+	22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,
+	22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,
+	22,22,22,22,22,22,22,22,23,24,25,26,27,28,29,30,
+	31,32,33,34,35,36,37,38,39,40,41,
+
+	/* 3 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,22,23,23,23,23,23,23,23,23,
+	23,23,23,23,23,23,23,23,23,23,23,23,23,23,23,23,
+	23,23,23,23,23,23,23,23,23,23,23,23,23,23,23,23,
+	23,23,23,23,23,23,23,23,23,23,23,23,23,23,23,23,
+	23,23,23,23,23,23,23,23,23,23,23,23,23,23,23,23,
+	23,23,23,23,23,23,23,23,23,24,25,26,27,28,29,30,
+	31,32,33,34,35,36,37,38,39,40,41,
+
+	/* 4 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,23,24,24,24,24,24,24,24,
+	24,24,24,24,24,24,24,24,24,24,24,24,24,24,24,24,
+	24,24,24,24,24,24,24,24,24,24,24,24,24,24,24,24,
+	24,24,24,24,24,24,24,24,24,24,24,24,24,24,24,24,
+	24,24,24,24,24,24,24,24,24,24,24,24,24,24,24,24,
+	24,24,24,24,24,24,24,24,24,24,25,26,27,28,29,30,
+	31,32,33,34,35,36,37,38,39,40,41,
+
+	/* 5 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,24,25,25,25,25,25,25,
+	25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,
+	25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,
+	25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,
+	25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,
+	25,25,25,25,25,25,25,25,25,25,25,26,27,28,29,30,
+	31,32,33,34,35,36,37,38,39,40,41,
+
+	/* 6 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,25,26,26,26,26,26,
+	26,26,26,26,26,26,26,26,26,26,26,26,26,26,26,26,
+	26,26,26,26,26,26,26,26,26,26,26,26,26,26,26,26,
+	26,26,26,26,26,26,26,26,26,26,26,26,26,26,26,26,
+	26,26,26,26,26,26,26,26,26,26,26,26,26,26,26,26,
+	26,26,26,26,26,26,26,26,26,26,26,26,27,28,29,30,
+	31,32,33,34,35,36,37,38,39,40,41,
+
+	/* 7 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,26,27,27,27,27,
+	27,27,27,27,27,27,27,27,27,27,27,27,27,27,27,27,
+	27,27,27,27,27,27,27,27,27,27,27,27,27,27,27,27,
+	27,27,27,27,27,27,27,27,27,27,27,27,27,27,27,27,
+	27,27,27,27,27,27,27,27,27,27,27,27,27,27,27,27,
+	27,27,27,27,27,27,27,27,27,27,27,27,27,28,29,30,
+	31,32,33,34,35,36,37,38,39,40,41,
+
+	/* 8 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,27,27,27,27,
+	27,27,27,27,27,27,27,27,27,27,27,27,27,27,27,27,
+	27,27,27,27,27,27,27,27,27,27,27,27,27,27,27,27,
+	27,27,27,27,27,27,27,27,27,27,27,27,27,27,27,27,
+	27,27,27,27,27,27,27,27,27,27,27,27,27,27,27,27,
+	27,27,27,27,27,27,27,27,27,27,27,27,27,27,28,29,
+	30,31,32,33,34,35,36,37,38,39,40,
+
+	/* 9 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,28,28,28,28,
+	28,28,28,28,28,28,28,28,28,28,28,28,28,28,28,28,
+	28,28,28,28,28,28,28,28,28,28,28,28,28,28,28,28,
+	28,28,28,28,28,28,28,28,28,28,28,28,28,28,28,28,
+	28,28,28,28,28,28,28,28,28,28,28,28,28,28,28,28,
+	28,28,28,28,28,28,28,28,28,28,28,28,28,28,29,30,
+	31,32,33,34,35,36,37,38,39,40,41,
+
+	/* 10 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,13,14,
+	14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+	14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+	14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+	14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+	14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+	14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,
+
+	/* 11 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,14,
+	15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+	15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+	15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+	15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+	15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+	15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,16,
+	17,18,19,20,21,22,23,24,25,26,27,
+
+	/* 12 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	15,16,16,16,16,16,16,16,16,16,16,16,16,16,16,16,
+	16,16,16,16,16,16,16,16,16,16,16,16,16,16,16,16,
+	16,16,16,16,16,16,16,16,16,16,16,16,16,16,16,16,
+	16,16,16,16,16,16,16,16,16,16,16,16,16,16,16,16,
+	16,16,16,16,16,16,16,16,16,16,16,16,16,16,16,16,
+	16,16,16,16,16,16,16,16,16,16,16,16,16,16,16,17,
+	18,19,20,21,22,23,24,25,26,27,28,
+
+	/* 13 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,16,17,17,17,17,17,17,17,17,17,17,17,17,17,17,
+	17,17,17,17,17,17,17,17,17,17,17,17,17,17,17,17,
+	17,17,17,17,17,17,17,17,17,17,17,17,17,17,17,17,
+	17,17,17,17,17,17,17,17,17,17,17,17,17,17,17,17,
+	17,17,17,17,17,17,17,17,17,17,17,17,17,17,17,17,
+	17,17,17,17,17,17,17,17,17,17,17,17,17,17,17,18,
+	19,20,21,22,23,24,25,26,27,28,29,
+
+	/* 14 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,17,18,18,18,18,18,18,18,18,18,18,18,18,18,
+	18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,
+	18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,
+	18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,
+	18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,
+	18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,19,
+	20,21,22,23,24,25,26,27,28,29,30,
+
+	/* 15 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,18,19,19,19,19,19,19,19,19,19,19,19,19,
+	19,19,19,19,19,19,19,19,19,19,19,19,19,19,19,19,
+	19,19,19,19,19,19,19,19,19,19,19,19,19,19,19,19,
+	19,19,19,19,19,19,19,19,19,19,19,19,19,19,19,19,
+	19,19,19,19,19,19,19,19,19,19,19,19,19,19,19,19,
+	19,19,19,19,19,19,19,19,19,19,19,19,19,19,19,20,
+	21,22,23,24,25,26,27,28,29,30,31,
+
+	/* 16 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,19,20,20,20,20,20,20,20,20,20,20,20,
+	20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,
+	20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,
+	20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,
+	20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,
+	20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,21,
+	22,23,24,25,26,27,28,29,30,31,32,
+
+	/* 17 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,20,21,21,21,21,21,21,21,21,21,21,
+	21,21,21,21,21,21,21,21,21,21,21,21,21,21,21,21,
+	21,21,21,21,21,21,21,21,21,21,21,21,21,21,21,21,
+	21,21,21,21,21,21,21,21,21,21,21,21,21,21,21,21,
+	21,21,21,21,21,21,21,21,21,21,21,21,21,21,21,21,
+	21,21,21,21,21,21,21,21,21,21,21,21,21,21,21,22,
+	23,24,25,26,27,28,29,30,31,32,33,
+
+	/* 18 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,28,28,29,30,
+	31,31,31,31,32,32,32,32,33,33,33,33,34,34,34,34,
+	35,35,35,35,36,36,36,36,37,37,37,37,38,38,38,38,
+	39,39,40,40,41,41,42,42,43,43,44,44,45,45,46,46,
+	47,47,48,48,49,49,50,50,51,51,52,52,53,53,54,54,
+	55,56,57,58,59,60,61,62,63,64,65,66,67,68,69,70,
+	71,72,73,74,75,76,77,78,79,80,81,
+
+	/* 19 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,24,25,25,26,26,26,26,
+	27,27,27,27,28,28,28,28,29,29,29,29,30,30,30,30,
+	31,31,31,31,32,32,32,32,33,33,33,33,34,34,34,34,
+	35,35,36,36,37,37,38,38,39,39,40,40,41,41,42,42,
+	43,43,44,44,45,45,46,46,47,47,48,48,49,49,50,50,
+	51,51,52,52,53,53,54,54,55,56,57,58,59,60,61,62,
+	63,64,65,66,67,68,69,70,71,72,73,
+
+	/* 20 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,25,26,26,26,26,27,
+	27,27,27,28,28,28,28,29,29,29,29,30,30,30,30,31,
+	31,31,31,32,32,32,32,33,33,33,33,34,34,34,34,35,
+	35,36,36,37,37,38,38,39,39,40,40,41,41,42,42,43,
+	43,44,44,45,45,46,46,47,47,48,48,49,49,50,50,51,
+	51,52,52,53,53,54,54,55,55,56,57,58,59,60,61,62,
+	63,64,65,66,67,68,69,70,71,72,73,
+
+	/* 21 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,26,27,27,27,27,
+	28,28,28,28,29,29,29,29,30,30,30,30,31,31,31,31,
+	32,32,32,32,33,33,33,33,34,34,34,34,35,35,35,35,
+	36,36,37,37,38,38,39,39,40,40,41,41,42,42,43,43,
+	44,44,45,45,46,46,47,47,48,48,49,49,50,50,51,51,
+	52,52,53,53,54,54,55,55,56,56,57,58,59,60,61,62,
+	63,64,65,66,67,68,69,70,71,72,73,
+
+	/* 22 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,27,27,27,28,
+	28,28,28,29,29,29,29,30,30,30,30,31,31,31,31,32,
+	32,32,32,33,33,33,33,34,34,34,34,35,35,35,35,36,
+	36,37,37,38,38,39,39,40,40,41,41,42,42,43,43,44,
+	44,45,45,46,46,47,47,48,48,49,49,50,50,51,51,52,
+	52,53,53,54,54,55,55,56,56,57,57,58,59,60,61,62,
+	63,64,65,66,67,68,69,70,71,72,73,
+
+	/* 23 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,28,28,28,28,
+	29,29,29,29,30,30,30,30,31,31,31,31,32,32,32,32,
+	33,33,33,33,34,34,34,34,35,35,35,35,36,36,36,36,
+	37,37,38,38,39,39,40,40,41,41,42,42,43,43,44,44,
+	45,45,46,46,47,47,48,48,49,49,50,50,51,51,52,52,
+	53,53,54,54,55,55,56,56,57,57,58,58,59,60,61,62,
+	63,64,65,66,67,68,69,70,71,72,73,
+
+	/* 24 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,28,28,28,29,
+	29,29,29,30,30,30,30,31,31,31,31,32,32,32,32,33,
+	33,33,33,34,34,34,34,35,35,35,35,36,36,36,36,37,
+	37,38,38,39,39,40,40,41,41,42,42,43,43,44,44,45,
+	45,46,46,47,47,48,48,49,49,50,50,51,51,52,52,53,
+	53,54,54,55,55,56,56,57,57,58,58,59,59,60,61,62,
+	63,64,65,66,67,68,69,70,71,72,73,
+
+	/* 25 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,28,28,29,29,
+	30,30,30,30,31,31,31,31,32,32,32,32,33,33,33,33,
+	34,34,34,34,35,35,35,35,36,36,36,36,37,37,37,37,
+	38,38,39,39,40,40,41,41,42,42,43,43,44,44,45,45,
+	46,46,47,47,48,48,49,49,50,50,51,51,52,52,53,53,
+	54,54,55,55,56,56,57,57,58,58,59,59,60,60,61,62,
+	63,64,65,66,67,68,69,70,71,72,73,
+
+	/* 26 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,28,28,29,30,
+	30,30,30,31,31,31,31,32,32,32,32,33,33,33,33,34,
+	34,34,34,35,35,35,35,36,36,36,36,37,37,37,37,38,
+	38,39,39,40,40,41,41,42,42,43,43,44,44,45,45,46,
+	46,47,47,48,48,49,49,50,50,51,51,52,52,53,53,54,
+	54,55,55,56,56,57,57,58,58,59,59,60,60,61,62,63,
+	64,65,66,67,68,69,70,71,72,73,74,
+
+	/* 27 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,16,17,17,18,18,19,19,20,20,21,21,22,22,22,22,
+	23,23,23,23,24,24,24,24,25,25,25,25,26,26,26,26,
+	27,27,27,27,28,28,28,28,29,29,29,29,30,30,30,30,
+	31,31,32,32,33,33,34,34,35,35,36,36,37,37,38,38,
+	39,39,40,40,41,41,42,42,43,43,44,44,45,45,46,46,
+	47,47,48,48,49,49,50,50,51,51,52,52,53,53,54,55,
+	56,57,58,59,60,61,62,63,64,65,66,
+
+	/* 28 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,17,18,18,19,19,20,20,21,21,22,22,22,22,23,
+	23,23,23,24,24,24,24,25,25,25,25,26,26,26,26,27,
+	27,27,27,28,28,28,28,29,29,29,29,30,30,30,30,31,
+	31,32,32,33,33,34,34,35,35,36,36,37,37,38,38,39,
+	39,40,40,41,41,42,42,43,43,44,44,45,45,46,46,47,
+	47,48,48,49,49,50,50,51,51,52,52,53,53,54,55,56,
+	57,58,59,60,61,62,63,64,65,66,67,
+
+	/* 29 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,18,19,19,20,20,21,21,22,22,23,23,23,23,
+	24,24,24,24,25,25,25,25,26,26,26,26,27,27,27,27,
+	28,28,28,28,29,29,29,29,30,30,30,30,31,31,31,31,
+	32,32,33,33,34,34,35,35,36,36,37,37,38,38,39,39,
+	40,40,41,41,42,42,43,43,44,44,45,45,46,46,47,47,
+	48,48,49,49,50,50,51,51,52,52,53,53,54,54,55,56,
+	57,58,59,60,61,62,63,64,65,66,67,
+
+	/* 30 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,19,20,20,21,21,22,22,23,23,23,23,24,
+	24,24,24,25,25,25,25,26,26,26,26,27,27,27,27,28,
+	28,28,28,29,29,29,29,30,30,30,30,31,31,31,31,32,
+	32,33,33,34,34,35,35,36,36,37,37,38,38,39,39,40,
+	40,41,41,42,42,43,43,44,44,45,45,46,46,47,47,48,
+	48,49,49,50,50,51,51,52,52,53,53,54,54,55,56,57,
+	58,59,60,61,62,63,64,65,66,67,68,
+
+	/* 31 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,20,21,21,22,22,23,23,24,24,24,24,
+	25,25,25,25,26,26,26,26,27,27,27,27,28,28,28,28,
+	29,29,29,29,30,30,30,30,31,31,31,31,32,32,32,32,
+	33,33,34,34,35,35,36,36,37,37,38,38,39,39,40,40,
+	41,41,42,42,43,43,44,44,45,45,46,46,47,47,48,48,
+	49,49,50,50,51,51,52,52,53,53,54,54,55,55,56,57,
+	58,59,60,61,62,63,64,65,66,67,68,
+
+	/* 32 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,21,22,22,23,23,24,24,24,24,25,
+	25,25,25,26,26,26,26,27,27,27,27,28,28,28,28,29,
+	29,29,29,30,30,30,30,31,31,31,31,32,32,32,32,33,
+	33,34,34,35,35,36,36,37,37,38,38,39,39,40,40,41,
+	41,42,42,43,43,44,44,45,45,46,46,47,47,48,48,49,
+	49,50,50,51,51,52,52,53,53,54,54,55,55,56,57,58,
+	59,60,61,62,63,64,65,66,67,68,69,
+
+	/* 33 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,22,23,23,24,24,25,25,25,25,
+	26,26,26,26,27,27,27,27,28,28,28,28,29,29,29,29,
+	30,30,30,30,31,31,31,31,32,32,32,32,33,33,33,33,
+	34,34,35,35,36,36,37,37,38,38,39,39,40,40,41,41,
+	42,42,43,43,44,44,45,45,46,46,47,47,48,48,49,49,
+	50,50,51,51,52,52,53,53,54,54,55,55,56,56,57,58,
+	59,60,61,62,63,64,65,66,67,68,69,
+
+	/* 34 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,23,24,24,25,25,25,25,26,
+	26,26,26,27,27,27,27,28,28,28,28,29,29,29,29,30,
+	30,30,30,31,31,31,31,32,32,32,32,33,33,33,33,34,
+	34,35,35,36,36,37,37,38,38,39,39,40,40,41,41,42,
+	42,43,43,44,44,45,45,46,46,47,47,48,48,49,49,50,
+	50,51,51,52,52,53,53,54,54,55,55,56,56,57,58,59,
+	60,61,62,63,64,65,66,67,68,69,70,
+
+	/* 35 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,28,28,28,29,
+	30,30,30,30,31,31,31,31,32,32,32,32,33,33,33,33,
+	34,34,34,34,35,35,35,35,36,36,36,36,37,37,37,37,
+	38,38,38,39,40,40,40,41,42,42,42,43,44,44,44,45,
+	46,46,46,47,48,48,48,49,50,50,50,51,52,52,53,54,
+	55,56,57,58,59,60,61,62,63,64,65,66,67,68,69,70,
+	71,72,73,74,75,76,77,78,79,80,81,
+
+	/* 36 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,21,22,23,23,23,24,25,25,25,25,
+	26,26,26,26,27,27,27,27,28,28,28,28,29,29,29,29,
+	30,30,30,30,31,31,31,31,32,32,32,32,33,33,33,33,
+	34,34,34,35,36,36,36,37,38,38,38,39,40,40,40,41,
+	42,42,42,43,44,44,44,45,46,46,46,47,48,48,48,49,
+	50,50,50,51,52,52,53,54,55,56,57,58,59,60,61,62,
+	63,64,65,66,67,68,69,70,71,72,73,
+
+	/* 37 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,22,23,24,24,24,25,25,25,25,
+	26,26,26,26,27,27,27,27,28,28,28,28,29,29,29,29,
+	30,30,30,30,31,31,31,31,32,32,32,32,33,33,33,33,
+	34,35,35,35,36,37,37,37,38,39,39,39,40,41,41,41,
+	42,43,43,43,44,45,45,45,46,47,47,47,48,49,49,49,
+	50,51,51,51,52,53,53,54,55,56,57,58,59,60,61,62,
+	63,64,65,66,67,68,69,70,71,72,73,
+
+	/* 38 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,23,24,25,25,25,25,26,26,
+	26,26,27,27,27,27,28,28,28,28,29,29,29,29,30,30,
+	30,30,31,31,31,31,32,32,32,32,33,33,33,33,34,34,
+	34,35,36,36,36,37,38,38,38,39,40,40,40,41,42,42,
+	42,43,44,44,44,45,46,46,46,47,48,48,48,49,50,50,
+	50,51,52,52,52,53,54,54,55,56,57,58,59,60,61,62,
+	63,64,65,66,67,68,69,70,71,72,73,
+
+	/* 39 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,24,25,26,26,26,26,27,
+	27,27,27,28,28,28,28,29,29,29,29,30,30,30,30,31,
+	31,31,31,32,32,32,32,33,33,33,33,34,34,34,34,35,
+	35,35,36,37,37,37,38,39,39,39,40,41,41,41,42,43,
+	43,43,44,45,45,45,46,47,47,47,48,49,49,49,50,51,
+	51,51,52,53,53,53,54,55,55,56,57,58,59,60,61,62,
+	63,64,65,66,67,68,69,70,71,72,73,
+
+	/* 40 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,25,26,27,27,27,27,
+	28,28,28,28,29,29,29,29,30,30,30,30,31,31,31,31,
+	32,32,32,32,33,33,33,33,34,34,34,34,35,35,35,35,
+	36,36,36,37,38,38,38,39,40,40,40,41,42,42,42,43,
+	44,44,44,45,46,46,46,47,48,48,48,49,50,50,50,51,
+	52,52,52,53,54,54,54,55,56,56,57,58,59,60,61,62,
+	63,64,65,66,67,68,69,70,71,72,73,
+
+	/* 41 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,26,27,27,27,27,
+	28,28,28,28,29,29,29,29,30,30,30,30,31,31,31,31,
+	32,32,32,32,33,33,33,33,34,34,34,34,35,35,35,35,
+	36,37,37,37,38,39,39,39,40,41,41,41,42,43,43,43,
+	44,45,45,45,46,47,47,47,48,49,49,49,50,51,51,51,
+	52,53,53,53,54,55,55,55,56,57,57,58,59,60,61,62,
+	63,64,65,66,67,68,69,70,71,72,73,
+
+	/* 42 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,27,27,28,28,
+	28,28,29,29,29,29,30,30,30,30,31,31,31,31,32,32,
+	32,32,33,33,33,33,34,34,34,34,35,35,35,35,36,36,
+	36,37,38,38,38,39,40,40,40,41,42,42,42,43,44,44,
+	44,45,46,46,46,47,48,48,48,49,50,50,50,51,52,52,
+	52,53,54,54,54,55,56,56,56,57,58,58,59,60,61,62,
+	63,64,65,66,67,68,69,70,71,72,73,
+
+	/* 43 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,28,28,28,29,
+	29,29,29,30,30,30,30,31,31,31,31,32,32,32,32,33,
+	33,33,33,34,34,34,34,35,35,35,35,36,36,36,36,37,
+	37,37,38,39,39,39,40,41,41,41,42,43,43,43,44,45,
+	45,45,46,47,47,47,48,49,49,49,50,51,51,51,52,53,
+	53,53,54,55,55,55,56,57,57,57,58,59,59,60,61,62,
+	63,64,65,66,67,68,69,70,71,72,73,
+
+	/* 44 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,13,14,
+	15,15,15,16,17,17,17,18,19,19,19,20,21,21,21,21,
+	22,22,22,22,23,23,23,23,24,24,24,24,25,25,25,25,
+	26,26,26,26,27,27,27,27,28,28,28,28,29,29,29,29,
+	30,30,30,31,32,32,32,33,34,34,34,35,36,36,36,37,
+	38,38,38,39,40,40,40,41,42,42,42,43,44,44,44,45,
+	46,46,46,47,48,48,48,49,50,50,50,51,52,52,53,54,
+	55,56,57,58,59,60,61,62,63,64,65,
+
+	/* 45 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,14,
+	15,16,16,16,17,18,18,18,19,20,20,20,21,21,21,21,
+	22,22,22,22,23,23,23,23,24,24,24,24,25,25,25,25,
+	26,26,26,26,27,27,27,27,28,28,28,28,29,29,29,29,
+	30,31,31,31,32,33,33,33,34,35,35,35,36,37,37,37,
+	38,39,39,39,40,41,41,41,42,43,43,43,44,45,45,45,
+	46,47,47,47,48,49,49,49,50,51,51,51,52,53,54,55,
+	56,57,58,59,60,61,62,63,64,65,66,
+
+	/* 46 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	15,16,17,17,17,18,19,19,19,20,21,21,21,21,22,22,
+	22,22,23,23,23,23,24,24,24,24,25,25,25,25,26,26,
+	26,26,27,27,27,27,28,28,28,28,29,29,29,29,30,30,
+	30,31,32,32,32,33,34,34,34,35,36,36,36,37,38,38,
+	38,39,40,40,40,41,42,42,42,43,44,44,44,45,46,46,
+	46,47,48,48,48,49,50,50,50,51,52,52,52,53,54,55,
+	56,57,58,59,60,61,62,63,64,65,66,
+
+	/* 47 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,16,17,18,18,18,19,20,20,20,21,22,22,22,22,23,
+	23,23,23,24,24,24,24,25,25,25,25,26,26,26,26,27,
+	27,27,27,28,28,28,28,29,29,29,29,30,30,30,30,31,
+	31,31,32,33,33,33,34,35,35,35,36,37,37,37,38,39,
+	39,39,40,41,41,41,42,43,43,43,44,45,45,45,46,47,
+	47,47,48,49,49,49,50,51,51,51,52,53,53,53,54,55,
+	56,57,58,59,60,61,62,63,64,65,66,
+
+	/* 48 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,17,18,19,19,19,20,21,21,21,22,23,23,23,23,
+	24,24,24,24,25,25,25,25,26,26,26,26,27,27,27,27,
+	28,28,28,28,29,29,29,29,30,30,30,30,31,31,31,31,
+	32,32,32,33,34,34,34,35,36,36,36,37,38,38,38,39,
+	40,40,40,41,42,42,42,43,44,44,44,45,46,46,46,47,
+	48,48,48,49,50,50,50,51,52,52,52,53,54,54,55,56,
+	57,58,59,60,61,62,63,64,65,66,67,
+
+	/* 49 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,18,19,20,20,20,21,22,22,22,23,23,23,23,
+	24,24,24,24,25,25,25,25,26,26,26,26,27,27,27,27,
+	28,28,28,28,29,29,29,29,30,30,30,30,31,31,31,31,
+	32,33,33,33,34,35,35,35,36,37,37,37,38,39,39,39,
+	40,41,41,41,42,43,43,43,44,45,45,45,46,47,47,47,
+	48,49,49,49,50,51,51,51,52,53,53,53,54,55,56,57,
+	58,59,60,61,62,63,64,65,66,67,68,
+
+	/* 50 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,19,20,21,21,21,22,23,23,23,23,24,24,
+	24,24,25,25,25,25,26,26,26,26,27,27,27,27,28,28,
+	28,28,29,29,29,29,30,30,30,30,31,31,31,31,32,32,
+	32,33,34,34,34,35,36,36,36,37,38,38,38,39,40,40,
+	40,41,42,42,42,43,44,44,44,45,46,46,46,47,48,48,
+	48,49,50,50,50,51,52,52,52,53,54,54,54,55,56,57,
+	58,59,60,61,62,63,64,65,66,67,68,
+
+	/* 51 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,20,21,22,22,22,23,24,24,24,24,25,
+	25,25,25,26,26,26,26,27,27,27,27,28,28,28,28,29,
+	29,29,29,30,30,30,30,31,31,31,31,32,32,32,32,33,
+	33,33,34,35,35,35,36,37,37,37,38,39,39,39,40,41,
+	41,41,42,43,43,43,44,45,45,45,46,47,47,47,48,49,
+	49,49,50,51,51,51,52,53,53,53,54,55,55,55,56,57,
+	58,59,60,61,62,63,64,65,66,67,68,
+
+	/* 52 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,28,28,29,30,
+	31,31,31,32,33,33,33,34,35,35,35,36,37,37,37,38,
+	39,39,39,40,41,41,41,42,43,43,43,44,45,45,45,46,
+	47,47,48,49,50,50,51,52,53,53,54,55,56,56,57,58,
+	59,59,60,61,62,62,63,64,65,65,66,67,68,68,69,70,
+	71,72,73,74,75,76,77,78,79,80,81,82,83,84,85,86,
+	87,88,89,90,91,92,93,94,95,96,97,
+
+	/* 53 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,24,25,26,27,27,27,28,
+	29,29,29,30,31,31,31,32,33,33,33,34,35,35,35,36,
+	37,37,37,38,39,39,39,40,41,41,41,42,43,43,43,44,
+	45,45,46,47,48,48,49,50,51,51,52,53,54,54,55,56,
+	57,57,58,59,60,60,61,62,63,63,64,65,66,66,67,68,
+	69,69,70,71,72,72,73,74,75,76,77,78,79,80,81,82,
+	83,84,85,86,87,88,89,90,91,92,93,
+
+	/* 54 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,25,26,27,27,27,28,
+	29,29,29,30,31,31,31,32,33,33,33,34,35,35,35,36,
+	37,37,37,38,39,39,39,40,41,41,41,42,43,43,43,44,
+	45,46,46,47,48,49,49,50,51,52,52,53,54,55,55,56,
+	57,58,58,59,60,61,61,62,63,64,64,65,66,67,67,68,
+	69,70,70,71,72,73,73,74,75,76,77,78,79,80,81,82,
+	83,84,85,86,87,88,89,90,91,92,93,
+
+	/* 55 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,26,27,27,28,28,
+	29,29,30,30,31,31,32,32,33,33,34,34,35,35,36,36,
+	37,37,38,38,39,39,40,40,41,41,42,42,43,43,44,44,
+	45,46,47,47,48,49,50,50,51,52,53,53,54,55,56,56,
+	57,58,59,59,60,61,62,62,63,64,65,65,66,67,68,68,
+	69,70,71,71,72,73,74,74,75,76,77,78,79,80,81,82,
+	83,84,85,86,87,88,89,90,91,92,93,
+
+	/* 56 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,27,27,28,29,
+	29,29,30,31,31,31,32,33,33,33,34,35,35,35,36,37,
+	37,37,38,39,39,39,40,41,41,41,42,43,43,43,44,45,
+	45,46,47,48,48,49,50,51,51,52,53,54,54,55,56,57,
+	57,58,59,60,60,61,62,63,63,64,65,66,66,67,68,69,
+	69,70,71,72,72,73,74,75,75,76,77,78,79,80,81,82,
+	83,84,85,86,87,88,89,90,91,92,93,
+
+	/* 57 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,28,28,28,29,
+	30,30,30,31,32,32,32,33,34,34,34,35,36,36,36,37,
+	38,38,38,39,40,40,40,41,42,42,42,43,44,44,44,45,
+	46,46,47,48,49,49,50,51,52,52,53,54,55,55,56,57,
+	58,58,59,60,61,61,62,63,64,64,65,66,67,67,68,69,
+	70,70,71,72,73,73,74,75,76,76,77,78,79,80,81,82,
+	83,84,85,86,87,88,89,90,91,92,93,
+
+	/* 58 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,28,28,28,29,
+	30,30,30,31,32,32,32,33,34,34,34,35,36,36,36,37,
+	38,38,38,39,40,40,40,41,42,42,42,43,44,44,44,45,
+	46,47,47,48,49,50,50,51,52,53,53,54,55,56,56,57,
+	58,59,59,60,61,62,62,63,64,65,65,66,67,68,68,69,
+	70,71,71,72,73,74,74,75,76,77,77,78,79,80,81,82,
+	83,84,85,86,87,88,89,90,91,92,93,
+
+	/* 59 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,28,28,29,29,
+	30,30,31,31,32,32,33,33,34,34,35,35,36,36,37,37,
+	38,38,39,39,40,40,41,41,42,42,43,43,44,44,45,45,
+	46,47,48,48,49,50,51,51,52,53,54,54,55,56,57,57,
+	58,59,60,60,61,62,63,63,64,65,66,66,67,68,69,69,
+	70,71,72,72,73,74,75,75,76,77,78,78,79,80,81,82,
+	83,84,85,86,87,88,89,90,91,92,93,
+
+	/* 60 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,28,28,29,30,
+	30,30,31,32,32,32,33,34,34,34,35,36,36,36,37,38,
+	38,38,39,40,40,40,41,42,42,42,43,44,44,44,45,46,
+	46,47,48,49,49,50,51,52,52,53,54,55,55,56,57,58,
+	58,59,60,61,61,62,63,64,64,65,66,67,67,68,69,70,
+	70,71,72,73,73,74,75,76,76,77,78,79,79,80,81,82,
+	83,84,85,86,87,88,89,90,91,92,93,
+
+	/* 61 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,16,17,18,19,19,20,21,22,22,23,24,25,25,25,26,
+	27,27,27,28,29,29,29,30,31,31,31,32,33,33,33,34,
+	35,35,35,36,37,37,37,38,39,39,39,40,41,41,41,42,
+	43,43,44,45,46,46,47,48,49,49,50,51,52,52,53,54,
+	55,55,56,57,58,58,59,60,61,61,62,63,64,64,65,66,
+	67,67,68,69,70,70,71,72,73,73,74,75,76,76,77,78,
+	79,80,81,82,83,84,85,86,87,88,89,
+
+	/* 62 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,17,18,19,20,20,21,22,23,23,24,25,25,25,26,
+	27,27,27,28,29,29,29,30,31,31,31,32,33,33,33,34,
+	35,35,35,36,37,37,37,38,39,39,39,40,41,41,41,42,
+	43,44,44,45,46,47,47,48,49,50,50,51,52,53,53,54,
+	55,56,56,57,58,59,59,60,61,62,62,63,64,65,65,66,
+	67,68,68,69,70,71,71,72,73,74,74,75,76,77,78,79,
+	80,81,82,83,84,85,86,87,88,89,90,
+
+	/* 63 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,18,19,20,21,21,22,23,24,24,25,25,26,26,
+	27,27,28,28,29,29,30,30,31,31,32,32,33,33,34,34,
+	35,35,36,36,37,37,38,38,39,39,40,40,41,41,42,42,
+	43,44,45,45,46,47,48,48,49,50,51,51,52,53,54,54,
+	55,56,57,57,58,59,60,60,61,62,63,63,64,65,66,66,
+	67,68,69,69,70,71,72,72,73,74,75,75,76,77,78,79,
+	80,81,82,83,84,85,86,87,88,89,90,
+
+	/* 64 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,19,20,21,22,22,23,24,25,25,25,26,27,
+	27,27,28,29,29,29,30,31,31,31,32,33,33,33,34,35,
+	35,35,36,37,37,37,38,39,39,39,40,41,41,41,42,43,
+	43,44,45,46,46,47,48,49,49,50,51,52,52,53,54,55,
+	55,56,57,58,58,59,60,61,61,62,63,64,64,65,66,67,
+	67,68,69,70,70,71,72,73,73,74,75,76,76,77,78,79,
+	80,81,82,83,84,85,86,87,88,89,90,
+
+	/* 65 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,20,21,22,23,23,24,25,26,26,26,27,
+	28,28,28,29,30,30,30,31,32,32,32,33,34,34,34,35,
+	36,36,36,37,38,38,38,39,40,40,40,41,42,42,42,43,
+	44,44,45,46,47,47,48,49,50,50,51,52,53,53,54,55,
+	56,56,57,58,59,59,60,61,62,62,63,64,65,65,66,67,
+	68,68,69,70,71,71,72,73,74,74,75,76,77,77,78,79,
+	80,81,82,83,84,85,86,87,88,89,90,
+
+	/* 66 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,21,22,23,24,24,25,26,26,26,27,
+	28,28,28,29,30,30,30,31,32,32,32,33,34,34,34,35,
+	36,36,36,37,38,38,38,39,40,40,40,41,42,42,42,43,
+	44,45,45,46,47,48,48,49,50,51,51,52,53,54,54,55,
+	56,57,57,58,59,60,60,61,62,63,63,64,65,66,66,67,
+	68,69,69,70,71,72,72,73,74,75,75,76,77,78,79,80,
+	81,82,83,84,85,86,87,88,89,90,91,
+
+	/* 67 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,22,23,24,25,25,26,26,27,27,
+	28,28,29,29,30,30,31,31,32,32,33,33,34,34,35,35,
+	36,36,37,37,38,38,39,39,40,40,41,41,42,42,43,43,
+	44,45,46,46,47,48,49,49,50,51,52,52,53,54,55,55,
+	56,57,58,58,59,60,61,61,62,63,64,64,65,66,67,67,
+	68,69,70,70,71,72,73,73,74,75,76,76,77,78,79,80,
+	81,82,83,84,85,86,87,88,89,90,91,
+
+	/* 68 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,23,24,25,26,26,26,27,28,
+	28,28,29,30,30,30,31,32,32,32,33,34,34,34,35,36,
+	36,36,37,38,38,38,39,40,40,40,41,42,42,42,43,44,
+	44,45,46,47,47,48,49,50,50,51,52,53,53,54,55,56,
+	56,57,58,59,59,60,61,62,62,63,64,65,65,66,67,68,
+	68,69,70,71,71,72,73,74,74,75,76,77,77,78,79,80,
+	81,82,83,84,85,86,87,88,89,90,91,
+
+	/* 69 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,28,28,29,30,
+	30,30,30,31,31,31,31,32,32,32,32,33,33,33,33,34,
+	34,34,34,35,35,35,35,36,36,36,36,37,37,37,37,38,
+	38,39,39,40,40,41,41,42,42,43,43,44,44,45,45,46,
+	46,47,47,48,48,49,49,50,50,51,51,52,52,53,53,54,
+	55,56,57,58,59,60,61,62,63,64,65,66,67,68,69,70,
+	71,72,73,74,75,76,77,78,79,80,81,
+
+	/* 70 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,23,24,24,25,25,25,25,26,
+	26,26,26,27,27,27,27,28,28,28,28,29,29,29,29,30,
+	30,30,30,31,31,31,31,32,32,32,32,33,33,33,33,34,
+	34,35,35,36,36,37,37,38,38,39,39,40,40,41,41,42,
+	42,43,43,44,44,45,45,46,46,47,47,48,48,49,49,50,
+	50,51,51,52,52,53,53,54,55,56,57,58,59,60,61,62,
+	63,64,65,66,67,68,69,70,71,72,73,
+
+	/* 71 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,24,25,25,26,26,26,26,
+	27,27,27,27,28,28,28,28,29,29,29,29,30,30,30,30,
+	31,31,31,31,32,32,32,32,33,33,33,33,34,34,34,34,
+	35,35,36,36,37,37,38,38,39,39,40,40,41,41,42,42,
+	43,43,44,44,45,45,46,46,47,47,48,48,49,49,50,50,
+	51,51,52,52,53,53,54,54,55,56,57,58,59,60,61,62,
+	63,64,65,66,67,68,69,70,71,72,73,
+
+	/* 72 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,25,26,26,26,26,27,
+	27,27,27,28,28,28,28,29,29,29,29,30,30,30,30,31,
+	31,31,31,32,32,32,32,33,33,33,33,34,34,34,34,35,
+	35,36,36,37,37,38,38,39,39,40,40,41,41,42,42,43,
+	43,44,44,45,45,46,46,47,47,48,48,49,49,50,50,51,
+	51,52,52,53,53,54,54,55,55,56,57,58,59,60,61,62,
+	63,64,65,66,67,68,69,70,71,72,73,
+
+	/* 73 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,26,27,27,27,27,
+	28,28,28,28,29,29,29,29,30,30,30,30,31,31,31,31,
+	32,32,32,32,33,33,33,33,34,34,34,34,35,35,35,35,
+	36,36,37,37,38,38,39,39,40,40,41,41,42,42,43,43,
+	44,44,45,45,46,46,47,47,48,48,49,49,50,50,51,51,
+	52,52,53,53,54,54,55,55,56,56,57,58,59,60,61,62,
+	63,64,65,66,67,68,69,70,71,72,73,
+
+	/* 74 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,27,27,27,28,
+	28,28,28,29,29,29,29,30,30,30,30,31,31,31,31,32,
+	32,32,32,33,33,33,33,34,34,34,34,35,35,35,35,36,
+	36,37,37,38,38,39,39,40,40,41,41,42,42,43,43,44,
+	44,45,45,46,46,47,47,48,48,49,49,50,50,51,51,52,
+	52,53,53,54,54,55,55,56,56,57,57,58,59,60,61,62,
+	63,64,65,66,67,68,69,70,71,72,73,
+
+	/* 75 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,28,28,28,28,
+	29,29,29,29,30,30,30,30,31,31,31,31,32,32,32,32,
+	33,33,33,33,34,34,34,34,35,35,35,35,36,36,36,36,
+	37,37,38,38,39,39,40,40,41,41,42,42,43,43,44,44,
+	45,45,46,46,47,47,48,48,49,49,50,50,51,51,52,52,
+	53,53,54,54,55,55,56,56,57,57,58,58,59,60,61,62,
+	63,64,65,66,67,68,69,70,71,72,73,
+
+	/* 76 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,28,28,28,29,
+	29,29,29,30,30,30,30,31,31,31,31,32,32,32,32,33,
+	33,33,33,34,34,34,34,35,35,35,35,36,36,36,36,37,
+	37,38,38,39,39,40,40,41,41,42,42,43,43,44,44,45,
+	45,46,46,47,47,48,48,49,49,50,50,51,51,52,52,53,
+	53,54,54,55,55,56,56,57,57,58,58,59,59,60,61,62,
+	63,64,65,66,67,68,69,70,71,72,73,
+
+	/* 77 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,28,28,29,29,
+	30,30,30,30,31,31,31,31,32,32,32,32,33,33,33,33,
+	34,34,34,34,35,35,35,35,36,36,36,36,37,37,37,37,
+	38,38,39,39,40,40,41,41,42,42,43,43,44,44,45,45,
+	46,46,47,47,48,48,49,49,50,50,51,51,52,52,53,53,
+	54,54,55,55,56,56,57,57,58,58,59,59,60,60,61,62,
+	63,64,65,66,67,68,69,70,71,72,73,
+
+	/* 78 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	15,16,16,17,17,18,18,19,19,20,20,21,21,21,21,22,
+	22,22,22,23,23,23,23,24,24,24,24,25,25,25,25,26,
+	26,26,26,27,27,27,27,28,28,28,28,29,29,29,29,30,
+	30,31,31,32,32,33,33,34,34,35,35,36,36,37,37,38,
+	38,39,39,40,40,41,41,42,42,43,43,44,44,45,45,46,
+	46,47,47,48,48,49,49,50,50,51,51,52,52,53,54,55,
+	56,57,58,59,60,61,62,63,64,65,66,
+
+	/* 79 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,16,17,17,18,18,19,19,20,20,21,21,22,22,22,22,
+	23,23,23,23,24,24,24,24,25,25,25,25,26,26,26,26,
+	27,27,27,27,28,28,28,28,29,29,29,29,30,30,30,30,
+	31,31,32,32,33,33,34,34,35,35,36,36,37,37,38,38,
+	39,39,40,40,41,41,42,42,43,43,44,44,45,45,46,46,
+	47,47,48,48,49,49,50,50,51,51,52,52,53,53,54,55,
+	56,57,58,59,60,61,62,63,64,65,66,
+
+	/* 80 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,17,18,18,19,19,20,20,21,21,22,22,22,22,23,
+	23,23,23,24,24,24,24,25,25,25,25,26,26,26,26,27,
+	27,27,27,28,28,28,28,29,29,29,29,30,30,30,30,31,
+	31,32,32,33,33,34,34,35,35,36,36,37,37,38,38,39,
+	39,40,40,41,41,42,42,43,43,44,44,45,45,46,46,47,
+	47,48,48,49,49,50,50,51,51,52,52,53,53,54,55,56,
+	57,58,59,60,61,62,63,64,65,66,67,
+
+	/* 81 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,18,19,19,20,20,21,21,22,22,23,23,23,23,
+	24,24,24,24,25,25,25,25,26,26,26,26,27,27,27,27,
+	28,28,28,28,29,29,29,29,30,30,30,30,31,31,31,31,
+	32,32,33,33,34,34,35,35,36,36,37,37,38,38,39,39,
+	40,40,41,41,42,42,43,43,44,44,45,45,46,46,47,47,
+	48,48,49,49,50,50,51,51,52,52,53,53,54,54,55,56,
+	57,58,59,60,61,62,63,64,65,66,67,
+
+	/* 82 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,19,20,20,21,21,22,22,23,23,23,23,24,
+	24,24,24,25,25,25,25,26,26,26,26,27,27,27,27,28,
+	28,28,28,29,29,29,29,30,30,30,30,31,31,31,31,32,
+	32,33,33,34,34,35,35,36,36,37,37,38,38,39,39,40,
+	40,41,41,42,42,43,43,44,44,45,45,46,46,47,47,48,
+	48,49,49,50,50,51,51,52,52,53,53,54,54,55,56,57,
+	58,59,60,61,62,63,64,65,66,67,68,
+
+	/* 83 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,20,21,21,22,22,23,23,24,24,24,24,
+	25,25,25,25,26,26,26,26,27,27,27,27,28,28,28,28,
+	29,29,29,29,30,30,30,30,31,31,31,31,32,32,32,32,
+	33,33,34,34,35,35,36,36,37,37,38,38,39,39,40,40,
+	41,41,42,42,43,43,44,44,45,45,46,46,47,47,48,48,
+	49,49,50,50,51,51,52,52,53,53,54,54,55,55,56,57,
+	58,59,60,61,62,63,64,65,66,67,68,
+
+	/* 84 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,21,22,22,23,23,24,24,24,24,25,
+	25,25,25,26,26,26,26,27,27,27,27,28,28,28,28,29,
+	29,29,29,30,30,30,30,31,31,31,31,32,32,32,32,33,
+	33,34,34,35,35,36,36,37,37,38,38,39,39,40,40,41,
+	41,42,42,43,43,44,44,45,45,46,46,47,47,48,48,49,
+	49,50,50,51,51,52,52,53,53,54,54,55,55,56,57,58,
+	59,60,61,62,63,64,65,66,67,68,69,
+
+	/* 85 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,22,23,23,24,24,25,25,25,25,
+	26,26,26,26,27,27,27,27,28,28,28,28,29,29,29,29,
+	30,30,30,30,31,31,31,31,32,32,32,32,33,33,33,33,
+	34,34,35,35,36,36,37,37,38,38,39,39,40,40,41,41,
+	42,42,43,43,44,44,45,45,46,46,47,47,48,48,49,49,
+	50,50,51,51,52,52,53,53,54,54,55,55,56,56,57,58,
+	59,60,61,62,63,64,65,66,67,68,69,
+
+	/* 86 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,28,28,29,30,
+	30,30,31,32,32,32,33,34,34,34,35,36,36,36,37,38,
+	38,38,39,40,40,40,41,42,42,42,43,44,44,44,45,46,
+	46,47,48,49,49,50,51,52,52,53,54,55,55,56,57,58,
+	58,59,60,61,61,62,63,64,64,65,66,67,67,68,69,70,
+	71,72,73,74,75,76,77,78,79,80,81,82,83,84,85,86,
+	87,88,89,90,91,92,93,94,95,96,97,
+
+	/* 87 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,23,24,25,26,26,26,27,28,
+	28,28,29,30,30,30,31,32,32,32,33,34,34,34,35,36,
+	36,36,37,38,38,38,39,40,40,40,41,42,42,42,43,44,
+	44,45,46,47,47,48,49,50,50,51,52,53,53,54,55,56,
+	56,57,58,59,59,60,61,62,62,63,64,65,65,66,67,68,
+	68,69,70,71,71,72,73,74,75,76,77,78,79,80,81,82,
+	83,84,85,86,87,88,89,90,91,92,93,
+
+	/* 88 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,24,25,26,27,27,27,28,
+	29,29,29,30,31,31,31,32,33,33,33,34,35,35,35,36,
+	37,37,37,38,39,39,39,40,41,41,41,42,43,43,43,44,
+	45,45,46,47,48,48,49,50,51,51,52,53,54,54,55,56,
+	57,57,58,59,60,60,61,62,63,63,64,65,66,66,67,68,
+	69,69,70,71,72,72,73,74,75,76,77,78,79,80,81,82,
+	83,84,85,86,87,88,89,90,91,92,93,
+
+	/* 89 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,25,26,27,27,27,28,
+	29,29,29,30,31,31,31,32,33,33,33,34,35,35,35,36,
+	37,37,37,38,39,39,39,40,41,41,41,42,43,43,43,44,
+	45,46,46,47,48,49,49,50,51,52,52,53,54,55,55,56,
+	57,58,58,59,60,61,61,62,63,64,64,65,66,67,67,68,
+	69,70,70,71,72,73,73,74,75,76,77,78,79,80,81,82,
+	83,84,85,86,87,88,89,90,91,92,93,
+
+	/* 90 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,26,27,27,28,28,
+	29,29,30,30,31,31,32,32,33,33,34,34,35,35,36,36,
+	37,37,38,38,39,39,40,40,41,41,42,42,43,43,44,44,
+	45,46,47,47,48,49,50,50,51,52,53,53,54,55,56,56,
+	57,58,59,59,60,61,62,62,63,64,65,65,66,67,68,68,
+	69,70,71,71,72,73,74,74,75,76,77,78,79,80,81,82,
+	83,84,85,86,87,88,89,90,91,92,93,
+
+	/* 91 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,27,27,28,29,
+	29,29,30,31,31,31,32,33,33,33,34,35,35,35,36,37,
+	37,37,38,39,39,39,40,41,41,41,42,43,43,43,44,45,
+	45,46,47,48,48,49,50,51,51,52,53,54,54,55,56,57,
+	57,58,59,60,60,61,62,63,63,64,65,66,66,67,68,69,
+	69,70,71,72,72,73,74,75,75,76,77,78,79,80,81,82,
+	83,84,85,86,87,88,89,90,91,92,93,
+
+	/* 92 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,28,28,28,29,
+	30,30,30,31,32,32,32,33,34,34,34,35,36,36,36,37,
+	38,38,38,39,40,40,40,41,42,42,42,43,44,44,44,45,
+	46,46,47,48,49,49,50,51,52,52,53,54,55,55,56,57,
+	58,58,59,60,61,61,62,63,64,64,65,66,67,67,68,69,
+	70,70,71,72,73,73,74,75,76,76,77,78,79,80,81,82,
+	83,84,85,86,87,88,89,90,91,92,93,
+
+	/* 93 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,28,28,28,29,
+	30,30,30,31,32,32,32,33,34,34,34,35,36,36,36,37,
+	38,38,38,39,40,40,40,41,42,42,42,43,44,44,44,45,
+	46,47,47,48,49,50,50,51,52,53,53,54,55,56,56,57,
+	58,59,59,60,61,62,62,63,64,65,65,66,67,68,68,69,
+	70,71,71,72,73,74,74,75,76,77,77,78,79,80,81,82,
+	83,84,85,86,87,88,89,90,91,92,93,
+
+	/* 94 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,28,28,29,29,
+	30,30,31,31,32,32,33,33,34,34,35,35,36,36,37,37,
+	38,38,39,39,40,40,41,41,42,42,43,43,44,44,45,45,
+	46,47,48,48,49,50,51,51,52,53,54,54,55,56,57,57,
+	58,59,60,60,61,62,63,63,64,65,66,66,67,68,69,69,
+	70,71,72,72,73,74,75,75,76,77,78,78,79,80,81,82,
+	83,84,85,86,87,88,89,90,91,92,93,
+
+	/* 95 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	15,16,17,18,18,19,20,21,21,22,23,24,24,24,25,26,
+	26,26,27,28,28,28,29,30,30,30,31,32,32,32,33,34,
+	34,34,35,36,36,36,37,38,38,38,39,40,40,40,41,42,
+	42,43,44,45,45,46,47,48,48,49,50,51,51,52,53,54,
+	54,55,56,57,57,58,59,60,60,61,62,63,63,64,65,66,
+	66,67,68,69,69,70,71,72,72,73,74,75,75,76,77,78,
+	79,80,81,82,83,84,85,86,87,88,89,
+
+	/* 96 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,16,17,18,19,19,20,21,22,22,23,24,25,25,25,26,
+	27,27,27,28,29,29,29,30,31,31,31,32,33,33,33,34,
+	35,35,35,36,37,37,37,38,39,39,39,40,41,41,41,42,
+	43,43,44,45,46,46,47,48,49,49,50,51,52,52,53,54,
+	55,55,56,57,58,58,59,60,61,61,62,63,64,64,65,66,
+	67,67,68,69,70,70,71,72,73,73,74,75,76,76,77,78,
+	79,80,81,82,83,84,85,86,87,88,89,
+
+	/* 97 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,17,18,19,20,20,21,22,23,23,24,25,25,25,26,
+	27,27,27,28,29,29,29,30,31,31,31,32,33,33,33,34,
+	35,35,35,36,37,37,37,38,39,39,39,40,41,41,41,42,
+	43,44,44,45,46,47,47,48,49,50,50,51,52,53,53,54,
+	55,56,56,57,58,59,59,60,61,62,62,63,64,65,65,66,
+	67,68,68,69,70,71,71,72,73,74,74,75,76,77,78,79,
+	80,81,82,83,84,85,86,87,88,89,90,
+
+	/* 98 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,18,19,20,21,21,22,23,24,24,25,25,26,26,
+	27,27,28,28,29,29,30,30,31,31,32,32,33,33,34,34,
+	35,35,36,36,37,37,38,38,39,39,40,40,41,41,42,42,
+	43,44,45,45,46,47,48,48,49,50,51,51,52,53,54,54,
+	55,56,57,57,58,59,60,60,61,62,63,63,64,65,66,66,
+	67,68,69,69,70,71,72,72,73,74,75,75,76,77,78,79,
+	80,81,82,83,84,85,86,87,88,89,90,
+
+	/* 99 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,19,20,21,22,22,23,24,25,25,25,26,27,
+	27,27,28,29,29,29,30,31,31,31,32,33,33,33,34,35,
+	35,35,36,37,37,37,38,39,39,39,40,41,41,41,42,43,
+	43,44,45,46,46,47,48,49,49,50,51,52,52,53,54,55,
+	55,56,57,58,58,59,60,61,61,62,63,64,64,65,66,67,
+	67,68,69,70,70,71,72,73,73,74,75,76,76,77,78,79,
+	80,81,82,83,84,85,86,87,88,89,90,
+
+	/* 100 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,20,21,22,23,23,24,25,26,26,26,27,
+	28,28,28,29,30,30,30,31,32,32,32,33,34,34,34,35,
+	36,36,36,37,38,38,38,39,40,40,40,41,42,42,42,43,
+	44,44,45,46,47,47,48,49,50,50,51,52,53,53,54,55,
+	56,56,57,58,59,59,60,61,62,62,63,64,65,65,66,67,
+	68,68,69,70,71,71,72,73,74,74,75,76,77,77,78,79,
+	80,81,82,83,84,85,86,87,88,89,90,
+
+	/* 101 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,21,22,23,24,24,25,26,26,26,27,
+	28,28,28,29,30,30,30,31,32,32,32,33,34,34,34,35,
+	36,36,36,37,38,38,38,39,40,40,40,41,42,42,42,43,
+	44,45,45,46,47,48,48,49,50,51,51,52,53,54,54,55,
+	56,57,57,58,59,60,60,61,62,63,63,64,65,66,66,67,
+	68,69,69,70,71,72,72,73,74,75,75,76,77,78,79,80,
+	81,82,83,84,85,86,87,88,89,90,91,
+
+	/* 102 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,22,23,24,25,25,26,26,27,27,
+	28,28,29,29,30,30,31,31,32,32,33,33,34,34,35,35,
+	36,36,37,37,38,38,39,39,40,40,41,41,42,42,43,43,
+	44,45,46,46,47,48,49,49,50,51,52,52,53,54,55,55,
+	56,57,58,58,59,60,61,61,62,63,64,64,65,66,67,67,
+	68,69,70,70,71,72,73,73,74,75,76,76,77,78,79,80,
+	81,82,83,84,85,86,87,88,89,90,91,
+
+	/* 103 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,28,28,29,30,
+	30,30,31,32,33,33,34,35,35,35,36,37,38,38,39,40,
+	40,40,41,42,43,43,44,45,45,45,46,47,48,48,49,50,
+	50,51,52,53,54,55,56,57,57,58,59,60,61,62,63,64,
+	64,65,66,67,68,69,70,71,71,72,73,74,75,76,77,78,
+	79,80,81,82,83,84,85,86,87,88,89,90,91,92,93,94,
+	95,96,97,98,99,100,101,102,103,104,105,
+
+	/* 104 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,23,24,25,26,27,27,28,29,
+	29,29,30,31,32,32,33,34,34,34,35,36,37,37,38,39,
+	39,39,40,41,42,42,43,44,44,44,45,46,47,47,48,49,
+	49,50,51,52,53,54,55,56,56,57,58,59,60,61,62,63,
+	63,64,65,66,67,68,69,70,70,71,72,73,74,75,76,77,
+	77,78,79,80,81,82,83,84,85,86,87,88,89,90,91,92,
+	93,94,95,96,97,98,99,100,101,102,103,
+
+	/* 105 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,24,25,26,27,27,28,29,
+	30,30,30,31,32,32,33,34,35,35,35,36,37,37,38,39,
+	40,40,40,41,42,42,43,44,45,45,45,46,47,47,48,49,
+	50,50,51,52,53,54,55,56,57,57,58,59,60,61,62,63,
+	64,64,65,66,67,68,69,70,71,71,72,73,74,75,76,77,
+	78,78,79,80,81,82,83,84,85,86,87,88,89,90,91,92,
+	93,94,95,96,97,98,99,100,101,102,103,
+
+	/* 106 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,25,26,27,27,28,29,
+	30,30,30,31,32,32,33,34,35,35,35,36,37,37,38,39,
+	40,40,40,41,42,42,43,44,45,45,45,46,47,47,48,49,
+	50,51,51,52,53,54,55,56,57,58,58,59,60,61,62,63,
+	64,65,65,66,67,68,69,70,71,72,72,73,74,75,76,77,
+	78,79,79,80,81,82,83,84,85,86,87,88,89,90,91,92,
+	93,94,95,96,97,98,99,100,101,102,103,
+
+	/* 107 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,26,27,27,28,29,
+	30,30,31,31,32,32,33,34,35,35,36,36,37,37,38,39,
+	40,40,41,41,42,42,43,44,45,45,46,46,47,47,48,49,
+	50,51,52,52,53,54,55,56,57,58,59,59,60,61,62,63,
+	64,65,66,66,67,68,69,70,71,72,73,73,74,75,76,77,
+	78,79,80,80,81,82,83,84,85,86,87,88,89,90,91,92,
+	93,94,95,96,97,98,99,100,101,102,103,
+
+	/* 108 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,27,27,28,29,
+	30,30,31,32,32,32,33,34,35,35,36,37,37,37,38,39,
+	40,40,41,42,42,42,43,44,45,45,46,47,47,47,48,49,
+	50,51,52,53,53,54,55,56,57,58,59,60,60,61,62,63,
+	64,65,66,67,67,68,69,70,71,72,73,74,74,75,76,77,
+	78,79,80,81,81,82,83,84,85,86,87,88,89,90,91,92,
+	93,94,95,96,97,98,99,100,101,102,103,
+
+	/* 109 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,28,28,28,29,
+	30,30,31,32,33,33,33,34,35,35,36,37,38,38,38,39,
+	40,40,41,42,43,43,43,44,45,45,46,47,48,48,48,49,
+	50,51,52,53,54,54,55,56,57,58,59,60,61,61,62,63,
+	64,65,66,67,68,68,69,70,71,72,73,74,75,75,76,77,
+	78,79,80,81,82,82,83,84,85,86,87,88,89,90,91,92,
+	93,94,95,96,97,98,99,100,101,102,103,
+
+	/* 110 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,28,28,28,29,
+	30,30,31,32,33,33,33,34,35,35,36,37,38,38,38,39,
+	40,40,41,42,43,43,43,44,45,45,46,47,48,48,48,49,
+	50,51,52,53,54,55,55,56,57,58,59,60,61,62,62,63,
+	64,65,66,67,68,69,69,70,71,72,73,74,75,76,76,77,
+	78,79,80,81,82,83,83,84,85,86,87,88,89,90,91,92,
+	93,94,95,96,97,98,99,100,101,102,103,
+
+	/* 111 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,23,24,25,26,27,28,28,29,29,
+	30,30,31,32,33,33,34,34,35,35,36,37,38,38,39,39,
+	40,40,41,42,43,43,44,44,45,45,46,47,48,48,49,49,
+	50,51,52,53,54,55,56,56,57,58,59,60,61,62,63,63,
+	64,65,66,67,68,69,70,70,71,72,73,74,75,76,77,77,
+	78,79,80,81,82,83,84,84,85,86,87,88,89,90,91,92,
+	93,94,95,96,97,98,99,100,101,102,103,
+
+	/* 112 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	15,16,17,18,19,20,21,22,22,23,24,25,26,26,27,28,
+	28,28,29,30,31,31,32,33,33,33,34,35,36,36,37,38,
+	38,38,39,40,41,41,42,43,43,43,44,45,46,46,47,48,
+	48,49,50,51,52,53,54,55,55,56,57,58,59,60,61,62,
+	62,63,64,65,66,67,68,69,69,70,71,72,73,74,75,76,
+	76,77,78,79,80,81,82,83,83,84,85,86,87,88,89,90,
+	91,92,93,94,95,96,97,98,99,100,101,
+
+	/* 113 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,16,17,18,19,20,21,22,23,23,24,25,26,26,27,28,
+	29,29,29,30,31,31,32,33,34,34,34,35,36,36,37,38,
+	39,39,39,40,41,41,42,43,44,44,44,45,46,46,47,48,
+	49,49,50,51,52,53,54,55,56,56,57,58,59,60,61,62,
+	63,63,64,65,66,67,68,69,70,70,71,72,73,74,75,76,
+	77,77,78,79,80,81,82,83,84,84,85,86,87,88,89,90,
+	91,92,93,94,95,96,97,98,99,100,101,
+
+	/* 114 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,17,18,19,20,21,22,23,24,24,25,26,26,27,28,
+	29,29,29,30,31,31,32,33,34,34,34,35,36,36,37,38,
+	39,39,39,40,41,41,42,43,44,44,44,45,46,46,47,48,
+	49,50,50,51,52,53,54,55,56,57,57,58,59,60,61,62,
+	63,64,64,65,66,67,68,69,70,71,71,72,73,74,75,76,
+	77,78,78,79,80,81,82,83,84,85,85,86,87,88,89,90,
+	91,92,93,94,95,96,97,98,99,100,101,
+
+	/* 115 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,18,19,20,21,22,23,24,25,25,26,26,27,28,
+	29,29,30,30,31,31,32,33,34,34,35,35,36,36,37,38,
+	39,39,40,40,41,41,42,43,44,44,45,45,46,46,47,48,
+	49,50,51,51,52,53,54,55,56,57,58,58,59,60,61,62,
+	63,64,65,65,66,67,68,69,70,71,72,72,73,74,75,76,
+	77,78,79,79,80,81,82,83,84,85,86,86,87,88,89,90,
+	91,92,93,94,95,96,97,98,99,100,101,
+
+	/* 116 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,19,20,21,22,23,24,25,26,26,26,27,28,
+	29,29,30,31,31,31,32,33,34,34,35,36,36,36,37,38,
+	39,39,40,41,41,41,42,43,44,44,45,46,46,46,47,48,
+	49,50,51,52,52,53,54,55,56,57,58,59,59,60,61,62,
+	63,64,65,66,66,67,68,69,70,71,72,73,73,74,75,76,
+	77,78,79,80,80,81,82,83,84,85,86,87,87,88,89,90,
+	91,92,93,94,95,96,97,98,99,100,101,
+
+	/* 117 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,20,21,22,23,24,25,26,27,27,27,28,
+	29,29,30,31,32,32,32,33,34,34,35,36,37,37,37,38,
+	39,39,40,41,42,42,42,43,44,44,45,46,47,47,47,48,
+	49,50,51,52,53,53,54,55,56,57,58,59,60,60,61,62,
+	63,64,65,66,67,67,68,69,70,71,72,73,74,74,75,76,
+	77,78,79,80,81,81,82,83,84,85,86,87,88,88,89,90,
+	91,92,93,94,95,96,97,98,99,100,101,
+
+	/* 118 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,21,22,23,24,25,26,27,27,27,28,
+	29,29,30,31,32,32,32,33,34,34,35,36,37,37,37,38,
+	39,39,40,41,42,42,42,43,44,44,45,46,47,47,47,48,
+	49,50,51,52,53,54,54,55,56,57,58,59,60,61,61,62,
+	63,64,65,66,67,68,68,69,70,71,72,73,74,75,75,76,
+	77,78,79,80,81,82,82,83,84,85,86,87,88,89,90,91,
+	92,93,94,95,96,97,98,99,100,101,102,
+
+	/* 119 */
+	0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+	16,17,18,19,20,21,22,22,23,24,25,26,27,27,28,28,
+	29,29,30,31,32,32,33,33,34,34,35,36,37,37,38,38,
+	39,39,40,41,42,42,43,43,44,44,45,46,47,47,48,48,
+	49,50,51,52,53,54,55,55,56,57,58,59,60,61,62,62,
+	63,64,65,66,67,68,69,69,70,71,72,73,74,75,76,76,
+	77,78,79,80,81,82,83,83,84,85,86,87,88,89,90,91,
+	92,93,94,95,96,97,98,99,100,101,102
+};
+
@@ -0,0 +1,1073 @@
+/* Generated by tools/gen_poly.c (gen_poly mz) - do not edit. */
+
+static const unsigned char poly4tbl[15] = {
+	0x00,0x01,0x01,0x00,0x00,0x01,0x00,0x01,0x00,0x00,0x00,0x00,0x01,0x01,0x01
+};
+
+static const unsigned char poly5tbl[31] = {
+	0x00,0x01,0x01,0x00,0x01,0x00,0x00,0x01,0x01,0x00,0x00,0x00,0x00,0x00,0x01,0x01,
+	0x01,0x00,0x00,0x01,0x00,0x00,0x00,0x01,0x00,0x01,0x00,0x01,0x01,0x01,0x01
+};
+
+static const unsigned char poly9tbl[511] = {
+	0x01,0x00,0x00,0x00,0x01,0x00,0x00,0x00,0x01,0x01,0x00,0x00,0x01,0x00,0x00,0x00,
+	0x01,0x01,0x01,0x00,0x01,0x00,0x01,0x00,0x01,0x01,0x00,0x01,0x01,0x00,0x00,0x00,
+	0x01,0x01,0x01,0x00,0x00,0x00,0x01,0x00,0x00,0x01,0x00,0x01,0x00,0x01,0x00,0x00,
+	0x00,0x01,0x01,0x00,0x01,0x01,0x00,0x00,0x01,0x01,0x01,0x01,0x01,0x00,0x00,0x01,
+	0x01,0x01,0x01,0x00,0x00,0x00,0x01,0x00,0x01,0x01,0x00,0x01,0x01,0x01,0x00,0x00,
+	0x01,0x00,0x01,0x00,0x00,0x01,0x00,0x00,0x00,0x00,0x00,0x01,0x00,0x00,0x01,0x01,
+	0x00,0x00,0x01,0x01,0x01,0x00,0x01,0x00,0x00,0x00,0x01,0x01,0x01,0x01,0x01,0x00,
+	0x01,0x01,0x01,0x01,0x00,0x00,0x00,0x00,0x00,0x01,0x01,0x01,0x01,0x01,0x01,0x01,
+	0x01,0x01,0x00,0x00,0x00,0x00,0x01,0x01,0x01,0x01,0x00,0x01,0x01,0x01,0x00,0x00,
+	0x00,0x00,0x01,0x00,0x01,0x01,0x00,0x00,0x01,0x01,0x00,0x01,0x01,0x00,0x01,0x01,
+	0x01,0x01,0x00,0x01,0x00,0x00,0x00,0x00,0x01,0x01,0x01,0x00,0x00,0x01,0x01,0x00,
+	0x00,0x00,0x00,0x01,0x00,0x00,0x01,0x00,0x00,0x00,0x01,0x00,0x01,0x00,0x01,0x01,
+	0x01,0x00,0x01,0x00,0x01,0x01,0x01,0x01,0x00,0x00,0x01,0x00,0x00,0x01,0x00,0x01,
+	0x01,0x01,0x00,0x00,0x01,0x01,0x01,0x00,0x00,0x00,0x00,0x00,0x00,0x01,0x01,0x01,
+	0x00,0x01,0x01,0x01,0x00,0x01,0x00,0x00,0x01,0x01,0x01,0x01,0x00,0x01,0x00,0x01,
+	0x00,0x00,0x01,0x00,0x01,0x00,0x00,0x00,0x00,0x00,0x00,0x01,0x00,0x01,0x00,0x01,
+	0x00,0x01,0x00,0x01,0x01,0x01,0x01,0x01,0x00,0x01,0x00,0x01,0x01,0x00,0x01,0x00,
+	0x00,0x00,0x00,0x00,0x01,0x01,0x00,0x01,0x01,0x01,0x00,0x01,0x01,0x00,0x01,0x01,
+	0x00,0x01,0x00,0x01,0x01,0x00,0x00,0x00,0x00,0x00,0x01,0x00,0x01,0x01,0x01,0x00,
+	0x01,0x01,0x01,0x01,0x01,0x00,0x00,0x00,0x01,0x01,0x01,0x01,0x00,0x00,0x01,0x01,
+	0x00,0x01,0x00,0x00,0x01,0x01,0x00,0x01,0x00,0x01,0x01,0x01,0x00,0x00,0x00,0x01,
+	0x01,0x00,0x01,0x00,0x00,0x00,0x01,0x00,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x00,
+	0x01,0x00,0x00,0x01,0x00,0x01,0x01,0x00,0x00,0x00,0x01,0x00,0x01,0x00,0x00,0x01,
+	0x01,0x00,0x00,0x00,0x01,0x01,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x01,0x01,0x00,
+	0x00,0x01,0x01,0x00,0x00,0x01,0x00,0x01,0x00,0x01,0x01,0x00,0x00,0x01,0x00,0x00,
+	0x01,0x01,0x01,0x01,0x01,0x01,0x00,0x01,0x01,0x00,0x01,0x00,0x00,0x01,0x00,0x00,
+	0x01,0x00,0x00,0x01,0x01,0x00,0x01,0x01,0x01,0x01,0x01,0x01,0x00,0x00,0x01,0x00,
+	0x01,0x01,0x00,0x01,0x00,0x01,0x00,0x00,0x00,0x00,0x01,0x00,0x01,0x00,0x00,0x00,
+	0x01,0x00,0x00,0x01,0x01,0x01,0x00,0x01,0x01,0x00,0x00,0x01,0x00,0x01,0x01,0x01,
+	0x01,0x00,0x01,0x01,0x00,0x00,0x00,0x00,0x01,0x01,0x00,0x01,0x00,0x01,0x00,0x01,
+	0x00,0x00,0x01,0x01,0x01,0x00,0x00,0x01,0x00,0x00,0x00,0x00,0x01,0x01,0x00,0x00,
+	0x00,0x01,0x00,0x00,0x00,0x00,0x01,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00
+};
+
+static const unsigned char poly17bits[16384] = {
+	0x01,0x10,0x02,0x01,0x14,0x42,0x09,0x10,0x12,0x01,0x35,0x52,0x49,0x31,0x86,0x01,
+	0x14,0x43,0x19,0x12,0x13,0x15,0x77,0x5b,0x59,0x23,0x87,0x34,0x46,0x0a,0x28,0x94,
+	0x12,0x01,0x34,0x42,0x4b,0x30,0x92,0x43,0x1d,0x53,0x0b,0x13,0x26,0x47,0x3e,0x6a,
+	0xdf,0x22,0x93,0x77,0x5f,0x18,0x3b,0x81,0x65,0x5a,0x6d,0x61,0xcc,0x04,0xd4,0x49,
+	0x35,0xc7,0x19,0x12,0x12,0x05,0x75,0x5a,0x4d,0x61,0x8e,0x24,0x54,0x0b,0x1d,0xc6,
+	0x5b,0x30,0xb2,0x43,0x5f,0x73,0x8b,0x51,0x0e,0x46,0x7c,0x48,0x7f,0x64,0xb9,0x5e,
+	0x99,0x28,0xbb,0xe3,0x4d,0x19,0x0f,0xc3,0x2e,0x6a,0xff,0x22,0xd1,0x57,0xdf,0x5a,
+	0x13,0x80,0x27,0x78,0xcd,0x27,0xe6,0x2d,0x12,0x79,0xb5,0xa5,0x31,0x51,0x70,0xa7,
+	0x97,0x34,0x66,0x0a,0x6a,0xb4,0x92,0x43,0x1c,0x43,0x09,0x12,0x32,0x05,0x37,0x7a,
+	0xcd,0x23,0xa6,0x25,0x16,0x29,0xbd,0x80,0x71,0x19,0x74,0x73,0xdf,0x11,0xa3,0x12,
+	0x6c,0xe4,0x9e,0x26,0x54,0x0f,0x5d,0xce,0x5f,0x60,0xba,0x66,0x1f,0x3b,0x8f,0x85,
+	0x46,0x63,0xb9,0x50,0x79,0x34,0xb5,0x3b,0xd1,0x64,0xef,0x3f,0x20,0x7c,0x82,0xdf,
+	0xfc,0x72,0xd6,0x82,0x81,0x1d,0xdb,0x8a,0x1b,0xad,0xe6,0x30,0xc3,0x52,0xaa,0x00,
+	0x5e,0xe1,0xa9,0x5c,0x99,0x2c,0xfb,0xeb,0x49,0x49,0x07,0xe6,0x6e,0x22,0xfb,0xf6,
+	0x99,0x72,0x1a,0x42,0x15,0xd0,0x2b,0x1d,0x85,0x6b,0xb2,0xf1,0x7f,0x1c,0x38,0xb9,
+	0xe3,0x49,0x59,0x07,0xc7,0x7e,0x62,0xda,0x62,0x99,0x53,0x0b,0x12,0x36,0x45,0x3f,
+	0x7e,0x9d,0x2b,0x83,0x65,0x5e,0x2d,0x69,0xc8,0x54,0xdc,0x6c,0x75,0x8f,0x1d,0xc6,
+	0x5a,0x20,0xb0,0x42,0x4b,0x31,0x82,0x41,0x1c,0x47,0x49,0x1a,0x36,0x55,0x3f,0x5f,
+	0x8d,0x6b,0xa2,0xf1,0x5e,0x0c,0x78,0x98,0x77,0x49,0x78,0x16,0x97,0x5d,0xf7,0xce,
+	0x01,0x81,0x13,0x3a,0x86,0x17,0x74,0x6e,0x0f,0x2a,0xbe,0xb6,0x17,0x16,0x4e,0xcd,
+	0x48,0x16,0xf5,0x7d,0x35,0xac,0xa9,0xc2,0x79,0x19,0x64,0x73,0xfe,0x01,0xe3,0x33,
+	0xf8,0xe4,0xbf,0x37,0x04,0x2c,0xc8,0xda,0x3c,0x78,0xfa,0x57,0x8b,0x1a,0xbe,0xd4,
+	0x37,0xd4,0x2c,0x65,0x0b,0x7c,0xd6,0x9f,0x51,0x26,0xc6,0x2e,0x60,0x5f,0x36,0xdb,
+	0xdf,0x4b,0x02,0xb3,0x34,0x2d,0xba,0xf8,0xff,0x0e,0x10,0x1d,0xf1,0x2b,0x5d,0x85,
+	0xef,0xf2,0xf1,0xfa,0x4c,0x3a,0x3d,0xa7,0x09,0xd4,0x53,0x95,0xf2,0x03,0xda,0xa7,
+	0xc9,0xd5,0xcf,0x56,0xf3,0x98,0x69,0xa8,0x55,0x0a,0x0e,0xf4,0x5c,0x27,0xcc,0x8c,
+	0x54,0x51,0xbc,0x67,0x03,0xf9,0x96,0x9d,0xf4,0x72,0xc6,0x82,0xa0,0x0d,0x9b,0xab,
+	0x8f,0xad,0xc7,0x21,0x93,0x71,0x3f,0x14,0x3d,0xf9,0xe9,0x6d,0x0d,0x0d,0xca,0xba,
+	0x38,0xfe,0x92,0xd3,0x1c,0x6a,0x98,0x52,0x19,0x30,0x33,0x53,0x55,0xf3,0x9f,0x19,
+	0xa6,0x52,0x66,0xc0,0xca,0x2c,0x59,0xcb,0x07,0xea,0xaf,0x2a,0xf5,0x07,0x95,0x5f,
+	0xd3,0x8a,0x0b,0xad,0xc7,0x20,0x83,0x73,0x3e,0x00,0x7f,0xf0,0xf9,0x7f,0x0c,0x38,
+	0x98,0xf3,0x09,0x78,0x93,0xc7,0x5f,0x73,0x8a,0x41,0x0c,0x47,0x68,0x0a,0x76,0x74,
+	0xab,0x5f,0xac,0x7a,0xf2,0xd2,0xcb,0x18,0x1b,0x80,0x37,0x78,0xec,0x37,0xa6,0x0c,
+	0x86,0x79,0x94,0xb4,0x61,0x72,0xe5,0xb3,0xf4,0x2c,0x26,0x3b,0xfe,0x95,0xa3,0x12,
+	0x6d,0xf4,0x9c,0x27,0x40,0x4d,0x54,0xde,0x4d,0x61,0x8f,0x34,0x56,0x0a,0x09,0x84,
+	0x52,0x20,0xa0,0x42,0x6a,0x21,0xc2,0x60,0x88,0x47,0x68,0x0b,0x66,0x76,0xaa,0x4b,
+	0xee,0x73,0xe2,0xc0,0xca,0x2d,0x49,0xc9,0x06,0xfe,0xed,0x23,0xe5,0x15,0x94,0x6a,
+	0x81,0xc3,0x3a,0x2b,0xc6,0x34,0xc0,0x6a,0x2c,0x13,0x6a,0x87,0xa2,0x26,0x2f,0xbf,
+	0xac,0xb5,0x03,0x50,0x07,0xd5,0x5e,0x47,0xc8,0x0a,0x3c,0xd5,0x2b,0x17,0x25,0x7f,
+	0xb8,0x79,0xeb,0x44,0x98,0x0d,0xe9,0x8b,0x6c,0xdf,0x2f,0x43,0x6d,0x52,0xfc,0x61,
+	0xe7,0xb5,0x90,0x60,0x28,0x47,0x22,0xaa,0xe6,0x3e,0x23,0x4e,0xa4,0xd8,0xc2,0x9c,
+	0x49,0xa0,0x97,0x3a,0x86,0x16,0x64,0x6c,0x0e,0x3e,0xfc,0xbf,0x07,0x04,0x4f,0xf8,
+	0x1a,0x5f,0xc4,0xfb,0x34,0xb8,0xea,0xdb,0x6b,0x0a,0x71,0x04,0xa5,0x58,0xc0,0xb4,
+	0xcc,0xa2,0xb5,0x1f,0x90,0x3e,0xc9,0xee,0x7e,0x33,0xca,0xc5,0xc8,0x07,0xed,0xdf,
+	0x24,0xf2,0x6b,0x5b,0x61,0xa3,0xf4,0x0c,0x26,0x79,0xde,0x15,0xe1,0x3a,0x6c,0xb6,
+	0xbe,0x87,0x06,0x67,0x7d,0x18,0x7d,0xe1,0xed,0x1c,0x15,0x68,0xab,0x66,0x3c,0x0b,
+	0xcb,0xa6,0xfa,0xe7,0x8a,0x61,0x0d,0x15,0x4a,0x8b,0x20,0x1e,0xa3,0x0d,0x9c,0xdb,
+	0x81,0xaa,0xab,0xef,0xad,0x01,0x41,0x13,0xb6,0x47,0x17,0xfb,0x9f,0x09,0xa6,0x73,
+	0x76,0x80,0xeb,0xb8,0x59,0xea,0x16,0xba,0x8c,0xbf,0xe1,0x64,0x8d,0x1f,0xe2,0x1e,
+	0x2a,0x9c,0x96,0x51,0x34,0xe6,0x0b,0x72,0x37,0x93,0x5d,0xff,0x4e,0x11,0x89,0xb3,
+	0x2a,0xcc,0x97,0xe4,0x66,0xa7,0xbb,0xf4,0x3c,0x26,0x1a,0xee,0xd5,0x82,0x86,0x6d,
+	0xd5,0x8d,0x77,0x63,0xd8,0x40,0xbd,0x55,0x21,0xbe,0xa0,0x77,0x3b,0x58,0xf5,0xe5,
+	0xb5,0x95,0x30,0x22,0x42,0x66,0xe0,0xca,0x6e,0x79,0x4b,0x45,0xc2,0xae,0x68,0xd7,
+	0xa7,0xd3,0x75,0xfa,0x4c,0x3b,0x2d,0xa5,0x08,0xc0,0x11,0x9c,0xe2,0x11,0xdb,0x92,
+	0x9b,0x9c,0xfe,0xd0,0xf2,0x8c,0x2a,0xb1,0x47,0x19,0x1b,0x83,0x07,0x7e,0xef,0x0b,
+	0x60,0x17,0xb6,0x4f,0x97,0xeb,0x97,0xa9,0xb6,0x39,0xf6,0x10,0xe3,0x10,0xc8,0xa0,
+	0x9c,0x8b,0x80,0x1f,0xf9,0xae,0x1d,0x87,0x4a,0xa6,0xf1,0x56,0x8c,0x68,0x90,0xd7,
+	0x59,0x32,0x96,0x07,0x55,0x5f,0x5f,0x4b,0x0b,0x22,0x36,0x26,0x0f,0xbe,0xfe,0x97,
+	0x82,0x06,0x6d,0xdd,0x0c,0x77,0x69,0x79,0x44,0xb5,0xdc,0xa1,0xa4,0x09,0xd3,0x23,
+	0x9b,0xf5,0x6f,0x14,0x99,0xb9,0xab,0xc8,0xdd,0x4d,0x66,0xff,0x3a,0x51,0x66,0xc7,
+	0xba,0x22,0x5e,0xa7,0xc9,0xd4,0xdf,0x54,0xf2,0x8c,0x2b,0xa1,0x45,0x18,0x0f,0xc1,
+	0x0e,0x6e,0xfd,0x0a,0x55,0x45,0xff,0x7e,0x11,0xea,0x83,0xea,0xaf,0x2b,0xe5,0x05,
+	0x94,0x4b,0x91,0x83,0x1b,0xbf,0xc6,0x15,0xd1,0x3a,0x0f,0x86,0x7e,0xe4,0xba,0x66,
+	0x1e,0x2b,0x8d,0x84,0x52,0x21,0xb0,0x40,0x6b,0x35,0x80,0x69,0x98,0x55,0x69,0x3e,
+	0x34,0x3f,0x9b,0xcd,0xef,0x67,0xa1,0xd9,0xd8,0x3e,0x5c,0xbe,0x5d,0xa7,0xce,0xa4,
+	0xd1,0x53,0x9e,0x42,0x15,0xd1,0x3b,0x1f,0x84,0x7f,0xf0,0xf8,0x6f,0x0e,0x39,0x8c,
+	0xb1,0x00,0x68,0x81,0xc6,0x6a,0x21,0xc3,0x70,0x8a,0x46,0x7c,0x49,0x6f,0x66,0xb8,
+	0x4a,0xdb,0x21,0xab,0xf1,0x4c,0x2c,0x5d,0x8a,0x1f,0xec,0xfe,0x36,0x92,0x4e,0xcd,
+	0x49,0x06,0xf7,0x7c,0x21,0xee,0xa0,0xd2,0x6b,0x18,0x51,0x21,0xb7,0x30,0x65,0x32,
+	0xec,0xa7,0xa6,0x25,0x17,0x39,0xbf,0x81,0x65,0x5b,0x7d,0x63,0xcd,0x10,0x96,0x40,
+	0x25,0xd5,0x18,0x27,0x40,0x4c,0x44,0xdc,0x4c,0x75,0xcd,0x3d,0x46,0x18,0x08,0xb1,
+	0x00,0x69,0x91,0xc4,0x6b,0x35,0x81,0x79,0x9a,0x54,0x7d,0x7c,0x3d,0x2f,0x89,0xcc,
+	0xda,0x35,0xe8,0xe8,0x5e,0x3f,0x48,0xfd,0x44,0xb5,0xdd,0xb1,0xa6,0x08,0xc7,0x61,
+	0x92,0xe5,0x7d,0x15,0xac,0xeb,0xe2,0xf9,0x5b,0x4c,0x72,0xbc,0x23,0x43,0x75,0xd2,
+	0xcd,0x79,0x07,0x84,0x4e,0xe0,0x99,0x5e,0xda,0x18,0x39,0xa0,0x71,0x5a,0x44,0xf1,
+	0x9c,0x2d,0xe0,0x59,0x5e,0x56,0xd9,0x39,0x2f,0x80,0x5c,0xc8,0x3c,0x5c,0xba,0x1d,
+	0xaf,0xca,0xf4,0xd9,0x76,0xde,0x0a,0x11,0x05,0x73,0x3a,0x41,0x67,0xf6,0xa8,0x63,
+	0x6b,0x71,0xc0,0xe5,0xdc,0x05,0xe4,0x4b,0x76,0xf3,0xdb,0x59,0x2a,0x16,0x36,0x4d,
+	0xbf,0x6e,0x95,0x8b,0x93,0x2f,0xde,0xbd,0x61,0x60,0xc5,0x96,0xe6,0x44,0x83,0xbd,
+	0xde,0x90,0xb0,0x28,0xea,0xf3,0xea,0x48,0x5b,0x25,0xe3,0x78,0x48,0x76,0xf4,0xab,
+	0x57,0x2d,0x7a,0xf8,0x73,0xcf,0x10,0x92,0x00,0x2d,0xd1,0x48,0x2f,0x65,0x0c,0x0c,
+	0xd8,0x98,0x3d,0xe8,0xf8,0x5e,0x1e,0x58,0xbd,0x65,0x21,0xdd,0x90,0xb7,0x58,0xe4,
+	0xf4,0x86,0x86,0x65,0x55,0x9d,0x7f,0xc3,0xc8,0x0a,0x3d,0xc5,0x29,0x16,0x31,0x3d,
+	0xb1,0x69,0xf9,0x45,0xad,0x5f,0xa0,0xba,0xea,0xde,0x3b,0x00,0x74,0x40,0xef,0x74,
+	0x90,0xee,0xc9,0x43,0xaf,0x73,0x64,0xa0,0xce,0xaa,0x31,0x4f,0x90,0x9a,0x89,0xac,
+	0xdb,0xe3,0x8a,0x69,0x8d,0x05,0x42,0x2b,0x30,0x54,0x23,0x9d,0x94,0x73,0x10,0xe0,
+	0x21,0xde,0xa1,0xa1,0x59,0xd9,0x26,0xdf,0xbf,0x43,0x44,0xc3,0xbc,0x4a,0xd2,0xb1,
+	0xb9,0xf8,0xf8,0x7e,0x1e,0x1a,0x9d,0xe5,0x63,0xf5,0x91,0xf5,0x7a,0x44,0xb2,0xac,
+	0xaf,0xa3,0x65,0x1d,0x1d,0xeb,0x8b,0x68,0x9f,0x27,0x47,0x3d,0x5a,0xd9,0x21,0xaf,
+	0xb1,0x44,0x28,0x0d,0x82,0x3a,0xac,0xb6,0x32,0x46,0x06,0xe8,0x8c,0x1e,0xf1,0x2c,
+	0x2d,0x8b,0xe8,0x9e,0x3f,0xc4,0x3c,0x44,0x3a,0x2c,0xb7,0x2a,0xc5,0x07,0xf6,0x6f,
+	0x13,0xe9,0xb7,0xac,0xa4,0x13,0x73,0x16,0x81,0x3d,0xda,0xd8,0x39,0x2c,0xb0,0x5a,
+	0xcb,0x00,0x9a,0xa1,0x2d,0x99,0xc9,0xab,0x2f,0xad,0x8d,0x80,0x13,0x39,0xb6,0x11,
+	0x77,0x52,0xc9,0x31,0x8e,0x80,0x14,0x49,0xb8,0x16,0x1b,0x9c,0xf7,0x41,0xf0,0x87,
+	0x9f,0xf7,0x46,0x80,0x89,0x98,0x9b,0x88,0xbe,0xf9,0xe6,0x9c,0x03,0x00,0x07,0x70,
+	0x0e,0x07,0x6c,0xce,0x3e,0x70,0x7e,0x07,0x8b,0xbe,0xfe,0x96,0x92,0x04,0x6c,0xc9,
+	0x4e,0x7e,0x79,0x6b,0x45,0x80,0x8e,0xe8,0x95,0x8f,0xd2,0x37,0xd8,0xec,0x7d,0x07,
+	0x8c,0xce,0xf0,0x91,0xfe,0xca,0x52,0xb9,0x30,0x79,0xf2,0xd5,0xbb,0x16,0x1c,0xec,
+	0xf9,0x46,0x9c,0x49,0xa1,0x87,0x38,0x87,0x02,0x26,0x65,0x1e,0x2c,0xfd,0x8a,0x55,
+	0x4d,0x7e,0x7e,0x1b,0x4b,0x87,0xe2,0x26,0xab,0xff,0xac,0x30,0x53,0x52,0x83,0x91,
+	0x1e,0xca,0x9c,0x58,0xb0,0xb4,0x2b,0xd2,0x75,0xf9,0x7c,0x3d,0x2e,0x99,0xce,0xdb,
+	0x21,0xaa,0xe1,0x4e,0x2d,0x49,0xc8,0x16,0xfc,0xec,0x37,0xa7,0x1c,0x84,0x78,0x80,
+	0xf6,0x68,0x62,0xf7,0xb2,0xc1,0x7e,0x6f,0x0a,0x78,0x94,0xb7,0x51,0x74,0xe6,0x8f,
+	0x32,0x37,0x16,0x0d,0xfd,0xca,0x55,0xc9,0x3e,0x7e,0x9e,0x1b,0x85,0x66,0x62,0xeb,
+	0x72,0xf8,0x62,0xdf,0x33,0x83,0x54,0x4e,0x4c,0x58,0x1c,0x75,0x69,0x7d,0x04,0xbd,
+	0xd8,0xf1,0xac,0x2c,0x93,0x6b,0x9f,0x21,0x27,0x31,0x5c,0xa1,0xad,0x98,0xd1,0x28,
+	0x2e,0xb3,0x6e,0x8d,0x0b,0xa2,0x37,0x3e,0x8c,0xbf,0xe0,0x74,0x8f,0x1e,0xf6,0x5c,
+	0x23,0x8c,0x84,0x50,0x01,0xb4,0x42,0x43,0xb1,0x92,0x49,0xbc,0x57,0x03,0x9a,0xa6,
+	0x5d,0x97,0xce,0xc7,0xe1,0x93,0xfd,0xfe,0x14,0xb2,0x08,0xef,0xe1,0xc0,0xcd,0x5d,
+	0x47,0xce,0x6a,0x30,0xd3,0x53,0x9b,0x12,0x1f,0xd4,0x7f,0x55,0xa8,0x2f,0xaa,0xfd,
+	0x8e,0x14,0x55,0x78,0x2f,0x07,0x2c,0xce,0xba,0x30,0x7e,0x82,0xdb,0xbc,0x7a,0xd2,
+	0xd2,0x89,0x38,0x9b,0xc2,0x1f,0x79,0xae,0x15,0x06,0x4a,0xac,0x50,0x52,0x84,0xe1,
+	0x10,0xcd,0xf0,0x96,0x8e,0xc4,0x55,0xd5,0xfe,0x47,0x82,0xab,0xbc,0x9d,0xa2,0x12,
+	0x6f,0xd4,0x98,0x25,0x68,0xc9,0x46,0xfe,0x69,0x63,0xe5,0x90,0xc4,0x68,0x05,0x87,
+	0x7a,0xa6,0x92,0x66,0x4c,0x0b,0x2c,0xd6,0x3a,0x01,0x66,0x62,0xea,0x62,0xfa,0x63,
+	0xcb,0x71,0x8a,0x44,0x5c,0x4d,0x6d,0x4e,0x3c,0x58,0xfb,0x05,0xa9,0x9b,0xe8,0xbe,
+	0x3f,0x86,0x1c,0xc4,0x78,0x04,0xb6,0x68,0xe7,0xa7,0xb0,0x45,0x3a,0x2f,0x87,0x2c,
+	0xc6,0x3b,0x30,0x74,0x23,0xdf,0xb4,0xf3,0x52,0xc8,0x20,0x9c,0x83,0x01,0x1f,0xf3,
+	0x0f,0x19,0x8f,0xc3,0x26,0xeb,0xff,0x28,0x70,0x53,0xd7,0xd3,0x93,0x9a,0x8e,0xdc,
+	0xd5,0xe4,0xe6,0xa7,0xb3,0x75,0x3c,0x2c,0xbb,0xea,0xdd,0x0b,0x06,0x77,0x7c,0x29,
+	0x6f,0xa0,0xd8,0xca,0x1c,0x59,0xa8,0x37,0x2a,0xcc,0x96,0xf4,0x64,0xa6,0xaf,0xb6,
+	0x35,0x36,0x08,0xef,0xe0,0xd0,0xcf,0x5c,0x53,0x8c,0x63,0x20,0xc1,0x52,0xae,0x40,
+	0x56,0xe5,0xf9,0x54,0xbc,0x6c,0xb3,0xef,0x9d,0x01,0x22,0x23,0x76,0x24,0xab,0xfa,
+	0xfc,0x3a,0x56,0x16,0xc9,0xbd,0x4e,0x90,0x99,0xb9,0xaa,0xd8,0xdf,0x4c,0x72,0xbd,
+	0x33,0x41,0x74,0xc6,0x8f,0x70,0x17,0x96,0x4f,0xd5,0xcb,0x17,0xeb,0x9e,0x38,0xb4,
+	0x32,0x43,0x56,0xe2,0x89,0x5a,0xbb,0x00,0x7d,0xd1,0xed,0x7f,0x25,0xa8,0xc8,0xda,
+	0x3d,0x68,0xf8,0x56,0x9f,0x58,0xb7,0xc4,0x25,0xd5,0x19,0x37,0x42,0x4d,0x50,0x9e,
+	0x45,0x65,0xdf,0x3c,0x73,0x4a,0x41,0x80,0x86,0x68,0x85,0x87,0x72,0x27,0x92,0x6c,
+	0xed,0x0f,0x24,0x5f,0xba,0x1b,0xcf,0xc6,0xf2,0xa1,0xfa,0xe9,0x6a,0x7d,0x03,0xcd,
+	0xd6,0xf6,0xc0,0xe2,0xad,0x1b,0xe1,0x26,0xac,0x8f,0xa2,0x37,0x3f,0x9c,0xbd,0xe1,
+	0x60,0xcd,0x17,0xe6,0x4e,0x22,0xb9,0xd6,0x19,0x30,0x32,0x43,0x57,0xf2,0x8b,0x5b,
+	0xaf,0x42,0x74,0xc1,0xff,0x7e,0x10,0xfa,0x81,0xeb,0xbb,0x69,0xec,0x15,0x86,0x4a,
+	0xa4,0xd1,0x52,0x8e,0x40,0x14,0xc5,0x79,0x16,0x94,0x6d,0xf1,0xcd,0x3d,0x47,0x08,
+	0x0a,0xb0,0x14,0x2b,0x98,0xd4,0x79,0x34,0xb4,0x2b,0xd3,0x65,0xfb,0x7d,0x29,0x6c,
+	0x90,0xde,0xc9,0x20,0x9f,0xb3,0x07,0x1c,0xcf,0xc9,0x02,0xbf,0xf5,0x25,0xb4,0x09,
+	0xf3,0x23,0xd9,0xd5,0xef,0x56,0xb1,0xb8,0xe9,0xea,0x7d,0x0b,0x4c,0xd6,0xfc,0x61,
+	0xe6,0xa5,0x92,0x61,0x3c,0x05,0x2b,0xba,0xf4,0x3f,0x16,0x1c,0xed,0xe9,0x44,0x9d,
+	0x5d,0xe3,0x8e,0x28,0x95,0x03,0x13,0x37,0x57,0x1d,0x7b,0x8b,0x41,0x0e,0x67,0x6c,
+	0x08,0x5e,0xf0,0xb9,0x7f,0x88,0x78,0x98,0x76,0x59,0x7a,0x17,0x83,0x1f,0xfe,0xde,
+	0x13,0x80,0x26,0x68,0xcf,0x26,0xf2,0x6f,0x1b,0x69,0xa7,0xa4,0x04,0x03,0x39,0x96,
+	0x11,0x35,0x72,0x49,0x73,0xa6,0x81,0x56,0x6b,0x18,0x50,0x31,0xb5,0x31,0x71,0x70,
+	0xe5,0xb7,0xb4,0x24,0x22,0x6b,0xf6,0xb0,0xe3,0x5a,0x69,0x20,0xd4,0x02,0x85,0x55,
+	0x52,0x8e,0x41,0x04,0xc7,0x78,0x02,0xd6,0x64,0xe1,0xdf,0x3c,0x72,0x5a,0x43,0x81,
+	0x92,0x2a,0x8c,0x97,0x60,0x26,0xa7,0x3e,0xa4,0x3e,0xa2,0x5e,0xae,0x58,0xd6,0xd4,
+	0xe1,0xb4,0x8d,0xb2,0x33,0x5e,0x84,0xf9,0x90,0xfc,0xe8,0x76,0xbf,0x1a,0xd5,0x64,
+	0xe7,0xbf,0x30,0x74,0x22,0xcf,0xb6,0xf2,0x46,0x8a,0x29,0x8c,0x91,0x00,0x2a,0xa1,
+	0x46,0x28,0x09,0xc2,0x32,0xa8,0xe6,0x3a,0x63,0x46,0xa0,0x88,0xca,0xb9,0x09,0xe8,
+	0x93,0xee,0xce,0x33,0xa1,0x74,0x08,0x6e,0xf0,0xda,0x4f,0x48,0x1b,0x24,0x77,0x3a,
+	0x49,0xe7,0xe6,0xa0,0xc3,0x7b,0x3b,0x40,0x75,0xd4,0xad,0x75,0x01,0xfc,0xc2,0xd7,
+	0xf9,0x32,0xdc,0xa6,0xd5,0x17,0xd6,0x4e,0x41,0x89,0x16,0x7a,0x8c,0x33,0x20,0x64,
+	0x02,0xee,0xe4,0x92,0xe7,0x5c,0x01,0xac,0xc2,0x72,0xa9,0x72,0x78,0x62,0xd7,0xb2,
+	0x83,0x5e,0xef,0x48,0x50,0x95,0xf5,0x73,0xd4,0xa0,0xa5,0x1b,0xf1,0x26,0x8d,0x9f,
+	0xe2,0x16,0xab,0x9c,0x9c,0xf0,0x30,0xee,0x82,0xf2,0x2d,0x3a,0xf9,0xe7,0x8d,0x11,
+	0x03,0x12,0x26,0x45,0x1e,0x6e,0xdd,0x0a,0x17,0x65,0x7f,0x3c,0x39,0xeb,0xc1,0xc8,
+	0x0f,0x6d,0xcf,0x2c,0x52,0x7b,0x11,0xe1,0x33,0xfc,0xa4,0xb7,0x33,0x54,0x24,0xed,
+	0x9a,0x74,0x7c,0x2e,0x1f,0xae,0xdf,0xa6,0xd2,0x67,0xd8,0x49,0x2d,0x47,0x28,0x0a,
+	0xf2,0x34,0xab,0xda,0xfc,0x78,0x76,0x96,0x8b,0x95,0x4f,0xd2,0xbb,0x19,0xec,0xf2,
+	0xf6,0x8a,0x42,0x3d,0x51,0x69,0x37,0xa4,0x2d,0x92,0x79,0xbd,0x24,0x31,0x5b,0xd1,
+	0xa3,0x9f,0xbd,0xe6,0x10,0xc3,0x10,0x8a,0x80,0x1c,0xc9,0xa8,0x1e,0xbb,0x8c,0xbd,
+	0xc1,0x60,0x8f,0x37,0x66,0x0c,0x0a,0xb8,0x94,0x3b,0x90,0x74,0x69,0x7e,0x34,0xbb,
+	0xdb,0xcd,0x6a,0x37,0xa3,0x5d,0x9c,0x7e,0xd1,0xea,0x0f,0x2b,0xaf,0xa4,0x14,0x03,
+	0x18,0x86,0x51,0x14,0xe6,0x49,0x52,0xb7,0xd1,0x75,0xfe,0x0c,0x33,0x29,0xf5,0x00,
+	0xe5,0x51,0xd4,0xe6,0xc5,0x93,0xb7,0x5e,0x84,0xf8,0x80,0xfe,0xe9,0x62,0xfd,0x13,
+	0xc5,0x76,0xe6,0x8a,0x62,0x3d,0x13,0x49,0xb7,0xe6,0x05,0x93,0x3b,0x9f,0x84,0x77,
+	0x71,0xf8,0x65,0xaf,0x3d,0x84,0x38,0x80,0x72,0x28,0x62,0x72,0xe2,0xc3,0xfa,0x2b,
+	0x4a,0xf5,0xc0,0xe5,0xdd,0x15,0xe6,0x4a,0x62,0xb1,0xd2,0x49,0x38,0x17,0x03,0x1f,
+	0xf6,0x5f,0x13,0x8a,0x87,0x6c,0xc7,0xaf,0x72,0x75,0xb2,0xcd,0xbf,0x67,0x04,0x89,
+	0x98,0x9a,0x98,0xbc,0xf8,0xf2,0xde,0x0a,0x10,0x15,0x71,0x3b,0x55,0x25,0xff,0xb8,
+	0x71,0x6a,0x44,0x92,0xac,0xed,0x83,0xe5,0x5f,0x35,0xea,0xc9,0x4a,0x3f,0x61,0x6d,
+	0x14,0x9c,0xe9,0xa1,0xcd,0x99,0x07,0x4a,0xaf,0x60,0x54,0x87,0xdd,0xd6,0xd6,0xc0,
+	0xa0,0x8d,0x9b,0xa3,0x0e,0xad,0xcd,0x80,0x97,0x79,0xb6,0x94,0x27,0x50,0x4d,0x75,
+	0xce,0x0d,0x40,0x1b,0x34,0x77,0x1b,0x59,0xa7,0xc7,0x34,0xc3,0x5a,0x2a,0x10,0x56,
+	0x41,0xb9,0x16,0x19,0xbc,0xf3,0x43,0xd8,0x03,0x8d,0xd7,0x62,0x82,0xe3,0x3c,0x09,
+	0xea,0xb2,0xfa,0xce,0x1a,0x31,0x24,0x21,0x5a,0xe0,0xb1,0xde,0x88,0x30,0x19,0xf2,
+	0x13,0xdb,0x96,0xdb,0x94,0xfa,0x80,0xfa,0xa9,0x6a,0xf9,0x43,0xcd,0x53,0xa6,0xc2,
+	0x66,0xe9,0x5b,0x6c,0x72,0xfe,0x03,0xc3,0x37,0xfa,0xcc,0x3b,0x25,0x24,0x08,0xca,
+	0xb0,0x98,0xea,0x98,0x5b,0x88,0x32,0x38,0xe6,0x13,0xf2,0x06,0x8b,0xbd,0xce,0x90,
+	0x91,0x38,0xaa,0xd2,0x7e,0x48,0x7a,0x34,0xb3,0x5b,0xdd,0x62,0x97,0xb3,0x17,0x1c,
+	0xee,0xd9,0x42,0x9e,0x61,0x25,0x95,0x18,0xa3,0x00,0x4c,0xc1,0x8c,0x4e,0xf1,0x89,
+	0x7d,0xcb,0x4c,0x5a,0x3d,0x61,0x69,0x54,0x94,0xed,0xf1,0xc5,0xbc,0x47,0x02,0xab,
+	0xb4,0x1c,0xa2,0x18,0xce,0xd0,0x90,0xac,0xe8,0xd3,0xef,0x5a,0x71,0xa0,0xe5,0x1a,
+	0x65,0x64,0x8c,0x0e,0xf0,0x1d,0x3f,0xca,0xdd,0x48,0x36,0xf5,0x3f,0x15,0x2c,0xeb,
+	0xea,0x78,0x5b,0x46,0xd3,0xb8,0x2b,0xca,0xf5,0xc8,0x64,0xdd,0x1f,0x47,0x4e,0x6a,
+	0x38,0x52,0x53,0x91,0xb3,0x1b,0xdc,0xf6,0xd5,0xb2,0x86,0x0e,0xe5,0x4d,0x14,0xdf,
+	0xd9,0x23,0x8e,0xa5,0x44,0x01,0x9d,0xd2,0x13,0x98,0xa6,0x59,0xd7,0xc6,0xc3,0xb1,
+	0x9b,0xd8,0xbe,0x5c,0xb6,0xdc,0xa7,0xc4,0x05,0xd5,0x5b,0x17,0xc2,0x0f,0x78,0x9f,
+	0x07,0x47,0x7f,0x7a,0x59,0x63,0x87,0xb0,0x06,0x0a,0xad,0xc4,0x10,0x85,0x70,0x02,
+	0xc6,0x64,0xc0,0xcf,0x7c,0x53,0xce,0x43,0xa0,0x83,0x7a,0xaf,0x02,0x74,0x45,0xbf,
+	0x7e,0x95,0xaa,0x83,0x6f,0xff,0x29,0x61,0x41,0xd4,0xc6,0xc5,0xd1,0x97,0xde,0xc6,
+	0xd0,0x81,0xbc,0xcb,0xc2,0xbb,0x39,0xec,0xb0,0xd6,0x0a,0x00,0x15,0x50,0x2b,0x15,
+	0x04,0x6b,0xb8,0x50,0x7b,0x14,0xb1,0x39,0xf9,0xe0,0xfd,0x1f,0x04,0x7e,0xe8,0x7b,
+	0x6e,0x10,0xda,0x81,0xa9,0x9b,0xe9,0xae,0x3d,0x87,0x08,0x86,0x71,0x14,0xa4,0x69,
+	0xd2,0xf5,0xf9,0x74,0xbc,0x2e,0x93,0x6f,0xdf,0x29,0x23,0x61,0x54,0x84,0xed,0xd0,
+	0xd5,0xfc,0x66,0x96,0xab,0x95,0x0d,0xf2,0x3b,0x5b,0xc4,0xf3,0xb4,0xa8,0xe2,0x7b,
+	0x7b,0x40,0xf1,0x94,0xad,0xf0,0x51,0xfe,0x46,0x93,0xb9,0xbf,0x88,0xf4,0x59,0x76,
+	0xd6,0x8b,0x11,0x0f,0xd2,0x3e,0x49,0xee,0x76,0xb2,0xca,0xcf,0x69,0x03,0xe5,0x56,
+	0xa4,0xe8,0xc2,0xff,0x79,0x60,0xf4,0x86,0x87,0x75,0x57,0x9c,0x6b,0x81,0xc1,0x1a,
+	0x2f,0xc4,0x1c,0x44,0x78,0x0c,0x37,0x68,0xed,0x06,0xb4,0x4d,0xb3,0xaf,0x9d,0x85,
+	0x62,0x23,0xf3,0x74,0xa9,0x7e,0xb8,0x7a,0xdb,0x42,0x9b,0x31,0x2f,0x90,0x5c,0xe9,
+	0x2c,0x1c,0x9b,0x89,0xaf,0xeb,0xe5,0x89,0x55,0x4b,0x1e,0x72,0x1d,0x33,0x0b,0xd5,
+	0x46,0xc7,0xf9,0x12,0xdc,0xe4,0xf5,0x97,0x94,0x66,0x40,0xcb,0x34,0xda,0xca,0x19,
+	0x09,0xa2,0x32,0x6e,0x86,0xba,0xa4,0x3e,0xa3,0x4e,0xac,0x59,0xc2,0x96,0xe8,0xa4,
+	0x9f,0xb3,0x06,0x0c,0xcd,0xc8,0x16,0xfd,0xfc,0x35,0xa6,0x08,0xc6,0x71,0x90,0xe4,
+	0x69,0x57,0xa5,0xfb,0xf0,0xf8,0x6e,0x1e,0x3b,0x8d,0xa5,0x42,0x61,0x91,0xd4,0x6b,
+	0x14,0x91,0x39,0xbb,0xc0,0x7d,0x5d,0x2c,0x7f,0xaa,0x59,0xce,0x56,0xf0,0xa8,0x6f,
+	0xab,0x69,0xcc,0x15,0xc4,0x6a,0x24,0x93,0x7a,0x8f,0x02,0x36,0x65,0x3f,0x3c,0xbd,
+	0xab,0xc1,0x4d,0x5f,0x6f,0x4b,0x68,0x12,0xf6,0x45,0xb3,0xbf,0x9d,0xa4,0x72,0x63,
+	0xd2,0xe0,0xa9,0x5f,0xa9,0x2a,0xf8,0xd7,0x8f,0x52,0x37,0xd0,0x6d,0x7d,0x0d,0x2d,
+	0xca,0xf8,0x18,0x7e,0xd0,0xfb,0x1d,0x28,0xba,0xf2,0x5f,0x1a,0x1a,0x95,0x65,0x73,
+	0xfd,0x31,0xe5,0x30,0xc4,0x22,0xa4,0x07,0x32,0x2f,0x97,0x2c,0xe7,0x2b,0x70,0x55,
+	0xb7,0xdf,0x95,0xe2,0x02,0xeb,0xb5,0x88,0xe0,0x19,0x5f,0xc2,0x9b,0x38,0xbe,0x92,
+	0x57,0x5c,0x6a,0x1d,0x02,0x1b,0xb4,0x77,0x13,0xd8,0xa7,0xcd,0x95,0xc7,0x52,0xa3,
+	0x90,0x4c,0xe8,0x1d,0x0e,0xda,0xbc,0x79,0xe2,0xd4,0x8a,0x04,0x5d,0xd9,0x2f,0x4f,
+	0xad,0x4a,0xf0,0x91,0xff,0xda,0x50,0xb8,0x24,0x3b,0xfb,0xc5,0xa9,0x17,0x29,0xbe,
+	0xb0,0x77,0x1a,0x48,0xb5,0xc4,0x21,0x95,0x11,0x33,0x12,0x45,0x75,0xde,0x0d,0x61,
+	0x0b,0x74,0x56,0x8f,0x59,0x86,0xd6,0x64,0xe0,0xcf,0x3e,0x73,0x4e,0x01,0x88,0x82,
+	0x38,0x8d,0xa2,0x32,0x6f,0x96,0xb8,0xa5,0x2a,0xe1,0x47,0xbc,0x4b,0xc3,0xa3,0xba,
+	0xed,0xae,0x35,0x07,0x18,0x8e,0xd1,0x04,0xee,0xe9,0x42,0xfd,0x51,0xe5,0xf6,0xa4,
+	0xa2,0x63,0x7f,0x31,0xe9,0xf1,0xcc,0x2c,0x55,0x0b,0x1f,0xe6,0x5f,0x32,0x9a,0xc7,
+	0x4d,0x53,0xaf,0x53,0x64,0xe2,0xee,0x2a,0x73,0x67,0x91,0xd8,0xab,0x0c,0x9d,0xc9,
+	0xa3,0xaf,0xbd,0x85,0x20,0x03,0x73,0x36,0x81,0x7f,0xfa,0x58,0x7b,0x04,0xb1,0x18,
+	0xe9,0xa0,0xdc,0x8b,0x04,0x5f,0xf9,0x2b,0x4d,0x85,0xce,0xe2,0xb1,0xdb,0xd8,0x3a,
+	0x1c,0xb6,0x59,0xf7,0xc6,0x81,0x91,0x1b,0x9a,0x96,0x5d,0xf4,0xfe,0x07,0x82,0x2f,
+	0xfc,0x9d,0x27,0x42,0x6d,0x50,0xdc,0x65,0xe5,0x9d,0x14,0x72,0x08,0x63,0x20,0xc0,
+	0x42,0xac,0x41,0x42,0xa7,0xf0,0x44,0xae,0x6d,0x86,0xbd,0xd4,0x30,0xa4,0x22,0x62,
+	0x67,0xb2,0xe8,0xef,0x2f,0x21,0x4d,0x90,0x9e,0xc9,0xa4,0xdf,0xb3,0x82,0x4c,0xcd,
+	0x4d,0x46,0xff,0x78,0x71,0xe6,0x85,0x92,0x23,0x1c,0x85,0x69,0x92,0xf5,0x7d,0x34,
+	0xbc,0xab,0xc3,0x6d,0x5b,0x6d,0x63,0xec,0x00,0xd6,0x61,0xb1,0xd5,0x39,0x36,0x10,
+	0x6f,0xd1,0xc8,0x2f,0x6d,0x8d,0x0c,0xd2,0x39,0x39,0xe0,0x71,0xde,0x04,0xf1,0x19,
+	0x7d,0xe2,0xdd,0x1a,0x16,0x54,0x6d,0x7d,0x0c,0x3d,0xc8,0xf9,0x0c,0x3c,0xd9,0xeb,
+	0x0f,0x29,0x8f,0xa0,0x16,0x2b,0x9c,0x94,0x71,0x30,0xe4,0x23,0xf6,0x25,0xb3,0x79,
+	0xfd,0x24,0xb5,0x1b,0xd1,0x26,0xcf,0xbf,0x62,0x54,0x83,0x9d,0xde,0xd2,0x90,0xa8,
+	0xa8,0xdb,0xeb,0x0a,0x79,0x85,0xa5,0x52,0x61,0xb0,0xc4,0x2b,0x35,0x05,0x39,0x9a,
+	0xd1,0x2d,0x7e,0xb9,0x6b,0xc9,0x41,0x8e,0x67,0x64,0x89,0x5e,0xfa,0x18,0x7b,0x80,
+	0xf1,0x18,0x6c,0xf0,0xde,0x0f,0x40,0x1f,0x74,0x7f,0x1f,0x09,0xaf,0xe2,0x74,0x8b,
+	0x5e,0xfe,0x58,0x73,0x84,0xa1,0x10,0x49,0xb0,0x96,0x0b,0x94,0x57,0x51,0xba,0x07,
+	0x0f,0xff,0xee,0x11,0xc3,0x12,0xaa,0x84,0x1e,0xe1,0x2c,0x0c,0x9b,0xa8,0xbf,0xab,
+	0xc4,0x1d,0x55,0x6a,0x0f,0x22,0x3e,0xa6,0x1f,0xb6,0x5e,0x87,0xc8,0x86,0xfd,0xd5,
+	0xa4,0xe6,0x23,0xf3,0x75,0xb9,0x7c,0xb9,0x6e,0x99,0x4b,0x8b,0x23,0x2e,0xa5,0x0e,
+	0xa0,0x1d,0x9a,0x9a,0x9d,0xec,0xf2,0xf7,0x9a,0x40,0x3c,0x45,0x2b,0x3e,0xb4,0x3f,
+	0x93,0x4c,0xef,0x6d,0x00,0xdd,0xd0,0xb7,0xdc,0xa4,0xf4,0x03,0xd6,0x67,0xd1,0xd9,
+	0x3f,0x4e,0x9c,0x58,0xb1,0xa4,0x29,0xd3,0x61,0xbb,0x75,0x2d,0x3c,0x98,0xfb,0x89,
+	0x68,0x9b,0x67,0x4f,0x39,0x0a,0xd1,0x04,0xef,0xf9,0x40,0xfc,0x45,0xa7,0xff,0xb4,
+	0xb0,0x62,0x4a,0x63,0xa0,0xc0,0x4a,0x2d,0x41,0x48,0x06,0xf4,0x4c,0x27,0xed,0x9c,
+	0x14,0x70,0x28,0x67,0x22,0xe8,0xc6,0xbe,0x61,0x66,0xa5,0x9a,0xe0,0x3c,0x0f,0x8a,
+	0xbe,0xfc,0xb6,0x96,0x06,0x44,0x4d,0x5c,0x5e,0x5d,0x69,0x2f,0x24,0x1c,0x8a,0x99,
+	0x8c,0xfa,0xb1,0xea,0xc8,0x5b,0x2d,0x62,0x78,0x42,0xd7,0xf0,0xa3,0xde,0xad,0x60,
+	0x51,0xd7,0xd7,0xd3,0x92,0x8a,0x8c,0xdd,0xc1,0xa6,0xef,0xb7,0xa1,0x74,0x09,0x7e,
+	0xf2,0xdb,0x5b,0x0a,0x12,0x34,0x65,0x3b,0x7c,0xb5,0xaf,0x91,0x45,0x7a,0x2f,0x03,
+	0x6c,0xc6,0xbe,0x60,0x76,0xa7,0x9b,0xf4,0x7e,0x06,0x9a,0xac,0xfd,0x83,0xc4,0x4f,
+	0x75,0xcb,0x5d,0x4a,0x1e,0x70,0x3d,0x37,0x09,0xfd,0xc2,0xd5,0xd9,0x36,0xde,0x8e,
+	0x51,0x05,0xf6,0x6a,0x43,0xe3,0xb2,0xe8,0xee,0x3f,0x23,0x4c,0x84,0xdc,0xc0,0xb4,
+	0xcd,0xb2,0xb7,0x1e,0x84,0x7c,0xc0,0xfe,0x6c,0x32,0xff,0x97,0x81,0x36,0x6b,0xde,
+	0x30,0xb1,0x72,0x49,0x72,0xb6,0x83,0x57,0x7f,0x5a,0x59,0x21,0xa7,0x30,0x44,0x22,
+	0xac,0x86,0x32,0x25,0x36,0x28,0xef,0xa2,0xf0,0x4f,0x1e,0x7b,0x8d,0x21,0x02,0x61,
+	0x14,0x84,0x69,0x90,0xd5,0x79,0x36,0x94,0x2f,0xd1,0x4d,0x7f,0x6f,0x09,0x48,0x92,
+	0xb4,0x6d,0xb2,0xfd,0xbf,0x04,0x34,0x49,0xfb,0x26,0x99,0xdf,0xcb,0x02,0xbb,0xb5,
+	0x2d,0xb0,0x59,0xfb,0x06,0x99,0x9d,0xeb,0x82,0xf9,0x9d,0x2c,0xf2,0x7b,0x5b,0x40,
+	0xb3,0xb4,0x2d,0xb2,0x79,0xff,0x04,0xb1,0x19,0xf9,0xa2,0xdd,0x9f,0x46,0x56,0xe9,
+	0x39,0x4c,0xb0,0x9c,0xab,0x80,0x5d,0xd9,0x2e,0x5f,0xaf,0x4b,0xe4,0xd3,0xf6,0xca,
+	0x42,0xb9,0x11,0x69,0xb2,0xf4,0x2f,0x16,0x3d,0xfd,0xa9,0x65,0x09,0x5d,0xc2,0x9f,
+	0x78,0xb6,0x96,0x07,0x54,0x4f,0x5d,0x4a,0x1f,0x60,0x3f,0x36,0x1d,0xbf,0xcb,0xc5,
+	0xcb,0x37,0xeb,0xdc,0x18,0x34,0x70,0x6b,0x57,0xa0,0xab,0xfa,0xfd,0x2a,0x54,0x17,
+	0xdd,0xff,0x47,0x80,0x8b,0xb8,0x9f,0x8a,0x96,0x7d,0xf4,0xbc,0x27,0x02,0x6d,0xd4,
+	0x9c,0x65,0x60,0xcd,0x16,0xf6,0x4c,0x23,0xad,0x94,0x10,0x20,0x20,0x42,0x62,0xa0,
+	0xc2,0x6a,0x29,0x43,0x60,0x82,0xe6,0x6c,0x03,0xef,0xf6,0xb0,0xe2,0x4a,0x6b,0x21,
+	0xc0,0x40,0x8c,0x45,0x40,0x8f,0x74,0x56,0x8e,0x49,0x84,0xd7,0x70,0xa2,0xc6,0x2e,
+	0x61,0x4f,0x34,0xda,0xcb,0x09,0x0b,0xa3,0x26,0x2c,0x8f,0xaa,0xb6,0x3f,0x96,0x1c,
+	0xe5,0x68,0x44,0x97,0xfc,0xe7,0x86,0xa1,0x15,0x19,0xba,0x93,0x4f,0xde,0x7b,0x01,
+	0xe0,0x02,0xee,0xe5,0x82,0xe5,0x5d,0x15,0xee,0xcb,0x62,0xbb,0x73,0x4d,0x30,0x9e,
+	0x83,0x05,0x5f,0xfb,0x0b,0x49,0x87,0xe6,0x66,0xa3,0xfb,0xfc,0x38,0x76,0x12,0xcb,
+	0x95,0xca,0x82,0xb9,0x9d,0xa8,0xb2,0x7b,0xde,0x10,0xb1,0x30,0x69,0xf2,0xf4,0xab,
+	0x56,0x3d,0x78,0xf9,0x67,0x8d,0x19,0x82,0x12,0x2c,0xe4,0x1a,0x66,0x54,0x8a,0x0d,
+	0xcc,0xdb,0x24,0xfa,0xeb,0x4b,0x69,0x03,0xe4,0x46,0xa6,0xe9,0xd6,0xbd,0x70,0x70,
+	0xe6,0x87,0xb2,0x27,0x1e,0xad,0xed,0x80,0xd5,0x59,0x36,0xd6,0x0f,0x51,0x0f,0x57,
+	0x6e,0x4b,0x6a,0x32,0xf2,0x47,0x9b,0x3b,0x8f,0x84,0x56,0x61,0xb8,0x44,0x3b,0x3d,
+	0xa5,0x29,0xd0,0x51,0xbd,0x76,0x11,0xfa,0x83,0xcb,0xbf,0x6b,0xc4,0x91,0x94,0x6a,
+	0x80,0xd3,0x38,0x2a,0xd2,0x76,0xc9,0x7a,0x3e,0x12,0x5f,0xd5,0xeb,0x17,0xa9,0xbe,
+	0xb8,0xf6,0x1a,0x42,0x14,0xc0,0x29,0x1c,0x91,0x29,0xbb,0xe1,0x6d,0x1d,0x0d,0xeb,
+	0xaa,0x78,0xdf,0x06,0xd3,0x3d,0x7b,0xc8,0x71,0x8c,0x24,0x50,0x4b,0x15,0xc2,0x0b,
+	0x38,0x97,0x03,0x17,0x77,0x5f,0x19,0x2b,0x83,0x64,0x4e,0x2f,0x68,0xdc,0x16,0xd5,
+	0x7c,0x67,0x8e,0x28,0x94,0x13,0x11,0x36,0x43,0x5f,0x72,0x9b,0x53,0x0f,0x52,0x3e,
+	0x41,0x6f,0x76,0xb8,0x6b,0xcb,0x61,0x8a,0x65,0x4c,0x0d,0x4c,0xda,0x3c,0x79,0xea,
+	0x55,0x8a,0x0e,0xfc,0xdd,0x27,0xc6,0x2d,0x50,0x59,0x35,0xe7,0x19,0x50,0x32,0x85,
+	0x37,0x72,0x4c,0x23,0xac,0x84,0x12,0x21,0x34,0x00,0x6b,0xb0,0xd0,0x6b,0x1c,0x11,
+	0x29,0xb3,0x60,0x6d,0x17,0xac,0xef,0xa2,0xf1,0x5f,0x1c,0x7a,0x99,0x63,0x0b,0x71,
+	0x06,0x85,0x5c,0xc2,0x9c,0x48,0xb0,0x95,0x3b,0x92,0x54,0x6d,0x7c,0x1c,0x3f,0xc9,
+	0xed,0x4e,0x35,0xc9,0xf9,0x0e,0x1c,0xdd,0xe9,0x27,0xad,0x9d,0x80,0x32,0x29,0xf6,
+	0x30,0xe3,0x52,0xe8,0x20,0xde,0xa3,0x81,0x5d,0xdb,0x0e,0x5b,0xad,0x63,0x60,0xc1,
+	0xd6,0xee,0x40,0xd3,0xb5,0xfb,0xd0,0xf8,0x2c,0x3e,0xbb,0xcf,0x8d,0x43,0x23,0xb3,
+	0x74,0x2d,0x3e,0xb8,0xff,0x8b,0x40,0x1f,0x75,0x6f,0x1d,0x08,0xbb,0xa0,0x7d,0x9b,
+	0x4c,0xff,0x6d,0x21,0xcd,0x90,0x96,0x48,0xa4,0xd5,0x12,0x86,0x44,0x44,0xcd,0x5c,
+	0x56,0xdc,0x69,0x25,0x85,0x18,0x82,0x10,0x0c,0xe0,0x18,0x4e,0xd0,0x98,0x2d,0xe8,
+	0xd9,0x4e,0x5e,0x79,0x29,0x65,0x00,0xcc,0xc0,0x94,0xcd,0xf0,0x97,0x9e,0xc6,0x54,
+	0xc1,0xbc,0x4e,0x92,0xb9,0xbd,0xa8,0xf0,0x5b,0x5e,0x52,0x99,0x31,0x2b,0xd0,0x54,
+	0xed,0x7c,0x14,0xbe,0xc9,0xe7,0xef,0x31,0xc1,0x70,0x8e,0x06,0x74,0x4d,0x3f,0x6e,
+	0x9d,0x0a,0x93,0x25,0x7f,0xb9,0x69,0xe9,0x45,0x8c,0x4f,0xe0,0x9b,0x7e,0xde,0x1a,
+	0x11,0x24,0x63,0x7a,0x60,0xf3,0xf6,0x89,0x72,0x3b,0x52,0x55,0xf1,0xbf,0x1d,0xa4,
+	0x7a,0xe2,0xd2,0xea,0x08,0x5b,0xa1,0xa3,0x78,0xcd,0x26,0xf6,0x2f,0x13,0x6d,0xf7,
+	0xac,0x21,0x43,0x71,0x92,0xc5,0x7d,0x57,0x8c,0x6b,0xa0,0xd1,0x5a,0x0e,0x50,0x1c,
+	0x65,0x69,0x5c,0x14,0xfd,0xf9,0x65,0xac,0x0d,0x82,0x3b,0xbc,0xb4,0x33,0x52,0x44,
+	0xe1,0x9c,0x0c,0xf0,0x19,0x7f,0xc2,0xd9,0x18,0x3e,0xd0,0x7f,0x5d,0x28,0x3f,0xa2,
+	0x5d,0x9e,0x5e,0xd5,0xe8,0x27,0xaf,0xbd,0x84,0x30,0x01,0x72,0x22,0xc3,0x76,0xea,
+	0x4a,0x7a,0x31,0xe3,0x51,0xd8,0x26,0xdd,0x9f,0x47,0x46,0xeb,0x38,0x58,0xf2,0x95,
+	0xbb,0x92,0x5c,0xec,0x7c,0x16,0x9e,0xcd,0xe5,0xc7,0xb5,0xd3,0x50,0xaa,0x04,0x1e,
+	0xe9,0xad,0x0c,0x91,0x09,0xbb,0xa3,0x4d,0x9d,0x4f,0xc3,0xab,0x3a,0xfd,0xa6,0x95,
+	0x17,0x52,0x0e,0x41,0x0c,0x46,0x78,0x08,0x77,0x60,0xe9,0x56,0xbc,0x68,0xf3,0xe7,
+	0x99,0x51,0x2a,0x06,0x36,0x6c,0xaf,0x2e,0xb4,0x1f,0x93,0x0e,0xcf,0xed,0x42,0xf5,
+	0xd1,0xf5,0xfe,0x04,0xb2,0x29,0xff,0xa1,0xe1,0x59,0x5d,0x66,0xdf,0x3a,0x13,0x46,
+	0x47,0xf8,0x0a,0x5f,0xe5,0xeb,0x74,0x99,0x7e,0xdb,0x4a,0x1b,0x21,0x27,0x30,0x4c,
+	0xa3,0xac,0x8c,0x93,0x21,0x3e,0xa1,0x6f,0xb8,0x59,0xeb,0x06,0xb8,0x8d,0xab,0xa3,
+	0x6d,0x9d,0x0d,0xe3,0x2b,0x78,0xd5,0xa7,0xd7,0x35,0xf2,0x48,0x6b,0x25,0x80,0x48,
+	0x88,0x15,0x48,0xaa,0x34,0x1e,0x8a,0x9d,0xcc,0xf2,0xb5,0xba,0xc0,0x7e,0x6d,0x2a,
+	0x7c,0x96,0x9f,0xd5,0x66,0xc6,0xab,0x30,0x5d,0xb2,0x9f,0x9f,0xc6,0x56,0xe1,0xb8,
+	0x4c,0xba,0x3d,0xaf,0x88,0xd4,0x59,0x34,0xf6,0x0b,0x53,0x27,0xd3,0x7c,0x6b,0x4e,
+	0x30,0x98,0xe3,0x09,0x59,0x83,0x87,0x7e,0xe7,0x8a,0x60,0x1d,0x17,0x4b,0x9f,0x62,
+	0x17,0xb3,0x1f,0x9d,0xee,0xd3,0xe3,0x9a,0x69,0xac,0x15,0x02,0x0a,0xa4,0x54,0x02,
+	0x8c,0xc4,0x50,0x85,0xf4,0x42,0xc6,0xe1,0x90,0xcd,0xf8,0x17,0x8e,0xce,0xf4,0xd1,
+	0xf6,0xce,0x02,0xb1,0x15,0x39,0xba,0xd1,0x6f,0x5e,0x39,0x29,0xe1,0x40,0xcc,0x45,
+	0xc4,0xcf,0x74,0xd3,0xde,0x4b,0x00,0x93,0x30,0x2f,0x92,0x7c,0xed,0x2e,0x34,0x1f,
+	0x9b,0x8f,0xcf,0xe7,0xe3,0xf1,0xd9,0x7c,0x7e,0x1e,0x1b,0x8d,0xe7,0x62,0xe1,0xd3,
+	0xfc,0x6a,0x56,0xb3,0x99,0xfd,0xea,0x54,0x9b,0x1c,0xff,0xc8,0x71,0x8d,0x34,0x52,
+	0x4a,0x01,0x80,0x02,0x28,0x85,0x02,0x22,0x25,0x16,0x28,0xad,0x82,0x70,0x0d,0x36,
+	0x7a,0xcf,0x03,0xa2,0x27,0x3e,0xad,0xaf,0xa0,0x55,0x1b,0x1e,0xd7,0x4d,0x73,0xaf,
+	0x11,0x44,0x62,0xac,0x02,0x72,0x25,0xb3,0x78,0xed,0x26,0xb4,0x0f,0x93,0x2f,0xdf,
+	0xad,0x63,0x61,0xd1,0xd4,0xef,0x54,0x91,0xbc,0xeb,0xc2,0xf9,0x19,0x6c,0xf2,0xfe,
+	0x0b,0x42,0x37,0xf0,0x6d,0x3f,0x2d,0xad,0x88,0xd0,0x19,0x3c,0xf2,0x5b,0x5b,0x02,
+	0x93,0x34,0x6f,0x9a,0x78,0xbd,0x26,0x11,0x5f,0xd3,0x8b,0x1b,0xaf,0xc6,0x34,0xc1,
+	0x7a,0x2e,0x12,0x7e,0xc5,0xab,0x36,0x3d,0xbe,0x99,0xe7,0x4a,0x61,0x81,0xd4,0x4a,
+	0x04,0xd1,0x18,0x2f,0xc0,0x5c,0x4c,0x7c,0x5c,0x3f,0x4d,0xad,0x4e,0xb0,0x99,0xfb,
+	0x8a,0x58,0x9d,0x64,0x73,0xff,0x11,0xe1,0x32,0xec,0xa6,0xb6,0x27,0x16,0x2d,0xfd,
+	0x88,0x75,0x49,0x7c,0x56,0x9f,0x59,0xa7,0xc6,0x24,0xc1,0x5b,0x3e,0x52,0x5f,0x51,
+	0xab,0x17,0x2c,0xee,0xba,0x72,0x5e,0x02,0x99,0x94,0x7b,0x90,0xf0,0x29,0x7e,0xb1,
+	0xeb,0xd9,0x49,0x2e,0x77,0x2e,0x09,0xce,0xf2,0xb0,0xea,0xca,0x7b,0x29,0x60,0x50,
+	0xc6,0xc5,0xd0,0x87,0xdc,0xc7,0xc4,0xc3,0xb5,0xdb,0xd0,0xba,0x0c,0xbe,0xf9,0xe7,
+	0x8c,0x01,0x01,0x13,0x32,0x07,0x17,0x7e,0xcf,0x0b,0x22,0x37,0x36,0x0d,0xbf,0xea,
+	0xd5,0x8b,0x16,0x7f,0xdc,0x39,0x25,0x20,0x48,0xc2,0xb4,0xc8,0xe2,0xbd,0x1b,0xc0,
+	0x36,0xec,0xae,0x36,0x37,0x1e,0x8d,0xed,0xc2,0xf5,0xd9,0x74,0xfe,0x0e,0x13,0x2d,
+	0xf7,0x28,0x61,0x43,0xf4,0xc2,0xc7,0xf9,0x13,0xcc,0xe6,0xf4,0x83,0xd6,0x6f,0x50,
+	0xd9,0x35,0xef,0x98,0x50,0x38,0x24,0x33,0x7a,0xc5,0xa3,0xb6,0x2d,0xb6,0x39,0xf7,
+	0x00,0xe1,0x11,0xdc,0xe2,0x95,0x9b,0x92,0x1e,0xcc,0xfc,0x54,0xb6,0xcc,0xa7,0xe5,
+	0x15,0x95,0x7a,0x83,0xc2,0x2e,0x69,0xcf,0x24,0xd2,0x6b,0x19,0x41,0x23,0xb6,0x24,
+	0x27,0x3b,0xfc,0xb5,0xa7,0x10,0x45,0x70,0x8e,0x07,0x64,0x4f,0x3e,0x7a,0xdf,0x03,
+	0x83,0x37,0x7e,0x8c,0x3b,0xa0,0x74,0x0a,0x4e,0xf4,0xd8,0x67,0xcc,0x09,0x04,0x53,
+	0x38,0x23,0x43,0x74,0xc2,0xcf,0x78,0x13,0xc6,0x47,0xf0,0x8b,0x5f,0xef,0x4a,0x70,
+	0x91,0xf7,0x5b,0x50,0xb2,0x85,0x3f,0xf3,0x4c,0x29,0x0d,0x80,0x1a,0xa8,0xb4,0x1a,
+	0xc2,0x14,0xc8,0xa8,0x1c,0x9b,0x88,0xbf,0xe9,0xe4,0x9d,0x17,0x42,0x0e,0x60,0x1c,
+	0x06,0x59,0x9c,0x77,0x41,0xf8,0x06,0x9f,0xfd,0xe7,0x84,0x81,0x11,0x1b,0x92,0x17,
+	0x5d,0xfe,0x5f,0x03,0x8a,0xa6,0x7c,0x87,0x8e,0xe6,0x75,0x93,0xdc,0xef,0x44,0x91,
+	0x9d,0xfb,0x82,0xd8,0x8d,0x6c,0xd3,0xef,0x5b,0x61,0xa2,0xe4,0x0e,0x27,0x6d,0x9c,
+	0x1c,0xf1,0x28,0x6d,0x83,0xec,0xce,0x37,0xe1,0x7c,0x0c,0x3e,0xf8,0xff,0x0f,0x00,
+	0x1f,0xf0,0x3f,0x1f,0x8c,0xff,0xe0,0xf0,0xcf,0x1e,0x73,0x0c,0x21,0x08,0xc0,0x10,
+	0x8c,0xe0,0x10,0xcf,0xd0,0x92,0x8c,0xec,0xd1,0xc7,0xde,0x63,0x80,0xc1,0x18,0x0f,
+	0xc0,0x1e,0x6c,0xfc,0x1e,0x17,0x4c,0xef,0x6c,0x10,0xdf,0xd1,0xa3,0x9e,0xad,0xe4,
+	0x11,0xd7,0x52,0x83,0x90,0x0e,0xc8,0x9d,0x4c,0xf2,0xbd,0x3b,0xc0,0x74,0xcc,0x2e,
+	0x74,0x1f,0x1f,0xcf,0xcf,0x62,0xb3,0xf3,0x5d,0x38,0x3e,0x93,0x4f,0xdf,0x6b,0x03,
+	0xe1,0x16,0xac,0xec,0x92,0xf7,0x5c,0x20,0xbc,0x82,0x53,0x3d,0x72,0x59,0x73,0x87,
+	0x91,0x16,0x4a,0x8c,0x50,0x10,0xa4,0x61,0x52,0xe5,0xf1,0xd4,0xac,0x64,0x13,0xff,
+	0xd7,0x81,0xb2,0x2b,0xde,0xb5,0xe1,0x70,0xcd,0x36,0xf6,0x0e,0x03,0x2d,0xd6,0x38,
+	0x21,0x62,0x60,0xc2,0xe6,0xe8,0x43,0xef,0x73,0xe0,0xe0,0xce,0x2f,0x61,0x4d,0x14,
+	0xde,0xc9,0x21,0x8f,0xb1,0x06,0x08,0x8d,0xc0,0x12,0xad,0xf4,0x10,0xe6,0x40,0xc2,
+	0xa5,0xd8,0xc1,0xac,0x4f,0xa3,0xab,0xfc,0x9d,0x26,0x52,0x6f,0x51,0xc8,0x27,0xec,
+	0x8d,0x06,0x73,0x3d,0x31,0x69,0xf1,0xc4,0xad,0x55,0x01,0xbe,0xe2,0x57,0xbb,0x1a,
+	0xdd,0xe4,0xf7,0xb7,0x90,0x64,0x68,0x4f,0x26,0xfa,0xee,0x1b,0x63,0x06,0xa0,0x0c,
+	0x8a,0xb9,0x8c,0xb8,0x91,0x6a,0x8a,0x73,0x2c,0x20,0x5a,0xe2,0x91,0xda,0x8a,0x18,
+	0x9d,0xe0,0x33,0xff,0x94,0xb1,0x30,0x68,0xe2,0xf6,0xaa,0x42,0x7f,0x71,0xe9,0x75,
+	0x8c,0x2c,0xd0,0x5b,0x1d,0x62,0x1b,0x72,0x17,0x93,0x1f,0xdf,0xce,0x53,0xa1,0xb2,
+	0x68,0xee,0x37,0xa2,0x4c,0x8e,0x7d,0xc4,0xbc,0x44,0x32,0xad,0xb7,0x20,0x64,0x03,
+	0xfe,0xe6,0x93,0xf3,0x1e,0x08,0xbc,0xd0,0x73,0x9c,0x20,0x31,0x53,0x51,0xb3,0x97,
+	0x1d,0xf6,0x5a,0x43,0x80,0x82,0x28,0x8d,0x83,0x22,0x2f,0xb7,0x2c,0xa5,0x0b,0xf0,
+	0x17,0x9f,0xde,0xd7,0xc0,0xa2,0xad,0x9f,0xa1,0x26,0x29,0xdf,0xa0,0xb3,0x7b,0xdc,
+	0x30,0xb5,0x32,0x41,0x76,0xe6,0x8b,0x72,0x3f,0x12,0x5d,0xf5,0xef,0x15,0x81,0x3a,
+	0xaa,0xd6,0x3e,0x40,0x7e,0x64,0xbb,0x7e,0x9d,0x2a,0x93,0x67,0x5f,0x39,0x2b,0xc1,
+	0x44,0xce,0x6d,0x40,0xdd,0x54,0xf7,0xdc,0x21,0xa4,0x01,0x52,0x23,0x91,0x54,0x6b,
+	0x1c,0x10,0x39,0xb1,0x61,0x79,0x55,0xa5,0xff,0xb0,0xf0,0x6a,0x4e,0x33,0xa8,0xe5,
+	0x0a,0x65,0x45,0x9c,0x4e,0xd1,0x89,0x3f,0xeb,0xcc,0x18,0x15,0x60,0x2b,0x76,0x34,
+	0xab,0xdb,0xec,0x7a,0x77,0x82,0xc9,0x9c,0x5f,0xc0,0xba,0x2c,0xbe,0xbb,0xc7,0x0c,
+	0x43,0x29,0x12,0x70,0x25,0xb7,0x38,0xe5,0x22,0xe4,0x07,0xb6,0x6f,0x97,0xa9,0xb7,
+	0x29,0xf4,0x11,0xf7,0x52,0xc1,0xb0,0x8e,0x8a,0xb5,0x4d,0xb0,0x9f,0x9b,0x86,0x5e,
+	0xe5,0xe8,0x44,0x9f,0x7d,0xe7,0x8c,0x00,0x11,0x11,0x33,0x13,0x55,0x77,0xdf,0x19,
+	0x23,0x02,0x64,0x44,0x8e,0x6c,0xd4,0x9f,0x55,0x66,0xce,0x2a,0x30,0x57,0x13,0x9b,
+	0x97,0x4f,0xd6,0xfb,0x11,0xe8,0xa2,0xfe,0xaf,0x02,0x75,0x55,0xbd,0x7f,0x81,0xe8,
+	0x8a,0x7f,0xed,0x28,0x54,0x13,0x9d,0xf7,0x43,0xd0,0x83,0x9d,0xdf,0xc2,0x92,0xa9,
+	0xbc,0x99,0xe2,0x1a,0x6b,0x84,0x90,0x00,0x28,0x81,0x42,0x2a,0x21,0x46,0x20,0x88,
+	0xc2,0x38,0x09,0xe2,0x32,0xea,0xc6,0xba,0x21,0x6e,0xa1,0xca,0xe8,0x19,0x4f,0xc2,
+	0xba,0x28,0xfe,0xb3,0xc3,0x5c,0x4b,0x0c,0x52,0x38,0x21,0x63,0x70,0xc0,0xe7,0xfc,
+	0x01,0xe6,0x63,0xf2,0xe1,0xfb,0x7d,0x28,0x7c,0x92,0xdf,0xdd,0x62,0x96,0xa3,0x15,
+	0x1d,0xfa,0x9b,0x4b,0x8e,0x73,0x24,0xa0,0x4a,0xea,0x31,0xca,0xc0,0x98,0x0d,0xe8,
+	0x9b,0x6e,0xde,0x3b,0x01,0x64,0x42,0xee,0x60,0xd2,0xe7,0xd9,0x51,0xae,0x46,0x36,
+	0xe9,0xff,0x2c,0x30,0x5b,0xd3,0x83,0x9b,0xbf,0xce,0x94,0xd1,0x30,0xae,0x82,0x76,
+	0x6d,0x3a,0x7c,0xb7,0x8f,0x95,0x47,0x52,0xab,0x11,0x4c,0xe2,0xbc,0x0a,0xd2,0x35,
+	0xf9,0xf8,0x7d,0x2e,0x1c,0x9e,0xd9,0xa5,0xee,0xa1,0xc3,0x79,0x1b,0x44,0x77,0xfc,
+	0x29,0x67,0x21,0xd8,0xc0,0xbd,0x5d,0xa0,0xbe,0xaa,0xd6,0x3f,0x50,0x7c,0x65,0xaf,
+	0x3c,0x94,0x3a,0x81,0x66,0x6a,0x6b,0x62,0xf0,0xc2,0xcf,0x79,0x03,0xc4,0x46,0xe4,
+	0xc9,0x56,0xff,0x58,0x71,0xa4,0xa5,0x12,0x61,0x34,0x84,0x2b,0xb0,0x55,0x3b,0x1e,
+	0x95,0x6d,0xf3,0xed,0x39,0x45,0x20,0x8e,0xa2,0x34,0x0f,0x9a,0xbe,0xdd,0xa6,0xd6,
+	0x27,0xd0,0x4d,0x7d,0x4f,0x0d,0x4a,0xba,0x30,0x7f,0x92,0xd9,0xbd,0x6e,0x90,0xdb,
+	0x99,0x2a,0x9a,0xf7,0x4d,0x30,0x9f,0x93,0x07,0x5e,0xef,0x49,0x40,0x97,0xf4,0x67,
+	0x96,0xa9,0xb5,0x09,0xf0,0x13,0xdf,0xd6,0xd3,0x90,0xaa,0x88,0xdf,0xe9,0x22,0xfd,
+	0x97,0x85,0x76,0x63,0xda,0x60,0xb9,0x57,0x09,0x3a,0xb2,0x57,0x1f,0x5a,0x9f,0x41,
+	0x27,0xf7,0x3c,0x21,0x6a,0xe0,0xd2,0xee,0x48,0x53,0xa5,0xf3,0x70,0xe8,0x66,0xbe,
+	0x2b,0xc7,0x25,0xd2,0x69,0x39,0x45,0x21,0x9e,0xa0,0x35,0x1b,0xd8,0xb7,0xcd,0xb4,
+	0xd7,0x12,0x82,0x04,0x4c,0xc9,0x0c,0x5e,0xf9,0x29,0x6d,0x81,0xcc,0xca,0x35,0xc9,
+	0xf8,0x1e,0x1e,0xdc,0xfd,0x65,0xa4,0x8d,0x92,0x33,0x1c,0xa4,0x79,0xd2,0xd4,0xe9,
+	0x34,0x9d,0xba,0x93,0x4e,0xce,0x79,0x00,0xf4,0x40,0xe7,0xf5,0x90,0xe4,0x68,0x47,
+	0xa7,0xfa,0xe4,0xba,0x67,0x0e,0x29,0x8c,0x90,0x10,0x28,0xa0,0x52,0x6a,0x00,0xd2,
+	0x20,0xa9,0xd3,0x68,0x2a,0x77,0x26,0x89,0xde,0xfa,0x10,0xfa,0x80,0xfb,0xb9,0x68,
+	0xf8,0x57,0x8f,0x5a,0xb6,0xd0,0x67,0xdc,0x09,0x25,0x43,0x78,0x02,0xd7,0x74,0xe3,
+	0xde,0x28,0x30,0x53,0x53,0x93,0x93,0x1f,0xde,0xde,0x51,0xa0,0xa6,0x2a,0xe7,0x27,
+	0xb0,0x4d,0xbb,0x2f,0x8d,0x8d,0xc2,0x33,0xb9,0xf4,0x39,0x76,0x10,0xeb,0x91,0xc8,
+	0xaa,0x3d,0x8f,0x88,0x96,0x79,0xb4,0xb4,0x23,0x52,0x65,0xf1,0xdc,0x2d,0x64,0x19,
+	0x5e,0xd3,0x89,0x3b,0xab,0xc4,0x1c,0x45,0x68,0x0e,0x36,0x7c,0xaf,0x0f,0xa4,0x5f,
+	0xb2,0x9a,0xcf,0xcc,0x53,0xa5,0xf2,0x60,0xea,0x67,0xaa,0x69,0xce,0x35,0xc0,0x68,
+	0x0c,0x17,0x68,0xaf,0x26,0x34,0x0f,0x9b,0xae,0xdf,0xa7,0xc2,0x65,0xd9,0x5d,0x6f,
+	0x4e,0x38,0x18,0xf3,0x01,0xf9,0x93,0xcd,0xfe,0x77,0x82,0xc8,0x8c,0x5d,0xc1,0xae,
+	0x6e,0xb7,0xab,0xd5,0x0d,0x76,0x7b,0x5b,0x41,0xa3,0xb6,0x2c,0xa6,0x3b,0xf6,0x14,
+	0xa3,0x18,0xcc,0xf0,0x94,0xae,0xc0,0x57,0xfd,0x7a,0x55,0xa2,0x8f,0xbe,0xf7,0x06,
+	0x80,0x0d,0xd8,0x9b,0x0d,0xee,0xfb,0x62,0xd8,0x43,0x8d,0x53,0x22,0x82,0x66,0x6c,
+	0x0b,0x6e,0xf6,0xba,0x43,0x4e,0x63,0xa8,0x40,0x5a,0x25,0xe1,0x58,0x4c,0x74,0xdc,
+	0x2f,0x45,0x0d,0x5e,0xfa,0x19,0x6b,0x82,0xf0,0x0c,0x2e,0xf9,0xce,0x1d,0x41,0x2a,
+	0x26,0x36,0x2e,0x8f,0xae,0xf6,0x37,0x92,0x4c,0xed,0x4d,0x04,0xdf,0xf8,0x33,0xce,
+	0x84,0xd0,0x01,0xbc,0xc3,0x43,0xbb,0x33,0x4d,0xb4,0xde,0x83,0x80,0x0f,0xf9,0x8f,
+	0x0d,0xc7,0x6b,0x32,0xf1,0x77,0x9d,0x38,0xb3,0x42,0x4d,0x51,0x8e,0x47,0x64,0xcb,
+	0x7e,0x7a,0x5a,0x53,0x81,0xb3,0x3a,0xcc,0xb6,0xf4,0x26,0x86,0x2f,0xf4,0x1d,0x37,
+	0x4a,0xcd,0x40,0x96,0xe5,0x75,0x95,0xbc,0xe3,0x42,0xe9,0x11,0xcc,0xe2,0xb4,0x8b,
+	0xd2,0x3f,0x58,0xfc,0x75,0xa7,0x9c,0x84,0x70,0x01,0xf6,0x62,0xc3,0xf3,0xba,0x48,
+	0xfe,0x75,0xa3,0xdc,0x8c,0x74,0x51,0xfe,0x47,0x83,0xbb,0xbe,0x9c,0xb6,0x50,0x66,
+	0xc4,0x8a,0x24,0x5d,0x9b,0x0f,0xcf,0xef,0x62,0xf1,0xd3,0xdd,0x7a,0x16,0x92,0x0d,
+	0xfd,0xcb,0x45,0xcb,0x3f,0x6a,0xdc,0x12,0x95,0x74,0x63,0xde,0x20,0xb1,0x53,0x59,
+	0x32,0x97,0x17,0x57,0x5e,0x4b,0x09,0x02,0x32,0x24,0x27,0x3a,0xec,0xb7,0xa6,0x04,
+	0x07,0x79,0x9e,0x15,0x65,0x7a,0x6c,0x33,0xee,0x85,0x82,0x23,0x3d,0x95,0x29,0xb3,
+	0x61,0x7d,0x15,0xad,0xfb,0xe0,0xf8,0x4f,0x0e,0x7b,0xac,0x31,0x42,0x40,0x80,0x84,
+	0x48,0x81,0x85,0x5a,0xa3,0x80,0x4c,0xc9,0x0d,0x4e,0xfb,0x28,0x79,0xc3,0xc5,0xda,
+	0x27,0xc8,0xcd,0x4c,0x57,0xed,0x7b,0x64,0xb0,0xce,0x8b,0x21,0x0f,0xb1,0x0e,0x89,
+	0x8d,0xca,0xb3,0xa9,0xfc,0x99,0x66,0x5a,0x6b,0x01,0xc0,0x02,0xac,0xc5,0x02,0xa7,
+	0x75,0x14,0xac,0xe9,0xc2,0xfd,0x59,0x64,0xf6,0xae,0x03,0x67,0x77,0xb8,0x69,0xeb,
+	0x65,0x88,0x4d,0xc8,0x1f,0x6c,0xfe,0x3e,0x13,0x4e,0xc7,0xe8,0x02,0xff,0xf5,0xa1,
+	0xf4,0x09,0x76,0x73,0xdb,0x51,0xab,0x16,0x3c,0xec,0xbb,0x66,0x1c,0x0b,0x89,0x86,
+	0x7a,0xa5,0xa2,0x60,0x4f,0x37,0xea,0xcd,0x0a,0x37,0x65,0x3d,0x1c,0xb9,0xa9,0xe9,
+	0xc9,0x4d,0x4f,0x6f,0x6a,0x78,0x52,0xd7,0xd1,0xb3,0x9e,0x8c,0xf4,0x51,0xf6,0xc6,
+	0x83,0xb1,0x1f,0x98,0xbe,0xd9,0xe6,0xde,0x23,0x80,0x45,0x58,0x0f,0x45,0x4e,0x6e,
+	0x78,0x5a,0x57,0xc1,0xbb,0x3e,0x9c,0xbe,0xd1,0x66,0xce,0x2b,0x20,0x55,0x12,0x8f,
+	0xd5,0x46,0xc6,0xe9,0x10,0xdd,0xf0,0xb7,0x9e,0x84,0x74,0x41,0xfe,0x66,0x93,0xfb,
+	0x9f,0x08,0xb6,0x71,0x77,0x94,0xa9,0xb1,0x49,0xf8,0x17,0x8f,0xde,0xf6,0xd0,0xe2,
+	0x8c,0x0b,0xa1,0x07,0x38,0x8f,0x83,0x26,0x6f,0xbf,0x28,0xf5,0x03,0xd5,0x57,0xd7,
+	0xda,0x03,0x88,0x87,0x68,0x87,0xa7,0x76,0x25,0xba,0xe8,0xff,0x2f,0x00,0x5d,0xd0,
+	0xbf,0x5d,0xa4,0xfe,0xa2,0xd2,0x6f,0x58,0x59,0x25,0xe7,0x38,0x40,0x72,0xa4,0xa3,
+	0x72,0x6d,0x32,0xfc,0xa7,0x87,0x35,0x57,0x18,0x2b,0x81,0x44,0x4a,0x2d,0x40,0x58,
+	0x04,0xf5,0x58,0x65,0xe4,0x8c,0x06,0x71,0x1d,0x35,0x6b,0xd9,0x40,0xbf,0x75,0x25,
+	0xbc,0x88,0xf3,0x29,0x78,0xd1,0xe7,0xdf,0x31,0xa2,0x40,0x4e,0x65,0xc8,0x4c,0x5c,
+	0x5d,0x6d,0x6f,0x2c,0x18,0xda,0x91,0xa9,0xba,0xf9,0xee,0x1c,0x13,0x08,0xa7,0x60,
+	0x44,0x87,0xfc,0xc6,0x96,0xe1,0x34,0x8d,0xba,0xb2,0x5e,0x8e,0x58,0x94,0xf4,0x61,
+	0xf6,0xa5,0xb3,0x71,0x7c,0x24,0xbf,0xba,0xd5,0x2e,0x46,0x3f,0x78,0xfd,0x27,0x85,
+	0x1d,0xd2,0x1a,0x09,0xa4,0x52,0x62,0x80,0xc2,0x28,0x09,0xc3,0x22,0xaa,0xe7,0x2e,
+	0x21,0x4f,0xb0,0x9a,0xcb,0x8c,0x5b,0xa1,0xa2,0x68,0xcf,0x27,0xe2,0x6d,0x1a,0x7d,
+	0xe5,0xad,0x14,0x11,0x38,0xa3,0x43,0x7c,0x43,0xcf,0x72,0xb2,0xc2,0x4f,0x79,0x0b,
+	0x45,0x46,0xee,0x68,0x52,0xf7,0xd1,0xf1,0xbe,0x0c,0xb6,0x79,0xf7,0x84,0xa1,0x11,
+	0x59,0xb2,0x97,0x1f,0xd6,0x5e,0x41,0xa8,0x06,0x3a,0xad,0xa7,0x20,0x45,0x13,0xbe,
+	0xc7,0x07,0xf3,0x3f,0x19,0xec,0xf3,0xe6,0x88,0x43,0x29,0x13,0x60,0x27,0xb6,0x2c,
+	0xa7,0x2b,0xf4,0x15,0xb7,0x5a,0xc5,0xe0,0x86,0xaf,0xf5,0x05,0xb4,0x4b,0xd3,0xa3,
+	0x9b,0xfd,0xee,0x14,0x93,0x18,0xaf,0xc0,0x54,0xcd,0x7c,0x56,0x9e,0x49,0xa5,0xc7,
+	0x30,0x83,0x52,0x2e,0x40,0x5e,0x64,0xf9,0x5e,0x1d,0x68,0xbb,0x66,0x1d,0x1b,0x8b,
+	0x87,0x6e,0xe7,0xab,0x70,0x5d,0x36,0xdf,0x9f,0x43,0x06,0xe3,0x3c,0x08,0xfa,0xb0,
+	0xfb,0xda,0x58,0x38,0x34,0x33,0x5b,0xd5,0xe3,0x97,0xb9,0xb6,0x18,0xe6,0x50,0xc2,
+	0x84,0xc8,0x81,0x8d,0xdb,0xa3,0x8a,0xed,0xcd,0x05,0xc7,0x7b,0x32,0xd0,0x67,0xdd,
+	0x19,0x27,0x42,0x6c,0x40,0xde,0x64,0xf1,0xdf,0x1d,0x62,0x1a,0x62,0x15,0x92,0x0b,
+	0x9d,0xc7,0x43,0xb3,0xb3,0x5d,0xbc,0x7e,0x93,0xca,0x8f,0x69,0x87,0xa5,0x56,0x21,
+	0xb8,0xc0,0x7b,0x3d,0x20,0x79,0xd2,0xd5,0xf9,0x36,0x9c,0xae,0xd1,0x47,0xde,0x6b,
+	0x01,0xc1,0x12,0xae,0xc4,0x16,0xe5,0x7c,0x04,0xbe,0xe8,0xf7,0xaf,0x10,0x55,0x70,
+	0xaf,0x17,0x24,0x6e,0xaa,0x7a,0xfe,0x12,0xd3,0x14,0xeb,0x98,0x58,0xb8,0x34,0x3b,
+	0xda,0xd5,0xe9,0x36,0xbd,0xbe,0x91,0x66,0x4a,0x6b,0x20,0xd0,0x42,0x8d,0x51,0x02,
+	0x86,0x64,0x44,0x8f,0x7c,0xd6,0x9e,0x41,0x24,0xc7,0x3a,0x22,0x56,0x26,0xc9,0xde,
+	0x7e,0x50,0xfa,0x05,0xab,0xbb,0xec,0xbc,0x17,0x02,0x0e,0xe4,0x5c,0x06,0xdc,0xcc,
+	0x75,0xc5,0xbc,0x46,0x12,0xa9,0xb5,0x08,0xe0,0x11,0xde,0xc2,0x91,0x99,0xba,0x9a,
+	0xde,0xdc,0x70,0xb4,0xa6,0x03,0x77,0x77,0x99,0x79,0xab,0x44,0x1c,0x4d,0xe9,0x0e,
+	0x3c,0xdd,0xab,0x07,0x2d,0xdf,0xa8,0x33,0x6b,0xd4,0x90,0xa5,0x78,0xc1,0xe6,0xee,
+	0x23,0xe3,0x75,0x98,0x6c,0xf9,0x4f,0x0d,0x4b,0xaa,0x32,0x7e,0x86,0x9b,0xb4,0x7e,
+	0x82,0xda,0xac,0x78,0xd3,0xc6,0xcb,0x31,0x8b,0xd0,0x1e,0x4c,0xfc,0x5c,0x37,0xcc,
+	0xad,0x44,0x11,0x9d,0xf3,0x03,0xd8,0x87,0xcd,0xd7,0xe7,0xd2,0xe1,0xb8,0x4d,0xaa,
+	0x3f,0xae,0x9c,0x96,0x50,0x24,0xe4,0x0a,0x66,0x75,0x9a,0x4d,0xed,0x4f,0x24,0xdb,
+	0xfa,0x1b,0x4a,0x96,0xf0,0x25,0xbe,0xa9,0xe7,0x29,0x51,0x41,0xb7,0xf6,0x05,0xb2,
+	0x2b,0xdf,0xa5,0xe3,0x71,0xd9,0x74,0xff,0x1e,0x11,0x2c,0xe3,0x6a,0x68,0x53,0xe6,
+	0xc3,0xf2,0xab,0x5a,0xfd,0x60,0xf5,0x97,0x95,0x76,0x42,0xca,0x20,0x98,0xc3,0x09,
+	0x1b,0xa3,0x07,0x3c,0xcf,0x8b,0x22,0x3f,0xb7,0x0d,0xb5,0x4b,0xd1,0x83,0x9f,0xff,
+	0xc6,0x90,0x81,0x38,0x8b,0xc2,0x3e,0x69,0xee,0x34,0x92,0x4a,0x8d,0x41,0x02,0xa7,
+	0x74,0x04,0xae,0xe8,0xd6,0xbf,0x50,0x74,0xe4,0xaf,0x36,0x35,0x3e,0x89,0xef,0xea,
+	0x71,0xcb,0x54,0xda,0x0c,0x79,0x89,0x65,0x4a,0x6d,0x40,0xdc,0x44,0xf5,0xdd,0x35,
+	0xe6,0x08,0x42,0x31,0x90,0x61,0x39,0x55,0x21,0xbf,0xb0,0x75,0x3a,0x4c,0xb7,0xec,
+	0xa5,0x87,0x31,0x17,0x10,0x2f,0xd1,0x4c,0x6f,0x6d,0x08,0x5c,0xd0,0xbd,0x7d,0xa0,
+	0xfc,0x8a,0x56,0x7d,0x78,0x7d,0x27,0x8d,0x9c,0xd2,0x10,0xa8,0xa0,0x5a,0xeb,0x00,
+	0xd8,0x81,0xad,0xdb,0xe1,0xaa,0x6d,0x8f,0x2d,0xc6,0x39,0x10,0x70,0x21,0xf7,0x30,
+	0xe1,0x72,0xec,0x22,0xf6,0x27,0x93,0x7d,0xff,0x0c,0x31,0x09,0xf1,0x02,0xcd,0xd5,
+	0xc6,0xc6,0xe1,0x91,0xdd,0xfa,0x16,0x9a,0x8c,0xfd,0xc1,0xe4,0xcf,0x37,0xe3,0x5c,
+	0x08,0x3c,0xd0,0x7b,0x1d,0x20,0x3b,0xf2,0x55,0xbb,0x1e,0x9d,0xec,0xf3,0xe7,0x98,
+	0x41,0x28,0x07,0x22,0x2e,0xa6,0x3e,0xa6,0x1e,0xa6,0x5c,0x86,0xdc,0xc4,0xf4,0xc5,
+	0xb6,0xe7,0x16,0xa1,0x3c,0x88,0xfa,0xb8,0x7a,0xda,0x52,0x99,0x30,0x3b,0xd2,0x55,
+	0xf9,0x3e,0x1d,0xae,0xdb,0xe6,0xda,0x63,0x88,0x41,0x08,0x07,0x60,0x0e,0x26,0x7c,
+	0x8e,0x1f,0xe4,0x7e,0x26,0x9a,0xee,0xdd,0x03,0x86,0x67,0x74,0x89,0x7f,0xea,0x58,
+	0x5a,0x14,0xf1,0x39,0x7d,0xa0,0xfd,0x9a,0x54,0x7c,0x6c,0x3f,0x2e,0x9d,0x8e,0xd3,
+	0x25,0xfa,0xe9,0x6b,0x6d,0x01,0xcc,0xc2,0xb4,0xc9,0xf2,0xbf,0x1a,0xd4,0x74,0xe5,
+	0xbe,0x24,0x36,0x2b,0xdf,0xa4,0xf3,0x73,0xd8,0x60,0xbd,0x17,0x01,0x3e,0xe2,0x5f,
+	0x3a,0x1a,0xd7,0x45,0xf3,0xbf,0x19,0xe4,0x72,0xe6,0x82,0xe2,0x2d,0x1b,0xe9,0xa7,
+	0xac,0x85,0x03,0x33,0x37,0x15,0x3d,0xfb,0xc9,0x69,0x0f,0x25,0x4e,0xa8,0x18,0xda,
+	0x90,0xb9,0xb8,0xf8,0xfa,0x5e,0x1a,0x18,0xb5,0x61,0x71,0xd5,0xb5,0xf7,0x10,0xe0,
+	0x20,0xce,0xa3,0xa0,0x4d,0x9b,0x2f,0xcf,0xad,0x42,0x71,0x91,0xf5,0x7b,0x54,0xb0,
+	0xad,0xbb,0xe1,0x6c,0x0d,0x0f,0xea,0xbe,0x3a,0xd6,0x16,0xc1,0x3c,0x4e,0x9a,0x38,
+	0xbd,0xa2,0x51,0x5f,0x56,0xdb,0x19,0x2b,0x82,0x74,0x4c,0x2e,0x7c,0x9e,0x1f,0xc5,
+	0x6e,0x66,0xbb,0x7a,0xdd,0x22,0x97,0x37,0x57,0x1c,0x6b,0x89,0x40,0x1a,0x25,0x65,
+	0x18,0x4c,0xf1,0x8c,0x2d,0xc1,0x49,0x1e,0x77,0x4d,0x39,0x0e,0x91,0x0c,0xeb,0xa9,
+	0x48,0xd9,0x05,0xef,0xfb,0x60,0xf8,0x47,0x8f,0x7b,0xa6,0x90,0x46,0x48,0x09,0x04,
+	0x52,0x28,0x21,0x42,0x60,0x80,0xc6,0x68,0x01,0xc7,0x72,0xa2,0xc2,0x6e,0x69,0x4b,
+	0x64,0xd2,0xee,0x49,0x43,0xa7,0xf2,0x64,0xaa,0x6f,0xae,0x39,0xc6,0x10,0x80,0x20,
+	0x08,0xc3,0x20,0x8a,0xe3,0x2c,0x09,0xcb,0xa2,0xba,0xef,0x8e,0x31,0x05,0x30,0x0a,
+	0xc3,0x24,0xca,0xeb,0x28,0x59,0xc3,0x87,0xfa,0xa7,0x8a,0xe5,0x4d,0x15,0xcf,0xdb,
+	0x22,0x9a,0xe7,0x4d,0x11,0x8f,0xd3,0x26,0xca,0xef,0x68,0x51,0xc7,0xd7,0xf2,0x82,
+	0xca,0xad,0x49,0xc1,0x87,0xfe,0xe7,0x82,0xe1,0x1d,0x1d,0xea,0x9b,0x6a,0x9e,0x33,
+	0x05,0x34,0x4a,0xcb,0x20,0x9a,0xe3,0x0d,0x19,0x8b,0x83,0x2e,0xef,0xaf,0x20,0x55,
+	0x13,0x9f,0xd7,0x47,0xd2,0xab,0x19,0xcd,0xe2,0xb6,0xab,0xd6,0x3d,0x70,0x78,0x67,
+	0x87,0xb8,0x86,0x1a,0xa5,0x64,0x00,0xcf,0xf0,0x92,0xce,0xcc,0x51,0x85,0xf6,0x62,
+	0xc2,0xe3,0xb8,0x49,0xea,0x37,0xaa,0xcc,0x9e,0x75,0x64,0xac,0x0e,0xb2,0x3d,0xbf,
+	0x88,0xf5,0x49,0x74,0xd7,0x9f,0x53,0x06,0xc2,0x2c,0x48,0xdb,0x24,0xfb,0xfb,0x49,
+	0x68,0x17,0xa6,0x4f,0xb6,0xfb,0xd7,0x88,0x22,0x39,0xd7,0x01,0xb3,0x33,0x5d,0xb4,
+	0xff,0x93,0xc0,0x2e,0x6d,0x8f,0x2c,0xd6,0x3b,0x11,0x64,0x63,0xfe,0x20,0xf3,0x73,
+	0xd9,0x70,0xbf,0x16,0x15,0x7c,0xeb,0x4f,0x28,0x1b,0xe2,0x17,0xba,0x8e,0x9f,0xe5,
+	0x66,0xa5,0x9b,0xf0,0x3e,0x0e,0x9e,0xfc,0xf5,0xa6,0x84,0x07,0x71,0x1f,0x15,0x6f,
+	0xdb,0x68,0x3b,0x67,0x05,0x98,0x8a,0x99,0x8d,0xea,0xb3,0xeb,0xdc,0x19,0x24,0x72,
+	0x6a,0x43,0xe2,0xa2,0xea,0xef,0x2b,0x61,0x45,0x94,0xce,0xc1,0x81,0x9f,0xfb,0x86,
+	0x98,0x85,0x68,0x83,0xe7,0x7e,0x21,0xea,0xe0,0xda,0x6f,0x48,0x59,0x04,0xf7,0x78,
+	0x61,0xe6,0xa4,0x82,0x63,0x3d,0x11,0x69,0xb3,0xe4,0x2d,0x17,0x29,0xbf,0xa0,0x75,
+	0x1b,0x5c,0xf7,0xcd,0x31,0x87,0x10,0x06,0x40,0x0c,0x44,0x58,0x0c,0x75,0x48,0x6d,
+	0x44,0x9c,0x4c,0xf1,0x8d,0x3d,0xc3,0x48,0x0a,0x35,0x44,0x29,0x1c,0x90,0x39,0xb9,
+	0xe0,0x79,0x5f,0x04,0xfb,0xb8,0x79,0xea,0x54,0x9a,0x0c,0xfd,0xc9,0x65,0xcf,0x3d,
+	0x42,0x58,0x00,0xb5,0x50,0x61,0xb4,0x84,0x23,0x31,0x55,0x31,0xbf,0x91,0x65,0x7a,
+	0x6d,0x23,0xec,0x84,0x96,0x61,0x34,0x85,0x3b,0xb2,0x54,0x2f,0x5c,0x9c,0x7d,0xe1,
+	0xec,0x0c,0x17,0x69,0xbf,0x24,0x35,0x1b,0xd9,0xa7,0xcf,0xb5,0xc3,0x50,0x8b,0x14,
+	0x5e,0xc8,0x39,0x0c,0xb0,0x18,0xeb,0x80,0xd8,0x89,0x2c,0xdb,0xeb,0x0b,0x69,0x87,
+	0xa4,0x46,0x23,0xb9,0xd4,0x39,0x34,0x30,0x6b,0xd3,0xe0,0xab,0x7f,0xad,0x28,0xd0,
+	0x53,0x9d,0x72,0x13,0xd2,0x07,0xd9,0x9f,0x4f,0xc6,0xfb,0x30,0xf8,0xe2,0xdf,0x3b,
+	0x02,0x54,0x44,0xed,0x5c,0x14,0xfc,0xe9,0x67,0xad,0x19,0xc0,0x32,0xac,0xa6,0x32,
+	0x67,0x16,0xa8,0xad,0x8a,0xf1,0x0d,0x3c,0xdb,0xcb,0x0b,0x2b,0xa7,0x24,0x04,0x0b,
+	0xb8,0x96,0x1b,0x94,0x76,0x41,0xfa,0x26,0x9b,0xff,0xcf,0x00,0x93,0x31,0x3f,0x90,
+	0x7d,0xf9,0x6c,0x3d,0x0f,0x89,0x8e,0xfa,0xb5,0xaa,0xc0,0x5f,0x7d,0x6a,0x5d,0x02,
+	0x9f,0xf4,0x77,0x96,0x88,0xa5,0x49,0xd1,0x87,0xdf,0xf7,0xc2,0xc0,0x89,0x1d,0xcb,
+	0x8a,0x3a,0xbd,0xa6,0x11,0x57,0x52,0x8b,0x11,0x0e,0xc2,0x3c,0x48,0xfa,0x34,0xbb,
+	0xda,0xdd,0x68,0x36,0xb7,0x1f,0x95,0x6e,0xc3,0xeb,0x3a,0x79,0xe6,0x95,0x92,0x02,
+	0x0c,0xc5,0x48,0x06,0xf5,0x5c,0x25,0xec,0x88,0x56,0x79,0x38,0x75,0x23,0xdd,0x94,
+	0xf7,0x50,0xe0,0xa4,0x8e,0xa3,0x25,0x1d,0x99,0xab,0x8b,0xed,0xcf,0x25,0xc3,0x79,
+	0x1a,0x54,0x75,0xfd,0x3d,0x25,0x28,0xc8,0xd2,0xbc,0x68,0xf2,0xf7,0x9b,0x50,0x3e,
+	0x44,0x3f,0x7c,0xbd,0x2f,0x81,0x4d,0xda,0x3f,0x49,0xec,0x56,0xb6,0xc8,0xe7,0xed,
+	0x11,0xc5,0x72,0xa6,0x82,0x66,0x6d,0x1b,0x6c,0xf7,0xae,0x01,0x47,0x73,0xba,0x41,
+	0x6f,0x77,0xa8,0x69,0xca,0x75,0xc8,0x6c,0x5c,0x1f,0x4d,0xef,0x6e,0x30,0xdb,0xd3,
+	0x8b,0x1a,0xbf,0xc4,0x35,0xd5,0x38,0x27,0x02,0x6c,0xc4,0x9e,0x64,0x74,0x8f,0x1f,
+	0xe6,0x5e,0x22,0x98,0xc6,0x59,0x11,0xa6,0x43,0x76,0xe3,0xdb,0x78,0x3a,0x56,0x17,
+	0xd9,0xbf,0x4f,0x84,0xdb,0xb0,0xba,0xca,0xde,0x79,0x20,0xf4,0x02,0xc7,0x75,0xd2,
+	0xcc,0x69,0x05,0x85,0x5a,0xa2,0x90,0x4e,0xc8,0x19,0x0c,0xf2,0x38,0x6b,0xc2,0xf0,
+	0x88,0x6e,0xf9,0x4b,0x4d,0x43,0xae,0x62,0x76,0xa3,0xdb,0xfc,0x7a,0x56,0x92,0x89,
+	0xbd,0xcb,0xc0,0x9b,0x3d,0xee,0x98,0x52,0x18,0x20,0x31,0x52,0x41,0xb1,0x96,0x09,
+	0xb4,0x53,0x53,0x92,0x83,0x1d,0xdf,0xca,0x13,0xa9,0xb6,0x38,0xe6,0x12,0xe2,0x04,
+	0x8a,0xa9,0x8c,0x99,0x81,0x2a,0xab,0xe7,0x2c,0x01,0x4b,0xb2,0xb2,0x4f,0x9e,0x7b,
+	0x85,0xa0,0x02,0x6b,0xb5,0x80,0x61,0x19,0x55,0x63,0x9f,0x30,0x37,0x12,0x4d,0xf5,
+	0xce,0x05,0xc1,0x1b,0x3e,0xd6,0x1f,0x51,0x2e,0x47,0x2e,0x6a,0xfe,0x32,0xd3,0x56,
+	0xcb,0x18,0x1a,0x90,0x35,0x79,0xf8,0x75,0xaf,0x1c,0x94,0x78,0xa1,0xe6,0x28,0x43,
+	0x63,0xb2,0xe0,0x6f,0x3f,0x29,0xed,0x80,0xd4,0x49,0x34,0xd7,0x1b,0x13,0x06,0x47,
+	0x7c,0x4a,0x5f,0x60,0xbb,0x76,0x1d,0x3a,0x9b,0xc7,0x4f,0x73,0xab,0x51,0x4c,0x66,
+	0xfc,0x0a,0x57,0x65,0xfb,0x7c,0x39,0x6e,0x91,0xca,0x8b,0x29,0x8f,0xa1,0x06,0x29,
+	0x9d,0x80,0x33,0x39,0xf4,0x31,0xf7,0x10,0xe1,0x30,0xcc,0xa2,0xb4,0x0f,0x92,0x3f,
+	0xdd,0xac,0x77,0x23,0xd8,0xc4,0xfd,0x55,0xa4,0xee,0xa2,0xf3,0x7f,0x18,0x78,0xb1,
+	0xe7,0x19,0x51,0x22,0x87,0x36,0x66,0x0e,0x2a,0xbc,0x96,0x13,0x14,0x66,0x49,0x5a,
+	0x36,0xd1,0x7f,0x5f,0x08,0x3b,0xa0,0x75,0x1a,0x4c,0xf5,0xcc,0x25,0xc5,0x19,0x16,
+	0x52,0x0d,0x71,0x0a,0x45,0x44,0xce,0x6c,0x50,0xdf,0x55,0xe3,0x9e,0x28,0xb4,0x13,
+	0x53,0x16,0xc3,0x1d,0x5a,0x9a,0x11,0x2d,0xf2,0x78,0x6b,0x46,0xb0,0x88,0xeb,0xa9,
+	0x49,0xc9,0x07,0xee,0xef,0x22,0xf1,0x57,0x9d,0x7a,0x93,0xc2,0x0f,0x79,0x8f,0x05,
+	0x46,0x6b,0x38,0x50,0x73,0x95,0xb1,0x33,0x58,0xe4,0xf5,0x96,0x84,0x64,0x41,0xdf,
+	0x76,0xd3,0xda,0x0b,0x08,0x97,0x60,0x27,0xb7,0x3c,0xa5,0x2a,0xe0,0x57,0xbe,0x4a,
+	0xd7,0xe1,0xb3,0xfd,0xbc,0x34,0x32,0x4a,0xc7,0xe0,0x82,0xef,0xfd,0x01,0xe4,0x43,
+	0xf6,0xe3,0xd3,0xf9,0x3a,0x5c,0xb6,0xdd,0xb7,0xc6,0x04,0xc1,0x19,0x1e,0xd2,0x1d,
+	0x79,0xaa,0x55,0x0e,0x4e,0xfc,0x58,0x77,0xc4,0xa9,0x14,0x19,0xb8,0xb3,0x4b,0xdc,
+	0x53,0x85,0xf2,0x22,0xca,0xe7,0xe8,0x41,0xcf,0x77,0xe2,0xc8,0x4a,0x3d,0x41,0x69,
+	0x16,0xb4,0x6d,0xb3,0xed,0xbd,0x05,0x20,0x0b,0xf2,0x36,0x8b,0xde,0xfe,0x50,0xf2,
+	0x84,0xab,0xb1,0x4d,0xb8,0x1f,0x8b,0x8e,0xfe,0xf5,0xa2,0xc4,0x0f,0x75,0x4f,0x1d,
+	0x4a,0x9b,0x20,0x3f,0xb3,0x4d,0xbd,0x4f,0x81,0x8b,0xba,0xbf,0x8e,0x94,0x55,0x70,
+	0xae,0x07,0x26,0x6f,0xbe,0x38,0xf7,0x02,0xc1,0x15,0xde,0xca,0x11,0x89,0xb2,0x3a,
+	0xce,0x96,0xf0,0x24,0xae,0xab,0xe6,0x3d,0x13,0x48,0xa7,0xe4,0x04,0x87,0x79,0x96,
+	0x94,0x65,0x70,0xcd,0x37,0xe6,0x0c,0x02,0x39,0x94,0x31,0x31,0x70,0x61,0xf7,0xb4,
+	0xa1,0x72,0x69,0x72,0xf4,0xa3,0xd7,0x3d,0x72,0x58,0x63,0x85,0x90,0x02,0x08,0x85,
+	0x40,0x02,0xa5,0x54,0x00,0xac,0xc0,0x52,0xad,0x70,0x50,0xe6,0xc5,0x92,0xa7,0x5c,
+	0x85,0xec,0xc2,0xf7,0xf9,0x70,0xfc,0x26,0x97,0x3f,0xd7,0x0c,0x63,0x29,0x50,0x50,
+	0xa5,0xf5,0x10,0xe4,0x60,0xc6,0xa7,0xf0,0x45,0xbe,0x6f,0x87,0xa9,0x96,0x39,0xb4,
+	0x30,0x63,0x52,0xe0,0xa1,0xde,0xa9,0x20,0x59,0xd3,0x87,0xdb,0xb7,0xca,0xc4,0xd9,
+	0x15,0xee,0xca,0x72,0xb9,0x72,0x59,0x72,0x97,0x93,0x17,0x5e,0xce,0x59,0x00,0xb6,
+	0x60,0x67,0xb7,0xb8,0xe5,0x2a,0x65,0x07,0xbc,0xce,0x93,0xa1,0x3e,0xa9,0xee,0xb8,
+	0x53,0x4a,0x02,0xb0,0x04,0x2b,0xb9,0xc4,0x39,0x15,0x20,0x2b,0xf2,0x74,0xab,0x5e,
+	0xbc,0x78,0xf3,0xc6,0x89,0x11,0x0b,0x92,0x36,0x4d,0xbe,0x7e,0x97,0x8a,0x87,0x6d,
+	0xd7,0xad,0x73,0x61,0xf0,0xc4,0xaf,0x75,0x05,0xbc,0xca,0xd3,0xa9,0x3a,0xf9,0xe6,
+	0x9d,0x13,0x02,0x06,0x64,0x4c,0x0e,0x7c,0xdc,0x3f,0x45,0x2c,0x4e,0xba,0x38,0xff,
+	0x82,0xd1,0x1d,0x7e,0xda,0x5b,0x09,0x22,0x32,0x66,0x07,0xba,0xae,0x9f,0xa7,0x46,
+	0x25,0xd9,0xd8,0x3f,0x4c,0xbc,0x5c,0xb3,0x8c,0xad,0xc1,0x41,0x9f,0x77,0x47,0x98,
+	0x0a,0x99,0x85,0x6b,0xb3,0xe1,0x7d,0x1d,0x2c,0xfb,0xea,0x59,0x4b,0x06,0xf2,0x2c,
+	0x2b,0xeb,0xe4,0x98,0x47,0x48,0x0b,0x24,0x56,0x2a,0x09,0xc6,0x72,0xa0,0xe2,0x6a,
+	0x6b,0x63,0xe0,0xc0,0xce,0x6d,0x41,0xcd,0x56,0xf6,0xc8,0x63,0xad,0x11,0x40,0x22,
+	0xa4,0x06,0x22,0x2d,0x96,0x38,0xa5,0x22,0x60,0x47,0xb6,0xea,0xc7,0xab,0x33,0x6d,
+	0xb4,0x9c,0xa3,0x00,0x4d,0xd1,0x8e,0x4f,0xe5,0xcb,0x74,0xdb,0x5e,0x5b,0x08,0x33,
+	0x20,0x65,0x12,0xec,0xe5,0x86,0xa5,0x55,0x11,0xbe,0xc3,0x47,0xfb,0x3b,0x49,0xe4,
+	0xd6,0xa6,0xc0,0x47,0xfd,0x5b,0x45,0xe2,0xae,0x2a,0xf7,0x27,0x91,0x5d,0xfb,0x0e,
+	0x19,0x8d,0xe3,0x22,0xe9,0xd7,0xac,0x62,0x73,0xf3,0xd1,0xf9,0x3e,0x1c,0xbe,0xd9,
+	0xe7,0xce,0x21,0x81,0x51,0x1a,0x06,0x55,0x5c,0x6f,0x4d,0x08,0x1e,0xf0,0x3d,0x3f,
+	0x88,0xfd,0xc8,0x74,0xdd,0x3e,0x57,0x0e,0x4b,0xac,0x52,0x72,0x80,0xe3,0x38,0x49,
+	0xe2,0xb6,0xaa,0xc6,0x3f,0x71,0x6c,0x25,0x8e,0xa8,0x94,0x1b,0x90,0x36,0x49,0xfe,
+	0x76,0x93,0xda,0x8f,0x48,0x97,0xe5,0x77,0xb5,0xb8,0xe1,0x6a,0x6d,0x03,0xec,0xc6,
+	0xb6,0xe1,0x76,0xad,0x3a,0xf0,0x76,0x8f,0x1a,0xb6,0x54,0x27,0xdc,0x8c,0x75,0x41,
+	0xfc,0x46,0x97,0xf9,0xb7,0x8c,0xa4,0x51,0x53,0x96,0xc3,0x15,0xdb,0x9a,0x1b,0x8c,
+	0xf6,0x70,0xe2,0xc6,0xaa,0x21,0x4f,0xb1,0x8a,0xc9,0x8d,0x4f,0xe3,0xab,0x78,0xdd,
+	0x26,0xd7,0x3f,0x53,0x4c,0x63,0xac,0x00,0x52,0x21,0xb1,0x50,0x69,0x34,0x94,0x2b,
+	0x91,0x45,0x7b,0x3f,0x01,0x6d,0xd2,0xfc,0x69,0x66,0xb5,0x9a,0xc1,0x2c,0x4f,0xab,
+	0x2a,0xfc,0x97,0x87,0x56,0x67,0xd8,0x48,0x3d,0x45,0x29,0x1e,0xb0,0x3d,0xbb,0xc8,
+	0xfd,0x4d,0x24,0xdf,0xba,0x13,0x4e,0xc6,0xf8,0x00,0xfe,0xe1,0xe3,0xfd,0x19,0x64,
+	0x72,0xee,0x03,0xe2,0x27,0xba,0xed,0xaf,0x25,0x05,0x19,0x9a,0x93,0x0d,0xfe,0xfb,
+	0x43,0xc8,0x03,0xac,0xc7,0x22,0xa3,0x77,0x3c,0x28,0xfb,0xe2,0xd9,0x5b,0x0e,0x52,
+	0x3c,0x61,0x6b,0x74,0x90,0xef,0xd9,0x41,0xae,0x67,0x26,0xa9,0xde,0xb8,0x30,0x7a,
+	0xc2,0xd3,0xb8,0x2a,0xda,0xf7,0xc9,0x70,0x9f,0x16,0x57,0x5c,0x6b,0x0d,0x00,0x1a,
+	0xa0,0x35,0x1a,0xc8,0xb5,0xcc,0xa0,0x95,0x1b,0x92,0x16,0x4d,0xfc,0x5e,0x17,0xc8,
+	0xaf,0x6c,0x95,0x8f,0xd3,0x27,0xda,0xed,0x69,0x45,0x85,0xde,0xe2,0x90,0xcb,0x98,
+	0x1b,0x88,0xb6,0x78,0xe6,0x96,0xa2,0x04,0x0f,0xf9,0x8e,0x1d,0xc5,0x6a,0x26,0xb3,
+	0x7e,0x8d,0x2a,0xb2,0x77,0x1f,0x18,0xbf,0xc1,0x65,0xdf,0x3d,0x63,0x48,0x40,0x94,
+	0xc4,0x61,0x95,0x95,0x73,0x12,0xc0,0x25,0xdc,0x89,0x25,0x4b,0xf9,0x02,0xdd,0xd5,
+	0xe7,0xd6,0xa1,0xb0,0x49,0xfa,0x37,0x8b,0xdc,0xde,0x54,0xf0,0xac,0x2f,0xa3,0x6d,
+	0x9c,0x1d,0xe1,0x2a,0x6c,0x97,0xae,0xc7,0x27,0xf3,0x7d,0x39,0x6c,0xb1,0xce,0x89,
+	0x01,0x0b,0xb3,0x26,0x0d,0x9f,0xea,0x97,0xab,0x96,0x3d,0xf4,0x38,0x67,0x02,0xe8,
+	0x84,0x9e,0xe1,0x24,0x8d,0x9b,0xa2,0x1e,0xaf,0xcc,0x94,0xd5,0x70,0xa6,0x86,0x26,
+	0x65,0x1f,0x3c,0xff,0x8b,0x41,0x0f,0x77,0x6e,0x09,0x4a,0xb2,0xb0,0x6f,0x9a,0x79,
+	0xad,0x24,0x10,0x4b,0x91,0x82,0x0b,0xbd,0xc7,0x01,0x93,0x33,0x1f,0x94,0x7f,0xd1,
+	0xe8,0x2f,0x2f,0xad,0x8c,0x90,0x11,0x38,0xa2,0x53,0x7e,0x42,0xdb,0x30,0xbb,0xd2,
+	0x5d,0x78,0x3e,0x17,0x0f,0xdf,0xee,0x53,0xe3,0x92,0xe8,0xac,0x1f,0xa3,0x0e,0xac,
+	0xdd,0x82,0x96,0x6d,0xf4,0x9d,0x37,0x42,0x4c,0x40,0x9c,0x44,0x71,0x9d,0x35,0x63,
+	0x58,0x40,0xb5,0xd4,0x21,0xb4,0x01,0x73,0x33,0xd1,0x75,0xff,0x1c,0x31,0x28,0xe1,
+	0x42,0xec,0x41,0xc6,0xe7,0xf0,0xc1,0xfe,0x6f,0x02,0xf9,0x94,0xbd,0xf0,0x70,0xee,
+	0x06,0xb2,0x2d,0xbf,0xa9,0xe5,0x09,0x55,0x43,0x9f,0x72,0x17,0x92,0x0f,0xdd,0xcf,
+	0x47,0xe3,0xbb,0x78,0xfc,0x36,0x97,0x1e,0xc7,0x4c,0x42,0xbd,0x50,0x71,0xb4,0xa5,
+	0x33,0x71,0x74,0xa5,0xbf,0xb0,0x74,0x2a,0x4e,0xb6,0xf8,0xe7,0x8e,0x21,0x05,0x11,
+	0x1a,0x83,0x05,0x5e,0xeb,0x09,0x48,0x93,0xa4,0x6f,0xb3,0xe9,0xfd,0x0d,0x24,0x5b,
+	0xfa,0x13,0xcb,0x96,0xfa,0x84,0xba,0xa1,0x6e,0xa9,0x4b,0xe8,0x13,0xee,0xc6,0xb2,
+	0xa1,0x7e,0xa9,0x6a,0xf8,0x53,0xcf,0x52,0xb2,0x80,0x6f,0xf9,0x49,0x6d,0x47,0xac,
+	0x4a,0xf2,0xb1,0xfb,0xd8,0x78,0x3c,0x36,0x1b,0xdf,0xc7,0xc3,0xb3,0xbb,0xdc,0xbc,
+	0x74,0x32,0xce,0x87,0xe0,0x07,0xbf,0xff,0x85,0xa0,0x03,0x7b,0xb7,0x81,0x75,0x5b,
+	0x5c,0x73,0x8d,0x31,0x02,0x40,0x04,0xc4,0x48,0x04,0xd5,0x58,0x27,0xc4,0x0c,0x44,
+	0x59,0x1c,0x77,0x49,0x79,0x06,0x95,0x5c,0xe3,0x8c,0x08,0x91,0x01,0x3b,0xb3,0x45,
+	0x3d,0x5f,0x89,0x2b,0xaa,0xf5,0x0e,0x04,0x5d,0xd8,0x3f,0x4d,0xac,0x5e,0xb2,0x98,
+	0xef,0xc8,0x51,0x8d,0x76,0x72,0xca,0x43,0xa8,0x03,0x6a,0xa7,0xa2,0x64,0x0f,0x3f,
+	0xee,0x9d,0x02,0x12,0x25,0x75,0x18,0x6d,0xe1,0xcc,0x0c,0x55,0x49,0x3f,0x66,0x1d,
+	0x1a,0x9b,0x85,0x6f,0xf3,0xe9,0x79,0x4d,0x24,0xde,0xaa,0x11,0x4f,0xd2,0xba,0x09,
+	0xee,0xf3,0xe2,0xc8,0x4b,0x2d,0x43,0x68,0x02,0xf6,0x64,0xa3,0xff,0xbc,0x30,0x72,
+	0x42,0xc3,0xb0,0x8a,0xca,0xbd,0x49,0xe0,0x97,0xbe,0xc6,0x16,0xe1,0x3c,0x0c,0xba,
+	0xb8,0xff,0x8a,0x50,0x1d,0x74,0x7b,0x5f,0x01,0xab,0xb2,0x7c,0xae,0x1e,0xb6,0x5c,
+	0xa7,0xcc,0x84,0xd5,0x51,0xb6,0xc6,0x07,0xf1,0x1f,0x1d,0xee,0xdb,0x62,0x9a,0x63,
+	0x0d,0x11,0x0a,0x83,0x24,0x4e,0xab,0x28,0xdc,0x93,0x85,0x7e,0xe3,0xca,0x68,0x19,
+	0x47,0x43,0xba,0x22,0x5f,0xb7,0xcb,0xd5,0xcb,0x16,0xfb,0x9c,0x39,0xa0,0x70,0x4a,
+	0x46,0xf0,0x88,0x6f,0xe9,0x49,0x4c,0x57,0xec,0x6b,0x66,0xb1,0xda,0xc9,0x28,0x1f,
+	0xa3,0x0f,0xbc,0xdf,0x83,0x82,0x2f,0xfd,0x8d,0x25,0x43,0x79,0x12,0xd5,0x75,0xf7,
+	0x9c,0x21,0x20,0x41,0x52,0xa6,0xc1,0x56,0xef,0x58,0x50,0xb4,0xe5,0x33,0xf5,0x34,
+	0xa5,0x3a,0xe0,0x76,0xae,0x0a,0xf6,0x75,0xb3,0xdc,0xad,0x64,0x11,0xdf,0xd3,0x83,
+	0x9a,0xaf,0xcc,0x95,0xc5,0x72,0xa7,0x92,0x64,0x6c,0x0f,0x2e,0xfe,0xbe,0x13,0x46,
+	0x46,0xe8,0x08,0x5e,0xf1,0xa9,0x7d,0x89,0x6c,0xda,0x7f,0x49,0x68,0x16,0xb6,0x4d,
+	0xb7,0xef,0x95,0x81,0x32,0x2b,0xd6,0x34,0xe1,0x7a,0x6c,0x32,0xfe,0x87,0x83,0x37,
+	0x7f,0x9c,0x39,0xa1,0x60,0x48,0x47,0xe4,0xca,0x66,0xf9,0x5b,0x4d,0x62,0xbe,0x22,
+	0x57,0x37,0xdb,0xdd,0x6b,0x06,0xb1,0x1c,0xa9,0xa8,0xd8,0xdb,0x0c,0x7a,0xb9,0x63,
+	0x49,0x51,0x86,0xc7,0x74,0xc3,0xde,0x6a,0x10,0xd3,0x11,0xbb,0x92,0x5d,0xfc,0x7e,
+	0x17,0x8a,0x8f,0xec,0xd7,0xa7,0xd2,0x65,0xf8,0x4d,0x2f,0x6f,0xac,0x18,0xd2,0x10,
+	0xa9,0xb0,0x58,0xea,0x14,0x9a,0x88,0xbd,0xc9,0xe0,0x9f,0x3f,0xc6,0x1c,0x40,0x38,
+	0x04,0x33,0x38,0xe5,0x23,0xf4,0x05,0xb7,0x7b,0xd5,0xa0,0xa7,0x3b,0xf5,0x24,0xa5,
+	0x1b,0xf0,0x36,0x8f,0x9e,0xf6,0x54,0xa2,0x8c,0x8e,0xf1,0x05,0xbc,0xcb,0xc3,0xab,
+	0x3b,0xed,0xa4,0x94,0x03,0x10,0x07,0x51,0x1e,0x47,0x4d,0x5a,0x3e,0x51,0x6f,0x57,
+	0xa8,0x2b,0xea,0xf5,0x8a,0x44,0x5d,0x5d,0x6f,0x4f,0x28,0x1a,0xf2,0x15,0xbb,0x9a,
+	0xdd,0xec,0x76,0xb7,0x9a,0xc5,0x6c,0x47,0xaf,0x7a,0xf4,0xb2,0xc7,0x1e,0x63,0x0c,
+	0x00,0x18,0x80,0x31,0x18,0xe0,0x31,0xde,0x80,0xb1,0x19,0xf8,0xb2,0xdf,0x9e,0x52,
+	0x14,0xe0,0x29,0x5e,0xb1,0xa9,0xf9,0xc9,0x6c,0x5f,0x2f,0x4b,0xec,0x52,0xf6,0xc0,
+	0xe3,0xbd,0x19,0xe0,0x32,0xee,0x86,0xb2,0x25,0x3e,0xa9,0xef,0xa8,0x51,0x4b,0x16,
+	0xf2,0x0d,0x3b,0xab,0xc5,0x0c,0x47,0x69,0x1a,0x74,0x75,0xbf,0x1d,0xa5,0x6a,0xe0,
+	0xd3,0xfe,0x4a,0x52,0xb1,0xb1,0x79,0xf8,0x74,0xbf,0x1e,0x95,0x6c,0xe3,0xef,0x38,
+	0x51,0x62,0x87,0xb2,0x26,0x0e,0xaf,0xec,0x94,0x97,0x50,0x26,0xc4,0x0e,0x64,0x5d,
+	0x1e,0x5f,0xcd,0x6b,0x26,0xb1,0x5e,0x89,0x28,0x9a,0xf3,0x0d,0x38,0x9b,0xc3,0x0f,
+	0x7b,0xaf,0x01,0x44,0x43,0xbc,0x42,0x53,0xb1,0xb3,0x59,0xfc,0x76,0x97,0x9a,0x87,
+	0x4c,0xc7,0xed,0x52,0xf5,0xf0,0xe5,0xbe,0x25,0x26,0x29,0xde,0xb0,0xb1,0x7a,0xc8,
+	0x72,0xbc,0x22,0x53,0x77,0xd3,0xd9,0x3b,0x0e,0x94,0x5c,0xe1,0xac,0x0c,0x93,0x29,
+	0xbf,0xa1,0x65,0x19,0x5d,0xe3,0x8f,0x38,0x97,0x02,0x07,0x75,0x5e,0x0d,0x69,0x8a,
+	0x74,0x5c,0x2e,0x5d,0x8e,0x5f,0xe4,0xfa,0x66,0x9a,0x6b,0x8d,0x01,0x02,0x23,0x34,
+	0x04,0x2b,0xb8,0xd4,0x3b,0x14,0x34,0x69,0xfb,0x64,0xb9,0x5f,0x89,0x2a,0xba,0xf7,
+	0x0f,0x10,0x1f,0xd1,0x2f,0x5f,0xad,0x6b,0xe0,0xd1,0xde,0x4e,0x50,0x99,0x35,0x6b,
+	0xd8,0x50,0xbd,0x74,0x31,0xfe,0x81,0xe3,0x3b,0x79,0xe4,0xb5,0x96,0x00,0x24,0x41,
+	0x5a,0x26,0xd1,0x5e,0x4f,0x48,0x1a,0x34,0x75,0x3b,0x5d,0xa5,0xef,0xb0,0xd1,0x7a,
+	0x0e,0x12,0x3c,0xe5,0x2b,0x74,0x15,0xbf,0xdb,0xc5,0xea,0x27,0xab,0xfd,0x8c,0x34,
+	0x51,0x7a,0x07,0x83,0x3e,0xee,0x9e,0x32,0x14,0x26,0x49,0xde,0x76,0xd1,0xfa,0x0f,
+	0x0a,0xbf,0xe4,0x35,0x97,0x18,0xa7,0x40,0x44,0xc5,0xdc,0x46,0xd4,0xc9,0x35,0xcf,
+	0x98,0x12,0x18,0xa4,0x71,0x52,0xc4,0xe1,0x94,0x8d,0xf0,0x13,0xde,0xc6,0xd1,0x91,
+	0xbe,0xca,0xd6,0xf9,0x30,0xfc,0xa2,0xd7,0x3f,0x52,0x5c,0x61,0xad,0x14,0x10,0x28,
+	0xa1,0x42,0x68,0x01,0xc6,0x62,0xa0,0xc3,0x7a,0x2b,0x42,0x74,0xc0,0xef,0x7c,0x11,
+	0xee,0xc3,0xe2,0xab,0x7b,0xed,0x20,0xd4,0x03,0x95,0x57,0x53,0x9a,0x03,0x0d,0xd7,
+	0x6a,0x03,0xe3,0x36,0xa8,0xee,0xba,0x73,0x4e,0x00,0x98,0x80,0x39,0x99,0xe0,0x3b,
+	0x7f,0x84,0xb9,0x90,0x78,0xa8,0x76,0x3a,0x4a,0xd7,0xe0,0xa3,0xff,0xbd,0x20,0x70,
+	0x43,0xd7,0xf2,0x83,0xda,0xaf,0x48,0xd5,0xc5,0xf7,0xf7,0x90,0xe0,0x28,0x4f,0xa3,
+	0xaa,0xec,0x9f,0x27,0x46,0x2d,0x58,0xd8,0x35,0xed,0xb8,0x54,0x3a,0x0c,0xb7,0x68,
+	0xe5,0x87,0xb4,0x47,0x12,0xab,0x95,0x0c,0xe2,0x39,0x5a,0xd0,0xb1,0xbd,0xb8,0xf0,
+	0x7a,0x4e,0x12,0xb8,0xa5,0x2b,0xf1,0x45,0xbd,0x5f,0x81,0xaa,0xaa,0xff,0xaf,0x00,
+	0x55,0x51,0xbf,0x57,0x05,0xfa,0xaa,0x5b,0xef,0x42,0xf0,0x81,0xff,0xfb,0x40,0xf8,
+	0x05,0xaf,0xfb,0xe4,0xb8,0x47,0x0a,0x2b,0xa4,0x14,0x02,0x08,0x84,0x50,0x00,0xa4,
+	0x40,0x42,0xa5,0xd0,0x40,0xac,0x45,0x02,0xaf,0xf4,0x14,0xa6,0x48,0xc6,0xf5,0xd0,
+	0xe4,0xec,0x07,0xa7,0x7f,0xb4,0xb8,0xe3,0x4a,0x69,0x01,0xc4,0x42,0xa4,0xc1,0x52,
+	0xaf,0x50,0x54,0xe4,0xed,0x16,0xb5,0x7c,0xa1,0xee,0xa8,0x53,0x6b,0x12,0xf0,0x25,
+	0xbf,0xb9,0xe5,0x28,0x45,0x03,0xbe,0xe6,0x17,0xb3,0x1e,0x8d,0xec,0xd2,0xf7,0xd8,
+	0x60,0xbc,0x07,0x03,0x3f,0xf6,0x1d,0x33,0x0a,0xc5,0x44,0xc6,0xed,0x50,0xd5,0xf4,
+	0xe7,0x96,0xa1,0x34,0x09,0xfa,0xb2,0xdb,0xde,0x5a,0x10,0xb0,0x21,0x7b,0xf1,0xe1,
+	0xfd,0x1d,0x24,0x7a,0xea,0x53,0xea,0x02,0xfa,0xa5,0xab,0xf1,0x4d,0x3c,0x5f,0x8b,
+	0x0b,0xae,0xf7,0x26,0x80,0x4f,0xf8,0x1b,0x4f,0xc6,0xfa,0x20,0xfa,0xe3,0xcb,0x79,
+	0x0b,0x44,0x56,0xec,0x69,0x46,0xb5,0xd8,0xe1,0xac,0x0d,0x83,0x2b,0xbe,0xb5,0x27,
+	0x10,0x4d,0xf1,0x8e,0x0d,0xc5,0x4b,0x36,0xf3,0x5f,0x19,0x2a,0x93,0x66,0x4f,0x3b,
+	0x2a,0xd5,0x06,0xc7,0x7d,0x52,0xdc,0x61,0xa5,0x95,0x10,0x22,0x00,0x46,0x60,0x88,
+	0x46,0x78,0x09,0x67,0x62,0xe8,0x42,0xfe,0x61,0xe3,0xf5,0x98,0x64,0x78,0x4f,0x07,
+	0xea,0xae,0x3a,0xf7,0x06,0x81,0x1d,0xda,0x9a,0x19,0xac,0xf2,0x72,0xca,0x42,0xb8,
+	0x01,0x6b,0xb3,0xe0,0x6d,0x1f,0x2d,0xef,0xa8,0x50,0x5b,0x14,0xf3,0x19,0x79,0xa2,
+	0xd5,0x1e,0x46,0x5c,0x48,0x3d,0x44,0x39,0x1c,0xb1,0x29,0xf9,0xc1,0xed,0x5f,0x25,
+	0xea,0xe8,0x5a,0x7f,0x40,0xf9,0x14,0xbd,0xf8,0xf1,0xee,0x0c,0x13,0x29,0xb7,0x20,
+	0x65,0x13,0xfc,0xe7,0x87,0xb1,0x17,0x18,0xae,0xd1,0x46,0xce,0x69,0x00,0xd5,0x50,
+	0xa7,0xd4,0x04,0xe4,0x49,0x56,0xf7,0xd9,0x71,0xae,0x04,0x16,0x69,0xbd,0x04,0x31,
+	0x19,0xf1,0x23,0xdd,0x95,0xe7,0x52,0xe1,0xb0,0xcc,0xaa,0x35,0x0f,0x98,0x9e,0xd9,
+	0xa4,0xfe,0xa3,0xc2,0x6d,0x59,0x4d,0x67,0xee,0x28,0x52,0x73,0x91,0xf1,0x3b,0x5c,
+	0xb4,0xfd,0xb3,0xc4,0x2c,0x45,0x0b,0x3e,0xf6,0x1f,0x13,0x0e,0xc7,0x6c,0x42,0xff,
+	0x70,0xf1,0xf6,0x8d,0x32,0x33,0x56,0x05,0xf9,0x9a,0x5d,0xec,0x7e,0x36,0x9a,0xcf,
+	0xcd,0x43,0xa7,0xf3,0x74,0xa8,0x6e,0xba,0x7b,0xcf,0x00,0x92,0x21,0x3d,0x91,0x69,
+	0xbb,0x65,0x2d,0x1d,0x88,0xbb,0xa8,0xfc,0x9b,0x46,0x5e,0x69,0x29,0x44,0x10,0x8c,
+	0xe1,0x00,0xcd,0xd1,0x86,0xce,0xe5,0xc1,0xd5,0xdf,0x56,0xd2,0x88,0x29,0x89,0xc1,
+	0x0a,0x2f,0xe5,0x0c,0x04,0x59,0x98,0x37,0x49,0xfc,0x56,0x97,0xd8,0xa7,0xcc,0x85,
+	0xc5,0x53,0xb7,0xd2,0x45,0xf8,0x0f,0x0f,0xef,0xee,0x30,0xd3,0x52,0x8b,0x10,0x1e,
+	0xc0,0x3d,0x5c,0xb8,0x3d,0xab,0xc8,0xdc,0x5d,0x64,0xfe,0x2e,0x13,0x6f,0xd7,0xa8,
+	0x23,0x6b,0xf5,0x80,0xe5,0x59,0x55,0xe6,0xcf,0x32,0xb3,0x56,0x0d,0x78,0x9a,0x57,
+	0x4d,0x7a,0x3e,0x13,0x4f,0xd7,0xea,0x03,0xeb,0xb7,0xa8,0xe4,0x1b,0x77,0x46,0x89,
+	0x18,0x9a,0x90,0x3d,0xf8,0xf8,0x7f,0x0e,0x18,0x9c,0xf1,0x21,0xfc,0x81,0xe7,0x7b,
+	0x71,0xe0,0xe5,0x9e,0x25,0x64,0x09,0x5e,0xf2,0x99,0x7b,0x8a,0x50,0x1c,0x64,0x79,
+	0x5e,0x15,0xe9,0xbb,0x6c,0xbc,0x1f,0x83,0x0e,0xee,0xfd,0x02,0xd4,0x45,0xf5,0xdf,
+	0x15,0xe2,0x0a,0x6a,0xb5,0x82,0x41,0x1d,0x57,0x4b,0x1b,0x22,0x17,0x36,0x4f,0x9f,
+	0x6a,0x97,0xa3,0x17,0x3d,0xfe,0x99,0x63,0x0a,0x61,0x04,0x84,0x48,0x80,0x95,0x58,
+	0xa2,0x94,0x0e,0xc0,0x1d,0x5c,0xfa,0x1d,0x2b,0x8a,0xf4,0x5c,0x26,0xdc,0x8e,0x55,
+	0x45,0xfe,0x6e,0x13,0xeb,0x97,0xa8,0xa6,0x3b,0xf7,0x04,0xa1,0x19,0xd8,0xb2,0x9d,
+	0xbe,0xd2,0x56,0xc8,0x28,0x1c,0x93,0x09,0xbf,0xe3,0x45,0x99,0x1f,0xcb,0x8e,0x7a,
+	0xb5,0xa2,0x41,0x5f,0x77,0xcb,0x59,0x0a,0x16,0x74,0x6d,0x3f,0x2c,0xbd,0x8a,0xd1,
+	0x0d,0x7e,0xfb,0x4b,0x49,0x03,0xa6,0x66,0x26,0xab,0xfe,0xbc,0x32,0x52,0x46,0xc1,
+	0x98,0x0e,0xd8,0x9d,0x6d,0xe2,0xfd,0x1a,0x54,0x74,0xed,0x3f,0x24,0x3c,0x8a,0xdb,
+	0xac,0x7a,0xf3,0xc2,0xc9,0x19,0x0f,0xc2,0x3e,0x68,0xfe,0x36,0x93,0x5e,0xcf,0x48,
+	0x12,0xb5,0x75,0x31,0xfc,0xa1,0xe7,0x39,0x51,0x60,0xa7,0xb6,0x24,0x26,0x2b,0xfe,
+	0xb4,0xb3,0x52,0x4c,0x60,0x9c,0x06,0x51,0x1d,0x77,0x4b,0x59,0x02,0x97,0x74,0x67,
+	0x9e,0x28,0xb5,0x03,0x51,0x17,0xd7,0x5f,0x53,0x8a,0x03,0x2c,0xc7,0x2a,0x22,0x77,
+	0x36,0x89,0xff,0xea,0x50,0xdb,0x14,0xfb,0x98,0x79,0xa8,0x74,0x1a,0x4e,0xd5,0xc8,
+	0x27,0xed,0x9d,0x04,0x72,0x29,0x73,0x60,0xe1,0xd6,0xac,0x60,0x53,0xf7,0xd3,0xd1,
+	0xba,0x0e,0x9e,0xfd,0xe5,0xa4,0x85,0x13,0x33,0x16,0x05,0x7d,0xda,0x5d,0x69,0x2e,
+	0x34,0x1e,0x8b,0x8d,0xce,0xf3,0xa1,0xf8,0xc9,0x6e,0x7f,0x2b,0x49,0xc4,0xd6,0xe4,
+	0xe0,0xc7,0xbf,0x73,0x44,0xa0,0x8c,0x8a,0xb1,0x0d,0xb8,0x9b,0xcb,0x8e,0x7b,0xa5,
+	0xa0,0x40,0x4b,0x35,0xc2,0x49,0x18,0x17,0x41,0x3f,0x76,0x1d,0x3b,0x8b,0xc5,0x4e,
+	0x67,0xe9,0x58,0x5c,0x74,0xfd,0x3f,0x05,0x2c,0xca,0xfa,0x38,0x7a,0xd2,0xd3,0x99,
+	0x3a,0x9a,0xd6,0x5d,0x70,0xbe,0x07,0x07,0x7f,0xfe,0x19,0x63,0x02,0xe0,0x04,0x8e,
+	0xe9,0x84,0x9d,0xd1,0x22,0x8e,0xa7,0x64,0x05,0x9f,0xfa,0x97,0x8a,0x86,0x7d,0xd5,
+	0xac,0x67,0x23,0xf9,0xd4,0xbd,0x74,0x30,0xee,0x83,0xe2,0x2f,0x3b,0xed,0xa5,0x84,
+	0x01,0x11,0x13,0x13,0x17,0x57,0x5f,0x5b,0x0b,0x03,0x26,0x66,0x2e,0x2a,0xfe,0xb6,
+	0x93,0x56,0x4e,0x48,0x18,0x14,0x71,0x39,0x75,0x21,0xfd,0x90,0xf5,0x78,0x64,0xb6,
+	0xae,0x87,0x27,0x77,0x3d,0x39,0xe9,0xe1,0xcc,0x0d,0x45,0x4b,0x3e,0x72,0x5f,0x13,
+	0x8b,0x97,0x6e,0xc6,0xbb,0x30,0x7c,0xa2,0xdf,0xbe,0x52,0x56,0xc0,0xa9,0x1c,0x99,
+	0xa8,0xbb,0xeb,0xcc,0x19,0x05,0x62,0x2a,0x62,0x76,0xa2,0xcb,0xfe,0x7b,0x42,0xd0,
+	0x80,0xad,0xd9,0xc1,0xae,0x6f,0xa7,0xa9,0xd4,0x19,0x34,0x72,0x4b,0x53,0xa2,0x83,
+	0x7e,0xef,0x0a,0x70,0x15,0xb7,0x5b,0xd5,0xe2,0x87,0xbb,0xb7,0x0c,0xa4,0x59,0xd2,
+	0x96,0xc9,0xb4,0xdf,0x92,0x92,0x0c,0xec,0xd9,0x46,0xde,0x69,0x21,0xc5,0x10,0x86,
+	0x40,0x04,0xc5,0x58,0x06,0xd4,0x4c,0x65,0xcd,0x1c,0x56,0x58,0x29,0x25,0x00,0x48,
+	0x80,0x94,0x48,0xa0,0x95,0x1a,0x82,0x14,0x4c,0xe8,0x1c,0x1e,0xd8,0xbd,0x6d,0xa0,
+	0xdd,0x9a,0x16,0x5c,0xec,0x7d,0x06,0x9c,0xcc,0xf1,0x85,0xbc,0xc3,0x42,0xab,0x31,
+	0x4c,0xa0,0x9c,0x8a,0x90,0x1d,0xf8,0xba,0x5f,0x8e,0x5a,0xb4,0xf0,0x63,0xde,0x21,
+	0xa1,0x51,0x58,0x26,0xd5,0x1e,0x47,0x4c,0x4a,0x3c,0x50,0x7b,0x15,0xa1,0x3b,0xf8,
+	0xf4,0xbf,0x16,0x14,0x6c,0xe9,0x4e,0x3c,0x59,0xeb,0x07,0xa8,0x8f,0xaa,0xb7,0x2f,
+	0x94,0x1d,0xf1,0x2a,0x4d,0x87,0xee,0xe6,0xb3,0xf3,0x5c,0x28,0x3c,0x92,0x5b,0x9d,
+	0x62,0x13,0xf3,0x17,0x99,0xbe,0xdb,0xc6,0xda,0x21,0xa8,0xc1,0x4a,0x2f,0x61,0x4c,
+	0x04,0xdc,0xc8,0x35,0xcd,0xb8,0x16,0x1a,0x8c,0xf5,0x40,0xe4,0xc5,0x96,0xe7,0x54,
+	0x81,0xbc,0xca,0xd2,0xb9,0x38,0xf8,0xf2,0xdf,0x1a,0x12,0x14,0x65,0x79,0x5c,0x35,
+	0xed,0xb9,0x44,0x38,0x0d,0xa3,0x2a,0xec,0x97,0xa6,0x46,0x27,0xf9,0xdc,0x3d,0x64,
+	0x38,0x4e,0x93,0xa8,0xaf,0xab,0xe5,0x0d,0x15,0x4b,0x9b,0x22,0x1f,0xb7,0x4f,0x95,
+	0xcb,0x93,0xab,0x9e,0xbd,0xe4,0x30,0xc7,0x12,0xa2,0x04,0x0e,0xe9,0x8c,0x1c,0xd1,
+	0x28,0x2f,0xa3,0x6c,0x8c,0x1f,0xe0,0x3e,0x2e,0x9e,0xbe,0xd5,0x26,0xc6,0x2f,0x70,
+	0x5d,0x37,0xcf,0x9d,0x42,0x12,0xa1,0x35,0x18,0xe8,0xb1,0xce,0x88,0x11,0x09,0xb2,
+	0x32,0x4f,0x96,0xfa,0x85,0xaa,0xa3,0x6f,0xbd,0x09,0xe1,0x03,0xfc,0xc7,0x87,0xf3,
+	0x37,0x98,0xec,0xf9,0x47,0x8c,0x4b,0xa0,0x93,0x7a,0x8e,0x12,0x34,0x64,0x2b,0x7e,
+	0xb4,0xbb,0xd3,0x4c,0x6a,0x3d,0x02,0x59,0x94,0xf7,0x51,0xf0,0xa6,0x8f,0xb7,0x67,
+	0x14,0x89,0xb9,0x8a,0xd8,0x9d,0x6c,0xf2,0xff,0x1b,0x40,0x36,0xe4,0x2f,0x36,0x3d,
+	0xbf,0x89,0xe5,0x4b,0x75,0xc3,0xdd,0x5a,0x16,0xd0,0x2d,0x7d,0x89,0x6d,0xca,0x7d,
+	0x48,0x7c,0x54,0xbf,0x5d,0xa5,0xee,0xa0,0xd3,0x7b,0x1a,0x50,0x35,0xf5,0x39,0x75,
+	0x20,0xed,0x92,0xf4,0x6c,0x26,0xbf,0xbe,0x95,0x26,0x42,0x6f,0x70,0xd8,0x67,0xcd,
+	0x19,0x06,0x52,0x2c,0x61,0x4a,0x64,0xd0,0xce,0x4d,0x41,0x8f,0x76,0x76,0x8a,0x4b,
+	0xac,0x53,0x62,0x82,0xe2,0x2c,0x0b,0xeb,0xa6,0xb8,0xc7,0x0a,0x23,0x25,0x14,0x08,
+	0xa9,0x80,0x58,0x89,0x24,0x5a,0xeb,0x01,0xc8,0x83,0xac,0xcf,0xa3,0xa3,0x7d,0x9d,
+	0x2c,0xf3,0x6b,0x59,0x41,0xa7,0xf6,0x24,0xa2,0x6b,0xfe,0x31,0xe3,0x50,0xc8,0x24,
+	0xdc,0x8b,0x05,0x4f,0xfb,0x2a,0x59,0xc7,0xc7,0xf2,0xa3,0xda,0xed,0x68,0x55,0x87,
+	0xdf,0xf6,0xd2,0xc2,0x88,0x09,0x89,0x83,0x2a,0xaf,0xa7,0x24,0x05,0x1b,0xba,0x97,
+	0x0f,0xd6,0x7f,0x51,0xe8,0x27,0xae,0xad,0x86,0x31,0x15,0x30,0x2b,0xd3,0x64,0xeb,
+	0x7f,0x28,0x78,0xd2,0xd7,0xd9,0x32,0x9e,0x86,0x55,0x55,0xfe,0x4f,0x03,0xab,0xb6,
+	0x3c,0xa6,0x1a,0xe6,0x54,0x82,0x8c,0xcc,0xd1,0x85,0xfe,0xe3,0xc2,0xe9,0x19,0x4d,
+	0xe2,0xbe,0x2a,0xd6,0x37,0xd1,0x7c,0x6f,0x0e,0x38,0x9c,0xb3,0x01,0x7c,0xc3,0xcf,
+	0x7a,0x33,0xc2,0x45,0xd8,0x0f,0x4d,0xcf,0x6e,0x72,0xfb,0x53,0xc9,0x32,0xbe,0x86,
+	0x17,0x75,0x7e,0x0d,0x2b,0xaa,0xf4,0x1e,0x06,0x5c,0xcc,0x7d,0x44,0xbc,0x4c,0xb3,
+	0xad,0xbd,0x81,0x60,0x0b,0x77,0x66,0x89,0x5a,0xba,0x10,0x7f,0xd0,0xf9,0x3d,0x2c,
+	0xb8,0xda,0xdb,0x08,0x3a,0xb1,0x67,0x19,0x59,0xa3,0x87,0x3c,0xc7,0x0a,0x22,0x35,
+	0x16,0x09,0xbd,0xc2,0x51,0x99,0x36,0x5b,0xde,0x53,0x81,0xb2,0x2a,0xce,0xb7,0xe0,
+	0x64,0x8f,0x3f,0xe6,0x1c,0x02,0x18,0x84,0x71,0x10,0xe4,0x61,0xd6,0xa5,0xf1,0x51,
+	0xfc,0x66,0x97,0xbb,0x97,0x0c,0xe6,0x79,0x52,0xd4,0xe1,0xb5,0x9d,0xb0,0x32,0x4a,
+	0xc6,0xf0,0x80,0xee,0xe9,0x43,0xed,0x53,0xe4,0xe2,0xe6,0xab,0x73,0x6d,0x30,0xdc,
+	0xa3,0x85,0x1d,0xd3,0x0a,0x0b,0xa5,0x46,0x20,0x89,0xd2,0x3a,0x08,0xf6,0x70,0xe3,
+	0xd6,0xa8,0x20,0x5b,0xf3,0x83,0xd9,0x9f,0x4e,0xd6,0xf9,0x31,0xec,0xa0,0xd6,0x2b,
+	0x10,0x55,0x71,0xbf,0x15,0x25,0x7a,0xe8,0x73,0xee,0x00,0xd2,0x21,0xb9,0xd1,0x69,
+	0x3e,0x35,0x2f,0x99,0xcc,0xfb,0x25,0xa8,0xc9,0xca,0x3f,0x69,0xec,0x14,0x96,0x48,
+	0xa5,0xc5,0x10,0x87,0x50,0x06,0xc4,0x4c,0x44,0xdd,0x5c,0x77,0xcc,0x29,0x04,0x11,
+	0x18,0xa3,0x01,0x5c,0xc3,0x8d,0x5a,0xb3,0x80,0x6d,0xd9,0x4d,0x6f,0x6f,0x28,0x58,
+	0xd2,0x95,0xf9,0xb2,0xdc,0xae,0x54,0x17,0xdc,0xef,0x45,0x81,0x9f,0xfa,0x96,0x9a,
+	0x84,0x7c,0xc1,0xee,0x6e,0x33,0xeb,0xd5,0x88,0x26,0x79,0xdf,0x05,0xe3,0x3b,0x78,
+	0xf4,0xb7,0x97,0x14,0x66,0x48,0x4a,0x34,0xd0,0x6b,0x1d,0x01,0x2b,0xb2,0x74,0x2f,
+	0x1e,0xbc,0xfd,0xa3,0xc4,0x0d,0x55,0x4b,0x1f,0x62,0x1f,0x32,0x1f,0x97,0x4f,0xd7,
+	0xeb,0x13,0xe9,0xb6,0xbc,0xa6,0x12,0x67,0x54,0x88,0x2d,0xc8,0xd9,0x0c,0x7e,0xf9,
+	0x6b,0x4d,0x01,0x8e,0xe2,0x34,0x8b,0xda,0xbe,0x58,0xf6,0xd4,0xa3,0x94,0x0d,0xf0,
+	0x1b,0x5f,0xc6,0xdb,0x30,0xba,0xc2,0x5f,0x79,0x2a,0x55,0x06,0xcf,0xfc,0x52,0xd6,
+	0xc0,0xa1,0x9d,0x99,0xa2,0x1a,0xef,0xc4,0x90,0x85,0x78,0x83,0xc6,0x6e,0x61,0xcb,
+	0x74,0xda,0x4e,0x59,0x09,0x27,0x62,0x6c,0x02,0xfe,0xe4,0xb3,0xf7,0x1c,0x20,0x38,
+	0xc2,0x53,0xb8,0x22,0x5b,0xf7,0xc3,0xd1,0x9b,0x1e,0xde,0xdc,0x71,0xa4,0xa4,0x02,
+	0x63,0x35,0x90,0x69,0xb9,0x45,0x29,0x1f,0xa0,0x3f,0xba,0xdc,0xbf,0x44,0x34,0xcd,
+	0xbb,0x26,0x1c,0x8f,0xc9,0x86,0xff,0xf5,0xa0,0xe4,0x0b,0x77,0x67,0x99,0x58,0xbb,
+	0x04,0x3d,0xd9,0xe9,0x2f,0x2d,0x8d,0x88,0x92,0x39,0xbc,0xb0,0x73,0x5a,0x40,0xb1,
+	0x94,0x29,0xb0,0x51,0x7b,0x16,0x91,0x3d,0xfb,0xc8,0x79,0x0d,0x24,0x5a,0xea,0x11,
+	0xca,0x82,0xb8,0x8d,0xaa,0xb3,0x6f,0x9c,0x19,0xa1,0x22,0x68,0xc7,0xa6,0xe2,0x67,
+	0xbb,0x79,0xed,0x24,0x94,0x0b,0x91,0x07,0x5b,0xbf,0x43,0x45,0xd3,0xbe,0x4b,0xc6,
+	0xf3,0xb0,0xe8,0xea,0x7f,0x2b,0x48,0xd4,0xd4,0xe5,0xf4,0x85,0xb6,0x63,0x56,0xa1,
+	0xb9,0xd8,0xf8,0x3c,0x3e,0x9a,0xdf,0xcd,0x62,0xb7,0xb3,0x55,0x3c,0x6e,0x9b,0x6a,
+	0x9f,0x23,0x07,0x35,0x5e,0x89,0x29,0x8a,0xf1,0x0c,0x2c,0xd9,0xca,0x1f,0x69,0xae,
+	0x34,0x16,0x0a,0x8d,0xc4,0x52,0xa5,0xf0,0x40,0xee,0x65,0x82,0xed,0xdc,0x15,0xe4,
+	0x6a,0x66,0xb3,0xfa,0xcd,0x2a,0x37,0x27,0x1d,0x9c,0xfb,0x81,0xe8,0x8b,0x6f,0xef,
+	0x29,0x40,0x51,0x94,0xe7,0x51,0xd1,0xb6,0xcf,0x96,0xf3,0x14,0xa8,0xa8,0xda,0xfb,
+	0x08,0x78,0x91,0xe7,0x5b,0x71,0xa2,0xc5,0x1e,0x67,0x4c,0x08,0x1c,0xd0,0x39,0x3d,
+	0xa0,0x79,0xda,0x54,0xf9,0x3c,0x3d,0xaa,0xd9,0xce,0x5e,0x71,0xa8,0x65,0x0a,0x6d,
+	0xc4,0x9c,0x44,0x70,0x8d,0x37,0x62,0x4c,0x02,0xbc,0xc4,0x33,0xb5,0x34,0x21,0x7a,
+	0xe0,0xf3,0xfe,0x08,0x72,0x31,0xf3,0x51,0xf9,0x36,0x9d,0xbe,0xd3,0x46,0xca,0x29,
+	0x08,0xd1,0x00,0xaf,0xf1,0x44,0xac,0x4d,0x82,0xbf,0xfc,0xb4,0xb6,0x02,0x46,0x65,
+	0xd8,0x4c,0x7d,0x4d,0x2d,0x4e,0xb8,0x18,0xfb,0x80,0xf9,0x99,0x6c,0xfa,0x7f,0x0b,
+	0x48,0x96,0xf4,0x65,0xb6,0xad,0xb7,0x21,0x74,0x01,0xff,0xf2,0xd1,0xfa,0x0e,0x1a,
+	0xbd,0xe5,0x21,0xd5,0x11,0xb7,0x52,0x45,0xf0,0x8e,0x0f,0xe5,0x4f,0x34,0xdb,0xdb,
+	0x0b,0x0a,0xb7,0x64,0x25,0x9f,0xb8,0xb7,0x0a,0xc4,0x55,0xd4,0xee,0x45,0x83,0xbf,
+	0xfe,0x94,0xb2,0x00,0x6e,0xe1,0xca,0x6c,0x59,0x4f,0x47,0xea,0x2a,0x7a,0xf7,0x83,
+	0xd1,0x1f,0x5e,0xde,0x59,0x21,0xa6,0x20,0x46,0x23,0xb8,0xc4,0x3b,0x35,0x24,0x29,
+	0xda,0xf0,0xb9,0x7e,0x98,0x7a,0x99,0x62,0x1b,0x73,0x07,0x91,0x1e,0xcb,0x8c,0x5a,
+	0xb1,0xa0,0x69,0xdb,0x65,0xeb,0x7d,0x08,0x7c,0xd0,0xff,0x5d,0x20,0xbe,0xa2,0x57,
+	0x3f,0x5a,0xdd,0x61,0xa7,0xb5,0x14,0x20,0x28,0xc2,0x72,0xa8,0x62,0x7a,0x63,0xc3,
+	0xf0,0x8a,0x4e,0xfd,0x49,0x65,0xc7,0xbc,0x42,0x52,0xa1,0xb1,0x58,0xe8,0x34,0x9e,
+	0x8a,0x95,0x4d,0xf2,0xbf,0x1b,0xc4,0x76,0xe4,0xaa,0x66,0x3f,0x3b,0xcd,0xa5,0xc6,
+	0x21,0x91,0x51,0x3b,0x16,0x15,0x7d,0xfb,0x4d,0x29,0x0f,0xa0,0x1e,0xaa,0x9c,0x9e,
+	0xd0,0x34,0xec,0xaa,0x76,0x3f,0x1a,0xdd,0xe5,0xe7,0xb5,0x91,0x70,0x2a,0x46,0x36,
+	0xe8,0xef,0x2e,0x31,0x4f,0x91,0x8a,0x8b,0xad,0xcf,0xa1,0x83,0x79,0x9f,0x04,0x77,
+	0x79,0x79,0x65,0xa5,0x9c,0x80,0x30,0x09,0xf2,0x32,0xcb,0xd6,0xfa,0x00,0xfa,0xa1,
+	0xeb,0xf9,0x49,0x6c,0x57,0xae,0x4b,0xe6,0xf3,0xf2,0xc8,0x6a,0x3d,0x03,0x49,0x96,
+	0xf6,0x45,0xb2,0xaf,0x9f,0xa5,0x66,0x21,0xdb,0xf0,0xbb,0x5e,0x9c,0x78,0xb1,0xe6,
+	0x09,0x53,0x23,0x93,0x74,0x6f,0x1e,0x38,0xbd,0xa3,0x41,0x5d,0x57,0xcf,0x5b,0x22,
+	0x92,0x66,0x4d,0x1b,0x2e,0xd7,0x2e,0x43,0x6f,0x72,0xf8,0x63,0xcf,0x31,0x82,0x40,
+	0x0c,0x45,0x48,0x0e,0x74,0x5c,0x2f,0x4d,0x8c,0x5e,0xf0,0xb8,0x6f,0x8a,0x79,0x8c,
+	0x34,0x50,0x6a,0x05,0x82,0x2a,0xac,0x97,0x22,0x06,0x27,0x7c,0x8c,0x3f,0xe0,0x7c,
+	0x0e,0x1e,0xfc,0xfd,0x27,0x84,0x0d,0xd0,0x1b,0x1d,0xe6,0x5b,0x72,0x92,0xc3,0x1d,
+	0x5b,0x8a,0x13,0x2c,0xe6,0x3a,0x62,0x56,0xa2,0x89,0xde,0xfb,0x00,0xf8,0x81,0xef,
+	0xfb,0x61,0xe8,0x45,0x8e,0x6f,0xe4,0x99,0x56,0x5a,0x08,0x31,0x00,0x61,0x10,0xc4,
+	0x61,0x94,0x85,0x71,0x13,0xd4,0x67,0xd5,0x99,0x37,0x4a,0xcc,0x50,0x94,0xe4,0x61,
+	0xd7,0xb5,0xf3,0x50,0xe8,0x24,0x9e,0xab,0x85,0x0d,0xd3,0x2b,0x1b,0xe5,0x67,0xb4,
+	0x89,0xf3,0x2b,0x58,0xd5,0xe5,0xf7,0xb5,0xb0,0x60,0x6a,0x67,0xa2,0xe8,0xce,0x3f,
+	0x61,0x6c,0x04,0x9e,0xe8,0xb5,0x8f,0x90,0x17,0x58,0xae,0x55,0x06,0xce,0xec,0x50,
+	0xd7,0xd4,0xe3,0x94,0x89,0xb0,0x1b,0xda,0x96,0xd9,0xb4,0xfe,0x82,0xd2,0x2d,0x78,
+	0xd9,0x67,0xcf,0x39,0x02,0x50,0x04,0xe5,0x58,0x44,0xf4,0xcc,0x27,0xe5,0x1d,0x14,
+	0x7a,0x89,0x63,0x2a,0x61,0x46,0xa4,0xc8,0xc2,0xbd,0x59,0xe0,0xb6,0xae,0x86,0x37,
+	0x75,0x3c,0x2d,0xab,0xe8,0xdc,0x1f,0x44,0x7e,0x6c,0x3b,0x6e,0x95,0x8a,0x83,0x2d,
+	0xdf,0xa9,0x23,0x69,0xd5,0x84,0xe7,0x71,0xd1,0xf4,0xef,0x16,0xb1,0x3c,0xa9,0xea,
+	0xf8,0x5b,0x4e,0x52,0xb8,0x21,0x6b,0xf1,0xc0,0xed,0x5d,0x05,0xee,0xea,0x72,0xfb,
+	0x52,0xd9,0x30,0xbf,0x92,0x55,0x7c,0x6e,0x1f,0x2a,0x9f,0xa6,0x57,0x37,0xda,0xcd,
+	0x69,0x07,0xa5,0x5e,0xa0,0xb8,0xca,0xda,0x39,0x28,0xf0,0x52,0xcf,0x50,0x92,0x84,
+	0x6d,0xd1,0xcd,0x7f,0x67,0x88,0x48,0x98,0x15,0x69,0xba,0x74,0x3f,0x1e,0x9d,0xed,
+	0xe3,0xe5,0x99,0x55,0x6a,0x0e,0x32,0x3c,0xa7,0x0b,0xf4,0x57,0x97,0xda,0x87,0xc8,
+	0x87,0xed,0xd7,0xa5,0xf2,0x61,0xfa,0x65,0xab,0x7d,0x8c,0x3c,0xd0,0x7a,0x0d,0x22,
+	0x3a,0xe6,0x17,0xb2,0x0e,0x8f,0xed,0xc6,0xb5,0xd1,0x70,0xae,0x06,0x36,0x6d,0xbf,
+	0x2c,0xb5,0x0b,0xd1,0x07,0xdf,0xff,0x43,0xc0,0x83,0xbc,0xcf,0x82,0xb3,0x3d,0xbc,
+	0xb8,0xf3,0x4a,0x48,0x11,0x84,0x63,0x30,0xc1,0x73,0xbe,0x00,0x77,0x71,0xf9,0x75,
+	0xad,0x3c,0x90,0x7a,0x89,0x62,0x3a,0x63,0x47,0xb0,0x8a,0xcb,0xad,0x4b,0xe1,0x83,
+	0xfc,0xcf,0x06,0xf3,0x3d,0x39,0xe8,0xf1,0xce,0x0c,0x51,0x09,0x37,0x62,0x4d,0x12,
+	0xbe,0xc5,0x27,0xf7,0x3d,0x31,0x68,0xe1,0xc6,0xac,0x41,0x43,0xb7,0xf2,0x45,0xba,
+	0x2f,0x8f,0xad,0xc6,0x31,0x91,0x70,0x2b,0x56,0x34,0xe9,0xfb,0x6c,0x38,0x5f,0x83,
+	0x8b,0xbe,0xff,0x86,0x90,0x05,0x78,0x8b,0x47,0x6e,0x6b,0x6a,0x70,0xd2,0xc7,0xd9,
+	0x13,0x8e,0xc6,0x74,0xc1,0xfe,0x6e,0x12,0xfb,0x95,0xa9,0xb2,0x79,0xfe,0x14,0xb3,
+	0x18,0xed,0xe0,0xd4,0x8f,0x54,0x57,0xdc,0x6b,0x05,0x81,0x1a,0xaa,0x94,0x1e,0xc0,
+	0x3c,0x4c,0xba,0x3c,0xbf,0x8a,0xd5,0x4d,0x76,0xff,0x1b,0x41,0x26,0xe6,0x2e,0x22,
+	0x7f,0xb6,0x99,0xf7,0x4a,0x40,0x91,0x94,0x6b,0x90,0xd1,0x39,0x3e,0x90,0x7f,0xd9,
+	0x68,0x3f,0x27,0x0d,0x9c,0xda,0x91,0xa8,0xaa,0xfb,0xef,0x08,0x51,0x01,0xb7,0x72,
+	0x45,0xb2,0xae,0x8f,0xa7,0x67,0x35,0x99,0xf9,0xab,0x4c,0x9d,0x4d,0xe3,0xaf,0x38,
+	0xd5,0x22,0x87,0x37,0x76,0x0c,0x2b,0xa8,0xd4,0x1a,0x04,0x74,0x48,0x6f,0x64,0x98,
+	0x4e,0xd9,0x09,0x2f,0xe3,0x6c,0x08,0x5f,0xe0,0xbb,0x7e,0x9c,0x3a,0x91,0x66,0x4b,
+	0x7b,0x22,0xd1,0x56,0xcf,0x58,0x12,0x94,0x65,0x71,0xdd,0x35,0xe7,0x18,0x40,0x30,
+	0x84,0x23,0x30,0x45,0x33,0xbe,0x85,0x27,0x73,0x7d,0x31,0xed,0xb1,0xc4,0x28,0x05,
+	0x03,0x3a,0xa6,0x17,0x36,0x4e,0x8f,0x68,0x96,0xb7,0x55,0x34,0xee,0x8b,0x62,0x3f,
+	0x33,0x4d,0xb5,0xce,0x81,0x81,0x1b,0xbb,0x86,0x1d,0xd5,0x6a,0x07,0xa3,0x3e,0xac,
+	0xbe,0xb2,0x56,0x0e,0x48,0x9c,0x54,0x71,0xbc,0x25,0x23,0x79,0xd4,0xb5,0xf5,0x30,
+	0xe4,0x22,0xe6,0x27,0xb2,0x6d,0xbf,0x2d,0xa5,0x09,0xd0,0x13,0x9d,0xf6,0x53,0xd2,
+	0x82,0x89,0x9d,0xcb,0x82,0xbb,0xbd,0xac,0xb0,0x53,0x5a,0x02,0x91,0x14,0x6b,0x98,
+	0x50,0x39,0x34,0x31,0x7b,0xd1,0xe1,0xbf,0x3d,0xa4,0x38,0xc2,0x52,0xa8,0x20,0x5a,
+	0xe3,0x81,0xd8,0x8b,0x0c,0xdf,0xe9,0x23,0xed,0x95,0x84,0x62,0x21,0xd3,0x70,0xab,
+	0x56,0x3c,0x68,0xfb,0x66,0x99,0x5b,0x8b,0x02,0x3e,0xe5,0x2f,0x34,0x1d,0xbb,0x8b,
+	0xcd,0xcf,0x67,0xe3,0xf9,0x58,0x7c,0x74,0xbf,0x1f,0x85,0x6e,0xe2,0xfb,0x7a,0x58,
+	0x72,0x95,0xb3,0x13,0x5c,0xe6,0xdd,0x12,0x96,0x44,0x65,0xdd,0x1c,0x77,0x48,0x69,
+	0x04,0x94,0x48,0xa1,0x85,0x18,0x83,0x00,0x0e,0xe1,0x0c,0x0c,0xd9,0x88,0x3f,0xe9,
+	0xec,0x1c,0x17,0x48,0xaf,0x64,0x14,0x8f,0xd9,0x86,0xde,0xe5,0xe0,0xc5,0x9f,0x77,
+	0x46,0x88,0x08,0x98,0x91,0x29,0xba,0xf1,0x6f,0x1c,0x19,0xa9,0xa3,0x68,0xcd,0x07,
+	0xe6,0x6f,0x32,0xf9,0xf7,0x8d,0x30,0x13,0x52,0x07,0xd1,0x1e,0x4f,0xcc,0x5a,0x34,
+	0xf0,0x6b,0x5f,0x21,0xab,0xf0,0x5c,0x2e,0x5c,0x9e,0x5d,0xe5,0xee,0x24,0x93,0x7b,
+	0x9f,0x00,0x37,0x71,0x7d,0x35,0xad,0xb9,0xc0,0x78,0x0d,0x26,0x7a,0xee,0x13,0xe2,
+	0x06,0xaa,0xad,0x8e,0xb1,0x05,0x38,0x8b,0xc3,0x2e,0x6b,0xef,0x20,0xd0,0x43,0x9d,
+	0x53,0x03,0x92,0x26,0x4d,0x9f,0x6e,0xd7,0xab,0x13,0x6d,0xf6,0xbc,0x23,0x42,0x65,
+	0xd0,0xcc,0x6d,0x45,0x8d,0x5e,0xf2,0x98,0x6b,0x88,0x51,0x08,0x26,0x70,0x4e,0x07,
+	0xe8,0x8e,0x3e,0xf5,0x2e,0x05,0x0f,0xfa,0xbe,0x1b,0xc6,0x56,0xe0,0xa8,0x4e,0xbb,
+	0x29,0xed,0x81,0xc4,0x4b,0x35,0xc3,0x59,0x1a,0x16,0x55,0x7d,0x7f,0x0d,0x29,0x8a,
+	0xf0,0x1c,0x2e,0xd8,0xde,0x5d,0x60,0xbe,0x26,0x17,0x3f,0xdf,0x8d,0x63,0x23,0xf1,
+	0x54,0xad,0x7c,0x90,0xfe,0xc9,0x62,0xbf,0x33,0x45,0x34,0xce,0x8b,0x20,0x1f,0xb3,
+	0x0f,0x9d,0xcf,0xc3,0xa3,0xbb,0xfd,0xac,0x34,0x13,0x5a,0x87,0xc1,0x16,0xef,0xdc,
+	0x10,0xb4,0x60,0x63,0xf7,0xb0,0xe1,0x7a,0x6d,0x22,0xfc,0x86,0x97,0x75,0x76,0x8c,
+	0x2b,0xa0,0x55,0x1a,0x0e,0xd5,0x4c,0x67,0xed,0x18,0x54,0x70,0xad,0x37,0x20,0x6c,
+	0x82,0xfe,0xec,0x32,0xf7,0x16,0x81,0x3c,0xca,0xda,0x38,0x38,0xf2,0x53,0xdb,0x12,
+	0x9b,0x94,0x7f,0xd0,0xf8,0x2d,0x2e,0xb9,0xce,0x99,0x01,0x2a,0xa3,0x66,0x2c,0x0b,
+	0xea,0xb6,0xba,0xc6,0x1e,0x61,0x2c,0x04,0x1a,0xa8,0xb5,0x0a,0xc0,0x15,0xdc,0xea,
+	0x15,0x8b,0x9a,0xbe,0xdc,0xb6,0xd4,0x26,0xc4,0x0f,0x74,0x5f,0x1f,0x4b,0x8f,0x62,
+	0x36,0xa3,0x5f,0xbc,0x7a,0xd3,0xc2,0x8b,0x39,0x8f,0x80,0x16,0x69,0xbc,0x14,0x33,
+	0x18,0xe5,0x61,0xd4,0x85,0xf5,0x53,0xd4,0xe2,0x85,0x9b,0xb3,0x0e,0x8c,0xdd,0xc0,
+	0xb6,0xed,0xb6,0xb5,0x36,0x00,0x6e,0xe0,0xda,0x6e,0x58,0x5b,0x05,0xe3,0x3a,0x68,
+	0xf6,0xb6,0x83,0x56,0x6f,0x58,0x58,0x35,0xe5,0x39,0x54,0x30,0xad,0xb3,0x60,0x6c,
+	0x07,0xae,0xee,0xb6,0xb3,0x56,0x0c,0x68,0x98,0x56,0x59,0x38,0x37,0x03,0x5d,0xd6,
+	0xdf,0x51,0xa2,0x86,0x2e,0xe5,0x0f,0x34,0x5f,0x9b,0x0b,0x8f,0xe7,0x66,0xa1,0xdb,
+	0xf8,0x3a,0x5e,0x96,0xd9,0xb5,0xee,0x80,0xd3,0x39,0x3a,0xd0,0x77,0xdd,0x38,0x37,
+	0x02,0x4d,0xd4,0xde,0x45,0xe0,0x8f,0x3e,0xf7,0x0e,0x01,0x0d,0xd2,0x3a,0x09,0xe6,
+	0x72,0xe2,0xc2,0xea,0x29,0x4b,0xe1,0x82,0xec,0xcd,0x07,0xe7,0x7f,0x30,0xf8,0xe3,
+	0xcf,0x39,0x03,0x40,0x06,0xe4,0x4c,0x06,0xfd,0xdc,0x35,0xe4,0x28,0x46,0x33,0xb8,
+	0xe5,0x2b,0x75,0x05,0xbd,0xda,0xd1,0xa8,0x2e,0xbb,0xef,0x8d,0x01,0x03,0x33,0x36,
+	0x05,0x3f,0xfa,0xdd,0x2b,0x06,0x35,0x5c,0xa9,0x2d,0x88,0xd9,0x88,0x3e,0xf9,0xee,
+	0x1d,0x03,0x0a,0xa6,0x74,0x06,0x8e,0xec,0xd4,0x97,0xd4,0x66,0xc4,0x8b,0x34,0x5f,
+	0x9a,0x1b,0x8d,0xe6,0x72,0xe3,0xd2,0xe8,0x28,0x5f,0xa3,0x8b,0xfc,0xdf,0x06,0xd2,
+	0x2d,0x79,0xc9,0x65,0xce,0x2d,0x40,0x59,0x14,0xf7,0x59,0x71,0xa6,0x85,0x16,0x63,
+	0x1c,0x00,0x39,0x90,0x71,0x39,0x74,0x31,0xff,0x91,0xe1,0x3a,0x6d,0xa6,0xbc,0x86,
+	0x12,0x25,0x74,0x08,0x6f,0xe0,0xd8,0x4e,0x5c,0x59,0x2d,0x67,0x28,0x48,0xd2,0xb4,
+	0xe9,0xf2,0xfd,0x3a,0x54,0x36,0xcd,0xbf,0x66,0x14,0x8b,0x99,0x8e,0xda,0xb5,0xe8,
+	0xe0,0xdf,0x3f,0x42,0x5c,0x40,0xbd,0x54,0x31,0xbc,0xa1,0x63,0x79,0x51,0xe5,0xf7,
+	0xb4,0xa0,0x62,0x6b,0x73,0xe0,0xe1,0xde,0x2d,0x60,0x59,0x56,0xd7,0xd9,0x33,0x8e,
+	0x84,0x54,0x41,0xbc,0x46,0x13,0xb9,0xb7,0x09,0xf4,0x53,0xd7,0xd2,0x83,0x98,0x8f,
+	0xc8,0x97,0xed,0xf6,0xb5,0xb2,0x40,0x6e,0x65,0x8a,0x6c,0xdc,0x1f,0x45,0x6e,0x6e,
+	0x3a,0x7a,0xd7,0x83,0x93,0x3f,0xde,0x9c,0x71,0x20,0xe4,0x02,0xe6,0x65,0x92,0xed,
+	0xfd,0x05,0xa4,0x4b,0xf2,0xb3,0xdb,0xdc,0x7a,0x14,0xb2,0x09,0xff,0xe3,0xc1,0xd9,
+	0x1f,0x4e,0xde,0x78,0x31,0xe6,0x01,0xd2,0x23,0x99,0xd5,0x6b,0x16,0xb1,0x3d,0xb9,
+	0xe8,0xf9,0x4f,0x0c,0x5b,0xa8,0x33,0x6a,0xc4,0x92,0xa4,0x6c,0x83,0xef,0xfe,0x31,
+	0xe2,0x40,0xca,0x25,0xc8,0xc9,0x0c,0x5f,0xe9,0x2b,0x6c,0x95,0x8e,0xc3,0x25,0xdb,
+	0xf9,0x2b,0x4c,0x95,0xcc,0xe3,0xa5,0x99,0xd1,0x2a,0x0e,0xb7,0x6c,0xa5,0x8f,0xb0,
+	0x17,0x1a,0x8e,0xd5,0x44,0xe6,0xed,0x12,0xf5,0x74,0xa5,0xbe,0xa0,0x76,0x2b,0x5a,
+	0xf4,0xf1,0xf7,0x9c,0x20,0x30,0x43,0x53,0xb2,0x83,0x5f,0xff,0x4a,0x51,0x81,0xb7,
+	0x7a,0xc4,0xb2,0xa4,0x2e,0xa3,0x6f,0xbc,0x19,0xe3,0x02,0xe8,0x85,0x8e,0xe3,0x25,
+	0x99,0xd9,0xab,0x0e,0xbd,0xcd,0xa1,0x87,0x39,0x97,0x00,0x27,0x71,0x5c,0x25,0xed,
+	0x98,0x54,0x78,0x2c,0x37,0x2a,0xcd,0x86,0xf6,0x65,0xb2,0xed,0xbf,0x25,0x24,0x09,
+	0xda,0xb2,0x99,0xfe,0xda,0x52,0x98,0x20,0x39,0xd3,0x41,0xbb,0x37,0x0d,0xbc,0xda,
+	0xd3,0x88,0x2a,0xb9,0xc7,0x09,0x13,0x23,0x17,0x34,0x6f,0x9b,0x68,0xbf,0x27,0x05,
+	0x1d,0xda,0x9b,0x09,0xae,0xf3,0x66,0x88,0x4b,0xa8,0x13,0x6a,0x86,0xb2,0x24,0x2e,
+	0xab,0xee,0xbc,0x13,0x42,0x06,0xe0,0x0c,0x0e,0xf9,0x8c,0x3d,0xc1,0x68,0x0e,0x37,
+	0x6c,0xad,0x0e,0xb0,0x1d,0xbb,0x8a,0xdd,0xcd,0x66,0xf7,0xbb,0x51,0x6c,0x66,0xbe,
+	0x2a,0xd7,0x27,0xd3,0x7d,0x7b,0x4c,0x31,0x8c,0xa1,0x00,0x49,0x91,0x86,0x4b,0xb5,
+	0xc3,0x51,0x9b,0x16,0x5f,0xdc,0x7b,0x05,0xa0,0x0a,0xea,0xb5,0x8a,0xc0,0x1d,0x5d,
+	0xea,0x1f,0x2a,0x9e,0xb6,0x55,0x36,0xce,0x8f,0x60,0x17,0xb7,0x5f,0x95,0xea,0x83,
+	0xeb,0xbf,0x29,0xe4,0x11,0xd6,0x42,0x81,0x91,0x1a,0x8a,0x94,0x5c,0xe0,0xbc,0x0e,
+	0x92,0x3d,0xfd,0xa8,0x75,0x0b,0x5c,0xd6,0xdd,0x71,0xa6,0x84,0x06,0x61,0x1d,0x14,
+	0x7b,0x99,0x61,0x2b,0x75,0x04,0xad,0xd8,0xd0,0xbc,0x6c,0xb2,0xff,0x9f,0x00,0x36,
+	0x61,0x7f,0x34,0xb9,0xfb,0xc9,0x68,0x1f,0x27,0x4f,0xbc,0x5a,0xd3,0x80,0xab,0xb9,
+	0xcd,0xa8,0x17,0x2b,0x9e,0xb4,0x75,0x32,0xcc,0xa7,0xe4,0x05,0x97,0x7b,0x97,0x80,
+	0x27,0x79,0xdd,0x25,0xe7,0x39,0x50,0x70,0xa5,0xb7,0x30,0x64,0x22,0xee,0xa6,0xb2,
+	0x67,0x1e,0x29,0xad,0x80,0x50,0x09,0x34,0x52,0x4b,0x11,0x82,0x03,0x3c,0xc7,0x0b,
+	0x32,0x37,0x17,0x1d,0xff,0xcb,0x41,0x8b,0x37,0x6e,0x8c,0x1a,0xb0,0x34,0x2b,0xda,
+	0xf4,0xf9,0x76,0x9c,0x2a,0x91,0x47,0x5b,0x3b,0x03,0x45,0x56,0xee,0x49,0x42,0xb7,
+	0xf0,0x65,0xbe,0x2d,0xa7,0x29,0xd4,0x11,0xb5,0x72,0x41,0xf2,0xa6,0x8b,0xf7,0x6f,
+	0x10,0xd9,0xb1,0xaf,0x98,0xd5,0x68,0x26,0xb7,0x3e,0x85,0x2e,0xe2,0x7f,0x3a,0x58,
+	0xf7,0xc5,0xb1,0x97,0x18,0xa6,0x50,0x46,0xc4,0xc8,0x04,0xdd,0xd9,0x27,0xce,0xad,
+	0x40,0x51,0x95,0xf7,0x53,0xd0,0xa2,0x8d,0x9f,0xe3,0x06,0xa9,0x9d,0x88,0xb2,0x39,
+	0xfe,0x90,0xf3,0x18,0x68,0xb0,0xd6,0x0b,0x10,0x17,0x51,0x3f,0x57,0x0d,0x7b,0xaa,
+	0x51,0x4e,0x46,0xf8,0x08,0x7f,0xe1,0xe9,0x5c,0x1d,0x6c,0xfb,0x6e,0x19,0x4b,0x83,
+	0xa2,0x2e,0xaf,0xaf,0xa4,0x15,0x13,0x1a,0x87,0x45,0x56,0xef,0x59,0x40,0xb6,0xe4,
+	0x27,0xb7,0x3d,0xb5,0x28,0xe1,0x43,0xfc,0x43,0xc7,0xf3,0xb2,0xc8,0xee,0x7d,0x03,
+	0xcc,0xc6,0xf4,0xc1,0xf6,0xef,0x12,0xf1,0x34,0xad,0xba,0xf0,0x7e,0x0e,0x1a,0xbc,
+	0xf5,0x23,0xd4,0x05,0xf5,0x5b,0x55,0xe2,0x8f,0x3a,0xb7,0x06,0x05,0x5d,0xda,0x1f,
+	0x49,0xae,0x76,0x36,0x8a,0xcf,0xec,0x53,0xe7,0xd2,0xe0,0xa8,0x4f,0xab,0x2b,0xec,
+	0x95,0x86,0x42,0x25,0xd1,0x58,0x2f,0x44,0x1c,0x4c,0xf9,0x0c,0x3d,0xc9,0xe9,0x0e,
+	0x3d,0xcd,0xa9,0x06,0x39,0x9d,0xa1,0x23,0x79,0xd5,0xa5,0xf7,0x31,0xf0,0x60,0xef,
+	0x37,0xa0,0x6c,0x8a,0x7f,0xec,0x38,0x56,0x12,0x89,0xb5,0x4a,0xc0,0x91,0x9c,0xea,
+	0x90,0xdb,0x98,0x3a,0x98,0xf6,0x59,0x72,0x96,0x83,0x15,0x5f,0xda,0x1b,0x09,0xa6,
+	0x72,0x66,0x82,0xea,0xac,0x1b,0xe3,0x06,0xa8,0x8d,0x8a,0xb3,0x2d,0xbc,0x99,0xe3,
+	0x0a,0x69,0x85,0x84,0x42,0x21,0x91,0x50,0x2b,0x14,0x14,0x69,0xb9,0x44,0x39,0x1d,
+	0xa1,0x2b,0xf8,0xd5,0xaf,0x56,0x35,0xf8,0xe9,0x6f,0x2d,0x09,0xc8,0x92,0xbc,0xec,
+	0xb2,0xf7,0x1e,0x00,0x3c,0xc0,0x7b,0x3c,0x30,0x7b,0xd3,0xc1,0xbb,0x3f,0x8c,0xbc,
+	0xd0,0x72,0x8c,0x22,0x30,0x47,0x13,0xba,0x87,0x0f,0xf7,0x6f,0x11,0xc9,0xb3,0xae,
+	0x8c,0x97,0x61,0x36,0xa5,0x3f,0xb0,0x7c,0xab,0x4e,0xbc,0x59,0xe3,0x86,0xa8,0x85,
+	0x0b,0xb3,0x27,0x1d,0x9d,0xeb,0x83,0xe9,0x9f,0x2d,0xe6,0x39,0x52,0x50,0xa1,0xb5,
+	0x18,0xe0,0x30,0xce,0x82,0xb0,0x0d,0xba,0xbb,0xcf,0x8c,0x53,0x21,0xb2,0x60,0x6f,
+	0x37,0xa8,0xed,0x8a,0x75,0x4d,0x3c,0x5e,0x9b,0x09,0xaf,0xe3,0x64,0x89,0x5f,0xea,
+	0x1a,0x7a,0x94,0xb3,0x11,0x7c,0xe2,0xdf,0x3a,0x12,0x56,0x45,0xf9,0x1e,0x1d,0xec,
+	0xfb,0x66,0x98,0x4b,0x89,0x03,0x2a,0xa7,0x26,0x24,0x0f,0xba,0xbe,0x9f,0x86,0x56,
+	0x65,0xf8,0x4c,0x3f,0x6d,0xad,0x0c,0x90,0x19,0xb9,0xa2,0x59,0xdf,0x46,0xd3,0xb9,
+	0x3b,0xc8,0xf4,0xdc,0x26,0xd4,0x0f,0x55,0x4f,0x5f,0x6a,0x1b,0x62,0x17,0xb2,0x0f,
+	0x9f,0xef,0xc7,0xa1,0x93,0x79,0xbe,0x14,0x37,0x58,0xed,0x65,0x84,0x8d,0xd0,0x13,
+	0x9c,0xe6,0x51,0xd3,0x96,0xcb,0x94,0xdb,0x90,0xba,0x88,0xfe,0xf9,0x62,0xdc,0x03,
+	0x85,0x57,0x72,0x8a,0x43,0x2c,0x43,0x6a,0x22,0xf2,0x66,0x8b,0x7b,0xae,0x10,0x56,
+	0x40,0xa9,0x14,0x18,0xa8,0xb1,0x4a,0xc8,0x11,0x8c,0xe2,0x30,0xcb,0xd2,0xba,0x08,
+	0xfe,0xf1,0xe3,0xdc,0x09,0x24,0x53,0x7a,0x03,0xc3,0x36,0xea,0xce,0x3a,0x31,0x66,
+	0x01,0xda,0xa2,0x99,0xdf,0xca,0x12,0xb9,0xb4,0x39,0xf2,0x50,0xeb,0x14,0x98,0xa8,
+	0xb9,0xcb,0xc8,0x1b,0x2d,0xe6,0x38,0x42,0x52,0xa0,0xa1,0x5a,0xe9,0x20,0xdc,0x83,
+	0x85,0x5f,0xf3,0x8a,0x49,0x8d,0x47,0x62,0xab,0x72,0x7c,0x22,0xdf,0xb6,0xd3,0x56,
+	0xca,0x08,0x18,0x91,0x21,0x3b,0xf1,0x65,0xbd,0x1d,0xa1,0x2a,0xe8,0xd7,0xae,0x42,
+	0x77,0xf1,0xf9,0x7d,0x2c,0x3c,0x9a,0xdb,0x8d,0x6a,0xb3,0xe3,0x5d,0x19,0x2e,0xd3,
+	0x6e,0x4b,0x6b,0x22,0xf0,0x46,0x8f,0x79,0x86,0x94,0x44,0x60,0x8d,0x16,0x72,0x0c,
+	0x23,0x28,0xc4,0x12,0xa4,0x64,0x02,0xef,0xf4,0x90,0xe6,0x48,0x43,0xa5,0xd2,0x60,
+	0xa8,0x47,0x2a,0x2b,0xe6,0x34,0x82,0x4a,0xac,0x51,0x42,0x86,0xe0,0x04,0x8f,0xf9,
+	0x86,0x9c,0xc5,0x60,0x87,0xb7,0x76,0x04,0xaa,0xa8,0xde,0xbb,0x00,0x7c,0xc1,0xef,
+	0x7e,0x31,0xea,0xc1,0xca,0x2f,0x69,0xcd,0x04,0xd6,0x69,0x31,0xc5,0x31,0x96,0x00,
+	0x25,0x51,0x58,0x27,0xc5,0x1c,0x46,0x58,0x08,0x35,0x40,0x69,0x14,0x94,0x69,0xb1,
+	0xc5,0x39,0x17,0x00,0x2f,0xf0,0x5c,0x2f,0x4c,0x9c,0x5c,0xf1,0xac,0x2d,0x83,0x69,
+	0x9e,0x35,0x65,0x38,0x4c,0xb3,0xac,0xad,0x83,0x61,0x1f,0x35,0x6f,0x99,0x48,0xbb,
+	0x25,0x2d,0x99,0xc8,0xbb,0x2d,0xac,0x99,0xc2,0x1a,0x29,0xa4,0x10,0x42,0x00,0x00
+};
+
@@ -206,10 +206,16 @@ typedef	struct ShaderInfo {
 		GLint u_palette;
 } ShaderInfo;
 
+// The screen is uploaded to these in turn, so the upload does not wait for
+// the GPU to finish drawing the previous frame from the same texture
+#define	SCREEN_TEXTURES	2
+
 static ShaderInfo shader;
 static ShaderInfo shader_filtering;
 static GLuint buffers[3];
-static GLuint textures[2];
+static GLuint screen_textures[SCREEN_TEXTURES];
+static GLuint palette_texture;
+static int screen_texture;
 static char palette_changed;
 
 void gles2_create()
@@ -238,10 +244,16 @@ void gles2_create()
 	if(!shader.program || !shader_filtering.program)
 		return;
 
-	glGenTextures(2, textures);	SHOW_ERROR
-	glBindTexture(GL_TEXTURE_2D, textures[0]); SHOW_ERROR
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE, TEX_WIDTH, TEX_HEIGHT, 0, GL_LUMINANCE, GL_UNSIGNED_BYTE, NULL); SHOW_ERROR
-	glBindTexture(GL_TEXTURE_2D, textures[1]); SHOW_ERROR	// color palette
+	int i;
+	glGenTextures(SCREEN_TEXTURES, screen_textures); SHOW_ERROR
+	for(i = 0; i < SCREEN_TEXTURES; ++i)
+	{
+		glBindTexture(GL_TEXTURE_2D, screen_textures[i]); SHOW_ERROR
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE, TEX_WIDTH, TEX_HEIGHT, 0, GL_LUMINANCE, GL_UNSIGNED_BYTE, NULL); SHOW_ERROR
+	}
+	screen_texture = 0;
+	glGenTextures(1, &palette_texture); SHOW_ERROR
+	glBindTexture(GL_TEXTURE_2D, palette_texture); SHOW_ERROR	// color palette
 	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, 256, 1, 0, GL_RGB, GL_UNSIGNED_SHORT_5_6_5, NULL); SHOW_ERROR
 
 	glGenBuffers(3, buffers); SHOW_ERROR
@@ -268,7 +280,8 @@ void gles2_destroy()
 	if(!shader.program || !shader_filtering.program)
 		return;
 	glDeleteBuffers(3, buffers); SHOW_ERROR
-	glDeleteTextures(2, textures); SHOW_ERROR
+	glDeleteTextures(SCREEN_TEXTURES, screen_textures); SHOW_ERROR
+	glDeleteTextures(1, &palette_texture); SHOW_ERROR
 }
 
 static void SetOrtho(float m[4][4], float left, float right, float bottom, float top, float near, float far, float scale_x, float scale_y)
@@ -283,14 +296,14 @@ static void SetOrtho(float m[4][4], float left, float right, float bottom, float
 	m[3][3] = 1;
 }
 
-static void gles2_DrawQuad(const ShaderInfo *sh, GLuint textures[2])
+static void gles2_DrawQuad(const ShaderInfo *sh)
 {
 	glUniform1i(sh->u_texture, 0); SHOW_ERROR
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST); SHOW_ERROR //@note : GL_LINEAR must be implemented in shader because of palette indexes in texture
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST); SHOW_ERROR
 
 	glActiveTexture(GL_TEXTURE1); SHOW_ERROR
-	glBindTexture(GL_TEXTURE_2D, textures[1]); SHOW_ERROR
+	glBindTexture(GL_TEXTURE_2D, palette_texture); SHOW_ERROR
 	glUniform1i(sh->u_palette, 1); SHOW_ERROR
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST); SHOW_ERROR
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST); SHOW_ERROR
@@ -346,14 +359,16 @@ void gles2_draw(int _w, int _h)
 			palette[i] = BGR565(Colours_GetR(i), Colours_GetG(i), Colours_GetB(i));
 		}
 		glActiveTexture(GL_TEXTURE1); SHOW_ERROR
-	    glBindTexture(GL_TEXTURE_2D, textures[1]); SHOW_ERROR
+	    glBindTexture(GL_TEXTURE_2D, palette_texture); SHOW_ERROR
 		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 256, 1, GL_RGB, GL_UNSIGNED_SHORT_5_6_5, palette); SHOW_ERROR
 	}
 
 	glActiveTexture(GL_TEXTURE0); SHOW_ERROR
-	glBindTexture(GL_TEXTURE_2D, textures[0]); SHOW_ERROR
+	glBindTexture(GL_TEXTURE_2D, screen_textures[screen_texture]); SHOW_ERROR
+	// Screen_atari holds palette indexes, looked up in the fragment shader
 	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, WIDTH, HEIGHT, GL_LUMINANCE, GL_UNSIGNED_BYTE, Screen_atari); SHOW_ERROR
-	gles2_DrawQuad(sh, textures);
+	gles2_DrawQuad(sh);
+	screen_texture = (screen_texture + 1) % SCREEN_TEXTURES;
 
 	glBindBuffer(GL_ARRAY_BUFFER, 0); SHOW_ERROR
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0); SHOW_ERROR
@@ -35,6 +35,9 @@
 #include "statesav.h"
 #endif
 #include "pokeysnd.h"
+#ifdef POKEYREC
+#include "pokeyrec.h"
+#endif
 #include "screen.h"
 
 /* GTIA Registers ---------------------------------------------------------- */
@@ -144,6 +147,11 @@ static ULONG hposp_mask[4];
 
 static ULONG grafp_lookup[4][256];
 static ULONG *grafp_ptr[4];
+#ifdef WORDS_UNALIGNED_OK
+/* Four bits of grafp spread over four bytes, 1 in each set one; the
+   bytes are in memory order, so a long written at ptr covers ptr[0..3] */
+static ULONG pm_expand[16];
+#endif
 static int global_sizem[4];
 
 static const int PM_Width[4] = {1, 2, 1, 4};
@@ -245,6 +253,15 @@ int GTIA_Initialise(int *argc, char *argv[])
 		grafp_lookup[1][i] = grafp2;
 		grafp_lookup[3][i] = grafp4;
 	}
+#ifdef WORDS_UNALIGNED_OK
+	for (i = 0; i < 16; i++) {
+		UBYTE bytes[4];
+		int j;
+		for (j = 0; j < 4; j++)
+			bytes[j] = (i >> j) & 1;
+		memcpy(&pm_expand[i], bytes, sizeof(ULONG));
+	}
+#endif
 	memset(ANTIC_cl, GTIA_COLOUR_BLACK, sizeof(ANTIC_cl));
 	for (i = 0; i < 32; i++)
 		GTIA_PutByte((UWORD) i, 0);
@@ -323,8 +340,21 @@ void GTIA_UpdatePmplColls(void)
 	hitclr_pos = 0;
 }
 
+/* bring PF0PM-PF3PM up to the current position: draw the scanline so far,
+   and wait for the lines before if a thread draws them */
+static void update_pf_colls(void)
+{
+	if (ANTIC_DRAWING_SCREEN) {
+		ANTIC_UpdateScanline();
+	}
+#ifdef ANTIC_RENDER_THREAD
+	ANTIC_SyncCollisions();
+#endif
+}
+
 #else
 #define update_partial_pmpl_colls()
+#define update_pf_colls()
 #endif /* NEW_CYCLE_EXACT */
 
 /* Prepare PMG scanline ---------------------------------------------------- */
@@ -346,6 +376,57 @@ void GTIA_NewPmScanline(void)
 
 /* Draw Players */
 
+#ifdef WORDS_UNALIGNED_OK
+
+/* Players are drawn four pixels at a time. hposp_mask has cleared the bits
+   that would land before GTIA_pm_scanline + 2, so a player starting left of
+   GTIA_pm_scanline is shifted to start there. The last long written ends
+   at most at GTIA_pm_scanline + 0x9e + 32, inside the array. */
+#define PM_CLIP_LEFT(ptr, grafp)	if (ptr < GTIA_pm_scanline) {		\
+		grafp >>= GTIA_pm_scanline - ptr;							\
+		ptr = GTIA_pm_scanline;										\
+	}
+
+#define DO_PLAYER(n)	if (GTIA_GRAFP##n) {						\
+	ULONG grafp = grafp_ptr[n][GTIA_GRAFP##n] & hposp_mask[n];	\
+	if (grafp) {											\
+		UBYTE *ptr = hposp_ptr[n];							\
+		ULONG coll = 0;										\
+		GTIA_pm_dirty = TRUE;									\
+		PM_CLIP_LEFT(ptr, grafp)							\
+		do {												\
+			ULONG bytes = pm_expand[grafp & 0xf];			\
+			if (bytes) {									\
+				ULONG old = UNALIGNED_GET_LONG(ptr, pm_scanline_read_long_stat);	\
+				coll |= old & (bytes * 0xff);				\
+				UNALIGNED_PUT_LONG(ptr, old | (bytes << n), pm_scanline_read_long_stat);	\
+			}												\
+			ptr += 4;										\
+			grafp >>= 4;									\
+		} while (grafp);									\
+		coll |= coll >> 16;									\
+		coll |= coll >> 8;									\
+		P##n##PL_T |= (coll & 0xff) | (1 << n);				\
+	}														\
+}
+
+	/* optimized DO_PLAYER(0): GTIA_pm_scanline is clear and P0PL is unused */
+	if (GTIA_GRAFP0) {
+		ULONG grafp = grafp_ptr[0][GTIA_GRAFP0] & hposp_mask[0];
+		if (grafp) {
+			UBYTE *ptr = hposp_ptr[0];
+			GTIA_pm_dirty = TRUE;
+			PM_CLIP_LEFT(ptr, grafp)
+			do {
+				UNALIGNED_PUT_LONG(ptr, pm_expand[grafp & 0xf], pm_scanline_read_long_stat);
+				ptr += 4;
+				grafp >>= 4;
+			} while (grafp);
+		}
+	}
+
+#else /* WORDS_UNALIGNED_OK */
+
 #define DO_PLAYER(n)	if (GTIA_GRAFP##n) {						\
 	ULONG grafp = grafp_ptr[n][GTIA_GRAFP##n] & hposp_mask[n];	\
 	if (grafp) {											\
@@ -375,6 +456,8 @@ void GTIA_NewPmScanline(void)
 		}
 	}
 
+#endif /* WORDS_UNALIGNED_OK */
+
 	DO_PLAYER(1)
 	DO_PLAYER(2)
 	DO_PLAYER(3)
@@ -435,81 +518,49 @@ UBYTE GTIA_GetByte(UWORD addr, int no_side_effects)
 {
 	switch (addr & 0x1f) {
 	case GTIA_OFFSET_M0PF:
-#ifdef NEW_CYCLE_EXACT
-	if (ANTIC_DRAWING_SCREEN) {
-			ANTIC_UpdateScanline();
-	}
-#endif
+		update_pf_colls();
 		return (((PF0PM & 0x10) >> 4)
 		      + ((PF1PM & 0x10) >> 3)
 		      + ((PF2PM & 0x10) >> 2)
 		      + ((PF3PM & 0x10) >> 1)) & GTIA_collisions_mask_missile_playfield;
 	case GTIA_OFFSET_M1PF:
-#ifdef NEW_CYCLE_EXACT
-	if (ANTIC_DRAWING_SCREEN) {
-			ANTIC_UpdateScanline();
-	}
-#endif
+		update_pf_colls();
 		return (((PF0PM & 0x20) >> 5)
 		      + ((PF1PM & 0x20) >> 4)
 		      + ((PF2PM & 0x20) >> 3)
 		      + ((PF3PM & 0x20) >> 2)) & GTIA_collisions_mask_missile_playfield;
 	case GTIA_OFFSET_M2PF:
-#ifdef NEW_CYCLE_EXACT
-	if (ANTIC_DRAWING_SCREEN) {
-			ANTIC_UpdateScanline();
-	}
-#endif
+		update_pf_colls();
 		return (((PF0PM & 0x40) >> 6)
 		      + ((PF1PM & 0x40) >> 5)
 		      + ((PF2PM & 0x40) >> 4)
 		      + ((PF3PM & 0x40) >> 3)) & GTIA_collisions_mask_missile_playfield;
 	case GTIA_OFFSET_M3PF:
-#ifdef NEW_CYCLE_EXACT
-	if (ANTIC_DRAWING_SCREEN) {
-			ANTIC_UpdateScanline();
-	}
-#endif
+		update_pf_colls();
 		return (((PF0PM & 0x80) >> 7)
 		      + ((PF1PM & 0x80) >> 6)
 		      + ((PF2PM & 0x80) >> 5)
 		      + ((PF3PM & 0x80) >> 4)) & GTIA_collisions_mask_missile_playfield;
 	case GTIA_OFFSET_P0PF:
-#ifdef NEW_CYCLE_EXACT
-	if (ANTIC_DRAWING_SCREEN) {
-			ANTIC_UpdateScanline();
-	}
-#endif
+		update_pf_colls();
 		return ((PF0PM & 0x01)
 		      + ((PF1PM & 0x01) << 1)
 		      + ((PF2PM & 0x01) << 2)
 		      + ((PF3PM & 0x01) << 3)) & GTIA_collisions_mask_player_playfield;
 	case GTIA_OFFSET_P1PF:
-#ifdef NEW_CYCLE_EXACT
-	if (ANTIC_DRAWING_SCREEN) {
-			ANTIC_UpdateScanline();
-	}
-#endif
+		update_pf_colls();
 		return (((PF0PM & 0x02) >> 1)
 		      + (PF1PM & 0x02)
 		      + ((PF2PM & 0x02) << 1)
 		      + ((PF3PM & 0x02) << 2)) & GTIA_collisions_mask_player_playfield;
 	case GTIA_OFFSET_P2PF:
-#ifdef NEW_CYCLE_EXACT
-	if (ANTIC_DRAWING_SCREEN) {
-			ANTIC_UpdateScanline();
-	}
-#endif
+		update_pf_colls();
 		return (((PF0PM & 0x04) >> 2)
 		      + ((PF1PM & 0x04) >> 1)
 		      + (PF2PM & 0x04)
 		      + ((PF3PM & 0x04) << 1)) & GTIA_collisions_mask_player_playfield;
 	case GTIA_OFFSET_P3PF:
-#ifdef NEW_CYCLE_EXACT
-	if (ANTIC_DRAWING_SCREEN) {
-			ANTIC_UpdateScanline();
-	}
-#endif
+		update_pf_colls();
 		return (((PF0PM & 0x08) >> 3)
 		      + ((PF1PM & 0x08) >> 2)
 		      + ((PF2PM & 0x08) >> 1)
@@ -618,6 +669,9 @@ void GTIA_PutByte(UWORD addr, UBYTE byte)
 		GTIA_speaker = !(byte & 0x08);
 #ifdef CONSOLE_SOUND
 		POKEYSND_UpdateConsol(1);
+#endif
+#ifdef POKEYREC
+		POKEYREC_Write(POKEYREC_EVENT_SPEAKER, (UBYTE) GTIA_speaker, 0);
 #endif
 		consol_mask = (~byte) & 0x0f;
 		break;
@@ -1060,6 +1114,9 @@ void GTIA_PutByte(UWORD addr, UBYTE byte)
 #ifdef NEW_CYCLE_EXACT
 		hitclr_pos = ANTIC_XPOS * 2 - 37;
 		collision_curpos = hitclr_pos;
+#endif
+#ifdef ANTIC_RENDER_THREAD
+		ANTIC_SetCollisions();
 #endif
 		break;
 /* TODO: cycle-exact missile HPOS, GRAF, SIZE */
@@ -1212,6 +1269,9 @@ void GTIA_StateSave(void)
 	StateSav_SaveUBYTE(&GTIA_HPOSM1, 1);
 	StateSav_SaveUBYTE(&GTIA_HPOSM2, 1);
 	StateSav_SaveUBYTE(&GTIA_HPOSM3, 1);
+#ifdef ANTIC_RENDER_THREAD
+	ANTIC_SyncCollisions();
+#endif
 	StateSav_SaveUBYTE(&PF0PM, 1);
 	StateSav_SaveUBYTE(&PF1PM, 1);
 	StateSav_SaveUBYTE(&PF2PM, 1);
@@ -1269,6 +1329,9 @@ void GTIA_StateRead(UBYTE version)
 	StateSav_ReadUBYTE(&PF1PM, 1);
 	StateSav_ReadUBYTE(&PF2PM, 1);
 	StateSav_ReadUBYTE(&PF3PM, 1);
+#ifdef ANTIC_RENDER_THREAD
+	ANTIC_SetCollisions();
+#endif
 	StateSav_ReadUBYTE(&GTIA_M0PL, 1);
 	StateSav_ReadUBYTE(&GTIA_M1PL, 1);
 	StateSav_ReadUBYTE(&GTIA_M2PL, 1);
@@ -69,6 +69,10 @@
 #ifdef HAVE_UNISTD_H
 #  include <unistd.h>
 #endif
+#ifdef HAVE_PTHREAD_CREATE
+#  include <pthread.h>
+#  include <time.h>
+#endif
 
 #define SECTOR_SIZE 512
 #define STD_HEADS   16          
@@ -378,6 +382,331 @@ static void ide_set_sector(struct ide_device *s, int64_t sector_num) {
     }
 }
 
+/* Host page cache.
+ *
+ * The image is read and written in pages of CACHE_PAGE_SIZE bytes kept in
+ * memory, the least recently used going first. A read that carries on from
+ * the previous one reads the next pages along with it in one go, so a
+ * sequential transfer does not go to the host a sector at a time.
+ *
+ * Written pages are written back by a thread, at most FLUSH_INTERVAL
+ * seconds later, or at once on FLUSH CACHE and when the emulator exits.
+ * With -ide_write_through, or without threads, every write goes to the
+ * image at once as it did before there was a cache.
+ *
+ * Only the emulation thread changes which page an entry holds; the flush
+ * thread copies dirty entries and clears their dirty flag. file_lock is
+ * held around every seek and its read or write, and from before a dirty
+ * entry is copied until it is written, so a page is never written back
+ * older than it already is in the image. cache_lock covers the page data
+ * being written and the dirty flags; it is taken after file_lock. */
+
+#define CACHE_PAGE_SIZE    4096
+#define CACHE_PAGE_SECTORS (CACHE_PAGE_SIZE / SECTOR_SIZE)
+#define READ_AHEAD_PAGES   8
+#define FLUSH_INTERVAL     1
+
+struct cache_page {
+    int64_t page;               /* -1 when empty */
+    int len;                    /* bytes of the image, less in the last page */
+    int dirty;
+    unsigned int used;          /* cache_clock when last used */
+    uint8_t *data;
+};
+
+static int cache_kb = 1024;
+static int write_through = 0;
+static struct cache_page *cache = NULL;
+static int cache_pages = 0;
+static int dirty_pages = 0;
+static unsigned int cache_clock = 0;
+static int64_t next_read_sector = -1;
+static uint8_t *read_ahead_buf = NULL;
+static uint8_t *flush_buf = NULL;
+
+#ifdef HAVE_PTHREAD_CREATE
+static pthread_mutex_t file_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t cache_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t flush_wake = PTHREAD_COND_INITIALIZER;
+static pthread_t flush_thread;
+static int flush_running = FALSE;
+static int flush_stop = FALSE;
+#define FILE_LOCK()    pthread_mutex_lock(&file_lock)
+#define FILE_UNLOCK()  pthread_mutex_unlock(&file_lock)
+#define CACHE_LOCK()   pthread_mutex_lock(&cache_lock)
+#define CACHE_UNLOCK() pthread_mutex_unlock(&cache_lock)
+#else
+#define FILE_LOCK()    do { } while (0)
+#define FILE_UNLOCK()  do { } while (0)
+#define CACHE_LOCK()   do { } while (0)
+#define CACHE_UNLOCK() do { } while (0)
+#endif
+
+/* Called with file_lock held */
+static int cache_write_page(struct ide_device *s, int64_t page,
+                            const uint8_t *data, int len) {
+    if (fseeko(s->file, page * CACHE_PAGE_SIZE, SEEK_SET) < 0
+        || fwrite(data, len, 1, s->file) != 1) {
+        Log_print("IDE: writing back the image failed: %s", strerror(errno));
+        return FALSE;
+    }
+    return TRUE;
+}
+
+/* Writes back every dirty page. Called with no lock held, from either
+   thread; buf holds a page. */
+static void cache_flush(struct ide_device *s, uint8_t *buf) {
+    int i, written = FALSE;
+
+    for (i = 0; i < cache_pages; i++) {
+        int64_t page;
+        int len;
+
+        FILE_LOCK();
+        CACHE_LOCK();
+        if (!cache[i].dirty) {
+            CACHE_UNLOCK();
+            FILE_UNLOCK();
+            continue;
+        }
+        page = cache[i].page;
+        len  = cache[i].len;
+        memcpy(buf, cache[i].data, len);
+        cache[i].dirty = 0;
+        dirty_pages--;
+        CACHE_UNLOCK();
+        cache_write_page(s, page, buf, len);
+        written = TRUE;
+        FILE_UNLOCK();
+    }
+    if (written) {
+        FILE_LOCK();
+        fflush(s->file);
+        FILE_UNLOCK();
+    }
+}
+
+#ifdef HAVE_PTHREAD_CREATE
+static void *flush_proc(void *arg) {
+    struct ide_device *s = arg;
+    uint8_t *buf = Util_malloc(CACHE_PAGE_SIZE);
+
+    CACHE_LOCK();
+    while (!flush_stop) {
+        struct timespec until;
+
+        clock_gettime(CLOCK_REALTIME, &until);
+        until.tv_sec += FLUSH_INTERVAL;
+        pthread_cond_timedwait(&flush_wake, &cache_lock, &until);
+        if (dirty_pages == 0)
+            continue;
+        CACHE_UNLOCK();
+        cache_flush(s, buf);
+        CACHE_LOCK();
+    }
+    CACHE_UNLOCK();
+    free(buf);
+    return NULL;
+}
+#endif
+
+static struct cache_page *cache_find(int64_t page) {
+    int i;
+
+    for (i = 0; i < cache_pages; i++)
+        if (cache[i].page == page)
+            return &cache[i];
+    return NULL;
+}
+
+/* Empties the least recently used entry, writing it back first if it is
+   dirty. Called with file_lock held. */
+static struct cache_page *cache_evict(struct ide_device *s) {
+    struct cache_page *p = &cache[0];
+    int i;
+
+    for (i = 1; i < cache_pages && p->page >= 0; i++)
+        if (cache[i].page < 0 || (int)(cache[i].used - p->used) < 0)
+            p = &cache[i];
+    if (p->dirty) {
+        /* The flush thread only copies a dirty page holding file_lock, so
+           the data can be written without cache_lock */
+        cache_write_page(s, p->page, p->data, p->len);
+        CACHE_LOCK();
+        p->dirty = 0;
+        dirty_pages--;
+        CACHE_UNLOCK();
+    }
+    p->page = -1;
+    return p;
+}
+
+/* Reads page and up to count - 1 of the pages after it that are not
+   cached yet. Returns the entry of page, or NULL on a read error. */
+static struct cache_page *cache_load(struct ide_device *s, int64_t page,
+                                     int count) {
+    int64_t last = (s->filesize - 1) / CACHE_PAGE_SIZE;
+    struct cache_page *first = NULL;
+    size_t got;
+    int i;
+
+    if (count > cache_pages / 2)
+        count = cache_pages / 2;
+    if (count < 1)
+        count = 1;
+    if (count > last - page + 1)
+        count = last - page + 1;
+    for (i = 1; i < count; i++)
+        if (cache_find(page + i))
+            break;
+    count = i;
+
+    FILE_LOCK();
+    if (fseeko(s->file, page * CACHE_PAGE_SIZE, SEEK_SET) < 0) {
+        FILE_UNLOCK();
+        return NULL;
+    }
+    got = fread(read_ahead_buf, 1, count * CACHE_PAGE_SIZE, s->file);
+    for (i = 0; i < count; i++) {
+        int64_t start = (page + i) * CACHE_PAGE_SIZE;
+        int len = s->filesize - start < CACHE_PAGE_SIZE
+                  ? (int)(s->filesize - start) : CACHE_PAGE_SIZE;
+        struct cache_page *p;
+
+        if ((size_t)i * CACHE_PAGE_SIZE + len > got)
+            break;
+        p = cache_evict(s);
+        memcpy(p->data, read_ahead_buf + i * CACHE_PAGE_SIZE, len);
+        p->page = page + i;
+        p->len  = len;
+        p->used = ++cache_clock;
+        if (i == 0)
+            first = p;
+    }
+    FILE_UNLOCK();
+    return first;
+}
+
+static int cache_read(struct ide_device *s, int64_t sector_num, int n) {
+    int ahead = sector_num == next_read_sector ? READ_AHEAD_PAGES : 1;
+    int i;
+
+    for (i = 0; i < n; i++) {
+        int64_t sector = sector_num + i;
+        struct cache_page *p = cache_find(sector / CACHE_PAGE_SECTORS);
+
+        if (!p && !(p = cache_load(s, sector / CACHE_PAGE_SECTORS, ahead)))
+            return FALSE;
+        memcpy(s->io_buffer + i * SECTOR_SIZE,
+               p->data + (sector % CACHE_PAGE_SECTORS) * SECTOR_SIZE,
+               SECTOR_SIZE);
+        p->used = ++cache_clock;
+    }
+    next_read_sector = sector_num + n;
+    return TRUE;
+}
+
+static int cache_write(struct ide_device *s, int64_t sector_num, int n) {
+    int i;
+
+    for (i = 0; i < n; i++) {
+        int64_t sector = sector_num + i;
+        struct cache_page *p = cache_find(sector / CACHE_PAGE_SECTORS);
+
+        if (!p) {
+            if (write_through)
+                continue;
+            if (!(p = cache_load(s, sector / CACHE_PAGE_SECTORS, 1)))
+                return FALSE;
+        }
+        CACHE_LOCK();
+        memcpy(p->data + (sector % CACHE_PAGE_SECTORS) * SECTOR_SIZE,
+               s->io_buffer + i * SECTOR_SIZE, SECTOR_SIZE);
+        if (!write_through && !p->dirty) {
+            p->dirty = 1;
+            dirty_pages++;
+        }
+        CACHE_UNLOCK();
+        p->used = ++cache_clock;
+    }
+
+    if (write_through) {
+        int ok;
+
+        FILE_LOCK();
+        ok = fseeko(s->file, sector_num * SECTOR_SIZE, SEEK_SET) >= 0
+             && fwrite(s->io_buffer, n * SECTOR_SIZE, 1, s->file) == 1;
+        fflush(s->file);
+        FILE_UNLOCK();
+        return ok;
+    }
+#ifdef HAVE_PTHREAD_CREATE
+    /* Do not let dirty pages crowd the clean ones out */
+    if (dirty_pages > cache_pages / 4)
+        pthread_cond_signal(&flush_wake);
+#endif
+    return TRUE;
+}
+
+static void cache_init(struct ide_device *s) {
+    int i;
+
+    cache_pages = cache_kb * 1024 / CACHE_PAGE_SIZE;
+    if (cache_pages < 2) {
+        cache_pages = 0;
+        return;
+    }
+    cache = Util_malloc(cache_pages * sizeof(struct cache_page));
+    for (i = 0; i < cache_pages; i++) {
+        cache[i].page  = -1;
+        cache[i].dirty = 0;
+        cache[i].used  = 0;
+        cache[i].data  = Util_malloc(CACHE_PAGE_SIZE);
+    }
+    read_ahead_buf = Util_malloc(READ_AHEAD_PAGES * CACHE_PAGE_SIZE);
+    flush_buf = Util_malloc(CACHE_PAGE_SIZE);
+    dirty_pages = 0;
+    next_read_sector = -1;
+
+#ifdef HAVE_PTHREAD_CREATE
+    if (!write_through) {
+        flush_stop = FALSE;
+        flush_running = pthread_create(&flush_thread, NULL, flush_proc, s) == 0;
+        if (!flush_running) {
+            Log_print("IDE: cannot start the write-back thread, writing through");
+            write_through = 1;
+        }
+    }
+#else
+    write_through = 1;
+#endif
+}
+
+static void cache_exit(struct ide_device *s) {
+    int i;
+
+    if (!cache)
+        return;
+#ifdef HAVE_PTHREAD_CREATE
+    if (flush_running) {
+        CACHE_LOCK();
+        flush_stop = TRUE;
+        pthread_cond_signal(&flush_wake);
+        CACHE_UNLOCK();
+        pthread_join(flush_thread, NULL);
+        flush_running = FALSE;
+    }
+#endif
+    cache_flush(s, flush_buf);
+    for (i = 0; i < cache_pages; i++)
+        free(cache[i].data);
+    free(cache);
+    free(read_ahead_buf);
+    free(flush_buf);
+    cache = NULL;
+    cache_pages = 0;
+}
+
 static void ide_sector_read(struct ide_device *s) {
     int64_t sector_num;
     int n;
@@ -396,10 +725,15 @@ static void ide_sector_read(struct ide_device *s) {
         if (n > s->req_nb_sectors)
             n = s->req_nb_sectors;
 
-        if (fseeko(s->file, sector_num * SECTOR_SIZE, SEEK_SET) < 0)
-            goto fail;
-        if (fread(s->io_buffer, n * SECTOR_SIZE, 1, s->file) != 1)
-            goto fail;
+        if (cache && sector_num + n <= s->nb_sectors) {
+            if (!cache_read(s, sector_num, n))
+                goto fail;
+        } else {
+            if (fseeko(s->file, sector_num * SECTOR_SIZE, SEEK_SET) < 0)
+                goto fail;
+            if (fread(s->io_buffer, n * SECTOR_SIZE, 1, s->file) != 1)
+                goto fail;
+        }
 
         if (IDE_debug) fprintf(stderr, "sector read OK\n");
 
@@ -428,15 +762,22 @@ static void ide_sector_write(struct ide_device *s) {
     if (n > s->req_nb_sectors)
         n = s->req_nb_sectors;
 
-    if (fseeko(s->file, sector_num * SECTOR_SIZE, SEEK_SET) < 0) {
-        fprintf(stderr, "FSEEKO FAILED\n");
-        goto fail;
-    }
-    if (fwrite(s->io_buffer, n * SECTOR_SIZE, 1, s->file) != 1) {
-        fprintf(stderr, "FWRITE FAILED\n");
-        goto fail;
+    if (cache && sector_num + n <= s->nb_sectors) {
+        if (!cache_write(s, sector_num, n)) {
+            fprintf(stderr, "CACHE WRITE FAILED\n");
+            goto fail;
+        }
+    } else {
+        if (fseeko(s->file, sector_num * SECTOR_SIZE, SEEK_SET) < 0) {
+            fprintf(stderr, "FSEEKO FAILED\n");
+            goto fail;
+        }
+        if (fwrite(s->io_buffer, n * SECTOR_SIZE, 1, s->file) != 1) {
+            fprintf(stderr, "FWRITE FAILED\n");
+            goto fail;
+        }
+        fflush(s->file);
     }
-    fflush(s->file);
 
     s->nsector -= n;
     if (s->nsector == 0) {
@@ -608,6 +949,8 @@ static void ide_command(struct ide_device *s, uint8_t val) {
 
     case WIN_FLUSH_CACHE:
     case WIN_FLUSH_CACHE_EXT:
+        if (cache)
+            cache_flush(s, flush_buf);
         fflush(s->file);
         break;
 
@@ -882,11 +1225,25 @@ int IDE_Initialise(int *argc, char *argv[]) {
             IDE_debug = 1;
         } else if (!strcmp(argv[i], "-ide_cf")) {
             device.is_cf = 1;
+        } else if (!strcmp(argv[i], "-ide_cache")) {
+            if (!available) {
+                Log_print("Missing argument for '%s'", argv[i]);
+                return FALSE;
+            }
+            cache_kb = Util_sscandec(argv[++i]);
+            if (cache_kb < 0) {
+                Log_print("Invalid IDE cache size");
+                return FALSE;
+            }
+        } else if (!strcmp(argv[i], "-ide_write_through")) {
+            write_through = 1;
         } else {
              if (!strcmp(argv[i], "-help")) {
                  Log_print("\t-ide <file>      Enable IDE emulation");
                  Log_print("\t-ide_debug       Enable IDE Debug Output");
                  Log_print("\t-ide_cf          Enable CF emulation");
+                 Log_print("\t-ide_cache <kb>  Cache the IDE image in memory (0: off, default 1024)");
+                 Log_print("\t-ide_write_through Write IDE sectors to the image at once");
              }
              argv[j++] = argv[i];
         }
@@ -896,6 +1253,8 @@ int IDE_Initialise(int *argc, char *argv[]) {
     if (filename) {
         IDE_enabled = ret = ide_init_drive(&device, filename);
         free(filename);
+        if (IDE_enabled)
+            cache_init(&device);
     }
 
     return ret;
@@ -904,6 +1263,7 @@ int IDE_Initialise(int *argc, char *argv[]) {
 void IDE_Exit(void)
 {
 	if (IDE_enabled) {
+		cache_exit(&device);
 		fclose(device.file);
 		IDE_enabled = FALSE;
 	}
@@ -57,6 +57,8 @@ struct IMG_TAPE_t {
 	int block_baudrates[MAX_BLOCKS]; /* Baudrates for each data block in the file */
 	char description[CASSETTE_DESCRIPTION_MAX]; /* Tape description, only for CAS files */
 	int was_writing; /* Indicated if the last operation on the file was writing */
+	UBYTE *image; /* Contents of the file, read when it was opened */
+	ULONG image_size; /* Length of IMAGE that still matches the file */
 };
 
 typedef struct {
@@ -111,6 +113,9 @@ static int WriteRecord(IMG_TAPE_t *file)
 	/* always append */
 	if (fseek(file->file, file->block_offsets[file->num_blocks], SEEK_SET) != 0)
 		return FALSE;
+	/* The image no longer matches the file from here */
+	if (file->image_size > file->block_offsets[file->num_blocks])
+		file->image_size = file->block_offsets[file->num_blocks];
 	/* write record header */
 	memcpy(header.identifier, "data", 4);
 	header.length_lo = file->block_length & 0xFF;
@@ -234,6 +239,15 @@ IMG_TAPE_t *IMG_TAPE_Open(char const *filename, int *writable, char const **desc
 		*description = NULL;
 	}
 
+	/* Keep the whole file in memory, so that reading blocks doesn't
+	   access it. Tape images are small. */
+	img->image_size = Util_flen(img->file);
+	img->image = (UBYTE *)Util_malloc(img->image_size + 1);
+	if (fseek(img->file, 0, SEEK_SET) != 0)
+		img->image_size = 0;
+	else
+		img->image_size = fread(img->image, 1, img->image_size, img->file);
+
 	img->savetime = 0;
 	img->save_gap = 0;
 	img->next_blockbyte = 0;
@@ -250,6 +264,7 @@ void IMG_TAPE_Close(IMG_TAPE_t *file)
 	if (file->was_writing)
 		CassetteFlush(file);
 	fclose(file->file);
+	free(file->image);
 	free(file->buffer);
 	free(file);
 }
@@ -303,6 +318,8 @@ IMG_TAPE_t *IMG_TAPE_Create(char const *filename, char const *description)
 	img->block_offsets[0] = strlen(description) + 16;
 	img->buffer = (UBYTE *)Util_malloc((img->buffer_size = DEFAULT_BUFFER_SIZE) * sizeof(UBYTE));
 	img->was_writing = TRUE;
+	img->image = NULL;
+	img->image_size = 0;
 
 	return img;
 }
@@ -337,8 +354,13 @@ static int ReadNextRecord(IMG_TAPE_t *file, int *gap)
 
 	if (file->isCAS) {
 		CAS_Header header;
+		ULONG offset = file->block_offsets[file->current_block];
+		/* Blocks written after opening are read from the file */
+		int in_image = offset + 8 <= file->image_size;
 
-		if (fseek(file->file, file->block_offsets[file->current_block], SEEK_SET) != 0
+		if (in_image)
+			memcpy(&header, file->image + offset, 8);
+		else if (fseek(file->file, offset, SEEK_SET) != 0
 		    || fread(&header, 1, 8, file->file) < 8)
 			return FALSE;
 
@@ -352,7 +374,12 @@ static int ReadNextRecord(IMG_TAPE_t *file, int *gap)
 		*gap = header.aux_lo + (header.aux_hi << 8);
 		/* read block into buffer */
 		EnlargeBuffer(file, length);
-		if (fread(file->buffer, 1, length, file->file) < length)
+		if (in_image) {
+			if (offset + 8 + length > file->image_size)
+				return FALSE;
+			memcpy(file->buffer, file->image + offset + 8, length);
+		}
+		else if (fread(file->buffer, 1, length, file->file) < length)
 			return FALSE;
 	}
 	else {
@@ -368,10 +395,14 @@ static int ReadNextRecord(IMG_TAPE_t *file, int *gap)
 			memset(file->buffer + 3, 0, 128);
 		}
 		else {
+			ULONG offset = file->current_block * 128;
 			int bytes;
-			if (fseek(file->file, file->current_block * 128, SEEK_SET) != 0
-			    || (bytes = fread(file->buffer + 3, 1, 128, file->file)) == 0)
+			if (offset >= file->image_size)
 				return FALSE;
+			bytes = file->image_size - offset;
+			if (bytes > 128)
+				bytes = 128;
+			memcpy(file->buffer + 3, file->image + offset, bytes);
 			if (bytes < 128) {
 				file->buffer[2] = 0xfa; /* non-full record */
 				memset(file->buffer + 3 + bytes, 0, 127 - bytes);
@@ -386,6 +417,14 @@ static int ReadNextRecord(IMG_TAPE_t *file, int *gap)
 	return TRUE;
 }
 
+/* Baudrate at which the bytes of the current block come in, sped up by
+   CASSETTE_accel. Gaps and FSK pulses keep their length: the OS times the
+   gaps between records, and loaders time the pulses. */
+static int ReadBaudrate(IMG_TAPE_t *file)
+{
+	return (file->isCAS ? file->block_baudrates[file->current_block] : DEFAULT_BAUDRATE) * CASSETTE_accel;
+}
+
 int IMG_TAPE_Read(IMG_TAPE_t *file, unsigned int *duration, int *is_gap, UBYTE *byte)
 {
 	if (file->was_writing) {
@@ -419,7 +458,7 @@ int IMG_TAPE_Read(IMG_TAPE_t *file, unsigned int *duration, int *is_gap, UBYTE *
 		*byte = file->buffer[file->next_blockbyte++];
 		*is_gap = FALSE;
 		/* Next event will be after 10 bits of data gets loaded. */
-		*duration = 10 * 1789790 / (file->isCAS ? file->block_baudrates[file->current_block] : 600);
+		*duration = 10 * 1789790 / ReadBaudrate(file);
 	}
 	return TRUE;
 }
@@ -511,8 +550,8 @@ int IMG_TAPE_SerinStatus(IMG_TAPE_t *file, int event_time_left)
 
 		/* exam rate; if time_to_irq < duration of one byte */
 		if (event_time_left <
-			10 * 1789790 / (file->isCAS ? file->block_baudrates[file->current_block] : 600) - 1) {
-			bit = event_time_left / (1789790 / (file->isCAS ? file->block_baudrates[file->current_block] : 600));
+			10 * 1789790 / ReadBaudrate(file) - 1) {
+			bit = event_time_left / (1789790 / ReadBaudrate(file));
 		}
 		else {
 			bit = 0;
@@ -25,6 +25,7 @@
 #include "config.h"
 #include <string.h>
 #include <stdlib.h> /* for exit() */
+#include "ai_interface.h"
 #include "antic.h"
 #include "atari.h"
 #include "cassette.h"
@@ -64,6 +65,9 @@ int INPUT_joy_5200_max = 220;
 
 int INPUT_cx85 = 0;
 
+int INPUT_poll_line = -1;
+void (*INPUT_poll_host)(void) = NULL;
+
 int INPUT_mouse_mode = INPUT_MOUSE_OFF;
 int INPUT_mouse_port = 0;
 int INPUT_mouse_delta_x = 0;
@@ -83,6 +87,7 @@ int INPUT_mouse_pen_ofs_h = 42;
 int INPUT_mouse_pen_ofs_v = 2;
 int INPUT_mouse_joy_inertia = 10;
 int INPUT_direct_mouse = 0;
+int INPUT_pot_override[8] = {-1, -1, -1, -1, -1, -1, -1, -1};
 
 #ifndef MOUSE_SHIFT
 #define MOUSE_SHIFT 4
@@ -191,6 +196,16 @@ int INPUT_Initialise(int *argc, char *argv[])
 		else if (strcmp(argv[i], "-multijoy") == 0) {
 			INPUT_joy_multijoy = 1;
 		}
+		else if (strcmp(argv[i], "-input-poll-line") == 0) {
+			if (i_a) {
+				INPUT_poll_line = Util_sscandec(argv[++i]);
+				if (INPUT_poll_line < -1 || INPUT_poll_line >= Atari800_TV_PAL) {
+					Log_print("Invalid scan line to poll input at - should be between 0 and %d, or -1", Atari800_TV_PAL - 1);
+					return FALSE;
+				}
+			}
+			else a_m = TRUE;
+		}
 #ifdef EVENT_RECORDING
 		else if (strcmp(argv[i], "-record") == 0) {
 			if (i_a) {
@@ -266,6 +281,8 @@ int INPUT_Initialise(int *argc, char *argv[])
 				Log_print("\t-directmouse     Use absolute X/Y mouse coords");
 				Log_print("\t-cx85 <n>        Emulate CX85 numeric keypad on port <n>");
 				Log_print("\t-multijoy        Emulate MultiJoy4 interface");
+				Log_print("\t-input-poll-line <n>");
+				Log_print("\t                 Read the joysticks again at scan line <n> (-1: off)");
 				#ifdef EVENT_RECORDING
 					Log_print("\t-record <file>   Record input to <file>");
 					Log_print("\t-playback <file> Playback input from <file>");
@@ -422,13 +439,103 @@ static UBYTE mouse_step(void)
 	return r;
 }
 
+/* Carried by INPUT_Frame() from one frame to the next, see INPUT_GetFrameState() */
+static int last_key_code = AKEY_NONE;
+static int last_key_break = 0;
+static UBYTE last_stick[4] = {INPUT_STICK_CENTRE, INPUT_STICK_CENTRE, INPUT_STICK_CENTRE, INPUT_STICK_CENTRE};
+static int last_mouse_buttons = 0;
+
+void INPUT_GetFrameState(UBYTE *buf)
+{
+	buf[0] = (UBYTE)last_key_code;
+	buf[1] = (UBYTE)(last_key_code >> 8);
+	buf[2] = (UBYTE)(last_key_code >> 16);
+	buf[3] = (UBYTE)(last_key_code >> 24);
+	buf[4] = (UBYTE)last_key_break;
+	buf[5] = (UBYTE)last_mouse_buttons;
+	memcpy(buf + 6, last_stick, 4);
+	buf[10] = buf[11] = 0;
+}
+
+void INPUT_SetFrameState(const UBYTE *buf)
+{
+	last_key_code = (int)(buf[0] | (buf[1] << 8) | (buf[2] << 16) | ((ULONG)buf[3] << 24));
+	last_key_break = buf[4];
+	last_mouse_buttons = buf[5];
+	memcpy(last_stick, buf + 6, 4);
+}
+
+/* Stops the joystick reporting opposite directions at once, if asked to */
+static void filter_stick(int i)
+{
+	if (INPUT_joy_block_opposite_directions) {
+		if ((STICK[i] & 0x0c) == 0) {	/* right and left simultaneously */
+			if (last_stick[i] & 0x04)	/* if wasn't left before, move left */
+				STICK[i] |= 0x08;
+			else						/* else move right */
+				STICK[i] |= 0x04;
+		}
+		else {
+			last_stick[i] &= 0x03;
+			last_stick[i] |= STICK[i] & 0x0c;
+		}
+		if ((STICK[i] & 0x03) == 0) {	/* up and down simultaneously */
+			if (last_stick[i] & 0x01)	/* if wasn't up before, move up */
+				STICK[i] |= 0x02;
+			else						/* else move down */
+				STICK[i] |= 0x01;
+		}
+		else {
+			last_stick[i] &= 0x0c;
+			last_stick[i] |= STICK[i] & 0x03;
+		}
+	}
+	else
+		last_stick[i] = STICK[i];
+}
+
+/* Puts the sticks and triggers where PIA and GTIA read them */
+static void latch_ports(void)
+{
+	if (INPUT_joy_multijoy && Atari800_machine_type != Atari800_MACHINE_5200) {
+		PIA_PORT_input[0] = 0xf0 | STICK[joy_multijoy_no];
+		PIA_PORT_input[1] = 0xff;
+		GTIA_TRIG[0] = TRIG_input[joy_multijoy_no];
+		GTIA_TRIG[1] = 1;
+	}
+	else {
+		GTIA_TRIG[0] = TRIG_input[0];
+		GTIA_TRIG[1] = TRIG_input[1];
+		PIA_PORT_input[0] = (STICK[1] << 4) | STICK[0];
+		PIA_PORT_input[1] = (STICK[3] << 4) | STICK[2];
+	}
+	if (Atari800_machine_type != Atari800_MACHINE_XLXE) {
+		GTIA_TRIG[2] = TRIG_input[2];
+		GTIA_TRIG[3] = TRIG_input[3];
+	}
+}
+
+void INPUT_Stick5200(int port, int stick)
+{
+	if ((stick & (INPUT_STICK_CENTRE ^ INPUT_STICK_LEFT)) == 0)
+		POKEY_POT_input[2 * port] = INPUT_joy_5200_min;
+	else if ((stick & (INPUT_STICK_CENTRE ^ INPUT_STICK_RIGHT)) == 0)
+		POKEY_POT_input[2 * port] = INPUT_joy_5200_max;
+	else
+		POKEY_POT_input[2 * port] = INPUT_joy_5200_center;
+	if ((stick & (INPUT_STICK_CENTRE ^ INPUT_STICK_FORWARD)) == 0)
+		POKEY_POT_input[2 * port + 1] = INPUT_joy_5200_min;
+	else if ((stick & (INPUT_STICK_CENTRE ^ INPUT_STICK_BACK)) == 0)
+		POKEY_POT_input[2 * port + 1] = INPUT_joy_5200_max;
+	else
+		POKEY_POT_input[2 * port + 1] = INPUT_joy_5200_center;
+}
+
+static void press_keys(void);
+
 void INPUT_Frame(void)
 {
 	int i;
-	static int last_key_code = AKEY_NONE;
-	static int last_key_break = 0;
-	static UBYTE last_stick[4] = {INPUT_STICK_CENTRE, INPUT_STICK_CENTRE, INPUT_STICK_CENTRE, INPUT_STICK_CENTRE};
-	static int last_mouse_buttons = 0;
 
 	scanline_counter = 10000;	/* do nothing in INPUT_Scanline() */
 
@@ -460,79 +567,7 @@ void INPUT_Frame(void)
 		gzprintf(recordfp, "%d %d %d ", INPUT_key_code, INPUT_key_shift, INPUT_key_consol);
 	}
 #endif
-	i = Atari800_machine_type == Atari800_MACHINE_5200 ? INPUT_key_shift : (INPUT_key_code == AKEY_BREAK);
-	if (i && !last_key_break) {
-		if (POKEY_IRQEN & 0x80) {
-			POKEY_IRQST &= ~0x80;
-			CPU_GenerateIRQ();
-		}
-	}
-	last_key_break = i;
-
-	POKEY_SKSTAT |= 0xc;
-	if (INPUT_key_shift)
-		POKEY_SKSTAT &= ~8;
-
-	if (INPUT_key_code < 0) {
-		if (CASSETTE_press_space) {
-			INPUT_key_code = AKEY_SPACE;
-			CASSETTE_press_space = 0;
-		}
-		else {
-			last_key_code = AKEY_NONE;
-		}
-	}
-	/* Following keys cannot be read with both shift and control pressed:
-	   J K L ; + * Z X C V B F1 F2 F3 F4 HELP	 */
-	/* which are 0x00-0x07 and 0x10-0x17 */
-	/* This is caused by the keyboard itself, these keys generate 'ghost keys'
-	 * when pressed with shift and control */
-	if (Atari800_machine_type != Atari800_MACHINE_5200 && (INPUT_key_code&~0x17) == AKEY_SHFTCTRL) {
-		INPUT_key_code = AKEY_NONE;
-	}
-	if (INPUT_key_code >= 0) {
-		/* The 5200 has only 4 of the 6 keyboard scan lines connected */
-		/* Pressing one 5200 key is like pressing 4 Atari 800 keys. */
-		/* The LSB (bit 0) and bit 5 are the two missing lines. */
-		/* When debounce is enabled, multiple keys pressed generate
-		 * no results. */
-		/* When debounce is disabled, multiple keys pressed generate
-		 * results only when in numerical sequence. */
-		/* Thus the LSB being one of the missing lines is important
-		 * because that causes events to be generated. */
-		/* Two events are generated every 64 scan lines
-		 * but this code only does one every frame. */
-		/* Bit 5 is different for each keypress because it is one
-		 * of the missing lines. */
-		if (Atari800_machine_type == Atari800_MACHINE_5200) {
-			static int bit5_5200 = 0;
-			if (bit5_5200) {
-				INPUT_key_code &= ~0x20;
-			}
-			bit5_5200 = !bit5_5200;
-			/* 5200 2nd fire button generates CTRL as well */
-			if (INPUT_key_shift) {
-				INPUT_key_code |= AKEY_SHFTCTRL;
-			}
-		}
-		POKEY_SKSTAT &= ~4;
-		if ((INPUT_key_code ^ last_key_code) & ~AKEY_SHFTCTRL) {
-		/* ignore if only shift or control has changed its state */
-			last_key_code = INPUT_key_code;
-			POKEY_KBCODE = (UBYTE) INPUT_key_code;
-			if (POKEY_IRQEN & 0x40) {
-				if (POKEY_IRQST & 0x40) {
-					POKEY_IRQST &= ~0x40;
-					CPU_GenerateIRQ();
-				}
-				else {
-					/* keyboard over-run */
-					POKEY_SKSTAT &= ~0x40;
-					/* assert(CPU_IRQ != 0); */
-				}
-			}
-		}
-	}
+	press_keys();
 
 	/* handle joysticks */
 #ifdef EVENT_RECORDING
@@ -568,30 +603,7 @@ void INPUT_Frame(void)
 	STICK[3] = (i >> 4) & 0x0f;
 
 	for (i = 0; i < 4; i++) {
-		if (INPUT_joy_block_opposite_directions) {
-			if ((STICK[i] & 0x0c) == 0) {	/* right and left simultaneously */
-				if (last_stick[i] & 0x04)	/* if wasn't left before, move left */
-					STICK[i] |= 0x08;
-				else						/* else move right */
-					STICK[i] |= 0x04;
-			}
-			else {
-				last_stick[i] &= 0x03;
-				last_stick[i] |= STICK[i] & 0x0c;
-			}
-			if ((STICK[i] & 0x03) == 0) {	/* up and down simultaneously */
-				if (last_stick[i] & 0x01)	/* if wasn't up before, move up */
-					STICK[i] |= 0x02;
-				else						/* else move down */
-					STICK[i] |= 0x01;
-			}
-			else {
-				last_stick[i] &= 0x0c;
-				last_stick[i] |= STICK[i] & 0x03;
-			}
-		}
-		else
-			last_stick[i] = STICK[i];
+		filter_stick(i);
 		/* Joystick Triggers */
 #ifdef EVENT_RECORDING
 		if(playingback){
@@ -640,18 +652,7 @@ void INPUT_Frame(void)
 				continue;
 			/* if analog js is unused, alternatively try keypad */
 #endif
-			if ((STICK[i] & (INPUT_STICK_CENTRE ^ INPUT_STICK_LEFT)) == 0)
-				POKEY_POT_input[2 * i] = INPUT_joy_5200_min;
-			else if ((STICK[i] & (INPUT_STICK_CENTRE ^ INPUT_STICK_RIGHT)) == 0)
-				POKEY_POT_input[2 * i] = INPUT_joy_5200_max;
-			else
-				POKEY_POT_input[2 * i] = INPUT_joy_5200_center;
-			if ((STICK[i] & (INPUT_STICK_CENTRE ^ INPUT_STICK_FORWARD)) == 0)
-				POKEY_POT_input[2 * i + 1] = INPUT_joy_5200_min;
-			else if ((STICK[i] & (INPUT_STICK_CENTRE ^ INPUT_STICK_BACK)) == 0)
-				POKEY_POT_input[2 * i + 1] = INPUT_joy_5200_max;
-			else
-				POKEY_POT_input[2 * i + 1] = INPUT_joy_5200_center;
+			INPUT_Stick5200(i, STICK[i]);
 		}
 	}
 
@@ -854,28 +855,145 @@ void INPUT_Frame(void)
 		}
 	}
 
-	if (INPUT_joy_multijoy && Atari800_machine_type != Atari800_MACHINE_5200) {
-		PIA_PORT_input[0] = 0xf0 | STICK[joy_multijoy_no];
-		PIA_PORT_input[1] = 0xff;
-		GTIA_TRIG[0] = TRIG_input[joy_multijoy_no];
-		GTIA_TRIG[1] = 1;
-	}
-	else {
-		GTIA_TRIG[0] = TRIG_input[0];
-		GTIA_TRIG[1] = TRIG_input[1];
-		PIA_PORT_input[0] = (STICK[1] << 4) | STICK[0];
-		PIA_PORT_input[1] = (STICK[3] << 4) | STICK[2];
-	}
-	if (Atari800_machine_type != Atari800_MACHINE_XLXE) {
-		GTIA_TRIG[2] = TRIG_input[2];
-		GTIA_TRIG[3] = TRIG_input[3];
+	for (i = 0; i < 8; i++) {
+		if (INPUT_pot_override[i] >= 0)
+			POKEY_POT_input[i] = INPUT_pot_override[i];
 	}
 
+	latch_ports();
+
 #ifdef EVENT_RECORDING
 	update_adler32_of_screen();
 #endif
 }
 
+/* Passes INPUT_key_code and INPUT_key_shift on to POKEY */
+static void press_keys(void)
+{
+	int i = Atari800_machine_type == Atari800_MACHINE_5200 ? INPUT_key_shift : (INPUT_key_code == AKEY_BREAK);
+	if (i && !last_key_break) {
+		if (POKEY_IRQEN & 0x80) {
+			POKEY_IRQST &= ~0x80;
+			CPU_GenerateIRQ();
+		}
+	}
+	last_key_break = i;
+
+	POKEY_SKSTAT |= 0xc;
+	if (INPUT_key_shift)
+		POKEY_SKSTAT &= ~8;
+
+	if (INPUT_key_code < 0) {
+		if (CASSETTE_press_space) {
+			INPUT_key_code = AKEY_SPACE;
+			CASSETTE_press_space = 0;
+		}
+		else {
+			last_key_code = AKEY_NONE;
+		}
+	}
+	/* Following keys cannot be read with both shift and control pressed:
+	   J K L ; + * Z X C V B F1 F2 F3 F4 HELP	 */
+	/* which are 0x00-0x07 and 0x10-0x17 */
+	/* This is caused by the keyboard itself, these keys generate 'ghost keys'
+	 * when pressed with shift and control */
+	if (Atari800_machine_type != Atari800_MACHINE_5200 && (INPUT_key_code&~0x17) == AKEY_SHFTCTRL) {
+		INPUT_key_code = AKEY_NONE;
+	}
+	if (INPUT_key_code >= 0) {
+		/* The 5200 has only 4 of the 6 keyboard scan lines connected */
+		/* Pressing one 5200 key is like pressing 4 Atari 800 keys. */
+		/* The LSB (bit 0) and bit 5 are the two missing lines. */
+		/* When debounce is enabled, multiple keys pressed generate
+		 * no results. */
+		/* When debounce is disabled, multiple keys pressed generate
+		 * results only when in numerical sequence. */
+		/* Thus the LSB being one of the missing lines is important
+		 * because that causes events to be generated. */
+		/* Two events are generated every 64 scan lines
+		 * but this code only does one every frame. */
+		/* Bit 5 is different for each keypress because it is one
+		 * of the missing lines. */
+		if (Atari800_machine_type == Atari800_MACHINE_5200) {
+			static int bit5_5200 = 0;
+			if (bit5_5200) {
+				INPUT_key_code &= ~0x20;
+			}
+			bit5_5200 = !bit5_5200;
+			/* 5200 2nd fire button generates CTRL as well */
+			if (INPUT_key_shift) {
+				INPUT_key_code |= AKEY_SHFTCTRL;
+			}
+		}
+		POKEY_SKSTAT &= ~4;
+		if ((INPUT_key_code ^ last_key_code) & ~AKEY_SHFTCTRL) {
+		/* ignore if only shift or control has changed its state */
+			last_key_code = INPUT_key_code;
+			POKEY_KBCODE = (UBYTE) INPUT_key_code;
+			if (POKEY_IRQEN & 0x40) {
+				if (POKEY_IRQST & 0x40) {
+					POKEY_IRQST &= ~0x40;
+					CPU_GenerateIRQ();
+				}
+				else {
+					/* keyboard over-run */
+					POKEY_SKSTAT &= ~0x40;
+					/* assert(CPU_IRQ != 0); */
+				}
+			}
+		}
+	}
+}
+
+void INPUT_Poll(void)
+{
+	int i;
+	int port[2];
+
+	/* A recording holds one sample a frame. The mouse, the CX85 and the
+	   5200's analog sticks are only worked out once a frame too. */
+	if (INPUT_Recording() || INPUT_Playingback() || INPUT_mouse_mode != INPUT_MOUSE_OFF
+		|| INPUT_cx85 || Atari800_machine_type == Atari800_MACHINE_5200)
+		return;
+	if (INPUT_poll_host != NULL)
+		INPUT_poll_host();
+	port[0] = PLATFORM_PORT(0);
+	port[1] = PLATFORM_PORT(1);
+	for (i = 0; i < 4; i++) {
+		STICK[i] = (port[i >> 1] >> ((i & 1) << 2)) & 0x0f;
+		filter_stick(i);
+		TRIG_input[i] = PLATFORM_TRIG(i);
+		if ((INPUT_joy_autofire[i] == INPUT_AUTOFIRE_FIRE && !TRIG_input[i]) || (INPUT_joy_autofire[i] == INPUT_AUTOFIRE_CONT))
+			TRIG_input[i] = (Atari800_nframes & 2) ? 1 : 0;
+	}
+	latch_ports();
+	AI_ApplyInput();
+}
+
+void INPUT_Refresh(void)
+{
+	int i;
+
+	if (INPUT_Recording() || INPUT_Playingback())
+		return;
+	if (Atari800_keyboard_detached) {
+		INPUT_key_code = AKEY_NONE;
+		INPUT_key_shift = 0;
+	}
+	press_keys();
+	for (i = 0; i < 8; i++) {
+		if (INPUT_pot_override[i] >= 0)
+			POKEY_POT_input[i] = INPUT_pot_override[i];
+	}
+	latch_ports();
+	AI_ApplyInput();
+	/* GTIA_Frame() latches the triggers once a frame */
+	if (GTIA_GRACTL & 4) {
+		for (i = 0; i < 4; i++)
+			GTIA_TRIG_latch[i] &= GTIA_TRIG[i];
+	}
+}
+
 #ifdef EVENT_RECORDING
 static void update_adler32_of_screen(void)
 {
@@ -965,6 +1083,10 @@ int INPUT_PlaybackInt(void)
 
 void INPUT_Scanline(void)
 {
+	if (ANTIC_ypos == INPUT_poll_line)
+		INPUT_Poll();
+	if (ANTIC_ypos == AI_input_line)
+		AI_InputLine();
 	if (--scanline_counter == 0) {
 		mouse_step();
 		if (INPUT_mouse_mode == INPUT_MOUSE_TRAK) {
@@ -76,13 +76,46 @@ extern int INPUT_direct_mouse;      /* When true, convert the mouse pointer
 													position directly into POKEY POT values */
 
 extern int INPUT_cx85;      /* emulate CX85 numeric keypad */
+
+/* POKEY POT values a front end sets itself, 0-228, or -1 where
+   INPUT_Frame() works them out as usual (paddles, 5200 analog sticks,
+   mouse). They hold until changed. */
+extern int INPUT_pot_override[8];
+
+/* Scan line at which INPUT_Scanline() reads the joysticks again, so
+   that a game reading them later in the frame (most do in the vertical
+   blank, from line 248) sees input that arrived since the frame began.
+   -1 reads them only in INPUT_Frame(). */
+extern int INPUT_poll_line;
+/* Called before they are read again, for the platform to take in
+   pending host input; may be NULL */
+extern void (*INPUT_poll_host)(void);
 /* Functions ----------------------------------------------------------- */
 
 int INPUT_Initialise(int *argc, char *argv[]);
 void INPUT_Exit(void);
 void INPUT_Frame(void);
 void INPUT_Scanline(void);
+/* Reads the joysticks and triggers again in the middle of a frame. Does
+   nothing while recording or playing back input, or when the mouse,
+   the CX85 or a 5200 take part. */
+void INPUT_Poll(void);
+/* Passes INPUT_key_code, INPUT_key_shift and the pot, joystick and trigger
+   overrides on to the chips in the middle of a frame, for input that
+   changes at a given scan line. Does nothing while recording or playing
+   back input. */
+void INPUT_Refresh(void);
 void INPUT_SelectMultiJoy(int no);
+/* Sets the pots of 5200 controller port (0-3) to where stick, an
+   INPUT_STICK_* value, pushes its analog stick */
+void INPUT_Stick5200(int port, int stick);
+/* What INPUT_Frame() remembers of the previous frame (last key, stick
+   directions for opposite-direction blocking, mouse buttons), which state
+   files leave out; in-process snapshots and libatari800 states keep it so
+   that a replay sees the same edges. */
+#define INPUT_FRAME_STATE_SIZE 12
+void INPUT_GetFrameState(UBYTE *buf);
+void INPUT_SetFrameState(const UBYTE *buf);
 void INPUT_CenterMousePointer(void);
 void INPUT_DrawMousePointer(void);
 int INPUT_Recording(void);
@@ -0,0 +1,93 @@
+/*
+ * libatari800/ai_minimal.c - Atari800 as a library - AI interface stubs
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+/* The minimal headless library (configure --enable-headless-minimal)
+   leaves out the AI socket interface and the monitor, whose buffers are
+   most of the emulator's data. What the core calls of them is here, doing
+   nothing: the watch, profile and coverage maps stay NULL unless the
+   library API sets them, so the CPU runs its plain loops. */
+
+#include "config.h"
+#include <string.h>
+
+#include "atari.h"
+#include "ai_interface.h"
+#include "monitor.h"
+
+int AI_enabled = FALSE;
+int AI_debug_port = 0;
+int AI_input_line = -1;
+int AI_timing = FALSE;
+int AI_unthrottled = FALSE;
+int AI_frame_timing = FALSE;
+int AI_render_policy = AI_RENDER_ALWAYS;
+int AI_render_every = 1;
+UBYTE *AI_pc_watch = NULL;
+UBYTE *AI_write_watch = NULL;
+UWORD AI_write_pc = 0;
+AI_ProfileRec *AI_profile = NULL;
+ULONG AI_profile_opcodes[256];
+int AI_profile_host = FALSE;
+UBYTE *AI_coverage = NULL;
+
+int AI_Initialise(int *argc, char *argv[])
+{
+	return TRUE;
+}
+
+void AI_Exit(void)
+{
+}
+
+void AI_Frame(void)
+{
+}
+
+void AI_ApplyInput(void)
+{
+}
+
+void AI_InputLine(void)
+{
+}
+
+/* Without clients every frame is looked at */
+int AI_RenderFrame(void)
+{
+	if (AI_render_policy == AI_RENDER_EVERY)
+		return (Atari800_nframes + 1) % AI_render_every == 0;
+	return TRUE;
+}
+
+void AI_DebugWrite(UBYTE byte)
+{
+}
+
+void AI_WatchHit(UWORD pc)
+{
+}
+
+void AI_WriteHit(UWORD addr, UBYTE old)
+{
+}
+
+void AI_TimeStage(int stage)
+{
+}
+
+void AI_TimeFrame(void)
+{
+}
+
+void AI_GetFrameStats(AI_FrameStats *stats, int clear)
+{
+	memset(stats, 0, sizeof(*stats));
+}
+
+void MONITOR_Exit(void)
+{
+}
@@ -36,34 +36,80 @@
 #include "akey.h"
 #include "afile.h"
 #include "../input.h"
+#include "cartridge.h"
+#include "ui.h"
 #include "log.h"
 #include "antic.h"
 #include "cpu.h"
 #include "platform.h"
 #include "memory.h"
+#include "pokey.h"
 #include "screen.h"
 #include "sio.h"
 #include "../sound.h"
 #include "util.h"
+#include "ai_features.h"
+#include "ai_hash.h"
+#include "ai_interface.h"
+#include "ai_observe.h"
+#include "ai_rewind.h"
+#if defined(AUDIO_RECORDING) || defined(VIDEO_RECORDING)
+#include "file_export.h"
+#endif
 #include "libatari800/main.h"
 #include "libatari800/cpu_crash.h"
+#include "libatari800/screen_ring.h"
 #include "libatari800/init.h"
 #include "libatari800/input.h"
 #include "libatari800/video.h"
 #include "libatari800/sound.h"
 #include "libatari800/statesav.h"
 
-
-#ifdef HAVE_SETJMP
-jmp_buf libatari800_cpu_crash;
-#endif
-
-/* global variable indicating that BRK instruction should exit emulation */
+/* global variable indicating that BRK instruction should not be reported */
 int libatari800_continue_on_brk = 0;
 
+/* global variable indicating that BRK instruction should stop the CPU, set
+   only when asked for */
+int libatari800_stop_on_brk = 0;
+
 /* global variable indicating last error code */
 int libatari800_error_code;
 
+/* What libatari800_next_frame records for rewinding a frame */
+typedef struct {
+	input_template_t input;
+	int pots[8];  /* INPUT_pot_override */
+} rewind_input_t;
+
+/* Features of the selected context, see libatari800_set_features */
+static AI_FEATURE_Table feature_table;
+static float *feature_out = NULL;
+
+/* Set while libatari800_next_frames runs, which ends its step after its
+   last frame only */
+static int next_frames_running = FALSE;
+
+/* Observation of the selected context written after every step, see
+   libatari800_set_observation_buffer */
+typedef struct {
+	UBYTE *dest;
+	int width, height, format, x1, y1, x2, y2;
+	ULONG *screen; /* the context's own screen while ANTIC draws into dest */
+} observation_t;
+
+static observation_t observation;
+
+/* Features, observation and screen ring at the end of a step */
+static void step_done(void)
+{
+	LIBATARI800_ScreenRing_Publish();
+	if (feature_table.n > 0)
+		AI_FEATURE_Eval(&feature_table, feature_out);
+	if (observation.dest != NULL && observation.screen == NULL)
+		AI_OBS_Render(observation.dest, observation.width, observation.height,
+			observation.format, observation.x1, observation.y1, observation.x2, observation.y2);
+}
+
 
 /** Initialize emulator configuration
  * 
@@ -165,12 +211,16 @@ const char *libatari800_error_message() {
  * condition. But some programs trap the BRK instruction to implement extra functionality
  * like a debugger.
  * 
+ * Until this is called, a BRK runs as on the machine and the frame returns the error code
+ * LIBATARI800_BRK_INSTRUCTION.
+ *
  * @param cont if True, the emulation will continue without notification when a BRK is
  * encountered. If False, emulation immediately exits with the error code
- * LIBATARI800_BRK_INSTRUCTION
+ * LIBATARI800_BRK_INSTRUCTION, the CPU stopped on the BRK
  */
 void libatari800_continue_emulation_on_brk(int cont) {
 	libatari800_continue_on_brk = cont;
+	libatari800_stop_on_brk = !cont;
 }
 
 
@@ -192,6 +242,32 @@ void libatari800_clear_input_array(input_template_t *input)
 }
 
 
+/** Set the analog inputs of the POKEY pots
+ *
+ * For the 5200's analog sticks (pots 2i and 2i + 1 are the x and y of
+ * controller i, 6 left or up to 220 right or down, 114 centred) and for
+ * paddles. A pot set here overrides what the input array's joystick or
+ * mouse would give it, from the next frame on until it is set again; the
+ * triggers, keypad (keycode, with AKEY_5200_ codes) and second button
+ * (shift) stay in the input array.
+ *
+ * The values are not part of the input array; movies and rewind record
+ * them with the input of each frame. They belong to no context.
+ *
+ * @param pots 8 values 0-228, or -1 for a pot to work as usual; NULL
+ * releases all of them
+ */
+void libatari800_set_pots(const int *pots)
+{
+	int i;
+
+	for (i = 0; i < 8; i++) {
+		int v = pots == NULL ? -1 : pots[i];
+		INPUT_pot_override[i] = v < 0 ? -1 : v > 228 ? 228 : v;
+	}
+}
+
+
 /** Perform one video frame's worth of emulation
  * 
  * This is the main driver for libatari800. This function runs the emulator for enough
@@ -211,31 +287,106 @@ void libatari800_clear_input_array(input_template_t *input)
  */
 int libatari800_next_frame(input_template_t *input)
 {
+	rewind_input_t rec;
+
+	rec.input = *input;
+	memcpy(rec.pots, INPUT_pot_override, sizeof(rec.pots));
+	AI_REWIND_RecordInput(AI_REWIND_LIBATARI800, Atari800_nframes + 1, &rec, sizeof(rec));
 	LIBATARI800_Input_array = input;
 	INPUT_key_code = PLATFORM_Keyboard();
 	LIBATARI800_Mouse();
-#ifdef HAVE_SETJMP
-	if ((libatari800_error_code = setjmp(libatari800_cpu_crash))) {
-		/* called from within CPU_GO to indicate crash */
-		Log_print("libatari800_next_frame: notified of CPU crash: %d\n", CPU_cim_encountered);
+	libatari800_error_code = 0;
+	LIBATARI800_Frame();
+	if (CPU_stopped) {
+		/* CPU_GO stopped the CPU at a crash, BRK or bad escape code for
+		   the rest of the frame; it runs again from there next frame */
+		Log_print("libatari800_next_frame: CPU stopped: %d", CPU_stopped);
+		libatari800_error_code = CPU_stopped;
+		CPU_Resume();
 	}
-	else
-#endif /* HAVE_SETJMP */
-	{
-		/* normal operation */
-		LIBATARI800_Frame();
-		if (CPU_cim_encountered) {
-			libatari800_error_code = LIBATARI800_CPU_CRASH;
-		}
-		else if (ANTIC_dlist == 0) {
-			libatari800_error_code = LIBATARI800_DLIST_ERROR;
-		}
+	else if (libatari800_error_code) {
+		/* a BRK the CPU ran through */
+	}
+	else if (CPU_cim_encountered) {
+		libatari800_error_code = LIBATARI800_CPU_CRASH;
 	}
-	PLATFORM_DisplayScreen();
+	else if (ANTIC_dlist == 0) {
+		libatari800_error_code = LIBATARI800_DLIST_ERROR;
+	}
+	if (Atari800_display_screen)
+		PLATFORM_DisplayScreen();
+	AI_REWIND_Frame();
+	if (!next_frames_running)
+		step_done();
 	return !libatari800_error_code;
 }
 
 
+/** Perform several video frames with the same input
+ *
+ * Runs up to \a frames frames as \a libatari800_next_frame does, repeating
+ * \a input for each of them as a frameskip ("action repeat") does, in a
+ * single call. Only the last frame is drawn, or the last two with
+ * LIBATARI800_FRAMES_MAXPOOL, whatever the render policy, and the mouse
+ * pointer, speed and LED overlays are left out. The frames before them run
+ * ANTIC without drawing but still detect collisions, so the emulation is
+ * the same as with \a libatari800_next_frame.
+ *
+ * With LIBATARI800_FRAMES_MAXPOOL the screen afterwards holds the maximum
+ * of the last two frames: each pixel the colour of the two with the
+ * greater luminance, which removes the flicker of sprites multiplexed over
+ * alternate frames.
+ *
+ * With LIBATARI800_FRAMES_SOUND the sound buffer afterwards holds the
+ * samples of all the frames run, one after another, and \a
+ * libatari800_get_sound_buffer_len their total size; the buffer grows as
+ * needed. Otherwise it holds those of the last frame.
+ *
+ * Features set with \a libatari800_set_features are evaluated once, after
+ * the last frame, so their deltas are the changes over all the frames, and
+ * the observation buffer is written then as well.
+ *
+ * Emulation stops after a frame with an error; \a libatari800_error_message
+ * describes it.
+ *
+ * @param input input template structure defining the user input for every
+ * frame
+ * @param frames number of frames to run
+ * @param flags LIBATARI800_FRAMES_ values or'ed together
+ *
+ * @returns number of frames run without an error, \a frames if all of them
+ */
+int libatari800_next_frames(input_template_t *input, int frames, int flags)
+{
+	static UBYTE *pool = NULL;
+	int drawn = flags & LIBATARI800_FRAMES_MAXPOOL ? 2 : 1;
+	int f;
+
+	if (flags & LIBATARI800_FRAMES_SOUND) {
+		sound_array_fill = 0;
+		sound_accumulate = TRUE;
+	}
+	next_frames_running = TRUE;
+	for (f = 0; f < frames; f++) {
+		LIBATARI800_draw_frame = f >= frames - drawn;
+		if (!libatari800_next_frame(input))
+			break;
+		if (drawn == 2 && f == frames - 2) {
+			if (pool == NULL)
+				pool = (UBYTE *)Util_malloc(Screen_WIDTH * Screen_HEIGHT);
+			memcpy(pool, Screen_atari, Screen_WIDTH * Screen_HEIGHT);
+		}
+		else if (drawn == 2 && f == frames - 1 && frames >= 2)
+			AI_OBS_MaxPool(pool);
+	}
+	LIBATARI800_draw_frame = -1;
+	sound_accumulate = FALSE;
+	next_frames_running = FALSE;
+	step_done();
+	return f;
+}
+
+
 /** Use disk image in a disk drive
  * 
  * Insert a virtual floppy image into one of the emulated disk drives. Currently
@@ -274,12 +425,101 @@ int libatari800_reboot_with_file(const char *filename)
 
 	file_type = AFILE_OpenFile(filename, FALSE, 1, FALSE);
 	if (file_type != AFILE_ERROR) {
+		/* As at libatari800_init, a raw cartridge whose size fits several
+		   types is left out, with LIBATARI800_UNIDENTIFIED_CART_TYPE */
+		if ((file_type & 0xff) == AFILE_ROM && CARTRIDGE_main.type == CARTRIDGE_UNKNOWN)
+			CARTRIDGE_SetType(&CARTRIDGE_main, UI_SelectCartType(CARTRIDGE_main.size));
 		Atari800_Coldstart();
 	}
 	return file_type;
 }
 
 
+/** Cold start with a cartridge of a given type
+ *
+ * Inserts \a filename as the main cartridge as the arguments `-cart-type
+ * type -cart filename` to \a libatari800_init would, without setting up the
+ * rest of the emulator again: a CART file keeps the type in its header, and
+ * a raw image gets \a type if it is of that type's size. A raw image left
+ * without a type is not inserted, with the error
+ * LIBATARI800_UNIDENTIFIED_CART_TYPE.
+ *
+ * @param filename cartridge image
+ * @param type cartridge type number as for -cart-type, or 0 for none
+ *
+ * @retval FALSE if the image could not be inserted
+ * @retval TRUE if the emulator was cold started with it
+ */
+int libatari800_reboot_with_cartridge(const char *filename, int type)
+{
+	int kb = CARTRIDGE_Insert(filename);
+
+	if (kb < 0) {
+		CARTRIDGE_Remove();
+		return FALSE;
+	}
+	/* The type given wins over one from a known dump */
+	if (CARTRIDGE_main.raw && type > 0 && type < CARTRIDGE_TYPE_COUNT
+	    && CARTRIDGES[type].kb == CARTRIDGE_main.size) {
+		if (CARTRIDGE_main.type != type)
+			CARTRIDGE_SetType(&CARTRIDGE_main, type);
+	}
+	else if (CARTRIDGE_main.type == CARTRIDGE_UNKNOWN)
+		CARTRIDGE_SetType(&CARTRIDGE_main, UI_SelectCartType(kb));
+	Atari800_Coldstart();
+	return CARTRIDGE_main.type != CARTRIDGE_NONE;
+}
+
+
+/** Look up a raw cartridge image among the known dumps
+ *
+ * Tells what the emulator knows of \a filename from the CRC32 of its data,
+ * as -cart-db describes, so that a known dump needs no trial runs to find
+ * its settings. CART files carry their type in the header and are not
+ * looked up.
+ *
+ * @param filename raw cartridge image
+ * @param type gets the cartridge type number, if not NULL
+ * @param machine gets LIBATARI800_MACHINE_800, _XLXE or _5200, or -1 if the
+ * dump runs on any machine, if not NULL
+ * @param tv gets 312 for PAL or 262 for NTSC, or -1 if either will do, if
+ * not NULL
+ *
+ * @retval FALSE if the image is not a known dump
+ * @retval TRUE if it is
+ */
+int libatari800_identify_cartridge(const char *filename, int *type, int *machine, int *tv)
+{
+	FILE *fp = fopen(filename, "rb");
+	CARTRIDGE_known_t const *known = NULL;
+	UBYTE *image;
+	int len;
+
+	if (fp == NULL)
+		return FALSE;
+	len = Util_flen(fp);
+	Util_rewind(fp);
+	if (len < CARTRIDGE_MIN_SIZE || len > CARTRIDGE_MAX_SIZE || (len & 0x3ff) != 0) {
+		fclose(fp);
+		return FALSE;
+	}
+	image = (UBYTE *)Util_malloc(len);
+	if (fread(image, 1, len, fp) == (size_t)len)
+		known = CARTRIDGE_Identify(image, len >> 10);
+	fclose(fp);
+	free(image);
+	if (known == NULL)
+		return FALSE;
+	if (type != NULL)
+		*type = known->type;
+	if (machine != NULL)
+		*machine = known->machine;
+	if (tv != NULL)
+		*tv = known->tv;
+	return TRUE;
+}
+
+
 /** Return pointer to main memory
  *
  * This is actual array containing the emulator's main bank of 64k of RAM.
@@ -297,6 +537,82 @@ UBYTE *libatari800_get_main_memory_ptr()
 }
 
 
+/** Compute values from memory after every frame
+ *
+ * Registers a table of features of the selected context, values read from
+ * the 64k the CPU sees that are written to \a out after each \a
+ * libatari800_next_frame, or after the last frame of each \a
+ * libatari800_next_frames, so rewards and game state need no decoding of
+ * memory by the caller. Each feature is one of:
+ *
+ * LIBATARI800_FEATURE_BYTE, the byte at addr, and mask;
+ * LIBATARI800_FEATURE_SBYTE, the same as a signed byte;
+ * LIBATARI800_FEATURE_WORD and LIBATARI800_FEATURE_WORD_BE, the word at
+ * addr, low or high byte first;
+ * LIBATARI800_FEATURE_BCD and LIBATARI800_FEATURE_BCD_LE, a number of len
+ * bytes of packed BCD such as a score, most or least significant byte
+ * first, where digits above 9 count as 0;
+ * LIBATARI800_FEATURE_BIT, 1 if the byte at addr and mask is not 0, else 0.
+ *
+ * With delta set the feature is the change of its value since the previous
+ * evaluation, 0 at the first. The result is multiplied by scale. Hardware
+ * registers are read without side effects.
+ *
+ * @param features array of \a n features
+ * @param n number of features, 0 - LIBATARI800_MAX_FEATURES, or 0 to stop
+ * @param out caller-owned array of \a n floats, written to until the
+ * features are replaced
+ *
+ * @retval FALSE if a feature is invalid (see the log); the previous features
+ * stay
+ * @retval TRUE if successful
+ */
+int libatari800_set_features(const feature_template_t *features, int n, float *out)
+{
+	AI_FEATURE_Def defs[AI_FEATURE_MAX];
+	const char *err = NULL;
+	int i;
+
+	for (i = 0; i < n && i < AI_FEATURE_MAX; i++) {
+		if (features[i].addr < 0 || features[i].addr > 0xffff)
+			err = "addr must be 0 - 65535";
+		defs[i].kind = features[i].kind;
+		defs[i].addr = (UWORD)features[i].addr;
+		defs[i].len = features[i].len;
+		defs[i].mask = (UBYTE)features[i].mask;
+		defs[i].delta = features[i].delta;
+		defs[i].scale = features[i].scale;
+	}
+	if (n > 0 && out == NULL)
+		err = "out is NULL";
+	if (err == NULL)
+		err = AI_FEATURE_Set(&feature_table, defs, n);
+	if (err != NULL) {
+		Log_print("libatari800_set_features: %s", err);
+		return FALSE;
+	}
+	feature_out = out;
+	return TRUE;
+}
+
+
+/** Evaluate the features now
+ *
+ * Writes the features of the selected context (see \a
+ * libatari800_set_features) to their array without running a frame, so
+ * their deltas after the next frame are measured from the current state,
+ * for instance after restoring a snapshot.
+ *
+ * @returns number of features evaluated
+ */
+int libatari800_eval_features(void)
+{
+	if (feature_table.n > 0)
+		AI_FEATURE_Eval(&feature_table, feature_out);
+	return feature_table.n;
+}
+
+
 /** Return pointer to screen data
  *
  * The emulated screen is an array of 384x240 bytes in scan line order with the
@@ -310,7 +626,8 @@ UBYTE *libatari800_get_main_memory_ptr()
  * 320x192 addressable pixels.
  * 
  * Note that the screen is output only, and changes to this array will have no
- * effect on the emulation.
+ * effect on the emulation. With -scanline-cache, changed lines may stay as
+ * they are until the emulation draws something else on them.
  *
  * @returns pointer to the beginning of the 92160 bytes of data holding the
  * emulated screen.
@@ -321,6 +638,144 @@ UBYTE *libatari800_get_screen_ptr()
 }
 
 
+/** Choose which frames are drawn
+ *
+ * Frames that are not drawn still run ANTIC for its timing (and collisions
+ * if Atari800_collisions_in_skipped_frames is set) but leave the screen
+ * buffer holding the last drawn frame, which roughly doubles emulation
+ * speed when only every few frames are looked at.
+ *
+ * LIBATARI800_RENDER_ALWAYS draws every frame (the default).
+ * LIBATARI800_RENDER_OBSERVED draws the frames an AI interface client will
+ * see; without the AI interface enabled this is every frame.
+ * LIBATARI800_RENDER_EVERY draws frames whose number is a multiple of
+ * \a every.
+ *
+ * @param policy one of the LIBATARI800_RENDER_ values
+ * @param every frame interval for LIBATARI800_RENDER_EVERY
+ */
+void libatari800_set_render_policy(int policy, int every)
+{
+	AI_render_policy = policy;
+	AI_render_every = every < 1 ? 1 : every;
+}
+
+
+/** Render a resized observation of the screen
+ *
+ * Crops the screen to the rectangle x1 <= x < x2, y1 <= y < y2 and resizes
+ * it to width x height pixels, writing width * height bytes in scan line
+ * order to dest. If the rectangle is empty (e.g. all zeros) the visible area
+ * is used, which is normally 336x240 starting at column 24.
+ *
+ * LIBATARI800_OBS_GRAY produces 8-bit luminance of the current palette,
+ * averaged over the source pixels each output pixel covers.
+ * LIBATARI800_OBS_INDEX produces Atari color indexes, taken from the center
+ * of each covered area.
+ *
+ * @param dest buffer of at least width * height bytes
+ * @param width output width, 1 - 384
+ * @param height output height, 1 - 240
+ * @param format LIBATARI800_OBS_GRAY or LIBATARI800_OBS_INDEX
+ *
+ * @returns number of bytes written, or 0 if the arguments are invalid
+ */
+int libatari800_get_observation(UBYTE *dest, int width, int height, int format,
+		int x1, int y1, int x2, int y2)
+{
+	return AI_OBS_Render(dest, width, height, format, x1, y1, x2, y2);
+}
+
+
+/** Have every step write its observation to a buffer
+ *
+ * After each \a libatari800_next_frame, or after the last frame of each \a
+ * libatari800_next_frames, the observation \a libatari800_get_observation
+ * would return is written to \a dest, caller-owned memory such as a pinned
+ * array, for the selected context.
+ *
+ * Asking for the whole 384x240 screen in LIBATARI800_OBS_INDEX format
+ * (x1 = y1 = 0, x2 = 384, y2 = 240) with \a dest aligned to 4 bytes makes
+ * \a dest the screen itself: ANTIC draws into it and nothing is copied.
+ * \a libatari800_get_screen_ptr then returns \a dest. As with that pointer,
+ * changes made to the buffer may stay on lines that -scanline-cache does
+ * not redraw.
+ *
+ * @param dest buffer of at least width * height bytes, or NULL to stop
+ * writing one
+ * @param width output width, 1 - 384
+ * @param height output height, 1 - 240
+ * @param format LIBATARI800_OBS_GRAY or LIBATARI800_OBS_INDEX
+ *
+ * @retval FALSE if the arguments are invalid; the previous buffer stays
+ * @retval TRUE if successful, \a dest then holding the current observation
+ */
+int libatari800_set_observation_buffer(UBYTE *dest, int width, int height, int format,
+		int x1, int y1, int x2, int y2)
+{
+	int direct = dest != NULL && format == LIBATARI800_OBS_INDEX
+		&& width == Screen_WIDTH && height == Screen_HEIGHT
+		&& x1 == 0 && y1 == 0 && x2 == Screen_WIDTH && y2 == Screen_HEIGHT
+		&& ((size_t)dest & (sizeof(ULONG) - 1)) == 0;
+
+	if (dest != NULL && !direct && AI_OBS_Render(dest, width, height, format, x1, y1, x2, y2) == 0)
+		return FALSE;
+	if (observation.screen != NULL) {
+		/* Give the context its screen back */
+		memcpy(observation.screen, Screen_atari, Screen_WIDTH * Screen_HEIGHT);
+		Screen_atari = observation.screen;
+		observation.screen = NULL;
+		ANTIC_InvalidateScanlineCache();
+	}
+	if (direct) {
+		memcpy(dest, Screen_atari, Screen_WIDTH * Screen_HEIGHT);
+		observation.screen = Screen_atari;
+		Screen_atari = (ULONG *)dest;
+		ANTIC_InvalidateScanlineCache();
+	}
+	observation.dest = dest;
+	observation.width = width;
+	observation.height = height;
+	observation.format = format;
+	observation.x1 = x1;
+	observation.y1 = y1;
+	observation.x2 = x2;
+	observation.y2 = y2;
+	return TRUE;
+}
+
+
+/** Hash the visible area of the screen
+ *
+ * Each line of the visible area is hashed, and the line hashes are hashed
+ * in order, so equal screens give equal hashes. Meant for telling whether
+ * a screen was seen before, not for security.
+ *
+ * @returns 64-bit hash of the screen
+ */
+uint64_t libatari800_get_screen_hash(void)
+{
+	return AI_HASH_Screen();
+}
+
+
+/** Hash the state of the machine
+ *
+ * Covers the memory the CPU sees (but the hardware registers' pages), every
+ * extended RAM bank, and the registers of the CPU, ANTIC, GTIA, POKEY and
+ * PIA. The hash of each 256-byte page is kept until the page changes, so a
+ * frame that wrote to a few pages costs little more than a compare of the
+ * memory. Meant for telling whether a state was seen before, not for
+ * security.
+ *
+ * @returns 64-bit hash of the machine state
+ */
+uint64_t libatari800_get_state_hash(void)
+{
+	return AI_HASH_State();
+}
+
+
 /** Return pointer to sound data
  *
  * If sound is used, each emulated frame will fill the sound buffer with samples
@@ -358,7 +813,7 @@ int libatari800_get_sound_buffer_len() {
  */
 
 int libatari800_get_sound_buffer_allocated_size() {
-	return (int)sound_hw_buffer_size;
+	return (int)sound_array_size;
 }
 
 
@@ -385,9 +840,50 @@ int libatari800_get_num_sound_channels() {
  *
  * @retval 1 8-bit audio
  * @retval 2 16-bit audio
+ * @retval 4 float32 audio
  */
 int libatari800_get_sound_sample_size() {
-	return Sound_out.sample_size;
+	return sound_float ? 4 : Sound_out.sample_size;
+}
+
+
+/** Set the rate, channels and sample format of the sound buffer
+ *
+ * POKEY is synthesised directly at \a freq, so a model that wants 16 kHz
+ * mono floats gets them from \a libatari800_get_sound_buffer without
+ * resampling or converting each frame's samples itself. Floats are the
+ * 16-bit samples scaled to -1.0 to 1.0. Two channels need a build with
+ * stereo sound, and play the second POKEY on the second channel; with one
+ * the second POKEY is not heard.
+ *
+ * Sound output is started over, so the samples of the current frame are
+ * lost, and started if it was disabled. The rate is limited to what the
+ * POKEY emulation supports: \a libatari800_get_sound_frequency returns the
+ * one used.
+ *
+ * @param freq sample rate in Hz
+ * @param channels 1 for mono, 2 for stereo
+ * @param format LIBATARI800_SOUND_U8, LIBATARI800_SOUND_S16 or
+ * LIBATARI800_SOUND_FLOAT
+ *
+ * @retval FALSE if the format is not supported or sound could not be
+ * started, which leaves it disabled
+ */
+int libatari800_set_sound_format(int freq, int channels, int format)
+{
+	if ((format != LIBATARI800_SOUND_U8 && format != LIBATARI800_SOUND_S16
+		&& format != LIBATARI800_SOUND_FLOAT) || channels < 1 || freq <= 0)
+		return FALSE;
+	if (Sound_enabled)
+		Sound_Exit();
+	Sound_desired.freq = freq;
+	Sound_desired.channels = channels;
+	Sound_desired.sample_size = format == LIBATARI800_SOUND_FLOAT ? 2 : format;
+	sound_float = format == LIBATARI800_SOUND_FLOAT;
+	if (!Sound_Setup())
+		return FALSE;
+	Sound_Continue();
+	return TRUE;
 }
 
 
@@ -459,6 +955,8 @@ void libatari800_get_current_state(emulator_state_t *state)
 	state->flags.selftest_enabled = MEMORY_selftest_enabled;
 	state->flags.nframes = (ULONG)Atari800_nframes;
 	state->flags.sample_residual = (ULONG)(0xffffffff * sample_residual);
+	state->flags.random_counter = POKEY_GetRandomCounter();
+	INPUT_GetFrameState(state->flags.input_state);
 }
 
 
@@ -479,6 +977,257 @@ void libatari800_restore_state(emulator_state_t *state)
 	MEMORY_selftest_enabled = state->flags.selftest_enabled;
 	Atari800_nframes = state->flags.nframes;
 	sample_residual = (double)state->flags.sample_residual / (double)0xffffffff;
+	POKEY_SetRandomCounter(state->flags.random_counter);
+	INPUT_SetFrameState(state->flags.input_state);
+	AI_REWIND_Clear();
+}
+
+
+/* Leads every snapshot buffer */
+typedef struct {
+	ULONG magic;
+	ULONG version;
+	ULONG size;
+	ULONG nframes;
+	int selftest_enabled;
+	double sample_residual;
+} snapshot_header_t;
+
+#define SNAPSHOT_MAGIC 0x50414e53 /* "SNAP" */
+
+
+/** Save a fast in-process snapshot of the emulator
+ *
+ * Like \a libatari800_get_current_state, but copies the running state
+ * (CPU, ANTIC, GTIA, POKEY, PIA, memory and cartridge bank) in native
+ * layout without the portable state file format, and leaves out the
+ * machine type and the mounted cartridges and disks. A snapshot is only
+ * valid in the process that wrote it, with the same media inserted:
+ * restoring it does not reload any file, so it is cheap enough for search
+ * algorithms that branch thousands of times a second.
+ *
+ * The size depends on the machine type and its amount of RAM, from about
+ * 130 KB for an 800XL; a NULL \a buffer returns the size needed without
+ * saving anything.
+ *
+ * @param buffer buffer to save into, or NULL
+ * @param size size of \a buffer
+ *
+ * @returns number of bytes used (or needed), or 0 if \a buffer is too small
+ */
+int libatari800_save_snapshot(UBYTE *buffer, int size)
+{
+	snapshot_header_t *header = (snapshot_header_t *)buffer;
+	ULONG len;
+
+	if (buffer == NULL)
+		return (int)(sizeof(snapshot_header_t) + StateSav_SaveSnapshot(NULL, 0));
+	if (size < (int)sizeof(snapshot_header_t))
+		return 0;
+	len = StateSav_SaveSnapshot(buffer + sizeof(snapshot_header_t), size - sizeof(snapshot_header_t));
+	if (len == 0)
+		return 0;
+	header->magic = SNAPSHOT_MAGIC;
+	header->version = LIBATARI800_SNAPSHOT_VERSION;
+	header->size = sizeof(snapshot_header_t) + len;
+	header->nframes = (ULONG)Atari800_nframes;
+	header->selftest_enabled = MEMORY_selftest_enabled;
+	header->sample_residual = sample_residual;
+	return (int)header->size;
+}
+
+
+/** Restore a snapshot from \a libatari800_save_snapshot
+ *
+ * @param buffer snapshot data
+ *
+ * @retval FALSE if \a buffer does not hold a snapshot of this version
+ * @retval TRUE if the emulator was restored
+ */
+int libatari800_restore_snapshot(const UBYTE *buffer)
+{
+	const snapshot_header_t *header = (const snapshot_header_t *)buffer;
+
+	if (header->magic != SNAPSHOT_MAGIC || header->version != LIBATARI800_SNAPSHOT_VERSION)
+		return FALSE;
+	if (!StateSav_ReadSnapshot(buffer + sizeof(snapshot_header_t), header->size - sizeof(snapshot_header_t)))
+		return FALSE;
+	Atari800_nframes = header->nframes;
+	MEMORY_selftest_enabled = header->selftest_enabled;
+	sample_residual = header->sample_residual;
+	AI_REWIND_Clear();
+	return TRUE;
+}
+
+
+/** Expand several children of one snapshot
+ *
+ * For each of \a k inputs, restores \a parent, runs \a frames frames with
+ * that input as \a libatari800_next_frames does and saves a snapshot of the
+ * result as \a libatari800_save_snapshot does into children + i * \a
+ * stride, so a tree search expands a node in one call. The emulator is left
+ * as the last child.
+ *
+ * With features set (see \a libatari800_set_features), the values after
+ * child i are stored at features + i * n for the n features, their deltas
+ * being the changes from \a parent.
+ *
+ * @param parent snapshot from \a libatari800_save_snapshot
+ * @param inputs array of \a k inputs, one per child
+ * @param k number of children
+ * @param frames frames to run for each child
+ * @param children buffer of \a k * \a stride bytes for the children's
+ * snapshots, or NULL to not save them
+ * @param stride bytes for each child's snapshot, at least the size of \a
+ * parent to be sure they fit
+ * @param sizes if not NULL, gets the size of each child's snapshot, 0 if it
+ * did not fit
+ * @param features if not NULL, buffer of \a k * n floats for the features
+ *
+ * @returns number of children whose frames all ran without an error, or -1
+ * if \a parent is not a valid snapshot
+ */
+int libatari800_restore_and_step_many(const UBYTE *parent, input_template_t *inputs, int k,
+		int frames, UBYTE *children, int stride, int *sizes, float *features)
+{
+	int i, ok = 0;
+
+	for (i = 0; i < k; i++) {
+		if (!libatari800_restore_snapshot(parent))
+			return -1;
+		/* Deltas are from the parent */
+		if (feature_table.n > 0)
+			AI_FEATURE_Eval(&feature_table, feature_out);
+		if (libatari800_next_frames(&inputs[i], frames, 0) == frames)
+			ok++;
+		if (children != NULL) {
+			int size = libatari800_save_snapshot(children + (size_t)i * stride, stride);
+			if (sizes != NULL)
+				sizes[i] = size;
+		}
+		if (features != NULL && feature_table.n > 0)
+			memcpy(features + (size_t)i * feature_table.n, feature_out, feature_table.n * sizeof(float));
+	}
+	return ok;
+}
+
+
+/** Keep a rewind history
+ *
+ * Every \a stride frames \a libatari800_next_frame keeps a keyframe of the
+ * machine state, up to \a depth of them, plus the input of every frame
+ * since the oldest. Only the newest keyframe is stored whole, the others as
+ * run-length packed differences from the next, so the history costs little
+ * more than one snapshot when the frames between keyframes change little.
+ * Changing the settings, restoring a snapshot or state, or selecting another
+ * context forgets the history.
+ *
+ * @param depth number of keyframes to keep, 0 to turn rewind off
+ * @param stride frames between keyframes
+ *
+ * @retval FALSE if \a depth or \a stride is out of range
+ * @retval TRUE if the history was set up
+ */
+int libatari800_set_rewind(int depth, int stride)
+{
+	return AI_REWIND_Configure(depth, stride);
+}
+
+
+/** Rewind the emulator by a number of frames
+ *
+ * Restores the newest keyframe at or before the target frame, then runs
+ * the remaining frames with the input \a libatari800_next_frame recorded
+ * for them, so the machine ends up as it was \a frames frames ago. The
+ * keyframes after the target are dropped.
+ *
+ * @param frames number of frames to go back
+ *
+ * @retval FALSE if the target frame is outside the history
+ * @retval TRUE if the emulator was rewound
+ */
+int libatari800_rewind(int frames)
+{
+	rewind_input_t rec;
+	int target = Atari800_nframes - frames;
+
+	if (AI_REWIND_Restore(target) < 0)
+		return FALSE;
+	while (Atari800_nframes < target) {
+		const void *recorded = AI_REWIND_GetInput(AI_REWIND_LIBATARI800, Atari800_nframes + 1);
+		if (recorded != NULL) {
+			memcpy(&rec, recorded, sizeof(rec));
+			libatari800_set_pots(rec.pots);
+		}
+		else {
+			libatari800_clear_input_array(&rec.input);
+			libatari800_set_pots(NULL);
+		}
+		libatari800_next_frame(&rec.input);
+	}
+	return TRUE;
+}
+
+
+/** Collect code coverage
+ *
+ * While \a map is set, the CPU sets map[pc] to 1 before every instruction
+ * it runs, through a copy of its loop that does just that (the one with
+ * the debugging checks, if those are on, marks it too). The map is the
+ * same one the AI interface's coverage_start uses; the caller clears it.
+ *
+ * @param map 65536 bytes, or NULL to stop
+ */
+void libatari800_set_coverage(UBYTE *map)
+{
+	AI_coverage = map;
+	CPU_UpdateGo();
+}
+
+
+/** Start recording the emulator's sound and video to a file
+ *
+ * The kind of file follows from the extension of \a filename, as in the
+ * emulator: .avi records video and sound, .wav (or .mp3 where supported)
+ * sound only. The codecs and other settings are those of the emulator
+ * options passed to \a libatari800_init, such as -vcodec and -acodec. Each
+ * frame \a libatari800_next_frame runs is added to the file, at the
+ * emulated frame rate however fast the frames are run; frames that are
+ * not drawn (see \a libatari800_set_render_policy) show the last frame
+ * drawn. A file already being recorded is closed first.
+ *
+ * @param filename name of the file to write
+ *
+ * @retval FALSE if the file could not be written, or recording is not
+ * compiled in
+ * @retval TRUE if recording has started
+ */
+int libatari800_start_recording(const char *filename)
+{
+#if defined(AUDIO_RECORDING) || defined(VIDEO_RECORDING)
+	return File_Export_StartRecording(filename);
+#else
+	return FALSE;
+#endif
+}
+
+
+/** Finish the file being recorded
+ *
+ * Writes out what is still buffered and completes the file's headers.
+ * \a libatari800_exit does this as well.
+ *
+ * @retval FALSE if nothing was being recorded or the file could not be
+ * completed
+ * @retval TRUE if the file was written
+ */
+int libatari800_stop_recording(void)
+{
+#if defined(AUDIO_RECORDING) || defined(VIDEO_RECORDING)
+	return File_Export_StopRecording();
+#else
+	return FALSE;
+#endif
 }
 
 
@@ -493,6 +1242,257 @@ void libatari800_exit() {
 	Atari800_Exit(0);
 }
 
+
+/* Emulator contexts. The core keeps one machine in globals, so a context
+   holds the saved state of a machine that is not running, plus its own
+   screen buffer and disk drives, and is swapped into the globals when it
+   is used. */
+struct atari800_ctx {
+	UBYTE *state;
+	int state_size;
+	ULONG *screen;
+	int error_code;
+	SIO_drives_t *drives;
+	AI_FEATURE_Table features;
+	float *features_out;
+	observation_t observation;
+};
+
+static atari800_ctx_t *ctx_live = NULL;    /* NULL = the initial machine */
+static atari800_ctx_t *ctx_initial = NULL; /* the initial machine when swapped out */
+
+static void ctx_save(atari800_ctx_t *ctx)
+{
+	if (ctx->state != NULL && libatari800_save_snapshot(ctx->state, ctx->state_size) != 0)
+		return;
+	ctx->state_size = libatari800_save_snapshot(NULL, 0);
+	ctx->state = (UBYTE *)Util_realloc(ctx->state, ctx->state_size);
+	libatari800_save_snapshot(ctx->state, ctx->state_size);
+}
+
+static void ctx_swap(atari800_ctx_t *ctx)
+{
+	atari800_ctx_t *out = ctx_live;
+	atari800_ctx_t *in = ctx;
+
+	if (ctx == ctx_live)
+		return;
+	if (out == NULL) {
+		if (ctx_initial == NULL) {
+			ctx_initial = (atari800_ctx_t *)Util_malloc(sizeof(atari800_ctx_t));
+			ctx_initial->state = NULL;
+			ctx_initial->state_size = 0;
+			ctx_initial->drives = NULL;
+			ctx_initial->features.n = 0;
+			ctx_initial->features_out = NULL;
+			ctx_initial->observation.dest = NULL;
+			ctx_initial->observation.screen = NULL;
+		}
+		out = ctx_initial;
+	}
+	ctx_save(out);
+	/* While ANTIC draws into a context's observation buffer, its own
+	   screen waits in observation.screen */
+	out->screen = observation.screen != NULL ? observation.screen : Screen_atari;
+	out->observation = observation;
+	out->error_code = libatari800_error_code;
+	out->drives = SIO_SaveDrives(out->drives);
+	out->features = feature_table;
+	out->features_out = feature_out;
+
+	if (in == NULL)
+		in = ctx_initial;
+	libatari800_restore_snapshot(in->state);
+	observation = in->observation;
+	Screen_atari = observation.screen != NULL ? (ULONG *)observation.dest : in->screen;
+	libatari800_error_code = in->error_code;
+	SIO_LoadDrives(in->drives);
+	feature_table = in->features;
+	feature_out = in->features_out;
+	ctx_live = ctx;
+	ANTIC_InvalidateScanlineCache();
+}
+
+
+/** Create a new emulator context
+ *
+ * The context starts as a copy of the machine that is currently selected,
+ * including its memory, screen and disk drives. All contexts share the
+ * configuration, ROMs and cartridges given to \a libatari800_init; each has
+ * its own machine state, kept as a snapshot (see \a
+ * libatari800_save_snapshot), and its own drives. Disks mounted with the
+ * same contents in any context are read and decoded once and shared; each
+ * context keeps the sectors it writes and its drive timing to itself (see
+ * -disk-writes for when writes reach the file). A context is swapped into
+ * the emulator when selected, so contexts may be used from one thread at a
+ * time only.
+ *
+ * @returns new context, to be released with \a libatari800_ctx_free
+ */
+atari800_ctx_t *libatari800_ctx_new(void)
+{
+	atari800_ctx_t *ctx = (atari800_ctx_t *)Util_malloc(sizeof(atari800_ctx_t));
+
+	ctx->state = NULL;
+	ctx->state_size = 0;
+	ctx_save(ctx);
+	ctx->screen = (ULONG *)Util_malloc(Screen_HEIGHT * Screen_WIDTH);
+	memcpy(ctx->screen, Screen_atari, Screen_HEIGHT * Screen_WIDTH);
+	ctx->error_code = libatari800_error_code;
+	ctx->drives = SIO_CopyDrives();
+	ctx->features.n = 0;
+	ctx->features_out = NULL;
+	ctx->observation.dest = NULL;
+	ctx->observation.screen = NULL;
+	return ctx;
+}
+
+
+/** Make a context the current machine
+ *
+ * All other libatari800 calls (memory and screen pointers, input, state
+ * save and restore, ...) act on the selected context until another one is
+ * selected. Pointers returned by \a libatari800_get_screen_ptr belong to
+ * the context that was selected when they were obtained.
+ *
+ * @param ctx context to select, or NULL for the machine created by \a
+ * libatari800_init
+ */
+void libatari800_ctx_select(atari800_ctx_t *ctx)
+{
+	ctx_swap(ctx);
+}
+
+
+/** Return the selected context
+ *
+ * @returns context last selected, or NULL for the machine created by \a
+ * libatari800_init
+ */
+atari800_ctx_t *libatari800_ctx_selected(void)
+{
+	return ctx_live;
+}
+
+
+/** Emulate the next frame of a context
+ *
+ * Selects \a ctx and runs one frame as \a libatari800_next_frame does.
+ *
+ * @param ctx context to run
+ * @param input user input for the frame
+ *
+ * @retval FALSE if the context's CPU crashed or its display list failed
+ * @retval TRUE otherwise
+ */
+int libatari800_ctx_next_frame(atari800_ctx_t *ctx, input_template_t *input)
+{
+	ctx_swap(ctx);
+	return libatari800_next_frame(input);
+}
+
+
+/** Advance several contexts and collect their observations
+ *
+ * Runs \a frames frames of each context in turn as \a libatari800_next_frames
+ * does, giving context i the input inputs[i] for all of them, and then
+ * renders its observation as \a libatari800_get_observation does into
+ * obs + i * width * height. Each context's features (see \a
+ * libatari800_set_features) are evaluated after its last frame. The
+ * observations form one contiguous n x height x width array. Contexts are
+ * stepped one after another: they share the emulator's globals, so they
+ * cannot run in parallel threads.
+ *
+ * @param ctxs array of n contexts
+ * @param inputs array of n inputs
+ * @param n number of contexts
+ * @param frames frames to run each context
+ * @param obs caller-owned buffer of n * width * height bytes, or NULL for
+ * no observations
+ * @param width observation width, 1 - 384
+ * @param height observation height, 1 - 240
+ * @param format LIBATARI800_OBS_GRAY or LIBATARI800_OBS_INDEX
+ *
+ * @returns number of contexts whose frames all ran without an error (see
+ * \a libatari800_error_message for the last error of a context)
+ */
+int libatari800_step_batch(atari800_ctx_t **ctxs, input_template_t *inputs, int n,
+		int frames, UBYTE *obs, int width, int height, int format)
+{
+	int i, ok = 0;
+
+	for (i = 0; i < n; i++) {
+		ctx_swap(ctxs[i]);
+		if (libatari800_next_frames(&inputs[i], frames, 0) == frames)
+			ok++;
+		if (obs != NULL)
+			AI_OBS_Render(obs + (size_t)i * width * height, width, height, format, 0, 0, 0, 0);
+	}
+	return ok;
+}
+
+
+/** Save the snapshots of several contexts
+ *
+ * Stores a snapshot of context i as \a libatari800_save_snapshot would into
+ * buffer + i * \a stride. A context that is not selected already holds one,
+ * which is copied without swapping it in.
+ *
+ * @param ctxs array of \a n contexts, NULL for the machine created by \a
+ * libatari800_init
+ * @param n number of contexts
+ * @param buffer buffer of \a n * \a stride bytes
+ * @param stride bytes for each snapshot
+ * @param sizes if not NULL, gets the size of each snapshot, 0 if it did not
+ * fit
+ *
+ * @returns number of snapshots that fitted
+ */
+int libatari800_save_many(atari800_ctx_t **ctxs, int n, UBYTE *buffer, int stride, int *sizes)
+{
+	int i, ok = 0;
+
+	for (i = 0; i < n; i++) {
+		UBYTE *dest = buffer + (size_t)i * stride;
+		int size;
+		if (ctxs[i] == ctx_live)
+			size = libatari800_save_snapshot(dest, stride);
+		else {
+			atari800_ctx_t *ctx = ctxs[i] != NULL ? ctxs[i] : ctx_initial;
+			size = (int)((const snapshot_header_t *)ctx->state)->size;
+			if (size <= stride)
+				memcpy(dest, ctx->state, size);
+			else
+				size = 0;
+		}
+		if (sizes != NULL)
+			sizes[i] = size;
+		if (size > 0)
+			ok++;
+	}
+	return ok;
+}
+
+
+/** Release a context
+ *
+ * If \a ctx is selected, the machine created by \a libatari800_init is
+ * selected instead.
+ *
+ * @param ctx context from \a libatari800_ctx_new
+ */
+void libatari800_ctx_free(atari800_ctx_t *ctx)
+{
+	if (ctx == NULL)
+		return;
+	if (ctx == ctx_live)
+		ctx_swap(NULL);
+	SIO_FreeDrives(ctx->drives);
+	free(ctx->state);
+	free(ctx->screen);
+	free(ctx);
+}
+
 /* Disk activity callback function pointer */
 void (*disk_activity_callback)(int drive, int operation) = NULL;
 
@@ -517,6 +1517,14 @@ void libatari800_unmount_disk(int drive_num)
 	SIO_Dismount(drive_num);
 }
 
+int libatari800_flush_disk(int drive_num)
+{
+	if (drive_num < 1 || drive_num > 8)
+		return FALSE;
+
+	return SIO_FlushDisk(drive_num);
+}
+
 void libatari800_disable_drive(int drive_num)
 {
 	if (drive_num < 1 || drive_num > 8)
@@ -1,5 +1,12 @@
+#include "config.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#ifdef HAVE_FORK
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#endif
 
 #include "libatari800.h"
 
@@ -17,11 +24,13 @@
 #define MACHINE_VIDEO_PAL 0x2000
 #define MACHINE_VIDEO_ALL (MACHINE_VIDEO_NTSC | MACHINE_VIDEO_PAL)
 
-typedef struct {
+typedef struct machine_config {
 	char *label;
 	int type;
 	int min_frames;
 	char *args[20];
+	struct machine_config *same_as;   /* boots to the same machine as this earlier one */
+	unsigned char *memory;            /* main memory once booted, while comparing */
 } machine_config_t;
 
 machine_config_t machine_config[] = {
@@ -171,21 +180,13 @@ int check_memo_pad(emulator_state_t *state) {
 
 #define BAD_DLIST_MIN_FRAMES 200
 
-int run_emulator(int num_args, int num_frames, int verbose) {
-	int i;
-
-	if (verbose > 1) {
-		for (i=0; i<num_args; i++) {
-			printf("%s ", test_args[i]);
-		}
-		printf("\n");
-	}
-	libatari800_init(num_args, test_args);
-	if (libatari800_error_code) return 0;
-
+/* Run the machine as it is for up to num_frames frames. Returns the number
+   of frames if no failure was seen, or minus the frame of the failure. */
+int run_frames(int num_frames) {
 	emulator_state_t state;
 	input_template_t input;
 
+	libatari800_clear_input_array(&input);
 	int frame = 0;
 	int selftest_count = 0;
 	while (frame < num_frames) {
@@ -224,6 +225,38 @@ exit:
 	return frame;
 }
 
+/* Put the arguments that set up a machine in test_args and return their
+   number. */
+int machine_args(machine_config_t *machine) {
+	/* args array is modified by atari800, so need to recreate it each time */
+	int num_args = 0;
+	char **machine_args;
+
+	while (num_args < (sizeof(default_args) / sizeof(default_args[0]))) {
+		test_args[num_args] = default_args[num_args];
+		num_args++;
+	}
+	machine_args = machine->args;
+	while (*machine_args) {
+		test_args[num_args++] = *machine_args++;
+	}
+	return num_args;
+}
+
+int run_emulator(int num_args, int num_frames, int verbose) {
+	int i;
+
+	if (verbose > 1) {
+		for (i=0; i<num_args; i++) {
+			printf("%s ", test_args[i]);
+		}
+		printf("\n");
+	}
+	libatari800_init(num_args, test_args);
+	if (libatari800_error_code) return 0;
+	return run_frames(num_frames);
+}
+
 cart_types_t *get_first_cart(machine_config_t *machine, int cart_kb) {
 	cart_types_t *cart_desc = NULL;
 
@@ -244,83 +277,6 @@ cart_types_t *get_first_cart(machine_config_t *machine, int cart_kb) {
 	return cart_desc;
 }
 
-/* Run the emulator using a given set of command line args. If it could be a
-   cartridge, run it multiple times trying the various cart types corresponding
-   to its size.
-*/
-int run_machine(machine_config_t *machine, char *pathname, int num_frames, int cart_kb, int verbose) {
-	int success;
-	int any_success = 0;
-	char **machine_args;
-	cart_types_t *cart_desc = get_first_cart(machine, cart_kb);
-	char cart_type_string[16];
-
-	if (cart_kb < 0 && !cart_desc) {
-		/* have an exact match for a cart type, but not compatible machine */
-		return 0;
-	}
-	num_frames = num_frames < machine->min_frames ? machine->min_frames : num_frames;
-	while (1) {
-		/* args array is modified by atari800, so need to recreate it each time */
-		int num_args = 0;
-		while (num_args < (sizeof(default_args) / sizeof(default_args[0]))) {
-			test_args[num_args] = default_args[num_args];
-			// printf("default arg %d: %s\n", num_args, default_args[num_args]);
-			num_args++;
-		}
-		machine_args = machine->args;
-		while (*machine_args) {
-			// printf("arg %d: %s\n", num_args, *machine_args);
-			test_args[num_args++] = *machine_args++;
-		}
-		if (cart_desc && ((cart_desc->size == cart_kb) || (cart_kb < 0))) {
-			test_args[num_args++] = "-cart-type";
-			sprintf(cart_type_string, "%d", cart_desc->type);
-			test_args[num_args++] = cart_type_string;
-			test_args[num_args++] = "-cart";
-		}
-		test_args[num_args++] = pathname;
-
-		success = run_emulator(num_args, num_frames, verbose);
-		if (success) any_success++;
-		if (!verbose) {
-			if (success > 0) {
-				printf("%s: %s (", pathname, machine->label);
-				machine_args = machine->args;
-				while (*machine_args) {
-					printf("%s", *machine_args);
-					machine_args++;
-					if (*machine_args) printf(" ");
-				}
-				if (cart_desc) {
-					printf(" -cart-type %d", cart_desc->type);
-				}
-				printf(")\n");
-			}
-		}
-		else {
-			printf("%s: %s", pathname, machine->label);
-			if (success > 0) printf(" status: OK through %d frames", success);
-			else {
-				printf(" status: FAIL");
-				if (libatari800_error_code) {
-					printf(" (%s)", libatari800_error_message());
-				}
-			}
-			if (cart_desc) {
-				printf(" (cart=%d '%s')", cart_desc->type, cart_desc->label);
-			}
-			printf("\n");
-		}
-		if (!cart_desc || (cart_kb < 0)) break;
-		if (cart_desc) {
-			cart_desc++;
-			if (cart_desc->size != cart_kb) cart_desc = NULL;
-		}
-	}
-	return any_success;
-}
-
 #define CHUNK_SIZE 1024
 #define INVALID_FILE_SIZE 999999
 
@@ -347,6 +303,7 @@ int guess_cart_kb(char *pathname, int verbose) {
 		}
 		total_len += current_len;
 	} while (current_len == CHUNK_SIZE);
+	fclose(fp);
 	if (total_len == 0) {
 		return INVALID_FILE_SIZE;
 	}
@@ -380,12 +337,377 @@ int guess_cart_kb(char *pathname, int verbose) {
 	return kb;
 }
 
-int main(int argc, char **argv) {
-	input_template_t input;
-	libatari800_clear_input_array(&input);
+/* An image to catalogue, with the machine, OS and video flags given before
+   it on the command line */
+typedef struct {
+	char *pathname;
+	int flags;
+	int cart_kb;
+	int remaining;   /* candidates not reported yet */
+	int successes;
+} image_t;
+
+/* A raw cartridge that is a known dump is tried only as its own type, and
+   only in the machine and video it is for if the choices given allow it */
+void identify_cart(image_t *image, int verbose) {
+	int type, machine, tv;
+	int flags = image->flags;
+
+	if (image->cart_kb <= 0 || image->cart_kb == INVALID_FILE_SIZE) return;
+	if (!libatari800_identify_cartridge(image->pathname, &type, &machine, &tv)) return;
+	if (verbose > 1) printf("%s: known cartridge; type %d\n", image->pathname, type);
+	image->cart_kb = -type;
+	if (machine == LIBATARI800_MACHINE_800) flags &= ~(MACHINE_TYPE_ALL & ~MACHINE_TYPE_800);
+	else if (machine == LIBATARI800_MACHINE_XLXE) flags &= ~(MACHINE_TYPE_800 | MACHINE_TYPE_5200);
+	else if (machine == LIBATARI800_MACHINE_5200) flags &= ~(MACHINE_TYPE_ALL & ~MACHINE_TYPE_5200);
+	if (tv == 312) flags &= ~MACHINE_VIDEO_NTSC;
+	else if (tv == 262) flags &= ~MACHINE_VIDEO_PAL;
+	if ((flags & MACHINE_TYPE_ALL) && (flags & MACHINE_VIDEO_ALL)) image->flags = flags;
+}
+
+/* One machine to try an image in, and the cart type if it is a cartridge */
+typedef struct {
+	image_t *image;
+	machine_config_t *machine;
+	cart_types_t *cart;   /* NULL to give the image as is */
+} candidate_t;
+
+typedef struct {
+	int candidate;
+	int frames;       /* as from run_frames() */
+	int error_code;   /* libatari800_error_code, -1 if the emulator died */
+} result_t;
+
+int machine_selected(machine_config_t *machine, int flags) {
+	return (machine->type & flags & MACHINE_TYPE_ALL) && (machine->type & flags & MACHINE_OS_ALL)
+		&& (machine->type & flags & MACHINE_VIDEO_ALL);
+}
+
+int boot_machine(machine_config_t *machine) {
+	int num_args = machine_args(machine);
+	return libatari800_init(num_args, test_args) && !libatari800_error_code;
+}
+
+void print_json_string(const char *s) {
+	putchar('"');
+	for (; *s; s++) {
+		unsigned char ch = (unsigned char)*s;
+		if (ch == '"' || ch == '\\') printf("\\%c", ch);
+		else if (ch < 0x20) printf("\\u%04x", ch);
+		else putchar(ch);
+	}
+	putchar('"');
+}
+
+/* The labels are padded to line up in the text output */
+void print_json_label(const char *label) {
+	char buf[64];
+	int len = (int)strlen(label);
+
+	if (len >= (int)sizeof(buf)) len = sizeof(buf) - 1;
+	while (len > 0 && label[len - 1] == ' ') len--;
+	memcpy(buf, label, len);
+	buf[len] = '\0';
+	print_json_string(buf);
+}
 
+/* Boot each machine that may be used and note those that come up with the
+   same memory as an earlier one of the same type and video: the ROMs asked
+   for were not found and the emulator fell back to the same ones, so they
+   would give the same results. */
+void find_same_machines(int flags, int verbose, int json) {
+	machine_config_t *machine, *earlier;
+
+	for (machine = machine_config; machine->label; machine++) {
+		if (!machine_selected(machine, flags) || !boot_machine(machine))
+			continue;
+		machine->memory = (unsigned char *)malloc(65536);
+		memcpy(machine->memory, libatari800_get_main_memory_ptr(), 65536);
+		for (earlier = machine_config; earlier < machine; earlier++) {
+			if (earlier->memory
+				&& (earlier->type & ~MACHINE_OS_ALL) == (machine->type & ~MACHINE_OS_ALL)
+				&& memcmp(earlier->memory, machine->memory, 65536) == 0) {
+				machine->same_as = earlier;
+				break;
+			}
+		}
+		if (!machine->same_as)
+			continue;
+		if (json) {
+			printf("{\"machine\": ");
+			print_json_label(machine->label);
+			printf(", \"same_as\": ");
+			print_json_label(earlier->label);
+			printf("}\n");
+		}
+		else if (verbose > 1)
+			printf("%s: same machine as %s\n", machine->label, earlier->label);
+	}
+	for (machine = machine_config; machine->label; machine++) {
+		free(machine->memory);
+		machine->memory = NULL;
+	}
+}
+
+/* Add the candidates for an image in machine order: the workers then boot
+   each machine once and try every image and cart type in it. */
+int add_candidates(image_t *image, machine_config_t *machine, candidate_t *candidates, int n, int verbose) {
+	cart_types_t *cart_desc = get_first_cart(machine, image->cart_kb);
+
+	if (!machine_selected(machine, image->flags)) {
+		if (verbose > 1) printf("%s: skipping %s\n", image->pathname, machine->label);
+		return n;
+	}
+	if (machine->same_as && machine_selected(machine->same_as, image->flags)) {
+		if (verbose > 1) printf("%s: skipping %s, same as %s\n", image->pathname, machine->label, machine->same_as->label);
+		return n;
+	}
+	if (image->cart_kb < 0 && !cart_desc) {
+		/* have an exact match for a cart type, but not compatible machine */
+		return n;
+	}
+	while (1) {
+		candidates[n].image = image;
+		candidates[n].machine = machine;
+		if (cart_desc && ((cart_desc->size == image->cart_kb) || (image->cart_kb < 0)))
+			candidates[n].cart = cart_desc;
+		else
+			candidates[n].cart = NULL;
+		n++;
+		image->remaining++;
+		if (!cart_desc || (image->cart_kb < 0)) break;
+		cart_desc++;
+		/* and last as is, as the emulator would take it */
+		if (cart_desc->size != image->cart_kb) cart_desc = NULL;
+	}
+	return n;
+}
+
+void report(candidate_t *candidate, result_t *result, int verbose, int json) {
+	image_t *image = candidate->image;
+	machine_config_t *machine = candidate->machine;
+	char **machine_args;
+	int success = result->frames;
+
+	libatari800_error_code = result->error_code;
+	if (json) {
+		printf("{\"file\": ");
+		print_json_string(image->pathname);
+		printf(", \"machine\": ");
+		print_json_label(machine->label);
+		printf(", \"args\": \"");
+		machine_args = machine->args;
+		while (*machine_args) {
+			printf("%s", *machine_args);
+			machine_args++;
+			if (*machine_args) printf(" ");
+		}
+		printf("\"");
+		if (candidate->cart) {
+			printf(", \"cart_type\": %d, \"cart\": ", candidate->cart->type);
+			print_json_string(candidate->cart->label);
+		}
+		if (success > 0) printf(", \"ok\": true, \"frames\": %d}\n", success);
+		else {
+			printf(", \"ok\": false, \"frames\": %d", -success);
+			if (result->error_code < 0) printf(", \"error\": \"emulator died\"");
+			else if (result->error_code) {
+				printf(", \"error\": ");
+				print_json_string(libatari800_error_message());
+			}
+			printf("}\n");
+		}
+	}
+	else if (!verbose) {
+		if (success > 0) {
+			printf("%s: %s (", image->pathname, machine->label);
+			machine_args = machine->args;
+			while (*machine_args) {
+				printf("%s", *machine_args);
+				machine_args++;
+				if (*machine_args) printf(" ");
+			}
+			if (candidate->cart) {
+				printf(" -cart-type %d", candidate->cart->type);
+			}
+			printf(")\n");
+		}
+	}
+	else {
+		printf("%s: %s", image->pathname, machine->label);
+		if (success > 0) printf(" status: OK through %d frames", success);
+		else {
+			printf(" status: FAIL");
+			if (result->error_code < 0) printf(" (emulator died)");
+			else if (result->error_code) {
+				printf(" (%s)", libatari800_error_message());
+			}
+		}
+		if (candidate->cart) {
+			printf(" (cart=%d '%s')", candidate->cart->type, candidate->cart->label);
+		}
+		printf("\n");
+	}
+
+	if (success > 0) image->successes++;
+	if (--image->remaining == 0 && !image->successes && !verbose && !json) printf("%s: FAIL\n", image->pathname);
+	fflush(stdout);
+}
+
+int candidate_frames(candidate_t *candidate, int num_frames) {
+	return num_frames < candidate->machine->min_frames ? candidate->machine->min_frames : num_frames;
+}
+
+#ifdef HAVE_FORK
+/* Try a candidate in the machine booted for it. As at libatari800_init,
+   the machine runs even if the image could not be loaded. */
+void run_booted(candidate_t *candidate, int num_frames, result_t *result) {
+	if (candidate->cart)
+		libatari800_reboot_with_cartridge(candidate->image->pathname, candidate->cart->type);
+	else
+		libatari800_reboot_with_file(candidate->image->pathname);
+	result->frames = libatari800_error_code ? 0 : run_frames(candidate_frames(candidate, num_frames));
+	result->error_code = libatari800_error_code;
+}
+
+/* Worker process: take candidates from todo, and try each in a process of
+   its own forked from the machine booted for it, which is kept for the
+   next candidates in the same machine. */
+void run_worker(candidate_t *candidates, int todo, int done, int num_frames) {
+	machine_config_t *booted = NULL;
+	int booted_ok = FALSE;
+	result_t result;
+	int c;
+
+	while (read(todo, &c, sizeof(c)) == sizeof(c)) {
+		candidate_t *candidate = &candidates[c];
+		int status;
+		pid_t player;
+
+		result.candidate = c;
+		if (candidate->machine != booted) {
+			booted = candidate->machine;
+			booted_ok = boot_machine(booted);
+		}
+		if (!booted_ok) {
+			result.frames = 0;
+			result.error_code = libatari800_error_code;
+			if (write(done, &result, sizeof(result)) != sizeof(result))
+				break;
+			continue;
+		}
+		player = fork();
+		if (player == 0) {
+			run_booted(candidate, num_frames, &result);
+			_exit(write(done, &result, sizeof(result)) == sizeof(result) ? 0 : 1);
+		}
+		if (player > 0 && waitpid(player, &status, 0) == player
+			&& WIFEXITED(status) && WEXITSTATUS(status) == 0)
+			continue;
+		/* No result from the player */
+		result.frames = 0;
+		result.error_code = -1;
+		if (write(done, &result, sizeof(result)) != sizeof(result))
+			break;
+	}
+	_exit(0);
+}
+
+/* Try the candidates on jobs worker processes, reporting each result as it
+   comes. Like movie_render, workers read the number of the next candidate
+   from one pipe and write their results to another, both in pieces smaller
+   than PIPE_BUF; a few candidates are handed out ahead, then one more for
+   each result. */
+int run_candidates(candidate_t *candidates, int n, int jobs, int num_frames, int verbose, int json) {
+	int todo[2], done[2];
+	FILE *results;
+	result_t result;
+	int received = 0;
+	int next = 0;
+	int w;
+
+	if (jobs > n) jobs = n;
+	if (pipe(todo) < 0 || pipe(done) < 0) {
+		printf("cannot start workers\n");
+		return FALSE;
+	}
+	fflush(stdout);
+	for (w = 0; w < jobs; w++) {
+		pid_t pid = fork();
+		if (pid < 0) {
+			printf("cannot start worker %d\n", w);
+			return FALSE;
+		}
+		if (pid == 0) {
+			close(todo[1]);
+			close(done[0]);
+			run_worker(candidates, todo[0], done[1], num_frames);
+		}
+	}
+	close(todo[0]);
+	close(done[1]);
+	while (next < n && next < 2 * jobs && write(todo[1], &next, sizeof(next)) == sizeof(next))
+		next++;
+	/* Workers stop when the pipe is empty and closed */
+	if (next == n)
+		close(todo[1]);
+	results = fdopen(done[0], "rb");
+	while (fread(&result, sizeof(result), 1, results) == 1) {
+		if (result.candidate < 0 || result.candidate >= n)
+			continue;
+		report(&candidates[result.candidate], &result, verbose, json);
+		received++;
+		if (next < n && write(todo[1], &next, sizeof(next)) == sizeof(next)
+			&& ++next == n)
+			close(todo[1]);
+	}
+	if (next < n)
+		close(todo[1]);
+	fclose(results);
+	while (wait(NULL) > 0)
+		;
+	/* A worker that died takes its candidate with it */
+	if (received < n) {
+		printf("%d candidates not tried\n", n - received);
+		return FALSE;
+	}
+	return TRUE;
+}
+#else
+/* Without fork, each candidate sets up the emulator from scratch */
+int run_candidates(candidate_t *candidates, int n, int jobs, int num_frames, int verbose, int json) {
+	char cart_type_string[16];
+	result_t result;
+	int c;
+
+	for (c = 0; c < n; c++) {
+		candidate_t *candidate = &candidates[c];
+		int num_args = machine_args(candidate->machine);
+		if (candidate->cart) {
+			test_args[num_args++] = "-cart-type";
+			sprintf(cart_type_string, "%d", candidate->cart->type);
+			test_args[num_args++] = cart_type_string;
+			test_args[num_args++] = "-cart";
+		}
+		test_args[num_args++] = candidate->image->pathname;
+		result.candidate = c;
+		result.frames = run_emulator(num_args, candidate_frames(candidate, num_frames), verbose);
+		result.error_code = libatari800_error_code;
+		report(candidate, &result, verbose, json);
+	}
+	return TRUE;
+}
+#endif /* HAVE_FORK */
+
+/* Images are catalogued this many at a time, so that each is done before
+   the end and the candidates of a batch fit in memory */
+#define IMAGE_BATCH 64
+
+int main(int argc, char **argv) {
 	/* one time init stuff */
 	int verbose = 1;
+	int json = FALSE;
+	int jobs = 0;
 	int machine_flag = MACHINE_TYPE_ALL;
 	int machine_flag_encountered = FALSE;
 	int os_flag = MACHINE_OS_ALL;
@@ -393,7 +715,16 @@ int main(int argc, char **argv) {
 	int video_flag = MACHINE_VIDEO_ALL;
 	int video_flag_encountered = FALSE;
 	int num_frames = 1000;
+	int all_flags = 0;
+	image_t *images;
+	int num_images = 0;
+	candidate_t *candidates;
+	int max_candidates;
+	int first, last;
+	cart_types_t *cart_desc;
+	int max_carts = 1;
 
+	images = (image_t *)malloc(sizeof(image_t) * (argc > 1 ? argc : 1));
 	int i;
 	for (i=1; i<argc; i++) {
 		if (argv[i][0] == '-') {
@@ -409,6 +740,12 @@ int main(int argc, char **argv) {
 			else if (strcmp(argv[i], "-s") == 0) {
 				verbose = 0;
 			}
+			else if (strcmp(argv[i], "-json") == 0) {
+				json = TRUE;
+			}
+			else if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+				jobs = atoi(argv[++i]);
+			}
 			else if (strcmp(argv[i], "-800") == 0) {
 				if (!machine_flag_encountered) machine_flag = 0;
 				machine_flag |= MACHINE_TYPE_800;
@@ -454,24 +791,60 @@ int main(int argc, char **argv) {
 			}
 		}
 		else {
-			int successful_count = 0;
-			machine_config_t *machine = machine_config;
-			int cart_kb = guess_cart_kb(argv[i], verbose);
-			if (cart_kb == INVALID_FILE_SIZE) continue;
-			while (machine->label) {
-				if (machine->type & machine_flag && machine->type & os_flag && machine->type & video_flag) {
-					if (verbose > 1) {
-						printf("trying %s\n", machine->label);
-					}
-					if (run_machine(machine, argv[i], num_frames, cart_kb, verbose)) successful_count++;
-				}
-				else if (verbose > 1) {
-					printf("skipping %s\n", machine->label);
-				}
-				machine++;
+			images[num_images].pathname = argv[i];
+			images[num_images].flags = machine_flag | os_flag | video_flag;
+			images[num_images].remaining = 0;
+			images[num_images].successes = 0;
+			all_flags |= images[num_images].flags;
+			num_images++;
+		}
+	}
+	if (num_images == 0) return 0;
+
+#if defined(HAVE_FORK) && defined(HAVE_SYSCONF) && defined(_SC_NPROCESSORS_ONLN)
+	if (jobs <= 0)
+		jobs = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+	if (jobs <= 0)
+		jobs = 1;
+
+	find_same_machines(all_flags, verbose, json);
+
+	/* Room for every cart type of the most common size in each machine */
+	for (cart_desc = cart_list_a8; cart_desc->size; cart_desc++) {
+		int n = 0;
+		cart_types_t *same = cart_desc;
+		while (same->size == cart_desc->size) {
+			n++;
+			same++;
+		}
+		if (n > max_carts) max_carts = n;
+	}
+	max_candidates = IMAGE_BATCH * (sizeof(machine_config) / sizeof(machine_config[0])) * max_carts;
+	candidates = (candidate_t *)malloc(sizeof(candidate_t) * max_candidates);
+
+	for (first = 0; first < num_images; first = last) {
+		int n = 0;
+		machine_config_t *machine;
+		last = first + IMAGE_BATCH < num_images ? first + IMAGE_BATCH : num_images;
+		for (i = first; i < last; i++) {
+			images[i].cart_kb = guess_cart_kb(images[i].pathname, verbose);
+			identify_cart(&images[i], verbose);
+		}
+		for (machine = machine_config; machine->label; machine++) {
+			for (i = first; i < last; i++) {
+				if (images[i].cart_kb == INVALID_FILE_SIZE) continue;
+				n = add_candidates(&images[i], machine, candidates, n, verbose);
 			}
-			if (!successful_count && !verbose) printf("%s: FAIL\n", argv[i]);
 		}
+		for (i = first; i < last; i++) {
+			if (images[i].cart_kb != INVALID_FILE_SIZE && images[i].remaining == 0 && !verbose && !json)
+				printf("%s: FAIL\n", images[i].pathname);
+		}
+		if (n > 0)
+			run_candidates(candidates, n, jobs, num_frames, verbose, json);
 	}
+	free(candidates);
+	free(images);
 	return 0;
 }
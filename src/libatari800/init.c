@@ -36,13 +36,17 @@
 int LIBATARI800_Initialise(void)
 {
 	libatari800_continue_on_brk = FALSE;
+	libatari800_stop_on_brk = FALSE;
 	return TRUE;
 }
 
 int LIBATARI800_ReadConfig(char *option, char *parameters)
 {
-	if (strcmp(option, "LIBATARI800_CONTINUE_ON_BRK") == 0)
-		return (libatari800_continue_on_brk = Util_sscanbool(parameters)) != -1;
+	if (strcmp(option, "LIBATARI800_CONTINUE_ON_BRK") == 0) {
+		libatari800_continue_on_brk = Util_sscanbool(parameters);
+		libatari800_stop_on_brk = libatari800_continue_on_brk == FALSE;
+		return libatari800_continue_on_brk != -1;
+	}
 	else
 		return FALSE;
 	return TRUE;
@@ -0,0 +1,620 @@
+/*
+ * libatari800/input_fuzz.c - coverage-guided fuzzing of joystick and keyboard input
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+/* Runs sequences of input from one starting state and keeps those that
+   make the 6502 run code that no run before did, as a corpus that new
+   sequences are mutated from: the aim is to reach the game states and
+   crashes that agents and scripts do not. The starting state is the
+   machine as the emulator options and -boot frames of no input leave it;
+   each run restores a snapshot of it (libatari800_save_snapshot), so a
+   run costs little more than its frames, and the CPU marks the PCs it
+   runs through libatari800_set_coverage.
+
+   Workers, one process per core as in movie_verify, share the coverage
+   of all runs, a bitmap each ORs its own into atomically, and the corpus,
+   to which a worker appends an input that set new bits; both live in
+   memory mapped before the workers are forked. Every input kept is also
+   written to the -corpus directory as a movie (see movie.c) from the
+   starting state, and every run that ended in an error (a CIM or an
+   empty display list; with -brk, a BRK) that was the first of its
+   kind or ran new code, to -crashes, where movie_render can show what
+   happened. -seeds takes movies whose input starts the corpus.
+
+   An input is two bytes per frame: joystick 0, its stick in bits 0-3 as
+   input_template_t.joy0 and its trigger in bit 4, with -consol START,
+   SELECT and OPTION in bits 5-7; and with -keys a key, an index in
+   fuzz_keys. Mutations set a run of frames to one stick position, press
+   or release the trigger over a run, copy a run from another input, move
+   part of the input later or earlier, or change single frames, a few at
+   a time. */
+
+#include "config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#ifdef HAVE_OPENDIR
+#include <dirent.h>
+#endif
+#ifdef HAVE_SYS_STAT_H
+#include <sys/stat.h>
+#endif
+#ifdef HAVE_FORK
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#endif
+#if defined(HAVE_MMAP) && defined(HAVE_FORK) && defined(__GNUC__)
+#include <sys/mman.h>
+#define SHARED_WORKERS
+#endif
+
+#include "libatari800.h"
+#include "util.h"
+
+#define DEFAULT_FRAMES  300
+#define MAX_FRAMES      3600
+#define DEFAULT_SECONDS 60
+#define MAX_CORPUS      8192
+#define MAX_ERROR       16      /* libatari800_error_code values counted */
+
+#define JOY_STICK   0x0f
+#define JOY_TRIG    0x10
+#define JOY_START   0x20
+#define JOY_SELECT  0x40
+#define JOY_OPTION  0x80
+
+/* Workers update the shared counters and bitmap atomically; without
+   atomics or fork there is one worker */
+#ifdef SHARED_WORKERS
+#define ATOMIC_ADD(p, n)   __atomic_fetch_add(p, n, __ATOMIC_RELAXED)
+#define ATOMIC_OR(p, n)    __atomic_fetch_or(p, n, __ATOMIC_RELAXED)
+#define ATOMIC_LOAD(p)     __atomic_load_n(p, __ATOMIC_ACQUIRE)
+#define ATOMIC_STORE(p, v) __atomic_store_n(p, v, __ATOMIC_RELEASE)
+#else
+static long atomic_add(long *p, long n) { long old = *p; *p += n; return old; }
+static uint64_t atomic_or(uint64_t *p, uint64_t n) { uint64_t old = *p; *p |= n; return old; }
+#define ATOMIC_ADD(p, n)   atomic_add(p, n)
+#define ATOMIC_OR(p, n)    atomic_or(p, n)
+#define ATOMIC_LOAD(p)     (*(p))
+#define ATOMIC_STORE(p, v) (*(p) = (v))
+#endif
+
+typedef struct {
+	uint64_t coverage[65536 / 64];  /* PC n is bit n % 64 of word n / 64 */
+	long runs;
+	long errors[MAX_ERROR];         /* runs ended by each error code */
+	long corpus_count;              /* slots taken, may pass MAX_CORPUS */
+	long corpus_ready[MAX_CORPUS];  /* the slot's input is written */
+} shared_t;
+
+/* Keys -keys presses: characters, and a key code for RETURN */
+static const struct {
+	UBYTE keychar;
+	UBYTE keycode;
+} fuzz_keys[] = {
+	{0, 0}, {' ', 0}, {0, AKEY_RETURN}, {0, AKEY_ESCAPE},
+	{'0', 0}, {'1', 0}, {'2', 0}, {'3', 0}, {'4', 0}, {'5', 0}, {'6', 0}, {'7', 0}, {'8', 0}, {'9', 0},
+	{'A', 0}, {'B', 0}, {'C', 0}, {'D', 0}, {'E', 0}, {'F', 0}, {'G', 0}, {'H', 0}, {'I', 0},
+	{'J', 0}, {'K', 0}, {'L', 0}, {'M', 0}, {'N', 0}, {'O', 0}, {'P', 0}, {'Q', 0}, {'R', 0},
+	{'S', 0}, {'T', 0}, {'U', 0}, {'V', 0}, {'W', 0}, {'X', 0}, {'Y', 0}, {'Z', 0}
+};
+#define NUM_KEYS ((int)(sizeof(fuzz_keys) / sizeof(fuzz_keys[0])))
+
+/* Stick positions, as bits of the directions pressed */
+static const UBYTE sticks[] = {0, 1, 2, 4, 8, 5, 9, 6, 10};
+
+static int frames = DEFAULT_FRAMES;
+static int use_keys = FALSE;
+static int use_consol = FALSE;
+static const char *corpus_dir = NULL;
+static const char *crash_dir = NULL;
+
+static UBYTE *start_state;
+static shared_t *shared;
+static UBYTE *corpus;               /* MAX_CORPUS inputs of input_size */
+static int input_size;
+static UBYTE coverage[65536];       /* this worker's run */
+static UBYTE *other_input;          /* for mutations that take from another */
+static ULONG rng_state;
+
+#define CORPUS_INPUT(slot) (corpus + (size_t)(slot) * input_size)
+
+static void usage(void)
+{
+	printf("usage: input_fuzz [-j jobs] [-frames n] [-boot frames] [-time seconds] [-runs n]\n"
+	       "                  [-seed n] [-corpus dir] [-crashes dir] [-seeds dir|movie]... [-keys] [-consol] [-brk]\n"
+	       "                  [-- emulator options]\n");
+}
+
+static ULONG rng(void)
+{
+	/* xorshift32 */
+	rng_state ^= rng_state << 13;
+	rng_state ^= rng_state >> 17;
+	rng_state ^= rng_state << 5;
+	return rng_state;
+}
+
+static int rng_below(int n)
+{
+	return n > 0 ? (int)(rng() % (ULONG)n) : 0;
+}
+
+static int count_bits(uint64_t bits)
+{
+#ifdef __GNUC__
+	return __builtin_popcountll(bits);
+#else
+	int n = 0;
+	for (; bits != 0; bits &= bits - 1)
+		n++;
+	return n;
+#endif
+}
+
+static int covered(void)
+{
+	int w, n = 0;
+	for (w = 0; w < 65536 / 64; w++)
+		n += count_bits(ATOMIC_LOAD(&shared->coverage[w]));
+	return n;
+}
+
+static void set_input(input_template_t *in, const UBYTE *input, int frame)
+{
+	UBYTE joy = input[2 * frame];
+	UBYTE key = input[2 * frame + 1];
+
+	libatari800_clear_input_array(in);
+	in->joy0 = joy & JOY_STICK;
+	in->trig0 = (joy & JOY_TRIG) != 0;
+	in->start = (joy & JOY_START) != 0;
+	in->select = (joy & JOY_SELECT) != 0;
+	in->option = (joy & JOY_OPTION) != 0;
+	if (key < NUM_KEYS) {
+		in->keychar = fuzz_keys[key].keychar;
+		in->keycode = fuzz_keys[key].keycode;
+	}
+}
+
+/* ORs this run's PCs into the shared coverage and returns how many no
+   run had before */
+static int merge_coverage(void)
+{
+	int w, b, fresh = 0;
+
+	for (w = 0; w < 65536 / 64; w++) {
+		const UBYTE *pcs = coverage + 64 * w;
+		uint64_t bits = 0;
+		for (b = 0; b < 64; b++)
+			bits |= (uint64_t)pcs[b] << b;
+		if (bits != 0)
+			fresh += count_bits(bits & ~ATOMIC_OR(&shared->coverage[w], bits));
+	}
+	return fresh;
+}
+
+/* Runs input from the starting state; returns the new PCs it ran and
+   stores the error that ended it early, or 0 */
+static int run_input(const UBYTE *input, int *error)
+{
+	input_template_t in;
+	int f;
+
+	libatari800_restore_snapshot(start_state);
+	memset(coverage, 0, sizeof(coverage));
+	*error = 0;
+	for (f = 0; f < frames; f++) {
+		set_input(&in, input, f);
+		if (!libatari800_next_frame(&in)) {
+			*error = libatari800_error_code;
+			break;
+		}
+	}
+	ATOMIC_ADD(&shared->runs, 1);
+	return merge_coverage();
+}
+
+/* Runs input again from the starting state, recording it as a movie */
+static void write_movie(const char *dir, const char *name, const UBYTE *input)
+{
+	char path[FILENAME_MAX];
+	libatari800_movie_t *movie;
+	input_template_t in;
+	int f;
+
+	Util_catpath(path, dir, name);
+	libatari800_restore_snapshot(start_state);
+	movie = libatari800_movie_record(path);
+	if (movie == NULL) {
+		printf("cannot write %s\n", path);
+		return;
+	}
+	for (f = 0; f < frames; f++) {
+		set_input(&in, input, f);
+		libatari800_movie_add_frame(movie, &in);
+		if (!libatari800_next_frame(&in))
+			break;
+	}
+	if (!libatari800_movie_close(movie))
+		printf("cannot write %s\n", path);
+}
+
+/* Adds input to the shared corpus, and its movie to corpus_dir; returns
+   its slot, or -1 if the corpus is full */
+static long add_to_corpus(const UBYTE *input)
+{
+	long slot = ATOMIC_ADD(&shared->corpus_count, 1);
+	char name[32];
+
+	if (corpus_dir != NULL) {
+		snprintf(name, sizeof(name), "input-%05ld.a8mv", slot);
+		write_movie(corpus_dir, name, input);
+	}
+	if (slot >= MAX_CORPUS)
+		return -1;
+	memcpy(CORPUS_INPUT(slot), input, input_size);
+	ATOMIC_STORE(&shared->corpus_ready[slot], 1);
+	return slot;
+}
+
+static void keep_error(const UBYTE *input, int error, int fresh)
+{
+	long n;
+	char name[48];
+
+	if (error < 0 || error >= MAX_ERROR)
+		error = 0;
+	n = ATOMIC_ADD(&shared->errors[error], 1);
+	if (n == 0) {
+		printf("new error %d: %s\n", error, libatari800_error_message());
+		fflush(stdout);
+	}
+	if (crash_dir != NULL && (n == 0 || fresh > 0)) {
+		snprintf(name, sizeof(name), "error%d-%05ld.a8mv", error, n);
+		write_movie(crash_dir, name, input);
+	}
+}
+
+/* Copies a random input of the corpus to input; FALSE if there is none */
+static int pick_input(UBYTE *input)
+{
+	long count = ATOMIC_LOAD(&shared->corpus_count);
+	int tries;
+
+	if (count > MAX_CORPUS)
+		count = MAX_CORPUS;
+	for (tries = 0; tries < 8 && count > 0; tries++) {
+		long slot = rng_below((int)count);
+		if (ATOMIC_LOAD(&shared->corpus_ready[slot])) {
+			memcpy(input, CORPUS_INPUT(slot), input_size);
+			return TRUE;
+		}
+	}
+	return FALSE;
+}
+
+/* A run of frames [*start, *start + length), longer ones rarer */
+static int pick_run(int *start)
+{
+	int length = 1 + rng_below(1 << rng_below(8));
+	if (length > frames)
+		length = frames;
+	*start = rng_below(frames - length + 1);
+	return length;
+}
+
+static void mutate(UBYTE *input)
+{
+	int ops = 1 + rng_below(4);
+	int kinds = 5 + use_consol + use_keys;
+
+	while (ops-- > 0) {
+		int start, length = pick_run(&start);
+		int f, kind = rng_below(kinds);
+		UBYTE stick, joy;
+		switch (kind) {
+		case 0:	/* hold a stick position */
+			stick = sticks[rng_below(sizeof(sticks))];
+			for (f = start; f < start + length; f++)
+				input[2 * f] = (input[2 * f] & ~JOY_STICK) | stick;
+			break;
+		case 1:	/* press or release the trigger */
+			joy = rng() & 1 ? JOY_TRIG : 0;
+			for (f = start; f < start + length; f++)
+				input[2 * f] = (input[2 * f] & ~JOY_TRIG) | joy;
+			break;
+		case 2:	/* the same frames of another input */
+			if (pick_input(other_input))
+				memcpy(input + 2 * start, other_input + 2 * start, 2 * length);
+			break;
+		case 3: {	/* move the rest later or earlier */
+			int shift = 1 + rng_below(length);
+			int rest = frames - start - shift;
+			if (rng() & 1) {
+				memmove(input + 2 * (start + shift), input + 2 * start, 2 * rest);
+				memset(input + 2 * start, 0, 2 * shift);
+			}
+			else {
+				memmove(input + 2 * start, input + 2 * (start + shift), 2 * rest);
+				memset(input + 2 * (start + rest), 0, 2 * shift);
+			}
+			break;
+		}
+		case 4:	/* single frames */
+			for (f = 0; f < 1 + rng_below(8); f++) {
+				int at = rng_below(frames);
+				input[2 * at] = (input[2 * at] & ~(JOY_STICK | JOY_TRIG))
+					| sticks[rng_below(sizeof(sticks))] | (rng() & 1 ? JOY_TRIG : 0);
+			}
+			break;
+		default:
+			if (kind == 5 && use_consol) {	/* tap a console key */
+				joy = JOY_START << rng_below(3);
+				for (f = start; f < start + length && f < start + 8; f++)
+					input[2 * f] |= joy;
+				for (; f < start + length; f++)
+					input[2 * f] &= ~(JOY_START | JOY_SELECT | JOY_OPTION);
+			}
+			else {	/* type a key */
+				UBYTE key = (UBYTE)rng_below(NUM_KEYS);
+				for (f = start; f < start + length && f < start + 4; f++)
+					input[2 * f + 1] = key;
+				if (f < frames)
+					input[2 * f + 1] = 0;
+			}
+			break;
+		}
+	}
+}
+
+static void fuzz(int worker, unsigned long seed, double until, long max_runs)
+{
+	UBYTE *input = (UBYTE *)Util_malloc(input_size);
+
+	other_input = (UBYTE *)Util_malloc(input_size);
+	rng_state = (ULONG)(seed * 2654435761UL + worker * 40503UL + 1);
+	if (rng_state == 0)
+		rng_state = 1;
+	while (Util_time() < until && (max_runs <= 0 || ATOMIC_LOAD(&shared->runs) < max_runs)) {
+		int fresh, error;
+		if (!pick_input(input))
+			memset(input, 0, input_size);
+		mutate(input);
+		fresh = run_input(input, &error);
+		if (fresh > 0)
+			add_to_corpus(input);
+		if (error != 0)
+			keep_error(input, error, fresh);
+	}
+	free(input);
+	free(other_input);
+}
+
+/* Adds the movie's input to the corpus if it runs new code */
+static void add_seed(const char *path)
+{
+	libatari800_movie_t *movie = libatari800_movie_open(path);
+	UBYTE *input;
+	input_template_t in;
+	int f, fresh, error;
+
+	if (movie == NULL) {
+		printf("%s: not a movie\n", path);
+		return;
+	}
+	input = (UBYTE *)Util_malloc(input_size);
+	memset(input, 0, input_size);
+	for (f = 0; f < frames && libatari800_movie_next_input(movie, &in); f++) {
+		int k;
+		input[2 * f] = (in.joy0 & JOY_STICK) | (in.trig0 ? JOY_TRIG : 0);
+		if (use_consol)
+			input[2 * f] |= (in.start ? JOY_START : 0) | (in.select ? JOY_SELECT : 0) | (in.option ? JOY_OPTION : 0);
+		for (k = 1; use_keys && k < NUM_KEYS; k++)
+			if (in.keychar != 0 ? in.keychar == fuzz_keys[k].keychar : in.keycode != 0 && in.keycode == fuzz_keys[k].keycode)
+				input[2 * f + 1] = (UBYTE)k;
+	}
+	libatari800_movie_close(movie);
+	fresh = run_input(input, &error);
+	printf("%s: %d new PCs\n", path, fresh);
+	if (fresh > 0)
+		add_to_corpus(input);
+	if (error != 0)
+		keep_error(input, error, fresh);
+	free(input);
+}
+
+/* The movies in DIR, or DIR itself if it is a file */
+static void add_seeds(const char *path)
+{
+#if defined(HAVE_OPENDIR) && defined(HAVE_STAT)
+	struct stat st;
+	if (stat(path, &st) == 0 && S_ISDIR(st.st_mode)) {
+		DIR *dir = opendir(path);
+		struct dirent *entry;
+		if (dir == NULL) {
+			printf("cannot read %s\n", path);
+			return;
+		}
+		while ((entry = readdir(dir)) != NULL) {
+			char name[FILENAME_MAX];
+			Util_catpath(name, path, entry->d_name);
+			if (stat(name, &st) == 0 && S_ISREG(st.st_mode))
+				add_seed(name);
+		}
+		closedir(dir);
+		return;
+	}
+#endif
+	add_seed(path);
+}
+
+static void report(double start)
+{
+	long runs = ATOMIC_LOAD(&shared->runs);
+	long inputs = ATOMIC_LOAD(&shared->corpus_count);
+	long errors = 0;
+	int i;
+	double seconds = Util_time() - start;
+
+	for (i = 0; i < MAX_ERROR; i++)
+		errors += ATOMIC_LOAD(&shared->errors[i]);
+	printf("%.0f s: %ld runs (%.0f/s), %ld inputs, %d PCs, %ld errors\n", seconds, runs,
+		seconds > 0 ? runs / seconds : 0.0, inputs, covered(), errors);
+	fflush(stdout);
+}
+
+int main(int argc, char **argv)
+{
+	const char *seeds[64];
+	int num_seeds = 0;
+	int jobs = 0;
+	int boot = 0;
+	int brk = FALSE;
+	double seconds = DEFAULT_SECONDS;
+	long max_runs = 0;
+	unsigned long seed = 1;
+	int i, end, size, error;
+	size_t shared_size;
+	double start, until;
+	UBYTE *input;
+
+	for (i = 1; i < argc && strcmp(argv[i], "--") != 0; i++) {
+		if (strcmp(argv[i], "-j") == 0 && i + 1 < argc)
+			jobs = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-frames") == 0 && i + 1 < argc)
+			frames = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-boot") == 0 && i + 1 < argc)
+			boot = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-time") == 0 && i + 1 < argc)
+			seconds = atof(argv[++i]);
+		else if (strcmp(argv[i], "-runs") == 0 && i + 1 < argc)
+			max_runs = atol(argv[++i]);
+		else if (strcmp(argv[i], "-seed") == 0 && i + 1 < argc)
+			seed = strtoul(argv[++i], NULL, 0);
+		else if (strcmp(argv[i], "-corpus") == 0 && i + 1 < argc)
+			corpus_dir = argv[++i];
+		else if (strcmp(argv[i], "-crashes") == 0 && i + 1 < argc)
+			crash_dir = argv[++i];
+		else if (strcmp(argv[i], "-seeds") == 0 && i + 1 < argc && num_seeds < 64)
+			seeds[num_seeds++] = argv[++i];
+		else if (strcmp(argv[i], "-keys") == 0)
+			use_keys = TRUE;
+		else if (strcmp(argv[i], "-consol") == 0)
+			use_consol = TRUE;
+		else if (strcmp(argv[i], "-brk") == 0)
+			brk = TRUE;
+		else {
+			usage();
+			return 2;
+		}
+	}
+	if (frames < 1 || frames > MAX_FRAMES) {
+		printf("-frames must be 1-%d\n", MAX_FRAMES);
+		return 2;
+	}
+	end = i < argc ? i + 1 : i;
+	/* libatari800_init() puts its own program name in front */
+	if (!libatari800_init(argc - end, argv + end)) {
+		printf("bad emulator options\n");
+		return 2;
+	}
+	/* Nothing looks at the screen */
+	libatari800_set_render_policy(LIBATARI800_RENDER_OBSERVED, 0);
+	libatari800_continue_emulation_on_brk(!brk);
+	for (i = 0; i < boot; i++) {
+		input_template_t in;
+		libatari800_clear_input_array(&in);
+		/* The OS sets up its display list a few frames in */
+		if (!libatari800_next_frame(&in) && libatari800_error_code != LIBATARI800_DLIST_ERROR) {
+			printf("the emulator stopped while booting: %s\n", libatari800_error_message());
+			return 2;
+		}
+	}
+	size = libatari800_save_snapshot(NULL, 0);
+	start_state = (UBYTE *)Util_malloc(size);
+	libatari800_save_snapshot(start_state, size);
+
+	input_size = 2 * frames;
+	shared_size = sizeof(shared_t) + (size_t)MAX_CORPUS * input_size;
+#ifdef SHARED_WORKERS
+	shared = (shared_t *)mmap(NULL, shared_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (shared == (shared_t *)MAP_FAILED) {
+		printf("cannot map %lu bytes of shared memory\n", (unsigned long)shared_size);
+		return 2;
+	}
+#else
+	shared = (shared_t *)Util_malloc(shared_size);
+	memset(shared, 0, shared_size);
+	jobs = 1;
+#endif
+	corpus = (UBYTE *)(shared + 1);
+	libatari800_set_coverage(coverage);
+
+	/* What no input does, then the seeds */
+	input = (UBYTE *)Util_malloc(input_size);
+	memset(input, 0, input_size);
+	if (run_input(input, &error) > 0)
+		add_to_corpus(input);
+	if (error != 0)
+		keep_error(input, error, 1);
+	free(input);
+	for (i = 0; i < num_seeds; i++)
+		add_seeds(seeds[i]);
+
+#if defined(HAVE_SYSCONF) && defined(_SC_NPROCESSORS_ONLN)
+	if (jobs <= 0)
+		jobs = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+	if (jobs <= 0)
+		jobs = 1;
+	printf("%d frames per run, %d jobs, %d PCs from %ld inputs to start with\n", frames, jobs, covered(),
+		ATOMIC_LOAD(&shared->corpus_count));
+	fflush(stdout);
+	start = Util_time();
+	until = start + seconds;
+
+#ifdef SHARED_WORKERS
+	{
+		int w, running = 0;
+		for (w = 0; w < jobs; w++) {
+			pid_t pid = fork();
+			if (pid < 0) {
+				printf("cannot start worker %d\n", w);
+				break;
+			}
+			if (pid == 0) {
+				fuzz(w, seed, until, max_runs);
+				fflush(stdout);
+				_exit(0);
+			}
+			running++;
+		}
+		while (running > 0) {
+			double next = Util_time() + 5.0;
+			while (running > 0 && Util_time() < next) {
+				if (waitpid(-1, NULL, WNOHANG) > 0)
+					running--;
+				else
+					Util_sleep(0.1);
+			}
+			report(start);
+		}
+	}
+#else
+	fuzz(0, seed, until, max_runs);
+	report(start);
+#endif
+
+	for (i = 0; i < MAX_ERROR; i++)
+		if (shared->errors[i] > 0)
+			printf("error %d: %ld runs\n", i, shared->errors[i]);
+	libatari800_set_coverage(NULL);
+	libatari800_exit();
+	return 0;
+}
@@ -1,6 +1,9 @@
 #ifndef LIBATARI800_H_
 #define LIBATARI800_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
 #ifndef UBYTE
 #define UBYTE unsigned char
 #endif
@@ -142,6 +145,8 @@ typedef struct {
     UBYTE _align1[3];
     ULONG nframes;
     ULONG sample_residual;
+    ULONG random_counter;
+    UBYTE input_state[12];
 } statesav_flags_t;
 
 typedef struct {
@@ -257,6 +262,48 @@ typedef struct {
     int Base_mult[4];
 } pokey_state_t;
 
+/* Observation formats for libatari800_get_observation */
+#define LIBATARI800_OBS_GRAY 0
+#define LIBATARI800_OBS_INDEX 1
+
+/* Render policies for libatari800_set_render_policy */
+#define LIBATARI800_RENDER_ALWAYS 0
+#define LIBATARI800_RENDER_OBSERVED 1
+#define LIBATARI800_RENDER_EVERY 2
+
+/* Machines for libatari800_identify_cartridge, as Atari800_MACHINE_* */
+#define LIBATARI800_MACHINE_800 0
+#define LIBATARI800_MACHINE_XLXE 1
+#define LIBATARI800_MACHINE_5200 2
+
+/* Kinds of feature for libatari800_set_features */
+#define LIBATARI800_FEATURE_BYTE 0    /* the byte at addr, and mask */
+#define LIBATARI800_FEATURE_SBYTE 1   /* the byte at addr, and mask, signed */
+#define LIBATARI800_FEATURE_WORD 2    /* the word at addr, low byte first */
+#define LIBATARI800_FEATURE_WORD_BE 3 /* the word at addr, high byte first */
+#define LIBATARI800_FEATURE_BCD 4     /* len bytes of BCD, most significant first */
+#define LIBATARI800_FEATURE_BCD_LE 5  /* len bytes of BCD, least significant first */
+#define LIBATARI800_FEATURE_BIT 6     /* 1 if the byte at addr and mask is not 0 */
+#define LIBATARI800_MAX_FEATURES 64
+
+typedef struct {
+    int kind;
+    int addr;
+    int len;      /* bytes of a BCD number, 1 - 4 */
+    int mask;     /* for BYTE, SBYTE and BIT */
+    int delta;    /* if set, the change since the previous frame or step */
+    float scale;  /* the value is multiplied by it */
+} feature_template_t;
+
+/* Sample formats for libatari800_set_sound_format, equal to their sizes */
+#define LIBATARI800_SOUND_U8 1     /* unsigned 8-bit */
+#define LIBATARI800_SOUND_S16 2    /* signed 16-bit, host byte order */
+#define LIBATARI800_SOUND_FLOAT 4  /* float32, -1.0 to 1.0 */
+
+/* Flags for libatari800_next_frames */
+#define LIBATARI800_FRAMES_MAXPOOL 1
+#define LIBATARI800_FRAMES_SOUND 2
+
 extern int libatari800_error_code;
 #define LIBATARI800_UNIDENTIFIED_CART_TYPE 1
 #define LIBATARI800_CPU_CRASH 2
@@ -274,16 +321,49 @@ void libatari800_continue_emulation_on_brk(int cont);
 
 void libatari800_clear_input_array(input_template_t *input);
 
+void libatari800_set_pots(const int *pots);
+
 int libatari800_next_frame(input_template_t *input);
 
+int libatari800_next_frames(input_template_t *input, int frames, int flags);
+
 int libatari800_mount_disk_image(int diskno, const char *filename, int readonly);
 
 int libatari800_reboot_with_file(const char *filename);
 
+int libatari800_reboot_with_cartridge(const char *filename, int type);
+
+int libatari800_identify_cartridge(const char *filename, int *type, int *machine, int *tv);
+
 UBYTE *libatari800_get_main_memory_ptr();
 
+int libatari800_set_features(const feature_template_t *features, int n, float *out);
+
+int libatari800_eval_features(void);
+
 UBYTE *libatari800_get_screen_ptr();
 
+int libatari800_get_observation(UBYTE *dest, int width, int height, int format,
+		int x1, int y1, int x2, int y2);
+
+int libatari800_set_observation_buffer(UBYTE *dest, int width, int height, int format,
+		int x1, int y1, int x2, int y2);
+
+uint64_t libatari800_get_screen_hash(void);
+
+uint64_t libatari800_get_state_hash(void);
+
+void libatari800_set_render_policy(int policy, int every);
+
+/* Ring of completed screens for readers in other threads */
+int libatari800_set_screen_buffers(int n);
+
+const UBYTE *libatari800_acquire_screen(int *frame);
+
+void libatari800_release_screen(const UBYTE *screen);
+
+unsigned long libatari800_get_screen_buffers_dropped(void);
+
 UBYTE *libatari800_get_sound_buffer();
 
 int libatari800_get_sound_buffer_len();
@@ -296,6 +376,8 @@ int libatari800_get_num_sound_channels();
 
 int libatari800_get_sound_sample_size();
 
+int libatari800_set_sound_format(int freq, int channels, int format);
+
 float libatari800_get_fps();
 
 int libatari800_get_frame_number();
@@ -304,11 +386,174 @@ void libatari800_get_current_state(emulator_state_t *state);
 
 void libatari800_restore_state(emulator_state_t *state);
 
+/* In-process snapshots, see libatari800_save_snapshot */
+#define LIBATARI800_SNAPSHOT_VERSION 1
+
+int libatari800_save_snapshot(UBYTE *buffer, int size);
+
+int libatari800_restore_snapshot(const UBYTE *buffer);
+
+int libatari800_restore_and_step_many(const UBYTE *parent, input_template_t *inputs, int k,
+		int frames, UBYTE *children, int stride, int *sizes, float *features);
+
+/* Copy-on-write store of snapshots sharing unchanged 256-byte pages */
+typedef struct libatari800_snapshot_store libatari800_snapshot_store_t;
+
+libatari800_snapshot_store_t *libatari800_snapshot_store_new(void);
+
+int libatari800_snapshot_store_save(libatari800_snapshot_store_t *store);
+
+int libatari800_snapshot_store_restore(libatari800_snapshot_store_t *store, int id);
+
+void libatari800_snapshot_store_drop(libatari800_snapshot_store_t *store, int id);
+
+size_t libatari800_snapshot_store_bytes(libatari800_snapshot_store_t *store);
+
+void libatari800_snapshot_store_free(libatari800_snapshot_store_t *store);
+
+/* Transposition table from state hashes to snapshots, visits and values,
+   shared by threads, see libatari800_ttable_new */
+typedef struct libatari800_ttable libatari800_ttable_t;
+
+libatari800_ttable_t *libatari800_ttable_new(int capacity);
+
+int libatari800_ttable_lookup(libatari800_ttable_t *t, uint64_t hash, int insert, int *created);
+
+void libatari800_ttable_set_snapshot(libatari800_ttable_t *t, int entry, int snapshot);
+
+int libatari800_ttable_get_snapshot(libatari800_ttable_t *t, int entry);
+
+void libatari800_ttable_update(libatari800_ttable_t *t, int entry, int visits, double value);
+
+void libatari800_ttable_get_stats(libatari800_ttable_t *t, int entry, int64_t *visits, double *value);
+
+int libatari800_ttable_count(libatari800_ttable_t *t);
+
+void libatari800_ttable_clear(libatari800_ttable_t *t);
+
+void libatari800_ttable_free(libatari800_ttable_t *t);
+
+/* Archives of states stored as the pages that differ from the first, for
+   datasets of many states, see libatari800_archive_create */
+typedef struct libatari800_archive libatari800_archive_t;
+
+libatari800_archive_t *libatari800_archive_create(const char *filename);
+
+int libatari800_archive_append(libatari800_archive_t *archive, const emulator_state_t *state);
+
+libatari800_archive_t *libatari800_archive_open(const char *filename);
+
+int libatari800_archive_count(libatari800_archive_t *archive);
+
+int libatari800_archive_get(libatari800_archive_t *archive, int record, emulator_state_t *state);
+
+int libatari800_archive_restore(libatari800_archive_t *archive, int record);
+
+int libatari800_archive_close(libatari800_archive_t *archive);
+
+/* Rewind history of keyframes and recorded input */
+int libatari800_set_rewind(int depth, int stride);
+
+int libatari800_rewind(int frames);
+
+/* Code coverage: a 64 KB map of the PCs run */
+void libatari800_set_coverage(UBYTE *map);
+
+/* Input movies: a starting state plus the input of every frame */
+#define LIBATARI800_MOVIE_VERSION 2
+
+typedef struct libatari800_movie libatari800_movie_t;
+
+libatari800_movie_t *libatari800_movie_record(const char *filename);
+
+void libatari800_movie_set_checksums(libatari800_movie_t *movie, int enabled);
+
+int libatari800_movie_add_frame(libatari800_movie_t *movie, const input_template_t *input);
+
+int libatari800_movie_add_keyframe(libatari800_movie_t *movie);
+
+libatari800_movie_t *libatari800_movie_open(const char *filename);
+
+int libatari800_movie_next_input(libatari800_movie_t *movie, input_template_t *input);
+
+int libatari800_movie_recorded_checksum(libatari800_movie_t *movie, ULONG *sum);
+
+ULONG libatari800_movie_memory_checksum(void);
+
+int libatari800_movie_play(libatari800_movie_t *movie, int frames);
+
+int libatari800_movie_keyframes(libatari800_movie_t *movie, int *frames, int max);
+
+int libatari800_movie_length(libatari800_movie_t *movie);
+
+int libatari800_movie_seek(libatari800_movie_t *movie, int keyframe);
+
+int libatari800_movie_frames(libatari800_movie_t *movie);
+
+int libatari800_movie_close(libatari800_movie_t *movie);
+
+/* Sound and video recording, see libatari800_start_recording */
+int libatari800_start_recording(const char *filename);
+
+int libatari800_stop_recording(void);
+
+/* Emulator contexts, each holding a separate machine */
+typedef struct atari800_ctx atari800_ctx_t;
+
+atari800_ctx_t *libatari800_ctx_new(void);
+
+void libatari800_ctx_select(atari800_ctx_t *ctx);
+
+atari800_ctx_t *libatari800_ctx_selected(void);
+
+int libatari800_ctx_next_frame(atari800_ctx_t *ctx, input_template_t *input);
+
+int libatari800_step_batch(atari800_ctx_t **ctxs, input_template_t *inputs, int n,
+		int frames, UBYTE *obs, int width, int height, int format);
+
+int libatari800_save_many(atari800_ctx_t **ctxs, int n, UBYTE *buffer, int stride, int *sizes);
+
+void libatari800_ctx_free(atari800_ctx_t *ctx);
+
+/* Vectorized environments: contexts stepped together, see
+   libatari800_vecenv_new */
+typedef struct libatari800_vecenv libatari800_vecenv_t;
+
+typedef struct {
+    UBYTE *obs;            /* n x height x width */
+    float *rewards;        /* n */
+    UBYTE *terminated;     /* n: the episode ended, and was reset */
+    UBYTE *truncated;      /* n: the episode was cut short, and reset */
+    int *episode_frames;   /* n: frames the episode had run */
+} libatari800_vecenv_result_t;
+
+libatari800_vecenv_t *libatari800_vecenv_new(int n, int frames, int flags,
+		int width, int height, int format);
+
+int libatari800_vecenv_set_reward(libatari800_vecenv_t *v, const feature_template_t *features, int n);
+
+int libatari800_vecenv_set_done(libatari800_vecenv_t *v, const feature_template_t *features, int n);
+
+void libatari800_vecenv_set_max_frames(libatari800_vecenv_t *v, int frames);
+
+const libatari800_vecenv_result_t *libatari800_vecenv_reset(libatari800_vecenv_t *v);
+
+void libatari800_vecenv_step_async(libatari800_vecenv_t *v, const input_template_t *inputs);
+
+const libatari800_vecenv_result_t *libatari800_vecenv_step_wait(libatari800_vecenv_t *v);
+
+const libatari800_vecenv_result_t *libatari800_vecenv_step(libatari800_vecenv_t *v, const input_template_t *inputs);
+
+void libatari800_vecenv_free(libatari800_vecenv_t *v);
+
 void libatari800_exit();
 
 /* Disk management functions */
 int libatari800_mount_disk(int drive_num, const char *filename, int read_only);
 void libatari800_unmount_disk(int drive_num);
+/* Writes sectors kept in memory by -disk-writes overlay or writeback to the
+   image file */
+int libatari800_flush_disk(int drive_num);
 void libatari800_disable_drive(int drive_num);
 void libatari800_set_disk_activity_callback(void (*callback)(int drive, int operation));
 
@@ -45,6 +45,7 @@
 #include "cartridge.h"
 #include "ui.h"
 #include "cfg.h"
+#include "ai_interface.h"
 #include "libatari800/main.h"
 #include "libatari800/init.h"
 #include "libatari800/input.h"
@@ -63,6 +64,15 @@
 #if defined(PBI_XLD) || defined (VOICEBOX)
 #include "votraxsnd.h"
 #endif
+#ifdef NETPLAY
+#include "netplay.h"
+#endif
+#ifdef STREAM_OUTPUT
+#include "stream.h"
+#endif
+#ifdef VIDEO_RECORDING
+#include "file_export.h"
+#endif
 
 int PLATFORM_Configure(char *option, char *parameters)
 {
@@ -102,8 +112,25 @@ int PLATFORM_Initialise(int *argc, char *argv[])
 }
 
 
+int LIBATARI800_draw_frame = -1;
+
+static void DrawOverlays(void)
+{
+#ifndef LIBATARI800_MINIMAL
+	INPUT_DrawMousePointer();
+	Screen_DrawAtariSpeed(Util_time());
+	Screen_DrawDiskLED();
+	Screen_Draw1200LED();
+#endif
+}
+
 void LIBATARI800_Frame(void)
 {
+	int run_ahead = FALSE;
+
+	/* Between frames the program using the library, AI_Frame included,
+	   has been running */
+	AI_TIME_STAGE(AI_TIME_HOST);
 	switch (INPUT_key_code) {
 	case AKEY_COLDSTART:
 		Atari800_Coldstart();
@@ -125,16 +152,54 @@ void LIBATARI800_Frame(void)
 	VOTRAXSND_Frame(); /* for the Votrax */
 #endif
 	Devices_Frame();
+	Atari800_QuickBootFrame();
+#ifdef NETPLAY
+	NETPLAY_Frame();  /* exchange input, roll back wrongly guessed frames */
+#endif
 	INPUT_Frame();
+	AI_ApplyInput();  /* Apply AI joystick/trigger overrides */
+#ifdef NETPLAY
+	NETPLAY_ApplyInput();
+#endif
 	GTIA_Frame();
-	ANTIC_Frame(TRUE);
-	INPUT_DrawMousePointer();
-	Screen_DrawAtariSpeed(Util_time());
-	Screen_DrawDiskLED();
-	Screen_Draw1200LED();
+	AI_TIME_STAGE(AI_TIME_INPUT);
+	if (LIBATARI800_draw_frame == TRUE) {
+		ANTIC_Frame(TRUE);
+		Atari800_display_screen = TRUE;
+	}
+	else if (LIBATARI800_draw_frame < 0 && AI_RenderFrame()) {
+		run_ahead = Atari800_RunAheadWanted();
+		if (run_ahead)
+			ANTIC_Frame(ANTIC_DRAW_COLLISIONS);
+		else {
+			ANTIC_Frame(TRUE);
+			DrawOverlays();
+		}
+		Atari800_display_screen = TRUE;
+	}
+	else {
+		ANTIC_Frame(LIBATARI800_draw_frame == FALSE || Atari800_collisions_in_skipped_frames
+			? ANTIC_DRAW_COLLISIONS : FALSE);
+		Atari800_display_screen = FALSE;
+	}
+	AI_TIME_STAGE(AI_TIME_ANTIC);
 	POKEY_Frame();
+	AI_TIME_STAGE(AI_TIME_POKEY);
+#ifdef VIDEO_RECORDING
+	File_Export_WriteVideo();
+	AI_TIME_STAGE(AI_TIME_RECORD);
+#endif
 	Sound_Update();
+	AI_TIME_STAGE(AI_TIME_SOUND);
+#ifdef STREAM_OUTPUT
+	STREAM_Frame();
+#endif
+	if (run_ahead) {
+		Atari800_RunAhead();
+		DrawOverlays();
+	}
 	Atari800_nframes++;
+	AI_TIME_FRAME();
 }
 
 
@@ -5,6 +5,11 @@
 
 #include "config.h"
 
+/* Set by libatari800_next_frames(): -1 leaves drawing to the render
+   policy, FALSE skips drawing the frame but keeps its collisions and TRUE
+   draws it without the mouse pointer, speed and LED overlays */
+extern int LIBATARI800_draw_frame;
+
 void LIBATARI800_Frame(void);
 
 #endif /* LIBATARI800_VIDEO_H_ */
@@ -0,0 +1,721 @@
+/*
+ * libatari800/movie.c - Atari800 as a library - input movies
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+/* A movie is the state the recording started from followed by the input of
+   every frame, which is enough to play the run again exactly. All numbers
+   are little-endian:
+
+     "A8MV" u32 version, u32 input size, state, then records
+
+   where a state is u32 size, u32 selftest_enabled, u32 nframes,
+   u32 sample_residual, u32 random_counter, 12 bytes input_state and size
+   bytes, all from libatari800_get_current_state.
+
+   The input of a frame is its input_template_t followed by a byte for each
+   of the 8 pots: 0 if the pot works as usual, else the value set with
+   libatari800_set_pots plus 1. Movies whose input size is that of
+   input_template_t alone were recorded before the pots were, and play
+   with them working as usual.
+
+   A record is a run of frames with the same input: a varint frame count,
+   a varint mask of the input bytes that changed since the previous record,
+   and the new value of each of those bytes. The first record is relative
+   to an all-zero input. A count of 0 is followed by a type byte instead:
+
+     0  end of the movie
+     1  varint n, then n u32 checksums of main memory, each taken at the
+        start of one of the n frames that follow
+     2  keyframe: u32 number of the frame that follows, counted from the
+        start of the movie, and the state before it. The record after a
+        keyframe is again relative to an all-zero input, so playing can
+        start at any keyframe.
+
+   The recorder holds back up to MOVIE_BLOCK_FRAMES frames so that their
+   checksums can go first; a movie cut short by a crash plays up to the
+   last block that was written. */
+
+#include "config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "atari.h"
+#include "crc32.h"
+#include "../input.h"
+#include "libatari800.h"
+#include "util.h"
+
+/* The input of a frame as recorded */
+typedef struct {
+	input_template_t input;
+	UBYTE pots[8];
+} movie_input_t;
+
+#define MOVIE_MAGIC "A8MV"
+#define MOVIE_INPUT_SIZE ((int)sizeof(movie_input_t))
+#define MOVIE_INPUT_SIZE_NO_POTS ((int)sizeof(input_template_t))
+#define MOVIE_STATE_HEADER 32
+#define MOVIE_BLOCK_FRAMES 1024
+
+#define RECORD_END 0
+#define RECORD_CHECKSUMS 1
+#define RECORD_KEYFRAME 2
+
+struct libatari800_movie {
+	FILE *fp;
+	int recording;
+	int input_size;          /* bytes of movie_input_t in the file */
+	movie_input_t input;     /* of the current record */
+	movie_input_t prev;      /* recording: of the record before */
+	ULONG run;               /* recording: frames in the current record,
+	                            playing: frames of it still to play */
+	int frames;              /* recorded or played so far */
+	int end;                 /* playing: the end record was read */
+
+	/* Recording: the frames held back, encoded, and their checksums */
+	int checksums;
+	UBYTE *block;
+	int block_len;
+	int block_size;
+	int block_frames;
+
+	/* Checksums of the frames being recorded, or of the frames of the
+	   last checksum record being played */
+	ULONG sums[MOVIE_BLOCK_FRAMES];
+	int sums_count;
+	int sums_pos;
+	int sum_valid;           /* playing: sum holds the current frame's */
+	ULONG sum;
+
+	/* Playing: where the starting state and the keyframes are */
+	int indexed;
+	int num_keys;
+	long *key_offsets;
+	int *key_frames;
+	int length;
+};
+
+static void put_u32(UBYTE *p, ULONG v)
+{
+	p[0] = (UBYTE)v;
+	p[1] = (UBYTE)(v >> 8);
+	p[2] = (UBYTE)(v >> 16);
+	p[3] = (UBYTE)(v >> 24);
+}
+
+static ULONG get_u32(const UBYTE *p)
+{
+	return p[0] | (p[1] << 8) | (p[2] << 16) | ((ULONG)p[3] << 24);
+}
+
+static int encode_varint(UBYTE *p, ULONG v)
+{
+	int n = 0;
+
+	while (v >= 0x80) {
+		p[n++] = (UBYTE)(v | 0x80);
+		v >>= 7;
+	}
+	p[n++] = (UBYTE)v;
+	return n;
+}
+
+static int get_varint(FILE *fp, ULONG *v)
+{
+	int shift = 0, c;
+
+	*v = 0;
+	do {
+		if (shift > 28 || (c = getc(fp)) == EOF)
+			return FALSE;
+		*v |= (ULONG)(c & 0x7f) << shift;
+		shift += 7;
+	} while (c & 0x80);
+	return TRUE;
+}
+
+static int read_u32(FILE *fp, ULONG *v)
+{
+	UBYTE b[4];
+
+	if (fread(b, 1, 4, fp) != 4)
+		return FALSE;
+	*v = get_u32(b);
+	return TRUE;
+}
+
+static void block_put(libatari800_movie_t *movie, const UBYTE *data, int len)
+{
+	if (movie->block_len + len > movie->block_size) {
+		movie->block_size = movie->block_size * 2 + len + 256;
+		movie->block = (UBYTE *)Util_realloc(movie->block, movie->block_size);
+	}
+	memcpy(movie->block + movie->block_len, data, len);
+	movie->block_len += len;
+}
+
+/* Encode the current record into the block */
+static void flush_run(libatari800_movie_t *movie)
+{
+	const UBYTE *a = (const UBYTE *)&movie->input;
+	const UBYTE *b = (const UBYTE *)&movie->prev;
+	UBYTE rec[10 + MOVIE_INPUT_SIZE];
+	ULONG mask = 0;
+	int i, n;
+
+	if (movie->run == 0)
+		return;
+	for (i = 0; i < MOVIE_INPUT_SIZE; i++)
+		if (a[i] != b[i])
+			mask |= 1UL << i;
+	n = encode_varint(rec, movie->run);
+	n += encode_varint(rec + n, mask);
+	for (i = 0; i < MOVIE_INPUT_SIZE; i++)
+		if (mask & (1UL << i))
+			rec[n++] = a[i];
+	block_put(movie, rec, n);
+	movie->prev = movie->input;
+	movie->run = 0;
+}
+
+/* Write out the frames held back, after their checksums */
+static void flush_block(libatari800_movie_t *movie)
+{
+	flush_run(movie);
+	if (movie->block_frames == 0)
+		return;
+	if (movie->checksums) {
+		UBYTE rec[7];
+		int i, n = 0;
+
+		rec[n++] = 0;
+		rec[n++] = RECORD_CHECKSUMS;
+		n += encode_varint(rec + n, movie->block_frames);
+		fwrite(rec, 1, n, movie->fp);
+		for (i = 0; i < movie->block_frames; i++) {
+			put_u32(rec, movie->sums[i]);
+			fwrite(rec, 1, 4, movie->fp);
+		}
+	}
+	fwrite(movie->block, 1, movie->block_len, movie->fp);
+	movie->block_len = 0;
+	movie->block_frames = 0;
+}
+
+static int write_state(FILE *fp)
+{
+	emulator_state_t *state;
+	UBYTE header[MOVIE_STATE_HEADER];
+	int ok;
+
+	state = (emulator_state_t *)Util_malloc(sizeof(emulator_state_t));
+	libatari800_get_current_state(state);
+	put_u32(header, state->tags.size);
+	put_u32(header + 4, state->flags.selftest_enabled);
+	put_u32(header + 8, state->flags.nframes);
+	put_u32(header + 12, state->flags.sample_residual);
+	put_u32(header + 16, state->flags.random_counter);
+	memcpy(header + 20, state->flags.input_state, 12);
+	ok = state->tags.size != 0
+		&& fwrite(header, 1, sizeof(header), fp) == sizeof(header)
+		&& fwrite(state->state, 1, state->tags.size, fp) == state->tags.size;
+	free(state);
+	return ok;
+}
+
+/* Read a state at the file position and restore the emulator to it */
+static int read_state(FILE *fp)
+{
+	emulator_state_t *state;
+	UBYTE header[MOVIE_STATE_HEADER];
+	ULONG size;
+
+	if (fread(header, 1, sizeof(header), fp) != sizeof(header)
+		|| (size = get_u32(header)) == 0 || size > STATESAV_MAX_SIZE)
+		return FALSE;
+	state = (emulator_state_t *)Util_malloc(sizeof(emulator_state_t));
+	memset(state, 0, sizeof(emulator_state_t));
+	if (fread(state->state, 1, size, fp) != size) {
+		free(state);
+		return FALSE;
+	}
+	state->tags.size = size;
+	state->flags.selftest_enabled = (UBYTE)get_u32(header + 4);
+	state->flags.nframes = get_u32(header + 8);
+	state->flags.sample_residual = get_u32(header + 12);
+	state->flags.random_counter = get_u32(header + 16);
+	memcpy(state->flags.input_state, header + 20, 12);
+	libatari800_restore_state(state);
+	free(state);
+	return TRUE;
+}
+
+static int skip_state(FILE *fp)
+{
+	ULONG size;
+
+	return read_u32(fp, &size) && fseek(fp, MOVIE_STATE_HEADER - 4 + size, SEEK_CUR) == 0;
+}
+
+/* Find the starting state, the keyframes and the length of the movie */
+static void build_index(libatari800_movie_t *movie)
+{
+	long pos = ftell(movie->fp);
+	int keys_size = 16;
+	ULONG run, v;
+	int frames = 0;
+
+	movie->indexed = TRUE;
+	movie->key_offsets = (long *)Util_malloc(keys_size * sizeof(long));
+	movie->key_frames = (int *)Util_malloc(keys_size * sizeof(int));
+	movie->key_offsets[0] = 12;
+	movie->key_frames[0] = 0;
+	movie->num_keys = 1;
+	if (fseek(movie->fp, 12, SEEK_SET) != 0 || !skip_state(movie->fp)) {
+		fseek(movie->fp, pos, SEEK_SET);
+		return;
+	}
+	while (get_varint(movie->fp, &run)) {
+		if (run > 0) {
+			int i, bytes = 0;
+			if (!get_varint(movie->fp, &v))
+				break;
+			for (i = 0; i < movie->input_size; i++)
+				bytes += (v >> i) & 1;
+			if (fseek(movie->fp, bytes, SEEK_CUR) != 0)
+				break;
+			frames += run;
+			continue;
+		}
+		v = getc(movie->fp);
+		if (v == RECORD_CHECKSUMS) {
+			if (!get_varint(movie->fp, &v) || fseek(movie->fp, 4 * (long)v, SEEK_CUR) != 0)
+				break;
+		}
+		else if (v == RECORD_KEYFRAME) {
+			ULONG frame;
+			long offset;
+			if (!read_u32(movie->fp, &frame))
+				break;
+			offset = ftell(movie->fp);
+			if (!skip_state(movie->fp))
+				break;
+			if (movie->num_keys == keys_size) {
+				keys_size *= 2;
+				movie->key_offsets = (long *)Util_realloc(movie->key_offsets, keys_size * sizeof(long));
+				movie->key_frames = (int *)Util_realloc(movie->key_frames, keys_size * sizeof(int));
+			}
+			movie->key_offsets[movie->num_keys] = offset;
+			movie->key_frames[movie->num_keys] = (int)frame;
+			movie->num_keys++;
+		}
+		else
+			break;
+	}
+	/* A keyframe cut off at the end of a crashed recording is past the
+	   last frame that can be played */
+	while (movie->num_keys > 1 && movie->key_frames[movie->num_keys - 1] > frames)
+		movie->num_keys--;
+	movie->length = frames;
+	clearerr(movie->fp);
+	fseek(movie->fp, pos, SEEK_SET);
+}
+
+
+/** Start recording a movie
+ *
+ * Writes the current state of the emulator to \a filename as the start of
+ * the movie. Pass the input of each frame that follows to \a
+ * libatari800_movie_add_frame, and finish the file with \a
+ * libatari800_movie_close.
+ *
+ * @param filename path of the movie file to create
+ *
+ * @returns movie being recorded, or NULL if the file cannot be written
+ */
+libatari800_movie_t *libatari800_movie_record(const char *filename)
+{
+	libatari800_movie_t *movie;
+	UBYTE header[12];
+	FILE *fp;
+
+	fp = fopen(filename, "wb");
+	if (fp == NULL)
+		return NULL;
+	memcpy(header, MOVIE_MAGIC, 4);
+	put_u32(header + 4, LIBATARI800_MOVIE_VERSION);
+	put_u32(header + 8, MOVIE_INPUT_SIZE);
+	if (fwrite(header, 1, sizeof(header), fp) != sizeof(header) || !write_state(fp)) {
+		fclose(fp);
+		return NULL;
+	}
+
+	movie = (libatari800_movie_t *)Util_malloc(sizeof(libatari800_movie_t));
+	memset(movie, 0, sizeof(libatari800_movie_t));
+	movie->fp = fp;
+	movie->recording = TRUE;
+	movie->input_size = MOVIE_INPUT_SIZE;
+	return movie;
+}
+
+
+/** Record a checksum of main memory with every frame
+ *
+ * The checksums let a replay be checked frame by frame with \a
+ * libatari800_movie_recorded_checksum, at 4 bytes a frame. Applies to the
+ * frames added after the call.
+ *
+ * @param movie movie being recorded
+ * @param enabled TRUE to record checksums
+ */
+void libatari800_movie_set_checksums(libatari800_movie_t *movie, int enabled)
+{
+	if (!movie->recording || movie->checksums == enabled)
+		return;
+	flush_block(movie);
+	movie->checksums = enabled;
+}
+
+
+/** Record the input of one frame
+ *
+ * Call with the input passed to \a libatari800_next_frame, once per frame
+ * and in the same order, before the frame is run. The pot values set with
+ * \a libatari800_set_pots are recorded with it. Frames are held back
+ * while the input stays the same, so most calls do not touch the file.
+ *
+ * @param movie movie from \a libatari800_movie_record
+ * @param input input of the frame
+ *
+ * @returns FALSE if \a movie is not being recorded
+ */
+int libatari800_movie_add_frame(libatari800_movie_t *movie, const input_template_t *input)
+{
+	movie_input_t frame;
+	int i;
+
+	if (!movie->recording)
+		return FALSE;
+	frame.input = *input;
+	for (i = 0; i < 8; i++)
+		frame.pots[i] = (UBYTE)(INPUT_pot_override[i] + 1);
+	if (movie->run > 0 && memcmp(&movie->input, &frame, sizeof(movie_input_t)) != 0)
+		flush_run(movie);
+	movie->input = frame;
+	movie->run++;
+	movie->frames++;
+	if (movie->checksums)
+		movie->sums[movie->block_frames] = libatari800_movie_memory_checksum();
+	if (++movie->block_frames == MOVIE_BLOCK_FRAMES)
+		flush_block(movie);
+	return TRUE;
+}
+
+
+/** Record a keyframe
+ *
+ * Writes the current state of the emulator into the movie, so that it can
+ * be played from this point as well as from the start; see \a
+ * libatari800_movie_seek. Call between frames.
+ *
+ * @param movie movie being recorded
+ *
+ * @returns FALSE if \a movie is not being recorded or the state could not
+ * be written
+ */
+int libatari800_movie_add_keyframe(libatari800_movie_t *movie)
+{
+	UBYTE rec[6];
+
+	if (!movie->recording)
+		return FALSE;
+	flush_block(movie);
+	rec[0] = 0;
+	rec[1] = RECORD_KEYFRAME;
+	put_u32(rec + 2, movie->frames);
+	if (fwrite(rec, 1, sizeof(rec), movie->fp) != sizeof(rec) || !write_state(movie->fp))
+		return FALSE;
+	memset(&movie->prev, 0, sizeof(movie_input_t));
+	return TRUE;
+}
+
+
+/** Open a movie for playback
+ *
+ * Reads the header of \a filename and restores the emulator to the state
+ * the recording started from. The machine type, cartridges and disks are
+ * those of the state file, as with \a libatari800_restore_state, so the
+ * emulator must have been started with the same media. The input is then
+ * read one frame at a time by \a libatari800_movie_next_input, or the
+ * whole movie played by \a libatari800_movie_play.
+ *
+ * @param filename path of the movie file
+ *
+ * @returns movie ready to play, or NULL if the file cannot be read or is not
+ * a movie of this version
+ */
+libatari800_movie_t *libatari800_movie_open(const char *filename)
+{
+	libatari800_movie_t *movie;
+	UBYTE header[12];
+	FILE *fp;
+
+	fp = fopen(filename, "rb");
+	if (fp == NULL)
+		return NULL;
+	if (fread(header, 1, sizeof(header), fp) != sizeof(header)
+		|| memcmp(header, MOVIE_MAGIC, 4) != 0
+		|| get_u32(header + 4) != LIBATARI800_MOVIE_VERSION
+		|| (get_u32(header + 8) != MOVIE_INPUT_SIZE && get_u32(header + 8) != MOVIE_INPUT_SIZE_NO_POTS)
+		|| !read_state(fp)) {
+		fclose(fp);
+		return NULL;
+	}
+
+	movie = (libatari800_movie_t *)Util_malloc(sizeof(libatari800_movie_t));
+	memset(movie, 0, sizeof(libatari800_movie_t));
+	movie->fp = fp;
+	movie->input_size = (int)get_u32(header + 8);
+	return movie;
+}
+
+
+/** Read the input of the next frame of a movie
+ *
+ * The movie is decoded as it is read, a record at a time, so it is never
+ * held in memory whole. Keyframes on the way are skipped. The pot values
+ * recorded for the frame are set as by \a libatari800_set_pots.
+ *
+ * @param movie movie from \a libatari800_movie_open
+ * @param input filled with the input of the frame
+ *
+ * @returns TRUE, or FALSE at the end of the movie
+ */
+int libatari800_movie_next_input(libatari800_movie_t *movie, input_template_t *input)
+{
+	int pots[8], i;
+
+	if (movie->recording || movie->end)
+		return FALSE;
+	while (movie->run == 0) {
+		UBYTE *p = (UBYTE *)&movie->input;
+		ULONG run, v;
+		int c;
+
+		if (!get_varint(movie->fp, &run))
+			break;
+		if (run > 0) {
+			if (!get_varint(movie->fp, &v))
+				break;
+			for (i = 0; i < movie->input_size; i++) {
+				if (!(v & (1UL << i)))
+					continue;
+				if ((c = getc(movie->fp)) == EOF)
+					break;
+				p[i] = (UBYTE)c;
+			}
+			if (i < movie->input_size)
+				break;
+			movie->run = run;
+		}
+		else if ((c = getc(movie->fp)) == RECORD_CHECKSUMS) {
+			if (!get_varint(movie->fp, &v) || v > MOVIE_BLOCK_FRAMES)
+				break;
+			for (i = 0; i < (int)v; i++)
+				if (!read_u32(movie->fp, &movie->sums[i]))
+					break;
+			if (i < (int)v)
+				break;
+			movie->sums_count = (int)v;
+			movie->sums_pos = 0;
+		}
+		else if (c == RECORD_KEYFRAME) {
+			if (fseek(movie->fp, 4, SEEK_CUR) != 0 || !skip_state(movie->fp))
+				break;
+			memset(&movie->input, 0, sizeof(movie_input_t));
+		}
+		else
+			break;
+	}
+	if (movie->run == 0) {
+		movie->end = TRUE;
+		return FALSE;
+	}
+	movie->run--;
+	movie->frames++;
+	movie->sum_valid = movie->sums_pos < movie->sums_count;
+	if (movie->sum_valid)
+		movie->sum = movie->sums[movie->sums_pos++];
+	*input = movie->input.input;
+	for (i = 0; i < 8; i++)
+		pots[i] = movie->input.pots[i] - 1;
+	libatari800_set_pots(pots);
+	return TRUE;
+}
+
+
+/** Recorded checksum of the frame last read
+ *
+ * @param movie movie being played
+ * @param sum set to the checksum of main memory recorded at the start of
+ * the frame last returned by \a libatari800_movie_next_input
+ *
+ * @returns FALSE if the movie has no checksum for the frame
+ */
+int libatari800_movie_recorded_checksum(libatari800_movie_t *movie, ULONG *sum)
+{
+	if (!movie->sum_valid)
+		return FALSE;
+	*sum = movie->sum;
+	return TRUE;
+}
+
+
+/** Checksum of main memory as recorded in movies
+ *
+ * @returns CRC32 of the 64 KB of main memory
+ */
+ULONG libatari800_movie_memory_checksum(void)
+{
+	return CRC32_Update(0, libatari800_get_main_memory_ptr(), 65536);
+}
+
+
+/** Play a movie
+ *
+ * Runs the emulator with the recorded input as fast as it will go, with no
+ * throttling; use \a libatari800_set_render_policy first to skip drawing
+ * the frames that are not looked at.
+ *
+ * @param movie movie from \a libatari800_movie_open
+ * @param frames maximum number of frames to play, or -1 for all
+ *
+ * @returns number of frames played
+ */
+int libatari800_movie_play(libatari800_movie_t *movie, int frames)
+{
+	input_template_t input;
+	int played = 0;
+
+	while ((frames < 0 || played < frames) && libatari800_movie_next_input(movie, &input)) {
+		libatari800_next_frame(&input);
+		played++;
+	}
+	return played;
+}
+
+
+/** List the points a movie can be played from
+ *
+ * The first is always the start of the movie, frame 0; the others are the
+ * keyframes from \a libatari800_movie_add_keyframe. The first call reads
+ * through the file once.
+ *
+ * @param movie movie being played
+ * @param frames filled with the frame number of each point, or NULL
+ * @param max size of \a frames
+ *
+ * @returns number of points
+ */
+int libatari800_movie_keyframes(libatari800_movie_t *movie, int *frames, int max)
+{
+	int i;
+
+	if (movie->recording)
+		return 0;
+	if (!movie->indexed)
+		build_index(movie);
+	for (i = 0; frames != NULL && i < movie->num_keys && i < max; i++)
+		frames[i] = movie->key_frames[i];
+	return movie->num_keys;
+}
+
+
+/** Number of frames in a movie
+ *
+ * Like \a libatari800_movie_keyframes, reads through the file the first
+ * time when playing.
+ *
+ * @param movie movie being recorded or played
+ */
+int libatari800_movie_length(libatari800_movie_t *movie)
+{
+	if (movie->recording)
+		return movie->frames;
+	if (!movie->indexed)
+		build_index(movie);
+	return movie->length;
+}
+
+
+/** Continue playing from a keyframe
+ *
+ * Restores the emulator to the state of a point listed by \a
+ * libatari800_movie_keyframes; the next input read is that of its frame.
+ *
+ * @param movie movie being played
+ * @param keyframe index of the point
+ *
+ * @returns FALSE if there is no such point or its state cannot be read
+ */
+int libatari800_movie_seek(libatari800_movie_t *movie, int keyframe)
+{
+	if (movie->recording)
+		return FALSE;
+	if (!movie->indexed)
+		build_index(movie);
+	if (keyframe < 0 || keyframe >= movie->num_keys)
+		return FALSE;
+	clearerr(movie->fp);
+	if (fseek(movie->fp, movie->key_offsets[keyframe], SEEK_SET) != 0 || !read_state(movie->fp))
+		return FALSE;
+	memset(&movie->input, 0, sizeof(movie_input_t));
+	movie->run = 0;
+	movie->end = FALSE;
+	movie->frames = movie->key_frames[keyframe];
+	movie->sums_count = movie->sums_pos = 0;
+	movie->sum_valid = FALSE;
+	return TRUE;
+}
+
+
+/** Number of frames recorded or played so far
+ *
+ * @param movie movie being recorded or played
+ */
+int libatari800_movie_frames(libatari800_movie_t *movie)
+{
+	return movie->frames;
+}
+
+
+/** Finish and close a movie
+ *
+ * When recording, writes out the frames held back and the end of the movie.
+ *
+ * @param movie movie being recorded or played; freed by this call
+ *
+ * @returns FALSE if writing the movie failed
+ */
+int libatari800_movie_close(libatari800_movie_t *movie)
+{
+	int ok = TRUE;
+
+	if (movie->recording) {
+		static const UBYTE end[2] = { 0, RECORD_END };
+		flush_block(movie);
+		fwrite(end, 1, sizeof(end), movie->fp);
+		ok = !ferror(movie->fp);
+	}
+	if (fclose(movie->fp) != 0)
+		ok = FALSE;
+	free(movie->block);
+	free(movie->key_offsets);
+	free(movie->key_frames);
+	free(movie);
+	return ok;
+}
@@ -0,0 +1,296 @@
+/*
+ * libatari800/movie_bench.c - replay movies as a correctness and speed gate
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+/* Plays each movie from its start a few times, one after the other on an
+   otherwise idle emulator, and takes the frame rate of the fastest run.
+   A movie passes if the checksums recorded in it match, if every run ends
+   with the same main memory, and if that memory and the frame rate hold
+   up against the baseline: a text file of one line per movie,
+
+       <memory CRC32 in hex> <frames per second> <frames> <movie file name>
+
+   written by -update. The CRC catches an optimisation that changes what
+   the emulator does; the frame rate, one that makes it slower than
+   -tolerance percent. Frame rates only compare on the same host with the
+   same emulator options, so the baseline belongs to the machine it was
+   written on. Movies are named in it by their file name without the
+   directory, and are not played in parallel, which would skew the
+   timing: movie_verify is the tool for checking long movies quickly. */
+
+#include "config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef HAVE_OPENDIR
+#include <dirent.h>
+#endif
+#ifdef HAVE_SYS_STAT_H
+#include <sys/stat.h>
+#endif
+
+#include "libatari800.h"
+#include "util.h"
+
+#define DEFAULT_RUNS      3
+#define DEFAULT_TOLERANCE 10.0
+
+typedef struct {
+	char name[FILENAME_MAX];
+	ULONG crc;
+	double fps;
+	int frames;
+} entry_t;
+
+static char **movies = NULL;
+static int num_movies = 0;
+static entry_t *baseline = NULL;
+static int num_baseline = 0;
+
+static void usage(void)
+{
+	printf("usage: movie_bench [-baseline file [-update]] [-tolerance percent] [-runs n]\n"
+	       "                   movie|directory... [-- emulator options]\n");
+}
+
+static void add_movie(const char *path)
+{
+	movies = (char **)Util_realloc(movies, (num_movies + 1) * sizeof(char *));
+	movies[num_movies++] = Util_strdup(path);
+}
+
+static int compare_names(const void *a, const void *b)
+{
+	return strcmp(*(char * const *)a, *(char * const *)b);
+}
+
+/* Adds the movies in DIR in name order, or DIR itself if it is a file */
+static void add_path(const char *path)
+{
+#if defined(HAVE_OPENDIR) && defined(HAVE_STAT)
+	struct stat st;
+	if (stat(path, &st) == 0 && S_ISDIR(st.st_mode)) {
+		DIR *dir = opendir(path);
+		struct dirent *entry;
+		int first = num_movies;
+		if (dir == NULL) {
+			printf("cannot read %s\n", path);
+			return;
+		}
+		while ((entry = readdir(dir)) != NULL) {
+			char name[FILENAME_MAX];
+			char magic[4];
+			FILE *fp;
+			Util_catpath(name, path, entry->d_name);
+			if (stat(name, &st) != 0 || !S_ISREG(st.st_mode))
+				continue;
+			/* Only files that start like a movie */
+			fp = fopen(name, "rb");
+			if (fp == NULL)
+				continue;
+			if (fread(magic, 1, 4, fp) == 4 && memcmp(magic, "A8MV", 4) == 0)
+				add_movie(name);
+			fclose(fp);
+		}
+		closedir(dir);
+		qsort(movies + first, num_movies - first, sizeof(char *), compare_names);
+		return;
+	}
+#endif
+	add_movie(path);
+}
+
+/* A missing file is an empty baseline; FALSE if it cannot be read */
+static int read_baseline(const char *filename)
+{
+	char line[FILENAME_MAX + 64];
+	FILE *fp = fopen(filename, "r");
+
+	if (fp == NULL)
+		return TRUE;
+	while (fgets(line, sizeof(line), fp) != NULL) {
+		entry_t e;
+		int name_start;
+		unsigned long crc;
+		if (line[0] == '#' || line[0] == '\n')
+			continue;
+		if (sscanf(line, "%lx %lf %d %n", &crc, &e.fps, &e.frames, &name_start) < 3) {
+			printf("%s: bad line: %s", filename, line);
+			fclose(fp);
+			return FALSE;
+		}
+		e.crc = (ULONG)crc;
+		Util_strlcpy(e.name, line + name_start, sizeof(e.name));
+		Util_chomp(e.name);
+		baseline = (entry_t *)Util_realloc(baseline, (num_baseline + 1) * sizeof(entry_t));
+		baseline[num_baseline++] = e;
+	}
+	fclose(fp);
+	return TRUE;
+}
+
+static int write_baseline(const char *filename, const entry_t *results, int n)
+{
+	FILE *fp = fopen(filename, "w");
+	int i;
+
+	if (fp == NULL)
+		return FALSE;
+	fprintf(fp, "# movie_bench baseline: memory CRC32, frames per second, frames, movie\n");
+	for (i = 0; i < n; i++)
+		if (results[i].frames > 0)
+			fprintf(fp, "%08lx %.1f %d %s\n", (unsigned long)results[i].crc, results[i].fps,
+				results[i].frames, results[i].name);
+	return fclose(fp) == 0;
+}
+
+static const entry_t *find_baseline(const char *name)
+{
+	int i;
+	for (i = 0; i < num_baseline; i++)
+		if (strcmp(baseline[i].name, name) == 0)
+			return &baseline[i];
+	return NULL;
+}
+
+/* Plays movie PATH runs times into result; prints and returns FALSE if
+   it does not replay as recorded or the same each time */
+static int play(const char *path, int runs, entry_t *result)
+{
+	libatari800_movie_t *movie = libatari800_movie_open(path);
+	char dir[FILENAME_MAX];
+	int r;
+
+	memset(result, 0, sizeof(entry_t));
+	Util_splitpath(path, dir, result->name);
+	if (movie == NULL) {
+		printf("%s: not a movie\n", path);
+		return FALSE;
+	}
+	for (r = 0; r < runs; r++) {
+		input_template_t input;
+		double start;
+		ULONG crc;
+		int frames = 0;
+		if (!libatari800_movie_seek(movie, 0)) {
+			printf("%s: cannot be played\n", path);
+			libatari800_movie_close(movie);
+			return FALSE;
+		}
+		start = Util_time();
+		while (libatari800_movie_next_input(movie, &input)) {
+			ULONG sum;
+			if (libatari800_movie_recorded_checksum(movie, &sum)
+				&& sum != libatari800_movie_memory_checksum()) {
+				printf("%s: frame %d differs from the recording\n", path, frames);
+				libatari800_movie_close(movie);
+				return FALSE;
+			}
+			libatari800_next_frame(&input);
+			frames++;
+		}
+		start = Util_time() - start;
+		crc = libatari800_movie_memory_checksum();
+		if (r > 0 && (crc != result->crc || frames != result->frames)) {
+			printf("%s: run %d ends differently from the first\n", path, r + 1);
+			libatari800_movie_close(movie);
+			return FALSE;
+		}
+		result->crc = crc;
+		result->frames = frames;
+		if (start > 0 && frames / start > result->fps)
+			result->fps = frames / start;
+	}
+	libatari800_movie_close(movie);
+	return TRUE;
+}
+
+int main(int argc, char **argv)
+{
+	const char *baseline_file = NULL;
+	double tolerance = DEFAULT_TOLERANCE;
+	int runs = DEFAULT_RUNS;
+	int update = FALSE;
+	entry_t *results;
+	int first, end, i;
+	int failed = 0;
+
+	for (i = 1; i < argc && argv[i][0] == '-' && strcmp(argv[i], "--") != 0; i++) {
+		if (strcmp(argv[i], "-baseline") == 0 && i + 1 < argc)
+			baseline_file = argv[++i];
+		else if (strcmp(argv[i], "-update") == 0)
+			update = TRUE;
+		else if (strcmp(argv[i], "-tolerance") == 0 && i + 1 < argc)
+			tolerance = atof(argv[++i]);
+		else if (strcmp(argv[i], "-runs") == 0 && i + 1 < argc)
+			runs = atoi(argv[++i]);
+		else {
+			usage();
+			return 2;
+		}
+	}
+	first = i;
+	for (end = first; end < argc && strcmp(argv[end], "--") != 0; end++)
+		;
+	for (i = first; i < end; i++)
+		add_path(argv[i]);
+	if (num_movies == 0 || runs < 1 || tolerance < 0 || (update && baseline_file == NULL)) {
+		usage();
+		return 2;
+	}
+	if (end < argc)
+		end++;
+	if (baseline_file != NULL && !update && !read_baseline(baseline_file))
+		return 2;
+	/* libatari800_init() puts its own program name in front */
+	if (!libatari800_init(argc - end, argv + end)) {
+		printf("bad emulator options\n");
+		return 2;
+	}
+	/* Draw every frame, as with a display */
+	libatari800_set_render_policy(LIBATARI800_RENDER_ALWAYS, 0);
+
+	results = (entry_t *)Util_malloc(num_movies * sizeof(entry_t));
+	for (i = 0; i < num_movies; i++) {
+		entry_t *r = &results[i];
+		const entry_t *base;
+		if (!play(movies[i], runs, r)) {
+			r->frames = 0;
+			failed++;
+			continue;
+		}
+		printf("%s: %d frames, memory %08lx, %.1f fps", movies[i], r->frames, (unsigned long)r->crc, r->fps);
+		base = update ? NULL : find_baseline(r->name);
+		if (base == NULL) {
+			printf(baseline_file != NULL && !update ? ", not in the baseline\n" : "\n");
+			continue;
+		}
+		printf(" (baseline %.1f, %+.1f%%)", base->fps, base->fps > 0 ? (r->fps / base->fps - 1) * 100 : 0.0);
+		if (r->crc != base->crc || r->frames != base->frames) {
+			printf(": memory differs from the baseline's %08lx\n", (unsigned long)base->crc);
+			failed++;
+		}
+		else if (r->fps < base->fps * (1 - tolerance / 100)) {
+			printf(": slower than the %.0f%% tolerance\n", tolerance);
+			failed++;
+		}
+		else
+			printf("\n");
+	}
+
+	if (update && !write_baseline(baseline_file, results, num_movies)) {
+		printf("cannot write %s\n", baseline_file);
+		failed++;
+	}
+	printf("%d movies: %s\n", num_movies, failed ? "FAILED" : "OK");
+	for (i = 0; i < num_movies; i++)
+		free(movies[i]);
+	free(movies);
+	free(results);
+	free(baseline);
+	libatari800_exit();
+	return failed ? 1 : 0;
+}
@@ -0,0 +1,316 @@
+/*
+ * libatari800/movie_render.c - render movies to video files headless
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+/* Plays movies (a starting state and the input of every frame, see
+   movie.c) and records each to a video file through the emulator's
+   codecs, as fast as the emulation runs: there is no display, no sound
+   device and no waiting for the frame rate. Arguments that are directories
+   stand for the movies in them. Movies are rendered in parallel, one
+   worker process per core taking the next movie as it finishes one: the
+   emulator and the recording code keep their state in globals, so
+   processes are the unit of parallelism, as in movie_verify. Each movie
+   is played in a process of its own, forked from the emulator as it was
+   just set up: a state file does not hold everything (the sound engines'
+   sample clock, for one), so a movie played after another could record
+   slightly different audio, and a file would depend on the number of
+   jobs. */
+
+#include "config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef HAVE_OPENDIR
+#include <dirent.h>
+#endif
+#ifdef HAVE_SYS_STAT_H
+#include <sys/stat.h>
+#endif
+#ifdef HAVE_FORK
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#endif
+
+#include "libatari800.h"
+#include "util.h"
+
+typedef struct {
+	int job;
+	int frames;      /* frames recorded */
+	int error;       /* 1: not a movie, 2: cannot write the output,
+	                    3: the emulator crashed */
+	double seconds;
+} result_t;
+
+static char **movies = NULL;
+static int num_movies = 0;
+static const char *out_dir = ".";
+static const char *out_type = "avi";
+
+static void usage(void)
+{
+	printf("usage: movie_render [-j jobs] [-d dir] [-t type] movie|directory... [-- emulator options]\n");
+}
+
+static void add_movie(const char *path)
+{
+	movies = (char **)Util_realloc(movies, (num_movies + 1) * sizeof(char *));
+	movies[num_movies++] = Util_strdup(path);
+}
+
+static int compare_names(const void *a, const void *b)
+{
+	return strcmp(*(char * const *)a, *(char * const *)b);
+}
+
+/* Adds the movies in DIR in name order, or DIR itself if it is a file */
+static void add_path(const char *path)
+{
+#if defined(HAVE_OPENDIR) && defined(HAVE_STAT)
+	struct stat st;
+	if (stat(path, &st) == 0 && S_ISDIR(st.st_mode)) {
+		DIR *dir = opendir(path);
+		struct dirent *entry;
+		int first = num_movies;
+		if (dir == NULL) {
+			printf("cannot read %s\n", path);
+			return;
+		}
+		while ((entry = readdir(dir)) != NULL) {
+			char name[FILENAME_MAX];
+			char magic[4];
+			FILE *fp;
+			Util_catpath(name, path, entry->d_name);
+			if (stat(name, &st) != 0 || !S_ISREG(st.st_mode))
+				continue;
+			/* Only files that start like a movie */
+			fp = fopen(name, "rb");
+			if (fp == NULL)
+				continue;
+			if (fread(magic, 1, 4, fp) == 4 && memcmp(magic, "A8MV", 4) == 0)
+				add_movie(name);
+			fclose(fp);
+		}
+		closedir(dir);
+		qsort(movies + first, num_movies - first, sizeof(char *), compare_names);
+		return;
+	}
+#endif
+	add_movie(path);
+}
+
+/* The output file of movie JOB: its name in out_dir, with out_type as the
+   extension */
+static void output_name(int job, char *buffer)
+{
+	char dir[FILENAME_MAX];
+	char file[FILENAME_MAX];
+	char *dot;
+	Util_splitpath(movies[job], dir, file);
+	dot = strrchr(file, '.');
+	if (dot != NULL && dot != file)
+		*dot = '\0';
+	if (strlen(file) + strlen(out_type) + 2 <= FILENAME_MAX) {
+		strcat(file, ".");
+		strcat(file, out_type);
+	}
+	Util_catpath(buffer, out_dir, file);
+}
+
+static void render(int job, result_t *result)
+{
+	libatari800_movie_t *movie;
+	input_template_t input;
+	char output[FILENAME_MAX];
+	double start = Util_time();
+
+	memset(result, 0, sizeof(result_t));
+	result->job = job;
+	movie = libatari800_movie_open(movies[job]);
+	if (movie == NULL) {
+		result->error = 1;
+		return;
+	}
+	output_name(job, output);
+	if (!libatari800_start_recording(output)) {
+		libatari800_movie_close(movie);
+		result->error = 2;
+		return;
+	}
+	while (libatari800_movie_next_input(movie, &input)) {
+		libatari800_next_frame(&input);
+		result->frames++;
+	}
+	libatari800_movie_close(movie);
+	if (!libatari800_stop_recording())
+		result->error = 2;
+	result->seconds = Util_time() - start;
+}
+
+static void report(const result_t *result)
+{
+	char output[FILENAME_MAX];
+	if (result->error == 1) {
+		printf("%s: not a movie\n", movies[result->job]);
+		return;
+	}
+	output_name(result->job, output);
+	if (result->error == 2)
+		printf("%s: cannot write %s\n", movies[result->job], output);
+	else if (result->error == 3)
+		printf("%s: emulator crashed\n", movies[result->job]);
+	else
+		printf("%s: %d frames to %s in %.1f s (%.0f fps)\n", movies[result->job], result->frames, output,
+			result->seconds, result->seconds > 0 ? result->frames / result->seconds : 0.0);
+	fflush(stdout);
+}
+
+int main(int argc, char **argv)
+{
+	int jobs = 0;
+	int first, end, i, w;
+	int frames = 0, failed = 0;
+	double start;
+
+	for (i = 1; i < argc && argv[i][0] == '-' && strcmp(argv[i], "--") != 0; i++) {
+		if (strcmp(argv[i], "-j") == 0 && i + 1 < argc)
+			jobs = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc)
+			out_dir = argv[++i];
+		else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+			out_type = argv[++i];
+		else {
+			usage();
+			return 2;
+		}
+	}
+	first = i;
+	for (end = first; end < argc && strcmp(argv[end], "--") != 0; end++)
+		;
+	for (i = first; i < end; i++)
+		add_path(argv[i]);
+	if (num_movies == 0) {
+		usage();
+		return 2;
+	}
+	if (end < argc)
+		end++;
+	/* libatari800_init() puts its own program name in front */
+	if (!libatari800_init(argc - end, argv + end)) {
+		printf("bad emulator options\n");
+		return 2;
+	}
+	/* Every frame goes into the video */
+	libatari800_set_render_policy(LIBATARI800_RENDER_ALWAYS, 0);
+
+#if defined(HAVE_SYSCONF) && defined(_SC_NPROCESSORS_ONLN)
+	if (jobs <= 0)
+		jobs = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+	if (jobs <= 0)
+		jobs = 1;
+	if (jobs > num_movies)
+		jobs = num_movies;
+	start = Util_time();
+
+#ifdef HAVE_FORK
+	{
+		/* Workers read the number of the next movie from one pipe and write
+		   their results to another; both are written in pieces smaller
+		   than PIPE_BUF, which pipes keep whole. A few movies are handed
+		   out ahead, then one more for each result, so neither pipe fills
+		   up. */
+		int todo[2], done[2];
+		FILE *results;
+		result_t result;
+		int received = 0;
+		int next = 0;
+		if (pipe(todo) < 0 || pipe(done) < 0) {
+			printf("cannot start workers\n");
+			return 2;
+		}
+		fflush(stdout);
+		for (w = 0; w < jobs; w++) {
+			pid_t pid = fork();
+			if (pid < 0) {
+				printf("cannot start worker %d\n", w);
+				return 2;
+			}
+			if (pid == 0) {
+				int job;
+				close(todo[1]);
+				close(done[0]);
+				while (read(todo[0], &job, sizeof(job)) == sizeof(job)) {
+					int status;
+					pid_t player = fork();
+					if (player == 0) {
+						render(job, &result);
+						_exit(write(done[1], &result, sizeof(result)) == sizeof(result) ? 0 : 1);
+					}
+					if (player > 0 && waitpid(player, &status, 0) == player
+						&& WIFEXITED(status) && WEXITSTATUS(status) == 0)
+						continue;
+					/* No result from the player */
+					memset(&result, 0, sizeof(result));
+					result.job = job;
+					result.error = 3;
+					if (write(done[1], &result, sizeof(result)) != sizeof(result))
+						break;
+				}
+				_exit(0);
+			}
+		}
+		close(todo[0]);
+		close(done[1]);
+		while (next < num_movies && next < 2 * jobs && write(todo[1], &next, sizeof(next)) == sizeof(next))
+			next++;
+		/* Workers stop when the pipe is empty and closed */
+		if (next == num_movies)
+			close(todo[1]);
+		results = fdopen(done[0], "rb");
+		while (fread(&result, sizeof(result), 1, results) == 1) {
+			if (result.job < 0 || result.job >= num_movies)
+				continue;
+			report(&result);
+			frames += result.frames;
+			failed += result.error != 0;
+			received++;
+			if (next < num_movies && write(todo[1], &next, sizeof(next)) == sizeof(next)
+				&& ++next == num_movies)
+				close(todo[1]);
+		}
+		if (next < num_movies)
+			close(todo[1]);
+		fclose(results);
+		while (wait(NULL) > 0)
+			;
+		/* A worker that died takes its movie with it */
+		if (received < num_movies) {
+			printf("%d movies not rendered\n", num_movies - received);
+			failed += num_movies - received;
+		}
+	}
+#else
+	{
+		for (i = 0; i < num_movies; i++) {
+			result_t result;
+			render(i, &result);
+			report(&result);
+			frames += result.frames;
+			failed += result.error != 0;
+		}
+	}
+#endif
+
+	printf("%d movies, %d frames in %.1f s, %d jobs: %s\n", num_movies, frames, Util_time() - start, jobs,
+		failed ? "FAILED" : "OK");
+	for (i = 0; i < num_movies; i++)
+		free(movies[i]);
+	free(movies);
+	libatari800_exit();
+	return failed ? 1 : 0;
+}
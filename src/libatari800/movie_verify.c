@@ -0,0 +1,269 @@
+/*
+ * libatari800/movie_verify.c - check that a movie replays as recorded
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+/* Replays a movie and compares main memory at the start of every frame
+   with the checksum recorded in it. The movie is cut at its keyframes and
+   the segments are replayed in parallel, one worker process per core: the
+   emulator keeps its machine in globals, so processes are the unit of
+   parallelism.
+
+   A movie without keyframes can only be replayed from the start. -o writes
+   a copy with a keyframe every -keyframes frames, and checksums if the
+   movie had none, during one sequential pass that verifies as it goes;
+   later checks of the copy then run on all cores. */
+
+#include "config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef HAVE_FORK
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#endif
+
+#include "libatari800.h"
+
+typedef struct {
+	int segment;
+	int bad_frame;   /* first frame that differs, -1 = none */
+	int checked;     /* frames compared with a recorded checksum */
+	int unchecked;   /* frames played without one */
+	int error;       /* the segment could not be played */
+} result_t;
+
+static const char *movie_path;
+
+static void usage(void)
+{
+	printf("usage: movie_verify [-j jobs] [-keyframes frames -o output] movie [emulator options]\n");
+}
+
+/* Play frames first .. end - 1, starting at the keyframe of first */
+static void play_segment(libatari800_movie_t *movie, int segment, int first, int end, result_t *result)
+{
+	input_template_t input;
+
+	memset(result, 0, sizeof(result_t));
+	result->segment = segment;
+	result->bad_frame = -1;
+	if (!libatari800_movie_seek(movie, segment)) {
+		result->error = TRUE;
+		return;
+	}
+	while (libatari800_movie_frames(movie) < end && libatari800_movie_next_input(movie, &input)) {
+		ULONG sum;
+		if (!libatari800_movie_recorded_checksum(movie, &sum))
+			result->unchecked++;
+		else if (sum != libatari800_movie_memory_checksum()) {
+			result->bad_frame = libatari800_movie_frames(movie) - 1;
+			return;
+		}
+		else
+			result->checked++;
+		libatari800_next_frame(&input);
+	}
+	if (libatari800_movie_frames(movie) < end)
+		result->error = TRUE;
+}
+
+/* Sequential pass writing a copy of the movie with keyframes */
+static int rewrite(libatari800_movie_t *movie, const char *output, int interval, result_t *result)
+{
+	libatari800_movie_t *copy;
+	input_template_t input;
+
+	memset(result, 0, sizeof(result_t));
+	result->bad_frame = -1;
+	copy = libatari800_movie_record(output);
+	if (copy == NULL) {
+		printf("cannot write %s\n", output);
+		return FALSE;
+	}
+	libatari800_movie_set_checksums(copy, TRUE);
+	while (libatari800_movie_next_input(movie, &input)) {
+		int frame = libatari800_movie_frames(movie) - 1;
+		ULONG sum;
+		if (frame > 0 && frame % interval == 0)
+			libatari800_movie_add_keyframe(copy);
+		if (!libatari800_movie_recorded_checksum(movie, &sum))
+			result->unchecked++;
+		else if (sum != libatari800_movie_memory_checksum()) {
+			if (result->bad_frame < 0)
+				result->bad_frame = frame;
+		}
+		else
+			result->checked++;
+		libatari800_movie_add_frame(copy, &input);
+		libatari800_next_frame(&input);
+	}
+	if (!libatari800_movie_close(copy)) {
+		printf("cannot write %s\n", output);
+		return FALSE;
+	}
+	return TRUE;
+}
+
+/* Play the segments worker, worker + jobs, ... and write their results */
+static void run_worker(int worker, int jobs, const int *keys, int num_keys, int length, FILE *out)
+{
+	libatari800_movie_t *movie = libatari800_movie_open(movie_path);
+	int s;
+
+	for (s = worker; s < num_keys; s += jobs) {
+		result_t result;
+		if (movie == NULL) {
+			memset(&result, 0, sizeof(result));
+			result.segment = s;
+			result.bad_frame = -1;
+			result.error = TRUE;
+		}
+		else
+			play_segment(movie, s, keys[s], s + 1 < num_keys ? keys[s + 1] : length, &result);
+		fwrite(&result, sizeof(result), 1, out);
+	}
+	fflush(out);
+	if (movie != NULL)
+		libatari800_movie_close(movie);
+}
+
+int main(int argc, char **argv)
+{
+	libatari800_movie_t *movie;
+	const char *output = NULL;
+	int interval = 0;
+	int jobs = 0;
+	int *keys;
+	int num_keys, length, i, w;
+	int checked = 0, unchecked = 0, failed = FALSE;
+	result_t *results;
+
+	for (i = 1; i < argc && argv[i][0] == '-'; i++) {
+		if (strcmp(argv[i], "-j") == 0 && i + 1 < argc)
+			jobs = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-keyframes") == 0 && i + 1 < argc)
+			interval = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+			output = argv[++i];
+		else {
+			usage();
+			return 2;
+		}
+	}
+	if (i >= argc || (output != NULL) != (interval > 0)) {
+		usage();
+		return 2;
+	}
+	movie_path = argv[i];
+	if (!libatari800_init(argc - i - 1, argv + i + 1)) {
+		printf("bad emulator options\n");
+		return 2;
+	}
+	libatari800_set_render_policy(LIBATARI800_RENDER_OBSERVED, 0);
+
+	movie = libatari800_movie_open(movie_path);
+	if (movie == NULL) {
+		printf("%s: not a movie\n", movie_path);
+		return 2;
+	}
+
+	if (output != NULL) {
+		result_t result;
+		if (!rewrite(movie, output, interval, &result))
+			return 2;
+		libatari800_movie_close(movie);
+		printf("%s: %d frames, %d checked, %d without checksums, wrote %s\n", movie_path,
+			result.checked + result.unchecked, result.checked, result.unchecked, output);
+		if (result.bad_frame >= 0) {
+			printf("frame %d differs from the recording\n", result.bad_frame);
+			return 1;
+		}
+		return 0;
+	}
+
+	num_keys = libatari800_movie_keyframes(movie, NULL, 0);
+	keys = (int *)malloc(num_keys * sizeof(int));
+	libatari800_movie_keyframes(movie, keys, num_keys);
+	length = libatari800_movie_length(movie);
+	results = (result_t *)calloc(num_keys, sizeof(result_t));
+#if defined(HAVE_SYSCONF) && defined(_SC_NPROCESSORS_ONLN)
+	if (jobs <= 0)
+		jobs = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+	if (jobs <= 0)
+		jobs = 1;
+	if (jobs > num_keys)
+		jobs = num_keys;
+	printf("%s: %d frames, %d segments, %d jobs\n", movie_path, length, num_keys, jobs);
+
+#ifdef HAVE_FORK
+	if (jobs > 1) {
+		FILE **pipes = (FILE **)calloc(jobs, sizeof(FILE *));
+		/* Each worker opens the movie again: a forked FILE shares its
+		   file position with the parent's */
+		libatari800_movie_close(movie);
+		movie = NULL;
+		for (w = 0; w < jobs; w++) {
+			int fd[2];
+			pid_t pid;
+			if (pipe(fd) < 0 || (pid = fork()) < 0) {
+				printf("cannot start worker %d\n", w);
+				return 2;
+			}
+			if (pid == 0) {
+				FILE *out = fdopen(fd[1], "wb");
+				close(fd[0]);
+				run_worker(w, jobs, keys, num_keys, length, out);
+				_exit(0);
+			}
+			close(fd[1]);
+			pipes[w] = fdopen(fd[0], "rb");
+		}
+		for (w = 0; w < jobs; w++) {
+			result_t result;
+			while (fread(&result, sizeof(result), 1, pipes[w]) == 1)
+				if (result.segment >= 0 && result.segment < num_keys)
+					results[result.segment] = result;
+			fclose(pipes[w]);
+		}
+		while (wait(NULL) > 0)
+			;
+		free(pipes);
+		/* A worker that died leaves its segments unplayed */
+		for (i = 0; i < num_keys; i++)
+			if (results[i].checked + results[i].unchecked == 0 && results[i].bad_frame < 0
+				&& (i + 1 < num_keys ? keys[i + 1] : length) > keys[i])
+				results[i].error = TRUE;
+	}
+	else
+#endif
+	{
+		for (i = 0; i < num_keys; i++)
+			play_segment(movie, i, keys[i], i + 1 < num_keys ? keys[i + 1] : length, &results[i]);
+		libatari800_movie_close(movie);
+	}
+
+	for (i = 0; i < num_keys; i++) {
+		checked += results[i].checked;
+		unchecked += results[i].unchecked;
+		if (results[i].error) {
+			printf("segment %d (frame %d): cannot be played\n", i, keys[i]);
+			failed = TRUE;
+		}
+		else if (results[i].bad_frame >= 0) {
+			printf("segment %d (frame %d): frame %d differs from the recording\n", i, keys[i], results[i].bad_frame);
+			failed = TRUE;
+		}
+	}
+	printf("%d frames checked, %d without checksums: %s\n", checked, unchecked, failed ? "FAILED" : "OK");
+	if (num_keys == 1 && length > 0)
+		printf("no keyframes; -keyframes and -o write a copy that verifies in parallel\n");
+	free(keys);
+	free(results);
+	libatari800_exit();
+	return failed ? 1 : 0;
+}
@@ -0,0 +1,1138 @@
+/*
+ * libatari800/python_module.c - CPython extension module over libatari800
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+/* The module "libatari800", built by "make python-module" in a libatari800
+   build configured with -fPIC in CFLAGS. It is a thin layer over the C
+   API: the screen, memory, sound and input are memoryviews over the
+   emulator's own buffers, and observations, features and snapshots go
+   into buffers the caller owns, such as numpy arrays, so stepping copies
+   nothing into Python objects.
+
+       import libatari800 as a8, numpy as np
+       a8.init(["-xl", "game.xex"])
+       screen = np.asarray(a8.screen()).reshape(240, 384)
+       inp = a8.input()              # writable, INPUT_SIZE bytes
+       inp[a8.INPUT_FIELDS["joy0"]] = 14
+       a8.next_frames(4, a8.FRAMES_MAXPOOL)
+
+   The GIL is released while frames run, so other Python threads (such as
+   one reading screens with acquire_screen()) carry on. Emulation itself is
+   serialised by a lock of the module's: the contexts share the emulator's
+   globals, so two threads stepping at once would run one after the other
+   anyway. The views of the screen, memory and sound stay valid until
+   another context is selected or the module is unloaded; buffers passed
+   to set_features() and set_observation_buffer() are kept alive for as
+   long as the selected context uses them.
+
+   vecenv_new() and the vecenv_ functions are the native vectorized
+   environment (see libatari800/vecenv.c) a Gymnasium VectorEnv wraps:
+   vecenv_step() steps all the environments with the GIL released and
+   returns views of its observations, rewards and end flags. */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include <errno.h>
+#include <pythread.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "libatari800.h"
+
+static PyThread_type_lock emu_lock = NULL;
+
+/* Run the statements with the GIL released and the emulator to themselves */
+#define EMULATE(stmts) \
+	Py_BEGIN_ALLOW_THREADS \
+	PyThread_acquire_lock(emu_lock, WAIT_LOCK); \
+	stmts; \
+	PyThread_release_lock(emu_lock); \
+	Py_END_ALLOW_THREADS
+
+static input_template_t input;
+
+/* Buffers in use by the emulator, by (context, name), so they outlive the
+   Python objects the caller may drop */
+static PyObject *held = NULL;
+static atari800_ctx_t *selected = NULL;
+
+#define CTX_CAPSULE "libatari800.ctx"
+
+static int hold(const char *name, Py_buffer *view)
+{
+	PyObject *key, *mv = NULL;
+	int r;
+
+	if (view != NULL && (mv = PyMemoryView_FromObject(view->obj)) == NULL)
+		return -1;
+	key = Py_BuildValue("(ns)", (Py_ssize_t)selected, name);
+	if (key == NULL) {
+		Py_XDECREF(mv);
+		return -1;
+	}
+	if (mv != NULL)
+		r = PyDict_SetItem(held, key, mv);
+	else if ((r = PyDict_DelItem(held, key)) < 0 && PyErr_ExceptionMatches(PyExc_KeyError)) {
+		PyErr_Clear();
+		r = 0;
+	}
+	Py_DECREF(key);
+	Py_XDECREF(mv);
+	return r;
+}
+
+/* Gets a C-contiguous buffer of at least size bytes */
+static int get_buffer(PyObject *obj, Py_buffer *view, Py_ssize_t size, int writable, const char *what)
+{
+	if (PyObject_GetBuffer(obj, view, writable ? PyBUF_CONTIG : PyBUF_CONTIG_RO) < 0)
+		return -1;
+	if (view->len < size) {
+		PyErr_Format(PyExc_ValueError, "%s needs %zd bytes, got %zd", what, size, view->len);
+		PyBuffer_Release(view);
+		return -1;
+	}
+	return 0;
+}
+
+static atari800_ctx_t *get_ctx(PyObject *obj)
+{
+	if (obj == Py_None)
+		return NULL;
+	return (atari800_ctx_t *)PyCapsule_GetPointer(obj, CTX_CAPSULE);
+}
+
+static PyObject *view_of(void *ptr, Py_ssize_t size, int writable)
+{
+	if (ptr == NULL)
+		Py_RETURN_NONE;
+	return PyMemoryView_FromMemory((char *)ptr, size, writable ? PyBUF_WRITE : PyBUF_READ);
+}
+
+/* === Machine === */
+
+static PyObject *py_init(PyObject *self, PyObject *args)
+{
+	PyObject *list, *seq;
+	char **argv;
+	Py_ssize_t i, n;
+	int ok;
+
+	if (!PyArg_ParseTuple(args, "O", &list))
+		return NULL;
+	if ((seq = PySequence_Fast(list, "init() takes a list of options")) == NULL)
+		return NULL;
+	n = PySequence_Fast_GET_SIZE(seq);
+	argv = (char **)PyMem_Malloc((n + 2) * sizeof(char *));
+	if (argv == NULL) {
+		Py_DECREF(seq);
+		return PyErr_NoMemory();
+	}
+	argv[0] = (char *)"atari800";
+	for (i = 0; i < n; i++) {
+		argv[i + 1] = (char *)PyUnicode_AsUTF8(PySequence_Fast_GET_ITEM(seq, i));
+		if (argv[i + 1] == NULL) {
+			PyMem_Free(argv);
+			Py_DECREF(seq);
+			return NULL;
+		}
+	}
+	argv[n + 1] = NULL;
+	EMULATE(ok = libatari800_init((int)n + 1, argv));
+	PyMem_Free(argv);
+	Py_DECREF(seq);
+	libatari800_clear_input_array(&input);
+	return PyBool_FromLong(ok);
+}
+
+static PyObject *py_input(PyObject *self, PyObject *args)
+{
+	return view_of(&input, sizeof(input), TRUE);
+}
+
+static PyObject *py_next_frame(PyObject *self, PyObject *args)
+{
+	int ok;
+
+	EMULATE(ok = libatari800_next_frame(&input));
+	return PyBool_FromLong(ok);
+}
+
+static PyObject *py_next_frames(PyObject *self, PyObject *args)
+{
+	int frames, flags = 0, ran;
+
+	if (!PyArg_ParseTuple(args, "i|i", &frames, &flags))
+		return NULL;
+	EMULATE(ran = libatari800_next_frames(&input, frames, flags));
+	return PyLong_FromLong(ran);
+}
+
+static PyObject *py_set_pots(PyObject *self, PyObject *args)
+{
+	PyObject *list = Py_None, *seq;
+	int pots[8], i;
+
+	if (!PyArg_ParseTuple(args, "|O", &list))
+		return NULL;
+	if (list == Py_None) {
+		EMULATE(libatari800_set_pots(NULL));
+		Py_RETURN_NONE;
+	}
+	if ((seq = PySequence_Fast(list, "pots are a list of 8 values")) == NULL)
+		return NULL;
+	if (PySequence_Fast_GET_SIZE(seq) != 8) {
+		Py_DECREF(seq);
+		PyErr_SetString(PyExc_ValueError, "pots are a list of 8 values");
+		return NULL;
+	}
+	for (i = 0; i < 8; i++) {
+		pots[i] = (int)PyLong_AsLong(PySequence_Fast_GET_ITEM(seq, i));
+		if (pots[i] == -1 && PyErr_Occurred()) {
+			Py_DECREF(seq);
+			return NULL;
+		}
+	}
+	Py_DECREF(seq);
+	EMULATE(libatari800_set_pots(pots));
+	Py_RETURN_NONE;
+}
+
+static PyObject *py_screen(PyObject *self, PyObject *args)
+{
+	return view_of(libatari800_get_screen_ptr(), 384 * 240, FALSE);
+}
+
+static PyObject *py_memory(PyObject *self, PyObject *args)
+{
+	return view_of(libatari800_get_main_memory_ptr(), 0x10000, TRUE);
+}
+
+static PyObject *py_sound(PyObject *self, PyObject *args)
+{
+	return view_of(libatari800_get_sound_buffer(), libatari800_get_sound_buffer_len(), FALSE);
+}
+
+static PyObject *py_sound_format(PyObject *self, PyObject *args)
+{
+	return Py_BuildValue("(iii)", libatari800_get_sound_frequency(),
+		libatari800_get_num_sound_channels(), libatari800_get_sound_sample_size());
+}
+
+static PyObject *py_set_sound_format(PyObject *self, PyObject *args)
+{
+	int freq, channels, format, ok;
+
+	if (!PyArg_ParseTuple(args, "iii", &freq, &channels, &format))
+		return NULL;
+	EMULATE(ok = libatari800_set_sound_format(freq, channels, format));
+	return PyBool_FromLong(ok);
+}
+
+static PyObject *py_frame_number(PyObject *self, PyObject *args)
+{
+	return PyLong_FromLong(libatari800_get_frame_number());
+}
+
+static PyObject *py_error_message(PyObject *self, PyObject *args)
+{
+	return PyUnicode_FromString(libatari800_error_message());
+}
+
+/* === Observations and features === */
+
+static PyObject *py_get_observation(PyObject *self, PyObject *args)
+{
+	PyObject *obj;
+	Py_buffer view;
+	int width, height, format = LIBATARI800_OBS_GRAY, x1 = 0, y1 = 0, x2 = 0, y2 = 0, n;
+
+	if (!PyArg_ParseTuple(args, "Oii|iiiii", &obj, &width, &height, &format, &x1, &y1, &x2, &y2))
+		return NULL;
+	if (get_buffer(obj, &view, (Py_ssize_t)width * height, TRUE, "observation") < 0)
+		return NULL;
+	EMULATE(n = libatari800_get_observation((UBYTE *)view.buf, width, height, format, x1, y1, x2, y2));
+	PyBuffer_Release(&view);
+	return PyLong_FromLong(n);
+}
+
+static PyObject *py_screen_hash(PyObject *self, PyObject *args)
+{
+	uint64_t hash;
+
+	EMULATE(hash = libatari800_get_screen_hash());
+	return PyLong_FromUnsignedLongLong(hash);
+}
+
+static PyObject *py_state_hash(PyObject *self, PyObject *args)
+{
+	uint64_t hash;
+
+	EMULATE(hash = libatari800_get_state_hash());
+	return PyLong_FromUnsignedLongLong(hash);
+}
+
+static PyObject *py_set_observation_buffer(PyObject *self, PyObject *args)
+{
+	PyObject *obj;
+	Py_buffer view;
+	int width = 0, height = 0, format = LIBATARI800_OBS_GRAY, x1 = 0, y1 = 0, x2 = 0, y2 = 0, ok;
+
+	if (!PyArg_ParseTuple(args, "O|iiiiiii", &obj, &width, &height, &format, &x1, &y1, &x2, &y2))
+		return NULL;
+	if (obj == Py_None) {
+		EMULATE(ok = libatari800_set_observation_buffer(NULL, 0, 0, 0, 0, 0, 0, 0));
+		if (hold("observation", NULL) < 0)
+			return NULL;
+		return PyBool_FromLong(ok);
+	}
+	if (get_buffer(obj, &view, (Py_ssize_t)width * height, TRUE, "observation buffer") < 0)
+		return NULL;
+	EMULATE(ok = libatari800_set_observation_buffer((UBYTE *)view.buf, width, height, format, x1, y1, x2, y2));
+	if (ok && hold("observation", &view) < 0)
+		ok = -1;
+	PyBuffer_Release(&view);
+	if (ok < 0)
+		return NULL;
+	return PyBool_FromLong(ok);
+}
+
+/* Features are (kind, addr[, len[, mask[, delta[, scale]]]]) tuples;
+   returns how many there are, or -1 */
+static int parse_features(PyObject *list, feature_template_t *defs)
+{
+	PyObject *seq;
+	Py_ssize_t i, n;
+
+	if ((seq = PySequence_Fast(list, "features are a list of tuples")) == NULL)
+		return -1;
+	n = PySequence_Fast_GET_SIZE(seq);
+	if (n > LIBATARI800_MAX_FEATURES) {
+		Py_DECREF(seq);
+		PyErr_Format(PyExc_ValueError, "at most %d features", LIBATARI800_MAX_FEATURES);
+		return -1;
+	}
+	for (i = 0; i < n; i++) {
+		feature_template_t *d = &defs[i];
+		d->len = 1;
+		d->mask = 0xff;
+		d->delta = 0;
+		d->scale = 1.0f;
+		if (!PyArg_ParseTuple(PySequence_Fast_GET_ITEM(seq, i), "ii|iiif;features are (kind, addr, len, mask, delta, scale)",
+				&d->kind, &d->addr, &d->len, &d->mask, &d->delta, &d->scale)) {
+			Py_DECREF(seq);
+			return -1;
+		}
+	}
+	Py_DECREF(seq);
+	return (int)n;
+}
+
+static PyObject *py_set_features(PyObject *self, PyObject *args)
+{
+	PyObject *list, *obj = Py_None;
+	feature_template_t defs[LIBATARI800_MAX_FEATURES];
+	Py_buffer view;
+	int n, ok;
+
+	if (!PyArg_ParseTuple(args, "O|O", &list, &obj))
+		return NULL;
+	if ((n = parse_features(list, defs)) < 0)
+		return NULL;
+	if (n == 0) {
+		EMULATE(ok = libatari800_set_features(NULL, 0, NULL));
+		if (hold("features", NULL) < 0)
+			return NULL;
+		return PyBool_FromLong(ok);
+	}
+	if (obj == Py_None) {
+		PyErr_SetString(PyExc_TypeError, "set_features() needs a buffer of float32 for the values");
+		return NULL;
+	}
+	if (get_buffer(obj, &view, n * (Py_ssize_t)sizeof(float), TRUE, "features") < 0)
+		return NULL;
+	EMULATE(ok = libatari800_set_features(defs, n, (float *)view.buf));
+	if (ok && hold("features", &view) < 0)
+		ok = -1;
+	PyBuffer_Release(&view);
+	if (ok < 0)
+		return NULL;
+	if (!ok) {
+		PyErr_SetString(PyExc_ValueError, "invalid feature");
+		return NULL;
+	}
+	Py_RETURN_TRUE;
+}
+
+/* === Screen ring === */
+
+static PyObject *py_set_screen_buffers(PyObject *self, PyObject *args)
+{
+	int n, ok;
+
+	if (!PyArg_ParseTuple(args, "i", &n))
+		return NULL;
+	EMULATE(ok = libatari800_set_screen_buffers(n));
+	return PyBool_FromLong(ok);
+}
+
+/* Returns (view, frame) or None; pass the view to release_screen() */
+static PyObject *py_acquire_screen(PyObject *self, PyObject *args)
+{
+	const UBYTE *screen;
+	PyObject *view;
+	int frame;
+
+	Py_BEGIN_ALLOW_THREADS
+	screen = libatari800_acquire_screen(&frame);
+	Py_END_ALLOW_THREADS
+	if (screen == NULL)
+		Py_RETURN_NONE;
+	if ((view = view_of((void *)screen, 384 * 240, FALSE)) == NULL) {
+		libatari800_release_screen(screen);
+		return NULL;
+	}
+	return Py_BuildValue("(Ni)", view, frame);
+}
+
+static PyObject *py_release_screen(PyObject *self, PyObject *args)
+{
+	PyObject *obj;
+
+	if (!PyArg_ParseTuple(args, "O!", &PyMemoryView_Type, &obj))
+		return NULL;
+	libatari800_release_screen((const UBYTE *)PyMemoryView_GET_BUFFER(obj)->buf);
+	Py_RETURN_NONE;
+}
+
+/* === Snapshots === */
+
+/* save_snapshot() returns bytes; save_snapshot(buffer) saves into it and
+   returns the size, 0 if it does not fit */
+static PyObject *py_save_snapshot(PyObject *self, PyObject *args)
+{
+	PyObject *obj = Py_None, *bytes;
+	Py_buffer view;
+	int size;
+
+	if (!PyArg_ParseTuple(args, "|O", &obj))
+		return NULL;
+	if (obj != Py_None) {
+		if (get_buffer(obj, &view, 0, TRUE, "snapshot") < 0)
+			return NULL;
+		EMULATE(size = libatari800_save_snapshot((UBYTE *)view.buf,
+			view.len > INT_MAX ? INT_MAX : (int)view.len));
+		PyBuffer_Release(&view);
+		return PyLong_FromLong(size);
+	}
+	size = libatari800_save_snapshot(NULL, 0);
+	if ((bytes = PyBytes_FromStringAndSize(NULL, size)) == NULL)
+		return NULL;
+	EMULATE(size = libatari800_save_snapshot((UBYTE *)PyBytes_AS_STRING(bytes), size));
+	if (size == 0) {
+		Py_DECREF(bytes);
+		PyErr_SetString(PyExc_RuntimeError, "snapshot failed");
+		return NULL;
+	}
+	return bytes;
+}
+
+static PyObject *py_restore_snapshot(PyObject *self, PyObject *args)
+{
+	PyObject *obj;
+	Py_buffer view;
+	int ok;
+
+	if (!PyArg_ParseTuple(args, "O", &obj))
+		return NULL;
+	if (get_buffer(obj, &view, 0, FALSE, "snapshot") < 0)
+		return NULL;
+	EMULATE(ok = libatari800_restore_snapshot((const UBYTE *)view.buf));
+	PyBuffer_Release(&view);
+	return PyBool_FromLong(ok);
+}
+
+/* restore_and_step_many(parent, inputs, frames[, children, stride[,
+   features]]) with inputs k * INPUT_SIZE bytes; returns (ok, sizes) */
+static PyObject *py_restore_and_step_many(PyObject *self, PyObject *args)
+{
+	PyObject *parent_obj, *inputs_obj, *children_obj = Py_None, *features_obj = Py_None, *sizes_list;
+	Py_buffer parent, inputs, children, features;
+	int frames, stride = 0, k, ok, i;
+	int *sizes;
+
+	if (!PyArg_ParseTuple(args, "OOi|OiO", &parent_obj, &inputs_obj, &frames, &children_obj, &stride, &features_obj))
+		return NULL;
+	if (get_buffer(parent_obj, &parent, 0, FALSE, "parent") < 0)
+		return NULL;
+	if (get_buffer(inputs_obj, &inputs, 0, TRUE, "inputs") < 0) {
+		PyBuffer_Release(&parent);
+		return NULL;
+	}
+	k = (int)(inputs.len / sizeof(input_template_t));
+	children.buf = features.buf = NULL;
+	children.obj = features.obj = NULL;
+	if ((children_obj != Py_None && get_buffer(children_obj, &children, (Py_ssize_t)k * stride, TRUE, "children") < 0)
+		|| (features_obj != Py_None && get_buffer(features_obj, &features, 0, TRUE, "features") < 0)
+		|| (sizes = (int *)PyMem_Calloc(k + 1, sizeof(int))) == NULL) {
+		if (children.obj != NULL)
+			PyBuffer_Release(&children);
+		if (features.obj != NULL)
+			PyBuffer_Release(&features);
+		PyBuffer_Release(&inputs);
+		PyBuffer_Release(&parent);
+		return PyErr_Occurred() ? NULL : PyErr_NoMemory();
+	}
+	EMULATE(ok = libatari800_restore_and_step_many((const UBYTE *)parent.buf, (input_template_t *)inputs.buf,
+		k, frames, (UBYTE *)children.buf, stride, sizes, (float *)features.buf));
+	if (children.obj != NULL)
+		PyBuffer_Release(&children);
+	if (features.obj != NULL)
+		PyBuffer_Release(&features);
+	PyBuffer_Release(&inputs);
+	PyBuffer_Release(&parent);
+	if (ok < 0) {
+		PyMem_Free(sizes);
+		PyErr_SetString(PyExc_ValueError, "invalid parent snapshot");
+		return NULL;
+	}
+	if ((sizes_list = PyList_New(k)) != NULL)
+		for (i = 0; i < k; i++)
+			PyList_SET_ITEM(sizes_list, i, PyLong_FromLong(sizes[i]));
+	PyMem_Free(sizes);
+	if (sizes_list == NULL)
+		return NULL;
+	return Py_BuildValue("(iN)", ok, sizes_list);
+}
+
+/* === Contexts === */
+
+static PyObject *py_ctx_new(PyObject *self, PyObject *args)
+{
+	atari800_ctx_t *ctx;
+
+	EMULATE(ctx = libatari800_ctx_new());
+	if (ctx == NULL) {
+		PyErr_SetString(PyExc_RuntimeError, "cannot create a context before init()");
+		return NULL;
+	}
+	return PyCapsule_New(ctx, CTX_CAPSULE, NULL);
+}
+
+static PyObject *py_ctx_select(PyObject *self, PyObject *args)
+{
+	PyObject *obj;
+	atari800_ctx_t *ctx;
+
+	if (!PyArg_ParseTuple(args, "O", &obj))
+		return NULL;
+	if ((ctx = get_ctx(obj)) == NULL && obj != Py_None)
+		return NULL;
+	EMULATE(libatari800_ctx_select(ctx));
+	selected = ctx;
+	Py_RETURN_NONE;
+}
+
+/* Drops the buffers a freed context held */
+static int unhold(atari800_ctx_t *ctx)
+{
+	static const char * const names[] = { "features", "observation" };
+	atari800_ctx_t *was = selected;
+	int i, r = 0;
+
+	selected = ctx;
+	for (i = 0; i < 2 && r == 0; i++)
+		r = hold(names[i], NULL);
+	selected = was;
+	return r;
+}
+
+static PyObject *py_ctx_free(PyObject *self, PyObject *args)
+{
+	PyObject *obj;
+	atari800_ctx_t *ctx;
+
+	if (!PyArg_ParseTuple(args, "O!", &PyCapsule_Type, &obj))
+		return NULL;
+	if ((ctx = get_ctx(obj)) == NULL)
+		return NULL;
+	EMULATE(libatari800_ctx_free(ctx));
+	if (selected == ctx)
+		selected = NULL;
+	/* Not again */
+	PyCapsule_SetName(obj, "libatari800.freed_ctx");
+	if (unhold(ctx) < 0)
+		return NULL;
+	Py_RETURN_NONE;
+}
+
+/* step_batch(ctxs, inputs, frames[, obs, width, height, format]) with
+   inputs len(ctxs) * INPUT_SIZE bytes and obs len(ctxs) * height * width;
+   None stands for the machine init() created */
+static PyObject *py_step_batch(PyObject *self, PyObject *args)
+{
+	PyObject *list, *seq, *inputs_obj, *obs_obj = Py_None;
+	Py_buffer inputs, obs;
+	atari800_ctx_t **ctxs;
+	int frames, width = 84, height = 84, format = LIBATARI800_OBS_GRAY, ok;
+	Py_ssize_t i, n;
+
+	if (!PyArg_ParseTuple(args, "OOi|Oiii", &list, &inputs_obj, &frames, &obs_obj, &width, &height, &format))
+		return NULL;
+	if ((seq = PySequence_Fast(list, "step_batch() takes a list of contexts")) == NULL)
+		return NULL;
+	n = PySequence_Fast_GET_SIZE(seq);
+	if ((ctxs = (atari800_ctx_t **)PyMem_Malloc((n + 1) * sizeof(atari800_ctx_t *))) == NULL) {
+		Py_DECREF(seq);
+		return PyErr_NoMemory();
+	}
+	for (i = 0; i < n; i++)
+		if ((ctxs[i] = get_ctx(PySequence_Fast_GET_ITEM(seq, i))) == NULL && PyErr_Occurred()) {
+			PyMem_Free(ctxs);
+			Py_DECREF(seq);
+			return NULL;
+		}
+	Py_DECREF(seq);
+	obs.buf = NULL;
+	if (get_buffer(inputs_obj, &inputs, n * (Py_ssize_t)sizeof(input_template_t), TRUE, "inputs") < 0) {
+		PyMem_Free(ctxs);
+		return NULL;
+	}
+	if (obs_obj != Py_None && get_buffer(obs_obj, &obs, n * width * height, TRUE, "observations") < 0) {
+		PyBuffer_Release(&inputs);
+		PyMem_Free(ctxs);
+		return NULL;
+	}
+	EMULATE(ok = libatari800_step_batch(ctxs, (input_template_t *)inputs.buf, (int)n, frames,
+		(UBYTE *)obs.buf, width, height, format));
+	/* It leaves the last of them selected */
+	if (n > 0)
+		selected = ctxs[n - 1];
+	if (obs.buf != NULL)
+		PyBuffer_Release(&obs);
+	PyBuffer_Release(&inputs);
+	PyMem_Free(ctxs);
+	return PyLong_FromLong(ok);
+}
+
+/* === Vectorized environments === */
+
+#define VECENV_CAPSULE "libatari800.vecenv"
+
+typedef struct {
+	libatari800_vecenv_t *v;
+	int n;
+	int size;   /* of an observation */
+} vecenv_t;
+
+static vecenv_t *get_vecenv(PyObject *obj)
+{
+	vecenv_t *e = (vecenv_t *)PyCapsule_GetPointer(obj, VECENV_CAPSULE);
+	if (e != NULL && e->v == NULL) {
+		PyErr_SetString(PyExc_ValueError, "vecenv was freed");
+		return NULL;
+	}
+	return e;
+}
+
+static PyObject *typed_view(void *ptr, Py_ssize_t size, const char *format)
+{
+	PyObject *view = view_of(ptr, size, FALSE), *typed;
+
+	if (view == NULL || format == NULL)
+		return view;
+	typed = PyObject_CallMethod(view, "cast", "s", format);
+	Py_DECREF(view);
+	return typed;
+}
+
+/* (obs, rewards, terminated, truncated, episode_frames) views, valid
+   until the step after the next */
+static PyObject *vecenv_result(vecenv_t *e, const libatari800_vecenv_result_t *r)
+{
+	return Py_BuildValue("(NNNNN)",
+		typed_view(r->obs, (Py_ssize_t)e->n * e->size, NULL),
+		typed_view(r->rewards, e->n * sizeof(float), "f"),
+		typed_view(r->terminated, e->n, "?"),
+		typed_view(r->truncated, e->n, "?"),
+		typed_view(r->episode_frames, e->n * sizeof(int), "i"));
+}
+
+static void vecenv_destroy(PyObject *capsule)
+{
+	vecenv_t *e = (vecenv_t *)PyCapsule_GetPointer(capsule, VECENV_CAPSULE);
+
+	if (e->v != NULL)
+		EMULATE(libatari800_vecenv_free(e->v));
+	PyMem_Free(e);
+}
+
+static PyObject *py_vecenv_new(PyObject *self, PyObject *args)
+{
+	int n, frames, width = 84, height = 84, format = LIBATARI800_OBS_GRAY, flags = 0;
+	vecenv_t *e;
+	PyObject *capsule;
+
+	if (!PyArg_ParseTuple(args, "ii|iiii", &n, &frames, &width, &height, &format, &flags))
+		return NULL;
+	if ((e = (vecenv_t *)PyMem_Malloc(sizeof(vecenv_t))) == NULL)
+		return PyErr_NoMemory();
+	EMULATE(e->v = libatari800_vecenv_new(n, frames, flags, width, height, format));
+	if (e->v == NULL) {
+		PyMem_Free(e);
+		PyErr_SetString(PyExc_ValueError, "invalid vecenv arguments");
+		return NULL;
+	}
+	e->n = n;
+	e->size = width * height;
+	if ((capsule = PyCapsule_New(e, VECENV_CAPSULE, vecenv_destroy)) == NULL) {
+		EMULATE(libatari800_vecenv_free(e->v));
+		PyMem_Free(e);
+	}
+	return capsule;
+}
+
+static PyObject *vecenv_set(PyObject *args, int done)
+{
+	PyObject *obj, *list;
+	feature_template_t defs[LIBATARI800_MAX_FEATURES];
+	int (*set)(libatari800_vecenv_t *, const feature_template_t *, int) =
+		done ? libatari800_vecenv_set_done : libatari800_vecenv_set_reward;
+	vecenv_t *e;
+	int n, ok;
+
+	if (!PyArg_ParseTuple(args, "OO", &obj, &list))
+		return NULL;
+	if ((e = get_vecenv(obj)) == NULL || (n = parse_features(list, defs)) < 0)
+		return NULL;
+	EMULATE(ok = set(e->v, defs, n));
+	if (!ok) {
+		PyErr_SetString(PyExc_ValueError, "invalid feature");
+		return NULL;
+	}
+	Py_RETURN_NONE;
+}
+
+static PyObject *py_vecenv_set_reward(PyObject *self, PyObject *args)
+{
+	return vecenv_set(args, FALSE);
+}
+
+static PyObject *py_vecenv_set_done(PyObject *self, PyObject *args)
+{
+	return vecenv_set(args, TRUE);
+}
+
+static PyObject *py_vecenv_set_max_frames(PyObject *self, PyObject *args)
+{
+	PyObject *obj;
+	vecenv_t *e;
+	int frames;
+
+	if (!PyArg_ParseTuple(args, "Oi", &obj, &frames) || (e = get_vecenv(obj)) == NULL)
+		return NULL;
+	libatari800_vecenv_set_max_frames(e->v, frames);
+	Py_RETURN_NONE;
+}
+
+static PyObject *py_vecenv_reset(PyObject *self, PyObject *args)
+{
+	PyObject *obj;
+	const libatari800_vecenv_result_t *r;
+	vecenv_t *e;
+
+	if (!PyArg_ParseTuple(args, "O", &obj) || (e = get_vecenv(obj)) == NULL)
+		return NULL;
+	EMULATE(r = libatari800_vecenv_reset(e->v));
+	return vecenv_result(e, r);
+}
+
+/* vecenv_step(v, inputs) with inputs n * INPUT_SIZE bytes */
+static PyObject *py_vecenv_step(PyObject *self, PyObject *args)
+{
+	PyObject *obj, *inputs_obj;
+	const libatari800_vecenv_result_t *r;
+	Py_buffer inputs;
+	vecenv_t *e;
+
+	if (!PyArg_ParseTuple(args, "OO", &obj, &inputs_obj) || (e = get_vecenv(obj)) == NULL)
+		return NULL;
+	if (get_buffer(inputs_obj, &inputs, e->n * (Py_ssize_t)sizeof(input_template_t), FALSE, "inputs") < 0)
+		return NULL;
+	EMULATE(r = libatari800_vecenv_step(e->v, (const input_template_t *)inputs.buf));
+	PyBuffer_Release(&inputs);
+	return vecenv_result(e, r);
+}
+
+static PyObject *py_vecenv_free(PyObject *self, PyObject *args)
+{
+	PyObject *obj;
+	vecenv_t *e;
+
+	if (!PyArg_ParseTuple(args, "O", &obj) || (e = get_vecenv(obj)) == NULL)
+		return NULL;
+	EMULATE(libatari800_vecenv_free(e->v));
+	/* The wrapper stays with the capsule, so later calls fail cleanly */
+	e->v = NULL;
+	Py_RETURN_NONE;
+}
+
+/* === Transposition tables === */
+
+#define TTABLE_CAPSULE "libatari800.ttable"
+
+/* Tables are used without the emulator lock, by any number of threads */
+static libatari800_ttable_t *get_ttable(PyObject *obj)
+{
+	return (libatari800_ttable_t *)PyCapsule_GetPointer(obj, TTABLE_CAPSULE);
+}
+
+static void ttable_destroy(PyObject *capsule)
+{
+	libatari800_ttable_free(get_ttable(capsule));
+}
+
+static PyObject *py_ttable_new(PyObject *self, PyObject *args)
+{
+	libatari800_ttable_t *t;
+	PyObject *capsule;
+	int capacity;
+
+	if (!PyArg_ParseTuple(args, "i", &capacity))
+		return NULL;
+	Py_BEGIN_ALLOW_THREADS
+	t = libatari800_ttable_new(capacity);
+	Py_END_ALLOW_THREADS
+	if (t == NULL) {
+		PyErr_SetString(PyExc_ValueError, "invalid capacity or out of memory");
+		return NULL;
+	}
+	if ((capsule = PyCapsule_New(t, TTABLE_CAPSULE, ttable_destroy)) == NULL)
+		libatari800_ttable_free(t);
+	return capsule;
+}
+
+static PyObject *py_ttable_lookup(PyObject *self, PyObject *args)
+{
+	PyObject *obj;
+	libatari800_ttable_t *t;
+	unsigned long long hash;
+	int insert = TRUE, created, entry;
+
+	if (!PyArg_ParseTuple(args, "OK|p", &obj, &hash, &insert) || (t = get_ttable(obj)) == NULL)
+		return NULL;
+	entry = libatari800_ttable_lookup(t, hash, insert, &created);
+	return Py_BuildValue("(iO)", entry, created ? Py_True : Py_False);
+}
+
+static PyObject *py_ttable_set_snapshot(PyObject *self, PyObject *args)
+{
+	PyObject *obj;
+	libatari800_ttable_t *t;
+	int entry, snapshot;
+
+	if (!PyArg_ParseTuple(args, "Oii", &obj, &entry, &snapshot) || (t = get_ttable(obj)) == NULL)
+		return NULL;
+	libatari800_ttable_set_snapshot(t, entry, snapshot);
+	Py_RETURN_NONE;
+}
+
+static PyObject *py_ttable_snapshot(PyObject *self, PyObject *args)
+{
+	PyObject *obj;
+	libatari800_ttable_t *t;
+	int entry;
+
+	if (!PyArg_ParseTuple(args, "Oi", &obj, &entry) || (t = get_ttable(obj)) == NULL)
+		return NULL;
+	return PyLong_FromLong(libatari800_ttable_get_snapshot(t, entry));
+}
+
+static PyObject *py_ttable_update(PyObject *self, PyObject *args)
+{
+	PyObject *obj;
+	libatari800_ttable_t *t;
+	int entry, visits;
+	double value;
+
+	if (!PyArg_ParseTuple(args, "Oiid", &obj, &entry, &visits, &value) || (t = get_ttable(obj)) == NULL)
+		return NULL;
+	libatari800_ttable_update(t, entry, visits, value);
+	Py_RETURN_NONE;
+}
+
+static PyObject *py_ttable_stats(PyObject *self, PyObject *args)
+{
+	PyObject *obj;
+	libatari800_ttable_t *t;
+	int64_t visits;
+	double value;
+	int entry;
+
+	if (!PyArg_ParseTuple(args, "Oi", &obj, &entry) || (t = get_ttable(obj)) == NULL)
+		return NULL;
+	libatari800_ttable_get_stats(t, entry, &visits, &value);
+	return Py_BuildValue("(Ld)", (long long)visits, value);
+}
+
+static PyObject *py_ttable_count(PyObject *self, PyObject *args)
+{
+	PyObject *obj;
+	libatari800_ttable_t *t;
+
+	if (!PyArg_ParseTuple(args, "O", &obj) || (t = get_ttable(obj)) == NULL)
+		return NULL;
+	return PyLong_FromLong(libatari800_ttable_count(t));
+}
+
+/* === State archives === */
+
+#define ARCHIVE_CAPSULE "libatari800.archive"
+
+typedef struct {
+	libatari800_archive_t *a;
+} archive_t;
+
+static archive_t *get_archive(PyObject *obj)
+{
+	archive_t *w = (archive_t *)PyCapsule_GetPointer(obj, ARCHIVE_CAPSULE);
+	if (w != NULL && w->a == NULL) {
+		PyErr_SetString(PyExc_ValueError, "archive was closed");
+		return NULL;
+	}
+	return w;
+}
+
+static void archive_destroy(PyObject *capsule)
+{
+	archive_t *w = (archive_t *)PyCapsule_GetPointer(capsule, ARCHIVE_CAPSULE);
+
+	libatari800_archive_close(w->a);
+	PyMem_Free(w);
+}
+
+static PyObject *archive_new(PyObject *args, libatari800_archive_t *(*open_fn)(const char *))
+{
+	const char *filename;
+	archive_t *w;
+	PyObject *capsule;
+
+	if (!PyArg_ParseTuple(args, "s", &filename))
+		return NULL;
+	if ((w = (archive_t *)PyMem_Malloc(sizeof(archive_t))) == NULL)
+		return PyErr_NoMemory();
+	errno = 0;
+	if ((w->a = open_fn(filename)) == NULL) {
+		PyMem_Free(w);
+		if (errno != 0)
+			PyErr_SetFromErrnoWithFilename(PyExc_OSError, filename);
+		else
+			PyErr_SetString(PyExc_ValueError, "not a state archive");
+		return NULL;
+	}
+	if ((capsule = PyCapsule_New(w, ARCHIVE_CAPSULE, archive_destroy)) == NULL) {
+		libatari800_archive_close(w->a);
+		PyMem_Free(w);
+	}
+	return capsule;
+}
+
+static PyObject *py_archive_create(PyObject *self, PyObject *args)
+{
+	return archive_new(args, libatari800_archive_create);
+}
+
+static PyObject *py_archive_open(PyObject *self, PyObject *args)
+{
+	return archive_new(args, libatari800_archive_open);
+}
+
+static PyObject *py_archive_append(PyObject *self, PyObject *args)
+{
+	PyObject *obj;
+	archive_t *w;
+	int record;
+
+	if (!PyArg_ParseTuple(args, "O", &obj) || (w = get_archive(obj)) == NULL)
+		return NULL;
+	EMULATE(record = libatari800_archive_append(w->a, NULL));
+	if (record < 0) {
+		PyErr_SetString(PyExc_OSError, "cannot append to the archive");
+		return NULL;
+	}
+	return PyLong_FromLong(record);
+}
+
+static PyObject *py_archive_count(PyObject *self, PyObject *args)
+{
+	PyObject *obj;
+	archive_t *w;
+
+	if (!PyArg_ParseTuple(args, "O", &obj) || (w = get_archive(obj)) == NULL)
+		return NULL;
+	return PyLong_FromLong(libatari800_archive_count(w->a));
+}
+
+static PyObject *py_archive_restore(PyObject *self, PyObject *args)
+{
+	PyObject *obj;
+	archive_t *w;
+	int record, ok;
+
+	if (!PyArg_ParseTuple(args, "Oi", &obj, &record) || (w = get_archive(obj)) == NULL)
+		return NULL;
+	EMULATE(ok = libatari800_archive_restore(w->a, record));
+	return PyBool_FromLong(ok);
+}
+
+static PyObject *py_archive_close(PyObject *self, PyObject *args)
+{
+	PyObject *obj;
+	archive_t *w;
+	int ok;
+
+	if (!PyArg_ParseTuple(args, "O", &obj) || (w = get_archive(obj)) == NULL)
+		return NULL;
+	ok = libatari800_archive_close(w->a);
+	/* The wrapper stays with the capsule, so later calls fail cleanly */
+	w->a = NULL;
+	return PyBool_FromLong(ok);
+}
+
+static PyMethodDef methods[] = {
+	{ "init", py_init, METH_VARARGS, "init(options) - start the emulator with a list of command line options" },
+	{ "input", py_input, METH_NOARGS, "input() - writable view of the input the next frames get" },
+	{ "next_frame", py_next_frame, METH_NOARGS, "next_frame() - run a frame; False on an error" },
+	{ "next_frames", py_next_frames, METH_VARARGS, "next_frames(n, flags=0) - run n frames with the same input; returns those run without an error" },
+	{ "set_pots", py_set_pots, METH_VARARGS, "set_pots(pots=None) - 8 pot values 0-228 (5200 analog sticks, paddles), -1 for one to work as usual; None releases all" },
+	{ "screen", py_screen, METH_NOARGS, "screen() - view of the 384x240 screen, a colour index per pixel" },
+	{ "memory", py_memory, METH_NOARGS, "memory() - writable view of the 64 KB the CPU sees" },
+	{ "sound", py_sound, METH_NOARGS, "sound() - view of the sound of the last frame or frames" },
+	{ "sound_format", py_sound_format, METH_NOARGS, "sound_format() - (frequency, channels, sample size)" },
+	{ "set_sound_format", py_set_sound_format, METH_VARARGS, "set_sound_format(frequency, channels, format) - synthesise sound at the rate and channels in SOUND_U8, SOUND_S16 or SOUND_FLOAT samples" },
+	{ "frame_number", py_frame_number, METH_NOARGS, "frame_number() - frames run since init()" },
+	{ "error_message", py_error_message, METH_NOARGS, "error_message() - what stopped the last frame" },
+	{ "get_observation", py_get_observation, METH_VARARGS, "get_observation(buffer, width, height, format=OBS_GRAY, x1=0, y1=0, x2=0, y2=0) - render the screen resized into buffer" },
+	{ "screen_hash", py_screen_hash, METH_NOARGS, "screen_hash() - 64-bit hash of the visible area of the screen" },
+	{ "state_hash", py_state_hash, METH_NOARGS, "state_hash() - 64-bit hash of the memory, banks and chip registers" },
+	{ "set_observation_buffer", py_set_observation_buffer, METH_VARARGS, "set_observation_buffer(buffer, width, height, format=OBS_GRAY, x1=0, y1=0, x2=0, y2=0) - render into buffer after every step; None stops" },
+	{ "set_features", py_set_features, METH_VARARGS, "set_features([(kind, addr, len, mask, delta, scale), ...], buffer) - evaluate features into a float32 buffer after every step" },
+	{ "set_screen_buffers", py_set_screen_buffers, METH_VARARGS, "set_screen_buffers(n) - keep a ring of n completed screens" },
+	{ "acquire_screen", py_acquire_screen, METH_NOARGS, "acquire_screen() - (view, frame) of the newest completed screen, or None" },
+	{ "release_screen", py_release_screen, METH_VARARGS, "release_screen(view) - hand back a screen from acquire_screen()" },
+	{ "save_snapshot", py_save_snapshot, METH_VARARGS, "save_snapshot(buffer=None) - snapshot as bytes, or into buffer returning its size" },
+	{ "restore_snapshot", py_restore_snapshot, METH_VARARGS, "restore_snapshot(snapshot) - False if it is not valid" },
+	{ "restore_and_step_many", py_restore_and_step_many, METH_VARARGS, "restore_and_step_many(parent, inputs, frames, children=None, stride=0, features=None) - (ok, sizes)" },
+	{ "ctx_new", py_ctx_new, METH_NOARGS, "ctx_new() - a new context holding a copy of the initial machine" },
+	{ "ctx_select", py_ctx_select, METH_VARARGS, "ctx_select(ctx) - make ctx the machine the other functions use" },
+	{ "ctx_free", py_ctx_free, METH_VARARGS, "ctx_free(ctx) - free a context" },
+	{ "step_batch", py_step_batch, METH_VARARGS, "step_batch(ctxs, inputs, frames, obs=None, width=84, height=84, format=OBS_GRAY) - step contexts; returns those without an error" },
+	{ "vecenv_new", py_vecenv_new, METH_VARARGS, "vecenv_new(n, frames, width=84, height=84, format=OBS_GRAY, flags=0) - n environments started from the selected machine, each step running frames frames" },
+	{ "vecenv_set_reward", py_vecenv_set_reward, METH_VARARGS, "vecenv_set_reward(v, features) - the reward is the sum of the features" },
+	{ "vecenv_set_done", py_vecenv_set_done, METH_VARARGS, "vecenv_set_done(v, features) - an episode ends when one of the features is not 0" },
+	{ "vecenv_set_max_frames", py_vecenv_set_max_frames, METH_VARARGS, "vecenv_set_max_frames(v, frames) - cut episodes short after frames frames, 0 for no limit" },
+	{ "vecenv_reset", py_vecenv_reset, METH_VARARGS, "vecenv_reset(v) - reset all environments; returns (obs, rewards, terminated, truncated, episode_frames)" },
+	{ "vecenv_step", py_vecenv_step, METH_VARARGS, "vecenv_step(v, inputs) - step all environments, resetting those that end; returns as vecenv_reset" },
+	{ "vecenv_free", py_vecenv_free, METH_VARARGS, "vecenv_free(v) - free the environments and their contexts" },
+	{ "ttable_new", py_ttable_new, METH_VARARGS, "ttable_new(capacity) - a transposition table from state hashes to snapshot handles, visits and values, for any number of threads" },
+	{ "ttable_lookup", py_ttable_lookup, METH_VARARGS, "ttable_lookup(t, hash, insert=True) - (entry, created); entry -1 if there is none or the table is full" },
+	{ "ttable_set_snapshot", py_ttable_set_snapshot, METH_VARARGS, "ttable_set_snapshot(t, entry, snapshot) - set the snapshot handle of an entry" },
+	{ "ttable_snapshot", py_ttable_snapshot, METH_VARARGS, "ttable_snapshot(t, entry) - the snapshot handle of an entry, -1 until set" },
+	{ "ttable_update", py_ttable_update, METH_VARARGS, "ttable_update(t, entry, visits, value) - add visits and value to an entry" },
+	{ "ttable_stats", py_ttable_stats, METH_VARARGS, "ttable_stats(t, entry) - (visits, value sum) of an entry" },
+	{ "ttable_count", py_ttable_count, METH_VARARGS, "ttable_count(t) - entries in the table" },
+	{ "archive_create", py_archive_create, METH_VARARGS, "archive_create(filename) - a new state archive, stored against its first state" },
+	{ "archive_append", py_archive_append, METH_VARARGS, "archive_append(a) - add the current state; returns its record number" },
+	{ "archive_open", py_archive_open, METH_VARARGS, "archive_open(filename) - map a state archive for reading" },
+	{ "archive_count", py_archive_count, METH_VARARGS, "archive_count(a) - records in the archive" },
+	{ "archive_restore", py_archive_restore, METH_VARARGS, "archive_restore(a, record) - restore the emulator from a record; False if there is none" },
+	{ "archive_close", py_archive_close, METH_VARARGS, "archive_close(a) - close the archive, writing the index of one being written; False on a write error" },
+	{ NULL, NULL, 0, NULL }
+};
+
+static void module_free(void *module)
+{
+	Py_CLEAR(held);
+	if (emu_lock != NULL) {
+		PyThread_free_lock(emu_lock);
+		emu_lock = NULL;
+	}
+}
+
+static struct PyModuleDef module = {
+	PyModuleDef_HEAD_INIT, "libatari800",
+	"Atari 8-bit emulator, with zero-copy views of its buffers", -1, methods,
+	NULL, NULL, NULL, module_free
+};
+
+PyMODINIT_FUNC PyInit_libatari800(void)
+{
+	static const struct { const char *name; size_t offset; } fields[] = {
+		{ "keychar", offsetof(input_template_t, keychar) },
+		{ "keycode", offsetof(input_template_t, keycode) },
+		{ "special", offsetof(input_template_t, special) },
+		{ "shift", offsetof(input_template_t, shift) },
+		{ "control", offsetof(input_template_t, control) },
+		{ "start", offsetof(input_template_t, start) },
+		{ "select", offsetof(input_template_t, select) },
+		{ "option", offsetof(input_template_t, option) },
+		{ "joy0", offsetof(input_template_t, joy0) },
+		{ "trig0", offsetof(input_template_t, trig0) },
+		{ "joy1", offsetof(input_template_t, joy1) },
+		{ "trig1", offsetof(input_template_t, trig1) },
+		{ "joy2", offsetof(input_template_t, joy2) },
+		{ "trig2", offsetof(input_template_t, trig2) },
+		{ "joy3", offsetof(input_template_t, joy3) },
+		{ "trig3", offsetof(input_template_t, trig3) },
+		{ "mousex", offsetof(input_template_t, mousex) },
+		{ "mousey", offsetof(input_template_t, mousey) },
+		{ "mouse_buttons", offsetof(input_template_t, mouse_buttons) },
+		{ "mouse_mode", offsetof(input_template_t, mouse_mode) }
+	};
+	PyObject *m, *dict;
+	size_t i;
+
+	if ((m = PyModule_Create(&module)) == NULL)
+		return NULL;
+	if ((emu_lock = PyThread_allocate_lock()) == NULL || (held = PyDict_New()) == NULL
+		|| (dict = PyDict_New()) == NULL) {
+		Py_DECREF(m);
+		return NULL;
+	}
+	for (i = 0; i < sizeof(fields) / sizeof(fields[0]); i++) {
+		PyObject *v = PyLong_FromSize_t(fields[i].offset);
+		if (v == NULL || PyDict_SetItemString(dict, fields[i].name, v) < 0) {
+			Py_XDECREF(v);
+			Py_DECREF(dict);
+			Py_DECREF(m);
+			return NULL;
+		}
+		Py_DECREF(v);
+	}
+	if (PyModule_AddObject(m, "INPUT_FIELDS", dict) < 0) {
+		Py_DECREF(dict);
+		Py_DECREF(m);
+		return NULL;
+	}
+	PyModule_AddIntConstant(m, "INPUT_SIZE", sizeof(input_template_t));
+	PyModule_AddIntConstant(m, "SCREEN_WIDTH", 384);
+	PyModule_AddIntConstant(m, "SCREEN_HEIGHT", 240);
+	PyModule_AddIntConstant(m, "OBS_GRAY", LIBATARI800_OBS_GRAY);
+	PyModule_AddIntConstant(m, "OBS_INDEX", LIBATARI800_OBS_INDEX);
+	PyModule_AddIntConstant(m, "FRAMES_MAXPOOL", LIBATARI800_FRAMES_MAXPOOL);
+	PyModule_AddIntConstant(m, "FRAMES_SOUND", LIBATARI800_FRAMES_SOUND);
+	PyModule_AddIntConstant(m, "SOUND_U8", LIBATARI800_SOUND_U8);
+	PyModule_AddIntConstant(m, "SOUND_S16", LIBATARI800_SOUND_S16);
+	PyModule_AddIntConstant(m, "SOUND_FLOAT", LIBATARI800_SOUND_FLOAT);
+	PyModule_AddIntConstant(m, "FEATURE_BYTE", LIBATARI800_FEATURE_BYTE);
+	PyModule_AddIntConstant(m, "FEATURE_SBYTE", LIBATARI800_FEATURE_SBYTE);
+	PyModule_AddIntConstant(m, "FEATURE_WORD", LIBATARI800_FEATURE_WORD);
+	PyModule_AddIntConstant(m, "FEATURE_WORD_BE", LIBATARI800_FEATURE_WORD_BE);
+	PyModule_AddIntConstant(m, "FEATURE_BCD", LIBATARI800_FEATURE_BCD);
+	PyModule_AddIntConstant(m, "FEATURE_BCD_LE", LIBATARI800_FEATURE_BCD_LE);
+	PyModule_AddIntConstant(m, "FEATURE_BIT", LIBATARI800_FEATURE_BIT);
+	return m;
+}
@@ -0,0 +1,108 @@
+/*
+ * libatari800/screen_ring.c - Atari800 as a library - ring of completed screens
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+/* The ring itself is the core's (screen_ring.c), shared with the other
+   readers of completed screens such as the recording encoder; this is
+   the library's interface to it. */
+
+#include "config.h"
+#include "atari.h"
+#include "../screen_ring.h"
+#include "libatari800.h"
+#include "libatari800/screen_ring.h"
+
+static int num_buffers = 0;   /* opened the core ring for, 0 = not */
+static unsigned long dropped_before = 0;
+
+void LIBATARI800_ScreenRing_Publish(void)
+{
+	if (num_buffers > 0)
+		Screen_Ring_Publish();
+}
+
+
+/** Keep completed screens in a ring for readers in other threads
+ *
+ * With \a n of 2 or more, the screen is copied at the end of every step
+ * (each \a libatari800_next_frame, or the last frame of each \a
+ * libatari800_next_frames) into one of \a n buffers, from which \a
+ * libatari800_acquire_screen takes the latest while the emulation goes on
+ * to the next frames. A step finding every buffer but the latest held by
+ * readers is not kept (see \a libatari800_get_screen_buffers_dropped); with
+ * one reader holding one screen at a time, 3 buffers always leave one free.
+ *
+ * The ring is shared by all contexts: it holds the screens of the steps of
+ * whichever context ran them. A recording in progress takes its screens
+ * from the same copies. Buffers a reader still holds when they are freed
+ * go when they are released.
+ *
+ * @param n number of buffers, 0 (or 1) to free them
+ *
+ * @retval FALSE if \a n is too large
+ * @retval TRUE if successful
+ */
+int libatari800_set_screen_buffers(int n)
+{
+	if (n == 1)
+		n = 0;
+	if (n < 0 || n > 64)
+		return FALSE;
+	if (num_buffers > 0)
+		Screen_Ring_Close(num_buffers - 1);
+	num_buffers = 0;
+	/* The core ring keeps one more than its users hold: the latest */
+	if (n > 0) {
+		if (!Screen_Ring_Open(n - 1))
+			return FALSE;
+		num_buffers = n;
+		dropped_before = Screen_Ring_Dropped();
+	}
+	return TRUE;
+}
+
+
+/** Hold the latest completed screen
+ *
+ * May be called from any thread. The screen, laid out as \a
+ * libatari800_get_screen_ptr describes, is not written until it is given
+ * back with \a libatari800_release_screen; holding it does not hold up the
+ * emulation, which goes on with the other buffers.
+ *
+ * @param frame if not NULL, gets the frame number of the screen (see \a
+ * libatari800_get_frame_number)
+ *
+ * @returns pointer to the 92160 bytes of the screen, or NULL if there are
+ * no buffers or no step has completed yet
+ */
+const UBYTE *libatari800_acquire_screen(int *frame)
+{
+	if (num_buffers == 0)
+		return NULL;
+	return Screen_Ring_Acquire(frame);
+}
+
+
+/** Give back a screen from \a libatari800_acquire_screen
+ *
+ * May be called from any thread, once for each acquire.
+ *
+ * @param screen pointer returned by \a libatari800_acquire_screen
+ */
+void libatari800_release_screen(const UBYTE *screen)
+{
+	Screen_Ring_Release(screen);
+}
+
+
+/** Return how many steps found no free buffer
+ *
+ * @returns number of screens not kept since \a libatari800_set_screen_buffers
+ */
+unsigned long libatari800_get_screen_buffers_dropped(void)
+{
+	return Screen_Ring_Dropped() - dropped_before;
+}
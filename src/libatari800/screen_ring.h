@@ -0,0 +1,12 @@
+#ifndef LIBATARI800_SCREEN_RING_H_
+#define LIBATARI800_SCREEN_RING_H_
+
+#include <stdio.h>
+
+#include "config.h"
+
+/* Copy the screen into the ring set up by libatari800_set_screen_buffers,
+   if there is one, as the latest completed frame */
+void LIBATARI800_ScreenRing_Publish(void);
+
+#endif /* LIBATARI800_SCREEN_RING_H_ */
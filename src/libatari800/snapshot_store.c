@@ -0,0 +1,284 @@
+/*
+ * libatari800/snapshot_store.c - Atari800 as a library - copy-on-write snapshot store
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+/* A snapshot (see libatari800_save_snapshot) is cut into 256-byte pages,
+   grouped 16 to a table. Saving compares every page with the snapshot the
+   machine was last saved to or restored from, and shares the pages and
+   whole groups that did not change. Pages are never modified once stored,
+   so sharing is by reference count and equal pointers mean equal data. */
+
+#include "config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "libatari800.h"
+#include "util.h"
+
+#define PAGE_SIZE 256
+#define GROUP_PAGES 16
+#define GROUP_SIZE (PAGE_SIZE * GROUP_PAGES)
+
+typedef struct {
+	int refs;
+	UBYTE data[PAGE_SIZE];
+} page_t;
+
+typedef struct {
+	int refs;
+	page_t *pages[GROUP_PAGES];
+} group_t;
+
+typedef struct {
+	int len;          /* snapshot size in bytes, 0 = unused slot */
+	group_t **groups; /* (len + GROUP_SIZE - 1) / GROUP_SIZE */
+} entry_t;
+
+struct libatari800_snapshot_store {
+	entry_t *entries;
+	int num_entries;
+	int base;           /* parent of the next save, -1 = none */
+	int scratch_id;     /* snapshot whose data is in scratch, -1 = none */
+	UBYTE *scratch;
+	UBYTE *work;
+	int buffer_size;    /* of scratch and work */
+	size_t bytes;       /* memory held by pages, groups and tables */
+};
+
+static void release_group(libatari800_snapshot_store_t *store, group_t *group)
+{
+	int i;
+
+	if (--group->refs > 0)
+		return;
+	for (i = 0; i < GROUP_PAGES; i++) {
+		if (group->pages[i] != NULL && --group->pages[i]->refs == 0) {
+			free(group->pages[i]);
+			store->bytes -= sizeof(page_t);
+		}
+	}
+	free(group);
+	store->bytes -= sizeof(group_t);
+}
+
+/* Store the group of data at offset, sharing what is unchanged in parent */
+static group_t *store_group(libatari800_snapshot_store_t *store, const UBYTE *data,
+                            int offset, int len, group_t *parent)
+{
+	page_t *pages[GROUP_PAGES];
+	group_t *group;
+	int i, changed = FALSE;
+
+	for (i = 0; i < GROUP_PAGES; i++) {
+		int start = offset + i * PAGE_SIZE;
+		int n = len - start < PAGE_SIZE ? len - start : PAGE_SIZE;
+		pages[i] = NULL;
+		if (n <= 0)
+			continue;
+		if (parent != NULL && memcmp(parent->pages[i]->data, data + start, n) == 0) {
+			pages[i] = parent->pages[i];
+			continue;
+		}
+		pages[i] = (page_t *)Util_malloc(sizeof(page_t));
+		pages[i]->refs = 0;
+		memcpy(pages[i]->data, data + start, n);
+		memset(pages[i]->data + n, 0, PAGE_SIZE - n);
+		store->bytes += sizeof(page_t);
+		changed = TRUE;
+	}
+	if (!changed) {
+		parent->refs++;
+		return parent;
+	}
+	group = (group_t *)Util_malloc(sizeof(group_t));
+	group->refs = 1;
+	for (i = 0; i < GROUP_PAGES; i++) {
+		group->pages[i] = pages[i];
+		if (pages[i] != NULL)
+			pages[i]->refs++;
+	}
+	store->bytes += sizeof(group_t);
+	return group;
+}
+
+
+/** Create an empty snapshot store
+ *
+ * @returns new store, to be released with \a libatari800_snapshot_store_free
+ */
+libatari800_snapshot_store_t *libatari800_snapshot_store_new(void)
+{
+	libatari800_snapshot_store_t *store = (libatari800_snapshot_store_t *)Util_malloc(sizeof(*store));
+
+	store->entries = NULL;
+	store->num_entries = 0;
+	store->base = -1;
+	store->scratch_id = -1;
+	store->scratch = NULL;
+	store->work = NULL;
+	store->buffer_size = 0;
+	store->bytes = 0;
+	return store;
+}
+
+
+/** Snapshot the emulator into a store
+ *
+ * Only the pages that differ from the snapshot the machine was last saved
+ * to or restored from take new memory; the rest are shared with it.
+ *
+ * @param store snapshot store
+ *
+ * @returns id of the new snapshot, or -1 on error
+ */
+int libatari800_snapshot_store_save(libatari800_snapshot_store_t *store)
+{
+	entry_t *entry, *parent = NULL;
+	UBYTE *swap;
+	int id, len, g, num_groups;
+
+	len = store->work != NULL ? libatari800_save_snapshot(store->work, store->buffer_size) : 0;
+	if (len == 0) {
+		/* First save, or the machine got more RAM */
+		len = libatari800_save_snapshot(NULL, 0);
+		store->scratch = (UBYTE *)Util_realloc(store->scratch, len);
+		store->work = (UBYTE *)Util_realloc(store->work, len);
+		store->buffer_size = len;
+		store->scratch_id = -1;
+		len = libatari800_save_snapshot(store->work, store->buffer_size);
+		if (len == 0)
+			return -1;
+	}
+
+	for (id = 0; id < store->num_entries && store->entries[id].len != 0; id++)
+		;
+	if (id == store->num_entries) {
+		store->entries = (entry_t *)Util_realloc(store->entries, (id + 1) * sizeof(entry_t));
+		store->num_entries++;
+	}
+	if (store->base >= 0 && store->entries[store->base].len == len)
+		parent = &store->entries[store->base];
+
+	entry = &store->entries[id];
+	num_groups = (len + GROUP_SIZE - 1) / GROUP_SIZE;
+	entry->len = len;
+	entry->groups = (group_t **)Util_malloc(num_groups * sizeof(group_t *));
+	store->bytes += num_groups * sizeof(group_t *);
+	for (g = 0; g < num_groups; g++)
+		entry->groups[g] = store_group(store, store->work, g * GROUP_SIZE, len,
+		                               parent != NULL ? parent->groups[g] : NULL);
+
+	/* The data just taken is that of the new snapshot */
+	swap = store->scratch;
+	store->scratch = store->work;
+	store->work = swap;
+	store->scratch_id = id;
+	store->base = id;
+	return id;
+}
+
+
+/** Restore the emulator from a snapshot in a store
+ *
+ * Only the pages that differ from the snapshot last saved or restored are
+ * copied before the machine state is loaded.
+ *
+ * @param store snapshot store
+ * @param id snapshot from \a libatari800_snapshot_store_save
+ *
+ * @retval FALSE if there is no such snapshot
+ * @retval TRUE if the emulator was restored
+ */
+int libatari800_snapshot_store_restore(libatari800_snapshot_store_t *store, int id)
+{
+	entry_t *entry, *have = NULL;
+	int g, i, num_groups;
+
+	if (id < 0 || id >= store->num_entries || store->entries[id].len == 0)
+		return FALSE;
+	entry = &store->entries[id];
+	if (store->scratch_id >= 0 && store->entries[store->scratch_id].len == entry->len)
+		have = &store->entries[store->scratch_id];
+
+	num_groups = (entry->len + GROUP_SIZE - 1) / GROUP_SIZE;
+	for (g = 0; g < num_groups; g++) {
+		group_t *group = entry->groups[g];
+		if (have != NULL && have->groups[g] == group)
+			continue;
+		for (i = 0; i < GROUP_PAGES; i++) {
+			int start = g * GROUP_SIZE + i * PAGE_SIZE;
+			int n = entry->len - start < PAGE_SIZE ? entry->len - start : PAGE_SIZE;
+			if (n <= 0)
+				break;
+			if (have == NULL || have->groups[g]->pages[i] != group->pages[i])
+				memcpy(store->scratch + start, group->pages[i]->data, n);
+		}
+	}
+	store->scratch_id = id;
+	store->base = id;
+	return libatari800_restore_snapshot(store->scratch);
+}
+
+
+/** Remove a snapshot from a store
+ *
+ * Pages no other snapshot shares are freed.
+ *
+ * @param store snapshot store
+ * @param id snapshot from \a libatari800_snapshot_store_save
+ */
+void libatari800_snapshot_store_drop(libatari800_snapshot_store_t *store, int id)
+{
+	entry_t *entry;
+	int g, num_groups;
+
+	if (id < 0 || id >= store->num_entries || store->entries[id].len == 0)
+		return;
+	entry = &store->entries[id];
+	num_groups = (entry->len + GROUP_SIZE - 1) / GROUP_SIZE;
+	for (g = 0; g < num_groups; g++)
+		release_group(store, entry->groups[g]);
+	free(entry->groups);
+	store->bytes -= num_groups * sizeof(group_t *);
+	entry->len = 0;
+	entry->groups = NULL;
+	if (store->base == id)
+		store->base = -1;
+	/* Its pages may now be freed and reused, so scratch can't be compared
+	   against them any more */
+	if (store->scratch_id == id)
+		store->scratch_id = -1;
+}
+
+
+/** Return the memory a store holds for its snapshots, in bytes
+ *
+ * @param store snapshot store
+ */
+size_t libatari800_snapshot_store_bytes(libatari800_snapshot_store_t *store)
+{
+	return store->bytes;
+}
+
+
+/** Release a snapshot store and all its snapshots
+ *
+ * @param store snapshot store
+ */
+void libatari800_snapshot_store_free(libatari800_snapshot_store_t *store)
+{
+	int id;
+
+	if (store == NULL)
+		return;
+	for (id = 0; id < store->num_entries; id++)
+		libatari800_snapshot_store_drop(store, id);
+	free(store->entries);
+	free(store->scratch);
+	free(store->work);
+	free(store);
+}
@@ -41,6 +41,17 @@ unsigned int sound_array_fill = 0;
 
 unsigned int sound_hw_buffer_size = 0;
 
+/* bytes allocated for LIBATARI800_Sound_array */
+unsigned int sound_array_size = 0;
+
+/* when set, each frame's samples are added after those already in
+   LIBATARI800_Sound_array instead of replacing them */
+int sound_accumulate = FALSE;
+
+/* when set, the 16-bit samples the core writes are stored as floats, each
+   taking twice the bytes in LIBATARI800_Sound_array */
+int sound_float = FALSE;
+
 /* difference between an integer sample rate and the floating point sample rate, used
    keep track of which frames need to drop a sample to stay at the constant audio
    sampling rate */
@@ -61,7 +72,8 @@ int PLATFORM_SoundSetup(Sound_setup_t *setup)
 	if (sound_hw_buffer_size == 0)
 	        return FALSE;
 
-	LIBATARI800_Sound_array = Util_malloc(sound_hw_buffer_size);
+	sound_array_size = sound_float ? 2 * sound_hw_buffer_size : sound_hw_buffer_size;
+	LIBATARI800_Sound_array = Util_malloc(sound_array_size);
 
 	sample_diff = (double)setup->buffer_frames - samples_per_video_frame;
 	sample_residual = 0;
@@ -72,6 +84,8 @@ int PLATFORM_SoundSetup(Sound_setup_t *setup)
 void PLATFORM_SoundExit(void)
 {
 	free(LIBATARI800_Sound_array);
+	LIBATARI800_Sound_array = NULL;
+	sound_array_size = 0;
 }
 
 void PLATFORM_SoundPause(void)
@@ -100,12 +114,29 @@ unsigned int PLATFORM_SoundAvailable(void)
 		buf_size -= Sound_out.sample_size * Sound_out.channels;
 	}
 
-	sound_array_fill = 0;
+	if (!sound_accumulate)
+		sound_array_fill = 0;
 	return buf_size;
 }
 
 void PLATFORM_SoundWrite(UBYTE const *buffer, unsigned int size)
 {
-	memcpy(LIBATARI800_Sound_array, buffer, size);
-	sound_array_fill = size;
+	unsigned int stored = sound_float ? 2 * size : size;
+
+	if (sound_array_fill + stored > sound_array_size) {
+		sound_array_size = sound_array_fill + stored > 2 * sound_array_size
+			? sound_array_fill + stored : 2 * sound_array_size;
+		LIBATARI800_Sound_array = Util_realloc(LIBATARI800_Sound_array, sound_array_size);
+	}
+	if (sound_float) {
+		SWORD const *in = (SWORD const *)buffer;
+		float *out = (float *)(LIBATARI800_Sound_array + sound_array_fill);
+		unsigned int i;
+
+		for (i = 0; i < size / 2; i++)
+			out[i] = in[i] * (1.0f / 32768.0f);
+	}
+	else
+		memcpy(LIBATARI800_Sound_array + sound_array_fill, buffer, size);
+	sound_array_fill += stored;
 }
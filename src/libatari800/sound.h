@@ -10,6 +10,12 @@ extern unsigned int sound_array_fill;
 
 extern unsigned int sound_hw_buffer_size;
 
+extern unsigned int sound_array_size;
+
+extern int sound_accumulate;
+
+extern int sound_float;
+
 extern double sample_residual;
 
 #endif /* LIBATARI800_SOUND_H_ */
@@ -0,0 +1,489 @@
+/*
+ * libatari800/state_archive.c - Atari800 as a library - state archives
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+/* An archive holds any number of states (see libatari800_get_current_state)
+   of one machine, each stored as the 256-byte pages of its state file that
+   differ from the first state, the base. All numbers are little-endian:
+
+     "A8SA" u32 version, u32 0, u32 0, base state, then records
+
+   where the base state is the 32-byte header of a movie state (u32 size,
+   u32 selftest_enabled, u32 nframes, u32 sample_residual,
+   u32 random_counter, 12 bytes input_state) and size bytes, and a record
+   is such a header, u32 n and n ascending u32 page numbers followed by the
+   n pages, the last page of a state padded with zeros. The base counts as
+   zeros past its end.
+
+   Records are only ever appended. Closing the archive writes the index
+   after them, u64 offset of each record, then u64 offset of the index,
+   u32 number of records and "A8SX"; an archive without it (cut short by a
+   crash) is indexed by reading through the records when opened.
+
+   Readers map the file and restore a record by copying its pages over the
+   base, after putting back the pages of the record restored before. */
+
+#include "config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef HAVE_MMAP
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "libatari800.h"
+#include "util.h"
+
+#define ARCHIVE_MAGIC "A8SA"
+#define ARCHIVE_VERSION 1
+#define ARCHIVE_HEADER 16
+#define INDEX_MAGIC "A8SX"
+#define INDEX_FOOTER 16
+#define STATE_HEADER 32
+#define PAGE_SIZE 256
+#define MAX_PAGES ((STATESAV_MAX_SIZE + PAGE_SIZE - 1) / PAGE_SIZE)
+
+struct libatari800_archive {
+	int writing;
+	emulator_state_t *state;  /* writing: the capture, reading: the
+	                             record restored last, over the base */
+	UBYTE *base;              /* the base's state file, MAX_PAGES pages */
+	ULONG base_size;
+	long *offsets;            /* of each record */
+	int count;
+	int offsets_size;
+
+	/* Writing */
+	FILE *fp;
+	long pos;
+	UBYTE *record;
+
+	/* Reading */
+	const UBYTE *map;
+	size_t map_len;
+	int mapped;               /* map is mmap'ed rather than read in */
+	ULONG pages[MAX_PAGES];   /* where state differs from base */
+	int num_pages;
+};
+
+static void put_u32(UBYTE *p, ULONG v)
+{
+	p[0] = (UBYTE)v;
+	p[1] = (UBYTE)(v >> 8);
+	p[2] = (UBYTE)(v >> 16);
+	p[3] = (UBYTE)(v >> 24);
+}
+
+static ULONG get_u32(const UBYTE *p)
+{
+	return p[0] | (p[1] << 8) | (p[2] << 16) | ((ULONG)p[3] << 24);
+}
+
+static void put_u64(UBYTE *p, long v)
+{
+	put_u32(p, (ULONG)v);
+	put_u32(p + 4, (ULONG)((unsigned long)v >> 16 >> 16));
+}
+
+static long get_u64(const UBYTE *p)
+{
+	return (long)(get_u32(p) | ((unsigned long)get_u32(p + 4) << 16 << 16));
+}
+
+static void put_state_header(UBYTE *p, const emulator_state_t *state)
+{
+	put_u32(p, state->tags.size);
+	put_u32(p + 4, state->flags.selftest_enabled);
+	put_u32(p + 8, state->flags.nframes);
+	put_u32(p + 12, state->flags.sample_residual);
+	put_u32(p + 16, state->flags.random_counter);
+	memcpy(p + 20, state->flags.input_state, 12);
+}
+
+static void get_state_header(emulator_state_t *state, const UBYTE *p)
+{
+	state->tags.size = get_u32(p);
+	state->flags.selftest_enabled = (UBYTE)get_u32(p + 4);
+	state->flags.nframes = get_u32(p + 8);
+	state->flags.sample_residual = get_u32(p + 12);
+	state->flags.random_counter = get_u32(p + 16);
+	memcpy(state->flags.input_state, p + 20, 12);
+}
+
+static void add_offset(libatari800_archive_t *archive, long offset)
+{
+	if (archive->count == archive->offsets_size) {
+		archive->offsets_size = archive->offsets_size * 2 + 1024;
+		archive->offsets = (long *)Util_realloc(archive->offsets, archive->offsets_size * sizeof(long));
+	}
+	archive->offsets[archive->count++] = offset;
+}
+
+static libatari800_archive_t *new_archive(int writing)
+{
+	libatari800_archive_t *archive = (libatari800_archive_t *)Util_malloc(sizeof(*archive));
+
+	memset(archive, 0, sizeof(*archive));
+	archive->writing = writing;
+	archive->state = (emulator_state_t *)Util_malloc(sizeof(emulator_state_t));
+	memset(archive->state, 0, sizeof(emulator_state_t));
+	archive->base = (UBYTE *)Util_malloc(MAX_PAGES * PAGE_SIZE);
+	memset(archive->base, 0, MAX_PAGES * PAGE_SIZE);
+	return archive;
+}
+
+static void free_archive(libatari800_archive_t *archive)
+{
+#ifdef HAVE_MMAP
+	if (archive->mapped)
+		munmap((void *)archive->map, archive->map_len);
+	else
+#endif
+		free((void *)archive->map);
+	free(archive->state);
+	free(archive->base);
+	free(archive->offsets);
+	free(archive->record);
+	free(archive);
+}
+
+
+/** Create a state archive
+ *
+ * The first state appended becomes the base that the others are stored
+ * against, so it is best one from the start of the episodes to come. The
+ * archive is complete once closed with \a libatari800_archive_close; one
+ * cut short can still be read up to its last whole record.
+ *
+ * @param filename the file to write, replaced if it exists
+ *
+ * @returns new archive, or NULL if the file cannot be created
+ */
+libatari800_archive_t *libatari800_archive_create(const char *filename)
+{
+	libatari800_archive_t *archive;
+	UBYTE header[ARCHIVE_HEADER];
+	FILE *fp = fopen(filename, "wb");
+
+	if (fp == NULL)
+		return NULL;
+	memset(header, 0, sizeof(header));
+	memcpy(header, ARCHIVE_MAGIC, 4);
+	put_u32(header + 4, ARCHIVE_VERSION);
+	if (fwrite(header, 1, sizeof(header), fp) != sizeof(header)) {
+		fclose(fp);
+		return NULL;
+	}
+	archive = new_archive(TRUE);
+	archive->fp = fp;
+	archive->pos = ARCHIVE_HEADER;
+	archive->record = (UBYTE *)Util_malloc(STATE_HEADER + 4 + MAX_PAGES * (4 + PAGE_SIZE));
+	return archive;
+}
+
+
+/** Add a state to an archive
+ *
+ * @param archive archive from \a libatari800_archive_create
+ * @param state state from \a libatari800_get_current_state, or NULL for
+ * the current state of the emulator
+ *
+ * @returns number of the record, counting from 0, or -1 on a write error
+ */
+int libatari800_archive_append(libatari800_archive_t *archive, const emulator_state_t *state)
+{
+	UBYTE *rec = archive->record;
+	ULONG size, page, num_pages, n = 0;
+	size_t len;
+
+	if (!archive->writing)
+		return -1;
+	if (state == NULL) {
+		libatari800_get_current_state(archive->state);
+		state = archive->state;
+	}
+	size = state->tags.size;
+	if (size == 0 || size > STATESAV_MAX_SIZE)
+		return -1;
+	num_pages = (size + PAGE_SIZE - 1) / PAGE_SIZE;
+
+	if (archive->base_size == 0) {
+		/* The first state is the base */
+		memcpy(archive->base, state->state, size);
+		put_state_header(rec, state);
+		if (fwrite(rec, 1, STATE_HEADER, archive->fp) != STATE_HEADER
+			|| fwrite(state->state, 1, size, archive->fp) != size)
+			return -1;
+		archive->base_size = size;
+		archive->pos += STATE_HEADER + size;
+	}
+
+	put_state_header(rec, state);
+	for (page = 0; page < num_pages; page++) {
+		ULONG off = page * PAGE_SIZE;
+		ULONG bytes = size - off < PAGE_SIZE ? size - off : PAGE_SIZE;
+		if (memcmp(archive->base + off, state->state + off, bytes) != 0)
+			put_u32(rec + STATE_HEADER + 4 + 4 * n++, page);
+	}
+	put_u32(rec + STATE_HEADER, n);
+	/* The pages go after the list of their numbers */
+	len = STATE_HEADER + 4 + n * 4;
+	for (page = 0; page < n; page++) {
+		ULONG off = get_u32(rec + STATE_HEADER + 4 + page * 4) * PAGE_SIZE;
+		ULONG bytes = size - off < PAGE_SIZE ? size - off : PAGE_SIZE;
+		memcpy(rec + len, state->state + off, bytes);
+		memset(rec + len + bytes, 0, PAGE_SIZE - bytes);
+		len += PAGE_SIZE;
+	}
+	if (fwrite(rec, 1, len, archive->fp) != len)
+		return -1;
+	add_offset(archive, archive->pos);
+	archive->pos += (long)len;
+	return archive->count - 1;
+}
+
+/* Size of the record at offset, or 0 if it is not whole before end */
+static size_t record_size(libatari800_archive_t *archive, long offset, long end)
+{
+	const UBYTE *p = archive->map + offset;
+	ULONG size, n, i, num_pages;
+
+	if (end - offset < STATE_HEADER + 4)
+		return 0;
+	size = get_u32(p);
+	n = get_u32(p + STATE_HEADER);
+	num_pages = (size + PAGE_SIZE - 1) / PAGE_SIZE;
+	if (size == 0 || size > STATESAV_MAX_SIZE || n > num_pages
+		|| (unsigned long)(end - offset) < STATE_HEADER + 4 + n * (4 + PAGE_SIZE))
+		return 0;
+	for (i = 0; i < n; i++) {
+		ULONG page = get_u32(p + STATE_HEADER + 4 + i * 4);
+		if (page >= num_pages || (i > 0 && page <= get_u32(p + STATE_HEADER + i * 4)))
+			return 0;
+	}
+	return STATE_HEADER + 4 + n * (4 + PAGE_SIZE);
+}
+
+/* Take the index at the end of the archive, or find the records */
+static void build_index(libatari800_archive_t *archive, long start)
+{
+	const UBYTE *footer = archive->map + archive->map_len - INDEX_FOOTER;
+	long end = (long)archive->map_len;
+	long pos;
+
+	if (archive->map_len >= (size_t)start + INDEX_FOOTER && memcmp(footer + 12, INDEX_MAGIC, 4) == 0) {
+		long index = get_u64(footer);
+		ULONG count = get_u32(footer + 8);
+		if (index >= start && (unsigned long)(end - INDEX_FOOTER - index) == count * 8UL) {
+			ULONG i;
+			for (i = 0; i < count; i++)
+				add_offset(archive, get_u64(archive->map + index + i * 8));
+			return;
+		}
+	}
+	/* No index: a writer did not close the archive */
+	for (pos = start; ; ) {
+		size_t len = record_size(archive, pos, end);
+		if (len == 0)
+			break;
+		add_offset(archive, pos);
+		pos += (long)len;
+	}
+}
+
+/* The whole file at archive->map */
+static int map_file(libatari800_archive_t *archive, const char *filename)
+{
+#ifdef HAVE_MMAP
+	struct stat st;
+	void *p;
+	int fd = open(filename, O_RDONLY);
+
+	if (fd < 0)
+		return FALSE;
+	if (fstat(fd, &st) != 0 || st.st_size < ARCHIVE_HEADER) {
+		close(fd);
+		return FALSE;
+	}
+	p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (p == MAP_FAILED)
+		return FALSE;
+	archive->map = (const UBYTE *)p;
+	archive->map_len = (size_t)st.st_size;
+	archive->mapped = TRUE;
+	return TRUE;
+#else
+	FILE *fp = fopen(filename, "rb");
+	UBYTE *data;
+	long len;
+
+	if (fp == NULL)
+		return FALSE;
+	if (fseek(fp, 0, SEEK_END) != 0 || (len = ftell(fp)) < ARCHIVE_HEADER
+		|| fseek(fp, 0, SEEK_SET) != 0) {
+		fclose(fp);
+		return FALSE;
+	}
+	data = (UBYTE *)Util_malloc((size_t)len);
+	if (fread(data, 1, (size_t)len, fp) != (size_t)len) {
+		free(data);
+		fclose(fp);
+		return FALSE;
+	}
+	fclose(fp);
+	archive->map = data;
+	archive->map_len = (size_t)len;
+	return TRUE;
+#endif
+}
+
+
+/** Open a state archive for reading
+ *
+ * The file is mapped into memory, so restoring a record reads only its
+ * pages, and any number of readers (threads or processes, each with an
+ * archive of its own) share one copy of it in the page cache.
+ *
+ * @param filename archive written by \a libatari800_archive_create
+ *
+ * @returns new archive, or NULL if the file cannot be read or is not an
+ * archive
+ */
+libatari800_archive_t *libatari800_archive_open(const char *filename)
+{
+	libatari800_archive_t *archive = new_archive(FALSE);
+	ULONG size;
+
+	if (!map_file(archive, filename)
+		|| memcmp(archive->map, ARCHIVE_MAGIC, 4) != 0
+		|| get_u32(archive->map + 4) != ARCHIVE_VERSION) {
+		free_archive(archive);
+		return NULL;
+	}
+	if (archive->map_len >= ARCHIVE_HEADER + STATE_HEADER) {
+		size = get_u32(archive->map + ARCHIVE_HEADER);
+		if (size > 0 && size <= STATESAV_MAX_SIZE
+			&& archive->map_len >= (size_t)ARCHIVE_HEADER + STATE_HEADER + size) {
+			memcpy(archive->base, archive->map + ARCHIVE_HEADER + STATE_HEADER, size);
+			memcpy(archive->state->state, archive->base, size);
+			archive->base_size = size;
+			build_index(archive, ARCHIVE_HEADER + STATE_HEADER + (long)size);
+		}
+	}
+	return archive;
+}
+
+
+/** Return the number of records in an archive
+ *
+ * @param archive state archive
+ */
+int libatari800_archive_count(libatari800_archive_t *archive)
+{
+	return archive->count;
+}
+
+
+/** Read a record of an archive
+ *
+ * @param archive archive from \a libatari800_archive_open
+ * @param record number of the record, from 0
+ * @param state if not NULL, set to the state, as \a
+ * libatari800_get_current_state gives it
+ *
+ * @returns FALSE if there is no such record
+ */
+int libatari800_archive_get(libatari800_archive_t *archive, int record, emulator_state_t *state)
+{
+	const UBYTE *p;
+	UBYTE *data = archive->state->state;
+	ULONG n, i;
+
+	if (archive->writing || record < 0 || record >= archive->count
+		|| record_size(archive, archive->offsets[record], (long)archive->map_len) == 0)
+		return FALSE;
+	p = archive->map + archive->offsets[record];
+	/* Back to the base, then the record's pages */
+	for (i = 0; i < (ULONG)archive->num_pages; i++) {
+		ULONG off = archive->pages[i] * PAGE_SIZE;
+		memcpy(data + off, archive->base + off,
+		       STATESAV_MAX_SIZE - off < PAGE_SIZE ? STATESAV_MAX_SIZE - off : PAGE_SIZE);
+	}
+	get_state_header(archive->state, p);
+	n = get_u32(p + STATE_HEADER);
+	for (i = 0; i < n; i++) {
+		ULONG page = get_u32(p + STATE_HEADER + 4 + i * 4);
+		ULONG off = page * PAGE_SIZE;
+		memcpy(data + off, p + STATE_HEADER + 4 + n * 4 + i * PAGE_SIZE,
+		       STATESAV_MAX_SIZE - off < PAGE_SIZE ? STATESAV_MAX_SIZE - off : PAGE_SIZE);
+		archive->pages[i] = page;
+	}
+	archive->num_pages = (int)n;
+	if (state != NULL && state != archive->state) {
+		state->tags = archive->state->tags;
+		state->flags = archive->state->flags;
+		memcpy(state->state, data, archive->state->tags.size);
+	}
+	return TRUE;
+}
+
+
+/** Restore the emulator from a record of an archive
+ *
+ * Only the pages of the record, and those of the record this reader
+ * restored before, are copied before the state is loaded.
+ *
+ * @param archive archive from \a libatari800_archive_open
+ * @param record number of the record, from 0
+ *
+ * @retval FALSE if there is no such record
+ * @retval TRUE if the emulator was restored
+ */
+int libatari800_archive_restore(libatari800_archive_t *archive, int record)
+{
+	if (!libatari800_archive_get(archive, record, NULL))
+		return FALSE;
+	libatari800_restore_state(archive->state);
+	return TRUE;
+}
+
+
+/** Close an archive
+ *
+ * An archive being written gets its index, for readers to find the
+ * records without reading through them.
+ *
+ * @param archive state archive
+ *
+ * @retval FALSE if writing the archive failed
+ * @retval TRUE otherwise
+ */
+int libatari800_archive_close(libatari800_archive_t *archive)
+{
+	int ok = TRUE;
+
+	if (archive == NULL)
+		return TRUE;
+	if (archive->writing) {
+		UBYTE buf[INDEX_FOOTER];
+		int i;
+		for (i = 0; i < archive->count && ok; i++) {
+			put_u64(buf, archive->offsets[i]);
+			ok = fwrite(buf, 1, 8, archive->fp) == 8;
+		}
+		put_u64(buf, archive->pos);
+		put_u32(buf + 8, (ULONG)archive->count);
+		memcpy(buf + 12, INDEX_MAGIC, 4);
+		ok = ok && fwrite(buf, 1, INDEX_FOOTER, archive->fp) == INDEX_FOOTER;
+		ok = fclose(archive->fp) == 0 && ok;
+	}
+	free_archive(archive);
+	return ok;
+}
@@ -0,0 +1,285 @@
+/*
+ * libatari800/ttable.c - Atari800 as a library - transposition table
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+/* A fixed-size open addressing table from state hashes (see
+   libatari800_get_state_hash) to a snapshot handle, a visit count and a
+   value sum, for search workers to find the states they reach that another
+   worker, or another context, reached first. Entries are claimed by
+   compare-and-swap on their key and never removed, so threads may look up,
+   insert and update at once without a lock. */
+
+#include "config.h"
+#include <stdlib.h>
+#include <string.h>
+
+#include "libatari800.h"
+
+/* Without GCC's atomics the table is for one thread only */
+#ifdef __GNUC__
+#define ATOMIC_LOAD(p)     __atomic_load_n(p, __ATOMIC_ACQUIRE)
+#define ATOMIC_STORE(p, v) __atomic_store_n(p, v, __ATOMIC_RELEASE)
+#define ATOMIC_ADD(p, n)   __atomic_fetch_add(p, n, __ATOMIC_RELAXED)
+#define ATOMIC_CAS(p, old, v) \
+	__atomic_compare_exchange_n(p, old, v, FALSE, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+#else
+static int atomic_cas(uint64_t *p, uint64_t *old, uint64_t v)
+{
+	if (*p != *old) {
+		*old = *p;
+		return FALSE;
+	}
+	*p = v;
+	return TRUE;
+}
+#define ATOMIC_LOAD(p)     (*(p))
+#define ATOMIC_STORE(p, v) (*(p) = (v))
+#define ATOMIC_ADD(p, n)   (*(p) += (n))
+#define ATOMIC_CAS(p, old, v) atomic_cas(p, old, v)
+#endif
+
+#define MAX_CAPACITY (1 << 28)
+
+typedef struct {
+	uint64_t key;      /* state hash, 0 = free */
+	uint64_t value;    /* bits of the double sum of values */
+	int64_t visits;
+	int snapshot;      /* -1 until set */
+	int pad;
+} slot_t;
+
+struct libatari800_ttable {
+	slot_t *slots;
+	uint64_t mask;     /* capacity - 1 */
+	int limit;         /* entries before inserting fails */
+	int count;
+};
+
+#define VALID(t, entry) ((entry) >= 0 && (uint64_t)(entry) <= (t)->mask)
+
+/* Hash 0 marks free slots, and shares the key of hash 1 */
+static uint64_t key_of(uint64_t hash)
+{
+	return hash != 0 ? hash : 1;
+}
+
+
+/** Create an empty transposition table
+ *
+ * The table has room for \a capacity entries, rounded up to a power of two,
+ * and stops taking new ones when seven eighths full, as lookups grow long
+ * beyond that. Each entry takes 32 bytes.
+ *
+ * The table belongs to no context: workers stepping different contexts in
+ * one process share it, each looking up the states its machine reaches.
+ *
+ * @param capacity entries, up to 2^28
+ *
+ * @returns new table, to be released with \a libatari800_ttable_free, or
+ * NULL if \a capacity is out of range or the memory is not available
+ */
+libatari800_ttable_t *libatari800_ttable_new(int capacity)
+{
+	libatari800_ttable_t *t;
+	int size = 1;
+	int i;
+
+	if (capacity < 1 || capacity > MAX_CAPACITY)
+		return NULL;
+	while (size < capacity)
+		size <<= 1;
+	t = (libatari800_ttable_t *)malloc(sizeof(*t));
+	if (t == NULL)
+		return NULL;
+	t->slots = (slot_t *)calloc(size, sizeof(slot_t));
+	if (t->slots == NULL) {
+		free(t);
+		return NULL;
+	}
+	for (i = 0; i < size; i++)
+		t->slots[i].snapshot = -1;
+	t->mask = size - 1;
+	t->limit = size - size / 8;
+	t->count = 0;
+	return t;
+}
+
+
+/** Find the entry of a state, or make one
+ *
+ * When two threads insert the same hash at once, one of them creates the
+ * entry and the other finds it. The creator is the one to store the state,
+ * e.g. with \a libatari800_snapshot_store_save, and to set the handle with
+ * \a libatari800_ttable_set_snapshot; until then the others see no
+ * snapshot.
+ *
+ * @param t transposition table
+ * @param hash state hash, e.g. from \a libatari800_get_state_hash
+ * @param insert whether to make an entry if there is none
+ * @param created if not NULL, set to TRUE if this call made the entry
+ *
+ * @returns entry number, or -1 if there is none and \a insert is FALSE or
+ * the table is full
+ */
+int libatari800_ttable_lookup(libatari800_ttable_t *t, uint64_t hash, int insert, int *created)
+{
+	uint64_t key = key_of(hash);
+	uint64_t i = key & t->mask;
+	uint64_t n;
+
+	if (created != NULL)
+		*created = FALSE;
+	for (n = 0; n <= t->mask; n++, i = (i + 1) & t->mask) {
+		uint64_t k = ATOMIC_LOAD(&t->slots[i].key);
+		if (k == 0) {
+			if (!insert || ATOMIC_LOAD(&t->count) >= t->limit)
+				return -1;
+			if (ATOMIC_CAS(&t->slots[i].key, &k, key)) {
+				ATOMIC_ADD(&t->count, 1);
+				if (created != NULL)
+					*created = TRUE;
+				return (int)i;
+			}
+			/* Another thread took the slot, maybe for this state */
+		}
+		if (k == key)
+			return (int)i;
+	}
+	return -1;
+}
+
+
+/** Set the snapshot handle of an entry
+ *
+ * The handle is the caller's, e.g. an id from \a
+ * libatari800_snapshot_store_save; the table only keeps it.
+ *
+ * @param t transposition table
+ * @param entry entry from \a libatari800_ttable_lookup
+ * @param snapshot handle, 0 or more, or -1 for none
+ */
+void libatari800_ttable_set_snapshot(libatari800_ttable_t *t, int entry, int snapshot)
+{
+	if (VALID(t, entry))
+		ATOMIC_STORE(&t->slots[entry].snapshot, snapshot);
+}
+
+
+/** Return the snapshot handle of an entry
+ *
+ * @param t transposition table
+ * @param entry entry from \a libatari800_ttable_lookup
+ *
+ * @returns the handle set, or -1 if none has been set yet or \a entry is
+ * not one
+ */
+int libatari800_ttable_get_snapshot(libatari800_ttable_t *t, int entry)
+{
+	if (!VALID(t, entry))
+		return -1;
+	return ATOMIC_LOAD(&t->slots[entry].snapshot);
+}
+
+
+/** Add visits and value to an entry
+ *
+ * For the backups of a tree search: the visit count and the value sum of
+ * the entry grow by \a visits and \a value. Negative numbers take back a
+ * virtual loss.
+ *
+ * @param t transposition table
+ * @param entry entry from \a libatari800_ttable_lookup
+ * @param visits visits to add
+ * @param value value to add
+ */
+void libatari800_ttable_update(libatari800_ttable_t *t, int entry, int visits, double value)
+{
+	slot_t *slot;
+	uint64_t old, bits;
+	double sum;
+
+	if (!VALID(t, entry))
+		return;
+	slot = &t->slots[entry];
+	old = ATOMIC_LOAD(&slot->value);
+	ATOMIC_ADD(&slot->visits, visits);
+	do {
+		memcpy(&sum, &old, sizeof(sum));
+		sum += value;
+		memcpy(&bits, &sum, sizeof(bits));
+	} while (!ATOMIC_CAS(&slot->value, &old, bits));
+}
+
+
+/** Return the visits and the value sum of an entry
+ *
+ * While other threads update the entry the two may come from different
+ * moments.
+ *
+ * @param t transposition table
+ * @param entry entry from \a libatari800_ttable_lookup
+ * @param visits if not NULL, set to the visit count
+ * @param value if not NULL, set to the value sum
+ */
+void libatari800_ttable_get_stats(libatari800_ttable_t *t, int entry, int64_t *visits, double *value)
+{
+	slot_t *slot;
+
+	if (!VALID(t, entry)) {
+		if (visits != NULL)
+			*visits = 0;
+		if (value != NULL)
+			*value = 0;
+		return;
+	}
+	slot = &t->slots[entry];
+	if (visits != NULL)
+		*visits = ATOMIC_LOAD(&slot->visits);
+	if (value != NULL) {
+		uint64_t bits = ATOMIC_LOAD(&slot->value);
+		memcpy(value, &bits, sizeof(*value));
+	}
+}
+
+
+/** Return the number of entries in a table
+ *
+ * @param t transposition table
+ */
+int libatari800_ttable_count(libatari800_ttable_t *t)
+{
+	return ATOMIC_LOAD(&t->count);
+}
+
+
+/** Empty a table
+ *
+ * Not to be called while other threads use the table.
+ *
+ * @param t transposition table
+ */
+void libatari800_ttable_clear(libatari800_ttable_t *t)
+{
+	uint64_t i;
+
+	memset(t->slots, 0, (t->mask + 1) * sizeof(slot_t));
+	for (i = 0; i <= t->mask; i++)
+		t->slots[i].snapshot = -1;
+	t->count = 0;
+}
+
+
+/** Release a transposition table
+ *
+ * @param t transposition table
+ */
+void libatari800_ttable_free(libatari800_ttable_t *t)
+{
+	if (t == NULL)
+		return;
+	free(t->slots);
+	free(t);
+}
@@ -0,0 +1,436 @@
+/*
+ * libatari800/vecenv.c - Atari800 as a library - vectorized environments
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+/* A vectorized environment is n contexts started from one snapshot and
+   stepped together, in the shape of a Gymnasium vector env: each step
+   gives every environment its input for a number of frames and collects
+   the observations, rewards and end flags into contiguous arrays, and an
+   environment whose episode ended is reset to the start in the same step.
+   Rewards and end conditions are features (see libatari800_set_features):
+   the reward is the sum of the reward features, and the episode ends when
+   a done feature is not 0, when the emulation fails (a CPU crash or a bad
+   display list) or, cut short, after a number of frames.
+
+   Where threads are available a worker thread steps the environments, so
+   the caller works on one step's results while the next runs. The results
+   are double-buffered for that: those of a step stay valid until the step
+   after the next is started. The contexts share the emulator's globals,
+   so the worker steps them one after another, and the caller must leave
+   the emulator alone between libatari800_vecenv_step_async and
+   libatari800_vecenv_step_wait. */
+
+#include "config.h"
+#include <stdlib.h>
+#include <string.h>
+#ifdef HAVE_PTHREAD_CREATE
+#include <pthread.h>
+#endif
+
+#include "libatari800.h"
+#include "log.h"
+#include "util.h"
+
+#define IDLE    0
+#define PENDING 1
+#define QUIT    2
+
+struct libatari800_vecenv {
+	int n, frames, flags;
+	int width, height, format;
+	int max_frames;                 /* 0 = no limit */
+	atari800_ctx_t **ctxs;
+	UBYTE *start;                   /* snapshot every episode starts from */
+	UBYTE *start_obs;               /* and its observation */
+	feature_template_t features[LIBATARI800_MAX_FEATURES];
+	int nreward, ndone;             /* reward features, then done features */
+	float *values;                  /* LIBATARI800_MAX_FEATURES per environment */
+	input_template_t *inputs;
+	int *episode_frames;            /* of the running episodes */
+	libatari800_vecenv_result_t result[2];
+	int next;                       /* result the next step writes */
+#ifdef HAVE_PTHREAD_CREATE
+	pthread_t thread;
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	int state;
+	int threaded;                   /* the worker runs */
+#endif
+};
+
+static void reset_env(libatari800_vecenv_t *v, int i, libatari800_vecenv_result_t *r)
+{
+	size_t size = (size_t)v->width * v->height;
+
+	libatari800_ctx_select(v->ctxs[i]);
+	libatari800_restore_snapshot(v->start);
+	/* Deltas are from the start */
+	libatari800_eval_features();
+	memcpy(r->obs + i * size, v->start_obs, size);
+	v->episode_frames[i] = 0;
+}
+
+static void reset_all(libatari800_vecenv_t *v, libatari800_vecenv_result_t *r)
+{
+	atari800_ctx_t *was = libatari800_ctx_selected();
+	int i;
+
+	for (i = 0; i < v->n; i++) {
+		reset_env(v, i, r);
+		r->rewards[i] = 0.0f;
+		r->terminated[i] = r->truncated[i] = FALSE;
+		r->episode_frames[i] = 0;
+	}
+	libatari800_ctx_select(was);
+}
+
+static void step_all(libatari800_vecenv_t *v, libatari800_vecenv_result_t *r)
+{
+	atari800_ctx_t *was = libatari800_ctx_selected();
+	size_t size = (size_t)v->width * v->height;
+	int i, j;
+
+	for (i = 0; i < v->n; i++) {
+		const float *values = v->values + i * LIBATARI800_MAX_FEATURES;
+		int ok, done = FALSE;
+		float reward = 0.0f;
+
+		libatari800_ctx_select(v->ctxs[i]);
+		ok = libatari800_next_frames(&v->inputs[i], v->frames, v->flags) == v->frames;
+		libatari800_get_observation(r->obs + i * size, v->width, v->height, v->format, 0, 0, 0, 0);
+		v->episode_frames[i] += v->frames;
+		for (j = 0; j < v->nreward; j++)
+			reward += values[j];
+		for (; j < v->nreward + v->ndone; j++)
+			done |= values[j] != 0.0f;
+		r->rewards[i] = reward;
+		r->terminated[i] = done || !ok;
+		r->truncated[i] = !r->terminated[i] && v->max_frames > 0 && v->episode_frames[i] >= v->max_frames;
+		r->episode_frames[i] = v->episode_frames[i];
+		if (r->terminated[i] || r->truncated[i])
+			reset_env(v, i, r);
+	}
+	libatari800_ctx_select(was);
+}
+
+#ifdef HAVE_PTHREAD_CREATE
+static void *worker(void *arg)
+{
+	libatari800_vecenv_t *v = (libatari800_vecenv_t *)arg;
+
+	pthread_mutex_lock(&v->lock);
+	for (;;) {
+		if (v->state == QUIT)
+			break;
+		if (v->state != PENDING) {
+			pthread_cond_wait(&v->cond, &v->lock);
+			continue;
+		}
+		pthread_mutex_unlock(&v->lock);
+		step_all(v, &v->result[v->next]);
+		pthread_mutex_lock(&v->lock);
+		v->state = IDLE;
+		pthread_cond_broadcast(&v->cond);
+	}
+	pthread_mutex_unlock(&v->lock);
+	return NULL;
+}
+
+static void wait_idle(libatari800_vecenv_t *v)
+{
+	if (!v->threaded)
+		return;
+	pthread_mutex_lock(&v->lock);
+	while (v->state == PENDING)
+		pthread_cond_wait(&v->cond, &v->lock);
+	pthread_mutex_unlock(&v->lock);
+}
+#else
+#define wait_idle(v) do { } while (0)
+#endif
+
+static void result_free(libatari800_vecenv_result_t *r)
+{
+	free(r->obs);
+	free(r->rewards);
+	free(r->terminated);
+	free(r->truncated);
+	free(r->episode_frames);
+}
+
+
+/** Create a vectorized environment
+ *
+ * Makes \a n contexts (see \a libatari800_ctx_new) of the selected machine,
+ * whose current state becomes the start of every episode, and starts the
+ * worker thread where threads are available. Set the rewards and end
+ * conditions, then call \a libatari800_vecenv_reset.
+ *
+ * @param n number of environments
+ * @param frames frames each step runs, with the same input (see \a
+ * libatari800_next_frames)
+ * @param flags LIBATARI800_FRAMES_MAXPOOL to max-pool the last two frames
+ * of a step for its observation, else 0
+ * @param width observation width, 1 - 384
+ * @param height observation height, 1 - 240
+ * @param format LIBATARI800_OBS_GRAY or LIBATARI800_OBS_INDEX
+ *
+ * @returns new vectorized environment, to be released with \a
+ * libatari800_vecenv_free, or NULL if the arguments are invalid
+ */
+libatari800_vecenv_t *libatari800_vecenv_new(int n, int frames, int flags,
+		int width, int height, int format)
+{
+	libatari800_vecenv_t *v;
+	size_t size = (size_t)width * height;
+	int i, start_size;
+
+	if (n < 1 || frames < 1 || width < 1 || width > 384 || height < 1 || height > 240
+			|| (format != LIBATARI800_OBS_GRAY && format != LIBATARI800_OBS_INDEX))
+		return NULL;
+	v = (libatari800_vecenv_t *)Util_malloc(sizeof(libatari800_vecenv_t));
+	memset(v, 0, sizeof(*v));
+	v->n = n;
+	v->frames = frames;
+	v->flags = flags & LIBATARI800_FRAMES_MAXPOOL;
+	v->width = width;
+	v->height = height;
+	v->format = format;
+	start_size = libatari800_save_snapshot(NULL, 0);
+	v->start = (UBYTE *)Util_malloc(start_size);
+	libatari800_save_snapshot(v->start, start_size);
+	v->start_obs = (UBYTE *)Util_malloc(size);
+	libatari800_get_observation(v->start_obs, width, height, format, 0, 0, 0, 0);
+	v->ctxs = (atari800_ctx_t **)Util_malloc(n * sizeof(atari800_ctx_t *));
+	for (i = 0; i < n; i++)
+		v->ctxs[i] = libatari800_ctx_new();
+	v->values = (float *)Util_malloc((size_t)n * LIBATARI800_MAX_FEATURES * sizeof(float));
+	v->inputs = (input_template_t *)Util_malloc(n * sizeof(input_template_t));
+	for (i = 0; i < n; i++)
+		libatari800_clear_input_array(&v->inputs[i]);
+	v->episode_frames = (int *)Util_malloc(n * sizeof(int));
+	for (i = 0; i < 2; i++) {
+		libatari800_vecenv_result_t *r = &v->result[i];
+		r->obs = (UBYTE *)Util_malloc(n * size);
+		r->rewards = (float *)Util_malloc(n * sizeof(float));
+		r->terminated = (UBYTE *)Util_malloc(n);
+		r->truncated = (UBYTE *)Util_malloc(n);
+		r->episode_frames = (int *)Util_malloc(n * sizeof(int));
+	}
+	reset_all(v, &v->result[0]);
+#ifdef HAVE_PTHREAD_CREATE
+	pthread_mutex_init(&v->lock, NULL);
+	pthread_cond_init(&v->cond, NULL);
+	v->state = IDLE;
+	v->threaded = pthread_create(&v->thread, NULL, worker, v) == 0;
+	if (!v->threaded)
+		Log_print("libatari800_vecenv_new: cannot start the worker thread, stepping at once");
+#endif
+	return v;
+}
+
+static int set_features(libatari800_vecenv_t *v, const feature_template_t *features, int n, int done)
+{
+	feature_template_t all[LIBATARI800_MAX_FEATURES];
+	atari800_ctx_t *was;
+	int nreward = done ? v->nreward : n;
+	int ndone = done ? n : v->ndone;
+	int i, ok = TRUE;
+
+	if (n < 0 || nreward + ndone > LIBATARI800_MAX_FEATURES)
+		return FALSE;
+	wait_idle(v);
+	memcpy(all, v->features, v->nreward * sizeof(feature_template_t));
+	memcpy(all + nreward, v->features + v->nreward, v->ndone * sizeof(feature_template_t));
+	memcpy(all + (done ? nreward : 0), features, n * sizeof(feature_template_t));
+	was = libatari800_ctx_selected();
+	for (i = 0; i < v->n && ok; i++) {
+		libatari800_ctx_select(v->ctxs[i]);
+		ok = libatari800_set_features(all, nreward + ndone, v->values + i * LIBATARI800_MAX_FEATURES);
+		if (ok)
+			libatari800_eval_features();
+	}
+	libatari800_ctx_select(was);
+	if (!ok)
+		return FALSE;
+	memcpy(v->features, all, (nreward + ndone) * sizeof(feature_template_t));
+	v->nreward = nreward;
+	v->ndone = ndone;
+	return TRUE;
+}
+
+
+/** Set the reward of the environments
+ *
+ * The reward of a step is the sum of the features' values after it; a
+ * score would be a LIBATARI800_FEATURE_BCD feature with delta set. Deltas
+ * are measured from the start of the episode or the previous step.
+ *
+ * @param v vectorized environment
+ * @param features array of \a n features, as for \a libatari800_set_features
+ * @param n number of features, 0 for no reward
+ *
+ * @retval FALSE if a feature is invalid or there are more than
+ * LIBATARI800_MAX_FEATURES with the done features; the previous ones stay
+ * @retval TRUE if successful
+ */
+int libatari800_vecenv_set_reward(libatari800_vecenv_t *v, const feature_template_t *features, int n)
+{
+	return set_features(v, features, n, FALSE);
+}
+
+
+/** Set the end conditions of the episodes
+ *
+ * An episode ends (is terminated) after the step at which any of the
+ * features is not 0, such as a LIBATARI800_FEATURE_BIT of a game over flag
+ * or a lives counter with delta set. It also ends if the emulation fails.
+ *
+ * @param v vectorized environment
+ * @param features array of \a n features, as for \a libatari800_set_features
+ * @param n number of features, 0 for none
+ *
+ * @retval FALSE if a feature is invalid or there are more than
+ * LIBATARI800_MAX_FEATURES with the reward features; the previous ones stay
+ * @retval TRUE if successful
+ */
+int libatari800_vecenv_set_done(libatari800_vecenv_t *v, const feature_template_t *features, int n)
+{
+	return set_features(v, features, n, TRUE);
+}
+
+
+/** Cut episodes short after a number of frames
+ *
+ * An episode that has run \a frames frames without ending is truncated at
+ * the end of that step and reset.
+ *
+ * @param v vectorized environment
+ * @param frames frame limit, 0 for none
+ */
+void libatari800_vecenv_set_max_frames(libatari800_vecenv_t *v, int frames)
+{
+	v->max_frames = frames < 0 ? 0 : frames;
+}
+
+
+/** Reset all environments to the start
+ *
+ * Waits for a step in progress first.
+ *
+ * @param v vectorized environment
+ *
+ * @returns results holding the start observations, with no rewards or end
+ * flags
+ */
+const libatari800_vecenv_result_t *libatari800_vecenv_reset(libatari800_vecenv_t *v)
+{
+	libatari800_vecenv_result_t *r;
+
+	wait_idle(v);
+	r = &v->result[v->next];
+	reset_all(v, r);
+	v->next ^= 1;
+	return r;
+}
+
+
+/** Start a step of all environments
+ *
+ * Environment i runs the step's frames with inputs[i]; one that ends the
+ * episode is reset, its observation in the results being the start of
+ * the next. The step runs in the worker thread if there is one, else at
+ * once; until \a libatari800_vecenv_step_wait returns, the emulator must
+ * not be used otherwise.
+ *
+ * @param v vectorized environment
+ * @param inputs array of \a n inputs, copied
+ */
+void libatari800_vecenv_step_async(libatari800_vecenv_t *v, const input_template_t *inputs)
+{
+	wait_idle(v);
+	memcpy(v->inputs, inputs, v->n * sizeof(input_template_t));
+#ifdef HAVE_PTHREAD_CREATE
+	if (v->threaded) {
+		pthread_mutex_lock(&v->lock);
+		v->state = PENDING;
+		pthread_cond_signal(&v->cond);
+		pthread_mutex_unlock(&v->lock);
+		return;
+	}
+#endif
+	step_all(v, &v->result[v->next]);
+}
+
+
+/** Wait for the step started by \a libatari800_vecenv_step_async
+ *
+ * @param v vectorized environment
+ *
+ * @returns results of the step: n observations of height x width bytes in
+ * one array, n rewards, n flags for episodes that ended and for those cut
+ * short, and the frames each episode had run at the end of the step. They
+ * stay valid until the step after the next is started.
+ */
+const libatari800_vecenv_result_t *libatari800_vecenv_step_wait(libatari800_vecenv_t *v)
+{
+	libatari800_vecenv_result_t *r;
+
+	wait_idle(v);
+	r = &v->result[v->next];
+	v->next ^= 1;
+	return r;
+}
+
+
+/** Step all environments and wait for the results
+ *
+ * @param v vectorized environment
+ * @param inputs array of \a n inputs
+ *
+ * @returns as \a libatari800_vecenv_step_wait
+ */
+const libatari800_vecenv_result_t *libatari800_vecenv_step(libatari800_vecenv_t *v, const input_template_t *inputs)
+{
+	libatari800_vecenv_step_async(v, inputs);
+	return libatari800_vecenv_step_wait(v);
+}
+
+
+/** Free a vectorized environment and its contexts
+ *
+ * @param v vectorized environment, or NULL
+ */
+void libatari800_vecenv_free(libatari800_vecenv_t *v)
+{
+	int i;
+
+	if (v == NULL)
+		return;
+	wait_idle(v);
+#ifdef HAVE_PTHREAD_CREATE
+	if (v->threaded) {
+		pthread_mutex_lock(&v->lock);
+		v->state = QUIT;
+		pthread_cond_signal(&v->cond);
+		pthread_mutex_unlock(&v->lock);
+		pthread_join(v->thread, NULL);
+	}
+	pthread_cond_destroy(&v->cond);
+	pthread_mutex_destroy(&v->lock);
+#endif
+	for (i = 0; i < v->n; i++)
+		libatari800_ctx_free(v->ctxs[i]);
+	for (i = 0; i < 2; i++)
+		result_free(&v->result[i]);
+	free(v->ctxs);
+	free(v->start);
+	free(v->start_obs);
+	free(v->values);
+	free(v->inputs);
+	free(v->episode_frames);
+	free(v);
+}
@@ -75,9 +75,12 @@ map_save save_map[2] = {
 
 #endif /* PAGED_ATTRIB */
 
-UBYTE MEMORY_basic[8192];
-UBYTE MEMORY_os[16384];
-UBYTE MEMORY_xegame[8192];
+UBYTE MEMORY_basic_buffer[8192];
+UBYTE MEMORY_os_buffer[16384];
+UBYTE MEMORY_xegame_buffer[8192];
+UBYTE const *MEMORY_basic = MEMORY_basic_buffer;
+UBYTE const *MEMORY_os = MEMORY_os_buffer;
+UBYTE const *MEMORY_xegame = MEMORY_xegame_buffer;
 
 int MEMORY_xe_bank = 0;
 int MEMORY_selftest_enabled = 0;
@@ -398,11 +401,11 @@ void MEMORY_StateSave(UBYTE SaveVerbose)
 
 	if (Atari800_machine_type == Atari800_MACHINE_XLXE) {
 		if (SaveVerbose != 0)
-			StateSav_SaveUBYTE(&MEMORY_basic[0], 8192);
+			StateSav_SaveUBYTE(MEMORY_basic, 8192);
 		StateSav_SaveUBYTE(&under_cartA0BF[0], 8192);
 
 		if (SaveVerbose != 0)
-			StateSav_SaveUBYTE(&MEMORY_os[0], 16384);
+			StateSav_SaveUBYTE(MEMORY_os, 16384);
 		StateSav_SaveUBYTE(&under_atarixl_os[0], 16384);
 		if (SaveVerbose != 0)
 			StateSav_SaveUBYTE(MEMORY_xegame, 0x2000);
@@ -578,15 +581,21 @@ void MEMORY_StateRead(UBYTE SaveVerbose, UBYTE StateVersion)
 #endif
 
 	if (Atari800_machine_type == Atari800_MACHINE_XLXE) {
-		if (SaveVerbose)
-			StateSav_ReadUBYTE(&MEMORY_basic[0], 8192);
+		if (SaveVerbose) {
+			StateSav_ReadUBYTE(&MEMORY_basic_buffer[0], 8192);
+			MEMORY_basic = MEMORY_basic_buffer;
+		}
 		StateSav_ReadUBYTE(&under_cartA0BF[0], 8192);
 
-		if (SaveVerbose)
-			StateSav_ReadUBYTE(&MEMORY_os[0], 16384);
+		if (SaveVerbose) {
+			StateSav_ReadUBYTE(&MEMORY_os_buffer[0], 16384);
+			MEMORY_os = MEMORY_os_buffer;
+		}
 		StateSav_ReadUBYTE(&under_atarixl_os[0], 16384);
-		if (StateVersion >= 7 && SaveVerbose)
-			StateSav_ReadUBYTE(MEMORY_xegame, 0x2000);
+		if (StateVersion >= 7 && SaveVerbose) {
+			StateSav_ReadUBYTE(MEMORY_xegame_buffer, 0x2000);
+			MEMORY_xegame = MEMORY_xegame_buffer;
+		}
 	}
 
 	if (StateVersion >= 7) {
@@ -1066,6 +1075,113 @@ void MEMORY_GetCharset(UBYTE *cs)
 	memcpy(cs + 0x300, ROM_altirra_5200_os + 0x300, 0x100); /* lowercase letters */
 }
 
+/* Where the banks of a kind are kept, how many there are, how long one is,
+   where the live one shows in MEMORY_mem and which it is. Returns FALSE if
+   the kind has no banks. */
+static int bank_layout(int kind, UBYTE **stored, int *banks, int *size, UWORD *window, int *live)
+{
+	switch (kind) {
+	case MEMORY_BANK_XE:
+		*stored = atarixe_memory;
+		*banks = atarixe_memory_size >> 14;
+		*size = 0x4000;
+		*window = 0x4000;
+		*live = ((PIA_PORTB | PIA_PORTB_mask) & 0x10) ? 0 : MEMORY_xe_bank;
+		break;
+	case MEMORY_BANK_AXLON:
+		*stored = axlon_ram;
+		*banks = axlon_ram != NULL ? axlon_current_bankmask + 1 : 0;
+		*size = 0x4000;
+		*window = 0x4000;
+		*live = axlon_curbank;
+		break;
+	case MEMORY_BANK_MOSAIC:
+		*stored = mosaic_ram;
+		*banks = mosaic_ram != NULL ? mosaic_current_num_banks : 0;
+		*size = 0x1000;
+		*window = 0xc000;
+		*live = mosaic_curbank;
+		break;
+	default:
+		return FALSE;
+	}
+	return *stored != NULL;
+}
+
+/* Self Test ROM or MapRAM may cover 0x5000-0x57ff of an XE bank in either
+   the CPU's or ANTIC's view; returns where the RAM under it is kept aside,
+   or NULL if the bank is not covered */
+static UBYTE const *xe_bank_under(int bank, int live)
+{
+	UBYTE portb = PIA_PORTB | PIA_PORTB_mask;
+	int hidden = MEMORY_selftest_enabled
+		|| (mapram_memory != NULL && MEMORY_ram_size > 20 && (portb & 0xb1) == 0x30);
+	if (bank == live && hidden)
+		return under_atarixl_os + 0x1000;
+	if (MEMORY_selftest_enabled && ANTIC_xe_ptr != NULL
+	    && bank == (int) ((ANTIC_xe_ptr - atarixe_memory) >> 14))
+		return antic_bank_under_selftest;
+	return NULL;
+}
+
+int MEMORY_ReadBank(int kind, int bank, int offset, UBYTE *dest, int len)
+{
+	UBYTE *stored;
+	int banks, size, live;
+	UWORD window;
+
+	if (!bank_layout(kind, &stored, &banks, &size, &window, &live)
+	    || bank < 0 || bank >= banks || offset < 0 || len < 0 || len > size - offset)
+		return FALSE;
+
+	if (bank == live)
+		memcpy(dest, MEMORY_mem + window + offset, len);
+	else
+		memcpy(dest, stored + bank * size + offset, len);
+
+	if (kind == MEMORY_BANK_XE && offset < 0x1800 && offset + len > 0x1000) {
+		UBYTE const *under = xe_bank_under(bank, live);
+		int from = offset > 0x1000 ? offset : 0x1000;
+		int to = offset + len < 0x1800 ? offset + len : 0x1800;
+		if (under != NULL)
+			memcpy(dest + from - offset, under + from - 0x1000, to - from);
+	}
+	return TRUE;
+}
+
+UBYTE const *MEMORY_BankPage(int kind, int bank, int page)
+{
+	UBYTE *stored;
+	int banks, size, live;
+	UWORD window;
+
+	if (!bank_layout(kind, &stored, &banks, &size, &window, &live)
+	    || bank < 0 || bank >= banks || page < 0 || page >= size >> 8)
+		return NULL;
+	if (kind == MEMORY_BANK_XE && page >= 0x10 && page < 0x18) {
+		UBYTE const *under = xe_bank_under(bank, live);
+		if (under != NULL)
+			return under + ((page - 0x10) << 8);
+	}
+	if (bank == live)
+		return MEMORY_mem + window + (page << 8);
+	return stored + bank * size + (page << 8);
+}
+
+int MEMORY_BankLive(int kind, int *banks)
+{
+	UBYTE *stored;
+	int size, live;
+	UWORD window;
+
+	if (!bank_layout(kind, &stored, banks, &size, &window, &live)) {
+		*banks = 0;
+		return -1;
+	}
+	/* Mosaic banks past the last leave the ROM in the window */
+	return live < *banks ? live : -1;
+}
+
 #ifndef PAGED_MEM
 UBYTE MEMORY_HwGetByte(UWORD addr, int no_side_effects)
 {
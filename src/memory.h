@@ -94,9 +94,15 @@ void MEMORY_ROM_PutByte(UWORD addr, UBYTE byte);
 
 #endif /* PAGED_ATTRIB */
 
-extern UBYTE MEMORY_basic[8192];
-extern UBYTE MEMORY_os[16384];
-extern UBYTE MEMORY_xegame[8192];
+/* The system ROMs, as set by SYSROM_LoadImage(): shared read-only images
+   where possible, else the buffers below, which also receive the ROMs
+   of verbose state files. */
+extern UBYTE const *MEMORY_basic;
+extern UBYTE const *MEMORY_os;
+extern UBYTE const *MEMORY_xegame;
+extern UBYTE MEMORY_basic_buffer[8192];
+extern UBYTE MEMORY_os_buffer[16384];
+extern UBYTE MEMORY_xegame_buffer[8192];
 
 extern int MEMORY_xe_bank;
 extern int MEMORY_selftest_enabled;
@@ -120,6 +126,28 @@ void MEMORY_CartA0bfEnable(void);
 #define MEMORY_CopyToCart(addr1, addr2, dst) memcpy(dst, MEMORY_mem + (addr1), (addr2) - (addr1) + 1)
 void MEMORY_GetCharset(UBYTE *cs);
 
+/* Copies len bytes from offset in an extended memory bank to dest, whether
+   the bank is switched in or not, without switching banks. XE bank 0 is
+   the base RAM at 0x4000-0x7fff and banks 1.. are the extended RAM, as in
+   MEMORY_xe_bank; Axlon banks are 16 KB and Mosaic banks 4 KB. Returns
+   FALSE if there is no such bank or the range does not fit in it. */
+#define MEMORY_BANK_XE      0
+#define MEMORY_BANK_AXLON   1
+#define MEMORY_BANK_MOSAIC  2
+int MEMORY_ReadBank(int kind, int bank, int offset, UBYTE *dest, int len);
+
+/* Returns the 256 bytes at page (0..63, or 0..15 for Mosaic) of an extended
+   memory bank as MEMORY_ReadBank would read them, in place: in MEMORY_mem
+   if the bank is switched in, else where it is kept. For reading many
+   banks without copying them; the pointer holds until the next bank
+   switch or memory write. NULL if there is no such page. */
+UBYTE const *MEMORY_BankPage(int kind, int bank, int page);
+
+/* Returns the bank of an extended memory kind the CPU sees in its window,
+   0x4000-0x7fff (0xc000-0xcfff for Mosaic), and sets *banks to the number
+   of banks; -1 if there are none or none is switched in. */
+int MEMORY_BankLive(int kind, int *banks);
+
 /* Mosaic and Axlon 400/800 RAM extensions */
 extern int MEMORY_mosaic_num_banks;
 extern int MEMORY_axlon_0f_mirror;
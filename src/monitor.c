@@ -25,6 +25,8 @@
 #define _POSIX_C_SOURCE 200112L /* for snprintf */
 
 #include "config.h"
+#include <ctype.h>
+#include <errno.h>
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
@@ -49,6 +51,8 @@
 #include "pia.h"
 #include "pokey.h"
 #include "util.h"
+#include "ai_search.h"
+#include "ai_trace.h"
 #ifdef STEREO_SOUND
 #include "pokeysnd.h"
 #endif
@@ -60,28 +64,15 @@
 #include <readline/history.h>
 #endif
 
+#include <stdarg.h>
+
 #ifdef __PLUS
 
-#include <stdarg.h>
 #include "misc_win.h"
 
 FILE *mon_output, *mon_input;
 
-void monitor_printf(const char *format, ...)
-{
-	va_list args;
-	va_start(args, format);
-	vfprintf(mon_output, format, args);
-	va_end(args);
-}
-
-#define printf            monitor_printf
-#define puts(s)           fputs(s, mon_output)
-#define putchar(c)        fputc(c, mon_output)
-#define perror(filename)  printf("%s: %s\n", filename, strerror(errno))
-
-#undef stdout
-#define stdout mon_output
+#define console_output() mon_output
 
 #undef stdin
 #define stdin mon_input
@@ -90,12 +81,38 @@ void monitor_printf(const char *format, ...)
 
 #else /* __PLUS */
 
+static FILE *console_output(void)
+{
+	return stdout;
+}
+
 #define PLUS_EXIT_MONITOR
 
 #endif /* __PLUS */
 
-UBYTE *trainer_memory = NULL;
-UBYTE *trainer_flags = NULL;
+/* While MONITOR_Batch() runs: where the output goes instead of the
+   console, and the script lines not yet read */
+static FILE *batch_output = NULL;
+static const char *batch_script;
+static int batch_line;
+
+static void monitor_printf(const char *format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	vfprintf(batch_output != NULL ? batch_output : console_output(), format, args);
+	va_end(args);
+}
+
+#define printf            monitor_printf
+#define puts(s)           fputs(s, stdout)
+#define putchar(c)        fputc(c, stdout)
+#define perror(filename)  printf("%s: %s\n", filename, strerror(errno))
+
+#undef stdout
+#define stdout (batch_output != NULL ? batch_output : console_output())
+
+static AI_SEARCH_t trainer = AI_SEARCH_INIT;
 
 #ifdef MONITOR_TRACE
 FILE *MONITOR_trace_file = NULL;
@@ -473,46 +490,223 @@ static void print_atascii_char(UWORD c) {
 
 #ifdef MONITOR_HINTS
 
-static const char *find_label_name(UWORD addr, int is_write)
+/* Label lookups are made for every instruction disassembled or traced and
+   for every address profiled, so rather than scanning the tables each
+   table gets an index: its labels sorted by address, for the label at an
+   address and the nearest one below it, and a hash table of their names.
+   The indexes of the built-in tables are built on first use, those of the
+   user labels again after they change. Where several labels share an
+   address or name, the first one in the table is found, as before. */
+typedef struct {
+	int size;       /* labels indexed */
+	int *by_addr;   /* the first label at each address, by address */
+	int naddrs;
+	int *by_name;   /* hash table of 1 + label numbers, 0 if empty */
+	int name_mask;
+	int valid;
+} label_index;
+
+static label_index builtin_index = {0, NULL, 0, NULL, 0, FALSE};
+static label_index builtin_5200_index = {0, NULL, 0, NULL, 0, FALSE};
+static label_index user_index = {0, NULL, 0, NULL, 0, FALSE};
+
+static unsigned int label_hash(const char *name)
 {
-	int i;
-	for (i = 0; i < symtable_user_size; i++) {
-		if (symtable_user[i].addr == addr)
-			return symtable_user[i].name;
-	}
-	if (symtable_builtin_enable) {
-		const symtable_rec *p;
-		for (p = (Atari800_machine_type == Atari800_MACHINE_5200 ? symtable_builtin_5200 : symtable_builtin); p->name != NULL; p++) {
-			if (p->addr == addr) {
-				if (is_write && p[1].addr == addr)
-					p++;
-				return p->name;
+	unsigned int h = 2166136261U;
+	while (*name != '\0')
+		h = (h ^ (UBYTE) tolower((UBYTE) *name++)) * 16777619U;
+	return h;
+}
+
+static const symtable_rec *label_table;
+
+static int compare_label_addr(const void *p1, const void *p2)
+{
+	int i1 = *(const int *) p1;
+	int i2 = *(const int *) p2;
+	if (label_table[i1].addr != label_table[i2].addr)
+		return label_table[i1].addr - label_table[i2].addr;
+	return i1 - i2;
+}
+
+static void build_label_index(label_index *index, const symtable_rec *table, int size)
+{
+	int i, slots = 16;
+	free(index->by_addr);
+	free(index->by_name);
+	index->size = size;
+	index->by_addr = (int *) Util_malloc((size + 1) * sizeof(int));
+	for (i = 0; i < size; i++)
+		index->by_addr[i] = i;
+	label_table = table;
+	qsort(index->by_addr, size, sizeof(int), compare_label_addr);
+	/* Keep the first of the labels at each address */
+	index->naddrs = 0;
+	for (i = 0; i < size; i++) {
+		if (index->naddrs == 0 || table[index->by_addr[index->naddrs - 1]].addr != table[index->by_addr[i]].addr)
+			index->by_addr[index->naddrs++] = index->by_addr[i];
+	}
+	while (slots < 2 * size)
+		slots <<= 1;
+	index->by_name = (int *) Util_malloc(slots * sizeof(int));
+	memset(index->by_name, 0, slots * sizeof(int));
+	index->name_mask = slots - 1;
+	for (i = 0; i < size; i++) {
+		unsigned int h = label_hash(table[i].name);
+		for (;; h++) {
+			int *slot = &index->by_name[h & index->name_mask];
+			if (*slot == 0) {
+				*slot = i + 1;
+				break;
 			}
+			if (Util_stricmp(table[*slot - 1].name, table[i].name) == 0)
+				break;
 		}
 	}
-	return NULL;
+	index->valid = TRUE;
 }
 
-static symtable_rec *find_user_label(const char *name)
+/* The user labels, or the enabled built-in ones, with their index */
+static const symtable_rec *user_labels(const label_index **index)
 {
-	int i;
-	for (i = 0; i < symtable_user_size; i++) {
-		if (Util_stricmp(symtable_user[i].name, name) == 0)
-			return &symtable_user[i];
+	if (!user_index.valid)
+		build_label_index(&user_index, symtable_user, symtable_user_size);
+	*index = &user_index;
+	return symtable_user;
+}
+
+static const symtable_rec *builtin_labels(const label_index **index)
+{
+	const symtable_rec *table;
+	label_index *p;
+	if (!symtable_builtin_enable)
+		return NULL;
+	if (Atari800_machine_type == Atari800_MACHINE_5200) {
+		table = symtable_builtin_5200;
+		p = &builtin_5200_index;
+	}
+	else {
+		table = symtable_builtin;
+		p = &builtin_index;
+	}
+	if (!p->valid) {
+		int size = 0;
+		while (table[size].name != NULL)
+			size++;
+		build_label_index(p, table, size);
+	}
+	*index = p;
+	return table;
+}
+
+/* Position in index->by_addr of the last label at or below addr, -1 if none */
+static int label_at_or_below(const label_index *index, const symtable_rec *table, UWORD addr)
+{
+	int lo = 0, hi = index->naddrs;
+	while (lo < hi) {
+		int mid = (lo + hi) / 2;
+		if (table[index->by_addr[mid]].addr <= addr)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	return lo - 1;
+}
+
+static const symtable_rec *label_by_name(const label_index *index, const symtable_rec *table, const char *name)
+{
+	unsigned int h = label_hash(name);
+	for (;; h++) {
+		int slot = index->by_name[h & index->name_mask];
+		if (slot == 0)
+			return NULL;
+		if (Util_stricmp(table[slot - 1].name, name) == 0)
+			return &table[slot - 1];
+	}
+}
+
+static const char *find_label_name(UWORD addr, int is_write)
+{
+	const label_index *index;
+	const symtable_rec *table = user_labels(&index);
+	int i = label_at_or_below(index, table, addr);
+	if (i >= 0 && table[index->by_addr[i]].addr == addr)
+		return table[index->by_addr[i]].name;
+	table = builtin_labels(&index);
+	if (table != NULL) {
+		i = label_at_or_below(index, table, addr);
+		if (i >= 0 && table[index->by_addr[i]].addr == addr) {
+			const symtable_rec *p = &table[index->by_addr[i]];
+			if (is_write && p[1].addr == addr)
+				p++;
+			return p->name;
+		}
 	}
 	return NULL;
 }
 
+#ifdef MONITOR_PROFILE
+/* The nearest label at or below addr (below is FALSE: above it) within
+   range, wrapping around at 0 and 0xffff; stores its distance from addr */
+static const char *find_nearby_label(UWORD addr, int below, int range, int *distance)
+{
+	const char *best = NULL;
+	int pass;
+	*distance = range + 1;
+	for (pass = 0; pass < 2; pass++) {
+		const label_index *index;
+		const symtable_rec *table = pass == 0 ? user_labels(&index) : builtin_labels(&index);
+		int i, d;
+		if (table == NULL || index->naddrs == 0)
+			continue;
+		i = label_at_or_below(index, table, below ? addr : (UWORD) (addr - 1));
+		if (!below)
+			i = i + 1 < index->naddrs ? i + 1 : 0;
+		else if (i < 0)
+			i = index->naddrs - 1;
+		d = (below ? addr - table[index->by_addr[i]].addr : table[index->by_addr[i]].addr - addr) & 0xffff;
+		/* User labels come first where both are as near */
+		if (d < *distance) {
+			best = table[index->by_addr[i]].name;
+			*distance = d;
+		}
+	}
+	return best;
+}
+#endif /* MONITOR_PROFILE */
+
+/* The user label nearest at or below addr, which names the routine that
+   code at addr belongs to; NULL if there is none */
+const char *MONITOR_RoutineLabel(UWORD addr, UWORD *label_addr)
+{
+	const label_index *index;
+	const symtable_rec *table = user_labels(&index);
+	int i = label_at_or_below(index, table, addr);
+	if (i < 0)
+		return NULL;
+	*label_addr = table[index->by_addr[i]].addr;
+	return table[index->by_addr[i]].name;
+}
+
+static symtable_rec *find_user_label(const char *name)
+{
+	const label_index *index;
+	const symtable_rec *table = user_labels(&index);
+	return (symtable_rec *) label_by_name(index, table, name);
+}
+
 static int find_label_value(const char *name)
 {
 	const symtable_rec *p = find_user_label(name);
+	const label_index *index;
+	const symtable_rec *table;
 	if (p != NULL)
 		return p->addr;
-	if (symtable_builtin_enable) {
-		for (p = (Atari800_machine_type == Atari800_MACHINE_5200 ? symtable_builtin_5200 : symtable_builtin); p->name != NULL; p++) {
-			if (Util_stricmp(p->name, name) == 0)
-				return p->addr;
-		}
+	table = builtin_labels(&index);
+	if (table != NULL) {
+		p = label_by_name(index, table, name);
+		if (p != NULL)
+			return p->addr;
 	}
 	return -1;
 }
@@ -525,6 +719,7 @@ static void free_user_labels(void)
 		free(symtable_user);
 		symtable_user = NULL;
 	}
+	user_index.valid = FALSE;
 }
 
 static void add_user_label(const char *name, UWORD addr)
@@ -541,6 +736,7 @@ static void add_user_label(const char *name, UWORD addr)
 	symtable_user[symtable_user_size].name = Util_strdup(name);
 	symtable_user[symtable_user_size].addr = addr;
 	symtable_user_size++;
+	user_index.valid = FALSE;
 }
 
 static void load_user_labels(const char *filename)
@@ -701,8 +897,29 @@ const UBYTE MONITOR_optype6502[256] = {
 };
 
 
+/* Takes the next line of the batch script into buffer; FALSE at its end */
+static int batch_gets(char *buffer, size_t size)
+{
+	size_t len = strcspn(batch_script, "\n");
+	if (*batch_script == '\0')
+		return FALSE;
+	Util_strlcpy(buffer, batch_script, len < size ? len + 1 : size);
+	batch_script += len;
+	if (*batch_script == '\n')
+		batch_script++;
+	batch_line++;
+	Util_chomp(buffer);
+	return TRUE;
+}
+
 static void safe_gets(char *buffer, size_t size, char const *prompt)
 {
+	if (batch_output != NULL) {
+		/* Commands that ask for more, such as A, read the script too */
+		if (!batch_gets(buffer, size))
+			buffer[0] = '\0';
+		return;
+	}
 #ifdef HAVE_FFLUSH
 	fflush(stdout);
 #endif
@@ -726,9 +943,15 @@ static void safe_gets(char *buffer, size_t size, char const *prompt)
 	Util_chomp(buffer);
 }
 
+/* MONITOR_Batch() does not page, but the output of a command that pages
+   on until told to quit ends at this size */
+#define BATCH_OUTPUT_MAX 0x40000
+
 static int pager(void)
 {
 	char buf[100];
+	if (batch_output != NULL)
+		return ftell(batch_output) >= BATCH_OUTPUT_MAX;
 	safe_gets(buf, sizeof(buf), "Press Return to continue ('q' to quit): ");
 	return buf[0] == 'q' || buf[0] == 'Q';
 }
@@ -895,68 +1118,91 @@ static int get_attrib_range(UWORD *addr1, UWORD *addr2)
 	return FALSE;
 }
 
-static UWORD show_instruction(FILE *fp, UWORD pc)
+UWORD MONITOR_DecodeInstruction(UWORD pc, MONITOR_instruction *insn)
 {
-	UWORD addr = pc;
-	UBYTE insn;
 	const char *mnemonic;
 	const char *p;
-	int value = 0;
-	int nchars = 0;
+	int len;
 
-	insn = MEMORY_SafeGetByte(pc);
+	insn->addr = pc;
+	insn->bytes[0] = MEMORY_SafeGetByte(pc);
+	insn->size = 1;
+	insn->target = -1;
+	insn->label = NULL;
 	pc++;
-	mnemonic = instr6502[insn];
-	for (p = mnemonic + 3; *p != '\0'; p++) {
+	mnemonic = instr6502[insn->bytes[0]];
+	for (len = 0; mnemonic[len] != '\0' && mnemonic[len] != ' '; len++)
+		insn->mnemonic[len] = mnemonic[len];
+	insn->mnemonic[len] = '\0';
+	insn->operand[0] = '\0';
+	if (mnemonic[len] == '\0')
+		return pc;
+	for (p = mnemonic + len + 1; *p != '\0'; p++) {
 		if (*p == '1') {
-			value = MEMORY_SafeGetByte(pc);
+			insn->bytes[1] = MEMORY_SafeGetByte(pc);
+			insn->size = 2;
+			insn->target = insn->bytes[1];
 			pc++;
-			nchars = fprintf(fp, "%04X: %02X %02X     " /*"%Xcyc  "*/ "%.*s$%02X%s",
-			                 addr, insn, value, /*cycles[insn],*/ (int) (p - mnemonic), mnemonic, value, p + 1);
+			snprintf(insn->operand, sizeof(insn->operand), "%.*s$%02X%s",
+			         (int) (p - mnemonic - len - 1), mnemonic + len + 1, insn->target, p + 1);
 			break;
 		}
 		if (*p == '2') {
-			value = MEMORY_SafeGetByte(pc) + (MEMORY_SafeGetByte(pc + 1) << 8);
-			nchars = fprintf(fp, "%04X: %02X %02X %02X  " /*"%Xcyc  "*/ "%.*s$%04X%s",
-			                 addr, insn, value & 0xff, value >> 8, /*cycles[insn],*/ (int) (p - mnemonic), mnemonic, value, p + 1);
+			insn->bytes[1] = MEMORY_SafeGetByte(pc);
+			insn->bytes[2] = MEMORY_SafeGetByte(pc + 1);
+			insn->size = 3;
+			insn->target = insn->bytes[1] + (insn->bytes[2] << 8);
 			pc += 2;
+			snprintf(insn->operand, sizeof(insn->operand), "%.*s$%04X%s",
+			         (int) (p - mnemonic - len - 1), mnemonic + len + 1, insn->target, p + 1);
 			break;
 		}
 		if (*p == '0') {
-			UBYTE op = MEMORY_SafeGetByte(pc);
+			insn->bytes[1] = MEMORY_SafeGetByte(pc);
+			insn->size = 2;
 			pc++;
-			value = (UWORD) (pc + (SBYTE) op);
-			nchars = fprintf(fp, "%04X: %02X %02X     " /*"3cyc  "*/ "%.4s$%04X", addr, insn, op, mnemonic, value);
+			insn->target = (UWORD) (pc + (SBYTE) insn->bytes[1]);
+			snprintf(insn->operand, sizeof(insn->operand), "$%04X", insn->target);
 			break;
 		}
 	}
 	if (*p == '\0') {
-		fprintf(fp, "%04X: %02X        " /*"%Xcyc  "*/ "%s\n", addr, insn, /*cycles[insn],*/ mnemonic);
+		/* No operand bytes, as "NOP !" */
+		strcpy(insn->operand, mnemonic + len + 1);
 		return pc;
 	}
+	if (p[-1] == '#')
+		insn->target = -1;
 #ifdef MONITOR_HINTS
-	if (p[-1] != '#') {
+	else
 		/* different names when reading/writing memory */
-		const char *label = find_label_name((UWORD) value, (MONITOR_optype6502[insn] & 0x08) != 0);
-		if (label != NULL) {
-			fprintf(fp, "%*s;%s\n", 28 - nchars, "", label);
-			return pc;
-		}
-	}
-#else
-	(void)nchars;
+		insn->label = find_label_name((UWORD) insn->target, (MONITOR_optype6502[insn->bytes[0]] & 0x08) != 0);
 #endif
-	fputc('\n', fp);
+	return pc;
+}
+
+static UWORD show_instruction(FILE *fp, UWORD pc)
+{
+	MONITOR_instruction insn;
+	char bytes[10];
+	int nchars;
+	int i;
+
+	pc = MONITOR_DecodeInstruction(pc, &insn);
+	for (i = 0; i < insn.size; i++)
+		sprintf(bytes + 3 * i, i < insn.size - 1 ? "%02X " : "%02X", insn.bytes[i]);
+	nchars = fprintf(fp, "%04X: %-10s" /*"%Xcyc  "*/ "%s%s%s", insn.addr, bytes,
+	                 insn.mnemonic, insn.operand[0] != '\0' ? " " : "", insn.operand);
+	if (insn.label != NULL)
+		fprintf(fp, "%*s;%s\n", 28 - nchars, "", insn.label);
+	else
+		fputc('\n', fp);
 	return pc;
 }
 
 void MONITOR_Exit(void)
 {
-	if (trainer_memory != NULL) {
-		free(trainer_memory);
-		trainer_memory=NULL;
-		trainer_flags=NULL;
-	}
+	AI_SEARCH_Free(&trainer);
 }
 
 void MONITOR_ShowState(FILE *fp, UWORD pc, UBYTE a, UBYTE x, UBYTE y, UBYTE s,
@@ -1136,11 +1382,352 @@ UBYTE MONITOR_break_brk = FALSE;
 int MONITOR_ret_nesting = 0;
 #endif
 
+/* Breakpoint conditions, for the B command and the AI interface */
+
+static int breakpoint_scan_flag(char c)
+{
+	switch (c) {
+	case 'N':
+		return CPU_N_FLAG;
+	case 'V':
+		return CPU_V_FLAG;
+	case 'D':
+		return CPU_D_FLAG;
+	case 'I':
+		return CPU_I_FLAG;
+	case 'Z':
+		return CPU_Z_FLAG;
+	case 'C':
+		return CPU_C_FLAG;
+	default:
+		return -1;
+	}
+}
+
+const char *MONITOR_ParseBreakpointCond(const char *t, MONITOR_breakpoint_cond *cond)
+{
+	UWORD condition;
+	int value, m_addr = -1;
+
+	if (strcmp(t, "OR") == 0) {
+		condition = MONITOR_BREAKPOINT_OR;
+		value = 0;
+	}
+	else if (strncmp(t, "CLR", 3) == 0) {
+		condition = MONITOR_BREAKPOINT_FLAG_CLEAR;
+		value = breakpoint_scan_flag(t[3]);
+	}
+	else if (strncmp(t, "SET", 3) == 0) {
+		condition = MONITOR_BREAKPOINT_FLAG_SET;
+		value = breakpoint_scan_flag(t[3]);
+	}
+	else {
+		condition = 0;
+		switch (t[0]) {
+		case 'A':
+			if (strncmp(t, "ACCESS", 6) == 0) {
+				condition = MONITOR_BREAKPOINT_ACCESS;
+				t += 6;
+			}
+			else {
+				condition = MONITOR_BREAKPOINT_A;
+				t++;
+			}
+			break;
+		case 'X':
+			condition = MONITOR_BREAKPOINT_X;
+			t++;
+			break;
+		case 'Y':
+			condition = MONITOR_BREAKPOINT_Y;
+			t++;
+			break;
+		case 'P':
+			if (t[1] == 'C') {
+				condition = MONITOR_BREAKPOINT_PC;
+				t += 2;
+			}
+			break;
+		case 'R':
+			if (strncmp(t, "READ", 4) == 0) {
+				condition = MONITOR_BREAKPOINT_READ;
+				t += 4;
+			}
+			break;
+		case 'S':
+			condition = MONITOR_BREAKPOINT_S;
+			t++;
+			break;
+		case 'W':
+			if (strncmp(t, "WRITE", 5) == 0) {
+				condition = MONITOR_BREAKPOINT_WRITE;
+				t += 5;
+			}
+			break;
+		case 'M':
+			if (strncmp(t, "MEM:", 4) == 0) {
+				UWORD tmp, i;
+				const char *p;
+				char b[100];
+				condition = MONITOR_BREAKPOINT_MEMORY;
+				t += 4;
+				p = t;
+				for(i = 0; i < 100; i++) {
+					if(
+							t[i] == ' ' || t[i] == '!' ||
+							t[i] == '<' || t[i] == '>' ||
+							t[i] == '=' || t[i] == '\0')
+					{
+						b[i] = '\0';
+						break;
+					}
+					b[i] = t[i];
+					p++;
+				}
+				if (parse_hex(b, &tmp))
+					m_addr = tmp;
+				t = p;
+			}
+			break;
+		default:
+			break;
+		}
+		if(condition == MONITOR_BREAKPOINT_MEMORY && (m_addr < 0 || m_addr > 0xffff))
+			return "Bad address for MEM:";
+		if (t[0] == '!' && t[1] == '=') {
+			condition += MONITOR_BREAKPOINT_LESS | MONITOR_BREAKPOINT_GREATER;
+			t += 2;
+		}
+		else {
+			if (*t == '<') {
+				condition += MONITOR_BREAKPOINT_LESS;
+				t++;
+			}
+			if (*t == '>') {
+				condition += MONITOR_BREAKPOINT_GREATER;
+				t++;
+			}
+			if (*t == '=') {
+				condition += MONITOR_BREAKPOINT_EQUAL;
+				t++;
+				if (*t == '=')
+					t++;
+			}
+		}
+		if ((condition >> 3) == 0 || (condition & 7) == 0)
+			return "Bad argument";
+		{
+			UWORD tmp;
+			if (parse_hex(t, &tmp))
+				value = tmp;
+			else
+				value = -1;
+		}
+	}
+	if (value < 0 || value > 0xffff)
+		return "Bad argument";
+	cond->enabled = TRUE;
+	cond->condition = condition;
+	cond->value = (UWORD) value;
+	cond->m_addr = (UWORD) m_addr;
+	return NULL;
+}
+
+/* The address the instruction at pc reads or writes, computed as the CPU
+   does (0 for the addressing modes without one) */
+static UWORD breakpoint_address(UWORD pc, UBYTE optype)
+{
+	UWORD zp;
+	switch (optype >> 4) {
+	case 1:
+		return MEMORY_dGetWord((UWORD) (pc + 1));
+	case 2:
+		return MEMORY_dGetByte((UWORD) (pc + 1));
+	case 3:
+		return (UWORD) (MEMORY_dGetWord((UWORD) (pc + 1)) + CPU_regX);
+	case 4:
+		return (UWORD) (MEMORY_dGetWord((UWORD) (pc + 1)) + CPU_regY);
+	case 5:
+		zp = (UBYTE) (MEMORY_dGetByte((UWORD) (pc + 1)) + CPU_regX);
+		break;
+	case 6:
+		zp = MEMORY_dGetByte((UWORD) (pc + 1));
+		break;
+	case 7:
+		return (UBYTE) (MEMORY_dGetByte((UWORD) (pc + 1)) + CPU_regX);
+	case 8:
+		return (UBYTE) (MEMORY_dGetByte((UWORD) (pc + 1)) + CPU_regY);
+	/* XXX: case 13 */
+	default:
+		return 0;
+	}
+#ifdef WRAP_ZPAGE
+	zp = MEMORY_dGetByte(zp) + (MEMORY_dGetByte((UBYTE) (zp + 1)) << 8);
+#else
+	zp = MEMORY_dGetWord(zp);
+#endif
+	return (optype >> 4) == 6 ? (UWORD) (zp + CPU_regY) : zp;
+}
+
+static int breakpoint_compare(int condition, int val, int value)
+{
+	return ((condition & MONITOR_BREAKPOINT_LESS) && val < value)
+		|| ((condition & MONITOR_BREAKPOINT_EQUAL) && val == value)
+		|| ((condition & MONITOR_BREAKPOINT_GREATER) && val > value);
+}
+
+static int breakpoint_cond_holds(const MONITOR_breakpoint_cond *c, UWORD pc, UBYTE optype, UWORD addr)
+{
+	int val;
+	switch (c->condition) {
+	case MONITOR_BREAKPOINT_FLAG_CLEAR:
+		return (CPU_regP & c->value) == 0;
+	case MONITOR_BREAKPOINT_FLAG_SET:
+		return (CPU_regP & c->value) != 0;
+	default:
+		break;
+	}
+	switch (c->condition >> 3) {
+	case MONITOR_BREAKPOINT_PC >> 3:
+		val = pc;
+		break;
+	case MONITOR_BREAKPOINT_A >> 3:
+		val = CPU_regA;
+		break;
+	case MONITOR_BREAKPOINT_X >> 3:
+		val = CPU_regX;
+		break;
+	case MONITOR_BREAKPOINT_Y >> 3:
+		val = CPU_regY;
+		break;
+	case MONITOR_BREAKPOINT_S >> 3:
+		val = CPU_regS;
+		break;
+	case MONITOR_BREAKPOINT_READ >> 3:
+		if ((optype & 4) == 0)
+			return FALSE;
+		val = addr;
+		break;
+	case MONITOR_BREAKPOINT_WRITE >> 3:
+		if ((optype & 8) == 0)
+			return FALSE;
+		val = addr;
+		break;
+	case MONITOR_BREAKPOINT_ACCESS >> 3:
+		if ((optype & 12) == 0)
+			return FALSE;
+		val = addr;
+		break;
+	case MONITOR_BREAKPOINT_MEMORY >> 3:
+		val = MEMORY_SafeGetByte(c->m_addr);
+		break;
+	default:
+		/* shouldn't happen */
+		return TRUE;
+	}
+	return breakpoint_compare(c->condition, val, c->value);
+}
+
+int MONITOR_BreakpointFires(const MONITOR_breakpoint_cond *table, int size)
+{
+	UWORD pc = CPU_regPC;
+	UBYTE optype = MONITOR_optype6502[MEMORY_dGetByte(pc)];
+	UWORD addr = breakpoint_address(pc, optype);
+	int i;
+
+	CPU_GetStatus();
+	for (i = 0; i < size; i++) {
+		if (!table[i].enabled)
+			continue; /* skip */
+		if (table[i].condition == MONITOR_BREAKPOINT_OR)
+			return TRUE; /* the group before held */
+		if (!breakpoint_cond_holds(&table[i], pc, optype, addr)) {
+			/* quickly skip AND-connected conditions */
+			do {
+				if (++i >= size)
+					return FALSE;
+			} while (table[i].condition != MONITOR_BREAKPOINT_OR || !table[i].enabled);
+		}
+	}
+	return TRUE;
+}
+
 #ifdef MONITOR_BREAKPOINTS
 
 MONITOR_breakpoint_cond MONITOR_breakpoint_table[MONITOR_BREAKPOINT_TABLE_MAX];
 int MONITOR_breakpoint_table_size = 0;
 int MONITOR_breakpoints_enabled = TRUE;
+UBYTE MONITOR_breakpoint_map[0x10000];
+int MONITOR_breakpoint_filter = 0;
+
+/* Marks bits in the map at the values of 0-0xffff for which all the
+   conditions of kind in table[start..end) hold */
+static void breakpoint_mark(int start, int end, int kind, UBYTE bits)
+{
+	int v, i;
+	for (v = 0; v < 0x10000; v++) {
+		for (i = start; i < end; i++) {
+			const MONITOR_breakpoint_cond *c = &MONITOR_breakpoint_table[i];
+			if (c->enabled && (c->condition >> 3 & kind) != 0 && (c->condition >> 3 & ~kind) == 0
+				&& !breakpoint_compare(c->condition, v, c->value))
+				break;
+		}
+		if (i == end)
+			MONITOR_breakpoint_map[v] |= bits;
+	}
+}
+
+void MONITOR_CompileBreakpoints(void)
+{
+	int start = 0;
+
+	memset(MONITOR_breakpoint_map, 0, sizeof(MONITOR_breakpoint_map));
+	MONITOR_breakpoint_filter = 0;
+	if (MONITOR_breakpoint_table_size == 0 || !MONITOR_breakpoints_enabled)
+		return;
+	/* Each group runs up to the next enabled OR */
+	while (start <= MONITOR_breakpoint_table_size) {
+		int end, pc = FALSE;
+		UBYTE mem = 0;
+		for (end = start; end < MONITOR_breakpoint_table_size; end++) {
+			const MONITOR_breakpoint_cond *c = &MONITOR_breakpoint_table[end];
+			if (!c->enabled)
+				continue;
+			if (c->condition == MONITOR_BREAKPOINT_OR)
+				break;
+			switch (c->condition >> 3) {
+			case MONITOR_BREAKPOINT_PC >> 3:
+				pc = TRUE;
+				break;
+			case MONITOR_BREAKPOINT_READ >> 3:
+				mem |= MONITOR_BREAKPOINT_MAP_READ;
+				break;
+			case MONITOR_BREAKPOINT_WRITE >> 3:
+				mem |= MONITOR_BREAKPOINT_MAP_WRITE;
+				break;
+			case MONITOR_BREAKPOINT_ACCESS >> 3:
+				mem |= MONITOR_BREAKPOINT_MAP_READ | MONITOR_BREAKPOINT_MAP_WRITE;
+				break;
+			default:
+				break;
+			}
+		}
+		/* The group can only fire at the PCs its PC conditions allow, or
+		   else on accesses to the addresses its READ, WRITE and ACCESS
+		   conditions allow; without either it is checked everywhere */
+		if (pc) {
+			breakpoint_mark(start, end, MONITOR_BREAKPOINT_PC >> 3, MONITOR_BREAKPOINT_MAP_PC);
+			MONITOR_breakpoint_filter |= MONITOR_BREAKPOINT_MAP_PC;
+		}
+		else if (mem) {
+			breakpoint_mark(start, end, MONITOR_BREAKPOINT_ACCESS >> 3, mem);
+			MONITOR_breakpoint_filter |= mem;
+		}
+		else
+			MONITOR_breakpoint_filter |= MONITOR_BREAKPOINT_MAP_ALL;
+		start = end + 1;
+	}
+}
 
 static void breakpoint_print_flag(int flagmask)
 {
@@ -1166,26 +1753,6 @@ static void breakpoint_print_flag(int flagmask)
 	}
 }
 
-static int breakpoint_scan_flag(char c)
-{
-	switch (c) {
-	case 'N':
-		return CPU_N_FLAG;
-	case 'V':
-		return CPU_V_FLAG;
-	case 'D':
-		return CPU_D_FLAG;
-	case 'I':
-		return CPU_I_FLAG;
-	case 'Z':
-		return CPU_Z_FLAG;
-	case 'C':
-		return CPU_C_FLAG;
-	default:
-		return -1;
-	}
-}
-
 static void breakpoints_set(int enabled)
 {
 	int i;
@@ -1358,138 +1925,16 @@ static void monitor_breakpoints(void)
 		else
 			i = MONITOR_breakpoint_table_size;
 		while (MONITOR_breakpoint_table_size < MONITOR_BREAKPOINT_TABLE_MAX) {
-			UWORD condition;
-			int value, m_addr = -1;
+			MONITOR_breakpoint_cond cond;
+			const char *error = MONITOR_ParseBreakpointCond(t, &cond);
 			int j;
-			if (strcmp(t, "OR") == 0) {
-				condition = MONITOR_BREAKPOINT_OR;
-				value = 0;
-			}
-			else if (strncmp(t, "CLR", 3) == 0) {
-				condition = MONITOR_BREAKPOINT_FLAG_CLEAR;
-				value = breakpoint_scan_flag(t[3]);
-			}
-			else if (strncmp(t, "SET", 3) == 0) {
-				condition = MONITOR_BREAKPOINT_FLAG_SET;
-				value = breakpoint_scan_flag(t[3]);
-			}
-			else {
-				condition = 0;
-				switch (t[0]) {
-				case 'A':
-					if (strncmp(t, "ACCESS", 6) == 0) {
-						condition = MONITOR_BREAKPOINT_ACCESS;
-						t += 6;
-					}
-					else {
-						condition = MONITOR_BREAKPOINT_A;
-						t++;
-					}
-					break;
-				case 'X':
-					condition = MONITOR_BREAKPOINT_X;
-					t++;
-					break;
-				case 'Y':
-					condition = MONITOR_BREAKPOINT_Y;
-					t++;
-					break;
-				case 'P':
-					if (t[1] == 'C') {
-						condition = MONITOR_BREAKPOINT_PC;
-						t += 2;
-					}
-					break;
-				case 'R':
-					if (strncmp(t, "READ", 4) == 0) {
-						condition = MONITOR_BREAKPOINT_READ;
-						t += 4;
-					}
-					break;
-				case 'S':
-					condition = MONITOR_BREAKPOINT_S;
-					t++;
-					break;
-				case 'W':
-					if (strncmp(t, "WRITE", 5) == 0) {
-						condition = MONITOR_BREAKPOINT_WRITE;
-						t += 5;
-					}
-					break;
-				case 'M':
-					if (strncmp(t, "MEM:", 4) == 0) {
-						UWORD tmp, i;
-						char *p;
-						char b[100];
-						condition = MONITOR_BREAKPOINT_MEMORY;
-						t += 4;
-						p = t;
-						for(i = 0; i < 100; i++) {
-							if(
-									t[i] == ' ' || t[i] == '!' ||
-									t[i] == '<' || t[i] == '>' ||
-									t[i] == '=' || t[i] == '\0')
-							{
-								b[i] = '\0';
-								break;
-							}
-							b[i] = t[i];
-							p++;
-						}
-						if (parse_hex(b, &tmp))
-							m_addr = tmp;
-						t = p;
-					}
-					break;
-				default:
-					break;
-				}
-				if(condition == MONITOR_BREAKPOINT_MEMORY && (m_addr < 0 || m_addr > 0xffff)) {
-					printf("Bad address for MEM:\n");
-					return;
-				}
-				if (t[0] == '!' && t[1] == '=') {
-					condition += MONITOR_BREAKPOINT_LESS | MONITOR_BREAKPOINT_GREATER;
-					t += 2;
-				}
-				else {
-					if (*t == '<') {
-						condition += MONITOR_BREAKPOINT_LESS;
-						t++;
-					}
-					if (*t == '>') {
-						condition += MONITOR_BREAKPOINT_GREATER;
-						t++;
-					}
-					if (*t == '=') {
-						condition += MONITOR_BREAKPOINT_EQUAL;
-						t++;
-						if (*t == '=')
-							t++;
-					}
-				}
-				if ((condition >> 3) == 0 || (condition & 7) == 0) {
-					printf("Bad argument\n");
-					return;
-				}
-				{
-					UWORD tmp;
-					if (parse_hex(t, &tmp))
-						value = tmp;
-					else
-						value = -1;
-				}
-			}
-			if (value < 0 || value > 0xffff) {
-				printf("Bad argument\n");
+			if (error != NULL) {
+				printf("%s\n", error);
 				return;
 			}
 			for (j = MONITOR_breakpoint_table_size; j > i; j--)
 				MONITOR_breakpoint_table[j] = MONITOR_breakpoint_table[j - 1];
-			MONITOR_breakpoint_table[i].enabled = TRUE;
-			MONITOR_breakpoint_table[i].condition = condition;
-			MONITOR_breakpoint_table[i].value = (UWORD) value;
-			MONITOR_breakpoint_table[i].m_addr = (UWORD) m_addr;
+			MONITOR_breakpoint_table[i] = cond;
 			i++;
 			MONITOR_breakpoint_table_size++;
 			t = get_token();
@@ -1798,11 +2243,28 @@ static void set_trace_file(char const *filename)
 			perror(filename);
 	}
 }
+
+/* Starts/stops the binary 6502 trace. */
+static void set_binary_trace_file(char const *filename)
+{
+	AI_TRACE_Stats stats;
+	if (AI_TRACE_Stop(&stats))
+		printf("Binary trace closed, %.0f instructions%s\n", stats.records,
+			stats.error ? ", write error" : "");
+	if (filename != NULL) {
+		if (AI_TRACE_Start(filename))
+			printf("Binary trace open\n");
+		else
+			perror(filename);
+	}
+}
 #endif /* MONITOR_TRACE */
 
 static void get_terminal_size(int *cols, int *rows) {
 	*cols = 80;
 	*rows = 24;
+	if (batch_output != NULL)
+		return;
 
 #ifdef TIOCGSIZE
 	{
@@ -1928,19 +2390,13 @@ static void get_nearby_label(UWORD addr, char *result) {
 		specify an unlabelled address as "subroutine+offset" or
 		"loop+offset" than a negative offset from the next subroutine
 		or loop. */
-	for(i = 0; i > -129; i--) {
-		label = find_label_name(addr + i, 0);
-		if(label != NULL) break;
-	}
+	label = find_nearby_label(addr, TRUE, 128, &i);
+	i = -i;
 
 	/* if nothing's in range, go ahead & look for a negative offset from
 		a label at a later address. */
-	if(label == NULL) {
-		for(i = 1; i < 128; i++) {
-			label = find_label_name(addr + i, 0);
-			if(label != NULL) break;
-		}
-	}
+	if(label == NULL)
+		label = find_nearby_label(addr, FALSE, 127, &i);
 
 	if(i == 0)
 		snprintf(result, 127, "%s/%04X", label, addr); /* exact match */
@@ -2483,32 +2939,9 @@ static void trainer_start_search(void)
 	UWORD trainer_value = 0;
 	int value_valid = get_hex(&trainer_value);
 
-	/* alloc needed memory at first use */
-	if (trainer_memory == NULL) {
-		trainer_memory = (UBYTE *)malloc(65536*2);
-		if (trainer_memory != NULL) {
-			trainer_flags = trainer_memory + 65536;
-		} else {
-			printf("Memory allocation failed!\n"
-			"Trainer not available.\n");
-		}
-	}
-	if (trainer_memory != NULL) {
-		/* copy memory into shadow buffer at first use */
-		long int count = 65535;
-		do {
-			*(trainer_memory+count) = MEMORY_SafeGetByte((UWORD) count);
-			*(trainer_flags+count) = 0xff;
-		} while (--count > -1);
-		if (value_valid) {
-			count = 65535;
-			do {
-				if (trainer_value != *(trainer_memory+count)) {
-					*(trainer_flags+count) = 0;
-				}
-			} while (--count > -1);
-		}
-	}
+	AI_SEARCH_Start(&trainer, AI_SEARCH_CPU);
+	if (value_valid)
+		AI_SEARCH_Narrow(&trainer, AI_SEARCH_EQUAL, trainer_value);
 }
 
 /* Locates memory addresses that haven't changed since TSS. */
@@ -2517,20 +2950,11 @@ static void trainer_search_unchanged(void)
 	UWORD trainer_value = 0;
 	int value_valid = get_hex(&trainer_value);
 
-	if (trainer_memory != NULL) {
-		long int count = 65535;
-		do {
-			if (value_valid) {
-				if (trainer_value != MEMORY_SafeGetByte((UWORD) count)) {
-					*(trainer_flags+count) = 0;
-				}
-			} else {
-				if (*(trainer_memory+count) != MEMORY_SafeGetByte((UWORD) count)) {
-					*(trainer_flags+count) = 0;
-				}
-			}
-			*(trainer_memory+count) = MEMORY_SafeGetByte((UWORD) count);
-		} while (--count > -1);
+	if (trainer.space >= 0) {
+		if (value_valid)
+			AI_SEARCH_Narrow(&trainer, AI_SEARCH_EQUAL, trainer_value);
+		else
+			AI_SEARCH_Narrow(&trainer, AI_SEARCH_UNCHANGED, 0);
 	} else {
 		printf("Use tss first.\n");
 	}
@@ -2542,20 +2966,11 @@ static void trainer_search_changed(void)
 	UWORD trainer_value = 0;
 	int value_valid = get_hex(&trainer_value);
 
-	if (trainer_memory != NULL) {
-		long int count = 65535;
-		do {
-			if (value_valid) {
-				if (trainer_value != MEMORY_SafeGetByte((UWORD) count)) {
-					*(trainer_flags+count) = 0;
-				}
-			} else {
-				if (*(trainer_memory+count) == MEMORY_SafeGetByte((UWORD) count)) {
-					*(trainer_flags+count) = 0;
-				}
-			};
-			*(trainer_memory+count) = MEMORY_SafeGetByte((UWORD) count);
-		} while (--count > -1);
+	if (trainer.space >= 0) {
+		if (value_valid)
+			AI_SEARCH_Narrow(&trainer, AI_SEARCH_EQUAL, trainer_value);
+		else
+			AI_SEARCH_Narrow(&trainer, AI_SEARCH_CHANGED, 0);
 	} else {
 		printf("Use tss first.\n");
 	}
@@ -2572,26 +2987,43 @@ static void trainer_print_addresses(void)
 		addr_count_max = 64;
 	}
 
-	if (trainer_memory != NULL) {
-		long int count = 0;
+	if (trainer.space >= 0) {
+		ULONG addrs[8];
 		ULONG addr_count = 0;
-		int i = 0;
-		do {
-			if (*(trainer_flags+count) != 0) {
-				printf("%04X ", (UWORD) count);
-				addr_count++;
-				if (++i == 8) {
-					printf("\n");
-					i = 0;
-				};
-			};
-		} while ((++count < 65536) && (addr_count < addr_count_max));
+		while (addr_count < addr_count_max) {
+			ULONG n = AI_SEARCH_List(&trainer, addr_count, addrs,
+				addr_count_max - addr_count < 8 ? addr_count_max - addr_count : 8);
+			ULONG i;
+			for (i = 0; i < n; i++)
+				printf("%04X ", (UWORD) addrs[i]);
+			addr_count += n;
+			if (n < 8)
+				break;
+			printf("\n");
+		}
 	printf("\n");
 	} else {
 		printf("Use tss first.\n");
 	}
 }
 
+/* Prints the addresses from addr1 to addr2 at which the n (at most 256)
+   bytes of tab are, wrapping at 0xffff */
+static void search_bytes(UWORD addr1, UWORD addr2, const UBYTE *tab, int n)
+{
+	static UBYTE view[0x10000 + 256];
+	const UBYTE *p = view + addr1;
+
+	AI_SEARCH_ReadCPU(view);
+	memcpy(view + 0x10000, view, 256);
+	while (p <= view + addr2
+	       && (p = (const UBYTE *) memchr(p, tab[0], view + addr2 + 1 - p)) != NULL) {
+		if (memcmp(p, tab, n) == 0)
+			printf("Found at %04X\n", (int) (p - view));
+		p++;
+	}
+}
+
 /* Searches in memory for a value. Memory range and value are fetched from
    command line. */
 static void monitor_search_mem(void)
@@ -2613,19 +3045,8 @@ static void monitor_search_mem(void)
 		printf("Bad arguments\n");
 		return;
 	}
-	if (n > 0) {
-		int a;
-		for (a = addr1; a <= addr2; a++) {
-			int i = 0;
-			while (MEMORY_SafeGetByte((UWORD) (a + i)) == tab[i]) {
-				i++;
-				if (i >= n) {
-					printf("Found at %04X\n", a);
-					break;
-				}
-			}
-		}
-	}
+	if (n > 0)
+		search_bytes(addr1, addr2, tab, n);
 }
 
 /* Shows disassembly of a loop that spans over address ADDR. */
@@ -2706,6 +3127,7 @@ static void configure_labels(UWORD *addr)
 					if (p->addr != *addr) {
 						printf("%s redefined (previous value: %04X)\n", name, p->addr);
 						p->addr = *addr;
+						user_index.valid = FALSE;
 					}
 				}
 				else
@@ -3069,7 +3491,7 @@ static void string_search(int screencodes)
 	static char strbuf[256] = { 0 }; /* default = nothing (always prompt) */
 	static UWORD start = 0, end = 0xffff; /* default = search all 64K */
 	char bytes[256];
-	int i, j, len;
+	int len;
 
 	get_hex(&start);
 	get_hex(&end);
@@ -3091,16 +3513,7 @@ static void string_search(int screencodes)
 	}
 
 	printf("search %04x - %04x for '%s'\n", start, end, strbuf);
-	for(i = start; i <= end; i++) {
-		j = 0;
-		while(MEMORY_SafeGetByte(i + j) == bytes[j]) {
-			j++;
-			if(j >= len) {
-				printf("Found at %04X\n", i);
-				break;
-			}
-		}
-	}
+	search_bytes(start, end, (const UBYTE *) bytes, len);
 }
 
 
@@ -3147,7 +3560,8 @@ static void show_help(void)
 	if(pager()) return;
 #ifdef MONITOR_TRACE
 	printf(
-		"TRACE [filename]               - Output 6502 trace on/off\n");
+		"TRACE [filename]               - Output 6502 trace on/off\n"
+		"BTRACE [filename]              - Binary 6502 trace on/off (see ai_trace.h)\n");
 #endif
 #ifdef MONITOR_BREAK
 	printf(
@@ -3529,7 +3943,7 @@ static char *command_generator(const char *text, int state)
 	static const char *commands[] = {
 		"CONT", "SHOW", "STACK", "LOOP", "HARDWARE", "READ", "WRITE",
 #ifdef MONITOR_TRACE
-		"TRACE",
+		"TRACE", "BTRACE",
 #endif
 #if defined(MONITOR_BREAK) || !defined(NO_YPOS_BREAK_FLICKER)
 		"BLINE",
@@ -3770,13 +4184,27 @@ void MONITOR_BPC(char *arg)
 	UWORD addr = 0xd000;
 	parse_hex(arg, &addr); /* XXX error message on bad arg? */
 	MONITOR_break_addr = addr;
+	CPU_UpdateGo();
 }
 #endif
 
-int MONITOR_Run(void)
+/* The commands MONITOR_Batch() has run, and whether it got to the end of
+   the script */
+static MONITOR_batch_command *batch_list;
+static int batch_max;
+static int batch_commands;
+static int batch_finished;
+
+static int run_monitor(void)
 {
 	UWORD addr;
 
+	if (batch_output != NULL) {
+		addr = CPU_regPC;
+		CPU_GetStatus();
+		goto prompt;
+	}
+
 #ifdef __PLUS
 	if (!Misc_AllocMonitorConsole(&mon_output, &mon_input))
 		return TRUE;
@@ -3813,28 +4241,47 @@ int MONITOR_Run(void)
 
 	show_state();
 
+prompt:
 	for (;;) {
 		char s[128];
 		static char old_s[128];
 		char *t;
 
-		safe_gets(s, sizeof(s), "> ");
-		if (s[0] != '\0')
-			strcpy(old_s, s);
+		if (batch_output != NULL) {
+			if (batch_commands > 0 && batch_commands <= batch_max)
+				batch_list[batch_commands - 1].end = ftell(batch_output);
+			if (!batch_gets(s, sizeof(s))) {
+				batch_finished = TRUE;
+				return TRUE;
+			}
+			/* Empty lines do not repeat commands here */
+			if (s[0] == '\0')
+				continue;
+			if (batch_commands < batch_max)
+				batch_list[batch_commands].line = batch_line - 1;
+			batch_commands++;
+		}
 		else {
-			/* if no command is given, restart the last one, but remove all
-			 * arguments, so after a 'm 600' we will see 'm 700' ... */
-			int i;
-			strcpy(s, old_s);
-			for (i = 0; i < (int) sizeof(s); i++)
-				if (s[i] == ' ') {
-					s[i] = '\0';
-					break;
-				}
+			safe_gets(s, sizeof(s), "> ");
+			if (s[0] != '\0')
+				strcpy(old_s, s);
+			else {
+				/* if no command is given, restart the last one, but remove all
+				 * arguments, so after a 'm 600' we will see 'm 700' ... */
+				int i;
+				strcpy(s, old_s);
+				for (i = 0; i < (int) sizeof(s); i++)
+					if (s[i] == ' ') {
+						s[i] = '\0';
+						break;
+					}
+			}
 		}
 #ifdef HAVE_SYSTEM
 		if (s[0] == '!') {
-			if (system(s + 1) == -1) {
+			if (batch_output != NULL)
+				printf("Shell commands are not run in batch mode\n");
+			else if (system(s + 1) == -1) {
 				printf("Error executing '%s'\n", s+1);
 			}
 			continue;
@@ -3857,6 +4304,10 @@ int MONITOR_Run(void)
 			return TRUE;
 		}
 #ifdef MONITOR_BREAK
+		else if (batch_output != NULL
+		         && (strcmp(t, "G") == 0 || strcmp(t, "R") == 0 || strcmp(t, "O") == 0))
+			/* They would come back to the console */
+			printf("Stepping is not done in batch mode\n");
 		else if (strcmp(t, "BBRK") == 0)
 			monitor_break_BRK();
 		else if (strcmp(t, "BPC") == 0)
@@ -3919,6 +4370,10 @@ int MONITOR_Run(void)
 			const char *filename = get_token();
 			set_trace_file(filename);
 		}
+		else if (strcmp(t, "BTRACE") == 0) {
+			const char *filename = get_token();
+			set_binary_trace_file(filename);
+		}
 #endif /* MONITOR_TRACE */
 #ifdef MONITOR_PROFILE
 		else if (strcmp(t, "PROFILE") == 0)
@@ -3977,8 +4432,10 @@ int MONITOR_Run(void)
 		else if (strcmp(t, "S") == 0)
 			monitor_search_mem();
 #ifdef MONITOR_BREAKPOINTS
-		else if (strcmp(t, "B") == 0)
+		else if (strcmp(t, "B") == 0) {
 			monitor_breakpoints();
+			MONITOR_CompileBreakpoints();
+		}
 #endif
 		else if (strcmp(t, "D") == 0) {
 			get_hex(&addr);
@@ -4076,6 +4533,37 @@ int MONITOR_Run(void)
 	}
 }
 
+int MONITOR_Run(void)
+{
+	int restart = run_monitor();
+	/* Breakpoints, stepping or tracing may have been switched */
+	CPU_UpdateGo();
+	return restart;
+}
+
+int MONITOR_Batch(const char *script, FILE *out, MONITOR_batch_command *commands, int max, int *result)
+{
+	int restart;
+
+	batch_output = out;
+	batch_script = script;
+	batch_line = 0;
+	batch_list = commands;
+	batch_max = max;
+	batch_commands = 0;
+	batch_finished = FALSE;
+	restart = run_monitor();
+	if (batch_commands > 0 && batch_commands <= max)
+		batch_list[batch_commands - 1].end = ftell(out);
+	*result = batch_finished ? MONITOR_BATCH_DONE
+		: restart ? MONITOR_BATCH_RESUMED : MONITOR_BATCH_QUIT;
+	batch_output = NULL;
+	/* The registers and flags the commands may have set */
+	CPU_PutStatus();
+	CPU_UpdateGo();
+	return batch_commands;
+}
+
 /*
 vim:ts=4:sw=4:
 */
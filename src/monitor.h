@@ -8,8 +8,32 @@
 
 int MONITOR_Run(void);
 
+/* MONITOR_Batch() ran the whole script, stopped at a command that lets
+   the emulation go on (CONT, COLDSTART, WARMSTART), or at QUIT */
+#define MONITOR_BATCH_DONE     0
+#define MONITOR_BATCH_RESUMED  1
+#define MONITOR_BATCH_QUIT     2
+
+/* A command MONITOR_Batch() ran */
+typedef struct {
+	int line;   /* of the script, from 0 */
+	long end;   /* ftell() of the output after it */
+} MONITOR_batch_command;
+
+/* Runs the monitor commands in script, one a line, without the console:
+   what they print goes to out, and lines that a command asks for (the
+   instructions after A) are read from the script. The first max commands
+   run are listed in commands. Commands that page go on without waiting,
+   until out holds 256 KB; QUIT only ends the script, and shell commands
+   and stepping (G, R, O) are not run. Returns the number of commands
+   run, with one of MONITOR_BATCH_* in *result. */
+int MONITOR_Batch(const char *script, FILE *out, MONITOR_batch_command *commands, int max, int *result);
+
 #ifdef MONITOR_HINTS
 void MONITOR_PreloadLabelFile(char *filename);
+/* The name and address of the user label nearest at or below addr, or
+   NULL: the routine code at addr is in, for profiles */
+const char *MONITOR_RoutineLabel(UWORD addr, UWORD *label_addr);
 #endif
 
 #ifdef MONITOR_TRACE
@@ -28,12 +52,25 @@ extern int MONITOR_ret_nesting;
 
 extern const UBYTE MONITOR_optype6502[256];
 
+/* An instruction as the monitor disassembles it */
+typedef struct {
+	UWORD addr;
+	UBYTE bytes[3];
+	int size;             /* 1 to 3 bytes */
+	char mnemonic[8];     /* "LDA", or "ESCRTS" for an emulator escape */
+	char operand[12];     /* "($12),Y", "#$12", "$1234" for a branch target, "" */
+	int target;           /* the address the operand refers to, -1 if none */
+	const char *label;    /* the label at target, NULL if none */
+} MONITOR_instruction;
+
+/* Decodes the instruction at pc, reading memory without side effects;
+   returns the address of the next one */
+UWORD MONITOR_DecodeInstruction(UWORD pc, MONITOR_instruction *insn);
+
 void MONITOR_Exit(void);
 void MONITOR_ShowState(FILE *fp, UWORD pc, UBYTE a, UBYTE x, UBYTE y, UBYTE s,
                 char n, char v, char z, char c);
 
-#ifdef MONITOR_BREAKPOINTS
-
 /* Breakpoint conditions */
 
 #define MONITOR_BREAKPOINT_OR          1
@@ -63,10 +100,36 @@ typedef struct {
 } MONITOR_breakpoint_cond;
 
 #define MONITOR_BREAKPOINT_TABLE_MAX  20
+
+/* Parses one upper-case token of the B command, such as "PC>=2000" or
+   "SETN", into cond. Returns NULL, or the error message. */
+const char *MONITOR_ParseBreakpointCond(const char *t, MONITOR_breakpoint_cond *cond);
+
+/* Whether the conditions of table, groups of them separated by OR, hold
+   for the instruction at CPU_regPC about to execute (with the registers
+   in CPU_regA etc. and the flags as CPU_GetStatus() finds them) */
+int MONITOR_BreakpointFires(const MONITOR_breakpoint_cond *table, int size);
+
+#ifdef MONITOR_BREAKPOINTS
+
 extern MONITOR_breakpoint_cond MONITOR_breakpoint_table[MONITOR_BREAKPOINT_TABLE_MAX];
 extern int MONITOR_breakpoint_table_size;
 extern int MONITOR_breakpoints_enabled;
 
+/* MONITOR_CompileBreakpoints() marks in MONITOR_breakpoint_map the PCs at
+   which, and the addresses read or written by which, an instruction may
+   fire a breakpoint, so the CPU evaluates the table only there. Call it
+   whenever the table changes. MONITOR_breakpoint_filter is the OR of the
+   bits in the map, with MONITOR_BREAKPOINT_MAP_ALL if some group of
+   conditions must be checked at every instruction; 0 means none is. */
+#define MONITOR_BREAKPOINT_MAP_PC      1
+#define MONITOR_BREAKPOINT_MAP_READ    2
+#define MONITOR_BREAKPOINT_MAP_WRITE   4
+#define MONITOR_BREAKPOINT_MAP_ALL     8
+extern UBYTE MONITOR_breakpoint_map[0x10000];
+extern int MONITOR_breakpoint_filter;
+void MONITOR_CompileBreakpoints(void);
+
 #endif /* MONITOR_BREAKPOINTS */
 
 #ifdef MONITOR_PROFILE
@@ -75,6 +75,10 @@ static int num_cur_pokeys = 0;
 static int pokey_frq; /* Hz - for easier resampling */
 static int filter_size;
 static double filter_data[SND_FILTER_SIZE];
+/* The interpolated filter at pos is filter_base[pos] + frac * filter_slope[pos],
+   zero from filter_size - 1 on */
+static double filter_base[SND_FILTER_SIZE];
+static double filter_slope[SND_FILTER_SIZE];
 static int audible_frq;
 
 static const int pokey_frq_ideal =  1789790; /* Hz - True */
@@ -94,11 +98,9 @@ static const int filter_size_8_8 = 1214;
 /* Flags and quality */
 static int snd_quality = 0;
 
-/* Poly tables */
-static int poly4tbl[15];
-static int poly5tbl[31];
-static unsigned char poly17tbl[131071];
-static int poly9tbl[511];
+/* Poly tables, one bit per step: poly4tbl, poly5tbl, poly9tbl and
+   poly17bits, which packs 8 steps per byte */
+#include "gen-mzpokey-poly.h"
 
 
 struct stPokeyState;
@@ -421,10 +423,37 @@ static void ResetPokeyState(PokeyState* ps)
 }
 
 
+/* Sums TAB at the age of each queued change from BEG up to END (no
+   wrap), weighted by the step the change makes from *AVOL, and leaves the
+   last volume in *AVOL. Two accumulators keep the additions independent. */
+static double sum_changes(PokeyState* ps, int beg, int end, qev_t *avol, double const *tab)
+{
+    int i = beg;
+    int curtick = ps->curtick;
+    qev_t a = *avol;
+    double sum0 = 0, sum1 = 0;
+
+    for (; i + 2 <= end; i += 2)
+    {
+        qev_t b0 = ps->qev[i];
+        qev_t b1 = ps->qev[i + 1];
+        sum0 += (a - b0)*tab[curtick - ps->qet[i]];
+        sum1 += (b0 - b1)*tab[curtick - ps->qet[i + 1]];
+        a = b1;
+    }
+    if (i < end)
+    {
+        qev_t b0 = ps->qev[i];
+        sum0 += (a - b0)*tab[curtick - ps->qet[i]];
+        a = b0;
+    }
+    *avol = a;
+    return sum0 + sum1;
+}
+
 static double read_resam_all(PokeyState* ps)
 {
-    int i = ps->qebeg;
-    qev_t avol,bvol;
+    qev_t avol;
     double sum;
 
     if(ps->qebeg == ps->qeend)
@@ -433,29 +462,13 @@ static double read_resam_all(PokeyState* ps)
     }
 
     avol = ps->ovola;
-    sum = 0;
 
     /* Separate two loop cases, for wrap-around and without */
     if(ps->qeend < ps->qebeg) /* With wrap */
-    {
-        while(i<filter_size)
-        {
-            bvol = ps->qev[i];
-            sum += (avol-bvol)*filter_data[ps->curtick - ps->qet[i]];
-            avol = bvol;
-            ++i;
-        }
-        i=0;
-    }
-
-    /* without wrap */
-    while(i<ps->qeend)
-    {
-        bvol = ps->qev[i];
-        sum += (avol-bvol)*filter_data[ps->curtick - ps->qet[i]];
-        avol = bvol;
-        ++i;
-    }
+        sum = sum_changes(ps, ps->qebeg, filter_size, &avol, filter_data)
+            + sum_changes(ps, 0, ps->qeend, &avol, filter_data);
+    else
+        sum = sum_changes(ps, ps->qebeg, ps->qeend, &avol, filter_data);
 
     sum += avol*filter_data[0];
     return sum;
@@ -464,10 +477,29 @@ static double read_resam_all(PokeyState* ps)
 /* linear interpolation of filter data */
 static double interp_filter_data(int pos, double frac)
 {
-	if (pos+1 >= filter_size) {
-		return 0.0;
-	}
-	return (frac)*filter_data[pos+1]+(1-frac)*(filter_data[pos]-filter_data[filter_size-1]);
+	return filter_base[pos] + frac*filter_slope[pos];
+}
+
+/* As sum_changes() for the interpolated filter: returns the filter_base
+   sum and adds the filter_slope sum to *SLOPE. */
+static double sum_changes_interp(PokeyState* ps, int beg, int end, qev_t *avol, double *slope)
+{
+    int i;
+    int curtick = ps->curtick;
+    qev_t a = *avol;
+    double base = 0, sl = 0;
+
+    for (i = beg; i < end; ++i)
+    {
+        int pos = curtick - ps->qet[i];
+        qev_t b = ps->qev[i];
+        base += (a - b)*filter_base[pos];
+        sl += (a - b)*filter_slope[pos];
+        a = b;
+    }
+    *avol = a;
+    *slope += sl;
+    return base;
 }
 
 /* returns the filtered output sample value using an interpolated filter */
@@ -475,43 +507,24 @@ static double interp_filter_data(int pos, double frac)
  * input sample values */
 static double interp_read_resam_all(PokeyState* ps, double frac)
 {
-    int i = ps->qebeg;
-    qev_t avol,bvol;
-    double sum;
+    qev_t avol;
+    double base, slope = 0;
 
     if (ps->qebeg == ps->qeend)
     {
         return ps->ovola * interp_filter_data(0,frac); /* if no events in the queue */
     }
 
+    /* The filter is linear in frac, so the base and slope parts are summed
+       separately and frac is applied once */
     avol = ps->ovola;
-    sum = 0;
-
-    /* Separate two loop cases, for wrap-around and without */
     if (ps->qeend < ps->qebeg) /* With wrap */
-    {
-        while (i < filter_size)
-        {
-            bvol = ps->qev[i];
-            sum += (avol-bvol)*interp_filter_data(ps->curtick - ps->qet[i],frac);
-            avol = bvol;
-            ++i;
-        }
-        i = 0;
-    }
-
-    /* without wrap */
-    while (i < ps->qeend)
-    {
-        bvol = ps->qev[i];
-        sum += (avol-bvol)*interp_filter_data(ps->curtick - ps->qet[i],frac);
-        avol = bvol;
-        ++i;
-    }
-
-    sum += avol*interp_filter_data(0,frac);
+        base = sum_changes_interp(ps, ps->qebeg, filter_size, &avol, &slope)
+             + sum_changes_interp(ps, 0, ps->qeend, &avol, &slope);
+    else
+        base = sum_changes_interp(ps, ps->qebeg, ps->qeend, &avol, &slope);
 
-    return sum;
+    return base + frac*slope + avol*interp_filter_data(0,frac);
 }
 
 static void add_change(PokeyState* ps, qev_t a)
@@ -579,59 +592,6 @@ static void bump_qe_subticks(PokeyState* ps, int subticks)
 
 
 
-static void build_poly4(void)
-{
-    unsigned char c;
-    unsigned char i;
-    unsigned char poly4=1;
-
-    for(i=0; i<15; i++)
-    {
-        poly4tbl[i] = ~poly4;
-        c = ((poly4>>2)&1) ^ ((poly4>>3)&1);
-        poly4 = ((poly4<<1)&15) + c;
-    }
-}
-
-static void build_poly5(void)
-{
-	unsigned char c;
-	unsigned char i;
-	unsigned char poly5 = 1;
-
-	for(i = 0; i < 31; i++) {
-		poly5tbl[i] = ~poly5; /* Inversion! Attention! */
-		c = ((poly5 >> 2) ^ (poly5 >> 4)) & 1;
-		poly5 = ((poly5 << 1) & 31) + c;
-	}
-}
-
-static void build_poly17(void)
-{
-	unsigned int c;
-	unsigned int i;
-	unsigned int poly17 = 1;
-
-	for(i = 0; i < 131071; i++) {
-		poly17tbl[i] = (unsigned char) poly17;
-		c = ((poly17 >> 11) ^ (poly17 >> 16)) & 1;
-		poly17 = ((poly17 << 1) & 131071) + c;
-	}
-}
-
-static void build_poly9(void)
-{
-	unsigned int c;
-	unsigned int i;
-	unsigned int poly9 = 1;
-
-	for(i = 0; i < 511; i++) {
-		poly9tbl[i] = (unsigned char) poly9;
-		c = ((poly9 >> 3) ^ (poly9 >> 8)) & 1;
-		poly9 = ((poly9 << 1) & 511) + c;
-	}
-}
-
 static void advance_polies(PokeyState* ps, int tacts)
 {
     ps->poly4pos = (tacts + ps->poly4pos) % 15;
@@ -1017,12 +977,12 @@ static void advance_ticks(PokeyState* ps, int ticks)
 
         if(need)
         {
-            p5v = poly5tbl[ps->poly5pos] & 1;
-            p4v = poly4tbl[ps->poly4pos] & 1;
+            p5v = poly5tbl[ps->poly5pos];
+            p4v = poly4tbl[ps->poly4pos];
             if(ps->selpoly9)
-                p917v = poly9tbl[ps->poly9pos] & 1;
+                p917v = poly9tbl[ps->poly9pos];
             else
-                p917v = poly17tbl[ps->poly17pos] & 1;
+                p917v = (poly17bits[ps->poly17pos >> 3] >> (ps->poly17pos & 7)) & 1;
 
 #ifdef NONLINEAR_MIXING
             if(ta == tbe0)
@@ -1142,8 +1102,10 @@ static double generate_sample(PokeyState* ps)
  filter table generator by Krzysztof Nikiel
  ******************************************/
 
+/* Returns the filter size and sets *cutoff; the filter itself is only
+   designed into filter_data if design is TRUE */
 static int remez_filter_table(double resamp_rate, /* output_rate/input_rate */
-                              double *cutoff, int quality)
+                              double *cutoff, int quality, int design)
 {
   int i;
   static const int orders[] = {600, 800, 1000, 1200};
@@ -1200,6 +1162,8 @@ found:
 
   if (size > SND_FILTER_SIZE) /* static table too short */
     return 0;
+  if (!design)
+    return size;
 
   desired[0] = 1;
   desired[1] = 0;
@@ -1242,11 +1206,51 @@ found:
   return size;
 }
 
+static void build_interp_filter(void)
+{
+    int i;
+    double last = filter_data[filter_size - 1];
+    for (i = 0; i < SND_FILTER_SIZE; i++)
+    {
+        if (i + 1 < filter_size)
+        {
+            filter_base[i] = filter_data[i] - last;
+            filter_slope[i] = filter_data[i + 1] - filter_base[i];
+        }
+        else
+            filter_base[i] = filter_slope[i] = 0.0;
+    }
+}
+
+/* Designing the filter takes a few milliseconds, most of the emulator's
+   startup, so MZPOKEYSND_Init() only asks for it and the first sample
+   generated designs it. A filter designed before is kept as long as
+   the resampling rate and quality stay the same. */
+static int filter_pending = FALSE;
+static double filter_rate = 0.0;	/* of the filter in filter_data, */
+static int filter_quality = -1;		/* or -1 if none was designed */
+static double wanted_rate;
+static int wanted_quality;
+
+static void design_filter(void)
+{
+    double cutoff;
+
+    filter_pending = FALSE;
+    if (filter_size == 0
+        || (wanted_rate == filter_rate && wanted_quality == filter_quality))
+        return;
+    remez_filter_table(wanted_rate, &cutoff, wanted_quality, TRUE);
+    build_interp_filter();
+    filter_rate = wanted_rate;
+    filter_quality = wanted_quality;
+}
+
 static void mzpokeysnd_process_8(void* sndbuffer, int sndn);
 static void mzpokeysnd_process_16(void* sndbuffer, int sndn);
 static void Update_pokey_sound_mz(UWORD addr, UBYTE val, UBYTE chip, UBYTE gain);
 #ifdef CONSOLE_SOUND
-static void Update_consol_sound_mz( int set );
+static void Update_consol_sound_mz( int set, int speaker );
 #endif
 
 /*****************************************************************************/
@@ -1370,15 +1374,12 @@ int MZPOKEYSND_Init(ULONG freq17, int playback_freq, UBYTE num_pokeys,
     default:
         pokey_frq = (int)(((double)pokey_frq_ideal/POKEYSND_playback_freq) + 0.5)
           * POKEYSND_playback_freq;
-	filter_size = remez_filter_table((double)POKEYSND_playback_freq/pokey_frq,
-					 &cutoff, quality);
+	wanted_rate = (double)POKEYSND_playback_freq/pokey_frq;
+	wanted_quality = quality;
+	filter_size = remez_filter_table(wanted_rate, &cutoff, quality, FALSE);
 	audible_frq = (int ) (cutoff * pokey_frq);
     }
-
-    build_poly4();
-    build_poly5();
-    build_poly9();
-    build_poly17();
+    filter_pending = TRUE;
 
 #ifdef __PLUS
 	if (clear_regs)
@@ -2288,6 +2289,8 @@ static void mzpokeysnd_process_8(void* sndbuffer, int sndn)
 
     if(num_cur_pokeys<1)
         return; /* module was not initialized */
+    if(filter_pending)
+        design_filter();
 
     /* if there are two pokeys, then the signal is stereo
        we assume even sndn */
@@ -2313,6 +2316,8 @@ static void mzpokeysnd_process_16(void* sndbuffer, int sndn)
 
     if(num_cur_pokeys<1)
         return; /* module was not initialized */
+    if(filter_pending)
+        design_filter();
 
     /* if there are two pokeys, then the signal is stereo
        we assume even sndn */
@@ -2334,10 +2339,12 @@ static void generate_sync(unsigned int num_ticks)
 {
 	double new_samp_pos;
 	unsigned int ticks;
-	UBYTE *buffer = POKEYSND_process_buffer + POKEYSND_process_buffer_fill;
-	UBYTE *buffer_end = POKEYSND_process_buffer + POKEYSND_process_buffer_length;
+	UBYTE *buffer = POKEYSND_synth_buffer + POKEYSND_process_buffer_fill;
+	UBYTE *buffer_end = POKEYSND_synth_buffer + POKEYSND_process_buffer_length;
 	unsigned int i;
 
+	if (filter_pending)
+		design_filter();
 	for (;;) {
 		double int_part;
 		new_samp_pos = samp_pos + ticks_per_sample;
@@ -2373,7 +2380,7 @@ static void generate_sync(unsigned int num_ticks)
 		}
 	}
 
-	POKEYSND_process_buffer_fill = buffer - POKEYSND_process_buffer;
+	POKEYSND_process_buffer_fill = buffer - POKEYSND_synth_buffer;
 	if (num_ticks > 0) {
 		/* remaining ticks */
 		for (i = 0; i < num_cur_pokeys; ++i)
@@ -2382,10 +2389,10 @@ static void generate_sync(unsigned int num_ticks)
 }
 
 #ifdef CONSOLE_SOUND
-static void Update_consol_sound_mz( int set )
+static void Update_consol_sound_mz( int set, int speaker )
 {
 	if (set) { /* The set variable is 0 only in VOL_ONLY_SOUND routines */
-		pokey_states[0].speaker = GTIA_speaker*CONSOLE_VOL;
+		pokey_states[0].speaker = speaker*CONSOLE_VOL;
 		pokey_states[0].forcero = 1; /* first chip */
 	}
 }
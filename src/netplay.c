@@ -0,0 +1,691 @@
+/*
+ * netplay.c - two-player rollback netplay over UDP
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+/* Frames are counted from the start of the session. A player's input for
+   frame f is taken -netplay-delay frames earlier and sent in every packet
+   until the peer acknowledges it, so a lost packet costs nothing but a
+   little more guessing. The input of a frame is one byte: the stick nibble,
+   the trigger in bit 4 and START, SELECT and OPTION in bits 5-7, 1 meaning
+   not pressed as in the hardware.
+
+   Both emulators start from the host's state, packed and sent to the guest
+   and loaded again by the host, so that nothing the state files leave out
+   can set them apart. From then on they agree as long as the same inputs
+   reach the same frames; every CHECK_EVERY frames the memory checksum of a
+   frame both have the real input for is exchanged, and a difference is
+   reported. */
+
+#include "config.h"
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/time.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <netdb.h>
+
+#include "atari.h"
+#include "ai_heatmap.h"
+#include "ai_interface.h"
+#include "akey.h"
+#include "antic.h"
+#include "crc32.h"
+#include "gtia.h"
+#include "input.h"
+#include "log.h"
+#include "memory.h"
+#include "netplay.h"
+#include "pia.h"
+#include "pokey.h"
+#ifdef SOUND
+#include "pokeysnd.h"
+#endif
+#include "statesav.h"
+#include "util.h"
+
+#define DEFAULT_PORT 9998
+#define PROTOCOL_VERSION 1
+
+#define RING 256             /* inputs kept, a power of two */
+#define RING_MASK (RING - 1)
+#define MAX_DELAY 15
+#define MAX_ROLLBACK 60
+#define CHECK_EVERY 60       /* frames between memory checksums */
+#define NO_CHECK 0xffffffff
+#define STATE_CHUNK 1024
+#define STATE_WINDOW 32      /* chunks sent ahead of the acknowledged ones */
+#define HELLO_EVERY 0.25     /* seconds between a waiting guest's hellos */
+#define TIMEOUT 10.0         /* seconds of silence that end a session */
+
+enum {
+	PACKET_HELLO = 1,     /* version */
+	PACKET_STATE,         /* total length, offset, data */
+	PACKET_STATE_ACK,     /* bytes received in order */
+	PACKET_INPUT,         /* first frame, count, inputs, ack, check frame, checksum */
+	PACKET_BYE
+};
+
+enum { MODE_OFF, MODE_HOST, MODE_GUEST };
+
+static int mode = MODE_OFF;
+static int sock = -1;
+static int port = DEFAULT_PORT;
+static char join_host[256];
+static int delay = 2;
+static int rollback = 8;
+
+static struct sockaddr_in peer;
+static int running = FALSE;
+static double last_heard;
+static double last_hello;
+
+/* The guest's copy of the host's state as it arrives, or how much of it
+   the guest has while the host is sending it */
+static UBYTE *state = NULL;
+static ULONG state_len;
+static ULONG state_have;
+static int sending = FALSE;
+
+static int frame;             /* the next frame to run */
+static UBYTE local_in[RING];
+static UBYTE remote_in[RING];
+static UBYTE used_in[RING];   /* the remote input each frame ran with */
+static int local_next;        /* local inputs known for the frames below */
+static int remote_next;       /* remote inputs known for the frames below */
+static int acked;             /* local inputs the peer has */
+static int rollback_from;     /* the first frame run with a wrong guess, or -1 */
+
+/* Snapshots of the last rollback + 1 frames, at the start of each */
+static UBYTE *snapshots = NULL;
+static ULONG snapshot_size;
+static int slots;
+static int slot_frame[MAX_ROLLBACK + 1];
+static ULONG slot_len[MAX_ROLLBACK + 1];
+static ULONG slot_crc[MAX_ROLLBACK + 1];
+
+static int check_frame;       /* the last checked frame of ours, or -1 */
+static ULONG check_crc;
+static int peer_check_frame;
+static ULONG peer_check_crc;
+static int compared_frame;
+
+static int saved_collisions;
+static unsigned long rollbacks;
+static unsigned long rerun_frames;
+static unsigned long stalls;
+static unsigned long desyncs;
+
+static void put32(UBYTE *p, ULONG v)
+{
+	p[0] = (UBYTE) (v >> 24);
+	p[1] = (UBYTE) (v >> 16);
+	p[2] = (UBYTE) (v >> 8);
+	p[3] = (UBYTE) v;
+}
+
+static ULONG get32(const UBYTE *p)
+{
+	return ((ULONG) p[0] << 24) | ((ULONG) p[1] << 16) | ((ULONG) p[2] << 8) | p[3];
+}
+
+static void send_packet(const UBYTE *buf, int len)
+{
+	sendto(sock, (const char *) buf, len, 0, (struct sockaddr *) &peer, sizeof(peer));
+}
+
+static void send_byte(int type)
+{
+	UBYTE b = (UBYTE) type;
+	send_packet(&b, 1);
+}
+
+static void send_input(void)
+{
+	UBYTE buf[1 + 4 + 1 + 255 + 12];
+	int first = acked;
+	int count = local_next - first;
+	int i;
+
+	if (count > 255)
+		count = 255;
+	buf[0] = PACKET_INPUT;
+	put32(buf + 1, first);
+	buf[5] = (UBYTE) count;
+	for (i = 0; i < count; i++)
+		buf[6 + i] = local_in[(first + i) & RING_MASK];
+	put32(buf + 6 + count, remote_next);
+	put32(buf + 10 + count, check_frame >= 0 ? (ULONG) check_frame : NO_CHECK);
+	put32(buf + 14 + count, check_crc);
+	send_packet(buf, 18 + count);
+}
+
+static void compare_checks(void)
+{
+	if (check_frame < 0 || check_frame != peer_check_frame || check_frame == compared_frame)
+		return;
+	compared_frame = check_frame;
+	/* Once apart, they stay apart: only the first is reported */
+	if (check_crc != peer_check_crc && desyncs++ == 0) {
+		Log_print("netplay: out of sync at frame %d (memory checksums %08lx, peer %08lx)",
+		          check_frame, (unsigned long) check_crc, (unsigned long) peer_check_crc);
+	}
+}
+
+/* The inputs of both players for frame f, the remote one guessed if not
+   known yet */
+static void apply_input(int f)
+{
+	UBYTE mine = local_in[f & RING_MASK];
+	UBYTE theirs;
+	UBYTE p0, p1;
+
+	if (f < remote_next)
+		theirs = remote_in[f & RING_MASK];
+	else
+		theirs = remote_next > 0 ? remote_in[(remote_next - 1) & RING_MASK] : 0xff;
+	used_in[f & RING_MASK] = theirs;
+	if (mode == MODE_HOST) {
+		p0 = mine;
+		p1 = theirs;
+	}
+	else {
+		p0 = theirs;
+		p1 = mine;
+	}
+	PIA_PORT_input[0] = (p0 & 0x0f) | ((p1 & 0x0f) << 4);
+	GTIA_TRIG[0] = (p0 >> 4) & 1;
+	GTIA_TRIG[1] = (p1 >> 4) & 1;
+	INPUT_key_consol = (p0 >> 5) & (p1 >> 5) & INPUT_CONSOL_NONE;
+}
+
+static void end_session(const char *reason, int say_bye)
+{
+	if (say_bye)
+		send_byte(PACKET_BYE);
+	running = FALSE;
+	Atari800_collisions_in_skipped_frames = saved_collisions;
+	Log_print("netplay: session ended (%s) after %d frames, %lu rollbacks of %lu frames, %lu stalls, %lu desyncs",
+	          reason, frame, rollbacks, rerun_frames, stalls, desyncs);
+	/* A guest says hello again, to join the host's next session */
+	state_have = 0;
+	last_hello = 0;
+}
+
+static int save_snapshot(int f)
+{
+	int slot = f % slots;
+	ULONG len = StateSav_SaveSnapshot(snapshots + slot * snapshot_size, snapshot_size);
+
+	if (len == 0) {
+		end_session("the machine changed", TRUE);
+		return FALSE;
+	}
+	slot_frame[slot] = f;
+	slot_len[slot] = len;
+	if (f % CHECK_EVERY == 0)
+		slot_crc[slot] = CRC32_Update(0xffffffff, MEMORY_mem, 65536);
+	return TRUE;
+}
+
+static void start_session(void)
+{
+	int i;
+
+	snapshot_size = StateSav_SaveSnapshot(NULL, 0);
+	slots = rollback + 1;
+	snapshots = (UBYTE *) Util_realloc(snapshots, slots * snapshot_size);
+	for (i = 0; i < slots; i++)
+		slot_frame[i] = -1;
+	frame = 0;
+	remote_next = 0;
+	acked = 0;
+	for (local_next = 0; local_next < delay; local_next++)
+		local_in[local_next] = 0xff;
+	rollback_from = -1;
+	check_frame = peer_check_frame = compared_frame = -1;
+	rollbacks = rerun_frames = stalls = desyncs = 0;
+	saved_collisions = Atari800_collisions_in_skipped_frames;
+	/* Frames run again always have collisions; so must the frames skipped
+	   on either side */
+	Atari800_collisions_in_skipped_frames = TRUE;
+	running = TRUE;
+	last_heard = Util_time();
+	Log_print("netplay: session started, playing port %d", mode == MODE_HOST ? 0 : 1);
+}
+
+static void receive_input(const UBYTE *buf, int len)
+{
+	int first, count, ack, i;
+	ULONG f;
+
+	if (len < 6)
+		return;
+	first = (int) get32(buf + 1);
+	count = buf[5];
+	if (len < 18 + count)
+		return;
+	ack = (int) get32(buf + 6 + count);
+	if (ack > acked && ack <= local_next)
+		acked = ack;
+	for (i = 0; i < count; i++) {
+		int g = first + i;
+		UBYTE in = buf[6 + i];
+
+		if (g < remote_next)
+			continue;
+		if (g > remote_next || g >= frame + RING / 2)
+			break;
+		remote_in[g & RING_MASK] = in;
+		if (g < frame && used_in[g & RING_MASK] != in
+		    && (rollback_from < 0 || g < rollback_from))
+			rollback_from = g;
+		remote_next++;
+	}
+	f = get32(buf + 10 + count);
+	if (f != NO_CHECK) {
+		peer_check_frame = (int) f;
+		peer_check_crc = get32(buf + 14 + count);
+		compare_checks();
+	}
+}
+
+/* The guest's side of the state transfer */
+static void receive_state(const UBYTE *buf, int len)
+{
+	UBYTE ack[5];
+	ULONG total, offset;
+
+	if (len < 9)
+		return;
+	total = get32(buf + 1);
+	offset = get32(buf + 5);
+	if (!running && total > 0 && total <= 4 * STATESAV_MAX_SIZE) {
+		if (state_have == 0 || total != state_len) {
+			state = (UBYTE *) Util_realloc(state, total);
+			state_len = total;
+			state_have = 0;
+		}
+		if (offset == state_have && offset + (len - 9) <= total) {
+			memcpy(state + offset, buf + 9, len - 9);
+			state_have += len - 9;
+		}
+	}
+	ack[0] = PACKET_STATE_ACK;
+	put32(ack + 1, running ? total : state_have);
+	send_packet(ack, 5);
+	if (!running && state_have == state_len && state_have > 0) {
+		if (StateSav_UnpackAtariState(state, state_len))
+			start_session();
+		else
+			Log_print("netplay: the host's state could not be loaded");
+		state_have = 0;
+	}
+}
+
+static int same_peer(const struct sockaddr_in *from)
+{
+	return from->sin_addr.s_addr == peer.sin_addr.s_addr && from->sin_port == peer.sin_port;
+}
+
+static void send_state(void);
+
+static void handle_packet(const UBYTE *buf, int len, const struct sockaddr_in *from)
+{
+	if (len < 1)
+		return;
+	if (mode == MODE_HOST && !running && !sending) {
+		/* Anyone may join a host that is not playing */
+		if (buf[0] == PACKET_HELLO && len >= 2) {
+			if (buf[1] != PROTOCOL_VERSION) {
+				Log_print("netplay: %s speaks protocol %d, not %d", inet_ntoa(from->sin_addr),
+				          buf[1], PROTOCOL_VERSION);
+				return;
+			}
+			peer = *from;
+			send_state();
+		}
+		return;
+	}
+	if (!same_peer(from))
+		return;
+	last_heard = Util_time();
+	switch (buf[0]) {
+	case PACKET_STATE:
+		if (mode == MODE_GUEST)
+			receive_state(buf, len);
+		break;
+	case PACKET_STATE_ACK:
+		if (sending && len >= 5 && get32(buf + 1) > state_have)
+			state_have = get32(buf + 1);
+		break;
+	case PACKET_INPUT:
+		if (running)
+			receive_input(buf, len);
+		else if (sending)
+			state_have = state_len;  /* the guest has it all and plays already */
+		break;
+	case PACKET_BYE:
+		if (running)
+			end_session("the peer left", FALSE);
+		else if (sending)
+			sending = FALSE;
+		break;
+	default:
+		break;
+	}
+}
+
+/* Handles what has arrived, waiting up to timeout seconds for the first
+   packet */
+static void receive(double timeout)
+{
+	UBYTE buf[9 + STATE_CHUNK];
+
+	if (timeout > 0) {
+		fd_set fds;
+		struct timeval tv;
+
+		FD_ZERO(&fds);
+		FD_SET(sock, &fds);
+		tv.tv_sec = (long) timeout;
+		tv.tv_usec = (long) ((timeout - tv.tv_sec) * 1e6);
+		if (select(sock + 1, &fds, NULL, NULL, &tv) <= 0)
+			return;
+	}
+	for (;;) {
+		struct sockaddr_in from;
+		socklen_t from_len = sizeof(from);
+		int len = (int) recvfrom(sock, (char *) buf, sizeof(buf), 0, (struct sockaddr *) &from, &from_len);
+
+		if (len < 0)
+			break;
+		handle_packet(buf, len, &from);
+	}
+}
+
+/* The host's side of the state transfer, which holds the emulation until
+   the guest has it all. Both then load it. */
+static void send_state(void)
+{
+	UBYTE *data = StateSav_PackAtariState(&state_len);
+	UBYTE buf[9 + STATE_CHUNK];
+	ULONG sent = 0;
+
+	if (data == NULL) {
+		Log_print("netplay: the state could not be saved");
+		return;
+	}
+	Log_print("netplay: %s joins, sending %lu bytes of state", inet_ntoa(peer.sin_addr),
+	          (unsigned long) state_len);
+	state_have = 0;
+	sending = TRUE;
+	last_heard = Util_time();
+	while (sending && state_have < state_len && Util_time() - last_heard < TIMEOUT) {
+		ULONG before = state_have;
+
+		while (sent < state_len && sent < state_have + STATE_WINDOW * STATE_CHUNK) {
+			ULONG n = state_len - sent < STATE_CHUNK ? state_len - sent : STATE_CHUNK;
+
+			buf[0] = PACKET_STATE;
+			put32(buf + 1, state_len);
+			put32(buf + 5, sent);
+			memcpy(buf + 9, data + sent, n);
+			send_packet(buf, 9 + n);
+			sent += n;
+		}
+		receive(0.1);
+		if (state_have == before)
+			sent = state_have;  /* nothing came: send again from what the guest has */
+	}
+	if (sending && state_have >= state_len && StateSav_UnpackAtariState(data, state_len))
+		start_session();
+	else
+		Log_print("netplay: the guest did not get the state");
+	sending = FALSE;
+	state_have = 0;
+	free(data);
+}
+
+/* Runs the frames from rollback_from again with the inputs now known */
+static void roll_back(void)
+{
+	int g = rollback_from;
+	int slot;
+	UBYTE *pc_watch = AI_pc_watch;
+	UBYTE *write_watch = AI_write_watch;
+	AI_ProfileRec *profile = AI_profile;
+	UBYTE *coverage = AI_coverage;
+	ULONG *heatmap = AI_HEATMAP_counts;
+	int h;
+
+	rollback_from = -1;
+	if (g < 0 || g >= frame)
+		return;
+	slot = g % slots;
+	if (slot_frame[slot] != g || !StateSav_ReadSnapshot(snapshots + slot * snapshot_size, slot_len[slot])) {
+		end_session("lost the snapshot to roll back to", TRUE);
+		return;
+	}
+	/* The frames run again are not seen by the AI interface's watches */
+	AI_pc_watch = AI_write_watch = AI_coverage = NULL;
+	AI_profile = NULL;
+	AI_HEATMAP_counts = NULL;
+#ifdef SOUND
+	POKEYSND_SetSpeculative(TRUE);
+#endif
+	for (h = g; h < frame && running; h++) {
+		if (h > g && !save_snapshot(h))
+			break;
+		apply_input(h);
+		GTIA_Frame();
+		ANTIC_Frame(ANTIC_DRAW_COLLISIONS);
+		POKEY_Frame();
+	}
+#ifdef SOUND
+	POKEYSND_SetSpeculative(FALSE);
+#endif
+	AI_pc_watch = pc_watch;
+	AI_write_watch = write_watch;
+	AI_profile = profile;
+	AI_coverage = coverage;
+	AI_HEATMAP_counts = heatmap;
+	rollbacks++;
+	rerun_frames += frame - g;
+}
+
+void NETPLAY_Frame(void)
+{
+	int c;
+
+	if (sock < 0)
+		return;
+	if (!running && mode == MODE_GUEST && state_have == 0 && Util_time() - last_hello > HELLO_EVERY) {
+		UBYTE hello[2];
+
+		hello[0] = PACKET_HELLO;
+		hello[1] = PROTOCOL_VERSION;
+		send_packet(hello, 2);
+		last_hello = Util_time();
+	}
+	receive(0);
+	if (!running)
+		return;
+
+	/* The keyboard is not shared, so it is not let through */
+	INPUT_key_code = AKEY_NONE;
+	INPUT_key_shift = 0;
+
+	if (frame - remote_next > rollback) {
+		stalls++;
+		while (running && frame - remote_next > rollback) {
+			send_input();
+			receive(1.0 / 60);
+			if (Util_time() - last_heard > TIMEOUT)
+				end_session("the peer stopped answering", TRUE);
+		}
+	}
+	if (running && rollback_from >= 0)
+		roll_back();
+	if (!running || !save_snapshot(frame))
+		return;
+
+	/* The last frame starting with every input before it known */
+	c = remote_next < frame ? remote_next : frame;
+	c -= c % CHECK_EVERY;
+	if (c > check_frame && slot_frame[c % slots] == c) {
+		check_frame = c;
+		check_crc = slot_crc[c % slots];
+		compare_checks();
+	}
+}
+
+void NETPLAY_ApplyInput(void)
+{
+	if (!running)
+		return;
+	local_in[local_next & RING_MASK] = (PIA_PORT_input[0] & 0x0f) | ((GTIA_TRIG[0] & 1) << 4)
+	                                   | ((INPUT_key_consol & INPUT_CONSOL_NONE) << 5);
+	local_next++;
+	send_input();
+	apply_input(frame);
+	frame++;
+}
+
+static int open_socket(void)
+{
+	struct sockaddr_in addr;
+
+	sock = (int) socket(AF_INET, SOCK_DGRAM, 0);
+	if (sock < 0) {
+		Log_print("netplay: cannot create a socket: %s", strerror(errno));
+		return FALSE;
+	}
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = htonl(INADDR_ANY);
+	addr.sin_port = htons(mode == MODE_HOST ? port : 0);
+	if (bind(sock, (struct sockaddr *) &addr, sizeof(addr)) < 0) {
+		Log_print("netplay: cannot use port %d: %s", port, strerror(errno));
+		close(sock);
+		sock = -1;
+		return FALSE;
+	}
+	fcntl(sock, F_SETFL, fcntl(sock, F_GETFL, 0) | O_NONBLOCK);
+	if (mode == MODE_GUEST) {
+		struct hostent *host = gethostbyname(join_host);
+
+		if (host == NULL || host->h_addrtype != AF_INET) {
+			Log_print("netplay: cannot find host %s", join_host);
+			close(sock);
+			sock = -1;
+			return FALSE;
+		}
+		memset(&peer, 0, sizeof(peer));
+		peer.sin_family = AF_INET;
+		memcpy(&peer.sin_addr, host->h_addr_list[0], sizeof(peer.sin_addr));
+		peer.sin_port = htons(port);
+		Log_print("netplay: joining %s:%d", join_host, port);
+	}
+	else
+		Log_print("netplay: hosting on UDP port %d", port);
+	return TRUE;
+}
+
+int NETPLAY_Initialise(int *argc, char *argv[])
+{
+	int i;
+	int j;
+
+	for (i = j = 1; i < *argc; i++) {
+		int i_a = (i + 1 < *argc);		/* is argument available? */
+		int a_m = FALSE;			/* error, argument missing! */
+		int a_i = FALSE;			/* error, argument invalid! */
+
+		if (strcmp(argv[i], "-netplay-host") == 0) {
+			if (i_a) {
+				mode = MODE_HOST;
+				port = Util_sscandec(argv[++i]);
+				if (port < 1 || port > 65535)
+					a_i = TRUE;
+			}
+			else a_m = TRUE;
+		}
+		else if (strcmp(argv[i], "-netplay-join") == 0) {
+			if (i_a) {
+				char *colon;
+
+				mode = MODE_GUEST;
+				Util_strlcpy(join_host, argv[++i], sizeof(join_host));
+				colon = strrchr(join_host, ':');
+				if (colon != NULL) {
+					*colon = '\0';
+					port = Util_sscandec(colon + 1);
+					if (port < 1 || port > 65535)
+						a_i = TRUE;
+				}
+			}
+			else a_m = TRUE;
+		}
+		else if (strcmp(argv[i], "-netplay-delay") == 0) {
+			if (i_a) {
+				delay = Util_sscandec(argv[++i]);
+				if (delay < 0 || delay > MAX_DELAY)
+					a_i = TRUE;
+			}
+			else a_m = TRUE;
+		}
+		else if (strcmp(argv[i], "-netplay-rollback") == 0) {
+			if (i_a) {
+				rollback = Util_sscandec(argv[++i]);
+				if (rollback < 1 || rollback > MAX_ROLLBACK)
+					a_i = TRUE;
+			}
+			else a_m = TRUE;
+		}
+		else {
+			if (strcmp(argv[i], "-help") == 0) {
+				Log_print("\t-netplay-host <port>  Host a two-player rollback netplay session");
+				Log_print("\t-netplay-join <host>[:<port>]  Join a netplay host (default port %d)", DEFAULT_PORT);
+				Log_print("\t-netplay-delay <n>  Frames the local input is delayed (default 2)");
+				Log_print("\t-netplay-rollback <n>  Frames run ahead of the peer's input (default 8)");
+			}
+			argv[j++] = argv[i];
+		}
+
+		if (a_m) {
+			Log_print("Missing argument for '%s'", argv[i]);
+			return FALSE;
+		}
+		else if (a_i) {
+			Log_print("Invalid argument for '%s'", argv[--i]);
+			return FALSE;
+		}
+	}
+	*argc = j;
+
+	if (mode != MODE_OFF)
+		return open_socket();
+	return TRUE;
+}
+
+void NETPLAY_Exit(void)
+{
+	if (sock < 0)
+		return;
+	if (running)
+		end_session("exit", TRUE);
+	close(sock);
+	sock = -1;
+	free(snapshots);
+	snapshots = NULL;
+	free(state);
+	state = NULL;
+}
@@ -0,0 +1,35 @@
+/*
+ * netplay.h - two-player rollback netplay over UDP
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+#ifndef NETPLAY_H_
+#define NETPLAY_H_
+
+/* Two emulators, one hosting and one joining, play one machine: the host's
+   joystick 0 is port 0 and the guest's is port 1, and the console keys of
+   both are pressed together. Each side runs its frames at once with the
+   other's last input as a guess, keeps a snapshot of every frame the guess
+   may still be wrong for, and when the real input turns out different it
+   goes back to that frame's snapshot and runs the frames since again,
+   without drawing or sound, before the current one. */
+
+/* Parses the -netplay-* options and opens the socket. */
+int NETPLAY_Initialise(int *argc, char *argv[]);
+
+/* Says goodbye to the peer and closes the socket. */
+void NETPLAY_Exit(void);
+
+/* At the start of a frame, before INPUT_Frame(): exchanges input, goes
+   back and runs the frames again that ran with a wrong guess, and waits
+   while too far ahead of the peer's input. */
+void NETPLAY_Frame(void);
+
+/* After INPUT_Frame() and AI_ApplyInput(): takes joystick 0 and the
+   console keys as the local input, and sets both players' input for the
+   frame about to run. */
+void NETPLAY_ApplyInput(void);
+
+#endif /* NETPLAY_H_ */
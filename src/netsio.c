@@ -4,7 +4,13 @@
 * fujinet_rx_thread receives from FujiNet-PC, responds to pings/alives,
 * queues complete packets to emulator
 *
+* Received data reaches the emulator through a lock-free ring, and the
+* packets the emulator sends are held and sent together by netsio_flush(),
+* so neither side costs a system call per byte.
+*
 */
+#define _GNU_SOURCE /* recvmmsg, sendmmsg */
+#include "config.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -14,11 +20,11 @@
 #include <pthread.h>
 #include <sys/types.h>
 #include <sys/socket.h>
-#include <sys/ioctl.h>
 #include <netinet/in.h>
 #include <fcntl.h>
 #include <time.h>
 #include "netsio.h"
+#include "ai_timeline.h"
 #include "log.h"
 #include "pia.h" /* For toggling PROC & INT */
 
@@ -26,7 +32,6 @@
 #ifdef DEBUG
 static char *buf_to_hex(const uint8_t *buf, size_t offset, size_t len);
 #endif /* DEBUG */
-static void send_block_to_fujinet(const uint8_t *block, size_t len);
 
 /* Flag to know when netsio is enabled */
 volatile int netsio_enabled = 0;
@@ -41,8 +46,36 @@ int netsio_cmd_state = 0;
 /* data frame size for SIO write commands */
 volatile int netsio_next_write_size = 0;
 
-/* FIFO pipe: fds0: FujiNet->emulator */
-int fds0[2];
+/* FujiNet->emulator data: a ring with one writer, fujinet_rx_thread, and
+   one reader, the emulator. Each side stores only its own index, the
+   writer after the data and the reader after taking it. */
+#if defined(__GNUC__)
+#define NETSIO_BARRIER() __sync_synchronize()
+#else
+#define NETSIO_BARRIER() do { } while (0)
+#endif
+static uint8_t rx_ring[NETSIO_FIFO_SIZE];
+static volatile unsigned int rx_head = 0; /* bytes written, mod 2^32 */
+static volatile unsigned int rx_tail = 0; /* bytes read */
+
+/* Emulator->FujiNet packets held for netsio_flush(). Data bytes sent one
+   after another go into one DATA_BLOCK packet. */
+#define TX_MAX_PACKETS 16
+static uint8_t tx_packet[TX_MAX_PACKETS][512 + 2];
+static size_t tx_len[TX_MAX_PACKETS];
+static int tx_count = 0;
+static int tx_block_open = 0; /* the last packet collects data bytes */
+
+/* Sync responses: the emulator waits on sync_cond until fujinet_rx_thread
+   clears netsio_sync_wait, both holding sync_mutex */
+#define SYNC_TIMEOUT_MS 45
+static pthread_mutex_t sync_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t sync_cond = PTHREAD_COND_INITIALIZER;
+static struct timespec sync_sent; /* CLOCK_MONOTONIC */
+static NetSIOSyncStats sync_stats;
+
+/* Datagrams taken by one recvmmsg() */
+#define RX_BATCH 16
 
 /* UDP socket for NetSIO and return address holder */
 static int sockfd = -1;
@@ -87,20 +120,25 @@ char *buf_to_hex(const uint8_t *buf, size_t offset, size_t len) {
 
 /* write data to emulator FIFO (fujinet_rx_thread) */
 static void enqueue_to_emulator(const uint8_t *pkt, size_t len) {
-    ssize_t n;
     while (len > 0)
     {
-        n = write(fds0[1], pkt, len);
-        if (n < 0)
+        unsigned int head = rx_head;
+        size_t room = NETSIO_FIFO_SIZE - (head - rx_tail);
+        size_t i;
+        if (room == 0)
         {
-            if (errno == EINTR) continue;
-#ifdef DEBUG
-            Log_print("netsio: write to emulator FIFO");
-#endif
-            /*exit(1);*/
+            /* the emulator takes the bytes at serial speed */
+            millisleep(1);
+            continue;
         }
-        pkt += n;
-        len -= n;
+        if (room > len)
+            room = len;
+        for (i = 0; i < room; i++)
+            rx_ring[(head + i) % NETSIO_FIFO_SIZE] = pkt[i];
+        NETSIO_BARRIER();
+        rx_head = head + (unsigned int)room;
+        pkt += room;
+        len -= room;
     }
 }
 
@@ -187,21 +225,106 @@ static void send_to_fujinet(const uint8_t *pkt, size_t len) {
 #endif
 }
 
-/* Send up to 512 bytes as a DATA_BLOCK packet */
-static void send_block_to_fujinet(const uint8_t *block, size_t len) {
-    uint8_t packet[512 + 2];
-
-    if (len == 0 || len > 512) return;  /* sanity check */
-    packet[0] = NETSIO_DATA_BLOCK;
-    memcpy(&packet[1], block, len);
+/* Close the DATA_BLOCK packet collecting data bytes: one byte goes as a
+   DATA_BYTE packet */
+static void close_tx_block(void) {
+    uint8_t *p;
+    if (!tx_block_open)
+        return;
+    tx_block_open = 0;
+    p = tx_packet[tx_count - 1];
+    if (tx_len[tx_count - 1] == 2)
+    {
+        p[0] = NETSIO_DATA_BYTE;
+        return;
+    }
     /* Pad the end with a junk byte or FN-PC won't accept the packet */
-    packet[1 + len] = 0xFF;
-    send_to_fujinet(packet, len + 2);
+    p[tx_len[tx_count - 1]++] = 0xFF;
+}
+
+/* Send the packets held by queue_to_fujinet() (emulator thread) */
+void netsio_flush(void) {
+    int i;
+    close_tx_block();
+    if (tx_count == 0)
+        return;
+#ifdef HAVE_SENDMMSG
+    if (fujinet_known && fujinet_addr.ss_family == AF_INET)
+    {
+        struct mmsghdr msgs[TX_MAX_PACKETS];
+        struct iovec iov[TX_MAX_PACKETS];
+        int flags = 0, sent = 0;
+#if defined(MSG_NOSIGNAL) && !defined(__APPLE__)
+        flags |= MSG_NOSIGNAL;
+#endif
+        memset(msgs, 0, sizeof(msgs));
+        for (i = 0; i < tx_count; i++)
+        {
+            iov[i].iov_base = tx_packet[i];
+            iov[i].iov_len = tx_len[i];
+            msgs[i].msg_hdr.msg_iov = &iov[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+            msgs[i].msg_hdr.msg_name = &fujinet_addr;
+            msgs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+        }
+        while (sent < tx_count)
+        {
+            int n = sendmmsg(sockfd, msgs + sent, tx_count - sent, flags);
+            if (n < 0)
+            {
+                if (errno == EINTR) continue;
+#ifdef DEBUG
+                Log_print("netsio: sendmmsg failed: %d", errno);
+#endif
+                break;
+            }
+            sent += n;
+        }
+        tx_count = 0;
+        return;
+    }
+#endif /* HAVE_SENDMMSG */
+    for (i = 0; i < tx_count; i++)
+        send_to_fujinet(tx_packet[i], tx_len[i]);
+    tx_count = 0;
+}
+
+/* Hold a packet for netsio_flush() (emulator thread) */
+static void queue_to_fujinet(const uint8_t *pkt, size_t len) {
+    close_tx_block();
+    if (tx_count == TX_MAX_PACKETS)
+        netsio_flush();
+    memcpy(tx_packet[tx_count], pkt, len);
+    tx_len[tx_count++] = len;
+}
+
+/* Hold data bytes for netsio_flush(), adding them to the DATA_BLOCK packet
+   of the bytes held just before */
+static void queue_data_to_fujinet(const uint8_t *data, size_t len) {
+    while (len > 0)
+    {
+        size_t n;
+        if (!tx_block_open || tx_len[tx_count - 1] == 1 + 512)
+        {
+            close_tx_block();
+            if (tx_count == TX_MAX_PACKETS)
+                netsio_flush();
+            tx_packet[tx_count][0] = NETSIO_DATA_BLOCK;
+            tx_len[tx_count++] = 1;
+            tx_block_open = 1;
+        }
+        n = 1 + 512 - tx_len[tx_count - 1];
+        if (n > len)
+            n = len;
+        memcpy(tx_packet[tx_count - 1] + tx_len[tx_count - 1], data, n);
+        tx_len[tx_count - 1] += n;
+        data += n;
+        len -= n;
+    }
 }
 
 /* Initialize NetSIO:
 *   - connect to FujiNet socket
-*   - create FIFO
 *   - spawn the thread
 */
 int netsio_init(uint16_t port) {
@@ -209,17 +332,6 @@ int netsio_init(uint16_t port) {
     pthread_t rx_thread;
     int broadcast = 1;
 
-    /* create emulator <-> netsio FIFOs */
-    if (pipe(fds0) < 0)
-    {
-#ifdef DEBUG
-        Log_print("netsio: pipe creation error");
-#endif
-        return -1;
-    }
-
-    /* fcntl(fds0[0], F_SETFL, O_NONBLOCK); */
-
     /* connect socket to FujiNet */
     sockfd = socket(AF_INET, SOCK_DGRAM, 0);
     if (sockfd < 0)
@@ -278,39 +390,83 @@ int netsio_init(uint16_t port) {
     return 0;
 }
 
+/* Start waiting for a sync response: called before the sync packet is
+   sent, so the response cannot come first (emulator thread) */
+static void sync_begin(void)
+{
+    pthread_mutex_lock(&sync_mutex);
+    netsio_sync_wait = 1;
+    clock_gettime(CLOCK_MONOTONIC, &sync_sent);
+    pthread_mutex_unlock(&sync_mutex);
+}
+
+/* A sync response came: count its latency and wake the emulator
+   (fujinet_rx_thread) */
+static void sync_end(void)
+{
+    pthread_mutex_lock(&sync_mutex);
+    if (netsio_sync_wait)
+    {
+        struct timespec now;
+        long us;
+        int i;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        us = (long)(now.tv_sec - sync_sent.tv_sec) * 1000000L
+            + (now.tv_nsec - sync_sent.tv_nsec) / 1000;
+        for (i = 0; i < NETSIO_LATENCY_BUCKETS - 1 && us >= 2L << i; i++)
+            ;
+        sync_stats.latency[i]++;
+        sync_stats.syncs++;
+        sync_stats.total_us += us;
+        if (us > sync_stats.max_us)
+            sync_stats.max_us = us;
+        netsio_sync_wait = 0; /* continue emulation */
+        pthread_cond_signal(&sync_cond);
+    }
+    pthread_mutex_unlock(&sync_mutex);
+}
+
 /* Called when a command frame with sync response is sent to FujiNet */
 void netsio_wait_for_sync(void)
 {
-    int ticker = 0;
+    struct timespec deadline;
+
+    pthread_mutex_lock(&sync_mutex);
+    /* pthread_cond_timedwait() takes CLOCK_REALTIME on every platform */
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_nsec += SYNC_TIMEOUT_MS * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L)
+    {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
     while (netsio_sync_wait)
     {
+        if (pthread_cond_timedwait(&sync_cond, &sync_mutex, &deadline) == ETIMEDOUT)
+        {
 #ifdef DEBUG
-        Log_print("netsio: waiting for sync response - %d", ticker);
+            Log_print("netsio: no sync response %u", netsio_sync_num);
 #endif
-        millisleep(5);
-        if (ticker > 7)
-        {
             netsio_sync_wait = 0;
+            sync_stats.timeouts++;
             break;
         }
-        ticker++;
     }
+    pthread_mutex_unlock(&sync_mutex);
+}
+
+void netsio_get_sync_stats(NetSIOSyncStats *stats, int clear)
+{
+    pthread_mutex_lock(&sync_mutex);
+    *stats = sync_stats;
+    if (clear)
+        memset(&sync_stats, 0, sizeof(sync_stats));
+    pthread_mutex_unlock(&sync_mutex);
 }
 
 /* Return number of bytes waiting from FujiNet to emulator */
 int netsio_available(void) {
-    int avail = 0;
-    if (fds0[0] >= 0)
-    {
-        if (ioctl(fds0[0], FIONREAD, &avail) < 0)
-        {
-#ifdef DEBUG
-            Log_print("netsio_avail: ioctl error");
-#endif
-            return -1;
-        }
-    }
-    return avail;
+    return (int)(rx_head - rx_tail);
 }
 
 /* COMMAND ON */
@@ -322,7 +478,7 @@ int netsio_cmd_on(void)
     Log_print("netsio: CMD ON");
 #endif
     netsio_cmd_state = 1;
-    send_to_fujinet(&p, 1);
+    queue_to_fujinet(&p, 1);
     return 0;
 }
 
@@ -334,7 +490,7 @@ int netsio_cmd_off(void)
 #ifdef DEBUG
     Log_print("netsio: CMD OFF");
 #endif
-    send_to_fujinet(&p, 1);
+    queue_to_fujinet(&p, 1);
     return 0;
 }
 
@@ -348,8 +504,9 @@ int netsio_cmd_off_sync(void)
 #ifdef DEBUG
     Log_print("netsio: CMD OFF SYNC");
 #endif
-    send_to_fujinet(p, sizeof(p));
-    netsio_sync_wait = 1; /* pause emulation until we hear back or timeout */
+    sync_begin(); /* pause emulation until we hear back or timeout */
+    queue_to_fujinet(p, sizeof(p));
+    netsio_flush();
     return 0;
 }
 
@@ -364,19 +521,17 @@ void netsio_toggle_cmd(int v)
 
 /* The emulator calls this to send a data byte out to FujiNet */
 int netsio_send_byte(uint8_t b) {
-    uint8_t pkt[2];
-    pkt[0] = NETSIO_DATA_BYTE;
-    pkt[1] = b;
 #ifdef DEBUG
     Log_print("netsio: send byte: %02X", b);
 #endif
-    send_to_fujinet(pkt, 2);
+    queue_data_to_fujinet(&b, 1);
     return 0;
 }
 
 /* The emulator calls this to send a data block out to FujiNet */
 int netsio_send_block(const uint8_t *block, ssize_t len) {
-    send_block_to_fujinet(block, len);
+    if (len <= 0 || len > 512) return 0;  /* sanity check */
+    queue_data_to_fujinet(block, (size_t)len);
 #ifdef DEBUG
     Log_print("netsio: send block, %i bytes:\n  %s", len, buf_to_hex(block, 0, len));
 #endif
@@ -394,24 +549,21 @@ int netsio_send_byte_sync(uint8_t b)
 #ifdef DEBUG
     Log_print("netsio: send byte: 0x%02X sync: %d", b, netsio_sync_num);
 #endif
-    send_to_fujinet(p, sizeof(p));
-    netsio_sync_wait = 1; /* pause emulation until we hear back or timeout s*/
+    sync_begin(); /* pause emulation until we hear back or timeout */
+    queue_to_fujinet(p, sizeof(p));
+    netsio_flush();
     return 0;
 }
 
 /* The emulator calls this to receive a data byte from FujiNet */
 int netsio_recv_byte(uint8_t *b) {
-    ssize_t n = read(fds0[0], b, 1);
-    if (n < 0)
-    {
-        if (errno == EINTR) return netsio_recv_byte(b);
-#ifdef DEBUG
-        Log_print("netsio: read from rx FIFO");
-#endif
-        return -1;
-    }
-    if (n == 0)
-        return -1; /* FIFO closed? */
+    unsigned int tail = rx_tail;
+    if (rx_head == tail)
+        return -1; /* FIFO empty */
+    NETSIO_BARRIER();
+    *b = rx_ring[tail % NETSIO_FIFO_SIZE];
+    NETSIO_BARRIER();
+    rx_tail = tail + 1;
 #ifdef DEBUG2
     Log_print("netsio: read to emu: %02X", (unsigned)*b);
 #endif
@@ -424,7 +576,8 @@ int netsio_cold_reset(void) {
 #ifdef DEBUG
     Log_print("netsio: cold reset");
 #endif
-    send_to_fujinet(&pkt, 1);
+    queue_to_fujinet(&pkt, 1);
+    netsio_flush();
     return 0;
 }
 
@@ -434,7 +587,8 @@ int netsio_warm_reset(void) {
 #ifdef DEBUG
     Log_print("netsio: warm reset");
 #endif
-    send_to_fujinet(&pkt, 1);
+    queue_to_fujinet(&pkt, 1);
+    netsio_flush();
     return 0;
 }
 
@@ -443,267 +597,317 @@ void netsio_test_cmd(void)
 {
     uint8_t p[6] = { 0x70, 0xE8, 0x00, 0x00, 0x59 }; /* Send fujidev get adapter config request */
     netsio_cmd_on(); /* Turn on CMD */
-    send_block_to_fujinet(p, sizeof(p));
+    netsio_send_block(p, sizeof(p));
     netsio_cmd_off_sync(); /* Turn off CMD */
 }
 
-/* Thread: receive from FujiNet socket (one packet == one command) */
-static void *fujinet_rx_thread(void *arg) {
-    uint8_t buf[4096];
-    uint8_t cmd;
-    ssize_t n;
+/* Act on one packet from FujiNet (fujinet_rx_thread) */
+static void handle_packet(const uint8_t *buf, ssize_t n) {
+    uint8_t cmd = buf[0];
 
-    for (;;)
+    switch (cmd)
     {
-        /* 
-         * Always initialize with full sockaddr_storage size for receiving
-         * This works on both Linux and macOS - we need full size for first connect
-         */
-        fujinet_addr_len = sizeof(fujinet_addr);
-        
-        /*
-         * If we've already established communication and know it's IPv4, we set the
-         * appropriate length in the sin_len field to ensure proper socket operation on macOS.
-         */
-#ifdef __APPLE__
-        if (fujinet_addr.ss_family == AF_INET) {
-            /* Only on macOS/BSD: Set sin_len for existing IPv4 connection */
-            struct sockaddr_in *addr_in = (struct sockaddr_in *)&fujinet_addr;
-            addr_in->sin_len = sizeof(struct sockaddr_in);
-        }
+        case NETSIO_PING_REQUEST:
+        {
+            uint8_t r = NETSIO_PING_RESPONSE;
+            send_to_fujinet(&r, 1);
+#ifdef DEBUG
+            Log_print("netsio: recv: PING→PONG");
 #endif
-        
-        n = recvfrom(sockfd,
-                             buf, sizeof(buf),
-                             0,
-                             (struct sockaddr *)&fujinet_addr,
-                             &fujinet_addr_len);
+            break;
+        }
 
-        if (n <= 0)
+        case NETSIO_DEVICE_CONNECTED: 
         {
 #ifdef DEBUG
-            Log_print("netsio: recv");
+            Log_print("netsio: recv: device connected");
 #endif
-            continue;
-        }
-        fujinet_known = 1;
-        
-        /* Update the address length to the correct size for future sends */
-        if (fujinet_addr.ss_family == AF_INET) {
-            /* For IPv4, use sizeof sockaddr_in */
-            fujinet_addr_len = sizeof(struct sockaddr_in);
+            netsio_enabled = 1;
+            break;
         }
 
-        /* Every packet must be at least one byte (the command) */
-        if (n < 1)
+        case NETSIO_DEVICE_DISCONNECTED:
         {
 #ifdef DEBUG
-            Log_print("netsio: empty packet");
+            Log_print("netsio: recv: device disconnected");
 #endif
-            continue;
+            netsio_enabled = 0;
+            break;
+        }
+        
+        case NETSIO_ALIVE_REQUEST:
+        {
+            uint8_t r = NETSIO_ALIVE_RESPONSE;
+            send_to_fujinet(&r, 1);
+#ifdef DEBUG2
+            Log_print("netsio: recv: IT'S ALIVE!");
+#endif
+            break;
         }
 
-        cmd = buf[0];
-
-        switch (cmd)
+        case NETSIO_CREDIT_STATUS:
         {
-            case NETSIO_PING_REQUEST:
+            uint8_t reply[2];
+            /* packet should be 2 bytes long */
+            if (n < 2)
             {
-                uint8_t r = NETSIO_PING_RESPONSE;
-                send_to_fujinet(&r, 1);
 #ifdef DEBUG
-                Log_print("netsio: recv: PING→PONG");
+                Log_print("netsio: recv: CREDIT_STATUS packet too short (%zd)", n);
 #endif
-                break;
             }
-
-            case NETSIO_DEVICE_CONNECTED: 
-            {
+            reply[0] = NETSIO_CREDIT_UPDATE;
+            reply[1] = 3;
+            send_to_fujinet(reply, sizeof(reply));
 #ifdef DEBUG
-                Log_print("netsio: recv: device connected");
+            Log_print("netsio: recv: credit status & response");
 #endif
-                netsio_enabled = 1;
-                break;
-            }
+            break;
+        }
 
-            case NETSIO_DEVICE_DISCONNECTED:
+        case NETSIO_SPEED_CHANGE:
+        {
+            /* packet: [cmd][baud32le] */
+            uint32_t baud;
+            if (n < 5)
             {
 #ifdef DEBUG
-                Log_print("netsio: recv: device disconnected");
+                Log_print("netsio: recv: SPEED_CHANGE packet too short (%zd)", n);
 #endif
-                netsio_enabled = 0;
                 break;
             }
-            
-            case NETSIO_ALIVE_REQUEST:
-            {
-                uint8_t r = NETSIO_ALIVE_RESPONSE;
-                send_to_fujinet(&r, 1);
-#ifdef DEBUG2
-                Log_print("netsio: recv: IT'S ALIVE!");
+            baud  = (uint32_t)buf[1];
+            baud |= (uint32_t)buf[2] <<  8;
+            baud |= (uint32_t)buf[3] << 16;
+            baud |= (uint32_t)buf[4] << 24;
+#ifdef DEBUG
+            Log_print("netsio: recv: requested baud rate %u", baud);
 #endif
-                break;
-            }
+            send_to_fujinet(buf, 5); /* echo back */
+            break;
+        }
 
-            case NETSIO_CREDIT_STATUS:
+        case NETSIO_SYNC_RESPONSE:
+        {
+            /* packet: [cmd][sync#][ack_type][ack_byte][write_lo][write_hi] */
+            uint8_t resp_sync, ack_type, ack_byte, write_size;
+
+            if (n < 6)
             {
-                uint8_t reply[2];
-                /* packet should be 2 bytes long */
-                if (n < 2)
-                {
-#ifdef DEBUG
-                    Log_print("netsio: recv: CREDIT_STATUS packet too short (%zd)", n);
-#endif
-                }
-                reply[0] = NETSIO_CREDIT_UPDATE;
-                reply[1] = 3;
-                send_to_fujinet(reply, sizeof(reply));
 #ifdef DEBUG
-                Log_print("netsio: recv: credit status & response");
+                Log_print("netsio: recv: SYNC_RESPONSE too short (%zd)", n);
 #endif
                 break;
             }
+            resp_sync  = buf[1];
+            ack_type   = buf[2];
+            ack_byte   = buf[3];
+            write_size = buf[4] | (uint16_t)buf[5] << 8;
 
-            case NETSIO_SPEED_CHANGE:
+            if (resp_sync != netsio_sync_num)
             {
-                /* packet: [cmd][baud32le] */
-                uint32_t baud;
-                if (n < 5)
-                {
 #ifdef DEBUG
-                    Log_print("netsio: recv: SPEED_CHANGE packet too short (%zd)", n);
+                Log_print("netsio: recv: sync-response: got %u, want %u", resp_sync, netsio_sync_num);
 #endif
-                    break;
-                }
-                baud  = (uint32_t)buf[1];
-                baud |= (uint32_t)buf[2] <<  8;
-                baud |= (uint32_t)buf[3] << 16;
-                baud |= (uint32_t)buf[4] << 24;
-#ifdef DEBUG
-                Log_print("netsio: recv: requested baud rate %u", baud);
-#endif
-                send_to_fujinet(buf, 5); /* echo back */
-                break;
             }
-
-            case NETSIO_SYNC_RESPONSE:
+            else
             {
-                /* packet: [cmd][sync#][ack_type][ack_byte][write_lo][write_hi] */
-                uint8_t resp_sync, ack_type, ack_byte, write_size;
-
-                if (n < 6)
+                if (ack_type == 0)
                 {
 #ifdef DEBUG
-                    Log_print("netsio: recv: SYNC_RESPONSE too short (%zd)", n);
+                    Log_print("netsio: recv: sync %u NAK, dropping", resp_sync);
 #endif
-                    break;
                 }
-                resp_sync  = buf[1];
-                ack_type   = buf[2];
-                ack_byte   = buf[3];
-                write_size = buf[4] | (uint16_t)buf[5] << 8;
-
-                if (resp_sync != netsio_sync_num)
+                else if (ack_type == 1)
                 {
+                    netsio_next_write_size = write_size;
 #ifdef DEBUG
-                    Log_print("netsio: recv: sync-response: got %u, want %u", resp_sync, netsio_sync_num);
+                    Log_print("netsio: recv: sync %u ACK byte=0x%02X  write_size=0x%04X", resp_sync, ack_byte, write_size);
 #endif
+                    enqueue_to_emulator(&ack_byte, 1);
                 }
                 else
                 {
-                    if (ack_type == 0)
-                    {
-#ifdef DEBUG
-                        Log_print("netsio: recv: sync %u NAK, dropping", resp_sync);
-#endif
-                    }
-                    else if (ack_type == 1)
-                    {
-                        netsio_next_write_size = write_size;
-#ifdef DEBUG
-                        Log_print("netsio: recv: sync %u ACK byte=0x%02X  write_size=0x%04X", resp_sync, ack_byte, write_size);
-#endif
-                        enqueue_to_emulator(&ack_byte, 1);
-                    }
-                    else
-                    {
 #ifdef DEBUG
-                        Log_print("netsio: recv: sync %u unknown ack_type %u", resp_sync, ack_type);
+                    Log_print("netsio: recv: sync %u unknown ack_type %u", resp_sync, ack_type);
 #endif
-                    }
                 }
-                netsio_sync_wait = 0; /* continue emulation */
-                break;
             }
+            sync_end();
+            break;
+        }
 
-            /* set_CA1 */
-            case NETSIO_PROCEED_ON:
-            {
-                break;
-            }
-            case NETSIO_PROCEED_OFF:
-            {
-                break;
-            }
+        /* set_CA1 */
+        case NETSIO_PROCEED_ON:
+        {
+            break;
+        }
+        case NETSIO_PROCEED_OFF:
+        {
+            break;
+        }
 
-            /* set_CB1 */
-            case NETSIO_INTERRUPT_ON:
+        /* set_CB1 */
+        case NETSIO_INTERRUPT_ON:
+        {
+            break;
+        }
+        case NETSIO_INTERRUPT_OFF:
+        {
+            break;
+        }
+
+        case NETSIO_DATA_BYTE:
+        {
+            /* packet: [cmd][data] */
+            uint8_t data;
+            if (n < 2)
             {
+#ifdef DEBUG
+                Log_print("netsio: recv: DATA_BYTE too short (%zd)", n);
+#endif
                 break;
             }
-            case NETSIO_INTERRUPT_OFF:
+            data = buf[1];
+#ifdef DEBUG
+            Log_print("netsio: recv: data byte: 0x%02X", data);
+#endif
+            enqueue_to_emulator(&data, 1);
+            break;
+        }
+
+        case NETSIO_DATA_BLOCK:
+        {
+            /* packet: [cmd][payload...] */
+            size_t payload_len;
+            if (n < 2)
             {
+#ifdef DEBUG
+                Log_print("netsio: recv: data block too short (%zd)", n);
+#endif
                 break;
             }
-
-            case NETSIO_DATA_BYTE:
-            {
-                /* packet: [cmd][data] */
-                uint8_t data;
-                if (n < 2)
-                {
+            /* payload length is everything after the command byte */
+            payload_len = n - 1;
 #ifdef DEBUG
-                    Log_print("netsio: recv: DATA_BYTE too short (%zd)", n);
+            Log_print("netsio: recv: data block %zu bytes:\n  %s", payload_len, buf_to_hex(buf, 1, payload_len));
 #endif
-                    break;
-                }
-                data = buf[1];
+            /* forward only buf[1]..buf[n-1] */
+            enqueue_to_emulator(buf + 1, payload_len);
+            break;
+        }            
+
+        default:
+        {
 #ifdef DEBUG
-                Log_print("netsio: recv: data byte: 0x%02X", data);
+            Log_print("netsio: recv: unknown cmd 0x%02X, length %zd", cmd, n);
 #endif
-                enqueue_to_emulator(&data, 1);
-                break;
-            }
+            break;
+        }
+    }
+}
 
-            case NETSIO_DATA_BLOCK:
-            {
-                /* packet: [cmd][payload...] */
-                size_t payload_len;
-                if (n < 2)
-                {
+/* Thread: receive from FujiNet socket (one packet == one command) */
+static void *fujinet_rx_thread(void *arg) {
+#ifdef HAVE_RECVMMSG
+    static uint8_t bufs[RX_BATCH][4096];
+    struct mmsghdr msgs[RX_BATCH];
+    struct iovec iov[RX_BATCH];
+    struct sockaddr_storage addrs[RX_BATCH];
+    int i, count;
+
+    for (;;)
+    {
+        memset(msgs, 0, sizeof(msgs));
+        for (i = 0; i < RX_BATCH; i++)
+        {
+            iov[i].iov_base = bufs[i];
+            iov[i].iov_len = sizeof(bufs[i]);
+            msgs[i].msg_hdr.msg_iov = &iov[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+            msgs[i].msg_hdr.msg_name = &addrs[i];
+            msgs[i].msg_hdr.msg_namelen = sizeof(addrs[i]);
+        }
+        /* Wait for one packet, then take those that came with it */
+        count = recvmmsg(sockfd, msgs, RX_BATCH, MSG_WAITFORONE, NULL);
+        if (count <= 0)
+        {
 #ifdef DEBUG
-                    Log_print("netsio: recv: data block too short (%zd)", n);
+            Log_print("netsio: recv");
 #endif
-                    break;
-                }
-                /* payload length is everything after the command byte */
-                payload_len = n - 1;
+            continue;
+        }
+        AI_TIMELINE_BEGIN(AI_TIMELINE_NETSIO, "packets");
+        for (i = 0; i < count; i++)
+        {
+            /* Every packet must be at least one byte (the command) */
+            if (msgs[i].msg_len < 1)
+                continue;
+            memcpy(&fujinet_addr, &addrs[i], sizeof(fujinet_addr));
+            fujinet_known = 1;
+            if (fujinet_addr.ss_family == AF_INET)
+                fujinet_addr_len = sizeof(struct sockaddr_in);
+            handle_packet(bufs[i], (ssize_t)msgs[i].msg_len);
+        }
+        AI_TIMELINE_END(AI_TIMELINE_NETSIO);
+    }
+#else /* HAVE_RECVMMSG */
+    uint8_t buf[4096];
+    ssize_t n;
+
+    for (;;)
+    {
+        /* 
+         * Always initialize with full sockaddr_storage size for receiving
+         * This works on both Linux and macOS - we need full size for first connect
+         */
+        fujinet_addr_len = sizeof(fujinet_addr);
+        
+        /*
+         * If we've already established communication and know it's IPv4, we set the
+         * appropriate length in the sin_len field to ensure proper socket operation on macOS.
+         */
+#ifdef __APPLE__
+        if (fujinet_addr.ss_family == AF_INET) {
+            /* Only on macOS/BSD: Set sin_len for existing IPv4 connection */
+            struct sockaddr_in *addr_in = (struct sockaddr_in *)&fujinet_addr;
+            addr_in->sin_len = sizeof(struct sockaddr_in);
+        }
+#endif
+        
+        n = recvfrom(sockfd,
+                             buf, sizeof(buf),
+                             0,
+                             (struct sockaddr *)&fujinet_addr,
+                             &fujinet_addr_len);
+
+        if (n <= 0)
+        {
 #ifdef DEBUG
-                Log_print("netsio: recv: data block %zu bytes:\n  %s", payload_len, buf_to_hex(buf, 1, payload_len));
+            Log_print("netsio: recv");
 #endif
-                /* forward only buf[1]..buf[n-1] */
-                enqueue_to_emulator(buf + 1, payload_len);
-                break;
-            }            
+            continue;
+        }
+        fujinet_known = 1;
+        
+        /* Update the address length to the correct size for future sends */
+        if (fujinet_addr.ss_family == AF_INET) {
+            /* For IPv4, use sizeof sockaddr_in */
+            fujinet_addr_len = sizeof(struct sockaddr_in);
+        }
 
-            default:
-            {
+        /* Every packet must be at least one byte (the command) */
+        if (n < 1)
+        {
 #ifdef DEBUG
-                Log_print("netsio: recv: unknown cmd 0x%02X, length %zd", cmd, n);
+            Log_print("netsio: empty packet");
 #endif
-                break;
-            }
+            continue;
         }
+
+        AI_TIMELINE_BEGIN(AI_TIMELINE_NETSIO, "packet");
+        handle_packet(buf, n);
+        AI_TIMELINE_END(AI_TIMELINE_NETSIO);
     }
+#endif /* HAVE_RECVMMSG */
     return NULL;
 }
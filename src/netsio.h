@@ -41,6 +41,18 @@ extern volatile int netsio_enabled;
 /* FIFO buffer depth */
 #define NETSIO_FIFO_SIZE 4096
 
+/* Round trips of the packets waiting for a sync response. latency[i]
+   counts responses taking at least 2^i but under 2^(i+1) microseconds
+   (latency[0] also the faster ones, the last bucket all slower ones). */
+#define NETSIO_LATENCY_BUCKETS 16
+typedef struct NetSIOSyncStats {
+    unsigned long syncs;    /* responses in time */
+    unsigned long timeouts; /* no response in time */
+    double total_us;
+    long max_us;
+    unsigned long latency[NETSIO_LATENCY_BUCKETS];
+} NetSIOSyncStats;
+
 /* NetSIO message struct */
 typedef struct NetSIOMsg {
     uint8_t id;
@@ -54,10 +66,6 @@ extern volatile int netsio_sync_wait;
 extern int netsio_cmd_state;
 extern volatile int netsio_next_write_size;
 
-/* FIFO pipes: fds0: FujiNet->emulator
-*/
-extern int fds0[2];
-
 /* Initialize NetSIO subsystem, connecting to FujiNet-PC at host:port. */
 /* Returns 0 on success, non-zero on error. */
 int netsio_init(uint16_t port);
@@ -71,6 +79,10 @@ int netsio_send_byte(uint8_t b);
 
 int netsio_send_block(const uint8_t *block, ssize_t len);
 
+/* Send the packets held back so far. Packets are held until the end of each
+   frame, or until a packet that waits for a sync response. */
+void netsio_flush(void);
+
 int netsio_send_byte_sync(uint8_t b);
 
 /* Dequeue one byte received from FujiNet-PC. */
@@ -82,6 +94,10 @@ int netsio_cmd_off(void);
 int netsio_cmd_off_sync(void);
 void netsio_toggle_cmd(int v);
 void netsio_wait_for_sync(void);
+
+/* Copy the sync statistics into STATS, and zero them if CLEAR */
+void netsio_get_sync_stats(NetSIOSyncStats *stats, int clear);
+
 int netsio_available(void);
 int netsio_cold_reset(void);
 int netsio_warm_reset(void);
@@ -22,12 +22,15 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <string.h>
+
 #include "pal_blending.h"
 
 #include "artifact.h"
 #include "atari.h"
 #include "colours.h"
 #include "colours_pal.h"
+#include "palette_blit.h"
 #include "platform.h"
 #include "screen.h"
 
@@ -35,12 +38,27 @@
 #include "videomode.h"
 #endif /* SUPPORTS_CHANGE_VIDEOMODE */
 
+/* Blended colours, indexed by (previous line's pixel & 0xf0) << 4 | pixel,
+   for lines starting even [0] and odd [1]. Blending the hue of the pixel
+   above is the only use of the previous line, so one lookup gives the
+   final colour. */
 static union {
-	UWORD bpp16[2][256];	/* 16-bit palette */
-	ULONG bpp32[2][256];	/* 32-bit palette */
-} palette;
+	UWORD bpp16[2][16 * 256];	/* 16-bit */
+	ULONG bpp32[2][16 * 256];	/* 32-bit */
+} blend;
+
+/* Index into BLEND of pixel C under PREV */
+#define BLEND_INDEX(prev, c) ((((prev) & 0xf0) << 4) | (c))
 
-static ULONG shift_mask;
+/* What BLEND was last computed from. Video mode changes and palette
+   updates that leave the PAL colours as they were keep it as it is. */
+static struct {
+	double yuv_table[256*5];
+	int adjust; /* whether gamma is applied */
+	double gamma;
+	PLATFORM_pixel_format_t format;
+} blend_key;
+static int blend_valid = FALSE;
 
 void PAL_BLENDING_UpdateLookup(void)
 {
@@ -48,11 +66,32 @@ void PAL_BLENDING_UpdateLookup(void)
 		double yuv_table[256*5];
 		int even_pal[256];
 		int odd_pal[256];
+		union {
+			UWORD bpp16[2][256];	/* 16-bit palette */
+			ULONG bpp32[2][256];	/* 32-bit palette */
+		} palette;
+		ULONG shift_mask;
 		int i;
+		int odd;
+		int adjust;
 		double *ptr = yuv_table;
 		PLATFORM_pixel_format_t format;
 
 		COLOURS_PAL_GetYUV(yuv_table);
+		adjust = !COLOURS_PAL_external.loaded || COLOURS_PAL_external.adjust;
+		PLATFORM_GetPixelFormat(&format);
+		if (blend_valid
+		    && memcmp(blend_key.yuv_table, yuv_table, sizeof(yuv_table)) == 0
+		    && blend_key.adjust == adjust
+		    && (!adjust || blend_key.gamma == COLOURS_PAL_setup.gamma)
+		    && blend_key.format.bpp == format.bpp && blend_key.format.rmask == format.rmask
+		    && blend_key.format.gmask == format.gmask && blend_key.format.bmask == format.bmask)
+			return;
+		memcpy(blend_key.yuv_table, yuv_table, sizeof(yuv_table));
+		blend_key.adjust = adjust;
+		blend_key.gamma = COLOURS_PAL_setup.gamma;
+		blend_key.format = format;
+		blend_valid = TRUE;
 
 		for (i = 0; i < 256; ++i) {
 			double y = *ptr++;
@@ -62,7 +101,7 @@ void PAL_BLENDING_UpdateLookup(void)
 			double odd_v = *ptr++;
 			double r, g, b;
 			Colours_YUV2RGB(y, even_u, even_v, &r, &g, &b);
-			if (!COLOURS_PAL_external.loaded || COLOURS_PAL_external.adjust) {
+			if (adjust) {
 				r = Colours_Gamma2Linear(r, COLOURS_PAL_setup.gamma);
 				g = Colours_Gamma2Linear(g, COLOURS_PAL_setup.gamma);
 				b = Colours_Gamma2Linear(b, COLOURS_PAL_setup.gamma);
@@ -72,7 +111,7 @@ void PAL_BLENDING_UpdateLookup(void)
 			}
 			Colours_SetRGB(i, (int) (r * 255), (int) (g * 255), (int) (b * 255), even_pal);
 			Colours_YUV2RGB(y, odd_u, odd_v, &r, &g, &b);
-			if (!COLOURS_PAL_external.loaded || COLOURS_PAL_external.adjust) {
+			if (adjust) {
 				r = Colours_Gamma2Linear(r, COLOURS_PAL_setup.gamma);
 				g = Colours_Gamma2Linear(g, COLOURS_PAL_setup.gamma);
 				b = Colours_Gamma2Linear(b, COLOURS_PAL_setup.gamma);
@@ -82,127 +121,123 @@ void PAL_BLENDING_UpdateLookup(void)
 			}
 			Colours_SetRGB(i, (int) (r * 255), (int) (g * 255), (int) (b * 255), odd_pal);
 		}
-		PLATFORM_GetPixelFormat(&format);
 		shift_mask = (format.rmask & ~(format.rmask << 1)) | (format.gmask & ~(format.gmask << 1)) | (format.bmask & ~(format.bmask << 1));
+		shift_mask = ~shift_mask;
 		switch (format.bpp) {
 		case 16:
 			PLATFORM_MapRGB(palette.bpp16[0], even_pal, 256);
 			PLATFORM_MapRGB(palette.bpp16[1], odd_pal, 256);
-			shift_mask |= shift_mask << 16;
+			for (odd = 0; odd < 2; ++odd)
+				for (i = 0; i < 16 * 256; ++i) {
+					/* Give the previous line's pixel the same Y component as the
+					   current line's pixel. */
+					ULONG quad = palette.bpp16[odd][i & 0xff];
+					ULONG quad_prev = palette.bpp16[odd ^ 1][((i >> 4) & 0xf0) | (i & 0x0f)];
+					/* Since QUAD_PREV and QUAD have the same Y component, computing
+					   averages of even U/V and odd U/V is equal to computing averages
+					   of even and odd RGB components. */
+					blend.bpp16[odd][i] = (UWORD) ((quad & quad_prev) + (((quad ^ quad_prev) & shift_mask) >> 1));
+				}
 			break;
 		case 32:
 			PLATFORM_MapRGB(palette.bpp32[0], even_pal, 256);
 			PLATFORM_MapRGB(palette.bpp32[1], odd_pal, 256);
+			for (odd = 0; odd < 2; ++odd)
+				for (i = 0; i < 16 * 256; ++i) {
+					ULONG quad = palette.bpp32[odd][i & 0xff];
+					ULONG quad_prev = palette.bpp32[odd ^ 1][((i >> 4) & 0xf0) | (i & 0x0f)];
+					blend.bpp32[odd][i] = (quad & quad_prev) + (((quad ^ quad_prev) & shift_mask) >> 1);
+				}
 		}
-		shift_mask = ~shift_mask;
 	}
 }
 
 void PAL_BLENDING_Blit16(ULONG *dest, UBYTE *src, int pitch, int width, int height, int start_odd)
 {
-	register ULONG quad, quad_prev;
-	register UBYTE c;
 	register int pos;
 	UBYTE *src_prev = src;
-	int odd_prev = start_odd ^ 1;
 	int width_32;
 	if (width & 0x01)
 		width_32 = width + 1;
 	else
 		width_32 = width;
 	while (height > 0) {
-		pos = width_32;
-		do {
-			pos--;
-			c = src[pos];
-			/* Make QUAD_PREV have the same Y component as the current line's pixel. */
-			quad_prev = palette.bpp16[odd_prev][(src_prev[pos] & 0xf0) | (c & 0x0f)] << 16;
-			quad = palette.bpp16[start_odd][c] << 16;
-			pos--;
-			c = src[pos];
-			quad_prev |= palette.bpp16[odd_prev][(src_prev[pos] & 0xf0) | (c & 0x0f)];
-			quad |= palette.bpp16[start_odd][c];
-			/* Since QUAD_PREV and QUAD have the same Y component, computing
-			   averages of even U/V and odd U/V is equal to computing averages
-			   of even and odd RGB components. */
-			/* dest[pos >> 1] = ((quad+quad_prev) & shift_mask)/2; */
-			dest[pos >> 1] = (quad & quad_prev) + (((quad ^ quad_prev) & shift_mask) >> 1);
-		} while (pos > 0);
+		UWORD const *lookup = blend.bpp16[start_odd];
+		pos = 0;
+		/* Eight pixels a pass */
+		for (; pos + 8 <= width_32; pos += 8) {
+			dest[pos >> 1] = (ULONG) lookup[BLEND_INDEX(src_prev[pos], src[pos])]
+			                 | (ULONG) lookup[BLEND_INDEX(src_prev[pos + 1], src[pos + 1])] << 16;
+			dest[(pos >> 1) + 1] = (ULONG) lookup[BLEND_INDEX(src_prev[pos + 2], src[pos + 2])]
+			                       | (ULONG) lookup[BLEND_INDEX(src_prev[pos + 3], src[pos + 3])] << 16;
+			dest[(pos >> 1) + 2] = (ULONG) lookup[BLEND_INDEX(src_prev[pos + 4], src[pos + 4])]
+			                       | (ULONG) lookup[BLEND_INDEX(src_prev[pos + 5], src[pos + 5])] << 16;
+			dest[(pos >> 1) + 3] = (ULONG) lookup[BLEND_INDEX(src_prev[pos + 6], src[pos + 6])]
+			                       | (ULONG) lookup[BLEND_INDEX(src_prev[pos + 7], src[pos + 7])] << 16;
+		}
+		for (; pos < width_32; pos += 2)
+			dest[pos >> 1] = (ULONG) lookup[BLEND_INDEX(src_prev[pos], src[pos])]
+			                 | (ULONG) lookup[BLEND_INDEX(src_prev[pos + 1], src[pos + 1])] << 16;
 		src_prev = src;
 		src += Screen_WIDTH;
 		dest += pitch;
 		height--;
 		start_odd ^= 1;
-		odd_prev ^= 1;
 	}
 }
 
 void PAL_BLENDING_Blit32(ULONG *dest, UBYTE *src, int pitch, int width, int height, int start_odd)
 {
-	register ULONG quad, quad_prev;
-	register UBYTE c;
 	register int pos;
 	UBYTE *src_prev = src;
-	int odd_prev = start_odd ^ 1;
 	while (height > 0) {
-		pos = width;
-		do {
-			pos--;
-			c = src[pos];
-			/* Make QUAD_PREV have the same Y component as the current line's pixel. */
-			quad_prev = palette.bpp32[odd_prev][(src_prev[pos] & 0xf0) | (c & 0x0f)];
-			quad = palette.bpp32[start_odd][c];
-			/* Since QUAD_PREV and QUAD have the same Y component, computing
-			   averages of even U/V and odd U/V is equal to computing averages
-			   of even and odd RGB components. */
-			/* dest[pos] = ((quad+quad_prev) & shift_mask)/2; */
-			dest[pos] = (quad & quad_prev) + (((quad ^ quad_prev) & shift_mask) >> 1);
-		} while (pos > 0);
+		ULONG const *lookup = blend.bpp32[start_odd];
+		pos = 0;
+		for (; pos + 8 <= width; pos += 8) {
+			dest[pos] = lookup[BLEND_INDEX(src_prev[pos], src[pos])];
+			dest[pos + 1] = lookup[BLEND_INDEX(src_prev[pos + 1], src[pos + 1])];
+			dest[pos + 2] = lookup[BLEND_INDEX(src_prev[pos + 2], src[pos + 2])];
+			dest[pos + 3] = lookup[BLEND_INDEX(src_prev[pos + 3], src[pos + 3])];
+			dest[pos + 4] = lookup[BLEND_INDEX(src_prev[pos + 4], src[pos + 4])];
+			dest[pos + 5] = lookup[BLEND_INDEX(src_prev[pos + 5], src[pos + 5])];
+			dest[pos + 6] = lookup[BLEND_INDEX(src_prev[pos + 6], src[pos + 6])];
+			dest[pos + 7] = lookup[BLEND_INDEX(src_prev[pos + 7], src[pos + 7])];
+		}
+		for (; pos < width; pos++)
+			dest[pos] = lookup[BLEND_INDEX(src_prev[pos], src[pos])];
 		src_prev = src;
 		src += Screen_WIDTH;
 		dest += pitch;
 		height--;
 		start_odd ^= 1;
-		odd_prev ^= 1;
 	}
 }
 
 void PAL_BLENDING_BlitScaled16(ULONG *dest, UBYTE *src, int pitch, int width, int height, int dest_width, int dest_height, int start_odd)
 {
-	register ULONG quad, quad_prev;
-	register int x;
 	int y = 0x10000;
 	int w1 = dest_width / 2 - 1;
-	int w = width << 16;
 	int h = height << 16;
 	int pos;
-	register int dx = w / dest_width;
 	int dy = h / dest_height;
-	int init_x = (width << 16) - 0x4000;
 	UBYTE *src_prev = src;
-	int odd_prev = start_odd ^ 1;
-
-	UBYTE c;
+	int const *map = PALETTE_BLIT_ColumnMap(width, dest_width, w1 * 2 + 2);
+	/* Destination line holding the current source line */
+	ULONG *drawn = NULL;
 
 	while (dest_height > 0) {
-		x = init_x;
-		pos = w1;
-		while (pos >= 0) {
-			c = src[x >> 16];
-			/* Make QUAD_PREV have the same Y component as the current line's pixel. */
-			quad_prev = palette.bpp16[odd_prev][(src_prev[x >> 16] & 0xf0) | (c & 0x0f)] << 16;
-			quad = palette.bpp16[start_odd][c] << 16;
-			x -= dx;
-			c = src[x >> 16];
-			quad_prev |= palette.bpp16[odd_prev][(src_prev[x >> 16] & 0xf0) | (c & 0x0f)];
-			quad |= palette.bpp16[start_odd][c];
-			x -= dx;
-			/* Since QUAD_PREV and QUAD have the same Y component, computing
-			   averages of even U/V and odd U/V is equal to computing averages
-			   of even and odd RGB components. */
-			/* dest[pos] = ((quad+quad_prev) & shift_mask)/2; */
-			dest[pos] = (quad & quad_prev) + (((quad ^ quad_prev) & shift_mask) >> 1);
-			pos--;
+		if (drawn != NULL)
+			/* Same source line as the one above */
+			memcpy(dest, drawn, (w1 + 1) * sizeof(ULONG));
+		else {
+			UWORD const *lookup = blend.bpp16[start_odd];
+			for (pos = 0; pos <= w1; pos++) {
+				int x0 = map[pos * 2];
+				int x1 = map[pos * 2 + 1];
+				dest[pos] = (ULONG) lookup[BLEND_INDEX(src_prev[x0], src[x0])]
+				            | (ULONG) lookup[BLEND_INDEX(src_prev[x1], src[x1])] << 16;
+			}
+			drawn = dest;
 		}
 		dest += pitch;
 		y -= dy;
@@ -212,43 +247,31 @@ void PAL_BLENDING_BlitScaled16(ULONG *dest, UBYTE *src, int pitch, int width, in
 			src_prev = src;
 			src += Screen_WIDTH;
 			start_odd ^= 1;
-			odd_prev ^= 1;
+			drawn = NULL;
 		}
 	}
 }
 
 void PAL_BLENDING_BlitScaled32(ULONG *dest, UBYTE *src, int pitch, int width, int height, int dest_width, int dest_height, int start_odd)
 {
-	register ULONG quad, quad_prev;
-	register int x;
 	int y = 0x10000;
-	int w1 = dest_width - 1;
-	int w = width << 16;
 	int h = height << 16;
 	int pos;
-	register int dx = w / dest_width;
 	int dy = h / dest_height;
-	int init_x = w - 0x4000;
 	UBYTE *src_prev = src;
-	int odd_prev = start_odd ^ 1;
-
-	UBYTE c;
+	int const *map = PALETTE_BLIT_ColumnMap(width, dest_width, dest_width);
+	ULONG *drawn = NULL;
 
 	while (dest_height > 0) {
-		x = init_x;
-		pos = w1;
-		while (pos >= 0) {
-			c = src[x >> 16];
-			/* Make QUAD_PREV have the same Y component as the current line's pixel. */
-			quad_prev = palette.bpp32[odd_prev][(src_prev[x >> 16] & 0xf0) | (c & 0x0f)];
-			quad = palette.bpp32[start_odd][c];
-			x -= dx;
-			/* Since QUAD_PREV and QUAD have the same Y component, computing
-			   averages of even U/V and odd U/V is equal to computing averages
-			   of even and odd RGB components. */
-			/* dest[pos] = ((quad+quad_prev) & shift_mask)/2; */
-			dest[pos] = (quad & quad_prev) + (((quad ^ quad_prev) & shift_mask) >> 1);
-			pos--;
+		if (drawn != NULL)
+			memcpy(dest, drawn, dest_width * sizeof(ULONG));
+		else {
+			ULONG const *lookup = blend.bpp32[start_odd];
+			for (pos = 0; pos < dest_width; pos++) {
+				int x = map[pos];
+				dest[pos] = lookup[BLEND_INDEX(src_prev[x], src[x])];
+			}
+			drawn = dest;
 		}
 		dest += pitch;
 		y -= dy;
@@ -258,7 +281,7 @@ void PAL_BLENDING_BlitScaled32(ULONG *dest, UBYTE *src, int pitch, int width, in
 			src_prev = src;
 			src += Screen_WIDTH;
 			start_odd ^= 1;
-			odd_prev ^= 1;
+			drawn = NULL;
 		}
 	}
 }
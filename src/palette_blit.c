@@ -0,0 +1,169 @@
+/*
+ * palette_blit.c - Atari screen to display pixel conversion
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+/* The conversion is a table lookup per pixel. Splitting the table into
+   nibble shuffles or pairing pixels in a 64K-entry table both cost more
+   than the single L1-resident lookup they replace, so the loops below
+   just unroll it. Scaling keeps a map of source columns and copies a
+   destination line when the one above shows the same source line; when
+   the map doubles or triples each column, a line is drawn with one lookup
+   per source pixel stored two or three times. */
+
+#include "config.h"
+#include <string.h>
+
+#include "palette_blit.h"
+#include "util.h"
+
+#define DEST_LINE(type, dest, dest_pitch) ((type *) ((UBYTE *) (dest) + (dest_pitch)))
+
+void PALETTE_BLIT_16(UWORD *dest, int dest_pitch, UBYTE const *src, int src_pitch,
+                     int width, int height, UWORD const *palette)
+{
+	for (; height > 0; --height) {
+		int pos = 0;
+		for (; pos + 8 <= width; pos += 8) {
+			dest[pos] = palette[src[pos]];
+			dest[pos + 1] = palette[src[pos + 1]];
+			dest[pos + 2] = palette[src[pos + 2]];
+			dest[pos + 3] = palette[src[pos + 3]];
+			dest[pos + 4] = palette[src[pos + 4]];
+			dest[pos + 5] = palette[src[pos + 5]];
+			dest[pos + 6] = palette[src[pos + 6]];
+			dest[pos + 7] = palette[src[pos + 7]];
+		}
+		for (; pos < width; pos++)
+			dest[pos] = palette[src[pos]];
+		src += src_pitch;
+		dest = DEST_LINE(UWORD, dest, dest_pitch);
+	}
+}
+
+void PALETTE_BLIT_32(ULONG *dest, int dest_pitch, UBYTE const *src, int src_pitch,
+                     int width, int height, ULONG const *palette)
+{
+	for (; height > 0; --height) {
+		int pos = 0;
+		for (; pos + 8 <= width; pos += 8) {
+			dest[pos] = palette[src[pos]];
+			dest[pos + 1] = palette[src[pos + 1]];
+			dest[pos + 2] = palette[src[pos + 2]];
+			dest[pos + 3] = palette[src[pos + 3]];
+			dest[pos + 4] = palette[src[pos + 4]];
+			dest[pos + 5] = palette[src[pos + 5]];
+			dest[pos + 6] = palette[src[pos + 6]];
+			dest[pos + 7] = palette[src[pos + 7]];
+		}
+		for (; pos < width; pos++)
+			dest[pos] = palette[src[pos]];
+		src += src_pitch;
+		dest = DEST_LINE(ULONG, dest, dest_pitch);
+	}
+}
+
+/* Destination pixels per source pixel when the column map is exactly
+   pos / map_factor, else 0 */
+static int map_factor = 0;
+
+int const *PALETTE_BLIT_ColumnMap(int width, int dest_width, int count)
+{
+	static int *map = NULL;
+	static int map_count = 0;
+	static int map_width = 0;
+	static int map_dest_width = 0;
+	int dx = (width << 16) / dest_width;
+	int x = (width << 16) - 0x4000;
+	int pos;
+	if (map_count == count && map_width == width && map_dest_width == dest_width)
+		return map;
+	map = (int *) Util_realloc(map, (count > 0 ? count : 1) * sizeof(int));
+	for (pos = count - 1; pos >= 0; --pos) {
+		map[pos] = x >> 16;
+		x -= dx;
+	}
+	map_factor = 0;
+	if (count == dest_width && dest_width % width == 0) {
+		int factor = dest_width / width;
+		pos = 0;
+		while (pos < count && map[pos] == pos / factor)
+			pos++;
+		if (pos == count)
+			map_factor = factor;
+	}
+	map_count = count;
+	map_width = width;
+	map_dest_width = dest_width;
+	return map;
+}
+
+/* Walks the destination lines of a scaled blit: LINE is the source line
+   shown on the current one, DRAWN the last destination line drawn. PIXEL
+   is the destination pixel for source column S. */
+#define SCALED_LOOP(type, pixel) \
+	int y = 0; \
+	int dy = (height << 16) / dest_height; \
+	int const *map = PALETTE_BLIT_ColumnMap(width, dest_width, count); \
+	UBYTE const *drawn_src = NULL; \
+	type *drawn = NULL; \
+	for (; dest_height > 0; --dest_height) { \
+		UBYTE const *line = src + src_pitch * (y >> 16); \
+		if (changed == NULL || changed[y >> 16]) { \
+			if (line == drawn_src) \
+				memcpy(dest, drawn, count * sizeof(type)); \
+			else { \
+				int pos; \
+				int s; \
+				switch (map_factor) { \
+				case 2: \
+					for (s = 0, pos = 0; pos < count; s++, pos += 2) { \
+						type value = pixel; \
+						dest[pos] = value; \
+						dest[pos + 1] = value; \
+					} \
+					break; \
+				case 3: \
+					for (s = 0, pos = 0; pos < count; s++, pos += 3) { \
+						type value = pixel; \
+						dest[pos] = value; \
+						dest[pos + 1] = value; \
+						dest[pos + 2] = value; \
+					} \
+					break; \
+				default: \
+					for (pos = 0; pos < count; pos++) { \
+						s = map[pos]; \
+						dest[pos] = pixel; \
+					} \
+				} \
+				drawn_src = line; \
+				drawn = dest; \
+			} \
+		} \
+		dest = DEST_LINE(type, dest, dest_pitch); \
+		y += dy; \
+	}
+
+void PALETTE_BLIT_Scaled8(UBYTE *dest, int dest_pitch, UBYTE const *src, int src_pitch,
+                          int width, int height, int dest_width, int dest_height, int count,
+                          UBYTE const *changed)
+{
+	SCALED_LOOP(UBYTE, line[s])
+}
+
+void PALETTE_BLIT_Scaled16(UWORD *dest, int dest_pitch, UBYTE const *src, int src_pitch,
+                           int width, int height, int dest_width, int dest_height, int count,
+                           UBYTE const *changed, UWORD const *palette)
+{
+	SCALED_LOOP(UWORD, palette[line[s]])
+}
+
+void PALETTE_BLIT_Scaled32(ULONG *dest, int dest_pitch, UBYTE const *src, int src_pitch,
+                           int width, int height, int dest_width, int dest_height, int count,
+                           UBYTE const *changed, ULONG const *palette)
+{
+	SCALED_LOOP(ULONG, palette[line[s]])
+}
@@ -0,0 +1,47 @@
+/*
+ * palette_blit.h - Atari screen to display pixel conversion
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+#ifndef PALETTE_BLIT_H_
+#define PALETTE_BLIT_H_
+
+#include "atari.h"
+
+/* Conversion of the 8-bit indexed Screen_atari, or a crop of it, to the
+   pixels of a display. SRC points at the top-left pixel to show and
+   SRC_PITCH is the length of a source line (usually Screen_WIDTH). DEST
+   points at the top-left destination pixel and DEST_PITCH is the length
+   of a destination line in bytes. PALETTE maps the 256 Atari colours to
+   the display's pixel format. */
+
+/* Copy WIDTH x HEIGHT pixels, one destination pixel per source pixel. */
+void PALETTE_BLIT_16(UWORD *dest, int dest_pitch, UBYTE const *src, int src_pitch,
+                     int width, int height, UWORD const *palette);
+void PALETTE_BLIT_32(ULONG *dest, int dest_pitch, UBYTE const *src, int src_pitch,
+                     int width, int height, ULONG const *palette);
+
+/* Scale WIDTH x HEIGHT pixels to DEST_WIDTH x DEST_HEIGHT. COUNT is the
+   number of pixels written on each line, at most DEST_WIDTH; the 8-bit
+   display writes a multiple of 4 and the 16-bit one a multiple of 2.
+   CHANGED, unless NULL, flags the source lines to draw; destination lines
+   showing the other lines are left as they are. */
+void PALETTE_BLIT_Scaled8(UBYTE *dest, int dest_pitch, UBYTE const *src, int src_pitch,
+                          int width, int height, int dest_width, int dest_height, int count,
+                          UBYTE const *changed);
+void PALETTE_BLIT_Scaled16(UWORD *dest, int dest_pitch, UBYTE const *src, int src_pitch,
+                           int width, int height, int dest_width, int dest_height, int count,
+                           UBYTE const *changed, UWORD const *palette);
+void PALETTE_BLIT_Scaled32(ULONG *dest, int dest_pitch, UBYTE const *src, int src_pitch,
+                           int width, int height, int dest_width, int dest_height, int count,
+                           UBYTE const *changed, ULONG const *palette);
+
+/* Source column of each of the first COUNT destination pixels when WIDTH
+   pixels are scaled to DEST_WIDTH: the displays step leftwards from just
+   inside the right edge in 16.16 fixed point. The map is kept until it is
+   asked for with other sizes. */
+int const *PALETTE_BLIT_ColumnMap(int width, int dest_width, int count);
+
+#endif /* PALETTE_BLIT_H_ */
@@ -147,6 +147,26 @@ UBYTE PBI_PROTO80_GetPixels(int scanline, int column)
 	return font_data;
 }
 
+int PBI_PROTO80_GetText(TEXT80_Screen *screen)
+{
+	int row, column;
+
+	screen->card = "proto80";
+	screen->rows = PROTO80_ROWS;
+	/* The cursor is drawn in the character RAM */
+	screen->cursor_x = screen->cursor_y = -1;
+	for (row = 0; row < PROTO80_ROWS; row++) {
+		for (column = 0; column < 80; column++) {
+			UBYTE character = MEMORY_mem[0x9800 + row*80 + column];
+			int c = character & 0x7f;
+			/* The OS font: internal codes to ATASCII */
+			screen->chars[row][column] = c < 0x40 ? c + 0x20 : c < 0x60 ? c - 0x40 : c;
+			screen->inverse[row][column] = (character & 0x80) != 0;
+		}
+	}
+	return TRUE;
+}
+
 /*
 vim:ts=4:sw=4:
 */
@@ -2,6 +2,7 @@
 #define PBI_PROTO80_H_
 
 #include "atari.h"
+#include "text80.h"
 int PBI_PROTO80_Initialise(int *argc, char *argv[]);
 void PBI_PROTO80_Exit(void);
 int PBI_PROTO80_ReadConfig(char *string, char *ptr);
@@ -10,6 +11,7 @@ int PBI_PROTO80_D1GetByte(UWORD addr, int no_side_effects);
 void PBI_PROTO80_D1PutByte(UWORD addr, UBYTE byte);
 int PBI_PROTO80_D1ffPutByte(UBYTE byte);
 UBYTE PBI_PROTO80_GetPixels(int scanline, int column);
+int PBI_PROTO80_GetText(TEXT80_Screen *screen);
 extern int PBI_PROTO80_enabled;
 
 #endif /* PBI_PROTO80_H_ */
@@ -22,9 +22,20 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 */
 
+#define _POSIX_C_SOURCE 200112L /* for fileno */
+
+#include "config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef HAVE_MMAP
+#include <sys/mman.h>
+#endif
+
 #include "atari.h"
 #include "util.h"
 #include "log.h"
+#include "sio.h"
 #include "pbi_scsi.h"
 
 #ifdef PBI_DEBUG
@@ -51,12 +62,193 @@ static UBYTE scsi_byte;
 #define SCSI_PHASE_STATUS 4 
 #define SCSI_PHASE_MSGIN 5
 
+#define SCSI_BLOCK_SIZE 256
+/* READ and WRITE move up to this many blocks at once */
+#define SCSI_MAX_BLOCKS 255
+
 static int scsi_phase = SCSI_PHASE_SELECTION;
 static int scsi_bufpos = 0;
-static UBYTE scsi_buffer[256];
+static UBYTE scsi_buffer[SCSI_BLOCK_SIZE * SCSI_MAX_BLOCKS];
 static int scsi_count = 0;
+static ULONG scsi_pos;	/* of the blocks being written */
+
+/* The disk image. Where the system allows it the file is mapped, so
+   emulators booting from the same image share its pages, and blocks are
+   copied straight from the mapping; the mapping is never written. As with
+   the disk drives, the blocks written are kept in pages of our own, and
+   SIO_disk_writes decides when they reach the file. */
+#define SCSI_PAGE_SIZE 4096
+
+static FILE *disk = NULL;
+static int read_only;	/* the file could not be opened for writing */
+static UBYTE *image = NULL;	/* the mapping, or NULL to read the file */
+static ULONG image_size;
+static ULONG disk_size;	/* with what was written past the end */
+static UBYTE **pages = NULL;	/* those written to */
+static UBYTE *dirty = NULL;	/* pages not in the file yet */
+static ULONG num_pages = 0;
+
+/* Reads like fread from POS onwards, up to disk_size */
+static int read_disk(ULONG pos, UBYTE *buffer, int size)
+{
+	int n;
+
+	if (pos >= disk_size)
+		return 0;
+	if ((ULONG) size > disk_size - pos)
+		size = (int) (disk_size - pos);
+	/* What the image has there */
+	if (image != NULL || pos >= image_size) {
+		int from_image = 0;
+		if (pos < image_size) {
+			from_image = size;
+			if ((ULONG) from_image > image_size - pos)
+				from_image = (int) (image_size - pos);
+			memcpy(buffer, image + pos, from_image);
+		}
+		memset(buffer + from_image, 0, size - from_image);
+	}
+	else {
+		size_t got = 0;
+		if (fseek(disk, (long) pos, SEEK_SET) == 0)
+			got = fread(buffer, 1, size, disk);
+		memset(buffer + got, 0, size - got);
+	}
+	/* and over it, what was written */
+	for (n = 0; n < size; ) {
+		ULONG page = (pos + n) / SCSI_PAGE_SIZE;
+		int offset = (int) ((pos + n) % SCSI_PAGE_SIZE);
+		int len = SCSI_PAGE_SIZE - offset;
+		if (len > size - n)
+			len = size - n;
+		if (page < num_pages && pages[page] != NULL)
+			memcpy(buffer + n, pages[page] + offset, len);
+		n += len;
+	}
+	return size;
+}
+
+/* The page of our own blocks holding byte POS, made if there is none */
+static UBYTE *own_page(ULONG pos)
+{
+	ULONG page = pos / SCSI_PAGE_SIZE;
+
+	if (page >= num_pages) {
+		ULONG n = page + 1;
+		pages = (UBYTE **) Util_realloc(pages, n * sizeof(UBYTE *));
+		dirty = (UBYTE *) Util_realloc(dirty, n);
+		memset(pages + num_pages, 0, (n - num_pages) * sizeof(UBYTE *));
+		memset(dirty + num_pages, 0, n - num_pages);
+		num_pages = n;
+	}
+	if (pages[page] == NULL) {
+		UBYTE *p = (UBYTE *) Util_malloc(SCSI_PAGE_SIZE);
+		memset(p, 0, SCSI_PAGE_SIZE);
+		read_disk(page * SCSI_PAGE_SIZE, p, SCSI_PAGE_SIZE);
+		pages[page] = p;
+	}
+	return pages[page];
+}
+
+/* Writes SIZE bytes at POS to our own pages and, with SIO_WRITES_DIRECT,
+   to the file */
+static void write_disk(ULONG pos, const UBYTE *buffer, int size)
+{
+	int n;
 
-FILE *PBI_SCSI_disk = NULL;
+	for (n = 0; n < size; ) {
+		int offset = (int) ((pos + n) % SCSI_PAGE_SIZE);
+		int len = SCSI_PAGE_SIZE - offset;
+		if (len > size - n)
+			len = size - n;
+		memcpy(own_page(pos + n) + offset, buffer + n, len);
+		n += len;
+	}
+	if (pos + size > disk_size)
+		disk_size = pos + size;
+	if (SIO_disk_writes == SIO_WRITES_DIRECT && !read_only) {
+		fseek(disk, (long) pos, SEEK_SET);
+		fwrite(buffer, 1, size, disk);
+		return;
+	}
+	for (n = 0; n < size; n += SCSI_BLOCK_SIZE)
+		dirty[(pos + n) / SCSI_PAGE_SIZE] = TRUE;
+}
+
+/* Writes the dirty pages to the file */
+static void flush_disk(void)
+{
+	ULONG page;
+	int result = TRUE;
+
+	if (read_only)
+		return;
+	for (page = 0; page < num_pages; page++) {
+		ULONG start = page * SCSI_PAGE_SIZE;
+		int len = SCSI_PAGE_SIZE;
+		if (!dirty[page])
+			continue;
+		if ((ULONG) len > disk_size - start)
+			len = (int) (disk_size - start);
+		if (fseek(disk, (long) start, SEEK_SET) != 0
+			|| fwrite(pages[page], 1, len, disk) != (size_t) len) {
+			result = FALSE;
+			break;
+		}
+		dirty[page] = FALSE;
+	}
+	if (fflush(disk) != 0)
+		result = FALSE;
+	if (!result)
+		Log_print("Failed writing the SCSI disk image");
+}
+
+int PBI_SCSI_Open(const char *filename)
+{
+	PBI_SCSI_Close();
+	read_only = FALSE;
+	disk = fopen(filename, "rb+");
+	if (disk == NULL && SIO_disk_writes == SIO_WRITES_OVERLAY) {
+		/* The writes stay in memory anyway */
+		disk = fopen(filename, "rb");
+		read_only = TRUE;
+	}
+	if (disk == NULL)
+		return FALSE;
+	image_size = disk_size = (ULONG) Util_flen(disk);
+#ifdef HAVE_MMAP
+	if (image_size > 0) {
+		void *p = mmap(NULL, image_size, PROT_READ, MAP_PRIVATE, fileno(disk), 0);
+		if (p != MAP_FAILED)
+			image = (UBYTE *) p;
+	}
+#endif
+	return TRUE;
+}
+
+void PBI_SCSI_Close(void)
+{
+	ULONG page;
+
+	if (disk == NULL)
+		return;
+	if (SIO_disk_writes == SIO_WRITES_WRITEBACK)
+		flush_disk();
+#ifdef HAVE_MMAP
+	if (image != NULL)
+		munmap(image, image_size);
+#endif
+	image = NULL;
+	fclose(disk);
+	disk = NULL;
+	for (page = 0; page < num_pages; page++)
+		free(pages[page]);
+	free(pages);
+	free(dirty);
+	pages = NULL;
+	dirty = NULL;
+	num_pages = 0;
+}
 
 static void scsi_changephase(int phase)
 {
@@ -113,6 +305,7 @@ static void scsi_process_command(void)
 {
 	int i;
 	int lba;
+	int blocks;
 /*	int lun;*/
 	D(printf("SCSI command:"));
 	for (i = 0; i < 6; i++) {
@@ -137,9 +330,9 @@ static void scsi_process_command(void)
 			/* read */
 /*			lun = ((scsi_buffer[1]&0xe0)>>5);*/
 			lba = (((scsi_buffer[1]&0x1f)<<16)|(scsi_buffer[2]<<8)|(scsi_buffer[3]));
-			D(printf("SCSI: read lun:%d lba:%d\n",lun,lba));
-			fseek(PBI_SCSI_disk, lba*256, SEEK_SET);
-			scsi_count = fread(scsi_buffer, 1, 256, PBI_SCSI_disk);
+			blocks = scsi_buffer[4] > 1 ? scsi_buffer[4] : 1;
+			D(printf("SCSI: read lun:%d lba:%d blocks:%d\n",lun,lba,blocks));
+			scsi_count = read_disk((ULONG) lba * SCSI_BLOCK_SIZE, scsi_buffer, blocks * SCSI_BLOCK_SIZE);
 			scsi_changephase(SCSI_PHASE_DATAIN);
 			/* scsi_count = 256; */
 			break;
@@ -147,10 +340,11 @@ static void scsi_process_command(void)
 			/* write */
 /*			lun = ((scsi_buffer[1]&0xe0)>>5);*/
 			lba = (((scsi_buffer[1]&0x1f)<<16)|(scsi_buffer[2]<<8)|(scsi_buffer[3]));
-			D(printf("SCSI: write lun:%d lba:%d\n",lun,lba));
-			fseek(PBI_SCSI_disk, lba*256, SEEK_SET);
+			blocks = scsi_buffer[4] > 1 ? scsi_buffer[4] : 1;
+			D(printf("SCSI: write lun:%d lba:%d blocks:%d\n",lun,lba,blocks));
+			scsi_pos = (ULONG) lba * SCSI_BLOCK_SIZE;
 			scsi_changephase(SCSI_PHASE_DATAOUT);
-			scsi_count = 256;
+			scsi_count = blocks * SCSI_BLOCK_SIZE;
 			break;
 		default:
 			D(printf("SCSI: unknown command:%2x\n", scsi_buffer[0]));
@@ -188,7 +382,7 @@ static void scsi_nextbyte(void)
 		D(printf("SCSI data out:%2x\n", scsi_byte));
 		scsi_buffer[scsi_bufpos++] = scsi_byte;
 		if (scsi_bufpos >= scsi_count) {
-			fwrite(scsi_buffer, 1, 256, PBI_SCSI_disk);
+			write_disk(scsi_pos, scsi_buffer, scsi_count);
 			scsi_changephase(SCSI_PHASE_STATUS);
 			scsi_buffer[0] = 0;
 		}
@@ -11,11 +11,16 @@ extern int PBI_SCSI_BSY;
 extern int PBI_SCSI_REQ;
 extern int PBI_SCSI_SEL;
 extern int PBI_SCSI_ACK;
-extern FILE *PBI_SCSI_disk;
 
 void PBI_SCSI_PutByte(UBYTE byte);
 UBYTE PBI_SCSI_GetByte(void);
 void PBI_SCSI_PutSEL(int newsel);
 void PBI_SCSI_PutACK(int newack);
 
+/* Attaches the disk image in FILENAME, detaching the one there was.
+   Returns FALSE if it cannot be opened. */
+int PBI_SCSI_Open(const char *filename);
+/* Detaches the disk image, writing back what SIO_disk_writes kept */
+void PBI_SCSI_Close(void);
+
 #endif /* PBI_MIO_H_ */
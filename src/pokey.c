@@ -86,17 +86,72 @@ int POKEY_Base_mult[POKEY_MAXPOKEYS];		/* selects either 64Khz or 15Khz clock mu
 UBYTE POKEY_POT_input[8] = {228, 228, 228, 228, 228, 228, 228, 228};
 static int pot_scanline;
 
-UBYTE POKEY_poly9_lookup[511];
-UBYTE POKEY_poly17_lookup[16385];
+/* POKEY_poly9_lookup and POKEY_poly17_lookup */
+#include "gen-pokey-poly.h"
 static ULONG random_scanline_counter;
 
+/* The timers, pot_scanline and random_scanline_counter are not counted on
+   every scanline: POKEY_Scanline() counts the lines in lines_run and brings
+   them up to date on the line the first timer with its IRQ enabled runs
+   out, timer_lines after they last were, and before POKEY is read or
+   written. The timers without an IRQ have no other effect, so they may run
+   out any number of times in between. */
+static int lines_run = 0;
+static int timer_lines = 1;
+
+/* Longest wait for a timer, so that lines_run * ANTIC_LINE_C fits */
+#define MAX_TIMER_LINES 0x10000
+
+static void update_timers(void)
+{
+	static const int chans[3] = { POKEY_CHAN1, POKEY_CHAN2, POKEY_CHAN4 };
+	int i;
+
+	if (lines_run > 0) {
+		int cycles = lines_run * ANTIC_LINE_C;
+		if (pot_scanline < 228) {
+			pot_scanline += lines_run;
+			if (pot_scanline > 228)
+				pot_scanline = 228;
+		}
+		random_scanline_counter += cycles;
+		for (i = 0; i < 3; i++) {
+			int max = POKEY_DivNMax[chans[i]];
+			if ((POKEY_DivNIRQ[chans[i]] -= cycles) < 0) {
+				/* reloaded on each line it ran out on, which for those
+				   with the IRQ enabled is only the last */
+				if (max > 0)
+					POKEY_DivNIRQ[chans[i]] += (max - 1 - POKEY_DivNIRQ[chans[i]]) / max * max;
+				if (POKEY_IRQEN & (1 << i)) {
+					POKEY_IRQST &= ~(1 << i);
+					CPU_GenerateIRQ();
+				}
+			}
+		}
+		lines_run = 0;
+	}
+	/* Counted down by ANTIC_LINE_C a line, a timer runs out on the line
+	   that takes it below 0 */
+	timer_lines = MAX_TIMER_LINES;
+	for (i = 0; i < 3; i++) {
+		if (POKEY_IRQEN & (1 << i)) {
+			int left = POKEY_DivNIRQ[chans[i]];
+			int lines = left < 0 ? 1 : left / ANTIC_LINE_C + 1;
+			if (lines < timer_lines)
+				timer_lines = lines;
+		}
+	}
+}
+
 ULONG POKEY_GetRandomCounter(void)
 {
+	update_timers();
 	return random_scanline_counter;
 }
 
 void POKEY_SetRandomCounter(ULONG value)
 {
+	update_timers();
 	random_scanline_counter = value;
 }
 
@@ -109,6 +164,8 @@ UBYTE POKEY_GetByte(UWORD addr, int no_side_effects)
 		return 0;
 #endif
 	addr &= 0x0f;
+	if (addr < 8 || addr == POKEY_OFFSET_ALLPOT || addr == POKEY_OFFSET_RANDOM)
+		update_timers();
 	if (addr < 8) {
 		byte = POKEY_POT_input[addr];
 		if (byte <= pot_scanline)
@@ -189,6 +246,10 @@ void POKEY_PutByte(UWORD addr, UBYTE byte)
 #else
 	addr &= 0x0f;
 #endif
+#ifdef POKEYREC
+	POKEYREC_Write(addr & 0x0f, byte, addr >> 4);
+#endif
+	update_timers();
 	switch (addr) {
 	case POKEY_OFFSET_AUDC1:
 		POKEY_AUDC[POKEY_CHAN1] = byte;
@@ -240,6 +301,7 @@ void POKEY_PutByte(UWORD addr, UBYTE byte)
 		break;
 	case POKEY_OFFSET_IRQEN:
 		POKEY_IRQEN = byte;
+		update_timers();
 #ifdef DEBUG1
 		printf("WR: IRQEN = %x, PC = %x\n", POKEY_IRQEN, PC);
 #endif
@@ -276,7 +338,7 @@ void POKEY_PutByte(UWORD addr, UBYTE byte)
 		/* check if cassette 2-tone mode has been enabled */
 		if ((POKEY_SKCTL & 0x08) == 0x00) {
 			/* intelligent device */
-			POKEY_DELAYED_SEROUT_IRQ = SIO_SEROUT_INTERVAL;
+			POKEY_DELAYED_SEROUT_IRQ = SIO_TransferDelay(SIO_SEROUT_INTERVAL);
 			POKEY_IRQST |= 0x08;
 			POKEY_DELAYED_XMTDONE_IRQ = SIO_XMTDONE_INTERVAL;
 		}
@@ -300,6 +362,7 @@ void POKEY_PutByte(UWORD addr, UBYTE byte)
 		POKEY_DivNIRQ[POKEY_CHAN1] = POKEY_DivNMax[POKEY_CHAN1];
 		POKEY_DivNIRQ[POKEY_CHAN2] = POKEY_DivNMax[POKEY_CHAN2];
 		POKEY_DivNIRQ[POKEY_CHAN4] = POKEY_DivNMax[POKEY_CHAN4];
+		update_timers();
 		POKEYSND_Update(POKEY_OFFSET_STIMER, byte, 0, SOUND_GAIN);
 #ifdef DEBUG1
 		printf("WR: STIMER = %x\n", byte);
@@ -379,7 +442,6 @@ void POKEY_PutByte(UWORD addr, UBYTE byte)
 int POKEY_Initialise(int *argc, char *argv[])
 {
 	int i;
-	ULONG reg;
 
 	/* Initialise Serial Port Interrupts */
 	POKEY_DELAYED_SERIN_IRQ = 0;
@@ -407,19 +469,8 @@ int POKEY_Initialise(int *argc, char *argv[])
 		POKEY_DivNIRQ[i] = POKEY_DivNMax[i] = 0;
 
 	pot_scanline = 0;
-
-	/* initialise poly9_lookup */
-	reg = 0x1ff;
-	for (i = 0; i < 511; i++) {
-		reg = ((((reg >> 5) ^ reg) & 1) << 8) + (reg >> 1);
-		POKEY_poly9_lookup[i] = (UBYTE) reg;
-	}
-	/* initialise poly17_lookup */
-	reg = 0x1ffff;
-	for (i = 0; i < 16385; i++) {
-		reg = ((((reg >> 5) ^ reg) & 0xff) << 9) + (reg >> 8);
-		POKEY_poly17_lookup[i] = (UBYTE) (reg >> 1);
-	}
+	lines_run = 0;
+	update_timers();
 
 #ifndef BASIC
 	if (INPUT_Playingback()) {
@@ -448,6 +499,10 @@ int POKEY_Initialise(int *argc, char *argv[])
 
 void POKEY_Frame(void)
 {
+#ifdef POKEYREC
+	POKEYREC_Frame();
+#endif
+	update_timers();
 	random_scanline_counter %= (POKEY_AUDCTL[0] & POKEY_POLY9) ? POKEY_POLY9_SIZE : POKEY_POLY17_SIZE;
 }
 
@@ -483,11 +538,6 @@ void POKEY_Scanline(void)
 		/* Don't process timers when POKEY is in reset mode. */
 		return;
 
-	if (pot_scanline < 228)
-		pot_scanline++;
-
-	random_scanline_counter += ANTIC_LINE_C;
-
 	if (POKEY_DELAYED_SERIN_IRQ > 0) {
 		if (--POKEY_DELAYED_SERIN_IRQ == 0) {
 			/* Load a byte to SERIN - even when the IRQ is disabled. */
@@ -563,29 +613,8 @@ void POKEY_Scanline(void)
 #endif
 		}
 
-	if ((POKEY_DivNIRQ[POKEY_CHAN1] -= ANTIC_LINE_C) < 0 ) {
-		POKEY_DivNIRQ[POKEY_CHAN1] += POKEY_DivNMax[POKEY_CHAN1];
-		if (POKEY_IRQEN & 0x01) {
-			POKEY_IRQST &= 0xfe;
-			CPU_GenerateIRQ();
-		}
-	}
-
-	if ((POKEY_DivNIRQ[POKEY_CHAN2] -= ANTIC_LINE_C) < 0 ) {
-		POKEY_DivNIRQ[POKEY_CHAN2] += POKEY_DivNMax[POKEY_CHAN2];
-		if (POKEY_IRQEN & 0x02) {
-			POKEY_IRQST &= 0xfd;
-			CPU_GenerateIRQ();
-		}
-	}
-
-	if ((POKEY_DivNIRQ[POKEY_CHAN4] -= ANTIC_LINE_C) < 0 ) {
-		POKEY_DivNIRQ[POKEY_CHAN4] += POKEY_DivNMax[POKEY_CHAN4];
-		if (POKEY_IRQEN & 0x04) {
-			POKEY_IRQST &= 0xfb;
-			CPU_GenerateIRQ();
-		}
-	}
+	if (++lines_run >= timer_lines)
+		update_timers();
 }
 
 /*****************************************************************************/
@@ -660,6 +689,26 @@ static void Update_Counter(int chan_mask)
 	}
 }
 
+int POKEY_ChannelPeriod(int chip, int chan)
+{
+	UBYTE audctl = POKEY_AUDCTL[chip];
+	UBYTE const *audf = POKEY_AUDF + 4 * chip;
+	int low = chan < POKEY_CHAN3;
+	int fast = audctl & (low ? POKEY_CH1_179 : POKEY_CH3_179);
+	int base = (audctl & POKEY_CLOCK_15) ? POKEY_DIV_15 : POKEY_DIV_64;
+
+	if (audctl & (low ? POKEY_CH1_CH2 : POKEY_CH3_CH4)) {
+		int div;
+		if (chan == POKEY_CHAN1 || chan == POKEY_CHAN3)
+			return 0;
+		div = audf[chan] * 256 + audf[chan - 1];
+		return fast ? div + 7 : (div + 1) * base;
+	}
+	if (fast && (chan == POKEY_CHAN1 || chan == POKEY_CHAN3))
+		return audf[chan] + 4;
+	return (audf[chan] + 1) * base;
+}
+
 #ifndef BASIC
 
 void POKEY_StateSave(void)
@@ -668,6 +717,7 @@ void POKEY_StateSave(void)
 	int keypressed = 0;
 
 	STATESAV_TAG(pokey);
+	update_timers();
 	StateSav_SaveUBYTE(&POKEY_KBCODE, 1);
 	StateSav_SaveUBYTE(&POKEY_IRQST, 1);
 	StateSav_SaveUBYTE(&POKEY_IRQEN, 1);
@@ -717,6 +767,7 @@ void POKEY_StateRead(void)
 	StateSav_ReadINT(&POKEY_DivNIRQ[0], 4);
 	StateSav_ReadINT(&POKEY_DivNMax[0], 4);
 	StateSav_ReadINT(&POKEY_Base_mult[0], 1);
+	update_timers();
 }
 
 #endif
@@ -63,6 +63,11 @@ void POKEY_Scanline(void);
 void POKEY_StateSave(void);
 void POKEY_StateRead(void);
 
+/* Period of channel CHAN (POKEY_CHAN*) of POKEY number CHIP, in 1.79 MHz
+   cycles between two clocks of its output, as the registers now set it.
+   0 for the low half of a 16-bit pair, which is not heard on its own. */
+int POKEY_ChannelPeriod(int chip, int chan);
+
 #endif
 
 /* CONSTANT DEFINITIONS */
@@ -113,10 +118,13 @@ extern UBYTE POKEY_AUDF[4 * POKEY_MAXPOKEYS];	/* AUDFx (D200, D202, D204, D206)
 extern UBYTE POKEY_AUDC[4 * POKEY_MAXPOKEYS];	/* AUDCx (D201, D203, D205, D207) */
 extern UBYTE POKEY_AUDCTL[POKEY_MAXPOKEYS];		/* AUDCTL (D208) */
 
+/* POKEY_DivNIRQ lags behind by the scanlines since the last POKEY access
+   or timer IRQ, see pokey.c */
 extern int POKEY_DivNIRQ[4], POKEY_DivNMax[4];
 extern int POKEY_Base_mult[POKEY_MAXPOKEYS];	/* selects either 64Khz or 15Khz clock mult */
 
-extern UBYTE POKEY_poly9_lookup[POKEY_POLY9_SIZE];
-extern UBYTE POKEY_poly17_lookup[16385];
+/* Polynomial counter sequences, generated by tools/gen_poly.c */
+extern UBYTE const POKEY_poly9_lookup[POKEY_POLY9_SIZE];
+extern UBYTE const POKEY_poly17_lookup[16385];
 
 #endif /* POKEY_H_ */
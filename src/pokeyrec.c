@@ -25,10 +25,19 @@
 #include "config.h"
 #include "pokeyrec.h"
 #include "pokey.h"
+#include "antic.h"
+#include "gtia.h"
 #include "log.h"
 #include "util.h"
+#ifdef SOUND
+#include "pokeysnd.h"
+#endif
 #include <string.h>
+#include <stdlib.h>
 #include <stdio.h>
+#ifdef HAVE_PTHREAD_CREATE
+#include <pthread.h>
+#endif
 
 static int enabled, counter, interval;
 static char *filename = "pokeyrec.dat", *fmt = "%c";
@@ -37,6 +46,28 @@ static FILE *fp;
 static int stereo;
 #endif
 
+/* Event log: records are collected in chunks, which a writer thread
+   writes out in order while the emulator fills the next one */
+#define CHUNK_BYTES 65536
+#define CHUNKS 4
+#define RECORD_MAX 7
+
+static int events, started, write_error;
+static unsigned int last_clock;
+static int speaker;
+static UBYTE *chunks[CHUNKS];
+static int queued[CHUNKS];  /* bytes of chunk i waiting for the writer */
+static int fill, head;
+static UBYTE *pos, *end;
+
+#ifdef HAVE_PTHREAD_CREATE
+static pthread_mutex_t log_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t chunk_queued = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t chunk_freed = PTHREAD_COND_INITIALIZER;
+static pthread_t writer;
+static int writer_running, writer_stop;
+#endif
+
 static void output_pokey_values(int pokeynr) {
     int i;
     for (i=0; i<4; i++) {
@@ -46,8 +77,129 @@ static void output_pokey_values(int pokeynr) {
     fprintf(fp, fmt, POKEY_AUDCTL[pokeynr]);
 }
 
+static void write_chunk(int i, int len) {
+    if (fwrite(chunks[i], 1, len, fp) != (size_t)len && !write_error) {
+        write_error = TRUE;
+        Log_print("Cannot write '%s', the rest of the Pokey events are lost", filename);
+    }
+}
+
+#ifdef HAVE_PTHREAD_CREATE
+static void *writer_main(void *arg) {
+    (void)arg;
+    for (;;) {
+        int len;
+
+        pthread_mutex_lock(&log_lock);
+        while (queued[head] == 0 && !writer_stop)
+            pthread_cond_wait(&chunk_queued, &log_lock);
+        len = queued[head];
+        pthread_mutex_unlock(&log_lock);
+        /* The queue is written out before the writer stops */
+        if (len == 0) return NULL;
+
+        write_chunk(head, len);
+        pthread_mutex_lock(&log_lock);
+        queued[head] = 0;
+        head = (head + 1) % CHUNKS;
+        pthread_cond_signal(&chunk_freed);
+        pthread_mutex_unlock(&log_lock);
+    }
+}
+#endif
+
+/* Pass the chunk being filled to the writer and move on to a free one */
+static void hand_over(void) {
+    int len = pos - chunks[fill];
+    if (len == 0) return;
+#ifdef HAVE_PTHREAD_CREATE
+    if (writer_running) {
+        int next = (fill + 1) % CHUNKS;
+        pthread_mutex_lock(&log_lock);
+        queued[fill] = len;
+        pthread_cond_signal(&chunk_queued);
+        while (queued[next] != 0)
+            pthread_cond_wait(&chunk_freed, &log_lock);
+        fill = next;
+        pthread_mutex_unlock(&log_lock);
+    }
+    else
+#endif
+        write_chunk(fill, len);
+    pos = chunks[fill];
+    end = pos + CHUNK_BYTES;
+}
+
+static void put_record(int reg, UBYTE value, int chip) {
+    unsigned int delta = ANTIC_CPU_CLOCK - last_clock;
+    last_clock += delta;
+    if (end - pos < RECORD_MAX)
+        hand_over();
+    while (delta >= 0x80) {
+        *pos++ = (UBYTE)(delta | 0x80);
+        delta >>= 7;
+    }
+    *pos++ = (UBYTE)delta;
+    *pos++ = (UBYTE)(chip << 5 | reg);
+    *pos++ = value;
+}
+
+/* Write the header and the sound registers as they are now */
+static void start_events(void) {
+    int pokeys = 1, chip, i;
+
+    started = TRUE;
+    last_clock = ANTIC_CPU_CLOCK;
+    speaker = GTIA_speaker;
+#ifdef STEREO_SOUND
+    if (POKEYSND_stereo_enabled) pokeys = 2;
+#endif
+    memset(pos, 0, 16);
+    memcpy(pos, "PKEV", 4);
+    pos[4] = POKEYREC_EVENT_VERSION;
+    pos[5] = (UBYTE)pokeys;
+    pos[6] = (UBYTE)(Atari800_tv_mode & 0xff);
+    pos[7] = (UBYTE)(Atari800_tv_mode >> 8);
+#ifdef SOUND
+    pos[8] = POKEYSND_FREQ_17_EXACT & 0xff;
+    pos[9] = (POKEYSND_FREQ_17_EXACT >> 8) & 0xff;
+    pos[10] = (POKEYSND_FREQ_17_EXACT >> 16) & 0xff;
+    pos[11] = (POKEYSND_FREQ_17_EXACT >> 24) & 0xff;
+#endif
+    pos += 16;
+
+    for (chip = 0; chip < pokeys; chip++) {
+        for (i = 0; i < 4; i++) {
+            put_record(POKEY_OFFSET_AUDF1 + i * 2, POKEY_AUDF[chip * 4 + i], chip);
+            put_record(POKEY_OFFSET_AUDC1 + i * 2, POKEY_AUDC[chip * 4 + i], chip);
+        }
+        put_record(POKEY_OFFSET_AUDCTL, POKEY_AUDCTL[chip], chip);
+    }
+    put_record(POKEY_OFFSET_SKCTL, POKEY_SKCTL, 0);
+    put_record(POKEYREC_EVENT_SPEAKER, (UBYTE)speaker, 0);
+}
+
+void POKEYREC_Write(int reg, UBYTE value, int chip) {
+    if (!events) return;
+    /* Only what the sound emulation reads */
+    if (reg > POKEY_OFFSET_STIMER && reg != POKEY_OFFSET_SKCTL) {
+        if (reg != POKEYREC_EVENT_SPEAKER || value == speaker) return;
+        speaker = value;
+    }
+    /* The log starts at the end of a frame, with the registers' values */
+    if (started) put_record(reg, value, chip);
+}
+
+void POKEYREC_Frame(void) {
+    if (!events) return;
+    if (started)
+        put_record(POKEYREC_EVENT_FRAME, 0, 0);
+    else
+        start_events();
+}
+
 void POKEYREC_Recorder(void) {
-    if (!enabled) return;
+    if (!enabled || events) return;
 
     if (++counter == interval) {
         counter = 0;
@@ -77,6 +229,8 @@ int POKEYREC_Initialise(int *argc, char *argv[]) {
                 Log_print("Negative interval not allowed");
                 return FALSE;
             }
+        } else if (!strcmp(argv[i], "-pokeyrec-events")) {
+            enabled = events = 1;
         } else if (!strcmp(argv[i], "-pokeyrec-ascii")) {
             fmt = "%02x";
         } else if (!strcmp(argv[i], "-pokeyrec-file")) {
@@ -93,6 +247,8 @@ int POKEYREC_Initialise(int *argc, char *argv[]) {
                 Log_print("\t-pokeyrec-interval <n>     "
                                 "Sampling interval in scanlines (default: %d)",
                                                                     interval);
+                Log_print("\t-pokeyrec-events           "
+                                "Log every Pokey sound register write");
                 Log_print("\t-pokeyrec-ascii            "
                                 "Store ascii values (default: raw)");
                 Log_print("\t-pokeyrec-file <filename>  "
@@ -116,6 +272,18 @@ int POKEYREC_Initialise(int *argc, char *argv[]) {
             return FALSE;
         }
     }
+    if (events) {
+        UBYTE *buffer = (UBYTE *)Util_malloc(CHUNK_BYTES * CHUNKS);
+        for (i = 0; i < CHUNKS; i++)
+            chunks[i] = buffer + CHUNK_BYTES * i;
+        pos = chunks[0];
+        end = pos + CHUNK_BYTES;
+#ifdef HAVE_PTHREAD_CREATE
+        writer_running = pthread_create(&writer, NULL, writer_main, NULL) == 0;
+        if (!writer_running)
+            Log_print("Cannot start the Pokey event writer thread, writing in the foreground");
+#endif
+    }
 
     return TRUE;
 
@@ -125,5 +293,23 @@ missing_argument:
 }
 
 void POKEYREC_Exit(void) {
+    if (events) {
+        if (!started) start_events();
+        put_record(POKEYREC_EVENT_END, 0, 0);
+        hand_over();
+#ifdef HAVE_PTHREAD_CREATE
+        if (writer_running) {
+            pthread_mutex_lock(&log_lock);
+            writer_stop = TRUE;
+            pthread_cond_signal(&chunk_queued);
+            pthread_mutex_unlock(&log_lock);
+            pthread_join(writer, NULL);
+            writer_running = FALSE;
+        }
+#endif
+        free(chunks[0]);
+        events = 0;
+    }
     if (fp) fclose(fp);
+    fp = NULL;
 }
@@ -1,7 +1,32 @@
 #ifndef POKEYREC_H_
 #define POKEYREC_H_
 
+#include "atari.h"
+
+/* With -pokeyrec-events every write to a sound register is logged with
+   its CPU cycle, for tools/pokeyrender to turn into audio offline.
+
+   The file is a 16-byte header, "PKEV", the version byte, the number of
+   POKEYs, the scanlines per frame and the POKEY clock as little-endian
+   16- and 32-bit words and 4 zero bytes, followed by 3- to 7-byte
+   records:
+
+     the cycles since the previous record, 7 bits per byte, lowest first,
+     bit 7 set on all but the last byte
+     chip * 0x20 + register
+     the value written
+
+   Registers 0x00-0x09 and 0x0f are the POKEY's; the log starts with
+   their values at the end of the frame it starts with. The others are: */
+#define POKEYREC_EVENT_SPEAKER 0x10  /* console speaker, value 0 or 1 */
+#define POKEYREC_EVENT_FRAME   0x1e  /* the end of an emulated frame */
+#define POKEYREC_EVENT_END     0x1f  /* the end of the log */
+
+#define POKEYREC_EVENT_VERSION 1
+
 void POKEYREC_Recorder(void);
+void POKEYREC_Write(int reg, UBYTE value, int chip);
+void POKEYREC_Frame(void);
 int  POKEYREC_Initialise(int *argc, char *argv[]);
 void POKEYREC_Exit(void);
 
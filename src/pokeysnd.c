@@ -46,6 +46,12 @@
 #include "gtia.h"
 #include "util.h"
 
+#if defined(HAVE_PTHREAD_CREATE) && !defined(ASAP) && !defined(__PLUS)
+#define SOUND_THREAD
+#include <pthread.h>
+#include <string.h>
+#endif
+
 #ifdef WORDS_UNALIGNED_OK
 #  define READ_U32(x)     (*(ULONG *) (x))
 #  define WRITE_U32(x, d) (*(ULONG *) (x) = (d))
@@ -86,6 +92,13 @@ static UBYTE Outbit[4 * POKEY_MAXPOKEYS];		/* current state of the output (high
 
 static UBYTE Outvol[4 * POKEY_MAXPOKEYS];		/* last output volume for each channel */
 
+/* The registers as the engine last saw them written. The emulation moves
+   on to later values before the sound worker thread replays a write. */
+static UBYTE rf_AUDF[4 * POKEY_MAXPOKEYS];
+static UBYTE rf_AUDC[4 * POKEY_MAXPOKEYS];
+static UBYTE rf_AUDCTL[POKEY_MAXPOKEYS];
+static int rf_Base_mult[POKEY_MAXPOKEYS];
+
 /* Initialize the bit patterns for the polynomials. */
 
 /* The 4bit and 5bit patterns are the identical ones used in the pokey chip. */
@@ -93,14 +106,14 @@ static UBYTE Outvol[4 * POKEY_MAXPOKEYS];		/* last output volume for each channe
 /* single bit per byte keeps the math simple, which is important for */
 /* efficient processing. */
 
-static UBYTE bit4[POKEY_POLY4_SIZE] =
+static const UBYTE bit4[POKEY_POLY4_SIZE] =
 #ifndef POKEY23_POLY
 {1, 1, 1, 1, 0, 0, 0, 1, 0, 0, 1, 1, 0, 1, 0};	/* new table invented by Perry */
 #else
 {1, 1, 0, 1, 1, 1, 0, 0, 0, 0, 1, 0, 1, 0, 0};	/* original POKEY 2.3 table */
 #endif
 
-static UBYTE bit5[POKEY_POLY5_SIZE] =
+static const UBYTE bit5[POKEY_POLY5_SIZE] =
 #ifndef POKEY23_POLY
 {1, 1, 1, 1, 0, 1, 1, 0, 1, 0, 0, 1, 1, 0, 0, 0, 0, 0, 1, 1, 1, 0, 0, 1, 0, 0, 0, 1, 0, 1, 0};
 #else
@@ -167,13 +180,14 @@ void (*POKEYSND_Update_ptr) (UWORD addr, UBYTE val, UBYTE chip, UBYTE gain)
   = null_pokey_sound;
 
 #ifdef CONSOLE_SOUND
-static void Update_consol_sound_rf(int set);
-static void null_consol_sound(int set) {}
-void (*POKEYSND_UpdateConsol_ptr)(int set) = null_consol_sound;
+static void Update_consol_sound_rf(int set, int gtia_speaker);
+static void null_consol_sound(int set, int gtia_speaker) {}
+void (*POKEYSND_UpdateConsol_ptr)(int set, int gtia_speaker) = null_consol_sound;
 int POKEYSND_console_sound_enabled = 1;
 #endif
 
 UBYTE *POKEYSND_process_buffer = NULL;
+UBYTE *POKEYSND_synth_buffer = NULL;
 unsigned int POKEYSND_process_buffer_length;
 unsigned int POKEYSND_process_buffer_fill;
 static unsigned int prev_update_tick;
@@ -233,11 +247,18 @@ static int const CONSOLE_VOL = 32;
 static int pokeysnd_init_rf(ULONG freq17, int playback_freq,
            UBYTE num_pokeys, int flags);
 
+#ifdef SOUND_THREAD
+static void stop_worker(void);
+#endif
+
 int POKEYSND_DoInit(void)
 {
 #ifdef AUDIO_RECORDING
 	File_Export_StopRecording();
 #endif
+#ifdef SOUND_THREAD
+	stop_worker();
+#endif
 
 	if (POKEYSND_enable_new_pokey)
 		return MZPOKEYSND_Init(snd_freq17, POKEYSND_playback_freq,
@@ -274,8 +295,12 @@ int POKEYSND_Init(ULONG freq17, int playback_freq, UBYTE num_pokeys,
 		unsigned int max_ticks_per_frame = ticks_per_frame + surplus_ticks;
 		double ticks_per_sample = (double)ticks_per_frame / samples_per_frame;
 		POKEYSND_process_buffer_length = POKEYSND_num_pokeys * (unsigned int)ceil((double)max_ticks_per_frame / ticks_per_sample) * ((POKEYSND_snd_flags & POKEYSND_BIT16) ? 2:1);
+#ifdef SOUND_THREAD
+		stop_worker();
+#endif
 		free(POKEYSND_process_buffer);
 		POKEYSND_process_buffer = (UBYTE *)Util_malloc(POKEYSND_process_buffer_length);
+		POKEYSND_synth_buffer = POKEYSND_process_buffer;
 		POKEYSND_process_buffer_fill = 0;
 	    prev_update_tick = ANTIC_CPU_CLOCK;
 	}
@@ -302,18 +327,204 @@ void POKEYSND_Process(void *sndbuffer, int sndn)
 #endif
 }
 
+int POKEYSND_quiet = FALSE;
+int POKEYSND_threaded = FALSE;
+
 static void Update_synchronized_sound(void)
 {
-	POKEYSND_GenerateSync(ANTIC_CPU_CLOCK - prev_update_tick);
+	if (!POKEYSND_quiet)
+		POKEYSND_GenerateSync(ANTIC_CPU_CLOCK - prev_update_tick);
 	prev_update_tick = ANTIC_CPU_CLOCK;
 }
 
-int POKEYSND_UpdateProcessBuffer(void)
+#ifdef SOUND_THREAD
+/* With POKEYSND_threaded the emulation only logs the register writes of a
+   frame, with their CPU tick within the frame. At the end of the frame
+   POKEYSND_UpdateProcessBuffer() hands the log to a worker thread, which
+   replays it against the sound engine - samples up to each write, then the
+   write - into POKEYSND_synth_buffer while the next frame is emulated, and
+   takes back the samples of the frame before. The engine state belongs to
+   the worker while it runs; the emulation thread only touches it while
+   the worker waits. */
+enum { EVENT_REGISTER, EVENT_CONSOL };
+/* A log this long is replayed before the frame ends, in case nothing
+   collects the samples */
+enum { EVENTS_MAX = 16384 };
+
+typedef struct {
+	unsigned int tick;
+	UWORD addr;
+	UBYTE val;
+	UBYTE chip;
+	UBYTE gain;
+	UBYTE kind;
+} sound_event_t;
+
+static struct {
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	pthread_t thread;
+	int running;
+	int busy; /* a log is being replayed */
+	int quit;
+	/* log[logging] receives the writes, the other one is replayed */
+	sound_event_t *log[2];
+	int log_len[2];
+	int log_alloc[2];
+	int logging;
+	unsigned int end_tick; /* of the frame being replayed */
+	int quiet;
+	UBYTE *buffer; /* what the worker writes, POKEYSND_synth_buffer */
+} worker = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER };
+
+static void *worker_main(void *arg)
 {
-	int sndn;
+	pthread_mutex_lock(&worker.lock);
+	for (;;) {
+		sound_event_t const *ev;
+		unsigned int tick = 0;
+		int i, n;
+		while (!worker.busy && !worker.quit)
+			pthread_cond_wait(&worker.cond, &worker.lock);
+		if (worker.quit)
+			break;
+		pthread_mutex_unlock(&worker.lock);
+
+		ev = worker.log[!worker.logging];
+		n = worker.log_len[!worker.logging];
+		for (i = 0; i < n; i++, ev++) {
+			if (!worker.quiet)
+				POKEYSND_GenerateSync(ev->tick - tick);
+			tick = ev->tick;
+			if (ev->kind == EVENT_REGISTER)
+				POKEYSND_Update_ptr(ev->addr, ev->val, ev->chip, ev->gain);
+#ifdef CONSOLE_SOUND
+			else
+				POKEYSND_UpdateConsol_ptr(1, ev->val);
+#endif
+		}
+		if (!worker.quiet)
+			POKEYSND_GenerateSync(worker.end_tick - tick);
+
+		pthread_mutex_lock(&worker.lock);
+		worker.busy = FALSE;
+		pthread_cond_broadcast(&worker.cond);
+	}
+	pthread_mutex_unlock(&worker.lock);
+	return arg;
+}
+
+/* Waits until the worker has replayed the last log. */
+static void wait_worker(void)
+{
+	pthread_mutex_lock(&worker.lock);
+	while (worker.busy)
+		pthread_cond_wait(&worker.cond, &worker.lock);
+	pthread_mutex_unlock(&worker.lock);
+}
+
+/* Hands the log of the frame so far to the idle worker. */
+static void start_replay(void)
+{
+	worker.logging = !worker.logging;
+	worker.log_len[worker.logging] = 0;
+	worker.end_tick = ANTIC_CPU_CLOCK - prev_update_tick;
+	worker.quiet = POKEYSND_quiet;
+	prev_update_tick = ANTIC_CPU_CLOCK;
+	POKEYSND_process_buffer_fill = 0;
+	pthread_mutex_lock(&worker.lock);
+	worker.busy = TRUE;
+	pthread_cond_signal(&worker.cond);
+	pthread_mutex_unlock(&worker.lock);
+}
+
+static void start_worker(void)
+{
+	/* Catch up with the writes so far, the worker starts afresh */
 	Update_synchronized_sound();
-	sndn = POKEYSND_process_buffer_fill / ((POKEYSND_snd_flags & POKEYSND_BIT16) ? 2 : 1);
+	worker.buffer = (UBYTE *)Util_malloc(POKEYSND_process_buffer_length);
+	memcpy(worker.buffer, POKEYSND_process_buffer, POKEYSND_process_buffer_fill);
+	POKEYSND_synth_buffer = worker.buffer;
+	worker.log_len[0] = worker.log_len[1] = 0;
+	worker.busy = worker.quit = FALSE;
+	if (pthread_create(&worker.thread, NULL, worker_main, NULL) != 0) {
+		POKEYSND_synth_buffer = POKEYSND_process_buffer;
+		free(worker.buffer);
+		worker.buffer = NULL;
+		POKEYSND_threaded = FALSE;
+		return;
+	}
+	worker.running = TRUE;
+}
+
+/* Drops the writes not replayed yet and ends the thread. */
+static void stop_worker(void)
+{
+	if (!worker.running)
+		return;
+	pthread_mutex_lock(&worker.lock);
+	worker.quit = TRUE;
+	pthread_cond_signal(&worker.cond);
+	pthread_mutex_unlock(&worker.lock);
+	pthread_join(worker.thread, NULL);
+	worker.running = FALSE;
+	POKEYSND_synth_buffer = POKEYSND_process_buffer;
 	POKEYSND_process_buffer_fill = 0;
+	free(worker.buffer);
+	worker.buffer = NULL;
+	prev_update_tick = ANTIC_CPU_CLOCK;
+}
+
+static void log_event(UWORD addr, UBYTE val, UBYTE chip, UBYTE gain, UBYTE kind)
+{
+	int n = worker.log_len[worker.logging];
+	sound_event_t *ev;
+	if (n >= EVENTS_MAX) {
+		wait_worker();
+		start_replay();
+		n = 0;
+	}
+	if (n >= worker.log_alloc[worker.logging]) {
+		worker.log_alloc[worker.logging] = n + 256;
+		worker.log[worker.logging] = (sound_event_t *)Util_realloc(worker.log[worker.logging],
+			worker.log_alloc[worker.logging] * sizeof(sound_event_t));
+	}
+	ev = worker.log[worker.logging] + n;
+	ev->tick = ANTIC_CPU_CLOCK - prev_update_tick;
+	ev->addr = addr;
+	ev->val = val;
+	ev->chip = chip;
+	ev->gain = gain;
+	ev->kind = kind;
+	worker.log_len[worker.logging] = n + 1;
+}
+#endif /* SOUND_THREAD */
+
+int POKEYSND_UpdateProcessBuffer(void)
+{
+	int sndn;
+#ifdef SOUND_THREAD
+	if (POKEYSND_threaded != worker.running) {
+		if (worker.running)
+			stop_worker();
+		else
+			start_worker();
+	}
+	if (worker.running) {
+		/* Take the samples of the previous frame, replay this one */
+		wait_worker();
+		sndn = POKEYSND_process_buffer_fill;
+		memcpy(POKEYSND_process_buffer, worker.buffer, sndn);
+		start_replay();
+	}
+	else
+#endif /* SOUND_THREAD */
+	{
+		Update_synchronized_sound();
+		sndn = POKEYSND_process_buffer_fill;
+		POKEYSND_process_buffer_fill = 0;
+	}
+	sndn /= (POKEYSND_snd_flags & POKEYSND_BIT16) ? 2 : 1;
 
 #if defined(PBI_XLD) || defined (VOICEBOX)
 	VOTRAXSND_Process(POKEYSND_process_buffer, sndn);
@@ -364,6 +575,12 @@ static int pokeysnd_init_rf(ULONG freq17, int playback_freq,
 		Div_n_cnt[chan] = 0;
 		Div_n_max[chan] = 0x7fffffffL;
 		pokeysnd_AUDV[chan] = 0;
+		rf_AUDF[chan] = POKEY_AUDF[chan];
+		rf_AUDC[chan] = POKEY_AUDC[chan];
+	}
+	for (chan = 0; chan < POKEY_MAXPOKEYS; chan++) {
+		rf_AUDCTL[chan] = POKEY_AUDCTL[chan];
+		rf_Base_mult[chan] = POKEY_Base_mult[chan];
 	}
 
 	/* set the number of pokey chips currently emulated */
@@ -393,8 +610,25 @@ static int pokeysnd_init_rf(ULONG freq17, int playback_freq,
 /*                                                                           */
 /*****************************************************************************/
 
+static int speculative = FALSE;
+
+void POKEYSND_SetSpeculative(int value)
+{
+	if (speculative && !value)
+		prev_update_tick = ANTIC_CPU_CLOCK;
+	speculative = value;
+}
+
 void POKEYSND_Update(UWORD addr, UBYTE val, UBYTE chip, UBYTE gain)
 {
+	if (speculative)
+		return;
+#ifdef SOUND_THREAD
+	if (worker.running) {
+		log_event(addr, val, chip, gain, EVENT_REGISTER);
+		return;
+	}
+#endif
     Update_synchronized_sound();
 	POKEYSND_Update_ptr(addr, val, chip, gain);
 }
@@ -413,47 +647,48 @@ static void Update_pokey_sound_rf(UWORD addr, UBYTE val, UBYTE chip,
 	/* determine which address was changed */
 	switch (addr & 0x0f) {
 	case POKEY_OFFSET_AUDF1:
-		/* POKEY_AUDF[POKEY_CHAN1 + chip_offs] = val; */
+		rf_AUDF[POKEY_CHAN1 + chip_offs] = val;
 		chan_mask = 1 << POKEY_CHAN1;
-		if (POKEY_AUDCTL[chip] & POKEY_CH1_CH2)		/* if ch 1&2 tied together */
+		if (rf_AUDCTL[chip] & POKEY_CH1_CH2)		/* if ch 1&2 tied together */
 			chan_mask |= 1 << POKEY_CHAN2;	/* then also change on ch2 */
 		break;
 	case POKEY_OFFSET_AUDC1:
-		/* POKEY_AUDC[POKEY_CHAN1 + chip_offs] = val; */
+		rf_AUDC[POKEY_CHAN1 + chip_offs] = val;
 		pokeysnd_AUDV[POKEY_CHAN1 + chip_offs] = (val & POKEY_VOLUME_MASK) * gain;
 		chan_mask = 1 << POKEY_CHAN1;
 		break;
 	case POKEY_OFFSET_AUDF2:
-		/* POKEY_AUDF[POKEY_CHAN2 + chip_offs] = val; */
+		rf_AUDF[POKEY_CHAN2 + chip_offs] = val;
 		chan_mask = 1 << POKEY_CHAN2;
 		break;
 	case POKEY_OFFSET_AUDC2:
-		/* POKEY_AUDC[POKEY_CHAN2 + chip_offs] = val; */
+		rf_AUDC[POKEY_CHAN2 + chip_offs] = val;
 		pokeysnd_AUDV[POKEY_CHAN2 + chip_offs] = (val & POKEY_VOLUME_MASK) * gain;
 		chan_mask = 1 << POKEY_CHAN2;
 		break;
 	case POKEY_OFFSET_AUDF3:
-		/* POKEY_AUDF[POKEY_CHAN3 + chip_offs] = val; */
+		rf_AUDF[POKEY_CHAN3 + chip_offs] = val;
 		chan_mask = 1 << POKEY_CHAN3;
-		if (POKEY_AUDCTL[chip] & POKEY_CH3_CH4)		/* if ch 3&4 tied together */
+		if (rf_AUDCTL[chip] & POKEY_CH3_CH4)		/* if ch 3&4 tied together */
 			chan_mask |= 1 << POKEY_CHAN4;	/* then also change on ch4 */
 		break;
 	case POKEY_OFFSET_AUDC3:
-		/* POKEY_AUDC[POKEY_CHAN3 + chip_offs] = val; */
+		rf_AUDC[POKEY_CHAN3 + chip_offs] = val;
 		pokeysnd_AUDV[POKEY_CHAN3 + chip_offs] = (val & POKEY_VOLUME_MASK) * gain;
 		chan_mask = 1 << POKEY_CHAN3;
 		break;
 	case POKEY_OFFSET_AUDF4:
-		/* POKEY_AUDF[POKEY_CHAN4 + chip_offs] = val; */
+		rf_AUDF[POKEY_CHAN4 + chip_offs] = val;
 		chan_mask = 1 << POKEY_CHAN4;
 		break;
 	case POKEY_OFFSET_AUDC4:
-		/* POKEY_AUDC[POKEY_CHAN4 + chip_offs] = val; */
+		rf_AUDC[POKEY_CHAN4 + chip_offs] = val;
 		pokeysnd_AUDV[POKEY_CHAN4 + chip_offs] = (val & POKEY_VOLUME_MASK) * gain;
 		chan_mask = 1 << POKEY_CHAN4;
 		break;
 	case POKEY_OFFSET_AUDCTL:
-		/* POKEY_AUDCTL[chip] = val; */
+		rf_AUDCTL[chip] = val;
+		rf_Base_mult[chip] = (val & POKEY_CLOCK_15) ? POKEY_DIV_15 : POKEY_DIV_64;
 		chan_mask = 15;			/* all channels */
 		break;
 	default:
@@ -466,17 +701,17 @@ static void Update_pokey_sound_rf(UWORD addr, UBYTE val, UBYTE chip,
 	/* different depending on the frequency and resolution:     */
 	/*    64 kHz or 15 kHz - AUDF + 1                           */
 	/*    1 MHz, 8-bit -     AUDF + 4                           */
-	/*    1 MHz, 16-bit -    POKEY_AUDF[POKEY_CHAN1]+256*POKEY_AUDF[POKEY_CHAN2] + 7    */
+	/*    1 MHz, 16-bit -    rf_AUDF[POKEY_CHAN1]+256*rf_AUDF[POKEY_CHAN2] + 7    */
 	/************************************************************/
 
 	/* only reset the channels that have changed */
 
 	if (chan_mask & (1 << POKEY_CHAN1)) {
 		/* process channel 1 frequency */
-		if (POKEY_AUDCTL[chip] & POKEY_CH1_179)
-			new_val = POKEY_AUDF[POKEY_CHAN1 + chip_offs] + 4;
+		if (rf_AUDCTL[chip] & POKEY_CH1_179)
+			new_val = rf_AUDF[POKEY_CHAN1 + chip_offs] + 4;
 		else
-			new_val = (POKEY_AUDF[POKEY_CHAN1 + chip_offs] + 1) * POKEY_Base_mult[chip];
+			new_val = (rf_AUDF[POKEY_CHAN1 + chip_offs] + 1) * rf_Base_mult[chip];
 
 		if (new_val != Div_n_max[POKEY_CHAN1 + chip_offs]) {
 			Div_n_max[POKEY_CHAN1 + chip_offs] = new_val;
@@ -489,16 +724,16 @@ static void Update_pokey_sound_rf(UWORD addr, UBYTE val, UBYTE chip,
 
 	if (chan_mask & (1 << POKEY_CHAN2)) {
 		/* process channel 2 frequency */
-		if (POKEY_AUDCTL[chip] & POKEY_CH1_CH2) {
-			if (POKEY_AUDCTL[chip] & POKEY_CH1_179)
-				new_val = POKEY_AUDF[POKEY_CHAN2 + chip_offs] * 256 +
-					POKEY_AUDF[POKEY_CHAN1 + chip_offs] + 7;
+		if (rf_AUDCTL[chip] & POKEY_CH1_CH2) {
+			if (rf_AUDCTL[chip] & POKEY_CH1_179)
+				new_val = rf_AUDF[POKEY_CHAN2 + chip_offs] * 256 +
+					rf_AUDF[POKEY_CHAN1 + chip_offs] + 7;
 			else
-				new_val = (POKEY_AUDF[POKEY_CHAN2 + chip_offs] * 256 +
-						   POKEY_AUDF[POKEY_CHAN1 + chip_offs] + 1) * POKEY_Base_mult[chip];
+				new_val = (rf_AUDF[POKEY_CHAN2 + chip_offs] * 256 +
+						   rf_AUDF[POKEY_CHAN1 + chip_offs] + 1) * rf_Base_mult[chip];
 		}
 		else
-			new_val = (POKEY_AUDF[POKEY_CHAN2 + chip_offs] + 1) * POKEY_Base_mult[chip];
+			new_val = (rf_AUDF[POKEY_CHAN2 + chip_offs] + 1) * rf_Base_mult[chip];
 
 		if (new_val != Div_n_max[POKEY_CHAN2 + chip_offs]) {
 			Div_n_max[POKEY_CHAN2 + chip_offs] = new_val;
@@ -511,10 +746,10 @@ static void Update_pokey_sound_rf(UWORD addr, UBYTE val, UBYTE chip,
 
 	if (chan_mask & (1 << POKEY_CHAN3)) {
 		/* process channel 3 frequency */
-		if (POKEY_AUDCTL[chip] & POKEY_CH3_179)
-			new_val = POKEY_AUDF[POKEY_CHAN3 + chip_offs] + 4;
+		if (rf_AUDCTL[chip] & POKEY_CH3_179)
+			new_val = rf_AUDF[POKEY_CHAN3 + chip_offs] + 4;
 		else
-			new_val = (POKEY_AUDF[POKEY_CHAN3 + chip_offs] + 1) * POKEY_Base_mult[chip];
+			new_val = (rf_AUDF[POKEY_CHAN3 + chip_offs] + 1) * rf_Base_mult[chip];
 
 		if (new_val != Div_n_max[POKEY_CHAN3 + chip_offs]) {
 			Div_n_max[POKEY_CHAN3 + chip_offs] = new_val;
@@ -527,16 +762,16 @@ static void Update_pokey_sound_rf(UWORD addr, UBYTE val, UBYTE chip,
 
 	if (chan_mask & (1 << POKEY_CHAN4)) {
 		/* process channel 4 frequency */
-		if (POKEY_AUDCTL[chip] & POKEY_CH3_CH4) {
-			if (POKEY_AUDCTL[chip] & POKEY_CH3_179)
-				new_val = POKEY_AUDF[POKEY_CHAN4 + chip_offs] * 256 +
-					POKEY_AUDF[POKEY_CHAN3 + chip_offs] + 7;
+		if (rf_AUDCTL[chip] & POKEY_CH3_CH4) {
+			if (rf_AUDCTL[chip] & POKEY_CH3_179)
+				new_val = rf_AUDF[POKEY_CHAN4 + chip_offs] * 256 +
+					rf_AUDF[POKEY_CHAN3 + chip_offs] + 7;
 			else
-				new_val = (POKEY_AUDF[POKEY_CHAN4 + chip_offs] * 256 +
-						   POKEY_AUDF[POKEY_CHAN3 + chip_offs] + 1) * POKEY_Base_mult[chip];
+				new_val = (rf_AUDF[POKEY_CHAN4 + chip_offs] * 256 +
+						   rf_AUDF[POKEY_CHAN3 + chip_offs] + 1) * rf_Base_mult[chip];
 		}
 		else
-			new_val = (POKEY_AUDF[POKEY_CHAN4 + chip_offs] + 1) * POKEY_Base_mult[chip];
+			new_val = (rf_AUDF[POKEY_CHAN4 + chip_offs] + 1) * rf_Base_mult[chip];
 
 		if (new_val != Div_n_max[POKEY_CHAN4 + chip_offs]) {
 			Div_n_max[POKEY_CHAN4 + chip_offs] = new_val;
@@ -558,16 +793,16 @@ static void Update_pokey_sound_rf(UWORD addr, UBYTE val, UBYTE chip,
 			/* if the channel is volume only */
 			/* or the channel is off (volume == 0) */
 			/* or the channel freq is greater than the playback freq */
-			if ( (POKEY_AUDC[chan + chip_offs] & POKEY_VOL_ONLY) ||
-				((POKEY_AUDC[chan + chip_offs] & POKEY_VOLUME_MASK) == 0)
+			if ( (rf_AUDC[chan + chip_offs] & POKEY_VOL_ONLY) ||
+				((rf_AUDC[chan + chip_offs] & POKEY_VOLUME_MASK) == 0)
 				|| (!BIENIAS_FIX && (Div_n_max[chan + chip_offs] < (Samp_n_max >> 8)))
 				) {
 				/* indicate the channel is 'on' */
 				Outvol[chan + chip_offs] = 1;
 
 				/* can only ignore channel if filtering off */
-				if ((chan == POKEY_CHAN3 && !(POKEY_AUDCTL[chip] & POKEY_CH1_FILTER)) ||
-					(chan == POKEY_CHAN4 && !(POKEY_AUDCTL[chip] & POKEY_CH2_FILTER)) ||
+				if ((chan == POKEY_CHAN3 && !(rf_AUDCTL[chip] & POKEY_CH1_FILTER)) ||
+					(chan == POKEY_CHAN4 && !(rf_AUDCTL[chip] & POKEY_CH2_FILTER)) ||
 					(chan == POKEY_CHAN1) ||
 					(chan == POKEY_CHAN2)
 					|| (!BIENIAS_FIX && (Div_n_max[chan + chip_offs] < (Samp_n_max >> 8)))
@@ -779,7 +1014,7 @@ static void pokeysnd_process_8(void *sndbuffer, int sndn)
 			Div_n_cnt[next_event] += Div_n_max[next_event];
 
 			/* get the current AUDC into a register (for optimization) */
-			audc = POKEY_AUDC[next_event];
+			audc = rf_AUDC[next_event];
 
 			/* set a pointer to the current output (for opt...) */
 			out_ptr = &Outvol[next_event];
@@ -808,7 +1043,7 @@ static void pokeysnd_process_8(void *sndbuffer, int sndn)
 					}
 					else {
 						/* if 9-bit poly is selected on this chip */
-						if (POKEY_AUDCTL[next_event >> 2] & POKEY_POLY9) {
+						if (rf_AUDCTL[next_event >> 2] & POKEY_POLY9) {
 							/* compare to the poly9 bit */
 							toggle = ((POKEY_poly9_lookup[P9] & 1) == !(*out_ptr));
 						}
@@ -821,7 +1056,7 @@ static void pokeysnd_process_8(void *sndbuffer, int sndn)
 			}
 
 			/* check channel 1 filter (clocked by channel 3) */
-			if ( POKEY_AUDCTL[next_event >> 2] & POKEY_CH1_FILTER) {
+			if ( rf_AUDCTL[next_event >> 2] & POKEY_CH1_FILTER) {
 				/* if we're processing channel 3 */
 				if ((next_event & 0x03) == POKEY_CHAN3) {
 					/* check output of channel 1 on same chip */
@@ -843,7 +1078,7 @@ static void pokeysnd_process_8(void *sndbuffer, int sndn)
 			}
 
 			/* check channel 2 filter (clocked by channel 4) */
-			if ( POKEY_AUDCTL[next_event >> 2] & POKEY_CH2_FILTER) {
+			if ( rf_AUDCTL[next_event >> 2] & POKEY_CH2_FILTER) {
 				/* if we're processing channel 4 */
 				if ((next_event & 0x03) == POKEY_CHAN4) {
 					/* check output of channel 2 on same chip */
@@ -1060,8 +1295,8 @@ static void Generate_sync_rf(unsigned int num_ticks)
 {
 	double new_samp_pos;
 	unsigned int ticks;
-	UBYTE *buffer = POKEYSND_process_buffer + POKEYSND_process_buffer_fill;
-	UBYTE *buffer_end = POKEYSND_process_buffer + POKEYSND_process_buffer_length;
+	UBYTE *buffer = POKEYSND_synth_buffer + POKEYSND_process_buffer_fill;
+	UBYTE *buffer_end = POKEYSND_synth_buffer + POKEYSND_process_buffer_length;
 
 	for (;;) {
 		double int_part;
@@ -1089,23 +1324,30 @@ static void Generate_sync_rf(unsigned int num_ticks)
 
 	}
 
-	POKEYSND_process_buffer_fill = buffer - POKEYSND_process_buffer;
+	POKEYSND_process_buffer_fill = buffer - POKEYSND_synth_buffer;
 }
 
 #ifdef CONSOLE_SOUND
 void POKEYSND_UpdateConsol(int set)
 {
-	if (!POKEYSND_console_sound_enabled)
+	if (!POKEYSND_console_sound_enabled || speculative)
+		return;
+#ifdef SOUND_THREAD
+	if (worker.running) {
+		if (set)
+			log_event(0, (UBYTE)GTIA_speaker, 0, 0, EVENT_CONSOL);
 		return;
+	}
+#endif
 	if (set)
 		Update_synchronized_sound();
-	POKEYSND_UpdateConsol_ptr(set);
+	POKEYSND_UpdateConsol_ptr(set, GTIA_speaker);
 }
 
-static void Update_consol_sound_rf(int set)
+static void Update_consol_sound_rf(int set, int gtia_speaker)
 {
 	if (set)
-		speaker = CONSOLE_VOL * GTIA_speaker;
+		speaker = CONSOLE_VOL * gtia_speaker;
 }
 #endif /* CONSOLE_SOUND */
 
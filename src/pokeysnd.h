@@ -91,7 +91,7 @@ extern int POKEYSND_bienias_fix;
 
 extern void (*POKEYSND_Process_ptr)(void *sndbuffer, int sndn);
 extern void (*POKEYSND_Update_ptr)(UWORD addr, UBYTE val, UBYTE chip, UBYTE gain);
-extern void (*POKEYSND_UpdateConsol_ptr)(int set);
+extern void (*POKEYSND_UpdateConsol_ptr)(int set, int gtia_speaker);
 
 int POKEYSND_Init(ULONG freq17, int playback_freq, UBYTE num_pokeys,
                      int flags
@@ -111,10 +111,28 @@ void POKEYSND_SetMzQuality(int quality);
 void POKEYSND_SetVolume(int vol);
 
 extern UBYTE *POKEYSND_process_buffer;
+/* Where POKEYSND_GenerateSync writes: POKEYSND_process_buffer, or the sound
+   worker's own buffer while POKEYSND_threaded is in effect */
+extern UBYTE *POKEYSND_synth_buffer;
 extern unsigned int POKEYSND_process_buffer_length;
 extern unsigned int POKEYSND_process_buffer_fill;
 extern void (*POKEYSND_GenerateSync)(unsigned int num_ticks);
+/* When TRUE, register writes still reach the sound engine but no samples
+   are generated for the elapsed CPU cycles, so POKEYSND_UpdateProcessBuffer
+   returns none. Set by Sound_Update when nothing would use the samples. */
+extern int POKEYSND_quiet;
 int POKEYSND_UpdateProcessBuffer(void);
+/* When TRUE (and threads are available), POKEYSND_Update only logs the
+   register writes, and a worker thread synthesises each frame's samples
+   from the log while the next frame is emulated. POKEYSND_UpdateProcessBuffer
+   then returns the samples of the frame before, one frame late. Takes
+   effect at the next POKEYSND_UpdateProcessBuffer call. */
+extern int POKEYSND_threaded;
+/* While TRUE, register writes do not reach the sound engine and no samples
+   are generated, so frames emulated and then taken back (see
+   Atari800_run_ahead) are not heard. Going back to FALSE, the engine goes
+   on from the current CPU clock. */
+void POKEYSND_SetSpeculative(int speculative);
 
 #ifdef __cplusplus
 }
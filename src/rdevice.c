@@ -168,6 +168,16 @@ extern void dc_set_baud(int baud);
 #include <netdb.h>
 #include <arpa/inet.h>
 #include <sys/time.h>
+#ifdef HAVE_PTHREAD_CREATE
+#define NET_THREAD  /* a thread serves the sockets, see below */
+#include <pthread.h>
+#ifdef __linux__
+#define NET_EPOLL
+#include <sys/epoll.h>
+#else
+#include <poll.h>
+#endif
+#endif /* HAVE_PTHREAD_CREATE */
 #endif /* R_NETWORK */
 #include <sys/types.h>
 #include <fcntl.h>
@@ -197,13 +207,15 @@ static int do_once;
 static int rdev_fd;
 
 #ifdef R_NETWORK
+#ifndef NET_THREAD
 static struct sockaddr_in in;
 static struct sockaddr_in peer_in;
 static int sock;
+static int retval;
+#endif /* NET_THREAD */
 static int portnum = 9000;
 static char inetaddress[256];
 static char CONNECT_STRING[40] = "\r\n_CONNECT 2400\r\n";
-static int retval;
 #endif /* R_NETWORK */
 
 static char MESSAGE[256];
@@ -232,7 +244,9 @@ char RDevice_serial_device[FILENAME_MAX];
 static void catch_disconnect(int sig)
 {
   DBG_APRINT("R*: Disconnected....");
+#ifndef NET_THREAD  /* the network thread has closed it already */
   close(rdev_fd);
+#endif
   connected = 0;
   do_once = 0;
   bufout[0] = 0;
@@ -245,6 +259,677 @@ static void catch_disconnect(int sig)
 }
 #endif /* R_NETWORK */
 
+#ifdef NET_THREAD
+/*---------------------------------------------------------------------------
+   Host Support Functions - Network Thread
+
+   A thread owns the sockets and moves bytes between them and two ring
+   buffers, so the CIO vectors only touch memory and never wait for the
+   network: a peer that stops reading fills the output ring (and writes
+   fail with error 135 as before) instead of stalling the emulation. The
+   thread also resolves host names and answers telnet option negotiation,
+   and sends with MSG_NOSIGNAL, so a dropped connection is seen as a
+   hangup rather than through SIGPIPE.
+---------------------------------------------------------------------------*/
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+#define NET_RING_SIZE 4096  /* a power of two */
+
+typedef struct {
+  unsigned char data[NET_RING_SIZE];
+  unsigned int head;  /* bytes ever put */
+  unsigned int tail;  /* bytes ever taken */
+} net_ring;
+
+/* Shared with the thread, guarded by net_lock */
+static struct {
+  int open;           /* a connection is up or being made */
+  int accepted;       /* a connection came in, not yet reported */
+  int hangup;         /* the connection went away, not yet reported */
+  char peer_name[256];
+  int req_connect;    /* requests, handled by the thread in turn */
+  int req_close;
+  int req_listen;     /* port to listen on */
+  int req_stop;
+  char host[256];
+  int port;
+  unsigned int tx_mark;  /* output before a request, which it drops */
+  net_ring rx, tx;
+} net;
+static pthread_mutex_t net_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_t net_thread;
+static int net_running = FALSE;
+static int net_wake_pipe[2];
+
+/* Owned by the thread */
+static int net_listen_fd = -1;
+static int net_fd = -1;
+static int net_connecting;
+static int telnet_state;
+static unsigned char telnet_verb;
+
+enum { TELNET_DATA, TELNET_IAC, TELNET_OPTION, TELNET_SUB };
+
+/* What the thread waits for, on each of its descriptors */
+#define NET_WAKE   0
+#define NET_LISTEN 1
+#define NET_CONN   2
+#define NET_IN     1
+#define NET_OUT    2
+
+static int watch_fd[3] = { -1, -1, -1 };
+static int watch_ev[3];
+#ifdef NET_EPOLL
+static int net_epoll_fd = -1;
+#endif
+
+static unsigned int ring_used(const net_ring *r)
+{
+  return r->head - r->tail;
+}
+
+static int ring_put(net_ring *r, const unsigned char *buf, int len)
+{
+  int i;
+
+  if(len > (int)(NET_RING_SIZE - ring_used(r)))
+    len = NET_RING_SIZE - ring_used(r);
+  for(i = 0; i < len; i++)
+    r->data[(r->head + i) & (NET_RING_SIZE - 1)] = buf[i];
+  r->head += len;
+  return len;
+}
+
+/* Copies out up to len bytes, leaving them in the ring */
+static int ring_peek(const net_ring *r, unsigned char *buf, int len)
+{
+  int i;
+
+  if(len > (int)ring_used(r))
+    len = ring_used(r);
+  for(i = 0; i < len; i++)
+    buf[i] = r->data[(r->tail + i) & (NET_RING_SIZE - 1)];
+  return len;
+}
+
+/* Watches fd for ev, none if fd is -1 or ev is 0. A watched descriptor is
+   given up here before it is closed, as its number may come back. */
+static void net_watch(int slot, int fd, int ev)
+{
+#ifdef NET_EPOLL
+  struct epoll_event e;
+
+  if(fd == watch_fd[slot] && ev == watch_ev[slot])
+    return;
+  memset(&e, 0, sizeof(e));
+  e.events = ((ev & NET_IN) ? EPOLLIN : 0) | ((ev & NET_OUT) ? EPOLLOUT : 0);
+  e.data.u32 = slot;
+  if(watch_fd[slot] >= 0 && watch_ev[slot] != 0)
+  {
+    if(fd == watch_fd[slot] && ev != 0)
+    {
+      epoll_ctl(net_epoll_fd, EPOLL_CTL_MOD, fd, &e);
+      watch_ev[slot] = ev;
+      return;
+    }
+    epoll_ctl(net_epoll_fd, EPOLL_CTL_DEL, watch_fd[slot], &e);
+  }
+  if(fd >= 0 && ev != 0)
+    epoll_ctl(net_epoll_fd, EPOLL_CTL_ADD, fd, &e);
+#endif /* NET_EPOLL */
+  watch_fd[slot] = fd;
+  watch_ev[slot] = ev;
+}
+
+/* Waits until a watched descriptor is ready, and tells for each how */
+static void net_wait(int ready[3])
+{
+#ifdef NET_EPOLL
+  struct epoll_event e[3];
+  int i, n;
+
+  ready[0] = ready[1] = ready[2] = 0;
+  n = epoll_wait(net_epoll_fd, e, 3, -1);
+  for(i = 0; i < n; i++)
+  {
+    /* Errors and hangups show up when the descriptor is used */
+    if(e[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR))
+      ready[e[i].data.u32] |= NET_IN;
+    if(e[i].events & (EPOLLOUT | EPOLLERR))
+      ready[e[i].data.u32] |= NET_OUT;
+  }
+#else
+  struct pollfd p[3];
+  int slot[3];
+  int i, n = 0;
+
+  ready[0] = ready[1] = ready[2] = 0;
+  for(i = 0; i < 3; i++)
+  {
+    if(watch_fd[i] < 0 || watch_ev[i] == 0)
+      continue;
+    p[n].fd = watch_fd[i];
+    p[n].events = ((watch_ev[i] & NET_IN) ? POLLIN : 0) | ((watch_ev[i] & NET_OUT) ? POLLOUT : 0);
+    p[n].revents = 0;
+    slot[n++] = i;
+  }
+  if(poll(p, n, -1) <= 0)
+    return;
+  for(i = 0; i < n; i++)
+  {
+    if(p[i].revents & (POLLIN | POLLHUP | POLLERR))
+      ready[slot[i]] |= NET_IN;
+    if(p[i].revents & (POLLOUT | POLLERR))
+      ready[slot[i]] |= NET_OUT;
+  }
+#endif /* NET_EPOLL */
+}
+
+static void net_nonblock(int fd)
+{
+  fcntl(fd, F_SETFL, O_NONBLOCK);
+#ifdef SO_NOSIGPIPE
+  {
+    int on = 1;
+    setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, (void *) &on, sizeof(on));
+  }
+#endif
+}
+
+static void net_drop(int slot, int *fd)
+{
+  if(*fd >= 0)
+  {
+    net_watch(slot, -1, 0);
+    close(*fd);
+    *fd = -1;
+  }
+}
+
+/* The connection went away: tell the emulation, unless it has asked for
+   another one meanwhile */
+static void net_lost(void)
+{
+  net_drop(NET_CONN, &net_fd);
+  pthread_mutex_lock(&net_lock);
+  if(net.open && !net.req_connect)
+  {
+    net.open = FALSE;
+    net.hangup = TRUE;
+  }
+  pthread_mutex_unlock(&net_lock);
+}
+
+static void net_do_connect(const char *host, int port)
+{
+  struct sockaddr_in peer;
+  struct hostent *h;
+
+  memset(&peer, 0, sizeof(peer));
+  peer.sin_family = AF_INET;
+  peer.sin_port = htons(port);
+  if(inet_pton(AF_INET, host, &peer.sin_addr) <= 0)
+  {
+    h = gethostbyname(host);
+    if(h == NULL)
+    {
+      Log_print("R*: cannot find host %s", host);
+      net_lost();
+      return;
+    }
+    memcpy(&peer.sin_addr, h->h_addr_list[0], h->h_length);
+  }
+  net_fd = socket(AF_INET, SOCK_STREAM, 0);
+  if(net_fd < 0)
+  {
+    net_lost();
+    return;
+  }
+  net_nonblock(net_fd);
+  net_connecting = FALSE;
+  telnet_state = TELNET_DATA;
+  if(connect(net_fd, (struct sockaddr *)&peer, sizeof(peer)) < 0)
+  {
+    if(errno != EINPROGRESS)
+    {
+      net_lost();
+      return;
+    }
+    net_connecting = TRUE;
+  }
+}
+
+static void net_do_listen(int port)
+{
+  struct sockaddr_in in;
+  int on = 1;
+
+  net_listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+  if(net_listen_fd < 0)
+  {
+    Log_print("R*: socket: %s", strerror(errno));
+    return;
+  }
+  memset(&in, 0, sizeof(in));
+  in.sin_family = AF_INET;
+  in.sin_addr.s_addr = INADDR_ANY;
+  in.sin_port = htons(port);
+  setsockopt(net_listen_fd, SOL_SOCKET, SO_REUSEADDR, (void *) &on, sizeof(on));
+  if(bind(net_listen_fd, (struct sockaddr *)&in, sizeof(in)) < 0
+     || listen(net_listen_fd, 5) < 0)
+  {
+    Log_print("R*: cannot listen on port %d: %s", port, strerror(errno));
+    close(net_listen_fd);
+    net_listen_fd = -1;
+    return;
+  }
+  net_nonblock(net_listen_fd);
+}
+
+/* Takes one connection, and stops listening */
+static void net_do_accept(void)
+{
+  struct sockaddr_in peer;
+  socklen_t len = sizeof(peer);
+  struct hostent *host;
+  int fd;
+
+  fd = accept(net_listen_fd, (struct sockaddr *)&peer, &len);
+  if(fd < 0)
+    return;
+  net_drop(NET_LISTEN, &net_listen_fd);
+  net_nonblock(fd);
+  net_fd = fd;
+  net_connecting = FALSE;
+  telnet_state = TELNET_DATA;
+  host = gethostbyaddr((char *) &peer.sin_addr, sizeof peer.sin_addr, AF_INET);
+
+  pthread_mutex_lock(&net_lock);
+  Util_strlcpy(net.peer_name, host != NULL ? host->h_name : inet_ntoa(peer.sin_addr), sizeof(net.peer_name));
+  net.open = TRUE;
+  net.accepted = TRUE;
+  pthread_mutex_unlock(&net_lock);
+}
+
+/* Passes on a received byte, answering telnet commands. Called with
+   net_lock held. */
+static void telnet_byte(unsigned char c)
+{
+  unsigned char reply[3];
+
+  switch(telnet_state)
+  {
+    case TELNET_DATA:
+      if(c == 0xff)
+        telnet_state = TELNET_IAC;
+      else
+        ring_put(&net.rx, &c, 1);
+      break;
+    case TELNET_IAC:
+      telnet_state = TELNET_DATA;
+      if(c == 0xff)
+        ring_put(&net.rx, &c, 1);  /* escaped 0xff */
+      else if(c >= 0xfb)
+      { /* WILL, WONT, DO, DONT */
+        telnet_verb = c;
+        telnet_state = TELNET_OPTION;
+      }
+      else if(c == 0xfa)
+        telnet_state = TELNET_SUB;
+      break;
+    case TELNET_OPTION:
+      reply[0] = 0xff;
+      if(telnet_verb == 0xfd)
+      { /*DO*/
+        /* WILL ECHO and GO AHEAD (char mode) */
+        reply[1] = ((c == 0x01) || (c == 0x03)) ? 0xfb : 0xfc;
+      }
+      else if(telnet_verb == 0xfe)
+        reply[1] = 0xfc; /*DONT -> WONT*/
+      else
+        reply[1] = 0xfe; /*WILL or WONT -> DONT*/
+      reply[2] = c;
+      ring_put(&net.tx, reply, 3);
+      telnet_state = TELNET_DATA;
+      break;
+    case TELNET_SUB:
+      if(c == 0xf0)
+      { /* end of sub negotiation */
+        telnet_state = TELNET_DATA;
+      }
+      break;
+  }
+}
+
+static void net_receive(void)
+{
+  unsigned char buf[NET_RING_SIZE];
+  int room, n, i;
+
+  pthread_mutex_lock(&net_lock);
+  room = NET_RING_SIZE - ring_used(&net.rx);
+  pthread_mutex_unlock(&net_lock);
+  if(room == 0)
+    return;
+  n = recv(net_fd, buf, room, 0);
+  if(n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+    return;
+  if(n <= 0)
+  {
+    net_lost();
+    return;
+  }
+  pthread_mutex_lock(&net_lock);
+  /* Input for a connection that is being closed is dropped */
+  if(!net.req_connect && !net.req_close)
+    for(i = 0; i < n; i++)
+      telnet_byte(buf[i]);
+  pthread_mutex_unlock(&net_lock);
+}
+
+static void net_send(void)
+{
+  unsigned char buf[NET_RING_SIZE];
+  int n;
+
+  pthread_mutex_lock(&net_lock);
+  /* Output after a request is for the next connection */
+  n = (net.req_connect || net.req_close) ? 0 : ring_peek(&net.tx, buf, NET_RING_SIZE);
+  pthread_mutex_unlock(&net_lock);
+  if(n == 0)
+    return;
+  n = send(net_fd, buf, n, MSG_NOSIGNAL);
+  if(n < 0)
+  {
+    if(errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+      net_lost();
+    return;
+  }
+  pthread_mutex_lock(&net_lock);
+  net.tx.tail += n;
+  pthread_mutex_unlock(&net_lock);
+}
+
+static void *net_proc(void *arg)
+{
+  char host[256];
+  int ready[3];
+  int port, listen_port, do_close, do_connect, ev;
+  char drain[64];
+
+  for(;;)
+  {
+    pthread_mutex_lock(&net_lock);
+    if(net.req_stop)
+    {
+      pthread_mutex_unlock(&net_lock);
+      break;
+    }
+    do_close = net.req_close;
+    do_connect = net.req_connect;
+    if(do_close || do_connect)
+      net.tx.tail = net.tx_mark;
+    Util_strlcpy(host, net.host, sizeof(host));
+    port = net.port;
+    listen_port = net.req_listen;
+    net.req_close = net.req_connect = FALSE;
+    net.req_listen = 0;
+    pthread_mutex_unlock(&net_lock);
+
+    if(do_close || do_connect)
+      net_drop(NET_CONN, &net_fd);
+    if(do_connect)
+    {
+      net_drop(NET_LISTEN, &net_listen_fd);
+      net_do_connect(host, port);
+    }
+    if(listen_port > 0)
+    {
+      net_drop(NET_LISTEN, &net_listen_fd);
+      net_do_listen(listen_port);
+    }
+
+    net_watch(NET_LISTEN, net_listen_fd, NET_IN);
+    if(net_fd >= 0)
+    {
+      if(net_connecting)
+        ev = NET_OUT;
+      else
+      {
+        pthread_mutex_lock(&net_lock);
+        ev = (ring_used(&net.rx) < NET_RING_SIZE ? NET_IN : 0)
+             | (ring_used(&net.tx) > 0 ? NET_OUT : 0);
+        pthread_mutex_unlock(&net_lock);
+      }
+      net_watch(NET_CONN, net_fd, ev);
+    }
+
+    net_wait(ready);
+    if(ready[NET_WAKE])
+    {
+      while(read(net_wake_pipe[0], drain, sizeof(drain)) > 0) {};
+    }
+    if(ready[NET_LISTEN] && net_listen_fd >= 0)
+      net_do_accept();
+    if(ready[NET_CONN] && net_fd >= 0)
+    {
+      if(net_connecting)
+      {
+        int err = 0;
+        socklen_t len = sizeof(err);
+        if(getsockopt(net_fd, SOL_SOCKET, SO_ERROR, (void *) &err, &len) < 0 || err != 0)
+          net_lost();
+        else
+          net_connecting = FALSE;
+      }
+      else
+      {
+        if(ready[NET_CONN] & NET_IN)
+          net_receive();
+        if(net_fd >= 0 && (ready[NET_CONN] & NET_OUT))
+          net_send();
+      }
+    }
+  }
+  net_drop(NET_CONN, &net_fd);
+  net_drop(NET_LISTEN, &net_listen_fd);
+  return NULL;
+}
+
+static void net_wake(void)
+{
+  char c = 0;
+  if(write(net_wake_pipe[1], &c, 1) != 1)
+  {
+    /* the pipe is full, so the thread wakes anyway */
+  }
+}
+
+static int net_start(void)
+{
+  if(net_running)
+    return TRUE;
+  if(pipe(net_wake_pipe) < 0)
+  {
+    Log_print("R*: pipe: %s", strerror(errno));
+    return FALSE;
+  }
+  fcntl(net_wake_pipe[0], F_SETFL, O_NONBLOCK);
+  fcntl(net_wake_pipe[1], F_SETFL, O_NONBLOCK);
+#ifdef NET_EPOLL
+  net_epoll_fd = epoll_create(3);
+  if(net_epoll_fd < 0)
+  {
+    Log_print("R*: epoll_create: %s", strerror(errno));
+    close(net_wake_pipe[0]);
+    close(net_wake_pipe[1]);
+    return FALSE;
+  }
+#endif
+  net_watch(NET_WAKE, net_wake_pipe[0], NET_IN);
+  if(pthread_create(&net_thread, NULL, net_proc, NULL) != 0)
+  {
+    Log_print("R*: cannot start the network thread");
+    net_watch(NET_WAKE, -1, 0);
+#ifdef NET_EPOLL
+    close(net_epoll_fd);
+#endif
+    close(net_wake_pipe[0]);
+    close(net_wake_pipe[1]);
+    return FALSE;
+  }
+  net_running = TRUE;
+  return TRUE;
+}
+
+static void net_stop(void)
+{
+  if(!net_running)
+    return;
+  pthread_mutex_lock(&net_lock);
+  net.req_stop = TRUE;
+  pthread_mutex_unlock(&net_lock);
+  net_wake();
+  pthread_join(net_thread, NULL);
+  net_watch(NET_WAKE, -1, 0);
+#ifdef NET_EPOLL
+  close(net_epoll_fd);
+#endif
+  close(net_wake_pipe[0]);
+  close(net_wake_pipe[1]);
+  net_running = FALSE;
+  net.req_stop = FALSE;
+}
+
+/* Asks for a connection; unread input and unsent output are dropped */
+static void net_connect(const char *host, int port)
+{
+  int started = net_start();
+
+  pthread_mutex_lock(&net_lock);
+  Util_strlcpy(net.host, host, sizeof(net.host));
+  net.port = port;
+  net.req_connect = started;
+  net.req_close = FALSE;
+  net.tx_mark = net.tx.head;
+  net.rx.tail = net.rx.head;
+  net.open = started;
+  net.accepted = FALSE;
+  net.hangup = !started;
+  pthread_mutex_unlock(&net_lock);
+  if(started)
+    net_wake();
+}
+
+static void net_listen(int port)
+{
+  if(!net_start())
+    return;
+  pthread_mutex_lock(&net_lock);
+  net.req_listen = port;
+  pthread_mutex_unlock(&net_lock);
+  net_wake();
+}
+
+static void net_close(void)
+{
+  if(!net_running)
+    return;
+  pthread_mutex_lock(&net_lock);
+  net.req_close = TRUE;
+  net.req_connect = FALSE;
+  net.tx_mark = net.tx.head;
+  net.rx.tail = net.rx.head;
+  net.open = FALSE;
+  net.accepted = FALSE;
+  net.hangup = FALSE;
+  pthread_mutex_unlock(&net_lock);
+  net_wake();
+}
+
+/* Queues output; returns how much fitted, 0 with no connection */
+static int net_write(const unsigned char *buf, int len)
+{
+  int n = 0, was_empty;
+
+  pthread_mutex_lock(&net_lock);
+  was_empty = ring_used(&net.tx) == 0;
+  if(net.open)
+    n = ring_put(&net.tx, buf, len);
+  pthread_mutex_unlock(&net_lock);
+  if(n > 0 && was_empty)
+    net_wake();
+  return n;
+}
+
+static int net_read(unsigned char *c)
+{
+  int n, was_full;
+
+  pthread_mutex_lock(&net_lock);
+  was_full = ring_used(&net.rx) == NET_RING_SIZE;
+  n = ring_peek(&net.rx, c, 1);
+  net.rx.tail += n;
+  pthread_mutex_unlock(&net_lock);
+  if(was_full)
+    net_wake();
+  return n;
+}
+
+/* Tells once that a connection came in, and from where */
+static int net_accepted(char *name, int size)
+{
+  int r;
+
+  pthread_mutex_lock(&net_lock);
+  r = net.accepted;
+  if(r)
+    Util_strlcpy(name, net.peer_name, size);
+  net.accepted = FALSE;
+  pthread_mutex_unlock(&net_lock);
+  return r;
+}
+
+/* Tells once that the connection went away, after its input is read */
+static int net_hungup(void)
+{
+  int r;
+
+  pthread_mutex_lock(&net_lock);
+  r = net.hangup && ring_used(&net.rx) == 0;
+  if(r)
+    net.hangup = FALSE;
+  pthread_mutex_unlock(&net_lock);
+  return r;
+}
+#endif /* NET_THREAD */
+
+/*---------------------------------------------------------------------------
+   Host Support Function - Write to and read from the other end, the serial
+   port or the network thread
+---------------------------------------------------------------------------*/
+#ifndef DREAMCAST
+static int rdev_write(const void *buf, int len)
+{
+#ifdef NET_THREAD
+  if(RDevice_serial_enabled == 0)
+    return net_write((const unsigned char *)buf, len);
+#endif
+  return write(rdev_fd, (char *)buf, len);
+}
+
+static int rdev_read(unsigned char *c)
+{
+#ifdef NET_THREAD
+  if(RDevice_serial_enabled == 0)
+    return net_read(c);
+#endif
+  return read(rdev_fd, (char *)c, 1);
+}
+#endif /* DREAMCAST */
+
 /*---------------------------------------------------------------------------
    Host Support Function - XIO 34 - Called from RDevice_SPEC
    Controls handshake lines DTR, RTS, SD
@@ -731,7 +1416,9 @@ static void xio_40(void)
 #ifdef R_NETWORK
 static void open_connection(char * address, int port)
 {
+#ifndef NET_THREAD
   struct hostent *host;
+#endif
 #ifdef HAVE_WINDOWS_H
   static int winsock_started;
   WSADATA wdata;
@@ -747,6 +1434,13 @@ static void open_connection(char * address, int port)
 #endif /* HAVE_WINDOWS_H */
   if((address != NULL) && (strlen(address) > 0))
   {
+#ifdef NET_THREAD
+    do_once = 1;
+    connected = 1;
+    net_connect(address, port > 0 ? port : 23);
+    snprintf(MESSAGE, sizeof(MESSAGE), "R*: Connecting to %s", address);
+    DBG_APRINT(MESSAGE);
+#else
     close(rdev_fd);
     close(sock);
     do_once = 1;
@@ -804,10 +1498,11 @@ static void open_connection(char * address, int port)
 #else
     fcntl(rdev_fd, F_SETFL, O_NONBLOCK);
 #endif /* HAVE_WINDOWS_H */
+#endif /* NET_THREAD */
 
     /* Telnet negotiation */
     snprintf(MESSAGE, sizeof(MESSAGE), "%c%c%c%c%c%c%c%c%c", 0xff, 0xfb, 0x01, 0xff, 0xfb, 0x03, 0xff, 0xfd, 0x0f3);
-    if(write(rdev_fd, MESSAGE, 9) != 9)
+    if(rdev_write(MESSAGE, 9) != 9)
     {
       DBG_APRINT("R*: warning, 'write' did not write all bytes");
     }
@@ -994,6 +1689,11 @@ void RDevice_CLOS(void)
   CPU_ClrN;
   concurrent = 0;
   bufend = 0;
+#ifdef NET_THREAD
+  if(RDevice_serial_enabled == 0)
+    net_close();
+  else
+#endif
   close(rdev_fd);
 }
 
@@ -1083,7 +1783,7 @@ void RDevice_WRIT(void)
         else
         {
 #ifndef DREAMCAST
-          if(write(rdev_fd, (char *)&out_char, 1) != 1) /* Write return */
+          if(rdev_write(&out_char, 1) != 1) /* Write return */
           {
             DBG_APRINT("R*: warning, 'write' did not write all bytes");
           }
@@ -1174,7 +1874,7 @@ void RDevice_WRIT(void)
   else
 #endif /* R_NETWORK */
 #ifndef DREAMCAST
-    if((connected) && (write(rdev_fd, (char *)&out_char, 1) < 1))
+    if((connected) && (rdev_write(&out_char, 1) < 1))
     { /* returns -1 if disconnected or 0 if could not send */
       perror("write");
       DBG_APRINT("R*: ERROR on write.");
@@ -1202,6 +1902,9 @@ void RDevice_WRIT(void)
 ---------------------------------------------------------------------------*/
 void RDevice_STAT(void)
 {
+#ifdef NET_THREAD
+  char peer_name[256];
+#else
 #ifdef HAVE_WINDOWS_H
   int len;
 #else
@@ -1209,13 +1912,14 @@ void RDevice_STAT(void)
   unsigned int len;
 #endif
 #endif
-  int bytesread;
-  unsigned char one;
-  int devnum;
   int on;
   unsigned char telnet_command[2];
   /*static char IACctr = 0;*/
   on = 1;
+#endif /* NET_THREAD */
+  int bytesread;
+  unsigned char one;
+  int devnum;
 
   if(Peek(764) == 1)
   { /* Hack for Ice-T Terminal program to work! */
@@ -1223,6 +1927,13 @@ void RDevice_STAT(void)
   }
   devnum = MEMORY_dGetByte(Devices_ICDNOZ);
 
+#ifdef NET_THREAD
+  if((RDevice_serial_enabled == 0) && connected && net_hungup())
+  {
+    catch_disconnect(0);
+  }
+#endif
+
 #ifdef R_NETWORK
   if(connected == 0)
   {
@@ -1238,6 +1949,9 @@ void RDevice_STAT(void)
 
         /* Set up the listening port. */
         do_once = 1;
+#ifdef NET_THREAD
+        net_listen(portnum);
+#else
         memset ( &in, 0, sizeof ( struct sockaddr_in ) );
         sock = socket ( AF_INET, SOCK_STREAM, 0 );
         in.sin_family = AF_INET;
@@ -1254,11 +1968,18 @@ void RDevice_STAT(void)
         retval = fcntl( sock, F_SETFL, O_NONBLOCK);
 #endif /* HAVE_WINDOWS_H */
         len = sizeof ( struct sockaddr_in );
+#endif /* NET_THREAD */
         /*bufend = 0;*/
         snprintf(MESSAGE, sizeof(MESSAGE), "R%d: Listening on port %d...", devnum, portnum);
         DBG_APRINT(MESSAGE);
       }
 
+#ifdef NET_THREAD
+      if(net_accepted(peer_name, sizeof(peer_name)))
+      {
+        snprintf(MESSAGE, sizeof(MESSAGE), "R%d: Serving Connection from %.200s.", devnum, peer_name);
+        DBG_APRINT(MESSAGE);
+#else
       rdev_fd = accept ( sock, (struct sockaddr *)&peer_in, &len );
       if(rdev_fd != -1)
       {
@@ -1288,10 +2009,11 @@ void RDevice_STAT(void)
 #else
         retval = fcntl( rdev_fd, F_SETFL, O_NONBLOCK);
 #endif /* HAVE_WINDOWS_H */
+#endif /* NET_THREAD */
 
         /* Telnet negotiation */
         snprintf(MESSAGE, sizeof(MESSAGE), "%c%c%c%c%c%c%c%c%c", 0xff, 0xfb, 0x01, 0xff, 0xfb, 0x03, 0xff, 0xfd, 0x0f3);
-        if(write(rdev_fd, MESSAGE, 9) != 9)
+        if(rdev_write(MESSAGE, 9) != 9)
         {
           DBG_APRINT("R*: warning, 'write' did not write all bytes");
         }
@@ -1307,7 +2029,9 @@ void RDevice_STAT(void)
         bufout[0] = 0;
         strcat(bufout, CONNECT_STRING);
         bufend = strlen(CONNECT_STRING);
+#ifndef NET_THREAD  /* the network thread stops listening itself */
         close(sock);
+#endif
       }
     }
   }
@@ -1318,12 +2042,13 @@ void RDevice_STAT(void)
     if(concurrent)
     {
 #ifndef DREAMCAST
-      bytesread = read(rdev_fd, (char *)&one, 1);
+      bytesread = rdev_read(&one);
 #else
       bytesread = dc_read_serial(&one);
 #endif
       if(bytesread > 0)
       {
+#ifndef NET_THREAD  /* the network thread answers telnet commands itself */
         if((RDevice_serial_enabled == 0) && (one == 0xff))
         {
           /* Start Telnet escape seq processing... */
@@ -1378,6 +2103,7 @@ void RDevice_STAT(void)
           }
         }
         else
+#endif /* NET_THREAD */
         {
           bufend++;
           bufout[bufend-1] = one;
@@ -1466,6 +2192,9 @@ void RDevice_INIT(void)
 
 void RDevice_Exit(void)
 {
+#ifdef NET_THREAD
+  net_stop();
+#endif
 #ifdef HAVE_WINDOWS_H
   WSACleanup();
 #endif /* HAVE_WINDOWS_H */
@@ -0,0 +1,202 @@
+/*
+ * resample.c - Band-limited sample rate conversion of the POKEY output
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+/* Each output sample is the sum of the input samples around its position
+   weighted by a low-pass kernel, read with linear interpolation from a
+   table of RES points per zero crossing. The kernel is stretched when
+   the output rate is lower, so it cuts below the output's Nyquist
+   frequency. Quality 0 uses a one-sample triangle, which is plain linear
+   interpolation. */
+
+#include "config.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "resample.h"
+#include "util.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define RES 256
+
+struct RESAMPLE_t {
+	int in_rate;
+	int out_rate;
+	int channels;
+	int sample_size;
+	double step;    /* input frames per output frame */
+	double scale;   /* kernel table points per input frame */
+	double width;   /* kernel half-width in input frames */
+	float *kernel;  /* from the centre outwards, kernel_len points */
+	int kernel_len;
+	float *buf;     /* input frames still needed, channels interleaved */
+	int buf_frames;
+	int buf_alloc;
+	double pos;     /* position of the next output frame in buf */
+};
+
+/* Modified Bessel function of the first kind, order 0 */
+static double bessel_i0(double x)
+{
+	double sum = 1.0, term = 1.0;
+	int k;
+	for (k = 1; k < 50 && term > sum * 1e-12; k++) {
+		term *= (x / (2 * k)) * (x / (2 * k));
+		sum += term;
+	}
+	return sum;
+}
+
+RESAMPLE_t *RESAMPLE_New(int in_rate, int out_rate, int channels, int sample_size, int quality)
+{
+	static int const zero_crossings[RESAMPLE_QUALITY_MAX + 1] = { 1, 8, 16, 32 };
+	static double const beta[RESAMPLE_QUALITY_MAX + 1] = { 0.0, 6.0, 8.0, 9.0 };
+	RESAMPLE_t *r;
+	double g;
+	int i, half;
+
+	if (in_rate <= 0 || out_rate <= 0 || channels < 1 || channels > 2)
+		return NULL;
+	if (quality < 0)
+		quality = 0;
+	else if (quality > RESAMPLE_QUALITY_MAX)
+		quality = RESAMPLE_QUALITY_MAX;
+
+	r = (RESAMPLE_t *) Util_malloc(sizeof(RESAMPLE_t));
+	r->in_rate = in_rate;
+	r->out_rate = out_rate;
+	r->channels = channels;
+	r->sample_size = sample_size;
+	r->step = (double) in_rate / out_rate;
+
+	/* Zero crossings every 1/g input frames */
+	g = quality == 0 ? 1.0 : 0.9 * (in_rate < out_rate ? in_rate : out_rate) / in_rate;
+	r->width = zero_crossings[quality] / g;
+	r->scale = g * RES;
+	r->kernel_len = zero_crossings[quality] * RES + 1;
+	r->kernel = (float *) Util_malloc(r->kernel_len * sizeof(float));
+	for (i = 0; i < r->kernel_len; i++) {
+		double u = (double) i / RES; /* in zero crossings */
+		double w = u / zero_crossings[quality];
+		if (quality == 0)
+			r->kernel[i] = (float) (1.0 - u);
+		else if (i == 0)
+			r->kernel[i] = (float) g;
+		else
+			r->kernel[i] = (float) (g * sin(M_PI * u) / (M_PI * u)
+			                        * bessel_i0(beta[quality] * sqrt(1.0 - w * w)) / bessel_i0(beta[quality]));
+	}
+	r->kernel[r->kernel_len - 1] = 0.0f;
+
+	/* Start with silence before the first input frame */
+	half = (int) ceil(r->width);
+	r->buf_alloc = 2 * half + 1024;
+	r->buf = (float *) Util_malloc(r->buf_alloc * channels * sizeof(float));
+	memset(r->buf, 0, half * channels * sizeof(float));
+	r->buf_frames = half;
+	r->pos = half;
+	return r;
+}
+
+void RESAMPLE_Free(RESAMPLE_t *r)
+{
+	if (r == NULL)
+		return;
+	free(r->kernel);
+	free(r->buf);
+	free(r);
+}
+
+int RESAMPLE_OutRate(RESAMPLE_t const *r)
+{
+	return r->out_rate;
+}
+
+int RESAMPLE_MaxOutput(RESAMPLE_t const *r, int in_count)
+{
+	int frames = r->buf_frames + in_count / r->channels;
+	return ((int) (frames / r->step) + 2) * r->channels;
+}
+
+int RESAMPLE_Process(RESAMPLE_t *r, UBYTE const *in, int in_count, UBYTE *out)
+{
+	int channels = r->channels;
+	int frames = in_count / channels;
+	int written = 0;
+	int drop, i;
+	float *dst;
+
+	/* Append the input as float */
+	if (r->buf_frames + frames > r->buf_alloc) {
+		r->buf_alloc = r->buf_frames + frames + 1024;
+		r->buf = (float *) Util_realloc(r->buf, r->buf_alloc * channels * sizeof(float));
+	}
+	dst = r->buf + r->buf_frames * channels;
+	if (r->sample_size == 2) {
+		SWORD const *src = (SWORD const *) in;
+		for (i = 0; i < frames * channels; i++)
+			dst[i] = src[i];
+	}
+	else {
+		for (i = 0; i < frames * channels; i++)
+			dst[i] = (float) (in[i] - 128);
+	}
+	r->buf_frames += frames;
+
+	/* Each output frame needs the input up to pos + width */
+	while (r->pos + r->width < r->buf_frames) {
+		float acc[2] = { 0.0f, 0.0f };
+		int first = (int) floor(r->pos - r->width) + 1;
+		int last = (int) floor(r->pos + r->width);
+		int n, c;
+		if (first < 0)
+			first = 0;
+		for (n = first; n <= last; n++) {
+			double x = fabs(r->pos - n) * r->scale;
+			int k = (int) x;
+			float w;
+			if (k >= r->kernel_len - 1)
+				continue;
+			w = r->kernel[k] + (float) (x - k) * (r->kernel[k + 1] - r->kernel[k]);
+			if (channels == 1)
+				acc[0] += w * r->buf[n];
+			else {
+				acc[0] += w * r->buf[2 * n];
+				acc[1] += w * r->buf[2 * n + 1];
+			}
+		}
+		for (c = 0; c < channels; c++) {
+			int v = (int) floor(acc[c] + 0.5f);
+			if (r->sample_size == 2) {
+				if (v > 32767) v = 32767;
+				else if (v < -32768) v = -32768;
+				((SWORD *) out)[written++] = (SWORD) v;
+			}
+			else {
+				v += 128;
+				if (v > 255) v = 255;
+				else if (v < 0) v = 0;
+				out[written++] = (UBYTE) v;
+			}
+		}
+		r->pos += r->step;
+	}
+
+	/* Forget the frames no later output frame reaches */
+	drop = (int) floor(r->pos - r->width);
+	if (drop > r->buf_frames)
+		drop = r->buf_frames;
+	if (drop > 0) {
+		memmove(r->buf, r->buf + drop * channels, (r->buf_frames - drop) * channels * sizeof(float));
+		r->buf_frames -= drop;
+		r->pos -= drop;
+	}
+	return written;
+}
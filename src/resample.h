@@ -0,0 +1,43 @@
+/*
+ * resample.h - Band-limited sample rate conversion of the POKEY output
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+#ifndef RESAMPLE_H_
+#define RESAMPLE_H_
+
+#include "atari.h"
+
+/* Converts the samples the POKEY emulation produces at the output rate to
+   another rate, so consumers that want their own rate (AI audio
+   subscriptions, recording) share one run of the synthesis. Samples are in
+   the POKEYSND format: unsigned 8-bit or signed 16-bit in host order,
+   channels interleaved. A converter keeps the tail of its input between
+   calls, so each stream needs its own. */
+
+typedef struct RESAMPLE_t RESAMPLE_t;
+
+/* Quality: 0 interpolates linearly, without filtering; 1 to 3 use a
+   Kaiser-windowed sinc low-pass with 8, 16 or 32 zero crossings on each
+   side, cut off at 90% of the lower of the two Nyquist frequencies. */
+#define RESAMPLE_QUALITY_MAX 3
+#define RESAMPLE_QUALITY_DEFAULT 2
+
+/* CHANNELS is 1 or 2, SAMPLE_SIZE 1 or 2 bytes. Returns NULL if a rate
+   is not positive or CHANNELS is out of range. */
+RESAMPLE_t *RESAMPLE_New(int in_rate, int out_rate, int channels, int sample_size, int quality);
+void RESAMPLE_Free(RESAMPLE_t *r);
+
+/* Most sample values RESAMPLE_Process() writes for IN_COUNT values. */
+int RESAMPLE_MaxOutput(RESAMPLE_t const *r, int in_count);
+
+/* Converts IN_COUNT sample values (a whole number of frames) from IN into
+   OUT and returns how many values were written. The output lags the input
+   by the filter's half length. */
+int RESAMPLE_Process(RESAMPLE_t *r, UBYTE const *in, int in_count, UBYTE *out);
+
+int RESAMPLE_OutRate(RESAMPLE_t const *r);
+
+#endif /* RESAMPLE_H_ */
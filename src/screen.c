@@ -29,6 +29,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "ai_interface.h"
 #include "antic.h"
 #include "atari.h"
 #include "cassette.h"
@@ -647,22 +648,69 @@ static UBYTE *SmallFont_DrawInt(UBYTE *screen, int n, UBYTE color1, UBYTE color2
 	return screen;
 }
 
+/* With frame timing, the mean us per frame of the CPU, ANTIC, sound
+   and the host (the display, events and sync), over the last update */
+static void DrawFrameTiming(int update)
+{
+	static const int letters[4] = { SMALLFONT_C, SMALLFONT_A, SMALLFONT_S, SMALLFONT_H };
+	static int us[4] = { 0, 0, 0, 0 };
+	static AI_FrameStats last;
+	UBYTE *screen;
+	int i;
+
+	if (update) {
+		AI_FrameStats s;
+		double t[4];
+		ULONG frames;
+		AI_GetFrameStats(&s, FALSE);
+		if (s.frames < last.frames)
+			memset(&last, 0, sizeof(last));	/* cleared meanwhile */
+		frames = s.frames - last.frames;
+		t[0] = s.total[AI_TIME_CPU] - last.total[AI_TIME_CPU];
+		t[1] = s.total[AI_TIME_ANTIC] - last.total[AI_TIME_ANTIC];
+		t[2] = s.total[AI_TIME_POKEY] - last.total[AI_TIME_POKEY]
+		     + s.total[AI_TIME_SOUND] - last.total[AI_TIME_SOUND];
+		t[3] = s.total[AI_TIME_HOST] - last.total[AI_TIME_HOST]
+		     + s.total[AI_TIME_SYNC] - last.total[AI_TIME_SYNC];
+		for (i = 0; i < 4; i++) {
+			us[i] = frames > 0 ? (int) (t[i] * 1e6 / frames) : 0;
+			if (us[i] > 99999)
+				us[i] = 99999;
+		}
+		last = s;
+	}
+	/* "C123 A45 S12 H19800", right-aligned above the speed */
+	screen = (UBYTE *) Screen_atari + Screen_visible_x1 + 25 * SMALLFONT_WIDTH
+	         + (Screen_visible_y2 - 2 * SMALLFONT_HEIGHT) * Screen_WIDTH;
+	for (i = 3; i >= 0; i--) {
+		screen = SmallFont_DrawInt(screen, us[i], 0x0c, 0x00);
+		SmallFont_DrawChar(screen, letters[i], 0x0c, 0x00);
+		screen -= 2 * SMALLFONT_WIDTH;
+	}
+}
+
 void Screen_DrawAtariSpeed(double cur_time)
 {
 	if (Screen_show_atari_speed) {
 		static int percent_display = 100;
 		static int last_updated = 0;
 		static double last_time = 0;
-		if ((cur_time - last_time) >= 0.5) {
+		int update = (cur_time - last_time) >= 0.5;
+		if (update) {
 			percent_display = (int) (100 * (Atari800_nframes - last_updated) / (cur_time - last_time) / (Atari800_tv_mode == Atari800_TV_PAL ? 50 : 60));
 			last_updated = Atari800_nframes;
 			last_time = cur_time;
 		}
+		if (AI_frame_timing) {
+			ANTIC_InvalidateScanlineCache();
+			DrawFrameTiming(update);
+		}
 		/* if (percent_display < 99 || percent_display > 101) */
 		{
 			/* space for 5 digits - up to 99999% Atari speed */
 			UBYTE *screen = (UBYTE *) Screen_atari + Screen_visible_x1 + 5 * SMALLFONT_WIDTH
 			          	+ (Screen_visible_y2 - SMALLFONT_HEIGHT) * Screen_WIDTH;
+			ANTIC_InvalidateScanlineCache();
 			SmallFont_DrawChar(screen, SMALLFONT_PERCENT, 0x0c, 0x00);
 			SmallFont_DrawInt(screen - SMALLFONT_WIDTH, percent_display, 0x0c, 0x00);
 		}
@@ -676,6 +724,7 @@ void Screen_DrawDiskLED(void)
 				        + (Screen_visible_y2 - SMALLFONT_HEIGHT) * Screen_WIDTH;
 		if (SIO_last_op_time > 0) {
 			SIO_last_op_time--;
+			ANTIC_InvalidateScanlineCache();
 			if (Screen_show_disk_led) {
 				SmallFont_DrawChar(screen, SIO_last_drive, 0x00, (UBYTE) (SIO_last_op == SIO_LAST_READ ? 0xac : 0x2b));
 				SmallFont_DrawChar(screen -= SMALLFONT_WIDTH, SMALLFONT_D, 0x00, (UBYTE) (SIO_last_op == SIO_LAST_READ ? 0xac : 0x2b));
@@ -687,6 +736,7 @@ void Screen_DrawDiskLED(void)
 		}
 		if ((CASSETTE_readable && !CASSETTE_record) ||
 		    (CASSETTE_writable && CASSETTE_record)) {
+			ANTIC_InvalidateScanlineCache();
 			if (Screen_show_disk_led)
 				SmallFont_DrawChar(screen, SMALLFONT_C, 0x00, (UBYTE) (CASSETTE_record ? 0x2b : 0xac));
 
@@ -709,6 +759,7 @@ void Screen_Draw1200LED(void)
 		UBYTE *screen = (UBYTE *) Screen_atari + Screen_visible_x1 + SMALLFONT_WIDTH * 10
 			+ (Screen_visible_y2 - SMALLFONT_HEIGHT) * Screen_WIDTH;
 		UBYTE portb = PIA_PORTB | PIA_PORTB_mask;
+		ANTIC_InvalidateScanlineCache();
 		if ((portb & 0x04) == 0) {
 			SmallFont_DrawChar(screen, SMALLFONT_L, 0x00, 0x36);
 			SmallFont_DrawChar(screen + SMALLFONT_WIDTH, 1, 0x00, 0x36);
@@ -721,35 +772,6 @@ void Screen_Draw1200LED(void)
 	}
 }
 
-/* Returns screen address for placing the next character on the left of the
-   drawn number. */
-static UBYTE *SmallFont_DrawFloat(UBYTE *screen, float f, int num_decimal_places, UBYTE color1, UBYTE color2)
-{
-	int n;
-	int i;
-
-	for (i = 0; i < num_decimal_places; i++) {
-		f *= 10;
-	}
-	n = (int)f;
-	if (num_decimal_places == 0) {
-		screen = SmallFont_DrawInt(screen, n, color1, color2);
-	}
-	else {
-		do {
-			SmallFont_DrawChar(screen, n % 10, color1, color2);
-			screen -= SMALLFONT_WIDTH;
-			n /= 10;
-			num_decimal_places--;
-			if (num_decimal_places == 0) {
-				SmallFont_DrawChar(screen, SMALLFONT_DOT, color1, color2);
-				screen -= SMALLFONT_WIDTH;
-			}
-		} while (n > 0);
-	}
-	return screen;
-}
-
 static UBYTE *SmallFont_DrawString(UBYTE *screen, const char *s, UBYTE color1, UBYTE color2)
 {
 	char cin;
@@ -779,6 +801,35 @@ static UBYTE *SmallFont_DrawString(UBYTE *screen, const char *s, UBYTE color1, U
 }
 
 #if defined(AUDIO_RECORDING) || defined(VIDEO_RECORDING)
+/* Returns screen address for placing the next character on the left of the
+   drawn number. */
+static UBYTE *SmallFont_DrawFloat(UBYTE *screen, float f, int num_decimal_places, UBYTE color1, UBYTE color2)
+{
+	int n;
+	int i;
+
+	for (i = 0; i < num_decimal_places; i++) {
+		f *= 10;
+	}
+	n = (int)f;
+	if (num_decimal_places == 0) {
+		screen = SmallFont_DrawInt(screen, n, color1, color2);
+	}
+	else {
+		do {
+			SmallFont_DrawChar(screen, n % 10, color1, color2);
+			screen -= SMALLFONT_WIDTH;
+			n /= 10;
+			num_decimal_places--;
+			if (num_decimal_places == 0) {
+				SmallFont_DrawChar(screen, SMALLFONT_DOT, color1, color2);
+				screen -= SMALLFONT_WIDTH;
+			}
+		} while (n > 0);
+	}
+	return screen;
+}
+
 void Screen_DrawMultimediaStats(void)
 {
 	if (Screen_show_multimedia_stats) {
@@ -793,6 +844,7 @@ void Screen_DrawMultimediaStats(void)
 
 		if (File_Export_GetRecordingStats(&elapsed_time, &size, &media_description)) {
 			num = 10 + strlen(media_description) + 2 + 7 + 2 + 6;
+			ANTIC_InvalidateScanlineCache();
 			screen = (UBYTE *) Screen_atari + Screen_visible_x1 + (Screen_visible_x2 - Screen_visible_x1) / 2 - (num * SMALLFONT_WIDTH) / 2 + (Screen_visible_y2 - SMALLFONT_HEIGHT) * Screen_WIDTH;
 
 			screen = SmallFont_DrawString(screen, "RECORDING ", 0x0f, 0x34);
@@ -865,6 +917,7 @@ void Screen_DrawStatusText(void) {
 	UBYTE* screen = (UBYTE*)Screen_atari + Screen_visible_x1 + (width - len * SMALLFONT_WIDTH) / 2
 				+ (Screen_visible_y2 - SMALLFONT_HEIGHT) * Screen_WIDTH;
 	if (status_text_duration == 0 || len == 0) return;
+	ANTIC_InvalidateScanlineCache();
 
 	if (status_text_duration > 0) --status_text_duration;
 
@@ -879,7 +932,6 @@ int Screen_SaveScreenshot(const char *filename, int interlaced)
 	UBYTE *ptr1;
 	UBYTE *ptr2;
 
-	Log_print("Screen_SaveScreenshot: filename=%s Screen_atari=%p", filename, (void*)Screen_atari);
 	if (!File_Export_ImageTypeSupported(filename)) {
 		Log_print("Unsupported image type for file: %s", filename);
 		return FALSE;
@@ -901,6 +953,7 @@ int Screen_SaveScreenshot(const char *filename, int interlaced)
 	if (interlaced) {
 		free(Screen_atari);
 		Screen_atari = main_screen_atari;
+		ANTIC_InvalidateScanlineCache();
 	}
 	return result;
 }
@@ -0,0 +1,174 @@
+/*
+ * screen_ring.c - completed screens shared with readers in other threads
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+/* A slot is written only while it is neither the latest nor held, and
+   readers only ever acquire the latest, so the copy into it is done
+   outside the lock; only the slot states are shared. */
+
+#include "config.h"
+#include <stdlib.h>
+#include <string.h>
+#ifdef HAVE_PTHREAD_CREATE
+#include <pthread.h>
+#endif
+
+#include "antic.h"
+#include "screen.h"
+#include "screen_ring.h"
+#include "util.h"
+
+#define SCREEN_SIZE (Screen_WIDTH * Screen_HEIGHT)
+#define MAX_SLOTS 160  /* the longest recording queue and most library buffers at once */
+
+typedef struct {
+	UBYTE *screen;      /* NULL until first needed */
+	int frame;          /* Atari800_nframes of the screen it holds */
+	int readers;        /* acquired and not yet released */
+} slot_t;
+
+static slot_t slots[MAX_SLOTS];
+static int num_slots = 0;     /* allocated */
+static int max_slots = 0;     /* what the users opened the ring for */
+static int users = 0;
+static int latest = -1;       /* -1 = none yet */
+static unsigned int latest_clock;  /* ANTIC_CPU_CLOCK when it was published */
+static unsigned long dropped = 0;
+
+#ifdef HAVE_PTHREAD_CREATE
+static pthread_mutex_t ring_lock = PTHREAD_MUTEX_INITIALIZER;
+#define LOCK()   pthread_mutex_lock(&ring_lock)
+#define UNLOCK() pthread_mutex_unlock(&ring_lock)
+#else
+#define LOCK()   do { } while (0)
+#define UNLOCK() do { } while (0)
+#endif
+
+int Screen_Ring_Open(int n)
+{
+	LOCK();
+	/* One more than the readers may hold, for the latest */
+	if (n < 0 || max_slots + n + (users == 0) > MAX_SLOTS) {
+		UNLOCK();
+		return FALSE;
+	}
+	if (users++ == 0) {
+		max_slots = 1;
+		dropped = 0;
+	}
+	max_slots += n;
+	UNLOCK();
+	return TRUE;
+}
+
+void Screen_Ring_Close(int n)
+{
+	int i;
+
+	LOCK();
+	max_slots -= n;
+	if (--users == 0) {
+		/* Slots still held are left for their readers to release */
+		for (i = 0; i < num_slots; i++) {
+			if (slots[i].readers == 0) {
+				free(slots[i].screen);
+				slots[i].screen = NULL;
+			}
+		}
+		max_slots = 0;
+		latest = -1;
+	}
+	UNLOCK();
+}
+
+void Screen_Ring_Publish(void)
+{
+	int i;
+	int slot = -1;
+
+	if (users == 0)
+		return;
+	LOCK();
+	if (latest >= 0 && latest_clock == ANTIC_CPU_CLOCK) {
+		/* Published earlier in the frame, before its number was final */
+		slots[latest].frame = Atari800_nframes;
+		UNLOCK();
+		return;
+	}
+	for (i = 0; i < num_slots && slot < 0; i++) {
+		if (i != latest && slots[i].readers == 0 && slots[i].screen != NULL)
+			slot = i;
+	}
+	if (slot < 0) {
+		/* A slot freed by Close, or a new one */
+		for (i = 0; i < max_slots && slot < 0; i++) {
+			if (i != latest && slots[i].readers == 0)
+				slot = i;
+		}
+		if (slot < 0)
+			dropped++;
+		else if (slots[slot].screen == NULL) {
+			slots[slot].screen = (UBYTE *) Util_malloc(SCREEN_SIZE);
+			if (slot >= num_slots)
+				num_slots = slot + 1;
+		}
+	}
+	UNLOCK();
+	if (slot < 0)
+		return;
+	memcpy(slots[slot].screen, Screen_atari, SCREEN_SIZE);
+	LOCK();
+	slots[slot].frame = Atari800_nframes;
+	latest = slot;
+	latest_clock = ANTIC_CPU_CLOCK;
+	UNLOCK();
+}
+
+const UBYTE *Screen_Ring_Acquire(int *frame)
+{
+	const UBYTE *screen = NULL;
+
+	LOCK();
+	if (latest >= 0) {
+		slots[latest].readers++;
+		screen = slots[latest].screen;
+		if (frame != NULL)
+			*frame = slots[latest].frame;
+	}
+	UNLOCK();
+	return screen;
+}
+
+const UBYTE *Screen_Ring_AcquireCurrent(void)
+{
+	Screen_Ring_Publish();
+	if (latest < 0 || latest_clock != ANTIC_CPU_CLOCK)
+		return NULL;
+	return Screen_Ring_Acquire(NULL);
+}
+
+void Screen_Ring_Release(const UBYTE *screen)
+{
+	int i;
+
+	LOCK();
+	for (i = 0; i < num_slots; i++) {
+		if (slots[i].screen == screen && slots[i].readers > 0) {
+			if (--slots[i].readers == 0 && users == 0) {
+				/* Held when the ring was closed */
+				free(slots[i].screen);
+				slots[i].screen = NULL;
+			}
+			break;
+		}
+	}
+	UNLOCK();
+}
+
+unsigned long Screen_Ring_Dropped(void)
+{
+	return dropped;
+}
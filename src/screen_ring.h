@@ -0,0 +1,52 @@
+/*
+ * screen_ring.h - completed screens shared with readers in other threads
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+#ifndef SCREEN_RING_H_
+#define SCREEN_RING_H_
+
+#include "atari.h"
+
+/* Completed screens, shared by readers in other threads.
+
+   A finished Screen_atari is copied once into a slot of the ring, and any
+   number of readers (the recording encoder, libatari800's screen buffers)
+   hold references to that slot instead of making copies of their own. A
+   slot is written again only when no reader holds it, so readers never see
+   it change and the emulation never waits for them. Slots are allocated as
+   they are first needed, up to what the users opened it for.
+
+   Publishing and acquiring the current screen are for the emulation thread;
+   acquiring the latest and releasing may be done from any thread. */
+
+/* Room for n more screens held at once by a new user; nothing is published
+   while the ring has no users. Returns FALSE if the ring would get too big. */
+int Screen_Ring_Open(int n);
+
+/* Takes back what Screen_Ring_Open(n) gave. When the last user goes, the
+   slots no reader holds are freed. */
+void Screen_Ring_Close(int n);
+
+/* Copies Screen_atari as the latest completed screen, once a frame: while
+   the CPU clock has not moved on, Screen_atari is taken to be the screen
+   already published, whose frame number is only brought up to date. */
+void Screen_Ring_Publish(void);
+
+/* Holds the latest completed screen, and gets its frame number if frame is
+   not NULL. Returns NULL if none has been published yet. */
+const UBYTE *Screen_Ring_Acquire(int *frame);
+
+/* Publishes Screen_atari and holds it. Returns NULL if every slot is held. */
+const UBYTE *Screen_Ring_AcquireCurrent(void);
+
+/* Gives back a screen from Screen_Ring_Acquire() or
+   Screen_Ring_AcquireCurrent(), once for each. */
+void Screen_Ring_Release(const UBYTE *screen);
+
+/* Frames that found every slot held since the first user opened the ring */
+unsigned long Screen_Ring_Dropped(void);
+
+#endif /* SCREEN_RING_H_ */
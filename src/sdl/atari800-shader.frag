@@ -4,6 +4,8 @@
 out vec4 FragColor;
 in vec2 TexCoord;
 uniform sampler2D ourTexture;
+uniform sampler2D u_palette; // 256x1 Atari palette, used when u_indexed is set
+uniform bool u_indexed; // ourTexture holds Atari colour indices instead of RGB
 uniform float scanlinesFactor;
 uniform float screenCurvature;
 uniform vec2 u_resolution; // Atari screen resolution
@@ -18,6 +20,14 @@ vec2 barrel(vec2 v, vec2 resolution) {
 	return v - r2 * (1.0 + distortion) * distortion;
 }
 
+// colour of the screen texture at pos, looked up in the palette when the
+// texture holds the raw Atari screen
+vec4 screenTexel(vec2 pos) {
+	vec4 texel = texture(ourTexture, pos);
+	if (!u_indexed) return texel;
+	return texture(u_palette, vec2((texel.r * 255.0 + 0.5) / 256.0, 0.5));
+}
+
 float prodXY(vec2 v) {
 	return v.x * v.y;
 }
@@ -72,7 +82,7 @@ float scanLines(vec2 screenCoords, vec2 texSize) {
 	return exp(-coord * coord * 1.75);
 }
 
-vec4 blur(sampler2D iChannel0, vec2 fragCoord, vec2 iResolution) {
+vec4 blur(vec2 fragCoord, vec2 iResolution) {
 	const float PI2 = 6.28318530718; // Pi*2
 
 	// Gaussian blur settings
@@ -85,12 +95,12 @@ vec4 blur(sampler2D iChannel0, vec2 fragCoord, vec2 iResolution) {
 	// normalized pixel coordinates (from 0 to 1)
 	vec2 uv = fragCoord;
 	// pixel color
-	vec4 color = texture(iChannel0, uv);
+	vec4 color = screenTexel(uv);
 
 	// blur calculations
 	for (float d = 0.0; d < PI2; d += PI2 / directions) {
 		for (float i = 1.0 / quality; i <= 1.0; i += 1.0 / quality) {
-			color += texture(iChannel0, uv + vec2(cos(d), sin(d)) * radius * i);		
+			color += screenTexel(uv + vec2(cos(d), sin(d)) * radius * i);		
 		}
 	}
 
@@ -102,7 +112,7 @@ vec4 blur(sampler2D iChannel0, vec2 fragCoord, vec2 iResolution) {
 vec3 get_tex_pixel(vec2 pos, vec2 texSize) {
 	vec2 pix = 1.0 / texSize;
 	vec2 p = pos - mod(pos, pix) + pix * 0.5;
-	vec3 color1 = texture(ourTexture, p).rgb;
+	vec3 color1 = screenTexel(p).rgb;
 	return color1;
 }
 
@@ -144,9 +154,9 @@ vec4 get_pixel_intensity(vec2 pos, vec2 next, vec3 left, vec3 middle, vec3 right
 vec4 get_pixel(vec2 pos, vec2 adjacent, vec2 texSize) {
 	vec2 pix = 1.0 / texSize;
 	vec2 p = pos - mod(pos, pix) + pix * 0.5;
-	vec3 color0 = texture(ourTexture, p - vec2(pix.x, 0.0)).rgb;
-	vec3 color1 = texture(ourTexture, p).rgb;
-	vec3 color2 = texture(ourTexture, p + vec2(pix.x, 0.0)).rgb;
+	vec3 color0 = screenTexel(p - vec2(pix.x, 0.0)).rgb;
+	vec3 color1 = screenTexel(p).rgb;
+	vec3 color2 = screenTexel(p + vec2(pix.x, 0.0)).rgb;
 	return get_pixel_intensity(pos, adjacent, color0, color1, color2, texSize);
 }
 
@@ -162,7 +172,7 @@ void main() {
 	vec4 bgnd = mix(pix, pix * mask, scanlinesFactor);
 
 	vec4 col = pix;
-	vec4 glow = blur(ourTexture, texCoords, texSize * vec2(1.0, 2.0));
+	vec4 glow = blur(texCoords, texSize * vec2(1.0, 2.0));
 	vec4 final = bgnd + glow * u_glowCoeff;
 
 	vec4 frm = frame(TexCoord, texResolution);
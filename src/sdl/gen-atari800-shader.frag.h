@@ -8,6 +8,14 @@ unsigned char fragmentShaderArr[] = {
   0x72, 0x61, 0x67, 0x43, 0x6f, 0x6c, 0x6f, 0x72, 0x3b, 0x0a, 0x69, 0x6e, 0x20, 0x76, 0x65, 0x63, 0x32, 0x20, 0x54, 0x65,
   0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x3b, 0x0a, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x73, 0x61, 0x6d, 0x70,
   0x6c, 0x65, 0x72, 0x32, 0x44, 0x20, 0x6f, 0x75, 0x72, 0x54, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x3b, 0x0a, 0x75, 0x6e,
+  0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x72, 0x32, 0x44, 0x20, 0x75, 0x5f, 0x70, 0x61,
+  0x6c, 0x65, 0x74, 0x74, 0x65, 0x3b, 0x20, 0x2f, 0x2f, 0x20, 0x32, 0x35, 0x36, 0x78, 0x31, 0x20, 0x41, 0x74, 0x61, 0x72,
+  0x69, 0x20, 0x70, 0x61, 0x6c, 0x65, 0x74, 0x74, 0x65, 0x2c, 0x20, 0x75, 0x73, 0x65, 0x64, 0x20, 0x77, 0x68, 0x65, 0x6e,
+  0x20, 0x75, 0x5f, 0x69, 0x6e, 0x64, 0x65, 0x78, 0x65, 0x64, 0x20, 0x69, 0x73, 0x20, 0x73, 0x65, 0x74, 0x0a, 0x75, 0x6e,
+  0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x62, 0x6f, 0x6f, 0x6c, 0x20, 0x75, 0x5f, 0x69, 0x6e, 0x64, 0x65, 0x78, 0x65, 0x64,
+  0x3b, 0x20, 0x2f, 0x2f, 0x20, 0x6f, 0x75, 0x72, 0x54, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x20, 0x68, 0x6f, 0x6c, 0x64,
+  0x73, 0x20, 0x41, 0x74, 0x61, 0x72, 0x69, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x75, 0x72, 0x20, 0x69, 0x6e, 0x64, 0x69, 0x63,
+  0x65, 0x73, 0x20, 0x69, 0x6e, 0x73, 0x74, 0x65, 0x61, 0x64, 0x20, 0x6f, 0x66, 0x20, 0x52, 0x47, 0x42, 0x0a, 0x75, 0x6e,
   0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x73, 0x63, 0x61, 0x6e, 0x6c, 0x69, 0x6e, 0x65,
   0x73, 0x46, 0x61, 0x63, 0x74, 0x6f, 0x72, 0x3b, 0x0a, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x66, 0x6c, 0x6f,
   0x61, 0x74, 0x20, 0x73, 0x63, 0x72, 0x65, 0x65, 0x6e, 0x43, 0x75, 0x72, 0x76, 0x61, 0x74, 0x75, 0x72, 0x65, 0x3b, 0x0a,
@@ -29,207 +37,218 @@ unsigned char fragmentShaderArr[] = {
   0x72, 0x32, 0x29, 0x20, 0x2a, 0x20, 0x73, 0x63, 0x72, 0x65, 0x65, 0x6e, 0x43, 0x75, 0x72, 0x76, 0x61, 0x74, 0x75, 0x72,
   0x65, 0x3b, 0x0a, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x76, 0x20, 0x2d, 0x20, 0x72, 0x32, 0x20, 0x2a, 0x20,
   0x28, 0x31, 0x2e, 0x30, 0x20, 0x2b, 0x20, 0x64, 0x69, 0x73, 0x74, 0x6f, 0x72, 0x74, 0x69, 0x6f, 0x6e, 0x29, 0x20, 0x2a,
-  0x20, 0x64, 0x69, 0x73, 0x74, 0x6f, 0x72, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x66, 0x6c, 0x6f, 0x61,
-  0x74, 0x20, 0x70, 0x72, 0x6f, 0x64, 0x58, 0x59, 0x28, 0x76, 0x65, 0x63, 0x32, 0x20, 0x76, 0x29, 0x20, 0x7b, 0x0a, 0x09,
-  0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x76, 0x2e, 0x78, 0x20, 0x2a, 0x20, 0x76, 0x2e, 0x79, 0x3b, 0x0a, 0x7d, 0x0a,
-  0x0a, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x6d, 0x61, 0x78, 0x58, 0x59, 0x28, 0x76, 0x65, 0x63, 0x32, 0x20, 0x76, 0x29,
-  0x20, 0x7b, 0x0a, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x6d, 0x61, 0x78, 0x28, 0x76, 0x2e, 0x78, 0x2c, 0x20,
-  0x76, 0x2e, 0x79, 0x29, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x73, 0x75, 0x6d, 0x32, 0x28,
-  0x76, 0x65, 0x63, 0x32, 0x20, 0x76, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x76, 0x2e,
-  0x78, 0x20, 0x2b, 0x20, 0x76, 0x2e, 0x79, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x76, 0x65, 0x63, 0x32, 0x20, 0x70, 0x6f, 0x73,
-  0x69, 0x74, 0x69, 0x76, 0x65, 0x4c, 0x6f, 0x67, 0x28, 0x76, 0x65, 0x63, 0x32, 0x20, 0x78, 0x29, 0x20, 0x7b, 0x0a, 0x09,
-  0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x63, 0x6c, 0x61, 0x6d, 0x70, 0x28, 0x6c, 0x6f, 0x67, 0x28, 0x78, 0x29, 0x2c,
-  0x20, 0x76, 0x65, 0x63, 0x32, 0x28, 0x30, 0x2e, 0x30, 0x29, 0x2c, 0x20, 0x76, 0x65, 0x63, 0x32, 0x28, 0x31, 0x30, 0x30,
-  0x2e, 0x30, 0x29, 0x29, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x64, 0x72, 0x61, 0x77, 0x20, 0x43, 0x52, 0x54,
-  0x20, 0x6d, 0x6f, 0x6e, 0x69, 0x74, 0x6f, 0x72, 0x20, 0x66, 0x72, 0x61, 0x6d, 0x65, 0x20, 0x77, 0x69, 0x74, 0x68, 0x20,
-  0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x20, 0x61, 0x6e, 0x64, 0x20, 0x76, 0x69, 0x67, 0x6e, 0x65, 0x74, 0x74, 0x65, 0x0a,
-  0x76, 0x65, 0x63, 0x34, 0x20, 0x66, 0x72, 0x61, 0x6d, 0x65, 0x28, 0x76, 0x65, 0x63, 0x32, 0x20, 0x74, 0x65, 0x78, 0x43,
-  0x6f, 0x6f, 0x72, 0x64, 0x73, 0x2c, 0x20, 0x76, 0x65, 0x63, 0x32, 0x20, 0x72, 0x65, 0x73, 0x6f, 0x6c, 0x75, 0x74, 0x69,
-  0x6f, 0x6e, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x69, 0x66, 0x20, 0x28, 0x73, 0x63, 0x72, 0x65, 0x65, 0x6e, 0x43, 0x75, 0x72,
-  0x76, 0x61, 0x74, 0x75, 0x72, 0x65, 0x20, 0x3d, 0x3d, 0x20, 0x30, 0x2e, 0x30, 0x29, 0x20, 0x72, 0x65, 0x74, 0x75, 0x72,
-  0x6e, 0x20, 0x76, 0x65, 0x63, 0x34, 0x28, 0x30, 0x2e, 0x30, 0x2c, 0x30, 0x2e, 0x30, 0x2c, 0x30, 0x2e, 0x30, 0x2c, 0x30,
-  0x2e, 0x30, 0x29, 0x3b, 0x0a, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x32, 0x20, 0x6d, 0x61, 0x72, 0x67, 0x69, 0x6e, 0x20, 0x3d,
-  0x20, 0x76, 0x65, 0x63, 0x32, 0x28, 0x30, 0x2e, 0x30, 0x2c, 0x20, 0x30, 0x2e, 0x30, 0x29, 0x3b, 0x0a, 0x09, 0x66, 0x6c,
-  0x6f, 0x61, 0x74, 0x20, 0x66, 0x72, 0x61, 0x6d, 0x65, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x43, 0x6f, 0x65, 0x66, 0x66,
-  0x20, 0x3d, 0x20, 0x31, 0x32, 0x30, 0x2e, 0x30, 0x3b, 0x0a, 0x09, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x73, 0x63, 0x72,
-  0x65, 0x65, 0x6e, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x43, 0x6f, 0x65, 0x66, 0x66, 0x20, 0x3d, 0x20, 0x31, 0x32, 0x2e,
-  0x30, 0x3b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x33, 0x20, 0x66, 0x72, 0x61, 0x6d, 0x65, 0x43, 0x6f, 0x6c, 0x6f, 0x72, 0x20,
-  0x3d, 0x20, 0x76, 0x65, 0x63, 0x33, 0x28, 0x30, 0x2e, 0x33, 0x2c, 0x20, 0x30, 0x2e, 0x33, 0x2c, 0x20, 0x30, 0x2e, 0x33,
-  0x35, 0x29, 0x3b, 0x0a, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x32, 0x20, 0x63, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x20, 0x3d, 0x20,
-  0x62, 0x61, 0x72, 0x72, 0x65, 0x6c, 0x28, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x2c, 0x20, 0x72, 0x65,
-  0x73, 0x6f, 0x6c, 0x75, 0x74, 0x69, 0x6f, 0x6e, 0x29, 0x20, 0x2a, 0x20, 0x28, 0x76, 0x65, 0x63, 0x32, 0x28, 0x31, 0x2e,
-  0x30, 0x29, 0x20, 0x2b, 0x20, 0x6d, 0x61, 0x72, 0x67, 0x69, 0x6e, 0x20, 0x2a, 0x20, 0x32, 0x2e, 0x30, 0x29, 0x20, 0x2d,
-  0x20, 0x6d, 0x61, 0x72, 0x67, 0x69, 0x6e, 0x3b, 0x0a, 0x09, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x20,
-  0x3d, 0x20, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x20, 0x2f, 0x20, 0x72, 0x65, 0x73, 0x6f, 0x6c, 0x75,
-  0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x0a, 0x09, 0x63, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x20, 0x3d, 0x20, 0x63, 0x6f, 0x6f, 0x72,
-  0x64, 0x73, 0x20, 0x2f, 0x20, 0x72, 0x65, 0x73, 0x6f, 0x6c, 0x75, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x0a, 0x0a, 0x09, 0x76,
-  0x65, 0x63, 0x32, 0x20, 0x76, 0x69, 0x67, 0x6e, 0x65, 0x74, 0x74, 0x65, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x20, 0x3d,
-  0x20, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x20, 0x2a, 0x20, 0x28, 0x31, 0x2e, 0x30, 0x20, 0x2d, 0x20,
-  0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x2e, 0x79, 0x78, 0x29, 0x3b, 0x0a, 0x09, 0x66, 0x6c, 0x6f, 0x61,
-  0x74, 0x20, 0x76, 0x69, 0x67, 0x6e, 0x65, 0x74, 0x74, 0x65, 0x20, 0x3d, 0x20, 0x70, 0x6f, 0x77, 0x28, 0x70, 0x72, 0x6f,
-  0x64, 0x58, 0x59, 0x28, 0x76, 0x69, 0x67, 0x6e, 0x65, 0x74, 0x74, 0x65, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x29, 0x20,
-  0x2a, 0x20, 0x31, 0x35, 0x2e, 0x30, 0x2c, 0x20, 0x30, 0x2e, 0x32, 0x35, 0x29, 0x3b, 0x0a, 0x0a, 0x09, 0x76, 0x65, 0x63,
-  0x33, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x20, 0x3d, 0x20, 0x66, 0x72, 0x61, 0x6d, 0x65, 0x43, 0x6f, 0x6c, 0x6f, 0x72,
-  0x20, 0x2a, 0x20, 0x76, 0x65, 0x63, 0x33, 0x28, 0x31, 0x2e, 0x30, 0x20, 0x2d, 0x20, 0x76, 0x69, 0x67, 0x6e, 0x65, 0x74,
-  0x74, 0x65, 0x29, 0x3b, 0x0a, 0x09, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x61, 0x6c, 0x70, 0x68, 0x61, 0x20, 0x3d, 0x20,
-  0x30, 0x2e, 0x30, 0x3b, 0x0a, 0x0a, 0x09, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x66, 0x72, 0x61, 0x6d, 0x65, 0x53, 0x68,
-  0x61, 0x64, 0x6f, 0x77, 0x20, 0x3d, 0x20, 0x6d, 0x61, 0x78, 0x58, 0x59, 0x28, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x76,
-  0x65, 0x4c, 0x6f, 0x67, 0x28, 0x2d, 0x63, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x20, 0x2a, 0x20, 0x66, 0x72, 0x61, 0x6d, 0x65,
-  0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x43, 0x6f, 0x65, 0x66, 0x66, 0x20, 0x2b, 0x20, 0x31, 0x2e, 0x30, 0x29, 0x20, 0x2b,
-  0x20, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x76, 0x65, 0x4c, 0x6f, 0x67, 0x28, 0x63, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x20,
-  0x2a, 0x20, 0x66, 0x72, 0x61, 0x6d, 0x65, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x43, 0x6f, 0x65, 0x66, 0x66, 0x20, 0x2d,
-  0x20, 0x28, 0x66, 0x72, 0x61, 0x6d, 0x65, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x43, 0x6f, 0x65, 0x66, 0x66, 0x20, 0x2d,
-  0x20, 0x31, 0x2e, 0x30, 0x29, 0x29, 0x29, 0x3b, 0x0a, 0x09, 0x66, 0x72, 0x61, 0x6d, 0x65, 0x53, 0x68, 0x61, 0x64, 0x6f,
-  0x77, 0x20, 0x3d, 0x20, 0x6d, 0x61, 0x78, 0x28, 0x73, 0x71, 0x72, 0x74, 0x28, 0x66, 0x72, 0x61, 0x6d, 0x65, 0x53, 0x68,
-  0x61, 0x64, 0x6f, 0x77, 0x29, 0x2c, 0x20, 0x30, 0x2e, 0x30, 0x29, 0x3b, 0x0a, 0x09, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x20,
-  0x2a, 0x3d, 0x20, 0x66, 0x72, 0x61, 0x6d, 0x65, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x3b, 0x0a, 0x09, 0x61, 0x6c, 0x70,
-  0x68, 0x61, 0x20, 0x3d, 0x20, 0x73, 0x75, 0x6d, 0x32, 0x28, 0x31, 0x2e, 0x30, 0x20, 0x2d, 0x20, 0x73, 0x74, 0x65, 0x70,
-  0x28, 0x76, 0x65, 0x63, 0x32, 0x28, 0x30, 0x2e, 0x30, 0x29, 0x2c, 0x20, 0x63, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x29, 0x20,
-  0x2b, 0x20, 0x73, 0x74, 0x65, 0x70, 0x28, 0x76, 0x65, 0x63, 0x32, 0x28, 0x31, 0x2e, 0x30, 0x29, 0x2c, 0x20, 0x63, 0x6f,
-  0x6f, 0x72, 0x64, 0x73, 0x29, 0x29, 0x3b, 0x0a, 0x09, 0x61, 0x6c, 0x70, 0x68, 0x61, 0x20, 0x3d, 0x20, 0x63, 0x6c, 0x61,
-  0x6d, 0x70, 0x28, 0x61, 0x6c, 0x70, 0x68, 0x61, 0x2c, 0x20, 0x30, 0x2e, 0x30, 0x2c, 0x20, 0x31, 0x2e, 0x30, 0x29, 0x3b,
-  0x0a, 0x0a, 0x09, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x73, 0x63, 0x72, 0x65, 0x65, 0x6e, 0x53, 0x68, 0x61, 0x64, 0x6f,
-  0x77, 0x20, 0x3d, 0x20, 0x31, 0x2e, 0x30, 0x20, 0x2d, 0x20, 0x70, 0x72, 0x6f, 0x64, 0x58, 0x59, 0x28, 0x70, 0x6f, 0x73,
-  0x69, 0x74, 0x69, 0x76, 0x65, 0x4c, 0x6f, 0x67, 0x28, 0x63, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x20, 0x2a, 0x20, 0x73, 0x63,
-  0x72, 0x65, 0x65, 0x6e, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x43, 0x6f, 0x65, 0x66, 0x66, 0x20, 0x2b, 0x20, 0x76, 0x65,
-  0x63, 0x32, 0x28, 0x31, 0x2e, 0x30, 0x29, 0x29, 0x20, 0x2a, 0x20, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x76, 0x65, 0x4c,
-  0x6f, 0x67, 0x28, 0x2d, 0x63, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x20, 0x2a, 0x20, 0x73, 0x63, 0x72, 0x65, 0x65, 0x6e, 0x53,
-  0x68, 0x61, 0x64, 0x6f, 0x77, 0x43, 0x6f, 0x65, 0x66, 0x66, 0x20, 0x2b, 0x20, 0x76, 0x65, 0x63, 0x32, 0x28, 0x73, 0x63,
-  0x72, 0x65, 0x65, 0x6e, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x43, 0x6f, 0x65, 0x66, 0x66, 0x20, 0x2b, 0x20, 0x31, 0x2e,
-  0x30, 0x29, 0x29, 0x29, 0x3b, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x73, 0x74, 0x72, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x20, 0x6f,
-  0x66, 0x20, 0x73, 0x63, 0x72, 0x65, 0x65, 0x6e, 0x20, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x0a, 0x09, 0x61, 0x6c, 0x70,
-  0x68, 0x61, 0x20, 0x3d, 0x20, 0x6d, 0x61, 0x78, 0x28, 0x30, 0x2e, 0x34, 0x20, 0x2a, 0x20, 0x73, 0x63, 0x72, 0x65, 0x65,
-  0x6e, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x2c, 0x20, 0x61, 0x6c, 0x70, 0x68, 0x61, 0x29, 0x3b, 0x0a, 0x0a, 0x09, 0x72,
-  0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x76, 0x65, 0x63, 0x34, 0x28, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x20, 0x2a, 0x20, 0x61,
-  0x6c, 0x70, 0x68, 0x61, 0x2c, 0x20, 0x61, 0x6c, 0x70, 0x68, 0x61, 0x29, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x2f, 0x2f, 0x20,
-  0x73, 0x69, 0x6d, 0x75, 0x6c, 0x61, 0x74, 0x65, 0x20, 0x43, 0x52, 0x54, 0x20, 0x73, 0x63, 0x61, 0x6e, 0x20, 0x6c, 0x69,
-  0x6e, 0x65, 0x73, 0x0a, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x73, 0x63, 0x61, 0x6e, 0x4c, 0x69, 0x6e, 0x65, 0x73, 0x28,
-  0x76, 0x65, 0x63, 0x32, 0x20, 0x73, 0x63, 0x72, 0x65, 0x65, 0x6e, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x2c, 0x20, 0x76,
-  0x65, 0x63, 0x32, 0x20, 0x74, 0x65, 0x78, 0x53, 0x69, 0x7a, 0x65, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x66, 0x6c, 0x6f, 0x61,
-  0x74, 0x20, 0x63, 0x6f, 0x6f, 0x72, 0x64, 0x20, 0x3d, 0x20, 0x66, 0x72, 0x61, 0x63, 0x74, 0x28, 0x73, 0x63, 0x72, 0x65,
-  0x65, 0x6e, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x2e, 0x79, 0x20, 0x2a, 0x20, 0x74, 0x65, 0x78, 0x53, 0x69, 0x7a, 0x65,
-  0x2e, 0x79, 0x29, 0x20, 0x2a, 0x20, 0x32, 0x2e, 0x30, 0x20, 0x2d, 0x20, 0x31, 0x2e, 0x30, 0x3b, 0x0a, 0x09, 0x72, 0x65,
-  0x74, 0x75, 0x72, 0x6e, 0x20, 0x65, 0x78, 0x70, 0x28, 0x2d, 0x63, 0x6f, 0x6f, 0x72, 0x64, 0x20, 0x2a, 0x20, 0x63, 0x6f,
-  0x6f, 0x72, 0x64, 0x20, 0x2a, 0x20, 0x31, 0x2e, 0x37, 0x35, 0x29, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x76, 0x65, 0x63, 0x34,
-  0x20, 0x62, 0x6c, 0x75, 0x72, 0x28, 0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x72, 0x32, 0x44, 0x20, 0x69, 0x43, 0x68, 0x61,
-  0x6e, 0x6e, 0x65, 0x6c, 0x30, 0x2c, 0x20, 0x76, 0x65, 0x63, 0x32, 0x20, 0x66, 0x72, 0x61, 0x67, 0x43, 0x6f, 0x6f, 0x72,
-  0x64, 0x2c, 0x20, 0x76, 0x65, 0x63, 0x32, 0x20, 0x69, 0x52, 0x65, 0x73, 0x6f, 0x6c, 0x75, 0x74, 0x69, 0x6f, 0x6e, 0x29,
-  0x20, 0x7b, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x50, 0x49, 0x32, 0x20,
-  0x3d, 0x20, 0x36, 0x2e, 0x32, 0x38, 0x33, 0x31, 0x38, 0x35, 0x33, 0x30, 0x37, 0x31, 0x38, 0x3b, 0x20, 0x2f, 0x2f, 0x20,
-  0x50, 0x69, 0x2a, 0x32, 0x0a, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x47, 0x61, 0x75, 0x73, 0x73, 0x69, 0x61, 0x6e, 0x20, 0x62,
-  0x6c, 0x75, 0x72, 0x20, 0x73, 0x65, 0x74, 0x74, 0x69, 0x6e, 0x67, 0x73, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20,
-  0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x64, 0x69, 0x72, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x73, 0x20, 0x3d, 0x20, 0x31,
-  0x36, 0x2e, 0x30, 0x3b, 0x20, 0x2f, 0x2f, 0x20, 0x62, 0x6c, 0x75, 0x72, 0x20, 0x64, 0x69, 0x72, 0x65, 0x63, 0x74, 0x69,
-  0x6f, 0x6e, 0x73, 0x20, 0x28, 0x64, 0x65, 0x66, 0x61, 0x75, 0x6c, 0x74, 0x20, 0x31, 0x36, 0x2e, 0x30, 0x20, 0x2d, 0x20,
-  0x6d, 0x6f, 0x72, 0x65, 0x20, 0x69, 0x73, 0x20, 0x62, 0x65, 0x74, 0x74, 0x65, 0x72, 0x20, 0x62, 0x75, 0x74, 0x20, 0x73,
-  0x6c, 0x6f, 0x77, 0x65, 0x72, 0x29, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20,
-  0x71, 0x75, 0x61, 0x6c, 0x69, 0x74, 0x79, 0x20, 0x3d, 0x20, 0x34, 0x2e, 0x30, 0x3b, 0x20, 0x2f, 0x2f, 0x20, 0x62, 0x6c,
-  0x75, 0x72, 0x20, 0x71, 0x75, 0x61, 0x6c, 0x69, 0x74, 0x79, 0x20, 0x28, 0x64, 0x65, 0x66, 0x61, 0x75, 0x6c, 0x74, 0x20,
-  0x34, 0x2e, 0x30, 0x20, 0x2d, 0x20, 0x6d, 0x6f, 0x72, 0x65, 0x20, 0x69, 0x73, 0x20, 0x62, 0x65, 0x74, 0x74, 0x65, 0x72,
+  0x20, 0x64, 0x69, 0x73, 0x74, 0x6f, 0x72, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x63,
+  0x6f, 0x6c, 0x6f, 0x75, 0x72, 0x20, 0x6f, 0x66, 0x20, 0x74, 0x68, 0x65, 0x20, 0x73, 0x63, 0x72, 0x65, 0x65, 0x6e, 0x20,
+  0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x20, 0x61, 0x74, 0x20, 0x70, 0x6f, 0x73, 0x2c, 0x20, 0x6c, 0x6f, 0x6f, 0x6b,
+  0x65, 0x64, 0x20, 0x75, 0x70, 0x20, 0x69, 0x6e, 0x20, 0x74, 0x68, 0x65, 0x20, 0x70, 0x61, 0x6c, 0x65, 0x74, 0x74, 0x65,
+  0x20, 0x77, 0x68, 0x65, 0x6e, 0x20, 0x74, 0x68, 0x65, 0x0a, 0x2f, 0x2f, 0x20, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65,
+  0x20, 0x68, 0x6f, 0x6c, 0x64, 0x73, 0x20, 0x74, 0x68, 0x65, 0x20, 0x72, 0x61, 0x77, 0x20, 0x41, 0x74, 0x61, 0x72, 0x69,
+  0x20, 0x73, 0x63, 0x72, 0x65, 0x65, 0x6e, 0x0a, 0x76, 0x65, 0x63, 0x34, 0x20, 0x73, 0x63, 0x72, 0x65, 0x65, 0x6e, 0x54,
+  0x65, 0x78, 0x65, 0x6c, 0x28, 0x76, 0x65, 0x63, 0x32, 0x20, 0x70, 0x6f, 0x73, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x76, 0x65,
+  0x63, 0x34, 0x20, 0x74, 0x65, 0x78, 0x65, 0x6c, 0x20, 0x3d, 0x20, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x28, 0x6f,
+  0x75, 0x72, 0x54, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x2c, 0x20, 0x70, 0x6f, 0x73, 0x29, 0x3b, 0x0a, 0x09, 0x69, 0x66,
+  0x20, 0x28, 0x21, 0x75, 0x5f, 0x69, 0x6e, 0x64, 0x65, 0x78, 0x65, 0x64, 0x29, 0x20, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e,
+  0x20, 0x74, 0x65, 0x78, 0x65, 0x6c, 0x3b, 0x0a, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x74, 0x65, 0x78, 0x74,
+  0x75, 0x72, 0x65, 0x28, 0x75, 0x5f, 0x70, 0x61, 0x6c, 0x65, 0x74, 0x74, 0x65, 0x2c, 0x20, 0x76, 0x65, 0x63, 0x32, 0x28,
+  0x28, 0x74, 0x65, 0x78, 0x65, 0x6c, 0x2e, 0x72, 0x20, 0x2a, 0x20, 0x32, 0x35, 0x35, 0x2e, 0x30, 0x20, 0x2b, 0x20, 0x30,
+  0x2e, 0x35, 0x29, 0x20, 0x2f, 0x20, 0x32, 0x35, 0x36, 0x2e, 0x30, 0x2c, 0x20, 0x30, 0x2e, 0x35, 0x29, 0x29, 0x3b, 0x0a,
+  0x7d, 0x0a, 0x0a, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x70, 0x72, 0x6f, 0x64, 0x58, 0x59, 0x28, 0x76, 0x65, 0x63, 0x32,
+  0x20, 0x76, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x76, 0x2e, 0x78, 0x20, 0x2a, 0x20,
+  0x76, 0x2e, 0x79, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x6d, 0x61, 0x78, 0x58, 0x59, 0x28,
+  0x76, 0x65, 0x63, 0x32, 0x20, 0x76, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x6d, 0x61,
+  0x78, 0x28, 0x76, 0x2e, 0x78, 0x2c, 0x20, 0x76, 0x2e, 0x79, 0x29, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x66, 0x6c, 0x6f, 0x61,
+  0x74, 0x20, 0x73, 0x75, 0x6d, 0x32, 0x28, 0x76, 0x65, 0x63, 0x32, 0x20, 0x76, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x72, 0x65,
+  0x74, 0x75, 0x72, 0x6e, 0x20, 0x76, 0x2e, 0x78, 0x20, 0x2b, 0x20, 0x76, 0x2e, 0x79, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x76,
+  0x65, 0x63, 0x32, 0x20, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x76, 0x65, 0x4c, 0x6f, 0x67, 0x28, 0x76, 0x65, 0x63, 0x32,
+  0x20, 0x78, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x63, 0x6c, 0x61, 0x6d, 0x70, 0x28,
+  0x6c, 0x6f, 0x67, 0x28, 0x78, 0x29, 0x2c, 0x20, 0x76, 0x65, 0x63, 0x32, 0x28, 0x30, 0x2e, 0x30, 0x29, 0x2c, 0x20, 0x76,
+  0x65, 0x63, 0x32, 0x28, 0x31, 0x30, 0x30, 0x2e, 0x30, 0x29, 0x29, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x64,
+  0x72, 0x61, 0x77, 0x20, 0x43, 0x52, 0x54, 0x20, 0x6d, 0x6f, 0x6e, 0x69, 0x74, 0x6f, 0x72, 0x20, 0x66, 0x72, 0x61, 0x6d,
+  0x65, 0x20, 0x77, 0x69, 0x74, 0x68, 0x20, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x20, 0x61, 0x6e, 0x64, 0x20, 0x76, 0x69,
+  0x67, 0x6e, 0x65, 0x74, 0x74, 0x65, 0x0a, 0x76, 0x65, 0x63, 0x34, 0x20, 0x66, 0x72, 0x61, 0x6d, 0x65, 0x28, 0x76, 0x65,
+  0x63, 0x32, 0x20, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x2c, 0x20, 0x76, 0x65, 0x63, 0x32, 0x20, 0x72,
+  0x65, 0x73, 0x6f, 0x6c, 0x75, 0x74, 0x69, 0x6f, 0x6e, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x69, 0x66, 0x20, 0x28, 0x73, 0x63,
+  0x72, 0x65, 0x65, 0x6e, 0x43, 0x75, 0x72, 0x76, 0x61, 0x74, 0x75, 0x72, 0x65, 0x20, 0x3d, 0x3d, 0x20, 0x30, 0x2e, 0x30,
+  0x29, 0x20, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x76, 0x65, 0x63, 0x34, 0x28, 0x30, 0x2e, 0x30, 0x2c, 0x30, 0x2e,
+  0x30, 0x2c, 0x30, 0x2e, 0x30, 0x2c, 0x30, 0x2e, 0x30, 0x29, 0x3b, 0x0a, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x32, 0x20, 0x6d,
+  0x61, 0x72, 0x67, 0x69, 0x6e, 0x20, 0x3d, 0x20, 0x76, 0x65, 0x63, 0x32, 0x28, 0x30, 0x2e, 0x30, 0x2c, 0x20, 0x30, 0x2e,
+  0x30, 0x29, 0x3b, 0x0a, 0x09, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x66, 0x72, 0x61, 0x6d, 0x65, 0x53, 0x68, 0x61, 0x64,
+  0x6f, 0x77, 0x43, 0x6f, 0x65, 0x66, 0x66, 0x20, 0x3d, 0x20, 0x31, 0x32, 0x30, 0x2e, 0x30, 0x3b, 0x0a, 0x09, 0x66, 0x6c,
+  0x6f, 0x61, 0x74, 0x20, 0x73, 0x63, 0x72, 0x65, 0x65, 0x6e, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x43, 0x6f, 0x65, 0x66,
+  0x66, 0x20, 0x3d, 0x20, 0x31, 0x32, 0x2e, 0x30, 0x3b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x33, 0x20, 0x66, 0x72, 0x61, 0x6d,
+  0x65, 0x43, 0x6f, 0x6c, 0x6f, 0x72, 0x20, 0x3d, 0x20, 0x76, 0x65, 0x63, 0x33, 0x28, 0x30, 0x2e, 0x33, 0x2c, 0x20, 0x30,
+  0x2e, 0x33, 0x2c, 0x20, 0x30, 0x2e, 0x33, 0x35, 0x29, 0x3b, 0x0a, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x32, 0x20, 0x63, 0x6f,
+  0x6f, 0x72, 0x64, 0x73, 0x20, 0x3d, 0x20, 0x62, 0x61, 0x72, 0x72, 0x65, 0x6c, 0x28, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f,
+  0x72, 0x64, 0x73, 0x2c, 0x20, 0x72, 0x65, 0x73, 0x6f, 0x6c, 0x75, 0x74, 0x69, 0x6f, 0x6e, 0x29, 0x20, 0x2a, 0x20, 0x28,
+  0x76, 0x65, 0x63, 0x32, 0x28, 0x31, 0x2e, 0x30, 0x29, 0x20, 0x2b, 0x20, 0x6d, 0x61, 0x72, 0x67, 0x69, 0x6e, 0x20, 0x2a,
+  0x20, 0x32, 0x2e, 0x30, 0x29, 0x20, 0x2d, 0x20, 0x6d, 0x61, 0x72, 0x67, 0x69, 0x6e, 0x3b, 0x0a, 0x09, 0x74, 0x65, 0x78,
+  0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x20, 0x3d, 0x20, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x20, 0x2f,
+  0x20, 0x72, 0x65, 0x73, 0x6f, 0x6c, 0x75, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x0a, 0x09, 0x63, 0x6f, 0x6f, 0x72, 0x64, 0x73,
+  0x20, 0x3d, 0x20, 0x63, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x20, 0x2f, 0x20, 0x72, 0x65, 0x73, 0x6f, 0x6c, 0x75, 0x74, 0x69,
+  0x6f, 0x6e, 0x3b, 0x0a, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x32, 0x20, 0x76, 0x69, 0x67, 0x6e, 0x65, 0x74, 0x74, 0x65, 0x43,
+  0x6f, 0x6f, 0x72, 0x64, 0x73, 0x20, 0x3d, 0x20, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x20, 0x2a, 0x20,
+  0x28, 0x31, 0x2e, 0x30, 0x20, 0x2d, 0x20, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x2e, 0x79, 0x78, 0x29,
+  0x3b, 0x0a, 0x09, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x76, 0x69, 0x67, 0x6e, 0x65, 0x74, 0x74, 0x65, 0x20, 0x3d, 0x20,
+  0x70, 0x6f, 0x77, 0x28, 0x70, 0x72, 0x6f, 0x64, 0x58, 0x59, 0x28, 0x76, 0x69, 0x67, 0x6e, 0x65, 0x74, 0x74, 0x65, 0x43,
+  0x6f, 0x6f, 0x72, 0x64, 0x73, 0x29, 0x20, 0x2a, 0x20, 0x31, 0x35, 0x2e, 0x30, 0x2c, 0x20, 0x30, 0x2e, 0x32, 0x35, 0x29,
+  0x3b, 0x0a, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x33, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x20, 0x3d, 0x20, 0x66, 0x72, 0x61,
+  0x6d, 0x65, 0x43, 0x6f, 0x6c, 0x6f, 0x72, 0x20, 0x2a, 0x20, 0x76, 0x65, 0x63, 0x33, 0x28, 0x31, 0x2e, 0x30, 0x20, 0x2d,
+  0x20, 0x76, 0x69, 0x67, 0x6e, 0x65, 0x74, 0x74, 0x65, 0x29, 0x3b, 0x0a, 0x09, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x61,
+  0x6c, 0x70, 0x68, 0x61, 0x20, 0x3d, 0x20, 0x30, 0x2e, 0x30, 0x3b, 0x0a, 0x0a, 0x09, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20,
+  0x66, 0x72, 0x61, 0x6d, 0x65, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x20, 0x3d, 0x20, 0x6d, 0x61, 0x78, 0x58, 0x59, 0x28,
+  0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x76, 0x65, 0x4c, 0x6f, 0x67, 0x28, 0x2d, 0x63, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x20,
+  0x2a, 0x20, 0x66, 0x72, 0x61, 0x6d, 0x65, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x43, 0x6f, 0x65, 0x66, 0x66, 0x20, 0x2b,
+  0x20, 0x31, 0x2e, 0x30, 0x29, 0x20, 0x2b, 0x20, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x76, 0x65, 0x4c, 0x6f, 0x67, 0x28,
+  0x63, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x20, 0x2a, 0x20, 0x66, 0x72, 0x61, 0x6d, 0x65, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77,
+  0x43, 0x6f, 0x65, 0x66, 0x66, 0x20, 0x2d, 0x20, 0x28, 0x66, 0x72, 0x61, 0x6d, 0x65, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77,
+  0x43, 0x6f, 0x65, 0x66, 0x66, 0x20, 0x2d, 0x20, 0x31, 0x2e, 0x30, 0x29, 0x29, 0x29, 0x3b, 0x0a, 0x09, 0x66, 0x72, 0x61,
+  0x6d, 0x65, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x20, 0x3d, 0x20, 0x6d, 0x61, 0x78, 0x28, 0x73, 0x71, 0x72, 0x74, 0x28,
+  0x66, 0x72, 0x61, 0x6d, 0x65, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x29, 0x2c, 0x20, 0x30, 0x2e, 0x30, 0x29, 0x3b, 0x0a,
+  0x09, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x20, 0x2a, 0x3d, 0x20, 0x66, 0x72, 0x61, 0x6d, 0x65, 0x53, 0x68, 0x61, 0x64, 0x6f,
+  0x77, 0x3b, 0x0a, 0x09, 0x61, 0x6c, 0x70, 0x68, 0x61, 0x20, 0x3d, 0x20, 0x73, 0x75, 0x6d, 0x32, 0x28, 0x31, 0x2e, 0x30,
+  0x20, 0x2d, 0x20, 0x73, 0x74, 0x65, 0x70, 0x28, 0x76, 0x65, 0x63, 0x32, 0x28, 0x30, 0x2e, 0x30, 0x29, 0x2c, 0x20, 0x63,
+  0x6f, 0x6f, 0x72, 0x64, 0x73, 0x29, 0x20, 0x2b, 0x20, 0x73, 0x74, 0x65, 0x70, 0x28, 0x76, 0x65, 0x63, 0x32, 0x28, 0x31,
+  0x2e, 0x30, 0x29, 0x2c, 0x20, 0x63, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x29, 0x29, 0x3b, 0x0a, 0x09, 0x61, 0x6c, 0x70, 0x68,
+  0x61, 0x20, 0x3d, 0x20, 0x63, 0x6c, 0x61, 0x6d, 0x70, 0x28, 0x61, 0x6c, 0x70, 0x68, 0x61, 0x2c, 0x20, 0x30, 0x2e, 0x30,
+  0x2c, 0x20, 0x31, 0x2e, 0x30, 0x29, 0x3b, 0x0a, 0x0a, 0x09, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x73, 0x63, 0x72, 0x65,
+  0x65, 0x6e, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x20, 0x3d, 0x20, 0x31, 0x2e, 0x30, 0x20, 0x2d, 0x20, 0x70, 0x72, 0x6f,
+  0x64, 0x58, 0x59, 0x28, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x76, 0x65, 0x4c, 0x6f, 0x67, 0x28, 0x63, 0x6f, 0x6f, 0x72,
+  0x64, 0x73, 0x20, 0x2a, 0x20, 0x73, 0x63, 0x72, 0x65, 0x65, 0x6e, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x43, 0x6f, 0x65,
+  0x66, 0x66, 0x20, 0x2b, 0x20, 0x76, 0x65, 0x63, 0x32, 0x28, 0x31, 0x2e, 0x30, 0x29, 0x29, 0x20, 0x2a, 0x20, 0x70, 0x6f,
+  0x73, 0x69, 0x74, 0x69, 0x76, 0x65, 0x4c, 0x6f, 0x67, 0x28, 0x2d, 0x63, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x20, 0x2a, 0x20,
+  0x73, 0x63, 0x72, 0x65, 0x65, 0x6e, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x43, 0x6f, 0x65, 0x66, 0x66, 0x20, 0x2b, 0x20,
+  0x76, 0x65, 0x63, 0x32, 0x28, 0x73, 0x63, 0x72, 0x65, 0x65, 0x6e, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x43, 0x6f, 0x65,
+  0x66, 0x66, 0x20, 0x2b, 0x20, 0x31, 0x2e, 0x30, 0x29, 0x29, 0x29, 0x3b, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x73, 0x74, 0x72,
+  0x65, 0x6e, 0x67, 0x74, 0x68, 0x20, 0x6f, 0x66, 0x20, 0x73, 0x63, 0x72, 0x65, 0x65, 0x6e, 0x20, 0x73, 0x68, 0x61, 0x64,
+  0x6f, 0x77, 0x0a, 0x09, 0x61, 0x6c, 0x70, 0x68, 0x61, 0x20, 0x3d, 0x20, 0x6d, 0x61, 0x78, 0x28, 0x30, 0x2e, 0x34, 0x20,
+  0x2a, 0x20, 0x73, 0x63, 0x72, 0x65, 0x65, 0x6e, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x2c, 0x20, 0x61, 0x6c, 0x70, 0x68,
+  0x61, 0x29, 0x3b, 0x0a, 0x0a, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x76, 0x65, 0x63, 0x34, 0x28, 0x63, 0x6f,
+  0x6c, 0x6f, 0x72, 0x20, 0x2a, 0x20, 0x61, 0x6c, 0x70, 0x68, 0x61, 0x2c, 0x20, 0x61, 0x6c, 0x70, 0x68, 0x61, 0x29, 0x3b,
+  0x0a, 0x7d, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x73, 0x69, 0x6d, 0x75, 0x6c, 0x61, 0x74, 0x65, 0x20, 0x43, 0x52, 0x54, 0x20,
+  0x73, 0x63, 0x61, 0x6e, 0x20, 0x6c, 0x69, 0x6e, 0x65, 0x73, 0x0a, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x73, 0x63, 0x61,
+  0x6e, 0x4c, 0x69, 0x6e, 0x65, 0x73, 0x28, 0x76, 0x65, 0x63, 0x32, 0x20, 0x73, 0x63, 0x72, 0x65, 0x65, 0x6e, 0x43, 0x6f,
+  0x6f, 0x72, 0x64, 0x73, 0x2c, 0x20, 0x76, 0x65, 0x63, 0x32, 0x20, 0x74, 0x65, 0x78, 0x53, 0x69, 0x7a, 0x65, 0x29, 0x20,
+  0x7b, 0x0a, 0x09, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x63, 0x6f, 0x6f, 0x72, 0x64, 0x20, 0x3d, 0x20, 0x66, 0x72, 0x61,
+  0x63, 0x74, 0x28, 0x73, 0x63, 0x72, 0x65, 0x65, 0x6e, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x2e, 0x79, 0x20, 0x2a, 0x20,
+  0x74, 0x65, 0x78, 0x53, 0x69, 0x7a, 0x65, 0x2e, 0x79, 0x29, 0x20, 0x2a, 0x20, 0x32, 0x2e, 0x30, 0x20, 0x2d, 0x20, 0x31,
+  0x2e, 0x30, 0x3b, 0x0a, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x65, 0x78, 0x70, 0x28, 0x2d, 0x63, 0x6f, 0x6f,
+  0x72, 0x64, 0x20, 0x2a, 0x20, 0x63, 0x6f, 0x6f, 0x72, 0x64, 0x20, 0x2a, 0x20, 0x31, 0x2e, 0x37, 0x35, 0x29, 0x3b, 0x0a,
+  0x7d, 0x0a, 0x0a, 0x76, 0x65, 0x63, 0x34, 0x20, 0x62, 0x6c, 0x75, 0x72, 0x28, 0x76, 0x65, 0x63, 0x32, 0x20, 0x66, 0x72,
+  0x61, 0x67, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x2c, 0x20, 0x76, 0x65, 0x63, 0x32, 0x20, 0x69, 0x52, 0x65, 0x73, 0x6f, 0x6c,
+  0x75, 0x74, 0x69, 0x6f, 0x6e, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61,
+  0x74, 0x20, 0x50, 0x49, 0x32, 0x20, 0x3d, 0x20, 0x36, 0x2e, 0x32, 0x38, 0x33, 0x31, 0x38, 0x35, 0x33, 0x30, 0x37, 0x31,
+  0x38, 0x3b, 0x20, 0x2f, 0x2f, 0x20, 0x50, 0x69, 0x2a, 0x32, 0x0a, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x47, 0x61, 0x75, 0x73,
+  0x73, 0x69, 0x61, 0x6e, 0x20, 0x62, 0x6c, 0x75, 0x72, 0x20, 0x73, 0x65, 0x74, 0x74, 0x69, 0x6e, 0x67, 0x73, 0x0a, 0x09,
+  0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x64, 0x69, 0x72, 0x65, 0x63, 0x74, 0x69, 0x6f,
+  0x6e, 0x73, 0x20, 0x3d, 0x20, 0x31, 0x36, 0x2e, 0x30, 0x3b, 0x20, 0x2f, 0x2f, 0x20, 0x62, 0x6c, 0x75, 0x72, 0x20, 0x64,
+  0x69, 0x72, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x73, 0x20, 0x28, 0x64, 0x65, 0x66, 0x61, 0x75, 0x6c, 0x74, 0x20, 0x31,
+  0x36, 0x2e, 0x30, 0x20, 0x2d, 0x20, 0x6d, 0x6f, 0x72, 0x65, 0x20, 0x69, 0x73, 0x20, 0x62, 0x65, 0x74, 0x74, 0x65, 0x72,
   0x20, 0x62, 0x75, 0x74, 0x20, 0x73, 0x6c, 0x6f, 0x77, 0x65, 0x72, 0x29, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20,
-  0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x73, 0x69, 0x7a, 0x65, 0x20, 0x3d, 0x20, 0x33, 0x2e, 0x30, 0x3b, 0x20, 0x2f, 0x2f,
-  0x20, 0x62, 0x6c, 0x75, 0x72, 0x20, 0x73, 0x69, 0x7a, 0x65, 0x20, 0x28, 0x72, 0x61, 0x64, 0x69, 0x75, 0x73, 0x29, 0x0a,
-  0x0a, 0x09, 0x76, 0x65, 0x63, 0x32, 0x20, 0x72, 0x61, 0x64, 0x69, 0x75, 0x73, 0x20, 0x3d, 0x20, 0x73, 0x69, 0x7a, 0x65,
-  0x20, 0x2f, 0x20, 0x69, 0x52, 0x65, 0x73, 0x6f, 0x6c, 0x75, 0x74, 0x69, 0x6f, 0x6e, 0x2e, 0x78, 0x79, 0x3b, 0x0a, 0x0a,
-  0x09, 0x2f, 0x2f, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x64, 0x20, 0x70, 0x69, 0x78, 0x65, 0x6c,
-  0x20, 0x63, 0x6f, 0x6f, 0x72, 0x64, 0x69, 0x6e, 0x61, 0x74, 0x65, 0x73, 0x20, 0x28, 0x66, 0x72, 0x6f, 0x6d, 0x20, 0x30,
-  0x20, 0x74, 0x6f, 0x20, 0x31, 0x29, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x32, 0x20, 0x75, 0x76, 0x20, 0x3d, 0x20, 0x66, 0x72,
-  0x61, 0x67, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x3b, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x70, 0x69, 0x78, 0x65, 0x6c, 0x20, 0x63,
-  0x6f, 0x6c, 0x6f, 0x72, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x34, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x20, 0x3d, 0x20, 0x74,
-  0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x28, 0x69, 0x43, 0x68, 0x61, 0x6e, 0x6e, 0x65, 0x6c, 0x30, 0x2c, 0x20, 0x75, 0x76,
-  0x29, 0x3b, 0x0a, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x62, 0x6c, 0x75, 0x72, 0x20, 0x63, 0x61, 0x6c, 0x63, 0x75, 0x6c, 0x61,
-  0x74, 0x69, 0x6f, 0x6e, 0x73, 0x0a, 0x09, 0x66, 0x6f, 0x72, 0x20, 0x28, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x64, 0x20,
-  0x3d, 0x20, 0x30, 0x2e, 0x30, 0x3b, 0x20, 0x64, 0x20, 0x3c, 0x20, 0x50, 0x49, 0x32, 0x3b, 0x20, 0x64, 0x20, 0x2b, 0x3d,
-  0x20, 0x50, 0x49, 0x32, 0x20, 0x2f, 0x20, 0x64, 0x69, 0x72, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x73, 0x29, 0x20, 0x7b,
-  0x0a, 0x09, 0x09, 0x66, 0x6f, 0x72, 0x20, 0x28, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x69, 0x20, 0x3d, 0x20, 0x31, 0x2e,
-  0x30, 0x20, 0x2f, 0x20, 0x71, 0x75, 0x61, 0x6c, 0x69, 0x74, 0x79, 0x3b, 0x20, 0x69, 0x20, 0x3c, 0x3d, 0x20, 0x31, 0x2e,
-  0x30, 0x3b, 0x20, 0x69, 0x20, 0x2b, 0x3d, 0x20, 0x31, 0x2e, 0x30, 0x20, 0x2f, 0x20, 0x71, 0x75, 0x61, 0x6c, 0x69, 0x74,
-  0x79, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x20, 0x2b, 0x3d, 0x20, 0x74, 0x65, 0x78,
-  0x74, 0x75, 0x72, 0x65, 0x28, 0x69, 0x43, 0x68, 0x61, 0x6e, 0x6e, 0x65, 0x6c, 0x30, 0x2c, 0x20, 0x75, 0x76, 0x20, 0x2b,
-  0x20, 0x76, 0x65, 0x63, 0x32, 0x28, 0x63, 0x6f, 0x73, 0x28, 0x64, 0x29, 0x2c, 0x20, 0x73, 0x69, 0x6e, 0x28, 0x64, 0x29,
-  0x29, 0x20, 0x2a, 0x20, 0x72, 0x61, 0x64, 0x69, 0x75, 0x73, 0x20, 0x2a, 0x20, 0x69, 0x29, 0x3b, 0x09, 0x09, 0x0a, 0x09,
-  0x09, 0x7d, 0x0a, 0x09, 0x7d, 0x0a, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x6f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x0a, 0x09, 0x63,
-  0x6f, 0x6c, 0x6f, 0x72, 0x20, 0x2f, 0x3d, 0x20, 0x71, 0x75, 0x61, 0x6c, 0x69, 0x74, 0x79, 0x20, 0x2a, 0x20, 0x64, 0x69,
-  0x72, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x73, 0x3b, 0x0a, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x63, 0x6f,
-  0x6c, 0x6f, 0x72, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x76, 0x65, 0x63, 0x33, 0x20, 0x67, 0x65, 0x74, 0x5f, 0x74, 0x65, 0x78,
-  0x5f, 0x70, 0x69, 0x78, 0x65, 0x6c, 0x28, 0x76, 0x65, 0x63, 0x32, 0x20, 0x70, 0x6f, 0x73, 0x2c, 0x20, 0x76, 0x65, 0x63,
-  0x32, 0x20, 0x74, 0x65, 0x78, 0x53, 0x69, 0x7a, 0x65, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x32, 0x20, 0x70,
-  0x69, 0x78, 0x20, 0x3d, 0x20, 0x31, 0x2e, 0x30, 0x20, 0x2f, 0x20, 0x74, 0x65, 0x78, 0x53, 0x69, 0x7a, 0x65, 0x3b, 0x0a,
-  0x09, 0x76, 0x65, 0x63, 0x32, 0x20, 0x70, 0x20, 0x3d, 0x20, 0x70, 0x6f, 0x73, 0x20, 0x2d, 0x20, 0x6d, 0x6f, 0x64, 0x28,
-  0x70, 0x6f, 0x73, 0x2c, 0x20, 0x70, 0x69, 0x78, 0x29, 0x20, 0x2b, 0x20, 0x70, 0x69, 0x78, 0x20, 0x2a, 0x20, 0x30, 0x2e,
-  0x35, 0x3b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x33, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x31, 0x20, 0x3d, 0x20, 0x74, 0x65,
-  0x78, 0x74, 0x75, 0x72, 0x65, 0x28, 0x6f, 0x75, 0x72, 0x54, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x2c, 0x20, 0x70, 0x29,
-  0x2e, 0x72, 0x67, 0x62, 0x3b, 0x0a, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x31,
-  0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x76, 0x65, 0x63, 0x34, 0x20, 0x67, 0x65, 0x74, 0x5f, 0x70, 0x69, 0x78, 0x65, 0x6c, 0x5f,
-  0x69, 0x6e, 0x74, 0x65, 0x6e, 0x73, 0x69, 0x74, 0x79, 0x28, 0x76, 0x65, 0x63, 0x32, 0x20, 0x70, 0x6f, 0x73, 0x2c, 0x20,
-  0x76, 0x65, 0x63, 0x32, 0x20, 0x6e, 0x65, 0x78, 0x74, 0x2c, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6c, 0x65, 0x66, 0x74,
-  0x2c, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6d, 0x69, 0x64, 0x64, 0x6c, 0x65, 0x2c, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20,
-  0x72, 0x69, 0x67, 0x68, 0x74, 0x2c, 0x20, 0x76, 0x65, 0x63, 0x32, 0x20, 0x74, 0x65, 0x78, 0x53, 0x69, 0x7a, 0x65, 0x29,
-  0x20, 0x7b, 0x0a, 0x09, 0x69, 0x66, 0x20, 0x28, 0x75, 0x5f, 0x70, 0x69, 0x78, 0x65, 0x6c, 0x53, 0x70, 0x72, 0x65, 0x61,
-  0x64, 0x20, 0x3c, 0x3d, 0x20, 0x30, 0x2e, 0x30, 0x29, 0x20, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x76, 0x65, 0x63,
-  0x34, 0x28, 0x6d, 0x69, 0x64, 0x64, 0x6c, 0x65, 0x2c, 0x20, 0x31, 0x2e, 0x30, 0x29, 0x3b, 0x0a, 0x0a, 0x09, 0x76, 0x65,
-  0x63, 0x32, 0x20, 0x70, 0x69, 0x78, 0x20, 0x3d, 0x20, 0x31, 0x2e, 0x30, 0x20, 0x2f, 0x20, 0x74, 0x65, 0x78, 0x53, 0x69,
-  0x7a, 0x65, 0x3b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x32, 0x20, 0x63, 0x65, 0x6e, 0x74, 0x65, 0x72, 0x20, 0x3d, 0x20, 0x70,
-  0x6f, 0x73, 0x20, 0x2d, 0x20, 0x6d, 0x6f, 0x64, 0x28, 0x70, 0x6f, 0x73, 0x2c, 0x20, 0x70, 0x69, 0x78, 0x29, 0x20, 0x2b,
-  0x20, 0x70, 0x69, 0x78, 0x20, 0x2a, 0x20, 0x30, 0x2e, 0x35, 0x3b, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x6e, 0x6f, 0x72, 0x6d,
-  0x61, 0x6c, 0x69, 0x7a, 0x65, 0x20, 0x64, 0x69, 0x73, 0x74, 0x61, 0x6e, 0x63, 0x65, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x32,
-  0x20, 0x64, 0x69, 0x66, 0x66, 0x20, 0x3d, 0x20, 0x28, 0x6e, 0x65, 0x78, 0x74, 0x20, 0x2d, 0x20, 0x63, 0x65, 0x6e, 0x74,
-  0x65, 0x72, 0x29, 0x20, 0x2f, 0x20, 0x28, 0x70, 0x69, 0x78, 0x20, 0x2a, 0x20, 0x30, 0x2e, 0x35, 0x29, 0x3b, 0x0a, 0x09,
-  0x76, 0x65, 0x63, 0x32, 0x20, 0x73, 0x71, 0x75, 0x61, 0x72, 0x65, 0x20, 0x3d, 0x20, 0x64, 0x69, 0x66, 0x66, 0x20, 0x2a,
-  0x20, 0x64, 0x69, 0x66, 0x66, 0x3b, 0x0a, 0x09, 0x73, 0x71, 0x75, 0x61, 0x72, 0x65, 0x2e, 0x79, 0x20, 0x2f, 0x3d, 0x20,
-  0x32, 0x2e, 0x30, 0x3b, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x74, 0x68,
-  0x72, 0x65, 0x73, 0x68, 0x6f, 0x6c, 0x64, 0x20, 0x3d, 0x20, 0x30, 0x2e, 0x30, 0x31, 0x3b, 0x0a, 0x09, 0x62, 0x6f, 0x6f,
-  0x6c, 0x20, 0x6c, 0x65, 0x66, 0x74, 0x4f, 0x6e, 0x20, 0x3d, 0x20, 0x64, 0x6f, 0x74, 0x28, 0x6c, 0x65, 0x66, 0x74, 0x2c,
-  0x20, 0x6c, 0x65, 0x66, 0x74, 0x29, 0x20, 0x3e, 0x20, 0x74, 0x68, 0x72, 0x65, 0x73, 0x68, 0x6f, 0x6c, 0x64, 0x3b, 0x0a,
-  0x09, 0x62, 0x6f, 0x6f, 0x6c, 0x20, 0x72, 0x69, 0x67, 0x68, 0x74, 0x4f, 0x6e, 0x20, 0x3d, 0x20, 0x64, 0x6f, 0x74, 0x28,
-  0x72, 0x69, 0x67, 0x68, 0x74, 0x2c, 0x20, 0x72, 0x69, 0x67, 0x68, 0x74, 0x29, 0x20, 0x3e, 0x20, 0x74, 0x68, 0x72, 0x65,
-  0x73, 0x68, 0x6f, 0x6c, 0x64, 0x3b, 0x0a, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x33, 0x20, 0x66, 0x61, 0x63, 0x74, 0x6f, 0x72,
-  0x20, 0x3d, 0x20, 0x6d, 0x69, 0x64, 0x64, 0x6c, 0x65, 0x3b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x33, 0x20, 0x68, 0x6f, 0x72,
-  0x7a, 0x20, 0x3d, 0x20, 0x76, 0x65, 0x63, 0x33, 0x28, 0x73, 0x71, 0x75, 0x61, 0x72, 0x65, 0x2e, 0x78, 0x2c, 0x20, 0x73,
-  0x71, 0x75, 0x61, 0x72, 0x65, 0x2e, 0x78, 0x2c, 0x20, 0x73, 0x71, 0x75, 0x61, 0x72, 0x65, 0x2e, 0x78, 0x29, 0x3b, 0x0a,
-  0x09, 0x76, 0x65, 0x63, 0x33, 0x20, 0x76, 0x65, 0x72, 0x74, 0x20, 0x3d, 0x20, 0x76, 0x65, 0x63, 0x33, 0x28, 0x73, 0x71,
-  0x75, 0x61, 0x72, 0x65, 0x2e, 0x79, 0x2c, 0x20, 0x73, 0x71, 0x75, 0x61, 0x72, 0x65, 0x2e, 0x79, 0x2c, 0x20, 0x73, 0x71,
-  0x75, 0x61, 0x72, 0x65, 0x2e, 0x79, 0x29, 0x3b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x33, 0x20, 0x74, 0x72, 0x61, 0x6e, 0x73,
-  0x70, 0x61, 0x72, 0x65, 0x6e, 0x63, 0x79, 0x3b, 0x0a, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x73, 0x69, 0x6d, 0x75, 0x6c, 0x61,
-  0x74, 0x65, 0x20, 0x63, 0x6f, 0x6e, 0x74, 0x69, 0x6e, 0x75, 0x6f, 0x75, 0x73, 0x20, 0x72, 0x61, 0x73, 0x74, 0x65, 0x72,
-  0x20, 0x6c, 0x69, 0x6e, 0x65, 0x20, 0x62, 0x65, 0x74, 0x77, 0x65, 0x65, 0x6e, 0x20, 0x61, 0x64, 0x6a, 0x61, 0x63, 0x65,
-  0x6e, 0x74, 0x20, 0x70, 0x69, 0x78, 0x65, 0x6c, 0x73, 0x20, 0x62, 0x79, 0x20, 0x69, 0x67, 0x6e, 0x6f, 0x72, 0x69, 0x6e,
-  0x67, 0x20, 0x64, 0x69, 0x66, 0x66, 0x2e, 0x78, 0x20, 0x64, 0x69, 0x73, 0x74, 0x61, 0x6e, 0x63, 0x65, 0x0a, 0x09, 0x69,
-  0x66, 0x20, 0x28, 0x6c, 0x65, 0x66, 0x74, 0x4f, 0x6e, 0x20, 0x26, 0x26, 0x20, 0x64, 0x69, 0x66, 0x66, 0x2e, 0x78, 0x20,
-  0x3c, 0x20, 0x30, 0x2e, 0x30, 0x20, 0x26, 0x26, 0x20, 0x64, 0x69, 0x66, 0x66, 0x2e, 0x78, 0x20, 0x3e, 0x20, 0x2d, 0x31,
-  0x2e, 0x30, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x09, 0x76, 0x65, 0x63, 0x33, 0x20, 0x64, 0x69, 0x66, 0x66, 0x20, 0x3d, 0x20,
-  0x61, 0x62, 0x73, 0x28, 0x6d, 0x69, 0x64, 0x64, 0x6c, 0x65, 0x20, 0x2d, 0x20, 0x6c, 0x65, 0x66, 0x74, 0x29, 0x3b, 0x0a,
+  0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x71, 0x75, 0x61, 0x6c, 0x69, 0x74, 0x79, 0x20, 0x3d, 0x20, 0x34, 0x2e, 0x30, 0x3b,
+  0x20, 0x2f, 0x2f, 0x20, 0x62, 0x6c, 0x75, 0x72, 0x20, 0x71, 0x75, 0x61, 0x6c, 0x69, 0x74, 0x79, 0x20, 0x28, 0x64, 0x65,
+  0x66, 0x61, 0x75, 0x6c, 0x74, 0x20, 0x34, 0x2e, 0x30, 0x20, 0x2d, 0x20, 0x6d, 0x6f, 0x72, 0x65, 0x20, 0x69, 0x73, 0x20,
+  0x62, 0x65, 0x74, 0x74, 0x65, 0x72, 0x20, 0x62, 0x75, 0x74, 0x20, 0x73, 0x6c, 0x6f, 0x77, 0x65, 0x72, 0x29, 0x0a, 0x09,
+  0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x73, 0x69, 0x7a, 0x65, 0x20, 0x3d, 0x20, 0x33,
+  0x2e, 0x30, 0x3b, 0x20, 0x2f, 0x2f, 0x20, 0x62, 0x6c, 0x75, 0x72, 0x20, 0x73, 0x69, 0x7a, 0x65, 0x20, 0x28, 0x72, 0x61,
+  0x64, 0x69, 0x75, 0x73, 0x29, 0x0a, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x32, 0x20, 0x72, 0x61, 0x64, 0x69, 0x75, 0x73, 0x20,
+  0x3d, 0x20, 0x73, 0x69, 0x7a, 0x65, 0x20, 0x2f, 0x20, 0x69, 0x52, 0x65, 0x73, 0x6f, 0x6c, 0x75, 0x74, 0x69, 0x6f, 0x6e,
+  0x2e, 0x78, 0x79, 0x3b, 0x0a, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x64,
+  0x20, 0x70, 0x69, 0x78, 0x65, 0x6c, 0x20, 0x63, 0x6f, 0x6f, 0x72, 0x64, 0x69, 0x6e, 0x61, 0x74, 0x65, 0x73, 0x20, 0x28,
+  0x66, 0x72, 0x6f, 0x6d, 0x20, 0x30, 0x20, 0x74, 0x6f, 0x20, 0x31, 0x29, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x32, 0x20, 0x75,
+  0x76, 0x20, 0x3d, 0x20, 0x66, 0x72, 0x61, 0x67, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x3b, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x70,
+  0x69, 0x78, 0x65, 0x6c, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x34, 0x20, 0x63, 0x6f, 0x6c,
+  0x6f, 0x72, 0x20, 0x3d, 0x20, 0x73, 0x63, 0x72, 0x65, 0x65, 0x6e, 0x54, 0x65, 0x78, 0x65, 0x6c, 0x28, 0x75, 0x76, 0x29,
+  0x3b, 0x0a, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x62, 0x6c, 0x75, 0x72, 0x20, 0x63, 0x61, 0x6c, 0x63, 0x75, 0x6c, 0x61, 0x74,
+  0x69, 0x6f, 0x6e, 0x73, 0x0a, 0x09, 0x66, 0x6f, 0x72, 0x20, 0x28, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x64, 0x20, 0x3d,
+  0x20, 0x30, 0x2e, 0x30, 0x3b, 0x20, 0x64, 0x20, 0x3c, 0x20, 0x50, 0x49, 0x32, 0x3b, 0x20, 0x64, 0x20, 0x2b, 0x3d, 0x20,
+  0x50, 0x49, 0x32, 0x20, 0x2f, 0x20, 0x64, 0x69, 0x72, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x73, 0x29, 0x20, 0x7b, 0x0a,
+  0x09, 0x09, 0x66, 0x6f, 0x72, 0x20, 0x28, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x69, 0x20, 0x3d, 0x20, 0x31, 0x2e, 0x30,
+  0x20, 0x2f, 0x20, 0x71, 0x75, 0x61, 0x6c, 0x69, 0x74, 0x79, 0x3b, 0x20, 0x69, 0x20, 0x3c, 0x3d, 0x20, 0x31, 0x2e, 0x30,
+  0x3b, 0x20, 0x69, 0x20, 0x2b, 0x3d, 0x20, 0x31, 0x2e, 0x30, 0x20, 0x2f, 0x20, 0x71, 0x75, 0x61, 0x6c, 0x69, 0x74, 0x79,
+  0x29, 0x20, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x20, 0x2b, 0x3d, 0x20, 0x73, 0x63, 0x72, 0x65,
+  0x65, 0x6e, 0x54, 0x65, 0x78, 0x65, 0x6c, 0x28, 0x75, 0x76, 0x20, 0x2b, 0x20, 0x76, 0x65, 0x63, 0x32, 0x28, 0x63, 0x6f,
+  0x73, 0x28, 0x64, 0x29, 0x2c, 0x20, 0x73, 0x69, 0x6e, 0x28, 0x64, 0x29, 0x29, 0x20, 0x2a, 0x20, 0x72, 0x61, 0x64, 0x69,
+  0x75, 0x73, 0x20, 0x2a, 0x20, 0x69, 0x29, 0x3b, 0x09, 0x09, 0x0a, 0x09, 0x09, 0x7d, 0x0a, 0x09, 0x7d, 0x0a, 0x0a, 0x09,
+  0x2f, 0x2f, 0x20, 0x6f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x0a, 0x09, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x20, 0x2f, 0x3d, 0x20,
+  0x71, 0x75, 0x61, 0x6c, 0x69, 0x74, 0x79, 0x20, 0x2a, 0x20, 0x64, 0x69, 0x72, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x73,
+  0x3b, 0x0a, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a,
+  0x76, 0x65, 0x63, 0x33, 0x20, 0x67, 0x65, 0x74, 0x5f, 0x74, 0x65, 0x78, 0x5f, 0x70, 0x69, 0x78, 0x65, 0x6c, 0x28, 0x76,
+  0x65, 0x63, 0x32, 0x20, 0x70, 0x6f, 0x73, 0x2c, 0x20, 0x76, 0x65, 0x63, 0x32, 0x20, 0x74, 0x65, 0x78, 0x53, 0x69, 0x7a,
+  0x65, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x32, 0x20, 0x70, 0x69, 0x78, 0x20, 0x3d, 0x20, 0x31, 0x2e, 0x30,
+  0x20, 0x2f, 0x20, 0x74, 0x65, 0x78, 0x53, 0x69, 0x7a, 0x65, 0x3b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x32, 0x20, 0x70, 0x20,
+  0x3d, 0x20, 0x70, 0x6f, 0x73, 0x20, 0x2d, 0x20, 0x6d, 0x6f, 0x64, 0x28, 0x70, 0x6f, 0x73, 0x2c, 0x20, 0x70, 0x69, 0x78,
+  0x29, 0x20, 0x2b, 0x20, 0x70, 0x69, 0x78, 0x20, 0x2a, 0x20, 0x30, 0x2e, 0x35, 0x3b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x33,
+  0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x31, 0x20, 0x3d, 0x20, 0x73, 0x63, 0x72, 0x65, 0x65, 0x6e, 0x54, 0x65, 0x78, 0x65,
+  0x6c, 0x28, 0x70, 0x29, 0x2e, 0x72, 0x67, 0x62, 0x3b, 0x0a, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x63, 0x6f,
+  0x6c, 0x6f, 0x72, 0x31, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x76, 0x65, 0x63, 0x34, 0x20, 0x67, 0x65, 0x74, 0x5f, 0x70, 0x69,
+  0x78, 0x65, 0x6c, 0x5f, 0x69, 0x6e, 0x74, 0x65, 0x6e, 0x73, 0x69, 0x74, 0x79, 0x28, 0x76, 0x65, 0x63, 0x32, 0x20, 0x70,
+  0x6f, 0x73, 0x2c, 0x20, 0x76, 0x65, 0x63, 0x32, 0x20, 0x6e, 0x65, 0x78, 0x74, 0x2c, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20,
+  0x6c, 0x65, 0x66, 0x74, 0x2c, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x6d, 0x69, 0x64, 0x64, 0x6c, 0x65, 0x2c, 0x20, 0x76,
+  0x65, 0x63, 0x33, 0x20, 0x72, 0x69, 0x67, 0x68, 0x74, 0x2c, 0x20, 0x76, 0x65, 0x63, 0x32, 0x20, 0x74, 0x65, 0x78, 0x53,
+  0x69, 0x7a, 0x65, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x69, 0x66, 0x20, 0x28, 0x75, 0x5f, 0x70, 0x69, 0x78, 0x65, 0x6c, 0x53,
+  0x70, 0x72, 0x65, 0x61, 0x64, 0x20, 0x3c, 0x3d, 0x20, 0x30, 0x2e, 0x30, 0x29, 0x20, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e,
+  0x20, 0x76, 0x65, 0x63, 0x34, 0x28, 0x6d, 0x69, 0x64, 0x64, 0x6c, 0x65, 0x2c, 0x20, 0x31, 0x2e, 0x30, 0x29, 0x3b, 0x0a,
+  0x0a, 0x09, 0x76, 0x65, 0x63, 0x32, 0x20, 0x70, 0x69, 0x78, 0x20, 0x3d, 0x20, 0x31, 0x2e, 0x30, 0x20, 0x2f, 0x20, 0x74,
+  0x65, 0x78, 0x53, 0x69, 0x7a, 0x65, 0x3b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x32, 0x20, 0x63, 0x65, 0x6e, 0x74, 0x65, 0x72,
+  0x20, 0x3d, 0x20, 0x70, 0x6f, 0x73, 0x20, 0x2d, 0x20, 0x6d, 0x6f, 0x64, 0x28, 0x70, 0x6f, 0x73, 0x2c, 0x20, 0x70, 0x69,
+  0x78, 0x29, 0x20, 0x2b, 0x20, 0x70, 0x69, 0x78, 0x20, 0x2a, 0x20, 0x30, 0x2e, 0x35, 0x3b, 0x0a, 0x09, 0x2f, 0x2f, 0x20,
+  0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x20, 0x64, 0x69, 0x73, 0x74, 0x61, 0x6e, 0x63, 0x65, 0x0a, 0x09,
+  0x76, 0x65, 0x63, 0x32, 0x20, 0x64, 0x69, 0x66, 0x66, 0x20, 0x3d, 0x20, 0x28, 0x6e, 0x65, 0x78, 0x74, 0x20, 0x2d, 0x20,
+  0x63, 0x65, 0x6e, 0x74, 0x65, 0x72, 0x29, 0x20, 0x2f, 0x20, 0x28, 0x70, 0x69, 0x78, 0x20, 0x2a, 0x20, 0x30, 0x2e, 0x35,
+  0x29, 0x3b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x32, 0x20, 0x73, 0x71, 0x75, 0x61, 0x72, 0x65, 0x20, 0x3d, 0x20, 0x64, 0x69,
+  0x66, 0x66, 0x20, 0x2a, 0x20, 0x64, 0x69, 0x66, 0x66, 0x3b, 0x0a, 0x09, 0x73, 0x71, 0x75, 0x61, 0x72, 0x65, 0x2e, 0x79,
+  0x20, 0x2f, 0x3d, 0x20, 0x32, 0x2e, 0x30, 0x3b, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6c, 0x6f, 0x61,
+  0x74, 0x20, 0x74, 0x68, 0x72, 0x65, 0x73, 0x68, 0x6f, 0x6c, 0x64, 0x20, 0x3d, 0x20, 0x30, 0x2e, 0x30, 0x31, 0x3b, 0x0a,
+  0x09, 0x62, 0x6f, 0x6f, 0x6c, 0x20, 0x6c, 0x65, 0x66, 0x74, 0x4f, 0x6e, 0x20, 0x3d, 0x20, 0x64, 0x6f, 0x74, 0x28, 0x6c,
+  0x65, 0x66, 0x74, 0x2c, 0x20, 0x6c, 0x65, 0x66, 0x74, 0x29, 0x20, 0x3e, 0x20, 0x74, 0x68, 0x72, 0x65, 0x73, 0x68, 0x6f,
+  0x6c, 0x64, 0x3b, 0x0a, 0x09, 0x62, 0x6f, 0x6f, 0x6c, 0x20, 0x72, 0x69, 0x67, 0x68, 0x74, 0x4f, 0x6e, 0x20, 0x3d, 0x20,
+  0x64, 0x6f, 0x74, 0x28, 0x72, 0x69, 0x67, 0x68, 0x74, 0x2c, 0x20, 0x72, 0x69, 0x67, 0x68, 0x74, 0x29, 0x20, 0x3e, 0x20,
+  0x74, 0x68, 0x72, 0x65, 0x73, 0x68, 0x6f, 0x6c, 0x64, 0x3b, 0x0a, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x33, 0x20, 0x66, 0x61,
+  0x63, 0x74, 0x6f, 0x72, 0x20, 0x3d, 0x20, 0x6d, 0x69, 0x64, 0x64, 0x6c, 0x65, 0x3b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x33,
+  0x20, 0x68, 0x6f, 0x72, 0x7a, 0x20, 0x3d, 0x20, 0x76, 0x65, 0x63, 0x33, 0x28, 0x73, 0x71, 0x75, 0x61, 0x72, 0x65, 0x2e,
+  0x78, 0x2c, 0x20, 0x73, 0x71, 0x75, 0x61, 0x72, 0x65, 0x2e, 0x78, 0x2c, 0x20, 0x73, 0x71, 0x75, 0x61, 0x72, 0x65, 0x2e,
+  0x78, 0x29, 0x3b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x33, 0x20, 0x76, 0x65, 0x72, 0x74, 0x20, 0x3d, 0x20, 0x76, 0x65, 0x63,
+  0x33, 0x28, 0x73, 0x71, 0x75, 0x61, 0x72, 0x65, 0x2e, 0x79, 0x2c, 0x20, 0x73, 0x71, 0x75, 0x61, 0x72, 0x65, 0x2e, 0x79,
+  0x2c, 0x20, 0x73, 0x71, 0x75, 0x61, 0x72, 0x65, 0x2e, 0x79, 0x29, 0x3b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x33, 0x20, 0x74,
+  0x72, 0x61, 0x6e, 0x73, 0x70, 0x61, 0x72, 0x65, 0x6e, 0x63, 0x79, 0x3b, 0x0a, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x73, 0x69,
+  0x6d, 0x75, 0x6c, 0x61, 0x74, 0x65, 0x20, 0x63, 0x6f, 0x6e, 0x74, 0x69, 0x6e, 0x75, 0x6f, 0x75, 0x73, 0x20, 0x72, 0x61,
+  0x73, 0x74, 0x65, 0x72, 0x20, 0x6c, 0x69, 0x6e, 0x65, 0x20, 0x62, 0x65, 0x74, 0x77, 0x65, 0x65, 0x6e, 0x20, 0x61, 0x64,
+  0x6a, 0x61, 0x63, 0x65, 0x6e, 0x74, 0x20, 0x70, 0x69, 0x78, 0x65, 0x6c, 0x73, 0x20, 0x62, 0x79, 0x20, 0x69, 0x67, 0x6e,
+  0x6f, 0x72, 0x69, 0x6e, 0x67, 0x20, 0x64, 0x69, 0x66, 0x66, 0x2e, 0x78, 0x20, 0x64, 0x69, 0x73, 0x74, 0x61, 0x6e, 0x63,
+  0x65, 0x0a, 0x09, 0x69, 0x66, 0x20, 0x28, 0x6c, 0x65, 0x66, 0x74, 0x4f, 0x6e, 0x20, 0x26, 0x26, 0x20, 0x64, 0x69, 0x66,
+  0x66, 0x2e, 0x78, 0x20, 0x3c, 0x20, 0x30, 0x2e, 0x30, 0x20, 0x26, 0x26, 0x20, 0x64, 0x69, 0x66, 0x66, 0x2e, 0x78, 0x20,
+  0x3e, 0x20, 0x2d, 0x31, 0x2e, 0x30, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x09, 0x76, 0x65, 0x63, 0x33, 0x20, 0x64, 0x69, 0x66,
+  0x66, 0x20, 0x3d, 0x20, 0x61, 0x62, 0x73, 0x28, 0x6d, 0x69, 0x64, 0x64, 0x6c, 0x65, 0x20, 0x2d, 0x20, 0x6c, 0x65, 0x66,
+  0x74, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x74, 0x72, 0x61, 0x6e, 0x73, 0x70, 0x61, 0x72, 0x65, 0x6e, 0x63, 0x79, 0x20, 0x3d,
+  0x20, 0x76, 0x65, 0x72, 0x74, 0x20, 0x2b, 0x20, 0x68, 0x6f, 0x72, 0x7a, 0x20, 0x2a, 0x20, 0x64, 0x69, 0x66, 0x66, 0x3b,
+  0x0a, 0x09, 0x7d, 0x0a, 0x09, 0x65, 0x6c, 0x73, 0x65, 0x20, 0x69, 0x66, 0x20, 0x28, 0x72, 0x69, 0x67, 0x68, 0x74, 0x4f,
+  0x6e, 0x20, 0x26, 0x26, 0x20, 0x64, 0x69, 0x66, 0x66, 0x2e, 0x78, 0x20, 0x3e, 0x20, 0x30, 0x2e, 0x30, 0x20, 0x26, 0x26,
+  0x20, 0x64, 0x69, 0x66, 0x66, 0x2e, 0x78, 0x20, 0x3c, 0x20, 0x31, 0x2e, 0x30, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x09, 0x76,
+  0x65, 0x63, 0x33, 0x20, 0x64, 0x69, 0x66, 0x66, 0x20, 0x3d, 0x20, 0x61, 0x62, 0x73, 0x28, 0x6d, 0x69, 0x64, 0x64, 0x6c,
+  0x65, 0x20, 0x2d, 0x20, 0x72, 0x69, 0x67, 0x68, 0x74, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x74, 0x72, 0x61, 0x6e, 0x73, 0x70,
+  0x61, 0x72, 0x65, 0x6e, 0x63, 0x79, 0x20, 0x3d, 0x20, 0x76, 0x65, 0x72, 0x74, 0x20, 0x2b, 0x20, 0x68, 0x6f, 0x72, 0x7a,
+  0x20, 0x2a, 0x20, 0x64, 0x69, 0x66, 0x66, 0x3b, 0x0a, 0x09, 0x7d, 0x0a, 0x09, 0x65, 0x6c, 0x73, 0x65, 0x20, 0x7b, 0x0a,
   0x09, 0x09, 0x74, 0x72, 0x61, 0x6e, 0x73, 0x70, 0x61, 0x72, 0x65, 0x6e, 0x63, 0x79, 0x20, 0x3d, 0x20, 0x76, 0x65, 0x72,
-  0x74, 0x20, 0x2b, 0x20, 0x68, 0x6f, 0x72, 0x7a, 0x20, 0x2a, 0x20, 0x64, 0x69, 0x66, 0x66, 0x3b, 0x0a, 0x09, 0x7d, 0x0a,
-  0x09, 0x65, 0x6c, 0x73, 0x65, 0x20, 0x69, 0x66, 0x20, 0x28, 0x72, 0x69, 0x67, 0x68, 0x74, 0x4f, 0x6e, 0x20, 0x26, 0x26,
-  0x20, 0x64, 0x69, 0x66, 0x66, 0x2e, 0x78, 0x20, 0x3e, 0x20, 0x30, 0x2e, 0x30, 0x20, 0x26, 0x26, 0x20, 0x64, 0x69, 0x66,
-  0x66, 0x2e, 0x78, 0x20, 0x3c, 0x20, 0x31, 0x2e, 0x30, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x09, 0x76, 0x65, 0x63, 0x33, 0x20,
-  0x64, 0x69, 0x66, 0x66, 0x20, 0x3d, 0x20, 0x61, 0x62, 0x73, 0x28, 0x6d, 0x69, 0x64, 0x64, 0x6c, 0x65, 0x20, 0x2d, 0x20,
-  0x72, 0x69, 0x67, 0x68, 0x74, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x74, 0x72, 0x61, 0x6e, 0x73, 0x70, 0x61, 0x72, 0x65, 0x6e,
-  0x63, 0x79, 0x20, 0x3d, 0x20, 0x76, 0x65, 0x72, 0x74, 0x20, 0x2b, 0x20, 0x68, 0x6f, 0x72, 0x7a, 0x20, 0x2a, 0x20, 0x64,
-  0x69, 0x66, 0x66, 0x3b, 0x0a, 0x09, 0x7d, 0x0a, 0x09, 0x65, 0x6c, 0x73, 0x65, 0x20, 0x7b, 0x0a, 0x09, 0x09, 0x74, 0x72,
-  0x61, 0x6e, 0x73, 0x70, 0x61, 0x72, 0x65, 0x6e, 0x63, 0x79, 0x20, 0x3d, 0x20, 0x76, 0x65, 0x72, 0x74, 0x20, 0x2b, 0x20,
-  0x68, 0x6f, 0x72, 0x7a, 0x3b, 0x0a, 0x09, 0x7d, 0x0a, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x33, 0x20, 0x69, 0x6e, 0x74, 0x65,
-  0x6e, 0x73, 0x69, 0x74, 0x79, 0x20, 0x3d, 0x20, 0x65, 0x78, 0x70, 0x28, 0x2d, 0x74, 0x72, 0x61, 0x6e, 0x73, 0x70, 0x61,
-  0x72, 0x65, 0x6e, 0x63, 0x79, 0x20, 0x2a, 0x20, 0x74, 0x72, 0x61, 0x6e, 0x73, 0x70, 0x61, 0x72, 0x65, 0x6e, 0x63, 0x79,
-  0x20, 0x2f, 0x20, 0x75, 0x5f, 0x70, 0x69, 0x78, 0x65, 0x6c, 0x53, 0x70, 0x72, 0x65, 0x61, 0x64, 0x29, 0x3b, 0x20, 0x2f,
-  0x2f, 0x20, 0x70, 0x69, 0x78, 0x65, 0x6c, 0x20, 0x73, 0x69, 0x7a, 0x65, 0x0a, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e,
-  0x20, 0x76, 0x65, 0x63, 0x34, 0x28, 0x66, 0x61, 0x63, 0x74, 0x6f, 0x72, 0x20, 0x2a, 0x20, 0x69, 0x6e, 0x74, 0x65, 0x6e,
-  0x73, 0x69, 0x74, 0x79, 0x2c, 0x20, 0x31, 0x2e, 0x30, 0x29, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x76, 0x65, 0x63, 0x34, 0x20,
-  0x67, 0x65, 0x74, 0x5f, 0x70, 0x69, 0x78, 0x65, 0x6c, 0x28, 0x76, 0x65, 0x63, 0x32, 0x20, 0x70, 0x6f, 0x73, 0x2c, 0x20,
-  0x76, 0x65, 0x63, 0x32, 0x20, 0x61, 0x64, 0x6a, 0x61, 0x63, 0x65, 0x6e, 0x74, 0x2c, 0x20, 0x76, 0x65, 0x63, 0x32, 0x20,
-  0x74, 0x65, 0x78, 0x53, 0x69, 0x7a, 0x65, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x32, 0x20, 0x70, 0x69, 0x78,
-  0x20, 0x3d, 0x20, 0x31, 0x2e, 0x30, 0x20, 0x2f, 0x20, 0x74, 0x65, 0x78, 0x53, 0x69, 0x7a, 0x65, 0x3b, 0x0a, 0x09, 0x76,
-  0x65, 0x63, 0x32, 0x20, 0x70, 0x20, 0x3d, 0x20, 0x70, 0x6f, 0x73, 0x20, 0x2d, 0x20, 0x6d, 0x6f, 0x64, 0x28, 0x70, 0x6f,
-  0x73, 0x2c, 0x20, 0x70, 0x69, 0x78, 0x29, 0x20, 0x2b, 0x20, 0x70, 0x69, 0x78, 0x20, 0x2a, 0x20, 0x30, 0x2e, 0x35, 0x3b,
-  0x0a, 0x09, 0x76, 0x65, 0x63, 0x33, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x30, 0x20, 0x3d, 0x20, 0x74, 0x65, 0x78, 0x74,
-  0x75, 0x72, 0x65, 0x28, 0x6f, 0x75, 0x72, 0x54, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x2c, 0x20, 0x70, 0x20, 0x2d, 0x20,
-  0x76, 0x65, 0x63, 0x32, 0x28, 0x70, 0x69, 0x78, 0x2e, 0x78, 0x2c, 0x20, 0x30, 0x2e, 0x30, 0x29, 0x29, 0x2e, 0x72, 0x67,
-  0x62, 0x3b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x33, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x31, 0x20, 0x3d, 0x20, 0x74, 0x65,
-  0x78, 0x74, 0x75, 0x72, 0x65, 0x28, 0x6f, 0x75, 0x72, 0x54, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x2c, 0x20, 0x70, 0x29,
-  0x2e, 0x72, 0x67, 0x62, 0x3b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x33, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x32, 0x20, 0x3d,
-  0x20, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x28, 0x6f, 0x75, 0x72, 0x54, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x2c,
-  0x20, 0x70, 0x20, 0x2b, 0x20, 0x76, 0x65, 0x63, 0x32, 0x28, 0x70, 0x69, 0x78, 0x2e, 0x78, 0x2c, 0x20, 0x30, 0x2e, 0x30,
+  0x74, 0x20, 0x2b, 0x20, 0x68, 0x6f, 0x72, 0x7a, 0x3b, 0x0a, 0x09, 0x7d, 0x0a, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x33, 0x20,
+  0x69, 0x6e, 0x74, 0x65, 0x6e, 0x73, 0x69, 0x74, 0x79, 0x20, 0x3d, 0x20, 0x65, 0x78, 0x70, 0x28, 0x2d, 0x74, 0x72, 0x61,
+  0x6e, 0x73, 0x70, 0x61, 0x72, 0x65, 0x6e, 0x63, 0x79, 0x20, 0x2a, 0x20, 0x74, 0x72, 0x61, 0x6e, 0x73, 0x70, 0x61, 0x72,
+  0x65, 0x6e, 0x63, 0x79, 0x20, 0x2f, 0x20, 0x75, 0x5f, 0x70, 0x69, 0x78, 0x65, 0x6c, 0x53, 0x70, 0x72, 0x65, 0x61, 0x64,
+  0x29, 0x3b, 0x20, 0x2f, 0x2f, 0x20, 0x70, 0x69, 0x78, 0x65, 0x6c, 0x20, 0x73, 0x69, 0x7a, 0x65, 0x0a, 0x09, 0x72, 0x65,
+  0x74, 0x75, 0x72, 0x6e, 0x20, 0x76, 0x65, 0x63, 0x34, 0x28, 0x66, 0x61, 0x63, 0x74, 0x6f, 0x72, 0x20, 0x2a, 0x20, 0x69,
+  0x6e, 0x74, 0x65, 0x6e, 0x73, 0x69, 0x74, 0x79, 0x2c, 0x20, 0x31, 0x2e, 0x30, 0x29, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x76,
+  0x65, 0x63, 0x34, 0x20, 0x67, 0x65, 0x74, 0x5f, 0x70, 0x69, 0x78, 0x65, 0x6c, 0x28, 0x76, 0x65, 0x63, 0x32, 0x20, 0x70,
+  0x6f, 0x73, 0x2c, 0x20, 0x76, 0x65, 0x63, 0x32, 0x20, 0x61, 0x64, 0x6a, 0x61, 0x63, 0x65, 0x6e, 0x74, 0x2c, 0x20, 0x76,
+  0x65, 0x63, 0x32, 0x20, 0x74, 0x65, 0x78, 0x53, 0x69, 0x7a, 0x65, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x32,
+  0x20, 0x70, 0x69, 0x78, 0x20, 0x3d, 0x20, 0x31, 0x2e, 0x30, 0x20, 0x2f, 0x20, 0x74, 0x65, 0x78, 0x53, 0x69, 0x7a, 0x65,
+  0x3b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x32, 0x20, 0x70, 0x20, 0x3d, 0x20, 0x70, 0x6f, 0x73, 0x20, 0x2d, 0x20, 0x6d, 0x6f,
+  0x64, 0x28, 0x70, 0x6f, 0x73, 0x2c, 0x20, 0x70, 0x69, 0x78, 0x29, 0x20, 0x2b, 0x20, 0x70, 0x69, 0x78, 0x20, 0x2a, 0x20,
+  0x30, 0x2e, 0x35, 0x3b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x33, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x30, 0x20, 0x3d, 0x20,
+  0x73, 0x63, 0x72, 0x65, 0x65, 0x6e, 0x54, 0x65, 0x78, 0x65, 0x6c, 0x28, 0x70, 0x20, 0x2d, 0x20, 0x76, 0x65, 0x63, 0x32,
+  0x28, 0x70, 0x69, 0x78, 0x2e, 0x78, 0x2c, 0x20, 0x30, 0x2e, 0x30, 0x29, 0x29, 0x2e, 0x72, 0x67, 0x62, 0x3b, 0x0a, 0x09,
+  0x76, 0x65, 0x63, 0x33, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x31, 0x20, 0x3d, 0x20, 0x73, 0x63, 0x72, 0x65, 0x65, 0x6e,
+  0x54, 0x65, 0x78, 0x65, 0x6c, 0x28, 0x70, 0x29, 0x2e, 0x72, 0x67, 0x62, 0x3b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x33, 0x20,
+  0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x32, 0x20, 0x3d, 0x20, 0x73, 0x63, 0x72, 0x65, 0x65, 0x6e, 0x54, 0x65, 0x78, 0x65, 0x6c,
+  0x28, 0x70, 0x20, 0x2b, 0x20, 0x76, 0x65, 0x63, 0x32, 0x28, 0x70, 0x69, 0x78, 0x2e, 0x78, 0x2c, 0x20, 0x30, 0x2e, 0x30,
   0x29, 0x29, 0x2e, 0x72, 0x67, 0x62, 0x3b, 0x0a, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x67, 0x65, 0x74, 0x5f,
   0x70, 0x69, 0x78, 0x65, 0x6c, 0x5f, 0x69, 0x6e, 0x74, 0x65, 0x6e, 0x73, 0x69, 0x74, 0x79, 0x28, 0x70, 0x6f, 0x73, 0x2c,
   0x20, 0x61, 0x64, 0x6a, 0x61, 0x63, 0x65, 0x6e, 0x74, 0x2c, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x30, 0x2c, 0x20, 0x63,
@@ -254,21 +273,20 @@ unsigned char fragmentShaderArr[] = {
   0x78, 0x2c, 0x20, 0x70, 0x69, 0x78, 0x20, 0x2a, 0x20, 0x6d, 0x61, 0x73, 0x6b, 0x2c, 0x20, 0x73, 0x63, 0x61, 0x6e, 0x6c,
   0x69, 0x6e, 0x65, 0x73, 0x46, 0x61, 0x63, 0x74, 0x6f, 0x72, 0x29, 0x3b, 0x0a, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x34, 0x20,
   0x63, 0x6f, 0x6c, 0x20, 0x3d, 0x20, 0x70, 0x69, 0x78, 0x3b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x34, 0x20, 0x67, 0x6c, 0x6f,
-  0x77, 0x20, 0x3d, 0x20, 0x62, 0x6c, 0x75, 0x72, 0x28, 0x6f, 0x75, 0x72, 0x54, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x2c,
-  0x20, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x2c, 0x20, 0x74, 0x65, 0x78, 0x53, 0x69, 0x7a, 0x65, 0x20,
-  0x2a, 0x20, 0x76, 0x65, 0x63, 0x32, 0x28, 0x31, 0x2e, 0x30, 0x2c, 0x20, 0x32, 0x2e, 0x30, 0x29, 0x29, 0x3b, 0x0a, 0x09,
-  0x76, 0x65, 0x63, 0x34, 0x20, 0x66, 0x69, 0x6e, 0x61, 0x6c, 0x20, 0x3d, 0x20, 0x62, 0x67, 0x6e, 0x64, 0x20, 0x2b, 0x20,
-  0x67, 0x6c, 0x6f, 0x77, 0x20, 0x2a, 0x20, 0x75, 0x5f, 0x67, 0x6c, 0x6f, 0x77, 0x43, 0x6f, 0x65, 0x66, 0x66, 0x3b, 0x0a,
-  0x0a, 0x09, 0x76, 0x65, 0x63, 0x34, 0x20, 0x66, 0x72, 0x6d, 0x20, 0x3d, 0x20, 0x66, 0x72, 0x61, 0x6d, 0x65, 0x28, 0x54,
-  0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x2c, 0x20, 0x74, 0x65, 0x78, 0x52, 0x65, 0x73, 0x6f, 0x6c, 0x75, 0x74, 0x69,
-  0x6f, 0x6e, 0x29, 0x3b, 0x0a, 0x09, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x66, 0x61, 0x63, 0x74, 0x6f, 0x72, 0x20, 0x3d,
-  0x20, 0x31, 0x2e, 0x30, 0x3b, 0x20, 0x2f, 0x2f, 0x20, 0x74, 0x6f, 0x64, 0x6f, 0x20, 0x69, 0x66, 0x20, 0x6e, 0x65, 0x65,
-  0x64, 0x20, 0x62, 0x65, 0x3a, 0x20, 0x62, 0x72, 0x69, 0x67, 0x68, 0x74, 0x6e, 0x65, 0x73, 0x73, 0x20, 0x3c, 0x3d, 0x20,
-  0x31, 0x2e, 0x30, 0x20, 0x3f, 0x20, 0x62, 0x72, 0x69, 0x67, 0x68, 0x74, 0x6e, 0x65, 0x73, 0x73, 0x20, 0x3a, 0x20, 0x70,
-  0x6f, 0x77, 0x28, 0x62, 0x72, 0x69, 0x67, 0x68, 0x74, 0x6e, 0x65, 0x73, 0x73, 0x2c, 0x20, 0x33, 0x2e, 0x30, 0x29, 0x3b,
-  0x0a, 0x09, 0x66, 0x69, 0x6e, 0x61, 0x6c, 0x20, 0x3d, 0x20, 0x6d, 0x69, 0x78, 0x28, 0x66, 0x69, 0x6e, 0x61, 0x6c, 0x20,
-  0x2a, 0x20, 0x66, 0x61, 0x63, 0x74, 0x6f, 0x72, 0x2c, 0x20, 0x66, 0x72, 0x6d, 0x2c, 0x20, 0x66, 0x72, 0x6d, 0x2e, 0x61,
-  0x29, 0x3b, 0x0a, 0x0a, 0x09, 0x46, 0x72, 0x61, 0x67, 0x43, 0x6f, 0x6c, 0x6f, 0x72, 0x20, 0x3d, 0x20, 0x66, 0x69, 0x6e,
-  0x61, 0x6c, 0x3b, 0x0a, 0x7d, 0x0a
+  0x77, 0x20, 0x3d, 0x20, 0x62, 0x6c, 0x75, 0x72, 0x28, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x73, 0x2c, 0x20,
+  0x74, 0x65, 0x78, 0x53, 0x69, 0x7a, 0x65, 0x20, 0x2a, 0x20, 0x76, 0x65, 0x63, 0x32, 0x28, 0x31, 0x2e, 0x30, 0x2c, 0x20,
+  0x32, 0x2e, 0x30, 0x29, 0x29, 0x3b, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x34, 0x20, 0x66, 0x69, 0x6e, 0x61, 0x6c, 0x20, 0x3d,
+  0x20, 0x62, 0x67, 0x6e, 0x64, 0x20, 0x2b, 0x20, 0x67, 0x6c, 0x6f, 0x77, 0x20, 0x2a, 0x20, 0x75, 0x5f, 0x67, 0x6c, 0x6f,
+  0x77, 0x43, 0x6f, 0x65, 0x66, 0x66, 0x3b, 0x0a, 0x0a, 0x09, 0x76, 0x65, 0x63, 0x34, 0x20, 0x66, 0x72, 0x6d, 0x20, 0x3d,
+  0x20, 0x66, 0x72, 0x61, 0x6d, 0x65, 0x28, 0x54, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x2c, 0x20, 0x74, 0x65, 0x78,
+  0x52, 0x65, 0x73, 0x6f, 0x6c, 0x75, 0x74, 0x69, 0x6f, 0x6e, 0x29, 0x3b, 0x0a, 0x09, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20,
+  0x66, 0x61, 0x63, 0x74, 0x6f, 0x72, 0x20, 0x3d, 0x20, 0x31, 0x2e, 0x30, 0x3b, 0x20, 0x2f, 0x2f, 0x20, 0x74, 0x6f, 0x64,
+  0x6f, 0x20, 0x69, 0x66, 0x20, 0x6e, 0x65, 0x65, 0x64, 0x20, 0x62, 0x65, 0x3a, 0x20, 0x62, 0x72, 0x69, 0x67, 0x68, 0x74,
+  0x6e, 0x65, 0x73, 0x73, 0x20, 0x3c, 0x3d, 0x20, 0x31, 0x2e, 0x30, 0x20, 0x3f, 0x20, 0x62, 0x72, 0x69, 0x67, 0x68, 0x74,
+  0x6e, 0x65, 0x73, 0x73, 0x20, 0x3a, 0x20, 0x70, 0x6f, 0x77, 0x28, 0x62, 0x72, 0x69, 0x67, 0x68, 0x74, 0x6e, 0x65, 0x73,
+  0x73, 0x2c, 0x20, 0x33, 0x2e, 0x30, 0x29, 0x3b, 0x0a, 0x09, 0x66, 0x69, 0x6e, 0x61, 0x6c, 0x20, 0x3d, 0x20, 0x6d, 0x69,
+  0x78, 0x28, 0x66, 0x69, 0x6e, 0x61, 0x6c, 0x20, 0x2a, 0x20, 0x66, 0x61, 0x63, 0x74, 0x6f, 0x72, 0x2c, 0x20, 0x66, 0x72,
+  0x6d, 0x2c, 0x20, 0x66, 0x72, 0x6d, 0x2e, 0x61, 0x29, 0x3b, 0x0a, 0x0a, 0x09, 0x46, 0x72, 0x61, 0x67, 0x43, 0x6f, 0x6c,
+  0x6f, 0x72, 0x20, 0x3d, 0x20, 0x66, 0x69, 0x6e, 0x61, 0x6c, 0x3b, 0x0a, 0x7d, 0x0a
 };
-unsigned int fragmentShaderArr_len = 5406;
+unsigned int fragmentShaderArr_len = 5774;
@@ -815,7 +815,9 @@ int PLATFORM_Keyboard(void)
 			break;
 		case SDL_VIDEOEXPOSE:
 			/* When window is "uncovered", and we are in the emulator's menu,
-			   we need to refresh display manually. */
+			   we need to refresh display manually. The uncovered part
+			   shows only what is drawn again, so draw everything. */
+			SDL_VIDEO_InvalidateRows();
 			PLATFORM_DisplayScreen();
 			break;
 #endif
@@ -1681,6 +1683,13 @@ static void Init_SDL_Joysticks(void)
 	}
 }
 
+/* Brings kbhits and the joysticks up to date in the middle of a frame.
+   The events stay queued for PLATFORM_Keyboard(). */
+static void PollHost(void)
+{
+	SDL_PumpEvents();
+}
+
 int SDL_INPUT_Initialise(int *argc, char *argv[])
 {
 	/* TODO check for errors! */
@@ -1842,6 +1851,7 @@ int SDL_INPUT_Initialise(int *argc, char *argv[])
 		Log_flushlog();
 		return FALSE;
 	}
+	INPUT_poll_host = PollHost;
 
 	return TRUE;
 }
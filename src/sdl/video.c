@@ -23,6 +23,7 @@
 */
 
 #include <SDL.h>
+#include <string.h>
 
 #include "af80.h"
 #include "bit3.h"
@@ -121,6 +122,49 @@ void SDL_VIDEO_UpdatePaletteLookup(VIDEOMODE_MODE_t mode, int bpp_32)
 	}
 }
 
+/* The shown rows of the frame last displayed, at their places in Screen_atari */
+static UBYTE shown_rows[Screen_HEIGHT * Screen_WIDTH];
+static int shown_rows_valid = FALSE;
+
+int SDL_VIDEO_FindChangedRows(UBYTE const *screen, UBYTE *changed)
+{
+	int offset = Screen_WIDTH * VIDEOMODE_src_offset_top + VIDEOMODE_src_offset_left;
+	UBYTE const *src = screen + offset;
+	UBYTE *shown = shown_rows + offset;
+	int count = 0;
+	unsigned int y;
+	for (y = 0; y < VIDEOMODE_src_height; y++) {
+		changed[y] = !shown_rows_valid || memcmp(shown, src, VIDEOMODE_src_width) != 0;
+		if (changed[y]) {
+			memcpy(shown, src, VIDEOMODE_src_width);
+			count++;
+		}
+		src += Screen_WIDTH;
+		shown += Screen_WIDTH;
+	}
+	shown_rows_valid = TRUE;
+	return count;
+}
+
+void SDL_VIDEO_InvalidateRows(void)
+{
+	shown_rows_valid = FALSE;
+}
+
+int SDL_VIDEO_NextChangedRows(UBYTE const *changed, int *top, int *count)
+{
+	int y = *top;
+	while (y < (int)VIDEOMODE_src_height && !changed[y])
+		y++;
+	if (y >= (int)VIDEOMODE_src_height)
+		return FALSE;
+	*top = y;
+	while (y < (int)VIDEOMODE_src_height && changed[y])
+		y++;
+	*count = y - *top;
+	return TRUE;
+}
+
 void PLATFORM_PaletteUpdate(void)
 {
 #ifdef NTSC_FILTER
@@ -136,6 +180,7 @@ void PLATFORM_PaletteUpdate(void)
 #endif
 			SDL_VIDEO_SW_PaletteUpdate();
 	}
+	SDL_VIDEO_InvalidateRows();
 }
 
 void PLATFORM_GetPixelFormat(PLATFORM_pixel_format_t *format)
@@ -234,6 +279,7 @@ void PLATFORM_SetVideoMode(VIDEOMODE_resolution_t const *res, int windowed, VIDE
 #else
 	SDL_VIDEO_SW_SetVideoMode(res, windowed, mode, rotate90);
 #endif
+	SDL_VIDEO_InvalidateRows();
 	SDL_VIDEO_current_display_mode = mode;
 #ifdef NTSC_FILTER
 	UpdateNtscFilter(mode);
@@ -578,63 +624,6 @@ void SDL_VIDEO_BlitNormal8(Uint32 *dest, Uint8 *src, int pitch, int width, int h
 	}
 }
 
-void SDL_VIDEO_BlitNormal16(Uint32 *dest, Uint8 *src, int pitch, int width, int height, Uint16 *palette16)
-{
-	register Uint32 quad;
-	register Uint32 *start32 = dest;
-	register Uint8 c;
-	register int pos;
-	int width_32;
-	if (width & 0x01)
-		width_32 = width + 1;
-	else
-		width_32 = width;
-	while (height > 0) {
-		pos = width_32;
-		do {
-#if SDL_BYTEORDER == SDL_BIG_ENDIAN
-			pos--;
-			c = src[pos];
-			quad = palette16[c];
-			pos--;
-			c = src[pos];
-			quad += palette16[c] << 16;
-#else
-			pos--;
-			c = src[pos];
-			quad = palette16[c] << 16;
-			pos--;
-			c = src[pos];
-			quad += palette16[c];
-#endif
-			start32[pos >> 1] = quad;
-		} while (pos > 0);
-		src += Screen_WIDTH;
-		start32 += pitch;
-		height--;
-	}
-}
-
-void SDL_VIDEO_BlitNormal32(Uint32 *dest, Uint8 *src, int pitch, int width, int height, Uint32 *palette32)
-{
-	register Uint32 quad;
-	register Uint32 *start32 = dest;
-	register Uint8 c;
-	register int pos;
-	while (height > 0) {
-		pos = width;
-		do {
-			pos--;
-			c = src[pos];
-			quad = palette32[c];
-			start32[pos] = quad;
-		} while (pos > 0);
-		src += Screen_WIDTH;
-		start32 += pitch;
-		height--;
-	}
-}
-
 void SDL_VIDEO_BlitXEP80_8(Uint32 *dest, Uint8 *src, int pitch, int width, int height)
 {
 	register Uint32 *start32 = dest;
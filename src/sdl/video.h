@@ -4,6 +4,7 @@
 #include <stdio.h>
 #include <SDL.h>
 
+#include "atari.h"
 #include "config.h"
 #include "videomode.h"
 
@@ -77,8 +78,6 @@ void SDL_VIDEO_Exit(void);
 
 /* Write the screen data into DEST. */
 void SDL_VIDEO_BlitNormal8(Uint32 *dest, Uint8 *src, int pitch, int width, int height);
-void SDL_VIDEO_BlitNormal16(Uint32 *dest, Uint8 *src, int pitch, int width, int height, Uint16 *palette16);
-void SDL_VIDEO_BlitNormal32(Uint32 *dest, Uint8 *src, int pitch, int width, int height, Uint32 *palette32);
 void SDL_VIDEO_BlitXEP80_8(Uint32 *dest, Uint8 *src, int pitch, int width, int height);
 void SDL_VIDEO_BlitXEP80_16(Uint32 *dest, Uint8 *src, int pitch, int width, int height, Uint16 *palette16);
 void SDL_VIDEO_BlitXEP80_32(Uint32 *dest, Uint8 *src, int pitch, int width, int height, Uint32 *palette32);
@@ -99,4 +98,16 @@ void SDL_VIDEO_BlitBIT3_32(Uint32 *dest, int first_column, int last_column, int
 /* Update lookup tables for the blit functions. */
 void SDL_VIDEO_UpdatePaletteLookup(VIDEOMODE_MODE_t mode, int bpp_32);
 
+/* Set CHANGED[y] for each of the VIDEOMODE_src_height shown rows of SCREEN
+   (laid out like Screen_atari) that differs from the frame shown before,
+   and remember the rows for the next call. Every row counts as changed
+   after SDL_VIDEO_InvalidateRows(), which must be called when the
+   display loses what it shows: a new video mode, palette or texture.
+   Returns the number of changed rows. */
+int SDL_VIDEO_FindChangedRows(UBYTE const *screen, UBYTE *changed);
+void SDL_VIDEO_InvalidateRows(void);
+/* Find the first band of changed rows at or below *TOP, setting *TOP and
+   *COUNT to it. Returns FALSE when no row below is changed. */
+int SDL_VIDEO_NextChangedRows(UBYTE const *changed, int *top, int *count);
+
 #endif /* SDL_VIDEO_H_ */
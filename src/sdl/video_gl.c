@@ -35,6 +35,7 @@
 #include "config.h"
 #include "filter_ntsc.h"
 #include "log.h"
+#include "palette_blit.h"
 #include "pbi_proto80.h"
 #ifdef PAL_BLENDING
 #include "pal_blending.h"
@@ -129,6 +130,7 @@ static struct
 	void   (APIENTRY* Uniform1i)(GLint location, GLint v0);
 	void   (APIENTRY* UniformMatrix4fv)(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value);
 	void   (APIENTRY* ActiveTexture)(GLenum texture);
+	void   (APIENTRY* PixelStorei)(GLenum pname, GLint param);
 	void   (APIENTRY* VertexAttribPointer)(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer);
 	void   (APIENTRY* EnableVertexAttribArray)(GLuint index);
 	void   (APIENTRY* GenVertexArrays)(GLsizei n, GLuint* arrays);
@@ -186,6 +188,42 @@ static GLuint textures[2];
 
 int SDL_VIDEO_GL_pbo = TRUE;
 
+int SDL_VIDEO_GL_indexed = FALSE;
+#if SDL2
+/* Set when the palette texture no longer matches the current palette. */
+static int indexed_palette_dirty = TRUE;
+#endif
+
+/* The Atari screen the blits read: Screen_atari, or the copy of it the
+   presentation thread is showing. */
+static UBYTE *atari_screen;
+
+/* Rows of the plain Atari screen changed since the frame shown before;
+   only these are blitted and uploaded. ROWS_INDEXED tells which texture
+   took the rows last, indexed_textures[0] or textures[0]. */
+static UBYTE changed_rows[Screen_HEIGHT];
+static int rows_indexed = FALSE;
+
+#if SDL2
+int SDL_VIDEO_GL_thread = FALSE;
+
+/* The presentation thread. The emulation copies each screen it displays
+   into one of three buffers and swaps it with the ready one; the thread
+   swaps the ready one with the one it shows, so neither waits for the
+   other. While running, the thread has the OpenGL context; StopPresenter()
+   hands it back before the main thread touches OpenGL itself. */
+static SDL_Thread *presenter = NULL;
+static SDL_mutex *presenter_lock = NULL;
+static SDL_cond *presenter_cond = NULL;
+static SDL_GLContext presenter_context;
+static UBYTE *screen_copies[3] = { NULL, NULL, NULL };
+static int copy_written;
+static int copy_ready;
+static int copy_shown;
+static int copy_fresh;    /* copy_ready holds a screen not shown yet */
+static int presenter_quit;
+#endif
+
 /* Indicates whether Pixel Buffer Objects GL extension is available.
    Available from OpenGL 2.1, it gives a significant boost in blit speed. */
 static int pbo_available;
@@ -356,8 +394,15 @@ static void InitGlTextures(void)
 	}
 }
 
+#if SDL2
+static void StopPresenter(void);
+#endif
+
 void SDL_VIDEO_GL_Cleanup(void)
 {
+#if SDL2
+	StopPresenter();
+#endif
 	if (SDL_VIDEO_screen != NULL && (SDL_VIDEO_screen->flags & SDL_OpenGL_FLAG) == SDL_OpenGL_FLAG)
 		CleanGlContext();
 	FreeTexture();
@@ -380,10 +425,17 @@ void SDL_VIDEO_GL_MapRGB(void *dest, int const *palette, int size)
 static void UpdatePaletteLookup(VIDEOMODE_MODE_t mode)
 {
 	SDL_VIDEO_UpdatePaletteLookup(mode, bpp_32);
+#if SDL2
+	indexed_palette_dirty = TRUE;
+#endif
 }
 
 void SDL_VIDEO_GL_PaletteUpdate(void)
 {
+#if SDL2
+	/* The thread's blits read the lookup tables */
+	StopPresenter();
+#endif
 	UpdatePaletteLookup(SDL_VIDEO_current_display_mode);
 }
 
@@ -497,6 +549,7 @@ static void SetGlDisplayList(void)
 static void CleanDisplayTexture(void)
 {
 	GLvoid *ptr;
+	SDL_VIDEO_InvalidateRows();
 	gl.BindTexture(GL_TEXTURE_2D, textures[0]);
 	if (SDL_VIDEO_GL_pbo) {
 		gl.BindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, screen_pbo);
@@ -557,6 +610,7 @@ static int InitGlFunctions(void)
 	(gl.Uniform1i = GetGlFunc("glUniform1i")) == NULL ||
 	(gl.UniformMatrix4fv = GetGlFunc("glUniformMatrix4fv")) == NULL ||
 	(gl.ActiveTexture = GetGlFunc("glActiveTexture")) == NULL ||
+	(gl.PixelStorei = GetGlFunc("glPixelStorei")) == NULL ||
 	(gl.BindBuffer = GetGlFunc("glBindBuffer")) == NULL ||
 	(gl.BufferData = GetGlFunc("glBufferData")) == NULL ||
 	(gl.GenBuffers = GetGlFunc("glGenBuffers")) == NULL ||
@@ -756,6 +810,15 @@ static GLint sh_vp_matrix;
 static GLint sh_resolution;
 static GLint sh_pixelSpread;
 static GLint sh_glow;
+static GLint sh_palette;
+static GLint sh_indexed;
+/* Textures of the indexed display - [0] is Atari colour indices, [1] is
+   the palette they are looked up in. */
+static GLuint indexed_textures[2];
+
+#ifndef GL_R8
+#define GL_R8 0x8229
+#endif
 
 #define	TEX_WIDTH	1024
 #define	TEX_HEIGHT	512
@@ -795,11 +858,22 @@ static void SDL_set_up_uvs(void) {
 }
 
 static void SDL_set_up_opengl(void) {
+	int i;
 	gl.GenTextures(2, textures);
 	gl.BindTexture(GL_TEXTURE_2D, textures[0]);
-	// gl.TexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE, TEX_WIDTH, TEX_HEIGHT, 0, GL_LUMINANCE, GL_UNSIGNED_BYTE, NULL);
-	// gl.BindTexture(GL_TEXTURE_2D, textures[1]); // color palette
-	// gl.TexImage2D(GL_TEXTURE_2D, 0, GL_RGB, 256, 1, 0, GL_RGB, GL_UNSIGNED_SHORT_5_6_5, NULL);
+	gl.GenTextures(2, indexed_textures);
+	gl.BindTexture(GL_TEXTURE_2D, indexed_textures[0]);
+	gl.TexImage2D(GL_TEXTURE_2D, 0, GL_R8, TEX_WIDTH, TEX_HEIGHT, 0, GL_RED, GL_UNSIGNED_BYTE, NULL);
+	gl.BindTexture(GL_TEXTURE_2D, indexed_textures[1]);
+	gl.TexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 256, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+	for (i = 0; i < 2; i++) {
+		gl.BindTexture(GL_TEXTURE_2D, indexed_textures[i]);
+		gl.TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		gl.TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		gl.TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		gl.TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	}
+	indexed_palette_dirty = TRUE;
 	our_texture = gl.GetUniformLocation(progID, "ourTexture");
 	sh_scanlines = gl.GetUniformLocation(progID, "scanlinesFactor");
 	sh_curvature = gl.GetUniformLocation(progID, "screenCurvature");
@@ -809,6 +883,8 @@ static void SDL_set_up_opengl(void) {
 	sh_resolution = gl.GetUniformLocation(progID, "u_resolution");
 	sh_pixelSpread = gl.GetUniformLocation(progID, "u_pixelSpread");
 	sh_glow = gl.GetUniformLocation(progID, "u_glowCoeff");
+	sh_palette = gl.GetUniformLocation(progID, "u_palette");
+	sh_indexed = gl.GetUniformLocation(progID, "u_indexed");
 
 	gl.GenBuffers(3, buffers);
 	gl.GenVertexArrays(1, vaos);
@@ -882,6 +958,9 @@ int SDL_VIDEO_GL_SetVideoMode(VIDEOMODE_resolution_t const *res, int windowed, V
 {
 	int isnew = SDL_VIDEO_screen == NULL; /* TRUE means the SDL/GL screen was not yet initialised */
 	int context_updated = FALSE; /* TRUE means the OpenGL context has been recreated */
+#if SDL2
+	StopPresenter();
+#endif
 	currently_rotated = rotate90;
 
 	/* Call SetVideoMode only when there was change in width, height, or windowed/fullscreen. */
@@ -1036,25 +1115,32 @@ int SDL_VIDEO_GL_SupportsVideomode(VIDEOMODE_MODE_t mode, int stretch, int rotat
 	return TRUE;
 }
 
-static void DisplayNormal(GLvoid *dest)
+/* Length of a line of the screen texture in bytes; 16-bit lines are padded
+   to whole words. */
+static int TexturePitch(void)
 {
-	Uint8 *screen = (Uint8 *)Screen_atari + Screen_WIDTH * VIDEOMODE_src_offset_top + VIDEOMODE_src_offset_left;
+	return bpp_32 ? VIDEOMODE_actual_width * 4 : (VIDEOMODE_actual_width + 1) / 2 * 4;
+}
+
+static void BlitNormalRows(GLvoid *dest, int top, int count)
+{
+	Uint8 *screen = atari_screen + Screen_WIDTH * (VIDEOMODE_src_offset_top + top) + VIDEOMODE_src_offset_left;
+	dest = (Uint8 *)dest + TexturePitch() * top;
 	if (bpp_32)
-		SDL_VIDEO_BlitNormal32((Uint32*)dest, screen, VIDEOMODE_actual_width, VIDEOMODE_src_width, VIDEOMODE_src_height, SDL_PALETTE_buffer.bpp32);
-	else {
-		int pitch;
-		if (VIDEOMODE_actual_width & 0x01)
-			pitch = VIDEOMODE_actual_width / 2 + 1;
-		else
-			pitch = VIDEOMODE_actual_width / 2;
-		SDL_VIDEO_BlitNormal16((Uint32*)dest, screen, pitch, VIDEOMODE_src_width, VIDEOMODE_src_height, SDL_PALETTE_buffer.bpp16);
-	}
+		PALETTE_BLIT_32((Uint32*)dest, TexturePitch(), screen, Screen_WIDTH, VIDEOMODE_src_width, count, SDL_PALETTE_buffer.bpp32);
+	else
+		PALETTE_BLIT_16((Uint16*)dest, TexturePitch(), screen, Screen_WIDTH, VIDEOMODE_src_width, count, SDL_PALETTE_buffer.bpp16);
+}
+
+static void DisplayNormal(GLvoid *dest)
+{
+	BlitNormalRows(dest, 0, VIDEOMODE_src_height);
 }
 
 #ifdef PAL_BLENDING
 static void DisplayPalBlending(GLvoid *dest)
 {
-	Uint8 *screen = (Uint8 *)Screen_atari + Screen_WIDTH * VIDEOMODE_src_offset_top + VIDEOMODE_src_offset_left;
+	Uint8 *screen = atari_screen + Screen_WIDTH * VIDEOMODE_src_offset_top + VIDEOMODE_src_offset_left;
 	if (bpp_32)
 		PAL_BLENDING_Blit32((ULONG*)dest, screen, VIDEOMODE_actual_width, VIDEOMODE_src_width, VIDEOMODE_src_height, VIDEOMODE_src_offset_top % 2);
 	else {
@@ -1071,9 +1157,10 @@ static void DisplayPalBlending(GLvoid *dest)
 #if NTSC_FILTER
 static void DisplayNTSCEmu(GLvoid *dest)
 {
-	(*pixel_formats[SDL_VIDEO_GL_pixel_format].ntsc_blit_func)(
+	FILTER_NTSC_Blit(
+		pixel_formats[SDL_VIDEO_GL_pixel_format].ntsc_blit_func,
 		FILTER_NTSC_emu,
-		(ATARI_NTSC_IN_T *) ((UBYTE *)Screen_atari + Screen_WIDTH * VIDEOMODE_src_offset_top + VIDEOMODE_src_offset_left),
+		(ATARI_NTSC_IN_T *) (atari_screen + Screen_WIDTH * VIDEOMODE_src_offset_top + VIDEOMODE_src_offset_left),
 		Screen_WIDTH,
 		VIDEOMODE_src_width,
 		VIDEOMODE_src_height,
@@ -1155,21 +1242,105 @@ static void DisplayBIT3(GLvoid *dest)
 #endif
 
 
-void SDL_VIDEO_GL_DisplayScreen(void)
+/* Fills changed_rows for the texture that is to take them. */
+static void FindChangedRows(int indexed)
 {
+	if (indexed != rows_indexed) {
+		SDL_VIDEO_InvalidateRows();
+		rows_indexed = indexed;
+	}
+	SDL_VIDEO_FindChangedRows(atari_screen, changed_rows);
+}
+
+/* Blits the screen into screen_texture and uploads it to the bound
+   texture. Of the plain Atari screen, only the changed rows are blitted
+   and uploaded. */
+static void UploadScreen(void)
+{
+	GLenum format = pixel_formats[SDL_VIDEO_GL_pixel_format].format;
+	GLenum type = pixel_formats[SDL_VIDEO_GL_pixel_format].type;
+	if (SDL_VIDEO_current_display_mode == VIDEOMODE_MODE_NORMAL
+	    && blit_funcs[VIDEOMODE_MODE_NORMAL] == &DisplayNormal) {
+		int top, count;
+		FindChangedRows(FALSE);
+		for (top = 0; SDL_VIDEO_NextChangedRows(changed_rows, &top, &count); top += count) {
+			BlitNormalRows(screen_texture, top, count);
+			gl.TexSubImage2D(GL_TEXTURE_2D, 0, 0, top, VIDEOMODE_actual_width, count, format, type,
+			                 (Uint8 *)screen_texture + TexturePitch() * top);
+		}
+	}
+	else {
+		SDL_VIDEO_InvalidateRows();
+		(*blit_funcs[SDL_VIDEO_current_display_mode])(screen_texture);
+		gl.TexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, VIDEOMODE_actual_width, VIDEOMODE_src_height, format, type,
+		                 screen_texture);
+	}
+}
+
 #if SDL2
-	if (!screen_width || !screen_height) return;
+/* Uploads the visible part of the Atari screen as it is, for the shader to look
+   its colours up in the palette texture. Only plain Atari screens are shown
+   this way; PAL blending, the NTSC filter and the 80-column displays still
+   produce RGB on the CPU. Returns FALSE if the screen must be blitted. */
+static int DisplayIndexed(void)
+{
+	int top, count;
+
+	if (!SDL_VIDEO_GL_indexed || SDL_VIDEO_current_display_mode != VIDEOMODE_MODE_NORMAL
+	    || blit_funcs[VIDEOMODE_MODE_NORMAL] != &DisplayNormal)
+		return FALSE;
+
+	if (indexed_palette_dirty) {
+		UBYTE rgba[256 * 4];
+		int const *palette = SDL_PALETTE_tab[VIDEOMODE_MODE_NORMAL].palette;
+		int i;
+		for (i = 0; i < 256; i++) {
+			rgba[i * 4] = (palette[i] >> 16) & 0xff;
+			rgba[i * 4 + 1] = (palette[i] >> 8) & 0xff;
+			rgba[i * 4 + 2] = palette[i] & 0xff;
+			rgba[i * 4 + 3] = 0xff;
+		}
+		gl.ActiveTexture(GL_TEXTURE1);
+		gl.BindTexture(GL_TEXTURE_2D, indexed_textures[1]);
+		gl.TexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 256, 1, GL_RGBA, GL_UNSIGNED_BYTE, rgba);
+		indexed_palette_dirty = FALSE;
+	}
+	else {
+		gl.ActiveTexture(GL_TEXTURE1);
+		gl.BindTexture(GL_TEXTURE_2D, indexed_textures[1]);
+	}
+
+	gl.ActiveTexture(GL_TEXTURE0);
+	gl.BindTexture(GL_TEXTURE_2D, indexed_textures[0]);
+	gl.PixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	gl.PixelStorei(GL_UNPACK_ROW_LENGTH, Screen_WIDTH);
+	FindChangedRows(TRUE);
+	for (top = 0; SDL_VIDEO_NextChangedRows(changed_rows, &top, &count); top += count)
+		gl.TexSubImage2D(GL_TEXTURE_2D, 0, 0, top, VIDEOMODE_src_width, count, GL_RED, GL_UNSIGNED_BYTE,
+			atari_screen + Screen_WIDTH * (VIDEOMODE_src_offset_top + top) + VIDEOMODE_src_offset_left);
+	gl.PixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+	gl.PixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	return TRUE;
+}
+#endif /* SDL2 */
+
+#if SDL2
+static void Present(void)
+{
+	int indexed;
 
 	gl.Clear(GL_COLOR_BUFFER_BIT);
 	gl.BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 	gl.Enable(GL_BLEND);
 	gl.Uniform1i(our_texture, 0);
-	gl.ActiveTexture(GL_TEXTURE0);
-	gl.BindTexture(GL_TEXTURE_2D, textures[0]);
-	(*blit_funcs[SDL_VIDEO_current_display_mode])(screen_texture);
-	gl.TexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, VIDEOMODE_actual_width, VIDEOMODE_src_height,
-		pixel_formats[SDL_VIDEO_GL_pixel_format].format, pixel_formats[SDL_VIDEO_GL_pixel_format].type,
-		screen_texture);
+	gl.Uniform1i(sh_palette, 1);
+	indexed = DisplayIndexed();
+	gl.Uniform1i(sh_indexed, indexed);
+	if (!indexed) {
+		gl.ActiveTexture(GL_TEXTURE0);
+		gl.BindTexture(GL_TEXTURE_2D, textures[0]);
+		UploadScreen();
+	}
 
 	gl.BindVertexArray(vaos[0]);
 	float sx = 1.0f, sy = 1.0f;
@@ -1216,11 +1387,108 @@ void SDL_VIDEO_GL_DisplayScreen(void)
 
 	gl.BindBuffer(GL_ARRAY_BUFFER, 0);
 	gl.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+static int PresenterMain(void *arg)
+{
+	SDL_GL_MakeCurrent(SDL_VIDEO_wnd, presenter_context);
+	SDL_LockMutex(presenter_lock);
+	for (;;) {
+		int shown;
+		while (!copy_fresh && !presenter_quit)
+			SDL_CondWait(presenter_cond, presenter_lock);
+		if (presenter_quit)
+			break;
+		shown = copy_ready;
+		copy_ready = copy_shown;
+		copy_shown = shown;
+		copy_fresh = FALSE;
+		SDL_UnlockMutex(presenter_lock);
+
+		atari_screen = screen_copies[shown];
+		Present();
+
+		SDL_LockMutex(presenter_lock);
+	}
+	SDL_UnlockMutex(presenter_lock);
+	SDL_GL_MakeCurrent(SDL_VIDEO_wnd, NULL);
+	return 0;
+}
+
+static int StartPresenter(void)
+{
+	if (screen_copies[0] == NULL) {
+		screen_copies[0] = (UBYTE *)Util_malloc(3 * Screen_WIDTH * Screen_HEIGHT);
+		screen_copies[1] = screen_copies[0] + Screen_WIDTH * Screen_HEIGHT;
+		screen_copies[2] = screen_copies[1] + Screen_WIDTH * Screen_HEIGHT;
+	}
+	if (presenter_lock == NULL) {
+		presenter_lock = SDL_CreateMutex();
+		presenter_cond = SDL_CreateCond();
+	}
+	copy_written = 0;
+	copy_ready = 1;
+	copy_shown = 2;
+	copy_fresh = FALSE;
+	presenter_quit = FALSE;
+	presenter_context = SDL_GL_GetCurrentContext();
+	SDL_GL_MakeCurrent(SDL_VIDEO_wnd, NULL);
+	presenter = SDL_CreateThread(PresenterMain, "atari800 present", NULL);
+	if (presenter == NULL) {
+		Log_print("Cannot start the presentation thread: %s", SDL_GetError());
+		SDL_GL_MakeCurrent(SDL_VIDEO_wnd, presenter_context);
+		SDL_VIDEO_GL_thread = FALSE;
+		return FALSE;
+	}
+	return TRUE;
+}
+
+static void StopPresenter(void)
+{
+	if (presenter == NULL)
+		return;
+	SDL_LockMutex(presenter_lock);
+	presenter_quit = TRUE;
+	SDL_CondSignal(presenter_cond);
+	SDL_UnlockMutex(presenter_lock);
+	SDL_WaitThread(presenter, NULL);
+	presenter = NULL;
+	SDL_GL_MakeCurrent(SDL_VIDEO_wnd, presenter_context);
+}
+#endif /* SDL2 */
+
+void SDL_VIDEO_GL_DisplayScreen(void)
+{
+#if SDL2
+	if (!screen_width || !screen_height) return;
 
+	/* The 80-column displays are drawn from other buffers, which the
+	   emulation goes on writing */
+	if (SDL_VIDEO_GL_thread && SDL_VIDEO_current_display_mode == VIDEOMODE_MODE_NORMAL) {
+		if (presenter != NULL || StartPresenter()) {
+			int written;
+			memcpy(screen_copies[copy_written], Screen_atari, Screen_WIDTH * Screen_HEIGHT);
+			SDL_LockMutex(presenter_lock);
+			written = copy_written;
+			copy_written = copy_ready;
+			copy_ready = written;
+			copy_fresh = TRUE;
+			SDL_CondSignal(presenter_cond);
+			SDL_UnlockMutex(presenter_lock);
+			return;
+		}
+	}
+	else
+		StopPresenter();
+	atari_screen = (UBYTE *)Screen_atari;
+	Present();
 #else
+	atari_screen = (UBYTE *)Screen_atari;
 	gl.BindTexture(GL_TEXTURE_2D, textures[0]);
 	if (SDL_VIDEO_GL_pbo) {
 		GLvoid *ptr;
+		/* The buffer is written anew each frame */
+		SDL_VIDEO_InvalidateRows();
 		gl.BindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, screen_pbo);
 		ptr = gl.MapBuffer(GL_PIXEL_UNPACK_BUFFER_ARB, GL_WRITE_ONLY_ARB);
 		(*blit_funcs[SDL_VIDEO_current_display_mode])(ptr);
@@ -1229,12 +1497,8 @@ void SDL_VIDEO_GL_DisplayScreen(void)
 		                 pixel_formats[SDL_VIDEO_GL_pixel_format].format, pixel_formats[SDL_VIDEO_GL_pixel_format].type,
 		                 NULL);
 		gl.BindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, 0);
-	} else {
-		(*blit_funcs[SDL_VIDEO_current_display_mode])(screen_texture);
-		gl.TexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, VIDEOMODE_actual_width, VIDEOMODE_src_height,
-		                 pixel_formats[SDL_VIDEO_GL_pixel_format].format, pixel_formats[SDL_VIDEO_GL_pixel_format].type,
-		                 screen_texture);
-	}
+	} else
+		UploadScreen();
 	gl.CallList(screen_dlist);
 	SDL_GL_SwapBuffers();
 #endif /* SDL2 */
@@ -1252,6 +1516,12 @@ int SDL_VIDEO_GL_ReadConfig(char *option, char *parameters)
 		return (SDL_VIDEO_GL_filtering = Util_sscanbool(parameters)) != -1;
 	else if (strcmp(option, "OPENGL_PBO") == 0)
 		return (SDL_VIDEO_GL_pbo = Util_sscanbool(parameters)) != -1;
+	else if (strcmp(option, "OPENGL_INDEXED") == 0)
+		return (SDL_VIDEO_GL_indexed = Util_sscanbool(parameters)) != -1;
+#if SDL2
+	else if (strcmp(option, "VIDEO_THREAD") == 0)
+		return (SDL_VIDEO_GL_thread = Util_sscanbool(parameters)) != -1;
+#endif
 	else
 		return FALSE;
 	return TRUE;
@@ -1262,6 +1532,10 @@ void SDL_VIDEO_GL_WriteConfig(FILE *fp)
 	fprintf(fp, "PIXEL_FORMAT=%s\n", pixel_format_cfg_strings[SDL_VIDEO_GL_pixel_format]);
 	fprintf(fp, "BILINEAR_FILTERING=%d\n", SDL_VIDEO_GL_filtering);
 	fprintf(fp, "OPENGL_PBO=%d\n", SDL_VIDEO_GL_pbo);
+	fprintf(fp, "OPENGL_INDEXED=%d\n", SDL_VIDEO_GL_indexed);
+#if SDL2
+	fprintf(fp, "VIDEO_THREAD=%d\n", SDL_VIDEO_GL_thread);
+#endif
 }
 
 /* Loads the OpenGL library. Return TRUE on success, FALSE on failure. */
@@ -1314,6 +1588,16 @@ int SDL_VIDEO_GL_Initialise(int *argc, char *argv[])
 			SDL_VIDEO_GL_pbo = TRUE;
 		else if (strcmp(argv[i], "-no-pbo") == 0)
 			SDL_VIDEO_GL_pbo = FALSE;
+		else if (strcmp(argv[i], "-gl-indexed") == 0)
+			SDL_VIDEO_GL_indexed = TRUE;
+		else if (strcmp(argv[i], "-no-gl-indexed") == 0)
+			SDL_VIDEO_GL_indexed = FALSE;
+#if SDL2
+		else if (strcmp(argv[i], "-video-thread") == 0)
+			SDL_VIDEO_GL_thread = TRUE;
+		else if (strcmp(argv[i], "-no-video-thread") == 0)
+			SDL_VIDEO_GL_thread = FALSE;
+#endif
 		else if (strcmp(argv[i], "-opengl-lib") == 0) {
 			if (i_a)
 				library_path = argv[++i];
@@ -1328,6 +1612,12 @@ int SDL_VIDEO_GL_Initialise(int *argc, char *argv[])
 				Log_print("\t-no-bilinear-filter  Disable OpenGL bilinear filtering");
 				Log_print("\t-pbo                 Use OpenGL Pixel Buffer Objects if available");
 				Log_print("\t-no-pbo              Don't use OpenGL Pixel Buffer Objects");
+				Log_print("\t-gl-indexed          Look up Atari colours in the OpenGL shader");
+				Log_print("\t-no-gl-indexed       Convert Atari colours to RGB before upload");
+#if SDL2
+				Log_print("\t-video-thread        Convert, upload and swap frames on a separate thread");
+				Log_print("\t-no-video-thread     Display frames on the emulation thread");
+#endif
 				Log_print("\t-opengl-lib <path>   Use a custom OpenGL shared library");
 			}
 			argv[j++] = argv[i];
@@ -1352,6 +1642,9 @@ int SDL_VIDEO_GL_Initialise(int *argc, char *argv[])
 
 void SDL_VIDEO_GL_SetPixelFormat(int value)
 {
+#if SDL2
+	StopPresenter();
+#endif
 	SDL_VIDEO_GL_pixel_format = value;
 	if (SDL_VIDEO_screen != NULL && (SDL_VIDEO_screen->flags & SDL_OpenGL_FLAG) == SDL_OpenGL_FLAG) {
 		int new_bpp_32 = value >= SDL_VIDEO_GL_PIXEL_FORMAT_BGRA32;
@@ -1377,6 +1670,9 @@ void SDL_VIDEO_GL_TogglePixelFormat(void)
 
 void SDL_VIDEO_GL_SetFiltering(int value)
 {
+#if SDL2
+	StopPresenter();
+#endif
 	SDL_VIDEO_GL_filtering = value;
 	if (SDL_VIDEO_screen != NULL && (SDL_VIDEO_screen->flags & SDL_OpenGL_FLAG) == SDL_OpenGL_FLAG) {
 		GLint filtering = value ? GL_LINEAR : GL_NEAREST;
@@ -1395,6 +1691,9 @@ void SDL_VIDEO_GL_ToggleFiltering(void)
 
 int SDL_VIDEO_GL_SetPbo(int value)
 {
+#if SDL2
+	StopPresenter();
+#endif
 	if (SDL_VIDEO_screen != NULL && (SDL_VIDEO_screen->flags & SDL_OpenGL_FLAG) == SDL_OpenGL_FLAG) {
 		/* Return false if PBOs are requested but not available. */
 		if (value && !pbo_available)
@@ -43,6 +43,18 @@ extern int SDL_VIDEO_GL_pbo;
 int SDL_VIDEO_GL_SetPbo(int value);
 int SDL_VIDEO_GL_TogglePbo(void);
 
+/* If TRUE, the SDL2 shader display uploads Screen_atari as 8-bit colour
+   indices and looks them up in a palette texture, instead of converting
+   the screen to RGB on the CPU. Takes effect on the next frame. */
+extern int SDL_VIDEO_GL_indexed;
+
+/* If TRUE, the SDL2 OpenGL display hands each screen to a presentation
+   thread, which converts, uploads and swaps it while the emulation goes
+   on, so a swap waiting for vsync doesn't delay the emulation. Screens
+   arriving faster than the thread shows them replace each other. Only the
+   normal display mode uses the thread. */
+extern int SDL_VIDEO_GL_thread;
+
 void SDL_VIDEO_GL_ScanlinesPercentageChanged(void);
 void SDL_VIDEO_GL_InterpolateScanlinesChanged(void);
 
@@ -38,6 +38,7 @@
 #include "config.h"
 #include "filter_ntsc.h"
 #include "log.h"
+#include "palette_blit.h"
 #include "pbi_proto80.h"
 #ifdef PAL_BLENDING
 #include "pal_blending.h"
@@ -596,7 +597,7 @@ static void DisplayNTSCEmu(void)
 	case 16:
 		pixels += VIDEOMODE_dest_offset_left * 2;
 		/* blit atari image, doubled vertically */
-		atari_ntsc_blit_rgb16(FILTER_NTSC_emu,
+		FILTER_NTSC_Blit(&atari_ntsc_blit_rgb16, FILTER_NTSC_emu,
 		                      (ATARI_NTSC_IN_T *) ((UBYTE *)Screen_atari + Screen_WIDTH * VIDEOMODE_src_offset_top + VIDEOMODE_src_offset_left),
 		                      Screen_WIDTH,
 		                      VIDEOMODE_src_width,
@@ -607,7 +608,7 @@ static void DisplayNTSCEmu(void)
 		break;
 	case 32:
 		pixels += VIDEOMODE_dest_offset_left * 4;
-		atari_ntsc_blit_argb32(FILTER_NTSC_emu,
+		FILTER_NTSC_Blit(&atari_ntsc_blit_argb32, FILTER_NTSC_emu,
 		                      (ATARI_NTSC_IN_T *) ((UBYTE *)Screen_atari + Screen_WIDTH * VIDEOMODE_src_offset_top + VIDEOMODE_src_offset_left),
 		                       Screen_WIDTH,
 		                       VIDEOMODE_src_width,
@@ -737,142 +738,119 @@ static void DisplayRotated(void)
 	}
 }
 
-static void DisplayWithoutScaling(void)
+/* The plain Atari screen is drawn only where its rows changed since the
+   frame shown before. DIRTY_RECTS are the destination lines drawn, for
+   SDL_UpdateRects()/SDL_UpdateTexture(); DIRTY_COUNT is -1 when the whole
+   screen was drawn. */
+static UBYTE changed_rows[Screen_HEIGHT];
+static SDL_Rect dirty_rects[Screen_HEIGHT];
+static int dirty_count;
+
+/* Returns the rows to draw, or NULL to draw all of them. */
+static UBYTE const *FindChangedRows(void)
+{
+#if !SDL2
+	/* SDL_Flip() shows the other buffer, which holds the frame before last */
+	if (SDL_VIDEO_screen->flags & SDL_DOUBLEBUF)
+		return NULL;
+#endif
+	SDL_VIDEO_FindChangedRows((UBYTE *)Screen_atari, changed_rows);
+	return changed_rows;
+}
+
+/* Collects the destination lines showing changed rows into dirty_rects,
+   stepping through the source lines as PALETTE_BLIT_Scaled*() do. */
+static void CollectDirtyRects(void)
+{
+	int y = 0;
+	int dy = (VIDEOMODE_src_height << 16) / VIDEOMODE_dest_height;
+	int line;
+	dirty_count = 0;
+	for (line = 0; line < (int)VIDEOMODE_dest_height; line++, y += dy) {
+		SDL_Rect *rect;
+		if (!changed_rows[y >> 16])
+			continue;
+		rect = &dirty_rects[dirty_count > 0 ? dirty_count - 1 : 0];
+		if (dirty_count > 0 && rect->y + rect->h == (int)VIDEOMODE_dest_offset_top + line)
+			rect->h++;
+		else {
+			rect = &dirty_rects[dirty_count++];
+			rect->x = VIDEOMODE_dest_offset_left;
+			rect->y = VIDEOMODE_dest_offset_top + line;
+			rect->w = VIDEOMODE_dest_width;
+			rect->h = 1;
+		}
+	}
+}
+
+static void BlitRows(int top, int count)
 {
 	int pitch4 = SDL_VIDEO_screen->pitch / 4;
-	UBYTE *screen = (UBYTE *)Screen_atari + Screen_WIDTH * VIDEOMODE_src_offset_top + VIDEOMODE_src_offset_left;
-	Uint8 *pixels = (Uint8 *) SDL_VIDEO_screen->pixels + SDL_VIDEO_screen->pitch * VIDEOMODE_dest_offset_top;
+	UBYTE *screen = (UBYTE *)Screen_atari + Screen_WIDTH * (VIDEOMODE_src_offset_top + top) + VIDEOMODE_src_offset_left;
+	Uint8 *pixels = (Uint8 *) SDL_VIDEO_screen->pixels + SDL_VIDEO_screen->pitch * (VIDEOMODE_dest_offset_top + top);
 	switch (SDL_VIDEO_screen->format->BitsPerPixel) {
 	/* Possible values are 8, 16 and 32, as checked earlier in the
 	 * PLATFORM_SetVideoMode() function. */
 	case 8:
 		pixels += VIDEOMODE_dest_offset_left;
-		SDL_VIDEO_BlitNormal8((Uint32 *)pixels, screen, pitch4, VIDEOMODE_src_width, VIDEOMODE_src_height);
+		SDL_VIDEO_BlitNormal8((Uint32 *)pixels, screen, pitch4, VIDEOMODE_src_width, count);
 		break;
 	case 16:
 		pixels += VIDEOMODE_dest_offset_left * 2;
-		SDL_VIDEO_BlitNormal16((Uint32*)pixels, screen, pitch4, VIDEOMODE_src_width, VIDEOMODE_src_height, SDL_PALETTE_buffer.bpp16);
+		PALETTE_BLIT_16((Uint16 *)pixels, SDL_VIDEO_screen->pitch, screen, Screen_WIDTH, VIDEOMODE_src_width, count, SDL_PALETTE_buffer.bpp16);
 		break;
 	default: /* SDL_VIDEO_screen->format->BitsPerPixel == 32 */
 		pixels += VIDEOMODE_dest_offset_left * 4;
-		SDL_VIDEO_BlitNormal32((Uint32 *)pixels, screen, pitch4, VIDEOMODE_src_width, VIDEOMODE_src_height, SDL_PALETTE_buffer.bpp32);
+		PALETTE_BLIT_32((Uint32 *)pixels, SDL_VIDEO_screen->pitch, screen, Screen_WIDTH, VIDEOMODE_src_width, count, SDL_PALETTE_buffer.bpp32);
 	}
 }
 
-static void DisplayWithScaling(void)
+static void DisplayWithoutScaling(void)
 {
-	register Uint32 quad;
-	register int x;
-	register Uint8 *screen = (UBYTE *)Screen_atari + Screen_WIDTH * VIDEOMODE_src_offset_top + VIDEOMODE_src_offset_left;
-	register Uint32 *pixels = (Uint32 *) SDL_VIDEO_screen->pixels;
-	int i;
-	int y = 0;
-	int w1;
-	int w = (VIDEOMODE_src_width) << 16;
-	int h = (VIDEOMODE_src_height) << 16;
-	register int dx = w / VIDEOMODE_dest_width;
-	register int yy;
-	int pos;
-	int pitch4 = SDL_VIDEO_screen->pitch / 4;
-	int dy = h / VIDEOMODE_dest_height;
-	int init_x = (VIDEOMODE_src_width << 16) - 0x4000;
-
-	Uint8 c;
+	UBYTE const *changed = FindChangedRows();
+	if (changed == NULL)
+		BlitRows(0, VIDEOMODE_src_height);
+	else {
+		int top, count;
+		for (top = 0; SDL_VIDEO_NextChangedRows(changed, &top, &count); top += count)
+			BlitRows(top, count);
+		CollectDirtyRects();
+	}
+}
 
-	i = VIDEOMODE_dest_height;
+static void DisplayWithScaling(void)
+{
+	UBYTE *screen = (UBYTE *)Screen_atari + Screen_WIDTH * VIDEOMODE_src_offset_top + VIDEOMODE_src_offset_left;
+	Uint8 *pixels = (Uint8 *) SDL_VIDEO_screen->pixels + SDL_VIDEO_screen->pitch * VIDEOMODE_dest_offset_top;
+	UBYTE const *changed = FindChangedRows();
 
 	switch (SDL_VIDEO_screen->format->BitsPerPixel) {
 	/* Possible values are 8, 16 and 32, as checked earlier in the
 	 * PLATFORM_SetVideoMode() function. */
 	case 8:
-		pixels += pitch4 * VIDEOMODE_dest_offset_top + VIDEOMODE_dest_offset_left / 4;
-		w1 = VIDEOMODE_dest_width / 4 - 1;
-		while (i > 0) {
-			x = init_x;
-			pos = w1;
-			yy = Screen_WIDTH * (y >> 16);
-			while (pos >= 0) {
-#if SDL_BYTEORDER == SDL_BIG_ENDIAN
-				quad = (screen[yy + (x >> 16)] << 0);
-				x -= dx;
-				quad += (screen[yy + (x >> 16)] << 8);
-				x -= dx;
-				quad += (screen[yy + (x >> 16)] << 16);
-				x -= dx;
-				quad += (screen[yy + (x >> 16)] << 24);
-				x -= dx;
-#else
-				quad = (screen[yy + (x >> 16)] << 24);
-				x -= dx;
-				quad += (screen[yy + (x >> 16)] << 16);
-				x -= dx;
-				quad += (screen[yy + (x >> 16)] << 8);
-				x -= dx;
-				quad += (screen[yy + (x >> 16)] << 0);
-				x -= dx;
-#endif
-
-				pixels[pos] = quad;
-				pos--;
-
-			}
-			pixels += pitch4;
-			y += dy;
-			i--;
-		}
+		/* Lines are written four pixels at a time, as whole words */
+		pixels += VIDEOMODE_dest_offset_left & ~3;
+		PALETTE_BLIT_Scaled8(pixels, SDL_VIDEO_screen->pitch, screen, Screen_WIDTH,
+		                     VIDEOMODE_src_width, VIDEOMODE_src_height,
+		                     VIDEOMODE_dest_width, VIDEOMODE_dest_height, VIDEOMODE_dest_width & ~3,
+		                     changed);
 		break;
 	case 16:
-		pixels += pitch4 * VIDEOMODE_dest_offset_top + VIDEOMODE_dest_offset_left / 2;
-		w1 = VIDEOMODE_dest_width / 2 - 1;
-		while (i > 0) {
-			x = init_x;
-			pos = w1;
-			yy = Screen_WIDTH * (y >> 16);
-			while (pos >= 0) {
-#if SDL_BYTEORDER == SDL_BIG_ENDIAN
-				c = screen[yy + (x >> 16)];
-				quad = SDL_PALETTE_buffer.bpp16[c];
-				x -= dx;
-				c = screen[yy + (x >> 16)];
-				quad += SDL_PALETTE_buffer.bpp16[c] << 16;
-				x -= dx;
-#else
-				c = screen[yy + (x >> 16)];
-				quad = SDL_PALETTE_buffer.bpp16[c] << 16;
-				x -= dx;
-				c = screen[yy + (x >> 16)];
-				quad += SDL_PALETTE_buffer.bpp16[c];
-				x -= dx;
-#endif
-
-				pixels[pos] = quad;
-				pos--;
-			}
-			pixels += pitch4;
-			y += dy;
-			i--;
-		}
+		pixels += (VIDEOMODE_dest_offset_left & ~1) * 2;
+		PALETTE_BLIT_Scaled16((Uint16 *)pixels, SDL_VIDEO_screen->pitch, screen, Screen_WIDTH,
+		                      VIDEOMODE_src_width, VIDEOMODE_src_height,
+		                      VIDEOMODE_dest_width, VIDEOMODE_dest_height, VIDEOMODE_dest_width & ~1,
+		                      changed, SDL_PALETTE_buffer.bpp16);
 		break;
-	default:
-		pixels += pitch4 * VIDEOMODE_dest_offset_top + VIDEOMODE_dest_offset_left;
-		w1 = VIDEOMODE_dest_width - 1;
-		/* SDL_VIDEO_screen->format->BitsPerPixel = 32 */
-		while (i > 0) {
-			x = init_x;
-			pos = w1;
-			yy = Screen_WIDTH * (y >> 16);
-			while (pos >= 0) {
-				c = screen[yy + (x >> 16)];
-				quad = SDL_PALETTE_buffer.bpp32[c];
-				x -= dx;
-				pixels[pos] = quad;
-				pos--;
-			}
-			pixels += pitch4;
-			y += dy;
-			i--;
-		}
+	default: /* SDL_VIDEO_screen->format->BitsPerPixel == 32 */
+		pixels += VIDEOMODE_dest_offset_left * 4;
+		PALETTE_BLIT_Scaled32((Uint32 *)pixels, SDL_VIDEO_screen->pitch, screen, Screen_WIDTH,
+		                      VIDEOMODE_src_width, VIDEOMODE_src_height,
+		                      VIDEOMODE_dest_width, VIDEOMODE_dest_height, VIDEOMODE_dest_width,
+		                      changed, SDL_PALETTE_buffer.bpp32);
 	}
+	if (changed != NULL)
+		CollectDirtyRects();
 }
 
 #ifdef PAL_BLENDING
@@ -919,30 +897,52 @@ void SDL_VIDEO_SW_DisplayScreen(void)
 	if (!SDL_VIDEO_texture || !SDL_VIDEO_renderer || !SDL_VIDEO_screen) {
 		return;
 	}
+	dirty_count = -1;
 	(*blit_funcs[SDL_VIDEO_current_display_mode])();
-	SDL_UpdateTexture(SDL_VIDEO_texture, NULL, SDL_VIDEO_screen->pixels, SDL_VIDEO_screen->pitch);
+	if (dirty_count < 0) {
+		/* The other displays draw everything */
+		SDL_VIDEO_InvalidateRows();
+		SDL_UpdateTexture(SDL_VIDEO_texture, NULL, SDL_VIDEO_screen->pixels, SDL_VIDEO_screen->pitch);
+	}
+	else {
+		int i;
+		for (i = 0; i < dirty_count; i++)
+			SDL_UpdateTexture(SDL_VIDEO_texture, &dirty_rects[i],
+			                  (Uint8 *)SDL_VIDEO_screen->pixels + SDL_VIDEO_screen->pitch * dirty_rects[i].y
+			                  + SDL_VIDEO_screen->format->BytesPerPixel * dirty_rects[i].x,
+			                  SDL_VIDEO_screen->pitch);
+	}
 	SDL_RenderClear(SDL_VIDEO_renderer);
 	SDL_RenderCopy(SDL_VIDEO_renderer, SDL_VIDEO_texture, NULL, NULL);
 	SDL_RenderPresent(SDL_VIDEO_renderer);
 #else
-	if (SDL_LockSurface(SDL_VIDEO_screen) != 0)
+	if (SDL_LockSurface(SDL_VIDEO_screen) != 0) {
 		/* When the window manager decides to switch the SDL display from
 		   fullscreen to windowed mode (eg. by minimising the window after the
 		   user pressed Alt+Tab in Windows), hardware surface gets disabled
 		   immediately. In such case surface locking will fail. When it happens,
 		   don't blit to screen as it would cause a segfault. When fullscreen
 		   mode gets re-enabled, surface locking will work again and screen
-		   displaying will be restored */
-		   return;
+		   displaying will be restored, drawing the whole surface anew. */
+		SDL_VIDEO_InvalidateRows();
+		return;
+	}
+	dirty_count = -1;
 	/* Use function corresponding to the current_display_mode. */
 	(*blit_funcs[SDL_VIDEO_current_display_mode])();
 	SDL_UnlockSurface(SDL_VIDEO_screen);
 	/* SDL_UpdateRect is faster than SDL_Flip for a software surface, because
 	   it copies only the used part of the screen. */
-	if (SDL_VIDEO_screen->flags & SDL_DOUBLEBUF)
+	if (SDL_VIDEO_screen->flags & SDL_DOUBLEBUF) {
+		SDL_VIDEO_InvalidateRows();
 		SDL_Flip(SDL_VIDEO_screen);
-	else
+	}
+	else if (dirty_count < 0) {
+		SDL_VIDEO_InvalidateRows();
 		SDL_UpdateRect(SDL_VIDEO_screen, VIDEOMODE_dest_offset_left, VIDEOMODE_dest_offset_top, VIDEOMODE_dest_width, VIDEOMODE_dest_height);
+	}
+	else if (dirty_count > 0)
+		SDL_UpdateRects(SDL_VIDEO_screen, dirty_count, dirty_rects);
 #endif /* SDL2 */
 }
 
@@ -22,13 +22,16 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 */
 
-#define _POSIX_C_SOURCE 200112L /* for snprintf */
+#define _POSIX_C_SOURCE 200809L /* for snprintf and fmemopen */
 
 #include "config.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#ifdef HAVE_MMAP
+#include <sys/mman.h>
+#endif
 
 #include "afile.h"
 #include "antic.h"  /* ANTIC_ypos */
@@ -36,6 +39,7 @@
 #include "binload.h"
 #include "cassette.h"
 #include "compfile.h"
+#include "crc32.h"
 #include "cpu.h"
 #include "esc.h"
 #include "log.h"
@@ -79,7 +83,9 @@ static int image_type[SIO_MAX_DRIVES];
 extern void (*disk_activity_callback)(int drive, int operation);
 #endif
 
+/* The image file, kept open only while the drive may write to it */
 static FILE *disk[SIO_MAX_DRIVES] = { NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL };
+int SIO_disk_writes = SIO_WRITES_DIRECT;
 static int sectorcount[SIO_MAX_DRIVES];
 static int sectorsize[SIO_MAX_DRIVES];
 /* these two are used by the 1450XLD parallel disk device */
@@ -158,6 +164,43 @@ typedef struct tagvapi_sector_header_t {
 /* Additional Info for all copy protected disk types */
 static void *additional_info[SIO_MAX_DRIVES];
 
+/* A disk image as SIO_Mount decoded it, read once and shared by every drive
+   of every emulator context that mounts the same file contents. Where no
+   emulator will make the file shorter it is mapped from the file, so even
+   separate processes share its pages; otherwise it is a copy. The shared
+   image is never written: each drive keeps the pages it wrote to itself,
+   and SIO_disk_writes decides when they reach the file. */
+typedef struct SIO_image_tag {
+	struct SIO_image_tag *next;
+	int refs;
+	/* the file as it is, before any decompressing */
+	ULONG file_size;
+	ULONG crc;
+	ULONG fnv;
+	UBYTE *data;
+	ULONG size;
+	int mapped;
+	int type;
+	int sectorcount;
+	int sectorsize;
+	int boot_sectors_type;
+	int forced_read_only;
+	int pro_max_sector;
+	vapi_sec_info_t *vapi_sectors;
+} SIO_image_t;
+
+static SIO_image_t *images = NULL;
+
+#define SIO_PAGE_SIZE 1024
+
+static SIO_image_t *image[SIO_MAX_DRIVES];	/* NULL when no disk */
+static ULONG drive_size[SIO_MAX_DRIVES];	/* with what the drive wrote */
+static ULONG image_pos[SIO_MAX_DRIVES];	/* where the next read starts */
+static UBYTE **pages[SIO_MAX_DRIVES];	/* those the drive wrote to */
+static ULONG num_pages[SIO_MAX_DRIVES];
+static UBYTE *dirty[SIO_MAX_DRIVES];	/* sectors not in the file yet */
+static int head_track[SIO_MAX_DRIVES];	/* for VAPI timing */
+
 SIO_UnitStatus SIO_drive_status[SIO_MAX_DRIVES];
 char SIO_filename[SIO_MAX_DRIVES][FILENAME_MAX];
 
@@ -187,11 +230,79 @@ static int ExpectedBytes = 0;
 int NetSIO_GetByte(void);
 #endif
 
+/* Accelerated transfers: the delays between the bytes of disk transfers the
+   OS makes are divided by SIO_accel, while the acknowledgements keep their
+   timing. Transfers of copy protected (PRO and ATX)
+   images and of loaders with their own SIO code keep the real timing, and
+   so does everything after a sector was asked for again right after an
+   accelerated transfer of it, as that is how a loader that found the
+   timing wrong retries. */
+int SIO_accel = 1;
+static int accel_transfer = FALSE;	/* the transfer in progress */
+static int accel_fallback = FALSE;	/* until the next disk is mounted */
+static UBYTE accel_last_frame[4];	/* of the last accelerated command */
+/* the OS's copy of the command frame it sends: CDEVIC, CCOMND, CAUX1/2 */
+#define OS_COMMAND_FRAME 0x023a
+
 int ignore_header_writeprotect = FALSE;
 
 int SIO_Initialise(int *argc, char *argv[])
 {
 	int i;
+	int j;
+
+	for (i = j = 1; i < *argc; i++) {
+		int i_a = (i + 1 < *argc);		/* is argument available? */
+		int a_m = FALSE;			/* error, argument missing! */
+		int a_i = FALSE;			/* error, argument invalid! */
+
+		if (strcmp(argv[i], "-disk-writes") == 0) {
+			if (i_a) {
+				char *mode = argv[++i];
+				if (strcmp(mode, "direct") == 0)
+					SIO_disk_writes = SIO_WRITES_DIRECT;
+				else if (strcmp(mode, "overlay") == 0)
+					SIO_disk_writes = SIO_WRITES_OVERLAY;
+				else if (strcmp(mode, "writeback") == 0)
+					SIO_disk_writes = SIO_WRITES_WRITEBACK;
+				else
+					a_i = TRUE;
+			}
+			else a_m = TRUE;
+		}
+		else if (strcmp(argv[i], "-sio-accel") == 0) {
+			if (i_a) {
+				SIO_accel = Util_sscandec(argv[++i]);
+				if (SIO_accel < 1 || SIO_accel > 16)
+					a_i = TRUE;
+				/* the transfers are emulated, not patched */
+				else if (SIO_accel > 1)
+					ESC_enable_sio_patch = FALSE;
+			}
+			else a_m = TRUE;
+		}
+		else {
+			if (strcmp(argv[i], "-help") == 0) {
+				Log_print("\t-sio-accel <n>    Make disk transfers n times faster but still through");
+				Log_print("\t                 POKEY's serial interrupts, instead of the SIO patch (1-16)");
+				Log_print("\t-disk-writes direct|overlay|writeback");
+				Log_print("\t                 Write sectors to the disk image at once, keep them in memory,");
+				Log_print("\t                 or keep them in memory until the disk is removed");
+			}
+			argv[j++] = argv[i];
+		}
+
+		if (a_m) {
+			Log_print("Missing argument for '%s'", argv[i]);
+			return FALSE;
+		}
+		else if (a_i) {
+			Log_print("Invalid argument for '%s'", argv[--i]);
+			return FALSE;
+		}
+	}
+	*argc = j;
+
 	for (i = 0; i < SIO_MAX_DRIVES; i++) {
 		strcpy(SIO_filename[i], "Off");
 		SIO_drive_status[i] = SIO_OFF;
@@ -211,83 +322,306 @@ void SIO_Exit(void)
 		SIO_Dismount(i);
 }
 
-int SIO_Mount(int diskno, const char *filename, int b_open_readonly)
+/* Hashes the file F as it is, before any decompressing */
+static void hash_file(FILE *f, ULONG *size, ULONG *crc, ULONG *fnv)
 {
-	FILE *f = NULL;
-	SIO_UnitStatus status = SIO_READ_WRITE;
-	struct AFILE_ATR_Header header;
+	UBYTE buffer[16384];
+	size_t n;
+
+	*size = 0;
+	*crc = 0xffffffff;
+	*fnv = 2166136261U;
+	Util_rewind(f);
+	while ((n = fread(buffer, 1, sizeof(buffer), f)) > 0) {
+		size_t i;
+		*crc = CRC32_Update(*crc, buffer, (unsigned int) n);
+		for (i = 0; i < n; i++)
+			*fnv = ((*fnv ^ buffer[i]) * 16777619U) & 0xffffffff;
+		*size += (ULONG) n;
+	}
+	Util_rewind(f);
+}
 
-	/* avoid overruns in SIO_filename[] */
-	if (strlen(filename) >= FILENAME_MAX)
-		return FALSE;
+static SIO_image_t *find_image(ULONG file_size, ULONG crc, ULONG fnv)
+{
+	SIO_image_t *img;
 
-	/* release previous disk */
-	SIO_Dismount(diskno);
+	for (img = images; img != NULL; img = img->next) {
+		if (img->file_size == file_size && img->crc == crc && img->fnv == fnv)
+			return img;
+	}
+	return NULL;
+}
 
-	/* open file */
-	if (!b_open_readonly)
-		f = Util_fopen(filename, "rb+", sio_tmpbuf[diskno - 1]);
-	if (f == NULL) {
-		f = Util_fopen(filename, "rb", sio_tmpbuf[diskno - 1]);
-		if (f == NULL)
-			return FALSE;
-		status = SIO_READ_ONLY;
+/* Makes a new shared image of the one SIO_Mount decoded into the arrays of
+   UNIT: DATA, the image decompressed, or else the contents of F */
+static SIO_image_t *new_image(int unit, FILE *f, SIO_UnitStatus status, UBYTE *data, ULONG size)
+{
+	SIO_image_t *img = (SIO_image_t *) Util_malloc(sizeof(SIO_image_t));
+
+	memset(img, 0, sizeof(SIO_image_t));
+	img->size = (ULONG) Util_flen(f);
+	if (data != NULL) {
+		img->data = data;
+		img->size = size;
+	}
+#ifdef HAVE_MMAP
+	else if (img->size > 0 && (status == SIO_READ_ONLY || SIO_disk_writes == SIO_WRITES_OVERLAY)) {
+		/* only where this emulator will not make the file shorter */
+		void *p = mmap(NULL, img->size, PROT_READ, MAP_PRIVATE, fileno(f), 0);
+		if (p != MAP_FAILED) {
+			img->data = (UBYTE *) p;
+			img->mapped = TRUE;
+		}
 	}
+#endif
+	if (img->data == NULL) {
+		img->data = (UBYTE *) Util_malloc(img->size > 0 ? img->size : 1);
+		Util_rewind(f);
+		if (fread(img->data, 1, img->size, f) != img->size) {
+			free(img->data);
+			free(img);
+			return NULL;
+		}
+	}
+	img->type = image_type[unit];
+	img->sectorcount = sectorcount[unit];
+	img->sectorsize = sectorsize[unit];
+	img->boot_sectors_type = boot_sectors_type[unit];
+	if (image_type[unit] == IMAGE_TYPE_PRO)
+		img->pro_max_sector = ((pro_additional_info_t *)additional_info[unit])->max_sector;
+	else if (image_type[unit] == IMAGE_TYPE_VAPI)
+		img->vapi_sectors = ((vapi_additional_info_t *)additional_info[unit])->sectors;
+	img->refs = 1;
+	img->next = images;
+	images = img;
+	return img;
+}
 
-	/* read header */
-	if (fread(&header, 1, sizeof(struct AFILE_ATR_Header), f) != sizeof(struct AFILE_ATR_Header)) {
-		fclose(f);
-		return FALSE;
+/* Changes IMG from a mapping of its file to a copy, before a drive writes
+   to that file */
+static void unmap_image(SIO_image_t *img)
+{
+#ifdef HAVE_MMAP
+	UBYTE *data;
+
+	if (!img->mapped)
+		return;
+	data = (UBYTE *) Util_malloc(img->size);
+	memcpy(data, img->data, img->size);
+	munmap(img->data, img->size);
+	img->data = data;
+	img->mapped = FALSE;
+#endif
+}
+
+/* Makes UNIT a drive with IMG mounted, and its own state for it */
+static void use_image(int unit, SIO_image_t *img, SIO_UnitStatus status)
+{
+	if (status == SIO_READ_WRITE && SIO_disk_writes != SIO_WRITES_OVERLAY)
+		unmap_image(img);
+	image[unit] = img;
+	drive_size[unit] = img->size;
+	image_pos[unit] = 0;
+	pages[unit] = NULL;
+	num_pages[unit] = 0;
+	dirty[unit] = NULL;
+	head_track[unit] = 0;
+	image_type[unit] = img->type;
+	sectorcount[unit] = img->sectorcount;
+	sectorsize[unit] = img->sectorsize;
+	boot_sectors_type[unit] = img->boot_sectors_type;
+	if (img->type == IMAGE_TYPE_PRO) {
+		pro_additional_info_t *info = (pro_additional_info_t *)Util_malloc(sizeof(pro_additional_info_t));
+		info->max_sector = img->pro_max_sector;
+		info->count = (unsigned char *)Util_malloc(img->sectorcount);
+		memset(info->count, 0, img->sectorcount);
+		additional_info[unit] = info;
 	}
+	else if (img->type == IMAGE_TYPE_VAPI) {
+		vapi_additional_info_t *info = (vapi_additional_info_t *)Util_malloc(sizeof(vapi_additional_info_t));
+		memset(info, 0, sizeof(vapi_additional_info_t));
+		info->sectors = img->vapi_sectors;
+		additional_info[unit] = info;
+	}
+}
 
-	/* detect compressed image and uncompress */
-	switch (header.magic1) {
-	case 0xf9:
-	case 0xfa:
-		/* DCM */
-		{
-			FILE *f2 = Util_tmpopen(sio_tmpbuf[diskno - 1]);
-			if (f2 == NULL)
-				return FALSE;
-			Util_rewind(f);
-			if (!CompFile_DCMtoATR(f, f2)) {
-				Util_fclose(f2, sio_tmpbuf[diskno - 1]);
-				fclose(f);
-				return FALSE;
-			}
-			fclose(f);
-			f = f2;
+static void release_image(SIO_image_t *img)
+{
+	SIO_image_t **p;
+
+	if (--img->refs > 0)
+		return;
+	for (p = &images; *p != img; p = &(*p)->next)
+		;
+	*p = img->next;
+#ifdef HAVE_MMAP
+	if (img->mapped)
+		munmap(img->data, img->size);
+	else
+#endif
+		free(img->data);
+	free(img->vapi_sectors);
+	free(img);
+}
+
+/* Reads like fread from image_pos[unit] onwards */
+static int read_image(int unit, UBYTE *buffer, int size)
+{
+	SIO_image_t *img = image[unit];
+	int n = 0;
+
+	while (n < size && image_pos[unit] < drive_size[unit]) {
+		ULONG pos = image_pos[unit];
+		ULONG page = pos / SIO_PAGE_SIZE;
+		int offset = (int) (pos % SIO_PAGE_SIZE);
+		int len = SIO_PAGE_SIZE - offset;
+		if (len > size - n)
+			len = size - n;
+		if ((ULONG) len > drive_size[unit] - pos)
+			len = (int) (drive_size[unit] - pos);
+		if (page < num_pages[unit] && pages[unit][page] != NULL)
+			memcpy(buffer + n, pages[unit][page] + offset, len);
+		else if (pos >= img->size)
+			memset(buffer + n, 0, len);
+		else {
+			int from_image = len;
+			if ((ULONG) from_image > img->size - pos)
+				from_image = (int) (img->size - pos);
+			memcpy(buffer + n, img->data + pos, from_image);
+			memset(buffer + n + from_image, 0, len - from_image);
 		}
-		Util_rewind(f);
-		if (fread(&header, 1, sizeof(struct AFILE_ATR_Header), f) != sizeof(struct AFILE_ATR_Header)) {
-			Util_fclose(f, sio_tmpbuf[diskno - 1]);
-			return FALSE;
+		n += len;
+		image_pos[unit] += len;
+	}
+	return n;
+}
+
+/* The page of UNIT's own sectors holding byte POS, made if there is none */
+static UBYTE *own_page(int unit, ULONG pos)
+{
+	ULONG page = pos / SIO_PAGE_SIZE;
+
+	if (page >= num_pages[unit]) {
+		ULONG n = page + 1;
+		if (n < (drive_size[unit] + SIO_PAGE_SIZE - 1) / SIO_PAGE_SIZE)
+			n = (drive_size[unit] + SIO_PAGE_SIZE - 1) / SIO_PAGE_SIZE;
+		pages[unit] = (UBYTE **) Util_realloc(pages[unit], n * sizeof(UBYTE *));
+		memset(pages[unit] + num_pages[unit], 0, (n - num_pages[unit]) * sizeof(UBYTE *));
+		num_pages[unit] = n;
+	}
+	if (pages[unit][page] == NULL) {
+		ULONG start = page * SIO_PAGE_SIZE;
+		ULONG saved_pos = image_pos[unit];
+		ULONG saved_size = drive_size[unit];
+		pages[unit][page] = (UBYTE *) Util_malloc(SIO_PAGE_SIZE);
+		memset(pages[unit][page], 0, SIO_PAGE_SIZE);
+		/* What the shared image has there */
+		image_pos[unit] = start;
+		if (drive_size[unit] > image[unit]->size)
+			drive_size[unit] = image[unit]->size;
+		if (start < drive_size[unit]) {
+			UBYTE *p = pages[unit][page];
+			pages[unit][page] = NULL;
+			read_image(unit, p, SIO_PAGE_SIZE);
+			pages[unit][page] = p;
 		}
-		status = SIO_READ_ONLY;
-		/* XXX: status = b_open_readonly ? SIO_READ_ONLY : SIO_READ_WRITE; */
-		break;
-	case 0x1f:
-		if (header.magic2 == 0x8b) {
-			/* ATZ/ATR.GZ, XFZ/XFD.GZ */
-			fclose(f);
-			f = Util_tmpopen(sio_tmpbuf[diskno - 1]);
-			if (f == NULL)
-				return FALSE;
-			if (!CompFile_ExtractGZ(filename, f)) {
-				Util_fclose(f, sio_tmpbuf[diskno - 1]);
-				return FALSE;
-			}
-			Util_rewind(f);
-			if (fread(&header, 1, sizeof(struct AFILE_ATR_Header), f) != sizeof(struct AFILE_ATR_Header)) {
-				Util_fclose(f, sio_tmpbuf[diskno - 1]);
-				return FALSE;
-			}
-			status = SIO_READ_ONLY;
-			/* XXX: status = b_open_readonly ? SIO_READ_ONLY : SIO_READ_WRITE; */
+		image_pos[unit] = saved_pos;
+		drive_size[unit] = saved_size;
+	}
+	return pages[unit][page];
+}
+
+/* Writes SIZE bytes of SECTOR at image_pos[unit], to the drive's own pages
+   and, with SIO_WRITES_DIRECT, to the file */
+static void write_image(int unit, int sector, const UBYTE *buffer, int size)
+{
+	ULONG offset = image_pos[unit];
+	int n = 0;
+
+	while (n < size) {
+		ULONG pos = offset + n;
+		int in_page = (int) (pos % SIO_PAGE_SIZE);
+		int len = SIO_PAGE_SIZE - in_page;
+		if (len > size - n)
+			len = size - n;
+		memcpy(own_page(unit, pos) + in_page, buffer + n, len);
+		n += len;
+	}
+	/* Writes past the end of a short image make it longer */
+	if (offset + size > drive_size[unit])
+		drive_size[unit] = offset + size;
+	if (SIO_disk_writes == SIO_WRITES_DIRECT) {
+		fseek(disk[unit], offset, SEEK_SET);
+		fwrite(buffer, 1, size, disk[unit]);
+		return;
+	}
+	if (dirty[unit] == NULL) {
+		dirty[unit] = (UBYTE *) Util_malloc(sectorcount[unit] + 1);
+		memset(dirty[unit], 0, sectorcount[unit] + 1);
+	}
+	dirty[unit][sector] = TRUE;
+}
+
+int SIO_FlushDisk(int diskno)
+{
+	int unit = diskno - 1;
+	int sector;
+	int result = TRUE;
+
+	if (image[unit] == NULL || dirty[unit] == NULL)
+		return TRUE;
+	if (SIO_drive_status[unit] != SIO_READ_WRITE || disk[unit] == NULL)
+		return FALSE;
+	for (sector = 1; sector <= sectorcount[unit]; sector++) {
+		UBYTE buffer[256];
+		int size;
+		ULONG offset;
+		if (!dirty[unit][sector])
+			continue;
+		SIO_SizeOfSector((UBYTE) unit, sector, &size, &offset);
+		image_pos[unit] = offset;
+		size = read_image(unit, buffer, size);
+		if (fseek(disk[unit], offset, SEEK_SET) != 0
+			|| fwrite(buffer, 1, size, disk[unit]) != (size_t) size) {
+			result = FALSE;
+			break;
 		}
-		break;
-	default:
-		break;
+		dirty[unit][sector] = FALSE;
+	}
+	if (fflush(disk[unit]) != 0)
+		result = FALSE;
+	if (!result)
+		Log_print("Failed writing disk %d to %s", diskno, SIO_filename[unit]);
+	return result;
+}
+
+int SIO_ImageHash(int diskno, ULONG *size, ULONG *crc)
+{
+	int unit = diskno - 1;
+
+	if (image[unit] == NULL) {
+		*size = *crc = 0;
+		return TRUE;
+	}
+	*size = image[unit]->file_size;
+	*crc = image[unit]->crc;
+	return num_pages[unit] == 0;
+}
+
+/* Finds the format and geometry of the image in *PF, opened from FILENAME,
+   for drive DISKNO. Formats that are not written to are reopened read-only.
+   Closes the file on failure. */
+static int parse_image(int diskno, FILE **pf, const char *filename,
+                       SIO_UnitStatus *status, int *forced_read_only)
+{
+	FILE *f = *pf;
+	struct AFILE_ATR_Header header;
+
+	Util_rewind(f);
+	if (fread(&header, 1, sizeof(struct AFILE_ATR_Header), f) != sizeof(struct AFILE_ATR_Header)) {
+		Util_fclose(f, sio_tmpbuf[diskno - 1]);
+		return FALSE;
 	}
 
 	boot_sectors_type[diskno - 1] = BOOT_SECTORS_LOGICAL;
@@ -302,8 +636,10 @@ int SIO_Mount(int diskno, const char *filename, int b_open_readonly)
 			return FALSE;
 		}
 
-		if (header.writeprotect != 0 && !ignore_header_writeprotect)
-			status = SIO_READ_ONLY;
+		if (header.writeprotect != 0 && !ignore_header_writeprotect) {
+			*status = SIO_READ_ONLY;
+			*forced_read_only = TRUE;
+		}
 
 		/* ATR header contains length in 16-byte chunks. */
 		/* First compute number of 128-byte chunks
@@ -349,13 +685,14 @@ int SIO_Mount(int diskno, const char *filename, int b_open_readonly)
 
 		/* .atx is read only for now */
 #ifndef VAPI_WRITE_ENABLE
-		if (!b_open_readonly) {
+		if (*status == SIO_READ_WRITE) {
 			fclose(f);
 			f = Util_fopen(filename, "rb", sio_tmpbuf[diskno - 1]);
 			if (f == NULL)
 				return FALSE;
-			status = SIO_READ_ONLY;
+			*status = SIO_READ_ONLY;
 		}
+		*forced_read_only = TRUE;
 #endif
 		
 		image_type[diskno - 1] = IMAGE_TYPE_VAPI;
@@ -503,13 +840,14 @@ int SIO_Mount(int diskno, const char *filename, int b_open_readonly)
 				header.seccountlo == 'P') {
 			pro_additional_info_t *info;
 			/* .pro is read only for now */
-			if (!b_open_readonly) {
+			if (*status == SIO_READ_WRITE) {
 				fclose(f);
 				f = Util_fopen(filename, "rb", sio_tmpbuf[diskno - 1]);
 				if (f == NULL)
 					return FALSE;
-				status = SIO_READ_ONLY;
+				*status = SIO_READ_ONLY;
 			}
+			*forced_read_only = TRUE;
 			image_type[diskno - 1] = IMAGE_TYPE_PRO;
 			sectorsize[diskno - 1] = 128;
 			if (file_length >= 1040*(128+12)+16) {
@@ -550,6 +888,125 @@ int SIO_Mount(int diskno, const char *filename, int b_open_readonly)
 		}
 	}
 
+	*pf = f;
+	return TRUE;
+}
+
+/* Opens DATA, an image decompressed for drive UNIT, as a file */
+static FILE *open_decompressed(int unit, UBYTE *data, ULONG size)
+{
+#ifdef HAVE_FMEMOPEN
+	return fmemopen(data, size, "rb");
+#else
+	FILE *f = Util_tmpopen(sio_tmpbuf[unit]);
+	if (f != NULL && fwrite(data, 1, size, f) != size) {
+		Util_fclose(f, sio_tmpbuf[unit]);
+		return NULL;
+	}
+	return f;
+#endif
+}
+
+int SIO_Mount(int diskno, const char *filename, int b_open_readonly)
+{
+	FILE *f = NULL;
+	SIO_UnitStatus status = SIO_READ_WRITE;
+	struct AFILE_ATR_Header header;
+	ULONG file_size, crc, fnv;
+	SIO_image_t *img;
+	int forced_read_only = FALSE;
+	UBYTE *data = NULL;	/* the decompressed image */
+	ULONG data_size = 0;
+
+	/* avoid overruns in SIO_filename[] */
+	if (strlen(filename) >= FILENAME_MAX)
+		return FALSE;
+
+	/* release previous disk */
+	SIO_Dismount(diskno);
+	/* a new disk may load fine with accelerated transfers */
+	accel_fallback = FALSE;
+
+	/* open file */
+	if (!b_open_readonly)
+		f = Util_fopen(filename, "rb+", sio_tmpbuf[diskno - 1]);
+	if (f == NULL) {
+		f = Util_fopen(filename, "rb", sio_tmpbuf[diskno - 1]);
+		if (f == NULL)
+			return FALSE;
+		status = SIO_READ_ONLY;
+	}
+
+	/* the same contents mounted before need not be read again */
+	hash_file(f, &file_size, &crc, &fnv);
+	img = find_image(file_size, crc, fnv);
+	if (img != NULL) {
+		img->refs++;
+		if (img->forced_read_only)
+			status = SIO_READ_ONLY;
+		if (status == SIO_READ_ONLY)
+			Util_fclose(f, sio_tmpbuf[diskno - 1]);
+		else
+			disk[diskno - 1] = f;
+		use_image(diskno - 1, img, status);
+		SIO_format_sectorsize[diskno - 1] = sectorsize[diskno - 1];
+		SIO_format_sectorcount[diskno - 1] = sectorcount[diskno - 1];
+		strcpy(SIO_filename[diskno - 1], filename);
+		SIO_drive_status[diskno - 1] = status;
+		return TRUE;
+	}
+
+	/* read header */
+	if (fread(&header, 1, sizeof(struct AFILE_ATR_Header), f) != sizeof(struct AFILE_ATR_Header)) {
+		fclose(f);
+		return FALSE;
+	}
+
+	/* detect compressed image and uncompress */
+	switch (header.magic1) {
+	case 0xf9:
+	case 0xfa:
+		/* DCM */
+		Util_rewind(f);
+		if (!CompFile_DCMtoATRBuffer(f, &data, &data_size)) {
+			fclose(f);
+			return FALSE;
+		}
+		fclose(f);
+		f = open_decompressed(diskno - 1, data, data_size);
+		if (f == NULL) {
+			free(data);
+			return FALSE;
+		}
+		status = SIO_READ_ONLY;
+		forced_read_only = TRUE;
+		/* XXX: status = b_open_readonly ? SIO_READ_ONLY : SIO_READ_WRITE; */
+		break;
+	case 0x1f:
+		if (header.magic2 == 0x8b) {
+			/* ATZ/ATR.GZ, XFZ/XFD.GZ */
+			fclose(f);
+			if (!CompFile_ExtractGZToBuffer(filename, &data, &data_size))
+				return FALSE;
+			f = open_decompressed(diskno - 1, data, data_size);
+			if (f == NULL) {
+				free(data);
+				return FALSE;
+			}
+			status = SIO_READ_ONLY;
+			forced_read_only = TRUE;
+			/* XXX: status = b_open_readonly ? SIO_READ_ONLY : SIO_READ_WRITE; */
+		}
+		break;
+	default:
+		break;
+	}
+
+	if (!parse_image(diskno, &f, filename, &status, &forced_read_only)) {
+		free(data);
+		return FALSE;
+	}
+
 #ifdef DEBUG
 	Log_print("sectorcount = %d, sectorsize = %d",
 		   sectorcount[diskno - 1], sectorsize[diskno - 1]);
@@ -557,26 +1014,63 @@ int SIO_Mount(int diskno, const char *filename, int b_open_readonly)
 	SIO_format_sectorsize[diskno - 1] = sectorsize[diskno - 1];
 	SIO_format_sectorcount[diskno - 1] = sectorcount[diskno - 1];
 	strcpy(SIO_filename[diskno - 1], filename);
+	img = new_image(diskno - 1, f, status, data, data_size);
+	if (img == NULL) {
+		if (image_type[diskno - 1] == IMAGE_TYPE_PRO)
+			free(((pro_additional_info_t *)additional_info[diskno-1])->count);
+		else if (image_type[diskno - 1] == IMAGE_TYPE_VAPI)
+			free(((vapi_additional_info_t *)additional_info[diskno-1])->sectors);
+		free(additional_info[diskno - 1]);
+		additional_info[diskno - 1] = NULL;
+		Util_fclose(f, sio_tmpbuf[diskno - 1]);
+		return FALSE;
+	}
+	img->file_size = file_size;
+	img->crc = crc;
+	img->fnv = fnv;
+	img->forced_read_only = forced_read_only;
+	/* the drive's own info, with the VAPI sectors now in the image */
+	if (image_type[diskno - 1] == IMAGE_TYPE_PRO)
+		free(((pro_additional_info_t *)additional_info[diskno-1])->count);
+	free(additional_info[diskno - 1]);
+	additional_info[diskno - 1] = NULL;
+	use_image(diskno - 1, img, status);
+	if (status == SIO_READ_ONLY)
+		Util_fclose(f, sio_tmpbuf[diskno - 1]);
+	else
+		disk[diskno - 1] = f;
 	SIO_drive_status[diskno - 1] = status;
-	disk[diskno - 1] = f;
 	return TRUE;
 }
 
 void SIO_Dismount(int diskno)
 {
-	if (disk[diskno - 1] != NULL) {
-		Util_fclose(disk[diskno - 1], sio_tmpbuf[diskno - 1]);
-		disk[diskno - 1] = NULL;
-		SIO_drive_status[diskno - 1] = SIO_NO_DISK;
-		strcpy(SIO_filename[diskno - 1], "Empty");
-		if (image_type[diskno - 1] == IMAGE_TYPE_PRO) {
-			free(((pro_additional_info_t *)additional_info[diskno-1])->count);
+	int unit = diskno - 1;
+
+	if (image[unit] != NULL) {
+		ULONG i;
+		if (SIO_disk_writes == SIO_WRITES_WRITEBACK)
+			SIO_FlushDisk(diskno);
+		/* only files that are not temporary stay open */
+		if (disk[unit] != NULL) {
+			fclose(disk[unit]);
+			disk[unit] = NULL;
 		}
-		else if (image_type[diskno - 1] == IMAGE_TYPE_VAPI) {
-			free(((vapi_additional_info_t *)additional_info[diskno-1])->sectors);
-		}
-		free(additional_info[diskno - 1]);
-		additional_info[diskno - 1] = 0;
+		release_image(image[unit]);
+		image[unit] = NULL;
+		for (i = 0; i < num_pages[unit]; i++)
+			free(pages[unit][i]);
+		free(pages[unit]);
+		pages[unit] = NULL;
+		num_pages[unit] = 0;
+		free(dirty[unit]);
+		dirty[unit] = NULL;
+		SIO_drive_status[unit] = SIO_NO_DISK;
+		strcpy(SIO_filename[unit], "Empty");
+		if (image_type[unit] == IMAGE_TYPE_PRO)
+			free(((pro_additional_info_t *)additional_info[unit])->count);
+		free(additional_info[unit]);
+		additional_info[unit] = NULL;
 	}
 }
 
@@ -587,6 +1081,135 @@ void SIO_DisableDrive(int diskno)
 	strcpy(SIO_filename[diskno - 1], "Off");
 }
 
+struct SIO_drives_tag {
+	SIO_UnitStatus drive_status[SIO_MAX_DRIVES];
+	char filename[SIO_MAX_DRIVES][FILENAME_MAX];
+	FILE *disk[SIO_MAX_DRIVES];
+	SIO_image_t *image[SIO_MAX_DRIVES];
+	ULONG drive_size[SIO_MAX_DRIVES];
+	ULONG image_pos[SIO_MAX_DRIVES];
+	UBYTE **pages[SIO_MAX_DRIVES];
+	ULONG num_pages[SIO_MAX_DRIVES];
+	UBYTE *dirty[SIO_MAX_DRIVES];
+	int head_track[SIO_MAX_DRIVES];
+	int boot_sectors_type[SIO_MAX_DRIVES];
+	int image_type[SIO_MAX_DRIVES];
+	int sectorcount[SIO_MAX_DRIVES];
+	int sectorsize[SIO_MAX_DRIVES];
+	int format_sectorcount[SIO_MAX_DRIVES];
+	int format_sectorsize[SIO_MAX_DRIVES];
+	int io_success[SIO_MAX_DRIVES];
+	void *additional_info[SIO_MAX_DRIVES];
+};
+
+SIO_drives_t *SIO_SaveDrives(SIO_drives_t *drives)
+{
+	if (drives == NULL)
+		drives = (SIO_drives_t *) Util_malloc(sizeof(SIO_drives_t));
+	memcpy(drives->drive_status, SIO_drive_status, sizeof(SIO_drive_status));
+	memcpy(drives->filename, SIO_filename, sizeof(SIO_filename));
+	memcpy(drives->disk, disk, sizeof(disk));
+	memcpy(drives->image, image, sizeof(image));
+	memcpy(drives->drive_size, drive_size, sizeof(drive_size));
+	memcpy(drives->image_pos, image_pos, sizeof(image_pos));
+	memcpy(drives->pages, pages, sizeof(pages));
+	memcpy(drives->num_pages, num_pages, sizeof(num_pages));
+	memcpy(drives->dirty, dirty, sizeof(dirty));
+	memcpy(drives->head_track, head_track, sizeof(head_track));
+	memcpy(drives->boot_sectors_type, boot_sectors_type, sizeof(boot_sectors_type));
+	memcpy(drives->image_type, image_type, sizeof(image_type));
+	memcpy(drives->sectorcount, sectorcount, sizeof(sectorcount));
+	memcpy(drives->sectorsize, sectorsize, sizeof(sectorsize));
+	memcpy(drives->format_sectorcount, SIO_format_sectorcount, sizeof(SIO_format_sectorcount));
+	memcpy(drives->format_sectorsize, SIO_format_sectorsize, sizeof(SIO_format_sectorsize));
+	memcpy(drives->io_success, io_success, sizeof(io_success));
+	memcpy(drives->additional_info, additional_info, sizeof(additional_info));
+	return drives;
+}
+
+void SIO_LoadDrives(const SIO_drives_t *drives)
+{
+	memcpy(SIO_drive_status, drives->drive_status, sizeof(SIO_drive_status));
+	memcpy(SIO_filename, drives->filename, sizeof(SIO_filename));
+	memcpy(disk, drives->disk, sizeof(disk));
+	memcpy(image, drives->image, sizeof(image));
+	memcpy(drive_size, drives->drive_size, sizeof(drive_size));
+	memcpy(image_pos, drives->image_pos, sizeof(image_pos));
+	memcpy(pages, drives->pages, sizeof(pages));
+	memcpy(num_pages, drives->num_pages, sizeof(num_pages));
+	memcpy(dirty, drives->dirty, sizeof(dirty));
+	memcpy(head_track, drives->head_track, sizeof(head_track));
+	memcpy(boot_sectors_type, drives->boot_sectors_type, sizeof(boot_sectors_type));
+	memcpy(image_type, drives->image_type, sizeof(image_type));
+	memcpy(sectorcount, drives->sectorcount, sizeof(sectorcount));
+	memcpy(sectorsize, drives->sectorsize, sizeof(sectorsize));
+	memcpy(SIO_format_sectorcount, drives->format_sectorcount, sizeof(SIO_format_sectorcount));
+	memcpy(SIO_format_sectorsize, drives->format_sectorsize, sizeof(SIO_format_sectorsize));
+	memcpy(io_success, drives->io_success, sizeof(io_success));
+	memcpy(additional_info, drives->additional_info, sizeof(additional_info));
+}
+
+SIO_drives_t *SIO_CopyDrives(void)
+{
+	SIO_drives_t *drives = SIO_SaveDrives(NULL);
+	int unit;
+
+	for (unit = 0; unit < SIO_MAX_DRIVES; unit++) {
+		ULONG i;
+		if (image[unit] == NULL)
+			continue;
+		image[unit]->refs++;
+		if (num_pages[unit] > 0) {
+			drives->pages[unit] = (UBYTE **) Util_malloc(num_pages[unit] * sizeof(UBYTE *));
+			for (i = 0; i < num_pages[unit]; i++) {
+				drives->pages[unit][i] = NULL;
+				if (pages[unit][i] != NULL) {
+					drives->pages[unit][i] = (UBYTE *) Util_malloc(SIO_PAGE_SIZE);
+					memcpy(drives->pages[unit][i], pages[unit][i], SIO_PAGE_SIZE);
+				}
+			}
+		}
+		if (dirty[unit] != NULL) {
+			drives->dirty[unit] = (UBYTE *) Util_malloc(sectorcount[unit] + 1);
+			memcpy(drives->dirty[unit], dirty[unit], sectorcount[unit] + 1);
+		}
+		if (image_type[unit] == IMAGE_TYPE_PRO) {
+			pro_additional_info_t *info = (pro_additional_info_t *) Util_malloc(sizeof(pro_additional_info_t));
+			*info = *(pro_additional_info_t *) additional_info[unit];
+			info->count = (unsigned char *) Util_malloc(sectorcount[unit]);
+			memcpy(info->count, ((pro_additional_info_t *) additional_info[unit])->count, sectorcount[unit]);
+			drives->additional_info[unit] = info;
+		}
+		else if (image_type[unit] == IMAGE_TYPE_VAPI) {
+			vapi_additional_info_t *info = (vapi_additional_info_t *) Util_malloc(sizeof(vapi_additional_info_t));
+			*info = *(vapi_additional_info_t *) additional_info[unit];
+			drives->additional_info[unit] = info;
+		}
+		/* the copy writes through its own handle */
+		if (disk[unit] != NULL) {
+			drives->disk[unit] = fopen(SIO_filename[unit], "rb+");
+			if (drives->disk[unit] == NULL)
+				drives->drive_status[unit] = SIO_READ_ONLY;
+		}
+	}
+	return drives;
+}
+
+void SIO_FreeDrives(SIO_drives_t *drives)
+{
+	SIO_drives_t current;
+	int i;
+
+	if (drives == NULL)
+		return;
+	SIO_SaveDrives(&current);
+	SIO_LoadDrives(drives);
+	for (i = 1; i <= SIO_MAX_DRIVES; i++)
+		SIO_Dismount(i);
+	SIO_LoadDrives(&current);
+	free(drives);
+}
+
 void SIO_SizeOfSector(UBYTE unit, int sector, int *sz, ULONG *ofs)
 {
 	int size;
@@ -648,7 +1271,7 @@ static int SeekSector(int unit, int sector)
 	SIO_last_sector = sector;
 	snprintf(SIO_status, sizeof(SIO_status), "%d: %d", unit + 1, sector);
 	SIO_SizeOfSector((UBYTE) unit, sector, &size, &offset);
-	fseek(disk[unit], offset, SEEK_SET);
+	image_pos[unit] = offset;
 
 	return size;
 }
@@ -663,7 +1286,7 @@ int SIO_ReadSector(int unit, int sector, UBYTE *buffer)
 	io_success[unit] = -1;
 	if (SIO_drive_status[unit] == SIO_OFF)
 		return 0;
-	if (disk[unit] == NULL)
+	if (image[unit] == NULL)
 		return 'N';
 	if (sector <= 0 || sector > sectorcount[unit])
 		return 'E';
@@ -683,7 +1306,7 @@ int SIO_ReadSector(int unit, int sector, UBYTE *buffer)
 		unsigned char *count;
 		info = (pro_additional_info_t *)additional_info[unit];
 		count = info->count;
-		if (fread(buffer, 1, 12, disk[unit]) < 12) {
+		if (read_image(unit, buffer, 12) < 12) {
 			Log_print("Error in header of .pro image: sector:%d", sector);
 			return 'E';
 		}
@@ -703,7 +1326,7 @@ int SIO_ReadSector(int unit, int sector, UBYTE *buffer)
 				}
 				size = SeekSector(unit, sector);
 				/* read sector header */
-				if (fread(buffer, 1, 12, disk[unit]) < 12) {
+				if (read_image(unit, buffer, 12) < 12) {
 					Log_print("Error in header2 of .pro image: sector:%d dupnum:%d", sector, dupnum);
 					return 'E';
 				}
@@ -711,7 +1334,7 @@ int SIO_ReadSector(int unit, int sector, UBYTE *buffer)
 		}
 		/* bad sector */
 		if (buffer[1] != 0xff) {
-			if (fread(buffer, 1, size, disk[unit]) < size) {
+			if (read_image(unit, buffer, size) < size) {
 				Log_print("Error in bad sector of .pro image: sector:%d", sector);
 			}
 			io_success[unit] = sector;
@@ -725,7 +1348,6 @@ int SIO_ReadSector(int unit, int sector, UBYTE *buffer)
 		vapi_additional_info_t *info;
 		vapi_sec_info_t *secinfo;
 		ULONG secindex = 0;
-		static int lasttrack = 0;
 		unsigned int currpos, time, delay, rotations, bestdelay;
 /*		unsigned char beststatus;*/
 		int fromtrack, trackstostep, j;
@@ -746,8 +1368,8 @@ int SIO_ReadSector(int unit, int sector, UBYTE *buffer)
 		}
 
 		secinfo = &info->sectors[sector-1];
-		fromtrack = lasttrack;
-		lasttrack = (sector-1)/18;
+		fromtrack = head_track[unit];
+		head_track[unit] = (sector-1)/18;
 
 		if (secinfo->sec_count == 0) {
 #ifdef DEBUG_VAPI
@@ -803,13 +1425,13 @@ int SIO_ReadSector(int unit, int sector, UBYTE *buffer)
 		if (secinfo->sec_count > 1)
 			Log_print("duplicate sector:%d dupnum:%d delay:%d",sector, secindex,info->vapi_delay_time);
 #endif
-		fseek(disk[unit],secinfo->sec_offset[secindex],SEEK_SET);
+		image_pos[unit] = secinfo->sec_offset[secindex];
 		info->sec_stat_buff[0] = 0x8 | ((secinfo->sec_status[secindex] == 0xFF) ? 0 : 0x04);
 		info->sec_stat_buff[1] = secinfo->sec_status[secindex];
 		info->sec_stat_buff[2] = 0xe0;
 		info->sec_stat_buff[3] = 0;
 		if (secinfo->sec_status[secindex] != 0xFF) {
-			if (fread(buffer, 1, size, disk[unit]) < size) {
+			if (read_image(unit, buffer, size) < size) {
 				Log_print("error reading sector:%d", sector);
 			}
 			io_success[unit] = sector;
@@ -833,7 +1455,7 @@ int SIO_ReadSector(int unit, int sector, UBYTE *buffer)
 		Log_flushlog();
 #endif		
 	}
-	if (fread(buffer, 1, size, disk[unit]) < size) {
+	if (read_image(unit, buffer, size) < size) {
 		Log_print("incomplete sector num:%d", sector);
 	}
 	io_success[unit] = 0;
@@ -846,7 +1468,7 @@ int SIO_WriteSector(int unit, int sector, const UBYTE *buffer)
 	io_success[unit] = -1;
 	if (SIO_drive_status[unit] == SIO_OFF)
 		return 0;
-	if (disk[unit] == NULL)
+	if (image[unit] == NULL)
 		return 'N';
 	if (SIO_drive_status[unit] != SIO_READ_WRITE || sector <= 0 || sector > sectorcount[unit])
 		return 'E';
@@ -878,8 +1500,8 @@ int SIO_WriteSector(int unit, int sector, const UBYTE *buffer)
 		}
 		
 		size = SeekSector(unit, sector);
-		fseek(disk[unit],secinfo->sec_offset[0],SEEK_SET);
-		fwrite(buffer, 1, size, disk[unit]);
+		image_pos[unit] = secinfo->sec_offset[0];
+		write_image(unit, sector, buffer, size);
 		io_success[unit] = 0;
 		return 'C';
 #if 0		
@@ -901,7 +1523,7 @@ int SIO_WriteSector(int unit, int sector, const UBYTE *buffer)
 	} 
 #endif
 	size = SeekSector(unit, sector);
-	fwrite(buffer, 1, size, disk[unit]);
+	write_image(unit, sector, buffer, size);
 	io_success[unit] = 0;
 	return 'C';
 }
@@ -918,10 +1540,27 @@ int SIO_FormatDisk(int unit, UBYTE *buffer, int sectsize, int sectcount)
 	io_success[unit] = -1;
 	if (SIO_drive_status[unit] == SIO_OFF)
 		return 0;
-	if (disk[unit] == NULL)
+	if (image[unit] == NULL)
 		return 'N';
 	if (SIO_drive_status[unit] != SIO_READ_WRITE)
 		return 'E';
+	if (SIO_disk_writes != SIO_WRITES_DIRECT) {
+		/* Only the sectors in memory are cleared, so the disk keeps its
+		   size */
+		if (sectsize != sectorsize[unit] || sectcount != sectorcount[unit])
+			return 'E';
+		memset(buffer, 0, sectsize);
+		for (i = 1; i <= sectcount; i++) {
+			int size;
+			ULONG offset;
+			SIO_SizeOfSector((UBYTE) unit, i, &size, &offset);
+			image_pos[unit] = offset;
+			write_image(unit, i, buffer, size);
+		}
+		memset(buffer, 0xff, sectsize);
+		io_success[unit] = 0;
+		return 'C';
+	}
 	/* Note formatting the disk can change size of the file.
 	   There is no portable way to truncate the file at given position.
 	   We have to close the "rb+" open file and open it in "wb" mode.
@@ -1090,7 +1729,7 @@ int SIO_DriveStatus(int unit, UBYTE *buffer)
 	if (io_success[unit] != 0  && image_type[unit] == IMAGE_TYPE_PRO) {
 		int sector = io_success[unit];
 		SeekSector(unit, sector);
-		if (fread(buffer, 1, 4, disk[unit]) < 4) {
+		if (read_image(unit, buffer, 4) < 4) {
 			Log_print("SIO_DriveStatus: failed to read sector header");
 		}
 		return 'C';
@@ -1107,7 +1746,7 @@ int SIO_DriveStatus(int unit, UBYTE *buffer)
 		return 'C';
 	}	
 	buffer[0] = 16;         /* drive active */
-	buffer[1] = disk[unit] != NULL ? 255 /* WD 177x OK */ : 127 /* no disk */;
+	buffer[1] = image[unit] != NULL ? 255 /* WD 177x OK */ : 127 /* no disk */;
 	if (io_success[unit] != 0)
 		buffer[0] |= 4;     /* failed RW-operation */
 	if (SIO_drive_status[unit] == SIO_READ_ONLY)
@@ -1141,6 +1780,9 @@ void SIO_Handler(void)
 	int realsize = 0;
 	int cmd = MEMORY_dGetByte(0x302);
 
+#ifndef BASIC
+	Atari800_QuickBootSIO();
+#endif
 	if ((unsigned int)MEMORY_dGetByte(0x300) + (unsigned int)MEMORY_dGetByte(0x301) > 0xff) {
 		/* carry */
 		unit++;
@@ -1525,6 +2167,37 @@ static UBYTE Command_Frame(void)
 	}
 }
 
+int SIO_TransferDelay(int delay)
+{
+	if (!accel_transfer || TransferStatus == SIO_NoFrame)
+		return delay;
+	delay /= SIO_accel;
+	/* About 57600 baud, as fast as high-speed drives went: the OS misses
+	   bytes that come in faster */
+	return delay < 3 ? 3 : delay;
+}
+
+/* Decides whether the command frame just received from the OS starts an
+   accelerated transfer for drive UNIT */
+static void CheckAcceleration(int unit)
+{
+	int command = CommandFrame[1] & 0x7f;
+
+	if (image_type[unit] == IMAGE_TYPE_PRO || image_type[unit] == IMAGE_TYPE_VAPI) {
+		accel_transfer = FALSE;
+		memset(accel_last_frame, 0, sizeof(accel_last_frame));
+		return;
+	}
+	/* Status is polled; other commands repeated are retries */
+	if (command != 0x53 && command != 0x4e && memcmp(CommandFrame, accel_last_frame, 4) == 0) {
+		Log_print("SIO: command repeated, disk transfers back to real timing");
+		accel_fallback = TRUE;
+		accel_transfer = FALSE;
+		return;
+	}
+	memcpy(accel_last_frame, CommandFrame, 4);
+}
+
 /* Enable/disable the command frame */
 void SIO_SwitchCommandFrame(int onoff)
 {
@@ -1544,6 +2217,7 @@ void SIO_SwitchCommandFrame(int onoff)
 		DataIndex = 0;
 		ExpectedBytes = 5;
 		TransferStatus = SIO_CommandFrame; /* Send Command Frame bytes in SIO_PutByte */
+		accel_transfer = SIO_accel > 1 && !accel_fallback;
 	}
 	else
 	{
@@ -1684,12 +2358,19 @@ void SIO_PutByte(int byte)
 			CommandFrame[CommandIndex++] = byte;
 			if (CommandIndex >= ExpectedBytes) {
 				if (CommandFrame[0] >= 0x31 && CommandFrame[0] <= 0x38 && (SIO_drive_status[CommandFrame[0]-0x31] != SIO_OFF || BINLOAD_start_binloading)) {
+					if (accel_transfer)
+						CheckAcceleration(CommandFrame[0] - 0x31);
 					TransferStatus = SIO_StatusRead;
 					POKEY_DELAYED_SERIN_IRQ = SIO_SERIN_INTERVAL + SIO_ACK_INTERVAL;
 				}
 				else
 					TransferStatus = SIO_NoFrame;
 			}
+			/* only the frame the OS sends is accelerated */
+			else if (CommandIndex <= 4 && byte != MEMORY_dGetByte(OS_COMMAND_FRAME + CommandIndex - 1)) {
+				accel_transfer = FALSE;
+				memset(accel_last_frame, 0, sizeof(accel_last_frame));
+			}
 		}
 		else {
 			Log_print("Invalid command frame!");
@@ -1852,8 +2533,8 @@ int SIO_GetByte(void)
 			}
 			else {
 				/* set delay using the expected transfer speed */
-				POKEY_DELAYED_SERIN_IRQ = (DataIndex == 1) ? SIO_SERIN_INTERVAL
-					: ((SIO_SERIN_INTERVAL * POKEY_AUDF[POKEY_CHAN3] - 1) / 0x28 + 1);
+				POKEY_DELAYED_SERIN_IRQ = SIO_TransferDelay((DataIndex == 1) ? SIO_SERIN_INTERVAL
+					: ((SIO_SERIN_INTERVAL * POKEY_AUDF[POKEY_CHAN3] - 1) / 0x28 + 1));
 			}
 		}
 		else {
@@ -20,6 +20,14 @@ extern char SIO_status[256];
 extern SIO_UnitStatus SIO_drive_status[SIO_MAX_DRIVES];
 extern char SIO_filename[SIO_MAX_DRIVES][FILENAME_MAX];
 
+/* When written sectors reach the disk image file: at once, only when
+   SIO_FlushDisk() is called, or also when the disk is removed. Until then
+   they are kept in memory by each emulator. */
+#define SIO_WRITES_DIRECT    0
+#define SIO_WRITES_OVERLAY   1
+#define SIO_WRITES_WRITEBACK 2
+extern int SIO_disk_writes;
+
 #define SIO_LAST_READ 0
 #define SIO_LAST_WRITE 1
 extern int SIO_last_op;
@@ -30,7 +38,27 @@ extern int SIO_last_sector;
 int SIO_Mount(int diskno, const char *filename, int b_open_readonly);
 void SIO_Dismount(int diskno);
 void SIO_DisableDrive(int diskno);
+/* Writes the sectors written since they were last written to the file.
+   Returns FALSE if that failed or the image file is read-only. */
+int SIO_FlushDisk(int diskno);
+/* Sets *SIZE and *CRC to the size and CRC32 of the image file in drive
+   DISKNO, both 0 if there is none. Returns FALSE if the drive has written
+   to the disk since it was mounted, so it no longer holds just that file. */
+int SIO_ImageHash(int diskno, ULONG *size, ULONG *crc);
 int SIO_RotateDisks(void);
+
+/* The drives with their disks, as held by one libatari800 emulator context.
+   SIO_SaveDrives() moves the drives in use into DRIVES, allocated if NULL,
+   and SIO_LoadDrives() puts them back in use; either leaves the other copy
+   to be overwritten, not freed. SIO_CopyDrives() returns a copy of the
+   drives in use that mounts the same shared images but reads, writes and
+   times its disks apart. SIO_FreeDrives() dismounts the disks of a set not
+   in use and frees it. */
+typedef struct SIO_drives_tag SIO_drives_t;
+SIO_drives_t *SIO_SaveDrives(SIO_drives_t *drives);
+void SIO_LoadDrives(const SIO_drives_t *drives);
+SIO_drives_t *SIO_CopyDrives(void);
+void SIO_FreeDrives(SIO_drives_t *drives);
 void SIO_Handler(void);
 
 UBYTE SIO_ChkSum(const UBYTE *buffer, int length);
@@ -49,6 +77,13 @@ void SIO_Exit(void);
 #define SIO_SEROUT_INTERVAL    8
 #define SIO_ACK_INTERVAL      36
 
+/* Divisor of the delays between the bytes of disk transfers made by the OS
+   without the SIO patch (-sio-accel); 1 keeps the real timing. */
+extern int SIO_accel;
+/* DELAY scanlines of the transfer in progress, shortened when it is
+   accelerated */
+int SIO_TransferDelay(int delay);
+
 /* These functions are also used by the 1450XLD Parallel disk device */
 extern int SIO_format_sectorcount[SIO_MAX_DRIVES];
 extern int SIO_format_sectorsize[SIO_MAX_DRIVES];
@@ -28,6 +28,11 @@
 #include "sound.h"
 
 #include "atari.h"
+#include "ai_interface.h"
+#include "ai_timeline.h"
+#ifdef AUDIO_RECORDING
+#include "file_export.h"
+#endif /* AUDIO_RECORDING */
 #include "log.h"
 #include "platform.h"
 #include "pokeysnd.h"
@@ -48,20 +53,62 @@ Sound_setup_t Sound_out;
 
 static int paused = TRUE;
 
+int Sound_lazy = TRUE;
+/* Set when the last frame's samples were thrown away because turbo mode
+   had filled the output buffer. */
+static int samples_dropped = FALSE;
+
+int Sound_observers = 0;
+
+int Sound_turbo_detach = FALSE;
+/* Set while the output is paused because the emulation runs faster than
+   real time with Sound_turbo_detach on. */
+static int detached = FALSE;
+/* Length in bytes of the samples the last Sound_Update took. */
+static unsigned int frame_bytes = 0;
+
 #ifndef SOUND_CALLBACK
 static UBYTE *process_buffer = NULL;
 static unsigned int process_buffer_size;
 #endif /* !SOUND_CALLBACK */
 
+/* sync_buffer is a single-producer/single-consumer ring: UpdateSyncBuffer
+   writes the samples of each frame and FillBuffer reads them, in the audio
+   thread when SOUND_CALLBACK is defined. write_pos and read_pos count bytes
+   from the start, wrapping at 2^32, and the byte at position P is at
+   sync_buffer[P & sync_buffer_mask]. Only the producer stores write_pos and
+   only the consumer stores read_pos, each after moving the data, so the
+   two sides need no lock; the positions sit on separate cache lines so
+   they don't bounce between the CPUs. At most sync_buffer_size bytes are
+   queued, which is less than the storage size. */
+#if defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 7))
+#define RING_LOAD(x) __atomic_load_n(&(x), __ATOMIC_ACQUIRE)
+#define RING_STORE(x, v) __atomic_store_n(&(x), (v), __ATOMIC_RELEASE)
+#define RING_LOCK()
+#define RING_UNLOCK()
+#else
+/* No atomics: the producer keeps the audio thread out instead */
+#define RING_LOAD(x) (x)
+#define RING_STORE(x, v) ((x) = (v))
+#define RING_LOCK() PLATFORM_SoundLock()
+#define RING_UNLOCK() PLATFORM_SoundUnlock()
+#endif
+
+enum { CACHE_LINE = 64 };
+
+static struct {
+	unsigned int write_pos;
+	unsigned int overruns; /* frames that had to wait for room */
+	unsigned int dropped; /* turbo frames thrown away */
+	UBYTE pad1[CACHE_LINE - 3 * sizeof(unsigned int)];
+	unsigned int read_pos;
+	unsigned int underruns; /* reads that found too few samples */
+	UBYTE pad2[CACHE_LINE - 2 * sizeof(unsigned int)];
+} sync_ring;
+
 static UBYTE *sync_buffer = NULL;
 static unsigned int sync_buffer_size;
-/* Two invariants are held:
-   a) 0 <= sync_read_pos < sync_buffer_size
-   b) sync_read_pos <= sync_write_pos <= sync_buffer_size + sync_read_pos
-   sync_write_pos may be >= sync_buffer_size. In such case the actual write
-   position is sync_write_pos % sync_buffer_size. */
-static unsigned int sync_write_pos;
-static unsigned int sync_read_pos;
+static unsigned int sync_buffer_mask;
 
 unsigned int Sound_latency = 20;
 /* Cumulative audio difference. */
@@ -106,6 +153,12 @@ int Sound_ReadConfig(char *option, char *ptr)
 	}
 	else if (strcmp(option, "SOUND_LATENCY") == 0)
 		return (Sound_latency = Util_sscandec(ptr)) != -1;
+	else if (strcmp(option, "SOUND_LAZY") == 0)
+		return (Sound_lazy = Util_sscanbool(ptr)) != -1;
+	else if (strcmp(option, "SOUND_TURBO_DETACH") == 0)
+		return (Sound_turbo_detach = Util_sscanbool(ptr)) != -1;
+	else if (strcmp(option, "SOUND_THREAD") == 0)
+		return (POKEYSND_threaded = Util_sscanbool(ptr)) != -1;
 	else
 		return FALSE;
 	return TRUE;
@@ -118,6 +171,9 @@ void Sound_WriteConfig(FILE *fp)
 	fprintf(fp, "SOUND_BITS=%u\n", Sound_desired.sample_size * 8);
 	fprintf(fp, "SOUND_BUFFER_MS=%u\n", Sound_desired.buffer_ms);
 	fprintf(fp, "SOUND_LATENCY=%u\n", Sound_latency);
+	fprintf(fp, "SOUND_LAZY=%d\n", Sound_lazy);
+	fprintf(fp, "SOUND_TURBO_DETACH=%d\n", Sound_turbo_detach);
+	fprintf(fp, "SOUND_THREAD=%d\n", POKEYSND_threaded);
 }
 
 int Sound_Initialise(int *argc, char *argv[])
@@ -167,6 +223,18 @@ int Sound_Initialise(int *argc, char *argv[])
 			if (i_a)
 				Sound_latency = Util_sscandec(argv[++i]);
 			else a_m = TRUE;
+		else if (strcmp(argv[i], "-lazy-sound") == 0)
+			Sound_lazy = TRUE;
+		else if (strcmp(argv[i], "-no-lazy-sound") == 0)
+			Sound_lazy = FALSE;
+		else if (strcmp(argv[i], "-turbo-detach-sound") == 0)
+			Sound_turbo_detach = TRUE;
+		else if (strcmp(argv[i], "-no-turbo-detach-sound") == 0)
+			Sound_turbo_detach = FALSE;
+		else if (strcmp(argv[i], "-sound-thread") == 0)
+			POKEYSND_threaded = TRUE;
+		else if (strcmp(argv[i], "-no-sound-thread") == 0)
+			POKEYSND_threaded = FALSE;
 		else {
 			if (strcmp(argv[i], "-help") == 0) {
 				help_only = TRUE;
@@ -178,6 +246,15 @@ int Sound_Initialise(int *argc, char *argv[])
 				Log_print("\t-audio8              Set sound output format to 8-bit");
 				Log_print("\t-snd-buflen <ms>     Set length of the hardware sound buffer in milliseconds");
 				Log_print("\t-snddelay <ms>       Set sound latency in milliseconds");
+				Log_print("\t-lazy-sound          Skip sound synthesis while nothing plays or records it");
+				Log_print("\t-no-lazy-sound       Always synthesise sound");
+				Log_print("\t-turbo-detach-sound  Stop sound output in turbo mode, keep recording");
+				Log_print("\t-no-turbo-detach-sound");
+				Log_print("\t                     Play sound in turbo mode, dropping what doesn't fit");
+#ifdef HAVE_PTHREAD_CREATE
+				Log_print("\t-sound-thread        Synthesise sound on a separate thread, one frame late");
+				Log_print("\t-no-sound-thread     Synthesise sound along with the emulation");
+#endif
 			}
 			argv[j++] = argv[i];
 		}
@@ -288,45 +365,44 @@ void Sound_Continue(void)
 		last_audio_write_time = Util_time();
 		PLATFORM_SoundContinue();
 		paused = FALSE;
+		detached = FALSE;
+		POKEYSND_quiet = FALSE;
 	}
 }
 
-/* Fills buffer BUFFER with SIZE bytes of audio samples. */
+/* Fills buffer BUFFER with SIZE bytes of audio samples. This is the
+   consumer side of sync_ring. */
 static void FillBuffer(UBYTE *buffer, unsigned int size)
 {
-	unsigned int new_read_pos;
 	static UBYTE last_frame[MAX_FRAME_SIZE];
 	unsigned int bytes_per_frame = Sound_out.channels * Sound_out.sample_size;
-	unsigned int to_write = sync_write_pos - sync_read_pos;
+	unsigned int read_pos = sync_ring.read_pos;
+	unsigned int to_write = RING_LOAD(sync_ring.write_pos) - read_pos;
 
 	if (to_write > 0) {
+		unsigned int pos = read_pos & sync_buffer_mask;
+		unsigned int first_part_size = sync_buffer_mask + 1 - pos;
 		if (to_write > size)
 			to_write = size;
 
-		new_read_pos = sync_read_pos + to_write;
-
-		if (new_read_pos <= sync_buffer_size)
+		if (to_write <= first_part_size)
 			/* no wrap */
-			memcpy(buffer, sync_buffer + sync_read_pos, to_write);
+			memcpy(buffer, sync_buffer + pos, to_write);
 		else {
 			/* wraps */
-			unsigned int first_part_size = sync_buffer_size - sync_read_pos;
-			memcpy(buffer, sync_buffer + sync_read_pos, first_part_size);
+			memcpy(buffer, sync_buffer + pos, first_part_size);
 			memcpy(buffer + first_part_size, sync_buffer, to_write - first_part_size);
 		}
-
-		sync_read_pos = new_read_pos;
-		if (sync_read_pos > sync_buffer_size) {
-			sync_read_pos -= sync_buffer_size;
-			sync_write_pos -= sync_buffer_size;
-		}
 		/* Save the last frame as we may need it to fill underflow. */
 		memcpy(last_frame, buffer + to_write - bytes_per_frame, bytes_per_frame);
+		/* Hand the space back to the producer */
+		RING_STORE(sync_ring.read_pos, read_pos + to_write);
 	}
 
 
 	/* Just repeat the last good frame if underflow. */
 	if (to_write < size) {
+		RING_STORE(sync_ring.underruns, sync_ring.underruns + 1);
 #if DEBUG
 		Log_print("Sound buffer underflow: fill %d, needed %d",
 		          to_write/Sound_out.channels/Sound_out.sample_size,
@@ -344,11 +420,13 @@ void Sound_Callback(UBYTE *buffer, unsigned int size)
 {
 #if DEBUG >= 2
 		Log_print("Callback: fill %u, needed %u",
-		          (sync_write_pos - sync_read_pos) / Sound_out.channels / Sound_out.sample_size,
+		          (sync_ring.write_pos - sync_ring.read_pos) / Sound_out.channels / Sound_out.sample_size,
 		          size / Sound_out.channels / Sound_out.sample_size);
 #endif
+	AI_TIMELINE_BEGIN(AI_TIMELINE_AUDIO, "callback");
 	FillBuffer(buffer, size);
 	last_audio_write_time = Util_time();
+	AI_TIMELINE_END(AI_TIMELINE_AUDIO);
 }
 #else /* !SOUND_CALLBACK */
 /* Write audio to output device. */
@@ -359,7 +437,7 @@ static void WriteOut(void)
 	if (avail > 0) {
 #if DEBUG >= 2
 		Log_print("WriteOut: fill %u, needed %u",
-		          (sync_write_pos - sync_read_pos) / Sound_out.channels / Sound_out.sample_size,
+		          (sync_ring.write_pos - sync_ring.read_pos) / Sound_out.channels / Sound_out.sample_size,
 		          avail / Sound_out.channels / Sound_out.sample_size);
 #endif
 		/* On some platforms (eg. NestedVM) avail may be larger than process_buffer_size. */
@@ -374,16 +452,28 @@ static void WriteOut(void)
 }
 #endif /* !SOUND_CALLBACK */
 
+/* Whether something other than the output takes every frame's samples */
+static int SamplesWanted(void)
+{
+#ifdef AUDIO_RECORDING
+	if (File_Export_IsRecording())
+		return TRUE;
+#endif /* AUDIO_RECORDING */
+	return Sound_observers > 0;
+}
+
+/* Queues the frame's samples in sync_ring; this is the producer side. */
 static void UpdateSyncBuffer(void)
 {
 	unsigned int bytes_written;
 	unsigned int samples_written;
 	unsigned int fill;
-	unsigned int new_write_pos;
+	unsigned int write_pos = sync_ring.write_pos;
+	unsigned int pos;
 
-	PLATFORM_SoundLock();
+	RING_LOCK();
 	/* Current fill of the audio buffer. */
-	fill = sync_write_pos - sync_read_pos;
+	fill = write_pos - RING_LOAD(sync_ring.read_pos);
 
 	/* Update sync_est_fill. */
 	{
@@ -395,14 +485,20 @@ static void UpdateSyncBuffer(void)
 			sync_est_fill = fill - est_gap;
 	}
 
-	if (Atari800_turbo && sync_est_fill > sync_max_fill) {
-		PLATFORM_SoundUnlock();
+	if ((Atari800_turbo || AI_unthrottled) && sync_est_fill > sync_max_fill) {
+		if (SamplesWanted())
+			frame_bytes = Sound_out.sample_size * POKEYSND_UpdateProcessBuffer();
+		RING_UNLOCK();
+		sync_ring.dropped++;
+		samples_dropped = TRUE;
 		return;
 	}
+	samples_dropped = FALSE;
 
 	/* produce samples from the sound emulation */
 	samples_written = POKEYSND_UpdateProcessBuffer();
 	bytes_written = Sound_out.sample_size * samples_written;
+	frame_bytes = bytes_written;
 
 	/* if there isn't enough room... */
 	if (bytes_written > sync_buffer_size - fill) {
@@ -414,17 +510,18 @@ static void UpdateSyncBuffer(void)
 #endif
 		/* Wait until hardware buffer can be filled, or wait until callback
 		   makes place in the buffer. */
+		sync_ring.overruns++;
 		do {
-			PLATFORM_SoundUnlock();
+			RING_UNLOCK();
 #ifndef __MINT__	/* this does more harm than good on Atari */
 			/* Sleep for the duration of one full HW buffer. */
 			Util_sleep((double)Sound_out.buffer_frames / Sound_out.freq);
 #endif
-			PLATFORM_SoundLock();
+			RING_LOCK();
 #ifndef SOUND_CALLBACK
 			WriteOut(); /* Write to audio buffer as much as possible. */
 #endif /* SOUND_CALLBACK */
-			fill = sync_write_pos - sync_read_pos;
+			fill = write_pos - RING_LOAD(sync_ring.read_pos);
 		} while (bytes_written > sync_buffer_size - fill);
 	}
 	/* Now bytes_written <= audio_buffer_size + dsp_read_pos - dsp_write_pos) */
@@ -435,32 +532,70 @@ static void UpdateSyncBuffer(void)
 	          fill / Sound_out.channels/Sound_out.sample_size,
 	          bytes_written / Sound_out.channels/Sound_out.sample_size);
 #endif
-	/* now we copy the data into the buffer and adjust the positions */
-	new_write_pos = sync_write_pos + bytes_written;
-	if (new_write_pos/sync_buffer_size == sync_write_pos/sync_buffer_size)
+	/* now we copy the data into the buffer and publish the new position */
+	pos = write_pos & sync_buffer_mask;
+	if (bytes_written <= sync_buffer_mask + 1 - pos)
 		/* no wrap */
-		memcpy(sync_buffer + sync_write_pos%sync_buffer_size, POKEYSND_process_buffer, bytes_written);
+		memcpy(sync_buffer + pos, POKEYSND_process_buffer, bytes_written);
 	else {
 		/* wraps */
-		int first_part_size = sync_buffer_size - sync_write_pos%sync_buffer_size;
-		memcpy(sync_buffer + sync_write_pos%sync_buffer_size, POKEYSND_process_buffer, first_part_size);
+		unsigned int first_part_size = sync_buffer_mask + 1 - pos;
+		memcpy(sync_buffer + pos, POKEYSND_process_buffer, first_part_size);
 		memcpy(sync_buffer, POKEYSND_process_buffer + first_part_size, bytes_written - first_part_size);
 	}
+	RING_STORE(sync_ring.write_pos, write_pos + bytes_written);
+	RING_UNLOCK();
+}
 
-	sync_write_pos = new_write_pos;
-	if (sync_write_pos > sync_read_pos + sync_buffer_size)
-		sync_write_pos -= sync_buffer_size;
-	PLATFORM_SoundUnlock();
+/* Lets the POKEY sound engine skip synthesis while no samples would be
+   played or recorded. Register writes and POKEY timers are unaffected. */
+static void UpdateQuiet(void)
+{
+	int wanted = (Sound_enabled && !paused && !detached && !samples_dropped) || SamplesWanted();
+	POKEYSND_quiet = Sound_lazy && !wanted;
+}
+
+/* With Sound_turbo_detach, pauses the output while the emulation runs
+   faster than real time and resumes it afterwards. Meanwhile every
+   frame's samples still go to the recording and the observers, at any
+   speed, and the emulation speed no longer follows the output. */
+static void UpdateDetached(void)
+{
+	int fast = Sound_turbo_detach && (Atari800_turbo || AI_unthrottled);
+	if (fast && !detached) {
+		PLATFORM_SoundPause();
+		detached = TRUE;
+	}
+	else if (!fast && detached) {
+		/* The samples queued before turbo play first; the rate control
+		   starts over */
+		avg_fill = sync_min_fill;
+		last_audio_write_time = Util_time();
+		PLATFORM_SoundContinue();
+		detached = FALSE;
+	}
 }
 
 void Sound_Update(void)
 {
-	if (!Sound_enabled || paused)
-		return;
-	UpdateSyncBuffer();
+	frame_bytes = 0;
+	if (Sound_enabled && !paused)
+		UpdateDetached();
+	if (Sound_enabled && !paused && !detached) {
+		UpdateSyncBuffer();
 #ifndef SOUND_CALLBACK
-	WriteOut();
+		WriteOut();
 #endif /* !SOUND_CALLBACK */
+	}
+	else if (Sound_enabled && SamplesWanted())
+		frame_bytes = Sound_out.sample_size * POKEYSND_UpdateProcessBuffer();
+	UpdateQuiet();
+}
+
+UBYTE const *Sound_FrameSamples(unsigned int *size)
+{
+	*size = frame_bytes;
+	return POKEYSND_process_buffer;
 }
 
 void Sound_SetLatency(unsigned int latency)
@@ -473,14 +608,16 @@ void Sound_SetLatency(unsigned int latency)
 		unsigned int latency_frames = Sound_out.freq*Sound_latency/1000;
 		PLATFORM_SoundLock();
 		sync_buffer_size = (latency_frames + SYNC_BUFFER_FRAGS*Sound_out.buffer_frames) * bytes_per_frame;
+		sync_buffer_mask = Sound_NextPow2(sync_buffer_size) - 1;
 		sync_min_fill = latency_frames * bytes_per_frame;
 		sync_max_fill = sync_min_fill + Sound_out.buffer_frames * bytes_per_frame;
 		avg_fill = sync_min_fill;
-		sync_read_pos = 0;
-		sync_write_pos = sync_min_fill;
+		/* The audio thread is kept out by the lock while the ring is reset */
+		sync_ring.read_pos = 0;
+		sync_ring.write_pos = sync_min_fill;
 		free(sync_buffer);
-		sync_buffer = Util_malloc(sync_buffer_size);
-		memset(sync_buffer, 0, sync_buffer_size);
+		sync_buffer = Util_malloc(sync_buffer_mask + 1);
+		memset(sync_buffer, 0, sync_buffer_mask + 1);
 		PLATFORM_SoundUnlock();
 	}
 }
@@ -489,8 +626,15 @@ double Sound_AdjustSpeed(void)
 {
 	double delay_mult = 1.0;
 	static double const alpha = 2.0/(1.0+40.0);
-
-	if (Sound_enabled && !paused) {
+	static unsigned int seen_underruns = 0;
+
+	if (Sound_enabled && !paused && !detached) {
+		unsigned int underruns = RING_LOAD(sync_ring.underruns);
+		if (underruns != seen_underruns) {
+			/* The output ran dry: stop trusting the average, it lags */
+			seen_underruns = underruns;
+			avg_fill = sync_est_fill;
+		}
 #if 1
 		avg_fill = avg_fill + alpha * (sync_est_fill - avg_fill);
 		if (avg_fill < sync_min_fill)
@@ -517,6 +661,18 @@ double Sound_AdjustSpeed(void)
 	return delay_mult;
 }
 
+void Sound_GetStats(Sound_stats_t *stats)
+{
+	stats->fill = RING_LOAD(sync_ring.write_pos) - RING_LOAD(sync_ring.read_pos);
+	stats->est_fill = sync_est_fill;
+	stats->min_fill = sync_min_fill;
+	stats->max_fill = sync_max_fill;
+	stats->size = sync_buffer_size;
+	stats->underruns = RING_LOAD(sync_ring.underruns);
+	stats->overruns = sync_ring.overruns;
+	stats->dropped = sync_ring.dropped;
+}
+
 unsigned int Sound_NextPow2(unsigned int num)
 {
 	unsigned int result = 1;
@@ -75,6 +75,27 @@ void Sound_Callback(UBYTE *buffer, unsigned int size);
 int Sound_ReadConfig(char *option, char *ptr);
 void Sound_WriteConfig(FILE *fp);
 
+/* If TRUE (the default), POKEY sound synthesis is skipped while audio output
+   is paused or dropping samples and nothing is being recorded. */
+extern int Sound_lazy;
+
+/* Number of users besides the audio output, such as AI audio subscriptions,
+   that want the samples of every frame. While it is nonzero, synthesis is
+   never skipped and frames whose samples the output pauses or drops still
+   have them taken from the POKEY emulation. */
+extern int Sound_observers;
+
+/* If TRUE, audio output pauses while the emulation runs in turbo mode or
+   unthrottled, instead of playing what fits and dropping the rest. Every
+   frame's samples still reach the recording and Sound_observers, and the
+   emulation speed is no longer tied to the output. Default FALSE. */
+extern int Sound_turbo_detach;
+
+/* Samples the last Sound_Update() took from the POKEY emulation, in the
+   Sound_out format; SIZE receives their length in bytes. They stay valid,
+   in POKEYSND_process_buffer, until the next frame starts. */
+UBYTE const *Sound_FrameSamples(unsigned int *size);
+
 /* Sound latency in ms. Don't change directly - use Sound_SetLatency instead. */
 extern unsigned int Sound_latency;
 
@@ -85,6 +106,27 @@ void Sound_SetLatency(unsigned int latency);
  * slows down or speeds up to match the actual speed of sound output. */
 double Sound_AdjustSpeed(void);
 
+/* State of the buffer between the emulation and the audio output, all
+   sizes in bytes. */
+typedef struct Sound_stats_t {
+	/* Samples waiting for the output now. */
+	unsigned int fill;
+	/* Estimate at the last frame of what the output has not played yet;
+	   Sound_AdjustSpeed() keeps it between min_fill and max_fill. */
+	unsigned int est_fill;
+	unsigned int min_fill;
+	unsigned int max_fill;
+	/* Most samples the buffer holds. */
+	unsigned int size;
+	/* Reads by the output that found too few samples and repeated the last
+	   one, frames that waited for room, and turbo frames thrown away. */
+	unsigned int underruns;
+	unsigned int overruns;
+	unsigned int dropped;
+} Sound_stats_t;
+
+void Sound_GetStats(Sound_stats_t *stats);
+
 /* Helper function for use when hardware audio buffer size is required to
    equal a power of 2. Returns a power of 2 that is not lower than NUM
    (0 <= NUM < UINT_MAX). */
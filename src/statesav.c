@@ -49,6 +49,7 @@
 #include "cartridge.h"
 #include "cpu.h"
 #include "gtia.h"
+#include "input.h"
 #include "log.h"
 #include "pbi.h"
 #include "pia.h"
@@ -85,27 +86,70 @@ static size_t mem_write(const void *buf, size_t len, gzFile stream);
 #define GZREAD(X, Y, Z)  mem_read(Y, Z, X)
 #define GZWRITE(X, Y, Z) mem_write(Y, Z, X)
 #undef GZERROR
-#elif defined(HAVE_LIBZ) /* above MEMCOMPR, below HAVE_LIBZ */
-#define GZOPEN(X, Y)     gzopen(X, Y)
-#define GZCLOSE(X)       gzclose(X)
-#define GZREAD(X, Y, Z)  gzread(X, Y, Z)
-#define GZWRITE(X, Y, Z) gzwrite(X, (const voidp) Y, Z)
+#else
+/* State files of other codecs than gzip are built in, and read from, a
+   memory image of the uncompressed file (see StateSav_SaveAtariStateCodec).
+   While image_mode is on, StateFile is IMAGE_FILE and the I/O goes there. */
+#define STATESAV_IMAGE
+static int image_mode = FALSE;
+static UBYTE image_handle;
+#define IMAGE_FILE       ((gzFile)(void *)&image_handle)
+static int image_close(void);
+static size_t image_read(void *buf, size_t len);
+static size_t image_write(const void *buf, size_t len);
+static int ReadImage(const char *filename);
+#ifdef HAVE_LIBZ
+#define GZOPEN(X, Y)     (image_mode ? IMAGE_FILE : gzopen(X, Y))
+#define GZCLOSE(X)       (image_mode ? image_close() : gzclose(X))
+#define GZREAD(X, Y, Z)  (image_mode ? (int)image_read(Y, Z) : gzread(X, Y, Z))
+#define GZWRITE(X, Y, Z) (image_mode ? (int)image_write(Y, Z) : gzwrite(X, (const voidp) Y, Z))
 #define GZERROR(X, Y)    gzerror(X, Y)
 #else
-#define GZOPEN(X, Y)     fopen(X, Y)
-#define GZCLOSE(X)       fclose(X)
-#define GZREAD(X, Y, Z)  fread(Y, Z, 1, X)
-#define GZWRITE(X, Y, Z) fwrite(Y, Z, 1, X)
-#undef GZERROR
 #define gzFile  FILE *
 #define Z_OK    0
+#define GZOPEN(X, Y)     (image_mode ? IMAGE_FILE : fopen(X, Y))
+#define GZCLOSE(X)       (image_mode ? image_close() : fclose(X))
+#define GZREAD(X, Y, Z)  (image_mode ? image_read(Y, Z) : fread(Y, Z, 1, X))
+#define GZWRITE(X, Y, Z) (image_mode ? image_write(Y, Z) : fwrite(Y, Z, 1, X))
+#undef GZERROR
+#endif
 #endif
 
 static gzFile StateFile = NULL;
 static int nFileError = Z_OK;
+/* In-process snapshots (see StateSav_SaveSnapshot) bypass StateFile and
+   copy every field as it is in memory */
+static int snapshot_mode = FALSE;
+static UBYTE *snapshot_buf;    /* NULL when only measuring */
+static ULONG snapshot_off;
+static ULONG snapshot_size;
+static int snapshot_error;
+
+static void SnapshotIO(void *data, ULONG len, int save)
+{
+	if (snapshot_off + len > snapshot_size) {
+		snapshot_error = TRUE;
+		return;
+	}
+	if (snapshot_buf != NULL) {
+		if (save)
+			memcpy(snapshot_buf + snapshot_off, data, len);
+		else
+			memcpy(data, snapshot_buf + snapshot_off, len);
+	}
+	snapshot_off += len;
+}
 
 static void GetGZErrorText(void)
 {
+#ifdef STATESAV_IMAGE
+	if (image_mode) {
+		/* Only reading can fail */
+		nFileError = -1;
+		Log_print("State file is truncated.");
+		return;
+	}
+#endif
 #ifdef GZERROR
 	const char *error = GZERROR(StateFile, &nFileError);
 	if (nFileError == Z_ERRNO) {
@@ -125,6 +169,10 @@ static void GetGZErrorText(void)
 /* Value is memory location of data, num is number of type to save */
 void StateSav_SaveUBYTE(const UBYTE *data, int num)
 {
+	if (snapshot_mode) {
+		SnapshotIO((void *)data, num * sizeof(UBYTE), TRUE);
+		return;
+	}
 	if (!StateFile || nFileError != Z_OK)
 		return;
 
@@ -139,6 +187,10 @@ void StateSav_SaveUBYTE(const UBYTE *data, int num)
 /* Value is memory location of data, num is number of type to save */
 void StateSav_ReadUBYTE(UBYTE *data, int num)
 {
+	if (snapshot_mode) {
+		SnapshotIO((void *)data, num * sizeof(UBYTE), FALSE);
+		return;
+	}
 	if (!StateFile || nFileError != Z_OK)
 		return;
 
@@ -149,6 +201,10 @@ void StateSav_ReadUBYTE(UBYTE *data, int num)
 /* Value is memory location of data, num is number of type to save */
 void StateSav_SaveUWORD(const UWORD *data, int num)
 {
+	if (snapshot_mode) {
+		SnapshotIO((void *)data, num * sizeof(UWORD), TRUE);
+		return;
+	}
 	if (!StateFile || nFileError != Z_OK)
 		return;
 
@@ -180,6 +236,10 @@ void StateSav_SaveUWORD(const UWORD *data, int num)
 /* Value is memory location of data, num is number of type to save */
 void StateSav_ReadUWORD(UWORD *data, int num)
 {
+	if (snapshot_mode) {
+		SnapshotIO((void *)data, num * sizeof(UWORD), FALSE);
+		return;
+	}
 	if (!StateFile || nFileError != Z_OK)
 		return;
 
@@ -203,6 +263,10 @@ void StateSav_ReadUWORD(UWORD *data, int num)
 
 void StateSav_SaveINT(const int *data, int num)
 {
+	if (snapshot_mode) {
+		SnapshotIO((void *)data, num * sizeof(int), TRUE);
+		return;
+	}
 	if (!StateFile || nFileError != Z_OK)
 		return;
 
@@ -256,6 +320,10 @@ void StateSav_SaveINT(const int *data, int num)
 
 void StateSav_ReadINT(int *data, int num)
 {
+	if (snapshot_mode) {
+		SnapshotIO((void *)data, num * sizeof(int), FALSE);
+		return;
+	}
 	if (!StateFile || nFileError != Z_OK)
 		return;
 
@@ -426,6 +494,11 @@ int StateSav_ReadAtariState(const char *filename, const char *mode)
 	}
 	nFileError = Z_OK;
 
+#ifdef STATESAV_IMAGE
+	/* Files of the fast codec are unpacked into the image first */
+	if (!ReadImage(filename))
+		return FALSE;
+#endif
 	StateFile = GZOPEN(filename, mode);
 	if (StateFile == NULL) {
 		Log_print("Could not open %s for state read.", filename);
@@ -543,6 +616,432 @@ int StateSav_ReadAtariState(const char *filename, const char *mode)
 }
 
 
+/* In-process snapshots: only the state that changes while the machine runs,
+   leaving out the machine type, OS/BASIC images and mounted media, which
+   must be the same when the snapshot is read. Fields are in native layout,
+   so a snapshot is only valid within the build that wrote it. Saving with a
+   NULL buffer just measures the size. */
+static ULONG Snapshot(UBYTE *buffer, ULONG size, int save)
+{
+	/* Not in state files: what RANDOM reads next, and what the input
+	   layer remembers of the last frame */
+	ULONG random_counter = POKEY_GetRandomCounter();
+	UBYTE input_state[INPUT_FRAME_STATE_SIZE];
+#ifdef LIBATARI800
+	statesav_tags_t tags;
+	LIBATARI800_StateSav_tags = &tags;
+#endif
+	snapshot_buf = buffer;
+	snapshot_off = 0;
+	snapshot_size = buffer != NULL ? size : (ULONG)-1;
+	snapshot_error = FALSE;
+	snapshot_mode = TRUE;
+
+	if (save) {
+		CARTRIDGE_BankStateSave();
+		ANTIC_StateSave();
+		CPU_StateSave(FALSE);
+		GTIA_StateSave();
+		PIA_StateSave();
+		POKEY_StateSave();
+		PBI_StateSave();
+		SnapshotIO(&random_counter, sizeof(random_counter), TRUE);
+		INPUT_GetFrameState(input_state);
+		SnapshotIO(input_state, sizeof(input_state), TRUE);
+	}
+	else {
+		CARTRIDGE_BankStateRead();
+		ANTIC_StateRead();
+		CPU_StateRead(FALSE, SAVE_VERSION_NUMBER);
+		GTIA_StateRead(SAVE_VERSION_NUMBER);
+		PIA_StateRead(SAVE_VERSION_NUMBER);
+		POKEY_StateRead();
+		PBI_StateRead();
+		SnapshotIO(&random_counter, sizeof(random_counter), FALSE);
+		POKEY_SetRandomCounter(random_counter);
+		SnapshotIO(input_state, sizeof(input_state), FALSE);
+		if (!snapshot_error)
+			INPUT_SetFrameState(input_state);
+	}
+
+	snapshot_mode = FALSE;
+#ifdef LIBATARI800
+	LIBATARI800_StateSav_tags = NULL;
+#endif
+	return snapshot_off;
+}
+
+ULONG StateSav_SaveSnapshot(UBYTE *buffer, ULONG size)
+{
+	ULONG len = Snapshot(buffer, size, TRUE);
+	return snapshot_error ? 0 : len;
+}
+
+int StateSav_ReadSnapshot(const UBYTE *buffer, ULONG size)
+{
+	Snapshot((UBYTE *)buffer, size, FALSE);
+	return !snapshot_error;
+}
+
+#ifdef STATESAV_IMAGE
+static UBYTE *image_buf = NULL;
+static ULONG image_len;   /* bytes written, or bytes to read */
+static ULONG image_off;   /* read position */
+static ULONG image_size;  /* allocated */
+
+static int image_close(void)
+{
+	image_mode = FALSE;
+	return 0;
+}
+
+static size_t image_read(void *buf, size_t len)
+{
+	if (image_off + len > image_len)
+		return 0;
+	memcpy(buf, image_buf + image_off, len);
+	image_off += len;
+	return len;
+}
+
+static size_t image_write(const void *buf, size_t len)
+{
+	if (image_len + len > image_size) {
+		image_size = (image_len + len) * 2;
+		image_buf = (UBYTE *)Util_realloc(image_buf, image_size);
+	}
+	memcpy(image_buf + image_len, buf, len);
+	image_len += len;
+	return len;
+}
+#endif /* STATESAV_IMAGE */
+
+/* The fast codec: the file data in LZ4 block format, after a FAST_MAGIC
+   and the uncompressed size (little-endian) */
+#define FAST_MAGIC "A8LZ"
+#define FAST_HEADER 8
+
+/* The LZ4 block format is also there for other users of it */
+#define LZ_HASH_BITS 12
+#define LZ_MIN_MATCH 4
+#define LZ_LAST_LITERALS 5  /* the format ends with at least 5 literals... */
+#define LZ_MF_LIMIT 12      /* ...and no match starts in the last 12 bytes */
+
+static ULONG lz_read32(const UBYTE *p)
+{
+	return p[0] | (p[1] << 8) | (p[2] << 16) | ((ULONG)p[3] << 24);
+}
+
+static UBYTE *lz_put_length(UBYTE *op, ULONG len)
+{
+	for (; len >= 255; len -= 255)
+		*op++ = 255;
+	*op++ = (UBYTE)len;
+	return op;
+}
+
+static UBYTE *lz_put_literals(UBYTE *op, const UBYTE *lit, ULONG len, int match)
+{
+	*op++ = (UBYTE)(((len < 15 ? len : 15) << 4) | (match < 15 ? match : 15));
+	if (len >= 15)
+		op = lz_put_length(op, len - 15);
+	memcpy(op, lit, len);
+	return op + len;
+}
+
+ULONG StateSav_LZCompress(const UBYTE *src, ULONG len, UBYTE *dst)
+{
+	ULONG table[1 << LZ_HASH_BITS]; /* position + 1 of a sequence with each hash */
+	UBYTE *op = dst;
+	ULONG ip = 0, anchor = 0;
+
+	memset(table, 0, sizeof(table));
+	while (len > LZ_MF_LIMIT && ip < len - LZ_MF_LIMIT) {
+		ULONG seq = lz_read32(src + ip);
+		ULONG h = ((seq * 2654435761U) & 0xffffffff) >> (32 - LZ_HASH_BITS);
+		ULONG ref = table[h];
+		ULONG mlen;
+
+		table[h] = ip + 1;
+		if (ref == 0 || ip - (ref - 1) > 65535 || lz_read32(src + ref - 1) != seq) {
+			/* Skip faster through data that does not compress */
+			ip += 1 + ((ip - anchor) >> 6);
+			continue;
+		}
+		ref--;
+		for (mlen = LZ_MIN_MATCH; ip + mlen < len - LZ_LAST_LITERALS
+		                          && src[ref + mlen] == src[ip + mlen]; mlen++)
+			;
+		op = lz_put_literals(op, src + anchor, ip - anchor, (int)(mlen - LZ_MIN_MATCH));
+		*op++ = (UBYTE)((ip - ref) & 0xff);
+		*op++ = (UBYTE)((ip - ref) >> 8);
+		if (mlen - LZ_MIN_MATCH >= 15)
+			op = lz_put_length(op, mlen - LZ_MIN_MATCH - 15);
+		ip += mlen;
+		anchor = ip;
+	}
+	op = lz_put_literals(op, src + anchor, len - anchor, 0);
+	return (ULONG)(op - dst);
+}
+
+int StateSav_LZDecompress(const UBYTE *src, ULONG srclen, UBYTE *dst, ULONG dstlen)
+{
+	ULONG ip = 0, op = 0;
+
+	while (ip < srclen) {
+		UBYTE token = src[ip++];
+		ULONG len = token >> 4, off, k;
+		if (len == 15) {
+			do {
+				if (ip >= srclen)
+					return FALSE;
+				len += src[ip];
+			} while (src[ip++] == 255);
+		}
+		if (ip + len > srclen || op + len > dstlen)
+			return FALSE;
+		memcpy(dst + op, src + ip, len);
+		ip += len;
+		op += len;
+		if (ip == srclen)
+			break;  /* the last literals */
+		if (ip + 2 > srclen)
+			return FALSE;
+		off = src[ip] | (src[ip + 1] << 8);
+		ip += 2;
+		if (off == 0 || off > op)
+			return FALSE;
+		len = token & 15;
+		if (len == 15) {
+			do {
+				if (ip >= srclen)
+					return FALSE;
+				len += src[ip];
+			} while (src[ip++] == 255);
+		}
+		len += LZ_MIN_MATCH;
+		if (op + len > dstlen)
+			return FALSE;
+		for (k = 0; k < len; k++, op++)
+			dst[op] = dst[op - off]; /* may overlap */
+	}
+	return op == dstlen;
+}
+
+/* A file of the fast codec, in a new buffer; *len gets its size */
+static UBYTE *PackFast(const UBYTE *image, ULONG size, ULONG *len)
+{
+	UBYTE *packed = (UBYTE *)Util_malloc(FAST_HEADER + StateSav_LZ_BOUND(size));
+	*len = FAST_HEADER + StateSav_LZCompress(image, size, packed + FAST_HEADER);
+	memcpy(packed, FAST_MAGIC, 4);
+	packed[4] = (UBYTE)size;
+	packed[5] = (UBYTE)(size >> 8);
+	packed[6] = (UBYTE)(size >> 16);
+	packed[7] = (UBYTE)(size >> 24);
+	return packed;
+}
+
+#ifdef STATESAV_IMAGE
+/* If filename is in the fast format, unpack it into the image and turn on
+   image_mode; other files are left for GZOPEN. Returns FALSE on error. */
+static int ReadImage(const char *filename)
+{
+	UBYTE header[FAST_HEADER];
+	UBYTE *packed;
+	long size;
+	FILE *f;
+	int ok;
+
+	if (filename == NULL) {
+		/* StateSav_UnpackAtariState left the image ready */
+		image_off = 0;
+		image_mode = TRUE;
+		return TRUE;
+	}
+	f = fopen(filename, "rb");
+	if (f == NULL)
+		return TRUE;  /* GZOPEN reports it */
+	if (fread(header, FAST_HEADER, 1, f) != 1 || memcmp(header, FAST_MAGIC, 4) != 0) {
+		fclose(f);
+		return TRUE;
+	}
+	fseek(f, 0, SEEK_END);
+	size = ftell(f) - FAST_HEADER;
+	fseek(f, FAST_HEADER, SEEK_SET);
+	image_len = lz_read32(header + 4);
+	if (image_len > image_size) {
+		image_size = image_len;
+		image_buf = (UBYTE *)Util_realloc(image_buf, image_size);
+	}
+	packed = (UBYTE *)Util_malloc(size > 0 ? size : 1);
+	ok = size > 0 && fread(packed, size, 1, f) == 1
+	     && StateSav_LZDecompress(packed, (ULONG)size, image_buf, image_len);
+	free(packed);
+	fclose(f);
+	if (!ok) {
+		Log_print("State file %s is corrupt.", filename);
+		return FALSE;
+	}
+	image_off = 0;
+	image_mode = TRUE;
+	return TRUE;
+}
+
+/* Write an image to filename with a codec. Touches no other state, so
+   it may run on another thread. */
+static int WriteImage(const char *filename, int codec, const UBYTE *image, ULONG size)
+{
+	FILE *f;
+	int ok;
+
+#ifdef HAVE_LIBZ
+	if (codec == StateSav_CODEC_GZIP) {
+		gzFile gz = gzopen(filename, "wb");
+		if (gz == NULL)
+			return FALSE;
+		ok = gzwrite(gz, (const voidp)image, size) == (int)size;
+		return gzclose(gz) == Z_OK && ok;
+	}
+#endif
+	f = fopen(filename, "wb");
+	if (f == NULL)
+		return FALSE;
+	if (codec == StateSav_CODEC_FAST) {
+		ULONG len;
+		UBYTE *packed = PackFast(image, size, &len);
+		ok = fwrite(packed, len, 1, f) == 1;
+		free(packed);
+	}
+	else
+		ok = size == 0 || fwrite(image, size, 1, f) == 1;
+	return fclose(f) == 0 && ok;
+}
+
+/* Save the state into the image */
+static int SaveImage(const char *filename, UBYTE SaveVerbose)
+{
+	if (StateFile != NULL) {
+		GZCLOSE(StateFile);
+		StateFile = NULL;
+	}
+	image_mode = TRUE;
+	image_len = 0;
+	return StateSav_SaveAtariState(filename, "wb", SaveVerbose);
+}
+#endif /* STATESAV_IMAGE */
+
+int StateSav_SaveAtariStateCodec(const char *filename, UBYTE SaveVerbose, int codec)
+{
+#ifdef STATESAV_IMAGE
+	if (!SaveImage(filename, SaveVerbose))
+		return FALSE;
+	if (!WriteImage(filename, codec, image_buf, image_len)) {
+		Log_print("Could not write %s.", filename);
+		return FALSE;
+	}
+	return TRUE;
+#else
+	return StateSav_SaveAtariState(filename, "wb", SaveVerbose);
+#endif
+}
+
+UBYTE *StateSav_CaptureAtariState(UBYTE SaveVerbose, ULONG *len)
+{
+#ifdef STATESAV_IMAGE
+	UBYTE *image;
+
+	if (!SaveImage("(memory)", SaveVerbose))
+		return NULL;
+	/* The caller owns the buffer now */
+	image = image_buf;
+	*len = image_len;
+	image_buf = NULL;
+	image_size = 0;
+	return image;
+#else
+	return NULL;
+#endif
+}
+
+int StateSav_WriteAtariState(const char *filename, const UBYTE *image, ULONG len, int codec)
+{
+#ifdef STATESAV_IMAGE
+	return WriteImage(filename, codec, image, len);
+#else
+	return FALSE;
+#endif
+}
+
+UBYTE *StateSav_PackAtariState(ULONG *len)
+{
+#ifdef STATESAV_IMAGE
+	if (!SaveImage("(memory)", TRUE))
+		return NULL;
+	return PackFast(image_buf, image_len, len);
+#elif defined(LIBATARI800)
+	UBYTE *image = (UBYTE *)Util_malloc(STATESAV_MAX_SIZE);
+	UBYTE *packed;
+	statesav_tags_t tags;
+
+	LIBATARI800_StateSave(image, &tags);
+	packed = PackFast(image, StateSav_Tell(), len);
+	free(image);
+	return packed;
+#else
+	return NULL;
+#endif
+}
+
+UBYTE *StateSav_PackImage(const UBYTE *image, ULONG size, ULONG *len)
+{
+	return PackFast(image, size, len);
+}
+
+int StateSav_UnpackAtariState(const UBYTE *data, ULONG len)
+{
+#if defined(STATESAV_IMAGE) || defined(LIBATARI800)
+	int fast = len >= FAST_HEADER && memcmp(data, FAST_MAGIC, 4) == 0;
+	ULONG size = fast ? lz_read32(data + 4) : len;
+	UBYTE *image;
+	int ok;
+
+#ifdef STATESAV_IMAGE
+	if (size > image_size) {
+		image_size = size;
+		image_buf = (UBYTE *)Util_realloc(image_buf, image_size);
+	}
+	image = image_buf;
+	image_len = size;
+#else
+	if (size > STATESAV_MAX_SIZE) {
+		Log_print("State data is too big.");
+		return FALSE;
+	}
+	image = (UBYTE *)Util_malloc(STATESAV_MAX_SIZE);
+#endif
+	if (fast)
+		ok = StateSav_LZDecompress(data + FAST_HEADER, len - FAST_HEADER, image, size);
+	else {
+		memcpy(image, data, size);
+		ok = TRUE;
+	}
+	if (!ok)
+		Log_print("State data is corrupt.");
+	else {
+#ifdef LIBATARI800
+		LIBATARI800_StateSav_buffer = image;
+#endif
+		ok = StateSav_ReadAtariState(NULL, "rb");
+	}
+#ifdef LIBATARI800
+	free(image);
+#endif
+	return ok;
+#else
+	return FALSE;
+#endif
+}
+
 /* Common definitions for in-memory state save used for DREAMCAST and libatari800
  */
 #if defined(MEMCOMPR) || defined(LIBATARI800)
@@ -673,7 +1172,10 @@ ULONG StateSav_Tell()
 /* replacement for GZREAD */
 static size_t mem_read(void *buf, size_t len, gzFile stream)
 {
-	if (plainmemoff + len > unclen) return 0;  /* shouldn't happen */
+	if (plainmemoff + len > unclen) {
+		nFileError = -1;  /* shouldn't happen */
+		return 0;
+	}
 	memcpy(buf, plainmembuf + plainmemoff, len);
 	plainmemoff += len;
 	return len;
@@ -682,7 +1184,10 @@ static size_t mem_read(void *buf, size_t len, gzFile stream)
 /* replacement for GZWRITE */
 static size_t mem_write(const void *buf, size_t len, gzFile stream)
 {
-	if (plainmemoff + len > unclen) return 0;  /* shouldn't happen */
+	if (plainmemoff + len > unclen) {
+		nFileError = -1;  /* shouldn't happen */
+		return 0;
+	}
 	memcpy(plainmembuf + plainmemoff, buf, len);
 	plainmemoff += len;
 	return len;
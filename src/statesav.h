@@ -7,6 +7,35 @@
 int StateSav_SaveAtariState(const char *filename, const char *mode, UBYTE SaveVerbose);
 int StateSav_ReadAtariState(const char *filename, const char *mode);
 
+/* Codecs for StateSav_SaveAtariStateCodec. StateSav_ReadAtariState tells
+   them apart by itself. */
+#define StateSav_CODEC_GZIP 0 /* the format of StateSav_SaveAtariState */
+#define StateSav_CODEC_FAST 1 /* LZ4 block format, several times faster */
+#define StateSav_CODEC_RAW  2 /* uncompressed */
+int StateSav_SaveAtariStateCodec(const char *filename, UBYTE SaveVerbose, int codec);
+/* Save in two steps: capture the state file into a new buffer (to be
+   freed by the caller; NULL if the build does not support it), then write
+   it with a codec. Only the capture touches the emulator, so the write
+   may run on another thread. */
+UBYTE *StateSav_CaptureAtariState(UBYTE SaveVerbose, ULONG *len);
+int StateSav_WriteAtariState(const char *filename, const UBYTE *image, ULONG len, int codec);
+/* State files in memory, to ship them to another process: the state as
+   a file of the fast codec, in a new buffer for the caller to free (NULL
+   if the build does not support it); and reading one back, or a raw one. */
+UBYTE *StateSav_PackAtariState(ULONG *len);
+/* A state file image (as StateSav_CaptureAtariState gives) packed the same
+   way, in a new buffer */
+UBYTE *StateSav_PackImage(const UBYTE *image, ULONG size, ULONG *len);
+int StateSav_UnpackAtariState(const UBYTE *data, ULONG len);
+
+/* LZ4 block format, as the fast codec writes it. Compressing LEN bytes of
+   SRC takes up to StateSav_LZ_BOUND(LEN) bytes at DST; returns the
+   compressed size. Decompressing checks that SRCLEN bytes of SRC give
+   exactly DSTLEN bytes, and returns FALSE if they do not. */
+#define StateSav_LZ_BOUND(len) ((len) + (len) / 255 + 16)
+ULONG StateSav_LZCompress(const UBYTE *src, ULONG len, UBYTE *dst);
+int StateSav_LZDecompress(const UBYTE *src, ULONG srclen, UBYTE *dst, ULONG dstlen);
+
 void StateSav_SaveUBYTE(const UBYTE *data, int num);
 void StateSav_SaveUWORD(const UWORD *data, int num);
 void StateSav_SaveINT(const int *data, int num);
@@ -17,6 +46,10 @@ void StateSav_ReadUWORD(UWORD *data, int num);
 void StateSav_ReadINT(int *data, int num);
 void StateSav_ReadFNAME(char *filename);
 
+/* In-process snapshot of the running machine, see statesav.c */
+ULONG StateSav_SaveSnapshot(UBYTE *buffer, ULONG size);
+int StateSav_ReadSnapshot(const UBYTE *buffer, ULONG size);
+
 #ifdef LIBATARI800
 ULONG StateSav_Tell(void);
 #include "libatari800/statesav.h"
@@ -0,0 +1,1030 @@
+/*
+ * stream.c - live screen and sound for web browsers over WebSocket
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+/* Every message to a viewer is one binary WebSocket message whose first
+   byte is its kind, with numbers little-endian:
+
+   palette  1, then 256 RGB triples; sent before the first frame and
+            whenever the colours change
+   video    2, key (1 if whole), UWORD width, UWORD height, ULONG frame
+            number, then runs over the width x height palette indices of
+            the visible area, each a LEB128 varint of count << 2 | kind
+            (RUN_*) and for RUN_FILL one byte, for RUN_LITERAL count bytes.
+            The pixels after the last run are as in the frame before.
+   audio    3, ULONG sample rate, channels, then the frame's samples, signed
+            16-bit
+
+   Server messages are never masked, so a message is put together once,
+   WebSocket header and all, and the same bytes are queued for everyone. */
+
+#define _POSIX_C_SOURCE 200112L /* for getaddrinfo */
+
+#include "config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <netdb.h>
+
+#include "atari.h"
+#include "colours.h"
+#include "log.h"
+#include "screen.h"
+#include "screen_ring.h"
+#ifdef SOUND
+#include "sound.h"
+#endif
+#include "stream.h"
+#include "util.h"
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+#define DEFAULT_PORT 8800
+#define DEFAULT_VIEWERS 8
+#define MAX_VIEWERS 64
+#define QUEUE_LIMIT (1 << 20)    /* bytes queued for a viewer before frames are dropped */
+#define REQUEST_MAX 4096         /* HTTP request head, or a message from a viewer */
+#define AUDIO_RING (1 << 18)     /* bytes of samples for the worker, a power of two */
+#define MIN_RUN 3                /* shorter runs of unchanged or repeated pixels are literal */
+#define SCREEN_SIZE (Screen_WIDTH * Screen_HEIGHT)
+#define HEADER_MAX 10            /* of a WebSocket message from the server */
+/* A video message: encode_runs() writes at most two bytes a pixel, as the
+   runs between literals are MIN_RUN pixels or more */
+#define VIDEO_MAX (HEADER_MAX + 10 + SCREEN_SIZE * 2 + 16)
+
+enum {
+	MESSAGE_PALETTE = 1,
+	MESSAGE_VIDEO,
+	MESSAGE_AUDIO
+};
+
+enum {
+	RUN_SKIP,     /* count pixels as in the frame before */
+	RUN_FILL,     /* count pixels of the next byte */
+	RUN_LITERAL   /* the next count bytes */
+};
+
+enum {
+	VIEWER_REQUEST,   /* reading the HTTP request */
+	VIEWER_CLOSING,   /* closed once what is queued is sent */
+	VIEWER_SOCKET     /* WebSocket open */
+};
+
+typedef struct {
+	int fd;
+	int state;
+	UBYTE in[REQUEST_MAX];
+	int in_len;
+	UBYTE *out;       /* bytes queued, from out_pos to out_len */
+	size_t out_pos;
+	size_t out_len;
+	size_t out_size;
+	int need_key;     /* the next frame sent must be whole */
+	int palette;      /* serial of the palette last sent */
+} viewer_t;
+
+static char address[256] = "127.0.0.1";
+static int port = 0;
+static int max_viewers = DEFAULT_VIEWERS;
+
+static int running = FALSE;
+static pthread_t thread;
+static int listen_fd = -1;
+static int wake_fds[2] = { -1, -1 };
+static int observing = FALSE;    /* our share of Sound_observers */
+
+/* Shared by the emulation and the worker, under lock */
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static int stopping;
+static int num_viewers;          /* WebSockets open */
+static const UBYTE *pending;     /* the screen not taken yet, held in the ring */
+static int pending_frame;
+static int pending_box[4];       /* its visible area: x1, y1, x2, y2 */
+static int palette[256];
+static int palette_serial;
+static UBYTE audio[AUDIO_RING];
+static ULONG audio_written;      /* bytes ever put in audio, and taken out */
+static ULONG audio_read;
+static unsigned int audio_rate;
+static int audio_channels;
+static int audio_sample_size;
+static ULONG frames_replaced;    /* screens the worker never took */
+
+/* The worker's own */
+static viewer_t viewers[MAX_VIEWERS];
+static int count;
+static UBYTE cur[SCREEN_SIZE];   /* the frame being sent, cropped */
+static UBYTE prev[SCREEN_SIZE];  /* the frame before */
+static int prev_width;           /* 0 while there is none */
+static int prev_height;
+static UBYTE *delta_msg;         /* WebSocket messages, HEADER_MAX bytes in */
+static UBYTE *key_msg;
+static UBYTE *audio_msg;
+static UBYTE *audio_take;
+static ULONG frames_sent;
+static ULONG frames_dropped;
+
+static const char page[] =
+	"<!DOCTYPE html>\n"
+	"<html><head><meta charset=\"utf-8\"><title>Atari800</title><style>\n"
+	"body{margin:0;background:#000;color:#888;font:12px sans-serif;text-align:center}\n"
+	"canvas{height:90vh;image-rendering:pixelated;display:block;margin:0 auto}\n"
+	"</style></head><body><canvas id=\"c\"></canvas><div id=\"s\">click for sound</div><script>\n"
+	"var c=document.getElementById('c'),g=c.getContext('2d'),img=null,pix=null,\n"
+	" pal=new Uint32Array(256),ac=null,at=0,ws=new WebSocket('ws://'+location.host+'/stream');\n"
+	"ws.binaryType='arraybuffer';\n"
+	"ws.onclose=function(){document.getElementById('s').textContent='disconnected';};\n"
+	"document.body.onclick=function(){if(!ac)ac=new AudioContext();ac.resume();\n"
+	" document.getElementById('s').textContent='';};\n"
+	"ws.onmessage=function(e){\n"
+	" var d=new Uint8Array(e.data),v=new DataView(e.data),i,k,n,p,t,s,b;\n"
+	" if(d[0]==1){for(i=0;i<256;i++)pal[i]=0xff000000|d[3+3*i]<<16|d[2+3*i]<<8|d[1+3*i];}\n"
+	" else if(d[0]==2){var w=v.getUint16(2,true),h=v.getUint16(4,true);\n"
+	"  if(!img||img.width!=w||img.height!=h){c.width=w;c.height=h;\n"
+	"   img=g.createImageData(w,h);pix=new Uint8Array(w*h);}\n"
+	"  for(p=10,i=0;p<d.length;){for(t=0,s=0;;s+=7){b=d[p++];t+=(b&127)*Math.pow(2,s);if(b<128)break;}\n"
+	"   n=Math.floor(t/4);k=t%4;\n"
+	"   if(k==1)pix.fill(d[p++],i,i+n);else if(k==2){pix.set(d.subarray(p,p+n),i);p+=n;}\n"
+	"   i+=n;}\n"
+	"  var o=new Uint32Array(img.data.buffer);for(i=0;i<w*h;i++)o[i]=pal[pix[i]];\n"
+	"  g.putImageData(img,0,0);}\n"
+	" else if(d[0]==3&&ac){var r=v.getUint32(1,true),ch=d[5],f=Math.floor((d.length-6)/2/ch);\n"
+	"  if(f<1)return;var a=ac.createBuffer(ch,f,r);\n"
+	"  for(k=0;k<ch;k++){var o2=a.getChannelData(k);\n"
+	"   for(i=0;i<f;i++)o2[i]=v.getInt16(6+2*(i*ch+k),true)/32768;}\n"
+	"  var src=ac.createBufferSource();src.buffer=a;src.connect(ac.destination);\n"
+	"  t=ac.currentTime;if(at<t+0.02||at>t+0.3)at=t+0.05;src.start(at);at+=f/r;}\n"
+	"};\n"
+	"</script></body></html>\n";
+
+/* SHA-1, for the WebSocket handshake only */
+static ULONG rol(ULONG x, int n)
+{
+	return ((x << n) | (x >> (32 - n))) & 0xffffffff;
+}
+
+static void sha1_block(ULONG h[5], const UBYTE *p)
+{
+	ULONG w[80];
+	ULONG a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+	int i;
+
+	for (i = 0; i < 16; i++)
+		w[i] = (ULONG)p[4 * i] << 24 | (ULONG)p[4 * i + 1] << 16 | (ULONG)p[4 * i + 2] << 8 | p[4 * i + 3];
+	for (; i < 80; i++)
+		w[i] = rol(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+	for (i = 0; i < 80; i++) {
+		ULONG f, k, t;
+		if (i < 20) {
+			f = (b & c) | (~b & d);
+			k = 0x5a827999;
+		}
+		else if (i < 40) {
+			f = b ^ c ^ d;
+			k = 0x6ed9eba1;
+		}
+		else if (i < 60) {
+			f = (b & c) | (b & d) | (c & d);
+			k = 0x8f1bbcdc;
+		}
+		else {
+			f = b ^ c ^ d;
+			k = 0xca62c1d6;
+		}
+		t = (rol(a, 5) + (f & 0xffffffff) + e + k + w[i]) & 0xffffffff;
+		e = d;
+		d = c;
+		c = rol(b, 30);
+		b = a;
+		a = t;
+	}
+	h[0] = (h[0] + a) & 0xffffffff;
+	h[1] = (h[1] + b) & 0xffffffff;
+	h[2] = (h[2] + c) & 0xffffffff;
+	h[3] = (h[3] + d) & 0xffffffff;
+	h[4] = (h[4] + e) & 0xffffffff;
+}
+
+static void sha1(const UBYTE *data, size_t len, UBYTE digest[20])
+{
+	ULONG h[5] = { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0 };
+	UBYTE block[64];
+	size_t i, rest;
+
+	for (i = 0; i + 64 <= len; i += 64)
+		sha1_block(h, data + i);
+	rest = len - i;
+	memset(block, 0, sizeof(block));
+	memcpy(block, data + i, rest);
+	block[rest] = 0x80;
+	if (rest >= 56) {
+		sha1_block(h, block);
+		memset(block, 0, sizeof(block));
+	}
+	for (i = 0; i < 8; i++)
+		block[63 - i] = (UBYTE)((len * 8) >> (8 * i));
+	sha1_block(h, block);
+	for (i = 0; i < 20; i++)
+		digest[i] = (UBYTE)(h[i / 4] >> (24 - 8 * (i % 4)));
+}
+
+static void base64(const UBYTE *data, int len, char *out)
+{
+	static const char digits[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+	int i;
+
+	for (i = 0; i < len; i += 3) {
+		ULONG n = (ULONG)data[i] << 16 | (i + 1 < len ? data[i + 1] << 8 : 0) | (i + 2 < len ? data[i + 2] : 0);
+		*out++ = digits[n >> 18];
+		*out++ = digits[(n >> 12) & 63];
+		*out++ = i + 1 < len ? digits[(n >> 6) & 63] : '=';
+		*out++ = i + 2 < len ? digits[n & 63] : '=';
+	}
+	*out = '\0';
+}
+
+/* Puts the WebSocket header of a len byte message of opcode in front of
+   the payload at buf + HEADER_MAX; returns where the message starts */
+static UBYTE *frame_message(UBYTE *buf, int opcode, size_t len, size_t *total)
+{
+	UBYTE *h;
+
+	if (len < 126) {
+		h = buf + HEADER_MAX - 2;
+		h[1] = (UBYTE)len;
+	}
+	else if (len < 65536) {
+		h = buf + HEADER_MAX - 4;
+		h[1] = 126;
+		h[2] = (UBYTE)(len >> 8);
+		h[3] = (UBYTE)len;
+	}
+	else {
+		int i;
+		h = buf;
+		h[1] = 127;
+		for (i = 0; i < 8; i++)
+			h[2 + i] = i < 4 ? 0 : (UBYTE)(len >> (8 * (7 - i)));
+	}
+	h[0] = (UBYTE)(0x80 | opcode);
+	*total = buf + HEADER_MAX + len - h;
+	return h;
+}
+
+static UBYTE *put_varint(UBYTE *p, ULONG v)
+{
+	while (v >= 0x80) {
+		*p++ = (UBYTE)(v | 0x80);
+		v >>= 7;
+	}
+	*p++ = (UBYTE)v;
+	return p;
+}
+
+/* Encodes the n pixels of cur as runs, against before unless it is NULL;
+   returns the end of what it wrote at out */
+static UBYTE *encode_runs(const UBYTE *pixels, const UBYTE *before, int n, UBYTE *out)
+{
+	int i = 0;
+	int literal = -1;   /* where the pixels not yet written start */
+
+	while (i < n) {
+		int j;
+		if (before != NULL && pixels[i] == before[i]) {
+			for (j = i + 1; j < n && pixels[j] == before[j]; j++);
+			if (j - i >= MIN_RUN || j == n) {
+				if (literal >= 0) {
+					out = put_varint(out, (ULONG)(i - literal) << 2 | RUN_LITERAL);
+					memcpy(out, pixels + literal, i - literal);
+					out += i - literal;
+					literal = -1;
+				}
+				/* The pixels after the last run stay as they are */
+				if (j < n)
+					out = put_varint(out, (ULONG)(j - i) << 2 | RUN_SKIP);
+				i = j;
+				continue;
+			}
+		}
+		for (j = i + 1; j < n && pixels[j] == pixels[i]; j++);
+		if (j - i >= MIN_RUN) {
+			if (literal >= 0) {
+				out = put_varint(out, (ULONG)(i - literal) << 2 | RUN_LITERAL);
+				memcpy(out, pixels + literal, i - literal);
+				out += i - literal;
+				literal = -1;
+			}
+			out = put_varint(out, (ULONG)(j - i) << 2 | RUN_FILL);
+			*out++ = pixels[i];
+			i = j;
+			continue;
+		}
+		if (literal < 0)
+			literal = i;
+		i++;
+	}
+	if (literal >= 0) {
+		out = put_varint(out, (ULONG)(n - literal) << 2 | RUN_LITERAL);
+		memcpy(out, pixels + literal, n - literal);
+		out += n - literal;
+	}
+	return out;
+}
+
+static void close_viewer(int i)
+{
+	viewer_t *v = &viewers[i];
+
+	close(v->fd);
+	free(v->out);
+	if (v->state == VIEWER_SOCKET) {
+		pthread_mutex_lock(&lock);
+		num_viewers--;
+		pthread_mutex_unlock(&lock);
+	}
+	viewers[i] = viewers[--count];
+}
+
+/* Queues len bytes for v; unless forced, not if they would take its queue
+   beyond QUEUE_LIMIT */
+static int queue(viewer_t *v, const UBYTE *data, size_t len, int forced)
+{
+	size_t queued = v->out_len - v->out_pos;
+
+	if (!forced && queued + len > QUEUE_LIMIT)
+		return FALSE;
+	if (v->out_pos > 0) {
+		memmove(v->out, v->out + v->out_pos, queued);
+		v->out_pos = 0;
+		v->out_len = queued;
+	}
+	if (v->out_len + len > v->out_size) {
+		v->out_size = v->out_len + len + 65536;
+		v->out = (UBYTE *)Util_realloc(v->out, v->out_size);
+	}
+	memcpy(v->out + v->out_len, data, len);
+	v->out_len += len;
+	return TRUE;
+}
+
+/* Sends what is queued for viewer i, as far as the socket takes it; returns
+   FALSE if the viewer was closed */
+static int flush(int i)
+{
+	viewer_t *v = &viewers[i];
+
+	while (v->out_pos < v->out_len) {
+		ssize_t n = send(v->fd, v->out + v->out_pos, v->out_len - v->out_pos, MSG_NOSIGNAL);
+		if (n < 0) {
+			if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+				return TRUE;
+			close_viewer(i);
+			return FALSE;
+		}
+		v->out_pos += n;
+	}
+	v->out_pos = v->out_len = 0;
+	if (v->state == VIEWER_CLOSING) {
+		close_viewer(i);
+		return FALSE;
+	}
+	return TRUE;
+}
+
+static void reply(viewer_t *v, const char *status, const char *type, const char *body)
+{
+	char head[256];
+
+	snprintf(head, sizeof(head), "HTTP/1.1 %s\r\nContent-Type: %s\r\nContent-Length: %d\r\n"
+		"Cache-Control: no-cache\r\nConnection: close\r\n\r\n", status, type, (int)strlen(body));
+	queue(v, (const UBYTE *)head, strlen(head), TRUE);
+	queue(v, (const UBYTE *)body, strlen(body), TRUE);
+	v->state = VIEWER_CLOSING;
+}
+
+/* Copies the value of header name in the request head to value */
+static int header(const char *head, const char *name, char *value, size_t size)
+{
+	size_t len = strlen(name);
+	const char *p;
+
+	for (p = strstr(head, "\r\n"); p != NULL; p = strstr(p, "\r\n")) {
+		const char *end;
+		p += 2;
+		if (Util_strnicmp(p, name, len) != 0 || p[len] != ':')
+			continue;
+		p += len + 1;
+		while (*p == ' ' || *p == '\t')
+			p++;
+		end = strstr(p, "\r\n");
+		if (end == NULL || (size_t)(end - p) >= size)
+			return FALSE;
+		memcpy(value, p, end - p);
+		value[end - p] = '\0';
+		return TRUE;
+	}
+	return FALSE;
+}
+
+/* Answers the request of v once its head is complete */
+static void request(viewer_t *v)
+{
+	static const char guid[] = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+	char *head = (char *)v->in;
+	char upgrade[32];
+	char key[64 + sizeof(guid)];
+	char accept[32];
+	char response[256];
+	UBYTE digest[20];
+	char *end;
+
+	v->in[v->in_len] = '\0';
+	end = strstr(head, "\r\n\r\n");
+	if (end == NULL) {
+		/* receive() keeps the last byte for the terminator */
+		if (v->in_len >= REQUEST_MAX - 1)
+			reply(v, "431 Request Header Fields Too Large", "text/plain", "too large\n");
+		return;
+	}
+	end[2] = '\0';
+	v->in_len = 0;
+	if (strncmp(head, "GET ", 4) != 0) {
+		reply(v, "405 Method Not Allowed", "text/plain", "GET only\n");
+		return;
+	}
+	if (header(head, "Upgrade", upgrade, sizeof(upgrade)) && Util_stricmp(upgrade, "websocket") == 0) {
+		if (!header(head, "Sec-WebSocket-Key", key, 64)) {
+			reply(v, "400 Bad Request", "text/plain", "no key\n");
+			return;
+		}
+		if (num_viewers >= max_viewers) {
+			reply(v, "503 Service Unavailable", "text/plain", "too many viewers\n");
+			return;
+		}
+		strcat(key, guid);
+		sha1((const UBYTE *)key, strlen(key), digest);
+		base64(digest, 20, accept);
+		snprintf(response, sizeof(response), "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\n"
+			"Connection: Upgrade\r\nSec-WebSocket-Accept: %s\r\n\r\n", accept);
+		queue(v, (const UBYTE *)response, strlen(response), TRUE);
+		v->state = VIEWER_SOCKET;
+		v->need_key = TRUE;
+		v->palette = -1;
+		pthread_mutex_lock(&lock);
+		num_viewers++;
+		pthread_mutex_unlock(&lock);
+	}
+	else if (strncmp(head + 4, "/ ", 2) == 0 || strncmp(head + 4, "/index.html ", 12) == 0)
+		reply(v, "200 OK", "text/html; charset=utf-8", page);
+	else
+		reply(v, "404 Not Found", "text/plain", "not found\n");
+}
+
+/* Goes through the messages from the viewer: answers pings and closes, and
+   ignores the rest */
+static void messages(viewer_t *v)
+{
+	while (v->in_len >= 2) {
+		int opcode = v->in[0] & 0x0f;
+		int len = v->in[1] & 0x7f;
+		int size = 2;
+		UBYTE buf[HEADER_MAX + 125];
+		const UBYTE *mask;
+		size_t total;
+		UBYTE *msg;
+		int i;
+
+		if (len == 127) {
+			v->state = VIEWER_CLOSING;
+			return;
+		}
+		if (len == 126) {
+			if (v->in_len < 4)
+				return;
+			len = v->in[2] << 8 | v->in[3];
+			size = 4;
+		}
+		mask = v->in + size;
+		if (v->in[1] & 0x80)
+			size += 4;
+		if (size + len > REQUEST_MAX) {
+			v->state = VIEWER_CLOSING;
+			return;
+		}
+		if (v->in_len < size + len)
+			return;
+		if ((opcode == 8 || opcode == 9) && len <= 125) {
+			for (i = 0; i < len; i++)
+				buf[HEADER_MAX + i] = v->in[size + i] ^ ((v->in[1] & 0x80) ? mask[i & 3] : 0);
+			/* A close is answered with its status, a ping with a pong */
+			msg = frame_message(buf, opcode == 8 ? 8 : 10, opcode == 8 && len > 2 ? 2 : len, &total);
+			queue(v, msg, total, TRUE);
+			if (opcode == 8)
+				v->state = VIEWER_CLOSING;
+		}
+		else if (opcode == 8)
+			v->state = VIEWER_CLOSING;
+		v->in_len -= size + len;
+		memmove(v->in, v->in + size + len, v->in_len);
+		if (v->state == VIEWER_CLOSING)
+			return;
+	}
+}
+
+/* Reads from viewer i; returns FALSE if it was closed */
+static int receive(int i)
+{
+	viewer_t *v = &viewers[i];
+	ssize_t n = recv(v->fd, v->in + v->in_len, REQUEST_MAX - v->in_len - (v->state == VIEWER_REQUEST), 0);
+
+	if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+		close_viewer(i);
+		return FALSE;
+	}
+	if (n < 0)
+		return TRUE;
+	v->in_len += n;
+	if (v->state == VIEWER_REQUEST)
+		request(v);
+	else if (v->state == VIEWER_SOCKET)
+		messages(v);
+	else
+		v->in_len = 0;
+	return TRUE;
+}
+
+static void accept_viewer(void)
+{
+	int fd = accept(listen_fd, NULL, NULL);
+	int one = 1;
+
+	if (fd < 0)
+		return;
+	if (count == MAX_VIEWERS) {
+		close(fd);
+		return;
+	}
+	fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+	setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, (char *)&one, sizeof(one));
+#ifdef SO_NOSIGPIPE
+	setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, (char *)&one, sizeof(one));
+#endif
+	memset(&viewers[count], 0, sizeof(viewer_t));
+	viewers[count].fd = fd;
+	viewers[count].state = VIEWER_REQUEST;
+	count++;
+}
+
+/* Queues the frame in cur, width x height, for every viewer: the changes
+   from prev for those who have it, a whole frame for the rest */
+static void send_frame(int frame, int width, int height, const int *colours, int serial)
+{
+	UBYTE pal[HEADER_MAX + 1 + 256 * 3];
+	UBYTE *pal_msg = NULL;
+	UBYTE *delta = NULL;
+	UBYTE *key = NULL;
+	size_t pal_len = 0, delta_len = 0, key_len = 0;
+	int delta_ok = width == prev_width && height == prev_height;
+	int i;
+
+	for (i = 0; i < count; i++) {
+		viewer_t *v = &viewers[i];
+		int whole = v->need_key || !delta_ok;
+		UBYTE **msg = whole ? &key : &delta;
+		size_t *len = whole ? &key_len : &delta_len;
+
+		if (v->state != VIEWER_SOCKET)
+			continue;
+		if (v->palette != serial) {
+			if (pal_msg == NULL) {
+				int c;
+				pal[HEADER_MAX] = MESSAGE_PALETTE;
+				for (c = 0; c < 256; c++) {
+					pal[HEADER_MAX + 1 + 3 * c] = (UBYTE)(colours[c] >> 16);
+					pal[HEADER_MAX + 2 + 3 * c] = (UBYTE)(colours[c] >> 8);
+					pal[HEADER_MAX + 3 + 3 * c] = (UBYTE)colours[c];
+				}
+				pal_msg = frame_message(pal, 2, 1 + 256 * 3, &pal_len);
+			}
+			queue(v, pal_msg, pal_len, TRUE);
+			v->palette = serial;
+		}
+		if (*msg == NULL) {
+			/* Encoded once, the first time a viewer needs it */
+			UBYTE *buf = whole ? key_msg : delta_msg;
+			UBYTE *p = buf + HEADER_MAX;
+			*p++ = MESSAGE_VIDEO;
+			*p++ = (UBYTE)whole;
+			*p++ = (UBYTE)width;
+			*p++ = (UBYTE)(width >> 8);
+			*p++ = (UBYTE)height;
+			*p++ = (UBYTE)(height >> 8);
+			*p++ = (UBYTE)frame;
+			*p++ = (UBYTE)(frame >> 8);
+			*p++ = (UBYTE)(frame >> 16);
+			*p++ = (UBYTE)(frame >> 24);
+			p = encode_runs(cur, whole ? NULL : prev, width * height, p);
+			*msg = frame_message(buf, 2, p - buf - HEADER_MAX, len);
+		}
+		if (queue(v, *msg, *len, FALSE)) {
+			v->need_key = FALSE;
+			frames_sent++;
+		}
+		else {
+			v->need_key = TRUE;
+			frames_dropped++;
+		}
+	}
+	memcpy(prev, cur, width * height);
+	prev_width = width;
+	prev_height = height;
+}
+
+/* Queues len bytes of samples from audio_take for every viewer */
+static void send_audio(int len, unsigned int rate, int channels, int sample_size)
+{
+	int samples = len / sample_size;
+	UBYTE *p = audio_msg + HEADER_MAX;
+	size_t total;
+	UBYTE *msg;
+	int i;
+
+	*p++ = MESSAGE_AUDIO;
+	*p++ = (UBYTE)rate;
+	*p++ = (UBYTE)(rate >> 8);
+	*p++ = (UBYTE)(rate >> 16);
+	*p++ = (UBYTE)(rate >> 24);
+	*p++ = (UBYTE)channels;
+	for (i = 0; i < samples; i++) {
+		int s;
+		if (sample_size == 2) {
+			SWORD w;
+			memcpy(&w, audio_take + 2 * i, 2);
+			s = w;
+		}
+		else
+			s = (audio_take[i] - 0x80) << 8;
+		*p++ = (UBYTE)s;
+		*p++ = (UBYTE)(s >> 8);
+	}
+	msg = frame_message(audio_msg, 2, p - audio_msg - HEADER_MAX, &total);
+	for (i = 0; i < count; i++) {
+		if (viewers[i].state == VIEWER_SOCKET)
+			queue(&viewers[i], msg, total, FALSE);
+	}
+}
+
+/* Takes what the emulation left since the last time and queues it */
+static void take(void)
+{
+	static int colours[256];
+	const UBYTE *screen;
+	int frame, box[4], serial, len = 0;
+	unsigned int rate;
+	int channels, sample_size;
+
+	pthread_mutex_lock(&lock);
+	screen = pending;
+	pending = NULL;
+	frame = pending_frame;
+	memcpy(box, pending_box, sizeof(box));
+	serial = palette_serial;
+	memcpy(colours, palette, sizeof(colours));
+	if (audio_written - audio_read > AUDIO_RING)
+		audio_read = audio_written - AUDIO_RING;
+	while (audio_read != audio_written) {
+		int pos = audio_read & (AUDIO_RING - 1);
+		int n = audio_written - audio_read;
+		if (n > AUDIO_RING - pos)
+			n = AUDIO_RING - pos;
+		memcpy(audio_take + len, audio + pos, n);
+		len += n;
+		audio_read += n;
+	}
+	rate = audio_rate;
+	channels = audio_channels;
+	sample_size = audio_sample_size;
+	pthread_mutex_unlock(&lock);
+
+	if (screen != NULL) {
+		int width = box[2] - box[0];
+		int height = box[3] - box[1];
+		int y;
+		for (y = 0; y < height; y++)
+			memcpy(cur + y * width, screen + (box[1] + y) * Screen_WIDTH + box[0], width);
+		Screen_Ring_Release(screen);
+		send_frame(frame, width, height, colours, serial);
+	}
+	if (len > 0 && rate > 0)
+		send_audio(len, rate, channels, sample_size);
+}
+
+static void *worker(void *arg)
+{
+	struct pollfd fds[2 + MAX_VIEWERS];
+
+	for (;;) {
+		int i;
+		int stop;
+
+		fds[0].fd = wake_fds[0];
+		fds[0].events = POLLIN;
+		fds[1].fd = listen_fd;
+		fds[1].events = POLLIN;
+		for (i = 0; i < count; i++) {
+			fds[2 + i].fd = viewers[i].fd;
+			fds[2 + i].events = POLLIN | (viewers[i].out_pos < viewers[i].out_len ? POLLOUT : 0);
+			fds[2 + i].revents = 0;
+		}
+		if (poll(fds, 2 + count, -1) < 0 && errno != EINTR)
+			break;
+		if (fds[0].revents & POLLIN) {
+			char buf[64];
+			while (read(wake_fds[0], buf, sizeof(buf)) > 0);
+		}
+		pthread_mutex_lock(&lock);
+		stop = stopping;
+		pthread_mutex_unlock(&lock);
+		if (stop)
+			break;
+		/* Viewers are closed by swapping the last one in, so go backwards */
+		for (i = count - 1; i >= 0; i--) {
+			if (i >= count || !(fds[2 + i].revents & (POLLIN | POLLHUP | POLLERR)))
+				continue;
+			if (fds[2 + i].revents & POLLIN)
+				receive(i);
+			else
+				close_viewer(i);
+		}
+		if (fds[1].revents & POLLIN)
+			accept_viewer();
+		take();
+		for (i = count - 1; i >= 0; i--) {
+			if (viewers[i].out_pos < viewers[i].out_len || viewers[i].state == VIEWER_CLOSING)
+				flush(i);
+		}
+	}
+	while (count > 0)
+		close_viewer(count - 1);
+	return NULL;
+}
+
+static int start(void)
+{
+	struct addrinfo hints;
+	struct addrinfo *res;
+	char service[8];
+	int one = 1;
+	int err;
+
+	memset(&hints, 0, sizeof(hints));
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+	hints.ai_flags = AI_PASSIVE;
+	snprintf(service, sizeof(service), "%d", port);
+	err = getaddrinfo(address[0] != '\0' ? address : NULL, service, &hints, &res);
+	if (err != 0) {
+		Log_print("Stream: %s: %s", address, gai_strerror(err));
+		return FALSE;
+	}
+	listen_fd = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
+	if (listen_fd >= 0) {
+		setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, (char *)&one, sizeof(one));
+		if (bind(listen_fd, res->ai_addr, res->ai_addrlen) != 0 || listen(listen_fd, 16) != 0) {
+			close(listen_fd);
+			listen_fd = -1;
+		}
+	}
+	freeaddrinfo(res);
+	if (listen_fd < 0) {
+		Log_print("Stream: cannot listen on %s:%d: %s", address, port, strerror(errno));
+		return FALSE;
+	}
+	fcntl(listen_fd, F_SETFL, fcntl(listen_fd, F_GETFL) | O_NONBLOCK);
+	if (pipe(wake_fds) != 0) {
+		close(listen_fd);
+		listen_fd = -1;
+		return FALSE;
+	}
+	fcntl(wake_fds[0], F_SETFL, fcntl(wake_fds[0], F_GETFL) | O_NONBLOCK);
+	fcntl(wake_fds[1], F_SETFL, fcntl(wake_fds[1], F_GETFL) | O_NONBLOCK);
+	/* The screen waiting for the worker, and the one it is copying */
+	if (!Screen_Ring_Open(2)) {
+		STREAM_Exit();
+		return FALSE;
+	}
+	delta_msg = (UBYTE *)Util_malloc(VIDEO_MAX);
+	key_msg = (UBYTE *)Util_malloc(VIDEO_MAX);
+	audio_take = (UBYTE *)Util_malloc(AUDIO_RING);
+	audio_msg = (UBYTE *)Util_malloc(HEADER_MAX + 6 + AUDIO_RING * 2);
+	stopping = FALSE;
+	prev_width = prev_height = 0;
+	palette_serial = 0;
+	memset(palette, 0, sizeof(palette));
+	running = TRUE;
+	if (pthread_create(&thread, NULL, worker, NULL) != 0) {
+		running = FALSE;
+		Screen_Ring_Close(2);
+		STREAM_Exit();
+		return FALSE;
+	}
+	Log_print("Stream: viewer page at http://%s:%d/", address[0] != '\0' ? address : "localhost", port);
+	return TRUE;
+}
+
+int STREAM_Initialise(int *argc, char *argv[])
+{
+	int i;
+	int j;
+
+	for (i = j = 1; i < *argc; i++) {
+		int i_a = (i + 1 < *argc);		/* is argument available? */
+		int a_m = FALSE;			/* error, argument missing! */
+		int a_i = FALSE;			/* error, argument invalid! */
+
+		if (strcmp(argv[i], "-stream") == 0) {
+			if (i_a) {
+				char *arg = argv[++i];
+				char *colon = strrchr(arg, ':');
+				if (colon != NULL) {
+					size_t len = colon - arg;
+					if (len >= sizeof(address))
+						len = sizeof(address) - 1;
+					memcpy(address, arg, len);
+					address[len] = '\0';
+					arg = colon + 1;
+				}
+				port = Util_sscandec(arg);
+				if (port < 1 || port > 65535)
+					a_i = TRUE;
+			}
+			else a_m = TRUE;
+		}
+		else if (strcmp(argv[i], "-stream-viewers") == 0) {
+			if (i_a) {
+				max_viewers = Util_sscandec(argv[++i]);
+				if (max_viewers < 1 || max_viewers > MAX_VIEWERS)
+					a_i = TRUE;
+			}
+			else a_m = TRUE;
+		}
+		else {
+			if (strcmp(argv[i], "-help") == 0) {
+				Log_print("\t-stream [<host>:]<port>  Serve the screen and sound to web browsers");
+				Log_print("\t                  (host default 127.0.0.1, e.g. %d)", DEFAULT_PORT);
+				Log_print("\t-stream-viewers <n>  Viewers at once, up to %d (default %d)", MAX_VIEWERS, DEFAULT_VIEWERS);
+			}
+			argv[j++] = argv[i];
+		}
+
+		if (a_m) {
+			Log_print("Missing argument for '%s'", argv[i]);
+			return FALSE;
+		}
+		else if (a_i) {
+			Log_print("Invalid argument for '%s'", argv[--i]);
+			return FALSE;
+		}
+	}
+	*argc = j;
+
+	if (port != 0)
+		return start();
+	return TRUE;
+}
+
+void STREAM_Exit(void)
+{
+	if (running) {
+		pthread_mutex_lock(&lock);
+		stopping = TRUE;
+		pthread_mutex_unlock(&lock);
+		if (write(wake_fds[1], "", 1) < 0) {
+			/* the pipe is full, so the worker wakes up anyway */
+		}
+		pthread_join(thread, NULL);
+		running = FALSE;
+		if (pending != NULL) {
+			Screen_Ring_Release(pending);
+			pending = NULL;
+		}
+		Screen_Ring_Close(2);
+		if (frames_sent > 0)
+			Log_print("Stream: %lu frames sent, %lu dropped by slow viewers, %lu not taken in time",
+				(unsigned long)frames_sent, (unsigned long)frames_dropped, (unsigned long)frames_replaced);
+	}
+#ifdef SOUND
+	if (observing) {
+		Sound_observers--;
+		observing = FALSE;
+	}
+#endif
+	if (listen_fd >= 0) {
+		close(listen_fd);
+		listen_fd = -1;
+	}
+	if (wake_fds[0] >= 0) {
+		close(wake_fds[0]);
+		close(wake_fds[1]);
+		wake_fds[0] = wake_fds[1] = -1;
+	}
+	free(delta_msg);
+	free(key_msg);
+	free(audio_take);
+	free(audio_msg);
+	delta_msg = key_msg = audio_take = audio_msg = NULL;
+}
+
+void STREAM_Frame(void)
+{
+	const UBYTE *screen = NULL;
+	const UBYTE *replaced = NULL;
+	int viewers_now;
+
+	if (!running)
+		return;
+	pthread_mutex_lock(&lock);
+	viewers_now = num_viewers;
+	pthread_mutex_unlock(&lock);
+#ifdef SOUND
+	/* Synthesis is never skipped while someone listens */
+	if ((viewers_now > 0) != observing) {
+		observing = !observing;
+		Sound_observers += observing ? 1 : -1;
+	}
+#endif
+	if (viewers_now == 0)
+		return;
+	if (Atari800_display_screen)
+		screen = Screen_Ring_AcquireCurrent();
+
+	pthread_mutex_lock(&lock);
+	if (screen != NULL) {
+		int x1 = Screen_visible_x1, x2 = Screen_visible_x2;
+		int y1 = Screen_visible_y1, y2 = Screen_visible_y2;
+		if (x1 < 0) x1 = 0;
+		if (y1 < 0) y1 = 0;
+		if (x2 > Screen_WIDTH) x2 = Screen_WIDTH;
+		if (y2 > Screen_HEIGHT) y2 = Screen_HEIGHT;
+		if (x2 <= x1 || y2 <= y1) {
+			x1 = y1 = 0;
+			x2 = Screen_WIDTH;
+			y2 = Screen_HEIGHT;
+		}
+		replaced = pending;
+		pending = screen;
+		pending_frame = Atari800_nframes;
+		pending_box[0] = x1;
+		pending_box[1] = y1;
+		pending_box[2] = x2;
+		pending_box[3] = y2;
+		if (replaced != NULL)
+			frames_replaced++;
+	}
+	if (memcmp(palette, Colours_table, sizeof(palette)) != 0) {
+		memcpy(palette, Colours_table, sizeof(palette));
+		palette_serial++;
+	}
+#ifdef SOUND
+	{
+		unsigned int size;
+		UBYTE const *samples = Sound_FrameSamples(&size);
+		if (Sound_out.freq != audio_rate || (int)Sound_out.channels != audio_channels
+		    || Sound_out.sample_size != audio_sample_size) {
+			/* What is left is of the old format */
+			audio_rate = Sound_out.freq;
+			audio_channels = Sound_out.channels;
+			audio_sample_size = Sound_out.sample_size;
+			audio_read = audio_written;
+		}
+		if (samples != NULL && size <= AUDIO_RING) {
+			unsigned int pos = audio_written & (AUDIO_RING - 1);
+			unsigned int first = size < AUDIO_RING - pos ? size : AUDIO_RING - pos;
+			memcpy(audio + pos, samples, first);
+			memcpy(audio, samples + first, size - first);
+			audio_written += size;
+		}
+	}
+#endif
+	pthread_mutex_unlock(&lock);
+
+	if (replaced != NULL)
+		Screen_Ring_Release(replaced);
+	if (write(wake_fds[1], "", 1) < 0) {
+		/* the pipe is full, so the worker wakes up anyway */
+	}
+}
@@ -0,0 +1,33 @@
+/*
+ * stream.h - live screen and sound for web browsers over WebSocket
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+#ifndef STREAM_H_
+#define STREAM_H_
+
+/* A small web server on a worker thread: a browser opening its address gets
+   a viewer page, which connects back over WebSocket and is sent the palette,
+   the screens and the sound of the running emulator as they are made.
+
+   Each frame is encoded once, whatever the number of viewers: the visible
+   area's palette indices, as the changes from the frame before, in runs of
+   unchanged, repeated and literal pixels. A viewer that has just connected,
+   or whose connection fell behind, is sent a whole frame (also encoded once
+   for all of them) and the changes from then on. The emulation never waits:
+   a frame the worker has not taken yet is replaced by the next one, and
+   what does not fit in a viewer's queue is dropped. */
+
+/* Parses the -stream options and starts the server. */
+int STREAM_Initialise(int *argc, char *argv[]);
+
+/* Closes every connection and stops the server. */
+void STREAM_Exit(void);
+
+/* At the end of a frame, after Sound_Update(): hands the completed screen
+   and the frame's samples to the worker. */
+void STREAM_Frame(void);
+
+#endif /* STREAM_H_ */
@@ -30,7 +30,15 @@
 #endif
 #include <stdarg.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#if defined(HAVE_STAT) && defined(HAVE_SYS_STAT_H)
+#define ROM_CACHE
+#include <sys/stat.h>
+#endif
+#ifdef HAVE_PTHREAD_CREATE
+#include <pthread.h>
+#endif
 
 #include "sysrom.h"
 
@@ -198,29 +206,226 @@ static void ClearUnsetFlag(int id)
 	}
 }
 
+/* Index of ROM image CRCs kept between runs, so that files already seen
+   are not read again at startup. An entry holds while the file keeps its
+   size and modification time. */
+#define DEFAULT_ROM_CACHE_NAME ".atari800.roms"
+
+#ifdef ROM_CACHE
+typedef struct {
+	char *path;
+	int len;
+	long mtime;
+	ULONG crc;
+	int seen; /* looked up or stored in this run */
+} rom_cache_entry;
+
+static rom_cache_entry *rom_cache = NULL;
+static int rom_cache_size = 0;
+static int rom_cache_alloc = 0;
+static int rom_cache_loaded = FALSE;
+static int rom_cache_dirty = FALSE;
+static int rom_cache_enabled = TRUE;
+static char rom_cache_filename[FILENAME_MAX] = "";
+#endif /* ROM_CACHE */
+
+void SYSROM_SetCacheFile(char const *filename)
+{
+#ifdef ROM_CACHE
+	if (filename == NULL)
+		rom_cache_enabled = FALSE;
+	else {
+		Util_strlcpy(rom_cache_filename, filename, FILENAME_MAX);
+		rom_cache_enabled = TRUE;
+	}
+#endif /* ROM_CACHE */
+}
+
+#ifdef ROM_CACHE
+static void LoadCache(void)
+{
+	FILE *fp;
+	char line[FILENAME_MAX + 64];
+
+	rom_cache_loaded = TRUE;
+	if (rom_cache_filename[0] == '\0') {
+		char *home = getenv("HOME");
+		if (home == NULL) {
+			rom_cache_enabled = FALSE;
+			return;
+		}
+		Util_catpath(rom_cache_filename, home, DEFAULT_ROM_CACHE_NAME);
+	}
+	if ((fp = fopen(rom_cache_filename, "r")) == NULL)
+		return;
+	while (fgets(line, sizeof(line), fp) != NULL) {
+		unsigned long crc;
+		int len;
+		long mtime;
+		int pos;
+		rom_cache_entry *e;
+		Util_chomp(line);
+		if (sscanf(line, "%lx %d %ld %n", &crc, &len, &mtime, &pos) != 3 || line[pos] == '\0')
+			continue;
+		if (rom_cache_size == rom_cache_alloc) {
+			rom_cache_alloc = rom_cache_alloc == 0 ? 64 : rom_cache_alloc * 2;
+			rom_cache = (rom_cache_entry *)Util_realloc(rom_cache, rom_cache_alloc * sizeof(rom_cache_entry));
+		}
+		e = &rom_cache[rom_cache_size++];
+		e->path = Util_strdup(line + pos);
+		e->len = len;
+		e->mtime = mtime;
+		e->crc = (ULONG)crc;
+		e->seen = FALSE;
+	}
+	fclose(fp);
+}
+
+/* Writes the index through a temporary file, so that emulators starting at
+   the same time never read half of it. */
+static void SaveCache(void)
+{
+	char tmp_filename[FILENAME_MAX + 4];
+	FILE *fp;
+	int i;
+
+	if (!rom_cache_dirty || !rom_cache_enabled)
+		return;
+	rom_cache_dirty = FALSE;
+	strcpy(tmp_filename, rom_cache_filename);
+	strcat(tmp_filename, ".tmp");
+	if ((fp = fopen(tmp_filename, "w")) == NULL)
+		return;
+	for (i = 0; i < rom_cache_size; ++i)
+		fprintf(fp, "%08lx %d %ld %s\n", (unsigned long)rom_cache[i].crc, rom_cache[i].len, rom_cache[i].mtime, rom_cache[i].path);
+	if (fclose(fp) != 0 || rename(tmp_filename, rom_cache_filename) != 0)
+		Util_unlink(tmp_filename);
+}
+
+static rom_cache_entry *FindCache(char const *path)
+{
+	int i;
+	if (!rom_cache_loaded)
+		LoadCache();
+	for (i = 0; i < rom_cache_size; ++i) {
+		if (strcmp(rom_cache[i].path, path) == 0)
+			return &rom_cache[i];
+	}
+	return NULL;
+}
+
+static void StoreCache(char const *path, int len, long mtime, ULONG crc)
+{
+	rom_cache_entry *e;
+	if (!rom_cache_enabled)
+		return;
+	e = FindCache(path);
+	if (e == NULL) {
+		if (rom_cache_size == rom_cache_alloc) {
+			rom_cache_alloc = rom_cache_alloc == 0 ? 64 : rom_cache_alloc * 2;
+			rom_cache = (rom_cache_entry *)Util_realloc(rom_cache, rom_cache_alloc * sizeof(rom_cache_entry));
+		}
+		e = &rom_cache[rom_cache_size++];
+		e->path = Util_strdup(path);
+	}
+	e->len = len;
+	e->mtime = mtime;
+	e->crc = crc;
+	e->seen = TRUE;
+	rom_cache_dirty = TRUE;
+}
+
+/* Drops the entries of files in DIRECTORY that were not found there. */
+static void PruneCache(char const *directory)
+{
+	int i, j;
+	for (i = j = 0; i < rom_cache_size; ++i) {
+		char name[FILENAME_MAX];
+		char path[FILENAME_MAX];
+		Util_splitpath(rom_cache[i].path, NULL, name);
+		Util_catpath(path, directory, name);
+		if (!rom_cache[i].seen && strcmp(path, rom_cache[i].path) == 0) {
+			free(rom_cache[i].path);
+			rom_cache_dirty = TRUE;
+		}
+		else
+			rom_cache[j++] = rom_cache[i];
+	}
+	rom_cache_size = j;
+}
+#endif /* ROM_CACHE */
+
+/* Gets the length and modification time of FILENAME. Returns FALSE if it
+   is not a readable file (e.g. a directory). */
+static int StatFile(char const *filename, int *len, long *mtime)
+{
+#ifdef ROM_CACHE
+	struct stat st;
+	if (stat(filename, &st) != 0 || !S_ISREG(st.st_mode))
+		return FALSE;
+	/* Sizes beyond any ROM image are all the same here */
+	*len = st.st_size > 0x10000 ? 0x10000 : (int)st.st_size;
+	*mtime = (long)st.st_mtime;
+	return TRUE;
+#else
+	FILE *f = fopen(filename, "rb");
+	if (f == NULL)
+		return FALSE;
+	*len = Util_flen(f);
+	*mtime = 0;
+	fclose(f);
+	return TRUE;
+#endif /* ROM_CACHE */
+}
+
+/* Gets the CRC of a ROM image of LEN bytes from the cache. */
+static int CachedCRC(char const *filename, int len, long mtime, ULONG *crc)
+{
+#ifdef ROM_CACHE
+	rom_cache_entry *e;
+	if (!rom_cache_enabled || (e = FindCache(filename)) == NULL
+	    || e->len != len || e->mtime != mtime)
+		return FALSE;
+	e->seen = TRUE;
+	*crc = e->crc;
+	return TRUE;
+#else
+	return FALSE;
+#endif /* ROM_CACHE */
+}
+
+static int FileCRC(char const *filename, ULONG *crc)
+{
+	int ok;
+	FILE *f = fopen(filename, "rb");
+	if (f == NULL)
+		return FALSE;
+	ok = CRC32_FromFile(f, crc);
+	fclose(f);
+	return ok;
+}
+
 int SYSROM_SetPath(char const *filename, int num, ...)
 {
 	va_list ap;
 	int len;
+	long mtime;
 	ULONG crc;
 	int retval = SYSROM_OK;
-	FILE *f = fopen(filename, "rb");
 
-	if (f == NULL)
+	if (!StatFile(filename, &len, &mtime))
 		return SYSROM_ERROR;
-
-	len = Util_flen(f);
 	/* Don't proceed to CRC computation if the file has invalid size. */
-	if (!IsLengthAllowed(len)) {
-		fclose(f);
+	if (!IsLengthAllowed(len))
 		return SYSROM_BADSIZE;
+	if (!CachedCRC(filename, len, mtime, &crc)) {
+		if (!FileCRC(filename, &crc))
+			return SYSROM_ERROR;
+#ifdef ROM_CACHE
+		StoreCache(filename, len, mtime, crc);
+		SaveCache();
+#endif
 	}
-	Util_rewind(f);
-	if (!CRC32_FromFile(f, &crc)) {
-		fclose(f);
-		return SYSROM_ERROR;
-	}
-	fclose(f);
 
 	va_start(ap, num);
 	while (num > 0) {
@@ -281,10 +486,81 @@ static int MatchByName(char const *filename, int len, int only_if_not_set)
 	return -1;
 }
 
+/* A file in a directory being searched */
+typedef struct {
+	char *name;
+	char *path;
+	int len;
+	long mtime;
+	ULONG crc;
+	int crc_state; /* see below */
+} dir_file;
+
+enum { CRC_NEEDED, CRC_CACHED, CRC_READ, CRC_FAILED };
+
+/* Threads reading ROM images whose CRCs are not cached. The files are
+   small, so on network drives the time goes to waiting for the server. */
+#define CRC_THREADS 8
+
+typedef struct {
+	dir_file *files;
+	int num_files;
+	int first; /* this thread takes every CRC_THREADS-th file from here */
+} crc_job;
+
+static void *CRCProc(void *arg)
+{
+	crc_job *job = (crc_job *)arg;
+	int i;
+	for (i = job->first; i < job->num_files; i += CRC_THREADS) {
+		dir_file *file = &job->files[i];
+		if (file->crc_state == CRC_NEEDED)
+			file->crc_state = FileCRC(file->path, &file->crc) ? CRC_READ : CRC_FAILED;
+	}
+	return NULL;
+}
+
+/* Computes the CRCs not known yet, in parallel if there are several. */
+static void ComputeCRCs(dir_file *files, int num_files, int num_needed)
+{
+	crc_job jobs[CRC_THREADS];
+	int i;
+#ifdef HAVE_PTHREAD_CREATE
+	pthread_t threads[CRC_THREADS];
+	int started[CRC_THREADS];
+#endif
+
+	for (i = 0; i < CRC_THREADS; ++i) {
+		jobs[i].files = files;
+		jobs[i].num_files = num_files;
+		jobs[i].first = i;
+	}
+#ifdef HAVE_PTHREAD_CREATE
+	if (num_needed > 1) {
+		for (i = 0; i < CRC_THREADS; ++i)
+			started[i] = pthread_create(&threads[i], NULL, CRCProc, &jobs[i]) == 0;
+		for (i = 0; i < CRC_THREADS; ++i) {
+			if (started[i])
+				pthread_join(threads[i], NULL);
+			else
+				CRCProc(&jobs[i]);
+		}
+		return;
+	}
+#endif
+	for (i = 0; i < CRC_THREADS; ++i)
+		CRCProc(&jobs[i]);
+}
+
 int SYSROM_FindInDir(char const *directory, int only_if_not_set)
 {
 	DIR *dir;
 	struct dirent *entry;
+	dir_file *files = NULL;
+	int num_files = 0;
+	int alloc_files = 0;
+	int num_needed = 0;
+	int i;
 
 	if (only_if_not_set && num_unset_roms == 0)
 		/* No unset ROM paths left. */
@@ -293,38 +569,71 @@ int SYSROM_FindInDir(char const *directory, int only_if_not_set)
 	if ((dir = opendir(directory)) == NULL)
 		return FALSE;
 
+	/* Files of allowed sizes, with the CRCs the cache knows */
 	while ((entry = readdir(dir)) != NULL) {
 		char full_filename[FILENAME_MAX];
-		FILE *file;
+		dir_file *file;
 		int len;
-		int id;
-		ULONG crc;
-		int matched_crc = FALSE;
+		long mtime;
 		Util_catpath(full_filename, directory, entry->d_name);
-		if ((file = fopen(full_filename, "rb")) == NULL)
-			/* Ignore non-readable files (e.g. directories). */
+		/* Ignore non-readable files (e.g. directories). */
+		if (!StatFile(full_filename, &len, &mtime))
 			continue;
-
-		len = Util_flen(file);
 		/* Don't proceed to CRC computation if the file has invalid size. */
-		if (!IsLengthAllowed(len)){
-			fclose(file);
+		if (!IsLengthAllowed(len))
 			continue;
+
+		if (num_files == alloc_files) {
+			alloc_files = alloc_files == 0 ? 16 : alloc_files * 2;
+			files = (dir_file *)Util_realloc(files, alloc_files * sizeof(dir_file));
+		}
+		file = &files[num_files++];
+		file->name = Util_strdup(entry->d_name);
+		file->path = Util_strdup(full_filename);
+		file->len = len;
+		file->mtime = mtime;
+		if (CachedCRC(full_filename, len, mtime, &file->crc))
+			file->crc_state = CRC_CACHED;
+		else {
+			file->crc_state = CRC_NEEDED;
+			++num_needed;
 		}
-		Util_rewind(file);
+	}
+	closedir(dir);
 
-		if (!CRC32_FromFile(file, &crc)) {
-			fclose(file);
-			continue;
+	if (num_needed > 0) {
+		ComputeCRCs(files, num_files, num_needed);
+#ifdef ROM_CACHE
+		/* With the time the file had before it was read, so that a file
+		   changed meanwhile is read again next time */
+		for (i = 0; i < num_files; ++i) {
+			if (files[i].crc_state == CRC_READ)
+				StoreCache(files[i].path, files[i].len, files[i].mtime, files[i].crc);
 		}
-		fclose(file);
+#endif
+	}
+#ifdef ROM_CACHE
+	if (rom_cache_enabled) {
+		PruneCache(directory);
+		SaveCache();
+	}
+#endif
+
+	/* Matched in the order the directory lists them */
+	for (i = 0; i < num_files; ++i) {
+		dir_file *file = &files[i];
+		int id;
+		int matched_crc = FALSE;
+
+		if (file->crc_state != CRC_CACHED && file->crc_state != CRC_READ)
+			continue;
 
 		/* Match ROM image by CRC. */
 		for (id = 0; id < SYSROM_LOADABLE_SIZE; ++id) {
 			if ((!only_if_not_set || SYSROM_roms[id].unset)
-			    && SYSROM_roms[id].size == len
-			    && SYSROM_roms[id].crc32 != CRC_NULL && SYSROM_roms[id].crc32 == crc) {
-				strcpy(SYSROM_roms[id].filename, full_filename);
+			    && SYSROM_roms[id].size == file->len
+			    && SYSROM_roms[id].crc32 != CRC_NULL && SYSROM_roms[id].crc32 == file->crc) {
+				strcpy(SYSROM_roms[id].filename, file->path);
 				ClearUnsetFlag(id);
 				matched_crc = TRUE;
 				break;
@@ -333,21 +642,25 @@ int SYSROM_FindInDir(char const *directory, int only_if_not_set)
 
 		if (!matched_crc) {
 			/* Match custom ROM image by name. */
-			char *c = entry->d_name;
+			char *c = file->name;
 			while (*c != 0) {
 				*c = (char)tolower(*c);
 				++c;
 			}
 
-			id = MatchByName(entry->d_name, len, only_if_not_set);
+			id = MatchByName(file->name, file->len, only_if_not_set);
 			if (id >= 0){
-				strcpy(SYSROM_roms[id].filename, full_filename);
+				strcpy(SYSROM_roms[id].filename, file->path);
 				ClearUnsetFlag(id);
 			}
 		}
 	}
 
-	closedir(dir);
+	for (i = 0; i < num_files; ++i) {
+		free(files[i].name);
+		free(files[i].path);
+	}
+	free(files);
 	return TRUE;
 }
 
@@ -510,13 +823,49 @@ void SYSROM_ChooseROMs(int machine_type, int ram_size, int tv_system, int *os_ve
 	}
 }
 
-int SYSROM_LoadImage(int id, UBYTE *buffer)
+/* ROM files mapped by SYSROM_LoadImage(), kept while the ROM's path stays
+   the same so that the memory map can go on pointing at them. */
+static struct {
+	UBYTE *data;
+	char *filename;
+} mapped[SYSROM_LOADABLE_SIZE];
+
+int SYSROM_LoadImage(int id, UBYTE *buffer, int size, UBYTE const **image)
 {
+	FILE *f;
+
+	*image = buffer;
 	if (SYSROM_roms[id].data != NULL) {
-		memcpy(buffer, SYSROM_roms[id].data, SYSROM_roms[id].size);
+		if (SYSROM_roms[id].size == size)
+			*image = SYSROM_roms[id].data;
+		else
+			memcpy(buffer, SYSROM_roms[id].data, SYSROM_roms[id].size);
 		return TRUE;
 	}
-	return Atari800_LoadImage(SYSROM_roms[id].filename, buffer, SYSROM_roms[id].size);
+	/* Only a ROM filling the whole buffer is mapped: the rest of the buffer
+	   is saved in state files. */
+	if (SYSROM_roms[id].size != size)
+		return Atari800_LoadImage(SYSROM_roms[id].filename, buffer, SYSROM_roms[id].size);
+	if (mapped[id].data != NULL) {
+		if (strcmp(mapped[id].filename, SYSROM_roms[id].filename) == 0) {
+			*image = mapped[id].data;
+			return TRUE;
+		}
+		Util_UnmapFile(mapped[id].data, size);
+		free(mapped[id].filename);
+		mapped[id].data = NULL;
+	}
+	f = fopen(SYSROM_roms[id].filename, "rb");
+	if (f != NULL) {
+		mapped[id].data = (UBYTE *) Util_MapFile(f, size, FALSE);
+		fclose(f);
+		if (mapped[id].data != NULL) {
+			mapped[id].filename = Util_strdup(SYSROM_roms[id].filename);
+			*image = mapped[id].data;
+			return TRUE;
+		}
+	}
+	return Atari800_LoadImage(SYSROM_roms[id].filename, buffer, size);
 }
 
 /* Matches values of OS_*_VERSION and BASIC_VERSION parameters in the config file.
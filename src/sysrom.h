@@ -106,11 +106,18 @@ enum{
    the first match. See the above enum for possible return values. */
 int SYSROM_SetPath(char const *filename, int num, ...);
 
+/* Set the file that keeps the CRCs of ROM images found, so that they are not
+   read again while their sizes and modification times stay the same. NULL
+   turns the cache off. By default it is .atari800.roms in the home
+   directory. Call before SYSROM_FindInDir(). */
+void SYSROM_SetCacheFile(char const *filename);
+
 /* Find ROM images in DIRECTORY, checking each file against known file sizes
    and CRCs. For each ROM for which a matching file is found, its filename is
    updated.
    If ONLY_IF_NOT_SET is TRUE, only paths that weren't given in the config
-   file/command line are updated.
+   file/command line are updated. Files not in the cache are read in
+   parallel.
    Returns FALSE if it couldn't open DIRECTORY; otherwise returns TRUE. */
 int SYSROM_FindInDir(char const *directory, int only_if_not_set);
 
@@ -139,9 +146,13 @@ void SYSROM_SetDefaults(void);
  */
 void SYSROM_ChooseROMs(int machine_type, int ram_size, int tv_system, int *os_version, int *basic_version, int *xegame_version);
 
-/* Called from Atari800_InitialiseMachine(). Loads OS ROM identified by ID into
-   a memory buffer BUFFER. */
-int SYSROM_LoadImage(int id, UBYTE *buffer);
+/* Called from Atari800_InitialiseMachine(). Sets *IMAGE to the OS ROM
+   identified by ID, for a memory buffer BUFFER of SIZE bytes. A ROM of that
+   size is not copied: *IMAGE points at the built-in data, or at the file
+   mapped read-only, whose pages are shared by every emulator running it.
+   Otherwise, or where the file cannot be mapped, the ROM is read into BUFFER
+   and *IMAGE is set to BUFFER. Returns FALSE if the file cannot be read. */
+int SYSROM_LoadImage(int id, UBYTE *buffer, int size, UBYTE const **image);
 
 /* Read/write from/to configuration file. */
 int SYSROM_ReadConfig(char *string, char *ptr);
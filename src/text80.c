@@ -0,0 +1,44 @@
+/*
+ * text80.c - the text screens of the 80 column cards
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+#include "config.h"
+
+#include "text80.h"
+#ifdef XEP80_EMULATION
+#include "xep80.h"
+#endif
+#ifdef PBI_PROTO80
+#include "pbi_proto80.h"
+#endif
+#ifdef AF80
+#include "af80.h"
+#endif
+#ifdef BIT3
+#include "bit3.h"
+#endif
+
+int TEXT80_GetScreen(TEXT80_Screen *screen)
+{
+	/* In the order the display picks them */
+#ifdef XEP80_EMULATION
+	if (XEP80_enabled)
+		return XEP80_GetText(screen);
+#endif
+#ifdef PBI_PROTO80
+	if (PBI_PROTO80_enabled)
+		return PBI_PROTO80_GetText(screen);
+#endif
+#ifdef AF80
+	if (AF80_enabled)
+		return AF80_GetText(screen);
+#endif
+#ifdef BIT3
+	if (BIT3_enabled)
+		return BIT3_GetText(screen);
+#endif
+	return FALSE;
+}
@@ -0,0 +1,39 @@
+/*
+ * text80.h - the text screens of the 80 column cards
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+#ifndef TEXT80_H_
+#define TEXT80_H_
+
+#include "atari.h"
+
+/* The XEP80, Austin Franklin, Bit3 and prototype 80 column cards each keep
+   their text in character RAM, which their pixel renderers turn into
+   pixels for the display. Each card can also give its text as a grid of
+   characters read straight from that RAM, so clients that only want the
+   text need no pixels. */
+
+#define TEXT80_COLUMNS 80
+#define TEXT80_MAX_ROWS 25
+
+typedef struct {
+	const char *card;	/* "xep80", "af80", "bit3" or "proto80" */
+	int rows;
+	/* Where the cursor is, or -1 when it is not shown */
+	int cursor_x;
+	int cursor_y;
+	/* ATASCII, bit 7 clear */
+	UBYTE chars[TEXT80_MAX_ROWS][TEXT80_COLUMNS];
+	/* TRUE where the character is shown inverse */
+	UBYTE inverse[TEXT80_MAX_ROWS][TEXT80_COLUMNS];
+} TEXT80_Screen;
+
+/* Fills SCREEN with the text of the enabled 80 column card, the one the
+   display would show. Returns FALSE if no card is enabled or it shows no
+   text (the XEP80 in graphics mode). */
+int TEXT80_GetScreen(TEXT80_Screen *screen);
+
+#endif /* TEXT80_H_ */
@@ -4458,6 +4458,8 @@ void UI_Run(void)
 
 	/* Sound_Active(TRUE); */
 	UI_is_active = FALSE;
+	/* the menus were drawn over the Atari screen */
+	ANTIC_InvalidateScanlineCache();
 	
 	/* flush keypresses */
 	while (PLATFORM_Keyboard() != AKEY_NONE)
@@ -56,6 +56,9 @@
 #ifdef HAVE_DIRECT_H
 #include <direct.h> /* getcwd on MSVC*/
 #endif
+#ifdef HAVE_MMAP
+#include <sys/mman.h>
+#endif
 
 #include "atari.h"
 #include "platform.h"
@@ -493,6 +496,28 @@ int Util_flen(FILE *fp)
 	return (int) ftell(fp);
 }
 
+void *Util_MapFile(FILE *fp, size_t size, int writable)
+{
+#ifdef HAVE_MMAP
+	struct stat st;
+	void *p;
+	/* Pages past the end of the file would fault when read. */
+	if (size == 0 || fstat(fileno(fp), &st) != 0 || st.st_size < (off_t) size)
+		return NULL;
+	p = mmap(NULL, size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_PRIVATE, fileno(fp), 0);
+	if (p != MAP_FAILED)
+		return p;
+#endif
+	return NULL;
+}
+
+void Util_UnmapFile(void *data, size_t size)
+{
+#ifdef HAVE_MMAP
+	munmap(data, size);
+#endif
+}
+
 /* Creates a file that does not exist and fills in filename with its name.
    filename must point to FILENAME_MAX characters buffer which doesn't need
    to be initialized. */
@@ -552,12 +577,38 @@ int Util_unlink(const char *filename)
 }
 #endif /* defined(HAVE_WINDOWS_H) && defined(UNICODE) */
 
+#if defined(HAVE_CLOCK_GETTIME) && defined(CLOCK_MONOTONIC)
+#define MONOTONIC_CLOCK
+#endif
+
+int64_t Util_time_ns(void)
+{
+#ifdef MONOTONIC_CLOCK
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+#elif defined(HAVE_WINDOWS_H)
+	static LARGE_INTEGER freq;
+	LARGE_INTEGER count;
+	if (freq.QuadPart == 0)
+		QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&count);
+	/* in two parts, so that the product cannot overflow */
+	return count.QuadPart / freq.QuadPart * 1000000000
+	       + count.QuadPart % freq.QuadPart * 1000000000 / freq.QuadPart;
+#else
+	return (int64_t)(Util_time() * 1e9);
+#endif
+}
+
+/* The system's monotonic clock is preferred to the platform's, which for
+   SDL only counts milliseconds. */
 double Util_time(void)
 {
-#ifdef SUPPORTS_PLATFORM_TIME
+#if defined(MONOTONIC_CLOCK) || defined(HAVE_WINDOWS_H)
+	return Util_time_ns() * 1e-9;
+#elif defined(SUPPORTS_PLATFORM_TIME)
 	return PLATFORM_Time();
-#elif defined(HAVE_WINDOWS_H)
-	return GetTickCount() * 1e-3;
 #elif defined(DJGPP)
 	/* DJGPP has gettimeofday, but it's not more accurate than uclock */
 	return uclock() * (1.0 / UCLOCKS_PER_SEC);
@@ -574,9 +625,6 @@ double Util_time(void)
 #endif
 }
 
-/* FIXME: Ports should use SUPPORTS_PLATFORM_SLEEP and SUPPORTS_PLATFORM_TIME */
-/* and not this mess */
-
 void Util_sleep(double s)
 {
 	if (s > 0) {
@@ -590,8 +638,8 @@ void Util_sleep(double s)
 		while ((curtime + s) > Util_time());
 #elif defined(HAVE_NANOSLEEP)
 		struct timespec ts;
-		ts.tv_sec = 0;
-		ts.tv_nsec = s * 1e9;
+		ts.tv_sec = (time_t)s;
+		ts.tv_nsec = (long)((s - ts.tv_sec) * 1e9);
 		nanosleep(&ts, NULL);
 #elif defined(HAVE_USLEEP)
 		usleep(s * 1e6);
@@ -615,6 +663,52 @@ void Util_sleep(double s)
 	}
 }
 
+/* How much later than asked sleeping ends lately, in nanoseconds; the
+   estimate follows longer oversleeps at once and shorter ones slowly. */
+static int64_t sleep_overshoot = 1000000;
+#define SLEEP_SPIN_MAX 4000000
+
+/* Sleeps until about DEADLINE */
+static void SleepTo(int64_t deadline)
+{
+#if defined(MONOTONIC_CLOCK) && defined(HAVE_CLOCK_NANOSLEEP)
+	struct timespec ts;
+	ts.tv_sec = (time_t)(deadline / 1000000000);
+	ts.tv_nsec = (long)(deadline % 1000000000);
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR)
+		;
+#else
+	int64_t now = Util_time_ns();
+	if (deadline > now)
+		Util_sleep((deadline - now) * 1e-9);
+#endif
+}
+
+void Util_sleep_until(int64_t deadline, int spin)
+{
+	int64_t now = Util_time_ns();
+	int64_t wake;
+
+	if (!spin) {
+		if (deadline > now)
+			SleepTo(deadline);
+		return;
+	}
+	wake = deadline - sleep_overshoot;
+	if (wake > now) {
+		int64_t late;
+		SleepTo(wake);
+		now = Util_time_ns();
+		late = now - wake;
+		if (late > sleep_overshoot)
+			sleep_overshoot = late < SLEEP_SPIN_MAX ? late : SLEEP_SPIN_MAX;
+		else
+			sleep_overshoot += (late - sleep_overshoot) / 20;
+	}
+	while (now < deadline)
+		now = Util_time_ns();
+}
+
 char *Util_getcwd(char *buf, size_t size)
 {
 #ifdef HAVE_GETCWD
@@ -9,6 +9,7 @@
 #endif
 #include <math.h>
 #include <ctype.h>
+#include <stdint.h>
 #ifdef HAVE_WINDOWS_H
 #include <windows.h>
 #endif
@@ -176,6 +177,17 @@ int Util_direxists(const char *filename);
    May change the current position. */
 int Util_flen(FILE *fp);
 
+/* Maps the first size bytes of an open file into memory, private to the
+   process but sharing its pages with every other process that maps the
+   file, until written to. If writable, writes go to a copy of the page,
+   never to the file. Does not move the stream's position. Returns NULL if
+   the file is shorter or cannot be mapped (or mmap is not available): read
+   it instead. */
+void *Util_MapFile(FILE *fp, size_t size, int writable);
+
+/* Releases a mapping made by Util_MapFile(). */
+void Util_UnmapFile(void *data, size_t size);
+
 /* Deletes a file, returns 0 on success, -1 on failure. */
 #ifdef HAVE_WINDOWS_H
 int Util_unlink(const char *filename);
@@ -224,8 +236,21 @@ FILE *Util_uniqopen(char *filename, const char *mode);
 #endif
 
 void Util_sleep(double s);
+
+/* Sleeps until Util_time_ns() reaches DEADLINE. Where the system can, this
+   is an absolute sleep on the monotonic clock, so that the time taken to
+   get there does not add up. With SPIN, sleeping ends early by how late it
+   has been ending lately and the rest is spun out; that estimate is kept
+   for a single pacing thread. */
+void Util_sleep_until(int64_t deadline, int spin);
+
+/* Seconds on a monotonic clock, as precise as the system has: only
+   differences between two readings mean anything. */
 double Util_time(void);
 
+/* Util_time() in integer nanoseconds */
+int64_t Util_time_ns(void);
+
 /* Get current working directory. */
 char *Util_getcwd(char *buf, size_t size);
 
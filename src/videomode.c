@@ -516,6 +516,9 @@ static void SetVideoMode(VIDEOMODE_resolution_t *res, VIDEOMODE_MODE_t display_m
 	VIDEOMODE_dest_offset_top = (res->height - VIDEOMODE_dest_height) / 2;
 	if (display_mode <= VIDEOMODE_MODE_LASTWITHHUD)
 		SetScreenVisible();
+#ifdef XEP80_EMULATION
+	XEP80_SetDisplayed(display_mode == VIDEOMODE_MODE_XEP80);
+#endif
 	PLATFORM_SetVideoMode(res, windowed, display_mode, rotate);
 }
 
@@ -92,6 +92,10 @@ static const char *PhonemeNames[65] =
 
 static int sample_rate[4] = {22050, 22050, 22050, 22050};
 
+/* Whether each phoneme's samples at each intonation are all 0, as those of
+   the pauses and STOP are */
+static UBYTE silent[0x40][4];
+
 /* converts milliseconds to a count of samples */
 static int time_to_samples(int ms)
 {
@@ -339,6 +343,32 @@ UBYTE Votrax_GetStatus(void)
 	return votraxsc01_locals.busy;
 }
 
+/* whether the phoneme the chip repeats after its buffer, and what is left
+   of the sample it is repeating, are silent */
+static int repeats_silence(void)
+{
+	int p = votraxsc01_locals.actPhoneme;
+	int n = votraxsc01_locals.actIntonation;
+	SWORD *start;
+
+	if ( PhonemeData[p].iType>=PT_VS ) {
+		p = 0x3f;
+		n = 0;
+	}
+	if ( !silent[p][n] )
+		return FALSE;
+	if ( votraxsc01_locals.iRemainingSamples==0 )
+		return TRUE;
+	start = PhonemeData[p].lpStart[n];
+	return votraxsc01_locals.pActPos>=start
+		&& votraxsc01_locals.pActPos+votraxsc01_locals.iRemainingSamples<=start+PhonemeData[p].iLength[n];
+}
+
+int Votrax_Idle(void)
+{
+	return !votraxsc01_locals.iDelay && !votraxsc01_locals.iSamplesInBuffer && repeats_silence();
+}
+
 void Votrax_Update(int num, SWORD *buffer, int length)
 {
 	int samplesToCopy;
@@ -372,6 +402,12 @@ void Votrax_Update(int num, SWORD *buffer, int length)
 					(*votraxsc01_locals.intf->BusyCallback)(votraxsc01_locals.busy);
 			}
 
+			if ( repeats_silence() ) {
+				/* all of it at once, not a sample of STOP at a time */
+				memset(buffer, 0x00, length*sizeof(SWORD));
+				break;
+			}
+
 			if ( votraxsc01_locals.iRemainingSamples==0 ) {
 				if ( PhonemeData[votraxsc01_locals.actPhoneme].iType>=PT_VS ) {
 					votraxsc01_locals.pActPos = PhonemeData[0x3f].lpStart[0];
@@ -412,7 +448,7 @@ void Votrax_Update(int num, SWORD *buffer, int length)
 
 int Votrax_Start(void *sound_interface)
 {
-	int i, buffer_size;
+	int i, j, k, buffer_size;
 	/* clear local variables */
 	memset(&votraxsc01_locals, 0x00, sizeof votraxsc01_locals);
 
@@ -433,6 +469,13 @@ int Votrax_Start(void *sound_interface)
 		if (size > buffer_size)  buffer_size = size;
 	}
 	votraxsc01_locals.lpBuffer = (SWORD*) Util_malloc(buffer_size*sizeof(SWORD));
+
+	for (i = 0; i <= 0x3f; i++) {
+		for (j = 0; j < 4; j++) {
+			for (k = 0; k < PhonemeData[i].iLength[j] && PhonemeData[i].lpStart[j][k] == 0; k++);
+			silent[i][j] = (k == PhonemeData[i].iLength[j]);
+		}
+	}
 	PrepareVoiceData(votraxsc01_locals.actPhoneme, votraxsc01_locals.actIntonation);
 	return 0;
 }
@@ -16,6 +16,8 @@ void Votrax_Stop(void);
 
 void Votrax_PutByte(UBYTE data);
 UBYTE Votrax_GetStatus(void);
+/* TRUE while the chip outputs nothing but silence until the next phoneme */
+int Votrax_Idle(void);
 
 void Votrax_Update(int num, SWORD *buffer, int length);
 int Votrax_Samples(int currentP, int nextP, int cursamples);
@@ -133,16 +133,22 @@ void VOTRAXSND_Reinit(void)
 	if (dsprate) VOTRAXSND_Init(dsprate, num_pokeys, bit16);
 }
 
+/* The resampler: the Votrax samples it has read ahead, and the position of
+   the next output sample past the first of them, in 1/2^32ths */
+static SWORD last_sample;
+static SWORD last_sample2;
+static ULONG startpos;
+static int have;
+
 /* process votrax and interpolate samples */
 static void votrax_process(SWORD *v_buffer, int len, SWORD *temp_v_buffer)
 {
-	static SWORD last_sample;
-	static SWORD last_sample2;
-	static double startpos;
-	static int have;
-	int max_left_sample_index = (int)(startpos + (double)(len - 1)*ratio);
+	/* Fixed point steps, so no sample needs a floating point conversion */
+	int step_int = (int)ratio;
+	ULONG step_frac = (ULONG)((ratio - step_int)*4294967296.0 + 0.5);
+	int max_left_sample_index = (len - 1)*step_int + (int)(((double)startpos + (double)(len - 1)*step_frac)/4294967296.0);
 	int pos = 0;
-	double fraction = 0;
+	ULONG fraction = startpos;
 	int i;
 	int floor_next_pos;
 
@@ -164,18 +170,18 @@ static void votrax_process(SWORD *v_buffer, int len, SWORD *temp_v_buffer)
 	}
 
 	for (i = 0; i < len; i++) {
-		SWORD left_sample;
-		SWORD right_sample;
-		SWORD interp_sample;
-		pos = (int)(startpos + (double)i*ratio);
-		fraction = startpos + (double)i*ratio - (double)pos;
-		left_sample = temp_v_buffer[pos];
-		right_sample = temp_v_buffer[pos+1];
-		interp_sample = (int)(left_sample + fraction*(double)(right_sample-left_sample));
-		v_buffer[i] = interp_sample;
+		int left_sample = temp_v_buffer[pos];
+		int right_sample = temp_v_buffer[pos+1];
+		/* 14 bits of the fraction, so that the sum fits in 32, truncated
+		   towards 0 */
+		v_buffer[i] = (SWORD)((left_sample*16384 + (right_sample - left_sample)*(int)(fraction >> 18))/16384);
+		pos += step_int;
+		fraction += step_frac;
+		if (fraction < step_frac)
+			pos++;
 	}
-	floor_next_pos = (int)(startpos + (double)len*ratio);
-	startpos = (startpos + (double)len*ratio) - (double)floor_next_pos;
+	floor_next_pos = pos;
+	startpos = fraction;
 	if (floor_next_pos == max_left_sample_index)
 	{
 		have = 2;
@@ -191,45 +197,39 @@ static void votrax_process(SWORD *v_buffer, int len, SWORD *temp_v_buffer)
 	}
 }
 
-/* 16 bit mixing */
+/* Whether the samples the resampler has read ahead are silent */
+static int resampler_silent(void)
+{
+	return have <= 0 || (last_sample == 0 && (have == 1 || last_sample2 == 0));
+}
+
+/* 16 bit mixing, into every num_pokeys-th sample */
 static void mix(SWORD *dst, SWORD *src, int sndn, int volume)
 {
-	SWORD s1, s2;
-	int val;
+	int step = num_pokeys;
+	int i;
 
-	while (sndn--) {
-		s1 = *src;
-		s1 = s1*volume/128;
-		s2 = *dst;
-		src++;
-		val = s1 + s2;
+	for (i = 0; i < sndn; i++) {
+		SWORD s1 = src[i]*volume/128;
+		int val = s1 + dst[i*step];
 		if (val > 32767) val = 32767;
 		if (val < -32768) val = -32768;
-		*dst++ = val;
-		if (num_pokeys == 2) {
-			dst++;
-		}
+		dst[i*step] = val;
 	}
 }
 
 /* 8 bit mixing */
 static void mix8(UBYTE *dst, SWORD *src, int sndn, int volume)
 {
-	SWORD s1, s2;
-	int val;
+	int step = num_pokeys;
+	int i;
 
-	while (sndn--) {
-		s1 = *src;
-		s1 = s1*volume/128;
-		s2 = ((int)(*dst) - 0x80)*256;
-		src++;
-		val = s1 + s2;
+	for (i = 0; i < sndn; i++) {
+		SWORD s1 = src[i]*volume/128;
+		int val = s1 + ((int)dst[i*step] - 0x80)*256;
 		if (val > 32767) val = 32767;
 		if (val < -32768) val = -32768;
-		*dst++ = (UBYTE)((val/256) + 0x80);
-		if (num_pokeys == 2) {
-			dst++;
-		}
+		dst[i*step] = (UBYTE)((val/256) + 0x80);
 	}
 }
 
@@ -261,6 +261,10 @@ void VOTRAXSND_Process(void *sndbuffer, int sndn)
 		votrax_written = FALSE;
 		Votrax_PutByte(votrax_written_byte);
 	}
+	/* Nothing to add while no phoneme sounds; the chip picks up where it
+	   was when the next one is written */
+	if (Votrax_Idle() && resampler_silent())
+		return;
 	sndn /= num_pokeys;
 	while (sndn > 0) {
 		int amount = ((sndn > VTRX_BLOCK_SIZE) ? VTRX_BLOCK_SIZE : sndn);
@@ -199,6 +199,55 @@ static void UpdateTVSystem(void)
    Functions for blitting display buffer.
    -------------------------------------- */
 
+/* The character each cell of the text screen was last drawn with, so a
+   cell whose character has not changed is not drawn again. DRAWN_NONE
+   marks cells to be drawn anyway: where the cursor was drawn, and every
+   cell once anything that changes how all characters look has changed
+   (drawn_state), or the screen was drawn in graphics mode. Cells are not
+   kept while a double width font is on, as they then depend on the cells
+   to the left. */
+#define DRAWN_NONE 0xffff
+static UWORD drawn[XEP80_HEIGHT][XEP80_LINE_LEN];
+/* Nothing is drawn while the display does not show the XEP80 */
+static int displayed = FALSE;
+static int drawn_valid = FALSE;
+static int drawn_state[8];
+
+/* Forgets what was drawn if the look of the characters has changed */
+static void CheckDrawn(void)
+{
+	int state[8];
+
+	state[0] = inverse_mode;
+	state[1] = char_set;
+	state[2] = attrib_a;
+	state[3] = attrib_b;
+	state[4] = blink_reverse;
+	state[5] = XEP80_char_height;
+	state[6] = XEP80_FONTS_oncolor;
+	state[7] = XEP80_FONTS_offcolor;
+	if (!drawn_valid || memcmp(state, drawn_state, sizeof(state)) != 0) {
+		memcpy(drawn_state, state, sizeof(state));
+		memset(drawn, 0xff, sizeof(drawn));
+		drawn_valid = TRUE;
+	}
+}
+
+/* Moves N rows of the drawn text screen from row SRC to row DST, along with
+   the line pointers, so rows that scroll need not be drawn again. */
+static void MoveRows(int dst, int src, int n)
+{
+	int row_size = XEP80_SCRN_WIDTH * XEP80_char_height;
+
+	/* Double width characters leave cells undrawn, so the rows are kept
+	   where they are, as their cells are drawn again anyway */
+	if (!displayed || graphics_mode || font_a_double || font_b_double || n <= 0)
+		return;
+	memmove(XEP80_screen_1 + dst * row_size, XEP80_screen_1 + src * row_size, n * row_size);
+	memmove(XEP80_screen_2 + dst * row_size, XEP80_screen_2 + src * row_size, n * row_size);
+	memmove(drawn[dst], drawn[src], n * sizeof(drawn[0]));
+}
+
 static void BlitChar(int x, int y, int cur)
 {
 	int screen_col;
@@ -211,12 +260,20 @@ static void BlitChar(int x, int y, int cur)
 	int last_double_cur = FALSE;
 
 	/* Don't Blit characters that aren't on the screen at the moment. */
-	if (x < xscroll || x >= xscroll + XEP80_LINE_LEN)
+	if (!displayed || x < xscroll || x >= xscroll + XEP80_LINE_LEN)
 		return;
 
 	screen_col = x-xscroll;
 	ch = char_data(y, x);
 
+	CheckDrawn();
+	if (cur || font_a_double || font_b_double)
+		drawn[y][screen_col] = DRAWN_NONE;
+	else if (drawn[y][screen_col] == ch)
+		return;
+	else
+		drawn[y][screen_col] = ch;
+
 	/* Dispaly Atari EOL's as spaces */
 	if (ch == XEP80_ATARI_EOL && ((font_a_index & XEP80_FONTS_BLK_FONT_BIT) == 0)
 	    && char_set != CHAR_SET_INTERNAL)
@@ -560,6 +617,8 @@ static void BlitGraphChar(int x, int y)
 	UBYTE ch;
 	UBYTE on, off;
 
+	if (!displayed)
+		return;
 	if (inverse_mode) {
 		on = XEP80_FONTS_offcolor;
 		off = XEP80_FONTS_oncolor;
@@ -570,6 +629,7 @@ static void BlitGraphChar(int x, int y)
 	}
 
 	ch = graph_data(y, x);
+	drawn_valid = FALSE;
 
 	to1 = &XEP80_screen_1[XEP80_SCRN_WIDTH * (y + GRAPH_Y_OFFSET)
 	                      + x * 8 + GRAPH_X_OFFSET];
@@ -592,6 +652,8 @@ static void BlitGraphScreen(void)
 {
 	int x, y;
 
+	if (!displayed)
+		return;
 	memset(XEP80_screen_1, XEP80_FONTS_offcolor, XEP80_SCRN_WIDTH*XEP80_MAX_SCRN_HEIGHT);
 	memset(XEP80_screen_2, XEP80_FONTS_offcolor, XEP80_SCRN_WIDTH*XEP80_MAX_SCRN_HEIGHT);
 	for (x=0; x<XEP80_GRAPH_WIDTH/8; x++)
@@ -724,6 +786,7 @@ static void ScrollDown(int y)
 
 	memmove(line_pointers+y+1, line_pointers+y, sizeof(UBYTE*) * (XEP80_HEIGHT-2-y));
 	line_pointers[y] = ptr;
+	MoveRows(y+1, y, XEP80_HEIGHT-2-y);
 }
 
 /* Fills line Y with EOL. */
@@ -747,6 +810,7 @@ static void ScrollScreenUp(void)
 
 	memmove(line_pointers, line_pointers+1, sizeof(UBYTE*) * (XEP80_HEIGHT-2));
 	line_pointers[XEP80_HEIGHT-2] = ptr;
+	MoveRows(0, 1, XEP80_HEIGHT-2);
 	ClearLine(XEP80_HEIGHT-2);
 }
 
@@ -1021,6 +1085,7 @@ static void DeleteLogicalLine(void)
 			UBYTE *ptr = line_pointers[ypos];
 			memmove(line_pointers+ypos, line_pointers+ypos+1, sizeof(UBYTE*) * (XEP80_HEIGHT-2-ypos));
 			line_pointers[XEP80_HEIGHT - 2] = ptr;
+			MoveRows(ypos, ypos+1, XEP80_HEIGHT-2-ypos);
 			/* Clear last line */
 			memset(ptr+xscroll, XEP80_ATARI_EOL, XEP80_LINE_LEN);
 			if (prev == XEP80_ATARI_EOL)
@@ -1634,6 +1699,50 @@ void XEP80_ChangeColors(void)
 	BlitScreen();
 }
 
+void XEP80_SetDisplayed(int value)
+{
+	if (value && !displayed) {
+		displayed = TRUE;
+		drawn_valid = FALSE;
+		/* Before the first ColdStart() there is nothing to draw */
+		if (line_pointers[0] != NULL)
+			BlitScreen();
+	}
+	displayed = value;
+}
+
+int XEP80_GetText(TEXT80_Screen *screen)
+{
+	int row, column;
+
+	if (graphics_mode)
+		return FALSE;
+	screen->card = "xep80";
+	screen->rows = XEP80_HEIGHT;
+	if (cursor_on && xpos >= xscroll && xpos < xscroll + XEP80_LINE_LEN) {
+		screen->cursor_x = xpos - xscroll;
+		screen->cursor_y = ypos;
+	}
+	else
+		screen->cursor_x = screen->cursor_y = -1;
+	for (row = 0; row < XEP80_HEIGHT; row++) {
+		for (column = 0; column < XEP80_LINE_LEN; column++) {
+			UBYTE ch = char_data(row, xscroll + column);
+			/* As BlitChar shows them */
+			int font_index = (ch & 0x80) ? font_b_index : font_a_index;
+			if (ch == XEP80_ATARI_EOL) {
+				screen->chars[row][column] = ' ';
+				screen->inverse[row][column] = FALSE;
+			}
+			else {
+				screen->chars[row][column] = ch & 0x7f;
+				screen->inverse[row][column] = (font_index & XEP80_FONTS_REV_FONT_BIT) != 0;
+			}
+		}
+	}
+	return TRUE;
+}
+
 int XEP80_ReadConfig(char *string, char *ptr)
 {
 	if (strcmp(string, "XEP80_CHARSET") == 0)
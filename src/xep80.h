@@ -3,6 +3,7 @@
 
 #include "config.h"
 #include "atari.h"
+#include "text80.h"
 
 #define XEP80_WIDTH 256
 #define XEP80_HEIGHT 25
@@ -47,6 +48,10 @@ extern UBYTE XEP80_screen_2[XEP80_SCRN_WIDTH*XEP80_MAX_SCRN_HEIGHT];
 UBYTE XEP80_GetBit(void);
 void XEP80_PutBit(UBYTE byte);
 void XEP80_ChangeColors(void);
+/* XEP80_screen_1/2 are drawn only while the display shows them; the whole
+   screen is drawn when it starts to */
+void XEP80_SetDisplayed(int displayed);
+int XEP80_GetText(TEXT80_Screen *screen);
 void XEP80_StateSave(void);
 void XEP80_StateRead(void);
 int XEP80_ReadConfig(char *string, char *ptr);
@@ -0,0 +1,116 @@
+/*
+ * gen_poly.c - generate the POKEY polynomial counter tables
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+/* The polynomial counters of both sound engines and of RANDOM are fixed
+   bit sequences. They are compiled in as constant data, so they are shared
+   between processes and cost nothing at startup; this program writes them:
+
+     gen_poly pokey > src/gen-pokey-poly.h      (pokey.c, pokeysnd.c)
+     gen_poly mz > src/gen-mzpokey-poly.h       (mzpokeysnd.c)
+
+   The sequences are the ones pokey.c and mzpokeysnd.c used to build at
+   run time. */
+
+#include <stdio.h>
+#include <string.h>
+
+static void print_table(const char *decl, const unsigned char *data, int size)
+{
+	int i;
+	printf("%s[%d] = {", decl, size);
+	for (i = 0; i < size; i++)
+		printf("%s0x%02x%s", i % 16 == 0 ? "\n\t" : "", data[i], i + 1 < size ? "," : "");
+	printf("\n};\n\n");
+}
+
+static void header(const char *target)
+{
+	printf("/* Generated by tools/gen_poly.c (gen_poly %s) - do not edit. */\n\n", target);
+}
+
+/* RANDOM and the pokeysnd.c engine: the 9-bit polynomial, one value per
+   step, and the 17-bit one as the bytes RANDOM shows, 8 steps apart */
+static void gen_pokey(void)
+{
+	static unsigned char poly9[511];
+	static unsigned char poly17[16385];
+	unsigned long reg;
+	int i;
+
+	reg = 0x1ff;
+	for (i = 0; i < 511; i++) {
+		reg = ((((reg >> 5) ^ reg) & 1) << 8) + (reg >> 1);
+		poly9[i] = (unsigned char) reg;
+	}
+	reg = 0x1ffff;
+	for (i = 0; i < 16385; i++) {
+		reg = ((((reg >> 5) ^ reg) & 0xff) << 9) + (reg >> 8);
+		poly17[i] = (unsigned char) (reg >> 1);
+	}
+
+	header("pokey");
+	print_table("UBYTE const POKEY_poly9_lookup", poly9, sizeof(poly9));
+	print_table("UBYTE const POKEY_poly17_lookup", poly17, sizeof(poly17));
+}
+
+/* The mzpokeysnd.c engine reads one bit per step: the 4- and 5-bit
+   polynomials inverted, one bit per byte, the 9-bit one likewise and the
+   17-bit one packed 8 steps per byte, lowest bit first */
+static void gen_mz(void)
+{
+	static unsigned char poly4[15];
+	static unsigned char poly5[31];
+	static unsigned char poly9[511];
+	static unsigned char poly17[(131071 + 7) / 8];
+	unsigned int reg, c;
+	int i;
+
+	reg = 1;
+	for (i = 0; i < 15; i++) {
+		poly4[i] = ~reg & 1;
+		c = ((reg >> 2) ^ (reg >> 3)) & 1;
+		reg = ((reg << 1) & 15) + c;
+	}
+	reg = 1;
+	for (i = 0; i < 31; i++) {
+		poly5[i] = ~reg & 1;
+		c = ((reg >> 2) ^ (reg >> 4)) & 1;
+		reg = ((reg << 1) & 31) + c;
+	}
+	reg = 1;
+	for (i = 0; i < 511; i++) {
+		poly9[i] = reg & 1;
+		c = ((reg >> 3) ^ (reg >> 8)) & 1;
+		reg = ((reg << 1) & 511) + c;
+	}
+	reg = 1;
+	memset(poly17, 0, sizeof(poly17));
+	for (i = 0; i < 131071; i++) {
+		poly17[i >> 3] |= (reg & 1) << (i & 7);
+		c = ((reg >> 11) ^ (reg >> 16)) & 1;
+		reg = ((reg << 1) & 131071) + c;
+	}
+
+	header("mz");
+	print_table("static const unsigned char poly4tbl", poly4, sizeof(poly4));
+	print_table("static const unsigned char poly5tbl", poly5, sizeof(poly5));
+	print_table("static const unsigned char poly9tbl", poly9, sizeof(poly9));
+	print_table("static const unsigned char poly17bits", poly17, sizeof(poly17));
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc == 2 && strcmp(argv[1], "pokey") == 0)
+		gen_pokey();
+	else if (argc == 2 && strcmp(argv[1], "mz") == 0)
+		gen_mz();
+	else {
+		fprintf(stderr, "Usage: %s pokey|mz\n", argv[0]);
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,202 @@
+/*
+ * pokeyrender.c - render a Pokey event log to a WAV file
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+/* Reads a log written with -pokeyrec-events (the format is described in
+   src/pokeyrec.h) and plays it through the emulator's sound engines, each
+   write at its cycle and a frame of samples at each frame mark, as the
+   emulator would have. The result matches what the emulator played at the
+   same settings, but can be rendered at any rate or sample size, with
+   either engine, without running the machine again. */
+
+#include "config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "atari.h"
+#include "antic.h"
+#include "gtia.h"
+#include "pokey.h"
+#include "pokeyrec.h"
+#include "pokeysnd.h"
+
+#define HEADER_SIZE 16
+
+/* The WAV file */
+
+static FILE *out;
+static unsigned long data_bytes = 0;
+
+static void put_le(unsigned char *p, unsigned long value, int bytes)
+{
+	while (bytes-- > 0) {
+		*p++ = (unsigned char) (value & 0xff);
+		value >>= 8;
+	}
+}
+
+static void write_wav_header(int rate, int channels, int sample_size)
+{
+	unsigned char header[44];
+	memcpy(header, "RIFF", 4);
+	put_le(header + 4, 36 + data_bytes, 4);
+	memcpy(header + 8, "WAVEfmt ", 8);
+	put_le(header + 16, 16, 4);
+	put_le(header + 20, 1, 2);
+	put_le(header + 22, channels, 2);
+	put_le(header + 24, rate, 4);
+	put_le(header + 28, (unsigned long) rate * channels * sample_size, 4);
+	put_le(header + 32, channels * sample_size, 2);
+	put_le(header + 34, sample_size * 8, 2);
+	memcpy(header + 36, "data", 4);
+	put_le(header + 40, data_bytes, 4);
+	fwrite(header, 1, sizeof(header), out);
+}
+
+/* Render up to the current cycle and write out the samples */
+static void write_frame(int sample_size)
+{
+	int n = POKEYSND_UpdateProcessBuffer();
+	if (sample_size == 2) {
+		/* WAV is little-endian */
+		UBYTE *p = POKEYSND_process_buffer;
+		int i;
+		for (i = 0; i < n; i++, p += 2) {
+			UWORD value = *(UWORD *) p;
+			p[0] = (UBYTE) (value & 0xff);
+			p[1] = (UBYTE) (value >> 8);
+		}
+	}
+	fwrite(POKEYSND_process_buffer, sample_size, n, out);
+	data_bytes += (unsigned long) n * sample_size;
+}
+
+static void usage(void)
+{
+	fprintf(stderr, "usage: pokeyrender [-r rate] [-8] [-rf] [-no-console] events output.wav\n");
+}
+
+int main(int argc, char **argv)
+{
+	FILE *in;
+	unsigned char header[HEADER_SIZE];
+	int rate = 44100;
+	int sample_size = 2;
+	int console = 1;
+	int pokeys;
+	unsigned long freq17;
+	unsigned int clock = 0;
+	unsigned int frame_start = 0;
+	unsigned int frame_ticks;
+	int i = 1;
+	int c;
+
+	for (; i < argc && argv[i][0] == '-'; i++) {
+		if (strcmp(argv[i], "-r") == 0 && i + 1 < argc)
+			rate = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-8") == 0)
+			sample_size = 1;
+		else if (strcmp(argv[i], "-rf") == 0)
+			POKEYSND_enable_new_pokey = 0;
+		else if (strcmp(argv[i], "-no-console") == 0)
+			console = 0;
+		else {
+			usage();
+			return 2;
+		}
+	}
+	if (argc - i != 2 || rate < 1000) {
+		usage();
+		return 2;
+	}
+	in = fopen(argv[i], "rb");
+	if (in == NULL) {
+		perror(argv[i]);
+		return 2;
+	}
+	if (fread(header, 1, HEADER_SIZE, in) != HEADER_SIZE || memcmp(header, "PKEV", 4) != 0) {
+		fprintf(stderr, "%s: not a Pokey event log\n", argv[i]);
+		return 2;
+	}
+	pokeys = header[5];
+	Atari800_tv_mode = header[6] + (header[7] << 8);
+	freq17 = header[8] + (header[9] << 8) + ((unsigned long) header[10] << 16) + ((unsigned long) header[11] << 24);
+	if (header[4] != POKEYREC_EVENT_VERSION || pokeys < 1 || pokeys > POKEY_MAXPOKEYS
+	    || (Atari800_tv_mode != Atari800_TV_PAL && Atari800_tv_mode != Atari800_TV_NTSC)) {
+		fprintf(stderr, "%s: unknown Pokey event log version\n", argv[i]);
+		return 2;
+	}
+	out = fopen(argv[i + 1], "wb");
+	if (out == NULL) {
+		perror(argv[i + 1]);
+		return 2;
+	}
+	write_wav_header(rate, pokeys, sample_size);
+
+#ifdef STEREO_SOUND
+	POKEYSND_stereo_enabled = pokeys > 1;
+#endif
+	POKEYSND_Init(freq17, rate, (UBYTE) pokeys, sample_size == 2 ? POKEYSND_BIT16 : 0);
+	frame_ticks = Atari800_tv_mode * ANTIC_LINE_C;
+
+	while ((c = getc(in)) != EOF) {
+		unsigned int delta = 0;
+		int shift = 0;
+		int reg, value, chip;
+		while (c & 0x80) {
+			delta |= (unsigned int) (c & 0x7f) << shift;
+			shift += 7;
+			if ((c = getc(in)) == EOF)
+				break;
+		}
+		delta |= (unsigned int) c << shift;
+		reg = getc(in);
+		value = getc(in);
+		if (c == EOF || value == EOF)
+			break;
+		chip = reg >> 5;
+		reg &= 0x1f;
+		clock += delta;
+
+		/* A gap without frame marks is rendered frame by frame, so the
+		   engines' buffer does not overflow. Frames run a few cycles
+		   over at times. */
+		while (clock - frame_start > frame_ticks + frame_ticks / 2) {
+			frame_start += frame_ticks;
+			ANTIC_screenline_cpu_clock = frame_start;
+			write_frame(sample_size);
+		}
+		ANTIC_screenline_cpu_clock = clock;
+
+		if (reg == POKEYREC_EVENT_END)
+			break;
+		if (reg == POKEYREC_EVENT_FRAME) {
+			write_frame(sample_size);
+			frame_start = clock;
+		}
+		else if (reg == POKEYREC_EVENT_SPEAKER) {
+#ifdef CONSOLE_SOUND
+			if (console) {
+				GTIA_speaker = value;
+				POKEYSND_UpdateConsol(1);
+			}
+#endif
+		}
+		else if (reg < POKEY_OFFSET_POKEY2 && chip < pokeys)
+			POKEYSND_Update((UWORD) reg, (UBYTE) value, (UBYTE) chip, 4);
+	}
+	write_frame(sample_size);
+	fclose(in);
+
+	if (fseek(out, 0, SEEK_SET) == 0)
+		write_wav_header(rate, pokeys, sample_size);
+	if (fclose(out) != 0) {
+		perror(argv[i + 1]);
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,95 @@
+/*
+ * sound_host.c - what the POKEY sound engines need from the emulator
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+/* pokeysnd.c and mzpokeysnd.c read the CPU clock, the TV mode, the
+   console speaker and a few POKEY registers, and call logging, memory
+   and recording functions. Tools that drive the engines on their own
+   (pokeyrender, pokeybench) link this instead of the emulator: the clock
+   is whatever the tool sets ANTIC_screenline_cpu_clock to. */
+
+#include "config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+
+#include "atari.h"
+#include "antic.h"
+#include "gtia.h"
+#include "pokey.h"
+#include "log.h"
+#include "util.h"
+#ifdef AUDIO_RECORDING
+#include "file_export.h"
+#endif
+#if defined(PBI_XLD) || defined(VOICEBOX)
+#include "votraxsnd.h"
+#endif
+
+unsigned int ANTIC_screenline_cpu_clock = 0;
+int ANTIC_xpos = 0;
+#ifdef NEW_CYCLE_EXACT
+int ANTIC_cur_screen_pos = ANTIC_NOT_DRAWING;
+const int *ANTIC_cpu2antic_ptr = NULL;
+#endif
+int Atari800_tv_mode = Atari800_TV_PAL;
+int GTIA_speaker = 0;
+UBYTE POKEY_AUDF[4 * POKEY_MAXPOKEYS];
+UBYTE POKEY_AUDC[4 * POKEY_MAXPOKEYS];
+UBYTE POKEY_AUDCTL[POKEY_MAXPOKEYS];
+int POKEY_Base_mult[POKEY_MAXPOKEYS];
+#include "gen-pokey-poly.h"
+
+void Log_print(const char *format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	vfprintf(stderr, format, args);
+	va_end(args);
+	fputc('\n', stderr);
+}
+
+void *Util_malloc(size_t size)
+{
+	void *ptr = malloc(size);
+	if (ptr == NULL) {
+		fprintf(stderr, "Out of memory\n");
+		exit(1);
+	}
+	return ptr;
+}
+
+void *Util_realloc(void *ptr, size_t size)
+{
+	ptr = realloc(ptr, size);
+	if (ptr == NULL) {
+		fprintf(stderr, "Out of memory\n");
+		exit(1);
+	}
+	return ptr;
+}
+
+#ifdef AUDIO_RECORDING
+int File_Export_StopRecording(void)
+{
+	return 0;
+}
+
+int File_Export_WriteAudio(const UBYTE *samples, int num_samples)
+{
+	return 0;
+}
+#endif
+
+#if defined(PBI_XLD) || defined(VOICEBOX)
+void VOTRAXSND_Init(int playback_freq, int n_pokeys, int b16)
+{
+}
+
+void VOTRAXSND_Process(void *sndbuffer, int sndn)
+{
+}
+#endif
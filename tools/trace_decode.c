@@ -0,0 +1,179 @@
+/*
+ * trace_decode.c - print a binary trace written by the AI interface
+ *
+ * Copyright (c) 2026 - AI Interface Extension
+ * Licensed under GPL-2.0-or-later
+ */
+
+/* Reads a trace from trace_start, -ai-trace or the monitor's BTRACE (the
+   format is described in src/ai_trace.h) and prints it as the monitor's
+   TRACE command would have, one line per instruction, so that traces of
+   two runs can be compared with diff. -c starts each line with the CPU
+   cycle. */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define HEADER_SIZE 16
+#define RECORD_SIZE 16
+
+/* The table of the monitor's disassembler */
+
+static const char mnemonics[256][10] = {
+	"BRK", "ORA (1,X)", "CIM", "ASO (1,X)", "NOP 1", "ORA 1", "ASL 1", "ASO 1",
+	"PHP", "ORA #1", "ASL", "ANC #1", "NOP 2", "ORA 2", "ASL 2", "ASO 2",
+
+	"BPL 0", "ORA (1),Y", "CIM", "ASO (1),Y", "NOP 1,X", "ORA 1,X", "ASL 1,X", "ASO 1,X",
+	"CLC", "ORA 2,Y", "NOP !", "ASO 2,Y", "NOP 2,X", "ORA 2,X", "ASL 2,X", "ASO 2,X",
+
+	"JSR 2", "AND (1,X)", "CIM", "RLA (1,X)", "BIT 1", "AND 1", "ROL 1", "RLA 1",
+	"PLP", "AND #1", "ROL", "ANC #1", "BIT 2", "AND 2", "ROL 2", "RLA 2",
+
+	"BMI 0", "AND (1),Y", "CIM", "RLA (1),Y", "NOP 1,X", "AND 1,X", "ROL 1,X", "RLA 1,X",
+	"SEC", "AND 2,Y", "NOP !", "RLA 2,Y", "NOP 2,X", "AND 2,X", "ROL 2,X", "RLA 2,X",
+
+
+	"RTI", "EOR (1,X)", "CIM", "LSE (1,X)", "NOP 1", "EOR 1", "LSR 1", "LSE 1",
+	"PHA", "EOR #1", "LSR", "ALR #1", "JMP 2", "EOR 2", "LSR 2", "LSE 2",
+
+	"BVC 0", "EOR (1),Y", "CIM", "LSE (1),Y", "NOP 1,X", "EOR 1,X", "LSR 1,X", "LSE 1,X",
+	"CLI", "EOR 2,Y", "NOP !", "LSE 2,Y", "NOP 2,X", "EOR 2,X", "LSR 2,X", "LSE 2,X",
+
+	"RTS", "ADC (1,X)", "CIM", "RRA (1,X)", "NOP 1", "ADC 1", "ROR 1", "RRA 1",
+	"PLA", "ADC #1", "ROR", "ARR #1", "JMP (2)", "ADC 2", "ROR 2", "RRA 2",
+
+	"BVS 0", "ADC (1),Y", "CIM", "RRA (1),Y", "NOP 1,X", "ADC 1,X", "ROR 1,X", "RRA 1,X",
+	"SEI", "ADC 2,Y", "NOP !", "RRA 2,Y", "NOP 2,X", "ADC 2,X", "ROR 2,X", "RRA 2,X",
+
+
+	"NOP #1", "STA (1,X)", "NOP #1", "SAX (1,X)", "STY 1", "STA 1", "STX 1", "SAX 1",
+	"DEY", "NOP #1", "TXA", "ANE #1", "STY 2", "STA 2", "STX 2", "SAX 2",
+
+	"BCC 0", "STA (1),Y", "CIM", "SHA (1),Y", "STY 1,X", "STA 1,X", "STX 1,Y", "SAX 1,Y",
+	"TYA", "STA 2,Y", "TXS", "SHS 2,Y", "SHY 2,X", "STA 2,X", "SHX 2,Y", "SHA 2,Y",
+
+	"LDY #1", "LDA (1,X)", "LDX #1", "LAX (1,X)", "LDY 1", "LDA 1", "LDX 1", "LAX 1",
+	"TAY", "LDA #1", "TAX", "ANX #1", "LDY 2", "LDA 2", "LDX 2", "LAX 2",
+
+	"BCS 0", "LDA (1),Y", "CIM", "LAX (1),Y", "LDY 1,X", "LDA 1,X", "LDX 1,Y", "LAX 1,X",
+	"CLV", "LDA 2,Y", "TSX", "LAS 2,Y", "LDY 2,X", "LDA 2,X", "LDX 2,Y", "LAX 2,Y",
+
+
+	"CPY #1", "CMP (1,X)", "NOP #1", "DCM (1,X)", "CPY 1", "CMP 1", "DEC 1", "DCM 1",
+	"INY", "CMP #1", "DEX", "SBX #1", "CPY 2", "CMP 2", "DEC 2", "DCM 2",
+
+	"BNE 0", "CMP (1),Y", "ESCRTS #1", "DCM (1),Y", "NOP 1,X", "CMP 1,X", "DEC 1,X", "DCM 1,X",
+	"CLD", "CMP 2,Y", "NOP !", "DCM 2,Y", "NOP 2,X", "CMP 2,X", "DEC 2,X", "DCM 2,X",
+
+
+	"CPX #1", "SBC (1,X)", "NOP #1", "INS (1,X)", "CPX 1", "SBC 1", "INC 1", "INS 1",
+	"INX", "SBC #1", "NOP", "SBC #1 !", "CPX 2", "SBC 2", "INC 2", "INS 2",
+
+	"BEQ 0", "SBC (1),Y", "ESCAPE #1", "INS (1),Y", "NOP 1,X", "SBC 1,X", "INC 1,X", "INS 1,X",
+	"SED", "SBC 2,Y", "NOP !", "INS 2,Y", "NOP 2,X", "SBC 2,X", "INC 2,X", "INS 2,X"
+};
+
+static void usage(void)
+{
+	fprintf(stderr, "usage: trace_decode [-c] trace [output]\n");
+}
+
+/* Print the instruction as the monitor's disassembler does */
+static void show_instruction(FILE *fp, const unsigned char *rec)
+{
+	unsigned int pc = rec[0] + (rec[1] << 8);
+	unsigned int insn = rec[2];
+	const char *mnemonic = mnemonics[insn];
+	const char *p;
+
+	for (p = mnemonic + 3; *p != '\0'; p++) {
+		if (*p == '1') {
+			fprintf(fp, "%04X: %02X %02X     %.*s$%02X%s\n",
+			        pc, insn, rec[3], (int) (p - mnemonic), mnemonic, rec[3], p + 1);
+			return;
+		}
+		if (*p == '2') {
+			unsigned int value = rec[3] + (rec[4] << 8);
+			fprintf(fp, "%04X: %02X %02X %02X  %.*s$%04X%s\n",
+			        pc, insn, rec[3], rec[4], (int) (p - mnemonic), mnemonic, value, p + 1);
+			return;
+		}
+		if (*p == '0') {
+			unsigned int target = (pc + 2 + (signed char) rec[3]) & 0xffff;
+			fprintf(fp, "%04X: %02X %02X     %.4s$%04X\n", pc, insn, rec[3], mnemonic, target);
+			return;
+		}
+	}
+	fprintf(fp, "%04X: %02X        %s\n", pc, insn, mnemonic);
+}
+
+int main(int argc, char **argv)
+{
+	FILE *in;
+	FILE *out = stdout;
+	unsigned char header[HEADER_SIZE];
+	unsigned char rec[RECORD_SIZE];
+	int cycles = 0;
+	int record_size;
+	int i = 1;
+	uint64_t high = 0;
+	unsigned long last = 0;
+	unsigned long count = 0;
+
+	if (i < argc && strcmp(argv[i], "-c") == 0) {
+		cycles = 1;
+		i++;
+	}
+	if (i >= argc || argc - i > 2) {
+		usage();
+		return 2;
+	}
+	in = fopen(argv[i], "rb");
+	if (in == NULL) {
+		perror(argv[i]);
+		return 2;
+	}
+	if (fread(header, 1, HEADER_SIZE, in) != HEADER_SIZE || memcmp(header, "A8TRACE", 8) != 0) {
+		fprintf(stderr, "%s: not a trace file\n", argv[i]);
+		return 2;
+	}
+	record_size = header[10] + (header[11] << 8);
+	if (header[8] + (header[9] << 8) != 1 || record_size < RECORD_SIZE) {
+		fprintf(stderr, "%s: unknown trace version\n", argv[i]);
+		return 2;
+	}
+	if (argc - i == 2) {
+		out = fopen(argv[i + 1], "w");
+		if (out == NULL) {
+			perror(argv[i + 1]);
+			return 2;
+		}
+	}
+
+	while (fread(rec, 1, RECORD_SIZE, in) == RECORD_SIZE) {
+		unsigned long clock = rec[12] + (rec[13] << 8) + ((unsigned long) rec[14] << 16) + ((unsigned long) (rec[15] & 0x7f) << 24);
+		unsigned int ypos = rec[11] + ((rec[15] & 0x80) << 1);
+		unsigned int p = rec[8];
+		if (record_size > RECORD_SIZE && fseek(in, record_size - RECORD_SIZE, SEEK_CUR) != 0)
+			break;
+		/* The cycle is kept in 31 bits and only goes forward */
+		if (count++ > 0 && clock < last)
+			high += 0x80000000UL;
+		last = clock;
+		if (cycles)
+			fprintf(out, "%12llu ", (unsigned long long) (high + clock));
+		fprintf(out, "%3u %3u A=%02X X=%02X Y=%02X S=%02X P=%c%c*-%c%c%c%c PC=",
+			ypos, rec[10], rec[5], rec[6], rec[7], rec[9],
+			(p & 0x80) ? 'N' : '-', (p & 0x40) ? 'V' : '-', (p & 0x08) ? 'D' : '-',
+			(p & 0x04) ? 'I' : '-', (p & 0x02) ? 'Z' : '-', (p & 0x01) ? 'C' : '-');
+		show_instruction(out, rec);
+	}
+	fclose(in);
+	if (out != stdout && fclose(out) != 0) {
+		perror(argv[i + 1]);
+		return 1;
+	}
+	return 0;
+}
@@ -307,7 +307,6 @@ $target ||= $test_settings->{'target'};
 $cflags ||= exists($test_settings->{'cflags'})
           ? $default_cflags . ' ' . $test_settings->{'cflags'}
 		  : $default_cflags;
-$cflags .= ' -D BENCHMARK=' . $frames;
 $ENV{'CFLAGS'} = $cflags;
 print "Using CFLAGS: $cflags\n";
 print OUT "CFLAGS=$cflags\n";
@@ -336,11 +335,12 @@ for my $config (@configs) {
 		else {
 			die "$program does not exist\n";
 		}
-		my $result = pipe_command('./atari800', '-config', 'benchmark/atari800.cfg', $program);
+		my $result = pipe_command('./atari800', '-config', 'benchmark/atari800.cfg',
+			'-benchmark', '-benchmark-only', 'boot', '-benchmark-frames', $frames, $program);
 		print $result;
 		# parse result
-		$result =~ /\d+ frames emulated in ([0-9.]+) seconds/
-			or die "Expected 'frames emulated in'\n";
+		$result =~ /"seconds": ([0-9.]+)/
+			or die "Expected a benchmark report\n";
 		my $speed_msg = "$1 seconds";
 		# avoid division by zero
 		if ($1 != 0) {
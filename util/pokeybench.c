@@ -3,7 +3,7 @@
  *  Atari800  Atari 800XL, etc. emulator                                     *
  *  ----------------------------------------------------------------------   *
  *  POKEY Chip Emulator,                                                     *
- *  "POKEYBENCH" Test and benchmark program for developers, V1.3             *
+ *  "POKEYBENCH" Test and benchmark program for developers, V2.0             *
  *  by Michael Borisov                                                       *
  *                                                                           *
  *****************************************************************************/
@@ -32,345 +32,154 @@
  *                                                                           *
  *****************************************************************************/
 
-#include "pokeysnd.h"
-#include "mzpokeysnd.h"
-
+/* Runs the sound engines over a fixed script of register writes - tones,
+   the polynomial distortions, 1.79 MHz and joined channels, high-pass
+   filters, 15 kHz clock, volume-only sample playback and silence - in
+   every configuration: the Ron Fries engine with and without the high
+   frequency fix and the MZ engine, 1 and 2 POKEYs, 8- and 16-bit output.
+   For each it prints the samples generated per second of CPU time and a
+   checksum of the output, so speed regressions and changes to the output
+   show up. The MZ engine dithers with rand(), which is seeded the same for
+   every run. Built and run from tools/ with "make bench-pokey". */
+
+#include "config.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <ctype.h>
 #include <time.h>
-#include <math.h>
-
-/* How many seconds of sound to generate per each test trial */
-#define MZM_TRIAL_TIME 2
 
-/* How many samples per each buffer run */
-#define MZM_BUF_SAMPLES 100
-
-/* How many test trials to run for statistics */
-#define TEST_TRIALS 5
+#include "atari.h"
+#include "antic.h"
+#include "pokey.h"
+#include "pokeysnd.h"
 
-/* How many seconds of sound to save in the outfile */
-#define MZM_SAVE_TIME 10
+#define SCRIPT_PATTERNS 8
+#define PATTERN_FRAMES 50
 
+static unsigned long checksum;
 
-/* Wrapper for fgets, removes trailing whitespace */
-char* fgetl(char* s, int len, FILE* fs)
+/* FNV-1a */
+static void add_to_checksum(const UBYTE *data, int len)
 {
-    char* s2;
-    int i;
-
-    s2 = fgets(s,len,fs);
-    if(s2 == NULL)
-        return s2;
-    for(i=strlen(s)-1; i>=0; i--)
-        if(isspace(s[i]))
-            s[i] = '\0';
-    return s2;
+	int i;
+	for (i = 0; i < len; i++) {
+		checksum ^= data[i];
+		checksum = (checksum * 16777619UL) & 0xffffffffUL;
+	}
 }
 
-int pktest(unsigned char *audf, unsigned char *audc, unsigned char audctl,
-           const char* ofn8, const char* ofn16,
-           unsigned short samplerate)
+static void put(int cycle, int reg, int value, int chip)
 {
-    unsigned char* buf;
-    short* buf16;
-    double rate;
-    double rasum;
-    double rasum2;
-    double varian;
-    double stddev;
-    unsigned long samremain, samproc;
-    int i;
-    time_t start,finish;
-    FILE* ft;
-
-    buf = malloc(MZM_BUF_SAMPLES);
-    if(buf == NULL)
-    {
-        printf("Out of memory\n");
-        return 1;
-    }
-
-    if(i=Pokey_sound_init(1790000,samplerate,1,0,1))
-    {
-        printf("Error initializing Pokey sound: %d\n",i);
-        return 1;
-    }
-
-    Update_pokey_sound(_AUDF1,audf[0],0,1);
-    Update_pokey_sound(_AUDC1,audc[0],0,1);
-    Update_pokey_sound(_AUDF2,audf[1],0,1);
-    Update_pokey_sound(_AUDC2,audc[1],0,1);
-    Update_pokey_sound(_AUDF3,audf[2],0,1);
-    Update_pokey_sound(_AUDC3,audc[2],0,1);
-    Update_pokey_sound(_AUDF4,audf[3],0,1);
-    Update_pokey_sound(_AUDC4,audc[3],0,1);
-    Update_pokey_sound(_AUDCTL,audctl,0,1);
-    Pokey_debugreset(0);
-    
-
-    rasum = 0.0;
-    rasum2 = 0.0;
-
-    for(i=0; i<TEST_TRIALS; i++)
-    {
-        rate = 0.0;
-        /* Wait for a change in system time (seconds)
-            to ensure start when a full second begins */
-        time(&start);
-        do
-        {
-            time(&finish);
-        } while(difftime(finish,start) == 0.0);
-
-        start = finish; /* Test start time */
-        /* Generate until test time elapses */
-        do
-        {
-            Pokey_process(buf,MZM_BUF_SAMPLES);
-            rate += MZM_BUF_SAMPLES;
-            time(&finish);
-        } while(difftime(finish,start) < MZM_TRIAL_TIME);
-
-        rate /= MZM_TRIAL_TIME;
-
-        printf("Trial %2d:  %10.0f samples/sec\n",
-            i+1, rate);
-        fflush(stdout);
-        rasum += rate;
-        rasum2 += rate*rate;
-    }
-
-    printf("\nAverage %10.0f samples/sec\n",rasum/TEST_TRIALS);
-
-    varian = (rasum2 - rasum*rasum/TEST_TRIALS)/(TEST_TRIALS-1);
-    stddev = sqrt(varian);
-
-    printf("Standard deviation: %10.0f samples/sec\n",stddev);
-
-    printf("Gen/play ratio = %3.1f\n",rasum/TEST_TRIALS/samplerate);
-
-    /* And now, write 8-bit output file */
-
-    if(i=Pokey_sound_init(1790000,samplerate,1,0,1))
-    {
-        printf("Error initializing Pokey sound: %d\n",i);
-        free(buf);
-        return 1;
-    }
-    Update_pokey_sound(_AUDF1,audf[0],0,1);
-    Update_pokey_sound(_AUDC1,audc[0],0,1);
-    Update_pokey_sound(_AUDF2,audf[1],0,1);
-    Update_pokey_sound(_AUDC2,audc[1],0,1);
-    Update_pokey_sound(_AUDF3,audf[2],0,1);
-    Update_pokey_sound(_AUDC3,audc[2],0,1);
-    Update_pokey_sound(_AUDF4,audf[3],0,1);
-    Update_pokey_sound(_AUDC4,audc[3],0,1);
-    Update_pokey_sound(_AUDCTL,audctl,0,1);
-    Pokey_debugreset(0);
-
-    if(!(ft=fopen(ofn8,"wb")))
-    {
-        perror(ofn8);
-        free(buf);
-        return 2;
-    }
-
-    samremain = samplerate*MZM_SAVE_TIME;
-    while(samremain>0)
-    {
-        if(samremain>=MZM_BUF_SAMPLES)
-        {
-            samproc = MZM_BUF_SAMPLES;
-        }
-        else
-        {
-            samproc = samremain;
-        }
-        Pokey_process(buf,(unsigned short)samproc);
-        i = fwrite(buf,1,samproc,ft);
-        if(i<samproc)
-        {
-            perror(ofn8);
-            free(buf);
-            fclose(ft);
-            return 2;
-        }
-        samremain -= samproc;
-    }
-
-    free(buf);
-    fclose(ft);
-
-    /* Write 16-bit output file */
-
-    if(i=Pokey_sound_init(1790000,samplerate,1,SND_BIT16,1))
-    {
-        printf("Error initializing Pokey sound: %d\n",i);
-        return 1;
-    }
-    Update_pokey_sound(_AUDF1,audf[0],0,1);
-    Update_pokey_sound(_AUDC1,audc[0],0,1);
-    Update_pokey_sound(_AUDF2,audf[1],0,1);
-    Update_pokey_sound(_AUDC2,audc[1],0,1);
-    Update_pokey_sound(_AUDF3,audf[2],0,1);
-    Update_pokey_sound(_AUDC3,audc[2],0,1);
-    Update_pokey_sound(_AUDF4,audf[3],0,1);
-    Update_pokey_sound(_AUDC4,audc[3],0,1);
-    Update_pokey_sound(_AUDCTL,audctl,0,1);
-    Pokey_debugreset(0);
-
-
-    buf16 = malloc(2*MZM_BUF_SAMPLES);
-    if(buf16 == NULL)
-    {
-        printf("Out of memory\n");
-        return 1;
-    }
-
-    if(!(ft=fopen(ofn16,"wb")))
-    {
-        perror(ofn16);
-        free(buf16);
-        return 2;
-    }
-
-    samremain = samplerate*MZM_SAVE_TIME;
-    while(samremain>0)
-    {
-        if(samremain>=MZM_BUF_SAMPLES)
-        {
-            samproc = MZM_BUF_SAMPLES;
-        }
-        else
-        {
-            samproc = samremain;
-        }
-        Pokey_process(buf16,(unsigned short)samproc);
-        i = fwrite(buf16,2,samproc,ft);
-        if(i<samproc)
-        {
-            perror(ofn16);
-            free(buf16);
-            fclose(ft);
-            return 2;
-        }
-        samremain -= samproc;
-    }
-
-    free(buf16);
-    fclose(ft);
-
-    return 0;
+	ANTIC_screenline_cpu_clock = cycle;
+	POKEYSND_Update((UWORD) reg, (UBYTE) value, (UBYTE) chip, 4);
 }
 
-int main(int argc, char* argv[])
+/* The writes of one frame of the script, in cycle order */
+static void script_frame(unsigned int start, int frame, int pokeys)
 {
-    char paramfn[256];
-    char ofn8[256];
-    char ofn16[256];
-    FILE* fs;
-    unsigned int params[10];
-    unsigned char audf[4];
-    unsigned char audc[4];
-    unsigned int tmp;
-    int i;
-    int ecode;
-
-    printf("PokeyBench (c) 2002 by Michael Borisov\n\n");
-
-    /* Get command-line parameters */
-    if(argc<2)
-    {
-        printf("Enter parameter file name: ");
-        fflush(stdout);
-        if(fgetl(paramfn,256,stdin) == NULL)
-        {
-            printf("Bad input\n");
-            return 1;
-        }
-    }
-    else
-    {
-        strncpy(paramfn,argv[1],255);
-        paramfn[255] = '\0';
-    }
-
-    if(argc<3)
-    {
-        printf("Enter output file name (8-bit): ");
-        fflush(stdout);
-        if(fgetl(ofn8,256,stdin) == NULL)
-        {
-            printf("Bad input\n");
-            return 1;
-        }
-    }
-    else
-    {
-        strncpy(ofn8,argv[2],255);
-        ofn8[255] = '\0';
-    }
-
-    if(argc<4)
-    {
-        printf("Enter output file name (16-bit): ");
-        fflush(stdout);
-        if(fgetl(ofn16,256,stdin) == NULL)
-        {
-            printf("Bad input\n");
-            return 1;
-        }
-    }
-    else
-    {
-        strncpy(ofn16,argv[3],255);
-        ofn16[255] = '\0';
-    }
-
+	static const UBYTE audctl[SCRIPT_PATTERNS] = {
+		0x00, 0x00, 0x60, 0x78, 0x06, 0x81, 0x00, 0x00
+	};
+	static const UBYTE dist[4] = { 0xa0, 0x20, 0x40, 0xc0 };
+	int step = frame % PATTERN_FRAMES;
+	int line, chip, ch;
+
+	for (line = 0; line < Atari800_tv_mode; line += 2) {
+		for (chip = 0; chip < pokeys; chip++) {
+			int pattern = (frame / PATTERN_FRAMES + chip * 3) % SCRIPT_PATTERNS;
+			unsigned int cycle = start + line * ANTIC_LINE_C + chip * 40;
+			if (line == 0 && step == 0) {
+				put(cycle, POKEY_OFFSET_AUDCTL, audctl[pattern], chip);
+				put(cycle, POKEY_OFFSET_SKCTL, 3, chip);
+			}
+			if (pattern == 6)
+				/* Volume-only samples */
+				put(cycle, POKEY_OFFSET_AUDC1, 0x10 | ((line + frame) & 0x0f), chip);
+			else if (pattern == 7) {
+				if (line == 0)
+					for (ch = 0; ch < 4; ch++)
+						put(cycle, POKEY_OFFSET_AUDC1 + ch * 2, 0, chip);
+			}
+			else if (line % 104 == 0) {
+				/* A sweep on each channel, moved three times a frame */
+				for (ch = 0; ch < 4; ch++) {
+					put(cycle + ch * 8, POKEY_OFFSET_AUDF1 + ch * 2, (ch * 37 + step * 5 + line / 26) & 0xff, chip);
+					put(cycle + ch * 8, POKEY_OFFSET_AUDC1 + ch * 2,
+					    (pattern == 1 ? dist[(ch + step) & 3] : 0xa0) | ((step + ch) % 6 + 4), chip);
+				}
+			}
+		}
+	}
+}
 
-    /* Read parameter file */
-    if(!(fs = fopen(paramfn,"r")))
-    {
-        perror(paramfn);
-        return 2;
-    }
-    
-    for(i=0; i<10; i++)
-    {
-        ecode = fscanf(fs,"%u",&tmp);
-        if(ecode == EOF)
-        {
-            if(ferror(fs))
-            {
-                perror(paramfn);
-                fclose(fs);
-                return 2;
-            }
-            else
-            {
-                printf("%s: Unexpected end of file\n", paramfn);
-                fclose(fs);
-                return 2;
-            }
-        }
-        else if(ecode != 1)
-        {
-            printf("%s: Error in file format\n", paramfn);
-            fclose(fs);
-            return 2;
-        }
-        params[i] = tmp;
-    }
-    fclose(fs);
+static void run(const char *engine, int new_pokey, int bienias_fix, int pokeys, int bits, int rate, int frames)
+{
+	unsigned int frame_ticks = Atari800_tv_mode * ANTIC_LINE_C;
+	unsigned long samples = 0;
+	clock_t t;
+	double seconds;
+	int frame;
+
+	POKEYSND_enable_new_pokey = new_pokey;
+	POKEYSND_bienias_fix = bienias_fix;
+#ifdef STEREO_SOUND
+	POKEYSND_stereo_enabled = pokeys > 1;
+#endif
+	ANTIC_screenline_cpu_clock = 0;
+	POKEYSND_Init(POKEYSND_FREQ_17_EXACT, rate, (UBYTE) pokeys, bits == 16 ? POKEYSND_BIT16 : 0);
+	srand(1);
+	checksum = 2166136261UL;
+
+	t = clock();
+	for (frame = 0; frame < frames; frame++) {
+		unsigned int start = frame * frame_ticks;
+		int n;
+		script_frame(start, frame, pokeys);
+		ANTIC_screenline_cpu_clock = start + frame_ticks;
+		n = POKEYSND_UpdateProcessBuffer();
+		add_to_checksum(POKEYSND_process_buffer, n * bits / 8);
+		samples += n / pokeys;
+	}
+	seconds = (double) (clock() - t) / CLOCKS_PER_SEC;
+
+	printf("%-6s %d POKEY%s %2d-bit  %12.0f samples/s  %6.1fx real time  checksum %08lx\n",
+	       engine, pokeys, pokeys > 1 ? "s" : " ", bits,
+	       seconds > 0 ? samples / seconds : 0.0,
+	       seconds > 0 ? samples / seconds / rate : 0.0, checksum);
+	fflush(stdout);
+}
 
-    for(i=0; i<4; i++)
-    {
-        audf[i] = params[i*2];
-        audc[i] = params[i*2+1];
-    }
-    
-    return pktest(audf,audc,(unsigned char)params[8],ofn8, ofn16, (unsigned short)params[9]);
+int main(int argc, char *argv[])
+{
+	int rate = 44100;
+	int frames = SCRIPT_PATTERNS * PATTERN_FRAMES * 15;
+	int pokeys, bits;
+	int i;
+
+	for (i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "-rate") == 0 && i + 1 < argc)
+			rate = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-frames") == 0 && i + 1 < argc)
+			frames = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-ntsc") == 0)
+			Atari800_tv_mode = Atari800_TV_NTSC;
+		else {
+			fprintf(stderr, "usage: pokeybench [-rate n] [-frames n] [-ntsc]\n");
+			return 2;
+		}
+	}
+	if (rate < 1000 || frames < 1) {
+		fprintf(stderr, "pokeybench: bad rate or frame count\n");
+		return 2;
+	}
+
+	printf("%d frames (%s) at %d Hz\n", frames, Atari800_tv_mode == Atari800_TV_PAL ? "PAL" : "NTSC", rate);
+	for (pokeys = 1; pokeys <= 2; pokeys++) {
+		for (bits = 8; bits <= 16; bits += 8) {
+			run("rf", FALSE, FALSE, pokeys, bits, rate, frames);
+			run("rf-hf", FALSE, TRUE, pokeys, bits, rate, frames);
+			run("mz", TRUE, FALSE, pokeys, bits, rate, frames);
+		}
+	}
+	return 0;
 }